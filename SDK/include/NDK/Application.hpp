@@ -19,6 +19,8 @@ namespace Ndk
 	class NDK_API Application
 	{
 		public:
+			struct FrameTimeStatistics;
+
 			inline Application();
 			Application(const Application&) = delete;
 			Application(Application&&) = delete;
@@ -29,6 +31,9 @@ namespace Ndk
 			#endif
 			template<typename... Args> World& AddWorld(Args&&... args);
 
+			inline float GetFrameRateLimit() const;
+			FrameTimeStatistics GetFrameTimeStatistics() const;
+			inline std::size_t GetFrameTimeHistorySize() const;
 			inline float GetUpdateTime() const;
 
 			bool Run();
@@ -39,21 +44,39 @@ namespace Ndk
 
 			inline void Quit();
 
+			inline void SetFrameRateLimit(float framePerSecond);
+			void SetFrameTimeHistorySize(std::size_t frameCount);
+
 			Application& operator=(const Application&) = delete;
 			Application& operator=(Application&&) = delete;
 
 			inline static Application* Instance();
 
+			struct FrameTimeStatistics
+			{
+				float average = 0.f;
+				float max = 0.f;
+				float percentile95 = 0.f;
+				float percentile99 = 0.f;
+				std::size_t frameCount = 0;
+			};
+
 		private:
+			void WaitForNextFrame();
+
 			#ifndef NDK_SERVER
 			std::vector<std::unique_ptr<Nz::Window>> m_windows;
 			#endif
 			std::list<World> m_worlds;
+			std::size_t m_frameTimeHistorySize;
+			std::size_t m_frameTimeIndex;
+			std::vector<float> m_frameTimes; //< Rolling history, m_frameTimeIndex being the oldest once full
 			Nz::Clock m_updateClock;
 			#ifndef NDK_SERVER
 			bool m_exitOnClosedWindows;
 			#endif
 			bool m_shouldQuit;
+			float m_frameRateLimit;
 			float m_updateTime;
 
 			static Application* s_application;
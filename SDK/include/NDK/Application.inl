@@ -3,16 +3,24 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <algorithm>
 #include <type_traits>
 #include <NDK/Sdk.hpp>
 
 namespace Ndk
 {
 	inline Application::Application() :
+	m_frameTimeHistorySize(240),
+	m_frameTimeIndex(0),
 	#ifndef NDK_SERVER
 	m_exitOnClosedWindows(true),
 	#endif
 	m_shouldQuit(false),
+	#ifdef NDK_SERVER
+	m_frameRateLimit(60.f), //< Nothing waits for the display, the loop would take a whole core
+	#else
+	m_frameRateLimit(0.f),
+	#endif
 	m_updateTime(0.f)
 	{
 		NazaraAssert(s_application == nullptr, "You can create only one application instance per program");
@@ -56,6 +64,16 @@ namespace Ndk
 		return m_worlds.back();
 	}
 
+	inline float Application::GetFrameRateLimit() const
+	{
+		return m_frameRateLimit;
+	}
+
+	inline std::size_t Application::GetFrameTimeHistorySize() const
+	{
+		return m_frameTimeHistorySize;
+	}
+
 	inline float Application::GetUpdateTime() const
 	{
 		return m_updateTime;
@@ -73,6 +91,11 @@ namespace Ndk
 		m_shouldQuit = true;
 	}
 
+	inline void Application::SetFrameRateLimit(float framePerSecond)
+	{
+		m_frameRateLimit = std::max(framePerSecond, 0.f); // 0.f means no limit
+	}
+
 	inline Application* Application::Instance()
 	{
 		return s_application;
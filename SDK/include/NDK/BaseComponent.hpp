@@ -7,23 +7,31 @@
 #ifndef NDK_BASECOMPONENT_HPP
 #define NDK_BASECOMPONENT_HPP
 
+#include <NDK/ComponentPool.hpp>
 #include <NDK/Entity.hpp>
 #include <functional>
 #include <unordered_map>
 #include <vector>
 
+namespace Nz
+{
+	class ByteStream;
+}
+
 namespace Ndk
 {
 	class NDK_API BaseComponent
 	{
 		friend Entity;
 		friend class Sdk;
+		friend class World;
 
 		public:
 			using Factory = std::function<BaseComponent*()>;
+			using PoolFactory = std::function<BaseComponentPool*()>;
 
 			BaseComponent(ComponentIndex componentIndex);
-			BaseComponent(const BaseComponent&) = default;
+			BaseComponent(const BaseComponent& component);
 			BaseComponent(BaseComponent&&) = default;
 			virtual ~BaseComponent();
 
@@ -31,8 +39,14 @@ namespace Ndk
 
 			ComponentIndex GetIndex() const;
 
+			virtual bool Serialize(Nz::ByteStream& stream) const;
+
+			virtual bool Unserialize(Nz::ByteStream& stream);
+
 			inline static ComponentIndex GetMaxComponentIndex();
 
+			inline static bool IsSerializable(ComponentIndex index);
+
 			BaseComponent& operator=(const BaseComponent&) = default;
 			BaseComponent& operator=(BaseComponent&&) = default;
 
@@ -40,7 +54,7 @@ namespace Ndk
 			ComponentIndex m_componentIndex;
 			EntityHandle m_entity;
 
-			static ComponentIndex RegisterComponent(ComponentId id, Factory factoryFunc);
+			static ComponentIndex RegisterComponent(ComponentId id, Factory factoryFunc, PoolFactory poolFactoryFunc, bool serializable = false);
 
 		private:
 			virtual void OnAttached();
@@ -50,6 +64,10 @@ namespace Ndk
 
 			void SetEntity(Entity* entity);
 
+			static std::unique_ptr<BaseComponent> CreateComponent(ComponentIndex index);
+			static std::unique_ptr<BaseComponentPool> CreatePool(ComponentIndex index);
+			static bool FindComponentIndex(ComponentId id, ComponentIndex* index);
+			static ComponentId GetComponentId(ComponentIndex index);
 			static bool Initialize();
 			static void Uninitialize();
 
@@ -57,6 +75,8 @@ namespace Ndk
 			{
 				ComponentId id;
 				Factory factory;
+				PoolFactory poolFactory;
+				bool serializable; //< Part of the world snapshots
 			};
 
 			static std::vector<ComponentEntry> s_entries;
@@ -13,6 +13,12 @@ namespace Ndk
 	{
 	}
 
+	inline BaseComponent::BaseComponent(const BaseComponent& component) :
+	m_componentIndex(component.m_componentIndex),
+	m_entity(nullptr) //< Une copie n'est attachée à aucune entité
+	{
+	}
+
 	inline ComponentIndex BaseComponent::GetIndex() const
 	{
 		return m_componentIndex;
@@ -23,7 +29,14 @@ namespace Ndk
 		return static_cast<ComponentIndex>(s_entries.size());
 	}
 
-	inline ComponentIndex BaseComponent::RegisterComponent(ComponentId id, Factory factoryFunc)
+	inline bool BaseComponent::IsSerializable(ComponentIndex index)
+	{
+		NazaraAssert(index < s_entries.size(), "Component index out of range");
+
+		return s_entries[index].serializable;
+	}
+
+	inline ComponentIndex BaseComponent::RegisterComponent(ComponentId id, Factory factoryFunc, PoolFactory poolFactoryFunc, bool serializable)
 	{
 		// Nous allons rajouter notre composant à la fin
 		ComponentIndex index = static_cast<ComponentIndex>(s_entries.size());
@@ -33,6 +46,8 @@ namespace Ndk
 		ComponentEntry& entry = s_entries.back();
 		entry.factory = factoryFunc;
 		entry.id = id;
+		entry.poolFactory = poolFactoryFunc;
+		entry.serializable = serializable;
 
 		// Une petite assertion pour s'assurer que l'identifiant n'est pas déjà utilisé
 		NazaraAssert(s_idToIndex.find(id) == s_idToIndex.end(), "This id is already in use");
@@ -55,6 +70,37 @@ namespace Ndk
 		}
 	}
 
+	inline std::unique_ptr<BaseComponent> BaseComponent::CreateComponent(ComponentIndex index)
+	{
+		NazaraAssert(index < s_entries.size(), "Component index out of range");
+
+		return std::unique_ptr<BaseComponent>(s_entries[index].factory());
+	}
+
+	inline std::unique_ptr<BaseComponentPool> BaseComponent::CreatePool(ComponentIndex index)
+	{
+		NazaraAssert(index < s_entries.size(), "Component index out of range");
+
+		return std::unique_ptr<BaseComponentPool>(s_entries[index].poolFactory());
+	}
+
+	inline bool BaseComponent::FindComponentIndex(ComponentId id, ComponentIndex* index)
+	{
+		auto it = s_idToIndex.find(id);
+		if (it == s_idToIndex.end())
+			return false;
+
+		*index = it->second;
+		return true;
+	}
+
+	inline ComponentId BaseComponent::GetComponentId(ComponentIndex index)
+	{
+		NazaraAssert(index < s_entries.size(), "Component index out of range");
+
+		return s_entries[index].id;
+	}
+
 	inline bool BaseComponent::Initialize()
 	{
 		// Rien à faire
@@ -9,6 +9,7 @@
 
 #include <Nazara/Core/Bitset.hpp>
 #include <NDK/Entity.hpp>
+#include <NDK/EntityList.hpp>
 #include <vector>
 
 namespace Ndk
@@ -31,12 +32,16 @@ namespace Ndk
 
 			bool Filters(const Entity* entity) const;
 
-			inline const std::vector<EntityHandle>& GetEntities() const;
+			inline const EntityList& GetEntities() const;
 			inline SystemIndex GetIndex() const;
+			inline float GetUpdateInterpolation() const;
 			inline float GetUpdateRate() const;
 			inline World& GetWorld() const;
 
 			inline bool HasEntity(const Entity* entity) const;
+			inline bool HasEntity(EntityId entityId) const;
+
+			inline bool IsParallelizable() const;
 
 			inline void SetUpdateRate(float updatePerSecond);
 
@@ -52,6 +57,13 @@ namespace Ndk
 
 			static SystemIndex GetNextIndex();
 
+			template<typename F> void ParallelForEachEntity(F function, std::size_t grainSize = 64) const;
+
+			// Systems declaring the components they access are updated on the TaskScheduler workers, at the same time as the systems they do not conflict with
+			template<typename ComponentType> void Reads();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Reads();
+			inline void ReadsComponent(ComponentIndex index);
+
 			template<typename ComponentType> void Requires();
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Requires();
 			inline void RequiresComponent(ComponentIndex index);
@@ -60,11 +72,20 @@ namespace Ndk
 			template<typename ComponentType1, typename ComponentType2, typename... Rest> void RequiresAny();
 			inline void RequiresAnyComponent(ComponentIndex index);
 
+			template<typename ComponentType> void Writes();
+			template<typename ComponentType1, typename ComponentType2, typename... Rest> void Writes();
+			inline void WritesComponent(ComponentIndex index);
+
 			virtual void OnUpdate(float elapsedTime) = 0;
 
 		private:
 			inline void AddEntity(Entity* entity);
 
+			inline bool Conflicts(const BaseSystem& system) const;
+
+			inline bool FiltersAnyComponent(const Nz::Bitset<>& components) const;
+			void FlushRemovedEntities();
+
 			virtual void OnEntityAdded(Entity* entity);
 			virtual void OnEntityRemoved(Entity* entity);
 			virtual void OnEntityValidation(Entity* entity, bool justAdded);
@@ -78,16 +99,19 @@ namespace Ndk
 			static inline bool Initialize();
 			static inline void Uninitialize();
 
-			std::vector<EntityHandle> m_entities;
-			Nz::Bitset<Nz::UInt64> m_entityBits;
+			EntityList m_entities;
 			Nz::Bitset<> m_excludedComponents;
-			mutable Nz::Bitset<> m_filterResult;
+			Nz::Bitset<> m_filteredComponents; //< Only changes of these components can change the result of Filters
+			Nz::Bitset<> m_readComponents;
 			Nz::Bitset<> m_requiredAnyComponents;
 			Nz::Bitset<> m_requiredComponents;
+			Nz::Bitset<> m_writtenComponents;
 			SystemIndex m_systemIndex;
 			World* m_world;
 			float m_updateCounter;
 			float m_updateRate;
+			bool m_accessDeclared;
+			bool m_hasRemovedEntities;
 
 			static SystemIndex s_nextIndex;
 	};
@@ -95,4 +119,7 @@ namespace Ndk
 
 #include <NDK/BaseSystem.inl>
 
+// World a besoin d'une classe BaseSystem complète, il inclut EntityList.inl une fois défini
+#include <NDK/World.hpp>
+
 #endif // NDK_BASESYSTEM_HPP
@@ -3,26 +3,39 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <algorithm>
 #include <type_traits>
+#include <typeinfo>
 
 namespace Ndk
 {
 	inline BaseSystem::BaseSystem(SystemIndex systemId) :
-	m_systemIndex(systemId)
+	m_entities(false),
+	m_systemIndex(systemId),
+	m_accessDeclared(false),
+	m_hasRemovedEntities(false)
 	{
 		SetUpdateRate(30);
 	}
 
 	inline BaseSystem::BaseSystem(const BaseSystem& system) :
+	m_entities(false),
 	m_excludedComponents(system.m_excludedComponents),
+	m_filteredComponents(system.m_filteredComponents),
+	m_readComponents(system.m_readComponents),
 	m_requiredComponents(system.m_requiredComponents),
+	m_writtenComponents(system.m_writtenComponents),
 	m_systemIndex(system.m_systemIndex),
 	m_updateCounter(0.f),
-	m_updateRate(system.m_updateRate)
+	m_updateRate(system.m_updateRate),
+	m_accessDeclared(system.m_accessDeclared),
+	m_hasRemovedEntities(false)
 	{
 	}
 
-	inline const std::vector<EntityHandle>& BaseSystem::GetEntities() const
+	inline const EntityList& BaseSystem::GetEntities() const
 	{
 		return m_entities;
 	}
@@ -32,6 +45,12 @@ namespace Ndk
 		return m_systemIndex;
 	}
 
+	inline float BaseSystem::GetUpdateInterpolation() const
+	{
+		// Progress toward the next fixed update, to render between the last two states of the simulation
+		return (m_updateRate > 0.f) ? m_updateCounter / m_updateRate : 0.f;
+	}
+
 	inline float BaseSystem::GetUpdateRate() const
 	{
 		return (m_updateRate > 0.f) ? 1.f / m_updateRate : 0.f;
@@ -47,7 +66,17 @@ namespace Ndk
 		if (!entity)
 			return false;
 
-		return m_entityBits.UnboundedTest(entity->GetId());
+		return HasEntity(entity->GetId());
+	}
+
+	inline bool BaseSystem::HasEntity(EntityId entityId) const
+	{
+		return m_entities.Has(entityId);
+	}
+
+	inline bool BaseSystem::IsParallelizable() const
+	{
+		return m_accessDeclared;
 	}
 
 	inline void BaseSystem::SetUpdateRate(float updatePerSecond)
@@ -58,6 +87,9 @@ namespace Ndk
 
 	inline void BaseSystem::Update(float elapsedTime)
 	{
+		// The name returned by typeid is compiler-specific but stays valid for the whole program
+		NazaraProfileZone(typeid(*this).name());
+
 		if (m_updateRate > 0.f)
 		{
 			m_updateCounter += elapsedTime;
@@ -90,6 +122,7 @@ namespace Ndk
 	inline void BaseSystem::ExcludesComponent(ComponentIndex index)
 	{
 		m_excludedComponents.UnboundedSet(index);
+		m_filteredComponents.UnboundedSet(index);
 	}
 
 	inline SystemIndex BaseSystem::GetNextIndex()
@@ -97,6 +130,38 @@ namespace Ndk
 		return s_nextIndex++;
 	}
 
+	// The entity list must not be modified by the function, which can be called from multiple threads at the same time
+	template<typename F>
+	void BaseSystem::ParallelForEachEntity(F function, std::size_t grainSize) const
+	{
+		Nz::TaskScheduler::ParallelFor(0, m_entities.size(), grainSize, [this, &function] (std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				function(m_entities[i]);
+		});
+	}
+
+	template<typename ComponentType>
+	void BaseSystem::Reads()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ReadsComponent(GetComponentIndex<ComponentType>());
+	}
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Reads()
+	{
+		Reads<ComponentType1>();
+		Reads<ComponentType2, Rest...>();
+	}
+
+	inline void BaseSystem::ReadsComponent(ComponentIndex index)
+	{
+		m_readComponents.UnboundedSet(index);
+		m_accessDeclared = true;
+	}
+
 	template<typename ComponentType>
 	void BaseSystem::Requires()
 	{
@@ -115,6 +180,7 @@ namespace Ndk
 	inline void BaseSystem::RequiresComponent(ComponentIndex index)
 	{
 		m_requiredComponents.UnboundedSet(index);
+		m_filteredComponents.UnboundedSet(index);
 	}
 
 	template<typename ComponentType>
@@ -135,32 +201,71 @@ namespace Ndk
 	inline void BaseSystem::RequiresAnyComponent(ComponentIndex index)
 	{
 		m_requiredAnyComponents.UnboundedSet(index);
+		m_filteredComponents.UnboundedSet(index);
+	}
+
+	template<typename ComponentType>
+	void BaseSystem::Writes()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		WritesComponent(GetComponentIndex<ComponentType>());
+	}
+
+	template<typename ComponentType1, typename ComponentType2, typename... Rest>
+	void BaseSystem::Writes()
+	{
+		Writes<ComponentType1>();
+		Writes<ComponentType2, Rest...>();
+	}
+
+	inline void BaseSystem::WritesComponent(ComponentIndex index)
+	{
+		m_writtenComponents.UnboundedSet(index);
+		m_accessDeclared = true;
 	}
 
 	inline void BaseSystem::AddEntity(Entity* entity)
 	{
 		NazaraAssert(entity, "Invalid entity");
 
-		m_entities.emplace_back(entity);
-		m_entityBits.UnboundedSet(entity->GetId(), true);
+		m_entities.Insert(entity);
 
 		entity->RegisterSystem(m_systemIndex);
 
 		OnEntityAdded(entity);
 	}
 
+	// Systems which did not declare their accesses conflict with every other system
+	inline bool BaseSystem::Conflicts(const BaseSystem& system) const
+	{
+		if (!m_accessDeclared || !system.m_accessDeclared)
+			return true;
+
+		return m_writtenComponents.Intersects(system.m_readComponents) ||
+		       m_writtenComponents.Intersects(system.m_writtenComponents) ||
+		       system.m_writtenComponents.Intersects(m_readComponents);
+	}
+
+	// Systems without any requirement accept every entity, they are told about every change of components
+	inline bool BaseSystem::FiltersAnyComponent(const Nz::Bitset<>& components) const
+	{
+		if (m_filteredComponents.TestNone())
+			return true;
+
+		return m_filteredComponents.Intersects(components);
+	}
+
 	inline void BaseSystem::RemoveEntity(Entity* entity)
 	{
 		NazaraAssert(entity, "Invalid entity");
 
-		auto it = std::find(m_entities.begin(), m_entities.end(), *entity);
-		NazaraAssert(it != m_entities.end(), "Entity is not part of this system");
+		NazaraAssert(HasEntity(entity), "Entity is not part of this system");
 
-		// Pour éviter de déplacer beaucoup de handles, on swap le dernier avec celui à supprimer
-		std::swap(*it, m_entities.back());
-		m_entities.pop_back(); // On le sort du vector
+		// L'identifiant ne sort du vector qu'au prochain FlushRemovedEntities, en une seule passe pour toutes les entités retirées
+		m_entities.m_entityBits.Reset(entity->GetId());
+		m_hasRemovedEntities = true;
 
-		m_entityBits.Reset(entity->GetId());
 		entity->UnregisterSystem(m_systemIndex);
 
 		OnEntityRemoved(entity); // Et on appelle le callback
@@ -37,7 +37,17 @@ namespace Ndk
 			return new ComponentType;
 		};
 
-		return BaseComponent::RegisterComponent(id, factory);
+		// Chaque monde stocke les components de ce type dans un pool
+		auto poolFactory = []() -> BaseComponentPool*
+		{
+			return new ComponentPool<ComponentType>;
+		};
+
+		// Seuls les components redéfinissant Serialize font partie des snapshots du monde
+		using BaseSerializeType = bool (BaseComponent::*)(Nz::ByteStream&) const;
+		constexpr bool serializable = !std::is_same<decltype(&ComponentType::Serialize), BaseSerializeType>::value;
+
+		return BaseComponent::RegisterComponent(id, factory, poolFactory, serializable);
 	}
 
 	template<typename ComponentType>
@@ -0,0 +1,103 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_COMPONENTPOOL_HPP
+#define NDK_COMPONENTPOOL_HPP
+
+#include <NDK/Algorithm.hpp>
+#include <NDK/Prerequesites.hpp>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Ndk
+{
+	class BaseComponent;
+
+	// Components of one type, for all entities of a world, with an entity id to dense index mapping (sparse set)
+	class NDK_API BaseComponentPool
+	{
+		public:
+			BaseComponentPool() = default;
+			BaseComponentPool(const BaseComponentPool&) = delete;
+			BaseComponentPool(BaseComponentPool&&) = delete;
+			virtual ~BaseComponentPool();
+
+			virtual BaseComponent& Add(EntityId entityId, std::unique_ptr<BaseComponent>&& component) = 0;
+
+			virtual BaseComponent& Clone(EntityId entityId, const BaseComponent& component) = 0;
+
+			inline std::size_t GetCount() const;
+			virtual BaseComponent& GetComponent(EntityId entityId) = 0;
+			inline const std::vector<EntityId>& GetEntityIds() const;
+
+			inline bool Has(EntityId entityId) const;
+
+			virtual void Remove(EntityId entityId) = 0;
+
+			virtual void Reserve(std::size_t count);
+
+			BaseComponentPool& operator=(const BaseComponentPool&) = delete;
+			BaseComponentPool& operator=(BaseComponentPool&&) = delete;
+
+		protected:
+			inline std::size_t EraseEntity(EntityId entityId);
+			inline std::size_t GetDenseIndex(EntityId entityId) const;
+			inline void InsertEntity(EntityId entityId);
+
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::vector<std::size_t> m_denseIndices; //< By entity id
+			std::vector<EntityId> m_entityIds;
+	};
+
+	// Components created by the pool are constructed in contiguous chunks, in creation order, and never move
+	template<typename ComponentType>
+	class ComponentPool : public BaseComponentPool
+	{
+		public:
+			ComponentPool() = default;
+			~ComponentPool();
+
+			BaseComponent& Add(EntityId entityId, std::unique_ptr<BaseComponent>&& component) override;
+
+			BaseComponent& Clone(EntityId entityId, const BaseComponent& component) override;
+			template<typename... Args> ComponentType& Create(EntityId entityId, Args&&... args);
+
+			template<typename F> void ForEach(F&& func);
+
+			ComponentType& Get(EntityId entityId);
+			BaseComponent& GetComponent(EntityId entityId) override;
+
+			void Remove(EntityId entityId) override;
+
+			void Reserve(std::size_t count) override;
+
+		private:
+			void AllocateChunk();
+			inline void Insert(EntityId entityId, ComponentType* component, bool pooled);
+
+			static constexpr std::size_t ChunkSize = 64;
+
+			using Slot = typename std::aligned_storage<sizeof(ComponentType), alignof(ComponentType)>::type;
+
+			struct Entry
+			{
+				ComponentType* component;
+				bool pooled; //< Components added as objects allocated by the user are deleted instead
+			};
+
+			std::vector<Entry> m_entries; //< Same order as the entity ids
+			std::vector<std::unique_ptr<Slot[]>> m_chunks;
+			std::vector<Slot*> m_freeSlots;
+	};
+}
+
+#include <NDK/ComponentPool.inl>
+
+#endif // NDK_COMPONENTPOOL_HPP
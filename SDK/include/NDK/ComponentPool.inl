@@ -0,0 +1,185 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace Ndk
+{
+	inline std::size_t BaseComponentPool::GetCount() const
+	{
+		return m_entityIds.size();
+	}
+
+	inline const std::vector<EntityId>& BaseComponentPool::GetEntityIds() const
+	{
+		return m_entityIds;
+	}
+
+	inline bool BaseComponentPool::Has(EntityId entityId) const
+	{
+		return entityId < m_denseIndices.size() && m_denseIndices[entityId] != InvalidIndex;
+	}
+
+	// The last entity takes the place of the removed one, its former dense index is returned
+	inline std::size_t BaseComponentPool::EraseEntity(EntityId entityId)
+	{
+		NazaraAssert(Has(entityId), "Entity has no component in this pool");
+
+		std::size_t index = m_denseIndices[entityId];
+
+		EntityId lastEntityId = m_entityIds.back();
+		m_entityIds[index] = lastEntityId;
+		m_denseIndices[lastEntityId] = index;
+
+		m_entityIds.pop_back();
+		m_denseIndices[entityId] = InvalidIndex;
+
+		return index;
+	}
+
+	inline std::size_t BaseComponentPool::GetDenseIndex(EntityId entityId) const
+	{
+		NazaraAssert(Has(entityId), "Entity has no component in this pool");
+
+		return m_denseIndices[entityId];
+	}
+
+	inline void BaseComponentPool::InsertEntity(EntityId entityId)
+	{
+		NazaraAssert(!Has(entityId), "Entity already has a component in this pool");
+
+		if (entityId >= m_denseIndices.size())
+			m_denseIndices.resize(entityId + 1, InvalidIndex);
+
+		m_denseIndices[entityId] = m_entityIds.size();
+		m_entityIds.push_back(entityId);
+	}
+
+	template<typename ComponentType>
+	ComponentPool<ComponentType>::~ComponentPool()
+	{
+		for (const Entry& entry : m_entries)
+		{
+			if (entry.pooled)
+				entry.component->~ComponentType();
+			else
+				delete entry.component;
+		}
+	}
+
+	template<typename ComponentType>
+	BaseComponent& ComponentPool<ComponentType>::Add(EntityId entityId, std::unique_ptr<BaseComponent>&& component)
+	{
+		NazaraAssert(component, "Component must be valid");
+
+		ComponentType* ptr = static_cast<ComponentType*>(component.get());
+		Insert(entityId, ptr, false);
+		component.release();
+
+		return *ptr;
+	}
+
+	template<typename ComponentType>
+	BaseComponent& ComponentPool<ComponentType>::Clone(EntityId entityId, const BaseComponent& component)
+	{
+		const ComponentType& source = static_cast<const ComponentType&>(component);
+		NazaraAssert(source.GetIndex() == GetComponentIndex<ComponentType>(), "Component is not of the pool type");
+
+		return Create(entityId, source);
+	}
+
+	template<typename ComponentType>
+	template<typename... Args>
+	ComponentType& ComponentPool<ComponentType>::Create(EntityId entityId, Args&&... args)
+	{
+		if (m_freeSlots.empty())
+			AllocateChunk();
+
+		// The slot is only taken once the component is constructed
+		ComponentType* component = new (m_freeSlots.back()) ComponentType(std::forward<Args>(args)...);
+		m_freeSlots.pop_back();
+
+		Insert(entityId, component, true);
+
+		return *component;
+	}
+
+	// Components must not be added to or removed from the pool during the iteration
+	template<typename ComponentType>
+	template<typename F>
+	void ComponentPool<ComponentType>::ForEach(F&& func)
+	{
+		const std::vector<EntityId>& entityIds = GetEntityIds();
+		for (std::size_t i = 0; i < m_entries.size(); ++i)
+			func(entityIds[i], *m_entries[i].component);
+	}
+
+	template<typename ComponentType>
+	ComponentType& ComponentPool<ComponentType>::Get(EntityId entityId)
+	{
+		return *m_entries[GetDenseIndex(entityId)].component;
+	}
+
+	template<typename ComponentType>
+	BaseComponent& ComponentPool<ComponentType>::GetComponent(EntityId entityId)
+	{
+		return Get(entityId);
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::Remove(EntityId entityId)
+	{
+		std::size_t index = EraseEntity(entityId);
+
+		Entry entry = m_entries[index];
+		m_entries[index] = m_entries.back();
+		m_entries.pop_back();
+
+		if (entry.pooled)
+		{
+			entry.component->~ComponentType();
+			m_freeSlots.push_back(reinterpret_cast<Slot*>(entry.component));
+		}
+		else
+			delete entry.component;
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::Reserve(std::size_t count)
+	{
+		BaseComponentPool::Reserve(count);
+
+		if (count > m_entries.capacity())
+			m_entries.reserve(std::max(count, 2 * m_entries.capacity()));
+
+		while (m_entries.size() + m_freeSlots.size() < count)
+			AllocateChunk();
+	}
+
+	template<typename ComponentType>
+	void ComponentPool<ComponentType>::AllocateChunk()
+	{
+		m_chunks.emplace_back(new Slot[ChunkSize]);
+
+		// Reversed, so that slots are given in address order
+		Slot* chunk = m_chunks.back().get();
+		for (std::size_t i = ChunkSize; i-- > 0;)
+			m_freeSlots.push_back(&chunk[i]);
+	}
+
+	template<typename ComponentType>
+	inline void ComponentPool<ComponentType>::Insert(EntityId entityId, ComponentType* component, bool pooled)
+	{
+		InsertEntity(entityId);
+
+		Entry entry;
+		entry.component = component;
+		entry.pooled = pooled;
+
+		m_entries.push_back(entry);
+	}
+}
@@ -35,8 +35,8 @@ namespace Ndk
 			inline void EnsureViewportUpdate() const;
 
 			inline float GetAspectRatio() const override;
-			inline Nz::Vector3f GetEyePosition() const override;
-			inline Nz::Vector3f GetForward() const override;
+			Nz::Vector3f GetEyePosition() const override;
+			Nz::Vector3f GetForward() const override;
 			inline float GetFOV() const;
 			inline const Nz::Frustumf& GetFrustum() const override;
 			inline unsigned int GetLayer() const;
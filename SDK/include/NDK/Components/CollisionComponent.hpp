@@ -8,6 +8,7 @@
 #define NDK_COMPONENTS_COLLISIONCOMPONENT_HPP
 
 #include <Nazara/Physics/Geom.hpp>
+#include <Nazara/Utility/Node.hpp>
 #include <NDK/Component.hpp>
 #include <memory>
 
@@ -47,10 +48,13 @@ namespace Ndk
 			void OnComponentAttached(BaseComponent& component) override;
 			void OnComponentDetached(BaseComponent& component) override;
 			void OnDetached() override;
+			void OnNodeInvalidated(const Nz::Node* node);
+
+			NazaraSlot(Nz::Node, OnNodeInvalidation, m_nodeInvalidationSlot);
 
 			std::unique_ptr<Nz::PhysObject> m_staticBody;
 			Nz::PhysGeomRef m_geom;
-			bool m_bodyUpdated;
+			bool m_bodyUpdated; //< Whether the static body matches the node, set by the PhysicsSystem
 	};
 }
 
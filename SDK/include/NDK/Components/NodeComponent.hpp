@@ -23,9 +23,13 @@ namespace Ndk
 			NodeComponent() = default;
 			~NodeComponent() = default;
 
+			bool Serialize(Nz::ByteStream& stream) const override;
+
 			void SetParent(Entity* entity, bool keepDerived = false);
 			using Nz::Node::SetParent;
 
+			bool Unserialize(Nz::ByteStream& stream) override;
+
 			static ComponentIndex componentIndex;
 	};
 }
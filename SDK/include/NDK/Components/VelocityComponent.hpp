@@ -23,6 +23,9 @@ namespace Ndk
 			VelocityComponent(const Nz::Vector3f& velocity = Nz::Vector3f::Zero());
 			~VelocityComponent() = default;
 
+			bool Serialize(Nz::ByteStream& stream) const override;
+			bool Unserialize(Nz::ByteStream& stream) override;
+
 			Nz::Vector3f linearVelocity;
 
 			VelocityComponent& operator=(const Nz::Vector3f& vel);
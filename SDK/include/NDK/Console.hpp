@@ -15,6 +15,8 @@
 #include <Nazara/Utility/Node.hpp>
 #include <Nazara/Utility/SimpleTextDrawer.hpp>
 #include <NDK/EntityOwner.hpp>
+#include <limits>
+#include <vector>
 
 namespace Nz
 {
@@ -43,6 +45,7 @@ namespace Ndk
 			inline unsigned int GetCharacterSize() const;
 			inline const EntityHandle& GetHistory() const;
 			inline const EntityHandle& GetHistoryBackground() const;
+			inline std::size_t GetHistoryCapacity() const;
 			inline const EntityHandle& GetInput() const;
 			inline const EntityHandle& GetInputBackground() const;
 			inline const Nz::Vector2f& GetSize() const;
@@ -54,6 +57,7 @@ namespace Ndk
 			void SendEvent(Nz::WindowEvent event);
 
 			void SetCharacterSize(unsigned int size);
+			void SetHistoryCapacity(std::size_t capacity);
 			void SetSize(const Nz::Vector2f& size);
 			void SetTextFont(Nz::FontRef font);
 
@@ -65,6 +69,7 @@ namespace Ndk
 		private:
 			void AddLineInternal(const Nz::String& text, const Nz::Color& color = Nz::Color::White);
 			void ExecuteInput();
+			inline std::size_t GetFirstLineNumber() const;
 			void Layout();
 			void RefreshHistory();
 
@@ -74,9 +79,23 @@ namespace Ndk
 				Nz::String text;
 			};
 
+			// Each visible line has its own text sprite, which keeps its layout while the line stays visible
+			struct HistoryRow
+			{
+				EntityOwner entity;
+				Nz::TextSpriteRef textSprite;
+				std::size_t lineNumber; //< Line currently laid out, InvalidLineNumber if none
+			};
+
+			static constexpr std::size_t InvalidLineNumber = std::numeric_limits<std::size_t>::max();
+
+			std::size_t m_historyCapacity;
+			std::size_t m_historyFirstLine; //< Number of the first line since the last Clear
+			std::size_t m_historyLineCount; //< Number of lines ever added, the next line number
 			std::size_t m_historyPosition;
 			std::vector<Nz::String> m_commandHistory;
-			std::vector<Line> m_historyLines;
+			std::vector<HistoryRow> m_historyRows; //< The row of line N is N % row count
+			std::vector<Line> m_historyLines; //< Ring buffer, line N is at (N - m_historyFirstLine) % m_historyCapacity
 			EntityOwner m_historyBackground;
 			EntityOwner m_history;
 			EntityOwner m_input;
@@ -87,9 +106,9 @@ namespace Ndk
 			Nz::SpriteRef m_inputBackgroundSprite;
 			Nz::SimpleTextDrawer m_historyDrawer;
 			Nz::SimpleTextDrawer m_inputDrawer;
-			Nz::TextSpriteRef m_historyTextSprite;
 			Nz::TextSpriteRef m_inputTextSprite;
 			Nz::Vector2f m_size;
+			bool m_historyInvalidated; //< Lines were added while the console was hidden
 			bool m_opened;
 			unsigned int m_characterSize;
 			unsigned int m_maxHistoryLines;
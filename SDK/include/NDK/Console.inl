@@ -32,6 +32,11 @@ namespace Ndk
 		return m_inputBackground;
 	}
 
+	inline std::size_t Console::GetHistoryCapacity() const
+	{
+		return m_historyCapacity;
+	}
+
 	inline const Nz::Vector2f& Console::GetSize() const
 	{
 		return m_size;
@@ -46,4 +51,10 @@ namespace Ndk
 	{
 		return m_opened;
 	}
+
+	inline std::size_t Console::GetFirstLineNumber() const
+	{
+		// Oldest line still in the history
+		return m_historyLineCount - m_historyLines.size();
+	}
 }
@@ -10,6 +10,7 @@
 #include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/HandledObject.hpp>
 #include <NDK/Algorithm.hpp>
+#include <NDK/ComponentPool.hpp>
 #include <memory>
 #include <vector>
 
@@ -21,6 +22,16 @@ namespace Ndk
 
 	using EntityHandle = Nz::ObjectHandle<Entity>;
 
+	// Identifies an entity without registering to it, a killed entity's ID is never valid again even once reused
+	struct EntityGenerationalId
+	{
+		EntityId id;
+		Nz::UInt32 generation;
+
+		inline bool operator==(const EntityGenerationalId& other) const;
+		inline bool operator!=(const EntityGenerationalId& other) const;
+	};
+
 	class NDK_API Entity : public Nz::HandledObject<Entity>
 	{
 		friend class BaseSystem;
@@ -39,7 +50,9 @@ namespace Ndk
 			inline BaseComponent& GetComponent(ComponentIndex index);
 			template<typename ComponentType> ComponentType& GetComponent();
 			inline const Nz::Bitset<>& GetComponentBits() const;
+			inline EntityGenerationalId GetGenerationalId() const;
 			inline EntityId GetId() const;
+			inline const Nz::Bitset<>& GetInvalidatedComponentBits() const;
 			inline const Nz::Bitset<>& GetSystemBits() const;
 			inline World* GetWorld() const;
 
@@ -64,21 +77,34 @@ namespace Ndk
 		private:
 			Entity(World* world, EntityId id);
 
-			void Create();
+			BaseComponent& AttachComponent(BaseComponent& component);
+
+			void Create(Nz::UInt32 generation);
 			void Destroy();
+			void DestroyComponent(ComponentIndex index);
+
+			void InvalidateComponent(ComponentIndex index);
+			inline bool IsFullyInvalidated() const;
+
+			BaseComponentPool& GetComponentPool(ComponentIndex index) const;
 
 			inline void RegisterSystem(SystemIndex index);
 
+			inline void ResetInvalidation();
+
 			inline void SetWorld(World* world) noexcept;
 
 			inline void UnregisterSystem(SystemIndex index);
 
-			std::vector<std::unique_ptr<BaseComponent>> m_components;
+			std::vector<BaseComponent*> m_components; //< Owned by the component pools of the world
 			Nz::Bitset<> m_componentBits;
+			Nz::Bitset<> m_invalidatedComponentBits; //< Components added or removed since the last update of the world
 			Nz::Bitset<> m_systemBits;
 			EntityId m_id;
+			Nz::UInt32 m_generation;
 			World* m_world;
 			bool m_enabled;
+			bool m_fullyInvalidated;
 			bool m_valid;
 	};
 }
@@ -15,9 +15,12 @@ namespace Ndk
 	{
 		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
 
-		// Allocation et affectation du component
-		std::unique_ptr<ComponentType> ptr(new ComponentType(std::forward<Args>(args)...));
-		return static_cast<ComponentType&>(AddComponent(std::move(ptr)));
+		ComponentIndex index = GetComponentIndex<ComponentType>();
+		DestroyComponent(index);
+
+		// Construction du component dans le pool du monde, avec les autres components du même type
+		ComponentPool<ComponentType>& pool = static_cast<ComponentPool<ComponentType>&>(GetComponentPool(index));
+		return static_cast<ComponentType&>(AttachComponent(pool.Create(m_id, std::forward<Args>(args)...)));
 	}
 
 	inline void Entity::Enable(bool enable)
@@ -34,7 +37,7 @@ namespace Ndk
 		///DOC: Le component doit être présent
 		NazaraAssert(HasComponent(index), "This component is not part of the entity");
 
-		BaseComponent* component = m_components[index].get();
+		BaseComponent* component = m_components[index];
 		NazaraAssert(component, "Invalid component pointer");
 
 		return *component;
@@ -55,11 +58,21 @@ namespace Ndk
 		return m_componentBits;
 	}
 
+	inline EntityGenerationalId Entity::GetGenerationalId() const
+	{
+		return EntityGenerationalId{m_id, m_generation};
+	}
+
 	inline EntityId Entity::GetId() const
 	{
 		return m_id;
 	}
 
+	inline const Nz::Bitset<>& Entity::GetInvalidatedComponentBits() const
+	{
+		return m_invalidatedComponentBits;
+	}
+
 	inline const Nz::Bitset<>& Entity::GetSystemBits() const
 	{
 		return m_systemBits;
@@ -109,11 +122,22 @@ namespace Ndk
 		return ss << "Entity(" << GetId() << ')';
 	}
 
+	inline bool Entity::IsFullyInvalidated() const
+	{
+		return m_fullyInvalidated;
+	}
+
 	inline void Entity::RegisterSystem(SystemIndex index)
 	{
 		m_systemBits.UnboundedSet(index);
 	}
 
+	inline void Entity::ResetInvalidation()
+	{
+		m_invalidatedComponentBits.Reset();
+		m_fullyInvalidated = false;
+	}
+
 	inline void Entity::SetWorld(World* world) noexcept
 	{
 		NazaraAssert(world, "An entity must be attached to a world at any time");
@@ -125,6 +149,16 @@ namespace Ndk
 	{
 		m_systemBits.UnboundedReset(index);
 	}
+
+	inline bool EntityGenerationalId::operator==(const EntityGenerationalId& other) const
+	{
+		return id == other.id && generation == other.generation;
+	}
+
+	inline bool EntityGenerationalId::operator!=(const EntityGenerationalId& other) const
+	{
+		return !operator==(other);
+	}
 }
 
 namespace std
@@ -141,4 +175,13 @@ namespace std
 			return hash<Ndk::EntityId>()(id);
 		}
 	};
+
+	template<>
+	struct hash<Ndk::EntityGenerationalId>
+	{
+		size_t operator()(const Ndk::EntityGenerationalId& entityId) const
+		{
+			return hash<Nz::UInt64>()((Nz::UInt64(entityId.generation) << 32) | entityId.id);
+		}
+	};
 }
\ No newline at end of file
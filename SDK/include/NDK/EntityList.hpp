@@ -8,56 +8,110 @@
 #define NDK_ENTITYLIST_HPP
 
 #include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/ObjectHandle.hpp>
 #include <NDK/Prerequesites.hpp>
 #include <NDK/Entity.hpp>
+#include <iterator>
+#include <vector>
 
 namespace Ndk
 {
+	class BaseSystem;
+	class World;
+
+	// Entities are stored by generational ID, and looked up in their world while iterating (which skips the destroyed ones)
+	// The list follows its world through a handle, if the world is moved, and the world removes the killed entities from it
 	class NDK_API EntityList
 	{
+		friend BaseSystem;
+		friend World;
+
 		public:
-			using Container = std::vector<EntityHandle>;
+			class iterator;
+			using const_iterator = iterator;
+			using Container = std::vector<EntityGenerationalId>;
+			using size_type = Container::size_type;
 
-			EntityList() = default;
-			~EntityList() = default;
+			inline EntityList();
+			inline EntityList(const EntityList& entityList);
+			inline EntityList(EntityList&& entityList) noexcept;
+			inline ~EntityList();
 
 			inline void Clear();
 
-			inline bool Has(const Entity* entity);
-			inline bool Has(EntityId entity);
+			inline bool Has(const Entity* entity) const;
+			inline bool Has(EntityId entity) const;
 
 			inline void Insert(Entity* entity);
 
 			inline void Remove(Entity* entity);
 
+			template<typename F> void Sort(F comparator);
+
+			inline Entity* operator[](size_type index) const; // nullptr if the entity is no longer valid
+
 			// STL API
-			inline Container::iterator begin();
-			inline Container::const_iterator begin() const;
+			inline iterator begin() const;
 
-			inline Container::const_iterator cbegin() const;
-			inline Container::const_iterator cend() const;
-			inline Container::const_reverse_iterator crbegin() const;
-			inline Container::const_reverse_iterator crend() const;
+			inline const_iterator cbegin() const;
+			inline const_iterator cend() const;
 
 			inline bool empty() const;
 
-			inline Container::iterator end();
-			inline Container::const_iterator end() const;
-
-			inline Container::reverse_iterator rbegin();
-			inline Container::const_reverse_iterator rbegin() const;
+			inline iterator end() const;
 
-			inline Container::reverse_iterator rend();
-			inline Container::const_reverse_iterator rend() const;
+			inline size_type size() const;
 
-			inline Container::size_type size() const;
+			inline EntityList& operator=(const EntityList& entityList);
+			inline EntityList& operator=(EntityList&& entityList) noexcept;
 
 		private:
-			std::vector<EntityHandle> m_entities;
+			inline explicit EntityList(bool registerToWorld);
+
+			inline void RemoveEntities(const Nz::Bitset<Nz::UInt64>& entities);
+
+			Container m_entities;
 			Nz::Bitset<Nz::UInt64> m_entityBits;
+			Nz::ObjectHandle<World> m_world;
+			bool m_registerToWorld; //< False for the lists of the systems, which flush their removed entities themselves
+	};
+
+	class EntityList::iterator
+	{
+		friend EntityList;
+
+		public:
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+			using pointer = Entity**;
+			using reference = Entity*;
+			using value_type = Entity*;
+
+			iterator(const iterator&) = default;
+			~iterator() = default;
+
+			inline Entity* operator*() const;
+
+			iterator& operator=(const iterator&) = default;
+
+			inline iterator& operator++();
+			inline iterator operator++(int);
+
+			inline bool operator==(const iterator& rhs) const;
+			inline bool operator!=(const iterator& rhs) const;
+
+		private:
+			inline iterator(World* world, Container::const_iterator it, Container::const_iterator end);
+
+			inline void SkipInvalidEntities();
+
+			Container::const_iterator m_iterator;
+			Container::const_iterator m_end;
+			World* m_world;
 	};
 }
 
-#include <NDK/EntityList.inl>
+// Les fonctions de EntityList.inl ont besoin de World, qui est inclus à la suite de BaseSystem
+#include <NDK/BaseSystem.hpp>
 
 #endif // NDK_ENTITYLIST_HPP
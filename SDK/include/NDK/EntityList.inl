@@ -5,29 +5,88 @@
 #include <Nazara/Core/Error.hpp>
 #include <algorithm>
 
+// Inclus par World.hpp, une fois World défini
+
 namespace Ndk
 {
+	inline EntityList::EntityList() :
+	EntityList(true)
+	{
+	}
+
+	inline EntityList::EntityList(const EntityList& entityList) :
+	m_entities(entityList.m_entities),
+	m_entityBits(entityList.m_entityBits),
+	m_world(entityList.m_world),
+	m_registerToWorld(true)
+	{
+		// La liste d'un système garde les entités qui en sont retirées jusqu'à son prochain flush
+		if (!entityList.m_registerToWorld)
+		{
+			m_entities.erase(std::remove_if(m_entities.begin(), m_entities.end(), [this] (const EntityGenerationalId& id)
+			{
+				return !Has(id.id) || !m_world->IsEntityIdValid(id);
+			}), m_entities.end());
+		}
+
+		if (m_world)
+			m_world->RegisterEntityList(this);
+	}
+
+	inline EntityList::EntityList(EntityList&& entityList) noexcept :
+	m_entities(std::move(entityList.m_entities)),
+	m_entityBits(std::move(entityList.m_entityBits)),
+	m_world(std::move(entityList.m_world)),
+	m_registerToWorld(entityList.m_registerToWorld)
+	{
+		entityList.Clear(); // Le bitset déplacé garde sa taille
+
+		if (m_registerToWorld && m_world)
+			m_world->UpdateEntityList(&entityList, this);
+	}
+
+	inline EntityList::EntityList(bool registerToWorld) :
+	m_registerToWorld(registerToWorld)
+	{
+	}
+
+	inline EntityList::~EntityList()
+	{
+		if (m_registerToWorld && m_world)
+			m_world->UnregisterEntityList(this);
+	}
+
 	inline void EntityList::Clear()
 	{
 		m_entities.clear();
 		m_entityBits.Clear();
 	}
 
-	inline bool EntityList::Has(const Entity* entity)
+	inline bool EntityList::Has(const Entity* entity) const
 	{
-		return entity && entity->IsValid() && Has(entity->GetId());
+		return entity && entity->IsValid() && m_world == *entity->GetWorld() && Has(entity->GetId());
 	}
 
-	inline bool EntityList::Has(EntityId entity)
+	inline bool EntityList::Has(EntityId entity) const
 	{
 		return m_entityBits.UnboundedTest(entity);
 	}
 
 	inline void EntityList::Insert(Entity* entity)
 	{
-		if (!Has(entity))
+		NazaraAssert(entity && entity->IsValid(), "Invalid entity");
+		NazaraAssert(!m_world || m_world == *entity->GetWorld(), "Entity is not part of the world of the list");
+
+		if (!Has(entity->GetId()))
 		{
-			m_entities.emplace_back(entity);
+			if (!m_world)
+			{
+				m_world = entity->GetWorld()->CreateHandle();
+				if (m_registerToWorld)
+					m_world->RegisterEntityList(this);
+			}
+
+			m_entities.push_back(entity->GetGenerationalId());
 			m_entityBits.UnboundedSet(entity->GetId(), true);
 		}
 	}
@@ -36,83 +95,162 @@ namespace Ndk
 	{
 		if (Has(entity))
 		{
-			auto it = std::find(m_entities.begin(), m_entities.end(), *entity);
+			EntityId id = entity->GetId();
+
+			auto it = std::find_if(m_entities.begin(), m_entities.end(), [id] (const EntityGenerationalId& entityId) { return entityId.id == id; });
 			NazaraAssert(it != m_entities.end(), "Entity should be part of the vector");
 
 			std::swap(*it, m_entities.back());
 			m_entities.pop_back(); // On le sort du vector
-			m_entityBits.UnboundedSet(entity->GetId(), false);
+			m_entityBits.UnboundedSet(id, false);
 		}
 	}
 
+	template<typename F>
+	void EntityList::Sort(F comparator)
+	{
+		std::sort(m_entities.begin(), m_entities.end(), [this, &comparator] (const EntityGenerationalId& lhs, const EntityGenerationalId& rhs)
+		{
+			return comparator(m_world->FindEntity(lhs), m_world->FindEntity(rhs));
+		});
+	}
+
+	inline Entity* EntityList::operator[](size_type index) const
+	{
+		NazaraAssert(index < m_entities.size(), "Index out of range");
+
+		const EntityGenerationalId& id = m_entities[index];
+
+		// Contrairement aux itérateurs, l'accès par indice ne peut sauter une entité détruite
+		return (m_world) ? m_world->FindEntity(id) : nullptr;
+	}
+
 	// Nz::Interface STD
-	inline EntityList::Container::iterator EntityList::begin()
+	inline EntityList::iterator EntityList::begin() const
 	{
-		return m_entities.begin();
+		return iterator(m_world.GetObject(), m_entities.begin(), m_entities.end());
 	}
 
-	inline EntityList::Container::const_iterator EntityList::begin() const
+	inline EntityList::const_iterator EntityList::cbegin() const
 	{
-		return m_entities.begin();
+		return begin();
 	}
 
-	inline EntityList::Container::const_iterator EntityList::cbegin() const
+	inline EntityList::const_iterator EntityList::cend() const
 	{
-		return m_entities.cbegin();
+		return end();
 	}
 
-	inline EntityList::Container::const_iterator EntityList::cend() const
+	inline bool EntityList::empty() const
 	{
-		return m_entities.cend();
+		return m_entities.empty();
 	}
 
-	inline EntityList::Container::const_reverse_iterator EntityList::crbegin() const
+	inline EntityList::iterator EntityList::end() const
 	{
-		return m_entities.crbegin();
+		return iterator(m_world.GetObject(), m_entities.end(), m_entities.end());
 	}
 
-	inline EntityList::Container::const_reverse_iterator EntityList::crend() const
+	inline EntityList::size_type EntityList::size() const
 	{
-		return m_entities.crend();
+		return m_entities.size();
 	}
 
-	inline bool EntityList::empty() const
+	inline EntityList& EntityList::operator=(const EntityList& entityList)
 	{
-		return m_entities.empty();
+		if (this != &entityList)
+		{
+			EntityList copy(entityList);
+			operator=(std::move(copy));
+		}
+
+		return *this;
 	}
 
-	inline EntityList::Container::iterator EntityList::end()
+	inline EntityList& EntityList::operator=(EntityList&& entityList) noexcept
 	{
-		return m_entities.end();
+		if (this != &entityList)
+		{
+			if (m_registerToWorld && m_world)
+				m_world->UnregisterEntityList(this);
+
+			m_entities = std::move(entityList.m_entities);
+			m_entityBits = std::move(entityList.m_entityBits);
+			m_world = std::move(entityList.m_world);
+			m_registerToWorld = entityList.m_registerToWorld;
+
+			entityList.Clear(); // Le bitset déplacé garde sa taille
+
+			if (m_registerToWorld && m_world)
+				m_world->UpdateEntityList(&entityList, this);
+		}
+
+		return *this;
+	}
+
+	inline void EntityList::RemoveEntities(const Nz::Bitset<Nz::UInt64>& entities)
+	{
+		// Appelé par le monde pour les entités tuées, en une seule passe comme le flush des systèmes
+		if (!m_entityBits.Intersects(entities))
+			return;
+
+		m_entities.erase(std::remove_if(m_entities.begin(), m_entities.end(), [this, &entities] (const EntityGenerationalId& id)
+		{
+			if (!entities.UnboundedTest(id.id))
+				return false;
+
+			m_entityBits.Reset(id.id);
+			return true;
+		}), m_entities.end());
 	}
 
-	inline EntityList::Container::const_iterator EntityList::end() const
+	inline EntityList::iterator::iterator(World* world, Container::const_iterator it, Container::const_iterator end) :
+	m_iterator(it),
+	m_end(end),
+	m_world(world)
 	{
-		return m_entities.end();
+		SkipInvalidEntities();
 	}
 
-	inline EntityList::Container::reverse_iterator EntityList::rbegin()
+	inline Entity* EntityList::iterator::operator*() const
 	{
-		return m_entities.rbegin();
+		NazaraAssert(m_world->IsEntityIdValid(*m_iterator), "Entity is no longer valid");
+
+		// Le stockage des entités est relu à chaque accès, il peut être réalloué par la création d'une entité durant l'itération
+		return &m_world->m_entities[m_iterator->id].entity;
 	}
 
-	inline EntityList::Container::const_reverse_iterator EntityList::rbegin() const
+	inline EntityList::iterator& EntityList::iterator::operator++()
 	{
-		return m_entities.rbegin();
+		++m_iterator;
+		SkipInvalidEntities();
+
+		return *this;
 	}
 
-	inline EntityList::Container::reverse_iterator EntityList::rend()
+	inline EntityList::iterator EntityList::iterator::operator++(int)
 	{
-		return m_entities.rend();
+		iterator it(*this);
+		operator++();
+
+		return it;
 	}
 
-	inline EntityList::Container::const_reverse_iterator EntityList::rend() const
+	inline bool EntityList::iterator::operator==(const iterator& rhs) const
 	{
-		return m_entities.rend();
+		return m_iterator == rhs.m_iterator;
 	}
 
-	inline EntityList::Container::size_type EntityList::size() const
+	inline bool EntityList::iterator::operator!=(const iterator& rhs) const
 	{
-		return m_entities.size();
+		return m_iterator != rhs.m_iterator;
+	}
+
+	inline void EntityList::iterator::SkipInvalidEntities()
+	{
+		// Les listes ne gardent les identifiants des entités détruites que jusqu'à la fin de World::Update, qui les en retire
+		// (depuis les callbacks appelés durant la destruction, seule une liste non vide nécessitant un monde)
+		while (m_iterator != m_end && m_world->m_destroyingEntities && !m_world->IsEntityIdValid(*m_iterator))
+			++m_iterator;
 	}
 }
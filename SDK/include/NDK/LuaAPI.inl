@@ -100,8 +100,14 @@ namespace Nz
 		params->animated = instance.CheckField<bool>("Animated", params->animated);
 		params->center = instance.CheckField<bool>("Center", params->center);
 		params->flipUVs = instance.CheckField<bool>("FlipUVs", params->flipUVs);
+		params->levelOfDetailCount = instance.CheckField<unsigned int>("LevelOfDetailCount", params->levelOfDetailCount);
+		params->levelOfDetailReduction = instance.CheckField<float>("LevelOfDetailReduction", params->levelOfDetailReduction);
+		params->levelOfDetailScreenSize = instance.CheckField<float>("LevelOfDetailScreenSize", params->levelOfDetailScreenSize);
 		//params->matrix = instance.CheckField<Matrix4f>("Matrix", params->matrix);
 		params->optimizeIndexBuffers = instance.CheckField<bool>("OptimizeIndexBuffers", params->optimizeIndexBuffers);
+		params->optimizeOverdraw = instance.CheckField<bool>("OptimizeOverdraw", params->optimizeOverdraw);
+		params->optimizeVertexFetch = instance.CheckField<bool>("OptimizeVertexFetch", params->optimizeVertexFetch);
+		params->quantizeVertices = instance.CheckField<bool>("QuantizeVertices", params->quantizeVertices);
 
 		return 1;
 	}
@@ -321,6 +327,8 @@ namespace Nz
 		instance.CheckType(index, Nz::LuaType_Table);
 
 		params->forceMono = instance.CheckField<bool>("ForceMono", params->forceMono);
+		params->keepCompressed = instance.CheckField<bool>("KeepCompressed", params->keepCompressed);
+		params->sampleRate = instance.CheckField<unsigned int>("SampleRate", params->sampleRate);
 
 		return 1;
 	}
@@ -127,6 +127,8 @@ namespace Ndk
 	template<typename T>
 	int AddComponentOfType(Nz::LuaInstance& lua, EntityHandle& handle);
 
+	NDK_API void PushComponentCache(Nz::LuaInstance& lua, ComponentIndex index);
+
 	template<typename T>
 	int PushComponentOfType(Nz::LuaInstance& lua, BaseComponent& component);
 }
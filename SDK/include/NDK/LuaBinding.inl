@@ -30,8 +30,7 @@ namespace Ndk
 		static_assert(std::is_base_of<BaseComponent, T>::value, "ComponentType must inherit BaseComponent");
 
 		T& component = handle->AddComponent<T>();
-		lua.Push(component.CreateHandle());
-		return 1;
+		return PushComponentOfType<T>(lua, component);
 	}
 
 	template<typename T>
@@ -40,7 +39,25 @@ namespace Ndk
 		static_assert(std::is_base_of<BaseComponent, T>::value, "ComponentType must inherit BaseComponent");
 
 		T& rightComponent = static_cast<T&>(component);
+
+		// Le handle déjà donné au script est réutilisé tant qu'il désigne encore ce component
+		PushComponentCache(lua, T::componentIndex);
+		if (lua.GetRawField(&rightComponent) == Nz::LuaType_Userdata)
+		{
+			const Nz::ObjectHandle<T>& cachedHandle = *static_cast<Nz::ObjectHandle<T>*>(lua.ToUserdata(-1));
+			if (cachedHandle.GetObject() == &rightComponent)
+			{
+				lua.Remove(-2); //< Cache
+				return 1;
+			}
+		}
+		lua.Pop();
+
 		lua.Push(rightComponent.CreateHandle());
+		lua.PushValue(-1);
+		lua.SetRawField(&rightComponent, -3);
+
+		lua.Remove(-2); //< Cache
 		return 1;
 	}
 }
@@ -6,6 +6,7 @@
 #define NDK_SYSTEMS_GLOBAL_HPP
 
 #include <NDK/Systems/ListenerSystem.hpp>
+#include <NDK/Systems/NodeSystem.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
 #include <NDK/Systems/RenderSystem.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
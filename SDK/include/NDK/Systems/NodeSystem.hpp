@@ -0,0 +1,38 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_SYSTEMS_NODESYSTEM_HPP
+#define NDK_SYSTEMS_NODESYSTEM_HPP
+
+#include <Nazara/Utility/NodeHierarchy.hpp>
+#include <NDK/System.hpp>
+
+namespace Ndk
+{
+	class NDK_API NodeSystem : public System<NodeSystem>
+	{
+		public:
+			NodeSystem();
+			NodeSystem(const NodeSystem& system);
+			~NodeSystem() = default;
+
+			inline Nz::NodeHierarchy& GetHierarchy();
+			inline const Nz::NodeHierarchy& GetHierarchy() const;
+
+			static SystemIndex systemIndex;
+
+		private:
+			void OnEntityRemoved(Entity* entity) override;
+			void OnEntityValidation(Entity* entity, bool justAdded) override;
+			void OnUpdate(float elapsedTime) override;
+
+			Nz::NodeHierarchy m_hierarchy;
+	};
+}
+
+#include <NDK/Systems/NodeSystem.inl>
+
+#endif // NDK_SYSTEMS_NODESYSTEM_HPP
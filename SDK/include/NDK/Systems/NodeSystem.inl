@@ -0,0 +1,16 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+namespace Ndk
+{
+	inline Nz::NodeHierarchy& NodeSystem::GetHierarchy()
+	{
+		return m_hierarchy;
+	}
+
+	inline const Nz::NodeHierarchy& NodeSystem::GetHierarchy() const
+	{
+		return m_hierarchy;
+	}
+}
@@ -7,6 +7,7 @@
 #ifndef NDK_SYSTEMS_PHYSICSSYSTEM_HPP
 #define NDK_SYSTEMS_PHYSICSSYSTEM_HPP
 
+#include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Physics/PhysWorld.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
@@ -15,6 +16,8 @@ namespace Ndk
 {
 	class NDK_API PhysicsSystem : public System<PhysicsSystem>
 	{
+		friend class CollisionComponent;
+
 		public:
 			PhysicsSystem();
 			PhysicsSystem(const PhysicsSystem& system);
@@ -26,11 +29,18 @@ namespace Ndk
 			static SystemIndex systemIndex;
 
 		private:
+			void InvalidateStaticObject(Entity* entity);
+
+			void OnEntityRemoved(Entity* entity) override;
 			void OnEntityValidation(Entity* entity, bool justAdded) override;
 			void OnUpdate(float elapsedTime) override;
 
+			std::vector<EntityHandle> m_awakeObjects;
+			std::vector<EntityHandle> m_invalidatedStaticObjects;
+			std::vector<EntityHandle> m_movingStaticObjects;
 			EntityList m_dynamicObjects;
 			EntityList m_staticObjects;
+			Nz::Bitset<Nz::UInt64> m_awakeObjectBits;
 			Nz::PhysWorld m_world;
 	};
 }
@@ -8,18 +8,32 @@
 #ifndef NDK_SYSTEMS_RENDERSYSTEM_HPP
 #define NDK_SYSTEMS_RENDERSYSTEM_HPP
 
+#include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/GuillotineBinPack.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/DepthRenderTechnique.hpp>
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Math/BoxTree.hpp>
+#include <Nazara/Renderer/GpuQuery.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
+#include <algorithm>
+#include <array>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace Ndk
 {
+	class CameraComponent;
 	class GraphicsComponent;
+	class LightComponent;
+	class NodeComponent;
 
 	class NDK_API RenderSystem : public System<RenderSystem>
 	{
@@ -31,30 +45,191 @@ namespace Ndk
 			template<typename T> void ChangeRenderTechnique();
 			inline void ChangeRenderTechnique(std::unique_ptr<Nz::AbstractRenderTechnique>&& renderTechnique);
 
+			inline void EnableDynamicResolution(bool enable);
+			inline void EnableOcclusionCulling(bool enable);
+			inline void EnableParallelQueueFilling(bool enable);
+			inline void EnableShadowAtlas(bool enable);
+			inline void EnableSinglePassPointShadows(bool enable);
+
 			inline const Nz::BackgroundRef& GetDefaultBackground() const;
 			inline const Nz::Matrix4f& GetCoordinateSystemMatrix() const;
+			inline float GetDynamicResolutionTarget() const;
 			inline Nz::Vector3f GetGlobalForward() const;
 			inline Nz::Vector3f GetGlobalRight() const;
 			inline Nz::Vector3f GetGlobalUp() const;
 			inline Nz::AbstractRenderTechnique& GetRenderTechnique() const;
+			inline float GetResolutionScale() const;
+			inline Nz::PixelFormatType GetShadowAtlasFormat() const;
+			inline const Nz::Vector2ui& GetShadowAtlasSize() const;
+			inline unsigned int GetShadowMapUpdateBudget() const;
+
+			inline bool IsDynamicResolutionEnabled() const;
+			inline bool IsOcclusionCullingEnabled() const;
+			inline bool IsParallelQueueFillingEnabled() const;
+			inline bool IsShadowAtlasEnabled() const;
+			inline bool IsSinglePassPointShadowsEnabled() const;
 
 			inline void SetDefaultBackground(Nz::BackgroundRef background);
+			inline void SetDynamicResolutionLimits(float minScale, float maxScale);
+			inline void SetDynamicResolutionTarget(float gpuFrameTime);
 			inline void SetGlobalForward(const Nz::Vector3f& direction);
 			inline void SetGlobalRight(const Nz::Vector3f& direction);
 			inline void SetGlobalUp(const Nz::Vector3f& direction);
+			inline void SetShadowAtlasFormat(Nz::PixelFormatType format);
+			inline void SetShadowAtlasSize(const Nz::Vector2ui& size);
+			inline void SetShadowMapUpdateBudget(unsigned int lightCount);
 
 			static SystemIndex systemIndex;
 
 		private:
+			struct ResolutionTarget;
+			struct CubemapFaces;
+			struct ShadowMapCache;
+
 			inline void InvalidateCoordinateSystem();
+			inline void InvalidateShadowAtlas();
+			void InvalidateStaticShadowLayers(const Nz::Boxf& box);
+			template<typename T> void QueryDrawables(const T& volume, std::vector<std::size_t>* drawableIndices) const;
 
+			bool DrawShadowCasters(const Nz::Spheref& range, bool staticCasters, const CubemapFaces* cubemapFaces = nullptr);
+			ResolutionTarget* EnsureResolutionTarget(const CameraComponent& camera, std::size_t cameraIndex);
 			void OnEntityRemoved(Entity* entity) override;
 			void OnEntityValidation(Entity* entity, bool justAdded) override;
 			void OnUpdate(float elapsedTime) override;
+			void ReleaseShadowAtlasRegion(Entity* light);
+			void FillRenderQueue(const CameraComponent& camera, Nz::AbstractRenderQueue* renderQueue);
+			void FillRenderQueueParallel(const CameraComponent& camera, Nz::ForwardRenderQueue* renderQueue);
+			void IssueOcclusionQueries(const CameraComponent& camera, std::size_t cameraIndex);
+			void UpdateCullingData();
 			void UpdateDirectionalShadowMaps(const Nz::AbstractViewer& viewer);
+			void UpdateOcclusionResults(std::size_t cameraIndex);
+			void UpdatePointSpotShadowMap(const LightComponent& lightComponent, const NodeComponent& lightNode, ShadowMapCache& cache);
 			void UpdatePointSpotShadowMaps();
+			void UpdateResolutionScale();
+			void UpdateShadowAtlas();
+			void UpdateShadowCasters();
+			void UpscaleResolutionTarget(const CameraComponent& camera, ResolutionTarget& resolutionTarget);
+
+			class ScaledViewer : public Nz::AbstractViewer
+			{
+				public:
+					ScaledViewer() = default;
+					~ScaledViewer() = default;
+
+					void ApplyView() const override;
+
+					float GetAspectRatio() const override;
+					Nz::Vector3f GetEyePosition() const override;
+					Nz::Vector3f GetForward() const override;
+					const Nz::Frustumf& GetFrustum() const override;
+					const Nz::Matrix4f& GetProjectionMatrix() const override;
+					const Nz::RenderTarget* GetTarget() const override;
+					const Nz::Matrix4f& GetViewMatrix() const override;
+					const Nz::Recti& GetViewport() const override;
+					float GetZFar() const override;
+					float GetZNear() const override;
+
+					void Reset(const CameraComponent* camera, const Nz::RenderTarget* target, const Nz::Recti& viewport);
+
+				private:
+					const CameraComponent* m_camera = nullptr;
+					const Nz::RenderTarget* m_target = nullptr;
+					Nz::Recti m_viewport;
+			};
+
+			struct CullingData
+			{
+				std::unordered_map<EntityId, std::size_t> proxies; //< Drawables with a finite bounding volume
+				std::vector<std::size_t> infiniteDrawables; //< Always visible, they can't be culled
+				std::vector<std::size_t> shadowCasters; //< Drawables of the shadow map being updated
+				std::vector<std::size_t> visibleDrawables; //< Drawables of the camera being rendered
+				Nz::Bitset<Nz::UInt64> occlusion; //< Drawables hidden according to the last occlusion queries of the camera
+				Nz::Bitset<Nz::UInt64> visibility; //< Same as visibleDrawables, indexed by drawable
+				Nz::BoxTreef tree; //< Bounding boxes of the drawables, their user data being their index in m_drawables
+			};
+
+			struct CubemapFaces
+			{
+				std::array<Nz::Frustumf, 6> frustums;
+				std::array<Nz::Matrix4f, 6> viewMatrices; //< For the casters which can't be drawn to every face at once
+				std::array<Nz::Matrix4f, 6> viewProjMatrices;
+			};
+
+			struct DirectionalShadowCache
+			{
+				Nz::PixelFormatType format = Nz::PixelFormatType_Undefined;
+				Nz::Quaternionf rotation;
+				Nz::Rectui region;
+				Nz::Vector2ui size;
+				unsigned int cascadeCount = 0;
+			};
+
+			struct OcclusionQuery
+			{
+				std::unique_ptr<Nz::GpuQuery> query;
+				bool pending = false;
+				bool visible = true;
+			};
+
+			using OcclusionQueries = std::unordered_map<EntityId, OcclusionQuery>;
+
+			struct ShadowCaster
+			{
+				Nz::Boxf aabb;
+				unsigned int lastChangeFrame;
+			};
+
+			struct ShadowMapCache
+			{
+				Nz::TextureRef staticLayer; //< Depth of the static casters only
+				Nz::PixelFormatType format = Nz::PixelFormatType_Undefined;
+				Nz::Quaternionf rotation;
+				Nz::Rectui region;
+				Nz::Vector2ui size;
+				Nz::Vector3f position;
+				Nz::LightType type = Nz::LightType_Directional; //< Never cached, forces the first update
+				float outerAngle = 0.f;
+				float radius = 0.f;
+				unsigned int lastUpdateFrame = 0;
+				bool dirty = true; //< A caster changed in the range of the light since its last update
+				bool staticLayerValid = false;
+			};
+
+			struct QueueChunk
+			{
+				Nz::ForwardRenderQueue renderQueue;
+			};
+
+			struct ResolutionTarget
+			{
+				Nz::MaterialRef upscaleMaterial; //< Samples the color texture
+				Nz::RenderTexture renderTexture;
+				Nz::TextureRef colorTexture;
+				Nz::Vector2ui scaledSize; //< Part of the textures rendered to
+				Nz::Vector2ui size;
+				Nz::VertexBuffer upscaleQuad;
+				ScaledViewer viewer;
+			};
+
+			struct ResolutionTimer
+			{
+				std::vector<std::unique_ptr<Nz::GpuQuery>> queries; //< One per camera
+				std::size_t queryCount = 0;
+				bool pending = false;
+			};
 
 			std::unique_ptr<Nz::AbstractRenderTechnique> m_renderTechnique;
+			std::vector<std::unique_ptr<QueueChunk>> m_queueChunks;
+			std::vector<std::unique_ptr<ResolutionTarget>> m_resolutionTargets; //< One per camera
+			std::array<ResolutionTimer, 3> m_resolutionTimers; //< Read two frames later, to never wait for the GPU
+			std::unordered_map<EntityId, DirectionalShadowCache> m_directionalShadowCaches;
+			std::unordered_map<EntityId, Nz::Rectui> m_shadowAtlasRegions; //< Lights whose shadow map is a part of m_shadowAtlas
+			std::unordered_map<EntityId, ShadowCaster> m_shadowCasters;
+			std::unordered_map<EntityId, ShadowMapCache> m_shadowMapCaches;
+			std::vector<OcclusionQueries> m_occlusionQueries; //< One map per camera
+			std::vector<Entity*> m_shadowLightsToUpdate;
+			std::vector<Nz::Boxf> m_changedCasterBoxes; //< Previous and new boxes of the casters which changed this frame
+			CullingData m_cullingData;
 			EntityList m_cameras;
 			EntityList m_drawables;
 			EntityList m_directionalLights;
@@ -62,9 +237,28 @@ namespace Ndk
 			EntityList m_pointSpotLights;
 			Nz::BackgroundRef m_background;
 			Nz::DepthRenderTechnique m_shadowTechnique;
+			Nz::GuillotineBinPack m_shadowAtlasPacker;
+			Nz::IndexBuffer m_occlusionBoxIndices;
 			Nz::Matrix4f m_coordinateSystemMatrix;
+			Nz::PixelFormatType m_shadowAtlasFormat;
+			Nz::RenderTexture m_shadowCacheRT;
 			Nz::RenderTexture m_shadowRT;
+			Nz::TextureRef m_shadowAtlas; //< Shared by the spot and directional lights, created on first use
+			Nz::Vector2ui m_shadowAtlasSize;
+			Nz::VertexBuffer m_occlusionBoxVertices;
+			float m_maxResolutionScale;
+			float m_minResolutionScale;
+			float m_resolutionScale;
+			float m_resolutionTargetTime;
+			unsigned int m_frameIndex;
+			unsigned int m_shadowMapUpdateBudget;
 			bool m_coordinateSystemInvalidated;
+			bool m_dynamicResolution;
+			bool m_occlusionCulling;
+			bool m_parallelQueueFilling;
+			bool m_shadowAtlasEnabled;
+			bool m_shadowAtlasInvalidated;
+			bool m_singlePassPointShadows;
 	};
 }
 
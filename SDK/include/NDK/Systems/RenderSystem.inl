@@ -5,7 +5,21 @@
 namespace Ndk
 {
 	inline RenderSystem::RenderSystem(const RenderSystem& renderSystem) :
-	System(renderSystem)
+	System(renderSystem),
+	m_shadowAtlasFormat(renderSystem.m_shadowAtlasFormat),
+	m_shadowAtlasSize(renderSystem.m_shadowAtlasSize),
+	m_maxResolutionScale(renderSystem.m_maxResolutionScale),
+	m_minResolutionScale(renderSystem.m_minResolutionScale),
+	m_resolutionScale(renderSystem.m_maxResolutionScale),
+	m_resolutionTargetTime(renderSystem.m_resolutionTargetTime),
+	m_frameIndex(0),
+	m_shadowMapUpdateBudget(renderSystem.m_shadowMapUpdateBudget),
+	m_dynamicResolution(renderSystem.m_dynamicResolution),
+	m_occlusionCulling(renderSystem.m_occlusionCulling),
+	m_parallelQueueFilling(renderSystem.m_parallelQueueFilling),
+	m_shadowAtlasEnabled(renderSystem.m_shadowAtlasEnabled),
+	m_shadowAtlasInvalidated(false),
+	m_singlePassPointShadows(renderSystem.m_singlePassPointShadows)
 	{
 	}
 
@@ -20,6 +34,44 @@ namespace Ndk
 		m_renderTechnique = std::move(renderTechnique);
 	}
 
+	inline void RenderSystem::EnableDynamicResolution(bool enable)
+	{
+		m_dynamicResolution = enable;
+		if (!enable)
+		{
+			m_resolutionScale = m_maxResolutionScale;
+			m_resolutionTargets.clear();
+			for (ResolutionTimer& timer : m_resolutionTimers)
+				timer.pending = false;
+		}
+	}
+
+	inline void RenderSystem::EnableOcclusionCulling(bool enable)
+	{
+		m_occlusionCulling = enable;
+		if (!enable)
+			m_occlusionQueries.clear();
+	}
+
+	inline void RenderSystem::EnableParallelQueueFilling(bool enable)
+	{
+		m_parallelQueueFilling = enable;
+	}
+
+	inline void RenderSystem::EnableShadowAtlas(bool enable)
+	{
+		if (m_shadowAtlasEnabled != enable)
+		{
+			m_shadowAtlasEnabled = enable;
+			InvalidateShadowAtlas();
+		}
+	}
+
+	inline void RenderSystem::EnableSinglePassPointShadows(bool enable)
+	{
+		m_singlePassPointShadows = enable;
+	}
+
 	inline const Nz::BackgroundRef& RenderSystem::GetDefaultBackground() const
 	{
 		return m_background;
@@ -30,6 +82,11 @@ namespace Ndk
 		return m_coordinateSystemMatrix;
 	}
 
+	inline float RenderSystem::GetDynamicResolutionTarget() const
+	{
+		return m_resolutionTargetTime;
+	}
+
 	inline Nz::Vector3f RenderSystem::GetGlobalForward() const
 	{
 		return Nz::Vector3f(-m_coordinateSystemMatrix.m13, -m_coordinateSystemMatrix.m23, -m_coordinateSystemMatrix.m33);
@@ -50,11 +107,72 @@ namespace Ndk
 		return *m_renderTechnique.get();
 	}
 
+	inline float RenderSystem::GetResolutionScale() const
+	{
+		return m_resolutionScale;
+	}
+
+	inline Nz::PixelFormatType RenderSystem::GetShadowAtlasFormat() const
+	{
+		return m_shadowAtlasFormat;
+	}
+
+	inline const Nz::Vector2ui& RenderSystem::GetShadowAtlasSize() const
+	{
+		return m_shadowAtlasSize;
+	}
+
+	inline unsigned int RenderSystem::GetShadowMapUpdateBudget() const
+	{
+		return m_shadowMapUpdateBudget;
+	}
+
+	inline bool RenderSystem::IsDynamicResolutionEnabled() const
+	{
+		return m_dynamicResolution;
+	}
+
+	inline bool RenderSystem::IsOcclusionCullingEnabled() const
+	{
+		return m_occlusionCulling;
+	}
+
+	inline bool RenderSystem::IsParallelQueueFillingEnabled() const
+	{
+		return m_parallelQueueFilling;
+	}
+
+	inline bool RenderSystem::IsShadowAtlasEnabled() const
+	{
+		return m_shadowAtlasEnabled;
+	}
+
+	inline bool RenderSystem::IsSinglePassPointShadowsEnabled() const
+	{
+		return m_singlePassPointShadows;
+	}
+
 	inline void RenderSystem::SetDefaultBackground(Nz::BackgroundRef background)
 	{
 		m_background = std::move(background);
 	}
 
+	inline void RenderSystem::SetDynamicResolutionLimits(float minScale, float maxScale)
+	{
+		NazaraAssert(minScale > 0.f && minScale <= maxScale && maxScale <= 1.f, "Invalid resolution scale limits");
+
+		m_minResolutionScale = minScale;
+		m_maxResolutionScale = maxScale;
+		m_resolutionScale = Nz::Clamp(m_resolutionScale, minScale, maxScale);
+	}
+
+	inline void RenderSystem::SetDynamicResolutionTarget(float gpuFrameTime)
+	{
+		NazaraAssert(gpuFrameTime > 0.f, "Invalid frame time");
+
+		m_resolutionTargetTime = gpuFrameTime;
+	}
+
 	inline void RenderSystem::SetGlobalForward(const Nz::Vector3f& direction)
 	{
 		m_coordinateSystemMatrix.m13 = -direction.x;
@@ -82,8 +200,53 @@ namespace Ndk
 		InvalidateCoordinateSystem();
 	}
 
+	inline void RenderSystem::SetShadowAtlasFormat(Nz::PixelFormatType format)
+	{
+		NazaraAssert(Nz::PixelFormat::GetContent(format) == Nz::PixelFormatContent_DepthStencil, "Shadow atlas format is not a depth format");
+
+		if (m_shadowAtlasFormat != format)
+		{
+			m_shadowAtlasFormat = format;
+			InvalidateShadowAtlas();
+		}
+	}
+
+	inline void RenderSystem::SetShadowAtlasSize(const Nz::Vector2ui& size)
+	{
+		NazaraAssert(size.x > 0 && size.y > 0, "Shadow atlas size must be positive");
+
+		if (m_shadowAtlasSize != size)
+		{
+			m_shadowAtlasSize = size;
+			InvalidateShadowAtlas();
+		}
+	}
+
+	inline void RenderSystem::SetShadowMapUpdateBudget(unsigned int lightCount)
+	{
+		m_shadowMapUpdateBudget = lightCount;
+	}
+
 	inline void RenderSystem::InvalidateCoordinateSystem()
 	{
 		m_coordinateSystemInvalidated = true;
 	}
+
+	inline void RenderSystem::InvalidateShadowAtlas()
+	{
+		m_shadowAtlasInvalidated = true;
+	}
+
+	template<typename T>
+	void RenderSystem::QueryDrawables(const T& volume, std::vector<std::size_t>* drawableIndices) const
+	{
+		drawableIndices->assign(m_cullingData.infiniteDrawables.begin(), m_cullingData.infiniteDrawables.end());
+		m_cullingData.tree.Query(volume, [drawableIndices] (std::size_t drawableIndex)
+		{
+			drawableIndices->push_back(drawableIndex);
+		});
+
+		// Queued in the order of m_drawables, whatever the layout of the tree
+		std::sort(drawableIndices->begin(), drawableIndices->end());
+	}
 }
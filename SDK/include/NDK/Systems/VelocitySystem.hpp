@@ -7,7 +7,14 @@
 #ifndef NDK_SYSTEMS_VELOCITYSYSTEM_HPP
 #define NDK_SYSTEMS_VELOCITYSYSTEM_HPP
 
+#include <Nazara/Math/Vector3.hpp>
 #include <NDK/System.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class Node;
+}
 
 namespace Ndk
 {
@@ -21,6 +28,9 @@ namespace Ndk
 
 		private:
 			void OnUpdate(float elapsedTime) override;
+
+			std::vector<Nz::Node*> m_movedNodes;
+			std::vector<Nz::Vector3f> m_movements;
 	};
 }
 
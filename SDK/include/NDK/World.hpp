@@ -8,7 +8,9 @@
 #define NDK_WORLD_HPP
 
 #include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/HandledObject.hpp>
+#include <NDK/ComponentPool.hpp>
 #include <NDK/Entity.hpp>
 #include <NDK/System.hpp>
 #include <algorithm>
@@ -16,6 +18,11 @@
 #include <vector>
 #include <unordered_map>
 
+namespace Nz
+{
+	class ByteStream;
+}
+
 namespace Ndk
 {
 	class World;
@@ -25,9 +32,11 @@ namespace Ndk
 	class NDK_API World : public Nz::HandledObject<World>
 	{
 		friend Entity;
+		friend class Ndk::EntityList;
 
 		public:
 			using EntityList = std::vector<EntityHandle>;
+			using SnapshotEntityMap = std::unordered_map<EntityGenerationalId, EntityHandle>;
 
 			inline World(bool addDefaultSystems = true);
 			World(const World&) = delete;
@@ -40,12 +49,20 @@ namespace Ndk
 			template<typename SystemType, typename... Args> SystemType& AddSystem(Args&&... args);
 
 			const EntityHandle& CreateEntity();
-			inline EntityList CreateEntities(unsigned int count);
+			EntityList CreateEntities(unsigned int count);
+			EntityList CreateEntities(unsigned int count, const Entity* prototype);
+			EntityList CreateEntities(unsigned int count, const std::vector<const BaseComponent*>& components);
+			inline std::vector<EntityGenerationalId> CreateEntityIds(unsigned int count);
 
 			void Clear() noexcept;
 
+			inline Entity* FindEntity(EntityGenerationalId id);
+
+			BaseComponentPool& GetComponentPool(ComponentIndex index);
+			template<typename ComponentType> ComponentPool<ComponentType>& GetComponentPool();
 			const EntityHandle& GetEntity(EntityId id);
 			inline const EntityList& GetEntities();
+			inline const std::vector<EntityId>& GetEntityIds() const;
 			inline BaseSystem& GetSystem(SystemIndex index);
 			template<typename SystemType> SystemType& GetSystem();
 
@@ -53,25 +70,48 @@ namespace Ndk
 			template<typename SystemType> bool HasSystem() const;
 
 			void KillEntity(Entity* entity);
+			inline void KillEntity(EntityGenerationalId id);
 			inline void KillEntities(const EntityList& list);
+			inline void KillEntities(const std::vector<EntityGenerationalId>& list);
 
 			inline bool IsEntityValid(const Entity* entity) const;
 			inline bool IsEntityIdValid(EntityId id) const;
+			inline bool IsEntityIdValid(EntityGenerationalId id) const;
 
 			inline void RemoveAllSystems();
 			inline void RemoveSystem(SystemIndex index);
 			template<typename SystemType> void RemoveSystem();
 
+			bool SerializeSnapshot(Nz::ByteStream& stream, bool modifiedOnly = false);
+
+			bool UnserializeSnapshot(Nz::ByteStream& stream, SnapshotEntityMap* entities);
+
 			void Update();
-			inline void Update(float elapsedTime);
+			void Update(float elapsedTime);
 
 			World& operator=(const World&) = delete;
 			inline World& operator=(World&& world) noexcept;
 
 		private:
+			Entity& AllocateEntity();
+
 			inline void Invalidate();
 			inline void Invalidate(EntityId id);
 
+			inline void RegisterEntityList(Ndk::EntityList* list);
+
+			struct SnapshotChanges;
+
+			static bool ReadSnapshot(Nz::ByteStream& stream, SnapshotChanges* changes);
+
+			void ReserveEntities(std::size_t count);
+
+			inline void UnregisterEntityList(Ndk::EntityList* list);
+
+			void UpdateAliveHandles();
+			inline void UpdateEntityList(Ndk::EntityList* oldList, Ndk::EntityList* newList) noexcept;
+			void UpdateSystemStages();
+
 			struct EntityBlock
 			{
 				EntityBlock(Entity&& e) :
@@ -85,15 +125,36 @@ namespace Ndk
 				unsigned int aliveIndex;
 			};
 
+			struct SnapshotEntity
+			{
+				std::vector<Nz::ByteArray> componentData; //< By component index
+				Nz::Bitset<> componentBits;
+				Nz::UInt32 generation;
+				bool written = false;
+			};
+
+			std::vector<Ndk::EntityList*> m_entityLists; //< Except those of the systems, must outlive the systems and components owning lists
+			std::vector<std::unique_ptr<BaseComponentPool>> m_componentPools; //< Must outlive the entities
 			std::vector<std::unique_ptr<BaseSystem>> m_systems;
+			std::vector<std::vector<BaseSystem*>> m_systemStages; //< Systems of a stage do not conflict and are updated at the same time
 			std::vector<EntityBlock> m_entities;
+			std::vector<Nz::UInt32> m_entityGenerations; //< Survives Clear, so that no generational ID becomes valid again
 			std::vector<EntityId> m_freeIdList;
-			EntityList m_aliveEntities;
+			std::vector<SnapshotEntity> m_snapshotEntities; //< Entities as written by the last snapshot, by id
+			std::vector<EntityId> m_aliveEntities;
+			EntityList m_aliveHandles; //< Built on demand by the handle API, in the order of m_aliveEntities
 			Nz::Bitset<Nz::UInt64> m_dirtyEntities;
 			Nz::Bitset<Nz::UInt64> m_killedEntities;
+			std::size_t m_firstOutdatedAliveHandle;
+			bool m_destroyingEntities; //< From the destruction of the killed entities to the flush of the lists, which may still hold their ids
+			bool m_entitiesFullyInvalidated; //< Every system has to check the dirty entities, not only those filtering their changed components
+			bool m_systemStagesUpdated;
 	};
 }
 
 #include <NDK/World.inl>
 
+// EntityList a besoin de World pour retrouver ses entités, EntityList.hpp et BaseSystem.hpp nous incluent pour cela
+#include <NDK/EntityList.inl>
+
 #endif // NDK_WORLD_HPP
@@ -3,18 +3,27 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
 #include <type_traits>
 
 namespace Ndk
 {
-	inline World::World(bool addDefaultSystems)
+	inline World::World(bool addDefaultSystems) :
+	m_firstOutdatedAliveHandle(0),
+	m_destroyingEntities(false),
+	m_entitiesFullyInvalidated(false),
+	m_systemStagesUpdated(false)
 	{
 		if (addDefaultSystems)
 			AddDefaultSystems();
 	}
 
 	inline World::World(World&& world) noexcept :
-	HandledObject(std::move(world))
+	HandledObject(std::move(world)),
+	m_firstOutdatedAliveHandle(0),
+	m_destroyingEntities(false),
+	m_entitiesFullyInvalidated(false),
+	m_systemStagesUpdated(false)
 	{
 		operator=(std::move(world));
 	}
@@ -32,6 +41,7 @@ namespace Ndk
 		// Affectation et retour du système
 		m_systems[index] = std::move(system);
 		m_systems[index]->SetWorld(this);
+		m_systemStagesUpdated = false;
 
 		Invalidate(); // On force une mise à jour de toutes les entités
 
@@ -48,18 +58,46 @@ namespace Ndk
 		return static_cast<SystemType&>(AddSystem(std::move(ptr)));
 	}
 
-	inline World::EntityList World::CreateEntities(unsigned int count)
+	inline std::vector<EntityGenerationalId> World::CreateEntityIds(unsigned int count)
 	{
-		EntityList list;
+		///DOC: Aucun handle n'est créé pour ces entités
+		ReserveEntities(count);
+
+		std::vector<EntityGenerationalId> list;
 		list.reserve(count);
 
 		for (unsigned int i = 0; i < count; ++i)
-			list.emplace_back(CreateEntity());
+			list.emplace_back(AllocateEntity().GetGenerationalId());
 
 		return list;
 	}
 
+	inline Entity* World::FindEntity(EntityGenerationalId id)
+	{
+		if (!IsEntityIdValid(id))
+			return nullptr;
+
+		return &m_entities[id.id].entity;
+	}
+
+	template<typename ComponentType>
+	ComponentPool<ComponentType>& World::GetComponentPool()
+	{
+		static_assert(std::is_base_of<BaseComponent, ComponentType>::value, "ComponentType is not a component");
+
+		ComponentIndex index = GetComponentIndex<ComponentType>();
+		return static_cast<ComponentPool<ComponentType>&>(GetComponentPool(index));
+	}
+
 	inline const World::EntityList& World::GetEntities()
+	{
+		///DOC: Les handles des entités créées sans handle (CreateEntityIds) ne sont créés qu'à l'appel
+		UpdateAliveHandles();
+
+		return m_aliveHandles;
+	}
+
+	inline const std::vector<EntityId>& World::GetEntityIds() const
 	{
 		return m_aliveEntities;
 	}
@@ -99,12 +137,31 @@ namespace Ndk
 		return HasSystem(index);
 	}
 
+	inline void World::KillEntity(EntityGenerationalId id)
+	{
+		///DOC: Ignoré si l'entité est invalide
+		if (IsEntityIdValid(id))
+			m_killedEntities.UnboundedSet(id.id, true);
+	}
+
 	inline void World::KillEntities(const EntityList& list)
 	{
+		if (m_killedEntities.GetSize() < m_entities.size())
+			m_killedEntities.Resize(m_entities.size(), false);
+
 		for (const EntityHandle& entity : list)
 			KillEntity(entity);
 	}
 
+	inline void World::KillEntities(const std::vector<EntityGenerationalId>& list)
+	{
+		if (m_killedEntities.GetSize() < m_entities.size())
+			m_killedEntities.Resize(m_entities.size(), false);
+
+		for (EntityGenerationalId id : list)
+			KillEntity(id);
+	}
+
 	inline bool World::IsEntityValid(const Entity* entity) const
 	{
 		return entity && entity->GetWorld() == this && IsEntityIdValid(entity->GetId());
@@ -115,16 +172,25 @@ namespace Ndk
 		return id < m_entities.size() && m_entities[id].entity.IsValid();
 	}
 
+	inline bool World::IsEntityIdValid(EntityGenerationalId id) const
+	{
+		return IsEntityIdValid(id.id) && m_entityGenerations[id.id] == id.generation;
+	}
+
 	inline void World::RemoveAllSystems()
 	{
 		m_systems.clear();
+		m_systemStagesUpdated = false;
 	}
 
 	inline void World::RemoveSystem(SystemIndex index)
 	{
 		///DOC: N'a aucun effet si le système n'est pas présent
 		if (HasSystem(index))
+		{
 			m_systems[index].reset();
+			m_systemStagesUpdated = false;
+		}
 	}
 
 	template<typename SystemType>
@@ -136,22 +202,11 @@ namespace Ndk
 		RemoveSystem(index);
 	}
 
-	inline void World::Update(float elapsedTime)
-	{
-		Update(); //< Update entities
-
-		// And then update systems
-		for (auto& systemPtr : m_systems)
-		{
-			if (systemPtr)
-				systemPtr->Update(elapsedTime);
-		}
-	}
-
 	inline void World::Invalidate()
 	{
 		m_dirtyEntities.Resize(m_entities.size(), false);
 		m_dirtyEntities.Set(true); // Activation de tous les bits
+		m_entitiesFullyInvalidated = true;
 	}
 
 	inline void World::Invalidate(EntityId id)
@@ -159,20 +214,66 @@ namespace Ndk
 		m_dirtyEntities.UnboundedSet(id, true);
 	}
 
+	inline void World::RegisterEntityList(Ndk::EntityList* list)
+	{
+		m_entityLists.push_back(list);
+	}
+
+	inline void World::UnregisterEntityList(Ndk::EntityList* list)
+	{
+		auto it = std::find(m_entityLists.begin(), m_entityLists.end(), list);
+		NazaraAssert(it != m_entityLists.end(), "List is not registered");
+
+		// On remplace la liste par la dernière avant de la retirer
+		*it = m_entityLists.back();
+		m_entityLists.pop_back();
+	}
+
+	inline void World::UpdateEntityList(Ndk::EntityList* oldList, Ndk::EntityList* newList) noexcept
+	{
+		std::replace(m_entityLists.begin(), m_entityLists.end(), oldList, newList);
+	}
+
 	inline World& World::operator=(World&& world) noexcept
 	{
 		m_aliveEntities  = std::move(world.m_aliveEntities);
+		m_aliveHandles   = std::move(world.m_aliveHandles);
+		m_firstOutdatedAliveHandle = world.m_firstOutdatedAliveHandle;
 		m_dirtyEntities  = std::move(world.m_dirtyEntities);
 		m_freeIdList     = std::move(world.m_freeIdList);
 		m_killedEntities = std::move(world.m_killedEntities);
+		m_snapshotEntities = std::move(world.m_snapshotEntities);
+		m_entitiesFullyInvalidated = world.m_entitiesFullyInvalidated;
 
+		// Nos entités rendent leurs components à nos pools avant que ceux-ci ne soient remplacés
 		m_entities = std::move(world.m_entities);
 		for (EntityBlock& block : m_entities)
 			block.entity.SetWorld(this);
 
+		m_entityGenerations = std::move(world.m_entityGenerations);
+
+		m_componentPools = std::move(world.m_componentPools);
+
 		m_systems = std::move(world.m_systems);
 		for (const auto& systemPtr : m_systems)
-			systemPtr->SetWorld(this);
+		{
+			if (systemPtr)
+				systemPtr->SetWorld(this);
+		}
+
+		m_systemStagesUpdated = false;
+		world.m_systemStagesUpdated = false;
+
+		// Nos listes d'entités restent les nôtres mais leurs entités ont été détruites, celles de l'autre monde nous suivent
+		for (Ndk::EntityList* list : m_entityLists)
+			list->Clear();
+
+		for (Ndk::EntityList* list : world.m_entityLists)
+		{
+			list->m_world = CreateHandle();
+			m_entityLists.push_back(list);
+		}
+		world.m_entityLists.clear();
 
 		return *this;
 	}
@@ -3,9 +3,47 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/Application.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace Ndk
 {
+	namespace
+	{
+		// Sleeps may last a few more milliseconds than asked, the end of the frame is waited actively
+		const Nz::UInt64 s_frameSpinDuration = 2000;
+	}
+
+	Application::FrameTimeStatistics Application::GetFrameTimeStatistics() const
+	{
+		FrameTimeStatistics statistics;
+		statistics.frameCount = m_frameTimes.size();
+		if (m_frameTimes.empty())
+			return statistics;
+
+		std::vector<float> sortedTimes(m_frameTimes);
+		std::sort(sortedTimes.begin(), sortedTimes.end());
+
+		float sum = 0.f;
+		for (float frameTime : sortedTimes)
+			sum += frameTime;
+
+		// Nearest-rank percentiles
+		auto Percentile = [&sortedTimes] (float percent)
+		{
+			std::size_t rank = static_cast<std::size_t>(std::ceil(percent * sortedTimes.size()));
+			return sortedTimes[std::max<std::size_t>(rank, 1) - 1];
+		};
+
+		statistics.average = sum / sortedTimes.size();
+		statistics.max = sortedTimes.back();
+		statistics.percentile95 = Percentile(0.95f);
+		statistics.percentile99 = Percentile(0.99f);
+
+		return statistics;
+	}
+
 	bool Application::Run()
 	{
 		#ifndef NDK_SERVER
@@ -36,14 +74,47 @@ namespace Ndk
 		if (m_shouldQuit)
 			return false;
 
+		if (m_frameRateLimit > 0.f)
+			WaitForNextFrame();
+
 		m_updateTime = m_updateClock.GetSeconds();
 		m_updateClock.Restart();
 
+		if (m_frameTimeHistorySize > 0)
+		{
+			if (m_frameTimes.size() < m_frameTimeHistorySize)
+				m_frameTimes.push_back(m_updateTime);
+			else
+			{
+				m_frameTimes[m_frameTimeIndex] = m_updateTime;
+				m_frameTimeIndex = (m_frameTimeIndex + 1) % m_frameTimeHistorySize;
+			}
+		}
+
 		for (World& world : m_worlds)
 			world.Update(m_updateTime);
 
 		return true;
 	}
 
+	void Application::SetFrameTimeHistorySize(std::size_t frameCount)
+	{
+		m_frameTimeHistorySize = frameCount;
+
+		m_frameTimes.clear();
+		m_frameTimeIndex = 0;
+	}
+
+	void Application::WaitForNextFrame()
+	{
+		Nz::UInt64 frameDuration = static_cast<Nz::UInt64>(1000000.f / m_frameRateLimit);
+
+		Nz::UInt64 elapsedTime = m_updateClock.GetMicroseconds();
+		if (elapsedTime + s_frameSpinDuration < frameDuration)
+			Nz::Thread::Sleep(static_cast<Nz::UInt32>((frameDuration - elapsedTime - s_frameSpinDuration) / 1000));
+
+		while (m_updateClock.GetMicroseconds() < frameDuration);
+	}
+
 	Application* Application::s_application = nullptr;
 }
\ No newline at end of file
@@ -3,11 +3,28 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/BaseComponent.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 
 namespace Ndk
 {
 	BaseComponent::~BaseComponent() = default;
 
+	bool BaseComponent::Serialize(Nz::ByteStream& stream) const
+	{
+		NazaraUnused(stream);
+
+		NazaraError("Component is not serializable");
+		return false;
+	}
+
+	bool BaseComponent::Unserialize(Nz::ByteStream& stream)
+	{
+		NazaraUnused(stream);
+
+		NazaraError("Component is not serializable");
+		return false;
+	}
+
 	void BaseComponent::OnAttached()
 	{
 	}
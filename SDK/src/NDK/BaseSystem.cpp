@@ -3,13 +3,22 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/BaseSystem.hpp>
+#include <NDK/World.hpp>
+#include <algorithm>
 
 namespace Ndk
 {
 	BaseSystem::~BaseSystem()
 	{
-		for (const EntityHandle& entity : m_entities)
-			entity->UnregisterSystem(m_systemIndex);
+		// Les entités retirées depuis le dernier FlushRemovedEntities ne font déjà plus partie du système
+		for (const EntityGenerationalId& id : m_entities.m_entities)
+		{
+			if (m_entities.Has(id.id))
+			{
+				if (Entity* entity = m_world->FindEntity(id))
+					entity->UnregisterSystem(m_systemIndex);
+			}
+		}
 	}
 
 	bool BaseSystem::Filters(const Entity* entity) const
@@ -17,26 +26,40 @@ namespace Ndk
 		if (!entity)
 			return false;
 
-		const Nz::Bitset<>& components = entity->GetComponentBits();
+		auto components = Nz::MakeBitsetExpression(entity->GetComponentBits());
 
-		m_filterResult.PerformsAND(m_requiredComponents, components);
-		if (m_filterResult !=  m_requiredComponents)
+		if ((m_requiredComponents & ~components).TestAny())
 			return false; // Au moins un component requis n'est pas présent
 
-		m_filterResult.PerformsAND(m_excludedComponents, components);
-		if (m_filterResult.TestAny())
+		if ((m_excludedComponents & components).TestAny())
 			return false; // Au moins un component exclu est présent
 
 		// Si nous avons une liste de composants nécessaires
 		if (m_requiredAnyComponents.TestAny())
 		{
-			if (!m_requiredAnyComponents.Intersects(components))
+			if (!m_requiredAnyComponents.Intersects(entity->GetComponentBits()))
 				return false;
 		}
 
 		return true;
 	}
 
+	void BaseSystem::FlushRemovedEntities()
+	{
+		if (!m_hasRemovedEntities)
+			return;
+
+		// Les entités retirées ne sont plus dans les bits de la liste, celles détruites n'ont plus la même génération
+		// (leur identifiant a pu être réutilisé par une entité ajoutée depuis)
+		EntityList::Container& entities = m_entities.m_entities;
+		entities.erase(std::remove_if(entities.begin(), entities.end(), [this] (const EntityGenerationalId& id)
+		{
+			return !m_entities.Has(id.id) || !m_world->IsEntityIdValid(id);
+		}), entities.end());
+
+		m_hasRemovedEntities = false;
+	}
+
 	void BaseSystem::OnEntityAdded(Entity* entity)
 	{
 		NazaraUnused(entity);
@@ -0,0 +1,20 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/ComponentPool.hpp>
+#include <algorithm>
+
+namespace Ndk
+{
+	BaseComponentPool::~BaseComponentPool() = default;
+
+	// Grows geometrically, so that successive reservations stay amortized
+	void BaseComponentPool::Reserve(std::size_t count)
+	{
+		if (count > m_entityIds.capacity())
+			m_entityIds.reserve(std::max(count, 2 * m_entityIds.capacity()));
+	}
+
+	constexpr std::size_t BaseComponentPool::InvalidIndex;
+}
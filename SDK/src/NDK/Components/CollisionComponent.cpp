@@ -6,6 +6,7 @@
 #include <Nazara/Physics/PhysObject.hpp>
 #include <NDK/Algorithm.hpp>
 #include <NDK/World.hpp>
+#include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
 
@@ -39,30 +40,53 @@ namespace Ndk
 
 		m_staticBody.reset(new Nz::PhysObject(&physWorld, m_geom));
 		m_staticBody->EnableAutoSleep(false);
+
+		// Its pose will be set by the PhysicsSystem once the entity is validated
+		m_bodyUpdated = false;
 	}
 
 	void CollisionComponent::OnAttached()
 	{
 		if (!m_entity->HasComponent<PhysicsComponent>())
 			InitializeStaticBody();
+
+		if (m_entity->HasComponent<NodeComponent>())
+			m_nodeInvalidationSlot.Connect(m_entity->GetComponent<NodeComponent>().OnNodeInvalidation, this, &CollisionComponent::OnNodeInvalidated);
 	}
 
 	void CollisionComponent::OnComponentAttached(BaseComponent& component)
 	{
-		if (IsComponent<PhysicsComponent>(component))
+		if (IsComponent<NodeComponent>(component))
+			m_nodeInvalidationSlot.Connect(static_cast<NodeComponent&>(component).OnNodeInvalidation, this, &CollisionComponent::OnNodeInvalidated);
+		else if (IsComponent<PhysicsComponent>(component))
 			m_staticBody.reset();
 	}
 
 	void CollisionComponent::OnComponentDetached(BaseComponent& component)
 	{
-		if (IsComponent<PhysicsComponent>(component))
+		if (IsComponent<NodeComponent>(component))
+			m_nodeInvalidationSlot.Disconnect();
+		else if (IsComponent<PhysicsComponent>(component))
 			InitializeStaticBody();
 	}
 
 	void CollisionComponent::OnDetached()
 	{
+		m_nodeInvalidationSlot.Disconnect();
 		m_staticBody.reset();
 	}
 
+	void CollisionComponent::OnNodeInvalidated(const Nz::Node* node)
+	{
+		NazaraUnused(node);
+
+		// Static bodies follow their node, but only when it actually moves
+		if (m_staticBody && m_bodyUpdated)
+		{
+			m_bodyUpdated = false;
+			m_entity->GetWorld()->GetSystem<PhysicsSystem>().InvalidateStaticObject(m_entity);
+		}
+	}
+
 	ComponentIndex CollisionComponent::componentIndex;
 }
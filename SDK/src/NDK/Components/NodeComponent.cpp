@@ -3,8 +3,35 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/Components/NodeComponent.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 
 namespace Ndk
 {
+	bool NodeComponent::Serialize(Nz::ByteStream& stream) const
+	{
+		// Seule la transformation locale est écrite, le parent n'est pas transmis
+		Nz::Vector3f transform[2] = {GetPosition(Nz::CoordSys_Local), GetScale(Nz::CoordSys_Local)};
+		if (!stream.WriteArray(transform, 2))
+			return false;
+
+		stream << GetRotation(Nz::CoordSys_Local);
+		return true;
+	}
+
+	bool NodeComponent::Unserialize(Nz::ByteStream& stream)
+	{
+		Nz::Vector3f transform[2];
+		if (!stream.ReadArray(transform, 2))
+			return false;
+
+		Nz::Quaternionf rotation;
+		stream >> rotation;
+
+		SetPosition(transform[0]);
+		SetRotation(rotation);
+		SetScale(transform[1]);
+		return true;
+	}
+
 	ComponentIndex NodeComponent::componentIndex;
 }
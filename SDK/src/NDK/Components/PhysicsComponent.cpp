@@ -31,6 +31,7 @@ namespace Ndk
 
 		m_object.reset(new Nz::PhysObject(&world, geom, matrix));
 		m_object->SetMass(1.f);
+		m_object->SetUserdata(this); //< Used by the PhysicsSystem to find the entities moved by the physics
 	}
 
 	void PhysicsComponent::OnComponentAttached(BaseComponent& component)
@@ -3,8 +3,19 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/Components/VelocityComponent.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 
 namespace Ndk
 {
+	bool VelocityComponent::Serialize(Nz::ByteStream& stream) const
+	{
+		return stream.WriteArray(&linearVelocity, 1);
+	}
+
+	bool VelocityComponent::Unserialize(Nz::ByteStream& stream)
+	{
+		return stream.ReadArray(&linearVelocity, 1);
+	}
+
 	ComponentIndex VelocityComponent::componentIndex;
 }
@@ -9,8 +9,6 @@
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/World.hpp>
 
-///TODO: For now is unable to display different color in the history, it needs a RichTextDrawer to do so
-
 namespace Ndk
 {
 	namespace
@@ -20,10 +18,14 @@ namespace Ndk
 	}
 
 	Console::Console(World& world, const Nz::Vector2f& size, Nz::LuaInstance& instance) :
+	m_historyCapacity(1000),
+	m_historyFirstLine(0),
+	m_historyLineCount(0),
 	m_historyPosition(0),
 	m_defaultFont(Nz::Font::GetDefault()),
 	m_instance(instance),
 	m_size(size),
+	m_historyInvalidated(false),
 	m_opened(false),
 	m_characterSize(24)
 	{
@@ -43,16 +45,11 @@ namespace Ndk
 		m_historyBackground->AddComponent<Ndk::GraphicsComponent>().Attach(m_historyBackgroundSprite, -1);
 		m_historyBackground->AddComponent<Ndk::NodeComponent>().SetParent(this);
 
-		// History
+		// History (its rows are created by Layout)
 		m_historyDrawer.SetCharacterSize(m_characterSize);
-		m_historyDrawer.SetColor(Nz::Color(200, 200, 200));
 		m_historyDrawer.SetFont(m_defaultFont);
 
-		m_historyTextSprite = Nz::TextSprite::New();
-
 		m_history = world.CreateEntity();
-		m_history->Enable(m_opened);
-		m_history->AddComponent<Ndk::GraphicsComponent>().Attach(m_historyTextSprite);
 
 		Ndk::NodeComponent& historyNode = m_history->AddComponent<Ndk::NodeComponent>();
 		historyNode.SetParent(this);
@@ -95,9 +92,13 @@ namespace Ndk
 	void Console::Clear()
 	{
 		m_historyLines.clear();
+		m_historyFirstLine = m_historyLineCount;
+
 		RefreshHistory();
 	}
 
+	constexpr std::size_t Console::InvalidLineNumber;
+
 	void Console::SendCharacter(char32_t character)
 	{
 		switch (character)
@@ -167,6 +168,9 @@ namespace Ndk
 				}
 				break;
 			}
+
+			default:
+				break;
 		}
 	}
 
@@ -175,13 +179,32 @@ namespace Ndk
 		m_characterSize = size;
 
 		m_historyDrawer.SetCharacterSize(m_characterSize);
-		m_historyTextSprite->Update(m_historyDrawer);
 		m_inputDrawer.SetCharacterSize(m_characterSize);
 		m_inputTextSprite->Update(m_inputDrawer);
 
 		Layout();
 	}
 
+	void Console::SetHistoryCapacity(std::size_t capacity)
+	{
+		NazaraAssert(capacity > 0, "History capacity must be over zero");
+
+		// Les lignes les plus récentes sont conservées, remises dans l'ordre
+		std::size_t keptLineCount = std::min(capacity, m_historyLines.size());
+		std::size_t firstLine = m_historyLineCount - keptLineCount;
+
+		std::vector<Line> lines;
+		lines.reserve(keptLineCount);
+		for (std::size_t i = firstLine; i < m_historyLineCount; ++i)
+			lines.push_back(std::move(m_historyLines[(i - m_historyFirstLine) % m_historyCapacity]));
+
+		m_historyCapacity = capacity;
+		m_historyFirstLine = firstLine;
+		m_historyLines = std::move(lines);
+
+		RefreshHistory();
+	}
+
 	void Console::SetSize(const Nz::Vector2f& size)
 	{
 		m_size = size;
@@ -205,17 +228,30 @@ namespace Ndk
 		if (m_opened != show)
 		{
 			m_historyBackground->Enable(show);
-			m_history->Enable(show);
 			m_input->Enable(show);
 			m_inputBackground->Enable(show);
 
+			for (HistoryRow& row : m_historyRows)
+				row.entity->Enable(show);
+
 			m_opened = show;
+
+			// Les lignes ajoutées en l'absence de la console sont mises en page en une fois
+			if (m_opened && m_historyInvalidated)
+				RefreshHistory();
 		}
 	}
 
 	void Console::AddLineInternal(const Nz::String& text, const Nz::Color& color)
 	{
-		m_historyLines.emplace_back(Line{color, text});
+		// Une fois la capacité atteinte, la nouvelle ligne remplace la plus ancienne
+		std::size_t index = (m_historyLineCount - m_historyFirstLine) % m_historyCapacity;
+		if (index < m_historyLines.size())
+			m_historyLines[index] = Line{color, text};
+		else
+			m_historyLines.emplace_back(Line{color, text});
+
+		m_historyLineCount++;
 	}
 
 	void Console::ExecuteInput()
@@ -252,32 +288,77 @@ namespace Ndk
 		Ndk::NodeComponent& historyNode = m_history->GetComponent<Ndk::NodeComponent>();
 		historyNode.SetPosition(0.f, historyHeight - m_maxHistoryLines * lineHeight);
 
+		// One row per visible line, all of them have to be laid out again
+		World* world = m_history->GetWorld();
+		m_historyRows.resize(m_maxHistoryLines);
+		for (HistoryRow& row : m_historyRows)
+		{
+			if (!row.entity)
+			{
+				row.textSprite = Nz::TextSprite::New();
+
+				row.entity = world->CreateEntity();
+				row.entity->Enable(m_opened);
+				row.entity->AddComponent<Ndk::GraphicsComponent>().Attach(row.textSprite);
+				row.entity->AddComponent<Ndk::NodeComponent>().SetParent(m_history);
+			}
+
+			row.lineNumber = InvalidLineNumber;
+		}
+
 		Ndk::NodeComponent& inputBackgroundNode = m_inputBackground->GetComponent<Ndk::NodeComponent>();
 		inputBackgroundNode.SetPosition(0.f, historyHeight + 2.f);
 
 		m_inputBackgroundSprite->SetSize(m_size.x, m_size.y - historyHeight);
+
+		RefreshHistory();
 	}
 
 	void Console::RefreshHistory()
 	{
-		m_historyDrawer.Clear();
-		auto it = m_historyLines.end();
-		if (m_historyLines.size() > m_maxHistoryLines)
-			it -= m_maxHistoryLines;
-		else
-			it = m_historyLines.begin();
+		// A hidden console waits to be shown, many lines may be added until then
+		if (!m_opened)
+		{
+			m_historyInvalidated = true;
+			return;
+		}
+
+		m_historyInvalidated = false;
+
+		if (m_historyRows.empty())
+			return;
+
+		unsigned int lineHeight = m_defaultFont->GetSizeInfo(m_characterSize).lineHeight;
+		std::size_t rowCount = m_historyRows.size();
+		std::size_t firstLine = GetFirstLineNumber();
 
-		for (unsigned int i = 0; i < m_maxHistoryLines; ++i)
+		// The last lines fill the rows from the bottom, only the lines which were not laid out yet are
+		for (std::size_t i = 0; i < rowCount; ++i)
 		{
-			if (m_maxHistoryLines - i <= m_historyLines.size() && it != m_historyLines.end())
+			std::size_t lineNumber = m_historyLineCount + i;
+			if (lineNumber < rowCount || lineNumber - rowCount < firstLine)
+				lineNumber = InvalidLineNumber; //< Above the oldest line
+			else
+				lineNumber -= rowCount;
+
+			HistoryRow& row = m_historyRows[(m_historyLineCount + i) % rowCount]; //< lineNumber % rowCount for the valid lines
+			if (row.lineNumber != lineNumber)
 			{
-				m_historyDrawer.AppendText(it->text);
-				++it;
+				if (lineNumber != InvalidLineNumber)
+				{
+					const Line& line = m_historyLines[(lineNumber - m_historyFirstLine) % m_historyCapacity];
+
+					m_historyDrawer.SetColor(line.color);
+					m_historyDrawer.SetText(line.text);
+					row.textSprite->Update(m_historyDrawer);
+				}
+				else
+					row.textSprite->Clear();
+
+				row.lineNumber = lineNumber;
 			}
 
-			m_historyDrawer.AppendText(Nz::String('\n'));
+			row.entity->GetComponent<Ndk::NodeComponent>().SetPosition(0.f, static_cast<float>(i * lineHeight));
 		}
-
-		m_historyTextSprite->Update(m_historyDrawer);
 	}
 }
@@ -12,23 +12,34 @@ namespace Ndk
 	HandledObject(std::move(entity)),
 	m_components(std::move(entity.m_components)),
 	m_componentBits(std::move(entity.m_componentBits)),
+	m_invalidatedComponentBits(std::move(entity.m_invalidatedComponentBits)),
 	m_systemBits(std::move(entity.m_systemBits)),
 	m_id(entity.m_id),
+	m_generation(entity.m_generation),
 	m_world(entity.m_world),
 	m_enabled(entity.m_enabled),
+	m_fullyInvalidated(entity.m_fullyInvalidated),
 	m_valid(entity.m_valid)
 	{
 	}
 
 	Entity::Entity(World* world, EntityId id) :
 	m_id(id),
-	m_world(world)
+	m_generation(0),
+	m_world(world),
+	m_enabled(false),
+	m_fullyInvalidated(false),
+	m_valid(false)
 	{
 	}
 
 	Entity::~Entity()
 	{
 		Destroy();
+
+		// Une entité déplacée n'a plus de components
+		for (std::size_t i = 0; i < m_components.size(); ++i)
+			DestroyComponent(static_cast<ComponentIndex>(i));
 	}
 
 	BaseComponent& Entity::AddComponent(std::unique_ptr<BaseComponent>&& componentPtr)
@@ -36,28 +47,10 @@ namespace Ndk
 		NazaraAssert(componentPtr, "Component must be valid");
 
 		ComponentIndex index = componentPtr->GetIndex();
+		DestroyComponent(index);
 
-		// Nous nous assurons que le vecteur de component est suffisamment grand pour contenir le nouveau component
-		if (index >= m_components.size())
-			m_components.resize(index + 1);
-
-		// Affectation et retour du component
-		m_components[index] = std::move(componentPtr);
-		m_componentBits.UnboundedSet(index);
-
-		Invalidate();
-
-		// On récupère le component et on informe les composants existants du nouvel arrivant
-		BaseComponent& component = *m_components[index].get();
-		component.SetEntity(this);
-
-		for (std::size_t i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
-		{
-			if (i != index)
-				m_components[i]->OnComponentAttached(component);
-		}
-
-		return component;
+		// Le pool prend possession du component
+		return AttachComponent(GetComponentPool(index).Add(m_id, std::move(componentPtr)));
 	}
 
 	void Entity::Kill()
@@ -67,6 +60,9 @@ namespace Ndk
 
 	void Entity::Invalidate()
 	{
+		// Tous les systèmes devront réévaluer l'entité
+		m_fullyInvalidated = true;
+
 		// On informe le monde que nous avons besoin d'une mise à jour
 		m_world->Invalidate(m_id);
 	}
@@ -79,8 +75,6 @@ namespace Ndk
 		NazaraAssert(m_componentBits.TestNone(), "All components should be gone");
 
 		m_components.clear();
-
-		Invalidate();
 	}
 
 	void Entity::RemoveComponent(ComponentIndex index)
@@ -89,7 +83,7 @@ namespace Ndk
 		if (HasComponent(index))
 		{
 			// On récupère le component et on informe les composants du détachement
-			BaseComponent& component = *m_components[index].get();
+			BaseComponent& component = *m_components[index];
 			for (std::size_t i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
 			{
 				if (i != index)
@@ -98,16 +92,42 @@ namespace Ndk
 
 			component.SetEntity(nullptr);
 
-			m_components[index].reset();
-			m_componentBits.Reset(index);
+			DestroyComponent(index);
 
-			Invalidate();
+			InvalidateComponent(index);
 		}
 	}
 
-	void Entity::Create()
+	BaseComponent& Entity::AttachComponent(BaseComponent& component)
 	{
+		ComponentIndex index = component.GetIndex();
+
+		// Nous nous assurons que le vecteur de component est suffisamment grand pour contenir le nouveau component
+		if (index >= m_components.size())
+			m_components.resize(index + 1, nullptr);
+
+		m_components[index] = &component;
+		m_componentBits.UnboundedSet(index);
+
+		InvalidateComponent(index);
+
+		// On informe les composants existants du nouvel arrivant
+		component.SetEntity(this);
+
+		for (std::size_t i = m_componentBits.FindFirst(); i != m_componentBits.npos; i = m_componentBits.FindNext(i))
+		{
+			if (i != index)
+				m_components[i]->OnComponentAttached(component);
+		}
+
+		return component;
+	}
+
+	void Entity::Create(Nz::UInt32 generation)
+	{
+		m_generation = generation;
 		m_enabled = true;
+		m_fullyInvalidated = true;
 		m_valid = true;
 	}
 
@@ -124,8 +144,34 @@ namespace Ndk
 		}
 		m_systemBits.Clear();
 
+		ResetInvalidation();
 		UnregisterAllHandles();
 
 		m_valid = false;
 	}
+
+	void Entity::DestroyComponent(ComponentIndex index)
+	{
+		// Destruction sans notification, le component est simplement rendu à son pool
+		if (index < m_components.size() && m_components[index])
+		{
+			GetComponentPool(index).Remove(m_id);
+
+			m_components[index] = nullptr;
+			m_componentBits.Reset(index);
+		}
+	}
+
+	void Entity::InvalidateComponent(ComponentIndex index)
+	{
+		// Seuls les systèmes filtrant ce component devront réévaluer l'entité
+		m_invalidatedComponentBits.UnboundedSet(index);
+
+		m_world->Invalidate(m_id);
+	}
+
+	BaseComponentPool& Entity::GetComponentPool(ComponentIndex index) const
+	{
+		return m_world->GetComponentPool(index);
+	}
 }
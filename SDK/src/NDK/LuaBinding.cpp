@@ -80,4 +80,32 @@ namespace Ndk
 		RegisterRenderer(instance);
 		#endif
 	}
+
+	void PushComponentCache(Nz::LuaInstance& lua, ComponentIndex index)
+	{
+		// Component handles by component address, one weak table per component type (addresses are reused by the pools)
+		if (lua.GetField("NdkComponentCache", Nz::LuaInstance::GetRegistryIndex()) != Nz::LuaType_Table)
+		{
+			lua.Pop();
+			lua.PushTable();
+			lua.PushValue(-1);
+			lua.SetField("NdkComponentCache", Nz::LuaInstance::GetRegistryIndex());
+		}
+
+		if (lua.GetRawField(index) != Nz::LuaType_Table)
+		{
+			lua.Pop();
+			lua.PushTable();
+
+			lua.PushTable(0, 1);
+			lua.PushString("v");
+			lua.SetField("__mode");
+			lua.SetMetatable(-2);
+
+			lua.PushValue(-1);
+			lua.SetRawField(index, -3);
+		}
+
+		lua.Remove(-2);
+	}
 }
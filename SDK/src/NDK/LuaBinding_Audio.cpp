@@ -140,7 +140,13 @@ namespace Ndk
 
 		soundBuffer.BindMethod("GetSamples", [] (Nz::LuaInstance& lua, Nz::SoundBufferRef& instance) -> int
 		{
-			lua.PushString(reinterpret_cast<const char*>(instance->GetSamples()), instance->GetSampleCount() * sizeof(Nz::Int16));
+			// Compressed buffers have no samples to expose
+			const Nz::Int16* samples = instance->GetSamples();
+			if (samples)
+				lua.PushString(reinterpret_cast<const char*>(samples), instance->GetSampleCount() * sizeof(Nz::Int16));
+			else
+				lua.PushNil();
+
 			return 1;
 		});
 
@@ -275,8 +275,8 @@ namespace Ndk
 		instance.SetGlobal("CursorPosition");
 
 		// Nz::HashType
-		static_assert(Nz::HashType_Max + 1 == 9, "Nz::HashType has been updated but change was not reflected to Lua binding");
-		instance.PushTable(0, 9);
+		static_assert(Nz::HashType_Max + 1 == 10, "Nz::HashType has been updated but change was not reflected to Lua binding");
+		instance.PushTable(0, 10);
 		{
 			instance.PushField("CRC32", Nz::HashType_CRC32);
 			instance.PushField("Fletcher16", Nz::HashType_Fletcher16);
@@ -287,6 +287,7 @@ namespace Ndk
 			instance.PushField("SHA384", Nz::HashType_SHA384);
 			instance.PushField("SHA512", Nz::HashType_SHA512);
 			instance.PushField("Whirlpool", Nz::HashType_Whirlpool);
+			instance.PushField("XXHash64", Nz::HashType_XXHash64);
 		}
 		instance.SetGlobal("HashType");
 
@@ -122,7 +122,7 @@ namespace Ndk
 
 		/*********************************** Ndk::World **********************************/
 		worldClass.BindMethod("CreateEntity", &World::CreateEntity);
-		worldClass.BindMethod("CreateEntities", &World::CreateEntities);
+		worldClass.BindMethod("CreateEntities", static_cast<World::EntityList(World::*)(unsigned int)>(&World::CreateEntities));
 		worldClass.BindMethod("Clear", &World::Clear);
 
 
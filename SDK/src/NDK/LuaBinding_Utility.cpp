@@ -6,6 +6,23 @@
 
 namespace Ndk
 {
+	namespace
+	{
+		// Assigns the value to the userdata given at outIndex if any (a script can reuse it between calls), or pushes a new one
+		template<typename T, typename V>
+		int ReplyInPlace(Nz::LuaInstance& lua, int outIndex, const char* tname, const V& value)
+		{
+			if (lua.GetStackTop() >= static_cast<unsigned int>(outIndex) && lua.IsOfType(outIndex, tname))
+			{
+				static_cast<T*>(lua.ToUserdata(outIndex))->Set(value);
+				lua.PushValue(outIndex);
+				return 1;
+			}
+
+			return lua.Push(value);
+		}
+	}
+
 	void LuaBinding::BindUtility()
 	{
 		/*********************************** Nz::AbstractImage **********************************/
@@ -101,6 +118,8 @@ namespace Ndk
 
 		fontClass.BindMethod("Destroy", &Nz::Font::Destroy);
 
+		fontClass.BindMethod("EnableDistanceField", &Nz::Font::EnableDistanceField);
+
 		fontClass.BindMethod("GetCachedGlyphCount", [] (Nz::LuaInstance& lua, Nz::FontRef& instance) -> int
 		{
 			unsigned int argCount = std::min(lua.GetStackTop(), 2U);
@@ -126,21 +145,26 @@ namespace Ndk
 			return 0;
 		});
 
-		fontClass.BindMethod("GetFamilyName",      &Nz::Font::GetFamilyName);
-		fontClass.BindMethod("GetKerning",         &Nz::Font::GetKerning);
-		fontClass.BindMethod("GetGlyphBorder",     &Nz::Font::GetGlyphBorder);
-		fontClass.BindMethod("GetMinimumStepSize", &Nz::Font::GetMinimumStepSize);
-		fontClass.BindMethod("GetSizeInfo",        &Nz::Font::GetSizeInfo);
-		fontClass.BindMethod("GetStyleName",       &Nz::Font::GetStyleName);
+		fontClass.BindMethod("GetDistanceFieldSize",   &Nz::Font::GetDistanceFieldSize);
+		fontClass.BindMethod("GetDistanceFieldSpread", &Nz::Font::GetDistanceFieldSpread);
+		fontClass.BindMethod("GetFamilyName",          &Nz::Font::GetFamilyName);
+		fontClass.BindMethod("GetKerning",             &Nz::Font::GetKerning);
+		fontClass.BindMethod("GetGlyphBorder",         &Nz::Font::GetGlyphBorder);
+		fontClass.BindMethod("GetMinimumStepSize",     &Nz::Font::GetMinimumStepSize);
+		fontClass.BindMethod("GetSizeInfo",            &Nz::Font::GetSizeInfo);
+		fontClass.BindMethod("GetStyleName",           &Nz::Font::GetStyleName);
 
-		fontClass.BindMethod("IsValid", &Nz::Font::IsValid);
+		fontClass.BindMethod("IsDistanceFieldEnabled", &Nz::Font::IsDistanceFieldEnabled);
+		fontClass.BindMethod("IsValid",                &Nz::Font::IsValid);
 
 		fontClass.BindMethod("Precache", (bool(Nz::Font::*)(unsigned int, Nz::UInt32, const Nz::String&) const) &Nz::Font::Precache);
 
 		fontClass.BindMethod("OpenFromFile", &Nz::Font::OpenFromFile, Nz::FontParams());
 
-		fontClass.BindMethod("SetGlyphBorder",     &Nz::Font::SetGlyphBorder);
-		fontClass.BindMethod("SetMinimumStepSize", &Nz::Font::SetMinimumStepSize);
+		fontClass.BindMethod("SetDistanceFieldSize",   &Nz::Font::SetDistanceFieldSize);
+		fontClass.BindMethod("SetDistanceFieldSpread", &Nz::Font::SetDistanceFieldSpread);
+		fontClass.BindMethod("SetGlyphBorder",         &Nz::Font::SetGlyphBorder);
+		fontClass.BindMethod("SetMinimumStepSize",     &Nz::Font::SetMinimumStepSize);
 
 		fontClass.BindStaticMethod("GetDefault",                &Nz::Font::GetDefault);
 		fontClass.BindStaticMethod("GetDefaultGlyphBorder",     &Nz::Font::GetDefaultGlyphBorder);
@@ -163,10 +187,7 @@ namespace Ndk
 		nodeClass.BindMethod("GetLeft", &Nz::Node::GetLeft);
 		nodeClass.BindMethod("GetNodeType", &Nz::Node::GetNodeType);
 		//nodeClass.SetMethod("GetParent", &Nz::Node::GetParent);
-		nodeClass.BindMethod("GetPosition", &Nz::Node::GetPosition, Nz::CoordSys_Global);
 		nodeClass.BindMethod("GetRight", &Nz::Node::GetRight);
-		//nodeClass.SetMethod("GetRotation", &Nz::Node::GetRotation, Nz::CoordSys_Global);
-		nodeClass.BindMethod("GetScale", &Nz::Node::GetScale, Nz::CoordSys_Global);
 		//nodeClass.SetMethod("GetTransformMatrix", &Nz::Node::GetTransformMatrix);
 		nodeClass.BindMethod("GetUp", &Nz::Node::GetUp);
 
@@ -183,12 +204,34 @@ namespace Ndk
 		nodeClass.BindMethod("GetInitialScale", &Nz::Node::GetInitialScale);
 		nodeClass.BindMethod("GetLeft", &Nz::Node::GetLeft);
 		nodeClass.BindMethod("GetNodeType", &Nz::Node::GetNodeType);
-		nodeClass.BindMethod("GetPosition", &Nz::Node::GetPosition, Nz::CoordSys_Global);
 		nodeClass.BindMethod("GetRight", &Nz::Node::GetRight);
-		nodeClass.BindMethod("GetRotation", &Nz::Node::GetRotation, Nz::CoordSys_Global);
-		nodeClass.BindMethod("GetScale", &Nz::Node::GetScale, Nz::CoordSys_Global);
 		nodeClass.BindMethod("GetUp", &Nz::Node::GetUp);
 
+		// node:GetPosition([coordSys[, vector]]) fills vector if given, instead of allocating a new one
+		nodeClass.BindMethod("GetPosition", [] (Nz::LuaInstance& lua, Nz::Node& node) -> int
+		{
+			int argIndex = 1;
+			Nz::CoordSys coordSys = lua.Check<Nz::CoordSys>(&argIndex, Nz::CoordSys_Global);
+
+			return ReplyInPlace<Nz::Vector3d>(lua, argIndex, "Vector3", node.GetPosition(coordSys));
+		});
+
+		nodeClass.BindMethod("GetRotation", [] (Nz::LuaInstance& lua, Nz::Node& node) -> int
+		{
+			int argIndex = 1;
+			Nz::CoordSys coordSys = lua.Check<Nz::CoordSys>(&argIndex, Nz::CoordSys_Global);
+
+			return ReplyInPlace<Nz::Quaterniond>(lua, argIndex, "Quaternion", node.GetRotation(coordSys));
+		});
+
+		nodeClass.BindMethod("GetScale", [] (Nz::LuaInstance& lua, Nz::Node& node) -> int
+		{
+			int argIndex = 1;
+			Nz::CoordSys coordSys = lua.Check<Nz::CoordSys>(&argIndex, Nz::CoordSys_Global);
+
+			return ReplyInPlace<Nz::Vector3d>(lua, argIndex, "Vector3", node.GetScale(coordSys));
+		});
+
 		nodeClass.BindMethod("SetInitialPosition", (void(Nz::Node::*)(const Nz::Vector3f&)) &Nz::Node::SetInitialPosition);
 		nodeClass.BindMethod("SetInitialRotation", (void(Nz::Node::*)(const Nz::Quaternionf&)) &Nz::Node::SetInitialRotation);
 
@@ -17,6 +17,7 @@
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/Systems/NodeSystem.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
 
@@ -80,6 +81,7 @@ namespace Ndk
 			// Shared systems
 			InitializeSystem<PhysicsSystem>();
 			InitializeSystem<VelocitySystem>();
+			InitializeSystem<NodeSystem>();
 
 			#ifndef NDK_SERVER
 			// Client systems
@@ -4,6 +4,7 @@
 
 #include <NDK/Systems/ListenerSystem.hpp>
 #include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/VoiceManager.hpp>
 #include <NDK/Components/ListenerComponent.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
@@ -21,7 +22,7 @@ namespace Ndk
 
 		unsigned int activeListenerCount = 0;
 
-		for (const Ndk::EntityHandle& entity : GetEntities())
+		for (Entity* entity : GetEntities())
 		{
 			// Le listener est-il actif ?
 			const ListenerComponent& listener = entity->GetComponent<ListenerComponent>();
@@ -46,6 +47,12 @@ namespace Ndk
 
 		if (activeListenerCount > 1)
 			NazaraWarning(Nz::String::Number(activeListenerCount) + " listeners were active in the same update loop");
+
+		// Les sons les plus audibles depuis la nouvelle position du listener récupèrent les sources
+		Nz::VoiceManager::Update();
+
+		// Les réglages modifiés des sons sont envoyés à OpenAL en une seule fois
+		Nz::Audio::Update();
 	}
 
 	SystemIndex ListenerSystem::systemIndex;
@@ -0,0 +1,48 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/Systems/NodeSystem.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+
+namespace Ndk
+{
+	NodeSystem::NodeSystem()
+	{
+		Requires<NodeComponent>();
+	}
+
+	NodeSystem::NodeSystem(const NodeSystem& system) :
+	System(system),
+	m_hierarchy()
+	{
+	}
+
+	void NodeSystem::OnEntityRemoved(Entity* entity)
+	{
+		// The component may already be destroyed, in which case it left the hierarchy by itself
+		if (entity->HasComponent<NodeComponent>())
+		{
+			NodeComponent& node = entity->GetComponent<NodeComponent>();
+			if (node.GetHierarchy() == &m_hierarchy)
+				m_hierarchy.Unregister(&node);
+		}
+	}
+
+	void NodeSystem::OnEntityValidation(Entity* entity, bool justAdded)
+	{
+		NazaraUnused(justAdded);
+
+		// The node component may have been replaced since the entity was added
+		m_hierarchy.Register(&entity->GetComponent<NodeComponent>());
+	}
+
+	void NodeSystem::OnUpdate(float elapsedTime)
+	{
+		NazaraUnused(elapsedTime);
+
+		m_hierarchy.Update();
+	}
+
+	SystemIndex NodeSystem::systemIndex;
+}
@@ -7,6 +7,7 @@
 #include <NDK/Components/CollisionComponent.hpp>
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
+#include <algorithm>
 
 namespace Ndk
 {
@@ -22,6 +23,31 @@ namespace Ndk
 	{
 	}
 
+	void PhysicsSystem::InvalidateStaticObject(Entity* entity)
+	{
+		m_invalidatedStaticObjects.emplace_back(entity);
+	}
+
+	void PhysicsSystem::OnEntityRemoved(Entity* entity)
+	{
+		m_dynamicObjects.Remove(entity);
+		m_staticObjects.Remove(entity);
+
+		auto RemoveFrom = [entity] (std::vector<EntityHandle>& entities)
+		{
+			entities.erase(std::remove(entities.begin(), entities.end(), *entity), entities.end());
+		};
+
+		if (m_awakeObjectBits.UnboundedTest(entity->GetId()))
+		{
+			m_awakeObjectBits.Reset(entity->GetId());
+			RemoveFrom(m_awakeObjects);
+		}
+
+		RemoveFrom(m_invalidatedStaticObjects);
+		RemoveFrom(m_movingStaticObjects);
+	}
+
 	void PhysicsSystem::OnEntityValidation(Entity* entity, bool justAdded)
 	{
 		// Si l'entité ne vient pas d'être ajoutée au système, il est possible qu'elle fasse partie du mauvais tableau
@@ -34,29 +60,91 @@ namespace Ndk
 
 		auto& entities = (entity->HasComponent<PhysicsComponent>()) ? m_dynamicObjects : m_staticObjects;
 		entities.Insert(entity);
+
+		if (!entity->HasComponent<PhysicsComponent>())
+		{
+			// Static bodies are then only updated when their node is invalidated
+			CollisionComponent& collision = entity->GetComponent<CollisionComponent>();
+			NodeComponent& node = entity->GetComponent<NodeComponent>();
+
+			Nz::PhysObject* physObj = collision.GetStaticBody();
+			physObj->SetPosition(node.GetPosition(Nz::CoordSys_Global));
+			physObj->SetRotation(node.GetRotation(Nz::CoordSys_Global));
+
+			collision.m_bodyUpdated = true;
+		}
 	}
 
 	void PhysicsSystem::OnUpdate(float elapsedTime)
 	{
 		m_world.Step(elapsedTime);
 
-		for (const Ndk::EntityHandle& entity : m_dynamicObjects)
+		// Sleeping objects are left alone, only those moved by the physics are tracked until they come to rest
+		std::size_t movedObjectCount = m_world.GetMovedObjectCount();
+		for (std::size_t i = 0; i < movedObjectCount; ++i)
 		{
-			NodeComponent& node = entity->GetComponent<NodeComponent>();
-			PhysicsComponent& phys = entity->GetComponent<PhysicsComponent>();
+			PhysicsComponent* phys = static_cast<PhysicsComponent*>(m_world.GetMovedObject(i)->GetUserdata());
+			if (!phys)
+				continue; // Not owned by a component
 
-			Nz::PhysObject& physObj = phys.GetPhysObject();
-			node.SetRotation(physObj.GetRotation(), Nz::CoordSys_Global);
-			node.SetPosition(physObj.GetPosition(), Nz::CoordSys_Global);
+			Entity* entity = phys->m_entity;
+			if (!m_awakeObjectBits.UnboundedTest(entity->GetId()))
+			{
+				m_awakeObjectBits.UnboundedSet(entity->GetId(), true);
+				m_awakeObjects.emplace_back(entity);
+			}
 		}
 
+		// Poses are blended between the last two steps, for a smooth motion whatever the step size
+		float interpolation = m_world.GetInterpolationFactor();
+		std::size_t awakeObjectCount = 0;
+		for (std::size_t i = 0; i < m_awakeObjects.size(); ++i)
+		{
+			const EntityHandle& entity = m_awakeObjects[i];
+
+			bool isAwake = false;
+			if (entity->HasComponent<PhysicsComponent>())
+			{
+				NodeComponent& node = entity->GetComponent<NodeComponent>();
+				PhysicsComponent& phys = entity->GetComponent<PhysicsComponent>();
+
+				Nz::PhysObject& physObj = phys.GetPhysObject();
+				node.SetRotation(physObj.GetInterpolatedRotation(interpolation), Nz::CoordSys_Global);
+				node.SetPosition(physObj.GetInterpolatedPosition(interpolation), Nz::CoordSys_Global);
+
+				// An object which did not move during the last step has just been given its final pose
+				isAwake = physObj.IsMoving();
+			}
+
+			if (isAwake)
+				m_awakeObjects[awakeObjectCount++] = entity;
+			else
+				m_awakeObjectBits.Reset(entity->GetId());
+		}
+		m_awakeObjects.resize(awakeObjectCount);
+
+		// Static objects moved by the last update have stopped, unless their node was invalidated again since
+		for (const EntityHandle& entity : m_movingStaticObjects)
+		{
+			CollisionComponent& collision = entity->GetComponent<CollisionComponent>();
+			if (collision.m_bodyUpdated)
+			{
+				Nz::PhysObject* physObj = collision.GetStaticBody();
+				physObj->SetAngularVelocity(Nz::Vector3f::Zero());
+				physObj->SetVelocity(Nz::Vector3f::Zero());
+			}
+		}
+		m_movingStaticObjects.clear();
+
 		float invElapsedTime = 1.f / elapsedTime;
-		for (const Ndk::EntityHandle& entity : m_staticObjects)
+		for (const EntityHandle& entity : m_invalidatedStaticObjects)
 		{
 			CollisionComponent& collision = entity->GetComponent<CollisionComponent>();
 			NodeComponent& node = entity->GetComponent<NodeComponent>();
 
 			Nz::PhysObject* physObj = collision.GetStaticBody();
+			if (!physObj)
+				continue; // Became a dynamic object since
 
 			Nz::Quaternionf oldRotation = physObj->GetRotation();
 			Nz::Vector3f oldPosition = physObj->GetPosition();
@@ -81,12 +169,16 @@ namespace Ndk
 				                             Nz::ToRadians(angles.yaw * invElapsedTime),
 				                             Nz::ToRadians(angles.roll * invElapsedTime));
 
-				physObj->SetRotation(oldRotation);
+				physObj->SetRotation(newRotation);
 				physObj->SetAngularVelocity(angularVelocity);
 			}
 			else
 				physObj->SetAngularVelocity(Nz::Vector3f::Zero());
+
+			collision.m_bodyUpdated = true;
+			m_movingStaticObjects.push_back(entity);
 		}
+		m_invalidatedStaticObjects.clear();
 	}
 
 	SystemIndex PhysicsSystem::systemIndex;
@@ -3,30 +3,442 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/Systems/RenderSystem.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Graphics/ColorBackground.hpp>
 #include <Nazara/Math/Rect.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Renderer/Shader.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
 #include <NDK/Components/CameraComponent.hpp>
 #include <NDK/Components/GraphicsComponent.hpp>
 #include <NDK/Components/LightComponent.hpp>
 #include <NDK/Components/NodeComponent.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Ndk
 {
+	namespace
+	{
+		// Below this, splitting the drawables costs more than it brings
+		const std::size_t s_minDrawablesPerChunk = 256;
+
+		// Casters whose bounding box didn't change during this many frames are baked in the static layers of the shadow maps
+		const unsigned int s_staticCasterFrameCount = 30;
+
+		// The resolution scale only changes by steps, each change resizing the buffers of the deferred technique
+		const float s_resolutionScaleStep = 0.05f;
+
+		// Smallest part of its shadow map size a spot light far away gets in the atlas, and smallest region side
+		const float s_minShadowAtlasImportance = 0.125f;
+		const unsigned int s_minShadowAtlasRegionSize = 64;
+	}
+
 	RenderSystem::RenderSystem() :
 	m_coordinateSystemMatrix(Nz::Matrix4f::Identity()),
-	m_coordinateSystemInvalidated(true)
+	m_shadowAtlasFormat(Nz::PixelFormatType_Depth16),
+	m_shadowAtlasSize(2048, 2048),
+	m_maxResolutionScale(1.f),
+	m_minResolutionScale(0.5f),
+	m_resolutionScale(1.f),
+	m_resolutionTargetTime(1.f / 60.f),
+	m_frameIndex(0),
+	m_shadowMapUpdateBudget(0),
+	m_coordinateSystemInvalidated(true),
+	m_dynamicResolution(false),
+	m_occlusionCulling(false),
+	m_parallelQueueFilling(false),
+	m_shadowAtlasEnabled(true),
+	m_shadowAtlasInvalidated(false),
+	m_singlePassPointShadows(true)
 	{
 		ChangeRenderTechnique<Nz::ForwardRenderTechnique>();
 		SetDefaultBackground(Nz::ColorBackground::New());
 		SetUpdateRate(0.f);
 	}
 
+	bool RenderSystem::DrawShadowCasters(const Nz::Spheref& range, bool staticCasters, const CubemapFaces* cubemapFaces)
+	{
+		Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
+		renderQueue->Clear();
+
+		QueryDrawables(range, &m_cullingData.shadowCasters);
+
+		bool empty = true;
+		Nz::UInt8 faceMask = 0;
+		for (std::size_t drawableIndex : m_cullingData.shadowCasters)
+		{
+			Entity* drawable = m_drawables[drawableIndex];
+			GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+
+			// Infinite volumes can't be tracked, they are considered static
+			bool isStatic = true;
+			auto it = m_shadowCasters.find(drawable->GetId());
+			if (it != m_shadowCasters.end())
+				isStatic = (m_frameIndex - it->second.lastChangeFrame >= s_staticCasterFrameCount);
+
+			if (isStatic != staticCasters)
+				continue;
+
+			// Drawn in a single pass to every face of a cubemap, the faces seeing none of the casters are skipped by the geometry shader
+			if (cubemapFaces)
+			{
+				const Nz::BoundingVolumef& boundingVolume = graphicsComponent.GetBoundingVolume();
+
+				Nz::UInt8 casterFaceMask = 0;
+				for (unsigned int face = 0; face < 6; ++face)
+				{
+					if (!boundingVolume.IsFinite() || cubemapFaces->frustums[face].Intersect(boundingVolume.aabb) != Nz::IntersectionSide_Outside)
+						casterFaceMask |= 1 << face;
+				}
+
+				if (casterFaceMask == 0)
+					continue;
+
+				faceMask |= casterFaceMask;
+			}
+
+			graphicsComponent.AddToRenderQueue(renderQueue);
+			empty = false;
+		}
+
+		if (empty)
+			return false;
+
+		if (cubemapFaces)
+			m_shadowTechnique.EnableCubemapLayering(cubemapFaces->viewProjMatrices.data(), faceMask);
+
+		Nz::SceneData dummySceneData;
+		dummySceneData.ambientColor = Nz::Color(0, 0, 0);
+		dummySceneData.background = nullptr;
+		dummySceneData.viewer = nullptr; //< Depth technique doesn't require any viewer
+
+		// Drawn over the depth already present (static layer)
+		Nz::Renderer::Enable(Nz::RendererParameter_DepthBuffer, true);
+		Nz::Renderer::Enable(Nz::RendererParameter_DepthWrite, true);
+
+		m_shadowTechnique.Draw(dummySceneData);
+
+		if (!cubemapFaces)
+			return false;
+
+		m_shadowTechnique.DisableCubemapLayering();
+
+		// Casters with a custom depth material may not support layering, they have to be drawn face by face
+		return m_shadowTechnique.HasSkippedNonLayeredMaterials();
+	}
+
+	RenderSystem::ResolutionTarget* RenderSystem::EnsureResolutionTarget(const CameraComponent& camera, std::size_t cameraIndex)
+	{
+		if (m_resolutionTargets.size() <= cameraIndex)
+			m_resolutionTargets.resize(cameraIndex + 1);
+
+		std::unique_ptr<ResolutionTarget>& resolutionTarget = m_resolutionTargets[cameraIndex];
+		if (!resolutionTarget)
+			resolutionTarget = std::make_unique<ResolutionTarget>();
+
+		// Allocated at the full size of the viewport, the scale only changes the part rendered to
+		const Nz::Recti& viewport = camera.GetViewport();
+		Nz::Vector2ui size(viewport.width, viewport.height);
+		if (resolutionTarget->size != size)
+		{
+			try
+			{
+				Nz::ErrorFlags flags(Nz::ErrorFlag_ThrowException, true);
+
+				Nz::TextureRef colorTexture = Nz::Texture::New();
+				colorTexture->Create(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, size.x, size.y);
+
+				Nz::RenderTexture& renderTexture = resolutionTarget->renderTexture;
+				renderTexture.Create(true);
+				renderTexture.AttachTexture(Nz::AttachmentPoint_Color, 0, colorTexture);
+				renderTexture.AttachBuffer(Nz::AttachmentPoint_DepthStencil, 0, Nz::PixelFormatType_Depth24Stencil8, size.x, size.y);
+				renderTexture.Unlock();
+
+				if (!renderTexture.IsComplete())
+				{
+					NazaraError("Incomplete resolution target");
+					resolutionTarget.reset();
+					return nullptr;
+				}
+
+				if (!resolutionTarget->upscaleMaterial)
+				{
+					Nz::TextureSampler sampler;
+					sampler.SetAnisotropyLevel(1);
+					sampler.SetFilterMode(Nz::SamplerFilter_Bilinear);
+					sampler.SetWrapMode(Nz::SamplerWrap_Clamp);
+
+					resolutionTarget->upscaleMaterial = Nz::Material::New();
+					resolutionTarget->upscaleMaterial->Enable(Nz::RendererParameter_DepthBuffer, false);
+					resolutionTarget->upscaleMaterial->Enable(Nz::RendererParameter_FaceCulling, false);
+					resolutionTarget->upscaleMaterial->EnableTransform(false);
+					resolutionTarget->upscaleMaterial->SetDiffuseSampler(sampler);
+
+					resolutionTarget->upscaleQuad.Reset(Nz::VertexDeclaration::Get(Nz::VertexLayout_XY_UV), 4, Nz::DataStorage_Hardware, Nz::BufferUsage_Dynamic);
+				}
+
+				resolutionTarget->upscaleMaterial->SetDiffuseMap(colorTexture);
+				resolutionTarget->colorTexture = std::move(colorTexture);
+				resolutionTarget->scaledSize.MakeZero();
+				resolutionTarget->size = size;
+			}
+			catch (const std::exception& e)
+			{
+				NazaraError("Failed to create resolution target: " + Nz::String(e.what()));
+				resolutionTarget.reset();
+				return nullptr;
+			}
+		}
+
+		Nz::Vector2ui scaledSize;
+		scaledSize.x = std::max(static_cast<unsigned int>(size.x * m_resolutionScale + 0.5f), 1U);
+		scaledSize.y = std::max(static_cast<unsigned int>(size.y * m_resolutionScale + 0.5f), 1U);
+
+		if (resolutionTarget->scaledSize != scaledSize)
+		{
+			float u = static_cast<float>(scaledSize.x) / size.x;
+			float v = static_cast<float>(scaledSize.y) / size.y;
+
+			// The scaled viewport is at the top of the texture, whose rows are stored from the bottom
+			Nz::VertexStruct_XY_UV vertices[4];
+			vertices[0].position.Set(-1.f, 1.f);
+			vertices[0].uv.Set(0.f, 1.f);
+			vertices[1].position.Set(1.f, 1.f);
+			vertices[1].uv.Set(u, 1.f);
+			vertices[2].position.Set(-1.f, -1.f);
+			vertices[2].uv.Set(0.f, 1.f - v);
+			vertices[3].position.Set(1.f, -1.f);
+			vertices[3].uv.Set(u, 1.f - v);
+
+			resolutionTarget->upscaleQuad.Fill(vertices, 0, 4);
+			resolutionTarget->scaledSize = scaledSize;
+		}
+
+		resolutionTarget->viewer.Reset(&camera, &resolutionTarget->renderTexture, Nz::Recti(0, 0, scaledSize.x, scaledSize.y));
+
+		return resolutionTarget.get();
+	}
+
+	void RenderSystem::FillRenderQueue(const CameraComponent& camera, Nz::AbstractRenderQueue* renderQueue)
+	{
+		QueryDrawables(camera.GetFrustum(), &m_cullingData.visibleDrawables);
+
+		for (std::size_t drawableIndex : m_cullingData.visibleDrawables)
+		{
+			Entity* drawable = m_drawables[drawableIndex];
+			GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
+
+			// Only the finite volumes have occlusion queries
+			if (!m_cullingData.occlusion.Test(drawableIndex))
+				graphicsComponent.AddToRenderQueue(renderQueue);
+			else
+				renderQueue->ReportCulledObjects(1);
+		}
+
+		// Null volumes are never visible, they are not reported
+		std::size_t frustumCulledCount = m_cullingData.tree.GetProxyCount() + m_cullingData.infiniteDrawables.size() - m_cullingData.visibleDrawables.size();
+		if (frustumCulledCount > 0)
+			renderQueue->ReportCulledObjects(static_cast<unsigned int>(frustumCulledCount));
+	}
+
+	void RenderSystem::FillRenderQueueParallel(const CameraComponent& camera, Nz::ForwardRenderQueue* renderQueue)
+	{
+		// The camera updates its matrices on demand, this must not happen concurrently
+		const Nz::Frustumf& frustum = camera.GetFrustum();
+		camera.GetProjectionMatrix();
+		camera.GetViewMatrix();
+		camera.GetViewport();
+
+		QueryDrawables(frustum, &m_cullingData.visibleDrawables);
+
+		std::size_t frustumCulledCount = m_cullingData.tree.GetProxyCount() + m_cullingData.infiniteDrawables.size() - m_cullingData.visibleDrawables.size();
+		if (frustumCulledCount > 0)
+			renderQueue->ReportCulledObjects(static_cast<unsigned int>(frustumCulledCount));
+
+		std::size_t visibleCount = m_cullingData.visibleDrawables.size();
+		if (visibleCount == 0)
+			return;
+
+		// Contiguous chunks of visible drawables, each one queued by a single thread in its own queue
+		std::size_t chunkCount = std::min<std::size_t>(Nz::TaskScheduler::GetWorkerCount() + 1, (visibleCount + s_minDrawablesPerChunk - 1) / s_minDrawablesPerChunk);
+		std::size_t chunkSize = (visibleCount + chunkCount - 1) / chunkCount;
+
+		while (m_queueChunks.size() < chunkCount)
+		{
+			m_queueChunks.emplace_back(std::make_unique<QueueChunk>());
+			m_queueChunks.back()->renderQueue.EnableCommandList(true);
+		}
+
+		// The grain size being the chunk size, each call processes exactly one chunk
+		Nz::TaskScheduler::ParallelFor(0, visibleCount, chunkSize, [&] (std::size_t first, std::size_t last)
+		{
+			QueueChunk& chunk = *m_queueChunks[first / chunkSize];
+			chunk.renderQueue.Clear();
+			chunk.renderQueue.SetViewer(&camera);
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				std::size_t drawableIndex = m_cullingData.visibleDrawables[i];
+				GraphicsComponent& graphicsComponent = m_drawables[drawableIndex]->GetComponent<GraphicsComponent>();
+
+				if (!m_cullingData.occlusion.Test(drawableIndex))
+					graphicsComponent.AddToRenderQueue(&chunk.renderQueue);
+				else
+					chunk.renderQueue.ReportCulledObjects(1);
+			}
+		});
+
+		// Merged in the order of the drawables, the result doesn't depend on the scheduling
+		for (std::size_t i = 0; i < chunkCount; ++i)
+			renderQueue->MergeCommandList(m_queueChunks[i]->renderQueue);
+	}
+
+	void RenderSystem::InvalidateStaticShadowLayers(const Nz::Boxf& box)
+	{
+		for (auto& pair : m_shadowMapCaches)
+		{
+			ShadowMapCache& cache = pair.second;
+			if (cache.staticLayerValid && Nz::Spheref(cache.position, cache.radius).Intersect(box))
+				cache.staticLayerValid = false;
+		}
+	}
+
+	void RenderSystem::IssueOcclusionQueries(const CameraComponent& camera, std::size_t cameraIndex)
+	{
+		NazaraProfileZone("RenderSystem::IssueOcclusionQueries");
+
+		if (!m_occlusionBoxVertices.IsValid())
+		{
+			Nz::ErrorFlags flags(Nz::ErrorFlag_ThrowException, true);
+
+			// Unit cube, scaled to the bounding box of each drawable
+			const float vertices[8 * 3] =
+			{
+				0.f, 0.f, 0.f,  1.f, 0.f, 0.f,  0.f, 1.f, 0.f,  1.f, 1.f, 0.f,
+				0.f, 0.f, 1.f,  1.f, 0.f, 1.f,  0.f, 1.f, 1.f,  1.f, 1.f, 1.f
+			};
+
+			const Nz::UInt16 indices[6 * 6] =
+			{
+				0, 2, 1,  1, 2, 3, // Back
+				4, 5, 6,  5, 7, 6, // Front
+				0, 1, 4,  1, 5, 4, // Bottom
+				2, 6, 3,  3, 6, 7, // Top
+				0, 4, 2,  2, 4, 6, // Left
+				1, 3, 5,  3, 7, 5  // Right
+			};
+
+			m_occlusionBoxVertices.Reset(Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ), 8, Nz::DataStorage_Hardware, Nz::BufferUsage_Static);
+			m_occlusionBoxVertices.Fill(vertices, 0, 8);
+
+			m_occlusionBoxIndices.Reset(false, 36, Nz::DataStorage_Hardware, Nz::BufferUsage_Static);
+			m_occlusionBoxIndices.Fill(indices, 0, 36);
+		}
+
+		OcclusionQueries& queries = m_occlusionQueries[cameraIndex];
+
+		m_cullingData.visibility.Reset();
+		m_cullingData.visibility.Resize(m_drawables.size(), false);
+		for (std::size_t drawableIndex : m_cullingData.visibleDrawables)
+			m_cullingData.visibility.Set(drawableIndex);
+
+		// The boxes are only tested against the depth buffer, the faces of both sides are drawn in case the viewer is inside one
+		Nz::RenderStates oldStates = Nz::Renderer::GetRenderStates();
+
+		Nz::Renderer::Enable(Nz::RendererParameter_Blend, false);
+		Nz::Renderer::Enable(Nz::RendererParameter_ColorWrite, false);
+		Nz::Renderer::Enable(Nz::RendererParameter_DepthBuffer, true);
+		Nz::Renderer::Enable(Nz::RendererParameter_DepthWrite, false);
+		Nz::Renderer::Enable(Nz::RendererParameter_FaceCulling, false);
+		Nz::Renderer::SetDepthFunc(Nz::RendererComparison_LessOrEqual);
+
+		Nz::Renderer::SetShader(Nz::ShaderLibrary::Get("DebugSimple"));
+		Nz::Renderer::SetIndexBuffer(&m_occlusionBoxIndices);
+		Nz::Renderer::SetVertexBuffer(&m_occlusionBoxVertices);
+
+		Nz::Vector3f eyePosition = camera.GetEyePosition();
+		float nearMargin = camera.GetZNear() * 2.f;
+
+		std::size_t drawableIndex = 0;
+		for (Entity* drawable : m_drawables)
+		{
+			std::size_t i = drawableIndex++;
+
+			const Nz::BoundingVolumef& boundingVolume = drawable->GetComponent<GraphicsComponent>().GetBoundingVolume();
+			if (!boundingVolume.IsFinite())
+				continue;
+
+			OcclusionQuery& occlusionQuery = queries[drawable->GetId()];
+
+			// A drawable coming back in the frustum must be drawn right away, not once its query answered
+			if (!m_cullingData.visibility.Test(i))
+			{
+				occlusionQuery.visible = true;
+				continue;
+			}
+
+			// Only one query at once per drawable, its result is collected during a later frame
+			if (occlusionQuery.pending)
+				continue;
+
+			// The faces of a box the viewer is (almost) inside may be clipped by the near plane
+			Nz::Boxf box = boundingVolume.aabb;
+			Nz::Boxf expandedBox(box.x - nearMargin, box.y - nearMargin, box.z - nearMargin, box.width + nearMargin * 2.f, box.height + nearMargin * 2.f, box.depth + nearMargin * 2.f);
+			if (expandedBox.Contains(eyePosition))
+			{
+				occlusionQuery.visible = true;
+				continue;
+			}
+
+			if (!occlusionQuery.query)
+				occlusionQuery.query = std::make_unique<Nz::GpuQuery>();
+
+			Nz::Renderer::SetMatrix(Nz::MatrixType_World, Nz::Matrix4f::Transform(box.GetPosition(), Nz::Quaternionf::Identity(), box.GetLengths()));
+
+			occlusionQuery.query->Begin(Nz::GpuQueryMode_AnySamplesPassed);
+			Nz::Renderer::DrawIndexedPrimitives(Nz::PrimitiveMode_TriangleList, 0, 36);
+			occlusionQuery.query->End();
+
+			occlusionQuery.pending = true;
+		}
+
+		Nz::Renderer::SetRenderStates(oldStates);
+	}
+
 	void RenderSystem::OnEntityRemoved(Entity* entity)
 	{
 		m_cameras.Remove(entity);
 		m_drawables.Remove(entity);
 		m_lights.Remove(entity);
+
+		for (OcclusionQueries& queries : m_occlusionQueries)
+			queries.erase(entity->GetId());
+
+		auto proxyIt = m_cullingData.proxies.find(entity->GetId());
+		if (proxyIt != m_cullingData.proxies.end())
+		{
+			m_cullingData.tree.Remove(proxyIt->second);
+			m_cullingData.proxies.erase(proxyIt);
+		}
+
+		auto it = m_shadowCasters.find(entity->GetId());
+		if (it != m_shadowCasters.end())
+		{
+			InvalidateStaticShadowLayers(it->second.aabb);
+
+			m_changedCasterBoxes.push_back(it->second.aabb);
+			m_shadowCasters.erase(it);
+		}
+
+		ReleaseShadowAtlasRegion(entity);
+
+		m_directionalShadowCaches.erase(entity->GetId());
+		m_shadowMapCaches.erase(entity->GetId());
 	}
 
 	void RenderSystem::OnEntityValidation(Entity* entity, bool justAdded)
@@ -36,9 +448,9 @@ namespace Ndk
 		if (entity->HasComponent<CameraComponent>() && entity->HasComponent<NodeComponent>())
 		{
 			m_cameras.Insert(entity);
-			std::sort(m_cameras.begin(), m_cameras.end(), [](const EntityHandle& handle1, const EntityHandle& handle2)
+			m_cameras.Sort([](Entity* camera1, Entity* camera2)
 			{
-				return handle1->GetComponent<CameraComponent>().GetLayer() < handle2->GetComponent<CameraComponent>().GetLayer();
+				return camera1->GetComponent<CameraComponent>().GetLayer() < camera2->GetComponent<CameraComponent>().GetLayer();
 			});
 		}
 		else
@@ -47,8 +459,29 @@ namespace Ndk
 		if (entity->HasComponent<GraphicsComponent>() && entity->HasComponent<NodeComponent>())
 			m_drawables.Insert(entity);
 		else
+		{
 			m_drawables.Remove(entity);
 
+			for (OcclusionQueries& queries : m_occlusionQueries)
+				queries.erase(entity->GetId());
+
+			auto proxyIt = m_cullingData.proxies.find(entity->GetId());
+			if (proxyIt != m_cullingData.proxies.end())
+			{
+				m_cullingData.tree.Remove(proxyIt->second);
+				m_cullingData.proxies.erase(proxyIt);
+			}
+
+			auto it = m_shadowCasters.find(entity->GetId());
+			if (it != m_shadowCasters.end())
+			{
+				InvalidateStaticShadowLayers(it->second.aabb);
+
+				m_changedCasterBoxes.push_back(it->second.aabb);
+				m_shadowCasters.erase(it);
+			}
+		}
+
 		if (entity->HasComponent<LightComponent>() && entity->HasComponent<NodeComponent>())
 		{
 			LightComponent& lightComponent = entity->GetComponent<LightComponent>();
@@ -70,17 +503,24 @@ namespace Ndk
 			m_directionalLights.Remove(entity);
 			m_lights.Remove(entity);
 			m_pointSpotLights.Remove(entity);
+
+			ReleaseShadowAtlasRegion(entity);
+
+			m_directionalShadowCaches.erase(entity->GetId());
+			m_shadowMapCaches.erase(entity->GetId());
 		}
 	}
 
 	void RenderSystem::OnUpdate(float elapsedTime)
 	{
+		NazaraProfileZone("RenderSystem::OnUpdate");
+
 		NazaraUnused(elapsedTime);
 
 		// Invalidate every renderable if the coordinate system changed
 		if (m_coordinateSystemInvalidated)
 		{
-			for (const Ndk::EntityHandle& drawable : m_drawables)
+			for (Entity* drawable : m_drawables)
 			{
 				GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
 				graphicsComponent.InvalidateTransformMatrix();
@@ -89,27 +529,51 @@ namespace Ndk
 			m_coordinateSystemInvalidated = false;
 		}
 
+		UpdateCullingData();
+		UpdateShadowAtlas();
 		UpdatePointSpotShadowMaps();
 
-		for (const Ndk::EntityHandle& camera : m_cameras)
+		// Occlusion queries rely on conditions which may not be supported by the hardware
+		bool occlusionCulling = m_occlusionCulling && Nz::GpuQuery::IsModeSupported(Nz::GpuQueryMode_AnySamplesPassed);
+		if (occlusionCulling && m_occlusionQueries.size() < m_cameras.size())
+			m_occlusionQueries.resize(m_cameras.size());
+
+		// The scenes are rendered in internal textures, sized from the GPU time of the previous frames, then upscaled to the targets of the cameras
+		bool dynamicResolution = m_dynamicResolution && Nz::GpuQuery::IsModeSupported(Nz::GpuQueryMode_TimeElapsed);
+		if (dynamicResolution)
+			UpdateResolutionScale();
+
+		ResolutionTimer& resolutionTimer = m_resolutionTimers[m_frameIndex % m_resolutionTimers.size()];
+
+		std::size_t drawableCount = m_drawables.size();
+		std::size_t cameraIndex = 0;
+		for (Entity* camera : m_cameras)
 		{
 			CameraComponent& camComponent = camera->GetComponent<CameraComponent>();
 
-			//UpdateDirectionalShadowMaps(camComponent);
+			UpdateDirectionalShadowMaps(camComponent);
 
 			Nz::AbstractRenderQueue* renderQueue = m_renderTechnique->GetRenderQueue();
 			renderQueue->Clear();
+			renderQueue->SetViewer(&camComponent);
 
-			//TODO: Culling
-			for (const Ndk::EntityHandle& drawable : m_drawables)
+			m_cullingData.occlusion.Reset();
+			m_cullingData.occlusion.Resize(drawableCount, false);
+			if (occlusionCulling)
+				UpdateOcclusionResults(cameraIndex);
+
+			// Only the command list can be filled by several threads (the other containers are keyed by shared resources)
+			if (m_parallelQueueFilling && m_renderTechnique->GetType() == Nz::RenderTechniqueType_BasicForward)
 			{
-				GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-				NodeComponent& drawableNode = drawable->GetComponent<NodeComponent>();
+				Nz::ForwardRenderQueue* forwardQueue = static_cast<Nz::ForwardRenderQueue*>(renderQueue);
+				forwardQueue->EnableCommandList(true);
 
-				graphicsComponent.AddToRenderQueue(renderQueue);
+				FillRenderQueueParallel(camComponent, forwardQueue);
 			}
+			else
+				FillRenderQueue(camComponent, renderQueue);
 
-			for (const Ndk::EntityHandle& light : m_lights)
+			for (Entity* light : m_lights)
 			{
 				LightComponent& lightComponent = light->GetComponent<LightComponent>();
 				NodeComponent& lightNode = light->GetComponent<NodeComponent>();
@@ -125,67 +589,448 @@ namespace Ndk
 			sceneData.background = m_background;
 			sceneData.viewer = &camComponent;
 
+			ResolutionTarget* resolutionTarget = (dynamicResolution) ? EnsureResolutionTarget(camComponent, cameraIndex) : nullptr;
+			if (resolutionTarget)
+			{
+				sceneData.viewer = &resolutionTarget->viewer;
+				sceneData.viewer->ApplyView();
+
+				if (resolutionTimer.queryCount == resolutionTimer.queries.size())
+					resolutionTimer.queries.emplace_back(std::make_unique<Nz::GpuQuery>());
+
+				resolutionTimer.queries[resolutionTimer.queryCount++]->Begin(Nz::GpuQueryMode_TimeElapsed);
+			}
+
 			m_renderTechnique->Clear(sceneData);
 			m_renderTechnique->Draw(sceneData);
+
+			// Tested against the depth buffer of this frame, the results will be used by the next ones
+			if (occlusionCulling)
+				IssueOcclusionQueries(camComponent, cameraIndex);
+
+			if (resolutionTarget)
+			{
+				UpscaleResolutionTarget(camComponent, *resolutionTarget);
+
+				resolutionTimer.queries[resolutionTimer.queryCount - 1]->End();
+				resolutionTimer.pending = true;
+			}
+
+			cameraIndex++;
+		}
+	}
+
+	void RenderSystem::ReleaseShadowAtlasRegion(Entity* light)
+	{
+		auto it = m_shadowAtlasRegions.find(light->GetId());
+		if (it == m_shadowAtlasRegions.end())
+			return;
+
+		m_shadowAtlasPacker.FreeRectangle(it->second);
+		m_shadowAtlasPacker.MergeFreeRectangles();
+		m_shadowAtlasRegions.erase(it);
+
+		if (light->HasComponent<LightComponent>())
+			light->GetComponent<LightComponent>().ClearShadowMapAtlas();
+	}
+
+	void RenderSystem::UpdateCullingData()
+	{
+		// Drawables moving inside of their enlarged box don't change the tree, the others are reinserted
+		m_cullingData.infiniteDrawables.clear();
+
+		std::size_t drawableIndex = 0;
+		for (Entity* drawable : m_drawables)
+		{
+			const Nz::BoundingVolumef& boundingVolume = drawable->GetComponent<GraphicsComponent>().GetBoundingVolume();
+			if (boundingVolume.IsFinite())
+			{
+				auto pair = m_cullingData.proxies.emplace(drawable->GetId(), Nz::BoxTreef::InvalidProxy);
+				if (pair.second)
+					pair.first->second = m_cullingData.tree.Insert(boundingVolume.aabb, drawableIndex);
+				else
+				{
+					// The indices change when drawables are removed
+					m_cullingData.tree.Move(pair.first->second, boundingVolume.aabb);
+					m_cullingData.tree.SetUserData(pair.first->second, drawableIndex);
+				}
+			}
+			else
+			{
+				if (boundingVolume.IsInfinite())
+					m_cullingData.infiniteDrawables.push_back(drawableIndex);
+
+				auto it = m_cullingData.proxies.find(drawable->GetId());
+				if (it != m_cullingData.proxies.end())
+				{
+					m_cullingData.tree.Remove(it->second);
+					m_cullingData.proxies.erase(it);
+				}
+			}
+
+			drawableIndex++;
 		}
 	}
 
 	void RenderSystem::UpdateDirectionalShadowMaps(const Nz::AbstractViewer& viewer)
 	{
+		NazaraGpuZone("RenderSystem::UpdateDirectionalShadowMaps");
+
+		static Nz::BoxCorner sliceCorners[4][2] =
+		{
+			{Nz::BoxCorner_NearLeftBottom,  Nz::BoxCorner_FarLeftBottom},
+			{Nz::BoxCorner_NearLeftTop,     Nz::BoxCorner_FarLeftTop},
+			{Nz::BoxCorner_NearRightBottom, Nz::BoxCorner_FarRightBottom},
+			{Nz::BoxCorner_NearRightTop,    Nz::BoxCorner_FarRightTop}
+		};
+
+		if (m_directionalLights.empty())
+			return;
+
 		if (!m_shadowRT.IsValid())
 			m_shadowRT.Create();
 
-		Nz::SceneData dummySceneData;
-		dummySceneData.ambientColor = Nz::Color(0, 0, 0);
-		dummySceneData.background = nullptr;
-		dummySceneData.viewer = nullptr; //< Depth technique doesn't require any viewer
+		// Each camera renders the whole shadow maps again, the far cascades can only be kept between the frames of a single one
+		bool allowSkippedCascades = (m_cameras.size() == 1);
 
-		for (const Ndk::EntityHandle& light : m_directionalLights)
+		const Nz::Frustumf& viewFrustum = viewer.GetFrustum();
+		float zNear = viewer.GetZNear();
+		float zFar = viewer.GetZFar();
+
+		for (Entity* light : m_directionalLights)
 		{
 			LightComponent& lightComponent = light->GetComponent<LightComponent>();
 			NodeComponent& lightNode = light->GetComponent<NodeComponent>();
 
 			if (!lightComponent.IsShadowCastingEnabled())
+			{
+				m_directionalShadowCaches.erase(light->GetId());
 				continue;
+			}
 
-			Nz::Vector2ui shadowMapSize(lightComponent.GetShadowMap()->GetSize());
+			Nz::Texture* shadowMap = lightComponent.GetShadowMap();
+			Nz::Rectui shadowMapRegion = lightComponent.GetShadowMapRegion();
+			unsigned int cascadeCount = lightComponent.GetShadowCascadeCount();
+			Nz::Vector2ui cascadeSize(shadowMapRegion.width / cascadeCount, shadowMapRegion.height);
+			Nz::Quaternionf lightRotation = lightNode.GetRotation();
 
-			m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, lightComponent.GetShadowMap());
+			// A new shadow map (or region of the atlas) or a rotation of the light invalidates every cascade
+			DirectionalShadowCache& cache = m_directionalShadowCaches[light->GetId()];
+			bool updateAll = !allowSkippedCascades;
+			if (cache.cascadeCount != cascadeCount || cache.format != lightComponent.GetShadowMapFormat() || cache.region != shadowMapRegion || cache.rotation != lightRotation || cache.size != cascadeSize)
+			{
+				cache.cascadeCount = cascadeCount;
+				cache.format = lightComponent.GetShadowMapFormat();
+				cache.region = shadowMapRegion;
+				cache.rotation = lightRotation;
+				cache.size = cascadeSize;
+
+				updateAll = true;
+			}
+
+			float splitDistances[NAZARA_GRAPHICS_MAX_SHADOW_CASCADES];
+			Nz::Light::ComputeShadowCascadeSplits(zNear, zFar, cascadeCount, lightComponent.GetShadowCascadeSplitLambda(), splitDistances);
+
+			Nz::Matrix4f lightViewMatrix = Nz::Matrix4f::ViewMatrix(Nz::Vector3f::Zero(), lightRotation);
+
+			// Casters between the light and a cascade have to be drawn in it, the depth range of the cascades is extended up to the scene bounds
+			float sceneMinDepth = std::numeric_limits<float>::infinity();
+			if (!m_cullingData.tree.IsEmpty())
+			{
+				const Nz::Boxf& sceneBox = m_cullingData.tree.GetBounds();
+				for (unsigned int i = 0; i <= Nz::BoxCorner_Max; ++i)
+					sceneMinDepth = std::min(sceneMinDepth, -lightViewMatrix.Transform(sceneBox.GetCorner(static_cast<Nz::BoxCorner>(i))).z);
+			}
+
+			m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, shadowMap);
 			Nz::Renderer::SetTarget(&m_shadowRT);
-			Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+			Nz::Renderer::Enable(Nz::RendererParameter_ScissorTest, true);
 
-			Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
-			renderQueue->Clear();
+			unsigned int updateInterval = lightComponent.GetShadowCascadeUpdateInterval();
+			for (unsigned int cascade = 0; cascade < cascadeCount; ++cascade)
+			{
+				// The first cascade is updated every frame, the others are staggered over the update interval
+				if (!updateAll && cascade > 0 && (m_frameIndex + cascade) % updateInterval != 0)
+					continue;
+
+				float sliceNear = (cascade > 0) ? splitDistances[cascade - 1] : zNear;
+				float sliceFar = splitDistances[cascade];
+
+				// Slice of the view frustum covered by the cascade
+				Nz::Vector3f corners[8];
+				Nz::Vector3f center(Nz::Vector3f::Zero());
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					const Nz::Vector3f& nearCorner = viewFrustum.GetCorner(sliceCorners[i][0]);
+					const Nz::Vector3f& farCorner = viewFrustum.GetCorner(sliceCorners[i][1]);
+
+					corners[i * 2] = Nz::Vector3f::Lerp(nearCorner, farCorner, (sliceNear - zNear) / (zFar - zNear));
+					corners[i * 2 + 1] = Nz::Vector3f::Lerp(nearCorner, farCorner, (sliceFar - zNear) / (zFar - zNear));
+
+					center += corners[i * 2] + corners[i * 2 + 1];
+				}
+				center /= 8.f;
+
+				// A bounding sphere keeps the size of the cascade constant whatever the orientation of the camera
+				float radius = 0.f;
+				for (const Nz::Vector3f& corner : corners)
+					radius = std::max(radius, center.Distance(corner));
+
+				radius = std::ceil(radius * 16.f) / 16.f;
+
+				// The cascade moves by whole texels, the casters stay rasterized the same way when the camera moves
+				Nz::Vector3f lightSpaceCenter = lightViewMatrix.Transform(center);
+
+				float texelSize = 2.f * radius / cascadeSize.x;
+				lightSpaceCenter.x = std::floor(lightSpaceCenter.x / texelSize) * texelSize;
+				lightSpaceCenter.y = std::floor(lightSpaceCenter.y / texelSize) * texelSize;
+
+				float depthNear = std::min(-lightSpaceCenter.z - radius, sceneMinDepth);
+				float depthFar = -lightSpaceCenter.z + radius;
 
-			///TODO: Culling
-			for (const Ndk::EntityHandle& drawable : m_drawables)
+				Nz::Matrix4f projectionMatrix = Nz::Matrix4f::Ortho(lightSpaceCenter.x - radius, lightSpaceCenter.x + radius, lightSpaceCenter.y + radius, lightSpaceCenter.y - radius, depthNear, depthFar);
+
+				// Only the casters inside of the volume of the cascade are drawn
+				Nz::Frustumf cascadeFrustum;
+				cascadeFrustum.Extract(lightViewMatrix, projectionMatrix);
+				QueryDrawables(cascadeFrustum, &m_cullingData.shadowCasters);
+
+				Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
+				renderQueue->Clear();
+
+				for (std::size_t drawableIndex : m_cullingData.shadowCasters)
+				{
+					Entity* drawable = m_drawables[drawableIndex];
+					drawable->GetComponent<GraphicsComponent>().AddToRenderQueue(renderQueue);
+				}
+
+				// The viewport starts from the top of the texture, the region from its first row
+				Nz::Recti cascadeRect(shadowMapRegion.x + cascade * cascadeSize.x, shadowMap->GetHeight() - shadowMapRegion.y - shadowMapRegion.height, cascadeSize.x, cascadeSize.y);
+				Nz::Renderer::SetScissorRect(cascadeRect);
+				Nz::Renderer::SetViewport(cascadeRect);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_View, lightViewMatrix);
+
+				Nz::SceneData dummySceneData;
+				dummySceneData.ambientColor = Nz::Color(0, 0, 0);
+				dummySceneData.background = nullptr;
+				dummySceneData.viewer = nullptr; //< Depth technique doesn't require any viewer
+
+				m_shadowTechnique.Clear(dummySceneData);
+				m_shadowTechnique.Draw(dummySceneData);
+
+				lightComponent.SetShadowCascade(cascade, lightViewMatrix * projectionMatrix, sliceFar);
+			}
+
+			Nz::Renderer::Enable(Nz::RendererParameter_ScissorTest, false);
+		}
+	}
+
+	void RenderSystem::UpdateOcclusionResults(std::size_t cameraIndex)
+	{
+		OcclusionQueries& queries = m_occlusionQueries[cameraIndex];
+
+		std::size_t drawableIndex = 0;
+		for (Entity* drawable : m_drawables)
+		{
+			std::size_t i = drawableIndex++;
+
+			auto it = queries.find(drawable->GetId());
+			if (it == queries.end())
+				continue;
+
+			// Results not yet available are waited for during the next frames instead of stalling this one
+			OcclusionQuery& occlusionQuery = it->second;
+			if (occlusionQuery.pending && occlusionQuery.query->IsResultAvailable())
 			{
-				GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-				NodeComponent& drawableNode = drawable->GetComponent<NodeComponent>();
+				occlusionQuery.visible = (occlusionQuery.query->GetResult() != 0);
+				occlusionQuery.pending = false;
+			}
 
-				graphicsComponent.AddToRenderQueue(renderQueue);
+			if (!occlusionQuery.visible)
+				m_cullingData.occlusion.Set(i);
+		}
+	}
+
+	void RenderSystem::UpdatePointSpotShadowMap(const LightComponent& lightComponent, const NodeComponent& lightNode, ShadowMapCache& cache)
+	{
+		Nz::Texture* shadowMap = lightComponent.GetShadowMap();
+		Nz::Rectui shadowMapRect = lightComponent.GetShadowMapRegion();
+		Nz::Vector2ui shadowMapSize(shadowMapRect.width, shadowMapRect.height);
+
+		// The static layer only covers the region of the shadow map, which may be a part of an atlas
+		Nz::Rectui staticLayerRect(0, 0, shadowMapSize.x, shadowMapSize.y);
+		Nz::Recti shadowMapViewport(shadowMapRect.x, shadowMap->GetHeight() - shadowMapRect.y - shadowMapRect.height, shadowMapSize.x, shadowMapSize.y);
+
+		bool rebuildStaticLayer = !cache.staticLayerValid;
+		if (rebuildStaticLayer)
+		{
+			if (!cache.staticLayer)
+				cache.staticLayer = Nz::Texture::New();
+
+			if (!cache.staticLayer->Create(shadowMap->GetType(), shadowMap->GetFormat(), shadowMapSize.x, shadowMapSize.y))
+			{
+				NazaraError("Failed to create static shadow map layer");
+				return;
 			}
+		}
+
+		Nz::Spheref range(lightNode.GetPosition(), lightComponent.GetRadius());
+
+		auto UpdateFace = [&] (unsigned int face, const Nz::Matrix4f& projectionMatrix, const Nz::Matrix4f& viewMatrix)
+		{
+			m_shadowCacheRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, cache.staticLayer, face);
+
+			if (rebuildStaticLayer)
+			{
+				Nz::Renderer::SetTarget(&m_shadowCacheRT);
+				Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+				Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_View, viewMatrix);
 
-			///TODO: Cache the matrices in the light?
-			Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, Nz::Matrix4f::Ortho(0.f, 100.f, 100.f, 0.f, 1.f, 100.f));
-			Nz::Renderer::SetMatrix(Nz::MatrixType_View, Nz::Matrix4f::ViewMatrix(lightNode.GetRotation() * Nz::Vector3f::Forward() * 100.f, lightNode.GetRotation()));
+				m_shadowTechnique.Clear(Nz::SceneData());
+				DrawShadowCasters(range, true);
+			}
+
+			// The static casters are copied, the dynamic ones drawn over them
+			m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, shadowMap, face);
+			Nz::RenderTexture::Blit(&m_shadowCacheRT, staticLayerRect, &m_shadowRT, shadowMapRect, Nz::RendererBuffer_Depth);
+
+			Nz::Renderer::SetTarget(&m_shadowRT);
+			Nz::Renderer::SetViewport(shadowMapViewport);
+			Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+			Nz::Renderer::SetMatrix(Nz::MatrixType_View, viewMatrix);
+
+			DrawShadowCasters(range, false);
+		};
+
+		// Draws the casters skipped by a layered draw, which is the only one to apply the per-face culling
+		auto DrawSkippedCasters = [&] (Nz::RenderTexture& renderTexture, Nz::Texture* texture, const Nz::Recti& viewport, const Nz::Matrix4f& projectionMatrix, const CubemapFaces& cubemapFaces, bool staticCasters)
+		{
+			m_shadowTechnique.SkipLayeredMaterials(true);
 
-			m_shadowTechnique.Clear(dummySceneData);
-			m_shadowTechnique.Draw(dummySceneData);
+			for (unsigned int face = 0; face < 6; ++face)
+			{
+				renderTexture.AttachTexture(Nz::AttachmentPoint_Depth, 0, texture, face);
+
+				Nz::Renderer::SetTarget(&renderTexture);
+				Nz::Renderer::SetViewport(viewport);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_View, cubemapFaces.viewMatrices[face]);
+
+				DrawShadowCasters(range, staticCasters);
+			}
+
+			m_shadowTechnique.SkipLayeredMaterials(false);
+		};
+
+		// The six faces are drawn at once, the geometry shader routing the triangles to the faces they touch
+		auto UpdateCubemap = [&] (const Nz::Matrix4f& projectionMatrix, const Nz::Matrix4f& viewMatrix, const CubemapFaces& cubemapFaces)
+		{
+			if (rebuildStaticLayer)
+			{
+				m_shadowCacheRT.AttachLayeredTexture(Nz::AttachmentPoint_Depth, 0, cache.staticLayer);
+
+				// The view matrix only orients the billboards
+				Nz::Renderer::SetTarget(&m_shadowCacheRT);
+				Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+				Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+				Nz::Renderer::SetMatrix(Nz::MatrixType_View, viewMatrix);
+
+				m_shadowTechnique.Clear(Nz::SceneData());
+				if (DrawShadowCasters(range, true, &cubemapFaces))
+					DrawSkippedCasters(m_shadowCacheRT, cache.staticLayer, Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y), projectionMatrix, cubemapFaces, true);
+			}
+
+			// Blitting only reads the first layer of a layered attachment, the static casters are copied face by face
+			for (unsigned int face = 0; face < 6; ++face)
+			{
+				m_shadowCacheRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, cache.staticLayer, face);
+				m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, shadowMap, face);
+				Nz::RenderTexture::Blit(&m_shadowCacheRT, staticLayerRect, &m_shadowRT, shadowMapRect, Nz::RendererBuffer_Depth);
+			}
+
+			m_shadowRT.AttachLayeredTexture(Nz::AttachmentPoint_Depth, 0, shadowMap);
+
+			Nz::Renderer::SetTarget(&m_shadowRT);
+			Nz::Renderer::SetViewport(shadowMapViewport);
+			Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, projectionMatrix);
+			Nz::Renderer::SetMatrix(Nz::MatrixType_View, viewMatrix);
+
+			if (DrawShadowCasters(range, false, &cubemapFaces))
+				DrawSkippedCasters(m_shadowRT, shadowMap, shadowMapViewport, projectionMatrix, cubemapFaces, false);
+		};
+
+		switch (lightComponent.GetLightType())
+		{
+			case Nz::LightType_Directional:
+				NazaraInternalError("Directional lights included in point/spot light list");
+				break;
+
+			case Nz::LightType_Point:
+			{
+				static Nz::Quaternionf rotations[6] =
+				{
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitX()), // nzCubemapFace_PositiveX
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitX()), // nzCubemapFace_NegativeX
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitY()), // nzCubemapFace_PositiveY
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitY()), // nzCubemapFace_NegativeY
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitZ()), // nzCubemapFace_PositiveZ
+					Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitZ())  // nzCubemapFace_NegativeZ
+				};
+
+				///TODO: Cache the matrices in the light?
+				Nz::Matrix4f projectionMatrix = Nz::Matrix4f::Perspective(Nz::FromDegrees(90.f), 1.f, 0.1f, lightComponent.GetRadius());
+				if (m_singlePassPointShadows)
+				{
+					CubemapFaces cubemapFaces;
+					for (unsigned int face = 0; face < 6; ++face)
+					{
+						Nz::Matrix4f viewMatrix = Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), rotations[face]);
+
+						cubemapFaces.frustums[face].Extract(viewMatrix, projectionMatrix);
+						cubemapFaces.viewMatrices[face] = viewMatrix;
+						cubemapFaces.viewProjMatrices[face] = Nz::Matrix4f::Concatenate(viewMatrix, projectionMatrix);
+					}
+
+					UpdateCubemap(projectionMatrix, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), rotations[0]), cubemapFaces);
+				}
+				else
+				{
+					for (unsigned int face = 0; face < 6; ++face)
+						UpdateFace(face, projectionMatrix, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), rotations[face]));
+				}
+
+				break;
+			}
+
+			case Nz::LightType_Spot:
+			{
+				///TODO: Cache the matrices in the light?
+				UpdateFace(0, Nz::Matrix4f::Perspective(lightComponent.GetOuterAngle()*2.f, 1.f, 0.1f, lightComponent.GetRadius()), Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), lightNode.GetRotation()));
+				break;
+			}
 		}
+
+		cache.dirty = false;
+		cache.lastUpdateFrame = m_frameIndex;
+		cache.staticLayerValid = true;
 	}
 
 	void RenderSystem::UpdatePointSpotShadowMaps()
 	{
+		NazaraGpuZone("RenderSystem::UpdatePointSpotShadowMaps");
+
 		if (!m_shadowRT.IsValid())
 			m_shadowRT.Create();
 
-		Nz::SceneData dummySceneData;
-		dummySceneData.ambientColor = Nz::Color(0, 0, 0);
-		dummySceneData.background = nullptr;
-		dummySceneData.viewer = nullptr; //< Depth technique doesn't require any viewer
+		if (!m_shadowCacheRT.IsValid())
+			m_shadowCacheRT.Create();
 
-		for (const Ndk::EntityHandle& light : m_pointSpotLights)
+		UpdateShadowCasters();
+
+		m_shadowLightsToUpdate.clear();
+		for (Entity* light : m_pointSpotLights)
 		{
 			LightComponent& lightComponent = light->GetComponent<LightComponent>();
 			NodeComponent& lightNode = light->GetComponent<NodeComponent>();
@@ -193,83 +1038,359 @@ namespace Ndk
 			if (!lightComponent.IsShadowCastingEnabled())
 				continue;
 
-			Nz::Vector2ui shadowMapSize(lightComponent.GetShadowMap()->GetSize());
+			ShadowMapCache& cache = m_shadowMapCaches[light->GetId()];
+
+			// Any change of the light itself invalidates its whole shadow map
+			Nz::Vector3f position = lightNode.GetPosition();
+			Nz::Quaternionf rotation = lightNode.GetRotation();
+			Nz::Rectui region = lightComponent.GetShadowMapRegion();
+			Nz::Vector2ui size(region.width, region.height);
+			if (cache.format != lightComponent.GetShadowMapFormat() || cache.size != size || cache.type != lightComponent.GetLightType() ||
+			    cache.position != position || cache.rotation != rotation || cache.radius != lightComponent.GetRadius() || cache.outerAngle != lightComponent.GetOuterAngle())
+			{
+				cache.format = lightComponent.GetShadowMapFormat();
+				cache.outerAngle = lightComponent.GetOuterAngle();
+				cache.position = position;
+				cache.radius = lightComponent.GetRadius();
+				cache.rotation = rotation;
+				cache.size = size;
+				cache.type = lightComponent.GetLightType();
+
+				cache.staticLayerValid = false;
+			}
 
-			switch (lightComponent.GetLightType())
+			// A region moved in the atlas keeps its static layer, but has to be drawn again before anything else
+			if (cache.region != region)
 			{
-				case Nz::LightType_Directional:
-					NazaraInternalError("Directional lights included in point/spot light list");
+				cache.region = region;
+				cache.dirty = true;
+				cache.lastUpdateFrame = 0;
+			}
+
+			Nz::Spheref range(position, cache.radius);
+			for (const Nz::Boxf& box : m_changedCasterBoxes)
+			{
+				if (range.Intersect(box))
+				{
+					cache.dirty = true;
 					break;
+				}
+			}
+
+			if (!cache.staticLayerValid || cache.dirty)
+				m_shadowLightsToUpdate.push_back(light);
+		}
 
-				case Nz::LightType_Point:
+		// With a budget, the lights waiting for the longest time go first
+		if (m_shadowMapUpdateBudget > 0 && m_shadowLightsToUpdate.size() > m_shadowMapUpdateBudget)
+		{
+			std::partial_sort(m_shadowLightsToUpdate.begin(), m_shadowLightsToUpdate.begin() + m_shadowMapUpdateBudget, m_shadowLightsToUpdate.end(), [this] (Entity* light1, Entity* light2)
+			{
+				return m_shadowMapCaches[light1->GetId()].lastUpdateFrame < m_shadowMapCaches[light2->GetId()].lastUpdateFrame;
+			});
+
+			m_shadowLightsToUpdate.resize(m_shadowMapUpdateBudget);
+		}
+
+		for (Entity* light : m_shadowLightsToUpdate)
+			UpdatePointSpotShadowMap(light->GetComponent<LightComponent>(), light->GetComponent<NodeComponent>(), m_shadowMapCaches[light->GetId()]);
+
+		m_changedCasterBoxes.clear();
+		m_frameIndex++;
+	}
+
+	void RenderSystem::UpdateResolutionScale()
+	{
+		// The timer about to be reused was filled a few frames ago, its results should be there without waiting for them
+		ResolutionTimer& timer = m_resolutionTimers[m_frameIndex % m_resolutionTimers.size()];
+		if (timer.pending)
+		{
+			bool available = true;
+			Nz::UInt64 elapsedTime = 0;
+			for (std::size_t i = 0; i < timer.queryCount; ++i)
+			{
+				const Nz::GpuQuery& query = *timer.queries[i];
+				if (!query.IsResultAvailable())
 				{
-					static Nz::Quaternionf rotations[6] =
-					{
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitX()), // nzCubemapFace_PositiveX
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitX()), // nzCubemapFace_NegativeX
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitY()), // nzCubemapFace_PositiveY
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitY()), // nzCubemapFace_NegativeY
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(), -Nz::Vector3f::UnitZ()), // nzCubemapFace_PositiveZ
-						Nz::Quaternionf::RotationBetween(Nz::Vector3f::Forward(),  Nz::Vector3f::UnitZ())  // nzCubemapFace_NegativeZ
-					};
+					available = false;
+					break;
+				}
 
-					for (unsigned int face = 0; face < 6; ++face)
-					{
-						m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, lightComponent.GetShadowMap(), face);
-						Nz::Renderer::SetTarget(&m_shadowRT);
-						Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+				elapsedTime += query.GetResult();
+			}
+
+			if (available && elapsedTime > 0)
+			{
+				float gpuTime = elapsedTime / 1000000000.f; // Nanoseconds
+
+				// The cost of the pixels being proportional to their count, the sides of the viewports follow the square root of the ratio
+				float idealScale = m_resolutionScale * std::sqrt(m_resolutionTargetTime / gpuTime);
+
+				// Halfway there, as the measures are late and noisy
+				float scale = m_resolutionScale + (idealScale - m_resolutionScale) * 0.5f;
+				scale = std::round(scale / s_resolutionScaleStep) * s_resolutionScaleStep;
+
+				m_resolutionScale = Nz::Clamp(scale, m_minResolutionScale, m_maxResolutionScale);
+			}
+		}
+
+		timer.queryCount = 0;
+		timer.pending = false;
+	}
+
+	void RenderSystem::UpdateShadowAtlas()
+	{
+		// A new size or format packs every light again, in a new atlas
+		if (m_shadowAtlasInvalidated)
+		{
+			for (Entity* light : m_lights)
+				light->GetComponent<LightComponent>().ClearShadowMapAtlas();
 
-						///TODO: Cache the matrices in the light?
-						Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, Nz::Matrix4f::Perspective(Nz::FromDegrees(90.f), 1.f, 0.1f, lightComponent.GetRadius()));
-						Nz::Renderer::SetMatrix(Nz::MatrixType_View, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), rotations[face]));
+			m_shadowAtlas.Reset();
+			m_shadowAtlasRegions.clear();
+			m_shadowAtlasInvalidated = false;
+		}
 
-						Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
-						renderQueue->Clear();
+		if (!m_shadowAtlasEnabled)
+			return;
 
-						///TODO: Culling
-						for (const Ndk::EntityHandle& drawable : m_drawables)
-						{
-							GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-							NodeComponent& drawableNode = drawable->GetComponent<NodeComponent>();
+		for (Entity* light : m_lights)
+		{
+			LightComponent& lightComponent = light->GetComponent<LightComponent>();
+			NodeComponent& lightNode = light->GetComponent<NodeComponent>();
 
-							graphicsComponent.AddToRenderQueue(renderQueue);
-						}
+			// Point lights keep their cubemap
+			Nz::LightType lightType = lightComponent.GetLightType();
+			if (!lightComponent.IsShadowCastingEnabled() || lightType == Nz::LightType_Point || lightComponent.GetShadowMapFormat() != m_shadowAtlasFormat)
+			{
+				ReleaseShadowAtlasRegion(light);
+				continue;
+			}
 
-						m_shadowTechnique.Clear(dummySceneData);
-						m_shadowTechnique.Draw(dummySceneData);
+			Nz::Vector2ui shadowMapSize = lightComponent.GetShadowMapSize();
+			if (lightType == Nz::LightType_Directional)
+				shadowMapSize.x *= lightComponent.GetShadowCascadeCount();
+
+			// Directional lights cover the whole view, spot lights get a part of their shadow map size following their size on screen
+			float importance = 1.f;
+			if (lightType == Nz::LightType_Spot)
+			{
+				Nz::Vector3f position = lightNode.GetPosition();
+				float radius = lightComponent.GetRadius();
+
+				importance = s_minShadowAtlasImportance;
+				for (Entity* camera : m_cameras)
+				{
+					const CameraComponent& camComponent = camera->GetComponent<CameraComponent>();
+
+					float distance = camComponent.GetEyePosition().Distance(position);
+					if (distance <= radius)
+					{
+						importance = 1.f;
+						break;
 					}
-					break;
+
+					// Projected radius of the range of the light, one when it fills the height of the viewport
+					importance = std::max(importance, radius / distance * camComponent.GetProjectionMatrix()(1, 1));
 				}
 
-				case Nz::LightType_Spot:
+				importance = std::min(importance, 1.f);
+			}
+
+			Nz::Vector2f idealSize = Nz::Vector2f(shadowMapSize) * importance;
+
+			// A region is only replaced when too small or way too big, the light moving on screen doesn't move it back and forth
+			auto it = m_shadowAtlasRegions.find(light->GetId());
+			if (it != m_shadowAtlasRegions.end())
+			{
+				const Nz::Rectui& region = it->second;
+				if (region.width >= idealSize.x && region.height >= idealSize.y && region.width * 0.4f <= idealSize.x && region.height * 0.4f <= idealSize.y)
+					continue;
+			}
+
+			if (!m_shadowAtlas)
+			{
+				unsigned int maxTextureSize = Nz::Renderer::GetMaxTextureSize();
+				Nz::Vector2ui atlasSize(std::min(m_shadowAtlasSize.x, maxTextureSize), std::min(m_shadowAtlasSize.y, maxTextureSize));
+
+				m_shadowAtlas = Nz::Texture::New();
+				if (!m_shadowAtlas->Create(Nz::ImageType_2D, m_shadowAtlasFormat, atlasSize.x, atlasSize.y))
 				{
-					m_shadowRT.AttachTexture(Nz::AttachmentPoint_Depth, 0, lightComponent.GetShadowMap());
-					Nz::Renderer::SetTarget(&m_shadowRT);
-					Nz::Renderer::SetViewport(Nz::Recti(0, 0, shadowMapSize.x, shadowMapSize.y));
+					NazaraError("Failed to create shadow atlas, lights will keep their own shadow map");
 
-					///TODO: Cache the matrices in the light?
-					Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, Nz::Matrix4f::Perspective(lightComponent.GetOuterAngle()*2.f, 1.f, 0.1f, lightComponent.GetRadius()));
-					Nz::Renderer::SetMatrix(Nz::MatrixType_View, Nz::Matrix4f::ViewMatrix(lightNode.GetPosition(), lightNode.GetRotation()));
+					m_shadowAtlas.Reset();
+					m_shadowAtlasEnabled = false;
+					return;
+				}
 
-					Nz::AbstractRenderQueue* renderQueue = m_shadowTechnique.GetRenderQueue();
-					renderQueue->Clear();
+				m_shadowAtlasPacker.Reset(atlasSize);
+			}
 
-					///TODO: Culling
-					for (const Ndk::EntityHandle& drawable : m_drawables)
-					{
-						GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-						NodeComponent& drawableNode = drawable->GetComponent<NodeComponent>();
+			auto GetRegionSize = [&] (unsigned int size, float idealSide)
+			{
+				unsigned int regionSize = Nz::GetNearestPowerOfTwo(static_cast<unsigned int>(std::ceil(idealSide)));
+				return std::min(std::max(regionSize, s_minShadowAtlasRegionSize), size);
+			};
+
+			// The new region is inserted before the old one is freed, a light not finding a bigger one keeps its current region
+			// Flipped regions are refused, as the cascades of directional lights are laid out horizontally
+			Nz::Rectui region;
+			bool inserted = false;
+			for (;;)
+			{
+				region.Set(0U, 0U, GetRegionSize(shadowMapSize.x, idealSize.x), GetRegionSize(shadowMapSize.y, idealSize.y));
 
-						graphicsComponent.AddToRenderQueue(renderQueue);
+				bool flipped;
+				if (m_shadowAtlasPacker.Insert(&region, &flipped, 1, false, Nz::GuillotineBinPack::RectBestAreaFit, Nz::GuillotineBinPack::SplitMinimizeArea))
+				{
+					if (!flipped)
+					{
+						inserted = true;
+						break;
 					}
 
-					m_shadowTechnique.Clear(dummySceneData);
-					m_shadowTechnique.Draw(dummySceneData);
-					break;
+					m_shadowAtlasPacker.FreeRectangle(region);
 				}
+
+				// Without a region yet, smaller ones are tried before giving up
+				if (it != m_shadowAtlasRegions.end() || (region.width <= s_minShadowAtlasRegionSize && region.height <= s_minShadowAtlasRegionSize))
+					break;
+
+				idealSize /= 2.f;
+			}
+
+			if (!inserted)
+			{
+				// Not enough room, the light keeps its current region or its own shadow map
+				if (it == m_shadowAtlasRegions.end())
+					lightComponent.ClearShadowMapAtlas();
+
+				continue;
 			}
+
+			ReleaseShadowAtlasRegion(light);
+
+			lightComponent.SetShadowMapAtlas(m_shadowAtlas, region);
+			m_shadowAtlasRegions[light->GetId()] = region;
 		}
 	}
 
+	void RenderSystem::UpdateShadowCasters()
+	{
+		for (Entity* drawable : m_drawables)
+		{
+			const Nz::BoundingVolumef& boundingVolume = drawable->GetComponent<GraphicsComponent>().GetBoundingVolume();
+			if (!boundingVolume.IsFinite())
+				continue;
+
+			auto pair = m_shadowCasters.emplace(drawable->GetId(), ShadowCaster());
+			ShadowCaster& caster = pair.first->second;
+
+			if (pair.second)
+			{
+				caster.aabb = boundingVolume.aabb;
+				caster.lastChangeFrame = m_frameIndex;
+
+				m_changedCasterBoxes.push_back(caster.aabb);
+			}
+			else if (caster.aabb != boundingVolume.aabb)
+			{
+				// A static caster leaving the static layers invalidates them, the dynamic ones are drawn every update anyway
+				m_changedCasterBoxes.push_back(caster.aabb);
+				m_changedCasterBoxes.push_back(boundingVolume.aabb);
+
+				if (m_frameIndex - caster.lastChangeFrame >= s_staticCasterFrameCount)
+					InvalidateStaticShadowLayers(caster.aabb);
+
+				caster.aabb = boundingVolume.aabb;
+				caster.lastChangeFrame = m_frameIndex;
+			}
+			else if (m_frameIndex - caster.lastChangeFrame == s_staticCasterFrameCount)
+			{
+				// Became static, it is moved to the static layers
+				m_changedCasterBoxes.push_back(caster.aabb);
+				InvalidateStaticShadowLayers(caster.aabb);
+			}
+		}
+	}
+
+	void RenderSystem::UpscaleResolutionTarget(const CameraComponent& camera, ResolutionTarget& resolutionTarget)
+	{
+		camera.ApplyView();
+
+		resolutionTarget.upscaleMaterial->Apply();
+
+		Nz::Renderer::SetIndexBuffer(nullptr);
+		Nz::Renderer::SetVertexBuffer(&resolutionTarget.upscaleQuad);
+		Nz::Renderer::DrawPrimitives(Nz::PrimitiveMode_TriangleStrip, 0, 4);
+	}
+
+	void RenderSystem::ScaledViewer::ApplyView() const
+	{
+		NazaraAssert(m_camera, "Invalid camera");
+
+		Nz::Renderer::SetMatrix(Nz::MatrixType_Projection, m_camera->GetProjectionMatrix());
+		Nz::Renderer::SetMatrix(Nz::MatrixType_View, m_camera->GetViewMatrix());
+		Nz::Renderer::SetTarget(m_target);
+		Nz::Renderer::SetViewport(m_viewport);
+	}
+
+	float RenderSystem::ScaledViewer::GetAspectRatio() const
+	{
+		return m_camera->GetAspectRatio();
+	}
+
+	Nz::Vector3f RenderSystem::ScaledViewer::GetEyePosition() const
+	{
+		return m_camera->GetEyePosition();
+	}
+
+	Nz::Vector3f RenderSystem::ScaledViewer::GetForward() const
+	{
+		return m_camera->GetForward();
+	}
+
+	const Nz::Frustumf& RenderSystem::ScaledViewer::GetFrustum() const
+	{
+		return m_camera->GetFrustum();
+	}
+
+	const Nz::Matrix4f& RenderSystem::ScaledViewer::GetProjectionMatrix() const
+	{
+		return m_camera->GetProjectionMatrix();
+	}
+
+	const Nz::RenderTarget* RenderSystem::ScaledViewer::GetTarget() const
+	{
+		return m_target;
+	}
+
+	const Nz::Matrix4f& RenderSystem::ScaledViewer::GetViewMatrix() const
+	{
+		return m_camera->GetViewMatrix();
+	}
+
+	const Nz::Recti& RenderSystem::ScaledViewer::GetViewport() const
+	{
+		return m_viewport;
+	}
+
+	float RenderSystem::ScaledViewer::GetZFar() const
+	{
+		return m_camera->GetZFar();
+	}
+
+	float RenderSystem::ScaledViewer::GetZNear() const
+	{
+		return m_camera->GetZNear();
+	}
+
+	void RenderSystem::ScaledViewer::Reset(const CameraComponent* camera, const Nz::RenderTarget* target, const Nz::Recti& viewport)
+	{
+		m_camera = camera;
+		m_target = target;
+		m_viewport = viewport;
+	}
+
 	SystemIndex RenderSystem::systemIndex;
 }
@@ -6,6 +6,7 @@
 #include <NDK/Components/NodeComponent.hpp>
 #include <NDK/Components/PhysicsComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/World.hpp>
 
 namespace Ndk
 {
@@ -17,13 +18,23 @@ namespace Ndk
 
 	void VelocitySystem::OnUpdate(float elapsedTime)
 	{
-		for (const Ndk::EntityHandle& entity : GetEntities())
+		m_movedNodes.clear();
+		m_movements.clear();
+
+		// Velocities are read in the order of their pool, nodes are then found from the entity id without going through the entity
+		ComponentPool<NodeComponent>& nodes = GetWorld().GetComponentPool<NodeComponent>();
+		GetWorld().GetComponentPool<VelocityComponent>().ForEach([&] (EntityId entityId, const VelocityComponent& velocity)
 		{
-			NodeComponent& node = entity->GetComponent<NodeComponent>();
-			const VelocityComponent& velocity = entity->GetComponent<VelocityComponent>();
+			// Disabled entities and those with a physics component have a velocity but are not part of the system
+			if (HasEntity(entityId))
+			{
+				m_movedNodes.push_back(&nodes.Get(entityId));
+				m_movements.push_back(velocity.linearVelocity * elapsedTime);
+			}
+		});
 
-			node.Move(velocity.linearVelocity * elapsedTime);
-		}
+		// Nodes of the NodeSystem hierarchy are moved all at once, and signal it during its update
+		Nz::Node::MoveNodes(m_movedNodes.data(), m_movements.data(), m_movedNodes.size());
 	}
 
 	SystemIndex VelocitySystem::systemIndex;
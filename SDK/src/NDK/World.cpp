@@ -3,7 +3,14 @@
 // For conditions of distribution and use, see copyright notice in Prerequesites.hpp
 
 #include <NDK/World.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <NDK/BaseComponent.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <NDK/Systems/NodeSystem.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
 
@@ -14,6 +21,61 @@
 
 namespace Ndk
 {
+	namespace
+	{
+		// Au-delà, un snapshot est rejeté plutôt que de laisser ses compteurs décider des allocations
+		constexpr Nz::UInt32 MaxSnapshotCount = 1U << 24;
+		constexpr Nz::UInt32 MaxSnapshotComponentSize = 1U << 24;
+
+		Nz::UInt64 GetRemainingSize(const Nz::ByteStream& stream)
+		{
+			Nz::Stream* source = stream.GetStream();
+
+			Nz::UInt64 size = source->GetSize();
+			Nz::UInt64 cursor = source->GetCursorPos();
+			return (cursor < size) ? size - cursor : 0;
+		}
+
+		bool ReadSnapshotCount(Nz::ByteStream& stream, Nz::UInt64 minimalElementSize, Nz::UInt32* count)
+		{
+			if (!stream.ReadArray(count, 1))
+				return false;
+
+			// Chaque élément occupe au moins minimalElementSize octets dans le reste du stream
+			return *count <= MaxSnapshotCount && *count <= GetRemainingSize(stream) / minimalElementSize;
+		}
+
+		template<typename T>
+		void ReserveMore(std::vector<T>& vector, std::size_t count)
+		{
+			// Croissance géométrique, pour que des lots successifs restent amortis
+			std::size_t size = vector.size() + count;
+			if (size > vector.capacity())
+				vector.reserve(std::max(size, 2 * vector.capacity()));
+		}
+	}
+
+	struct World::SnapshotChanges
+	{
+		struct ComponentData
+		{
+			ComponentIndex index;
+			std::size_t offset; //< In componentData
+			std::size_t size;
+		};
+
+		struct EntityChanges
+		{
+			EntityGenerationalId id;
+			std::vector<ComponentIndex> removedComponents;
+			std::vector<ComponentData> components;
+		};
+
+		std::vector<EntityGenerationalId> removedEntities;
+		std::vector<EntityChanges> entities;
+		Nz::ByteArray componentData;
+	};
+
 	World::~World() noexcept
 	{
 		// La destruction doit se faire dans un ordre précis
@@ -24,6 +86,7 @@ namespace Ndk
 	{
 		AddSystem<PhysicsSystem>();
 		AddSystem<VelocitySystem>();
+		AddSystem<NodeSystem>();
 
 		#ifndef NDK_SERVER
 		AddSystem<ListenerSystem>();
@@ -31,45 +94,108 @@ namespace Ndk
 		#endif
 	}
 
-	const EntityHandle& World::CreateEntity()
+	World::EntityList World::CreateEntities(unsigned int count)
 	{
-		EntityId id;
-		if (!m_freeIdList.empty())
+		///DOC: Le stockage du monde n'est agrandi qu'une fois pour tout le lot
+		ReserveEntities(count);
+
+		EntityList list;
+		list.reserve(count);
+
+		for (unsigned int i = 0; i < count; ++i)
+			list.emplace_back(AllocateEntity().CreateHandle());
+
+		return list;
+	}
+
+	World::EntityList World::CreateEntities(unsigned int count, const Entity* prototype)
+	{
+		///DOC: Les entités reçoivent une copie de chaque component du prototype
+		NazaraAssert(prototype && prototype->IsValid(), "Invalid prototype");
+
+		const Nz::Bitset<>& componentBits = prototype->GetComponentBits();
+
+		std::vector<const BaseComponent*> components;
+		for (std::size_t i = componentBits.FindFirst(); i != componentBits.npos; i = componentBits.FindNext(i))
+			components.push_back(prototype->m_components[i]);
+
+		return CreateEntities(count, components);
+	}
+
+	World::EntityList World::CreateEntities(unsigned int count, const std::vector<const BaseComponent*>& components)
+	{
+		///DOC: Les entités reçoivent une copie de chaque component de la liste
+		NazaraProfileZone("World::CreateEntities");
+
+		EntityList list = CreateEntities(count);
+
+		// Les pools réservent leurs components d'un coup, avant qu'une copie ne soit faite
+		ComponentIndex componentCount = 0;
+		for (const BaseComponent* component : components)
 		{
-			// On récupère un identifiant
-			id = m_freeIdList.back();
-			m_freeIdList.pop_back();
+			NazaraAssert(component, "Invalid component");
+
+			ComponentIndex index = component->GetIndex();
+			componentCount = std::max<ComponentIndex>(componentCount, index + 1);
+
+			BaseComponentPool& pool = GetComponentPool(index);
+			pool.Reserve(pool.GetCount() + count);
 		}
-		else
+
+		if (m_dirtyEntities.GetSize() < m_entities.size())
+			m_dirtyEntities.Resize(m_entities.size(), false);
+
+		for (const EntityHandle& entity : list)
 		{
-			// On alloue une nouvelle entité
-			id = m_entities.size();
+			entity->m_components.resize(componentCount, nullptr);
 
-			// Impossible d'utiliser emplace_back à cause de la portée
-			m_entities.push_back(Entity(this, id));
+			for (const BaseComponent* component : components)
+			{
+				BaseComponentPool& pool = GetComponentPool(component->GetIndex());
+				entity->AttachComponent(pool.Clone(entity->GetId(), *component));
+			}
 		}
 
-		// On initialise l'entité et on l'ajoute à la liste des entités vivantes
-		Entity& entity = m_entities[id].entity;
-		entity.Create();
+		return list;
+	}
 
-		m_aliveEntities.emplace_back(&entity);
-		m_entities[id].aliveIndex = m_aliveEntities.size()-1;
+	const EntityHandle& World::CreateEntity()
+	{
+		///DOC: Les entités créées sans handle depuis le dernier appel en reçoivent un également
+		AllocateEntity();
+		UpdateAliveHandles();
 
-		return m_aliveEntities.back();
+		return m_aliveHandles.back();
 	}
 
 	void World::Clear() noexcept
 	{
 		///DOC: Tous les handles sont correctement invalidés, les entités sont immédiatement invalidées
 
-		// Destruction des entités d'abord, et des handles ensuite
-		// ceci pour éviter que les handles n'informent les entités inutilement lors de leur destruction
+		// Destruction des entités, qui invalident leurs handles et quittent leurs systèmes
 		m_entities.clear();
 
+		// Les identifiants générationnels des entités détruites ne doivent pas désigner les prochaines
+		for (Nz::UInt32& generation : m_entityGenerations)
+			generation++;
+
 		m_aliveEntities.clear();
+		m_aliveHandles.clear();
+		m_firstOutdatedAliveHandle = 0;
+		m_freeIdList.clear();
 		m_dirtyEntities.Clear();
 		m_killedEntities.Clear();
+		m_entitiesFullyInvalidated = false;
+
+		// Les systèmes et les listes d'entités se débarrassent des identifiants des entités détruites
+		for (auto& system : m_systems)
+		{
+			if (system)
+				system->FlushRemovedEntities();
+		}
+
+		for (Ndk::EntityList* list : m_entityLists)
+			list->Clear();
 	}
 
 	void World::KillEntity(Entity* entity)
@@ -80,10 +206,26 @@ namespace Ndk
 			m_killedEntities.UnboundedSet(entity->GetId(), true);
 	}
 
+	BaseComponentPool& World::GetComponentPool(ComponentIndex index)
+	{
+		if (index >= m_componentPools.size())
+			m_componentPools.resize(index + 1);
+
+		// Les pools sont créés à la demande, par la factory enregistrée avec le component
+		std::unique_ptr<BaseComponentPool>& pool = m_componentPools[index];
+		if (!pool)
+			pool = BaseComponent::CreatePool(index);
+
+		return *pool;
+	}
+
 	const EntityHandle& World::GetEntity(EntityId id)
 	{
 		if (IsEntityIdValid(id))
-			return m_aliveEntities[m_entities[id].aliveIndex];
+		{
+			UpdateAliveHandles();
+			return m_aliveHandles[m_entities[id].aliveIndex];
+		}
 		else
 		{
 			NazaraError("Invalid ID");
@@ -91,43 +233,383 @@ namespace Ndk
 		}
 	}
 
+	Entity& World::AllocateEntity()
+	{
+		EntityId id;
+		if (!m_freeIdList.empty())
+		{
+			// On récupère un identifiant
+			id = m_freeIdList.back();
+			m_freeIdList.pop_back();
+		}
+		else
+		{
+			// On alloue une nouvelle entité
+			id = m_entities.size();
+
+			// Impossible d'utiliser emplace_back à cause de la portée
+			m_entities.push_back(Entity(this, id));
+
+			// La table des components est allouée d'emblée, celles des entités créées à la suite sont ainsi contiguës en mémoire
+			m_entities[id].entity.m_components.reserve(BaseComponent::GetMaxComponentIndex());
+
+			if (id >= m_entityGenerations.size())
+				m_entityGenerations.push_back(0);
+		}
+
+		// On initialise l'entité et on l'ajoute à la liste des entités vivantes, sans lui créer de handle
+		Entity& entity = m_entities[id].entity;
+		entity.Create(m_entityGenerations[id]);
+
+		m_aliveEntities.push_back(id);
+		m_entities[id].aliveIndex = m_aliveEntities.size()-1;
+
+		return entity;
+	}
+
+	bool World::ReadSnapshot(Nz::ByteStream& stream, SnapshotChanges* changes)
+	{
+		constexpr Nz::UInt64 generationalIdSize = sizeof(EntityId) + sizeof(Nz::UInt32);
+
+		Nz::UInt32 removedEntityCount;
+		if (!ReadSnapshotCount(stream, generationalIdSize, &removedEntityCount))
+			return false;
+
+		changes->removedEntities.resize(removedEntityCount);
+		for (EntityGenerationalId& id : changes->removedEntities)
+		{
+			if (!stream.ReadArray(&id.id, 1) || !stream.ReadArray(&id.generation, 1))
+				return false;
+		}
+
+		Nz::UInt32 entityCount;
+		if (!ReadSnapshotCount(stream, generationalIdSize + 2 * sizeof(Nz::UInt32), &entityCount))
+			return false;
+
+		// Les données de chaque component sont vérifiées en les chargeant dans un component témoin de son type
+		std::vector<std::unique_ptr<BaseComponent>> checkComponents;
+
+		changes->entities.resize(entityCount);
+		for (SnapshotChanges::EntityChanges& entity : changes->entities)
+		{
+			if (!stream.ReadArray(&entity.id.id, 1) || !stream.ReadArray(&entity.id.generation, 1))
+				return false;
+
+			Nz::UInt32 removedComponentCount;
+			if (!ReadSnapshotCount(stream, sizeof(ComponentId), &removedComponentCount))
+				return false;
+
+			entity.removedComponents.reserve(removedComponentCount);
+			for (Nz::UInt32 i = 0; i < removedComponentCount; ++i)
+			{
+				ComponentId componentId;
+				if (!stream.ReadArray(&componentId, 1))
+					return false;
+
+				ComponentIndex index;
+				if (BaseComponent::FindComponentIndex(componentId, &index))
+					entity.removedComponents.push_back(index);
+			}
+
+			Nz::UInt32 componentCount;
+			if (!ReadSnapshotCount(stream, sizeof(ComponentId) + sizeof(Nz::UInt32), &componentCount))
+				return false;
+
+			entity.components.reserve(componentCount);
+			for (Nz::UInt32 i = 0; i < componentCount; ++i)
+			{
+				ComponentId componentId;
+				Nz::UInt32 size;
+				if (!stream.ReadArray(&componentId, 1) || !stream.ReadArray(&size, 1))
+					return false;
+
+				if (size > MaxSnapshotComponentSize || size > GetRemainingSize(stream))
+					return false;
+
+				std::size_t offset = changes->componentData.GetSize();
+				changes->componentData.Resize(offset + size);
+				if (size > 0 && stream.Read(changes->componentData.GetBuffer() + offset, size) != size)
+					return false;
+
+				// Les components inconnus de ce programme sont ignorés, leur taille permet de les sauter
+				ComponentIndex index;
+				if (!BaseComponent::FindComponentIndex(componentId, &index) || !BaseComponent::IsSerializable(index))
+				{
+					changes->componentData.Resize(offset);
+					continue;
+				}
+
+				if (index >= checkComponents.size())
+					checkComponents.resize(index + 1);
+
+				std::unique_ptr<BaseComponent>& checkComponent = checkComponents[index];
+				if (!checkComponent)
+					checkComponent = BaseComponent::CreateComponent(index);
+
+				Nz::MemoryView componentView(changes->componentData.GetConstBuffer() + offset, size);
+				Nz::ByteStream componentStream(&componentView);
+				componentStream.SetDataEndianness(stream.GetDataEndianness());
+
+				if (!checkComponent->Unserialize(componentStream))
+					return false;
+
+				entity.components.push_back({index, offset, size});
+			}
+		}
+
+		return true;
+	}
+
+	void World::ReserveEntities(std::size_t count)
+	{
+		// Les identifiants libres sont réutilisés avant que de nouvelles entités ne soient allouées
+		std::size_t newEntityCount = (count > m_freeIdList.size()) ? count - m_freeIdList.size() : 0;
+
+		ReserveMore(m_entities, newEntityCount);
+		ReserveMore(m_aliveEntities, count);
+
+		if (m_entities.size() + newEntityCount > m_entityGenerations.size())
+			ReserveMore(m_entityGenerations, m_entities.size() + newEntityCount - m_entityGenerations.size());
+	}
+
+	bool World::SerializeSnapshot(Nz::ByteStream& stream, bool modifiedOnly)
+	{
+		///DOC: Les entités sont identifiées par leur identifiant générationnel, les components par leur ComponentId
+		NazaraProfileZone("World::SerializeSnapshot");
+
+		// Entités disparues (ou dont l'identifiant a été réutilisé) depuis le dernier snapshot
+		std::vector<EntityGenerationalId> removedEntities;
+		for (std::size_t i = 0; i < m_snapshotEntities.size(); ++i)
+		{
+			SnapshotEntity& snapshotEntity = m_snapshotEntities[i];
+
+			EntityGenerationalId id = {static_cast<EntityId>(i), snapshotEntity.generation};
+			if (snapshotEntity.written && !IsEntityIdValid(id))
+			{
+				removedEntities.push_back(id);
+
+				snapshotEntity.componentBits.Clear();
+				snapshotEntity.written = false;
+			}
+		}
+
+		stream << static_cast<Nz::UInt32>(removedEntities.size());
+		for (const EntityGenerationalId& id : removedEntities)
+			stream << id.id << id.generation;
+
+		// Chaque component est d'abord sérialisé à part, pour être comparé à celui du dernier snapshot
+		Nz::ByteArray componentData;
+		Nz::MemoryStream componentMemoryStream(&componentData, Nz::OpenMode_WriteOnly);
+		Nz::ByteStream componentStream(&componentMemoryStream);
+		componentStream.SetDataEndianness(stream.GetDataEndianness());
+
+		// Le nombre d'entités écrites n'est connu qu'à la fin
+		Nz::ByteArray entityData;
+		Nz::ByteStream entityStream(&entityData, Nz::OpenMode_WriteOnly);
+		entityStream.SetDataEndianness(stream.GetDataEndianness());
+
+		std::vector<ComponentIndex> removedComponents;
+		std::vector<ComponentIndex> writtenComponents;
+		Nz::UInt32 entityCount = 0;
+		for (EntityId aliveId : m_aliveEntities)
+		{
+			Entity* entity = &m_entities[aliveId].entity;
+
+			EntityGenerationalId id = entity->GetGenerationalId();
+			if (id.id >= m_snapshotEntities.size())
+				m_snapshotEntities.resize(id.id + 1);
+
+			SnapshotEntity& snapshotEntity = m_snapshotEntities[id.id];
+
+			bool isNew = !snapshotEntity.written;
+			if (isNew)
+			{
+				snapshotEntity.generation = id.generation;
+				snapshotEntity.written = true;
+			}
+
+			const Nz::Bitset<>& componentBits = entity->GetComponentBits();
+
+			removedComponents.clear();
+			for (std::size_t i = snapshotEntity.componentBits.FindFirst(); i != snapshotEntity.componentBits.npos; i = snapshotEntity.componentBits.FindNext(i))
+			{
+				if (!componentBits.UnboundedTest(i))
+					removedComponents.push_back(static_cast<ComponentIndex>(i));
+			}
+
+			for (ComponentIndex index : removedComponents)
+				snapshotEntity.componentBits.Reset(index);
+
+			writtenComponents.clear();
+			for (std::size_t i = componentBits.FindFirst(); i != componentBits.npos; i = componentBits.FindNext(i))
+			{
+				ComponentIndex index = static_cast<ComponentIndex>(i);
+				if (!BaseComponent::IsSerializable(index))
+					continue;
+
+				componentData.Clear(true);
+				componentMemoryStream.SetCursorPos(0);
+
+				if (!entity->GetComponent(index).Serialize(componentStream))
+				{
+					NazaraError("Failed to serialize component of entity #" + Nz::String::Number(id.id));
+
+					// Le prochain snapshot ne peut plus se baser sur celui-ci
+					m_snapshotEntities.clear();
+					return false;
+				}
+				componentStream.FlushBits();
+
+				if (index >= snapshotEntity.componentData.size())
+					snapshotEntity.componentData.resize(index + 1);
+
+				Nz::ByteArray& previousData = snapshotEntity.componentData[index];
+				if (modifiedOnly && snapshotEntity.componentBits.UnboundedTest(index) && previousData == componentData)
+					continue;
+
+				previousData = componentData;
+				snapshotEntity.componentBits.UnboundedSet(index, true);
+				writtenComponents.push_back(index);
+			}
+
+			if (modifiedOnly && !isNew && removedComponents.empty() && writtenComponents.empty())
+				continue;
+
+			entityStream << id.id << id.generation;
+
+			entityStream << static_cast<Nz::UInt32>(removedComponents.size());
+			for (ComponentIndex index : removedComponents)
+				entityStream << BaseComponent::GetComponentId(index);
+
+			entityStream << static_cast<Nz::UInt32>(writtenComponents.size());
+			for (ComponentIndex index : writtenComponents)
+			{
+				const Nz::ByteArray& data = snapshotEntity.componentData[index];
+				entityStream << BaseComponent::GetComponentId(index) << static_cast<Nz::UInt32>(data.GetSize());
+				if (!data.IsEmpty())
+					entityStream.Write(data.GetConstBuffer(), data.GetSize());
+			}
+
+			entityCount++;
+		}
+
+		stream << entityCount;
+		if (!entityData.IsEmpty())
+			stream.Write(entityData.GetConstBuffer(), entityData.GetSize());
+
+		return true;
+	}
+
+	bool World::UnserializeSnapshot(Nz::ByteStream& stream, SnapshotEntityMap* entities)
+	{
+		///DOC: Les entités du snapshot sont associées aux entités de ce monde par la table, complétée au fur et à mesure
+		///DOC: Le snapshot est entièrement lu et vérifié avant d'être appliqué, le monde et la table restent inchangés s'il est invalide
+		NazaraAssert(entities, "Invalid entity map");
+		NazaraAssert(stream.GetStream(), "Invalid stream");
+		NazaraProfileZone("World::UnserializeSnapshot");
+
+		SnapshotChanges changes;
+		if (!ReadSnapshot(stream, &changes))
+		{
+			NazaraError("Snapshot is truncated or corrupted");
+			return false;
+		}
+
+		for (const EntityGenerationalId& id : changes.removedEntities)
+		{
+			auto it = entities->find(id);
+			if (it != entities->end())
+			{
+				if (it->second)
+					it->second->Kill();
+
+				entities->erase(it);
+			}
+		}
+
+		for (const SnapshotChanges::EntityChanges& entityChanges : changes.entities)
+		{
+			EntityHandle& entity = (*entities)[entityChanges.id];
+			if (!entity)
+				entity = CreateEntity();
+
+			for (ComponentIndex index : entityChanges.removedComponents)
+				entity->RemoveComponent(index);
+
+			for (const SnapshotChanges::ComponentData& componentChanges : entityChanges.components)
+			{
+				ComponentIndex index = componentChanges.index;
+				BaseComponent& component = (entity->HasComponent(index)) ? entity->GetComponent(index) : entity->AddComponent(BaseComponent::CreateComponent(index));
+
+				Nz::MemoryView componentView(changes.componentData.GetConstBuffer() + componentChanges.offset, componentChanges.size);
+				Nz::ByteStream componentStream(&componentView);
+				componentStream.SetDataEndianness(stream.GetDataEndianness());
+
+				// Ces données ont déjà été acceptées par un component du même type, seul un component dépendant de son état peut les refuser ici
+				if (!component.Unserialize(componentStream))
+				{
+					NazaraError("Failed to unserialize component of entity #" + Nz::String::Number(entity->GetId()));
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
 	void World::Update()
 	{
+		NazaraProfileZone("World::Update");
+
 		// Gestion des entités tuées depuis le dernier appel
-		for (std::size_t i = m_killedEntities.FindFirst(); i != m_killedEntities.npos; i = m_killedEntities.FindNext(i))
+		m_destroyingEntities = m_killedEntities.TestAny();
+
+		for (std::size_t i : Nz::MakeBitsetExpression(m_killedEntities))
 		{
 			EntityBlock& block = m_entities[i];
 			Entity& entity = block.entity;
 
 			NazaraAssert(entity.IsValid(), "Entity must be valid");
 
-			// Remise en file d'attente de l'identifiant d'entité
+			// Remise en file d'attente de l'identifiant d'entité, sous une nouvelle génération
 			m_freeIdList.push_back(entity.GetId());
+			m_entityGenerations[entity.GetId()]++;
 
 			// Destruction de l'entité (invalidation du handle par la même occasion)
 			entity.Destroy();
 
-			// Nous allons sortir le handle de la liste des entités vivantes
-			// en swappant le handle avec le dernier handle, avant de pop
+			// Nous allons sortir l'identifiant de la liste des entités vivantes
+			// en le remplaçant par le dernier identifiant, avant de pop
 
 			NazaraAssert(block.aliveIndex < m_aliveEntities.size(), "Alive index out of range");
 
-			if (block.aliveIndex < m_aliveEntities.size()-1) // S'il ne s'agit pas du dernier handle
+			if (block.aliveIndex < m_aliveEntities.size()-1) // S'il ne s'agit pas du dernier identifiant
 			{
-				EntityHandle& lastHandle = m_aliveEntities.back();
-				EntityHandle& myHandle = m_aliveEntities[block.aliveIndex];
-
-				myHandle = std::move(lastHandle);
+				EntityId lastId = m_aliveEntities.back();
+				m_aliveEntities[block.aliveIndex] = lastId;
 
 				// On n'oublie pas de corriger l'indice associé à l'entité
-				m_entities[myHandle->GetId()].aliveIndex = block.aliveIndex;
+				m_entities[lastId].aliveIndex = block.aliveIndex;
 			}
 			m_aliveEntities.pop_back();
+
+			// Le handle de l'entité déplacée n'est plus à sa place
+			m_firstOutdatedAliveHandle = std::min<std::size_t>(m_firstOutdatedAliveHandle, block.aliveIndex);
 		}
+
+		// Les listes d'entités oublient les entités tuées, en une seule passe chacune
+		for (Ndk::EntityList* list : m_entityLists)
+			list->RemoveEntities(m_killedEntities);
+
 		m_killedEntities.Reset();
 
+		// Les entités créées en lot ont les mêmes components, le filtre de chaque système n'est alors évalué qu'une fois
+		Nz::Bitset<> filterComponentBits;
+		Nz::Bitset<> filteringSystems;
+		Nz::Bitset<> evaluatedSystems;
+
 		// Gestion des entités nécessitant une mise à jour de leurs systèmes
-		for (std::size_t i = m_dirtyEntities.FindFirst(); i != m_dirtyEntities.npos; i = m_dirtyEntities.FindNext(i))
+		for (std::size_t i : Nz::MakeBitsetExpression(m_dirtyEntities))
 		{
 			NazaraAssert(i < m_entities.size(), "Entity index out of range");
 
@@ -137,17 +619,37 @@ namespace Ndk
 			if (!entity->IsValid())
 				continue;
 
+			// Only the systems filtering the added or removed components may change their mind about the entity
+			bool fullyInvalidated = m_entitiesFullyInvalidated || entity->IsFullyInvalidated();
+			const Nz::Bitset<>& invalidatedComponents = entity->GetInvalidatedComponentBits();
+
+			if (entity->GetComponentBits() != filterComponentBits)
+			{
+				filterComponentBits = entity->GetComponentBits();
+				evaluatedSystems.Reset();
+			}
+
 			for (auto& system : m_systems)
 			{
 				// Ignore non-existent systems
 				if (!system)
 					continue;
 
+				if (!fullyInvalidated && !system->FiltersAnyComponent(invalidatedComponents))
+					continue;
+
 				// Is our entity already part of this system?
 				bool partOfSystem = system->HasEntity(entity);
 
+				SystemIndex systemIndex = system->GetIndex();
+				if (!evaluatedSystems.UnboundedTest(systemIndex))
+				{
+					filteringSystems.UnboundedSet(systemIndex, system->Filters(entity));
+					evaluatedSystems.UnboundedSet(systemIndex);
+				}
+
 				// Should it be part of it?
-				if (entity->IsEnabled() && system->Filters(entity))
+				if (entity->IsEnabled() && filteringSystems.UnboundedTest(systemIndex))
 				{
 					// Yes it should, add it to the system if not already done and validate it (again)
 					if (!partOfSystem)
@@ -162,7 +664,95 @@ namespace Ndk
 						system->RemoveEntity(entity);
 				}
 			}
+
+			entity->ResetInvalidation();
 		}
 		m_dirtyEntities.Reset();
+		m_entitiesFullyInvalidated = false;
+
+		// Removed entities leave the systems all at once
+		for (auto& system : m_systems)
+		{
+			if (system)
+				system->FlushRemovedEntities();
+		}
+
+		m_destroyingEntities = false;
+	}
+	void World::Update(float elapsedTime)
+	{
+		Update(); //< Update entities
+
+		// And then update systems, stage by stage
+		if (!m_systemStagesUpdated)
+			UpdateSystemStages();
+
+		for (const std::vector<BaseSystem*>& stage : m_systemStages)
+		{
+			if (stage.size() == 1)
+				stage.front()->Update(elapsedTime);
+			else
+			{
+				Nz::TaskScheduler::ParallelFor(0, stage.size(), 1, [&stage, elapsedTime] (std::size_t first, std::size_t last)
+				{
+					for (std::size_t i = first; i < last; ++i)
+						stage[i]->Update(elapsedTime);
+				});
+			}
+		}
+	}
+
+	void World::UpdateAliveHandles()
+	{
+		// Seuls les handles des entités créées ou déplacées dans la liste depuis le dernier appel sont recréés
+		std::size_t firstHandle = std::min(m_firstOutdatedAliveHandle, m_aliveHandles.size());
+
+		m_aliveHandles.resize(m_aliveEntities.size());
+		for (std::size_t i = firstHandle; i < m_aliveEntities.size(); ++i)
+		{
+			Entity& entity = m_entities[m_aliveEntities[i]].entity;
+			if (m_aliveHandles[i].GetObject() != &entity)
+				m_aliveHandles[i] = entity.CreateHandle();
+		}
+
+		m_firstOutdatedAliveHandle = m_aliveHandles.size();
+	}
+
+	void World::UpdateSystemStages()
+	{
+		// Systems keep their order relatively to the ones they conflict with, the others may run earlier
+		// Systems which did not declare their accesses conflict with everyone and get a stage of their own, run by the calling thread
+		m_systemStages.clear();
+		for (const auto& systemPtr : m_systems)
+		{
+			if (!systemPtr)
+				continue;
+
+			std::size_t stageIndex = 0;
+			for (std::size_t i = m_systemStages.size(); i-- > 0;)
+			{
+				auto conflictIt = std::find_if(m_systemStages[i].begin(), m_systemStages[i].end(), [&systemPtr] (const BaseSystem* system)
+				{
+					return systemPtr->Conflicts(*system);
+				});
+
+				if (conflictIt != m_systemStages[i].end())
+				{
+					stageIndex = i + 1;
+					break;
+				}
+			}
+
+			if (stageIndex == m_systemStages.size())
+				m_systemStages.emplace_back();
+
+			m_systemStages[stageIndex].push_back(systemPtr.get());
+		}
+
+		// Component pools are created on demand, which systems updated at the same time cannot do
+		for (ComponentIndex i = 0; i < BaseComponent::GetMaxComponentIndex(); ++i)
+			GetComponentPool(i);
+
+		m_systemStagesUpdated = true;
 	}
 }
@@ -28,6 +28,7 @@ MODULE.OsLibraries.Posix = {
 	"xcb-ewmh",
 	"xcb-icccm",
 	"xcb-keysyms",
-	"xcb-randr"
+	"xcb-randr",
+	"xcb-xinput"
 }
 
@@ -0,0 +1,23 @@
+TOOL.Name = "AssetCooker"
+
+TOOL.Directory = "../tests"
+TOOL.EnableConsole = true
+TOOL.Kind = "Application"
+TOOL.TargetDirectory = TOOL.Directory
+
+TOOL.Defines = {
+}
+
+TOOL.Includes = {
+	"../include"
+}
+
+TOOL.Files = {
+	"../tests/AssetCooker/**.hpp",
+	"../tests/AssetCooker/**.cpp"
+}
+
+TOOL.Libraries = {
+	"NazaraCore",
+	"NazaraUtility"
+}
@@ -0,0 +1,23 @@
+TOOL.Name = "Benchmarks"
+
+TOOL.Directory = "../tests"
+TOOL.EnableConsole = true
+TOOL.Kind = "Application"
+TOOL.TargetDirectory = TOOL.Directory
+
+TOOL.Defines = {
+}
+
+TOOL.Includes = {
+	"../include"
+}
+
+TOOL.Files = {
+	"../tests/Benchmarks/**.hpp",
+	"../tests/Benchmarks/**.cpp"
+}
+
+TOOL.Libraries = {
+	"NazaraCore",
+	"NazaraUtility"
+}
@@ -0,0 +1,23 @@
+TOOL.Name = "NetworkLoad"
+
+TOOL.Directory = "../tests"
+TOOL.EnableConsole = true
+TOOL.Kind = "Application"
+TOOL.TargetDirectory = TOOL.Directory
+
+TOOL.Defines = {
+}
+
+TOOL.Includes = {
+	"../include"
+}
+
+TOOL.Files = {
+	"../tests/NetworkLoad/**.hpp",
+	"../tests/NetworkLoad/**.cpp"
+}
+
+TOOL.Libraries = {
+	"NazaraCore",
+	"NazaraNetwork"
+}
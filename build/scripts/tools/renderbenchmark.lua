@@ -0,0 +1,24 @@
+TOOL.Name = "RenderBenchmark"
+
+TOOL.ClientOnly = true
+
+TOOL.Directory = "../tests"
+TOOL.EnableConsole = true
+TOOL.Kind = "Application"
+TOOL.TargetDirectory = TOOL.Directory
+
+TOOL.Defines = {
+}
+
+TOOL.Includes = {
+	"../include"
+}
+
+TOOL.Files = {
+	"../tests/RenderBenchmark/**.hpp",
+	"../tests/RenderBenchmark/**.cpp"
+}
+
+TOOL.Libraries = {
+	"NazaraSDK"
+}
@@ -14,6 +14,7 @@ TOOL.Includes = {
 
 TOOL.Files = {
 	"../tests/main.cpp",
+	"../tests/Engine/**.hpp",
 	"../tests/Engine/**.cpp"
 }
 
@@ -66,6 +66,7 @@ int main()
 		// On bouge la source du son en fonction du temps depuis chaque mise à jour
 		Nz::Vector3f pos = sound.GetPosition() + sound.GetVelocity()*clock.GetSeconds();
 		sound.SetPosition(pos);
+		Nz::Audio::Update(); // Envoie la nouvelle position à OpenAL
 
 		std::cout << "Sound position: " << pos << std::endl;
 
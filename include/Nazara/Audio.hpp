@@ -39,5 +39,6 @@
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
+#include <Nazara/Audio/VoiceManager.hpp>
 
 #endif // NAZARA_GLOBAL_AUDIO_HPP
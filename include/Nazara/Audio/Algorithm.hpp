@@ -8,10 +8,23 @@
 #define NAZARA_ALGORITHM_AUDIO_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Audio/Config.hpp>
 
 namespace Nz
 {
+	NAZARA_AUDIO_API void ConvertSamples(const Int16* input, float* output, std::size_t sampleCount);
+	NAZARA_AUDIO_API void ConvertSamples(const float* input, Int16* output, std::size_t sampleCount);
+
+	NAZARA_AUDIO_API unsigned int GetResampledFrameCount(unsigned int frameCount, UInt32 inputRate, UInt32 outputRate);
+
+	NAZARA_AUDIO_API void InterleaveStereo(const Int16* left, const Int16* right, Int16* output, unsigned int frameCount);
+	NAZARA_AUDIO_API void InterleaveStereo(const float* left, const float* right, float* output, unsigned int frameCount);
+
+	NAZARA_AUDIO_API void MixToMono(Int16* input, Int16* output, unsigned int channelCount, unsigned int frameCount);
+	NAZARA_AUDIO_API void MixToMono(float* input, float* output, unsigned int channelCount, unsigned int frameCount);
 	template<typename T> void MixToMono(T* input, T* output, unsigned int channelCount, unsigned int frameCount);
+
+	NAZARA_AUDIO_API void Resample(const Int16* input, Int16* output, unsigned int channelCount, unsigned int frameCount, UInt32 inputRate, UInt32 outputRate);
 }
 
 #include <Nazara/Audio/Algorithm.inl>
@@ -17,6 +17,7 @@ namespace Nz
 	* \param frameCount Number of frames
 	*
 	* \remark The input buffer may be the same as the output one
+	* \remark Int16 and float samples go through the SIMD overloads
 	*/
 	template<typename T>
 	void MixToMono(T* input, T* output, unsigned int channelCount, unsigned int frameCount)
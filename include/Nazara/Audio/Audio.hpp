@@ -49,6 +49,10 @@ namespace Nz
 
 			static void Uninitialize();
 
+			static void Update();
+
+			static constexpr bool ParallelInitialization = true;
+
 		private:
 			static unsigned int s_moduleReferenceCounter;
 	};
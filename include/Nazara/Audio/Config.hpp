@@ -43,6 +43,15 @@
 // The number of buffers used for audio streaming (At least two)
 #define NAZARA_AUDIO_STREAMED_BUFFER_COUNT 2
 
+// The number of threads shared by all musics to decode and queue their buffers
+#define NAZARA_AUDIO_STREAMING_THREAD_COUNT 2
+
+// The default amount of memory (in bytes) kept by decoded compressed sound buffers
+#define NAZARA_AUDIO_DECODED_CACHE_SIZE (16 * 1024 * 1024)
+
+// The maximum number of OpenAL sources shared by sounds, the other playing sounds are virtualized
+#define NAZARA_AUDIO_MAX_SOURCE_COUNT 64
+
 /// Checking the values and types of certain constants
 #include <Nazara/Audio/ConfigCheck.hpp>
 
@@ -19,6 +19,9 @@
 #endif
 
 NazaraCheckTypeAndVal(NAZARA_AUDIO_STREAMED_BUFFER_COUNT, integral, >, 0, " shall be a strictly positive integer");
+NazaraCheckTypeAndVal(NAZARA_AUDIO_STREAMING_THREAD_COUNT, integral, >, 0, " shall be a strictly positive integer");
+NazaraCheckTypeAndVal(NAZARA_AUDIO_DECODED_CACHE_SIZE, integral, >=, 0, " shall be a positive integer");
+NazaraCheckTypeAndVal(NAZARA_AUDIO_MAX_SOURCE_COUNT, integral, >, 0, " shall be a strictly positive integer");
 
 #undef NazaraCheckTypeAndVal
 
@@ -23,6 +23,7 @@ namespace Nz
 		bool IsValid() const;
 	};
 
+	class AudioStreamer;
 	class Music;
 	class SoundStream;
 
@@ -32,6 +33,7 @@ namespace Nz
 
 	class NAZARA_AUDIO_API Music : public Resource, public SoundEmitter
 	{
+		friend AudioStreamer;
 		friend MusicLoader;
 
 		public:
@@ -72,7 +74,9 @@ namespace Nz
 			MusicImpl* m_impl = nullptr;
 
 			bool FillAndQueueBuffer(unsigned int buffer);
-			void MusicThread();
+			void StartStreaming();
+			void StopStreaming();
+			bool UpdateStreaming(UInt32* nextUpdate);
 
 			static MusicLoader::LoaderList s_loaders;
 	};
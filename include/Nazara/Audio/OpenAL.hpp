@@ -64,6 +64,8 @@ namespace Nz
 	class NAZARA_AUDIO_API OpenAL
 	{
 		public:
+			static void DeferUpdates();
+
 			static OpenALFunc GetEntry(const String& entryPoint);
 			static String GetRendererName();
 			static String GetVendorName();
@@ -73,6 +75,8 @@ namespace Nz
 
 			static bool IsInitialized();
 
+			static void ProcessUpdates();
+
 			static std::size_t QueryInputDevices(std::vector<String>& devices);
 			static std::size_t QueryOutputDevices(std::vector<String>& devices);
 
@@ -11,13 +11,18 @@
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
+#include <limits>
 
 namespace Nz
 {
+	class VoiceManager;
+
 	class NAZARA_AUDIO_API Sound : public SoundEmitter
 	{
+		friend VoiceManager;
+
 		public:
-			Sound() = default;
+			Sound();
 			Sound(const SoundBuffer* soundBuffer);
 			Sound(const Sound& sound);
 			Sound(Sound&&) = default;
@@ -28,6 +33,7 @@ namespace Nz
 			const SoundBuffer* GetBuffer() const;
 			UInt32 GetDuration() const;
 			UInt32 GetPlayingOffset() const;
+			int GetPriority() const;
 			SoundStatus GetStatus() const;
 
 			bool IsLooping() const;
@@ -43,6 +49,7 @@ namespace Nz
 
 			void SetBuffer(const SoundBuffer* buffer);
 			void SetPlayingOffset(UInt32 offset);
+			void SetPriority(int priority);
 
 			void Stop();
 
@@ -50,7 +57,19 @@ namespace Nz
 			Sound& operator=(Sound&&) = default;
 
 		private:
+			UInt32 ComputeVirtualOffset() const;
+
+			static constexpr std::size_t InvalidVoice = std::numeric_limits<std::size_t>::max();
+
 			SoundBufferConstRef m_buffer;
+			SoundStatus m_status;
+			UInt64 m_offsetTime; //< When m_offset was measured, in microseconds
+			UInt32 m_offset;
+			std::size_t m_voiceIndex; //< Position in the voice manager while playing or paused
+			int m_priority;
+			unsigned int m_openALBuffer; //< Buffer bound to every source the sound gets
+			bool m_decodedBufferAttached; //< Compressed buffers are only decoded while playing
+			bool m_looping;
 	};
 }
 
@@ -19,12 +19,15 @@
 #include <Nazara/Core/ResourceParameters.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <functional>
 
 namespace Nz
 {
 	struct SoundBufferParams : ResourceParameters
 	{
 		bool forceMono = false;
+		bool keepCompressed = false; //< Keeps the encoded file in memory and decodes it when a sound starts playing
+		UInt32 sampleRate = 0; //< Resamples the sound at this rate when loading it, 0 keeps the rate of the file
 
 		bool IsValid() const;
 	};
@@ -49,6 +52,8 @@ namespace Nz
 		friend class Audio;
 
 		public:
+			using Decoder = std::function<bool(const void* data, std::size_t size, Int16* samples, unsigned int sampleCount)>;
+
 			SoundBuffer() = default;
 			SoundBuffer(AudioFormat format, unsigned int sampleCount, unsigned int sampleRate, const Int16* samples);
 			SoundBuffer(const SoundBuffer&) = delete;
@@ -56,23 +61,31 @@ namespace Nz
 			~SoundBuffer();
 
 			bool Create(AudioFormat format, unsigned int sampleCount, unsigned int sampleRate, const Int16* samples);
+			bool CreateCompressed(AudioFormat format, unsigned int sampleCount, unsigned int sampleRate, const void* data, std::size_t size, Decoder decoder);
 			void Destroy();
 
 			UInt32 GetDuration() const;
 			AudioFormat GetFormat() const;
+			std::size_t GetMemoryUsage() const;
 			const Int16* GetSamples() const;
 			UInt32 GetSampleCount() const;
 			UInt32 GetSampleRate() const;
 
+			bool IsCompressed() const;
+			bool IsDecoded() const;
 			bool IsValid() const;
 
 			bool LoadFromFile(const String& filePath, const SoundBufferParams& params = SoundBufferParams());
 			bool LoadFromMemory(const void* data, std::size_t size, const SoundBufferParams& params = SoundBufferParams());
 			bool LoadFromStream(Stream& stream, const SoundBufferParams& params = SoundBufferParams());
 
+			static std::size_t GetDecodedCacheSize();
+			static std::size_t GetDecodedMemoryUsage();
 			static bool IsFormatSupported(AudioFormat format);
 			template<typename... Args> static SoundBufferRef New(Args&&... args);
 
+			static void SetDecodedCacheSize(std::size_t size);
+
 			SoundBuffer& operator=(const SoundBuffer&) = delete;
 			SoundBuffer& operator=(SoundBuffer&&) = delete; ///TODO
 
@@ -81,7 +94,11 @@ namespace Nz
 			NazaraSignal(OnSoundBufferRelease, const SoundBuffer* /*soundBuffer*/);
 
 		private:
+			unsigned int AcquireOpenALBuffer() const;
 			unsigned int GetOpenALBuffer() const;
+			void ReleaseOpenALBuffer() const;
+
+			static void EvictDecodedBuffers(std::size_t requiredSize);
 
 			static bool Initialize();
 			static void Uninitialize();
@@ -90,6 +107,8 @@ namespace Nz
 
 			static SoundBufferLibrary::LibraryMap s_library;
 			static SoundBufferLoader::LoaderList s_loaders;
+			static SoundBufferManager::ManagerCache s_managerCache;
+			static SoundBufferManager::ManagerLoads s_managerLoads;
 			static SoundBufferManager::ManagerMap s_managerMap;
 			static SoundBufferManager::ManagerParams s_managerParameters;
 	};
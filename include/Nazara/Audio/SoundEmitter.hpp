@@ -11,6 +11,7 @@
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <vector>
 
 ///TODO: Inherit SoundEmitter from Node
 
@@ -18,6 +19,8 @@ namespace Nz
 {
 	class NAZARA_AUDIO_API SoundEmitter
 	{
+		friend class Audio;
+
 		public:
 			virtual ~SoundEmitter();
 
@@ -55,13 +58,48 @@ namespace Nz
 			SoundEmitter& operator=(SoundEmitter&&) = delete; ///TODO
 
 		protected:
-			SoundEmitter();
+			SoundEmitter(bool ownSource = true);
 			SoundEmitter(const SoundEmitter& emitter);
 			SoundEmitter(SoundEmitter&&) = delete; ///TODO
 
+			void AttachSource(unsigned int source);
+			unsigned int DetachSource();
+
+			void FlushParameters();
+
 			SoundStatus GetInternalStatus() const;
 
-			unsigned int m_source;
+			unsigned int m_source; //< 0 while a pooled emitter has no source
+			Vector3f m_position;
+			Vector3f m_velocity;
+			float m_attenuation;
+			float m_minDistance;
+			float m_pitch;
+			float m_volume;
+			bool m_ownsSource;
+			bool m_spatialized;
+
+		private:
+			enum Parameter : UInt8
+			{
+				Parameter_Attenuation    = 0x01,
+				Parameter_MinDistance    = 0x02,
+				Parameter_Pitch          = 0x04,
+				Parameter_Position       = 0x08,
+				Parameter_Spatialization = 0x10,
+				Parameter_Velocity       = 0x20,
+				Parameter_Volume         = 0x40
+			};
+
+			void InvalidateParameter(Parameter parameter);
+			void ValidateParameters();
+
+			static void FlushAllParameters();
+
+			std::size_t m_dirtyIndex; //< Index in s_dirtyEmitters, valid while m_dirtyParameters is not zero
+			UInt8 m_dirtyParameters;
+
+			static std::vector<SoundEmitter*> s_dirtyEmitters;
 	};
 }
 #endif // NAZARA_SOUNDEMITTER_HPP
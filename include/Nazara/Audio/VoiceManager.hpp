@@ -0,0 +1,45 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VOICEMANAGER_HPP
+#define NAZARA_VOICEMANAGER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Audio/Config.hpp>
+
+namespace Nz
+{
+	class Sound;
+
+	class NAZARA_AUDIO_API VoiceManager
+	{
+		friend Sound;
+		friend class Audio;
+
+		public:
+			VoiceManager() = delete;
+			~VoiceManager() = delete;
+
+			static std::size_t GetRealVoiceCount();
+			static std::size_t GetSourceCount();
+			static std::size_t GetVoiceCount();
+
+			static void Update();
+
+		private:
+			static bool AttachVoice(Sound* sound);
+			static void DetachVoice(Sound* sound);
+
+			static bool Initialize(unsigned int maxSourceCount);
+
+			static void Register(Sound* sound);
+			static void Unregister(Sound* sound);
+
+			static void Uninitialize();
+	};
+}
+
+#endif // NAZARA_VOICEMANAGER_HPP
@@ -28,6 +28,15 @@ namespace Nz
 	template<typename T> void HashCombine(std::size_t& seed, const T& v);
 	template<typename T> T ReverseBits(T integer);
 
+	template<typename T>
+	struct BulkSerializable
+	{
+		// Arithmetic scalar stored in T, void if T must be serialized field by field
+		using ComponentType = std::conditional_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, T, void>;
+
+		static constexpr bool value = !std::is_void<ComponentType>::value;
+	};
+
 	template<typename T>
 	struct PointedType
 	{
@@ -42,10 +51,16 @@ namespace Nz
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Serialize(SerializationContext& context, T value);
 
+	template<typename T>
+	bool SerializeArray(SerializationContext& context, const T* values, std::size_t count);
+
 	inline bool Unserialize(SerializationContext& context, bool* value);
 
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Unserialize(SerializationContext& context, T* value);
+
+	template<typename T>
+	bool UnserializeArray(SerializationContext& context, T* values, std::size_t count);
 }
 
 #include <Nazara/Core/Algorithm.inl>
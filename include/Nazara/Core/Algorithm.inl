@@ -8,8 +8,11 @@
 
 #include <Nazara/Core/AbstractHash.hpp>
 #include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Endianness.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <algorithm>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -30,6 +33,82 @@ namespace Nz
 		}
 
 		NAZARA_CORE_API extern const UInt8 BitReverseTable256[256];
+
+		template<typename T>
+		bool SerializeArray(SerializationContext& context, const T* values, std::size_t count, std::true_type)
+		{
+			using ComponentType = typename BulkSerializable<T>::ComponentType;
+			static_assert(std::is_trivially_copyable<T>::value, "Bulk serializable types must be trivially copyable");
+			static_assert(sizeof(T) % sizeof(ComponentType) == 0, "Bulk serializable types must not have padding");
+
+			context.FlushBits();
+
+			std::size_t byteCount = count * sizeof(T);
+			if (context.endianness == Endianness_Unknown || context.endianness == GetPlatformEndianness())
+				return context.stream->Write(values, byteCount) == byteCount;
+
+			// Swap through a stack buffer, components are independent so chunks don't have to match T boundaries
+			alignas(UInt64) UInt8 buffer[4096];
+
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(values);
+			while (byteCount > 0)
+			{
+				std::size_t chunkSize = std::min(byteCount, sizeof(buffer));
+				std::memcpy(buffer, ptr, chunkSize);
+				SwapBytes(buffer, sizeof(ComponentType), chunkSize / sizeof(ComponentType));
+
+				if (context.stream->Write(buffer, chunkSize) != chunkSize)
+					return false;
+
+				byteCount -= chunkSize;
+				ptr += chunkSize;
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		bool SerializeArray(SerializationContext& context, const T* values, std::size_t count, std::false_type)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (!Serialize(context, values[i]))
+					return false;
+			}
+
+			return true;
+		}
+
+		template<typename T>
+		bool UnserializeArray(SerializationContext& context, T* values, std::size_t count, std::true_type)
+		{
+			using ComponentType = typename BulkSerializable<T>::ComponentType;
+			static_assert(std::is_trivially_copyable<T>::value, "Bulk serializable types must be trivially copyable");
+			static_assert(sizeof(T) % sizeof(ComponentType) == 0, "Bulk serializable types must not have padding");
+
+			context.ResetBitPosition();
+
+			std::size_t byteCount = count * sizeof(T);
+			if (context.stream->Read(values, byteCount) != byteCount)
+				return false;
+
+			if (context.endianness != Endianness_Unknown && context.endianness != GetPlatformEndianness())
+				SwapBytes(values, sizeof(ComponentType), byteCount / sizeof(ComponentType));
+
+			return true;
+		}
+
+		template<typename T>
+		bool UnserializeArray(SerializationContext& context, T* values, std::size_t count, std::false_type)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (!Unserialize(context, &values[i]))
+					return false;
+			}
+
+			return true;
+		}
 	}
 
 	/*!
@@ -237,6 +316,28 @@ namespace Nz
 		return context.stream->Write(&value, sizeof(T)) == sizeof(T);
 	}
 
+	/*!
+	* \ingroup core
+	* \brief Serializes a contiguous array
+	* \return true if serialization succedeed
+	*
+	* \param context Context for the serialization
+	* \param values Array to serialize
+	* \param count Number of elements
+	*
+	* Arrays of BulkSerializable types are written in one block (swapping their components if the endianness differs),
+	* other types are serialized element by element. Both produce the same bytes.
+	*
+	* \see Serialize, UnserializeArray
+	*/
+	template<typename T>
+	bool SerializeArray(SerializationContext& context, const T* values, std::size_t count)
+	{
+		NazaraAssert(values || count == 0, "Invalid data pointer");
+
+		return Detail::SerializeArray(context, values, count, std::integral_constant<bool, BulkSerializable<T>::value>());
+	}
+
 	/*!
 	* \ingroup core
 	* \brief Unserializes a boolean
@@ -294,6 +395,25 @@ namespace Nz
 		else
 			return false;
 	}
+
+	/*!
+	* \ingroup core
+	* \brief Unserializes a contiguous array
+	* \return true if unserialization succedeed
+	*
+	* \param context Context for the unserialization
+	* \param values Preallocated array to fill
+	* \param count Number of elements
+	*
+	* \see Unserialize, SerializeArray
+	*/
+	template<typename T>
+	bool UnserializeArray(SerializationContext& context, T* values, std::size_t count)
+	{
+		NazaraAssert(values || count == 0, "Invalid data pointer");
+
+		return Detail::UnserializeArray(context, values, count, std::integral_constant<bool, BulkSerializable<T>::value>());
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,74 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASYNCLOGGER_HPP
+#define NAZARA_ASYNCLOGGER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API AsyncLogger : public AbstractLogger
+	{
+		public:
+			AsyncLogger(AbstractLogger* logger, LogOverflowPolicy overflowPolicy = LogOverflowPolicy_Drop, std::size_t queueCapacity = 1024);
+			AsyncLogger(const AsyncLogger&) = delete;
+			AsyncLogger(AsyncLogger&&) = delete;
+			~AsyncLogger();
+
+			void EnableStdReplication(bool enable) override;
+
+			void Flush();
+
+			UInt64 GetDroppedCount() const;
+			AbstractLogger* GetLogger() const;
+			LogOverflowPolicy GetOverflowPolicy() const;
+
+			bool IsStdReplicationEnabled() override;
+
+			void SetOverflowPolicy(LogOverflowPolicy overflowPolicy);
+
+			void Write(const String& string) override;
+			void WriteError(ErrorType type, const String& error, unsigned int line = 0, const char* file = nullptr, const char* function = nullptr) override;
+
+			AsyncLogger& operator=(const AsyncLogger&) = delete;
+			AsyncLogger& operator=(AsyncLogger&&) = delete;
+
+		private:
+			struct Entry;
+			struct ProducerQueue;
+
+			ProducerQueue* GetProducerQueue();
+			bool ProcessEntries();
+			void Push(ErrorType type, const String& message, unsigned int line, const char* file, const char* function, bool isError);
+			void ThreadProc();
+			void WakeConsumer();
+
+			std::atomic<LogOverflowPolicy> m_overflowPolicy;
+			std::atomic<UInt64> m_droppedCount;
+			std::atomic_bool m_consumerSleeping;
+			std::atomic_bool m_shouldStop;
+			std::size_t m_queueCapacity;
+			std::unique_ptr<AbstractLogger> m_logger;
+			std::vector<std::unique_ptr<ProducerQueue>> m_queues;
+			ConditionVariable m_wakeUp;
+			SharedMutex m_queueMutex;
+			Mutex m_wakeUpMutex;
+			UInt64 m_id;
+			Thread m_thread;
+	};
+}
+
+#endif // NAZARA_ASYNCLOGGER_HPP
@@ -9,6 +9,8 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/String.hpp>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -17,6 +19,8 @@ namespace Nz
 {
 	class AbstractHash;
 
+	template<typename Node> class BitsetExpression;
+
 	template<typename Block = UInt32, class Allocator = std::allocator<Block>>
 	class Bitset
 	{
@@ -24,6 +28,7 @@ namespace Nz
 
 		public:
 			class Bit;
+			using BlockType = Block;
 
 			Bitset();
 			explicit Bitset(std::size_t bitCount, bool val);
@@ -32,6 +37,7 @@ namespace Nz
 			Bitset(const Bitset& bitset) = default;
 			explicit Bitset(const String& bits);
 			template<typename T> Bitset(T value);
+			template<typename Node> explicit Bitset(const BitsetExpression<Node>& expression);
 			Bitset(Bitset&& bitset) noexcept = default;
 			~Bitset() noexcept = default;
 
@@ -86,6 +92,7 @@ namespace Nz
 			Bitset& operator=(const Bitset& bitset) = default;
 			Bitset& operator=(const String& bits);
 			template<typename T> Bitset& operator=(T value);
+			template<typename Node> Bitset& operator=(const BitsetExpression<Node>& expression);
 			Bitset& operator=(Bitset&& bitset) noexcept = default;
 
 			Bitset& operator&=(const Bitset& bitset);
@@ -145,6 +152,126 @@ namespace Nz
 			Block m_mask;
 	};
 
+	namespace Detail
+	{
+		template<typename Block, class Allocator>
+		class BitsetLeafNode
+		{
+			public:
+				using BlockType = Block;
+
+				BitsetLeafNode(const Bitset<Block, Allocator>& bitset);
+
+				Block GetBlock(std::size_t i) const;
+				std::size_t GetSize() const;
+
+			private:
+				const Bitset<Block, Allocator>* m_bitset;
+		};
+
+		template<typename Operation, typename Lhs, typename Rhs>
+		class BitsetBinaryNode
+		{
+			public:
+				using BlockType = typename Lhs::BlockType;
+
+				BitsetBinaryNode(const Lhs& lhs, const Rhs& rhs);
+
+				BlockType GetBlock(std::size_t i) const;
+				std::size_t GetSize() const;
+
+			private:
+				Lhs m_lhs;
+				Rhs m_rhs;
+		};
+
+		template<typename Operand>
+		class BitsetNotNode
+		{
+			public:
+				using BlockType = typename Operand::BlockType;
+
+				BitsetNotNode(const Operand& operand);
+
+				BlockType GetBlock(std::size_t i) const;
+				std::size_t GetSize() const;
+
+			private:
+				Operand m_operand;
+		};
+	}
+
+	template<typename Node>
+	class BitsetExpression
+	{
+		public:
+			using BlockType = typename Node::BlockType;
+			class Iterator;
+
+			explicit BitsetExpression(const Node& node);
+			BitsetExpression(const BitsetExpression&) = default;
+			~BitsetExpression() = default;
+
+			std::size_t Count() const;
+
+			std::size_t FindFirst() const;
+			std::size_t FindNext(std::size_t bit) const;
+
+			BlockType GetBlock(std::size_t i) const;
+			std::size_t GetBlockCount() const;
+			const Node& GetNode() const;
+			std::size_t GetSize() const;
+
+			bool TestAny() const;
+			bool TestNone() const;
+
+			Iterator begin() const;
+			Iterator end() const;
+
+			BitsetExpression& operator=(const BitsetExpression&) = delete;
+
+			static constexpr std::size_t bitsPerBlock = std::numeric_limits<BlockType>::digits;
+			static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+		private:
+			std::size_t FindFirstFrom(std::size_t blockIndex) const;
+
+			Node m_node;
+	};
+
+	template<typename Node>
+	class BitsetExpression<Node>::Iterator
+	{
+		friend BitsetExpression;
+
+		public:
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+			using pointer = const std::size_t*;
+			using reference = std::size_t;
+			using value_type = std::size_t;
+
+			Iterator(const Iterator& iterator) = default;
+
+			std::size_t operator*() const;
+			Iterator& operator++();
+			Iterator operator++(int);
+
+			bool operator==(const Iterator& iterator) const;
+			bool operator!=(const Iterator& iterator) const;
+
+			Iterator& operator=(const Iterator& iterator) = default;
+
+		private:
+			Iterator(const BitsetExpression* expression, std::size_t bit);
+
+			const BitsetExpression* m_expression;
+			std::size_t m_bit;
+	};
+
+	template<typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetLeafNode<Block, Allocator>> MakeBitsetExpression(const Bitset<Block, Allocator>& bitset);
+
 	template<typename Block, class Allocator>
 	bool operator==(const Bitset<Block, Allocator>& lhs, const Nz::Bitset<Block, Allocator>& rhs);
 
@@ -171,6 +298,36 @@ namespace Nz
 
 	template<typename Block, class Allocator>
 	Bitset<Block, Allocator> operator^(const Bitset<Block, Allocator>& lhs, const Bitset<Block, Allocator>& rhs);
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Lhs, Rhs>> operator&(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator&(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs);
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator&(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Lhs, Rhs>> operator|(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator|(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs);
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator|(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Lhs, Rhs>> operator^(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator^(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs);
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator^(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs);
+
+	template<typename Operand>
+	BitsetExpression<Detail::BitsetNotNode<Operand>> operator~(const BitsetExpression<Operand>& operand);
 }
 
 namespace std
@@ -4,6 +4,7 @@
 
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
 #include <limits>
 #include <utility>
 #include <Nazara/Core/Debug.hpp>
@@ -108,6 +109,20 @@ namespace Nz
 	{
 	}
 
+	/*!
+	* \brief Constructs a Bitset object by evaluating a bitset expression
+	*
+	* \param expression Expression to evaluate
+	*/
+
+	template<typename Block, class Allocator>
+	template<typename Node>
+	Bitset<Block, Allocator>::Bitset(const BitsetExpression<Node>& expression) :
+	Bitset()
+	{
+		operator=(expression);
+	}
+
 	/*!
 	* \brief Constructs a Bitset copying an unsigned integral number
 	*
@@ -280,21 +295,29 @@ namespace Nz
 	* \param b Second bitset
 	*
 	* \remark The "AND" is performed with all the bits of the smallest bitset and the capacity of this is set to the largest of the two bitsets
+	* \remark a and b may be this bitset
 	*/
 
 	template<typename Block, class Allocator>
 	void Bitset<Block, Allocator>::PerformsAND(const Bitset& a, const Bitset& b)
 	{
 		std::pair<std::size_t, std::size_t> minmax = std::minmax(a.GetBlockCount(), b.GetBlockCount());
+		std::size_t bitCount = std::max(a.GetSize(), b.GetSize());
 
-		// We reinitialise our blocks with zero
-		m_blocks.clear();
-		m_blocks.resize(minmax.second, 0U);
-		m_bitCount = std::max(a.GetSize(), b.GetSize());
+		// Growing keeps the existing blocks, in case a or b is this bitset
+		m_blocks.resize(minmax.second);
+		m_bitCount = bitCount;
+
+		// Plain loops over the blocks, which compilers turn into SIMD code
+		Block* blocks = m_blocks.data();
+		const Block* aBlocks = a.m_blocks.data();
+		const Block* bBlocks = b.m_blocks.data();
 
 		// In case of the "AND", we can stop with the smallest size (because x & 0 = 0)
 		for (std::size_t i = 0; i < minmax.first; ++i)
-			m_blocks[i] = a.GetBlock(i) & b.GetBlock(i);
+			blocks[i] = aBlocks[i] & bBlocks[i];
+
+		std::fill(blocks + minmax.first, blocks + minmax.second, Block(0U));
 
 		ResetExtraBits();
 	}
@@ -311,8 +334,11 @@ namespace Nz
 		m_blocks.resize(a.GetBlockCount());
 		m_bitCount = a.GetSize();
 
+		Block* blocks = m_blocks.data();
+		const Block* aBlocks = a.m_blocks.data();
+
 		for (std::size_t i = 0; i < m_blocks.size(); ++i)
-			m_blocks[i] = ~a.GetBlock(i);
+			blocks[i] = ~aBlocks[i];
 
 		ResetExtraBits();
 	}
@@ -334,14 +360,21 @@ namespace Nz
 
 		std::size_t maxBlockCount = greater.GetBlockCount();
 		std::size_t minBlockCount = lesser.GetBlockCount();
+		std::size_t bitCount = greater.GetSize();
+
+		// Growing keeps the existing blocks, in case a or b is this bitset
 		m_blocks.resize(maxBlockCount);
-		m_bitCount = greater.GetSize();
+		m_bitCount = bitCount;
+
+		Block* blocks = m_blocks.data();
+		const Block* greaterBlocks = greater.m_blocks.data();
+		const Block* lesserBlocks = lesser.m_blocks.data();
 
 		for (std::size_t i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) | b.GetBlock(i);
+			blocks[i] = greaterBlocks[i] | lesserBlocks[i];
 
-		for (std::size_t i = minBlockCount; i < maxBlockCount; ++i)
-			m_blocks[i] = greater.GetBlock(i); // (x | 0 = x)
+		if (blocks != greaterBlocks)
+			std::copy(greaterBlocks + minBlockCount, greaterBlocks + maxBlockCount, blocks + minBlockCount); // (x | 0 = x)
 
 		ResetExtraBits();
 	}
@@ -363,14 +396,21 @@ namespace Nz
 
 		std::size_t maxBlockCount = greater.GetBlockCount();
 		std::size_t minBlockCount = lesser.GetBlockCount();
+		std::size_t bitCount = greater.GetSize();
+
+		// Growing keeps the existing blocks, in case a or b is this bitset
 		m_blocks.resize(maxBlockCount);
-		m_bitCount = greater.GetSize();
+		m_bitCount = bitCount;
+
+		Block* blocks = m_blocks.data();
+		const Block* greaterBlocks = greater.m_blocks.data();
+		const Block* lesserBlocks = lesser.m_blocks.data();
 
 		for (std::size_t i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) ^ b.GetBlock(i);
+			blocks[i] = greaterBlocks[i] ^ lesserBlocks[i];
 
-		for (std::size_t i = minBlockCount; i < maxBlockCount; ++i)
-			m_blocks[i] = greater.GetBlock(i); // (x ^ 0 = x)
+		if (blocks != greaterBlocks)
+			std::copy(greaterBlocks + minBlockCount, greaterBlocks + maxBlockCount, blocks + minBlockCount); // (x ^ 0 = x)
 
 		ResetExtraBits();
 	}
@@ -386,11 +426,12 @@ namespace Nz
 	{
 		// We only test the blocks in common
 		std::size_t sharedBlocks = std::min(GetBlockCount(), bitset.GetBlockCount());
+
+		const Block* aBlocks = m_blocks.data();
+		const Block* bBlocks = bitset.m_blocks.data();
 		for (std::size_t i = 0; i < sharedBlocks; ++i)
 		{
-			Block a = GetBlock(i);
-			Block b = bitset.GetBlock(i);
-			if (a & b)
+			if (aBlocks[i] & bBlocks[i])
 				return true;
 		}
 
@@ -747,6 +788,32 @@ namespace Nz
 		return *this;
 	}
 
+	/*!
+	* \brief Evaluates a bitset expression into this bitset
+	* \return A reference to this
+	*
+	* \param expression Expression to evaluate, it may reference this bitset
+	*/
+
+	template<typename Block, class Allocator>
+	template<typename Node>
+	Bitset<Block, Allocator>& Bitset<Block, Allocator>::operator=(const BitsetExpression<Node>& expression)
+	{
+		std::size_t bitCount = expression.GetSize();
+
+		// Every block only depends on the blocks of the operands at the same index, so this can be done in place
+		// (the expression is never smaller than its operands, resizing does not lose any of them)
+		std::size_t blockCount = ComputeBlockCount(bitCount);
+		m_blocks.resize(blockCount);
+
+		for (std::size_t i = 0; i < blockCount; ++i)
+			m_blocks[i] = expression.GetBlock(i);
+
+		m_bitCount = bitCount;
+
+		return *this;
+	}
+
 	/*!
 	* \brief Copies the internal representation of an unsigned integer
 	* \return A reference to this
@@ -1088,6 +1155,344 @@ namespace Nz
 		return *this;
 	}
 
+	namespace Detail
+	{
+		template<typename Block, class Allocator>
+		BitsetLeafNode<Block, Allocator>::BitsetLeafNode(const Bitset<Block, Allocator>& bitset) :
+		m_bitset(&bitset)
+		{
+		}
+
+		template<typename Block, class Allocator>
+		Block BitsetLeafNode<Block, Allocator>::GetBlock(std::size_t i) const
+		{
+			// A bitset behaves as if it was followed by an infinity of '0'
+			return (i < m_bitset->GetBlockCount()) ? m_bitset->GetBlock(i) : Block(0U);
+		}
+
+		template<typename Block, class Allocator>
+		std::size_t BitsetLeafNode<Block, Allocator>::GetSize() const
+		{
+			return m_bitset->GetSize();
+		}
+
+		template<typename Operation, typename Lhs, typename Rhs>
+		BitsetBinaryNode<Operation, Lhs, Rhs>::BitsetBinaryNode(const Lhs& lhs, const Rhs& rhs) :
+		m_lhs(lhs),
+		m_rhs(rhs)
+		{
+			static_assert(std::is_same<typename Lhs::BlockType, typename Rhs::BlockType>::value, "Bitsets must use the same block type");
+		}
+
+		template<typename Operation, typename Lhs, typename Rhs>
+		auto BitsetBinaryNode<Operation, Lhs, Rhs>::GetBlock(std::size_t i) const -> BlockType
+		{
+			return static_cast<BlockType>(Operation()(m_lhs.GetBlock(i), m_rhs.GetBlock(i)));
+		}
+
+		template<typename Operation, typename Lhs, typename Rhs>
+		std::size_t BitsetBinaryNode<Operation, Lhs, Rhs>::GetSize() const
+		{
+			return std::max(m_lhs.GetSize(), m_rhs.GetSize());
+		}
+
+		template<typename Operand>
+		BitsetNotNode<Operand>::BitsetNotNode(const Operand& operand) :
+		m_operand(operand)
+		{
+		}
+
+		template<typename Operand>
+		auto BitsetNotNode<Operand>::GetBlock(std::size_t i) const -> BlockType
+		{
+			return static_cast<BlockType>(~m_operand.GetBlock(i));
+		}
+
+		template<typename Operand>
+		std::size_t BitsetNotNode<Operand>::GetSize() const
+		{
+			return m_operand.GetSize();
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::BitsetExpression
+	* \brief Core class that represents a lazily evaluated combination of bitsets
+	*
+	* Expressions are built with MakeBitsetExpression and the &, |, ^ and ~ operators, e.g. MakeBitsetExpression(a) & b & ~MakeBitsetExpression(c).
+	* They are evaluated block per block when iterated or tested, without any temporary bitset.
+	*
+	* The size of an expression is the size of its largest operand and smaller operands are considered to be followed by '0',
+	* so ~c is set on every bit past the end of c.
+	*
+	* \remark An expression references its bitsets, they must outlive it
+	*/
+
+	/*!
+	* \brief Constructs a BitsetExpression object from its root node
+	*
+	* \param node Root of the expression
+	*/
+
+	template<typename Node>
+	BitsetExpression<Node>::BitsetExpression(const Node& node) :
+	m_node(node)
+	{
+	}
+
+	/*!
+	* \brief Counts the number of bits set to 1
+	* \return Number of bits set to 1
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::Count() const
+	{
+		std::size_t blockCount = GetBlockCount();
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < blockCount; ++i)
+			count += CountBits(GetBlock(i));
+
+		return count;
+	}
+
+	/*!
+	* \brief Finds the first bit set to one in the expression
+	* \return Index of the first bit or npos
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::FindFirst() const
+	{
+		return FindFirstFrom(0);
+	}
+
+	/*!
+	* \brief Finds the next bit set to one in the expression
+	* \return Index of the next bit if exists or npos
+	*
+	* \param bit Index of the bit, the search begin with bit + 1
+	*
+	* \remark Produce a NazaraAssert if bit is greather than number of bits in the expression
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::FindNext(std::size_t bit) const
+	{
+		NazaraAssert(bit < GetSize(), "Bit index out of range");
+
+		if (++bit >= GetSize())
+			return npos;
+
+		std::size_t blockIndex = bit / bitsPerBlock;
+		std::size_t bitIndex = bit % bitsPerBlock;
+
+		// We ignore the X first bits
+		BlockType block = GetBlock(blockIndex);
+		block >>= bitIndex;
+
+		if (block)
+			return IntegralLog2Pot(block & -block) + bit;
+		else
+			return FindFirstFrom(blockIndex + 1);
+	}
+
+	/*!
+	* \brief Evaluates the ith block
+	* \return Block of the expression, with the bits past the size set to '0'
+	*
+	* \param i Index of the block
+	*
+	* \remark Produce a NazaraAssert if i is greather than number of blocks in the expression
+	*/
+
+	template<typename Node>
+	auto BitsetExpression<Node>::GetBlock(std::size_t i) const -> BlockType
+	{
+		NazaraAssert(i < GetBlockCount(), "Block index out of range");
+
+		BlockType block = m_node.GetBlock(i);
+
+		std::size_t lastBits = GetSize() % bitsPerBlock;
+		if (lastBits != 0 && i == GetBlockCount() - 1)
+			block &= (BlockType(1U) << lastBits) - 1U;
+
+		return block;
+	}
+
+	/*!
+	* \brief Gets the number of blocks
+	* \return Number of blocks
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::GetBlockCount() const
+	{
+		return (GetSize() + bitsPerBlock - 1) / bitsPerBlock;
+	}
+
+	/*!
+	* \brief Gets the root node of the expression
+	* \return Root node
+	*/
+
+	template<typename Node>
+	const Node& BitsetExpression<Node>::GetNode() const
+	{
+		return m_node;
+	}
+
+	/*!
+	* \brief Gets the number of bits
+	* \return Size of the largest bitset of the expression
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::GetSize() const
+	{
+		return m_node.GetSize();
+	}
+
+	/*!
+	* \brief Checks if at least one bit is set
+	* \return true if one bit is set, stopping at the first non-empty block
+	*/
+
+	template<typename Node>
+	bool BitsetExpression<Node>::TestAny() const
+	{
+		return FindFirst() != npos;
+	}
+
+	/*!
+	* \brief Checks if all the bits are cleared
+	* \return true if no bit is set
+	*/
+
+	template<typename Node>
+	bool BitsetExpression<Node>::TestNone() const
+	{
+		return !TestAny();
+	}
+
+	/*!
+	* \brief Returns an iterator to the first set bit, for use with range-based for loops
+	* \return Iterator whose value is the index of the bit
+	*/
+
+	template<typename Node>
+	auto BitsetExpression<Node>::begin() const -> Iterator
+	{
+		return Iterator(this, FindFirst());
+	}
+
+	/*!
+	* \brief Returns an iterator past the last set bit
+	* \return End iterator
+	*/
+
+	template<typename Node>
+	auto BitsetExpression<Node>::end() const -> Iterator
+	{
+		return Iterator(this, npos);
+	}
+
+	/*!
+	* \brief Finds the position of the first bit set to true after the blockIndex
+	* \return The position of the bit or npos
+	*
+	* \param blockIndex Index of the block
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::FindFirstFrom(std::size_t blockIndex) const
+	{
+		std::size_t blockCount = GetBlockCount();
+		for (std::size_t i = blockIndex; i < blockCount; ++i)
+		{
+			BlockType block = GetBlock(i);
+			if (block)
+				return IntegralLog2Pot(block & -block) + i*bitsPerBlock;
+		}
+
+		return npos;
+	}
+
+	template<typename Node>
+	BitsetExpression<Node>::Iterator::Iterator(const BitsetExpression* expression, std::size_t bit) :
+	m_expression(expression),
+	m_bit(bit)
+	{
+	}
+
+	/*!
+	* \brief Gets the index of the current bit
+	* \return Index of the bit
+	*/
+
+	template<typename Node>
+	std::size_t BitsetExpression<Node>::Iterator::operator*() const
+	{
+		return m_bit;
+	}
+
+	/*!
+	* \brief Moves to the next set bit
+	* \return A reference to this
+	*
+	* \remark As with FindNext, the blocks are read again at every step, bits set while iterating are seen if they come after the current one
+	*/
+
+	template<typename Node>
+	auto BitsetExpression<Node>::Iterator::operator++() -> Iterator&
+	{
+		m_bit = m_expression->FindNext(m_bit);
+		return *this;
+	}
+
+	/*!
+	* \brief Moves to the next set bit
+	* \return An iterator to the previous bit
+	*/
+
+	template<typename Node>
+	auto BitsetExpression<Node>::Iterator::operator++(int) -> Iterator
+	{
+		Iterator previous(*this);
+		operator++();
+
+		return previous;
+	}
+
+	template<typename Node>
+	bool BitsetExpression<Node>::Iterator::operator==(const Iterator& iterator) const
+	{
+		return m_bit == iterator.m_bit;
+	}
+
+	template<typename Node>
+	bool BitsetExpression<Node>::Iterator::operator!=(const Iterator& iterator) const
+	{
+		return !operator==(iterator);
+	}
+
+	/*!
+	* \brief Makes an expression out of a bitset
+	* \return Expression referencing the bitset
+	*
+	* \param bitset Bitset to reference
+	*
+	* \see BitsetExpression
+	*/
+
+	template<typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetLeafNode<Block, Allocator>> MakeBitsetExpression(const Bitset<Block, Allocator>& bitset)
+	{
+		return BitsetExpression<Detail::BitsetLeafNode<Block, Allocator>>(Detail::BitsetLeafNode<Block, Allocator>(bitset));
+	}
+
 	/*!
 	* \brief Compares two bitsets
 	* \return true if the two bitsets are the same
@@ -1265,6 +1670,149 @@ namespace Nz
 
 		return bitset;
 	}
+
+	/*!
+	* \brief Combines two bitset expressions with the "AND" operator, without evaluating them
+	* \return Expression of the "AND"
+	*
+	* \param lhs First expression
+	* \param rhs Second expression
+	*/
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Lhs, Rhs>> operator&(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		using NodeType = Detail::BitsetBinaryNode<std::bit_and<>, Lhs, Rhs>;
+		return BitsetExpression<NodeType>(NodeType(lhs.GetNode(), rhs.GetNode()));
+	}
+
+	/*!
+	* \brief Combines a bitset expression and a bitset with the "AND" operator, without evaluating them
+	* \return Expression of the "AND"
+	*
+	* \param lhs Expression
+	* \param rhs Bitset
+	*/
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator&(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs)
+	{
+		return lhs & MakeBitsetExpression(rhs);
+	}
+
+	/*!
+	* \brief Combines a bitset and a bitset expression with the "AND" operator, without evaluating them
+	* \return Expression of the "AND"
+	*
+	* \param lhs Bitset
+	* \param rhs Expression
+	*/
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_and<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator&(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		return MakeBitsetExpression(lhs) & rhs;
+	}
+
+	/*!
+	* \brief Combines two bitset expressions with the "OR" operator, without evaluating them
+	* \return Expression of the "OR"
+	*
+	* \param lhs First expression
+	* \param rhs Second expression
+	*/
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Lhs, Rhs>> operator|(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		using NodeType = Detail::BitsetBinaryNode<std::bit_or<>, Lhs, Rhs>;
+		return BitsetExpression<NodeType>(NodeType(lhs.GetNode(), rhs.GetNode()));
+	}
+
+	/*!
+	* \brief Combines a bitset expression and a bitset with the "OR" operator, without evaluating them
+	* \return Expression of the "OR"
+	*
+	* \param lhs Expression
+	* \param rhs Bitset
+	*/
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator|(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs)
+	{
+		return lhs | MakeBitsetExpression(rhs);
+	}
+
+	/*!
+	* \brief Combines a bitset and a bitset expression with the "OR" operator, without evaluating them
+	* \return Expression of the "OR"
+	*
+	* \param lhs Bitset
+	* \param rhs Expression
+	*/
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_or<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator|(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		return MakeBitsetExpression(lhs) | rhs;
+	}
+
+	/*!
+	* \brief Combines two bitset expressions with the "XOR" operator, without evaluating them
+	* \return Expression of the "XOR"
+	*
+	* \param lhs First expression
+	* \param rhs Second expression
+	*/
+
+	template<typename Lhs, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Lhs, Rhs>> operator^(const BitsetExpression<Lhs>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		using NodeType = Detail::BitsetBinaryNode<std::bit_xor<>, Lhs, Rhs>;
+		return BitsetExpression<NodeType>(NodeType(lhs.GetNode(), rhs.GetNode()));
+	}
+
+	/*!
+	* \brief Combines a bitset expression and a bitset with the "XOR" operator, without evaluating them
+	* \return Expression of the "XOR"
+	*
+	* \param lhs Expression
+	* \param rhs Bitset
+	*/
+
+	template<typename Lhs, typename Block, class Allocator>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Lhs, Detail::BitsetLeafNode<Block, Allocator>>> operator^(const BitsetExpression<Lhs>& lhs, const Bitset<Block, Allocator>& rhs)
+	{
+		return lhs ^ MakeBitsetExpression(rhs);
+	}
+
+	/*!
+	* \brief Combines a bitset and a bitset expression with the "XOR" operator, without evaluating them
+	* \return Expression of the "XOR"
+	*
+	* \param lhs Bitset
+	* \param rhs Expression
+	*/
+
+	template<typename Block, class Allocator, typename Rhs>
+	BitsetExpression<Detail::BitsetBinaryNode<std::bit_xor<>, Detail::BitsetLeafNode<Block, Allocator>, Rhs>> operator^(const Bitset<Block, Allocator>& lhs, const BitsetExpression<Rhs>& rhs)
+	{
+		return MakeBitsetExpression(lhs) ^ rhs;
+	}
+
+	/*!
+	* \brief Negates a bitset expression, without evaluating it
+	* \return Expression of the "NOT"
+	*
+	* \param operand Expression to negate
+	*/
+
+	template<typename Operand>
+	BitsetExpression<Detail::BitsetNotNode<Operand>> operator~(const BitsetExpression<Operand>& operand)
+	{
+		using NodeType = Detail::BitsetNotNode<Operand>;
+		return BitsetExpression<NodeType>(NodeType(operand.GetNode()));
+	}
 }
 
 
@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_BORROWEDREF_HPP
+#define NAZARA_BORROWEDREF_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/ObjectRef.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	class BorrowedRef
+	{
+		public:
+			BorrowedRef();
+			BorrowedRef(T* object);
+			template<typename U> BorrowedRef(const ObjectRef<U>& ref);
+			template<typename U> BorrowedRef(const BorrowedRef<U>& ref);
+			BorrowedRef(const BorrowedRef& ref) = default;
+			~BorrowedRef() = default;
+
+			ObjectRef<T> Acquire() const;
+			T* Get() const;
+			bool IsValid() const;
+			void Reset(T* object = nullptr);
+
+			operator bool() const;
+			operator T*() const;
+			T* operator->() const;
+
+			BorrowedRef& operator=(const BorrowedRef& ref) = default;
+
+		private:
+			T* m_object;
+	};
+
+	template<typename T> bool operator==(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs);
+	template<typename T> bool operator==(const ObjectRef<T>& lhs, const BorrowedRef<T>& rhs);
+	template<typename T> bool operator==(const BorrowedRef<T>& lhs, const ObjectRef<T>& rhs);
+
+	template<typename T> bool operator!=(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs);
+	template<typename T> bool operator!=(const ObjectRef<T>& lhs, const BorrowedRef<T>& rhs);
+	template<typename T> bool operator!=(const BorrowedRef<T>& lhs, const ObjectRef<T>& rhs);
+
+	template<typename T> bool operator<(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs);
+
+	template<typename T> struct PointedType<BorrowedRef<T>> { typedef T type; };
+	template<typename T> struct PointedType<BorrowedRef<T> const> { typedef T type; };
+}
+
+#include <Nazara/Core/BorrowedRef.inl>
+
+#endif // NAZARA_BORROWEDREF_HPP
@@ -0,0 +1,268 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <functional>
+#include <type_traits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::BorrowedRef
+	* \brief Core class that represents a reference to a RefCounted object which does not touch its counter
+	*
+	* A BorrowedRef is meant to be passed to functions and stored in short-lived structures (such as render queues)
+	* while an ObjectRef somewhere else keeps the object alive; copying it is as cheap as copying a pointer.
+	* Acquire gives an ObjectRef out of it, when the object has to be kept.
+	*
+	* \remark The object must outlive the BorrowedRef, nothing checks it
+	*/
+
+	/*!
+	* \brief Constructs a BorrowedRef object by default
+	*/
+
+	template<typename T>
+	BorrowedRef<T>::BorrowedRef() :
+	m_object(nullptr)
+	{
+	}
+
+	/*!
+	* \brief Constructs a BorrowedRef object referencing an object
+	*
+	* \param object Pointer to the object
+	*/
+
+	template<typename T>
+	BorrowedRef<T>::BorrowedRef(T* object) :
+	m_object(object)
+	{
+	}
+
+	/*!
+	* \brief Constructs a BorrowedRef object borrowing the object of an ObjectRef
+	*
+	* \param ref ObjectRef keeping the object alive
+	*/
+
+	template<typename T>
+	template<typename U>
+	BorrowedRef<T>::BorrowedRef(const ObjectRef<U>& ref) :
+	m_object(ref.Get())
+	{
+	}
+
+	/*!
+	* \brief Constructs a BorrowedRef object from another type of BorrowedRef
+	*
+	* \param ref BorrowedRef of type U to convert to type T
+	*/
+
+	template<typename T>
+	template<typename U>
+	BorrowedRef<T>::BorrowedRef(const BorrowedRef<U>& ref) :
+	m_object(ref.Get())
+	{
+	}
+
+	/*!
+	* \brief Gets an owning reference to the object
+	* \return ObjectRef adding a reference to the object
+	*/
+
+	template<typename T>
+	ObjectRef<T> BorrowedRef<T>::Acquire() const
+	{
+		return ObjectRef<T>(m_object);
+	}
+
+	/*!
+	* \brief Gets the underlying pointer
+	* \return Underlying pointer
+	*/
+
+	template<typename T>
+	T* BorrowedRef<T>::Get() const
+	{
+		return m_object;
+	}
+
+	/*!
+	* \brief Checks whether the reference is valid
+	* \return true if reference is not nullptr
+	*/
+
+	template<typename T>
+	bool BorrowedRef<T>::IsValid() const
+	{
+		return m_object != nullptr;
+	}
+
+	/*!
+	* \brief Resets the content of the BorrowedRef with another pointer
+	*
+	* \param object Pointer to the new object, which may be nullptr
+	*/
+
+	template<typename T>
+	void BorrowedRef<T>::Reset(T* object)
+	{
+		m_object = object;
+	}
+
+	/*!
+	* \brief Converts the BorrowedRef to bool
+	* \return true if reference is not nullptr
+	*/
+
+	template<typename T>
+	BorrowedRef<T>::operator bool() const
+	{
+		return IsValid();
+	}
+
+	/*!
+	* \brief Dereferences the BorrowedRef
+	* \return Underlying pointer
+	*/
+
+	template<typename T>
+	BorrowedRef<T>::operator T*() const
+	{
+		return m_object;
+	}
+
+	/*!
+	* \brief Dereferences the BorrowedRef
+	* \return Underlying pointer
+	*/
+
+	template<typename T>
+	T* BorrowedRef<T>::operator->() const
+	{
+		return m_object;
+	}
+
+	/*!
+	* \brief Checks whether both references point to the same object
+	* \return true if they do
+	*
+	* \param lhs First reference
+	* \param rhs Second reference
+	*/
+
+	template<typename T>
+	bool operator==(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs)
+	{
+		return lhs.Get() == rhs.Get();
+	}
+
+	/*!
+	* \brief Checks whether both references point to the same object
+	* \return true if they do
+	*
+	* \param lhs ObjectRef to compare
+	* \param rhs BorrowedRef to compare
+	*/
+
+	template<typename T>
+	bool operator==(const ObjectRef<T>& lhs, const BorrowedRef<T>& rhs)
+	{
+		return lhs.Get() == rhs.Get();
+	}
+
+	/*!
+	* \brief Checks whether both references point to the same object
+	* \return true if they do
+	*
+	* \param lhs BorrowedRef to compare
+	* \param rhs ObjectRef to compare
+	*/
+
+	template<typename T>
+	bool operator==(const BorrowedRef<T>& lhs, const ObjectRef<T>& rhs)
+	{
+		return lhs.Get() == rhs.Get();
+	}
+
+	/*!
+	* \brief Checks whether both references point to different objects
+	* \return true if they do
+	*
+	* \param lhs First reference
+	* \param rhs Second reference
+	*/
+
+	template<typename T>
+	bool operator!=(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/*!
+	* \brief Checks whether both references point to different objects
+	* \return true if they do
+	*
+	* \param lhs ObjectRef to compare
+	* \param rhs BorrowedRef to compare
+	*/
+
+	template<typename T>
+	bool operator!=(const ObjectRef<T>& lhs, const BorrowedRef<T>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/*!
+	* \brief Checks whether both references point to different objects
+	* \return true if they do
+	*
+	* \param lhs BorrowedRef to compare
+	* \param rhs ObjectRef to compare
+	*/
+
+	template<typename T>
+	bool operator!=(const BorrowedRef<T>& lhs, const ObjectRef<T>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/*!
+	* \brief Compares the addresses of the referenced objects
+	* \return true if the first address is lower than the second one
+	*
+	* \param lhs First reference
+	* \param rhs Second reference
+	*/
+
+	template<typename T>
+	bool operator<(const BorrowedRef<T>& lhs, const BorrowedRef<T>& rhs)
+	{
+		return std::less<T*>()(lhs.Get(), rhs.Get());
+	}
+}
+
+namespace std
+{
+	/*!
+	* \brief Specialisation of std to hash
+	* \return Result of the hash, the same as the ObjectRef of the same object
+	*
+	* \param object BorrowedRef to hash
+	*/
+
+	template<typename T>
+	struct hash<Nz::BorrowedRef<T>>
+	{
+		size_t operator()(const Nz::BorrowedRef<T>& object) const
+		{
+			hash<T*> h;
+			return h(object.Get());
+		}
+	};
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -33,6 +33,7 @@ namespace Nz
 			inline bool FlushBits();
 
 			inline std::size_t Read(void* ptr, std::size_t size);
+			template<typename T> bool ReadArray(T* values, std::size_t count);
 
 			inline void SetDataEndianness(Endianness endiannes);
 			inline void SetStream(Stream* stream);
@@ -41,6 +42,7 @@ namespace Nz
 			void SetStream(const void* ptr, Nz::UInt64 size);
 
 			inline void Write(const void* data, std::size_t size);
+			template<typename T> bool WriteArray(const T* values, std::size_t count);
 
 			template<typename T>
 			ByteStream& operator>>(T& value);
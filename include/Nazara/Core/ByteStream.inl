@@ -114,6 +114,33 @@ namespace Nz
 		return m_context.stream->Read(ptr, size);
 	}
 
+	/*!
+	* \brief Reads a contiguous array of values
+	* \return true if every value was read
+	*
+	* \param values Preallocated array to fill
+	* \param count Number of values to read
+	*
+	* \remark Produces a NazaraError if unserialization failed
+	*
+	* \see UnserializeArray
+	*/
+
+	template<typename T>
+	bool ByteStream::ReadArray(T* values, std::size_t count)
+	{
+		if (!m_context.stream)
+			OnEmptyStream();
+
+		if (!UnserializeArray(m_context, values, count))
+		{
+			NazaraError("Failed to unserialize array");
+			return false;
+		}
+
+		return true;
+	}
+
 	/*!
 	* \brief Sets the stream endianness
 	*
@@ -163,6 +190,33 @@ namespace Nz
 		m_context.stream->Write(data, size);
 	}
 
+	/*!
+	* \brief Writes a contiguous array of values
+	* \return true if every value was written
+	*
+	* \param values Array to write
+	* \param count Number of values to write
+	*
+	* \remark Produces a NazaraError if serialization failed
+	*
+	* \see SerializeArray
+	*/
+
+	template<typename T>
+	bool ByteStream::WriteArray(const T* values, std::size_t count)
+	{
+		if (!m_context.stream)
+			OnEmptyStream();
+
+		if (!SerializeArray(m_context, values, count))
+		{
+			NazaraError("Failed to serialize array");
+			return false;
+		}
+
+		return true;
+	}
+
 	/*!
 	* \brief Outputs a data from the stream
 	* \return A reference to this
@@ -8,6 +8,7 @@
 #define NAZARA_CLOCK_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 
 #if NAZARA_CORE_THREADSAFE && NAZARA_THREADSAFETY_CLOCK
 #include <Nazara/Core/ThreadSafety.hpp>
@@ -20,7 +21,7 @@ namespace Nz
 	class NAZARA_CORE_API Clock
 	{
 		public:
-			Clock(UInt64 startingValue = 0, bool paused = false);
+			Clock(UInt64 startingValue = 0, bool paused = false, ClockMode mode = ClockMode_System);
 			Clock(const Clock& clock) = default;
 			Clock(Clock&& clock) = default;
 			~Clock() = default;
@@ -28,6 +29,7 @@ namespace Nz
 			float GetSeconds() const;
 			UInt64 GetMicroseconds() const;
 			UInt64 GetMilliseconds() const;
+			ClockMode GetMode() const;
 
 			bool IsPaused() const;
 
@@ -39,10 +41,14 @@ namespace Nz
 			Clock& operator=(Clock&& clock) = default;
 
 		private:
+			UInt64 GetReferenceTime() const;
+			UInt64 GetTimeSinceReference() const;
+
 			NazaraMutexAttrib(m_mutex, mutable)
 
+			ClockMode m_mode;
 			UInt64 m_elapsedTime;
-			UInt64 m_refTime;
+			UInt64 m_refTime; //< In microseconds, or in timestamp ticks with ClockMode_Timestamp
 			bool m_paused;
 	};
 
@@ -50,6 +56,10 @@ namespace Nz
 
 	extern NAZARA_CORE_API ClockFunction GetElapsedMicroseconds;
 	extern NAZARA_CORE_API ClockFunction GetElapsedMilliseconds;
+	extern NAZARA_CORE_API ClockFunction GetTimestamp;
+
+	NAZARA_CORE_API UInt64 GetTimestampFrequency();
+	NAZARA_CORE_API UInt64 TimestampToMicroseconds(UInt64 ticks);
 }
 
 #endif // NAZARA_CLOCK_HPP
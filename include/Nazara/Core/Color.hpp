@@ -19,27 +19,27 @@ namespace Nz
 	{
 		public:
 			inline Color();
-			inline Color(UInt8 red, UInt8 green, UInt8 blue, UInt8 alpha = 255);
-			inline explicit Color(UInt8 lightness);
-			inline Color(UInt8 color[3], UInt8 alpha = 255);
+			constexpr Color(UInt8 red, UInt8 green, UInt8 blue, UInt8 alpha = 255);
+			constexpr explicit Color(UInt8 lightness);
+			constexpr Color(UInt8 color[3], UInt8 alpha = 255);
 			inline Color(const Color& color) = default;
 			inline ~Color() = default;
 
-			inline bool IsOpaque() const;
+			constexpr bool IsOpaque() const;
 
 			inline String ToString() const;
 
-			inline Color operator+(const Color& angles) const;
-			inline Color operator*(const Color& angles) const;
+			constexpr Color operator+(const Color& angles) const;
+			constexpr Color operator*(const Color& angles) const;
 
-			inline Color operator+=(const Color& angles);
-			inline Color operator*=(const Color& angles);
+			constexpr Color operator+=(const Color& angles);
+			constexpr Color operator*=(const Color& angles);
 
-			inline bool operator==(const Color& angles) const;
-			inline bool operator!=(const Color& angles) const;
+			constexpr bool operator==(const Color& angles) const;
+			constexpr bool operator!=(const Color& angles) const;
 
-			static inline Color FromCMY(float cyan, float magenta, float yellow);
-			static inline Color FromCMYK(float cyan, float magenta, float yellow, float black);
+			static constexpr Color FromCMY(float cyan, float magenta, float yellow);
+			static constexpr Color FromCMYK(float cyan, float magenta, float yellow, float black);
 			static inline Color FromHSL(UInt8 hue, UInt8 saturation, UInt8 lightness);
 			static inline Color FromHSV(float hue, float saturation, float value);
 			static inline Color FromXYZ(const Vector3f& vec);
@@ -35,7 +35,7 @@ namespace Nz
 	* \param alpha Alpha value
 	*/
 
-	inline Color::Color(UInt8 red, UInt8 green, UInt8 blue, UInt8 alpha) :
+	constexpr Color::Color(UInt8 red, UInt8 green, UInt8 blue, UInt8 alpha) :
 	r(red),
 	g(green),
 	b(blue),
@@ -49,7 +49,7 @@ namespace Nz
 	* \param lightness Value for r, g and b
 	*/
 
-	inline Color::Color(UInt8 lightness) :
+	constexpr Color::Color(UInt8 lightness) :
 	r(lightness),
 	g(lightness),
 	b(lightness),
@@ -64,7 +64,7 @@ namespace Nz
 	* \param alpha Alpha value
 	*/
 
-	inline Color::Color(UInt8 vec[3], UInt8 alpha) :
+	constexpr Color::Color(UInt8 vec[3], UInt8 alpha) :
 	r(vec[0]),
 	g(vec[1]),
 	b(vec[2]),
@@ -76,7 +76,7 @@ namespace Nz
 	* \brief Return true is the color has no degree of transparency
 	* \return true if the color has an alpha value of 255
 	*/
-	inline bool Color::IsOpaque() const
+	constexpr bool Color::IsOpaque() const
 	{
 		return a == 255;
 	}
@@ -106,16 +106,13 @@ namespace Nz
 	* \param color Other color
 	*/
 
-	inline Color Color::operator+(const Color& color) const
+	constexpr Color Color::operator+(const Color& color) const
 	{
 		///TODO: Improve this shit
-		Color c;
-		c.r = static_cast<UInt8>(std::min(static_cast<unsigned int>(r) + static_cast<unsigned int>(color.r), 255U));
-		c.g = static_cast<UInt8>(std::min(static_cast<unsigned int>(g) + static_cast<unsigned int>(color.g), 255U));
-		c.b = static_cast<UInt8>(std::min(static_cast<unsigned int>(b) + static_cast<unsigned int>(color.b), 255U));
-		c.a = static_cast<UInt8>(std::min(static_cast<unsigned int>(a) + static_cast<unsigned int>(color.a), 255U));
-
-		return c;
+		return Color(static_cast<UInt8>(std::min(static_cast<unsigned int>(r) + static_cast<unsigned int>(color.r), 255U)),
+		             static_cast<UInt8>(std::min(static_cast<unsigned int>(g) + static_cast<unsigned int>(color.g), 255U)),
+		             static_cast<UInt8>(std::min(static_cast<unsigned int>(b) + static_cast<unsigned int>(color.b), 255U)),
+		             static_cast<UInt8>(std::min(static_cast<unsigned int>(a) + static_cast<unsigned int>(color.a), 255U)));
 	}
 
 	/*!
@@ -125,16 +122,13 @@ namespace Nz
 	* \param color Other color
 	*/
 
-	inline Color Color::operator*(const Color& color) const
+	constexpr Color Color::operator*(const Color& color) const
 	{
 		///TODO: Improve this shit
-		Color c;
-		c.r = static_cast<UInt8>((static_cast<unsigned int>(r) * static_cast<unsigned int>(color.r)) / 255U);
-		c.g = static_cast<UInt8>((static_cast<unsigned int>(g) * static_cast<unsigned int>(color.g)) / 255U);
-		c.b = static_cast<UInt8>((static_cast<unsigned int>(b) * static_cast<unsigned int>(color.b)) / 255U);
-		c.a = static_cast<UInt8>((static_cast<unsigned int>(a) * static_cast<unsigned int>(color.a)) / 255U);
-
-		return c;
+		return Color(static_cast<UInt8>((static_cast<unsigned int>(r) * static_cast<unsigned int>(color.r)) / 255U),
+		             static_cast<UInt8>((static_cast<unsigned int>(g) * static_cast<unsigned int>(color.g)) / 255U),
+		             static_cast<UInt8>((static_cast<unsigned int>(b) * static_cast<unsigned int>(color.b)) / 255U),
+		             static_cast<UInt8>((static_cast<unsigned int>(a) * static_cast<unsigned int>(color.a)) / 255U));
 	}
 
 	/*!
@@ -144,7 +138,7 @@ namespace Nz
 	* \param color Other color
 	*/
 
-	inline Color Color::operator+=(const Color& color)
+	constexpr Color Color::operator+=(const Color& color)
 	{
 		return operator=(operator+(color));
 	}
@@ -156,7 +150,7 @@ namespace Nz
 	* \param color Other color
 	*/
 
-	inline Color Color::operator*=(const Color& color)
+	constexpr Color Color::operator*=(const Color& color)
 	{
 		return operator=(operator*(color));
 	}
@@ -168,7 +162,7 @@ namespace Nz
 	* \param color Color to compare
 	*/
 
-	inline bool Color::operator==(const Color& color) const
+	constexpr bool Color::operator==(const Color& color) const
 	{
 		return r == color.r && g == color.g && b == color.b && a == color.a;
 	}
@@ -180,7 +174,7 @@ namespace Nz
 	* \param color Color to compare
 	*/
 
-	inline bool Color::operator!=(const Color& color) const
+	constexpr bool Color::operator!=(const Color& color) const
 	{
 		return !operator==(color);
 	}
@@ -196,7 +190,7 @@ namespace Nz
 	* \param yellow Yellow component
 	*/
 
-	inline Color Color::FromCMY(float cyan, float magenta, float yellow)
+	constexpr Color Color::FromCMY(float cyan, float magenta, float yellow)
 	{
 		return Color(static_cast<UInt8>((1.f-cyan)*255.f), static_cast<UInt8>((1.f-magenta)*255.f), static_cast<UInt8>((1.f-yellow)*255.f));
 	}
@@ -211,7 +205,7 @@ namespace Nz
 	* \param black Black component
 	*/
 
-	inline Color Color::FromCMYK(float cyan, float magenta, float yellow, float black)
+	constexpr Color Color::FromCMYK(float cyan, float magenta, float yellow, float black)
 	{
 		return FromCMY(cyan * (1.f - black) + black,
 		               magenta * (1.f - black) + black,
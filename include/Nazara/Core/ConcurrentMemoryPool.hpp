@@ -0,0 +1,94 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CONCURRENTMEMORYPOOL_HPP
+#define NAZARA_CONCURRENTMEMORYPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Nz
+{
+	class ConcurrentMemoryPool
+	{
+		public:
+			ConcurrentMemoryPool(unsigned int blockSize, unsigned int magazineSize = 32, unsigned int magazinesPerChunk = 32, unsigned int maxChunkCount = 1024);
+			ConcurrentMemoryPool(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool(ConcurrentMemoryPool&&) = delete;
+			~ConcurrentMemoryPool() = default;
+
+			void* Allocate();
+			template<typename T> void Delete(T* ptr);
+			void Free(void* ptr);
+
+			unsigned int GetBlockSize() const;
+			unsigned int GetCapacity() const;
+			unsigned int GetMagazineSize() const;
+
+			template<typename T, typename... Args> T* New(Args&&... args);
+
+			ConcurrentMemoryPool& operator=(const ConcurrentMemoryPool&) = delete;
+			ConcurrentMemoryPool& operator=(ConcurrentMemoryPool&&) = delete;
+
+			static constexpr unsigned int CacheCount = 64;
+
+		private:
+			struct Cache;
+			struct Magazine;
+
+			Cache& AcquireCache();
+			void Flush(Cache& cache);
+			Magazine& GetMagazine(UInt32 index);
+			bool Grow();
+			UInt32 PopMagazine(std::atomic<UInt64>& stack);
+			void PushMagazine(std::atomic<UInt64>& stack, UInt32 index);
+			bool Refill(Cache& cache);
+
+			static unsigned int GetCacheIndex();
+
+			// Avoid false sharing between threads: new[] does not align the array on a cache line,
+			// the members are thus surrounded by a whole cache line on both sides
+			struct Cache
+			{
+				UInt8 headPadding[64];
+				void* head = nullptr;
+				unsigned int count = 0;
+				std::atomic_bool locked;
+				UInt8 tailPadding[64];
+			};
+
+			struct Chunk
+			{
+				std::unique_ptr<UInt8[]> blocks;
+				std::unique_ptr<Magazine[]> magazines;
+			};
+
+			struct Magazine
+			{
+				void* head;
+				std::atomic<UInt32> next;
+			};
+
+			static constexpr UInt32 InvalidIndex = 0xFFFFFFFF;
+
+			std::atomic<UInt64> m_emptyMagazines; // Tagged indices (ABA protection): [32 bits tag | 32 bits index + 1]
+			std::atomic<UInt64> m_fullMagazines;
+			std::atomic_uint m_chunkCount;
+			std::unique_ptr<Cache[]> m_caches;
+			std::unique_ptr<Chunk[]> m_chunks;
+			Mutex m_growMutex;
+			unsigned int m_blockSize;
+			unsigned int m_magazineSize;
+			unsigned int m_magazinesPerChunk;
+			unsigned int m_maxChunkCount;
+	};
+}
+
+#include <Nazara/Core/ConcurrentMemoryPool.inl>
+
+#endif // NAZARA_CONCURRENTMEMORYPOOL_HPP
@@ -0,0 +1,307 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <algorithm>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::ConcurrentMemoryPool
+	* \brief Core class that represents a memory pool of fixed-size blocks which can be shared between threads
+	*
+	* Each thread works with its own cache of free blocks (no contention), exchanging whole magazines of blocks with a shared lock-free stack when its cache gets empty or full.
+	* A block can be freed by any thread, it simply joins the cache of the freeing thread.
+	*/
+
+	/*!
+	* \brief Constructs a ConcurrentMemoryPool object
+	*
+	* \param blockSize Size of blocks that will be allocated
+	* \param magazineSize Number of blocks exchanged at once between a thread cache and the shared stack
+	* \param magazinesPerChunk Number of magazines allocated at once when the pool grows
+	* \param maxChunkCount Maximum number of chunks the pool can allocate
+	*/
+
+	inline ConcurrentMemoryPool::ConcurrentMemoryPool(unsigned int blockSize, unsigned int magazineSize, unsigned int magazinesPerChunk, unsigned int maxChunkCount) :
+	m_emptyMagazines(0),
+	m_fullMagazines(0),
+	m_chunkCount(0),
+	m_caches(new Cache[CacheCount]),
+	m_chunks(new Chunk[maxChunkCount]),
+	m_magazineSize(std::max(magazineSize, 1U)),
+	m_magazinesPerChunk(std::max(magazinesPerChunk, 1U)),
+	m_maxChunkCount(maxChunkCount)
+	{
+		// Free blocks store the address of the next free block
+		m_blockSize = std::max<unsigned int>(blockSize, sizeof(void*));
+		m_blockSize = (m_blockSize + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+
+		for (unsigned int i = 0; i < CacheCount; ++i)
+			m_caches[i].locked = false;
+	}
+
+	/*!
+	* \brief Allocates a block and returns a pointer to it
+	* \return A pointer to a block of at least GetBlockSize() bytes
+	*
+	* \remark Produces a NazaraError and returns nullptr if the pool has reached its maximum chunk count
+	*/
+
+	inline void* ConcurrentMemoryPool::Allocate()
+	{
+		Cache& cache = AcquireCache();
+		if (cache.count == 0 && !Refill(cache))
+		{
+			cache.locked.store(false, std::memory_order_release);
+			return nullptr;
+		}
+
+		void* block = cache.head;
+		cache.head = *static_cast<void**>(block);
+		cache.count--;
+
+		cache.locked.store(false, std::memory_order_release);
+
+		return block;
+	}
+
+	/*!
+	* \brief Deletes the memory represented by the pointer
+	*
+	* Calls the destructor of the object before releasing it
+	*
+	* \remark If ptr is null, nothing is done
+	*/
+
+	template<typename T>
+	inline void ConcurrentMemoryPool::Delete(T* ptr)
+	{
+		if (ptr)
+		{
+			ptr->~T();
+			Free(ptr);
+		}
+	}
+
+	/*!
+	* \brief Frees the memory represented by the pointer
+	*
+	* \param ptr Block allocated by this pool, from any thread
+	*
+	* \remark If ptr is null, nothing is done
+	*/
+
+	inline void ConcurrentMemoryPool::Free(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		Cache& cache = AcquireCache();
+		*static_cast<void**>(ptr) = cache.head;
+		cache.head = ptr;
+
+		// Keeps one magazine at hand to avoid going back and forth with the shared stack
+		if (++cache.count >= 2 * m_magazineSize)
+			Flush(cache);
+
+		cache.locked.store(false, std::memory_order_release);
+	}
+
+	/*!
+	* \brief Gets the block size
+	* \return Size of the blocks
+	*/
+
+	inline unsigned int ConcurrentMemoryPool::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	/*!
+	* \brief Gets the number of blocks the pool has allocated so far
+	* \return Number of blocks, free or not
+	*/
+
+	inline unsigned int ConcurrentMemoryPool::GetCapacity() const
+	{
+		return m_chunkCount.load(std::memory_order_relaxed) * m_magazinesPerChunk * m_magazineSize;
+	}
+
+	/*!
+	* \brief Gets the magazine size
+	* \return Number of blocks exchanged at once between a thread cache and the shared stack
+	*/
+
+	inline unsigned int ConcurrentMemoryPool::GetMagazineSize() const
+	{
+		return m_magazineSize;
+	}
+
+	/*!
+	* \brief Creates a new value of type T with arguments
+	* \return Pointer to the allocated object
+	*
+	* \param args Arguments for the new object
+	*
+	* \remark Constructs inplace in the pool
+	* \remark Produces a NazaraAssert if T does not fit in a block
+	* \remark Returns nullptr if the pool has reached its maximum chunk count
+	*/
+
+	template<typename T, typename... Args>
+	inline T* ConcurrentMemoryPool::New(Args&&... args)
+	{
+		NazaraAssert(sizeof(T) <= m_blockSize, "Type is too big for this pool");
+
+		T* object = static_cast<T*>(Allocate());
+		if (!object)
+			return nullptr;
+
+		PlacementNew(object, std::forward<Args>(args)...);
+
+		return object;
+	}
+
+	inline ConcurrentMemoryPool::Cache& ConcurrentMemoryPool::AcquireCache()
+	{
+		// Caches are only shared when there are more threads than caches, the lock is uncontended otherwise
+		Cache& cache = m_caches[GetCacheIndex()];
+		while (cache.locked.exchange(true, std::memory_order_acquire));
+
+		return cache;
+	}
+
+	inline void ConcurrentMemoryPool::Flush(Cache& cache)
+	{
+		UInt32 magazineIndex = PopMagazine(m_emptyMagazines);
+		if (magazineIndex == InvalidIndex)
+			return; // Should not happen, there is always a free descriptor for the blocks held by the caches
+
+		// Hands the first magazineSize blocks over, the remaining ones stay in the cache
+		void* first = cache.head;
+		void* last = first;
+		for (unsigned int i = 1; i < m_magazineSize; ++i)
+			last = *static_cast<void**>(last);
+
+		cache.head = *static_cast<void**>(last);
+		cache.count -= m_magazineSize;
+		*static_cast<void**>(last) = nullptr;
+
+		GetMagazine(magazineIndex).head = first;
+		PushMagazine(m_fullMagazines, magazineIndex);
+	}
+
+	inline ConcurrentMemoryPool::Magazine& ConcurrentMemoryPool::GetMagazine(UInt32 index)
+	{
+		return m_chunks[index / m_magazinesPerChunk].magazines[index % m_magazinesPerChunk];
+	}
+
+	inline bool ConcurrentMemoryPool::Grow()
+	{
+		LockGuard lock(m_growMutex);
+
+		// Another thread may have grown the pool while we were waiting
+		if ((m_fullMagazines.load(std::memory_order_acquire) & 0xFFFFFFFF) != 0)
+			return true;
+
+		unsigned int chunkIndex = m_chunkCount.load(std::memory_order_relaxed);
+		if (chunkIndex >= m_maxChunkCount)
+		{
+			NazaraError("Concurrent memory pool is full (" + String::Number(m_maxChunkCount) + " chunks)");
+			return false;
+		}
+
+		std::size_t blockPerMagazine = m_magazineSize;
+		Chunk& chunk = m_chunks[chunkIndex];
+		chunk.blocks.reset(new UInt8[m_blockSize * blockPerMagazine * m_magazinesPerChunk]);
+		chunk.magazines.reset(new Magazine[m_magazinesPerChunk]);
+
+		for (unsigned int i = 0; i < m_magazinesPerChunk; ++i)
+		{
+			UInt8* magazineBlocks = &chunk.blocks[m_blockSize * blockPerMagazine * i];
+			for (std::size_t j = 0; j < blockPerMagazine; ++j)
+			{
+				void* next = (j + 1 < blockPerMagazine) ? &magazineBlocks[m_blockSize * (j + 1)] : nullptr;
+				*reinterpret_cast<void**>(&magazineBlocks[m_blockSize * j]) = next;
+			}
+
+			chunk.magazines[i].head = magazineBlocks;
+		}
+
+		m_chunkCount.store(chunkIndex + 1, std::memory_order_relaxed);
+
+		// Publishing the magazines makes the chunk visible to the other threads
+		for (unsigned int i = 0; i < m_magazinesPerChunk; ++i)
+			PushMagazine(m_fullMagazines, chunkIndex * m_magazinesPerChunk + i);
+
+		return true;
+	}
+
+	inline UInt32 ConcurrentMemoryPool::PopMagazine(std::atomic<UInt64>& stack)
+	{
+		UInt64 head = stack.load(std::memory_order_acquire);
+		for (;;)
+		{
+			UInt32 index = static_cast<UInt32>(head & 0xFFFFFFFF);
+			if (index == 0)
+				return InvalidIndex;
+
+			// The descriptor may be popped and pushed again meanwhile, the tag makes the exchange fail if so
+			UInt32 next = GetMagazine(index - 1).next.load(std::memory_order_relaxed);
+			UInt64 newHead = ((head >> 32) + 1) << 32 | next;
+			if (stack.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+				return index - 1;
+		}
+	}
+
+	inline void ConcurrentMemoryPool::PushMagazine(std::atomic<UInt64>& stack, UInt32 index)
+	{
+		Magazine& magazine = GetMagazine(index);
+
+		UInt64 head = stack.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			magazine.next.store(static_cast<UInt32>(head & 0xFFFFFFFF), std::memory_order_relaxed);
+			UInt64 newHead = ((head >> 32) + 1) << 32 | (index + 1);
+			if (stack.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+				return;
+		}
+	}
+
+	inline bool ConcurrentMemoryPool::Refill(Cache& cache)
+	{
+		UInt32 magazineIndex;
+		while ((magazineIndex = PopMagazine(m_fullMagazines)) == InvalidIndex)
+		{
+			if (!Grow())
+				return false;
+		}
+
+		Magazine& magazine = GetMagazine(magazineIndex);
+
+		// The blocks of the magazine are appended to the cache (which is empty)
+		cache.head = magazine.head;
+		cache.count = m_magazineSize;
+
+		PushMagazine(m_emptyMagazines, magazineIndex);
+
+		return true;
+	}
+
+	inline unsigned int ConcurrentMemoryPool::GetCacheIndex()
+	{
+		static std::atomic_uint s_nextIndex(0);
+		static thread_local unsigned int s_index = (s_nextIndex++) % CacheCount;
+
+		return s_index;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
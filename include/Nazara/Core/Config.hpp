@@ -43,6 +43,9 @@
 // Checks the assertions
 #define NAZARA_CORE_ENABLE_ASSERTS 0
 
+// Compile the profiling zones (NazaraProfileZone), which only record when Profiler::Enable is called
+#define NAZARA_CORE_ENABLE_PROFILER 1
+
 // Call exit when an assertion is invalid
 #define NAZARA_CORE_EXIT_ON_ASSERT_FAILURE 1
 
@@ -55,6 +58,9 @@
 // Use the MemoryManager to manage dynamic allocations (can detect memory leak but allocations/frees are slower)
 #define NAZARA_CORE_MANAGE_MEMORY 0
 
+// Back the MemoryManager by size classes and per-thread caches instead of a locked list of blocks (fast enough for production, leaks are then counted per module instead of listed)
+#define NAZARA_CORE_MEMORYMANAGER_THREADCACHE 0
+
 // Activate the security tests based on the code (Advised for development)
 #define NAZARA_CORE_SAFE 1
 
@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Initializer.hpp>
+#include <atomic>
 
 namespace Nz
 {
@@ -25,7 +26,7 @@ namespace Nz
 			static void Uninitialize();
 
 		private:
-			static unsigned int s_moduleReferenceCounter;
+			static std::atomic<unsigned int> s_moduleReferenceCounter;
 	};
 }
 
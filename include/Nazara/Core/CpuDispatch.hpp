@@ -0,0 +1,117 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_CPUDISPATCH_HPP
+#define NAZARA_CPUDISPATCH_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
+#include <atomic>
+#include <initializer_list>
+#include <vector>
+
+namespace Nz
+{
+	class CpuDispatch;
+
+	namespace Detail
+	{
+		class NAZARA_CORE_API CpuKernelBase
+		{
+			friend class Nz::CpuDispatch;
+
+			public:
+				CpuKernelBase(const CpuKernelBase&) = delete;
+				CpuKernelBase(CpuKernelBase&&) = delete;
+
+				inline const char* GetName() const;
+				virtual const char* GetSelectedName() const = 0;
+
+				CpuKernelBase& operator=(const CpuKernelBase&) = delete;
+				CpuKernelBase& operator=(CpuKernelBase&&) = delete;
+
+			protected:
+				CpuKernelBase(const char* name);
+				~CpuKernelBase();
+
+				virtual void Select() = 0;
+
+			private:
+				const char* m_name;
+				CpuKernelBase* m_next;
+		};
+	}
+
+	class NAZARA_CORE_API CpuDispatch
+	{
+		friend Detail::CpuKernelBase;
+
+		public:
+			CpuDispatch() = delete;
+			~CpuDispatch() = delete;
+
+			template<typename F> static void ForEachKernel(F&& callback);
+
+			static bool HasCapabilities(UInt64 capabilities);
+
+			static bool Initialize();
+
+			static bool IsCapabilityEnabled(ProcessorCap capability);
+			static bool IsInitialized();
+
+			static constexpr UInt64 MakeCapabilities(std::initializer_list<ProcessorCap> capabilities);
+
+			static void SetCapabilityEnabled(ProcessorCap capability, bool enable);
+
+			static void Uninitialize();
+
+		private:
+			static void Register(Detail::CpuKernelBase* kernel);
+			static void SelectAll();
+			static void Unregister(Detail::CpuKernelBase* kernel);
+
+			static Detail::CpuKernelBase* s_kernels;
+	};
+
+	template<typename Signature> class CpuKernel;
+
+	template<typename R, typename... Args>
+	class CpuKernel<R(Args...)> : public Detail::CpuKernelBase
+	{
+		public:
+			using Function = R(*)(Args...);
+			struct Implementation;
+
+			CpuKernel(const char* name, Function fallback, std::initializer_list<Implementation> implementations = {});
+			~CpuKernel() = default;
+
+			inline Function Get() const;
+			const char* GetSelectedName() const override;
+
+			inline R operator()(Args... args) const;
+
+			struct Implementation
+			{
+				Implementation(Function implFunction, const char* implName, std::initializer_list<ProcessorCap> capabilities);
+
+				Function function;
+				const char* name;
+				UInt64 requiredCapabilities;
+			};
+
+		private:
+			void Select() override;
+			Function SelectImplementation() const;
+
+			std::vector<Implementation> m_implementations;
+			mutable std::atomic<Function> m_function;
+			mutable std::atomic<const char*> m_selectedName;
+	};
+}
+
+#include <Nazara/Core/CpuDispatch.inl>
+
+#endif // NAZARA_CPUDISPATCH_HPP
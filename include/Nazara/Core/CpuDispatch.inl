@@ -0,0 +1,186 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		/*!
+		* \brief Gets the name of the kernel
+		* \return Name given at construction
+		*/
+
+		inline const char* CpuKernelBase::GetName() const
+		{
+			return m_name;
+		}
+	}
+
+	/*!
+	* \brief Calls a function for every registered kernel
+	*
+	* \param callback Function called with a const reference to each kernel, as a Detail::CpuKernelBase
+	*/
+
+	template<typename F>
+	void CpuDispatch::ForEachKernel(F&& callback)
+	{
+		for (const Detail::CpuKernelBase* kernel = s_kernels; kernel; kernel = kernel->m_next)
+			callback(*kernel);
+	}
+
+	/*!
+	* \brief Builds a capability mask, as expected by HasCapabilities
+	* \return Mask with the bit of each capability set
+	*
+	* \param capabilities Capabilities to put in the mask
+	*/
+
+	constexpr UInt64 CpuDispatch::MakeCapabilities(std::initializer_list<ProcessorCap> capabilities)
+	{
+		static_assert(ProcessorCap_Max < 64, "Capability mask is too small");
+
+		UInt64 mask = 0;
+		for (ProcessorCap capability : capabilities)
+			mask |= UInt64(1) << capability;
+
+		return mask;
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::CpuKernel
+	* \brief Core class that holds several implementations of a function and dispatches calls to the best one the processor supports
+	*
+	* Implementations are given by order of preference, the first one whose capabilities are all enabled is selected,
+	* the fallback one being used when none is. Selection happens during Core::Initialize, or on the first call if it happens earlier,
+	* and again each time CpuDispatch::SetCapabilityEnabled changes the available capabilities.
+	*
+	* Kernels are meant to be static objects of the translation unit implementing them:
+	* \code
+	* CpuKernel<void(float*, std::size_t)> s_scaleKernel("Scale", &ScaleGeneric, {
+	*     {&ScaleAVX2, "AVX2", {ProcessorCap_AVX2}},
+	*     {&ScaleSSE2, "SSE2", {ProcessorCap_SSE2}}
+	* });
+	* \endcode
+	*/
+
+	/*!
+	* \brief Constructs a CpuKernel object and registers it to CpuDispatch
+	*
+	* \param name Name of the kernel, must stay valid during the lifetime of the kernel
+	* \param fallback Implementation working on every processor
+	* \param implementations Specialized implementations, best first
+	*/
+
+	template<typename R, typename... Args>
+	CpuKernel<R(Args...)>::CpuKernel(const char* name, Function fallback, std::initializer_list<Implementation> implementations) :
+	CpuKernelBase(name),
+	m_implementations(implementations),
+	m_function(nullptr),
+	m_selectedName(nullptr)
+	{
+		NazaraAssert(fallback, "Invalid fallback function");
+
+		m_implementations.emplace_back(fallback, "Generic", std::initializer_list<ProcessorCap>{});
+	}
+
+	/*!
+	* \brief Gets the selected implementation
+	* \return Pointer to the function calls are dispatched to
+	*/
+
+	template<typename R, typename... Args>
+	inline auto CpuKernel<R(Args...)>::Get() const -> Function
+	{
+		Function function = m_function.load(std::memory_order_relaxed);
+		if (!function)
+			function = SelectImplementation();
+
+		return function;
+	}
+
+	/*!
+	* \brief Gets the name of the selected implementation
+	* \return Name of the implementation, "Generic" for the fallback
+	*/
+
+	template<typename R, typename... Args>
+	const char* CpuKernel<R(Args...)>::GetSelectedName() const
+	{
+		Get();
+
+		return m_selectedName.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Calls the selected implementation
+	* \return What the implementation returns
+	*
+	* \param args Arguments forwarded to the implementation
+	*/
+
+	template<typename R, typename... Args>
+	inline R CpuKernel<R(Args...)>::operator()(Args... args) const
+	{
+		return Get()(std::forward<Args>(args)...);
+	}
+
+	/*!
+	* \brief Selects the implementation according to the enabled capabilities
+	*/
+
+	template<typename R, typename... Args>
+	void CpuKernel<R(Args...)>::Select()
+	{
+		SelectImplementation();
+	}
+
+	/*!
+	* \brief Selects the best implementation and stores it
+	* \return The selected implementation
+	*
+	* \remark Concurrent selections store the same implementation, they are harmless
+	*/
+
+	template<typename R, typename... Args>
+	auto CpuKernel<R(Args...)>::SelectImplementation() const -> Function
+	{
+		for (const Implementation& implementation : m_implementations)
+		{
+			if (CpuDispatch::HasCapabilities(implementation.requiredCapabilities))
+			{
+				m_selectedName.store(implementation.name, std::memory_order_relaxed);
+				m_function.store(implementation.function, std::memory_order_relaxed);
+
+				return implementation.function;
+			}
+		}
+
+		NazaraInternalError("No implementation found, even the fallback one");
+		return m_implementations.back().function;
+	}
+
+	/*!
+	* \brief Constructs an Implementation object
+	*
+	* \param implFunction Specialized function
+	* \param implName Name of the implementation, generally the instruction set it uses
+	* \param capabilities Processor capabilities the function requires
+	*/
+
+	template<typename R, typename... Args>
+	CpuKernel<R(Args...)>::Implementation::Implementation(Function implFunction, const char* implName, std::initializer_list<ProcessorCap> capabilities) :
+	function(implFunction),
+	name(implName),
+	requiredCapabilities(CpuDispatch::MakeCapabilities(capabilities))
+	{
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -29,6 +29,7 @@ namespace Nz
 {
 	inline constexpr Endianness GetPlatformEndianness();
 	inline void SwapBytes(void* buffer, std::size_t size);
+	inline void SwapBytes(void* buffer, std::size_t elementSize, std::size_t count);
 	template<typename T> T SwapBytes(T value);
 }
 
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <algorithm>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -40,6 +41,66 @@ namespace Nz
 			std::swap(bytes[i++], bytes[j--]);
 	}
 
+	/*!
+	* \ingroup core
+	* \brief Swaps the bytes of each element of an array
+	*
+	* \param buffer Raw memory of the array
+	* \param elementSize Size of an element, whose bytes are reversed
+	* \param count Number of elements
+	*
+	* \remark The common 2, 4 and 8 bytes sizes are written as plain shift loops, which compilers vectorize
+	*/
+	inline void SwapBytes(void* buffer, std::size_t elementSize, std::size_t count)
+	{
+		UInt8* bytes = static_cast<UInt8*>(buffer);
+
+		switch (elementSize)
+		{
+			case 1:
+				break;
+
+			case 2:
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					UInt16 value;
+					std::memcpy(&value, &bytes[i * 2], 2);
+					value = static_cast<UInt16>((value >> 8) | (value << 8));
+					std::memcpy(&bytes[i * 2], &value, 2);
+				}
+				break;
+
+			case 4:
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					UInt32 value;
+					std::memcpy(&value, &bytes[i * 4], 4);
+					value = ((value & 0x000000FFU) << 24) | ((value & 0x0000FF00U) << 8) |
+					        ((value & 0x00FF0000U) >> 8)  | ((value & 0xFF000000U) >> 24);
+					std::memcpy(&bytes[i * 4], &value, 4);
+				}
+				break;
+
+			case 8:
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					UInt64 value;
+					std::memcpy(&value, &bytes[i * 8], 8);
+					value = ((value & 0x00000000000000FFULL) << 56) | ((value & 0x000000000000FF00ULL) << 40) |
+					        ((value & 0x0000000000FF0000ULL) << 24) | ((value & 0x00000000FF000000ULL) << 8)  |
+					        ((value & 0x000000FF00000000ULL) >> 8)  | ((value & 0x0000FF0000000000ULL) >> 24) |
+					        ((value & 0x00FF000000000000ULL) >> 40) | ((value & 0xFF00000000000000ULL) >> 56);
+					std::memcpy(&bytes[i * 8], &value, 8);
+				}
+				break;
+
+			default:
+				for (std::size_t i = 0; i < count; ++i)
+					SwapBytes(&bytes[i * elementSize], elementSize);
+				break;
+		}
+	}
+
 	template<typename T> 
 	T SwapBytes(T value)
 	{
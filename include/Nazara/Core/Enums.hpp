@@ -9,6 +9,14 @@
 
 namespace Nz
 {
+	enum ClockMode
+	{
+		ClockMode_System,    // GetElapsedMicroseconds
+		ClockMode_Timestamp, // GetTimestamp, converted to microseconds only when the time is read
+
+		ClockMode_Max = ClockMode_Timestamp
+	};
+
 	enum CoordSys
 	{
 		CoordSys_Global,
@@ -69,8 +77,17 @@ namespace Nz
 		HashType_SHA384,
 		HashType_SHA512,
 		HashType_Whirlpool,
+		HashType_XXHash64,
 
-		HashType_Max = HashType_Whirlpool
+		HashType_Max = HashType_XXHash64
+	};
+
+	enum LogOverflowPolicy
+	{
+		LogOverflowPolicy_Block, // The writing thread waits for room in its queue
+		LogOverflowPolicy_Drop,  // The entry is dropped, dropped entries are counted and reported
+
+		LogOverflowPolicy_Max = LogOverflowPolicy_Drop
 	};
 
 	enum OpenModeFlags
@@ -136,8 +153,17 @@ namespace Nz
 		ProcessorCap_SSE41,
 		ProcessorCap_SSE42,
 		ProcessorCap_SSE4a,
-
-		ProcessorCap_Max = ProcessorCap_SSE4a
+		ProcessorCap_PCLMULQDQ,
+		ProcessorCap_SHA,
+		ProcessorCap_AVX2,
+		ProcessorCap_AVX512F,
+		ProcessorCap_BMI1,
+		ProcessorCap_BMI2,
+		ProcessorCap_InvariantTSC, // Timestamp counter running at a constant rate (generic timer on ARM64)
+		ProcessorCap_RDTSCP,
+		ProcessorCap_NEON,
+
+		ProcessorCap_Max = ProcessorCap_NEON
 	};
 
 	enum ProcessorVendor
@@ -164,6 +190,14 @@ namespace Nz
 		ProcessorVendor_Max = ProcessorVendor_XenHVM
 	};
 
+	enum RefCountingMode
+	{
+		RefCountingMode_Atomic,         // References may be added and removed from any thread
+		RefCountingMode_SingleThreaded, // References are only added and removed from one thread at a time, no atomic operation
+
+		RefCountingMode_Max = RefCountingMode_SingleThreaded
+	};
+
 	enum SphereType
 	{
 		SphereType_Cubic,
@@ -191,6 +225,17 @@ namespace Nz
 
 		Ternary_Max = Ternary_Unknown
 	};
+
+	enum ThreadPriority
+	{
+		ThreadPriority_Lowest,
+		ThreadPriority_Low,
+		ThreadPriority_Normal,
+		ThreadPriority_High,
+		ThreadPriority_Highest,
+
+		ThreadPriority_Max = ThreadPriority_Highest
+	};
 }
 
 #endif // NAZARA_ENUMS_CORE_HPP
@@ -0,0 +1,39 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_EXCLUSIVELOCKGUARD_HPP
+#define NAZARA_EXCLUSIVELOCKGUARD_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	class SharedMutex;
+
+	class ExclusiveLockGuard
+	{
+		public:
+			inline ExclusiveLockGuard(SharedMutex& mutex, bool lock = true);
+			ExclusiveLockGuard(const ExclusiveLockGuard&) = delete;
+			ExclusiveLockGuard(ExclusiveLockGuard&&) = delete;
+			inline ~ExclusiveLockGuard();
+
+			inline void Lock();
+			inline bool TryLock();
+			inline void Unlock();
+
+			ExclusiveLockGuard& operator=(const ExclusiveLockGuard&) = delete;
+			ExclusiveLockGuard& operator=(ExclusiveLockGuard&&) = delete;
+
+		private:
+			SharedMutex& m_mutex;
+			bool m_locked;
+	};
+}
+
+#include <Nazara/Core/ExclusiveLockGuard.inl>
+
+#endif // NAZARA_EXCLUSIVELOCKGUARD_HPP
@@ -0,0 +1,85 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ExclusiveLockGuard.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::ExclusiveLockGuard
+	* \brief Core class that represents a RAII-style owner of a SharedMutex in exclusive (writer) mode
+	*/
+
+	/*!
+	* \brief Constructs a ExclusiveLockGuard object with a mutex
+	*
+	* \param mutex Mutex to lock
+	* \param lock Should the mutex be locked by the constructor
+	*/
+	inline ExclusiveLockGuard::ExclusiveLockGuard(SharedMutex& mutex, bool lock) :
+	m_mutex(mutex),
+	m_locked(false)
+	{
+		if (lock)
+		{
+			m_mutex.Lock();
+			m_locked = true;
+		}
+	}
+
+	/*!
+	* \brief Destructs a ExclusiveLockGuard object and unlocks the mutex if it was previously locked
+	*/
+	inline ExclusiveLockGuard::~ExclusiveLockGuard()
+	{
+		if (m_locked)
+			m_mutex.Unlock();
+	}
+
+	/*!
+	* \brief Locks the underlying mutex in exclusive mode
+	*
+	* \see SharedMutex::Lock
+	*/
+	inline void ExclusiveLockGuard::Lock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_mutex.Lock();
+		m_locked = true;
+	}
+
+	/*!
+	* \brief Tries to lock the underlying mutex in exclusive mode
+	* \return true if the lock was acquired successfully
+	*
+	* \see SharedMutex::TryLock
+	*/
+	inline bool ExclusiveLockGuard::TryLock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_locked = m_mutex.TryLock();
+		return m_locked;
+	}
+
+	/*!
+	* \brief Unlocks the underlying mutex
+	*
+	* \see SharedMutex::Unlock
+	*/
+	inline void ExclusiveLockGuard::Unlock()
+	{
+		NazaraAssert(m_locked, "Mutex is not locked");
+
+		m_mutex.Unlock();
+		m_locked = false;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -55,8 +55,11 @@ namespace Nz
 			String GetPath() const override;
 			UInt64 GetSize() const override;
 
+			bool IsMapped() const;
 			bool IsOpen() const;
 
+			const void* Map();
+
 			bool Open(unsigned int openMode = OpenMode_NotOpen);
 			bool Open(const String& filePath, unsigned int openMode = OpenMode_NotOpen);
 
@@ -67,6 +70,8 @@ namespace Nz
 			bool SetFile(const String& filePath);
 			bool SetSize(UInt64 size);
 
+			void Unmap();
+
 			File& operator=(const String& filePath);
 			File& operator=(const File&) = delete;
 			File& operator=(File&& file) noexcept;
@@ -0,0 +1,69 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FRAMEARENA_HPP
+#define NAZARA_FRAMEARENA_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class FrameArena
+	{
+		public:
+			FrameArena(std::size_t blockSize = 64 * 1024);
+			FrameArena(const FrameArena&) = delete;
+			FrameArena(FrameArena&&) noexcept = default;
+			~FrameArena() = default;
+
+			void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+			std::size_t GetAllocatedSize() const;
+			std::size_t GetBlockSize() const;
+			std::size_t GetCapacity() const;
+			unsigned int GetFrameIndex() const;
+
+			template<typename T, typename... Args> T* New(Args&&... args);
+			template<typename T> T* NewArray(std::size_t count);
+
+			void NextFrame();
+
+			void Reset();
+
+			FrameArena& operator=(const FrameArena&) = delete;
+			FrameArena& operator=(FrameArena&&) noexcept = default;
+
+		private:
+			struct Block
+			{
+				std::unique_ptr<UInt8[]> memory;
+				std::size_t size;
+			};
+
+			void* AllocateFromNextBlock(std::size_t size, std::size_t alignment);
+
+			static std::size_t AlignOffset(const Block& block, std::size_t offset, std::size_t alignment);
+
+			struct Frame
+			{
+				std::vector<Block> blocks;
+				std::size_t allocatedSize = 0;
+				std::size_t currentBlock = 0;
+				std::size_t offset = 0;
+			};
+
+			Frame m_frames[2];
+			std::size_t m_blockSize;
+			unsigned int m_frameIndex;
+	};
+}
+
+#include <Nazara/Core/FrameArena.inl>
+
+#endif // NAZARA_FRAMEARENA_HPP
@@ -0,0 +1,232 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::FrameArena
+	* \brief Core class that represents a double-buffered linear allocator for per-frame data
+	*
+	* Allocations are made by bumping an offset inside memory blocks owned by the arena, they cannot be freed individually.
+	* Instead, every allocation of a frame is released at once by NextFrame (or Reset), in constant time and without calling the global allocator:
+	* blocks are kept and reused by the following frames, so a steady workload stops allocating memory after a few frames.
+	*
+	* The arena holds two frames: NextFrame switches to the other one, which means the memory allocated during the previous frame stays valid until the next call to NextFrame.
+	*
+	* \remark Destructors of objects constructed with New are never called, this class is meant for trivially destructible types or containers using FrameArenaAllocator
+	* \remark This class is not thread-safe
+	*
+	* \see FrameArenaAllocator
+	*/
+
+	/*!
+	* \brief Constructs a FrameArena object
+	*
+	* \param blockSize Size of the memory blocks the arena will allocate, bigger allocations get their own block
+	*/
+
+	inline FrameArena::FrameArena(std::size_t blockSize) :
+	m_blockSize(blockSize),
+	m_frameIndex(0)
+	{
+		NazaraAssert(blockSize > 0, "Block size must be over zero");
+	}
+
+	/*!
+	* \brief Allocates memory from the current frame
+	* \return A pointer to the allocated memory, valid until the current frame is reset
+	*
+	* \param size Size to allocate
+	* \param alignment Alignment of the returned memory, must be a power of two
+	*/
+
+	inline void* FrameArena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		Frame& frame = m_frames[m_frameIndex];
+		if (frame.currentBlock < frame.blocks.size())
+		{
+			Block& block = frame.blocks[frame.currentBlock];
+
+			std::size_t offset = AlignOffset(block, frame.offset, alignment);
+			if (offset + size <= block.size)
+			{
+				frame.allocatedSize += size;
+				frame.offset = offset + size;
+
+				return &block.memory[offset];
+			}
+		}
+
+		return AllocateFromNextBlock(size, alignment);
+	}
+
+	/*!
+	* \brief Gets the number of bytes allocated during the current frame
+	* \return Allocated size
+	*/
+
+	inline std::size_t FrameArena::GetAllocatedSize() const
+	{
+		return m_frames[m_frameIndex].allocatedSize;
+	}
+
+	/*!
+	* \brief Gets the size of the blocks allocated by the arena
+	* \return Block size
+	*/
+
+	inline std::size_t FrameArena::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	/*!
+	* \brief Gets the memory owned by the arena, for both of its frames
+	* \return Capacity in bytes
+	*/
+
+	inline std::size_t FrameArena::GetCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (const Frame& frame : m_frames)
+		{
+			for (const Block& block : frame.blocks)
+				capacity += block.size;
+		}
+
+		return capacity;
+	}
+
+	/*!
+	* \brief Gets the index of the current frame
+	* \return 0 or 1
+	*/
+
+	inline unsigned int FrameArena::GetFrameIndex() const
+	{
+		return m_frameIndex;
+	}
+
+	/*!
+	* \brief Constructs an object in the current frame
+	* \return A pointer to the constructed object
+	*
+	* \param args Arguments for the constructor
+	*
+	* \remark The destructor of the object will never be called
+	*/
+
+	template<typename T, typename... Args>
+	T* FrameArena::New(Args&&... args)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Objects allocated in a frame arena are never destroyed");
+
+		void* ptr = Allocate(sizeof(T), alignof(T));
+		return new (ptr) T(std::forward<Args>(args)...);
+	}
+
+	/*!
+	* \brief Allocates an uninitialized array in the current frame
+	* \return A pointer to the first element of the array
+	*
+	* \param count Number of elements
+	*/
+
+	template<typename T>
+	T* FrameArena::NewArray(std::size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Objects allocated in a frame arena are never destroyed");
+
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	/*!
+	* \brief Switches to the other frame and resets it
+	*
+	* Memory allocated during the frame preceding this call stays valid until the next call to NextFrame
+	*/
+
+	inline void FrameArena::NextFrame()
+	{
+		m_frameIndex ^= 1;
+		Reset();
+	}
+
+	/*!
+	* \brief Releases every allocation of the current frame
+	*
+	* \remark This does not return memory to the system, blocks are kept for future allocations
+	*/
+
+	inline void FrameArena::Reset()
+	{
+		Frame& frame = m_frames[m_frameIndex];
+		frame.allocatedSize = 0;
+		frame.currentBlock = 0;
+		frame.offset = 0;
+	}
+
+	/*!
+	* \brief Allocates memory at the start of the next block of the current frame, creating it if needed
+	* \return A pointer to the allocated memory
+	*
+	* \param size Size to allocate
+	* \param alignment Alignment of the returned memory
+	*/
+
+	inline void* FrameArena::AllocateFromNextBlock(std::size_t size, std::size_t alignment)
+	{
+		Frame& frame = m_frames[m_frameIndex];
+
+		std::size_t blockIndex = (frame.blocks.empty()) ? 0 : frame.currentBlock + 1;
+		if (blockIndex == frame.blocks.size() || AlignOffset(frame.blocks[blockIndex], 0, alignment) + size > frame.blocks[blockIndex].size)
+		{
+			// Blocks kept from previous frames are reused in order, a new one is only inserted when the next one is too small
+			Block block;
+			block.size = std::max(m_blockSize, size + alignment - 1);
+			block.memory.reset(new UInt8[block.size]);
+
+			frame.blocks.emplace(frame.blocks.begin() + blockIndex, std::move(block));
+		}
+
+		Block& block = frame.blocks[blockIndex];
+		std::size_t offset = AlignOffset(block, 0, alignment);
+
+		frame.allocatedSize += size;
+		frame.currentBlock = blockIndex;
+		frame.offset = offset + size;
+
+		return &block.memory[offset];
+	}
+
+	/*!
+	* \brief Computes the first offset inside a block, starting from another one, matching an alignment
+	* \return Aligned offset
+	*
+	* \param block Block the offset refers to
+	* \param offset Starting offset
+	* \param alignment Alignment, must be a power of two
+	*/
+
+	inline std::size_t FrameArena::AlignOffset(const Block& block, std::size_t offset, std::size_t alignment)
+	{
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.memory.get()) + offset;
+		std::uintptr_t alignedAddress = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+		return offset + static_cast<std::size_t>(alignedAddress - address);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
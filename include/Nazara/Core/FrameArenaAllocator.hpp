@@ -0,0 +1,60 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FRAMEARENAALLOCATOR_HPP
+#define NAZARA_FRAMEARENAALLOCATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Nz
+{
+	template<typename T>
+	class FrameArenaAllocator
+	{
+		template<typename U> friend class FrameArenaAllocator;
+
+		public:
+			using value_type = T;
+			using propagate_on_container_copy_assignment = std::true_type;
+			using propagate_on_container_move_assignment = std::true_type;
+			using propagate_on_container_swap = std::true_type;
+
+			template<typename U>
+			struct rebind
+			{
+				using other = FrameArenaAllocator<U>;
+			};
+
+			FrameArenaAllocator();
+			FrameArenaAllocator(FrameArena& arena);
+			template<typename U> FrameArenaAllocator(const FrameArenaAllocator<U>& allocator);
+			FrameArenaAllocator(const FrameArenaAllocator&) = default;
+			~FrameArenaAllocator() = default;
+
+			T* allocate(std::size_t count);
+			void deallocate(T* ptr, std::size_t count);
+
+			FrameArena* GetArena() const;
+
+			FrameArenaAllocator& operator=(const FrameArenaAllocator&) = default;
+
+			template<typename U> bool operator==(const FrameArenaAllocator<U>& allocator) const;
+			template<typename U> bool operator!=(const FrameArenaAllocator<U>& allocator) const;
+
+		private:
+			FrameArena* m_arena;
+	};
+
+	template<typename T> using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+}
+
+#include <Nazara/Core/FrameArenaAllocator.inl>
+
+#endif // NAZARA_FRAMEARENAALLOCATOR_HPP
@@ -0,0 +1,133 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::FrameArenaAllocator
+	* \brief Core class that represents a STL-compatible allocator drawing its memory from a FrameArena
+	*
+	* Deallocation is a no-op, memory is reclaimed when the arena frame is reset.
+	* A container using this allocator must then be emptied or reassigned before its frame gets reset, and must not outlive the arena.
+	*
+	* A default-constructed allocator is not bound to any arena and uses the global allocator instead,
+	* which allows containers to be default-constructed and receive an arena-bound allocator later through assignment.
+	*
+	* \see FrameArena
+	*/
+
+	/*!
+	* \brief Constructs a FrameArenaAllocator object not bound to any arena
+	*/
+
+	template<typename T>
+	FrameArenaAllocator<T>::FrameArenaAllocator() :
+	m_arena(nullptr)
+	{
+	}
+
+	/*!
+	* \brief Constructs a FrameArenaAllocator object bound to an arena
+	*
+	* \param arena Arena to allocate from, must outlive the allocator and its copies
+	*/
+
+	template<typename T>
+	FrameArenaAllocator<T>::FrameArenaAllocator(FrameArena& arena) :
+	m_arena(&arena)
+	{
+	}
+
+	/*!
+	* \brief Constructs a FrameArenaAllocator object bound to the same arena as another allocator
+	*
+	* \param allocator Allocator of another type
+	*/
+
+	template<typename T>
+	template<typename U>
+	FrameArenaAllocator<T>::FrameArenaAllocator(const FrameArenaAllocator<U>& allocator) :
+	m_arena(allocator.m_arena)
+	{
+	}
+
+	/*!
+	* \brief Allocates uninitialized storage for count objects
+	* \return A pointer to the storage
+	*
+	* \param count Number of objects
+	*/
+
+	template<typename T>
+	T* FrameArenaAllocator<T>::allocate(std::size_t count)
+	{
+		if (m_arena)
+			return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+		else
+			return static_cast<T*>(OperatorNew(count * sizeof(T)));
+	}
+
+	/*!
+	* \brief Releases storage obtained from allocate
+	*
+	* \param ptr Pointer returned by allocate
+	* \param count Number of objects passed to allocate
+	*
+	* \remark This does nothing when the allocator is bound to an arena
+	*/
+
+	template<typename T>
+	void FrameArenaAllocator<T>::deallocate(T* ptr, std::size_t count)
+	{
+		NazaraUnused(count);
+
+		if (!m_arena)
+			OperatorDelete(ptr);
+	}
+
+	/*!
+	* \brief Gets the arena this allocator is bound to
+	* \return A pointer to the arena, or nullptr when using the global allocator
+	*/
+
+	template<typename T>
+	FrameArena* FrameArenaAllocator<T>::GetArena() const
+	{
+		return m_arena;
+	}
+
+	/*!
+	* \brief Checks whether memory allocated by an allocator can be released by this one
+	* \return true if both allocators use the same arena
+	*
+	* \param allocator Other allocator
+	*/
+
+	template<typename T>
+	template<typename U>
+	bool FrameArenaAllocator<T>::operator==(const FrameArenaAllocator<U>& allocator) const
+	{
+		return m_arena == allocator.m_arena;
+	}
+
+	/*!
+	* \brief Checks whether memory allocated by an allocator cannot be released by this one
+	* \return false if both allocators use the same arena
+	*
+	* \param allocator Other allocator
+	*/
+
+	template<typename T>
+	template<typename U>
+	bool FrameArenaAllocator<T>::operator!=(const FrameArenaAllocator<U>& allocator) const
+	{
+		return !operator==(allocator);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
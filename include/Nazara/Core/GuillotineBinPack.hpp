@@ -13,6 +13,8 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/SparsePtr.hpp>
 #include <Nazara/Math/Rect.hpp>
+#include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace Nz
@@ -45,6 +47,7 @@ namespace Nz
 			bool Insert(Rectui* rects, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod);
 			bool Insert(Rectui* rects, bool* flipped, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod);
 			bool Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod);
+			bool InsertSorted(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod);
 
 			bool MergeFreeRectangles();
 
@@ -76,12 +79,32 @@ namespace Nz
 			};
 
 		private:
-			void SplitFreeRectAlongAxis(const Rectui& freeRect, const Rectui& placedRect, bool splitHorizontal);
-			void SplitFreeRectByHeuristic(const Rectui& freeRect, const Rectui& placedRect, GuillotineSplitHeuristic method);
+			struct FreeRect
+			{
+				Rectui rect;
+				std::size_t bucketPosition;
+				unsigned int bucket;
+			};
 
+			void AddFreeRectangle(Rectui rect, bool merge);
+			bool FindFreeRectangle(unsigned int width, unsigned int height, FreeRectChoiceHeuristic rectChoice, std::size_t* freeRectIndex, bool* flipped, int* score) const;
+			void FindFreeRectangleInBuckets(unsigned int width, unsigned int height, bool flip, FreeRectChoiceHeuristic rectChoice, std::size_t* freeRectIndex, bool* flipped, int* score) const;
+			void PlaceRectangle(std::size_t freeRectIndex, Rectui& rect, bool flipped, bool merge, GuillotineSplitHeuristic splitMethod);
+			void RemoveFreeRectangle(std::size_t freeRectIndex);
+			void SplitFreeRectAlongAxis(const Rectui& freeRect, const Rectui& placedRect, bool splitHorizontal, bool merge);
+			void SplitFreeRectByHeuristic(const Rectui& freeRect, const Rectui& placedRect, GuillotineSplitHeuristic method, bool merge);
+
+			static unsigned int GetSizeClass(unsigned int size);
 			static int ScoreByHeuristic(int width, int height, const Rectui& freeRect, FreeRectChoiceHeuristic rectChoice);
 
-			std::vector<Rectui> m_freeRectangles;
+			static constexpr unsigned int SizeClassCount = 16;
+
+			// Free rectangles are bucketed by the size class (log2) of their width and height, and indexed by their corners for merging
+			std::array<std::vector<std::size_t>, SizeClassCount * SizeClassCount> m_buckets;
+			std::array<UInt32, SizeClassCount> m_bucketMasks;
+			std::unordered_map<UInt64, std::size_t> m_freeRectsByBottomRight;
+			std::unordered_map<UInt64, std::size_t> m_freeRectsByTopLeft;
+			std::vector<FreeRect> m_freeRectangles;
 			unsigned int m_height;
 			unsigned int m_usedArea;
 			unsigned int m_width;
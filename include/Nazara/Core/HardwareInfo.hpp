@@ -21,6 +21,8 @@ namespace Nz
 
 			static void Cpuid(UInt32 functionId, UInt32 subFunctionId, UInt32 result[4]);
 
+			static unsigned int GetCoreCount();
+			static UInt64 GetCoreProcessorMask(unsigned int coreIndex);
 			static String GetProcessorBrandString();
 			static unsigned int GetProcessorCount();
 			static ProcessorVendor GetProcessorVendor();
@@ -8,19 +8,47 @@
 #define NAZARA_INITIALIZER_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <array>
+#include <type_traits>
 
 namespace Nz
 {
+	namespace Detail
+	{
+		struct InitializerModule
+		{
+			bool (*initialize)();
+			void (*uninitialize)();
+			UInt64 initializationTime;
+			bool initialized;
+			bool parallel;
+		};
+
+		// A module may be initialized on a worker thread if it declares "static constexpr bool ParallelInitialization = true;"
+		template<typename T, typename = void>
+		struct IsParallelInitializable : std::false_type {};
+
+		template<typename T>
+		struct IsParallelInitializable<T, decltype(void(T::ParallelInitialization))> : std::integral_constant<bool, T::ParallelInitialization> {};
+
+		NAZARA_CORE_API bool InitializeModules(InitializerModule* modules, std::size_t moduleCount, bool parallel);
+		NAZARA_CORE_API void UninitializeModules(InitializerModule* modules, std::size_t moduleCount);
+	}
+
 	template<typename... Args>
 	class Initializer
 	{
 		public:
-			Initializer(bool initialize = true);
+			Initializer(bool initialize = true, bool parallel = false);
 			Initializer(const Initializer&) = delete;
 			Initializer(Initializer&&) = delete; ///TODO
 			~Initializer();
 
-			bool Initialize();
+			UInt64 GetInitializationTime() const;
+			UInt64 GetModuleInitializationTime(std::size_t moduleIndex) const;
+
+			bool Initialize(bool parallel = false);
 			bool IsInitialized() const;
 			void Uninitialize();
 
@@ -30,6 +58,8 @@ namespace Nz
 			Initializer& operator=(Initializer&&) = delete; ///TODO
 
 		private:
+			std::array<Detail::InitializerModule, sizeof...(Args)> m_modules;
+			UInt64 m_initializationTime;
 			bool m_initialized;
 	};
 }
@@ -2,68 +2,37 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	namespace Detail
-	{
-		template<typename...> struct Initializer;
-
-		template<typename T, typename... Rest>
-		struct Initializer<T, Rest...>
-		{
-			static bool Init()
-			{
-				if (T::Initialize())
-				{
-					if (Initializer<Rest...>::Init())
-						return true;
-					else
-						T::Uninitialize();
-				}
-
-				return false;
-			}
-
-			static void Uninit()
-			{
-				Initializer<Rest...>::Uninit();
-				T::Uninitialize();
-			}
-		};
-
-		template<>
-		struct Initializer<>
-		{
-			static bool Init()
-			{
-				return true;
-			}
-
-			static void Uninit()
-			{
-			}
-		};
-	}
-
 	/*!
 	* \ingroup core
 	* \class Nz::Initializer
 	* \brief Core class that represents a module initializer
+	*
+	* Modules are initialized in the order of the template parameters and uninitialized in the reverse order.
+	*
+	* In parallel mode, the modules declaring a true ParallelInitialization constant (the ones only depending on Core)
+	* are first initialized together on the TaskScheduler, then the other ones are initialized in order on the calling thread.
 	*/
 
 	/*!
 	* \brief Constructs a Initializer object with a boolean
 	*
 	* \param initialize Initialize the module
+	* \param parallel Initialize the independent modules in parallel
 	*/
 	template<typename... Args>
-	Initializer<Args...>::Initializer(bool initialize) :
+	Initializer<Args...>::Initializer(bool initialize, bool parallel) :
+	m_modules({{{&Args::Initialize, &Args::Uninitialize, 0, false, Detail::IsParallelInitializable<Args>::value}...}}),
+	m_initializationTime(0),
 	m_initialized(false)
 	{
 		if (initialize)
-			Initialize();
+			Initialize(parallel);
 	}
 
 	/*!
@@ -77,16 +46,49 @@ namespace Nz
 		Uninitialize();
 	}
 
+	/*!
+	* \brief Gets the time taken by the last initialization
+	* \return Elapsed time in microseconds
+	*/
+	template<typename... Args>
+	UInt64 Initializer<Args...>::GetInitializationTime() const
+	{
+		return m_initializationTime;
+	}
+
+	/*!
+	* \brief Gets the time taken by a module during the last initialization
+	* \return Elapsed time in microseconds
+	*
+	* \param moduleIndex Index of the module in the template parameters
+	*
+	* \remark This includes the initialization of the dependencies not already initialized by a previous module
+	*/
+	template<typename... Args>
+	UInt64 Initializer<Args...>::GetModuleInitializationTime(std::size_t moduleIndex) const
+	{
+		NazaraAssert(moduleIndex < sizeof...(Args), "Module index out of range");
+
+		return m_modules[moduleIndex].initializationTime;
+	}
+
 	/*!
 	* \brief Initialize the module
+	* \return true if every module was initialized
+	*
+	* \param parallel Initialize the independent modules in parallel
 	*
 	* \see Uninitialize
 	*/
 	template<typename... Args>
-	bool Initializer<Args...>::Initialize()
+	bool Initializer<Args...>::Initialize(bool parallel)
 	{
 		if (!m_initialized)
-			m_initialized = Detail::Initializer<Args...>::Init();
+		{
+			UInt64 start = GetElapsedMicroseconds();
+			m_initialized = Detail::InitializeModules(m_modules.data(), m_modules.size(), parallel);
+			m_initializationTime = GetElapsedMicroseconds() - start;
+		}
 
 		return m_initialized;
 	}
@@ -110,7 +112,10 @@ namespace Nz
 	void Initializer<Args...>::Uninitialize()
 	{
 		if (m_initialized)
-			Detail::Initializer<Args...>::Uninit();
+		{
+			Detail::UninitializeModules(m_modules.data(), m_modules.size());
+			m_initialized = false;
+		}
 	}
 
 	/*!
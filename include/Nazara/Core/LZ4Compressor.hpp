@@ -0,0 +1,52 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_LZ4COMPRESSOR_HPP
+#define NAZARA_LZ4COMPRESSOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API LZ4Compressor
+	{
+		public:
+			LZ4Compressor();
+			inline LZ4Compressor(const void* dictionary, std::size_t dictionarySize);
+			LZ4Compressor(const LZ4Compressor&) = default;
+			LZ4Compressor(LZ4Compressor&&) = default;
+			~LZ4Compressor() = default;
+
+			std::size_t Compress(const void* input, std::size_t inputSize, void* output, std::size_t outputCapacity);
+
+			bool Decompress(const void* input, std::size_t inputSize, void* output, std::size_t outputSize) const;
+
+			inline const ByteArray& GetDictionary() const;
+
+			void SetDictionary(const void* dictionary, std::size_t dictionarySize);
+
+			LZ4Compressor& operator=(const LZ4Compressor&) = default;
+			LZ4Compressor& operator=(LZ4Compressor&&) = default;
+
+			static inline std::size_t ComputeMaxCompressedSize(std::size_t inputSize);
+
+			static constexpr std::size_t MaxDictionarySize = 64 * 1024; //< Matches cannot reach further than 64 KiB back
+
+		private:
+			inline UInt8 GetByte(std::size_t position, const UInt8* input) const;
+
+			std::vector<UInt32> m_dictionaryTable; //< Hash table filled with the dictionary positions, copied at each compression
+			std::vector<UInt32> m_hashTable;
+			ByteArray m_dictionary;
+	};
+}
+
+#include <Nazara/Core/LZ4Compressor.inl>
+
+#endif // NAZARA_LZ4COMPRESSOR_HPP
@@ -0,0 +1,59 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Constructs a LZ4Compressor object sharing a dictionary with its peer
+	*
+	* \param dictionary Data both sides expect to see in packets (only its last 64 KiB are used)
+	* \param dictionarySize Size of the dictionary
+	*/
+
+	inline LZ4Compressor::LZ4Compressor(const void* dictionary, std::size_t dictionarySize) :
+	LZ4Compressor()
+	{
+		SetDictionary(dictionary, dictionarySize);
+	}
+
+	/*!
+	* \brief Gets the dictionary
+	* \return Dictionary used by both compression and decompression
+	*/
+
+	inline const ByteArray& LZ4Compressor::GetDictionary() const
+	{
+		return m_dictionary;
+	}
+
+	/*!
+	* \brief Computes the size a compressed block may take in the worst case
+	* \return Size of the output buffer which makes the compression always succeed
+	*
+	* \param inputSize Size of the data to compress
+	*/
+
+	inline std::size_t LZ4Compressor::ComputeMaxCompressedSize(std::size_t inputSize)
+	{
+		return inputSize + inputSize / 255 + 16;
+	}
+
+	/*!
+	* \brief Gets a byte from the dictionary followed by the input
+	* \return Byte at this position
+	*
+	* \param position Position, the input starting right after the dictionary
+	* \param input Data being compressed
+	*/
+
+	inline UInt8 LZ4Compressor::GetByte(std::size_t position, const UInt8* input) const
+	{
+		std::size_t dictionarySize = m_dictionary.GetSize();
+		return (position < dictionarySize) ? m_dictionary[position] : input[position - dictionarySize];
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
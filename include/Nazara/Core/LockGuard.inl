@@ -51,6 +51,7 @@ namespace Nz
 		NazaraAssert(!m_locked, "Mutex is already locked");
 
 		m_mutex.Lock();
+		m_locked = true;
 	}
 
 	/*!
@@ -64,7 +65,8 @@ namespace Nz
 	{
 		NazaraAssert(!m_locked, "Mutex is already locked");
 
-		return m_mutex.TryLock();
+		m_locked = m_mutex.TryLock();
+		return m_locked;
 	}
 
 	/*!
@@ -77,6 +79,7 @@ namespace Nz
 		NazaraAssert(m_locked, "Mutex is not locked");
 
 		m_mutex.Unlock();
+		m_locked = false;
 	}
 }
 
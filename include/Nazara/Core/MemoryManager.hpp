@@ -10,28 +10,65 @@
 #include <Nazara/Prerequesites.hpp>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 namespace Nz
 {
 	class NAZARA_CORE_API MemoryManager
 	{
 		public:
+			struct AllocationSite;
+			struct ModuleUsage;
+
 			static void* Allocate(std::size_t size, bool multi = false, const char* file = nullptr, unsigned int line = 0);
 
+			static void DumpAllocationSites(const char* filePath = nullptr);
+
 			static void EnableAllocationFilling(bool allocationFilling);
 			static void EnableAllocationLogging(bool logAllocations);
+			static void EnableAllocationSampling(bool sampleAllocations);
 
 			static void Free(void* pointer, bool multi = false);
 
 			static unsigned int GetAllocatedBlockCount();
 			static std::size_t GetAllocatedSize();
 			static unsigned int GetAllocationCount();
+			static unsigned int GetAllocationSamplingRate();
+			static std::vector<AllocationSite> GetAllocationSites();
+			static std::vector<ModuleUsage> GetModuleUsages();
 
 			static bool IsAllocationFillingEnabled();
 			static bool IsAllocationLoggingEnabled();
+			static bool IsAllocationSamplingEnabled();
 
 			static void NextFree(const char* file, unsigned int line);
 
+			static void ResetAllocationSites();
+
+			static void SetAllocationSamplingRate(unsigned int sampleRate);
+
+			struct AllocationSite
+			{
+				const char* file;
+				UInt32 stackHash;
+				UInt64 allocatedSize;
+				UInt64 allocationCount;
+				UInt64 liveAllocationCount;
+				UInt64 liveSize;
+				UInt64 sampleCount;
+				double allocationRate;
+				unsigned int line;
+			};
+
+			struct ModuleUsage
+			{
+				const char* name; //< Deduced from the path of the allocating files, "(unknown)" for allocations without position
+				UInt64 allocatedSize;
+				UInt64 allocationCount;
+				UInt64 liveAllocationCount;
+				UInt64 liveSize;
+			};
+
 		private:
 			MemoryManager();
 			~MemoryManager();
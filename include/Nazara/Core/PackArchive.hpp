@@ -0,0 +1,113 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PACKARCHIVE_HPP
+#define NAZARA_PACKARCHIVE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/String.hpp>
+#include <functional>
+#include <vector>
+
+namespace Nz
+{
+	// Read-only archive of many files, mapped in memory with its index
+	// Entries are sorted by the hash of their path, and aligned so uncompressed ones can be used in place
+	class NAZARA_CORE_API PackArchive
+	{
+		public:
+			struct Entry;
+			struct SourceEntry;
+
+			PackArchive();
+			PackArchive(const String& filePath);
+			PackArchive(const PackArchive&) = delete;
+			PackArchive(PackArchive&& archive) noexcept;
+			~PackArchive() = default;
+
+			void Close();
+
+			bool Extract(const Entry& entry, void* buffer) const;
+
+			const Entry* FindEntry(const String& entryPath) const;
+
+			inline const Entry& GetEntry(std::size_t index) const;
+			inline std::size_t GetEntryCount() const;
+			inline const void* GetEntryData(const Entry& entry) const;
+			inline String GetEntryPath(const Entry& entry) const;
+			inline String GetFilePath() const;
+
+			inline bool IsOpen() const;
+
+			bool Open(const String& filePath);
+
+			PackArchive& operator=(const PackArchive&) = delete;
+			PackArchive& operator=(PackArchive&& archive) noexcept;
+
+			static bool Build(const String& filePath, const std::vector<SourceEntry>& entries, UInt32 alignment = DefaultAlignment);
+			static bool BuildFromDirectory(const String& filePath, const String& directoryPath, bool compress = true, UInt32 alignment = DefaultAlignment);
+			static UInt64 ComputePathHash(const String& entryPath);
+			static String NormalizePath(const String& entryPath);
+
+			static constexpr UInt32 DefaultAlignment = 16;
+			static constexpr UInt32 FormatVersion = 1;
+
+			enum EntryFlags
+			{
+				EntryFlag_Compressed = 0x01 //< The data is a LZ4 block
+			};
+
+			// Laid out as in the archive, the index is used straight from the mapping
+			struct Entry
+			{
+				inline bool IsCompressed() const;
+
+				UInt64 pathHash;
+				UInt64 offset;     //< From the beginning of the archive, aligned
+				UInt64 size;       //< Once extracted
+				UInt64 storedSize; //< In the archive
+				UInt32 pathOffset; //< In the path table
+				UInt16 pathLength;
+				UInt16 flags;
+			};
+
+			struct SourceEntry
+			{
+				String path;        //< Path of the entry in the archive
+				String filePath;    //< File holding the data, if data is empty
+				ByteArray data;
+				bool compress = true; //< Compressed data is only kept if it is smaller
+			};
+
+		private:
+			using DataLoader = std::function<bool(std::size_t sourceIndex, ByteArray* data, bool* compress)>;
+
+			static bool WriteArchive(const String& filePath, std::vector<String> entryPaths, UInt32 alignment, const DataLoader& dataLoader);
+
+			struct Header
+			{
+				UInt32 magic;
+				UInt32 version;
+				UInt32 entryCount;
+				UInt32 alignment;
+				UInt64 indexOffset;
+				UInt64 pathTableOffset;
+				UInt64 pathTableSize;
+			};
+
+			File m_file;
+			const UInt8* m_data;
+			const Entry* m_entries;
+			const char* m_paths;
+			std::size_t m_entryCount;
+	};
+}
+
+#include <Nazara/Core/PackArchive.inl>
+
+#endif // NAZARA_PACKARCHIVE_HPP
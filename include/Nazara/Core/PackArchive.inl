@@ -0,0 +1,93 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets an entry of the archive
+	* \return Entry at the index, entries being sorted by the hash of their path
+	*
+	* \param index Index of the entry
+	*
+	* \remark Produces a NazaraAssert if index is out of range
+	*/
+
+	inline const PackArchive::Entry& PackArchive::GetEntry(std::size_t index) const
+	{
+		NazaraAssert(index < m_entryCount, "Entry index out of range");
+
+		return m_entries[index];
+	}
+
+	/*!
+	* \brief Gets the number of entries of the archive
+	* \return Number of entries, zero if the archive is not open
+	*/
+
+	inline std::size_t PackArchive::GetEntryCount() const
+	{
+		return m_entryCount;
+	}
+
+	/*!
+	* \brief Gets the data of an entry, as stored in the archive
+	* \return Pointer to the mapped data, valid until the archive is closed
+	*
+	* \param entry Entry of the archive
+	*
+	* \remark Compressed entries have to be extracted, the data of the others can be used in place
+	*/
+
+	inline const void* PackArchive::GetEntryData(const Entry& entry) const
+	{
+		return m_data + entry.offset;
+	}
+
+	/*!
+	* \brief Gets the path of an entry
+	* \return Path of the entry in the archive
+	*
+	* \param entry Entry of the archive
+	*/
+
+	inline String PackArchive::GetEntryPath(const Entry& entry) const
+	{
+		return String(m_paths + entry.pathOffset, entry.pathLength);
+	}
+
+	/*!
+	* \brief Gets the path of the archive
+	* \return Path of the archive file
+	*/
+
+	inline String PackArchive::GetFilePath() const
+	{
+		return m_file.GetPath();
+	}
+
+	/*!
+	* \brief Checks whether the archive is open
+	* \return true If it is the case
+	*/
+
+	inline bool PackArchive::IsOpen() const
+	{
+		return m_data != nullptr;
+	}
+
+	/*!
+	* \brief Checks whether the data of the entry is compressed
+	* \return true If it is the case
+	*/
+
+	inline bool PackArchive::Entry::IsCompressed() const
+	{
+		return (flags & EntryFlag_Compressed) != 0;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -11,22 +11,28 @@
 #include <Nazara/Core/Color.hpp>
 #include <Nazara/Core/String.hpp>
 #include <atomic>
-#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <vector>
 
 namespace Nz
 {
+	class FrozenParameterList;
+
 	class NAZARA_CORE_API ParameterList
 	{
 		public:
 			using Destructor = void (*)(void* value);
 
 			ParameterList() = default;
-			ParameterList(const ParameterList& list);
-			ParameterList(ParameterList&&) = default;
-			~ParameterList();
+			ParameterList(const ParameterList& list) = default;
+			ParameterList(ParameterList&&) noexcept = default;
+			~ParameterList() = default;
 
 			void Clear();
 
+			void ForEach(const std::function<void(const ParameterList& list, const String& name)>& callback) const;
+
 			bool GetBooleanParameter(const String& name, bool* value) const;
 			bool GetColorParameter(const String& name, Color* value) const;
 			bool GetFloatParameter(const String& name, float* value) const;
@@ -36,6 +42,8 @@ namespace Nz
 			bool GetStringParameter(const String& name, String* value) const;
 			bool GetUserdataParameter(const String& name, void** value) const;
 
+			std::size_t GetParameterCount() const;
+
 			bool HasParameter(const String& name) const;
 
 			void RemoveParameter(const String& name);
@@ -52,12 +60,24 @@ namespace Nz
 
 			String ToString() const;
 
-			ParameterList& operator=(const ParameterList& list);
-			ParameterList& operator=(ParameterList&&) = default;
+			ParameterList& operator=(const ParameterList& list) = default;
+			ParameterList& operator=(ParameterList&&) noexcept = default;
 
 		private:
+			struct InternedKey;
+
 			struct Parameter
 			{
+				Parameter(const InternedKey* Key);
+				Parameter(const Parameter& parameter);
+				Parameter(Parameter&& parameter) noexcept;
+				~Parameter();
+
+				void Destroy();
+
+				Parameter& operator=(const Parameter& parameter);
+				Parameter& operator=(Parameter&& parameter) noexcept;
+
 				struct UserdataValue
 				{
 					UserdataValue(Destructor Destructor, void* value) :
@@ -89,17 +109,58 @@ namespace Nz
 					UserdataValue* userdataVal;
 				};
 
+				const InternedKey* key;
 				Value value;
 			};
 
 			Parameter& CreateValue(const String& name);
-			void DestroyValue(Parameter& parameter);
+			std::size_t FindBucket(const String& name, std::size_t hash) const;
+			const Parameter* FindParameter(const String& name) const;
+			void Rehash(std::size_t bucketCount);
+
+			static const InternedKey* InternKey(const String& name);
+
+			// Open addressing (linear probing) over the dense parameter array, a bucket holds a parameter index + 1 (0 being an empty bucket)
+			std::vector<Parameter> m_parameters;
+			std::vector<UInt32> m_buckets;
+	};
 
-			using ParameterMap = std::unordered_map<String, Parameter>;
-			ParameterMap m_parameters;
+	class NAZARA_CORE_API FrozenParameterList
+	{
+		public:
+			FrozenParameterList();
+			explicit FrozenParameterList(const ParameterList& list);
+			explicit FrozenParameterList(ParameterList&& list);
+			FrozenParameterList(const FrozenParameterList&) = default;
+			FrozenParameterList(FrozenParameterList&&) noexcept = default;
+			~FrozenParameterList() = default;
+
+			inline bool GetBooleanParameter(const String& name, bool* value) const;
+			inline bool GetColorParameter(const String& name, Color* value) const;
+			inline bool GetFloatParameter(const String& name, float* value) const;
+			inline bool GetIntegerParameter(const String& name, int* value) const;
+			inline const ParameterList& GetList() const;
+			inline bool GetParameterType(const String& name, ParameterType* type) const;
+			inline bool GetPointerParameter(const String& name, void** value) const;
+			inline bool GetStringParameter(const String& name, String* value) const;
+			inline bool GetUserdataParameter(const String& name, void** value) const;
+
+			inline bool HasParameter(const String& name) const;
+
+			inline String ToString() const;
+
+			inline operator const ParameterList&() const;
+
+			FrozenParameterList& operator=(const FrozenParameterList&) = default;
+			FrozenParameterList& operator=(FrozenParameterList&&) noexcept = default;
+
+		private:
+			std::shared_ptr<const ParameterList> m_list;
 	};
 }
 
 std::ostream& operator<<(std::ostream& out, const Nz::ParameterList& parameterList);
 
+#include <Nazara/Core/ParameterList.inl>
+
 #endif // NAZARA_PARAMETERLIST_HPP
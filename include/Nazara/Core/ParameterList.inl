@@ -0,0 +1,136 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets a parameter as a boolean
+	* \return true if the parameter could be represented as a boolean
+	*
+	* \see ParameterList::GetBooleanParameter
+	*/
+	inline bool FrozenParameterList::GetBooleanParameter(const String& name, bool* value) const
+	{
+		return m_list->GetBooleanParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets a parameter as a color
+	* \return true if the parameter could be represented as a color
+	*
+	* \see ParameterList::GetColorParameter
+	*/
+	inline bool FrozenParameterList::GetColorParameter(const String& name, Color* value) const
+	{
+		return m_list->GetColorParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets a parameter as a float
+	* \return true if the parameter could be represented as a float
+	*
+	* \see ParameterList::GetFloatParameter
+	*/
+	inline bool FrozenParameterList::GetFloatParameter(const String& name, float* value) const
+	{
+		return m_list->GetFloatParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets a parameter as an integer
+	* \return true if the parameter could be represented as an integer
+	*
+	* \see ParameterList::GetIntegerParameter
+	*/
+	inline bool FrozenParameterList::GetIntegerParameter(const String& name, int* value) const
+	{
+		return m_list->GetIntegerParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets the shared parameter list
+	* \return Reference to the immutable list, valid as long as one copy of this object exists
+	*/
+	inline const ParameterList& FrozenParameterList::GetList() const
+	{
+		return *m_list;
+	}
+
+	/*!
+	* \brief Gets a parameter type
+	* \return true if the parameter is present, its type being written to type
+	*
+	* \see ParameterList::GetParameterType
+	*/
+	inline bool FrozenParameterList::GetParameterType(const String& name, ParameterType* type) const
+	{
+		return m_list->GetParameterType(name, type);
+	}
+
+	/*!
+	* \brief Gets a parameter as a pointer
+	* \return true if the parameter could be represented as a pointer
+	*
+	* \see ParameterList::GetPointerParameter
+	*/
+	inline bool FrozenParameterList::GetPointerParameter(const String& name, void** value) const
+	{
+		return m_list->GetPointerParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets a parameter as a string
+	* \return true if the parameter could be represented as a string
+	*
+	* \see ParameterList::GetStringParameter
+	*/
+	inline bool FrozenParameterList::GetStringParameter(const String& name, String* value) const
+	{
+		return m_list->GetStringParameter(name, value);
+	}
+
+	/*!
+	* \brief Gets a parameter as an userdata
+	* \return true if the parameter could be represented as a userdata
+	*
+	* \see ParameterList::GetUserdataParameter
+	*/
+	inline bool FrozenParameterList::GetUserdataParameter(const String& name, void** value) const
+	{
+		return m_list->GetUserdataParameter(name, value);
+	}
+
+	/*!
+	* \brief Checks whether the parameter list contains a parameter named `name`
+	* \return true if found
+	*
+	* \param name Name of the parameter
+	*/
+	inline bool FrozenParameterList::HasParameter(const String& name) const
+	{
+		return m_list->HasParameter(name);
+	}
+
+	/*!
+	* \brief Gives a string representation
+	* \return A string representation of the object: "ParameterList(Name: Type(value), ...)"
+	*/
+	inline String FrozenParameterList::ToString() const
+	{
+		return m_list->ToString();
+	}
+
+	/*!
+	* \brief Converts the object to the shared parameter list, to pass it to functions expecting a ParameterList
+	* \return Reference to the immutable list
+	*/
+	inline FrozenParameterList::operator const ParameterList&() const
+	{
+		return *m_list;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,86 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PROFILER_HPP
+#define NAZARA_PROFILER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/String.hpp>
+#include <vector>
+
+#if NAZARA_CORE_ENABLE_PROFILER
+	#define NazaraProfileZoneVariable(line) NazaraProfileZone ## line
+	#define NazaraProfileZoneName(line) NazaraProfileZoneVariable(line)
+	#define NazaraProfileZone(name) Nz::Profiler::Zone NazaraProfileZoneName(__LINE__)(name)
+#else
+	#define NazaraProfileZone(name)
+#endif
+
+namespace Nz
+{
+	class Stream;
+
+	class NAZARA_CORE_API Profiler
+	{
+		public:
+			class Zone;
+			struct ZoneStats;
+
+			Profiler() = delete;
+			~Profiler() = delete;
+
+			static void Clear();
+
+			static void Enable(bool enable = true);
+
+			static bool ExportChromeTrace(const String& filePath);
+			static bool ExportChromeTrace(Stream& stream);
+
+			static std::vector<ZoneStats> GetStats();
+
+			static bool IsEnabled();
+
+			static void SetThreadName(const String& name);
+
+			struct ZoneStats
+			{
+				const char* name;
+				UInt64 callCount;
+				UInt64 maxTime;
+				UInt64 selfTime;
+				UInt64 totalTime;
+			};
+
+		private:
+			struct ThreadData;
+			struct ThreadRegistry;
+
+			static ThreadRegistry& GetRegistry();
+			static ThreadData* GetThreadData();
+	};
+
+	class NAZARA_CORE_API Profiler::Zone
+	{
+		public:
+			Zone(const char* name);
+			Zone(const Zone&) = delete;
+			Zone(Zone&&) = delete;
+			~Zone();
+
+			Zone& operator=(const Zone&) = delete;
+			Zone& operator=(Zone&&) = delete;
+
+		private:
+			const char* m_name;
+			Profiler::ThreadData* m_thread;
+			Zone* m_parent;
+			UInt64 m_beginTime;
+			UInt64 m_childTime;
+	};
+}
+
+#endif // NAZARA_PROFILER_HPP
@@ -0,0 +1,79 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_READAHEADSTREAM_HPP
+#define NAZARA_READAHEADSTREAM_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API ReadAheadStream : public Stream
+	{
+		public:
+			ReadAheadStream(Stream& source, std::size_t blockSize = 64 * 1024, unsigned int blockCount = 4);
+			ReadAheadStream(const ReadAheadStream&) = delete;
+			ReadAheadStream(ReadAheadStream&&) = delete; ///TODO
+			~ReadAheadStream();
+
+			bool EndOfStream() const override;
+
+			inline unsigned int GetBlockCount() const;
+			inline std::size_t GetBlockSize() const;
+			UInt64 GetCursorPos() const override;
+			String GetDirectory() const override;
+			String GetPath() const override;
+			UInt64 GetSize() const override;
+			inline Stream& GetSource() const;
+
+			bool SetCursorPos(UInt64 offset) override;
+
+			ReadAheadStream& operator=(const ReadAheadStream&) = delete;
+			ReadAheadStream& operator=(ReadAheadStream&&) = delete; ///TODO
+
+		private:
+			struct Block
+			{
+				std::unique_ptr<UInt8[]> data;
+				UInt64 offset;
+				std::size_t size;
+			};
+
+			void DiscardBlocks();
+			const Block* FindBlock(UInt64 offset) const;
+			void FlushStream() override;
+			void IOThread();
+			std::size_t ReadBlock(void* buffer, std::size_t size) override;
+			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+
+			std::deque<Block> m_blocks;
+			std::vector<std::unique_ptr<UInt8[]>> m_freeBuffers;
+			mutable Mutex m_mutex;
+			ConditionVariable m_blockReady;
+			ConditionVariable m_blockRequested;
+			Stream& m_source;
+			Thread m_thread;
+			UInt64 m_cursorPos;
+			UInt64 m_nextReadPos;
+			UInt64 m_size;
+			std::size_t m_blockSize;
+			unsigned int m_blockCount;
+			unsigned int m_generation;
+			bool m_running;
+			bool m_sourceEnded;
+	};
+}
+
+#include <Nazara/Core/ReadAheadStream.inl>
+
+#endif // NAZARA_READAHEADSTREAM_HPP
@@ -0,0 +1,42 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the number of blocks prefetched ahead of the cursor
+	* \return Size of the read-ahead window, in blocks
+	*/
+
+	inline unsigned int ReadAheadStream::GetBlockCount() const
+	{
+		return m_blockCount;
+	}
+
+	/*!
+	* \brief Gets the size of the blocks read from the source
+	* \return Block size in bytes
+	*/
+
+	inline std::size_t ReadAheadStream::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	/*!
+	* \brief Gets the stream this stream reads from
+	* \return Source stream
+	*
+	* \remark The source must not be used while the ReadAheadStream is alive, as it is read from the I/O thread
+	*/
+
+	inline Stream& ReadAheadStream::GetSource() const
+	{
+		return m_source;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
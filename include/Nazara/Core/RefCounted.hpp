@@ -8,6 +8,7 @@
 #define NAZARA_REFCOUNTED_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <atomic>
 #include <unordered_map>
 
@@ -22,28 +23,40 @@ namespace Nz
 	class NAZARA_CORE_API RefCounted
 	{
 		public:
-			RefCounted(bool persistent = true);
+			RefCounted(bool persistent = true, RefCountingMode countingMode = RefCountingMode_Atomic);
 			RefCounted(const RefCounted&) = delete;
 			RefCounted(RefCounted&&) = default;
 			virtual ~RefCounted();
 
-			void AddReference() const;
+			inline void AddReference() const;
 
-			unsigned int GetReferenceCount() const;
+			inline RefCountingMode GetCountingMode() const;
+			inline unsigned int GetReferenceCount() const;
 
-			bool IsPersistent() const;
+			inline bool IsPersistent() const;
 
-			bool RemoveReference() const;
+			inline bool RemoveReference() const;
 
+			void SetCountingMode(RefCountingMode countingMode);
 			bool SetPersistent(bool persistent = true, bool checkReferenceCount = false);
 
 			RefCounted& operator=(const RefCounted&) = delete;
 			RefCounted& operator=(RefCounted&&) = default;
 
+			static void EnableDeferredRelease(bool enable = true);
+			static std::size_t FlushDeferredReleases();
+			static bool IsDeferredReleaseEnabled();
+
 		private:
+			bool OnLastReferenceRemoved() const;
+
 			std::atomic_bool m_persistent;
 			mutable std::atomic_uint m_referenceCount;
+			mutable bool m_releaseQueued;
+			bool m_singleThreaded;
 	};
 }
 
+#include <Nazara/Core/RefCounted.inl>
+
 #endif // NAZARA_RESOURCE_HPP
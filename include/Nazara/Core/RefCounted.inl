@@ -0,0 +1,87 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Adds a reference to the object
+	*/
+
+	inline void RefCounted::AddReference() const
+	{
+		if (m_singleThreaded)
+			m_referenceCount.store(m_referenceCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		else
+			m_referenceCount.fetch_add(1, std::memory_order_relaxed); // New references can only come from existing ones
+	}
+
+	/*!
+	* \brief Gets the way references are counted
+	* \return Counting mode of the object
+	*/
+
+	inline RefCountingMode RefCounted::GetCountingMode() const
+	{
+		return (m_singleThreaded) ? RefCountingMode_SingleThreaded : RefCountingMode_Atomic;
+	}
+
+	/*!
+	* \brief Gets the number of references to the object
+	* \return Number of references
+	*/
+
+	inline unsigned int RefCounted::GetReferenceCount() const
+	{
+		return m_referenceCount.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Checks whether the object is persistent
+	* \return true if object is not destroyed when no more referenced
+	*/
+
+	inline bool RefCounted::IsPersistent() const
+	{
+		return m_persistent;
+	}
+
+	/*!
+	* \brief Removes a reference to the object
+	* \return true if object is deleted because no more referenced
+	*
+	* \remark Produces a NazaraError if counter is already 0 with NAZARA_CORE_SAFE defined
+	* \remark If deferred release is enabled on this thread, the object is only queued for destruction and false is returned
+	*/
+
+	inline bool RefCounted::RemoveReference() const
+	{
+		#if NAZARA_CORE_SAFE
+		if (GetReferenceCount() == 0)
+		{
+			NazaraError("Impossible to remove reference (Ref. counter is already 0)");
+			return false;
+		}
+		#endif
+
+		unsigned int previousCount;
+		if (m_singleThreaded)
+		{
+			previousCount = m_referenceCount.load(std::memory_order_relaxed);
+			m_referenceCount.store(previousCount - 1, std::memory_order_relaxed);
+		}
+		else
+			previousCount = m_referenceCount.fetch_sub(1, std::memory_order_acq_rel); // Every use of the object happens before its destruction
+
+		if (previousCount == 1 && !m_persistent)
+			return OnLastReferenceRemoved();
+		else
+			return false;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
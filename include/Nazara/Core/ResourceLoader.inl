@@ -4,9 +4,11 @@
 
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/VirtualFileSystem.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -47,6 +49,11 @@ namespace Nz
 	*
 	* \remark Produces a NazaraError if resource is nullptr with NAZARA_CORE_SAFE defined
 	* \remark Produces a NazaraError if parameters are invalid with NAZARA_CORE_SAFE defined
+	* Loaders registered with a memory loader but no file loader are given a read-only mapping of the file,
+	* which is released when this function returns.
+	* Files found in a pack mounted in the VirtualFileSystem are given to the memory loaders, in place when they are not compressed,
+	* and files found in a mounted directory are loaded from there.
+	*
 	* \remark Produces a NazaraError if filePath has no extension
 	* \remark Produces a NazaraError if file count not be opened
 	* \remark Produces a NazaraWarning if loader failed
@@ -66,6 +73,45 @@ namespace Nz
 			return false;
 		}
 
+		if (VirtualFileSystem::HasMounts())
+		{
+			VirtualFileSystem::Location location;
+			if (VirtualFileSystem::Find(filePath, &location))
+			{
+				if (location.archive)
+				{
+					const PackArchive::Entry& entry = *location.entry;
+					if (entry.size == 0)
+					{
+						NazaraError("Failed to load file: \"" + filePath + "\" is empty");
+						return false;
+					}
+
+					bool loaded;
+					if (entry.IsCompressed())
+					{
+						ByteArray data(static_cast<std::size_t>(entry.size), 0);
+						if (!location.archive->Extract(entry, data.GetBuffer()))
+						{
+							NazaraError("Failed to load file: unable to extract \"" + filePath + '"');
+							return false;
+						}
+
+						loaded = LoadFromMemory(resource, data.GetConstBuffer(), data.GetSize(), parameters);
+					}
+					else
+						loaded = LoadFromMemory(resource, location.archive->GetEntryData(entry), static_cast<std::size_t>(entry.size), parameters);
+
+					if (loaded)
+						resource->SetFilePath(filePath);
+
+					return loaded;
+				}
+				else
+					path = location.filePath;
+			}
+		}
+
 		File file(path); // Open only if needed
 
 		bool found = false;
@@ -78,6 +124,7 @@ namespace Nz
 			StreamChecker checkFunc = std::get<1>(loader);
 			StreamLoader streamLoader = std::get<2>(loader);
 			FileLoader fileLoader = std::get<3>(loader);
+			MemoryLoader memoryLoader = std::get<4>(loader);
 
 			if (checkFunc && !file.IsOpen())
 			{
@@ -107,7 +154,7 @@ namespace Nz
 					found = true;
 				}
 
-				if (fileLoader(resource, filePath, parameters))
+				if (fileLoader(resource, path, parameters))
 				{
 					resource->SetFilePath(filePath);
 					return true;
@@ -123,9 +170,25 @@ namespace Nz
 				else if (recognized == Ternary_True)
 					found = true;
 
-				file.SetCursorPos(0);
+				const void* mappedData = nullptr;
+				if (memoryLoader)
+				{
+					// Let the loader parse the mapped pages directly, the stream is used if the file cannot be mapped
+					ErrorFlags flags(ErrorFlag_Silent);
+					mappedData = file.Map();
+				}
+
+				bool loaded;
+				if (mappedData)
+					loaded = memoryLoader(resource, mappedData, static_cast<std::size_t>(file.GetSize()), parameters);
+				else
+				{
+					file.SetCursorPos(0);
+
+					loaded = streamLoader(resource, file, parameters);
+				}
 
-				if (streamLoader(resource, file, parameters))
+				if (loaded)
 				{
 					resource->SetFilePath(filePath);
 					return true;
@@ -9,11 +9,21 @@
 
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/ResourceParameters.hpp>
+#include <Nazara/Core/ResourceRequest.hpp>
 #include <Nazara/Core/String.hpp>
 #include <unordered_map>
 
 namespace Nz
 {
+	struct ResourceManagerStats
+	{
+		UInt64 evictionCount = 0;
+		UInt64 hitCount = 0;
+		UInt64 missCount = 0;
+		std::size_t residentBytes = 0;
+		std::size_t residentCount = 0;
+	};
+
 	template<typename Type, typename Parameters>
 	class ResourceManager
 	{
@@ -26,19 +36,44 @@ namespace Nz
 			static void Clear();
 
 			static ObjectRef<Type> Get(const String& filePath);
+			static ResourceRequest<Type> GetAsync(const String& filePath);
 			static const Parameters& GetDefaultParameters();
+			static float GetHitRate();
+			static std::size_t GetMemoryBudget();
+			static const ResourceManagerStats& GetStats();
 
 			static void Purge();
 			static void Register(const String& filePath, ObjectRef<Type> resource);
+			static void ResetStats();
 			static void SetDefaultParameters(const Parameters& params);
+			static void SetMemoryBudget(std::size_t memoryBudget);
 			static void Unregister(const String& filePath);
 
 		private:
-			static bool Initialize();
-			static void Uninitialize();
+			struct ManagerCache
+			{
+				ResourceManagerStats stats;
+				std::size_t memoryBudget = 0;
+				UInt64 useCounter = 0;
+			};
 
-			using ManagerMap = std::unordered_map<String, ObjectRef<Type>>;
+			struct ManagerEntry
+			{
+				ObjectRef<Type> resource;
+				std::size_t memoryUsage;
+				UInt64 lastUse;
+			};
+
+			using ManagerLoads = std::unordered_map<String, typename ResourceRequest<Type>::StateRef>;
+			using ManagerMap = std::unordered_map<String, ManagerEntry>;
 			using ManagerParams = Parameters;
+
+			static void EnforceBudget();
+			static bool Initialize();
+			static void Insert(const String& absolutePath, ObjectRef<Type> resource);
+			static void ProcessLoads();
+			static void Touch(ManagerEntry& entry);
+			static void Uninitialize();
 	};
 }
 
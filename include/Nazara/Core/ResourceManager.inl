@@ -5,6 +5,9 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <algorithm>
+#include <vector>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -13,6 +16,14 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::ResourceManager
 	* \brief Core class that represents a resource manager
+	*
+	* Resources can be loaded synchronously with Get or on the TaskScheduler workers with GetAsync,
+	* a file requested while it is already loading is only loaded once.
+	*
+	* A memory budget can be set, resources only owned by the manager are then evicted in least recently used order
+	* whenever the memory used by the registered resources (as reported by Type::GetMemoryUsage) exceeds it.
+	*
+	* \remark Every function of the manager has to be called from the same thread
 	*/
 
 	/*!
@@ -21,7 +32,16 @@ namespace Nz
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Clear()
 	{
+		// Loading tasks use their state until they are done
+		for (auto& pair : Type::s_managerLoads)
+			TaskScheduler::Wait(pair.second->task);
+
+		Type::s_managerLoads.clear();
 		Type::s_managerMap.clear();
+
+		ResourceManagerStats& stats = Type::s_managerCache.stats;
+		stats.residentBytes = 0;
+		stats.residentCount = 0;
 	}
 
 	/*!
@@ -29,33 +49,124 @@ namespace Nz
 	* \return Reference to the object
 	*
 	* \param filePath Path to the asset that will be loaded
+	*
+	* \remark If the asset is being loaded asynchronously, waits for it instead of loading it again
 	*/
 	template<typename Type, typename Parameters>
 	ObjectRef<Type> ResourceManager<Type, Parameters>::Get(const String& filePath)
 	{
 		String absolutePath = File::AbsolutePath(filePath);
+
+		auto loadIt = Type::s_managerLoads.find(absolutePath);
+		if (loadIt != Type::s_managerLoads.end())
+		{
+			Type::s_managerCache.stats.hitCount++;
+
+			ObjectRef<Type> resource = ResourceRequest<Type>(loadIt->second).Wait();
+			ProcessLoads();
+
+			return resource;
+		}
+
 		auto it = Type::s_managerMap.find(absolutePath);
-		if (it == Type::s_managerMap.end())
+		if (it != Type::s_managerMap.end())
 		{
-			ObjectRef<Type> resource = Type::New();
-			if (!resource)
-			{
-				NazaraError("Failed to create resource");
-				return ObjectRef<Type>();
-			}
+			Type::s_managerCache.stats.hitCount++;
+			Touch(it->second);
 
-			if (!resource->LoadFromFile(absolutePath, GetDefaultParameters()))
-			{
-				NazaraError("Failed to load resource from file: " + absolutePath);
-				return ObjectRef<Type>();
-			}
+			return it->second.resource;
+		}
 
-			NazaraDebug("Loaded resource from file " + absolutePath);
+		Type::s_managerCache.stats.missCount++;
 
-			it = Type::s_managerMap.insert(std::make_pair(absolutePath, resource)).first;
+		ObjectRef<Type> resource = Type::New();
+		if (!resource)
+		{
+			NazaraError("Failed to create resource");
+			return ObjectRef<Type>();
+		}
+
+		if (!resource->LoadFromFile(absolutePath, GetDefaultParameters()))
+		{
+			NazaraError("Failed to load resource from file: " + absolutePath);
+			return ObjectRef<Type>();
 		}
 
-		return it->second;
+		NazaraDebug("Loaded resource from file " + absolutePath);
+
+		Insert(absolutePath, resource);
+
+		return resource;
+	}
+
+	/*!
+	* \brief Gets a request for the object, loaded from file on the TaskScheduler workers
+	* \return Request giving access to the object once loaded
+	*
+	* \param filePath Path to the asset that will be loaded
+	*
+	* If the asset is already loaded, the request is done right away. If it is being loaded, the request shares the load in flight.
+	* Loaded assets are registered in the manager by the next call to one of its functions.
+	*
+	* \remark The loading task is started right away, along with any other task pending in the TaskScheduler
+	* \remark Type has to support being loaded from another thread
+	*/
+	template<typename Type, typename Parameters>
+	ResourceRequest<Type> ResourceManager<Type, Parameters>::GetAsync(const String& filePath)
+	{
+		using State = typename ResourceRequest<Type>::State;
+
+		ProcessLoads();
+
+		String absolutePath = File::AbsolutePath(filePath);
+
+		auto loadIt = Type::s_managerLoads.find(absolutePath);
+		if (loadIt != Type::s_managerLoads.end())
+		{
+			Type::s_managerCache.stats.hitCount++;
+
+			return ResourceRequest<Type>(loadIt->second);
+		}
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it != Type::s_managerMap.end())
+		{
+			Type::s_managerCache.stats.hitCount++;
+			Touch(it->second);
+
+			typename ResourceRequest<Type>::StateRef state = new State(absolutePath, it->second.resource);
+			state->loaded = true;
+
+			return ResourceRequest<Type>(state);
+		}
+
+		Type::s_managerCache.stats.missCount++;
+
+		ObjectRef<Type> resource = Type::New();
+		if (!resource)
+		{
+			NazaraError("Failed to create resource");
+			return ResourceRequest<Type>();
+		}
+
+		typename ResourceRequest<Type>::StateRef state = new State(absolutePath, resource);
+
+		// The state is kept alive by the load list until the task is done
+		State* loadState = state;
+		Parameters parameters = GetDefaultParameters();
+		state->task = TaskScheduler::AddTask([loadState, parameters]()
+		{
+			if (loadState->resource->LoadFromFile(loadState->filePath, parameters))
+				loadState->loaded = true;
+			else
+				NazaraError("Failed to load resource from file: " + loadState->filePath);
+		});
+
+		TaskScheduler::Run();
+
+		Type::s_managerLoads.insert(std::make_pair(absolutePath, state));
+
+		return ResourceRequest<Type>(state);
 	}
 
 	/*!
@@ -68,19 +179,67 @@ namespace Nz
 		return Type::s_managerParameters;
 	}
 
+	/*!
+	* \brief Gets the proportion of requests which did not need to load their file
+	* \return Hit rate between 0 and 1, 0 if nothing was requested
+	*
+	* \see GetStats
+	*/
+	template<typename Type, typename Parameters>
+	float ResourceManager<Type, Parameters>::GetHitRate()
+	{
+		const ResourceManagerStats& stats = Type::s_managerCache.stats;
+
+		UInt64 requestCount = stats.hitCount + stats.missCount;
+		if (requestCount == 0)
+			return 0.f;
+
+		return static_cast<float>(stats.hitCount) / requestCount;
+	}
+
+	/*!
+	* \brief Gets the memory budget of the manager
+	* \return Budget in bytes, 0 if there is none
+	*/
+	template<typename Type, typename Parameters>
+	std::size_t ResourceManager<Type, Parameters>::GetMemoryBudget()
+	{
+		return Type::s_managerCache.memoryBudget;
+	}
+
+	/*!
+	* \brief Gets the statistics of the manager
+	* \return Number of hits, misses and evictions since the last reset, along with the resources currently registered
+	*
+	* \remark Resident bytes are updated when resources are registered or requested again, not when they are modified
+	*/
+	template<typename Type, typename Parameters>
+	const ResourceManagerStats& ResourceManager<Type, Parameters>::GetStats()
+	{
+		return Type::s_managerCache.stats;
+	}
+
 	/*!
 	* \brief Purges the resource manager from every asset whose it is the only owner
 	*/
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Purge()
 	{
+		ProcessLoads();
+
+		ResourceManagerStats& stats = Type::s_managerCache.stats;
+
 		auto it = Type::s_managerMap.begin();
 		while (it != Type::s_managerMap.end())
 		{
-			const ObjectRef<Type>& ref = it->second;
-			if (ref.GetReferenceCount() == 1) // Are we the only ones to own the resource ?
+			const ManagerEntry& entry = it->second;
+			if (entry.resource->GetReferenceCount() == 1) // Are we the only ones to own the resource ?
 			{
-				NazaraDebug("Purging resource from file " + ref->GetFilePath());
+				NazaraDebug("Purging resource from file " + entry.resource->GetFilePath());
+
+				stats.residentBytes -= entry.memoryUsage;
+				stats.residentCount--;
+
 				Type::s_managerMap.erase(it++); // Then we erase it
 			}
 			else
@@ -97,9 +256,23 @@ namespace Nz
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Register(const String& filePath, ObjectRef<Type> resource)
 	{
+		ProcessLoads();
+
 		String absolutePath = File::AbsolutePath(filePath);
 
-		Type::s_managerMap[absolutePath] = resource;
+		Insert(absolutePath, std::move(resource));
+	}
+
+	/*!
+	* \brief Resets the hit, miss and eviction counters
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::ResetStats()
+	{
+		ResourceManagerStats& stats = Type::s_managerCache.stats;
+		stats.evictionCount = 0;
+		stats.hitCount = 0;
+		stats.missCount = 0;
 	}
 
 	/*!
@@ -113,17 +286,87 @@ namespace Nz
 		Type::s_managerParameters = params;
 	}
 
+	/*!
+	* \brief Sets the memory budget of the manager
+	*
+	* \param memoryBudget Budget in bytes, 0 to disable it
+	*
+	* \remark Resources exceeding the new budget are evicted right away
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::SetMemoryBudget(std::size_t memoryBudget)
+	{
+		Type::s_managerCache.memoryBudget = memoryBudget;
+
+		EnforceBudget();
+	}
+
 	/*!
 	* \brief Unregisters the resource under the filePath
 	*
 	* \param filePath Path for the resource
+	*
+	* \remark If the resource is being loaded, the load goes on but the resource will not be registered
 	*/
 	template<typename Type, typename Parameters>
 	void ResourceManager<Type, Parameters>::Unregister(const String& filePath)
 	{
+		ProcessLoads();
+
 		String absolutePath = File::AbsolutePath(filePath);
 
-		Type::s_managerMap.erase(absolutePath);
+		auto loadIt = Type::s_managerLoads.find(absolutePath);
+		if (loadIt != Type::s_managerLoads.end())
+			loadIt->second->discarded = true;
+
+		auto it = Type::s_managerMap.find(absolutePath);
+		if (it != Type::s_managerMap.end())
+		{
+			ResourceManagerStats& stats = Type::s_managerCache.stats;
+			stats.residentBytes -= it->second.memoryUsage;
+			stats.residentCount--;
+
+			Type::s_managerMap.erase(it);
+		}
+	}
+
+	/*!
+	* \brief Evicts the least recently used resources only owned by the manager, until the memory budget is respected
+	*
+	* \remark Resources owned elsewhere are kept, the budget may thus stay exceeded
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::EnforceBudget()
+	{
+		ManagerCache& cache = Type::s_managerCache;
+		if (cache.memoryBudget == 0 || cache.stats.residentBytes <= cache.memoryBudget)
+			return;
+
+		std::vector<typename ManagerMap::iterator> candidates;
+		for (auto it = Type::s_managerMap.begin(); it != Type::s_managerMap.end(); ++it)
+		{
+			if (it->second.resource->GetReferenceCount() == 1)
+				candidates.push_back(it);
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const typename ManagerMap::iterator& lhs, const typename ManagerMap::iterator& rhs)
+		{
+			return lhs->second.lastUse < rhs->second.lastUse;
+		});
+
+		for (const auto& it : candidates)
+		{
+			if (cache.stats.residentBytes <= cache.memoryBudget)
+				break;
+
+			NazaraDebug("Evicting resource from file " + it->first);
+
+			cache.stats.evictionCount++;
+			cache.stats.residentBytes -= it->second.memoryUsage;
+			cache.stats.residentCount--;
+
+			Type::s_managerMap.erase(it);
+		}
 	}
 
 	/*!
@@ -136,6 +379,78 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Registers a resource, replacing the one previously registered under the same path
+	*
+	* \param absolutePath Absolute path for the resource
+	* \param resource Object to associate with
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::Insert(const String& absolutePath, ObjectRef<Type> resource)
+	{
+		ManagerCache& cache = Type::s_managerCache;
+
+		ManagerEntry& entry = Type::s_managerMap[absolutePath];
+		if (entry.resource)
+			cache.stats.residentBytes -= entry.memoryUsage;
+		else
+			cache.stats.residentCount++;
+
+		entry.resource = std::move(resource);
+		entry.memoryUsage = entry.resource->GetMemoryUsage();
+		entry.lastUse = ++cache.useCounter;
+
+		cache.stats.residentBytes += entry.memoryUsage;
+
+		EnforceBudget();
+	}
+
+	/*!
+	* \brief Registers the resources whose asynchronous load is over
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::ProcessLoads()
+	{
+		auto it = Type::s_managerLoads.begin();
+		while (it != Type::s_managerLoads.end())
+		{
+			typename ResourceRequest<Type>::State& state = *it->second;
+			if (!state.task.IsDone())
+			{
+				++it;
+				continue;
+			}
+
+			// A resource registered meanwhile takes precedence
+			if (state.loaded && !state.discarded && Type::s_managerMap.find(state.filePath) == Type::s_managerMap.end())
+			{
+				NazaraDebug("Loaded resource from file " + state.filePath);
+
+				Insert(state.filePath, state.resource);
+			}
+
+			Type::s_managerLoads.erase(it++);
+		}
+	}
+
+	/*!
+	* \brief Marks a registered resource as the most recently used one
+	*
+	* \param entry Entry of the resource
+	*/
+	template<typename Type, typename Parameters>
+	void ResourceManager<Type, Parameters>::Touch(ManagerEntry& entry)
+	{
+		ManagerCache& cache = Type::s_managerCache;
+
+		// The resource may have been modified since it was registered
+		std::size_t memoryUsage = entry.resource->GetMemoryUsage();
+		cache.stats.residentBytes = cache.stats.residentBytes - entry.memoryUsage + memoryUsage;
+
+		entry.memoryUsage = memoryUsage;
+		entry.lastUse = ++cache.useCounter;
+	}
+
 	/*!
 	* \brief Uninitialize the resource manager
 	*/
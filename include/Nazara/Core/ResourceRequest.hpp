@@ -0,0 +1,70 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_RESOURCEREQUEST_HPP
+#define NAZARA_RESOURCEREQUEST_HPP
+
+#include <Nazara/Core/ObjectRef.hpp>
+#include <Nazara/Core/RefCounted.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/TaskHandle.hpp>
+
+namespace Nz
+{
+	template<typename Type, typename Parameters> class ResourceManager;
+
+	template<typename Type>
+	class ResourceRequest
+	{
+		template<typename, typename> friend class ResourceManager;
+
+		public:
+			ResourceRequest() = default;
+			ResourceRequest(const ResourceRequest&) = default;
+			ResourceRequest(ResourceRequest&&) = default;
+			~ResourceRequest() = default;
+
+			const String& GetFilePath() const;
+			const TaskHandle& GetTaskHandle() const;
+
+			bool IsDone() const;
+			bool IsValid() const;
+
+			ObjectRef<Type> Wait() const;
+
+			ResourceRequest& operator=(const ResourceRequest&) = default;
+			ResourceRequest& operator=(ResourceRequest&&) = default;
+
+		private:
+			struct State : RefCounted
+			{
+				State(const String& path, ObjectRef<Type> loadedResource) :
+				RefCounted(false),
+				filePath(path),
+				resource(std::move(loadedResource)),
+				discarded(false),
+				loaded(false)
+				{
+				}
+
+				String filePath;
+				ObjectRef<Type> resource;
+				TaskHandle task;
+				bool discarded; // Unregistered while loading
+				bool loaded;    // Written by the loading task, read once it is done
+			};
+
+			using StateRef = ObjectRef<State>;
+
+			ResourceRequest(StateRef state);
+
+			StateRef m_state;
+	};
+}
+
+#include <Nazara/Core/ResourceRequest.inl>
+
+#endif // NAZARA_RESOURCEREQUEST_HPP
@@ -0,0 +1,97 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::ResourceRequest
+	* \brief Core class that represents a handle to a resource being loaded asynchronously by a ResourceManager
+	*
+	* Every request for the same file path made while it is loading shares the same load, and thus the same resource
+	*/
+
+	/*!
+	* \brief Constructs a ResourceRequest object from the state of the load
+	*
+	* \param state State shared by every request of the same file path
+	*/
+	template<typename Type>
+	ResourceRequest<Type>::ResourceRequest(StateRef state) :
+	m_state(std::move(state))
+	{
+	}
+
+	/*!
+	* \brief Gets the path of the requested file
+	* \return Absolute path of the file
+	*
+	* \remark The request must be valid
+	*/
+	template<typename Type>
+	const String& ResourceRequest<Type>::GetFilePath() const
+	{
+		NazaraAssert(m_state, "Invalid request");
+
+		return m_state->filePath;
+	}
+
+	/*!
+	* \brief Gets the handle of the loading task
+	* \return Task handle, which can be used as a dependency of other tasks
+	*
+	* \remark The handle is invalid if the resource was already loaded when it was requested
+	* \remark The request must be valid
+	*/
+	template<typename Type>
+	const TaskHandle& ResourceRequest<Type>::GetTaskHandle() const
+	{
+		NazaraAssert(m_state, "Invalid request");
+
+		return m_state->task;
+	}
+
+	/*!
+	* \brief Checks whether the load is over
+	* \return true If the resource is loaded or failed to load, or if the request is invalid
+	*/
+	template<typename Type>
+	bool ResourceRequest<Type>::IsDone() const
+	{
+		return !m_state || m_state->task.IsDone();
+	}
+
+	/*!
+	* \brief Checks whether the request references a load
+	* \return true If it is the case
+	*/
+	template<typename Type>
+	bool ResourceRequest<Type>::IsValid() const
+	{
+		return m_state.IsValid();
+	}
+
+	/*!
+	* \brief Waits for the load to be over
+	* \return Reference to the resource, or an invalid reference if the load failed
+	*
+	* The calling thread executes pending tasks while waiting
+	*/
+	template<typename Type>
+	ObjectRef<Type> ResourceRequest<Type>::Wait() const
+	{
+		if (!m_state)
+			return ObjectRef<Type>();
+
+		TaskScheduler::Wait(m_state->task);
+
+		return (m_state->loaded) ? m_state->resource : ObjectRef<Type>();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
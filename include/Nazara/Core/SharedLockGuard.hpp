@@ -0,0 +1,39 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SHAREDLOCKGUARD_HPP
+#define NAZARA_SHAREDLOCKGUARD_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	class SharedMutex;
+
+	class SharedLockGuard
+	{
+		public:
+			inline SharedLockGuard(SharedMutex& mutex, bool lock = true);
+			SharedLockGuard(const SharedLockGuard&) = delete;
+			SharedLockGuard(SharedLockGuard&&) = delete;
+			inline ~SharedLockGuard();
+
+			inline void Lock();
+			inline bool TryLock();
+			inline void Unlock();
+
+			SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+			SharedLockGuard& operator=(SharedLockGuard&&) = delete;
+
+		private:
+			SharedMutex& m_mutex;
+			bool m_locked;
+	};
+}
+
+#include <Nazara/Core/SharedLockGuard.inl>
+
+#endif // NAZARA_SHAREDLOCKGUARD_HPP
@@ -0,0 +1,85 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SharedLockGuard.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SharedLockGuard
+	* \brief Core class that represents a RAII-style owner of a SharedMutex in shared (reader) mode
+	*/
+
+	/*!
+	* \brief Constructs a SharedLockGuard object with a mutex
+	*
+	* \param mutex Mutex to lock
+	* \param lock Should the mutex be locked by the constructor
+	*/
+	inline SharedLockGuard::SharedLockGuard(SharedMutex& mutex, bool lock) :
+	m_mutex(mutex),
+	m_locked(false)
+	{
+		if (lock)
+		{
+			m_mutex.LockShared();
+			m_locked = true;
+		}
+	}
+
+	/*!
+	* \brief Destructs a SharedLockGuard object and unlocks the mutex if it was previously locked
+	*/
+	inline SharedLockGuard::~SharedLockGuard()
+	{
+		if (m_locked)
+			m_mutex.UnlockShared();
+	}
+
+	/*!
+	* \brief Locks the underlying mutex in shared mode
+	*
+	* \see SharedMutex::LockShared
+	*/
+	inline void SharedLockGuard::Lock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_mutex.LockShared();
+		m_locked = true;
+	}
+
+	/*!
+	* \brief Tries to lock the underlying mutex in shared mode
+	* \return true if the lock was acquired successfully
+	*
+	* \see SharedMutex::TryLockShared
+	*/
+	inline bool SharedLockGuard::TryLock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_locked = m_mutex.TryLockShared();
+		return m_locked;
+	}
+
+	/*!
+	* \brief Unlocks the underlying mutex
+	*
+	* \see SharedMutex::UnlockShared
+	*/
+	inline void SharedLockGuard::Unlock()
+	{
+		NazaraAssert(m_locked, "Mutex is not locked");
+
+		m_mutex.UnlockShared();
+		m_locked = false;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,41 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SHAREDMUTEX_HPP
+#define NAZARA_SHAREDMUTEX_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	class SharedMutexImpl;
+
+	class NAZARA_CORE_API SharedMutex
+	{
+		public:
+			SharedMutex();
+			SharedMutex(const SharedMutex&) = delete;
+			inline SharedMutex(SharedMutex&& mutex) noexcept;
+			~SharedMutex();
+
+			void Lock();
+			void LockShared();
+			bool TryLock();
+			bool TryLockShared();
+			void Unlock();
+			void UnlockShared();
+
+			SharedMutex& operator=(const SharedMutex&) = delete;
+			SharedMutex& operator=(SharedMutex&& mutex) noexcept;
+
+		private:
+			SharedMutexImpl* m_impl;
+	};
+}
+
+#include <Nazara/Core/SharedMutex.inl>
+
+#endif // NAZARA_SHAREDMUTEX_HPP
@@ -0,0 +1,25 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SharedMutex
+	*/
+
+	/*!
+	* \brief Constructs a SharedMutex object by moving another one
+	*/
+	inline SharedMutex::SharedMutex(SharedMutex&& mutex) noexcept :
+	m_impl(mutex.m_impl)
+	{
+		mutex.m_impl = nullptr;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
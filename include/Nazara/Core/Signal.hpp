@@ -8,7 +8,7 @@
 #define NAZARA_SIGNAL_HPP
 
 #include <functional>
-#include <memory>
+#include <type_traits>
 #include <vector>
 
 #define NazaraDetailSignal(Keyword, SignalName, ...) using SignalName ## Type = Nz::Signal<__VA_ARGS__>; \
@@ -34,12 +34,13 @@ namespace Nz
 			Signal();
 			Signal(const Signal&) = delete;
 			Signal(Signal&& signal);
-			~Signal() = default;
+			~Signal();
 
 			void Clear();
 
 			Connection Connect(const Callback& func);
 			Connection Connect(Callback&& func);
+			template<typename F> Connection Connect(F&& func);
 			template<typename O> Connection Connect(O& object, void (O::*method)(Args...));
 			template<typename O> Connection Connect(O* object, void (O::*method)(Args...));
 			template<typename O> Connection Connect(const O& object, void (O::*method)(Args...) const);
@@ -53,26 +54,42 @@ namespace Nz
 		private:
 			struct Slot;
 
-			using SlotPtr = std::shared_ptr<Slot>;
-			using SlotList = std::vector<SlotPtr>;
+			using SlotList = std::vector<Slot*>;
 			using SlotListIndex = typename SlotList::size_type;
 
+			// Callbacks up to this size (enough for an object pointer and a member function pointer) are stored inside the slot
+			using CallbackStorage = typename std::aligned_storage<4 * sizeof(void*)>::type;
+
 			struct Slot
 			{
-				Slot(Signal* me) :
-				signal(me)
-				{
-				}
+				Slot(Signal* me);
+				Slot(const Slot&) = delete;
+				~Slot();
+
+				template<typename F> void SetCallback(F&& func);
+				template<typename F> void SetCallback(F&& func, std::true_type fitsInStorage);
+				template<typename F> void SetCallback(F&& func, std::false_type fitsInStorage);
 
-				Callback callback;
+				Slot& operator=(const Slot&) = delete;
+
+				CallbackStorage storage;
+				Connection* connections;
 				Signal* signal;
+				Slot* nextReleased;
 				SlotListIndex index;
+				void (*destructor)(CallbackStorage& storage);
+				void (*invoker)(CallbackStorage& storage, Args... args);
 			};
 
-			void Disconnect(const SlotPtr& slot);
+			template<typename F> Connection ConnectCallback(F&& func);
+			void Disconnect(Slot* slot);
+			void ReleaseSlot(Slot* slot) const;
+			void ReleaseDeferredSlots() const;
 
 			SlotList m_slots;
+			mutable Slot* m_releasedSlots;
 			mutable SlotListIndex m_slotIterator;
+			mutable unsigned int m_emissionDepth;
 	};
 
 	template<typename... Args>
@@ -82,10 +99,10 @@ namespace Nz
 		friend BaseClass;
 
 		public:
-			Connection() = default;
-			Connection(const Connection& connection) = default;
-			Connection(Connection&& connection) = default;
-			~Connection() = default;
+			Connection();
+			Connection(const Connection& connection);
+			Connection(Connection&& connection);
+			~Connection();
 
 			template<typename... ConnectArgs>
 			void Connect(BaseClass& signal, ConnectArgs&&... args);
@@ -93,13 +110,19 @@ namespace Nz
 
 			bool IsConnected() const;
 
-			Connection& operator=(const Connection& connection) = default;
-			Connection& operator=(Connection&& connection) = default;
+			Connection& operator=(const Connection& connection);
+			Connection& operator=(Connection&& connection);
 
 		private:
-			Connection(const SlotPtr& slot);
+			Connection(Slot* slot);
+
+			void Link(Slot* slot);
+			void Unlink();
 
-			std::weak_ptr<Slot> m_ptr;
+			// Every connection to a slot is part of an intrusive list, so the slot can reset them when it dies
+			Connection* m_next;
+			Connection* m_previous;
+			Slot* m_slot;
 	};
 
 	template<typename... Args>
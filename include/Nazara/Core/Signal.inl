@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <new>
 #include <utility>
 #include <Nazara/Core/Debug.hpp>
 
@@ -12,6 +13,11 @@ namespace Nz
 	* \ingroup core
 	* \class Nz::Signal
 	* \brief Core class that represents a signal, a list of objects waiting for its message
+	*
+	* Each connection is a single allocation holding its callback (small callbacks, such as member functions, are stored inline).
+	* Emitting a signal walks a contiguous list of slots and does not allocate nor touch any reference count.
+	*
+	* \remark Connecting or disconnecting listeners while the signal is emitted is safe, disconnected slots are destroyed once the emission is over
 	*/
 
 	/*!
@@ -20,7 +26,9 @@ namespace Nz
 
 	template<typename... Args>
 	Signal<Args...>::Signal() :
-	m_slotIterator(0)
+	m_releasedSlots(nullptr),
+	m_slotIterator(0),
+	m_emissionDepth(0)
 	{
 	}
 
@@ -31,11 +39,26 @@ namespace Nz
 	*/
 
 	template<typename... Args>
-	Signal<Args...>::Signal(Signal&& signal)
+	Signal<Args...>::Signal(Signal&& signal) :
+	Signal()
 	{
 		operator=(std::move(signal));
 	}
 
+	/*!
+	* \brief Destructs the object and disconnects every listener
+	*/
+
+	template<typename... Args>
+	Signal<Args...>::~Signal()
+	{
+		Clear();
+
+		// In case a callback threw
+		m_emissionDepth = 0;
+		ReleaseDeferredSlots();
+	}
+
 	/*!
 	* \brief Clears the list of actions attached to the signal
 	*/
@@ -43,6 +66,9 @@ namespace Nz
 	template<typename... Args>
 	void Signal<Args...>::Clear()
 	{
+		for (Slot* slot : m_slots)
+			ReleaseSlot(slot);
+
 		m_slots.clear();
 		m_slotIterator = 0;
 	}
@@ -57,7 +83,9 @@ namespace Nz
 	template<typename... Args>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(const Callback& func)
 	{
-		return Connect(Callback(func));
+		NazaraAssert(func, "Invalid function");
+
+		return ConnectCallback(func);
 	}
 
 	/*!
@@ -72,20 +100,21 @@ namespace Nz
 	{
 		NazaraAssert(func, "Invalid function");
 
-		// Since we're incrementing the slot vector size, we need to replace our iterator at the end
-		// (Except when we are iterating on the signal)
-		bool resetIt = (m_slotIterator >= m_slots.size());
-
-		auto tempPtr = std::make_shared<Slot>(this);
-		tempPtr->callback = std::move(func);
-		tempPtr->index = m_slots.size();
-
-		m_slots.emplace_back(std::move(tempPtr));
+		return ConnectCallback(std::move(func));
+	}
 
-		if (resetIt)
-			m_slotIterator = m_slots.size(); //< Replace the iterator to the end
+	/*!
+	* \brief Connects a callable object (function, lambda, functor) to the signal
+	* \return Connection attached to the signal
+	*
+	* \param func Callable object, stored without going through a std::function
+	*/
 
-		return Connection(m_slots.back());
+	template<typename... Args>
+	template<typename F>
+	typename Signal<Args...>::Connection Signal<Args...>::Connect(F&& func)
+	{
+		return ConnectCallback(std::forward<F>(func));
 	}
 
 	/*!
@@ -100,7 +129,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(O& object, void (O::*method) (Args...))
 	{
-		return Connect([&object, method] (Args&&... args)
+		return ConnectCallback([&object, method] (Args&&... args)
 		{
 			return (object .* method) (std::forward<Args>(args)...);
 		});
@@ -118,7 +147,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(O* object, void (O::*method)(Args...))
 	{
-		return Connect([object, method] (Args&&... args)
+		return ConnectCallback([object, method] (Args&&... args)
 		{
 			return (object ->* method) (std::forward<Args>(args)...);
 		});
@@ -136,7 +165,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(const O& object, void (O::*method) (Args...) const)
 	{
-		return Connect([&object, method] (Args&&... args)
+		return ConnectCallback([&object, method] (Args&&... args)
 		{
 			return (object .* method) (std::forward<Args>(args)...);
 		});
@@ -154,7 +183,7 @@ namespace Nz
 	template<typename O>
 	typename Signal<Args...>::Connection Signal<Args...>::Connect(const O* object, void (O::*method)(Args...) const)
 	{
-		return Connect([object, method] (Args&&... args)
+		return ConnectCallback([object, method] (Args&&... args)
 		{
 			return (object ->* method) (std::forward<Args>(args)...);
 		});
@@ -169,8 +198,16 @@ namespace Nz
 	template<typename... Args>
 	void Signal<Args...>::operator()(Args... args) const
 	{
+		m_emissionDepth++;
+
 		for (m_slotIterator = 0; m_slotIterator < m_slots.size(); ++m_slotIterator)
-			m_slots[m_slotIterator]->callback(args...);
+		{
+			Slot* slot = m_slots[m_slotIterator];
+			slot->invoker(slot->storage, args...);
+		}
+
+		if (--m_emissionDepth == 0)
+			ReleaseDeferredSlots();
 	}
 
 	/*!
@@ -183,16 +220,51 @@ namespace Nz
 	template<typename... Args>
 	Signal<Args...>& Signal<Args...>::operator=(Signal&& signal)
 	{
+		if (this == &signal)
+			return *this;
+
+		Clear();
+
 		m_slots = std::move(signal.m_slots);
 		m_slotIterator = signal.m_slotIterator;
 
+		signal.m_slots.clear();
+		signal.m_slotIterator = 0;
+
 		// We need to update the signal pointer inside of each slot
-		for (SlotPtr& slot : m_slots)
+		for (Slot* slot : m_slots)
 			slot->signal = this;
 
 		return *this;
 	}
 
+	/*!
+	* \brief Creates a slot for a callback and appends it to the slot list
+	* \return Connection attached to the signal
+	*
+	* \param func Callable object to store in the slot
+	*/
+
+	template<typename... Args>
+	template<typename F>
+	typename Signal<Args...>::Connection Signal<Args...>::ConnectCallback(F&& func)
+	{
+		// Since we're incrementing the slot vector size, we need to replace our iterator at the end
+		// (Except when we are iterating on the signal)
+		bool resetIt = (m_slotIterator >= m_slots.size());
+
+		Slot* slot = new Slot(this);
+		slot->SetCallback(std::forward<F>(func));
+		slot->index = m_slots.size();
+
+		m_slots.push_back(slot);
+
+		if (resetIt)
+			m_slotIterator = m_slots.size(); //< Replace the iterator to the end
+
+		return Connection(slot);
+	}
+
 	/*!
 	* \brief Disconnects a listener from this signal
 	*
@@ -204,7 +276,7 @@ namespace Nz
 	*/
 
 	template<typename... Args>
-	void Signal<Args...>::Disconnect(const SlotPtr& slot)
+	void Signal<Args...>::Disconnect(Slot* slot)
 	{
 		NazaraAssert(slot, "Invalid slot pointer");
 		NazaraAssert(slot->index < m_slots.size(), "Invalid slot index");
@@ -217,20 +289,20 @@ namespace Nz
 		if (m_slotIterator >= (m_slots.size() - 1) || slot->index > m_slotIterator)
 		{
 			// Yes we can
-			SlotPtr& newSlot = m_slots[slot->index];
-			newSlot = std::move(m_slots.back());
+			Slot*& newSlot = m_slots[slot->index];
+			newSlot = m_slots.back();
 			newSlot->index = slot->index; //< Update the moved slot index before resizing (in case it's the last one)
 		}
 		else
 		{
 			// Nope, let's be tricky
-			SlotPtr& current = m_slots[m_slotIterator];
-			SlotPtr& newSlot = m_slots[slot->index];
+			Slot*& current = m_slots[m_slotIterator];
+			Slot*& newSlot = m_slots[slot->index];
 
-			newSlot = std::move(current);
+			newSlot = current;
 			newSlot->index = slot->index; //< Update the moved slot index
 
-			current = std::move(m_slots.back());
+			current = m_slots.back();
 			current->index = m_slotIterator; //< Update the moved slot index
 
 			--m_slotIterator;
@@ -238,6 +310,128 @@ namespace Nz
 
 		// Pop the last entry (from where we moved our slot)
 		m_slots.pop_back();
+
+		ReleaseSlot(slot);
+	}
+
+	/*!
+	* \brief Resets the connections of a slot and destroys it, or defers its destruction if the signal is being emitted
+	*
+	* \param slot Slot which was removed from the slot list
+	*/
+
+	template<typename... Args>
+	void Signal<Args...>::ReleaseSlot(Slot* slot) const
+	{
+		Connection* connection = slot->connections;
+		while (connection)
+		{
+			Connection* next = connection->m_next;
+
+			connection->m_next = nullptr;
+			connection->m_previous = nullptr;
+			connection->m_slot = nullptr;
+
+			connection = next;
+		}
+		slot->connections = nullptr;
+
+		if (m_emissionDepth > 0)
+		{
+			// The callback may be running right now
+			slot->nextReleased = m_releasedSlots;
+			m_releasedSlots = slot;
+		}
+		else
+			delete slot;
+	}
+
+	/*!
+	* \brief Destroys the slots disconnected during the emission
+	*/
+
+	template<typename... Args>
+	void Signal<Args...>::ReleaseDeferredSlots() const
+	{
+		while (m_releasedSlots)
+		{
+			Slot* next = m_releasedSlots->nextReleased;
+			delete m_releasedSlots;
+
+			m_releasedSlots = next;
+		}
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Slot::Slot(Signal* me) :
+	connections(nullptr),
+	signal(me),
+	nextReleased(nullptr),
+	destructor(nullptr),
+	invoker(nullptr)
+	{
+	}
+
+	template<typename... Args>
+	Signal<Args...>::Slot::~Slot()
+	{
+		if (destructor)
+			destructor(storage);
+	}
+
+	/*!
+	* \brief Stores a callable object in the slot, inline if it is small enough
+	*
+	* \param func Callable object
+	*/
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::Slot::SetCallback(F&& func)
+	{
+		using Functor = typename std::decay<F>::type;
+
+		NazaraAssert(!destructor, "Slot already has a callback");
+
+		SetCallback(std::forward<F>(func), std::integral_constant<bool, sizeof(Functor) <= sizeof(CallbackStorage) && alignof(Functor) <= alignof(CallbackStorage)>());
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::Slot::SetCallback(F&& func, std::true_type /*fitsInStorage*/)
+	{
+		using Functor = typename std::decay<F>::type;
+
+		new (&storage) Functor(std::forward<F>(func));
+
+		destructor = [] (CallbackStorage& callbackStorage)
+		{
+			reinterpret_cast<Functor*>(&callbackStorage)->~Functor();
+		};
+
+		invoker = [] (CallbackStorage& callbackStorage, Args... args)
+		{
+			(*reinterpret_cast<Functor*>(&callbackStorage))(std::forward<Args>(args)...);
+		};
+	}
+
+	template<typename... Args>
+	template<typename F>
+	void Signal<Args...>::Slot::SetCallback(F&& func, std::false_type /*fitsInStorage*/)
+	{
+		using Functor = typename std::decay<F>::type;
+
+		new (&storage) Functor*(new Functor(std::forward<F>(func)));
+
+		destructor = [] (CallbackStorage& callbackStorage)
+		{
+			delete *reinterpret_cast<Functor**>(&callbackStorage);
+		};
+
+		invoker = [] (CallbackStorage& callbackStorage, Args... args)
+		{
+			(**reinterpret_cast<Functor**>(&callbackStorage))(std::forward<Args>(args)...);
+		};
 	}
 
 	/*!
@@ -245,6 +439,45 @@ namespace Nz
 	* \brief Core class that represents a connection attached to a signal
 	*/
 
+	/*!
+	* \brief Constructs a Signal::Connection object by default, not connected to any signal
+	*/
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection() :
+	m_next(nullptr),
+	m_previous(nullptr),
+	m_slot(nullptr)
+	{
+	}
+
+	/*!
+	* \brief Constructs a Signal::Connection object referencing the same slot as another one
+	*
+	* \param connection Connection to copy
+	*/
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection(const Connection& connection) :
+	Connection()
+	{
+		Link(connection.m_slot);
+	}
+
+	/*!
+	* \brief Constructs a Signal::Connection object by move semantic
+	*
+	* \param connection Connection to move into this
+	*/
+
+	template<typename... Args>
+	Signal<Args...>::Connection::Connection(Connection&& connection) :
+	Connection()
+	{
+		Link(connection.m_slot);
+		connection.Unlink();
+	}
+
 	/*!
 	* \brief Constructs a Signal::Connection object with a slot
 	*
@@ -252,9 +485,20 @@ namespace Nz
 	*/
 
 	template<typename... Args>
-	Signal<Args...>::Connection::Connection(const SlotPtr& slot) :
-	m_ptr(slot)
+	Signal<Args...>::Connection::Connection(Slot* slot) :
+	Connection()
+	{
+		Link(slot);
+	}
+
+	/*!
+	* \brief Destructs the object, without disconnecting it
+	*/
+
+	template<typename... Args>
+	Signal<Args...>::Connection::~Connection()
 	{
+		Unlink();
 	}
 
 	/*!
@@ -278,8 +522,8 @@ namespace Nz
 	template<typename... Args>
 	void Signal<Args...>::Connection::Disconnect()
 	{
-		if (SlotPtr ptr = m_ptr.lock())
-			ptr->signal->Disconnect(ptr);
+		if (m_slot)
+			m_slot->signal->Disconnect(m_slot);
 	}
 
 	/*!
@@ -290,7 +534,91 @@ namespace Nz
 	template<typename... Args>
 	bool Signal<Args...>::Connection::IsConnected() const
 	{
-		return !m_ptr.expired();
+		return m_slot != nullptr;
+	}
+
+	/*!
+	* \brief Makes this connection reference the same slot as another one
+	* \return A reference to this
+	*
+	* \param connection Connection to copy
+	*/
+
+	template<typename... Args>
+	typename Signal<Args...>::Connection& Signal<Args...>::Connection::operator=(const Connection& connection)
+	{
+		if (this != &connection)
+		{
+			Unlink();
+			Link(connection.m_slot);
+		}
+
+		return *this;
+	}
+
+	/*!
+	* \brief Moves the connection into this
+	* \return A reference to this
+	*
+	* \param connection Connection to move into this
+	*/
+
+	template<typename... Args>
+	typename Signal<Args...>::Connection& Signal<Args...>::Connection::operator=(Connection&& connection)
+	{
+		if (this != &connection)
+		{
+			Unlink();
+			Link(connection.m_slot);
+			connection.Unlink();
+		}
+
+		return *this;
+	}
+
+	/*!
+	* \brief Inserts the connection in the connection list of a slot
+	*
+	* \param slot Slot to reference, may be nullptr
+	*
+	* \remark The connection must not be linked
+	*/
+
+	template<typename... Args>
+	void Signal<Args...>::Connection::Link(Slot* slot)
+	{
+		m_slot = slot;
+		if (slot)
+		{
+			m_next = slot->connections;
+			if (m_next)
+				m_next->m_previous = this;
+
+			slot->connections = this;
+		}
+	}
+
+	/*!
+	* \brief Removes the connection from the connection list of its slot
+	*/
+
+	template<typename... Args>
+	void Signal<Args...>::Connection::Unlink()
+	{
+		if (!m_slot)
+			return;
+
+		if (m_previous)
+			m_previous->m_next = m_next;
+		else
+			m_slot->connections = m_next;
+
+		if (m_next)
+			m_next->m_previous = m_previous;
+
+		m_next = nullptr;
+		m_previous = nullptr;
+		m_slot = nullptr;
 	}
 
 	/*!
@@ -0,0 +1,39 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SPINLOCKGUARD_HPP
+#define NAZARA_SPINLOCKGUARD_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	class SpinMutex;
+
+	class SpinLockGuard
+	{
+		public:
+			inline SpinLockGuard(SpinMutex& mutex, bool lock = true);
+			SpinLockGuard(const SpinLockGuard&) = delete;
+			SpinLockGuard(SpinLockGuard&&) = delete;
+			inline ~SpinLockGuard();
+
+			inline void Lock();
+			inline bool TryLock();
+			inline void Unlock();
+
+			SpinLockGuard& operator=(const SpinLockGuard&) = delete;
+			SpinLockGuard& operator=(SpinLockGuard&&) = delete;
+
+		private:
+			SpinMutex& m_mutex;
+			bool m_locked;
+	};
+}
+
+#include <Nazara/Core/SpinLockGuard.inl>
+
+#endif // NAZARA_SPINLOCKGUARD_HPP
@@ -0,0 +1,85 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SpinLockGuard.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/SpinMutex.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SpinLockGuard
+	* \brief Core class that represents a SpinMutex wrapper that provides a convenient RAII-style mechanism
+	*/
+
+	/*!
+	* \brief Constructs a SpinLockGuard object with a mutex
+	*
+	* \param mutex Mutex to lock
+	* \param lock Should the mutex be locked by the constructor
+	*/
+	inline SpinLockGuard::SpinLockGuard(SpinMutex& mutex, bool lock) :
+	m_mutex(mutex),
+	m_locked(false)
+	{
+		if (lock)
+		{
+			m_mutex.Lock();
+			m_locked = true;
+		}
+	}
+
+	/*!
+	* \brief Destructs a SpinLockGuard object and unlocks the mutex if it was previously locked
+	*/
+	inline SpinLockGuard::~SpinLockGuard()
+	{
+		if (m_locked)
+			m_mutex.Unlock();
+	}
+
+	/*!
+	* \brief Locks the underlying mutex
+	*
+	* \see SpinMutex::Lock
+	*/
+	inline void SpinLockGuard::Lock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_mutex.Lock();
+		m_locked = true;
+	}
+
+	/*!
+	* \brief Tries to lock the underlying mutex
+	* \return true if the lock was acquired successfully
+	*
+	* \see SpinMutex::TryLock
+	*/
+	inline bool SpinLockGuard::TryLock()
+	{
+		NazaraAssert(!m_locked, "Mutex is already locked");
+
+		m_locked = m_mutex.TryLock();
+		return m_locked;
+	}
+
+	/*!
+	* \brief Unlocks the underlying mutex
+	*
+	* \see SpinMutex::Unlock
+	*/
+	inline void SpinLockGuard::Unlock()
+	{
+		NazaraAssert(m_locked, "Mutex is not locked");
+
+		m_mutex.Unlock();
+		m_locked = false;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
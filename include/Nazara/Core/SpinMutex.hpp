@@ -0,0 +1,54 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SPINMUTEX_HPP
+#define NAZARA_SPINMUTEX_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <atomic>
+
+namespace Nz
+{
+	class NAZARA_CORE_API SpinMutex
+	{
+		public:
+			SpinMutex();
+			SpinMutex(const SpinMutex&) = delete;
+			SpinMutex(SpinMutex&&) = delete;
+			~SpinMutex() = default;
+
+			inline void Lock();
+			inline bool TryLock();
+			inline void Unlock();
+
+			SpinMutex& operator=(const SpinMutex&) = delete;
+			SpinMutex& operator=(SpinMutex&&) = delete;
+
+			static constexpr int MaxSpinCount = 100;
+
+		private:
+			enum State
+			{
+				State_Unlocked,
+				State_Locked,
+				State_LockedWithWaiters
+			};
+
+			void LockSlow();
+			void WakeWaiter();
+
+			std::atomic_int m_state;
+			std::atomic_int m_averageSpinCount;
+			ConditionVariable m_parkCondition;
+			Mutex m_parkMutex;
+	};
+}
+
+#include <Nazara/Core/SpinMutex.inl>
+
+#endif // NAZARA_SPINMUTEX_HPP
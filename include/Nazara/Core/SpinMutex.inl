@@ -0,0 +1,43 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SpinMutex.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Locks the mutex
+	*
+	* Spins for a while if the mutex is owned by another thread, then blocks until it is released
+	*/
+	inline void SpinMutex::Lock()
+	{
+		if (!TryLock())
+			LockSlow();
+	}
+
+	/*!
+	* \brief Tries to lock the mutex
+	* \return true if the lock was acquired successfully
+	*/
+	inline bool SpinMutex::TryLock()
+	{
+		int expected = State_Unlocked;
+		return m_state.compare_exchange_strong(expected, State_Locked, std::memory_order_acquire, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Unlocks the mutex
+	*
+	* Wakes up one of the blocked threads, if any
+	*/
+	inline void SpinMutex::Unlock()
+	{
+		if (m_state.exchange(State_Unlocked, std::memory_order_release) == State_LockedWithWaiters)
+			WakeWaiter();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SPSCQUEUE_HPP
+#define NAZARA_SPSCQUEUE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <atomic>
+#include <memory>
+
+namespace Nz
+{
+	// Bounded lock-free queue between exactly one producer thread and one consumer thread
+	template<typename T>
+	class SpscQueue
+	{
+		public:
+			SpscQueue(std::size_t capacity);
+			SpscQueue(const SpscQueue&) = delete;
+			SpscQueue(SpscQueue&&) = delete;
+			~SpscQueue() = default;
+
+			void Clear();
+
+			std::size_t GetCapacity() const;
+			std::size_t GetSize() const;
+
+			bool IsEmpty() const;
+
+			bool Pop(T* value);
+			bool Push(const T& value);
+			bool Push(T&& value);
+
+			SpscQueue& operator=(const SpscQueue&) = delete;
+			SpscQueue& operator=(SpscQueue&&) = delete;
+
+		private:
+			template<typename U> bool PushValue(U&& value);
+
+			std::unique_ptr<T[]> m_values;
+			std::size_t m_mask;
+			// Padding keeps each side's indices on its own cache line without requiring an over-aligned allocation
+			char m_padding0[64];
+			std::atomic<std::size_t> m_readIndex; //< Written by the consumer
+			std::size_t m_cachedWriteIndex;       //< Consumer copy, refreshed when the queue looks empty
+			char m_padding1[64];
+			std::atomic<std::size_t> m_writeIndex; //< Written by the producer
+			std::size_t m_cachedReadIndex;         //< Producer copy, refreshed when the queue looks full
+			char m_padding2[64];
+	};
+}
+
+#include <Nazara/Core/SpscQueue.inl>
+
+#endif // NAZARA_SPSCQUEUE_HPP
@@ -0,0 +1,155 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SpscQueue
+	* \brief Core class that represents a bounded single-producer single-consumer queue
+	*
+	* Push may only be called by one thread and Pop by another one, neither of them ever blocks
+	*
+	* \remark T must be default constructible, values are move-assigned into preallocated slots
+	*/
+
+	/*!
+	* \brief Constructs a SpscQueue object
+	*
+	* \param capacity Maximum number of values in the queue, rounded up to a power of two
+	*/
+	template<typename T>
+	SpscQueue<T>::SpscQueue(std::size_t capacity) :
+	m_readIndex(0),
+	m_cachedWriteIndex(0),
+	m_writeIndex(0),
+	m_cachedReadIndex(0)
+	{
+		NazaraAssert(capacity > 0, "Capacity must be over zero");
+
+		capacity = GetNearestPowerOfTwo(capacity);
+
+		m_mask = capacity - 1;
+		m_values.reset(new T[capacity]);
+	}
+
+	/*!
+	* \brief Discards every value of the queue
+	*
+	* \remark Must be called by the consumer
+	*/
+	template<typename T>
+	void SpscQueue<T>::Clear()
+	{
+		m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+		m_readIndex.store(m_cachedWriteIndex, std::memory_order_release);
+	}
+
+	/*!
+	* \brief Gets the maximum number of values in the queue
+	*/
+	template<typename T>
+	std::size_t SpscQueue<T>::GetCapacity() const
+	{
+		return m_mask + 1;
+	}
+
+	/*!
+	* \brief Gets the number of values in the queue
+	* \return Approximate count if the other thread is using the queue
+	*/
+	template<typename T>
+	std::size_t SpscQueue<T>::GetSize() const
+	{
+		return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_acquire);
+	}
+
+	/*!
+	* \brief Checks whether the queue is empty
+	*/
+	template<typename T>
+	bool SpscQueue<T>::IsEmpty() const
+	{
+		return GetSize() == 0;
+	}
+
+	/*!
+	* \brief Takes the oldest value of the queue
+	* \return true if a value was taken, false if the queue is empty
+	*
+	* \param value Value to fill, may be null to discard it
+	*
+	* \remark Must be called by the consumer
+	*/
+	template<typename T>
+	bool SpscQueue<T>::Pop(T* value)
+	{
+		std::size_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+		if (readIndex == m_cachedWriteIndex)
+		{
+			m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+			if (readIndex == m_cachedWriteIndex)
+				return false;
+		}
+
+		if (value)
+			*value = std::move(m_values[readIndex & m_mask]);
+
+		m_readIndex.store(readIndex + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*!
+	* \brief Adds a value to the queue
+	* \return true if the value was added, false if the queue is full
+	*
+	* \param value Value to copy
+	*
+	* \remark Must be called by the producer
+	*/
+	template<typename T>
+	bool SpscQueue<T>::Push(const T& value)
+	{
+		return PushValue(value);
+	}
+
+	/*!
+	* \brief Adds a value to the queue
+	* \return true if the value was added, false if the queue is full (the value is then left untouched)
+	*
+	* \param value Value to move
+	*
+	* \remark Must be called by the producer
+	*/
+	template<typename T>
+	bool SpscQueue<T>::Push(T&& value)
+	{
+		return PushValue(std::move(value));
+	}
+
+	template<typename T>
+	template<typename U>
+	bool SpscQueue<T>::PushValue(U&& value)
+	{
+		std::size_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+		if (writeIndex - m_cachedReadIndex > m_mask)
+		{
+			m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+			if (writeIndex - m_cachedReadIndex > m_mask)
+				return false;
+		}
+
+		m_values[writeIndex & m_mask] = std::forward<U>(value);
+
+		m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+		return true;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
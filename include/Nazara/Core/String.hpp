@@ -18,6 +18,8 @@
 
 namespace Nz
 {
+	class StringView;
+
 	class NAZARA_CORE_API String
 	{
 		public:
@@ -39,6 +41,7 @@ namespace Nz
 			String(const char* string);
 			String(const char* string, std::size_t length);
 			String(const std::string& string);
+			explicit String(const StringView& string);
 			String(const String& string) = default;
 			String(String&& string) noexcept = default;
 			~String() = default;
@@ -100,6 +103,7 @@ namespace Nz
 			bool IsEmpty() const;
 			bool IsNull() const;
 			bool IsNumber(UInt8 radix = 10, UInt32 flags = CaseInsensitive) const;
+			bool IsValidUtf8() const;
 
 			bool Match(const char* pattern) const;
 			bool Match(const String& pattern) const;
@@ -133,6 +137,7 @@ namespace Nz
 			String& Set(const char* string);
 			String& Set(const char* string, std::size_t length);
 			String& Set(const std::string& string);
+			String& Set(const StringView& string);
 			String& Set(const String& string);
 			String& Set(String&& string) noexcept;
 
@@ -143,8 +148,11 @@ namespace Nz
 			unsigned int Split(std::vector<String>& result, const char* separation, std::intmax_t start = 0, UInt32 flags = None) const;
 			unsigned int Split(std::vector<String>& result, const char* separation, std::size_t length, std::intmax_t start = 0, UInt32 flags = None) const;
 			unsigned int Split(std::vector<String>& result, const String& separation, std::intmax_t start = 0, UInt32 flags = None) const;
+			unsigned int Split(std::vector<StringView>& result, char separation = ' ', std::intmax_t start = 0, UInt32 flags = None) const;
+			unsigned int Split(std::vector<StringView>& result, const StringView& separation, std::intmax_t start = 0, UInt32 flags = None) const;
 			unsigned int SplitAny(std::vector<String>& result, const char* separations, std::intmax_t start = 0, UInt32 flags = None) const;
 			unsigned int SplitAny(std::vector<String>& result, const String& separations, std::intmax_t start = 0, UInt32 flags = None) const;
+			unsigned int SplitAny(std::vector<StringView>& result, const StringView& separations, std::intmax_t start = 0, UInt32 flags = None) const;
 
 			bool StartsWith(char character, UInt32 flags = None) const;
 			bool StartsWith(const char* string, UInt32 flags = None) const;
@@ -312,13 +320,31 @@ namespace Nz
 
 			struct SharedString
 			{
+				struct BufferDeleter
+				{
+					inline BufferDeleter(bool isHeapAllocated = true);
+
+					inline void operator()(char* buffer) const;
+
+					bool heapAllocated;
+				};
+
+				// Strings shorter than this are stored in the same allocation as their shared state
+				static constexpr std::size_t SmallStringCapacity = 23;
+
 				inline SharedString();
 				inline SharedString(std::size_t strSize);
 				inline SharedString(std::size_t strSize, std::size_t strCapacity);
+				SharedString(const SharedString&) = delete;
+				SharedString(SharedString&&) = delete;
+
+				SharedString& operator=(const SharedString&) = delete;
+				SharedString& operator=(SharedString&&) = delete;
 
 				std::size_t capacity;
 				std::size_t size;
-				std::unique_ptr<char[]> string;
+				std::unique_ptr<char[], BufferDeleter> string;
+				char smallBuffer[SmallStringCapacity + 1];
 			};
 	};
 
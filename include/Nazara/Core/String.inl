@@ -34,7 +34,8 @@ namespace Nz
 
 	inline String::SharedString::SharedString() : // Special case: empty string
 	capacity(0),
-	size(0)
+	size(0),
+	string(nullptr, BufferDeleter())
 	{
 	}
 
@@ -45,11 +46,8 @@ namespace Nz
 	*/
 
 	inline String::SharedString::SharedString(std::size_t strSize) :
-	capacity(strSize), 
-	size(strSize),
-	string(new char[strSize + 1])
+	SharedString(strSize, strSize)
 	{
-		string[strSize] = '\0';
 	}
 
 	/*!
@@ -57,16 +55,43 @@ namespace Nz
 	*
 	* \param strSize Number of characters in the string
 	* \param strCapacity Capacity in characters in the string
+	*
+	* \remark If the capacity fits in the small buffer, no memory is allocated besides the shared string itself, and the capacity is raised to the small buffer one
 	*/
 
 	inline String::SharedString::SharedString(std::size_t strSize, std::size_t strCapacity) :
-	capacity(strCapacity),
+	capacity((strCapacity > SmallStringCapacity) ? strCapacity : SmallStringCapacity),
 	size(strSize),
-	string(new char[strCapacity + 1])
+	string((strCapacity > SmallStringCapacity) ? new char[strCapacity + 1] : smallBuffer, BufferDeleter(strCapacity > SmallStringCapacity))
 	{
 		string[strSize] = '\0';
 	}
 
+	/*!
+	* \brief Constructs a BufferDeleter object
+	*
+	* \param isHeapAllocated Whether the buffer to release was allocated on the heap
+	*/
+
+	inline String::SharedString::BufferDeleter::BufferDeleter(bool isHeapAllocated) :
+	heapAllocated(isHeapAllocated)
+	{
+	}
+
+	/*!
+	* \brief Releases the buffer of a shared string
+	*
+	* \param buffer Buffer to release
+	*
+	* \remark Small buffers are part of the shared string and are not released
+	*/
+
+	inline void String::SharedString::BufferDeleter::operator()(char* buffer) const
+	{
+		if (heapAllocated)
+			delete[] buffer;
+	}
+
 	/*!
 	* \brief Appends the string to the hash
 	* \return true if hash is successful
@@ -0,0 +1,100 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STRINGVIEW_HPP
+#define NAZARA_STRINGVIEW_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <string>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API StringView
+	{
+		public:
+			inline StringView();
+			inline StringView(const char* string);
+			inline StringView(const char* string, std::size_t length);
+			inline StringView(const std::string& string);
+			inline StringView(const String& string);
+			StringView(const StringView&) = default;
+			~StringView() = default;
+
+			bool EndsWith(char character, UInt32 flags = String::None) const;
+			bool EndsWith(StringView string, UInt32 flags = String::None) const;
+			bool Equals(StringView string, UInt32 flags = String::None) const;
+
+			std::size_t Find(char character, std::intmax_t start = 0, UInt32 flags = String::None) const;
+			std::size_t Find(StringView string, std::intmax_t start = 0, UInt32 flags = String::None) const;
+			std::size_t FindAny(StringView characters, std::intmax_t start = 0, UInt32 flags = String::None) const;
+			std::size_t FindLast(char character, std::intmax_t start = -1, UInt32 flags = String::None) const;
+
+			inline const char* GetConstBuffer() const;
+			inline std::size_t GetSize() const;
+			StringView GetWord(unsigned int index) const;
+			std::size_t GetWordPosition(unsigned int index) const;
+
+			inline bool IsEmpty() const;
+
+			unsigned int Split(std::vector<StringView>& result, char separation = ' ', std::intmax_t start = 0, UInt32 flags = String::None) const;
+			unsigned int Split(std::vector<StringView>& result, StringView separation, std::intmax_t start = 0, UInt32 flags = String::None) const;
+			unsigned int SplitAny(std::vector<StringView>& result, StringView separations, std::intmax_t start = 0, UInt32 flags = String::None) const;
+
+			bool StartsWith(char character, UInt32 flags = String::None) const;
+			bool StartsWith(StringView string, UInt32 flags = String::None) const;
+
+			StringView SubString(std::intmax_t startPos, std::intmax_t endPos = -1) const;
+			StringView SubStringFrom(StringView string, std::intmax_t startPos = 0, bool fromLast = false, bool include = false, UInt32 flags = String::None) const;
+			StringView SubStringTo(StringView string, std::intmax_t startPos = 0, bool toLast = false, bool include = false, UInt32 flags = String::None) const;
+
+			bool ToBool(bool* value, UInt32 flags = String::None) const;
+			bool ToDouble(double* value) const;
+			bool ToInteger(long long* value, UInt8 radix = 10) const;
+			String ToString() const;
+
+			StringView& Trim(UInt32 flags = String::None);
+			StringView& Trim(char character, UInt32 flags = String::None);
+			StringView Trimmed(UInt32 flags = String::None) const;
+			StringView Trimmed(char character, UInt32 flags = String::None) const;
+
+			// Méthodes STD
+			inline const char* begin() const;
+			inline const char* end() const;
+
+			typedef const char& const_reference;
+			typedef const char* const_iterator;
+			typedef char value_type;
+			// Méthodes STD
+
+			inline char operator[](std::size_t pos) const;
+
+			StringView& operator=(const StringView&) = default;
+
+			NAZARA_CORE_API friend bool operator==(const StringView& first, const StringView& second);
+			NAZARA_CORE_API friend bool operator!=(const StringView& first, const StringView& second);
+			NAZARA_CORE_API friend bool operator<(const StringView& first, const StringView& second);
+
+			static const std::size_t npos;
+
+		private:
+			const char* m_string;
+			std::size_t m_size;
+	};
+
+	NAZARA_CORE_API std::ostream& operator<<(std::ostream& out, const StringView& string);
+}
+
+namespace std
+{
+	template<>
+	struct hash<Nz::StringView>;
+}
+
+#include <Nazara/Core/StringView.inl>
+
+#endif // NAZARA_STRINGVIEW_HPP
@@ -0,0 +1,176 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::StringView
+	* \brief Core class that represents a non-owning reference to a sequence of characters
+	*
+	* A StringView never allocates memory, its substrings, words and split tokens reference the same characters.
+	* The referenced characters must outlive the view and are not null-terminated in general, use ToString to get a String out of it.
+	*
+	* \remark Case-insensitive operations only handle ASCII characters, String::HandleUtf8 is not supported
+	*/
+
+	/*!
+	* \brief Constructs an empty StringView object
+	*/
+
+	inline StringView::StringView() :
+	m_string(""),
+	m_size(0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a StringView object referencing a null-terminated string
+	*
+	* \param string String to reference, nullptr is treated as an empty string
+	*/
+
+	inline StringView::StringView(const char* string) :
+	m_string((string) ? string : ""),
+	m_size((string) ? std::strlen(string) : 0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a StringView object referencing a sequence of characters
+	*
+	* \param string First character to reference
+	* \param length Number of characters
+	*/
+
+	inline StringView::StringView(const char* string, std::size_t length) :
+	m_string(string),
+	m_size(length)
+	{
+		NazaraAssert(string || length == 0, "Invalid string");
+	}
+
+	/*!
+	* \brief Constructs a StringView object referencing a std::string
+	*
+	* \param string String to reference
+	*/
+
+	inline StringView::StringView(const std::string& string) :
+	m_string(string.data()),
+	m_size(string.size())
+	{
+	}
+
+	/*!
+	* \brief Constructs a StringView object referencing a String
+	*
+	* \param string String to reference
+	*
+	* \remark Modifying the string invalidates the view
+	*/
+
+	inline StringView::StringView(const String& string) :
+	StringView((string.IsEmpty()) ? "" : string.GetConstBuffer(), string.GetSize())
+	{
+	}
+
+	/*!
+	* \brief Gets the referenced characters
+	* \return A pointer to the first character, which is not null-terminated in general
+	*/
+
+	inline const char* StringView::GetConstBuffer() const
+	{
+		return m_string;
+	}
+
+	/*!
+	* \brief Gets the number of referenced characters
+	* \return Size of the view
+	*/
+
+	inline std::size_t StringView::GetSize() const
+	{
+		return m_size;
+	}
+
+	/*!
+	* \brief Checks whether the view is empty
+	* \return true if the view does not reference any character
+	*/
+
+	inline bool StringView::IsEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	/*!
+	* \brief Returns an iterator to the first character
+	* \return Beginning of the view
+	*/
+
+	inline const char* StringView::begin() const
+	{
+		return m_string;
+	}
+
+	/*!
+	* \brief Returns an iterator past the last character
+	* \return End of the view
+	*/
+
+	inline const char* StringView::end() const
+	{
+		return m_string + m_size;
+	}
+
+	/*!
+	* \brief Gets the character at a position
+	* \return The character
+	*
+	* \param pos Position of the character
+	*
+	* \remark Produces a NazaraAssert if pos is out of range
+	*/
+
+	inline char StringView::operator[](std::size_t pos) const
+	{
+		NazaraAssert(pos < m_size, "Index out of range");
+
+		return m_string[pos];
+	}
+}
+
+namespace std
+{
+	/*!
+	* \brief Specialisation of std to hash
+	* \return Result of the hash, matching the one of Nz::String for the same characters
+	*
+	* \param str StringView to hash
+	*/
+
+	template<>
+	struct hash<Nz::StringView>
+	{
+		size_t operator()(const Nz::StringView& str) const
+		{
+			// Algorithme DJB2
+			// http://www.cse.yorku.ca/~oz/hash.html
+
+			size_t h = 5381;
+			for (char c : str)
+				h = ((h << 5) + h) + c;
+
+			return h;
+		}
+	};
+}
+
+#include <Nazara/Core/DebugOff.hpp>
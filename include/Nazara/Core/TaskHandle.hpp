@@ -0,0 +1,43 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKHANDLE_HPP
+#define NAZARA_TASKHANDLE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Config.hpp>
+
+namespace Nz
+{
+	class TaskScheduler;
+	struct TaskState;
+
+	class NAZARA_CORE_API TaskHandle
+	{
+		friend TaskScheduler;
+
+		public:
+			TaskHandle();
+			TaskHandle(const TaskHandle& handle);
+			TaskHandle(TaskHandle&& handle) noexcept;
+			~TaskHandle();
+
+			bool IsDone() const;
+			bool IsValid() const;
+
+			void Reset();
+
+			TaskHandle& operator=(const TaskHandle& handle);
+			TaskHandle& operator=(TaskHandle&& handle) noexcept;
+
+		private:
+			explicit TaskHandle(TaskState* state);
+
+			TaskState* m_state;
+	};
+}
+
+#endif // NAZARA_TASKHANDLE_HPP
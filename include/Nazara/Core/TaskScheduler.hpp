@@ -9,27 +9,52 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/TaskHandle.hpp>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
 
 namespace Nz
 {
+	struct TaskState;
+
 	class NAZARA_CORE_API TaskScheduler
 	{
+		friend TaskState;
+
 		public:
 			TaskScheduler() = delete;
 			~TaskScheduler() = delete;
 
-			template<typename F> static void AddTask(F function);
-			template<typename F, typename... Args> static void AddTask(F function, Args&&... args);
-			template<typename C> static void AddTask(void (C::*function)(), C* object);
+			template<typename F> static TaskHandle AddTask(F function);
+			template<typename F, typename... Args> static TaskHandle AddTask(F function, Args&&... args);
+			template<typename C> static TaskHandle AddTask(void (C::*function)(), C* object);
+			template<typename F> static TaskHandle AddTaskAfter(std::initializer_list<TaskHandle> dependencies, F function);
+			template<typename F> static TaskHandle AddTaskAfter(const std::vector<TaskHandle>& dependencies, F function);
 			static unsigned int GetWorkerCount();
+			static unsigned int GetWorkerIndex();
 			static bool Initialize();
+			static bool IsWorkerPinningEnabled();
+			template<typename F> static void ParallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, F function);
+			template<typename T, typename F, typename R> static T ParallelReduce(std::size_t begin, std::size_t end, std::size_t grainSize, T identity, F function, R reduction);
 			static void Run();
 			static void SetWorkerCount(unsigned int workerCount);
+			static void SetWorkerPinning(bool enable);
 			static void Uninitialize();
+			static void Wait(const TaskHandle& handle);
+			static void Wait(std::initializer_list<TaskHandle> handles);
+			static void Wait(const std::vector<TaskHandle>& handles);
 			static void WaitForTasks();
 
 		private:
-			static void AddTaskFunctor(Functor* taskFunctor);
+			static TaskHandle AddTaskFunctor(TaskState* state, Functor* taskFunctor, const TaskHandle* dependencies = nullptr, std::size_t dependencyCount = 0);
+			static TaskState* AllocateTaskState(void** functorStorage);
+			static std::size_t GetHelperCount(std::size_t chunkCount);
+			template<typename T, typename... Args> static Functor* NewTaskFunctor(TaskState** state, Args&&... args);
+			static TaskHandle SpawnTaskFunctor(TaskState* state, Functor* taskFunctor);
+
+			static constexpr std::size_t TaskFunctorSize = 64; //< Functors up to this size are stored in their task state
 	};
 }
 
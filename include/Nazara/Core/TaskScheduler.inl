@@ -2,6 +2,8 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -15,39 +17,246 @@ namespace Nz
 	/*!
 	* \brief Adds a task to the pending list
 	*
+	* \return Handle to the task
+	*
 	* \param function Task that the pool will execute
 	*/
 
 	template<typename F>
-	void TaskScheduler::AddTask(F function)
+	TaskHandle TaskScheduler::AddTask(F function)
 	{
-		AddTaskFunctor(new FunctorWithoutArgs<F>(function));
+		TaskState* state;
+		Functor* functor = NewTaskFunctor<FunctorWithoutArgs<F>>(&state, function);
+
+		return AddTaskFunctor(state, functor);
 	}
 
 	/*!
 	* \brief Adds a task to the pending list
 	*
+	* \return Handle to the task
+	*
 	* \param function Task that the pool will execute
 	* \param args Arguments of the function
 	*/
 
 	template<typename F, typename... Args>
-	void TaskScheduler::AddTask(F function, Args&&... args)
+	TaskHandle TaskScheduler::AddTask(F function, Args&&... args)
 	{
-		AddTaskFunctor(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+		TaskState* state;
+		Functor* functor = NewTaskFunctor<FunctorWithArgs<F, Args...>>(&state, function, std::forward<Args>(args)...);
+
+		return AddTaskFunctor(state, functor);
 	}
 
 	/*!
 	* \brief Adds a task to the pending list
 	*
+	* \return Handle to the task
+	*
 	* \param function Task that the pool will execute
 	* \param object Object on which the method will be called
 	*/
 
 	template<typename C>
-	void TaskScheduler::AddTask(void (C::*function)(), C* object)
+	TaskHandle TaskScheduler::AddTask(void (C::*function)(), C* object)
+	{
+		TaskState* state;
+		Functor* functor = NewTaskFunctor<MemberWithoutArgs<C>>(&state, function, object);
+
+		return AddTaskFunctor(state, functor);
+	}
+
+	/*!
+	* \brief Adds a task which will only be executed once its dependencies are done
+	* \return Handle to the task
+	*
+	* \param dependencies Tasks which have to be done before this one
+	* \param function Task that the pool will execute
+	*
+	* \remark Invalid handles are ignored
+	*/
+
+	template<typename F>
+	TaskHandle TaskScheduler::AddTaskAfter(std::initializer_list<TaskHandle> dependencies, F function)
+	{
+		TaskState* state;
+		Functor* functor = NewTaskFunctor<FunctorWithoutArgs<F>>(&state, function);
+
+		return AddTaskFunctor(state, functor, dependencies.begin(), dependencies.size());
+	}
+
+	/*!
+	* \brief Adds a task which will only be executed once its dependencies are done
+	* \return Handle to the task
+	*
+	* \param dependencies Tasks which have to be done before this one
+	* \param function Task that the pool will execute
+	*
+	* \remark Invalid handles are ignored
+	*/
+
+	template<typename F>
+	TaskHandle TaskScheduler::AddTaskAfter(const std::vector<TaskHandle>& dependencies, F function)
+	{
+		TaskState* state;
+		Functor* functor = NewTaskFunctor<FunctorWithoutArgs<F>>(&state, function);
+
+		return AddTaskFunctor(state, functor, dependencies.data(), dependencies.size());
+	}
+
+	/*!
+	* \brief Executes a function over a range of indices using the workers and the calling thread
+	*
+	* \param begin First index of the range
+	* \param end Index following the last one of the range
+	* \param grainSize Number of indices processed at once
+	* \param function Function called with each sub-range as (first, last), last being excluded
+	*
+	* Sub-ranges are taken on demand by each participating thread, costly parts of the range are thus balanced automatically
+	*
+	* \remark The function is called concurrently on disjoint sub-ranges
+	* \remark Can be called from a task
+	*/
+
+	template<typename F>
+	void TaskScheduler::ParallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, F function)
 	{
-		AddTaskFunctor(new MemberWithoutArgs<C>(function, object));
+		if (begin >= end)
+			return;
+
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		std::size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+		std::size_t helperCount = GetHelperCount(chunkCount);
+		if (helperCount == 0)
+		{
+			function(begin, end);
+			return;
+		}
+
+		std::atomic<std::size_t> nextIndex(begin);
+		auto process = [&]()
+		{
+			for (;;)
+			{
+				std::size_t first = nextIndex.fetch_add(grainSize, std::memory_order_relaxed);
+				if (first >= end)
+					break;
+
+				function(first, std::min(first + grainSize, end));
+			}
+		};
+
+		std::vector<TaskHandle> helpers;
+		helpers.reserve(helperCount);
+		for (std::size_t i = 0; i < helperCount; ++i)
+		{
+			TaskState* state;
+			Functor* functor = NewTaskFunctor<FunctorWithoutArgs<decltype(process)>>(&state, process);
+
+			helpers.emplace_back(SpawnTaskFunctor(state, functor));
+		}
+
+		// The calling thread takes part in the work
+		process();
+
+		Wait(helpers);
+	}
+
+	/*!
+	* \brief Reduces a range of indices using the workers and the calling thread
+	* \return Result of the reduction
+	*
+	* \param begin First index of the range
+	* \param end Index following the last one of the range
+	* \param grainSize Number of indices processed at once
+	* \param identity Initial value of each partial result
+	* \param function Function called with each sub-range as (first, last, partialResult), returning the new partial result
+	* \param reduction Function combining two partial results
+	*
+	* \remark The reduction should be associative, partial results are combined in no particular order of sub-ranges
+	* \see ParallelFor
+	*/
+
+	template<typename T, typename F, typename R>
+	T TaskScheduler::ParallelReduce(std::size_t begin, std::size_t end, std::size_t grainSize, T identity, F function, R reduction)
+	{
+		if (begin >= end)
+			return identity;
+
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		std::size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+		std::size_t helperCount = GetHelperCount(chunkCount);
+		if (helperCount == 0)
+			return function(begin, end, identity);
+
+		// One partial result per participant, they do not need to be synchronized
+		std::vector<T> partialResults(helperCount + 1, identity);
+
+		std::atomic<std::size_t> nextIndex(begin);
+		auto process = [&](std::size_t participant)
+		{
+			T& partialResult = partialResults[participant];
+			for (;;)
+			{
+				std::size_t first = nextIndex.fetch_add(grainSize, std::memory_order_relaxed);
+				if (first >= end)
+					break;
+
+				partialResult = function(first, std::min(first + grainSize, end), partialResult);
+			}
+		};
+
+		std::vector<TaskHandle> helpers;
+		helpers.reserve(helperCount);
+		for (std::size_t i = 0; i < helperCount; ++i)
+		{
+			TaskState* state;
+			Functor* functor = NewTaskFunctor<FunctorWithArgs<decltype(process), std::size_t>>(&state, process, i + 1);
+
+			helpers.emplace_back(SpawnTaskFunctor(state, functor));
+		}
+
+		process(0);
+
+		Wait(helpers);
+
+		T result = std::move(partialResults[0]);
+		for (std::size_t i = 1; i < partialResults.size(); ++i)
+			result = reduction(result, partialResults[i]);
+
+		return result;
+	}
+
+	/*!
+	* \brief Builds the functor of a new task
+	* \return Functor of the task, to be given to AddTaskFunctor or SpawnTaskFunctor along with the state
+	*
+	* \param state Pointer receiving the state of the task
+	* \param args Arguments forwarded to the functor constructor
+	*
+	* Task states come from a thread-caching pool, functors small enough are built inside the state so adding a task does not go through the allocator
+	*/
+
+	template<typename T, typename... Args>
+	Functor* TaskScheduler::NewTaskFunctor(TaskState** state, Args&&... args)
+	{
+		if (sizeof(T) <= TaskFunctorSize && alignof(T) <= alignof(std::max_align_t))
+		{
+			void* functorStorage;
+			*state = AllocateTaskState(&functorStorage);
+
+			return PlacementNew(static_cast<T*>(functorStorage), std::forward<Args>(args)...);
+		}
+		else
+		{
+			// Big captures are allocated apart
+			*state = AllocateTaskState(nullptr);
+
+			return new T(std::forward<Args>(args)...);
+		}
 	}
 }
 
@@ -8,7 +8,9 @@
 #define NAZARA_THREAD_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/String.hpp>
 #include <iosfwd>
 
 namespace Nz
@@ -33,10 +35,17 @@ namespace Nz
 			bool IsJoinable() const;
 			void Join();
 
+			bool SetAffinity(UInt64 processorMask);
+			bool SetName(const String& name);
+			bool SetPriority(ThreadPriority priority);
+
 			Thread& operator=(const Thread&) = delete;
 			Thread& operator=(Thread&& thread);
 
 			static unsigned int HardwareConcurrency();
+			static bool SetCurrentThreadAffinity(UInt64 processorMask);
+			static bool SetCurrentThreadName(const String& name);
+			static bool SetCurrentThreadPriority(ThreadPriority priority);
 			static void Sleep(UInt32 milliseconds);
 
 		private:
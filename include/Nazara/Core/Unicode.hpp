@@ -107,6 +107,10 @@ namespace Nz
 			static char32_t GetLowercase(char32_t character);
 			static char32_t GetTitlecase(char32_t character);
 			static char32_t GetUppercase(char32_t character);
+
+			static bool IsValidUtf8(const char* str, std::size_t size);
+
+			static std::size_t Utf8ToUtf32(const char* str, std::size_t size, char32_t* output);
 	};
 }
 
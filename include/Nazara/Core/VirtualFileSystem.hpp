@@ -0,0 +1,64 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VIRTUALFILESYSTEM_HPP
+#define NAZARA_VIRTUALFILESYSTEM_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/PackArchive.hpp>
+#include <Nazara/Core/String.hpp>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class NAZARA_CORE_API VirtualFileSystem
+	{
+		public:
+			struct Location;
+
+			VirtualFileSystem() = delete;
+			~VirtualFileSystem() = delete;
+
+			static bool Exists(const String& path);
+
+			static bool Find(const String& path, Location* location);
+
+			static inline bool HasMounts();
+
+			static bool MountDirectory(const String& directoryPath, const String& mountPoint = String());
+			static bool MountPack(const String& packPath, const String& mountPoint = String());
+
+			static bool ReadFile(const String& path, ByteArray* data);
+
+			static void Uninitialize();
+
+			static bool Unmount(const String& path);
+			static void UnmountAll();
+
+			struct Location
+			{
+				const PackArchive* archive = nullptr;     //< Pack holding the file, nullptr for a loose file
+				const PackArchive::Entry* entry = nullptr;
+				String filePath;                          //< Path of the loose file
+			};
+
+		private:
+			struct Mount
+			{
+				std::unique_ptr<PackArchive> archive; //< nullptr for a directory
+				String mountPoint;
+				String path;
+			};
+
+			static std::vector<Mount> s_mounts; //< The last mounted one is searched first
+	};
+}
+
+#include <Nazara/Core/VirtualFileSystem.inl>
+
+#endif // NAZARA_VIRTUALFILESYSTEM_HPP
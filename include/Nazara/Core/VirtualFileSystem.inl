@@ -0,0 +1,20 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Checks whether a pack or a directory is mounted
+	* \return true If it is the case
+	*/
+
+	inline bool VirtualFileSystem::HasMounts()
+	{
+		return !s_mounts.empty();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
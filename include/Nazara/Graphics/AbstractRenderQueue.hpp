@@ -9,19 +9,23 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Color.hpp>
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
 #include <Nazara/Core/SparsePtr.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Math/Box.hpp>
 #include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
-#include <vector>
+#include <memory>
 
 namespace Nz
 {
+	class AbstractViewer;
 	class Drawable;
 	class Material;
 	class Texture;
+	class TextureStreamer;
 	struct MeshData;
 
 	class NAZARA_GRAPHICS_API AbstractRenderQueue
@@ -30,8 +34,9 @@ namespace Nz
 			struct DirectionalLight;
 			struct PointLight;
 			struct SpotLight;
+			struct Stats;
 
-			AbstractRenderQueue() = default;
+			AbstractRenderQueue();
 			AbstractRenderQueue(const AbstractRenderQueue&) = delete;
 			AbstractRenderQueue(AbstractRenderQueue&&) = default;
 			virtual ~AbstractRenderQueue();
@@ -52,21 +57,33 @@ namespace Nz
 			virtual void AddMesh(int renderOrder, const Material* material, const MeshData& meshData, const Boxf& meshAABB, const Matrix4f& transformMatrix) = 0;
 			virtual void AddPointLight(const PointLight& light);
 			virtual void AddSpotLight(const SpotLight& light);
-			virtual void AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay = nullptr) = 0;
+			virtual void AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay = nullptr, unsigned int textureLayer = 0) = 0;
 
 			virtual void Clear(bool fully = false);
 
+			inline const Stats& GetStats() const;
+			inline TextureStreamer* GetTextureStreamer() const;
+			inline const AbstractViewer* GetViewer() const;
+
+			inline void ReportCulledObjects(unsigned int count);
+
+			inline void SetTextureStreamer(TextureStreamer* textureStreamer);
+			inline void SetViewer(const AbstractViewer* viewer);
+
 			AbstractRenderQueue& operator=(const AbstractRenderQueue&) = delete;
 			AbstractRenderQueue& operator=(AbstractRenderQueue&&) = default;
 
 			struct DirectionalLight
 			{
 				Color color;
+				Matrix4f cascadeMatrices[NAZARA_GRAPHICS_MAX_SHADOW_CASCADES]; //< Side by side in the shadow map
 				Matrix4f transformMatrix;
 				Vector3f direction;
 				Texture* shadowMap;
 				float ambientFactor;
+				float cascadeSplits[NAZARA_GRAPHICS_MAX_SHADOW_CASCADES]; //< View depth where each cascade ends
 				float diffuseFactor;
+				unsigned int cascadeCount; //< Zero when transformMatrix covers the whole shadow map
 			};
 
 			struct PointLight
@@ -98,10 +115,30 @@ namespace Nz
 				float radius;
 			};
 
-			std::vector<DirectionalLight> directionalLights;
-			std::vector<PointLight> pointLights;
-			std::vector<SpotLight> spotLights;
+			struct Stats
+			{
+				unsigned int batchCount = 0; //< Groups of objects sharing their draw calls, only counted outside of the command list
+				unsigned int culledObjectCount = 0;
+				unsigned int instanceCount = 0; //< Meshes, sprites, billboards and drawables
+			};
+
+			FrameVector<DirectionalLight> directionalLights;
+			FrameVector<PointLight> pointLights;
+			FrameVector<SpotLight> spotLights;
+
+		protected:
+			FrameArena& GetFrameArena();
+			void RequestTextureResolutions(const Material* material, const Boxf& meshAABB, const Matrix4f& transformMatrix);
+
+			Stats m_stats;
+
+		private:
+			std::unique_ptr<FrameArena> m_frameArena;
+			const AbstractViewer* m_viewer;
+			TextureStreamer* m_textureStreamer;
 	};
 }
 
+#include <Nazara/Graphics/AbstractRenderQueue.inl>
+
 #endif // NAZARA_ABSTRACTRENDERQUEUE_HPP
@@ -0,0 +1,77 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the statistics of the queue since its last clear
+	* \return Counters of the queued content
+	*/
+
+	inline const AbstractRenderQueue::Stats& AbstractRenderQueue::GetStats() const
+	{
+		return m_stats;
+	}
+
+	/*!
+	* \brief Gets the texture streamer receiving the resolution requests of the queued meshes
+	* \return Current texture streamer, or nullptr if none was set
+	*/
+
+	inline TextureStreamer* AbstractRenderQueue::GetTextureStreamer() const
+	{
+		return m_textureStreamer;
+	}
+
+	/*!
+	* \brief Gets the viewer the queue is filled for
+	* \return Current viewer, or nullptr if none was set
+	*/
+
+	inline const AbstractViewer* AbstractRenderQueue::GetViewer() const
+	{
+		return m_viewer;
+	}
+
+	/*!
+	* \brief Reports objects which were not queued because they are not visible
+	*
+	* \param count Number of culled objects
+	*/
+
+	inline void AbstractRenderQueue::ReportCulledObjects(unsigned int count)
+	{
+		m_stats.culledObjectCount += count;
+	}
+
+	/*!
+	* \brief Sets the texture streamer receiving the resolution requests of the queued meshes
+	*
+	* \param textureStreamer Texture streamer, nullptr to disable the requests
+	*
+	* \remark Requests are only made while a viewer is set, since the resolution depends on the on-screen size
+	*/
+
+	inline void AbstractRenderQueue::SetTextureStreamer(TextureStreamer* textureStreamer)
+	{
+		m_textureStreamer = textureStreamer;
+	}
+
+	/*!
+	* \brief Sets the viewer the queue is filled for
+	*
+	* \param viewer Viewer the renderables can use to select their level of detail, nullptr to use the full detail
+	*
+	* \remark It is kept by Clear, since the same queue is usually refilled for the same viewer
+	*/
+
+	inline void AbstractRenderQueue::SetViewer(const AbstractViewer* viewer)
+	{
+		m_viewer = viewer;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -12,7 +12,11 @@
 #include <Nazara/Core/String.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/Enums.hpp>
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
 #include <Nazara/Graphics/SceneData.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <functional>
+#include <vector>
 
 namespace Nz
 {
@@ -43,6 +47,25 @@ namespace Nz
 			AbstractRenderTechnique& operator=(AbstractRenderTechnique&&) = default;
 
 		protected:
+			struct MeshBatchEntry;
+
+			using InstanceStreamer = std::function<bool(const Matrix4f* instances, unsigned int instanceCount)>;
+
+			void DrawMeshBatch(const MeshBatchEntry* entries, unsigned int entryCount) const;
+			void DrawMeshBatches(ForwardRenderQueue::MeshInstanceContainer& meshInstances, unsigned int maxInstanceCount, const std::function<void()>& applyMaterial, const InstanceStreamer& streamInstances) const;
+
+			static bool IsMeshBatchable(const MeshData& meshData);
+			static bool MeshBatchLess(const MeshData& mesh1, const MeshData& mesh2);
+
+			struct MeshBatchEntry
+			{
+				const MeshData* meshData;
+				std::vector<Matrix4f>* instances;
+			};
+
+			mutable std::vector<MeshBatchEntry> m_meshBatchEntries;
+			mutable std::vector<Matrix4f> m_meshBatchInstances;
+			mutable std::vector<Renderer::DrawIndexedIndirectCommand> m_indirectCommands;
 			bool m_instancingEnabled;
 	};
 }
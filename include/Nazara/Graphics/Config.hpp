@@ -48,6 +48,9 @@
 // The maximum number of lights in a standard shader
 #define NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS 3
 
+// The maximum number of shadow cascades of a directional light
+#define NAZARA_GRAPHICS_MAX_SHADOW_CASCADES 4
+
 /// Checking the values and types of certain constants
 #include <Nazara/Graphics/ConfigCheck.hpp>
 
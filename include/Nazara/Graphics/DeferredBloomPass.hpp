@@ -30,7 +30,6 @@ namespace Nz
 			Texture* GetTexture(unsigned int i) const;
 
 			bool Process(const SceneData& sceneData, unsigned int firstWorkTexture, unsigned int secondWorkTexture) const;
-			bool Resize(const Vector2ui& dimensions);
 
 			void SetBlurPassCount(unsigned int passCount);
 			void SetBrightLuminance(float luminance);
@@ -38,12 +37,14 @@ namespace Nz
 			void SetBrightThreshold(float threshold);
 
 		protected:
+			void ReleaseTextures() const;
+
 			RenderStates m_bloomStates;
-			RenderTexture m_bloomRTT;
+			mutable RenderTexture m_bloomRTT;
 			ShaderRef m_bloomBrightShader;
 			ShaderRef m_bloomFinalShader;
 			ShaderRef m_gaussianBlurShader;
-			TextureRef m_bloomTextures[2];
+			mutable Texture* m_bloomTextures[2]; //< Transient, only owned during Process
 			TextureSampler m_bilinearSampler;
 			mutable bool m_uniformUpdated;
 			float m_brightLuminance;
@@ -24,14 +24,15 @@ namespace Nz
 			virtual ~DeferredDOFPass();
 
 			bool Process(const SceneData& sceneData, unsigned int firstWorkTexture, unsigned int secondWorkTexture) const;
-			bool Resize(const Vector2ui& dimensions);
 
 		protected:
-			RenderTexture m_dofRTT;
+			void ReleaseTextures() const;
+
+			mutable RenderTexture m_dofRTT;
 			RenderStates m_states;
 			ShaderConstRef m_dofShader;
 			ShaderConstRef m_gaussianBlurShader;
-			TextureRef m_dofTextures[2];
+			mutable Texture* m_dofTextures[2]; //< Transient, only owned during Process
 			TextureSampler m_bilinearSampler;
 			TextureSampler m_pointSampler;
 			int m_gaussianBlurShaderFilterLocation;
@@ -21,6 +21,8 @@ namespace Nz
 			DeferredFinalPass();
 			virtual ~DeferredFinalPass();
 
+			bool GetFusedStage(FusedStage* stage) const override;
+
 			bool Process(const SceneData& sceneData, unsigned int firstWorkTexture, unsigned int secondWorkTexture) const;
 
 		protected:
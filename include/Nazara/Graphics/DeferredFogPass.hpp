@@ -21,6 +21,10 @@ namespace Nz
 			DeferredFogPass();
 			virtual ~DeferredFogPass();
 
+			void ApplyFusedStage(const SceneData& sceneData, const Shader* shader, UInt8* textureUnit) const override;
+
+			bool GetFusedStage(FusedStage* stage) const override;
+
 			bool Process(const SceneData& sceneData, unsigned int firstWorkTexture, unsigned int secondWorkTexture) const;
 
 		protected:
@@ -37,6 +37,7 @@ namespace Nz
 
 				int eyePosition;
 				int sceneAmbient;
+				int skinningMatrices;
 				int textureOverlay;
 			};
 
@@ -8,6 +8,7 @@
 #define NAZARA_DEFERREDRENDERPASS_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/Enums.hpp>
 #include <Nazara/Graphics/SceneData.hpp>
@@ -21,6 +22,7 @@ namespace Nz
 	class RenderBuffer;
 	class RenderTexture;
 	class Scene;
+	class Shader;
 	class Texture;
 
 	class NAZARA_GRAPHICS_API DeferredRenderPass
@@ -28,12 +30,18 @@ namespace Nz
 		friend DeferredRenderTechnique;
 
 		public:
+			struct FusedStage;
+
 			DeferredRenderPass();
 			DeferredRenderPass(const DeferredRenderPass&) = delete;
 			virtual ~DeferredRenderPass();
 
+			virtual void ApplyFusedStage(const SceneData& sceneData, const Shader* shader, UInt8* textureUnit) const;
+
 			void Enable(bool enable);
 
+			virtual bool GetFusedStage(FusedStage* stage) const;
+
 			virtual void Initialize(DeferredRenderTechnique* technique);
 
 			bool IsEnabled() const;
@@ -43,6 +51,12 @@ namespace Nz
 
 			DeferredRenderPass& operator=(const DeferredRenderPass&) = delete;
 
+			struct FusedStage
+			{
+				String declarations; //< GLSL uniforms and functions of the stage
+				String function;     //< Name of its `vec4 function(vec4 color, vec2 texCoord)`, empty if it leaves the color unchanged
+			};
+
 		protected:
 			Vector2ui m_dimensions;
 			DeferredRenderTechnique* m_deferredTechnique;
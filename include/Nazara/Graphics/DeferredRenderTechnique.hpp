@@ -16,11 +16,14 @@
 #include <Nazara/Renderer/RenderBuffer.hpp>
 #include <Nazara/Renderer/RenderStates.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
+#include <Nazara/Renderer/Shader.hpp>
 #include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Renderer/TextureSampler.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace Nz
 {
@@ -32,10 +35,13 @@ namespace Nz
 			DeferredRenderTechnique();
 			~DeferredRenderTechnique();
 
+			Texture* AcquireTransientTexture(PixelFormatType format, unsigned int width, unsigned int height) const;
+
 			void Clear(const SceneData& sceneData) const override;
 			bool Draw(const SceneData& sceneData) const override;
 
 			void EnablePass(RenderPassType renderPass, int position, bool enable);
+			void EnablePassFusion(bool enable);
 
 			RenderBuffer* GetDepthStencilBuffer() const;
 			Texture* GetGBuffer(unsigned int i) const;
@@ -48,15 +54,22 @@ namespace Nz
 			Texture* GetWorkTexture(unsigned int i) const;
 
 			bool IsPassEnabled(RenderPassType renderPass, int position);
+			bool IsPassFusionEnabled() const;
 
 			DeferredRenderPass* ResetPass(RenderPassType renderPass, int position);
 
+			void ReleaseTransientTexture(const Texture* texture) const;
+
 			void SetPass(RenderPassType relativeTo, int position, DeferredRenderPass* pass);
 
 			static bool IsSupported();
 
 		private:
+			bool DrawFusedPasses(const SceneData& sceneData, std::size_t firstPass, std::size_t passCount, unsigned int workTexture, unsigned int sceneTexture, bool* swapTextures) const;
+			std::size_t GatherFusedStages(std::size_t firstPass) const;
+			const Shader* GetFusedShader() const;
 			bool Resize(const Vector2ui& dimensions) const;
+			void UpdateTransientTextures() const;
 
 			static bool Initialize();
 			static void Uninitialize();
@@ -66,7 +79,18 @@ namespace Nz
 				bool operator()(RenderPassType pass1, RenderPassType pass2) const;
 			};
 
+			struct TransientTexture
+			{
+				TextureRef texture;
+				unsigned int unusedFrameCount = 0;
+				bool acquired = false;
+				bool used = false; //< Acquired during the current frame
+			};
+
 			std::map<RenderPassType, std::map<int, std::unique_ptr<DeferredRenderPass>>, RenderPassComparator> m_passes;
+			mutable std::unordered_map<String, ShaderRef> m_fusedShaders; //< By names of the functions of their stages, null if it failed to build
+			mutable std::vector<std::pair<RenderPassType, const DeferredRenderPass*>> m_enabledPasses;
+			mutable std::vector<DeferredRenderPass::FusedStage> m_fusedStages;
 			ForwardRenderTechnique m_forwardTechnique; // Must be initialized before the RenderQueue
 			DeferredRenderQueue m_renderQueue;
 			mutable RenderBufferRef m_depthStencilBuffer;
@@ -74,8 +98,14 @@ namespace Nz
 			mutable RenderTexture m_workRTT;
 			mutable TextureRef m_GBuffer[4];
 			mutable TextureRef m_workTextures[2];
+			mutable std::vector<TransientTexture> m_transientTextures;
 			mutable Vector2ui m_GBufferSize;
 			const RenderTarget* m_viewerTarget;
+			RenderStates m_fusedStates;
+			TextureSampler m_fusedSampler;
+			bool m_passFusionEnabled;
+
+			static bool s_initialized;
 };
 }
 
@@ -13,8 +13,10 @@
 #include <Nazara/Graphics/DepthRenderQueue.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Renderer/Shader.hpp>
+#include <Nazara/Renderer/StreamBuffer.hpp>
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
+#include <array>
 
 namespace Nz
 {
@@ -25,11 +27,22 @@ namespace Nz
 			~DepthRenderTechnique() = default;
 
 			void Clear(const SceneData& sceneData) const override;
+
+			void DisableCubemapLayering();
+
 			bool Draw(const SceneData& sceneData) const override;
 
+			void EnableCubemapLayering(const Matrix4f* viewProjMatrices, UInt8 faceMask = 0x3F);
+
 			AbstractRenderQueue* GetRenderQueue() override;
 			RenderTechniqueType GetType() const override;
 
+			inline bool HasSkippedNonLayeredMaterials() const;
+
+			inline bool IsCubemapLayeringEnabled() const;
+
+			inline void SkipLayeredMaterials(bool skip);
+
 			static bool Initialize();
 			static void Uninitialize();
 
@@ -40,7 +53,9 @@ namespace Nz
 			void DrawBillboards(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
 			void DrawOpaqueModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
 			const ShaderUniforms* GetShaderUniforms(const Shader* shader) const;
+			bool IsMaterialDrawn(const Material* material) const;
 			void OnShaderInvalidated(const Shader* shader) const;
+			void SendCubemapUniforms(const Shader* shader, const ShaderUniforms* uniforms) const;
 
 			struct LightIndex
 			{
@@ -55,14 +70,22 @@ namespace Nz
 				NazaraSlot(Shader, OnShaderRelease, shaderReleaseSlot);
 
 				// Autre uniformes
+				int cubemapFaceMask;
+				int cubemapViewProjMatrices;
 				int eyePosition;
 				int sceneAmbient;
+				int skinningMatrices;
 				int textureOverlay;
 			};
 
 			mutable std::unordered_map<const Shader*, ShaderUniforms> m_shaderUniforms;
-			Buffer m_vertexBuffer;
+			mutable StreamBuffer m_vertexBuffer;
 			mutable DepthRenderQueue m_renderQueue;
+			std::array<Matrix4f, 6> m_cubemapViewProjMatrices;
+			UInt32 m_cubemapFlags;
+			UInt8 m_cubemapFaceMask;
+			bool m_layeredMaterialsSkipped;
+			mutable bool m_nonLayeredMaterialsSkipped;
 			VertexBuffer m_billboardPointBuffer;
 			VertexBuffer m_spriteBuffer;
 
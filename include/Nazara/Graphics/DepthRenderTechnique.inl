@@ -1,3 +1,43 @@
 // Copyright (C) 2015 Jérôme Leclercq
 // This file is part of the "Nazara Engine - Graphics module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Checks whether the last draw with cubemap layering skipped materials
+	* \return true If some objects have a material unable to draw every face at once, they must be drawn face by face with SkipLayeredMaterials
+	*/
+
+	inline bool DepthRenderTechnique::HasSkippedNonLayeredMaterials() const
+	{
+		return m_nonLayeredMaterialsSkipped;
+	}
+
+	/*!
+	* \brief Checks whether the technique draws every face of a layered cubemap at once
+	* \return true If EnableCubemapLayering was called (and not DisableCubemapLayering since)
+	*/
+
+	inline bool DepthRenderTechnique::IsCubemapLayeringEnabled() const
+	{
+		return m_cubemapFlags != 0;
+	}
+
+	/*!
+	* \brief Draws only the materials skipped by cubemap layering
+	*
+	* \param skip Should the materials able to draw every face at once (and thus already drawn) be skipped
+	*
+	* \remark Only affects the draws without cubemap layering
+	*/
+
+	inline void DepthRenderTechnique::SkipLayeredMaterials(bool skip)
+	{
+		m_layeredMaterialsSkipped = skip;
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
@@ -88,6 +88,14 @@ namespace Nz
 		ParticleLayout_Max = ParticleLayout_Sprite
 	};
 
+	enum ParticleStorage
+	{
+		ParticleStorage_Interleaved, // The components of a particle follow each other (array of structures)
+		ParticleStorage_Separate,    // Each component is stored in its own contiguous array (structure of arrays)
+
+		ParticleStorage_Max = ParticleStorage_Separate
+	};
+
 	enum RenderPassType
 	{
 		RenderPassType_AA,
@@ -133,13 +141,17 @@ namespace Nz
 	{
 		ShaderFlags_None = 0,
 
-		ShaderFlags_Billboard      = 0x01,
-		ShaderFlags_Deferred       = 0x02,
-		ShaderFlags_Instancing     = 0x04,
-		ShaderFlags_TextureOverlay = 0x08,
-		ShaderFlags_VertexColor    = 0x10,
-
-		ShaderFlags_Max = ShaderFlags_VertexColor * 2 - 1
+		ShaderFlags_Billboard         = 0x01,
+		ShaderFlags_Deferred          = 0x02,
+		ShaderFlags_Instancing        = 0x04,
+		ShaderFlags_Skinning          = 0x08,
+		ShaderFlags_TextureOverlay    = 0x10,
+		ShaderFlags_VertexColor       = 0x20,
+		ShaderFlags_ClusteredLighting = 0x40,
+		ShaderFlags_CubemapLayered    = 0x80, //< Primitives are routed to the faces of a layered cubemap target by a geometry shader
+		ShaderFlags_VertexPulling     = 0x100, //< Billboards are read from a texture and expanded from the vertex index
+
+		ShaderFlags_Max = ShaderFlags_VertexPulling * 2 - 1
 	};
 }
 
@@ -28,7 +28,7 @@ namespace Nz
 		friend class ForwardRenderTechnique;
 
 		public:
-			ForwardRenderQueue() = default;
+			ForwardRenderQueue();
 			~ForwardRenderQueue() = default;
 
 			void AddBillboard(int renderOrder, const Material* material, const Vector3f& position, const Vector2f& size, const Vector2f& sinCos = Vector2f(0.f, 1.f), const Color& color = Color::White) override;
@@ -42,10 +42,16 @@ namespace Nz
 			void AddBillboards(int renderOrder, const Material* material, unsigned int count, SparsePtr<const Vector3f> positionPtr, SparsePtr<const float> sizePtr, SparsePtr<const float> anglePtr, SparsePtr<const float> alphaPtr) override;
 			void AddDrawable(int renderOrder, const Drawable* drawable) override;
 			void AddMesh(int renderOrder, const Material* material, const MeshData& meshData, const Boxf& meshAABB, const Matrix4f& transformMatrix) override;
-			void AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay = nullptr) override;
+			void AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay = nullptr, unsigned int textureLayer = 0) override;
 
 			void Clear(bool fully = false) override;
 
+			void EnableCommandList(bool enable);
+
+			bool IsCommandListEnabled() const;
+
+			void MergeCommandList(const ForwardRenderQueue& renderQueue);
+
 			void Sort(const AbstractViewer* viewer);
 
 			/// Billboards
@@ -76,6 +82,7 @@ namespace Nz
 			{
 				const VertexStruct_XYZ_Color_UV* vertices;
 				unsigned int spriteCount;
+				unsigned int textureLayer; //< Layer of the diffuse map, when it is an array
 			};
 
 			struct BatchedSpriteEntry
@@ -143,7 +150,7 @@ namespace Nz
 				const Material* material;
 			};
 
-			typedef std::vector<unsigned int> TransparentModelContainer;
+			typedef FrameVector<unsigned int> TransparentModelContainer;
 
 			struct Layer
 			{
@@ -151,14 +158,70 @@ namespace Nz
 				BasicSpriteBatches basicSprites;
 				ModelBatches opaqueModels;
 				TransparentModelContainer transparentModels;
-				std::vector<TransparentModelData> transparentModelData;
-				std::vector<const Drawable*> otherDrawables;
+				FrameVector<TransparentModelData> transparentModelData;
+				FrameVector<const Drawable*> otherDrawables;
 				unsigned int clearCount = 0;
 			};
 
 			std::map<int, Layer> layers;
 
+			/// Command list
+			enum CommandType
+			{
+				CommandType_OpaqueModel,
+				CommandType_TransparentModel,
+				CommandType_Sprites,
+				CommandType_Billboards,
+				CommandType_Drawable,
+
+				CommandType_Max = CommandType_Drawable
+			};
+
+			struct Command
+			{
+				UInt64 sortKey;
+				UInt32 index; //< Index of the command data, in the container matching the type of the command
+			};
+
+			struct BillboardCommandData
+			{
+				const Material* material;
+				unsigned int billboardCount;
+				unsigned int firstBillboard;
+			};
+
+			struct ModelCommandData
+			{
+				Matrix4f transformMatrix;
+				MeshData meshData;
+				Spheref squaredBoundingSphere; //< Relative to the translation of the transform matrix
+				const Material* material;
+			};
+
+			struct SpriteCommandData
+			{
+				const Material* material;
+				const Texture* overlay;
+				SpriteChain_XYZ_Color_UV spriteChain;
+			};
+
+			struct CommandList
+			{
+				FrameVector<BillboardData> billboards;
+				FrameVector<BillboardCommandData> billboardCommands;
+				FrameVector<Command> commands;
+				FrameVector<const Drawable*> drawables;
+				FrameVector<ModelCommandData> models;
+				FrameVector<SpriteCommandData> sprites;
+			};
+
+			CommandList commandList;
+
+			static UInt8 GetCommandLayer(UInt64 sortKey);
+			static CommandType GetCommandType(UInt64 sortKey);
+
 		private:
+			void AddCommand(int renderOrder, CommandType type, UInt64 typeKey, unsigned int index);
 			BillboardData* GetBillboardData(int renderOrder, const Material* material, unsigned int count);
 			Layer& GetLayer(int i); ///TODO: Inline
 
@@ -166,6 +229,11 @@ namespace Nz
 			void OnMaterialInvalidation(const Material* material);
 			void OnTextureInvalidation(const Texture* texture);
 			void OnVertexBufferInvalidation(const VertexBuffer* vertexBuffer);
+
+			void ResetCommandList();
+			void ResetFrameData(Layer& layer);
+
+			bool m_commandListEnabled;
 	};
 }
 
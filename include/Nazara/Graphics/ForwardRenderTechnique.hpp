@@ -13,6 +13,8 @@
 #include <Nazara/Graphics/ForwardRenderQueue.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Renderer/Shader.hpp>
+#include <Nazara/Renderer/StreamBuffer.hpp>
+#include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 
@@ -27,34 +29,88 @@ namespace Nz
 			void Clear(const SceneData& sceneData) const override;
 			bool Draw(const SceneData& sceneData) const override;
 
+			void EnableClusteredLighting(bool enable);
+			void EnableDepthPrepass(bool enable);
+
 			unsigned int GetMaxLightPassPerObject() const;
 			AbstractRenderQueue* GetRenderQueue() override;
 			RenderTechniqueType GetType() const override;
 
+			bool IsClusteredLightingEnabled() const;
+			bool IsDepthPrepassEnabled() const;
+
 			void SetMaxLightPassPerObject(unsigned int maxLightPassPerObject);
 
 			static bool Initialize();
 			static void Uninitialize();
 
 		protected:
+			enum BillboardDrawMode
+			{
+				BillboardDrawMode_Instancing,    //< One instance of the quad vertex buffer per billboard
+				BillboardDrawMode_VertexPulling, //< Billboards read from a texture by the vertex shader
+				BillboardDrawMode_Vertices       //< Four vertices generated per billboard
+			};
+
 			struct ShaderUniforms;
 
-			void ChooseLights(const Spheref& object, bool includeDirectionalLights = true) const;
+			void BindBillboardBuffers(BillboardDrawMode drawMode) const;
+			void BuildLightClusters(const AbstractViewer* viewer) const;
+			void ChooseLights(const Spheref& object, bool includeDirectionalLights = true, bool includeClusteredLights = true) const;
 			void DrawBasicSprites(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
+			void DrawBillboardBatch(const SceneData& sceneData, const Material* material, const ForwardRenderQueue::BillboardData* billboards, unsigned int billboardCount, BillboardDrawMode drawMode, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms) const;
 			void DrawBillboards(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
+			void DrawCommandList(const SceneData& sceneData) const;
+			void DrawDepthPrepass(ForwardRenderQueue::Layer& layer) const;
+			void DrawMeshInstances(const Shader* shader, const ShaderUniforms* shaderUniforms, UInt8 freeTextureUnit, const MeshData& meshData, const Spheref& squaredBoundingSphere, const Matrix4f* instances, unsigned int instanceCount, bool instancing) const;
 			void DrawOpaqueModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
+			void DrawSpriteChains(const SceneData& sceneData, const Material* material, const Texture* overlay, const ForwardRenderQueue::SpriteChain_XYZ_Color_UV* spriteChains, unsigned int spriteChainCount, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms) const;
+			void DrawTransparentModel(const SceneData& sceneData, const Material* material, const MeshData& meshData, const Matrix4f& matrix, const Spheref& squaredBoundingSphere, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms, unsigned int& lightCount) const;
 			void DrawTransparentModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const;
 			const ShaderUniforms* GetShaderUniforms(const Shader* shader) const;
 			void OnShaderInvalidated(const Shader* shader) const;
+			void SendClusterUniforms(const Shader* shader, const ShaderUniforms* shaderUniforms, UInt8 availableTextureUnit, bool enable) const;
 			void SendLightUniforms(const Shader* shader, const LightUniforms& uniforms, unsigned int index, unsigned int uniformOffset, UInt8 availableTextureUnit) const;
+			bool StreamInstances(const Matrix4f* instances, unsigned int instanceCount, unsigned int* firstInstance) const;
 
 			static float ComputeDirectionalLightScore(const Spheref& object, const AbstractRenderQueue::DirectionalLight& light);
 			static float ComputePointLightScore(const Spheref& object, const AbstractRenderQueue::PointLight& light);
 			static float ComputeSpotLightScore(const Spheref& object, const AbstractRenderQueue::SpotLight& light);
+			static BillboardDrawMode GetBillboardDrawMode();
 			static bool IsDirectionalLightSuitable(const Spheref& object, const AbstractRenderQueue::DirectionalLight& light);
 			static bool IsPointLightSuitable(const Spheref& object, const AbstractRenderQueue::PointLight& light);
 			static bool IsSpotLightSuitable(const Spheref& object, const AbstractRenderQueue::SpotLight& light);
 
+			struct InstanceLightSet
+			{
+				unsigned int firstLight; //< In m_instanceLightIndices
+				unsigned int lightCount;
+				unsigned int instanceIndex;
+			};
+
+			struct LightClusterRange
+			{
+				unsigned int minX, maxX;
+				unsigned int minY, maxY;
+				unsigned int minZ, maxZ;
+			};
+
+			struct LightClusters
+			{
+				std::vector<float> gridData; //< Index of the first light and light count of each cluster
+				std::vector<float> indexData;
+				std::vector<float> lightData; //< Four RGBA texels per light
+				std::vector<LightClusterRange> lightRanges;
+				std::vector<unsigned int> clusterCursors;
+				TextureRef gridTexture;
+				TextureRef indexTexture;
+				TextureRef lightTexture;
+				Vector2f slicing;
+				Vector3f depthAxis;
+				Vector4f tiles;
+				bool active = false;
+			};
+
 			struct LightIndex
 			{
 				LightType type;
@@ -74,25 +130,58 @@ namespace Nz
 				/// this may not work everywhere
 				int lightOffset; // "Distance" between Lights[0].type and Lights[1].type
 
+				// Clustered lighting
+				int clusterCount;
+				int clusterDepthAxis;
+				int clusterGrid;
+				int clusterLightIndices;
+				int clusterLights;
+				int clusterLightsEnabled;
+				int clusterSlicing;
+				int clusterTiles;
+
 				// Other uniforms
+				int billboardData;
 				int eyePosition;
 				int sceneAmbient;
+				int skinningMatrices;
 				int textureOverlay;
 			};
 
 			mutable std::unordered_map<const Shader*, ShaderUniforms> m_shaderUniforms;
+			mutable std::vector<ForwardRenderQueue::BillboardData> m_commandBillboards;
+			mutable std::vector<Vector4f> m_billboardTexels;
+			mutable std::vector<ForwardRenderQueue::SpriteChain_XYZ_Color_UV> m_commandSpriteChains;
+			mutable LightClusters m_lightClusters;
+			mutable std::vector<InstanceLightSet> m_instanceLightSets;
+			mutable std::vector<LightIndex> m_instanceLightIndices;
 			mutable std::vector<LightIndex> m_lights;
-			Buffer m_vertexBuffer;
+			mutable std::vector<Matrix4f> m_commandInstances;
+			mutable std::vector<Matrix4f> m_lightSetInstances;
+			mutable StreamBuffer m_instanceStream;
+			mutable StreamBuffer m_vertexBuffer;
 			mutable ForwardRenderQueue m_renderQueue;
+			mutable TextureRef m_billboardTexture;
+			MaterialRef m_depthPrepassMaterial;
 			VertexBuffer m_billboardPointBuffer;
+			VertexBuffer m_instanceBuffer;
+			VertexBuffer m_layeredSpriteBuffer;
 			VertexBuffer m_spriteBuffer;
 			unsigned int m_maxLightPassPerObject;
+			bool m_clusteredLightingEnabled;
+			bool m_depthPrepassEnabled;
 
 			static IndexBuffer s_quadIndexBuffer;
+			static TextureSampler s_billboardSampler;
+			static TextureSampler s_clusterSampler;
 			static TextureSampler s_shadowSampler;
+			static VertexBuffer s_billboardPullingBuffer;
 			static VertexBuffer s_quadVertexBuffer;
 			static VertexDeclaration s_billboardInstanceDeclaration;
+			static VertexDeclaration s_billboardPullingDeclaration;
 			static VertexDeclaration s_billboardVertexDeclaration;
+			static VertexDeclaration s_layeredSpriteDeclaration;
+			static bool s_billboardPullingSupported;
 	};
 }
 
@@ -46,9 +46,23 @@ namespace Nz
 
 						shader->SendMatrix(uniforms.locations.lightViewProjMatrix + index, light.transformMatrix);
 						shader->SendInteger(uniforms.locations.directionalSpotLightShadowMap + index, availableTextureUnit);
+
+						// Cascade count and the depths where they end
+						Vector4f cascadeSplits(0.f);
+						for (unsigned int i = 0; i < light.cascadeCount; ++i)
+						{
+							cascadeSplits[i] = light.cascadeSplits[i];
+							shader->SendMatrix(uniforms.locations.lightCascadeMatrix + index * NAZARA_GRAPHICS_MAX_SHADOW_CASCADES + i, light.cascadeMatrices[i]);
+						}
+
+						shader->SendVector(uniforms.locations.parameters2 + uniformOffset, cascadeSplits);
+						shader->SendVector(uniforms.locations.parameters3 + uniformOffset, Vector2f(static_cast<float>(light.cascadeCount), 0.f));
 					}
 					else
+					{
 						shader->SendInteger(uniforms.locations.directionalSpotLightShadowMap + index, dummyTexture);
+						shader->SendVector(uniforms.locations.parameters3 + uniformOffset, Vector2f(0.f, 0.f));
+					}
 
 					shader->SendInteger(uniforms.locations.pointLightShadowMap + index, dummyCubemap);
 					break;
@@ -11,8 +11,10 @@
 #include <Nazara/Core/Color.hpp>
 #include <Nazara/Graphics/Enums.hpp>
 #include <Nazara/Graphics/Renderable.hpp>
+#include <Nazara/Math/Rect.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
 #include <Nazara/Renderer/Texture.hpp>
+#include <array>
 
 namespace Nz
 {
@@ -29,6 +31,7 @@ namespace Nz
 
 			void AddToRenderQueue(AbstractRenderQueue* renderQueue, const Matrix4f& transformMatrix) const override;
 
+			inline void ClearShadowMapAtlas();
 			Light* Clone() const;
 			Light* Create() const;
 
@@ -50,11 +53,16 @@ namespace Nz
 			inline float GetOuterAngleCosine() const;
 			inline float GetOuterAngleTangent() const;
 			inline float GetRadius() const;
+			inline unsigned int GetShadowCascadeCount() const;
+			inline float GetShadowCascadeSplitLambda() const;
+			inline unsigned int GetShadowCascadeUpdateInterval() const;
 			inline TextureRef GetShadowMap() const;
 			inline PixelFormatType GetShadowMapFormat() const;
+			inline Rectui GetShadowMapRegion() const;
 			inline const Vector2ui& GetShadowMapSize() const;
 
 			inline bool IsShadowCastingEnabled() const;
+			inline bool IsShadowMapAtlased() const;
 
 			inline void SetAmbientFactor(float factor);
 			inline void SetAttenuation(float attenuation);
@@ -64,6 +72,11 @@ namespace Nz
 			inline void SetLightType(LightType type);
 			inline void SetOuterAngle(float outerAngle);
 			inline void SetRadius(float radius);
+			inline void SetShadowCascade(unsigned int cascade, const Matrix4f& viewProjMatrix, float splitDistance);
+			inline void SetShadowCascadeCount(unsigned int cascadeCount);
+			inline void SetShadowCascadeSplitLambda(float lambda);
+			inline void SetShadowCascadeUpdateInterval(unsigned int frameCount);
+			inline void SetShadowMapAtlas(TextureRef atlas, const Rectui& region);
 			inline void SetShadowMapFormat(PixelFormatType shadowFormat);
 			inline void SetShadowMapSize(const Vector2ui& size);
 
@@ -72,18 +85,28 @@ namespace Nz
 			Light& operator=(const Light& light);
 			Light& operator=(Light&& light) = default;
 
+			static void ComputeShadowCascadeSplits(float zNear, float zFar, unsigned int cascadeCount, float lambda, float* splitDistances);
+
 		private:
 			void MakeBoundingVolume() const override;
 			inline void InvalidateShadowMap();
 			void UpdateShadowMap() const;
 
+			std::array<Matrix4f, NAZARA_GRAPHICS_MAX_SHADOW_CASCADES> m_shadowCascadeMatrices;
+			std::array<float, NAZARA_GRAPHICS_MAX_SHADOW_CASCADES> m_shadowCascadeSplits;
 			Color m_color;
 			LightType m_type;
 			PixelFormatType m_shadowMapFormat;
+			Rectui m_shadowAtlasRegion; //< In texels, the first row being the one at v = 0
+			TextureRef m_shadowAtlas; //< Shared with other lights, the shadow map only covers m_shadowAtlasRegion
 			Vector2ui m_shadowMapSize;
 			mutable TextureRef m_shadowMap;
 			bool m_shadowCastingEnabled;
 			mutable bool m_shadowMapUpdated;
+			unsigned int m_fittedShadowCascades; //< One bit per cascade set since the shadow map was invalidated
+			unsigned int m_shadowCascadeCount;
+			unsigned int m_shadowCascadeUpdateInterval;
+			float m_shadowCascadeSplitLambda;
 			float m_ambientFactor;
 			float m_attenuation;
 			float m_diffuseFactor;
@@ -104,6 +127,7 @@ namespace Nz
 			int color;
 			int directionalSpotLightShadowMap;
 			int factors;
+			int lightCascadeMatrix;
 			int lightViewProjMatrix;
 			int parameters1;
 			int parameters2;
@@ -19,6 +19,10 @@ namespace Nz
 	m_shadowMapSize(light.m_shadowMapSize),
 	m_shadowCastingEnabled(light.m_shadowCastingEnabled),
 	m_shadowMapUpdated(false),
+	m_fittedShadowCascades(0),
+	m_shadowCascadeCount(light.m_shadowCascadeCount),
+	m_shadowCascadeUpdateInterval(light.m_shadowCascadeUpdateInterval),
+	m_shadowCascadeSplitLambda(light.m_shadowCascadeSplitLambda),
 	m_ambientFactor(light.m_ambientFactor),
 	m_attenuation(light.m_attenuation),
 	m_diffuseFactor(light.m_diffuseFactor),
@@ -32,6 +36,25 @@ namespace Nz
 	{
 	}
 
+	/*!
+	* \brief Gives the light its own shadow map back, instead of a region of an atlas
+	*
+	* \remark Invalidates the shadow map
+	*
+	* \see SetShadowMapAtlas
+	*/
+
+	inline void Light::ClearShadowMapAtlas()
+	{
+		if (m_shadowAtlas)
+		{
+			m_shadowAtlas.Reset();
+			m_shadowMap.Reset();
+
+			InvalidateShadowMap();
+		}
+	}
+
 	/*!
 	* \brief Enables shadow casting
 	*
@@ -43,7 +66,7 @@ namespace Nz
 		if (m_shadowCastingEnabled != castShadows)
 		{
 			m_shadowCastingEnabled = castShadows;
-			m_shadowMapUpdated = false;
+			InvalidateShadowMap();
 		}
 	}
 
@@ -177,6 +200,36 @@ namespace Nz
 		return m_radius;
 	}
 
+	/*!
+	* \brief Gets the number of shadow cascades of a directional light
+	* \return Shadow cascade count
+	*/
+
+	inline unsigned int Light::GetShadowCascadeCount() const
+	{
+		return m_shadowCascadeCount;
+	}
+
+	/*!
+	* \brief Gets the split scheme of the shadow cascades
+	* \return Blend factor between uniform (0) and logarithmic (1) splits
+	*/
+
+	inline float Light::GetShadowCascadeSplitLambda() const
+	{
+		return m_shadowCascadeSplitLambda;
+	}
+
+	/*!
+	* \brief Gets the update interval of the shadow cascades following the first one
+	* \return Number of frames between two updates of these cascades
+	*/
+
+	inline unsigned int Light::GetShadowCascadeUpdateInterval() const
+	{
+		return m_shadowCascadeUpdateInterval;
+	}
+
 	/*!
 	* \brief Gets the shadow map
 	* \return Reference to the shadow map texture
@@ -199,6 +252,25 @@ namespace Nz
 		return m_shadowMapFormat;
 	}
 
+	/*!
+	* \brief Gets the part of the shadow map texture covered by the shadow map of this light
+	* \return Region in texels, the whole texture (or the whole face of a cubemap) if the light owns it
+	*
+	* \see SetShadowMapAtlas
+	*/
+
+	inline Rectui Light::GetShadowMapRegion() const
+	{
+		if (m_shadowAtlas)
+			return m_shadowAtlasRegion;
+
+		unsigned int width = m_shadowMapSize.x;
+		if (m_type == LightType_Directional)
+			width *= m_shadowCascadeCount;
+
+		return Rectui(0U, 0U, width, m_shadowMapSize.y);
+	}
+
 	/*!
 	* \brief Gets the size of the shadow map
 	* \return Shadow map size
@@ -219,6 +291,16 @@ namespace Nz
 		return m_shadowCastingEnabled;
 	}
 
+	/*!
+	* \brief Checks whether the shadow map is a region of an atlas shared with other lights
+	* \return true If the shadow map is a region of an atlas
+	*/
+
+	inline bool Light::IsShadowMapAtlased() const
+	{
+		return m_shadowAtlas.IsValid();
+	}
+
 	/*!
 	* \brief Sets the ambient factor
 	*
@@ -319,6 +401,98 @@ namespace Nz
 		InvalidateBoundingVolume();
 	}
 
+	/*!
+	* \brief Sets a shadow cascade, as it was rendered in the shadow map
+	*
+	* \param cascade Index of the cascade
+	* \param viewProjMatrix View projection matrix the cascade was rendered with
+	* \param splitDistance View depth where the cascade ends
+	*
+	* \remark Cascades are only used by the shader once all of them have been set
+	* \remark Produces a NazaraAssert if cascade is out of range
+	*/
+
+	inline void Light::SetShadowCascade(unsigned int cascade, const Matrix4f& viewProjMatrix, float splitDistance)
+	{
+		NazaraAssert(cascade < m_shadowCascadeCount, "Shadow cascade out of range");
+
+		m_shadowCascadeMatrices[cascade] = viewProjMatrix;
+		m_shadowCascadeSplits[cascade] = splitDistance;
+		m_fittedShadowCascades |= 1U << cascade;
+	}
+
+	/*!
+	* \brief Sets the number of shadow cascades of a directional light
+	*
+	* \param cascadeCount Shadow cascade count
+	*
+	* \remark Invalidates the shadow map
+	* \remark Produces a NazaraAssert if cascadeCount is zero or over NAZARA_GRAPHICS_MAX_SHADOW_CASCADES
+	*/
+
+	inline void Light::SetShadowCascadeCount(unsigned int cascadeCount)
+	{
+		NazaraAssert(cascadeCount > 0 && cascadeCount <= NAZARA_GRAPHICS_MAX_SHADOW_CASCADES, "Invalid shadow cascade count");
+
+		m_shadowCascadeCount = cascadeCount;
+
+		InvalidateShadowMap();
+	}
+
+	/*!
+	* \brief Sets the split scheme of the shadow cascades
+	*
+	* \param lambda Blend factor between uniform (0) and logarithmic (1) splits
+	*
+	* \remark Produces a NazaraAssert if lambda is not in [0, 1]
+	*/
+
+	inline void Light::SetShadowCascadeSplitLambda(float lambda)
+	{
+		NazaraAssert(lambda >= 0.f && lambda <= 1.f, "Split lambda must be between 0 and 1");
+
+		m_shadowCascadeSplitLambda = lambda;
+	}
+
+	/*!
+	* \brief Sets the update interval of the shadow cascades following the first one
+	*
+	* \param frameCount Number of frames between two updates of these cascades, the first one is always updated
+	*
+	* \remark Produces a NazaraAssert if frameCount is zero
+	*/
+
+	inline void Light::SetShadowCascadeUpdateInterval(unsigned int frameCount)
+	{
+		NazaraAssert(frameCount > 0, "Update interval must be at least one frame");
+
+		m_shadowCascadeUpdateInterval = frameCount;
+	}
+
+	/*!
+	* \brief Renders the shadow map in a region of a texture shared with other lights
+	*
+	* \param atlas Texture containing the shadow maps, its format and type being kept as they are
+	* \param region Part of the atlas given to the light, in texels
+	*
+	* \remark Invalidates the shadow map
+	* \remark Produces a NazaraAssert if the light is a point light, its shadow map being a cubemap
+	* \remark Produces a NazaraAssert if the atlas is invalid or if the region does not fit in it
+	*/
+
+	inline void Light::SetShadowMapAtlas(TextureRef atlas, const Rectui& region)
+	{
+		NazaraAssert(m_type != LightType_Point, "Point lights can't use a shadow map atlas");
+		NazaraAssert(atlas && atlas->IsValid(), "Invalid atlas");
+		NazaraAssert(region.x + region.width <= atlas->GetWidth() && region.y + region.height <= atlas->GetHeight(), "Region does not fit in the atlas");
+
+		m_shadowAtlas = std::move(atlas);
+		m_shadowAtlasRegion = region;
+		m_shadowMap.Reset();
+
+		InvalidateShadowMap();
+	}
+
 	/*!
 	* \brief Sets the shadow map format
 	*
@@ -379,6 +553,9 @@ namespace Nz
 		m_outerAngleCosine = light.m_outerAngleCosine;
 		m_outerAngleTangent = light.m_outerAngleTangent;
 		m_radius = light.m_radius;
+		m_shadowCascadeCount = light.m_shadowCascadeCount;
+		m_shadowCascadeSplitLambda = light.m_shadowCascadeSplitLambda;
+		m_shadowCascadeUpdateInterval = light.m_shadowCascadeUpdateInterval;
 		m_shadowCastingEnabled = light.m_shadowCastingEnabled;
 		m_shadowMapFormat = light.m_shadowMapFormat;
 		m_shadowMapSize = light.m_shadowMapSize;
@@ -394,6 +571,7 @@ namespace Nz
 
 	inline void Light::InvalidateShadowMap()
 	{
+		m_fittedShadowCascades = 0;
 		m_shadowMapUpdated = false;
 	}
 }
@@ -24,7 +24,9 @@
 #include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Renderer/TextureSampler.hpp>
 #include <Nazara/Renderer/UberShader.hpp>
+#include <Nazara/Utility/Buffer.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
+#include <array>
 
 namespace Nz
 {
@@ -68,6 +70,7 @@ namespace Nz
 			inline void Enable(RendererParameter renderParameter, bool enable);
 			inline void EnableAlphaTest(bool alphaTest);
 			inline void EnableDepthSorting(bool depthSorting);
+			inline void EnableDistanceField(bool distanceField);
 			inline void EnableLighting(bool lighting);
 			inline void EnableShadowCasting(bool castShadows);
 			inline void EnableShadowReceive(bool receiveShadows);
@@ -87,11 +90,13 @@ namespace Nz
 			inline FaceSide GetFaceCulling() const;
 			inline FaceFilling GetFaceFilling() const;
 			inline const TextureRef& GetHeightMap() const;
+			inline std::size_t GetMemoryUsage() const;
 			inline const TextureRef& GetNormalMap() const;
 			inline const RenderStates& GetRenderStates() const;
 			inline const UberShader* GetShader() const;
 			inline const UberShaderInstance* GetShaderInstance(UInt32 flags = ShaderFlags_None) const;
 			inline float GetShininess() const;
+			inline UInt32 GetSortKey() const;
 			inline Color GetSpecularColor() const;
 			inline const TextureRef& GetSpecularMap() const;
 			inline TextureSampler& GetSpecularSampler();
@@ -108,9 +113,11 @@ namespace Nz
 
 			inline bool IsAlphaTestEnabled() const;
 			inline bool IsDepthSortingEnabled() const;
+			inline bool IsDistanceFieldEnabled() const;
 			inline bool IsEnabled(RendererParameter renderParameter) const;
 			inline bool IsLightingEnabled() const;
 			inline bool IsShadowCastingEnabled() const;
+			bool IsShaderReady(UInt32 shaderFlags = ShaderFlags_None) const;
 			inline bool IsShadowReceiveEnabled() const;
 			inline bool IsTransformEnabled() const;
 
@@ -122,6 +129,8 @@ namespace Nz
 
 			void SaveToParameters(ParameterList* matData);
 
+			void WarmUpShader(UInt32 shaderFlags = ShaderFlags_None) const;
+
 			inline bool SetAlphaMap(const String& textureName);
 			inline void SetAlphaMap(TextureRef alphaMap);
 			inline void SetAlphaThreshold(float alphaThreshold);
@@ -153,7 +162,11 @@ namespace Nz
 
 			inline Material& operator=(const Material& material);
 
+			static void EnableAsyncShaderCompilation(bool enable);
+			static bool EnableBindlessTextures(bool enable);
 			inline static MaterialRef GetDefault();
+			static bool IsAsyncShaderCompilationEnabled();
+			static bool IsBindlessTexturesEnabled();
 			template<typename... Args> static MaterialRef New(Args&&... args);
 
 			// Signals:
@@ -165,16 +178,27 @@ namespace Nz
 			{
 				const Shader* shader;
 				UberShaderInstance* uberInstance = nullptr;
+				bool bindlessTextures = false; //< Textures are referenced by handles stored in the uniform block
+				bool fallback = false; //< uberInstance is a placeholder while the real variant compiles
+				int uniformBlock;
 				int uniforms[MaterialUniform_Max + 1];
 			};
 
 			void Copy(const Material& material);
+			void FillShaderParameters(UInt32 flags, ParameterList* list) const;
 			void GenerateShader(UInt32 flags) const;
 			inline void InvalidateShaders();
+			inline void InvalidateSortKey();
+			inline void InvalidateUniformBuffer();
+			void UpdateBindlessHandles() const;
+			void UpdateSortKey() const;
+			void UpdateUniformBuffer() const;
 
 			static bool Initialize();
 			static void Uninitialize();
 
+			mutable std::array<UInt64, 6> m_bindlessHandles;
+			mutable BufferRef m_uniformBuffer;
 			Color m_ambientColor;
 			Color m_diffuseColor;
 			Color m_specularColor;
@@ -190,20 +214,28 @@ namespace Nz
 			TextureRef m_specularMap;
 			UberShaderConstRef m_uberShader;
 			mutable ShaderInstance m_shaders[ShaderFlags_Max + 1];
+			mutable UInt32 m_sortKey;
 			bool m_alphaTestEnabled;
 			bool m_depthSortingEnabled;
+			bool m_distanceFieldEnabled;
 			bool m_lightingEnabled;
 			bool m_shadowCastingEnabled;
 			bool m_shadowReceiveEnabled;
+			mutable bool m_sortKeyUpdated;
 			bool m_transformEnabled;
+			mutable bool m_uniformBufferUpdated;
 			float m_alphaThreshold;
 			float m_shininess;
 
 			static MaterialLibrary::LibraryMap s_library;
 			static MaterialLoader::LoaderList s_loaders;
+			static MaterialManager::ManagerCache s_managerCache;
+			static MaterialManager::ManagerLoads s_managerLoads;
 			static MaterialManager::ManagerMap s_managerMap;
 			static MaterialManager::ManagerParams s_managerParameters;
 			static MaterialRef s_defaultMaterial;
+			static bool s_asyncShaderCompilation;
+			static bool s_bindlessTextures;
 	};
 }
 
@@ -57,32 +57,34 @@ namespace Nz
 		{
 			case RendererParameter_Blend:
 				m_states.blending = enable;
-				return;
+				break;
 
 			case RendererParameter_ColorWrite:
 				m_states.colorWrite = enable;
-				return;
+				break;
 
 			case RendererParameter_DepthBuffer:
 				m_states.depthBuffer = enable;
-				return;
+				break;
 
 			case RendererParameter_DepthWrite:
 				m_states.depthWrite = enable;
-				return;
+				break;
 
 			case RendererParameter_FaceCulling:
 				m_states.faceCulling = enable;
-				return;
+				break;
 
 			case RendererParameter_ScissorTest:
 				m_states.scissorTest = enable;
-				return;
+				break;
 
 			case RendererParameter_StencilTest:
 				m_states.stencilTest = enable;
-				return;
+				break;
 		}
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -112,6 +114,22 @@ namespace Nz
 		m_depthSortingEnabled = depthSorting;
 	}
 
+	/*!
+	* \brief Enables the distance field rendering of the texture overlay
+	*
+	* \param distanceField Should the parameter be enabled
+	*
+	* \remark The alpha channel of the overlay is then interpreted as a signed distance field (as generated by fonts)
+	* \remark Invalidates the shaders
+	*/
+
+	inline void Material::EnableDistanceField(bool distanceField)
+	{
+		m_distanceFieldEnabled = distanceField;
+
+		InvalidateShaders();
+	}
+
 	/*!
 	* \brief Enables the lighting
 	*
@@ -309,6 +327,18 @@ namespace Nz
 		return m_heightMap;
 	}
 
+	/*!
+	* \brief Gets the memory owned by the material
+	* \return Size in bytes
+	*
+	* \remark Textures and shaders are not taken into account, they are owned by their own managers
+	*/
+
+	inline std::size_t Material::GetMemoryUsage() const
+	{
+		return sizeof(Material);
+	}
+
 	/*!
 	* \brief Gets the normal map
 	* \return Constant reference to the texture
@@ -349,7 +379,7 @@ namespace Nz
 	inline const UberShaderInstance* Material::GetShaderInstance(UInt32 flags) const
 	{
 		const ShaderInstance& instance = m_shaders[flags];
-		if (!instance.uberInstance)
+		if (!instance.uberInstance || instance.fallback)
 			GenerateShader(flags);
 
 		return instance.uberInstance;
@@ -365,6 +395,21 @@ namespace Nz
 		return m_shininess;
 	}
 
+	/*!
+	* \brief Gets the sort key of the material
+	* \return Key grouping materials by pipeline (shader and its features), then by render states and finally by textures
+	*
+	* \remark The key is cached until the material changes, two different materials may share the same key
+	*/
+
+	inline UInt32 Material::GetSortKey() const
+	{
+		if (!m_sortKeyUpdated)
+			UpdateSortKey();
+
+		return m_sortKey;
+	}
+
 	/*!
 	* \brief Gets the specular color
 	* \return Specular color
@@ -505,6 +550,16 @@ namespace Nz
 		return m_depthSortingEnabled;
 	}
 
+	/*!
+	* \brief Checks whether this material renders its texture overlay as a distance field
+	* \return true If it is the case
+	*/
+
+	inline bool Material::IsDistanceFieldEnabled() const
+	{
+		return m_distanceFieldEnabled;
+	}
+
 	/*!
 	* \brief Checks whether this material has the render parameter enabled
 	* \return true If it is the case
@@ -675,6 +730,8 @@ namespace Nz
 	inline void Material::SetAlphaThreshold(float alphaThreshold)
 	{
 		m_alphaThreshold = alphaThreshold;
+
+		InvalidateUniformBuffer();
 	}
 
 	/*!
@@ -686,6 +743,8 @@ namespace Nz
 	inline void Material::SetAmbientColor(const Color& ambient)
 	{
 		m_ambientColor = ambient;
+
+		InvalidateUniformBuffer();
 	}
 
 	/*!
@@ -697,6 +756,8 @@ namespace Nz
 	inline void Material::SetDepthFunc(RendererComparison depthFunc)
 	{
 		m_states.depthFunc = depthFunc;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -720,6 +781,8 @@ namespace Nz
 	inline void Material::SetDiffuseColor(const Color& diffuse)
 	{
 		m_diffuseColor = diffuse;
+
+		InvalidateUniformBuffer();
 	}
 
 	/*!
@@ -782,6 +845,8 @@ namespace Nz
 	inline void Material::SetDstBlend(BlendFunc func)
 	{
 		m_states.dstBlend = func;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -833,6 +898,8 @@ namespace Nz
 	inline void Material::SetFaceCulling(FaceSide faceSide)
 	{
 		m_states.cullingSide = faceSide;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -844,6 +911,8 @@ namespace Nz
 	inline void Material::SetFaceFilling(FaceFilling filling)
 	{
 		m_states.faceFilling = filling;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -935,6 +1004,8 @@ namespace Nz
 	inline void Material::SetRenderStates(const RenderStates& states)
 	{
 		m_states = states;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -978,6 +1049,8 @@ namespace Nz
 	inline void Material::SetShininess(float shininess)
 	{
 		m_shininess = shininess;
+
+		InvalidateUniformBuffer();
 	}
 
 	/*!
@@ -989,6 +1062,8 @@ namespace Nz
 	inline void Material::SetSpecularColor(const Color& specular)
 	{
 		m_specularColor = specular;
+
+		InvalidateUniformBuffer();
 	}
 
 	/*!
@@ -1051,6 +1126,8 @@ namespace Nz
 	inline void Material::SetSrcBlend(BlendFunc func)
 	{
 		m_states.srcBlend = func;
+
+		InvalidateSortKey();
 	}
 
 	/*!
@@ -1086,6 +1163,26 @@ namespace Nz
 	{
 		for (ShaderInstance& instance : m_shaders)
 			instance.uberInstance = nullptr;
+
+		InvalidateSortKey();
+	}
+
+	/*!
+	* \brief Invalidates the sort key
+	*/
+
+	inline void Material::InvalidateSortKey()
+	{
+		m_sortKeyUpdated = false;
+	}
+
+	/*!
+	* \brief Invalidates the uniform buffer
+	*/
+
+	inline void Material::InvalidateUniformBuffer()
+	{
+		m_uniformBufferUpdated = false;
 	}
 
 	/*!
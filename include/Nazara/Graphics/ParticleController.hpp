@@ -36,6 +36,8 @@ namespace Nz
 
 			virtual void Apply(ParticleSystem& system, ParticleMapper& mapper, unsigned int startId, unsigned int endId, float elapsedTime) = 0;
 
+			virtual bool IsParallelizable() const;
+
 			// Signals:
 			NazaraSignal(OnParticleControllerRelease, const ParticleController* /*particleController*/);
 
@@ -0,0 +1,95 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_PARTICLEGPUSIMULATOR_HPP
+#define NAZARA_PARTICLEGPUSIMULATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Color.hpp>
+#include <Nazara/Graphics/Drawable.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Math/Vector4.hpp>
+#include <Nazara/Renderer/RenderStates.hpp>
+#include <Nazara/Renderer/RenderTexture.hpp>
+#include <Nazara/Renderer/Shader.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class ParticleMapper;
+
+	class NAZARA_GRAPHICS_API ParticleGpuSimulator : public Drawable
+	{
+		friend class Graphics;
+
+		public:
+			ParticleGpuSimulator(unsigned int maxParticleCount);
+			ParticleGpuSimulator(const ParticleGpuSimulator& simulator);
+			~ParticleGpuSimulator();
+
+			void Draw() const override;
+
+			const Color& GetEndColor() const;
+			float GetEndSize() const;
+			const Vector3f& GetGravity() const;
+			const MaterialRef& GetMaterial() const;
+			unsigned int GetMaxParticleCount() const;
+			const Color& GetStartColor() const;
+			float GetStartSize() const;
+			Texture* GetStateTexture(unsigned int i) const;
+			unsigned int GetUsedParticleCount() const;
+
+			void KillParticles();
+
+			void SetColorOverLife(const Color& startColor, const Color& endColor);
+			void SetGravity(const Vector3f& gravity);
+			void SetMaterial(MaterialRef material);
+			void SetSizeOverLife(float startSize, float endSize);
+
+			void Simulate(float elapsedTime);
+			void Spawn(const ParticleMapper& mapper, unsigned int count);
+
+			ParticleGpuSimulator& operator=(const ParticleGpuSimulator&) = delete;
+
+		private:
+			void CreateStates();
+			void UploadStates(unsigned int firstSlot, unsigned int count, const Vector4f* state0, const Vector4f* state1);
+
+			static bool Initialize();
+			static void Uninitialize();
+
+			std::vector<Vector4f> m_spawnStates[2];
+			Color m_endColor;
+			Color m_startColor;
+			MaterialRef m_material;
+			RenderTexture m_stateRTT[2];
+			TextureRef m_stateTextures[2][2]; //< [set][0: position and remaining life, 1: velocity and total life]
+			Vector2ui m_stateSize;
+			Vector3f m_gravity;
+			VertexBuffer m_instanceBuffer;
+			float m_endSize;
+			float m_startSize;
+			unsigned int m_currentState;
+			unsigned int m_maxParticleCount;
+			unsigned int m_spawnCursor;
+			unsigned int m_usedParticleCount;
+
+			static RenderStates s_simulationStates;
+			static ShaderRef s_renderShader;
+			static ShaderRef s_simulationShader;
+			static TextureSampler s_stateSampler;
+			static VertexBuffer s_quadVertexBuffer;
+			static VertexDeclaration s_instanceDeclaration;
+	};
+}
+
+#endif // NAZARA_PARTICLEGPUSIMULATOR_HPP
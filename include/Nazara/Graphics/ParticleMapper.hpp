@@ -18,14 +18,19 @@ namespace Nz
 	{
 		public:
 			ParticleMapper(void* buffer, const ParticleDeclaration* declaration);
+			ParticleMapper(void* buffer, const ParticleDeclaration* declaration, unsigned int maxParticleCount, unsigned int firstParticle);
 			~ParticleMapper();
 
 			template<typename T> SparsePtr<T> GetComponentPtr(ParticleComponent component);
 			template<typename T> SparsePtr<const T> GetComponentPtr(ParticleComponent component) const;
+			const ParticleDeclaration* GetDeclaration() const;
 
 		private:
 			const ParticleDeclaration* m_declaration;
+			ParticleStorage m_storage;
 			UInt8* m_ptr;
+			unsigned int m_firstParticle;
+			unsigned int m_maxParticleCount;
 	};
 }
 
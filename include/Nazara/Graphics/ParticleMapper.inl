@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Utility.hpp>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -13,7 +14,7 @@ namespace Nz
 	*
 	* \param component Component to get in the declaration
 	*
-	* \remark The same components are not continguous but separated by sizeof(ParticleSize)
+	* \remark With interleaved storage, the same components are not contiguous but separated by the stride of the declaration
 	* \remark Produces a NazaraError if component is disabled
 	*/
 
@@ -29,7 +30,13 @@ namespace Nz
 		if (enabled)
 		{
 			///TODO: Check the ratio between the type of the attribute and the template type ?
-			return SparsePtr<T>(m_ptr + offset, m_declaration->GetStride());
+			if (m_storage == ParticleStorage_Separate)
+			{
+				std::size_t componentStride = Utility::ComponentStride[type];
+				return SparsePtr<T>(m_ptr + offset * m_maxParticleCount + m_firstParticle * componentStride, static_cast<int>(componentStride));
+			}
+			else
+				return SparsePtr<T>(m_ptr + offset, m_declaration->GetStride());
 		}
 		else
 		{
@@ -44,7 +51,7 @@ namespace Nz
 	*
 	* \param component Component to get in the declaration
 	*
-	* \remark The same components are not continguous but separated by sizeof(ParticleSize)
+	* \remark With interleaved storage, the same components are not contiguous but separated by the stride of the declaration
 	* \remark Produces a NazaraError if component is disabled
 	*/
 
@@ -60,7 +67,13 @@ namespace Nz
 		if (enabled)
 		{
 			///TODO: Check the ratio between the type of the attribute and the template type ?
-			return SparsePtr<const T>(m_ptr + offset, m_declaration->GetStride());
+			if (m_storage == ParticleStorage_Separate)
+			{
+				std::size_t componentStride = Utility::ComponentStride[type];
+				return SparsePtr<const T>(m_ptr + offset * m_maxParticleCount + m_firstParticle * componentStride, static_cast<int>(componentStride));
+			}
+			else
+				return SparsePtr<const T>(m_ptr + offset, m_declaration->GetStride());
 		}
 		else
 		{
@@ -8,13 +8,16 @@
 #define NAZARA_PARTICLESYSTEM_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Graphics/ParticleController.hpp>
 #include <Nazara/Graphics/ParticleDeclaration.hpp>
 #include <Nazara/Graphics/ParticleEmitter.hpp>
 #include <Nazara/Graphics/ParticleGenerator.hpp>
+#include <Nazara/Graphics/ParticleMapper.hpp>
 #include <Nazara/Graphics/ParticleRenderer.hpp>
 #include <Nazara/Graphics/Renderable.hpp>
 #include <Nazara/Math/BoundingVolume.hpp>
+#include <Nazara/Math/Box.hpp>
 #include <functional>
 #include <memory>
 #include <set>
@@ -22,11 +25,23 @@
 
 namespace Nz
 {
+	class ParticleGpuSimulator;
+
+	struct ParticleSystemLOD
+	{
+		float boundsMargin = 1.f;         //< Added around the positions of the particles, to cover their size in the bounding volume
+		float culledUpdateRate = 0.f;     //< Simulation updates per second of systems which were not rendered since the last update, zero freezing them
+		float fullRateSize = 0.25f;       //< Projected size (fraction of the viewport height) from which the system is fully simulated on every update
+		float maxCatchUpTime = 1.f;       //< Longest time simulated by a system which was skipped, the rest is dropped
+		float minEmissionFactor = 0.25f;  //< Part of the emission rate and of the particle cap kept by the smallest (or culled) systems
+		float minUpdateRate = 10.f;       //< Simulation updates per second of the smallest visible systems
+	};
+
 	class NAZARA_GRAPHICS_API ParticleSystem : public Renderable
 	{
 		public:
-			ParticleSystem(unsigned int maxParticleCount, ParticleLayout layout);
-			ParticleSystem(unsigned int maxParticleCount, ParticleDeclarationConstRef declaration);
+			ParticleSystem(unsigned int maxParticleCount, ParticleLayout layout, ParticleStorage storage = ParticleStorage_Interleaved);
+			ParticleSystem(unsigned int maxParticleCount, ParticleDeclarationConstRef declaration, ParticleStorage storage = ParticleStorage_Interleaved);
 			ParticleSystem(const ParticleSystem& emitter);
 			~ParticleSystem();
 
@@ -37,21 +52,33 @@ namespace Nz
 
 			void ApplyControllers(ParticleMapper& mapper, unsigned int particleCount, float elapsedTime);
 
+			bool Cull(const Frustumf& frustum, const Matrix4f& transformMatrix) const override;
+
 			void* CreateParticle();
 			void* CreateParticles(unsigned int count);
 
 			void EnableFixedStep(bool fixedStep);
+			void EnableGpuSimulation(bool gpuSimulation);
+			void EnableSimulationLOD(bool simulationLOD);
 
 			void* GenerateParticle();
 			void* GenerateParticles(unsigned int count);
 
 			const ParticleDeclarationConstRef& GetDeclaration() const;
 			float GetFixedStepSize() const;
+			ParticleGpuSimulator* GetGpuSimulator() const;
 			unsigned int GetMaxParticleCount() const;
 			unsigned int GetParticleCount() const;
+			unsigned int GetParticleLimit() const;
+			ParticleMapper GetParticleMapper(unsigned int firstParticle = 0) const;
 			unsigned int GetParticleSize() const;
+			float GetProjectedSize() const;
+			const ParticleSystemLOD& GetSimulationLOD() const;
+			ParticleStorage GetStorage() const;
 
 			bool IsFixedStepEnabled() const;
+			bool IsGpuSimulationEnabled() const;
+			bool IsSimulationLODEnabled() const;
 
 			void KillParticle(unsigned int index);
 			void KillParticles();
@@ -62,6 +89,7 @@ namespace Nz
 
 			void SetFixedStepSize(float stepSize);
 			void SetRenderer(ParticleRenderer* renderer);
+			void SetSimulationLOD(const ParticleSystemLOD& simulationLOD);
 
 			void Update(float elapsedTime);
 			void UpdateBoundingVolume(const Matrix4f& transformMatrix) override;
@@ -71,20 +99,32 @@ namespace Nz
 		private:
 			void MakeBoundingVolume() const override;
 			void ResizeBuffer();
+			void Simulate(float elapsedTime, float emissionFactor);
+			void UpdateParticleBounds();
 
 			std::set<unsigned int, std::greater<unsigned int>> m_dyingParticles;
+			std::unique_ptr<ParticleGpuSimulator> m_gpuSimulator;
 			mutable std::vector<UInt8> m_buffer;
 			std::vector<ParticleControllerRef> m_controllers;
 			std::vector<ParticleEmitter*> m_emitters;
 			std::vector<ParticleGeneratorRef> m_generators;
 			ParticleDeclarationConstRef m_declaration;
 			ParticleRendererRef m_renderer;
+			Boxf m_particleBounds; //< Positions of the particles at their last simulation, kept while the system is empty
+			ParticleStorage m_storage;
+			ParticleSystemLOD m_simulationLOD;
+			Mutex m_dyingParticlesMutex;
 			bool m_fixedStepEnabled;
+			bool m_particleBoundsValid;
 			bool m_processing;
+			bool m_simulationLODEnabled;
 			float m_stepAccumulator;
 			float m_stepSize;
+			float m_timeSinceUpdate;
+			mutable float m_projectedSize; //< Largest projected size since the last update, negative if the system wasn't rendered
 			unsigned int m_maxParticleCount;
 			unsigned int m_particleCount;
+			unsigned int m_particleLimit; //< Lowered by the simulation LOD, never over m_maxParticleCount
 			unsigned int m_particleSize;
 	};
 }
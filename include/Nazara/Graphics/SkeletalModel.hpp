@@ -8,12 +8,16 @@
 #define NAZARA_SKELETALMODEL_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Core/ResourceLoader.hpp>
 #include <Nazara/Core/Updatable.hpp>
 #include <Nazara/Graphics/Model.hpp>
 #include <Nazara/Utility/Animation.hpp>
 #include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace Nz
@@ -26,6 +30,16 @@ namespace Nz
 		bool IsValid() const;
 	};
 
+	struct SkeletalModelLOD
+	{
+		float fullRateSize = 0.25f;     //< Projected size (fraction of the viewport height) from which the animation is updated on every call
+		float minUpdateRate = 5.f;      //< Animation updates per second of the smallest visible instances
+		float reducedJointSize = 0.1f;  //< Projected size below which only the joints up to reducedJointDepth are animated
+		float sharedPoseSize = 0.03f;   //< Projected size below which the pose is snapped to the animation frames and shared between instances
+		unsigned int reducedJointDepth = 3;
+		bool skipCulled = true;         //< Should instances which were not rendered since the last update keep their pose
+	};
+
 	class SkeletalModel;
 
 	using SkeletalModelLoader = ResourceLoader<SkeletalModel, SkeletalModelParameters>;
@@ -33,6 +47,7 @@ namespace Nz
 	class NAZARA_GRAPHICS_API SkeletalModel : public Model, Updatable
 	{
 		friend SkeletalModelLoader;
+		friend class Graphics;
 
 		public:
 			SkeletalModel();
@@ -47,8 +62,11 @@ namespace Nz
 			SkeletalModel* Create() const;
 
 			void EnableAnimation(bool animation);
+			void EnableAnimationLOD(bool animationLOD);
 
 			Animation* GetAnimation() const;
+			const SkeletalModelLOD& GetAnimationLOD() const;
+			float GetProjectedSize() const;
 			Skeleton* GetSkeleton();
 			const Skeleton* GetSkeleton() const;
 
@@ -56,6 +74,8 @@ namespace Nz
 
 			bool IsAnimated() const override;
 			bool IsAnimationEnabled() const;
+			bool IsAnimationLODEnabled() const;
+			bool IsPoseShared() const;
 
 			bool LoadFromFile(const String& filePath, const SkeletalModelParameters& params = SkeletalModelParameters());
 			bool LoadFromMemory(const void* data, std::size_t size, const SkeletalModelParameters& params = SkeletalModelParameters());
@@ -64,6 +84,7 @@ namespace Nz
 			void Reset();
 
 			bool SetAnimation(Animation* animation);
+			void SetAnimationLOD(const SkeletalModelLOD& animationLOD);
 			void SetMesh(Mesh* mesh) override;
 			bool SetSequence(const String& sequenceName);
 			void SetSequence(unsigned int sequenceIndex);
@@ -72,20 +93,45 @@ namespace Nz
 			SkeletalModel& operator=(SkeletalModel&& node) = default;
 
 		private:
+			const Skeleton* GetRenderSkeleton() const;
 			void MakeBoundingVolume() const override;
+			void MakeReducedJoints();
+			void ReleaseSharedPose();
 			/*void Register() override;
 			void Unregister() override;*/
 			void Update() override;
+			void UseSharedPose();
+
+			static bool Initialize();
+			static void Uninitialize();
+
+			struct SharedPose
+			{
+				AnimationRef animation;
+				MeshRef mesh;
+				SkeletonRef skeleton;
+			};
+
+			using SharedPoseKey = std::tuple<const Animation*, const Mesh*, unsigned int>;
 
 			AnimationRef m_animation;
 			Skeleton m_skeleton;
+			SkeletonRef m_sharedPose;
+			SkeletalModelLOD m_animationLOD;
 			const Sequence* m_currentSequence;
+			std::vector<unsigned int> m_reducedJoints;
 			bool m_animationEnabled;
+			bool m_animationLODEnabled;
 			float m_interpolation;
+			float m_timeSinceUpdate;
+			mutable float m_projectedSize; //< Largest projected size since the last update, negative if the model wasn't rendered
 			unsigned int m_currentFrame;
 			unsigned int m_nextFrame;
 
+			static std::map<SharedPoseKey, SharedPose> s_sharedPoses;
+			static Mutex s_sharedPoseMutex;
 			static SkeletalModelLoader::LoaderList s_loaders;
+			static std::size_t s_sharedPoseSweepSize;
 	};
 }
 
@@ -26,7 +26,15 @@ namespace Nz
 			SkinningManager() = delete;
 			~SkinningManager() = delete;
 
+			static bool BindSkinningTexture(const Skeleton* skeleton, UInt8 textureUnit);
+
 			static VertexBuffer* GetBuffer(const SkeletalMesh* mesh, const Skeleton* skeleton);
+			static unsigned int GetMaxIdleFrameCount();
+
+			static bool IsGpuSkinningSupported();
+
+			static void SetMaxIdleFrameCount(unsigned int frameCount);
+
 			static void Skin();
 
 		private:
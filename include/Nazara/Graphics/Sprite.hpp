@@ -40,6 +40,7 @@ namespace Nz
 			inline const MaterialRef& GetMaterial() const;
 			inline const Vector2f& GetSize() const;
 			inline const Rectf& GetTextureCoords() const;
+			inline unsigned int GetTextureLayer() const;
 
 			inline void SetColor(const Color& color);
 			inline void SetDefaultMaterial();
@@ -48,6 +49,7 @@ namespace Nz
 			inline void SetSize(float sizeX, float sizeY);
 			inline void SetTexture(TextureRef texture, bool resizeSprite = true);
 			inline void SetTextureCoords(const Rectf& coords);
+			inline void SetTextureLayer(unsigned int layer);
 			inline void SetTextureRect(const Rectui& rect);
 
 			inline Sprite& operator=(const Sprite& sprite);
@@ -67,6 +69,7 @@ namespace Nz
 			MaterialRef m_material;
 			Rectf m_textureCoords;
 			Vector2f m_size;
+			unsigned int m_textureLayer;
 
 			static SpriteLibrary::LibraryMap s_library;
 	};
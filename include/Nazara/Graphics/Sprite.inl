@@ -15,7 +15,8 @@ namespace Nz
 	inline Sprite::Sprite() :
 	m_color(Color::White),
 	m_textureCoords(0.f, 0.f, 1.f, 1.f),
-	m_size(64.f, 64.f)
+	m_size(64.f, 64.f),
+	m_textureLayer(0)
 	{
 		SetDefaultMaterial();
 	}
@@ -29,7 +30,8 @@ namespace Nz
 	inline Sprite::Sprite(MaterialRef material) :
 	m_color(Color::White),
 	m_textureCoords(0.f, 0.f, 1.f, 1.f),
-	m_size(64.f, 64.f)
+	m_size(64.f, 64.f),
+	m_textureLayer(0)
 	{
 		SetMaterial(std::move(material), true);
 	}
@@ -43,7 +45,8 @@ namespace Nz
 	inline Sprite::Sprite(Texture* texture) :
 	m_color(Color::White),
 	m_textureCoords(0.f, 0.f, 1.f, 1.f),
-	m_size(64.f, 64.f)
+	m_size(64.f, 64.f),
+	m_textureLayer(0)
 	{
 		SetTexture(texture, true);
 	}
@@ -59,7 +62,8 @@ namespace Nz
 	m_color(sprite.m_color),
 	m_material(sprite.m_material),
 	m_textureCoords(sprite.m_textureCoords),
-	m_size(sprite.m_size)
+	m_size(sprite.m_size),
+	m_textureLayer(sprite.m_textureLayer)
 	{
 	}
 
@@ -103,6 +107,18 @@ namespace Nz
 		return m_textureCoords;
 	}
 
+	/*!
+	* \brief Gets the layer of the texture array used by the sprite
+	* \return Current texture layer
+	*
+	* \see SetTextureLayer
+	*/
+
+	inline unsigned int Sprite::GetTextureLayer() const
+	{
+		return m_textureLayer;
+	}
+
 	/*!
 	* \brief Sets the color of the billboard
 	*
@@ -145,6 +161,9 @@ namespace Nz
 			if (diffuseMap && diffuseMap->IsValid())
 				SetSize(Vector2f(Vector2ui(diffuseMap->GetSize())));
 		}
+
+		// Les batchs regroupent les sprites par matériau
+		InvalidateInstanceData(0);
 	}
 
 	/*!
@@ -206,6 +225,21 @@ namespace Nz
 		InvalidateVertices();
 	}
 
+	/*!
+	* \brief Sets the layer of the texture array used by the sprite
+	*
+	* \param layer Layer of the material diffuse map to sample
+	*
+	* \remark Only used when the diffuse map of the material is a texture array (ImageType_2D_Array), sprites sharing such a material are drawn together whatever their layer
+	*/
+
+	inline void Sprite::SetTextureLayer(unsigned int layer)
+	{
+		m_textureLayer = layer;
+
+		InvalidateInstanceData(0);
+	}
+
 	/*!
 	* \brief Sets the texture rectangle of the sprite
 	*
@@ -243,6 +277,7 @@ namespace Nz
 		m_material = sprite.m_material;
 		m_textureCoords = sprite.m_textureCoords;
 		m_size = sprite.m_size;
+		m_textureLayer = sprite.m_textureLayer;
 
 		// We do not copy final vertices because it's highly probable that our parameters are modified and they must be regenerated
 		InvalidateBoundingVolume();
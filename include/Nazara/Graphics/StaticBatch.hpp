@@ -0,0 +1,125 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STATICBATCH_HPP
+#define NAZARA_STATICBATCH_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Graphics/Sprite.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class StaticBatch;
+	class StaticMesh;
+
+	using StaticBatchConstRef = ObjectRef<const StaticBatch>;
+	using StaticBatchRef = ObjectRef<StaticBatch>;
+
+	// Merges static models and sprites sharing a material into one draw per material, their geometry being pre-transformed in the batch space
+	// Batches are rebuilt on the first use following a change of a member (or a call to Invalidate), never per frame
+	class NAZARA_GRAPHICS_API StaticBatch : public InstancedRenderable
+	{
+		public:
+			StaticBatch() = default;
+			StaticBatch(const StaticBatch&) = delete;
+			StaticBatch(StaticBatch&&) = delete;
+			~StaticBatch() = default;
+
+			void AddModel(Model* model, const Matrix4f& transformMatrix = Matrix4f::Identity());
+			void AddSprite(Sprite* sprite, const Matrix4f& transformMatrix = Matrix4f::Identity());
+
+			void AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const override;
+
+			void Clear();
+
+			std::size_t GetBatchCount() const;
+			inline std::size_t GetModelCount() const;
+			inline std::size_t GetSpriteCount() const;
+
+			void Invalidate();
+
+			bool RemoveModel(const Model* model);
+			bool RemoveSprite(const Sprite* sprite);
+
+			StaticBatch& operator=(const StaticBatch&) = delete;
+			StaticBatch& operator=(StaticBatch&&) = delete;
+
+			template<typename... Args> static StaticBatchRef New(Args&&... args);
+
+		private:
+			void BuildBatches() const;
+			void BuildMeshBatches() const;
+			void BuildSpriteBatches() const;
+			inline void EnsureBatchesUpdated() const;
+			void MakeBoundingVolume() const override;
+			void UpdateData(InstanceData* instanceData) const override;
+
+			struct InstanceHeader
+			{
+				Matrix4f transformMatrix; //< Matrix the cached vertices were built with
+				UInt32 revision;
+			};
+
+			struct MeshBatch
+			{
+				Boxf aabb;
+				IndexBufferRef indexBuffer;
+				MaterialRef material;
+				VertexBufferRef vertexBuffer;
+			};
+
+			struct ModelMember
+			{
+				ModelRef model;
+				Matrix4f transformMatrix;
+
+				NazaraSlot(InstancedRenderable, OnInstancedRenderableInvalidateData, onInvalidateDataSlot);
+			};
+
+			struct SpriteBatch
+			{
+				MaterialRef material;
+				std::size_t firstSprite;
+				std::size_t spriteCount;
+				unsigned int textureLayer;
+			};
+
+			struct SpriteMember
+			{
+				SpriteRef sprite;
+				Matrix4f transformMatrix;
+
+				NazaraSlot(InstancedRenderable, OnInstancedRenderableInvalidateData, onInvalidateDataSlot);
+			};
+
+			struct UnbatchedMesh
+			{
+				const StaticMesh* subMesh;
+				const Material* material;
+				Matrix4f transformMatrix;
+			};
+
+			std::vector<ModelMember> m_models;
+			std::vector<SpriteMember> m_sprites;
+			mutable std::vector<MeshBatch> m_meshBatches;
+			mutable std::vector<SpriteBatch> m_spriteBatches;
+			mutable std::vector<UnbatchedMesh> m_unbatchedMeshes;
+			mutable std::vector<VertexStruct_XYZ_Color_UV> m_spriteVertices; //< In the batch space, four per sprite
+			mutable UInt32 m_revision = 0;
+			mutable bool m_batchesUpdated = false;
+	};
+}
+
+#include <Nazara/Graphics/StaticBatch.inl>
+
+#endif // NAZARA_STATICBATCH_HPP
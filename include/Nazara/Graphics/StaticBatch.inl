@@ -0,0 +1,60 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <memory>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the number of models merged by the batch
+	* \return Number of models
+	*/
+
+	inline std::size_t StaticBatch::GetModelCount() const
+	{
+		return m_models.size();
+	}
+
+	/*!
+	* \brief Gets the number of sprites merged by the batch
+	* \return Number of sprites
+	*/
+
+	inline std::size_t StaticBatch::GetSpriteCount() const
+	{
+		return m_sprites.size();
+	}
+
+	/*!
+	* \brief Rebuilds the batches if a member changed since they were built
+	*/
+
+	inline void StaticBatch::EnsureBatchesUpdated() const
+	{
+		if (!m_batchesUpdated)
+		{
+			BuildBatches();
+			m_batchesUpdated = true;
+		}
+	}
+
+	/*!
+	* \brief Creates a new static batch from the arguments
+	* \return A reference to the newly created static batch
+	*
+	* \param args Arguments for the static batch
+	*/
+
+	template<typename... Args>
+	StaticBatchRef StaticBatch::New(Args&&... args)
+	{
+		std::unique_ptr<StaticBatch> object(new StaticBatch(std::forward<Args>(args)...));
+		object->SetPersistent(false);
+
+		return object.release();
+	}
+}
+
+#include <Nazara/Graphics/DebugOff.hpp>
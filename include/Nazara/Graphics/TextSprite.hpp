@@ -52,11 +52,24 @@ namespace Nz
 			template<typename... Args> static TextSpriteRef New(Args&&... args);
 
 		private:
+			bool AppendGlyphs(const AbstractTextDrawer& drawer, std::size_t firstGlyph, std::size_t glyphCount);
 			inline void InvalidateVertices();
 			void MakeBoundingVolume() const override;
 			void OnAtlasInvalidated(const AbstractAtlas* atlas);
 			void OnAtlasLayerChange(const AbstractAtlas* atlas, AbstractImage* oldLayer, AbstractImage* newLayer);
 			void UpdateData(InstanceData* instanceData) const override;
+			void UpdateGlyphs(const AbstractTextDrawer& drawer, std::size_t glyphCount);
+
+			static void MakeGlyphVertices(const AbstractTextDrawer::Glyph& glyph, const Texture* texture, VertexStruct_XY_Color_UV* vertices);
+
+			struct InstanceHeader
+			{
+				Matrix4f transformMatrix; //< Matrix the cached vertices were built with
+				Color color;
+				float scale;
+				UInt32 quadCount;
+				UInt32 revision;
+			};
 
 			struct RenderIndices
 			{
@@ -75,9 +88,12 @@ namespace Nz
 			std::unordered_map<const AbstractAtlas*, AtlasSlots> m_atlases;
 			mutable std::unordered_map<Texture*, RenderIndices> m_renderInfos;
 			mutable std::vector<VertexStruct_XY_Color_UV> m_localVertices;
+			std::vector<UInt32> m_quadRevisions; //< Value of m_revision when each quad was last modified
 			Color m_color;
 			MaterialRef m_material;
 			Recti m_localBounds;
+			UInt32 m_revision;
+			UInt64 m_glyphRevision;
 			mutable bool m_verticesUpdated;
 			float m_scale;
 
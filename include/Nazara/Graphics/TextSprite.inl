@@ -13,6 +13,8 @@ namespace Nz
 
 	inline TextSprite::TextSprite() :
 	m_color(Color::White),
+	m_revision(0),
+	m_glyphRevision(AbstractTextDrawer::InvalidRevision),
 	m_scale(1.f)
 	{
 		SetDefaultMaterial();
@@ -40,9 +42,12 @@ namespace Nz
 	InstancedRenderable(sprite),
 	m_renderInfos(sprite.m_renderInfos),
 	m_localVertices(sprite.m_localVertices),
+	m_quadRevisions(sprite.m_quadRevisions),
 	m_color(sprite.m_color),
 	m_material(sprite.m_material),
 	m_localBounds(sprite.m_localBounds),
+	m_revision(sprite.m_revision),
+	m_glyphRevision(sprite.m_glyphRevision),
 	m_scale(sprite.m_scale)
 	{
 		for (auto it = sprite.m_atlases.begin(); it != sprite.m_atlases.end(); ++it)
@@ -65,7 +70,9 @@ namespace Nz
 		m_atlases.clear();
 		m_boundingVolume.MakeNull();
 		m_localVertices.clear();
+		m_quadRevisions.clear();
 		m_renderInfos.clear();
+		m_glyphRevision = AbstractTextDrawer::InvalidRevision;
 	}
 
 	/*!
@@ -112,21 +119,14 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Sets the default material of the text sprite (just default material)
+	* \brief Sets the default material of the text sprite
+	*
+	* \remark The default material ("Translucent2D" from the material library) is shared by every text sprite, allowing their glyphes to be batched together
 	*/
 
-
 	inline void TextSprite::SetDefaultMaterial()
 	{
-		MaterialRef material = Material::New();
-		material->Enable(RendererParameter_Blend, true);
-		material->Enable(RendererParameter_DepthWrite, false);
-		material->Enable(RendererParameter_FaceCulling, false);
-		material->EnableLighting(false);
-		material->SetDstBlend(BlendFunc_InvSrcAlpha);
-		material->SetSrcBlend(BlendFunc_SrcAlpha);
-
-		SetMaterial(material);
+		SetMaterial(MaterialLibrary::Get("Translucent2D"));
 	}
 
 	/*!
@@ -171,8 +171,12 @@ namespace Nz
 		m_renderInfos = text.m_renderInfos;
 		m_localBounds = text.m_localBounds;
 		m_localVertices = text.m_localVertices;
+		m_glyphRevision = text.m_glyphRevision;
 		m_scale = text.m_scale;
 
+		// Our revision counter is kept, instances already built from this sprite must see every quad as modified
+		m_quadRevisions.assign(text.m_quadRevisions.size(), ++m_revision);
+
 		// Connect to the slots of the new atlases
 		for (auto it = text.m_atlases.begin(); it != text.m_atlases.end(); ++it)
 		{
@@ -11,8 +11,7 @@
 #include <Nazara/Graphics/InstancedRenderable.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
-#include <array>
-#include <set>
+#include <vector>
 
 namespace Nz
 {
@@ -71,20 +70,43 @@ namespace Nz
 			};
 
 		private:
+			struct Chunk;
+
+			void InvalidateTile(std::size_t tileIndex);
+			void InvalidateTiles();
 			void MakeBoundingVolume() const override;
+			void MakeChunks();
+			void UpdateChunk(const Chunk& chunk, const Matrix4f& transformMatrix, UInt32* layerSpriteCounts, VertexStruct_XYZ_Color_UV* vertices) const;
 			void UpdateData(InstanceData* instanceData) const override;
 
 			static bool Initialize();
 			static void Uninitialize();
 
+			struct Chunk
+			{
+				Vector2ui firstTile;
+				Vector2ui tileCount;
+				std::size_t firstVertex;
+				UInt32 revision; //< Value of m_revision when a tile of this chunk was last modified
+			};
+
+			struct InstanceHeader
+			{
+				Matrix4f transformMatrix; //< Matrix the cached vertices were built with
+				UInt32 chunkCount;
+				UInt32 layerCount;
+				UInt32 revision;
+			};
+
 			struct Layer
 			{
 				MaterialRef material;
-				std::set<std::size_t> tiles;
 			};
 
+			std::vector<Chunk> m_chunks;
 			std::vector<Tile> m_tiles;
 			std::vector<Layer> m_layers;
+			UInt32 m_revision;
 			Vector2ui m_mapSize;
 			Vector2f m_tileSize;
 
@@ -24,6 +24,7 @@ namespace Nz
 	inline TileMap::TileMap(const Nz::Vector2ui& mapSize, const Nz::Vector2f& tileSize, std::size_t materialCount) :
 	m_tiles(mapSize.x * mapSize.y),
 	m_layers(materialCount),
+	m_revision(0),
 	m_mapSize(mapSize),
 	m_tileSize(tileSize)
 	{
@@ -34,6 +35,7 @@ namespace Nz
 		for (Layer& layer : m_layers)
 			layer.material = Material::GetDefault();
 
+		MakeChunks();
 		InvalidateBoundingVolume();
 	}
 
@@ -52,8 +54,7 @@ namespace Nz
 		Tile& tile = m_tiles[tileIndex];
 		tile.enabled = false;
 
-		m_layers[tile.layerIndex].tiles.erase(tileIndex);
-
+		InvalidateTile(tileIndex);
 		InvalidateInstanceData(1U << tile.layerIndex);
 	}
 
@@ -65,9 +66,7 @@ namespace Nz
 		for (Tile& tile : m_tiles)
 			tile.enabled = false;
 
-		for (Layer& layer : m_layers)
-			layer.tiles.clear();
-
+		InvalidateTiles();
 		InvalidateInstanceData(0xFFFFFFFF);
 	}
 
@@ -97,7 +96,7 @@ namespace Nz
 			Tile& tile = m_tiles[tileIndex];
 			tile.enabled = false;
 
-			m_layers[tile.layerIndex].tiles.erase(tileIndex);
+			InvalidateTile(tileIndex);
 
 			invalidatedLayers |= 1U << tile.layerIndex;
 
@@ -128,23 +127,17 @@ namespace Nz
 		UInt32 invalidatedLayers = 1U << materialIndex;
 
 		std::size_t tileIndex = tilePos.y * m_mapSize.x + tilePos.x;
-		Tile& tile = m_tiles[tilePos.y * m_mapSize.x + tilePos.x];
-
-		if (!tile.enabled)
-			m_layers[materialIndex].tiles.insert(tileIndex);
-		else if (materialIndex != tile.layerIndex)
-		{
-			m_layers[materialIndex].tiles.erase(tileIndex);
-			m_layers[tile.layerIndex].tiles.insert(tileIndex);
+		Tile& tile = m_tiles[tileIndex];
 
+		if (tile.enabled && materialIndex != tile.layerIndex)
 			invalidatedLayers |= 1U << tile.layerIndex;
-		}
 
 		tile.enabled = true;
 		tile.color = color;
 		tile.textureCoords = coords;
 		tile.layerIndex = materialIndex;
 
+		InvalidateTile(tileIndex);
 		InvalidateInstanceData(invalidatedLayers);
 	}
 
@@ -194,20 +187,15 @@ namespace Nz
 	{
 		NazaraAssert(materialIndex < m_layers.size(), "Material out of bounds");
 
-		for (Layer& layer : m_layers)
-			layer.tiles.clear();
-
-		std::size_t tileIndex = 0;
 		for (Tile& tile : m_tiles)
 		{
 			tile.enabled = true;
 			tile.color = color;
 			tile.textureCoords = coords;
 			tile.layerIndex = materialIndex;
-
-			m_layers[materialIndex].tiles.insert(tileIndex++);
 		}
 
+		InvalidateTiles();
 		InvalidateInstanceData(0xFFFFFFFF);
 	}
 
@@ -264,20 +252,15 @@ namespace Nz
 			std::size_t tileIndex = tilesPos->y * m_mapSize.x + tilesPos->x;
 			Tile& tile = m_tiles[tileIndex];
 
-			if (!tile.enabled)
-				m_layers[materialIndex].tiles.insert(tileIndex);
-			else if (materialIndex != tile.layerIndex)
-			{
-				m_layers[materialIndex].tiles.erase(tileIndex);
-				m_layers[tile.layerIndex].tiles.insert(tileIndex);
-
+			if (tile.enabled && materialIndex != tile.layerIndex)
 				invalidatedLayers |= 1U << tile.layerIndex;
-			}
 
 			tile.enabled = true;
 			tile.color = color;
 			tile.textureCoords = coords;
 			tile.layerIndex = materialIndex;
+
+			InvalidateTile(tileIndex);
 			tilesPos++;
 		}
 
@@ -415,6 +398,10 @@ namespace Nz
 		m_tiles = TileMap.m_tiles;
 		m_tileSize = TileMap.m_tileSize;
 
+		// Our revision counter is kept, instances already built from this TileMap must see every chunk as modified
+		MakeChunks();
+		InvalidateTiles();
+
 		// We do not copy final vertices because it's highly probable that our parameters are modified and they must be regenerated
 		InvalidateBoundingVolume();
 		InvalidateInstanceData(0xFFFFFFFF);
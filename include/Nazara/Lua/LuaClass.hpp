@@ -63,14 +63,14 @@ namespace Nz
 
 		private:
 			using ParentFunc = std::function<void(LuaInstance& lua, T* instance)>;
-			using InstanceGetter = std::function<T*(LuaInstance& lua)>;
+			using InstanceGetter = std::function<T*(void* userdata)>;
 
 			struct ClassInfo
 			{
 				std::vector<ClassFunc> methods;
 				std::vector<ParentFunc> parentGetters;
 				std::vector<StaticFunc> staticMethods;
-				std::unordered_map<String, InstanceGetter> instanceGetters;
+				std::unordered_map<const void*, InstanceGetter> instanceGetters; //< By ClassInfo of the child classes
 				ClassIndexFunc getter;
 				ClassIndexFunc setter;
 				ConstructorFunc constructor;
@@ -91,8 +91,11 @@ namespace Nz
 			static int StaticGetterProxy(lua_State* state);
 			static int StaticMethodProxy(lua_State* state);
 			static int StaticSetterProxy(lua_State* state);
+			static T* TestInstance(const ClassInfo& info, LuaInstance& lua, int index);
 			static int ToStringProxy(lua_State* state);
 
+			static constexpr long long TypeTagField = 1; //< Metatable slot holding the ClassInfo address
+
 			std::map<String, ClassFunc> m_methods;
 			std::map<String, StaticFunc> m_staticMethods;
 			std::shared_ptr<ClassInfo> m_info;
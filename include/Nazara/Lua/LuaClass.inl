@@ -46,9 +46,9 @@ namespace Nz
 
 		std::shared_ptr<typename LuaClass<P>::ClassInfo>& parentInfo = parent.m_info;
 
-		parentInfo->instanceGetters[m_info->name] = [info = m_info, convertFunc] (LuaInstance& lua) -> P*
+		parentInfo->instanceGetters[m_info.get()] = [convertFunc] (void* userdata) -> P*
 		{
-			return convertFunc(static_cast<T*>(lua.CheckUserdata(1, info->name)));
+			return convertFunc(static_cast<T*>(userdata));
 		};
 
 		m_info->parentGetters.emplace_back([parentInfo, convertFunc] (LuaInstance& lua, T* instance)
@@ -86,6 +86,14 @@ namespace Nz
 			lua.PushString(m_info->name);
 			lua.SetField("__type");
 
+			// Instances are identified by the address of the ClassInfo rather than by name, and the metatable
+			// is also indexed by this address in the registry, so proxies never have to hash a string
+			lua.PushLightUserdata(m_info.get());
+			lua.SetRawField(TypeTagField);
+
+			lua.PushValue(-1);
+			lua.SetRawField(m_info.get(), LuaInstance::GetRegistryIndex());
+
 			// In case a __tostring method is missing, add a default implementation returning the type
 			if (m_methods.find("__tostring") == m_methods.end())
 			{
@@ -133,11 +141,6 @@ namespace Nz
 				lua.PushCFunction(MethodProxy, 2);
 				lua.SetField(pair.first); // Method name
 			}
-
-			m_info->instanceGetters[m_info->name] = [info = m_info] (LuaInstance& instance)
-			{
-				return static_cast<T*>(instance.CheckUserdata(1, info->name));
-			};
 		}
 		lua.Pop(); // On pop la metatable
 
@@ -342,7 +345,8 @@ namespace Nz
 			return 0; // Normalement jamais exécuté (l'erreur provoquant une exception)
 		}
 
-		lua.SetMetatable(info->name);
+		lua.GetRawField(info.get(), LuaInstance::GetRegistryIndex());
+		lua.SetMetatable(-2);
 		return 1;
 	}
 
@@ -354,7 +358,10 @@ namespace Nz
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 		const FinalizerFunc& finalizer = info->finalizer;
 
-		T* instance = static_cast<T*>(lua.CheckUserdata(1, info->name));
+		T* instance = TestInstance(*info, lua, 1);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
+
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
 		if (!finalizer || finalizer(lua, *instance))
@@ -385,7 +392,7 @@ namespace Nz
 		if (!getter || !getter(lua, *instance))
 		{
 			// Query from the metatable
-			lua.GetMetatable(info->name); //< Metatable
+			lua.GetRawField(info.get(), LuaInstance::GetRegistryIndex()); //< Metatable
 			lua.PushValue(1); //< Field
 			lua.GetTable(); // Metatable[Field]
 
@@ -412,7 +419,10 @@ namespace Nz
 
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 
-		T* instance = static_cast<T*>(lua.CheckUserdata(1, info->name));
+		T* instance = TestInstance(*info, lua, 1);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
+
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
 		Get(info, lua, instance);
@@ -426,28 +436,15 @@ namespace Nz
 
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 
-		T* instance = nullptr;
-		if (lua.GetMetatable(1))
-		{
-			LuaType type = lua.GetField("__type");
-			if (type == LuaType_String)
-			{
-				String name = lua.ToString(-1);
-				auto it = info->instanceGetters.find(name);
-				if (it != info->instanceGetters.end())
-					instance = it->second(lua);
-			}
-			lua.Pop(2);
-
-			lua.Remove(1); //< Remove the instance from the Lua stack
-		}
-
+		T* instance = TestInstance(*info, lua, 1);
 		if (!instance)
 		{
 			lua.Error("Method cannot be called without an object");
 			return 0;
 		}
 
+		lua.Remove(1); //< Remove the instance from the Lua stack
+
 		unsigned int index = static_cast<unsigned int>(lua.ToInteger(lua.GetIndexOfUpValue(2)));
 		const ClassFunc& method = info->methods[index];
 		return method(lua, *instance);
@@ -461,10 +458,13 @@ namespace Nz
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 		const ClassIndexFunc& setter = info->setter;
 
-		T& instance = *static_cast<T*>(lua.CheckUserdata(1, info->name));
+		T* instance = TestInstance(*info, lua, 1);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
+
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
-		if (!setter(lua, instance))
+		if (!setter(lua, *instance))
 		{
 			std::size_t length;
 			const char* str = lua.ToString(2, &length);
@@ -525,6 +525,26 @@ namespace Nz
 		return 1;
 	}
 
+	template<class T>
+	T* LuaClass<T>::TestInstance(const ClassInfo& info, LuaInstance& lua, int index)
+	{
+		if (!lua.GetMetatable(index))
+			return nullptr;
+
+		lua.GetRawField(TypeTagField);
+		const void* typeTag = lua.ToUserdata(-1);
+		lua.Pop(2);
+
+		if (typeTag == &info)
+			return static_cast<T*>(lua.ToUserdata(index));
+
+		auto it = info.instanceGetters.find(typeTag);
+		if (it != info.instanceGetters.end())
+			return it->second(lua.ToUserdata(index));
+
+		return nullptr;
+	}
+
 	template<class T>
 	int LuaClass<T>::ToStringProxy(lua_State* state)
 	{
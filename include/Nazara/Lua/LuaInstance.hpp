@@ -13,8 +13,12 @@
 #include <Nazara/Core/String.hpp>
 #include <Nazara/Lua/Config.hpp>
 #include <Nazara/Lua/Enums.hpp>
+#include <array>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 struct lua_Debug;
 struct lua_State;
@@ -26,6 +30,21 @@ namespace Nz
 	using LuaCFunction = int (*)(lua_State* state);
 	using LuaFunction = std::function<int(LuaInstance& instance)>;
 
+	struct LuaMemoryStats
+	{
+		UInt64 allocationCount = 0;       //< Blocks allocated or resized by Lua
+		UInt64 freeCount = 0;
+		UInt64 pooledAllocationCount = 0; //< Allocations served by the size class pools
+		std::size_t peakUsage = 0;
+		std::size_t poolCapacity = 0;     //< Memory reserved by the pools, released with the instance
+	};
+
+	struct LuaFunctionSamples
+	{
+		UInt64 exclusiveSamples = 0; //< Samples taken while the function was running
+		UInt64 inclusiveSamples = 0; //< Samples taken while the function was in the call stack
+	};
+
 	class NAZARA_LUA_API LuaInstance
 	{
 		public:
@@ -95,10 +114,16 @@ namespace Nz
 			lua_State* GetInternalState() const;
 			String GetLastError() const;
 			UInt32 GetMemoryLimit() const;
+			const LuaMemoryStats& GetMemoryStats() const;
 			UInt32 GetMemoryUsage() const;
+			const std::unordered_map<String, LuaFunctionSamples>& GetProfilerFunctions() const;
+			String GetProfilerReport() const;
+			UInt64 GetProfilerSampleCount() const;
 			LuaType GetMetatable(const char* tname) const;
 			LuaType GetMetatable(const String& tname) const;
 			bool GetMetatable(int index) const;
+			LuaType GetRawField(long long n, int tableIndex = -1) const;
+			LuaType GetRawField(const void* key, int tableIndex = -1) const;
 			unsigned int GetStackTop() const;
 			LuaType GetTable(int index = -2) const;
 			UInt32 GetTimeLimit() const;
@@ -110,6 +135,7 @@ namespace Nz
 			bool IsOfType(int index, LuaType type) const;
 			bool IsOfType(int index, const char* tname) const;
 			bool IsOfType(int index, const String& tname) const;
+			bool IsProfilerRunning() const;
 			bool IsValid(int index) const;
 
 			long long Length(int index) const;
@@ -150,6 +176,7 @@ namespace Nz
 
 			void Remove(int index) const;
 			void Replace(int index) const;
+			void ResetProfiler();
 
 			void SetField(const char* name, int tableIndex = -2) const;
 			void SetField(const String& name, int tableIndex = -2) const;
@@ -159,9 +186,14 @@ namespace Nz
 			void SetMetatable(const String& tname) const;
 			void SetMetatable(int index) const;
 			void SetMemoryLimit(std::size_t memoryLimit);
+			void SetRawField(long long n, int tableIndex = -2) const;
+			void SetRawField(const void* key, int tableIndex = -2) const;
 			void SetTable(int index = -3) const;
 			void SetTimeLimit(UInt32 timeLimit);
 
+			void StartProfiler(UInt32 instructionInterval = 1000, UInt32 microsecondInterval = 0);
+			void StopProfiler();
+
 			bool ToBoolean(int index) const;
 			long long ToInteger(int index, bool* succeeded = nullptr) const;
 			double ToNumber(int index, bool* succeeded = nullptr) const;
@@ -174,24 +206,51 @@ namespace Nz
 			LuaInstance& operator=(const LuaInstance&) = delete;
 			LuaInstance& operator=(LuaInstance&&) = delete; ///TODO
 
+			static void ClearBytecodeCache();
+			static const String& GetBytecodeCacheDirectory();
 			static int GetIndexOfUpValue(int upValue);
 			static LuaInstance* GetInstance(lua_State* state);
+			static int GetRegistryIndex();
+			static void SetBytecodeCacheDirectory(const String& directory);
 
 		private:
+			void* AllocateBlock(std::size_t size);
 			template<typename T> T CheckBounds(int index, long long value) const;
+			void FreeBlock(void* block, std::size_t size);
+			bool LoadChunk(const void* source, std::size_t size, const String& chunkName);
 			bool Run(int argCount, int resultCount);
+			void TakeProfilerSample(lua_State* state);
+			void UpdateHook();
 
+			static void InstructionHook(lua_State* state, lua_Debug* debug);
 			static void* MemoryAllocator(void *ud, void *ptr, std::size_t osize, std::size_t nsize);
 			static int ProxyFunc(lua_State* state);
-			static void TimeLimiter(lua_State* state, lua_Debug* debug);
 
+			// Lua makes a lot of small allocations (strings, tables, closures), they are served by free lists of 16 bytes size classes
+			static constexpr std::size_t PoolGranularity = 16;
+			static constexpr std::size_t PoolMaxBlockSize = 256;
+			static constexpr std::size_t PoolChunkSize = 8 * 1024;
+
+			std::array<void*, PoolMaxBlockSize / PoolGranularity> m_freeBlocks;
+			std::vector<std::unique_ptr<UInt8[]>> m_poolChunks;
+			LuaMemoryStats m_memoryStats;
+			std::unordered_map<String, LuaFunctionSamples> m_profilerFunctions;
+			std::unordered_map<String, UInt64> m_profilerStacks; //< Sample count by call stack, from the outermost function
+			std::vector<String> m_profilerFrames;
 			std::size_t m_memoryLimit;
 			std::size_t m_memoryUsage;
+			UInt64 m_profilerLastSample;
+			UInt64 m_profilerSampleCount;
+			UInt32 m_profilerInstructionInterval;
+			UInt32 m_profilerMicrosecondInterval;
+			bool m_profilerRunning;
 			UInt32 m_timeLimit;
 			Clock m_clock;
 			String m_lastError;
 			lua_State* m_state;
 			unsigned int m_level;
+
+			static String s_bytecodeCacheDirectory;
 	};
 }
 
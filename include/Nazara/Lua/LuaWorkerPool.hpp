@@ -0,0 +1,77 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Lua scripting module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_LUAWORKERPOOL_HPP
+#define NAZARA_LUAWORKERPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/TaskHandle.hpp>
+#include <Nazara/Lua/Config.hpp>
+#include <Nazara/Lua/LuaInstance.hpp>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	// Runs independent scripts on the TaskScheduler workers, each worker owning its LuaInstance
+	// Jobs get their inputs serialized or through shared immutable data, and send their results back through a queue
+	class NAZARA_LUA_API LuaWorkerPool
+	{
+		public:
+			struct Result;
+			using Initializer = std::function<void(LuaInstance& instance)>;
+
+			LuaWorkerPool(const Initializer& initializer = Initializer());
+			LuaWorkerPool(const LuaWorkerPool&) = delete;
+			LuaWorkerPool(LuaWorkerPool&&) = delete;
+			~LuaWorkerPool();
+
+			TaskHandle Call(const String& functionName, ByteArray input, UInt64 jobId);
+			template<typename F> TaskHandle Dispatch(F job);
+
+			bool Execute(const String& code);
+			bool ExecuteFromFile(const String& filePath);
+
+			inline std::size_t GetInstanceCount() const;
+
+			bool PollResult(Result* result);
+			std::size_t PollResults(std::vector<Result>* results);
+			void PostResult(Result result);
+
+			void WaitForJobs();
+
+			LuaWorkerPool& operator=(const LuaWorkerPool&) = delete;
+			LuaWorkerPool& operator=(LuaWorkerPool&&) = delete;
+
+			struct Result
+			{
+				ByteArray data;         //< Serialized output of the job
+				String error;           //< Error message if the job failed
+				UInt64 jobId = 0;
+				bool succeeded = false;
+			};
+
+		private:
+			void CallFunction(LuaInstance& instance, const String& functionName, const ByteArray& input, UInt64 jobId);
+			LuaInstance& LockInstance();
+			void UnlockInstance(LuaInstance& instance);
+
+			std::vector<std::unique_ptr<LuaInstance>> m_instances; //< One per worker, the last one is shared by the threads outside the scheduler
+			std::deque<Result> m_results;
+			std::vector<TaskHandle> m_jobs;
+			Mutex m_externalMutex;
+			Mutex m_resultMutex;
+	};
+}
+
+#include <Nazara/Lua/LuaWorkerPool.inl>
+
+#endif // NAZARA_LUAWORKERPOOL_HPP
@@ -0,0 +1,33 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Lua scripting module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Lua/Debug.hpp>
+
+namespace Nz
+{
+	// The job is called as job(LuaInstance&) by whichever worker runs it, it should only capture immutable or owned data
+	// Like any task added from outside the workers, it starts once TaskScheduler::Run is called
+	template<typename F>
+	TaskHandle LuaWorkerPool::Dispatch(F job)
+	{
+		TaskHandle handle = TaskScheduler::AddTask([this, job]() mutable
+		{
+			LuaInstance& instance = LockInstance();
+			job(instance);
+			UnlockInstance(instance);
+		});
+
+		m_jobs.push_back(handle);
+
+		return handle;
+	}
+
+	inline std::size_t LuaWorkerPool::GetInstanceCount() const
+	{
+		return m_instances.size();
+	}
+}
+
+#include <Nazara/Lua/DebugOff.hpp>
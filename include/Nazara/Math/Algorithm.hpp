@@ -57,8 +57,8 @@ namespace Nz
 	template<typename T, typename T2> constexpr T Lerp(const T& from, const T& to, const T2& interpolation);
 	template<typename T> constexpr T MultiplyAdd(T x, T y, T z);
 	template<typename T> /*constexpr*/ T NormalizeAngle(T angle);
-	template<typename T> /*constexpr*/ bool NumberEquals(T a, T b);
-	template<typename T> /*constexpr*/ bool NumberEquals(T a, T b, T maxDifference);
+	template<typename T> constexpr bool NumberEquals(T a, T b);
+	template<typename T> constexpr bool NumberEquals(T a, T b, T maxDifference);
 	String NumberToString(long long number, UInt8 radix = 10);
 	template<typename T> constexpr T RadianToDegree(T radians);
 	long long StringToNumber(String str, UInt8 radix = 10, bool* ok = nullptr);
@@ -543,8 +543,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	//TODO: Mark as constexpr when supported by all major compilers
-	/*constexpr*/ inline bool NumberEquals(T a, T b)
+	constexpr bool NumberEquals(T a, T b)
 	{
 		return NumberEquals(a, b, std::numeric_limits<T>::epsilon());
 	}
@@ -560,13 +559,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	//TODO: Mark as constexpr when supported by all major compilers
-	/*constexpr*/ inline bool NumberEquals(T a, T b, T maxDifference)
+	constexpr bool NumberEquals(T a, T b, T maxDifference)
 	{
-		if (b > a)
-			std::swap(a, b);
-
-		T diff = a - b;
+		T diff = (b > a) ? b - a : a - b;
 		return diff <= maxDifference;
 	}
 
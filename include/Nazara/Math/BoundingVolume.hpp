@@ -62,6 +62,7 @@ namespace Nz
 			static BoundingVolume Infinite();
 			static BoundingVolume Lerp(const BoundingVolume& from, const BoundingVolume& to, T interpolation);
 			static BoundingVolume Null();
+			static void TransformBoxes(const T* localCenterX, const T* localCenterY, const T* localCenterZ, const T* localExtentX, const T* localExtentY, const T* localExtentZ, const Matrix4<T>* transformMatrices, std::size_t count, T* centerX, T* centerY, T* centerZ, T* extentX, T* extentY, T* extentZ);
 
 			Extend extend;
 			Box<T> aabb;
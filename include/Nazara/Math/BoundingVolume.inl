@@ -7,6 +7,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
@@ -383,6 +384,8 @@ namespace Nz
 	/*!
 	* \brief Updates the obb and the aabb of the bounding volume
 	*
+	* The aabb is computed from the center and the extents of the local box (Arvo's method) rather than from the corners of the obb
+	*
 	* \param transformMatrix Matrix4 which represents the transformation to apply
 	*/
 
@@ -391,9 +394,15 @@ namespace Nz
 	{
 		obb.Update(transformMatrix);
 
-		aabb.Set(obb(0), obb(1));
-		for (unsigned int i = 2; i < 8; ++i)
-			aabb.ExtendTo(obb(i));
+		Vector3<T> center = transformMatrix.Transform(obb.localBox.GetCenter());
+		Vector3<T> halfLengths = obb.localBox.GetLengths() / F(2.0);
+
+		// Each extent of the aabb is the sum of the local extents projected on its axis
+		Vector3<T> extents(std::abs(transformMatrix.m11) * halfLengths.x + std::abs(transformMatrix.m21) * halfLengths.y + std::abs(transformMatrix.m31) * halfLengths.z,
+		                   std::abs(transformMatrix.m12) * halfLengths.x + std::abs(transformMatrix.m22) * halfLengths.y + std::abs(transformMatrix.m32) * halfLengths.z,
+		                   std::abs(transformMatrix.m13) * halfLengths.x + std::abs(transformMatrix.m23) * halfLengths.y + std::abs(transformMatrix.m33) * halfLengths.z);
+
+		aabb.Set(center - extents, center + extents);
 	}
 
 	/*!
@@ -407,9 +416,7 @@ namespace Nz
 	{
 		obb.Update(translation);
 
-		aabb.Set(obb(0), obb(1));
-		for (unsigned int i = 2; i < 8; ++i)
-			aabb.ExtendTo(obb(i));
+		aabb.Set(obb.localBox.x + translation.x, obb.localBox.y + translation.y, obb.localBox.z + translation.z, obb.localBox.width, obb.localBox.height, obb.localBox.depth);
 	}
 
 	/*!
@@ -593,6 +600,53 @@ namespace Nz
 		return volume;
 	}
 
+	/*!
+	* \brief Computes the aabbs of a set of transformed boxes
+	*
+	* The boxes are given and computed as structures of arrays, as Frustum::CullBoxes takes them, and only their aabb is computed (see Update)
+	*
+	* \param localCenterX X components of the local box centers
+	* \param localCenterY Y components of the local box centers
+	* \param localCenterZ Z components of the local box centers
+	* \param localExtentX Half widths of the local boxes
+	* \param localExtentY Half heights of the local boxes
+	* \param localExtentZ Half depths of the local boxes
+	* \param transformMatrices Transformation of each box
+	* \param count Number of boxes
+	* \param centerX X components of the aabb centers
+	* \param centerY Y components of the aabb centers
+	* \param centerZ Z components of the aabb centers
+	* \param extentX Half widths of the aabbs
+	* \param extentY Half heights of the aabbs
+	* \param extentZ Half depths of the aabbs
+	*
+	* \remark The output arrays can be the input ones
+	*/
+
+	template<typename T>
+	void BoundingVolume<T>::TransformBoxes(const T* localCenterX, const T* localCenterY, const T* localCenterZ, const T* localExtentX, const T* localExtentY, const T* localExtentZ, const Matrix4<T>* transformMatrices, std::size_t count, T* centerX, T* centerY, T* centerZ, T* extentX, T* extentY, T* extentZ)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const Matrix4<T>& matrix = transformMatrices[i];
+
+			T cx = localCenterX[i];
+			T cy = localCenterY[i];
+			T cz = localCenterZ[i];
+			T ex = localExtentX[i];
+			T ey = localExtentY[i];
+			T ez = localExtentZ[i];
+
+			centerX[i] = matrix.m11 * cx + matrix.m21 * cy + matrix.m31 * cz + matrix.m41;
+			centerY[i] = matrix.m12 * cx + matrix.m22 * cy + matrix.m32 * cz + matrix.m42;
+			centerZ[i] = matrix.m13 * cx + matrix.m23 * cy + matrix.m33 * cz + matrix.m43;
+
+			extentX[i] = std::abs(matrix.m11) * ex + std::abs(matrix.m21) * ey + std::abs(matrix.m31) * ez;
+			extentY[i] = std::abs(matrix.m12) * ex + std::abs(matrix.m22) * ey + std::abs(matrix.m32) * ez;
+			extentZ[i] = std::abs(matrix.m13) * ex + std::abs(matrix.m23) * ey + std::abs(matrix.m33) * ez;
+		}
+	}
+
 	/*!
 	* \brief Serializes a BoundingVolume
 	* \return true if successfully serialized
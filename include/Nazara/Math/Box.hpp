@@ -23,71 +23,71 @@ namespace Nz
 	{
 		public:
 			Box() = default;
-			Box(T Width, T Height, T Depth);
-			Box(T X, T Y, T Z, T Width, T Height, T Depth);
-			Box(const T box[6]);
-			Box(const Rect<T>& rect);
-			Box(const Vector3<T>& lengths);
-			Box(const Vector3<T>& vec1, const Vector3<T>& vec2);
-			template<typename U> explicit Box(const Box<U>& box);
+			constexpr Box(T Width, T Height, T Depth);
+			constexpr Box(T X, T Y, T Z, T Width, T Height, T Depth);
+			constexpr Box(const T box[6]);
+			constexpr Box(const Rect<T>& rect);
+			constexpr Box(const Vector3<T>& lengths);
+			constexpr Box(const Vector3<T>& vec1, const Vector3<T>& vec2);
+			template<typename U> constexpr explicit Box(const Box<U>& box);
 			Box(const Box& box) = default;
 			~Box() = default;
 
-			bool Contains(T X, T Y, T Z) const;
-			bool Contains(const Box& box) const;
-			bool Contains(const Vector3<T>& point) const;
+			constexpr bool Contains(T X, T Y, T Z) const;
+			constexpr bool Contains(const Box& box) const;
+			constexpr bool Contains(const Vector3<T>& point) const;
 
-			Box& ExtendTo(T X, T Y, T Z);
-			Box& ExtendTo(const Box& box);
-			Box& ExtendTo(const Vector3<T>& point);
+			constexpr Box& ExtendTo(T X, T Y, T Z);
+			constexpr Box& ExtendTo(const Box& box);
+			constexpr Box& ExtendTo(const Vector3<T>& point);
 
 			Sphere<T> GetBoundingSphere() const;
-			Vector3<T> GetCenter() const;
+			constexpr Vector3<T> GetCenter() const;
 			Vector3<T> GetCorner(BoxCorner corner) const;
-			Vector3<T> GetLengths() const;
-			Vector3<T> GetMaximum() const;
-			Vector3<T> GetMinimum() const;
-			Vector3<T> GetNegativeVertex(const Vector3<T>& normal) const;
-			Vector3<T> GetPosition() const;
-			Vector3<T> GetPositiveVertex(const Vector3<T>& normal) const;
+			constexpr Vector3<T> GetLengths() const;
+			constexpr Vector3<T> GetMaximum() const;
+			constexpr Vector3<T> GetMinimum() const;
+			constexpr Vector3<T> GetNegativeVertex(const Vector3<T>& normal) const;
+			constexpr Vector3<T> GetPosition() const;
+			constexpr Vector3<T> GetPositiveVertex(const Vector3<T>& normal) const;
 			T GetRadius() const;
 			Sphere<T> GetSquaredBoundingSphere() const;
-			T GetSquaredRadius() const;
+			constexpr T GetSquaredRadius() const;
 
-			bool Intersect(const Box& box, Box* intersection = nullptr) const;
+			constexpr bool Intersect(const Box& box, Box* intersection = nullptr) const;
 
-			bool IsValid() const;
+			constexpr bool IsValid() const;
 
-			Box& MakeZero();
+			constexpr Box& MakeZero();
 
-			Box& Set(T Width, T Height, T Depth);
-			Box& Set(T X, T Y, T Z, T Width, T Height, T Depth);
-			Box& Set(const T box[6]);
-			Box& Set(const Box& box);
-			Box& Set(const Rect<T>& rect);
-			Box& Set(const Vector3<T>& lengths);
-			Box& Set(const Vector3<T>& vec1, const Vector3<T>& vec2);
-			template<typename U> Box& Set(const Box<U>& box);
+			constexpr Box& Set(T Width, T Height, T Depth);
+			constexpr Box& Set(T X, T Y, T Z, T Width, T Height, T Depth);
+			constexpr Box& Set(const T box[6]);
+			constexpr Box& Set(const Box& box);
+			constexpr Box& Set(const Rect<T>& rect);
+			constexpr Box& Set(const Vector3<T>& lengths);
+			constexpr Box& Set(const Vector3<T>& vec1, const Vector3<T>& vec2);
+			template<typename U> constexpr Box& Set(const Box<U>& box);
 
 			String ToString() const;
 
 			Box& Transform(const Matrix4<T>& matrix, bool applyTranslation = true);
-			Box& Translate(const Vector3<T>& translation);
+			constexpr Box& Translate(const Vector3<T>& translation);
 
 			T& operator[](unsigned int i);
 			T operator[](unsigned int i) const;
 
-			Box operator*(T scalar) const;
-			Box operator*(const Vector3<T>& vec) const;
+			constexpr Box operator*(T scalar) const;
+			constexpr Box operator*(const Vector3<T>& vec) const;
 
-			Box& operator*=(T scalar);
-			Box& operator*=(const Vector3<T>& vec);
+			constexpr Box& operator*=(T scalar);
+			constexpr Box& operator*=(const Vector3<T>& vec);
 
-			bool operator==(const Box& box) const;
-			bool operator!=(const Box& box) const;
+			constexpr bool operator==(const Box& box) const;
+			constexpr bool operator!=(const Box& box) const;
 
-			static Box Lerp(const Box& from, const Box& to, T interpolation);
-			static Box Zero();
+			static constexpr Box Lerp(const Box& from, const Box& to, T interpolation);
+			static constexpr Box Zero();
 
 			T x, y, z, width, height, depth;
 	};
@@ -30,9 +30,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(T Width, T Height, T Depth)
+	constexpr Box<T>::Box(T Width, T Height, T Depth) :
+	x(F(0.0)),
+	y(F(0.0)),
+	z(F(0.0)),
+	width(Width),
+	height(Height),
+	depth(Depth)
 	{
-		Set(Width, Height, Depth);
 	}
 
 	/*!
@@ -47,9 +52,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(T X, T Y, T Z, T Width, T Height, T Depth)
+	constexpr Box<T>::Box(T X, T Y, T Z, T Width, T Height, T Depth) :
+	x(X),
+	y(Y),
+	z(Z),
+	width(Width),
+	height(Height),
+	depth(Depth)
 	{
-		Set(X, Y, Z, Width, Height, Depth);
 	}
 
 	/*!
@@ -59,9 +69,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(const T vec[6])
+	constexpr Box<T>::Box(const T vec[6]) :
+	x(vec[0]),
+	y(vec[1]),
+	z(vec[2]),
+	width(vec[3]),
+	height(vec[4]),
+	depth(vec[5])
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -73,9 +88,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(const Rect<T>& rect)
+	constexpr Box<T>::Box(const Rect<T>& rect) :
+	x(rect.x),
+	y(rect.y),
+	z(F(0.0)),
+	width(rect.width),
+	height(rect.height),
+	depth(F(1.0))
 	{
-		Set(rect);
 	}
 
 	/*!
@@ -87,9 +107,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(const Vector3<T>& lengths)
+	constexpr Box<T>::Box(const Vector3<T>& lengths) :
+	x(F(0.0)),
+	y(F(0.0)),
+	z(F(0.0)),
+	width(lengths.x),
+	height(lengths.y),
+	depth(lengths.z)
 	{
-		Set(lengths);
 	}
 
 	/*!
@@ -101,9 +126,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>::Box(const Vector3<T>& vec1, const Vector3<T>& vec2)
+	constexpr Box<T>::Box(const Vector3<T>& vec1, const Vector3<T>& vec2) :
+	x(std::min(vec1.x, vec2.x)),
+	y(std::min(vec1.y, vec2.y)),
+	z(std::min(vec1.z, vec2.z)),
+	width((vec2.x > vec1.x) ? vec2.x - vec1.x : vec1.x - vec2.x),
+	height((vec2.y > vec1.y) ? vec2.y - vec1.y : vec1.y - vec2.y),
+	depth((vec2.z > vec1.z) ? vec2.z - vec1.z : vec1.z - vec2.z)
 	{
-		Set(vec1, vec2);
 	}
 
 	/*!
@@ -114,9 +144,14 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Box<T>::Box(const Box<U>& box)
+	constexpr Box<T>::Box(const Box<U>& box) :
+	x(F(box.x)),
+	y(F(box.y)),
+	z(F(box.z)),
+	width(F(box.width)),
+	height(F(box.height)),
+	depth(F(box.depth))
 	{
-		Set(box);
 	}
 
 	/*!
@@ -131,7 +166,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::Contains(T X, T Y, T Z) const
+	constexpr bool Box<T>::Contains(T X, T Y, T Z) const
 	{
 		return X >= x && X <= x + width &&
 		       Y >= y && Y <= y + height &&
@@ -148,7 +183,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::Contains(const Box<T>& box) const
+	constexpr bool Box<T>::Contains(const Box<T>& box) const
 	{
 		return Contains(box.x, box.y, box.z) &&
 		       Contains(box.x + box.width, box.y + box.height, box.z + box.depth);
@@ -164,7 +199,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::Contains(const Vector3<T>& point) const
+	constexpr bool Box<T>::Contains(const Vector3<T>& point) const
 	{
 		return Contains(point.x, point.y, point.z);
 	}
@@ -181,7 +216,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::ExtendTo(T X, T Y, T Z)
+	constexpr Box<T>& Box<T>::ExtendTo(T X, T Y, T Z)
 	{
 		width = std::max(x + width, X);
 		height = std::max(y + height, Y);
@@ -208,7 +243,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::ExtendTo(const Box& box)
+	constexpr Box<T>& Box<T>::ExtendTo(const Box& box)
 	{
 		width = std::max(x + width, box.x + box.width);
 		height = std::max(y + height, box.y + box.height);
@@ -235,7 +270,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::ExtendTo(const Vector3<T>& point)
+	constexpr Box<T>& Box<T>::ExtendTo(const Vector3<T>& point)
 	{
 		return ExtendTo(point.x, point.y, point.z);
 	}
@@ -259,7 +294,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetCenter() const
+	constexpr Vector3<T> Box<T>::GetCenter() const
 	{
 		return GetPosition() + GetLengths() / F(2.0);
 	}
@@ -313,7 +348,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetLengths() const
+	constexpr Vector3<T> Box<T>::GetLengths() const
 	{
 		return Vector3<T>(width, height, depth);
 	}
@@ -326,7 +361,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetMaximum() const
+	constexpr Vector3<T> Box<T>::GetMaximum() const
 	{
 		return GetPosition() + GetLengths();
 	}
@@ -339,7 +374,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetMinimum() const
+	constexpr Vector3<T> Box<T>::GetMinimum() const
 	{
 		return GetPosition();
 	}
@@ -354,7 +389,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetNegativeVertex(const Vector3<T>& normal) const
+	constexpr Vector3<T> Box<T>::GetNegativeVertex(const Vector3<T>& normal) const
 	{
 		Vector3<T> neg(GetPosition());
 
@@ -378,7 +413,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetPosition() const
+	constexpr Vector3<T> Box<T>::GetPosition() const
 	{
 		return Vector3<T>(x, y, z);
 	}
@@ -393,7 +428,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector3<T> Box<T>::GetPositiveVertex(const Vector3<T>& normal) const
+	constexpr Vector3<T> Box<T>::GetPositiveVertex(const Vector3<T>& normal) const
 	{
 		Vector3<T> pos(GetPosition());
 
@@ -439,7 +474,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Box<T>::GetSquaredRadius() const
+	constexpr T Box<T>::GetSquaredRadius() const
 	{
 		Vector3<T> size(GetLengths());
 		size /= F(2.0); // The size only depends on the lengths and not the center
@@ -456,7 +491,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::Intersect(const Box& box, Box* intersection) const
+	constexpr bool Box<T>::Intersect(const Box& box, Box* intersection) const
 	{
 		T left = std::max(x, box.x);
 		T right = std::min(x + width, box.x + box.width);
@@ -492,7 +527,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::IsValid() const
+	constexpr bool Box<T>::IsValid() const
 	{
 		return width > F(0.0) && height > F(0.0) && depth > F(0.0);
 	}
@@ -505,7 +540,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::MakeZero()
+	constexpr Box<T>& Box<T>::MakeZero()
 	{
 		x = F(0.0);
 		y = F(0.0);
@@ -529,7 +564,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(T Width, T Height, T Depth)
+	constexpr Box<T>& Box<T>::Set(T Width, T Height, T Depth)
 	{
 		x = F(0.0);
 		y = F(0.0);
@@ -553,7 +588,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(T X, T Y, T Z, T Width, T Height, T Depth)
+	constexpr Box<T>& Box<T>::Set(T X, T Y, T Z, T Width, T Height, T Depth)
 	{
 		x = X;
 		y = Y;
@@ -573,7 +608,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(const T box[6])
+	constexpr Box<T>& Box<T>::Set(const T box[6])
 	{
 		x = box[0];
 		y = box[1];
@@ -593,9 +628,14 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(const Box& box)
+	constexpr Box<T>& Box<T>::Set(const Box& box)
 	{
-		std::memcpy(this, &box, sizeof(Box));
+		x = box.x;
+		y = box.y;
+		z = box.z;
+		width = box.width;
+		height = box.height;
+		depth = box.depth;
 
 		return *this;
 	}
@@ -610,7 +650,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(const Rect<T>& rect)
+	constexpr Box<T>& Box<T>::Set(const Rect<T>& rect)
 	{
 		x = rect.x;
 		y = rect.y;
@@ -632,7 +672,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(const Vector3<T>& lengths)
+	constexpr Box<T>& Box<T>::Set(const Vector3<T>& lengths)
 	{
 		return Set(lengths.x, lengths.y, lengths.z);
 	}
@@ -647,7 +687,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Set(const Vector3<T>& vec1, const Vector3<T>& vec2)
+	constexpr Box<T>& Box<T>::Set(const Vector3<T>& vec1, const Vector3<T>& vec2)
 	{
 		x = std::min(vec1.x, vec2.x);
 		y = std::min(vec1.y, vec2.y);
@@ -668,7 +708,7 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Box<T>& Box<T>::Set(const Box<U>& box)
+	constexpr Box<T>& Box<T>::Set(const Box<U>& box)
 	{
 		x = F(box.x);
 		y = F(box.y);
@@ -722,7 +762,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::Translate(const Vector3<T>& translation)
+	constexpr Box<T>& Box<T>::Translate(const Vector3<T>& translation)
 	{
 		x += translation.x;
 		y += translation.y;
@@ -791,7 +831,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T> Box<T>::operator*(T scalar) const
+	constexpr Box<T> Box<T>::operator*(T scalar) const
 	{
 		return Box(x, y, z, width * scalar, height * scalar, depth * scalar);
 	}
@@ -804,7 +844,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T> Box<T>::operator*(const Vector3<T>& vec) const
+	constexpr Box<T> Box<T>::operator*(const Vector3<T>& vec) const
 	{
 		return Box(x, y, z, width * vec.x, height * vec.y, depth * vec.z);
 	}
@@ -817,7 +857,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::operator*=(T scalar)
+	constexpr Box<T>& Box<T>::operator*=(T scalar)
 	{
 		width *= scalar;
 		height *= scalar;
@@ -834,7 +874,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T>& Box<T>::operator*=(const Vector3<T>& vec)
+	constexpr Box<T>& Box<T>::operator*=(const Vector3<T>& vec)
 	{
 		width *= vec.x;
 		height *= vec.y;
@@ -851,7 +891,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::operator==(const Box& box) const
+	constexpr bool Box<T>::operator==(const Box& box) const
 	{
 		return NumberEquals(x, box.x) && NumberEquals(y, box.y) && NumberEquals(z, box.z) &&
 		       NumberEquals(width, box.width) && NumberEquals(height, box.height) && NumberEquals(depth, box.depth);
@@ -865,7 +905,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Box<T>::operator!=(const Box& box) const
+	constexpr bool Box<T>::operator!=(const Box& box) const
 	{
 		return !operator==(box);
 	}
@@ -885,7 +925,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T> Box<T>::Lerp(const Box& from, const Box& to, T interpolation)
+	constexpr Box<T> Box<T>::Lerp(const Box& from, const Box& to, T interpolation)
 	{
 		#ifdef NAZARA_DEBUG
 		if (interpolation < F(0.0) || interpolation > F(1.0))
@@ -895,15 +935,8 @@ namespace Nz
 		}
 		#endif
 
-		Box box;
-		box.x = Nz::Lerp(from.x, to.x, interpolation);
-		box.y = Nz::Lerp(from.y, to.y, interpolation);
-		box.z = Nz::Lerp(from.z, to.z, interpolation);
-		box.width = Nz::Lerp(from.width, to.width, interpolation);
-		box.height = Nz::Lerp(from.height, to.height, interpolation);
-		box.depth = Nz::Lerp(from.depth, to.depth, interpolation);
-
-		return box;
+		return Box(Nz::Lerp(from.x, to.x, interpolation), Nz::Lerp(from.y, to.y, interpolation), Nz::Lerp(from.z, to.z, interpolation),
+		           Nz::Lerp(from.width, to.width, interpolation), Nz::Lerp(from.height, to.height, interpolation), Nz::Lerp(from.depth, to.depth, interpolation));
 	}
 
 	/*!
@@ -914,12 +947,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Box<T> Box<T>::Zero()
+	constexpr Box<T> Box<T>::Zero()
 	{
-		Box box;
-		box.MakeZero();
-
-		return box;
+		return Box(F(0.0), F(0.0), F(0.0), F(0.0), F(0.0), F(0.0));
 	}
 
 	/*!
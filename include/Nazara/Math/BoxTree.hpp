@@ -0,0 +1,98 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Mathematics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_BOXTREE_HPP
+#define NAZARA_BOXTREE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Sphere.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	template<typename T>
+	class BoxTree
+	{
+		public:
+			BoxTree(T margin = T(0.1));
+			BoxTree(const BoxTree& tree) = default;
+			BoxTree(BoxTree&& tree) = default;
+			~BoxTree() = default;
+
+			void Clear();
+
+			const Box<T>& GetBounds() const;
+			const Box<T>& GetFatBox(std::size_t proxy) const;
+			unsigned int GetHeight() const;
+			T GetMargin() const;
+			std::size_t GetProxyCount() const;
+			std::size_t GetUserData(std::size_t proxy) const;
+
+			std::size_t Insert(const Box<T>& box, std::size_t userData);
+
+			bool IsEmpty() const;
+
+			bool Move(std::size_t proxy, const Box<T>& box);
+
+			template<typename Callback> void Query(const Box<T>& box, Callback&& callback) const;
+			template<typename Callback> void Query(const Frustum<T>& frustum, Callback&& callback) const;
+			template<typename Callback> void Query(const Sphere<T>& sphere, Callback&& callback) const;
+
+			void Remove(std::size_t proxy);
+
+			void SetMargin(T margin);
+			void SetUserData(std::size_t proxy, std::size_t userData);
+
+			BoxTree& operator=(const BoxTree& tree) = default;
+			BoxTree& operator=(BoxTree&& tree) = default;
+
+			static constexpr std::size_t InvalidProxy = std::numeric_limits<std::size_t>::max();
+
+		private:
+			struct Node
+			{
+				Box<T> box; //< Fat box for the leaves
+				std::size_t left;
+				std::size_t right;
+				std::size_t parent; //< Next free node once released
+				std::size_t userData;
+				int height; //< -1 once released
+
+				bool IsLeaf() const;
+			};
+
+			std::size_t AllocateNode();
+			std::size_t Balance(std::size_t index);
+			Box<T> Fatten(const Box<T>& box) const;
+			void InsertLeaf(std::size_t leaf);
+			template<typename Callback> void QueryNode(std::size_t index, const Box<T>& box, Callback& callback) const;
+			template<typename Callback> void QueryNode(std::size_t index, const Frustum<T>& frustum, Callback& callback) const;
+			template<typename Callback> void QueryNode(std::size_t index, const Sphere<T>& sphere, Callback& callback) const;
+			void ReleaseNode(std::size_t index);
+			void RemoveLeaf(std::size_t leaf);
+			template<typename Callback> void ReportSubtree(std::size_t index, Callback& callback) const;
+			void UpdateNode(std::size_t index);
+
+			static T ComputeSurface(const Box<T>& box);
+			static Box<T> Merge(const Box<T>& first, const Box<T>& second);
+
+			std::vector<Node> m_nodes;
+			std::size_t m_freeList;
+			std::size_t m_proxyCount;
+			std::size_t m_root;
+			T m_margin;
+	};
+
+	typedef BoxTree<double> BoxTreed;
+	typedef BoxTree<float> BoxTreef;
+}
+
+#include <Nazara/Math/BoxTree.inl>
+
+#endif // NAZARA_BOXTREE_HPP
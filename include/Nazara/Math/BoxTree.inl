@@ -0,0 +1,656 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Mathematics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+#define F(a) static_cast<T>(a)
+
+namespace Nz
+{
+	/*!
+	* \ingroup math
+	* \class Nz::BoxTree
+	* \brief Math class that represents a dynamic bounding volume hierarchy of axis-aligned boxes
+	*
+	* Each box (proxy) is stored enlarged by a margin, moving it inside of its enlarged box doesn't change the tree.
+	* Insertions choose the sibling increasing the least the surface of the tree and rotations keep it balanced, so the queries visit a logarithmic number of nodes.
+	*/
+
+	/*!
+	* \brief Constructs an empty BoxTree object
+	*
+	* \param margin Fraction of the largest length of a box added on each side of it
+	*/
+
+	template<typename T>
+	BoxTree<T>::BoxTree(T margin) :
+	m_freeList(InvalidProxy),
+	m_proxyCount(0),
+	m_root(InvalidProxy),
+	m_margin(margin)
+	{
+	}
+
+	/*!
+	* \brief Removes every proxy of the tree
+	*/
+
+	template<typename T>
+	void BoxTree<T>::Clear()
+	{
+		m_nodes.clear();
+		m_freeList = InvalidProxy;
+		m_proxyCount = 0;
+		m_root = InvalidProxy;
+	}
+
+	/*!
+	* \brief Gets a box containing every proxy of the tree
+	* \return Union of the enlarged boxes
+	*
+	* \remark Produces a NazaraAssert if the tree is empty
+	*/
+
+	template<typename T>
+	const Box<T>& BoxTree<T>::GetBounds() const
+	{
+		NazaraAssert(m_root != InvalidProxy, "Tree is empty");
+
+		return m_nodes[m_root].box;
+	}
+
+	/*!
+	* \brief Gets the enlarged box of a proxy
+	* \return Box stored in the tree, containing the last box of the proxy
+	*
+	* \param proxy Proxy returned by Insert
+	*/
+
+	template<typename T>
+	const Box<T>& BoxTree<T>::GetFatBox(std::size_t proxy) const
+	{
+		NazaraAssert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid proxy");
+
+		return m_nodes[proxy].box;
+	}
+
+	/*!
+	* \brief Gets the height of the tree
+	* \return Number of levels under the root, zero if the tree holds less than two proxies
+	*/
+
+	template<typename T>
+	unsigned int BoxTree<T>::GetHeight() const
+	{
+		return (m_root != InvalidProxy) ? static_cast<unsigned int>(m_nodes[m_root].height) : 0U;
+	}
+
+	/*!
+	* \brief Gets the margin of the tree
+	* \return Fraction of the largest length of a box added on each side of it
+	*/
+
+	template<typename T>
+	T BoxTree<T>::GetMargin() const
+	{
+		return m_margin;
+	}
+
+	/*!
+	* \brief Gets the number of proxies of the tree
+	* \return Proxy count
+	*/
+
+	template<typename T>
+	std::size_t BoxTree<T>::GetProxyCount() const
+	{
+		return m_proxyCount;
+	}
+
+	/*!
+	* \brief Gets the user data of a proxy
+	* \return Value given to Insert or SetUserData
+	*
+	* \param proxy Proxy returned by Insert
+	*/
+
+	template<typename T>
+	std::size_t BoxTree<T>::GetUserData(std::size_t proxy) const
+	{
+		NazaraAssert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid proxy");
+
+		return m_nodes[proxy].userData;
+	}
+
+	/*!
+	* \brief Inserts a box in the tree
+	* \return Proxy identifying the box until its removal
+	*
+	* \param box Box to insert
+	* \param userData Value given to the callbacks of the queries
+	*/
+
+	template<typename T>
+	std::size_t BoxTree<T>::Insert(const Box<T>& box, std::size_t userData)
+	{
+		std::size_t proxy = AllocateNode();
+
+		Node& node = m_nodes[proxy];
+		node.box = Fatten(box);
+		node.userData = userData;
+		node.height = 0;
+
+		InsertLeaf(proxy);
+		m_proxyCount++;
+
+		return proxy;
+	}
+
+	/*!
+	* \brief Checks whether the tree holds no proxy
+	* \return true if empty
+	*/
+
+	template<typename T>
+	bool BoxTree<T>::IsEmpty() const
+	{
+		return m_root == InvalidProxy;
+	}
+
+	/*!
+	* \brief Updates the box of a proxy
+	* \return true if the proxy had to be moved in the tree
+	*
+	* \param proxy Proxy returned by Insert
+	* \param box New box of the proxy
+	*
+	* \remark Nothing changes as long as the box stays inside of the enlarged box of the proxy
+	*/
+
+	template<typename T>
+	bool BoxTree<T>::Move(std::size_t proxy, const Box<T>& box)
+	{
+		NazaraAssert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid proxy");
+
+		if (m_nodes[proxy].box.Contains(box))
+			return false;
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].box = Fatten(box);
+		InsertLeaf(proxy);
+
+		return true;
+	}
+
+	/*!
+	* \brief Calls a function with the user data of the proxies intersecting a box
+	*
+	* \param box Box to test
+	* \param callback Function taking the user data of a proxy
+	*
+	* \remark The enlarged boxes are tested, some proxies may be slightly out of the box
+	*/
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::Query(const Box<T>& box, Callback&& callback) const
+	{
+		if (m_root != InvalidProxy)
+			QueryNode(m_root, box, callback);
+	}
+
+	/*!
+	* \brief Calls a function with the user data of the proxies intersecting a frustum
+	*
+	* \param frustum Frustum to test
+	* \param callback Function taking the user data of a proxy
+	*
+	* \remark The enlarged boxes are tested, some proxies may be slightly out of the frustum
+	*/
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::Query(const Frustum<T>& frustum, Callback&& callback) const
+	{
+		if (m_root != InvalidProxy)
+			QueryNode(m_root, frustum, callback);
+	}
+
+	/*!
+	* \brief Calls a function with the user data of the proxies intersecting a sphere
+	*
+	* \param sphere Sphere to test
+	* \param callback Function taking the user data of a proxy
+	*
+	* \remark The enlarged boxes are tested, some proxies may be slightly out of the sphere
+	*/
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::Query(const Sphere<T>& sphere, Callback&& callback) const
+	{
+		if (m_root != InvalidProxy)
+			QueryNode(m_root, sphere, callback);
+	}
+
+	/*!
+	* \brief Removes a proxy from the tree
+	*
+	* \param proxy Proxy returned by Insert, which may be reused by the next insertions
+	*/
+
+	template<typename T>
+	void BoxTree<T>::Remove(std::size_t proxy)
+	{
+		NazaraAssert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid proxy");
+
+		RemoveLeaf(proxy);
+		ReleaseNode(proxy);
+		m_proxyCount--;
+	}
+
+	/*!
+	* \brief Sets the margin of the tree
+	*
+	* \param margin Fraction of the largest length of a box added on each side of it
+	*
+	* \remark Only applies to the boxes inserted or moved afterwards
+	*/
+
+	template<typename T>
+	void BoxTree<T>::SetMargin(T margin)
+	{
+		m_margin = margin;
+	}
+
+	/*!
+	* \brief Sets the user data of a proxy
+	*
+	* \param proxy Proxy returned by Insert
+	* \param userData Value given to the callbacks of the queries
+	*/
+
+	template<typename T>
+	void BoxTree<T>::SetUserData(std::size_t proxy, std::size_t userData)
+	{
+		NazaraAssert(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid proxy");
+
+		m_nodes[proxy].userData = userData;
+	}
+
+	template<typename T>
+	constexpr std::size_t BoxTree<T>::InvalidProxy;
+
+	template<typename T>
+	bool BoxTree<T>::Node::IsLeaf() const
+	{
+		return height == 0;
+	}
+
+	template<typename T>
+	std::size_t BoxTree<T>::AllocateNode()
+	{
+		std::size_t index;
+		if (m_freeList != InvalidProxy)
+		{
+			index = m_freeList;
+			m_freeList = m_nodes[index].parent;
+		}
+		else
+		{
+			index = m_nodes.size();
+			m_nodes.emplace_back();
+		}
+
+		Node& node = m_nodes[index];
+		node.left = InvalidProxy;
+		node.right = InvalidProxy;
+		node.parent = InvalidProxy;
+		node.height = 0;
+
+		return index;
+	}
+
+	template<typename T>
+	std::size_t BoxTree<T>::Balance(std::size_t index)
+	{
+		// Rotates the highest child of the node above it when the heights of its children differ by more than one
+		Node& a = m_nodes[index];
+		if (a.IsLeaf() || a.height < 2)
+			return index;
+
+		std::size_t indexB = a.left;
+		std::size_t indexC = a.right;
+		Node& b = m_nodes[indexB];
+		Node& c = m_nodes[indexC];
+
+		int balance = c.height - b.height;
+		if (balance > 1)
+		{
+			std::size_t indexF = c.left;
+			std::size_t indexG = c.right;
+			Node& f = m_nodes[indexF];
+			Node& g = m_nodes[indexG];
+
+			c.left = index;
+			c.parent = a.parent;
+			a.parent = indexC;
+
+			if (c.parent == InvalidProxy)
+				m_root = indexC;
+			else if (m_nodes[c.parent].left == index)
+				m_nodes[c.parent].left = indexC;
+			else
+				m_nodes[c.parent].right = indexC;
+
+			if (f.height > g.height)
+			{
+				c.right = indexF;
+				a.right = indexG;
+				g.parent = index;
+
+				a.box = Merge(b.box, g.box);
+				c.box = Merge(a.box, f.box);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.right = indexG;
+				a.right = indexF;
+				f.parent = index;
+
+				a.box = Merge(b.box, f.box);
+				c.box = Merge(a.box, g.box);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+
+			return indexC;
+		}
+
+		if (balance < -1)
+		{
+			std::size_t indexD = b.left;
+			std::size_t indexE = b.right;
+			Node& d = m_nodes[indexD];
+			Node& e = m_nodes[indexE];
+
+			b.left = index;
+			b.parent = a.parent;
+			a.parent = indexB;
+
+			if (b.parent == InvalidProxy)
+				m_root = indexB;
+			else if (m_nodes[b.parent].left == index)
+				m_nodes[b.parent].left = indexB;
+			else
+				m_nodes[b.parent].right = indexB;
+
+			if (d.height > e.height)
+			{
+				b.right = indexD;
+				a.left = indexE;
+				e.parent = index;
+
+				a.box = Merge(c.box, e.box);
+				b.box = Merge(a.box, d.box);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.right = indexE;
+				a.left = indexD;
+				d.parent = index;
+
+				a.box = Merge(c.box, d.box);
+				b.box = Merge(a.box, e.box);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+
+			return indexB;
+		}
+
+		return index;
+	}
+
+	template<typename T>
+	Box<T> BoxTree<T>::Fatten(const Box<T>& box) const
+	{
+		// Relative to the size of the box, flat boxes get a thickness
+		T margin = m_margin * std::max({box.width, box.height, box.depth});
+
+		return Box<T>(box.x - margin, box.y - margin, box.z - margin, box.width + F(2.0) * margin, box.height + F(2.0) * margin, box.depth + F(2.0) * margin);
+	}
+
+	template<typename T>
+	void BoxTree<T>::InsertLeaf(std::size_t leaf)
+	{
+		if (m_root == InvalidProxy)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = InvalidProxy;
+			return;
+		}
+
+		// Descends toward the sibling whose merging increases the least the surface of the tree
+		Box<T> leafBox = m_nodes[leaf].box;
+		std::size_t index = m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const Node& node = m_nodes[index];
+
+			T surface = ComputeSurface(node.box);
+			T combinedSurface = ComputeSurface(Merge(node.box, leafBox));
+
+			// Cost of a new parent for this node and the leaf, and cost of pushing the leaf further down
+			T cost = F(2.0) * combinedSurface;
+			T inheritanceCost = F(2.0) * (combinedSurface - surface);
+
+			auto ComputeDescentCost = [&](const Node& child)
+			{
+				T childCost = ComputeSurface(Merge(child.box, leafBox));
+				if (!child.IsLeaf())
+					childCost -= ComputeSurface(child.box);
+
+				return childCost + inheritanceCost;
+			};
+
+			T leftCost = ComputeDescentCost(m_nodes[node.left]);
+			T rightCost = ComputeDescentCost(m_nodes[node.right]);
+
+			if (cost < leftCost && cost < rightCost)
+				break;
+
+			index = (leftCost < rightCost) ? node.left : node.right;
+		}
+
+		std::size_t sibling = index;
+		std::size_t oldParent = m_nodes[sibling].parent;
+		std::size_t newParent = AllocateNode();
+
+		Node& parentNode = m_nodes[newParent];
+		parentNode.parent = oldParent;
+		parentNode.left = sibling;
+		parentNode.right = leaf;
+		parentNode.box = Merge(m_nodes[sibling].box, leafBox);
+		parentNode.height = m_nodes[sibling].height + 1;
+
+		if (oldParent == InvalidProxy)
+			m_root = newParent;
+		else if (m_nodes[oldParent].left == sibling)
+			m_nodes[oldParent].left = newParent;
+		else
+			m_nodes[oldParent].right = newParent;
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[leaf].parent = newParent;
+
+		for (index = m_nodes[leaf].parent; index != InvalidProxy; index = m_nodes[index].parent)
+		{
+			index = Balance(index);
+			UpdateNode(index);
+		}
+	}
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::QueryNode(std::size_t index, const Box<T>& box, Callback& callback) const
+	{
+		const Node& node = m_nodes[index];
+
+		// Touching boxes intersect, contrary to Box::Intersect
+		if (node.box.x > box.x + box.width || node.box.x + node.box.width < box.x ||
+		    node.box.y > box.y + box.height || node.box.y + node.box.height < box.y ||
+		    node.box.z > box.z + box.depth || node.box.z + node.box.depth < box.z)
+			return;
+
+		if (box.Contains(node.box))
+			ReportSubtree(index, callback);
+		else if (node.IsLeaf())
+			callback(node.userData);
+		else
+		{
+			QueryNode(node.left, box, callback);
+			QueryNode(node.right, box, callback);
+		}
+	}
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::QueryNode(std::size_t index, const Frustum<T>& frustum, Callback& callback) const
+	{
+		const Node& node = m_nodes[index];
+
+		switch (frustum.Intersect(node.box))
+		{
+			case IntersectionSide_Inside:
+				ReportSubtree(index, callback);
+				break;
+
+			case IntersectionSide_Intersecting:
+				if (node.IsLeaf())
+					callback(node.userData);
+				else
+				{
+					QueryNode(node.left, frustum, callback);
+					QueryNode(node.right, frustum, callback);
+				}
+				break;
+
+			case IntersectionSide_Outside:
+				break;
+		}
+	}
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::QueryNode(std::size_t index, const Sphere<T>& sphere, Callback& callback) const
+	{
+		const Node& node = m_nodes[index];
+		if (!sphere.Intersect(node.box))
+			return;
+
+		if (node.IsLeaf())
+			callback(node.userData);
+		else
+		{
+			QueryNode(node.left, sphere, callback);
+			QueryNode(node.right, sphere, callback);
+		}
+	}
+
+	template<typename T>
+	void BoxTree<T>::ReleaseNode(std::size_t index)
+	{
+		Node& node = m_nodes[index];
+		node.parent = m_freeList;
+		node.height = -1;
+
+		m_freeList = index;
+	}
+
+	template<typename T>
+	void BoxTree<T>::RemoveLeaf(std::size_t leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = InvalidProxy;
+			return;
+		}
+
+		// The sibling of the leaf takes the place of their parent
+		std::size_t parent = m_nodes[leaf].parent;
+		std::size_t grandParent = m_nodes[parent].parent;
+		std::size_t sibling = (m_nodes[parent].left == leaf) ? m_nodes[parent].right : m_nodes[parent].left;
+
+		ReleaseNode(parent);
+
+		if (grandParent == InvalidProxy)
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = InvalidProxy;
+			return;
+		}
+
+		if (m_nodes[grandParent].left == parent)
+			m_nodes[grandParent].left = sibling;
+		else
+			m_nodes[grandParent].right = sibling;
+
+		m_nodes[sibling].parent = grandParent;
+
+		for (std::size_t index = grandParent; index != InvalidProxy; index = m_nodes[index].parent)
+		{
+			index = Balance(index);
+			UpdateNode(index);
+		}
+	}
+
+	template<typename T>
+	template<typename Callback>
+	void BoxTree<T>::ReportSubtree(std::size_t index, Callback& callback) const
+	{
+		const Node& node = m_nodes[index];
+		if (node.IsLeaf())
+			callback(node.userData);
+		else
+		{
+			ReportSubtree(node.left, callback);
+			ReportSubtree(node.right, callback);
+		}
+	}
+
+	template<typename T>
+	void BoxTree<T>::UpdateNode(std::size_t index)
+	{
+		Node& node = m_nodes[index];
+		const Node& left = m_nodes[node.left];
+		const Node& right = m_nodes[node.right];
+
+		node.box = Merge(left.box, right.box);
+		node.height = 1 + std::max(left.height, right.height);
+	}
+
+	template<typename T>
+	T BoxTree<T>::ComputeSurface(const Box<T>& box)
+	{
+		return F(2.0) * (box.width * box.height + box.height * box.depth + box.depth * box.width);
+	}
+
+	template<typename T>
+	Box<T> BoxTree<T>::Merge(const Box<T>& first, const Box<T>& second)
+	{
+		Box<T> box(first);
+		return box.ExtendTo(second);
+	}
+}
+
+#undef F
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -44,4 +44,7 @@
 // Enable tests of security based on the code (Advised for the developpement)
 #define NAZARA_MATH_SAFE 1
 
+// Use SSE2/NEON implementations of the hot operations of Matrix4f and Quaternionf, when the target supports them
+#define NAZARA_MATH_SIMD 1
+
 #endif // NAZARA_CONFIG_MATH_HPP
@@ -375,6 +375,9 @@ namespace Nz
 
 		return true;
 	}
+
+	template<typename T>
+	struct BulkSerializable<EulerAngles<T>> : BulkSerializable<T> {}; //< Components are serialized in memory order
 }
 
 /*!
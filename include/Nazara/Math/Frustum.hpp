@@ -7,12 +7,14 @@
 #ifndef NAZARA_FRUSTUM_HPP
 #define NAZARA_FRUSTUM_HPP
 
+#include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/String.hpp>
 #include <Nazara/Math/BoundingVolume.hpp>
 #include <Nazara/Math/Enums.hpp>
 #include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Math/OrientedBox.hpp>
 #include <Nazara/Math/Plane.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Sphere.hpp>
 #include <Nazara/Math/Vector3.hpp>
 
@@ -38,6 +40,9 @@ namespace Nz
 			bool Contains(const Vector3<T>& point) const;
 			bool Contains(const Vector3<T>* points, unsigned int pointCount) const;
 
+			void CullBoxes(const T* centerX, const T* centerY, const T* centerZ, const T* extentX, const T* extentY, const T* extentZ, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache = nullptr) const;
+			void CullSpheres(const T* centerX, const T* centerY, const T* centerZ, const T* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache = nullptr) const;
+
 			Frustum& Extract(const Matrix4<T>& clipMatrix);
 			Frustum& Extract(const Matrix4<T>& view, const Matrix4<T>& projection);
 
@@ -61,6 +66,8 @@ namespace Nz
 			friend bool Unserialize(SerializationContext& context, Frustum<U>* frustum);
 
 		private:
+			void Cull(const T* centerX, const T* centerY, const T* centerZ, const T* extentX, const T* extentY, const T* extentZ, const T* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const;
+
 			Vector3<T> m_corners[BoxCorner_Max+1];
 			Plane<T> m_planes[FrustumPlane_Max+1];
 	};
@@ -16,6 +16,33 @@
 
 namespace Nz
 {
+	namespace Detail
+	{
+		// Tests a volume against the planes, starting with the one which culled it the last time
+		// The extent along a plane normal is |n.x|*extentX + |n.y|*extentY + |n.z|*extentZ for a box, and the radius for a sphere
+		template<typename T>
+		bool FrustumCullVolume(const Plane<T>* planes, T centerX, T centerY, T centerZ, T extentX, T extentY, T extentZ, T radius, UInt8* cachedPlane)
+		{
+			unsigned int firstPlane = (cachedPlane && *cachedPlane <= FrustumPlane_Max) ? *cachedPlane : 0;
+			for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+			{
+				unsigned int planeIndex = (firstPlane + i) % (FrustumPlane_Max + 1);
+				const Plane<T>& plane = planes[planeIndex];
+
+				T distance = plane.normal.x * centerX + plane.normal.y * centerY + plane.normal.z * centerZ - plane.distance;
+				T extent = std::abs(plane.normal.x) * extentX + std::abs(plane.normal.y) * extentY + std::abs(plane.normal.z) * extentZ + radius;
+				if (distance + extent < T(0.0))
+				{
+					if (cachedPlane)
+						*cachedPlane = static_cast<UInt8>(planeIndex);
+
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
 
 	/*!
     * \ingroup math
@@ -241,6 +268,55 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Culls a set of axis-aligned boxes against the frustum
+	*
+	* The boxes are given as structures of arrays, which allows to test several of them at once with SIMD instructions
+	*
+	* \param centerX X components of the box centers
+	* \param centerY Y components of the box centers
+	* \param centerZ Z components of the box centers
+	* \param extentX Half widths of the boxes
+	* \param extentY Half heights of the boxes
+	* \param extentZ Half depths of the boxes
+	* \param count Number of boxes
+	* \param visibility Bitset resized to count, the bit of a box is set if it is not entirely outside of the frustum (as with Contains)
+	* \param planeCache Optional array of count plane indices, storing the plane which culled each box to test it first on the next call
+	*
+	* \remark Produces a NazaraError with NAZARA_DEBUG defined if visibility is invalid
+	* \remark The plane cache can be left uninitialized, invalid indices are ignored
+	*
+	* \see CullSpheres
+	*/
+
+	template<typename T>
+	void Frustum<T>::CullBoxes(const T* centerX, const T* centerY, const T* centerZ, const T* extentX, const T* extentY, const T* extentZ, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const
+	{
+		Cull(centerX, centerY, centerZ, extentX, extentY, extentZ, nullptr, count, visibility, planeCache);
+	}
+
+	/*!
+	* \brief Culls a set of spheres against the frustum
+	*
+	* \param centerX X components of the sphere centers
+	* \param centerY Y components of the sphere centers
+	* \param centerZ Z components of the sphere centers
+	* \param radius Radii of the spheres
+	* \param count Number of spheres
+	* \param visibility Bitset resized to count, the bit of a sphere is set if it is not entirely outside of the frustum (as with Contains)
+	* \param planeCache Optional array of count plane indices, storing the plane which culled each sphere to test it first on the next call
+	*
+	* \remark Produces a NazaraError with NAZARA_DEBUG defined if visibility is invalid
+	*
+	* \see CullBoxes
+	*/
+
+	template<typename T>
+	void Frustum<T>::CullSpheres(const T* centerX, const T* centerY, const T* centerZ, const T* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const
+	{
+		Cull(centerX, centerY, centerZ, nullptr, nullptr, nullptr, radius, count, visibility, planeCache);
+	}
+
 	/*!
 	* \brief Constructs the frustum from a Matrix4
 	* \return A reference to this frustum which is the build up of projective matrix
@@ -676,6 +752,42 @@ namespace Nz
 		       << "        Top: " << m_planes[FrustumPlane_Top].ToString() << ")\n";
 	}
 
+	/*!
+	* \brief Culls a set of boxes (if radius is null) or of spheres (if the extents are null)
+	*
+	* \see CullBoxes, CullSpheres
+	*/
+
+	template<typename T>
+	void Frustum<T>::Cull(const T* centerX, const T* centerY, const T* centerZ, const T* extentX, const T* extentY, const T* extentZ, const T* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		visibility->Resize(count);
+
+		UInt64 block = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			bool visible;
+			if (radius)
+				visible = Detail::FrustumCullVolume(m_planes, centerX[i], centerY[i], centerZ[i], F(0.0), F(0.0), F(0.0), radius[i], (planeCache) ? &planeCache[i] : nullptr);
+			else
+				visible = Detail::FrustumCullVolume(m_planes, centerX[i], centerY[i], centerZ[i], extentX[i], extentY[i], extentZ[i], F(0.0), (planeCache) ? &planeCache[i] : nullptr);
+
+			if (visible)
+				block |= UInt64(1) << (i % 64);
+
+			if (i % 64 == 63)
+			{
+				visibility->SetBlock(i / 64, block);
+				block = 0;
+			}
+		}
+
+		if (count % 64 != 0)
+			visibility->SetBlock(count / 64, block);
+	}
+
 	/*!
 	* \brief Serializes a Frustum
 	* \return true if successfully serialized
@@ -725,6 +837,157 @@ namespace Nz
 
 		return true;
 	}
+
+	#if defined(NAZARA_MATH_SSE2) || defined(NAZARA_MATH_NEON)
+	template<> inline void Frustum<float>::Cull(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, const float* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const;
+
+	// Tests four volumes against each plane at once, a group leaves as soon as its four volumes are culled
+	template<>
+	inline void Frustum<float>::Cull(const float* centerX, const float* centerY, const float* centerZ, const float* extentX, const float* extentY, const float* extentZ, const float* radius, std::size_t count, Bitset<UInt64>* visibility, UInt8* planeCache) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		visibility->Resize(count);
+
+		#ifdef NAZARA_MATH_SSE2
+		using Register = __m128;
+		#else
+		using Register = float32x4_t;
+		#endif
+
+		struct SimdPlane
+		{
+			Register normalX, normalY, normalZ;
+			Register absNormalX, absNormalY, absNormalZ;
+			Register distance;
+		};
+
+		SimdPlane planes[FrustumPlane_Max + 1];
+		for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+		{
+			const Plane<float>& plane = m_planes[i];
+
+			#ifdef NAZARA_MATH_SSE2
+			planes[i] = {_mm_set1_ps(plane.normal.x), _mm_set1_ps(plane.normal.y), _mm_set1_ps(plane.normal.z),
+			             _mm_set1_ps(std::abs(plane.normal.x)), _mm_set1_ps(std::abs(plane.normal.y)), _mm_set1_ps(std::abs(plane.normal.z)),
+			             _mm_set1_ps(plane.distance)};
+			#else
+			planes[i] = {vdupq_n_f32(plane.normal.x), vdupq_n_f32(plane.normal.y), vdupq_n_f32(plane.normal.z),
+			             vdupq_n_f32(std::abs(plane.normal.x)), vdupq_n_f32(std::abs(plane.normal.y)), vdupq_n_f32(std::abs(plane.normal.z)),
+			             vdupq_n_f32(plane.distance)};
+			#endif
+		}
+
+		UInt64 block = 0;
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			#ifdef NAZARA_MATH_SSE2
+			__m128 x = _mm_loadu_ps(&centerX[i]);
+			__m128 y = _mm_loadu_ps(&centerY[i]);
+			__m128 z = _mm_loadu_ps(&centerZ[i]);
+			__m128 zero = _mm_setzero_ps();
+			#else
+			float32x4_t x = vld1q_f32(&centerX[i]);
+			float32x4_t y = vld1q_f32(&centerY[i]);
+			float32x4_t z = vld1q_f32(&centerZ[i]);
+			float32x4_t zero = vdupq_n_f32(0.f);
+			const uint32_t laneBits[4] = {1, 2, 4, 8};
+			uint32x4_t laneMask = vld1q_u32(laneBits);
+			#endif
+
+			Register sizeX, sizeY, sizeZ;
+			if (!radius)
+			{
+				#ifdef NAZARA_MATH_SSE2
+				sizeX = _mm_loadu_ps(&extentX[i]);
+				sizeY = _mm_loadu_ps(&extentY[i]);
+				sizeZ = _mm_loadu_ps(&extentZ[i]);
+				#else
+				sizeX = vld1q_f32(&extentX[i]);
+				sizeY = vld1q_f32(&extentY[i]);
+				sizeZ = vld1q_f32(&extentZ[i]);
+				#endif
+			}
+			else
+			{
+				#ifdef NAZARA_MATH_SSE2
+				sizeX = _mm_loadu_ps(&radius[i]);
+				#else
+				sizeX = vld1q_f32(&radius[i]);
+				#endif
+			}
+
+			// Objects stored next to each other tend to be culled by the same plane
+			unsigned int firstPlane = (planeCache && planeCache[i] <= FrustumPlane_Max) ? planeCache[i] : 0;
+			unsigned int culled = 0;
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				unsigned int planeIndex = (firstPlane + j) % (FrustumPlane_Max + 1);
+				const SimdPlane& plane = planes[planeIndex];
+
+				#ifdef NAZARA_MATH_SSE2
+				__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane.normalX, x), _mm_mul_ps(plane.normalY, y)), _mm_mul_ps(plane.normalZ, z));
+				if (radius)
+					distance = _mm_add_ps(distance, sizeX);
+				else
+					distance = _mm_add_ps(distance, _mm_add_ps(_mm_add_ps(_mm_mul_ps(plane.absNormalX, sizeX), _mm_mul_ps(plane.absNormalY, sizeY)), _mm_mul_ps(plane.absNormalZ, sizeZ)));
+
+				unsigned int outside = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, plane.distance), zero)));
+				#else
+				float32x4_t distance = vmlaq_f32(vmlaq_f32(vmulq_f32(plane.normalX, x), plane.normalY, y), plane.normalZ, z);
+				if (radius)
+					distance = vaddq_f32(distance, sizeX);
+				else
+					distance = vmlaq_f32(vmlaq_f32(vmlaq_f32(distance, plane.absNormalX, sizeX), plane.absNormalY, sizeY), plane.absNormalZ, sizeZ);
+
+				uint32x4_t outsideLanes = vandq_u32(vcltq_f32(vsubq_f32(distance, plane.distance), zero), laneMask);
+				uint32x2_t outsidePairs = vadd_u32(vget_low_u32(outsideLanes), vget_high_u32(outsideLanes));
+				unsigned int outside = vget_lane_u32(vpadd_u32(outsidePairs, outsidePairs), 0);
+				#endif
+
+				outside &= ~culled;
+				if (outside)
+				{
+					if (planeCache)
+					{
+						for (unsigned int lane = 0; lane < 4; ++lane)
+						{
+							if (outside & (1U << lane))
+								planeCache[i + lane] = static_cast<UInt8>(planeIndex);
+						}
+					}
+
+					culled |= outside;
+					if (culled == 0xF)
+						break;
+				}
+			}
+
+			block |= UInt64(~culled & 0xF) << (i % 64);
+			if (i % 64 == 60)
+			{
+				visibility->SetBlock(i / 64, block);
+				block = 0;
+			}
+		}
+
+		for (; i < count; ++i)
+		{
+			bool visible;
+			if (radius)
+				visible = Detail::FrustumCullVolume(m_planes, centerX[i], centerY[i], centerZ[i], 0.f, 0.f, 0.f, radius[i], (planeCache) ? &planeCache[i] : nullptr);
+			else
+				visible = Detail::FrustumCullVolume(m_planes, centerX[i], centerY[i], centerZ[i], extentX[i], extentY[i], extentZ[i], 0.f, (planeCache) ? &planeCache[i] : nullptr);
+
+			if (visible)
+				block |= UInt64(1) << (i % 64);
+		}
+
+		if (count % 64 != 0)
+			visibility->SetBlock(count / 64, block);
+	}
+	#endif
 }
 
 /*!
@@ -27,13 +27,13 @@ namespace Nz
 	{
 		public:
 			Matrix4() = default;
-			Matrix4(T r11, T r12, T r13, T r14,
-			        T r21, T r22, T r23, T r24,
-			        T r31, T r32, T r33, T r34,
-			        T r41, T r42, T r43, T r44);
+			constexpr Matrix4(T r11, T r12, T r13, T r14,
+			                  T r21, T r22, T r23, T r24,
+			                  T r31, T r32, T r33, T r34,
+			                  T r41, T r42, T r43, T r44);
 			//Matrix4(const Matrix3<T>& matrix);
-			Matrix4(const T matrix[16]);
-			template<typename U> explicit Matrix4(const Matrix4<U>& matrix);
+			constexpr Matrix4(const T matrix[16]);
+			template<typename U> constexpr explicit Matrix4(const Matrix4<U>& matrix);
 			Matrix4(const Matrix4& matrix) = default;
 			~Matrix4() = default;
 
@@ -66,7 +66,7 @@ namespace Nz
 			bool IsAffine() const;
 			bool IsIdentity() const;
 
-			Matrix4& MakeIdentity();
+			constexpr Matrix4& MakeIdentity();
 			Matrix4& MakeLookAt(const Vector3<T>& eye, const Vector3<T>& target, const Vector3<T>& up = Vector3<T>::Up());
 			Matrix4& MakeOrtho(T left, T right, T top, T bottom, T zNear = -1.0, T zFar = 1.0);
 			Matrix4& MakePerspective(T angle, T ratio, T zNear, T zFar);
@@ -76,16 +76,16 @@ namespace Nz
 			Matrix4& MakeTransform(const Vector3<T>& translation, const Quaternion<T>& rotation);
 			Matrix4& MakeTransform(const Vector3<T>& translation, const Quaternion<T>& rotation, const Vector3<T>& scale);
 			Matrix4& MakeViewMatrix(const Vector3<T>& translation, const Quaternion<T>& rotation);
-			Matrix4& MakeZero();
+			constexpr Matrix4& MakeZero();
 
-			Matrix4& Set(T r11, T r12, T r13, T r14,
-			             T r21, T r22, T r23, T r24,
-			             T r31, T r32, T r33, T r34,
-			             T r41, T r42, T r43, T r44);
-			Matrix4& Set(const T matrix[16]);
+			constexpr Matrix4& Set(T r11, T r12, T r13, T r14,
+			                       T r21, T r22, T r23, T r24,
+			                       T r31, T r32, T r33, T r34,
+			                       T r41, T r42, T r43, T r44);
+			constexpr Matrix4& Set(const T matrix[16]);
 			//Matrix4(const Matrix3<T>& matrix);
-			Matrix4& Set(const Matrix4& matrix);
-			template<typename U> Matrix4& Set(const Matrix4<U>& matrix);
+			constexpr Matrix4& Set(const Matrix4& matrix);
+			template<typename U> constexpr Matrix4& Set(const Matrix4<U>& matrix);
 			Matrix4& SetRotation(const Quaternion<T>& rotation);
 			Matrix4& SetScale(const Vector3<T>& scale);
 			Matrix4& SetTranslation(const Vector3<T>& translation);
@@ -120,7 +120,7 @@ namespace Nz
 
 			static Matrix4 Concatenate(const Matrix4& left, const Matrix4& right);
 			static Matrix4 ConcatenateAffine(const Matrix4& left, const Matrix4& right);
-			static Matrix4 Identity();
+			static constexpr Matrix4 Identity();
 			static Matrix4 LookAt(const Vector3<T>& eye, const Vector3<T>& target, const Vector3<T>& up = Vector3<T>::Up());
 			static Matrix4 Ortho(T left, T right, T top, T bottom, T zNear = -1.0, T zFar = 1.0);
 			static Matrix4 Perspective(T angle, T ratio, T zNear, T zFar);
@@ -130,7 +130,7 @@ namespace Nz
 			static Matrix4 Transform(const Vector3<T>& translation, const Quaternion<T>& rotation);
 			static Matrix4 Transform(const Vector3<T>& translation, const Quaternion<T>& rotation, const Vector3<T>& scale);
 			static Matrix4 ViewMatrix(const Vector3<T>& translation, const Quaternion<T>& rotation);
-			static Matrix4 Zero();
+			static constexpr Matrix4 Zero();
 
 			T m11, m12, m13, m14,
 			 m21, m22, m23, m24,
@@ -9,6 +9,7 @@
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
 #include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
@@ -37,15 +38,15 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>::Matrix4(T r11, T r12, T r13, T r14,
-	                    T r21, T r22, T r23, T r24,
-	                    T r31, T r32, T r33, T r34,
-	                    T r41, T r42, T r43, T r44)
+	constexpr Matrix4<T>::Matrix4(T r11, T r12, T r13, T r14,
+	                              T r21, T r22, T r23, T r24,
+	                              T r31, T r32, T r33, T r34,
+	                              T r41, T r42, T r43, T r44) :
+	m11(r11), m12(r12), m13(r13), m14(r14),
+	m21(r21), m22(r22), m23(r23), m24(r24),
+	m31(r31), m32(r32), m33(r33), m34(r34),
+	m41(r41), m42(r42), m43(r43), m44(r44)
 	{
-		Set(r11, r12, r13, r14,
-		    r21, r22, r23, r24,
-		    r31, r32, r33, r34,
-		    r41, r42, r43, r44);
 	}
 
 	/*!
@@ -55,9 +56,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>::Matrix4(const T matrix[16])
+	constexpr Matrix4<T>::Matrix4(const T matrix[16]) :
+	Matrix4(matrix[ 0], matrix[ 1], matrix[ 2], matrix[ 3],
+	        matrix[ 4], matrix[ 5], matrix[ 6], matrix[ 7],
+	        matrix[ 8], matrix[ 9], matrix[10], matrix[11],
+	        matrix[12], matrix[13], matrix[14], matrix[15])
 	{
-		Set(matrix);
 	}
 
 	/*!
@@ -68,9 +72,12 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Matrix4<T>::Matrix4(const Matrix4<U>& matrix)
+	constexpr Matrix4<T>::Matrix4(const Matrix4<U>& matrix) :
+	Matrix4(F(matrix.m11), F(matrix.m12), F(matrix.m13), F(matrix.m14),
+	        F(matrix.m21), F(matrix.m22), F(matrix.m23), F(matrix.m24),
+	        F(matrix.m31), F(matrix.m32), F(matrix.m33), F(matrix.m34),
+	        F(matrix.m41), F(matrix.m42), F(matrix.m43), F(matrix.m44))
 	{
-		Set(matrix);
 	}
 
 	/*!
@@ -817,7 +824,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>& Matrix4<T>::MakeIdentity()
+	constexpr Matrix4<T>& Matrix4<T>::MakeIdentity()
 	{
 		Set(F(1.0), F(0.0), F(0.0), F(0.0),
 		    F(0.0), F(1.0), F(0.0), F(0.0),
@@ -1054,7 +1061,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>& Matrix4<T>::MakeZero()
+	constexpr Matrix4<T>& Matrix4<T>::MakeZero()
 	{
 		Set(F(0.0), F(0.0), F(0.0), F(0.0),
 		    F(0.0), F(0.0), F(0.0), F(0.0),
@@ -1072,10 +1079,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>& Matrix4<T>::Set(T r11, T r12, T r13, T r14,
-	                            T r21, T r22, T r23, T r24,
-	                            T r31, T r32, T r33, T r34,
-	                            T r41, T r42, T r43, T r44)
+	constexpr Matrix4<T>& Matrix4<T>::Set(T r11, T r12, T r13, T r14,
+	                                      T r21, T r22, T r23, T r24,
+	                                      T r31, T r32, T r33, T r34,
+	                                      T r41, T r42, T r43, T r44)
 	{
 		m11 = r11;
 		m12 = r12;
@@ -1105,12 +1112,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>& Matrix4<T>::Set(const T matrix[16])
+	constexpr Matrix4<T>& Matrix4<T>::Set(const T matrix[16])
 	{
-		// Here we are confident of the continuity of memory elements
-		std::memcpy(&m11, matrix, 16 * sizeof(T));
-
-		return *this;
+		return Set(matrix[ 0], matrix[ 1], matrix[ 2], matrix[ 3],
+		           matrix[ 4], matrix[ 5], matrix[ 6], matrix[ 7],
+		           matrix[ 8], matrix[ 9], matrix[10], matrix[11],
+		           matrix[12], matrix[13], matrix[14], matrix[15]);
 	}
 
 	/*!
@@ -1121,11 +1128,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T>& Matrix4<T>::Set(const Matrix4& matrix)
+	constexpr Matrix4<T>& Matrix4<T>::Set(const Matrix4& matrix)
 	{
-		std::memcpy(this, &matrix, sizeof(Matrix4));
-
-		return *this;
+		return Set(matrix.m11, matrix.m12, matrix.m13, matrix.m14,
+		           matrix.m21, matrix.m22, matrix.m23, matrix.m24,
+		           matrix.m31, matrix.m32, matrix.m33, matrix.m34,
+		           matrix.m41, matrix.m42, matrix.m43, matrix.m44);
 	}
 
 	/*!
@@ -1137,14 +1145,12 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Matrix4<T>& Matrix4<T>::Set(const Matrix4<U>& matrix)
+	constexpr Matrix4<T>& Matrix4<T>::Set(const Matrix4<U>& matrix)
 	{
-		Set(F(matrix[ 0]), F(matrix[ 1]), F(matrix[ 2]), F(matrix[ 3]),
-		    F(matrix[ 4]), F(matrix[ 5]), F(matrix[ 6]), F(matrix[ 7]),
-		    F(matrix[ 8]), F(matrix[ 9]), F(matrix[10]), F(matrix[11]),
-		    F(matrix[12]), F(matrix[13]), F(matrix[14]), F(matrix[15]));
-
-		return *this;
+		return Set(F(matrix.m11), F(matrix.m12), F(matrix.m13), F(matrix.m14),
+		           F(matrix.m21), F(matrix.m22), F(matrix.m23), F(matrix.m24),
+		           F(matrix.m31), F(matrix.m32), F(matrix.m33), F(matrix.m34),
+		           F(matrix.m41), F(matrix.m42), F(matrix.m43), F(matrix.m44));
 	}
 
 	/*!
@@ -1559,12 +1565,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T> Matrix4<T>::Identity()
+	constexpr Matrix4<T> Matrix4<T>::Identity()
 	{
-		Matrix4 matrix;
-		matrix.MakeIdentity();
-
-		return matrix;
+		return Matrix4(F(1.0), F(0.0), F(0.0), F(0.0),
+		               F(0.0), F(1.0), F(0.0), F(0.0),
+		               F(0.0), F(0.0), F(1.0), F(0.0),
+		               F(0.0), F(0.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -1755,12 +1761,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Matrix4<T> Matrix4<T>::Zero()
+	constexpr Matrix4<T> Matrix4<T>::Zero()
 	{
-		Matrix4 matrix;
-		matrix.MakeZero();
-
-		return matrix;
+		return Matrix4(F(0.0), F(0.0), F(0.0), F(0.0),
+		               F(0.0), F(0.0), F(0.0), F(0.0),
+		               F(0.0), F(0.0), F(0.0), F(0.0),
+		               F(0.0), F(0.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1801,6 +1807,333 @@ namespace Nz
 
 		return true;
 	}
+
+	template<typename T>
+	struct BulkSerializable<Matrix4<T>> : BulkSerializable<T> {}; //< Components are serialized in memory order
+
+	#if defined(NAZARA_MATH_SSE2) || defined(NAZARA_MATH_NEON)
+	// Specializations of the hot operations for Matrix4f (see Simd.hpp), they must be declared before any use
+	template<> inline Matrix4<float>& Matrix4<float>::Concatenate(const Matrix4& matrix);
+	template<> inline Matrix4<float>& Matrix4<float>::ConcatenateAffine(const Matrix4& matrix);
+	template<> inline Vector3<float> Matrix4<float>::Transform(const Vector3<float>& vector, float w) const;
+	template<> inline Vector4<float> Matrix4<float>::Transform(const Vector4<float>& vector) const;
+	#endif
+
+	#ifdef NAZARA_MATH_SSE2
+	namespace Detail
+	{
+		// 2x2 matrices products, the matrices being stored in a register in row-major order (A# being the adjugate of A)
+		inline __m128 SimdMat2Mul(__m128 a, __m128 b) // A * B
+		{
+			return _mm_add_ps(_mm_mul_ps(a, SimdSwizzle<0, 3, 0, 3>(b)), _mm_mul_ps(SimdSwizzle<1, 0, 3, 2>(a), SimdSwizzle<2, 1, 2, 1>(b)));
+		}
+
+		inline __m128 SimdMat2AdjMul(__m128 a, __m128 b) // A# * B
+		{
+			return _mm_sub_ps(_mm_mul_ps(SimdSwizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(SimdSwizzle<1, 1, 2, 2>(a), SimdSwizzle<2, 3, 0, 1>(b)));
+		}
+
+		inline __m128 SimdMat2MulAdj(__m128 a, __m128 b) // A * B#
+		{
+			return _mm_sub_ps(_mm_mul_ps(a, SimdSwizzle<3, 0, 3, 0>(b)), _mm_mul_ps(SimdSwizzle<1, 0, 3, 2>(a), SimdSwizzle<2, 1, 2, 1>(b)));
+		}
+
+		inline __m128 SimdCrossProduct(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(SimdSwizzle<1, 2, 0, 3>(a), SimdSwizzle<2, 0, 1, 3>(b)), _mm_mul_ps(SimdSwizzle<2, 0, 1, 3>(a), SimdSwizzle<1, 2, 0, 3>(b)));
+		}
+	}
+
+	template<> inline bool Matrix4<float>::GetInverse(Matrix4* dest) const;
+	template<> inline bool Matrix4<float>::GetInverseAffine(Matrix4* dest) const;
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::Concatenate(const Matrix4& matrix)
+	{
+		#if NAZARA_MATH_MATRIX4_CHECK_AFFINE
+		if (IsAffine() && matrix.IsAffine())
+			return ConcatenateAffine(matrix);
+		#endif
+
+		__m128 row1 = _mm_loadu_ps(&matrix.m11);
+		__m128 row2 = _mm_loadu_ps(&matrix.m21);
+		__m128 row3 = _mm_loadu_ps(&matrix.m31);
+		__m128 row4 = _mm_loadu_ps(&matrix.m41);
+
+		_mm_storeu_ps(&m11, Detail::SimdCombineRows(_mm_loadu_ps(&m11), row1, row2, row3, row4));
+		_mm_storeu_ps(&m21, Detail::SimdCombineRows(_mm_loadu_ps(&m21), row1, row2, row3, row4));
+		_mm_storeu_ps(&m31, Detail::SimdCombineRows(_mm_loadu_ps(&m31), row1, row2, row3, row4));
+		_mm_storeu_ps(&m41, Detail::SimdCombineRows(_mm_loadu_ps(&m41), row1, row2, row3, row4));
+
+		return *this;
+	}
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::ConcatenateAffine(const Matrix4& matrix)
+	{
+		#ifdef NAZARA_DEBUG
+		if (!IsAffine())
+		{
+			NazaraWarning("First matrix not affine");
+			return Concatenate(matrix);
+		}
+
+		if (!matrix.IsAffine())
+		{
+			NazaraWarning("Second matrix not affine");
+			return Concatenate(matrix);
+		}
+		#endif
+
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+		__m128 row1 = _mm_loadu_ps(&matrix.m11);
+		__m128 row2 = _mm_loadu_ps(&matrix.m21);
+		__m128 row3 = _mm_loadu_ps(&matrix.m31);
+		__m128 row4 = _mm_loadu_ps(&matrix.m41);
+
+		// The last column is forced to (0, 0, 0, 1), the fourth factor of the translation row being one
+		const __m128 zero = _mm_setzero_ps();
+		_mm_storeu_ps(&m11, _mm_and_ps(Detail::SimdCombineRows(_mm_loadu_ps(&m11), row1, row2, row3, zero), xyzMask));
+		_mm_storeu_ps(&m21, _mm_and_ps(Detail::SimdCombineRows(_mm_loadu_ps(&m21), row1, row2, row3, zero), xyzMask));
+		_mm_storeu_ps(&m31, _mm_and_ps(Detail::SimdCombineRows(_mm_loadu_ps(&m31), row1, row2, row3, zero), xyzMask));
+
+		__m128 translation = _mm_add_ps(Detail::SimdCombineRows(_mm_loadu_ps(&m41), row1, row2, row3, zero), row4);
+		_mm_storeu_ps(&m41, _mm_or_ps(_mm_and_ps(translation, xyzMask), _mm_set_ps(1.f, 0.f, 0.f, 0.f)));
+
+		return *this;
+	}
+
+	template<>
+	inline bool Matrix4<float>::GetInverse(Matrix4* dest) const
+	{
+		#if NAZARA_MATH_MATRIX4_CHECK_AFFINE
+		if (IsAffine())
+			return GetInverseAffine(dest);
+		#endif
+
+		#ifdef NAZARA_DEBUG
+		if (!dest)
+		{
+			NazaraError("Destination matrix must be valid");
+			return false;
+		}
+		#endif
+
+		// Blockwise inversion, the matrix being split into four 2x2 matrices [A B; C D]
+		__m128 row1 = _mm_loadu_ps(&m11);
+		__m128 row2 = _mm_loadu_ps(&m21);
+		__m128 row3 = _mm_loadu_ps(&m31);
+		__m128 row4 = _mm_loadu_ps(&m41);
+
+		__m128 a = _mm_movelh_ps(row1, row2);
+		__m128 b = _mm_movehl_ps(row2, row1);
+		__m128 c = _mm_movelh_ps(row3, row4);
+		__m128 d = _mm_movehl_ps(row4, row3);
+
+		// Determinants of A, B, C and D
+		__m128 subDeterminants = _mm_sub_ps(_mm_mul_ps(Detail::SimdShuffle<0, 2, 0, 2>(row1, row3), Detail::SimdShuffle<1, 3, 1, 3>(row2, row4)),
+		                                    _mm_mul_ps(Detail::SimdShuffle<1, 3, 1, 3>(row1, row3), Detail::SimdShuffle<0, 2, 0, 2>(row2, row4)));
+
+		__m128 detA = Detail::SimdSwizzle<0, 0, 0, 0>(subDeterminants);
+		__m128 detB = Detail::SimdSwizzle<1, 1, 1, 1>(subDeterminants);
+		__m128 detC = Detail::SimdSwizzle<2, 2, 2, 2>(subDeterminants);
+		__m128 detD = Detail::SimdSwizzle<3, 3, 3, 3>(subDeterminants);
+
+		__m128 adjDC = Detail::SimdMat2AdjMul(d, c);
+		__m128 adjAB = Detail::SimdMat2AdjMul(a, b);
+
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Detail::SimdMat2Mul(b, adjDC));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Detail::SimdMat2MulAdj(d, adjAB));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Detail::SimdMat2MulAdj(a, adjDC));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Detail::SimdMat2Mul(c, adjAB));
+
+		// det(M) = det(A)det(D) + det(B)det(C) - tr((A#B)(D#C))
+		__m128 trace = _mm_mul_ps(adjAB, Detail::SimdSwizzle<0, 2, 1, 3>(adjDC));
+		trace = _mm_add_ps(trace, Detail::SimdSwizzle<2, 3, 0, 1>(trace));
+		trace = _mm_add_ps(trace, Detail::SimdSwizzle<1, 0, 3, 2>(trace));
+
+		__m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+		if (_mm_cvtss_f32(det) == 0.f)
+			return false;
+
+		__m128 invDet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+		x = _mm_mul_ps(x, invDet);
+		y = _mm_mul_ps(y, invDet);
+		z = _mm_mul_ps(z, invDet);
+		w = _mm_mul_ps(w, invDet);
+
+		_mm_storeu_ps(&dest->m11, Detail::SimdShuffle<3, 1, 3, 1>(x, y));
+		_mm_storeu_ps(&dest->m21, Detail::SimdShuffle<2, 0, 2, 0>(x, y));
+		_mm_storeu_ps(&dest->m31, Detail::SimdShuffle<3, 1, 3, 1>(z, w));
+		_mm_storeu_ps(&dest->m41, Detail::SimdShuffle<2, 0, 2, 0>(z, w));
+
+		return true;
+	}
+
+	template<>
+	inline bool Matrix4<float>::GetInverseAffine(Matrix4* dest) const
+	{
+		#ifdef NAZARA_DEBUG
+		if (!IsAffine())
+		{
+			NazaraWarning("Matrix is not affine");
+			return GetInverse(dest);
+		}
+
+		if (!dest)
+		{
+			NazaraError("Destination matrix must be valid");
+			return false;
+		}
+		#endif
+
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+		__m128 row1 = _mm_and_ps(_mm_loadu_ps(&m11), xyzMask);
+		__m128 row2 = _mm_and_ps(_mm_loadu_ps(&m21), xyzMask);
+		__m128 row3 = _mm_and_ps(_mm_loadu_ps(&m31), xyzMask);
+		__m128 translation = _mm_loadu_ps(&m41);
+
+		// The inverse of the rotation/scale part has the cross products of its rows as columns, divided by its determinant
+		__m128 cross23 = Detail::SimdCrossProduct(row2, row3);
+		__m128 cross31 = Detail::SimdCrossProduct(row3, row1);
+		__m128 cross12 = Detail::SimdCrossProduct(row1, row2);
+
+		__m128 det = _mm_mul_ps(row1, cross23);
+		det = _mm_add_ps(det, Detail::SimdSwizzle<2, 3, 0, 1>(det));
+		det = _mm_add_ps(det, Detail::SimdSwizzle<1, 0, 3, 2>(det));
+		if (_mm_cvtss_f32(det) == 0.f)
+			return false;
+
+		__m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+		__m128 zero = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(cross23, cross31, cross12, zero);
+
+		row1 = _mm_mul_ps(cross23, invDet);
+		row2 = _mm_mul_ps(cross31, invDet);
+		row3 = _mm_mul_ps(cross12, invDet);
+
+		// Translation is -t * R^-1
+		__m128 invTranslation = Detail::SimdCombineRows(translation, row1, row2, row3, _mm_setzero_ps());
+		invTranslation = _mm_sub_ps(_mm_set_ps(1.f, 0.f, 0.f, 0.f), _mm_and_ps(invTranslation, xyzMask));
+
+		_mm_storeu_ps(&dest->m11, row1);
+		_mm_storeu_ps(&dest->m21, row2);
+		_mm_storeu_ps(&dest->m31, row3);
+		_mm_storeu_ps(&dest->m41, invTranslation);
+
+		return true;
+	}
+
+	template<>
+	inline Vector3<float> Matrix4<float>::Transform(const Vector3<float>& vector, float w) const
+	{
+		__m128 result = Detail::SimdCombineRows(_mm_setr_ps(vector.x, vector.y, vector.z, w), _mm_loadu_ps(&m11), _mm_loadu_ps(&m21), _mm_loadu_ps(&m31), _mm_loadu_ps(&m41));
+
+		alignas(16) float components[4];
+		_mm_store_ps(components, result);
+
+		return Vector3<float>(components[0], components[1], components[2]);
+	}
+
+	template<>
+	inline Vector4<float> Matrix4<float>::Transform(const Vector4<float>& vector) const
+	{
+		Vector4<float> result;
+		_mm_storeu_ps(&result.x, Detail::SimdCombineRows(_mm_loadu_ps(&vector.x), _mm_loadu_ps(&m11), _mm_loadu_ps(&m21), _mm_loadu_ps(&m31), _mm_loadu_ps(&m41)));
+
+		return result;
+	}
+	#elif defined(NAZARA_MATH_NEON)
+	namespace Detail
+	{
+		inline float32x4_t SimdCombineRows(const float* factors, float32x4_t row1, float32x4_t row2, float32x4_t row3, float32x4_t row4)
+		{
+			float32x4_t result = vmulq_n_f32(row1, factors[0]);
+			result = vmlaq_n_f32(result, row2, factors[1]);
+			result = vmlaq_n_f32(result, row3, factors[2]);
+			result = vmlaq_n_f32(result, row4, factors[3]);
+
+			return result;
+		}
+	}
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::Concatenate(const Matrix4& matrix)
+	{
+		#if NAZARA_MATH_MATRIX4_CHECK_AFFINE
+		if (IsAffine() && matrix.IsAffine())
+			return ConcatenateAffine(matrix);
+		#endif
+
+		float32x4_t row1 = vld1q_f32(&matrix.m11);
+		float32x4_t row2 = vld1q_f32(&matrix.m21);
+		float32x4_t row3 = vld1q_f32(&matrix.m31);
+		float32x4_t row4 = vld1q_f32(&matrix.m41);
+
+		vst1q_f32(&m11, Detail::SimdCombineRows(&m11, row1, row2, row3, row4));
+		vst1q_f32(&m21, Detail::SimdCombineRows(&m21, row1, row2, row3, row4));
+		vst1q_f32(&m31, Detail::SimdCombineRows(&m31, row1, row2, row3, row4));
+		vst1q_f32(&m41, Detail::SimdCombineRows(&m41, row1, row2, row3, row4));
+
+		return *this;
+	}
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::ConcatenateAffine(const Matrix4& matrix)
+	{
+		#ifdef NAZARA_DEBUG
+		if (!IsAffine())
+		{
+			NazaraWarning("First matrix not affine");
+			return Concatenate(matrix);
+		}
+
+		if (!matrix.IsAffine())
+		{
+			NazaraWarning("Second matrix not affine");
+			return Concatenate(matrix);
+		}
+		#endif
+
+		float32x4_t row1 = vld1q_f32(&matrix.m11);
+		float32x4_t row2 = vld1q_f32(&matrix.m21);
+		float32x4_t row3 = vld1q_f32(&matrix.m31);
+		float32x4_t row4 = vld1q_f32(&matrix.m41);
+
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		vst1q_f32(&m11, vsetq_lane_f32(0.f, Detail::SimdCombineRows(&m11, row1, row2, row3, zero), 3));
+		vst1q_f32(&m21, vsetq_lane_f32(0.f, Detail::SimdCombineRows(&m21, row1, row2, row3, zero), 3));
+		vst1q_f32(&m31, vsetq_lane_f32(0.f, Detail::SimdCombineRows(&m31, row1, row2, row3, zero), 3));
+
+		float32x4_t translation = vaddq_f32(Detail::SimdCombineRows(&m41, row1, row2, row3, zero), row4);
+		vst1q_f32(&m41, vsetq_lane_f32(1.f, translation, 3));
+
+		return *this;
+	}
+
+	template<>
+	inline Vector3<float> Matrix4<float>::Transform(const Vector3<float>& vector, float w) const
+	{
+		const float factors[4] = {vector.x, vector.y, vector.z, w};
+
+		float components[4];
+		vst1q_f32(components, Detail::SimdCombineRows(factors, vld1q_f32(&m11), vld1q_f32(&m21), vld1q_f32(&m31), vld1q_f32(&m41)));
+
+		return Vector3<float>(components[0], components[1], components[2]);
+	}
+
+	template<>
+	inline Vector4<float> Matrix4<float>::Transform(const Vector4<float>& vector) const
+	{
+		Vector4<float> result;
+		vst1q_f32(&result.x, Detail::SimdCombineRows(&vector.x, vld1q_f32(&m11), vld1q_f32(&m21), vld1q_f32(&m31), vld1q_f32(&m41)));
+
+		return result;
+	}
+	#endif
 }
 
 /*!
@@ -243,8 +243,22 @@ namespace Nz
 	template<typename T>
 	void OrientedBox<T>::Update(const Matrix4<T>& transformMatrix)
 	{
-		for (unsigned int i = 0; i <= BoxCorner_Max; ++i)
-			m_corners[i] = transformMatrix.Transform(localBox.GetCorner(static_cast<BoxCorner>(i)));
+		// Only the position and the three edges are transformed, the corners are built from them
+		Vector3<T> origin = transformMatrix.Transform(localBox.GetPosition());
+		Vector3<T> xEdge = transformMatrix.Transform(Vector3<T>(localBox.width, F(0.0), F(0.0)), F(0.0));
+		Vector3<T> yEdge = transformMatrix.Transform(Vector3<T>(F(0.0), localBox.height, F(0.0)), F(0.0));
+		Vector3<T> zEdge = transformMatrix.Transform(Vector3<T>(F(0.0), F(0.0), localBox.depth), F(0.0));
+
+		Vector3<T> farRightBottom = origin + xEdge;
+
+		m_corners[BoxCorner_FarLeftBottom] = origin;
+		m_corners[BoxCorner_FarLeftTop] = origin + yEdge;
+		m_corners[BoxCorner_FarRightBottom] = farRightBottom;
+		m_corners[BoxCorner_FarRightTop] = farRightBottom + yEdge;
+		m_corners[BoxCorner_NearLeftBottom] = origin + zEdge;
+		m_corners[BoxCorner_NearLeftTop] = m_corners[BoxCorner_FarLeftTop] + zEdge;
+		m_corners[BoxCorner_NearRightBottom] = farRightBottom + zEdge;
+		m_corners[BoxCorner_NearRightTop] = m_corners[BoxCorner_FarRightTop] + zEdge;
 	}
 
 	/*!
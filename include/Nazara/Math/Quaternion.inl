@@ -7,6 +7,7 @@
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <cstring>
 #include <limits>
@@ -714,10 +715,10 @@ namespace Nz
 		#endif
 
 		Quaternion interpolated;
-		interpolated.w = Lerp(from.w, to.w, interpolation);
-		interpolated.x = Lerp(from.x, to.x, interpolation);
-		interpolated.y = Lerp(from.y, to.y, interpolation);
-		interpolated.z = Lerp(from.z, to.z, interpolation);
+		interpolated.w = Nz::Lerp(from.w, to.w, interpolation);
+		interpolated.x = Nz::Lerp(from.x, to.x, interpolation);
+		interpolated.y = Nz::Lerp(from.y, to.y, interpolation);
+		interpolated.z = Nz::Lerp(from.z, to.z, interpolation);
 
 		return interpolated;
 	}
@@ -883,6 +884,99 @@ namespace Nz
 
 		return true;
 	}
+
+	#ifdef NAZARA_MATH_SSE2
+	// Specializations of the hot operations for Quaternionf (see Simd.hpp)
+	template<>
+	inline Quaternion<float> Quaternion<float>::operator*(const Quaternion& quat) const
+	{
+		// Components are stored as (w, x, y, z), each component of this quaternion scales a signed permutation of the other one
+		__m128 other = _mm_loadu_ps(&quat.w);
+
+		__m128 result = _mm_mul_ps(_mm_set1_ps(w), other);
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(x), _mm_xor_ps(Detail::SimdSwizzle<1, 0, 3, 2>(other), _mm_setr_ps(-0.f, 0.f, -0.f, 0.f))));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(y), _mm_xor_ps(Detail::SimdSwizzle<2, 3, 0, 1>(other), _mm_setr_ps(-0.f, 0.f, 0.f, -0.f))));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(z), _mm_xor_ps(Detail::SimdSwizzle<3, 2, 1, 0>(other), _mm_setr_ps(-0.f, -0.f, 0.f, 0.f))));
+
+		Quaternion product;
+		_mm_storeu_ps(&product.w, result);
+
+		return product;
+	}
+
+	template<>
+	inline Quaternion<float> Quaternion<float>::Slerp(const Quaternion& from, const Quaternion& to, float interpolation)
+	{
+		#ifdef NAZARA_DEBUG
+		if (interpolation < 0.f || interpolation > 1.f)
+		{
+			NazaraError("Interpolation must be in range [0..1] (Got " + String::Number(interpolation) + ')');
+			return Zero();
+		}
+		#endif
+
+		__m128 fromQuat = _mm_loadu_ps(&from.w);
+		__m128 toQuat = _mm_loadu_ps(&to.w);
+
+		__m128 dot = _mm_mul_ps(fromQuat, toQuat);
+		dot = _mm_add_ps(dot, Detail::SimdSwizzle<2, 3, 0, 1>(dot));
+		dot = _mm_add_ps(dot, Detail::SimdSwizzle<1, 0, 3, 2>(dot));
+
+		float cosOmega = _mm_cvtss_f32(dot);
+		if (cosOmega < 0.f)
+		{
+			// We invert everything
+			toQuat = _mm_xor_ps(toQuat, _mm_set1_ps(-0.f));
+			cosOmega = -cosOmega;
+		}
+
+		float k0, k1;
+		if (cosOmega > 0.9999f)
+		{
+			// Linear interpolation to avoid division by zero
+			k0 = 1.f - interpolation;
+			k1 = interpolation;
+		}
+		else
+		{
+			float sinOmega = std::sqrt(1.f - cosOmega*cosOmega);
+			float omega = std::atan2(sinOmega, cosOmega);
+
+			// To avoid two divisions
+			sinOmega = 1.f/sinOmega;
+
+			k0 = std::sin((1.f - interpolation) * omega) * sinOmega;
+			k1 = std::sin(interpolation*omega) * sinOmega;
+		}
+
+		Quaternion result;
+		_mm_storeu_ps(&result.w, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(k0), fromQuat), _mm_mul_ps(_mm_set1_ps(k1), toQuat)));
+
+		return result;
+	}
+	#elif defined(NAZARA_MATH_NEON)
+	template<>
+	inline Quaternion<float> Quaternion<float>::operator*(const Quaternion& quat) const
+	{
+		// Components are stored as (w, x, y, z), each component of this quaternion scales a signed permutation of the other one
+		static const float xSigns[4] = {-1.f, 1.f, -1.f, 1.f};
+		static const float ySigns[4] = {-1.f, 1.f, 1.f, -1.f};
+		static const float zSigns[4] = {-1.f, -1.f, 1.f, 1.f};
+
+		float32x4_t other = vld1q_f32(&quat.w);
+		float32x4_t rotated = vextq_f32(other, other, 2);
+
+		float32x4_t result = vmulq_n_f32(other, w);
+		result = vmlaq_f32(result, vrev64q_f32(other), vmulq_n_f32(vld1q_f32(xSigns), x));
+		result = vmlaq_f32(result, rotated, vmulq_n_f32(vld1q_f32(ySigns), y));
+		result = vmlaq_f32(result, vrev64q_f32(rotated), vmulq_n_f32(vld1q_f32(zSigns), z));
+
+		Quaternion product;
+		vst1q_f32(&product.w, result);
+
+		return product;
+	}
+	#endif
 }
 
 /*!
@@ -20,68 +20,68 @@ namespace Nz
 	{
 		public:
 			Rect() = default;
-			Rect(T Width, T Height);
-			Rect(T X, T Y, T Width, T Height);
-			Rect(const T rect[4]);
-			Rect(const Vector2<T>& lengths);
-			Rect(const Vector2<T>& vec1, const Vector2<T>& vec2);
-			template<typename U> explicit Rect(const Rect<U>& rect);
+			constexpr Rect(T Width, T Height);
+			constexpr Rect(T X, T Y, T Width, T Height);
+			constexpr Rect(const T rect[4]);
+			constexpr Rect(const Vector2<T>& lengths);
+			constexpr Rect(const Vector2<T>& vec1, const Vector2<T>& vec2);
+			template<typename U> constexpr explicit Rect(const Rect<U>& rect);
 			Rect(const Rect& rect) = default;
 			~Rect() = default;
 
-			bool Contains(T X, T Y) const;
-			bool Contains(const Rect& rect) const;
-			bool Contains(const Vector2<T>& point) const;
+			constexpr bool Contains(T X, T Y) const;
+			constexpr bool Contains(const Rect& rect) const;
+			constexpr bool Contains(const Vector2<T>& point) const;
 
-			Rect& ExtendTo(T X, T Y);
-			Rect& ExtendTo(const Rect& rect);
-			Rect& ExtendTo(const Vector2<T>& point);
+			constexpr Rect& ExtendTo(T X, T Y);
+			constexpr Rect& ExtendTo(const Rect& rect);
+			constexpr Rect& ExtendTo(const Vector2<T>& point);
 
-			Vector2<T> GetCenter() const;
+			constexpr Vector2<T> GetCenter() const;
 			Vector2<T> GetCorner(RectCorner corner) const;
-			Vector2<T> GetLengths() const;
-			Vector2<T> GetMaximum() const;
-			Vector2<T> GetMinimum() const;
-			Vector2<T> GetNegativeVertex(const Vector2<T>& normal) const;
-			Vector2<T> GetPosition() const;
-			Vector2<T> GetPositiveVertex(const Vector2<T>& normal) const;
+			constexpr Vector2<T> GetLengths() const;
+			constexpr Vector2<T> GetMaximum() const;
+			constexpr Vector2<T> GetMinimum() const;
+			constexpr Vector2<T> GetNegativeVertex(const Vector2<T>& normal) const;
+			constexpr Vector2<T> GetPosition() const;
+			constexpr Vector2<T> GetPositiveVertex(const Vector2<T>& normal) const;
 
-			bool Intersect(const Rect& rect, Rect* intersection = nullptr) const;
+			constexpr bool Intersect(const Rect& rect, Rect* intersection = nullptr) const;
 
-			bool IsValid() const;
+			constexpr bool IsValid() const;
 
-			Rect& MakeZero();
+			constexpr Rect& MakeZero();
 
-			Rect& Set(T Width, T Height);
-			Rect& Set(T X, T Y, T Width, T Height);
-			Rect& Set(const T rect[4]);
-			Rect& Set(const Rect<T>& rect);
-			Rect& Set(const Vector2<T>& lengths);
-			Rect& Set(const Vector2<T>& vec1, const Vector2<T>& vec2);
-			template<typename U> Rect& Set(const Rect<U>& rect);
+			constexpr Rect& Set(T Width, T Height);
+			constexpr Rect& Set(T X, T Y, T Width, T Height);
+			constexpr Rect& Set(const T rect[4]);
+			constexpr Rect& Set(const Rect<T>& rect);
+			constexpr Rect& Set(const Vector2<T>& lengths);
+			constexpr Rect& Set(const Vector2<T>& vec1, const Vector2<T>& vec2);
+			template<typename U> constexpr Rect& Set(const Rect<U>& rect);
 
 			String ToString() const;
 
-			Rect& Translate(const Vector2<T>& translation);
+			constexpr Rect& Translate(const Vector2<T>& translation);
 
 			T& operator[](unsigned int i);
 			T operator[](unsigned int i) const;
 
-			Rect operator*(T scalar) const;
-			Rect operator*(const Vector2<T>& vec) const;
-			Rect operator/(T scalar) const;
-			Rect operator/(const Vector2<T>& vec) const;
+			constexpr Rect operator*(T scalar) const;
+			constexpr Rect operator*(const Vector2<T>& vec) const;
+			constexpr Rect operator/(T scalar) const;
+			constexpr Rect operator/(const Vector2<T>& vec) const;
 
-			Rect& operator*=(T scalar);
-			Rect& operator*=(const Vector2<T>& vec);
-			Rect& operator/=(T scalar);
-			Rect& operator/=(const Vector2<T>& vec);
+			constexpr Rect& operator*=(T scalar);
+			constexpr Rect& operator*=(const Vector2<T>& vec);
+			constexpr Rect& operator/=(T scalar);
+			constexpr Rect& operator/=(const Vector2<T>& vec);
 
-			bool operator==(const Rect& rect) const;
-			bool operator!=(const Rect& rect) const;
+			constexpr bool operator==(const Rect& rect) const;
+			constexpr bool operator!=(const Rect& rect) const;
 
-			static Rect Lerp(const Rect& from, const Rect& to, T interpolation);
-			static Rect Zero();
+			static constexpr Rect Lerp(const Rect& from, const Rect& to, T interpolation);
+			static constexpr Rect Zero();
 
 			T x, y, width, height;
 	};
@@ -31,9 +31,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>::Rect(T Width, T Height)
+	constexpr Rect<T>::Rect(T Width, T Height) :
+	x(F(0.0)),
+	y(F(0.0)),
+	width(Width),
+	height(Height)
 	{
-		Set(Width, Height);
 	}
 
 	/*!
@@ -46,9 +49,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>::Rect(T X, T Y, T Width, T Height)
+	constexpr Rect<T>::Rect(T X, T Y, T Width, T Height) :
+	x(X),
+	y(Y),
+	width(Width),
+	height(Height)
 	{
-		Set(X, Y, Width, Height);
 	}
 
 	/*!
@@ -58,9 +64,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>::Rect(const T vec[4])
+	constexpr Rect<T>::Rect(const T vec[4]) :
+	x(vec[0]),
+	y(vec[1]),
+	width(vec[2]),
+	height(vec[3])
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -72,9 +81,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>::Rect(const Vector2<T>& lengths)
+	constexpr Rect<T>::Rect(const Vector2<T>& lengths) :
+	x(F(0.0)),
+	y(F(0.0)),
+	width(lengths.x),
+	height(lengths.y)
 	{
-		Set(lengths);
 	}
 
 	/*!
@@ -86,9 +98,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>::Rect(const Vector2<T>& vec1, const Vector2<T>& vec2)
+	constexpr Rect<T>::Rect(const Vector2<T>& vec1, const Vector2<T>& vec2) :
+	x(std::min(vec1.x, vec2.x)),
+	y(std::min(vec1.y, vec2.y)),
+	width((vec2.x > vec1.x) ? vec2.x - vec1.x : vec1.x - vec2.x),
+	height((vec2.y > vec1.y) ? vec2.y - vec1.y : vec1.y - vec2.y)
 	{
-		Set(vec1, vec2);
 	}
 
 	/*!
@@ -99,9 +114,12 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Rect<T>::Rect(const Rect<U>& rect)
+	constexpr Rect<T>::Rect(const Rect<U>& rect) :
+	x(F(rect.x)),
+	y(F(rect.y)),
+	width(F(rect.width)),
+	height(F(rect.height))
 	{
-		Set(rect);
 	}
 
 	/*!
@@ -115,7 +133,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::Contains(T X, T Y) const
+	constexpr bool Rect<T>::Contains(T X, T Y) const
 	{
 		return X >= x && X <= (x + width) &&
 		       Y >= y && Y <= (y + height);
@@ -131,7 +149,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::Contains(const Rect<T>& rect) const
+	constexpr bool Rect<T>::Contains(const Rect<T>& rect) const
 	{
 		return Contains(rect.x, rect.y) &&
 		       Contains(rect.x + rect.width, rect.y + rect.height);
@@ -147,7 +165,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::Contains(const Vector2<T>& point) const
+	constexpr bool Rect<T>::Contains(const Vector2<T>& point) const
 	{
 		return Contains(point.x, point.y);
 	}
@@ -163,7 +181,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::ExtendTo(T X, T Y)
+	constexpr Rect<T>& Rect<T>::ExtendTo(T X, T Y)
 	{
 		width = std::max(x + width, X);
 		height = std::max(y + height, Y);
@@ -187,7 +205,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::ExtendTo(const Rect& rect)
+	constexpr Rect<T>& Rect<T>::ExtendTo(const Rect& rect)
 	{
 		width = std::max(x + width, rect.x + rect.width);
 		height = std::max(y + height, rect.y + rect.height);
@@ -211,7 +229,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::ExtendTo(const Vector2<T>& point)
+	constexpr Rect<T>& Rect<T>::ExtendTo(const Vector2<T>& point)
 	{
 		return ExtendTo(point.x, point.y);
 	}
@@ -222,7 +240,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetCenter() const
+	constexpr Vector2<T> Rect<T>::GetCenter() const
 	{
 		return GetPosition() + GetLengths() / F(2.0);
 	}
@@ -264,7 +282,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetLengths() const
+	constexpr Vector2<T> Rect<T>::GetLengths() const
 	{
 		return Vector2<T>(width, height);
 	}
@@ -277,7 +295,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetMaximum() const
+	constexpr Vector2<T> Rect<T>::GetMaximum() const
 	{
 		return GetPosition() + GetLengths();
 	}
@@ -290,7 +308,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetMinimum() const
+	constexpr Vector2<T> Rect<T>::GetMinimum() const
 	{
 		return GetPosition();
 	}
@@ -305,7 +323,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetNegativeVertex(const Vector2<T>& normal) const
+	constexpr Vector2<T> Rect<T>::GetNegativeVertex(const Vector2<T>& normal) const
 	{
 		Vector2<T> neg(GetPosition());
 
@@ -326,7 +344,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetPosition() const
+	constexpr Vector2<T> Rect<T>::GetPosition() const
 	{
 		return Vector2<T>(x, y);
 	}
@@ -341,7 +359,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Rect<T>::GetPositiveVertex(const Vector2<T>& normal) const
+	constexpr Vector2<T> Rect<T>::GetPositiveVertex(const Vector2<T>& normal) const
 	{
 		Vector2<T> pos(GetPosition());
 
@@ -363,7 +381,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::Intersect(const Rect& rect, Rect* intersection) const
+	constexpr bool Rect<T>::Intersect(const Rect& rect, Rect* intersection) const
 	{
 		T left = std::max(x, rect.x);
 		T right = std::min(x + width, rect.x + rect.width);
@@ -392,7 +410,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::IsValid() const
+	constexpr bool Rect<T>::IsValid() const
 	{
 		return width > F(0.0) && height > F(0.0);
 	}
@@ -405,7 +423,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::MakeZero()
+	constexpr Rect<T>& Rect<T>::MakeZero()
 	{
 		x = F(0.0);
 		y = F(0.0);
@@ -426,7 +444,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(T Width, T Height)
+	constexpr Rect<T>& Rect<T>::Set(T Width, T Height)
 	{
 		x = F(0.0);
 		y = F(0.0);
@@ -447,7 +465,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(T X, T Y, T Width, T Height)
+	constexpr Rect<T>& Rect<T>::Set(T X, T Y, T Width, T Height)
 	{
 		x = X;
 		y = Y;
@@ -465,7 +483,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(const T rect[4])
+	constexpr Rect<T>& Rect<T>::Set(const T rect[4])
 	{
 		x = rect[0];
 		y = rect[1];
@@ -483,9 +501,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(const Rect<T>& rect)
+	constexpr Rect<T>& Rect<T>::Set(const Rect<T>& rect)
 	{
-		std::memcpy(this, &rect, sizeof(Rect));
+		x = rect.x;
+		y = rect.y;
+		width = rect.width;
+		height = rect.height;
 
 		return *this;
 	}
@@ -500,7 +521,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(const Vector2<T>& lengths)
+	constexpr Rect<T>& Rect<T>::Set(const Vector2<T>& lengths)
 	{
 		return Set(lengths.x, lengths.y);
 	}
@@ -515,7 +536,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Set(const Vector2<T>& vec1, const Vector2<T>& vec2)
+	constexpr Rect<T>& Rect<T>::Set(const Vector2<T>& vec1, const Vector2<T>& vec2)
 	{
 		x = std::min(vec1.x, vec2.x);
 		y = std::min(vec1.y, vec2.y);
@@ -534,7 +555,7 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Rect<T>& Rect<T>::Set(const Rect<U>& rect)
+	constexpr Rect<T>& Rect<T>::Set(const Rect<U>& rect)
 	{
 		x = F(rect.x);
 		y = F(rect.y);
@@ -565,7 +586,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::Translate(const Vector2<T>& translation)
+	constexpr Rect<T>& Rect<T>::Translate(const Vector2<T>& translation)
 	{
 		x += translation.x;
 		y += translation.y;
@@ -633,7 +654,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::operator*(T scalar) const
+	constexpr Rect<T> Rect<T>::operator*(T scalar) const
 	{
 		return Rect(x, y, width * scalar, height * scalar);
 	}
@@ -646,7 +667,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::operator*(const Vector2<T>& vec) const
+	constexpr Rect<T> Rect<T>::operator*(const Vector2<T>& vec) const
 	{
 		return Rect(x, y, width*vec.x, height*vec.y);
 	}
@@ -659,7 +680,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::operator/(T scalar) const
+	constexpr Rect<T> Rect<T>::operator/(T scalar) const
 	{
 		return Rect(x, y, width/scalar, height/scalar);
 	}
@@ -672,7 +693,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::operator/(const Vector2<T>& vec) const
+	constexpr Rect<T> Rect<T>::operator/(const Vector2<T>& vec) const
 	{
 		return Rect(x, y, width/vec.x, height/vec.y);
 	}
@@ -685,7 +706,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::operator*=(T scalar)
+	constexpr Rect<T>& Rect<T>::operator*=(T scalar)
 	{
 		width *= scalar;
 		height *= scalar;
@@ -701,7 +722,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::operator*=(const Vector2<T>& vec)
+	constexpr Rect<T>& Rect<T>::operator*=(const Vector2<T>& vec)
 	{
 		width *= vec.x;
 		height *= vec.y;
@@ -717,7 +738,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::operator/=(T scalar)
+	constexpr Rect<T>& Rect<T>::operator/=(T scalar)
 	{
 		width /= scalar;
 		height /= scalar;
@@ -733,7 +754,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T>& Rect<T>::operator/=(const Vector2<T>& vec)
+	constexpr Rect<T>& Rect<T>::operator/=(const Vector2<T>& vec)
 	{
 		width /= vec.x;
 		height /= vec.y;
@@ -749,7 +770,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::operator==(const Rect& rect) const
+	constexpr bool Rect<T>::operator==(const Rect& rect) const
 	{
 		return NumberEquals(x, rect.x) && NumberEquals(y, rect.y) &&
 		       NumberEquals(width, rect.width) && NumberEquals(height, rect.height);
@@ -763,7 +784,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Rect<T>::operator!=(const Rect& rect) const
+	constexpr bool Rect<T>::operator!=(const Rect& rect) const
 	{
 		return !operator==(rect);
 	}
@@ -783,7 +804,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::Lerp(const Rect& from, const Rect& to, T interpolation)
+	constexpr Rect<T> Rect<T>::Lerp(const Rect& from, const Rect& to, T interpolation)
 	{
 		#ifdef NAZARA_DEBUG
 		if (interpolation < F(0.0) || interpolation > F(1.0))
@@ -793,13 +814,7 @@ namespace Nz
 		}
 		#endif
 
-		Rect rect;
-		rect.x = Nz::Lerp(from.x, to.x, interpolation);
-		rect.y = Nz::Lerp(from.y, to.y, interpolation);
-		rect.width = Nz::Lerp(from.width, to.width, interpolation);
-		rect.height = Nz::Lerp(from.height, to.height, interpolation);
-
-		return rect;
+		return Rect(Nz::Lerp(from.x, to.x, interpolation), Nz::Lerp(from.y, to.y, interpolation), Nz::Lerp(from.width, to.width, interpolation), Nz::Lerp(from.height, to.height, interpolation));
 	}
 
 	/*!
@@ -810,12 +825,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Rect<T> Rect<T>::Zero()
+	constexpr Rect<T> Rect<T>::Zero()
 	{
-		Rect rect;
-		rect.MakeZero();
-
-		return rect;
+		return Rect(F(0.0), F(0.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -0,0 +1,57 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Mathematics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MATH_SIMD_HPP
+#define NAZARA_MATH_SIMD_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Config.hpp>
+
+// The math classes are templates inlined everywhere, a runtime dispatch would cost more than the operations themselves:
+// the SIMD paths are chosen at compile time, from the instruction sets every processor of the target has
+#if NAZARA_MATH_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define NAZARA_MATH_SSE2
+		#include <emmintrin.h>
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+		#define NAZARA_MATH_NEON
+		#include <arm_neon.h>
+	#endif
+#endif
+
+#ifdef NAZARA_MATH_SSE2
+namespace Nz
+{
+	namespace Detail
+	{
+		// Picks the two first components from a and the two last ones from b (indices are in memory order)
+		template<int X, int Y, int Z, int W>
+		inline __m128 SimdShuffle(__m128 a, __m128 b)
+		{
+			return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+		}
+
+		template<int X, int Y, int Z, int W>
+		inline __m128 SimdSwizzle(__m128 a)
+		{
+			return _mm_shuffle_ps(a, a, _MM_SHUFFLE(W, Z, Y, X));
+		}
+
+		// Linear combination of four rows by the components of a vector (row vector by matrix product)
+		inline __m128 SimdCombineRows(__m128 factors, __m128 row1, __m128 row2, __m128 row3, __m128 row4)
+		{
+			__m128 result = _mm_mul_ps(SimdSwizzle<0, 0, 0, 0>(factors), row1);
+			result = _mm_add_ps(result, _mm_mul_ps(SimdSwizzle<1, 1, 1, 1>(factors), row2));
+			result = _mm_add_ps(result, _mm_mul_ps(SimdSwizzle<2, 2, 2, 2>(factors), row3));
+			result = _mm_add_ps(result, _mm_mul_ps(SimdSwizzle<3, 3, 3, 3>(factors), row4));
+
+			return result;
+		}
+	}
+}
+#endif
+
+#endif // NAZARA_MATH_SIMD_HPP
@@ -21,13 +21,13 @@ namespace Nz
 	{
 		public:
 			Vector2() = default;
-			Vector2(T X, T Y);
-			explicit Vector2(T scale);
-			Vector2(const T vec[2]);
-			template<typename U> explicit Vector2(const Vector2<U>& vec);
+			constexpr Vector2(T X, T Y);
+			constexpr explicit Vector2(T scale);
+			constexpr Vector2(const T vec[2]);
+			template<typename U> constexpr explicit Vector2(const Vector2<U>& vec);
 			Vector2(const Vector2& vec) = default;
-			explicit Vector2(const Vector3<T>& vec);
-			explicit Vector2(const Vector4<T>& vec);
+			constexpr explicit Vector2(const Vector3<T>& vec);
+			constexpr explicit Vector2(const Vector4<T>& vec);
 			~Vector2() = default;
 
 			T AbsDotProduct(const Vector2& vec) const;
@@ -35,69 +35,69 @@ namespace Nz
 
 			T Distance(const Vector2& vec) const;
 			float Distancef(const Vector2& vec) const;
-			T DotProduct(const Vector2& vec) const;
+			constexpr T DotProduct(const Vector2& vec) const;
 
 			T GetLength() const;
 			float GetLengthf() const;
 			Vector2 GetNormal(T* length = nullptr) const;
-			T GetSquaredLength() const;
+			constexpr T GetSquaredLength() const;
 
-			Vector2& MakeUnit();
-			Vector2& MakeUnitX();
-			Vector2& MakeUnitY();
-			Vector2& MakeZero();
+			constexpr Vector2& MakeUnit();
+			constexpr Vector2& MakeUnitX();
+			constexpr Vector2& MakeUnitY();
+			constexpr Vector2& MakeZero();
 
-			Vector2& Maximize(const Vector2& vec);
-			Vector2& Minimize(const Vector2& vec);
+			constexpr Vector2& Maximize(const Vector2& vec);
+			constexpr Vector2& Minimize(const Vector2& vec);
 
 			Vector2& Normalize(T* length = nullptr);
 
-			Vector2& Set(T X, T Y);
-			Vector2& Set(T scale);
-			Vector2& Set(const T vec[2]);
-			Vector2& Set(const Vector2& vec);
-			Vector2& Set(const Vector3<T>& vec);
-			Vector2& Set(const Vector4<T>& vec);
-			template<typename U> Vector2& Set(const Vector2<U>& vec);
+			constexpr Vector2& Set(T X, T Y);
+			constexpr Vector2& Set(T scale);
+			constexpr Vector2& Set(const T vec[2]);
+			constexpr Vector2& Set(const Vector2& vec);
+			constexpr Vector2& Set(const Vector3<T>& vec);
+			constexpr Vector2& Set(const Vector4<T>& vec);
+			template<typename U> constexpr Vector2& Set(const Vector2<U>& vec);
 
-			T SquaredDistance(const Vector2& vec) const;
+			constexpr T SquaredDistance(const Vector2& vec) const;
 
 			String ToString() const;
 
 			operator T* ();
 			operator const T* () const;
 
-			const Vector2& operator+() const;
-			Vector2 operator-() const;
-
-			Vector2 operator+(const Vector2& vec) const;
-			Vector2 operator-(const Vector2& vec) const;
-			Vector2 operator*(const Vector2& vec) const;
-			Vector2 operator*(T scale) const;
-			Vector2 operator/(const Vector2& vec) const;
-			Vector2 operator/(T scale) const;
-
-			Vector2& operator+=(const Vector2& vec);
-			Vector2& operator-=(const Vector2& vec);
-			Vector2& operator*=(const Vector2& vec);
-			Vector2& operator*=(T scale);
-			Vector2& operator/=(const Vector2& vec);
-			Vector2& operator/=(T scale);
-
-			bool operator==(const Vector2& vec) const;
-			bool operator!=(const Vector2& vec) const;
-			bool operator<(const Vector2& vec) const;
-			bool operator<=(const Vector2& vec) const;
-			bool operator>(const Vector2& vec) const;
-			bool operator>=(const Vector2& vec) const;
-
-			static T DotProduct(const Vector2& vec1, const Vector2& vec2);
-			static Vector2 Lerp(const Vector2& from, const Vector2& to, T interpolation);
+			constexpr const Vector2& operator+() const;
+			constexpr Vector2 operator-() const;
+
+			constexpr Vector2 operator+(const Vector2& vec) const;
+			constexpr Vector2 operator-(const Vector2& vec) const;
+			constexpr Vector2 operator*(const Vector2& vec) const;
+			constexpr Vector2 operator*(T scale) const;
+			constexpr Vector2 operator/(const Vector2& vec) const;
+			constexpr Vector2 operator/(T scale) const;
+
+			constexpr Vector2& operator+=(const Vector2& vec);
+			constexpr Vector2& operator-=(const Vector2& vec);
+			constexpr Vector2& operator*=(const Vector2& vec);
+			constexpr Vector2& operator*=(T scale);
+			constexpr Vector2& operator/=(const Vector2& vec);
+			constexpr Vector2& operator/=(T scale);
+
+			constexpr bool operator==(const Vector2& vec) const;
+			constexpr bool operator!=(const Vector2& vec) const;
+			constexpr bool operator<(const Vector2& vec) const;
+			constexpr bool operator<=(const Vector2& vec) const;
+			constexpr bool operator>(const Vector2& vec) const;
+			constexpr bool operator>=(const Vector2& vec) const;
+
+			static constexpr T DotProduct(const Vector2& vec1, const Vector2& vec2);
+			static constexpr Vector2 Lerp(const Vector2& from, const Vector2& to, T interpolation);
 			static Vector2 Normalize(const Vector2& vec);
-			static Vector2 Unit();
-			static Vector2 UnitX();
-			static Vector2 UnitY();
-			static Vector2 Zero();
+			static constexpr Vector2 Unit();
+			static constexpr Vector2 UnitX();
+			static constexpr Vector2 UnitY();
+			static constexpr Vector2 Zero();
 
 			T x, y;
 	};
@@ -115,8 +115,8 @@ namespace Nz
 
 template<typename T> std::ostream& operator<<(std::ostream& out, const Nz::Vector2<T>& vec);
 
-template<typename T> Nz::Vector2<T> operator*(T scale, const Nz::Vector2<T>& vec);
-template<typename T> Nz::Vector2<T> operator/(T scale, const Nz::Vector2<T>& vec);
+template<typename T> constexpr Nz::Vector2<T> operator*(T scale, const Nz::Vector2<T>& vec);
+template<typename T> constexpr Nz::Vector2<T> operator/(T scale, const Nz::Vector2<T>& vec);
 
 #include <Nazara/Math/Vector2.inl>
 
@@ -28,9 +28,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>::Vector2(T X, T Y)
+	constexpr Vector2<T>::Vector2(T X, T Y) :
+	x(X),
+	y(Y)
 	{
-		Set(X, Y);
 	}
 
 	/*!
@@ -40,9 +41,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>::Vector2(T scale)
+	constexpr Vector2<T>::Vector2(T scale) :
+	x(scale),
+	y(scale)
 	{
-		Set(scale);
 	}
 
 	/*!
@@ -52,9 +54,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>::Vector2(const T vec[2])
+	constexpr Vector2<T>::Vector2(const T vec[2]) :
+	x(vec[0]),
+	y(vec[1])
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -65,9 +68,10 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Vector2<T>::Vector2(const Vector2<U>& vec)
+	constexpr Vector2<T>::Vector2(const Vector2<U>& vec) :
+	x(F(vec.x)),
+	y(F(vec.y))
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -77,9 +81,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>::Vector2(const Vector3<T>& vec)
+	constexpr Vector2<T>::Vector2(const Vector3<T>& vec) :
+	x(vec.x),
+	y(vec.y)
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -89,9 +94,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>::Vector2(const Vector4<T>& vec)
+	constexpr Vector2<T>::Vector2(const Vector4<T>& vec) :
+	x(vec.x),
+	y(vec.y)
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -164,7 +170,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Vector2<T>::DotProduct(const Vector2& vec) const
+	constexpr T Vector2<T>::DotProduct(const Vector2& vec) const
 	{
 		return x*vec.x + y*vec.y;
 	}
@@ -221,7 +227,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Vector2<T>::GetSquaredLength() const
+	constexpr T Vector2<T>::GetSquaredLength() const
 	{
 		return x*x + y*y;
 	}
@@ -234,7 +240,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::MakeUnit()
+	constexpr Vector2<T>& Vector2<T>::MakeUnit()
 	{
 		return Set(F(1.0), F(1.0));
 	}
@@ -247,7 +253,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::MakeUnitX()
+	constexpr Vector2<T>& Vector2<T>::MakeUnitX()
 	{
 		return Set(F(1.0), F(0.0));
 	}
@@ -260,7 +266,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::MakeUnitY()
+	constexpr Vector2<T>& Vector2<T>::MakeUnitY()
 	{
 		return Set(F(0.0), F(1.0));
 	}
@@ -273,7 +279,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::MakeZero()
+	constexpr Vector2<T>& Vector2<T>::MakeZero()
 	{
 		return Set(F(0.0), F(0.0));
 	}
@@ -288,7 +294,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Maximize(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::Maximize(const Vector2& vec)
 	{
 		if (vec.x > x)
 			x = vec.x;
@@ -309,7 +315,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Minimize(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::Minimize(const Vector2& vec)
 	{
 		if (vec.x < x)
 			x = vec.x;
@@ -357,7 +363,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(T X, T Y)
+	constexpr Vector2<T>& Vector2<T>::Set(T X, T Y)
 	{
 		x = X;
 		y = Y;
@@ -373,7 +379,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(T scale)
+	constexpr Vector2<T>& Vector2<T>::Set(T scale)
 	{
 		x = scale;
 		y = scale;
@@ -389,9 +395,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(const T vec[2])
+	constexpr Vector2<T>& Vector2<T>::Set(const T vec[2])
 	{
-		std::memcpy(&x, vec, 2*sizeof(T));
+		x = vec[0];
+		y = vec[1];
 
 		return *this;
 	}
@@ -404,9 +411,10 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::Set(const Vector2& vec)
 	{
-		std::memcpy(this, &vec, sizeof(Vector2));
+		x = vec.x;
+		y = vec.y;
 
 		return *this;
 	}
@@ -420,7 +428,7 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Vector2<T>& Vector2<T>::Set(const Vector2<U>& vec)
+	constexpr Vector2<T>& Vector2<T>::Set(const Vector2<U>& vec)
 	{
 		x = F(vec.x);
 		y = F(vec.y);
@@ -436,7 +444,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(const Vector3<T>& vec)
+	constexpr Vector2<T>& Vector2<T>::Set(const Vector3<T>& vec)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -452,7 +460,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::Set(const Vector4<T>& vec)
+	constexpr Vector2<T>& Vector2<T>::Set(const Vector4<T>& vec)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -470,7 +478,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Vector2<T>::SquaredDistance(const Vector2& vec) const
+	constexpr T Vector2<T>::SquaredDistance(const Vector2& vec) const
 	{
 		return (*this - vec).GetSquaredLength();
 	}
@@ -520,7 +528,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	const Vector2<T>& Vector2<T>::operator+() const
+	constexpr const Vector2<T>& Vector2<T>::operator+() const
 	{
 		return *this;
 	}
@@ -531,7 +539,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator-() const
+	constexpr Vector2<T> Vector2<T>::operator-() const
 	{
 		return Vector2(-x, -y);
 	}
@@ -544,7 +552,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator+(const Vector2& vec) const
+	constexpr Vector2<T> Vector2<T>::operator+(const Vector2& vec) const
 	{
 		return Vector2(x + vec.x, y + vec.y);
 	}
@@ -557,7 +565,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator-(const Vector2& vec) const
+	constexpr Vector2<T> Vector2<T>::operator-(const Vector2& vec) const
 	{
 		return Vector2(x - vec.x, y - vec.y);
 	}
@@ -570,7 +578,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator*(const Vector2& vec) const
+	constexpr Vector2<T> Vector2<T>::operator*(const Vector2& vec) const
 	{
 		return Vector2(x * vec.x, y * vec.y);
 	}
@@ -583,7 +591,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator*(T scale) const
+	constexpr Vector2<T> Vector2<T>::operator*(T scale) const
 	{
 		return Vector2(x * scale, y * scale);
 	}
@@ -599,15 +607,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator/(const Vector2& vec) const
+	constexpr Vector2<T> Vector2<T>::operator/(const Vector2& vec) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -625,15 +631,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::operator/(T scale) const
+	constexpr Vector2<T> Vector2<T>::operator/(T scale) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -648,7 +652,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator+=(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::operator+=(const Vector2& vec)
 	{
 		x += vec.x;
 		y += vec.y;
@@ -664,7 +668,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator-=(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::operator-=(const Vector2& vec)
 	{
 		x -= vec.x;
 		y -= vec.y;
@@ -680,7 +684,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator*=(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::operator*=(const Vector2& vec)
 	{
 		x *= vec.x;
 		y *= vec.y;
@@ -696,7 +700,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator*=(T scale)
+	constexpr Vector2<T>& Vector2<T>::operator*=(T scale)
 	{
 		x *= scale;
 		y *= scale;
@@ -715,15 +719,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator/=(const Vector2& vec)
+	constexpr Vector2<T>& Vector2<T>::operator/=(const Vector2& vec)
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -744,15 +746,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T>& Vector2<T>::operator/=(T scale)
+	constexpr Vector2<T>& Vector2<T>::operator/=(T scale)
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -770,7 +770,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator==(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator==(const Vector2& vec) const
 	{
 		return NumberEquals(x, vec.x) &&
 		       NumberEquals(y, vec.y);
@@ -784,7 +784,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator!=(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator!=(const Vector2& vec) const
 	{
 		return !operator==(vec);
 	}
@@ -797,7 +797,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator<(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator<(const Vector2& vec) const
 	{
 		if (x == vec.x)
 			return y < vec.y;
@@ -813,7 +813,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator<=(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator<=(const Vector2& vec) const
 	{
 		if (x == vec.x)
 			return y <= vec.y;
@@ -829,7 +829,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator>(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator>(const Vector2& vec) const
 	{
 		return !operator<=(vec);
 	}
@@ -842,7 +842,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector2<T>::operator>=(const Vector2& vec) const
+	constexpr bool Vector2<T>::operator>=(const Vector2& vec) const
 	{
 		return !operator<(vec);
 	}
@@ -858,7 +858,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Vector2<T>::DotProduct(const Vector2& vec1, const Vector2& vec2)
+	constexpr T Vector2<T>::DotProduct(const Vector2& vec1, const Vector2& vec2)
 	{
 		return vec1.DotProduct(vec2);
 	}
@@ -877,13 +877,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::Lerp(const Vector2& from, const Vector2& to, T interpolation)
+	constexpr Vector2<T> Vector2<T>::Lerp(const Vector2& from, const Vector2& to, T interpolation)
 	{
-		Vector2 dummy;
-		dummy.x = Nz::Lerp(from.x, to.x, interpolation);
-		dummy.y = Nz::Lerp(from.y, to.y, interpolation);
-
-		return dummy;
+		return Vector2(Nz::Lerp(from.x, to.x, interpolation), Nz::Lerp(from.y, to.y, interpolation));
 	}
 
 	/*!
@@ -911,12 +907,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::Unit()
+	constexpr Vector2<T> Vector2<T>::Unit()
 	{
-		Vector2 vector;
-		vector.MakeUnit();
-
-		return vector;
+		return Vector2(F(1.0), F(1.0));
 	}
 
 	/*!
@@ -927,12 +920,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector2<T> Vector2<T>::UnitX()
+	constexpr Vector2<T> Vector2<T>::UnitX()
 	{
-		Vector2 vector;
-		vector.MakeUnitX();
-
-		return vector;
+		return Vector2(F(1.0), F(0.0));
 	}
 
 	/*!
@@ -942,12 +932,9 @@ namespace Nz
 	* \see MakeUnitY
 	*/
 	template<typename T>
-	Vector2<T> Vector2<T>::UnitY()
+	constexpr Vector2<T> Vector2<T>::UnitY()
 	{
-		Vector2 vector;
-		vector.MakeUnitY();
-
-		return vector;
+		return Vector2(F(0.0), F(1.0));
 	}
 
 	/*!
@@ -957,12 +944,9 @@ namespace Nz
 	* \see MakeZero
 	*/
 	template<typename T>
-	Vector2<T> Vector2<T>::Zero()
+	constexpr Vector2<T> Vector2<T>::Zero()
 	{
-		Vector2 vector;
-		vector.MakeZero();
-
-		return vector;
+		return Vector2(F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1002,6 +986,9 @@ namespace Nz
 
 		return true;
 	}
+
+	template<typename T>
+	struct BulkSerializable<Vector2<T>> : BulkSerializable<T> {}; //< Components are serialized in memory order
 }
 
 /*!
@@ -1026,7 +1013,7 @@ std::ostream& operator<<(std::ostream& out, const Nz::Vector2<T>& vec)
 */
 
 template<typename T>
-Nz::Vector2<T> operator*(T scale, const Nz::Vector2<T>& vec)
+constexpr Nz::Vector2<T> operator*(T scale, const Nz::Vector2<T>& vec)
 {
 	return Nz::Vector2<T>(scale * vec.x, scale * vec.y);
 }
@@ -1042,15 +1029,13 @@ Nz::Vector2<T> operator*(T scale, const Nz::Vector2<T>& vec)
 */
 
 template<typename T>
-Nz::Vector2<T> operator/(T scale, const Nz::Vector2<T>& vec)
+constexpr Nz::Vector2<T> operator/(T scale, const Nz::Vector2<T>& vec)
 {
 	#if NAZARA_MATH_SAFE
 	if (Nz::NumberEquals(vec.x, F(0.0)) || Nz::NumberEquals(vec.y, F(0.0)))
 	{
-		Nz::String error("Division by zero");
-
-		NazaraError(error);
-		throw std::domain_error(error);
+		NazaraError("Division by zero");
+		throw std::domain_error("Division by zero");
 	}
 	#endif
 
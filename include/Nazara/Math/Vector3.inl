@@ -30,9 +30,11 @@ namespace Nz
 	* \param Z Z component
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(T X, T Y, T Z)
+	constexpr Vector3<T>::Vector3(T X, T Y, T Z) :
+	x(X),
+	y(Y),
+	z(Z)
 	{
-		Set(X, Y, Z);
 	}
 
 	/*!
@@ -42,9 +44,11 @@ namespace Nz
 	* \param vec vec.X = Y component and vec.y = Z component
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(T X, const Vector2<T>& vec)
+	constexpr Vector3<T>::Vector3(T X, const Vector2<T>& vec) :
+	x(X),
+	y(vec.x),
+	z(vec.y)
 	{
-		Set(X, vec);
 	}
 
 	/*!
@@ -53,9 +57,11 @@ namespace Nz
 	* \param scale X component = Y component = Z component
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(T scale)
+	constexpr Vector3<T>::Vector3(T scale) :
+	x(scale),
+	y(scale),
+	z(scale)
 	{
-		Set(scale);
 	}
 
 	/*!
@@ -64,9 +70,11 @@ namespace Nz
 	* \param vec[3] vec[0] is X component, vec[1] is Y component and vec[2] is Z component
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(const T vec[3])
+	constexpr Vector3<T>::Vector3(const T vec[3]) :
+	x(vec[0]),
+	y(vec[1]),
+	z(vec[2])
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -76,9 +84,11 @@ namespace Nz
 	* \param Z Z component
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(const Vector2<T>& vec, T Z)
+	constexpr Vector3<T>::Vector3(const Vector2<T>& vec, T Z) :
+	x(vec.x),
+	y(vec.y),
+	z(Z)
 	{
-		Set(vec, Z);
 	}
 
 	/*!
@@ -88,9 +98,11 @@ namespace Nz
 	*/
 	template<typename T>
 	template<typename U>
-	Vector3<T>::Vector3(const Vector3<U>& vec)
+	constexpr Vector3<T>::Vector3(const Vector3<U>& vec) :
+	x(F(vec.x)),
+	y(F(vec.y)),
+	z(F(vec.z))
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -99,9 +111,11 @@ namespace Nz
 	* \param vec Vector4 where only the first three components are taken
 	*/
 	template<typename T>
-	Vector3<T>::Vector3(const Vector4<T>& vec)
+	constexpr Vector3<T>::Vector3(const Vector4<T>& vec) :
+	x(vec.x),
+	y(vec.y),
+	z(vec.z)
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -159,7 +173,7 @@ namespace Nz
 	* \see CrossProduct
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::CrossProduct(const Vector3& vec) const
+	constexpr Vector3<T> Vector3<T>::CrossProduct(const Vector3& vec) const
 	{
 		return Vector3(y * vec.z - z * vec.y, z * vec.x - x * vec.z, x * vec.y - y * vec.x);
 	}
@@ -199,7 +213,7 @@ namespace Nz
 	* \see AbsDotProduct, DotProduct
 	*/
 	template<typename T>
-	T Vector3<T>::DotProduct(const Vector3& vec) const
+	constexpr T Vector3<T>::DotProduct(const Vector3& vec) const
 	{
 		return x * vec.x + y * vec.y + z * vec.z;
 	}
@@ -252,7 +266,7 @@ namespace Nz
 	* \see GetLength
 	*/
 	template<typename T>
-	T Vector3<T>::GetSquaredLength() const
+	constexpr T Vector3<T>::GetSquaredLength() const
 	{
 		return x*x + y*y + z*z;
 	}
@@ -264,7 +278,7 @@ namespace Nz
 	* \see Backward
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeBackward()
+	constexpr Vector3<T>& Vector3<T>::MakeBackward()
 	{
 		return Set(F(0.0), F(0.0), F(1.0));
 	}
@@ -276,7 +290,7 @@ namespace Nz
 	* \see Down
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeDown()
+	constexpr Vector3<T>& Vector3<T>::MakeDown()
 	{
 		return Set(F(0.0), F(-1.0), F(0.0));
 	}
@@ -288,7 +302,7 @@ namespace Nz
 	* \see Forward
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeForward()
+	constexpr Vector3<T>& Vector3<T>::MakeForward()
 	{
 		return Set(F(0.0), F(0.0), F(-1.0));
 	}
@@ -300,7 +314,7 @@ namespace Nz
 	* \see Left
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeLeft()
+	constexpr Vector3<T>& Vector3<T>::MakeLeft()
 	{
 		return Set(F(-1.0), F(0.0), F(0.0));
 	}
@@ -312,7 +326,7 @@ namespace Nz
 	* \see Right
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeRight()
+	constexpr Vector3<T>& Vector3<T>::MakeRight()
 	{
 		return Set(F(1.0), F(0.0), F(0.0));
 	}
@@ -324,7 +338,7 @@ namespace Nz
 	* \see Unit
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeUnit()
+	constexpr Vector3<T>& Vector3<T>::MakeUnit()
 	{
 		return Set(F(1.0), F(1.0), F(1.0));
 	}
@@ -336,7 +350,7 @@ namespace Nz
 	* \see UnitX
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeUnitX()
+	constexpr Vector3<T>& Vector3<T>::MakeUnitX()
 	{
 		return Set(F(1.0), F(0.0), F(0.0));
 	}
@@ -348,7 +362,7 @@ namespace Nz
 	* \see UnitY
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeUnitY()
+	constexpr Vector3<T>& Vector3<T>::MakeUnitY()
 	{
 		return Set(F(0.0), F(1.0), F(0.0));
 	}
@@ -360,7 +374,7 @@ namespace Nz
 	* \see UnitZ
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeUnitZ()
+	constexpr Vector3<T>& Vector3<T>::MakeUnitZ()
 	{
 		return Set(F(0.0), F(0.0), F(1.0));
 	}
@@ -372,7 +386,7 @@ namespace Nz
 	* \see Up
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeUp()
+	constexpr Vector3<T>& Vector3<T>::MakeUp()
 	{
 		return Set(F(0.0), F(1.0), F(0.0));
 	}
@@ -384,7 +398,7 @@ namespace Nz
 	* \see Zero
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::MakeZero()
+	constexpr Vector3<T>& Vector3<T>::MakeZero()
 	{
 		return Set(F(0.0), F(0.0), F(0.0));
 	}
@@ -398,7 +412,7 @@ namespace Nz
 	* \see Minimize
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Maximize(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::Maximize(const Vector3& vec)
 	{
 		if (vec.x > x)
 			x = vec.x;
@@ -421,7 +435,7 @@ namespace Nz
 	* \see Maximize
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Minimize(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::Minimize(const Vector3& vec)
 	{
 		if (vec.x < x)
 			x = vec.x;
@@ -472,7 +486,7 @@ namespace Nz
 	* \param Z Z component
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(T X, T Y, T Z)
+	constexpr Vector3<T>& Vector3<T>::Set(T X, T Y, T Z)
 	{
 		x = X;
 		y = Y;
@@ -488,7 +502,7 @@ namespace Nz
 	* \param vec vec.X = Y component and vec.y = Z component
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(T X, const Vector2<T>& vec)
+	constexpr Vector3<T>& Vector3<T>::Set(T X, const Vector2<T>& vec)
 	{
 		x = X;
 		y = vec.x;
@@ -504,7 +518,7 @@ namespace Nz
 	* \param scale X component = Y component = Z component
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(T scale)
+	constexpr Vector3<T>& Vector3<T>::Set(T scale)
 	{
 		x = scale;
 		y = scale;
@@ -520,9 +534,11 @@ namespace Nz
 	* \param vec[3] vec[0] is X component, vec[1] is Y component and vec[2] is Z component
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(const T vec[3])
+	constexpr Vector3<T>& Vector3<T>::Set(const T vec[3])
 	{
-		std::memcpy(&x, vec, 3*sizeof(T));
+		x = vec[0];
+		y = vec[1];
+		z = vec[2];
 
 		return *this;
 	}
@@ -534,7 +550,7 @@ namespace Nz
 	* \param Z Z component
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(const Vector2<T>& vec, T Z)
+	constexpr Vector3<T>& Vector3<T>::Set(const Vector2<T>& vec, T Z)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -550,9 +566,11 @@ namespace Nz
 	* \param vec The other vector
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::Set(const Vector3& vec)
 	{
-		std::memcpy(this, &vec, sizeof(Vector3));
+		x = vec.x;
+		y = vec.y;
+		z = vec.z;
 
 		return *this;
 	}
@@ -565,7 +583,7 @@ namespace Nz
 	*/
 	template<typename T>
 	template<typename U>
-	Vector3<T>& Vector3<T>::Set(const Vector3<U>& vec)
+	constexpr Vector3<T>& Vector3<T>::Set(const Vector3<U>& vec)
 	{
 		x = F(vec.x);
 		y = F(vec.y);
@@ -581,7 +599,7 @@ namespace Nz
 	* \param vec Vector4 where only the first three components are taken
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::Set(const Vector4<T>& vec)
+	constexpr Vector3<T>& Vector3<T>::Set(const Vector4<T>& vec)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -599,7 +617,7 @@ namespace Nz
 	* \see Distance
 	*/
 	template<typename T>
-	T Vector3<T>::SquaredDistance(const Vector3& vec) const
+	constexpr T Vector3<T>::SquaredDistance(const Vector3& vec) const
 	{
 		return (*this - vec).GetSquaredLength();
 	}
@@ -645,7 +663,7 @@ namespace Nz
 	* \return A constant reference to this vector
 	*/
 	template<typename T>
-	const Vector3<T>& Vector3<T>::operator+() const
+	constexpr const Vector3<T>& Vector3<T>::operator+() const
 	{
 		return *this;
 	}
@@ -655,7 +673,7 @@ namespace Nz
 	* \return A constant reference to this vector with negate components
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator-() const
+	constexpr Vector3<T> Vector3<T>::operator-() const
 	{
 		return Vector3(-x, -y, -z);
 	}
@@ -667,7 +685,7 @@ namespace Nz
 	* \param vec The other vector to add components with
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator+(const Vector3& vec) const
+	constexpr Vector3<T> Vector3<T>::operator+(const Vector3& vec) const
 	{
 		return Vector3(x + vec.x, y + vec.y, z + vec.z);
 	}
@@ -679,7 +697,7 @@ namespace Nz
 	* \param vec The other vector to substract components with
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator-(const Vector3& vec) const
+	constexpr Vector3<T> Vector3<T>::operator-(const Vector3& vec) const
 	{
 		return Vector3(x - vec.x, y - vec.y, z - vec.z);
 	}
@@ -691,7 +709,7 @@ namespace Nz
 	* \param vec The other vector to multiply components with
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator*(const Vector3& vec) const
+	constexpr Vector3<T> Vector3<T>::operator*(const Vector3& vec) const
 	{
 		return Vector3(x * vec.x, y * vec.y, z * vec.z);
 	}
@@ -703,7 +721,7 @@ namespace Nz
 	* \param scale The scalar to multiply components with
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator*(T scale) const
+	constexpr Vector3<T> Vector3<T>::operator*(T scale) const
 	{
 		return Vector3(x * scale, y * scale, z * scale);
 	}
@@ -718,15 +736,13 @@ namespace Nz
 	* \throw std::domain_error if NAZARA_MATH_SAFE is defined and one of the vec components is null
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator/(const Vector3& vec) const
+	constexpr Vector3<T> Vector3<T>::operator/(const Vector3& vec) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)) || NumberEquals(vec.z, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -743,15 +759,13 @@ namespace Nz
 	* \throw std::domain_error if NAZARA_MATH_SAFE is defined and scale is null
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::operator/(T scale) const
+	constexpr Vector3<T> Vector3<T>::operator/(T scale) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -765,7 +779,7 @@ namespace Nz
 	* \param vec The other vector to add components with
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator+=(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::operator+=(const Vector3& vec)
 	{
 		x += vec.x;
 		y += vec.y;
@@ -781,7 +795,7 @@ namespace Nz
 	* \param vec The other vector to substract components with
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator-=(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::operator-=(const Vector3& vec)
 	{
 		x -= vec.x;
 		y -= vec.y;
@@ -797,7 +811,7 @@ namespace Nz
 	* \param vec The other vector to multiply components with
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator*=(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::operator*=(const Vector3& vec)
 	{
 		x *= vec.x;
 		y *= vec.y;
@@ -813,7 +827,7 @@ namespace Nz
 	* \param vec The other vector to multiply components with
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator*=(T scale)
+	constexpr Vector3<T>& Vector3<T>::operator*=(T scale)
 	{
 		x *= scale;
 		y *= scale;
@@ -832,14 +846,12 @@ namespace Nz
 	* \throw std::domain_error if NAZARA_MATH_SAFE is defined and one of the vec components is null
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator/=(const Vector3& vec)
+	constexpr Vector3<T>& Vector3<T>::operator/=(const Vector3& vec)
 	{
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)) || NumberEquals(vec.z, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 
 		x /= vec.x;
@@ -859,14 +871,12 @@ namespace Nz
 	* \throw std::domain_error if NAZARA_MATH_SAFE is defined and scale is null
 	*/
 	template<typename T>
-	Vector3<T>& Vector3<T>::operator/=(T scale)
+	constexpr Vector3<T>& Vector3<T>::operator/=(T scale)
 	{
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 
 		x /= scale;
@@ -883,7 +893,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator==(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator==(const Vector3& vec) const
 	{
 		return NumberEquals(x, vec.x) &&
 		       NumberEquals(y, vec.y) &&
@@ -897,7 +907,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator!=(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator!=(const Vector3& vec) const
 	{
 		return !operator==(vec);
 	}
@@ -909,7 +919,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator<(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator<(const Vector3& vec) const
 	{
 		if (x == vec.x)
 		{
@@ -929,7 +939,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator<=(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator<=(const Vector3& vec) const
 	{
 		if (x == vec.x)
 		{
@@ -949,7 +959,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator>(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator>(const Vector3& vec) const
 	{
 		return !operator<=(vec);
 	}
@@ -961,7 +971,7 @@ namespace Nz
 	* \param vec Other vector to compare with
 	*/
 	template<typename T>
-	bool Vector3<T>::operator>=(const Vector3& vec) const
+	constexpr bool Vector3<T>::operator>=(const Vector3& vec) const
 	{
 		return !operator<(vec);
 	}
@@ -976,7 +986,7 @@ namespace Nz
 	* \see CrossProduct
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::CrossProduct(const Vector3& vec1, const Vector3& vec2)
+	constexpr Vector3<T> Vector3<T>::CrossProduct(const Vector3& vec1, const Vector3& vec2)
 	{
 		return vec1.CrossProduct(vec2);
 	}
@@ -991,7 +1001,7 @@ namespace Nz
 	* \see AbsDotProduct, DotProduct
 	*/
 	template<typename T>
-	T Vector3<T>::DotProduct(const Vector3& vec1, const Vector3& vec2)
+	constexpr T Vector3<T>::DotProduct(const Vector3& vec1, const Vector3& vec2)
 	{
 		return vec1.DotProduct(vec2);
 	}
@@ -1003,12 +1013,9 @@ namespace Nz
 	* \see MakeBackward
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Backward()
+	constexpr Vector3<T> Vector3<T>::Backward()
 	{
-		Vector3 vector;
-		vector.MakeBackward();
-
-		return vector;
+		return Vector3(F(0.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -1052,12 +1059,9 @@ namespace Nz
 	* \see MakeDown
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Down()
+	constexpr Vector3<T> Vector3<T>::Down()
 	{
-		Vector3 vector;
-		vector.MakeDown();
-
-		return vector;
+		return Vector3(F(0.0), F(-1.0), F(0.0));
 	}
 
 	/*!
@@ -1067,12 +1071,9 @@ namespace Nz
 	* \see Forward
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Forward()
+	constexpr Vector3<T> Vector3<T>::Forward()
 	{
-		Vector3 vector;
-		vector.MakeForward();
-
-		return vector;
+		return Vector3(F(0.0), F(0.0), F(-1.0));
 	}
 
 	/*!
@@ -1082,12 +1083,9 @@ namespace Nz
 	* \see MakeLeft
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Left()
+	constexpr Vector3<T> Vector3<T>::Left()
 	{
-		Vector3 vector;
-		vector.MakeLeft();
-
-		return vector;
+		return Vector3(F(-1.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1103,14 +1101,9 @@ namespace Nz
 	* \see Lerp
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Lerp(const Vector3& from, const Vector3& to, T interpolation)
+	constexpr Vector3<T> Vector3<T>::Lerp(const Vector3& from, const Vector3& to, T interpolation)
 	{
-		Vector3 dummy;
-		dummy.x = Nz::Lerp(from.x, to.x, interpolation);
-		dummy.y = Nz::Lerp(from.y, to.y, interpolation);
-		dummy.z = Nz::Lerp(from.z, to.z, interpolation);
-
-		return dummy;
+		return Vector3(Nz::Lerp(from.x, to.x, interpolation), Nz::Lerp(from.y, to.y, interpolation), Nz::Lerp(from.z, to.z, interpolation));
 	}
 
 	/*!
@@ -1136,12 +1129,9 @@ namespace Nz
 	* \see MakeRight
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Right()
+	constexpr Vector3<T> Vector3<T>::Right()
 	{
-		Vector3 vector;
-		vector.MakeRight();
-
-		return vector;
+		return Vector3(F(1.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1154,7 +1144,7 @@ namespace Nz
 	* \see Distance
 	*/
 	template<typename T>
-	T Vector3<T>::SquaredDistance(const Vector3& vec1, const Vector3& vec2)
+	constexpr T Vector3<T>::SquaredDistance(const Vector3& vec1, const Vector3& vec2)
 	{
 		return vec1.SquaredDistance(vec2);
 	}
@@ -1166,12 +1156,9 @@ namespace Nz
 	* \see MakeUnit
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Unit()
+	constexpr Vector3<T> Vector3<T>::Unit()
 	{
-		Vector3 vector;
-		vector.MakeUnit();
-
-		return vector;
+		return Vector3(F(1.0), F(1.0), F(1.0));
 	}
 
 	/*!
@@ -1181,12 +1168,9 @@ namespace Nz
 	* \see MakeUnitX
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::UnitX()
+	constexpr Vector3<T> Vector3<T>::UnitX()
 	{
-		Vector3 vector;
-		vector.MakeUnitX();
-
-		return vector;
+		return Vector3(F(1.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1196,12 +1180,9 @@ namespace Nz
 	* \see MakeUnitY
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::UnitY()
+	constexpr Vector3<T> Vector3<T>::UnitY()
 	{
-		Vector3 vector;
-		vector.MakeUnitY();
-
-		return vector;
+		return Vector3(F(0.0), F(1.0), F(0.0));
 	}
 
 	/*!
@@ -1211,12 +1192,9 @@ namespace Nz
 	* \see MakeUnitZ
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::UnitZ()
+	constexpr Vector3<T> Vector3<T>::UnitZ()
 	{
-		Vector3 vector;
-		vector.MakeUnitZ();
-
-		return vector;
+		return Vector3(F(0.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -1226,12 +1204,9 @@ namespace Nz
 	* \see MakeUp
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Up()
+	constexpr Vector3<T> Vector3<T>::Up()
 	{
-		Vector3 vector;
-		vector.MakeUp();
-
-		return vector;
+		return Vector3(F(0.0), F(1.0), F(0.0));
 	}
 
 	/*!
@@ -1241,12 +1216,9 @@ namespace Nz
 	* \see MakeZero
 	*/
 	template<typename T>
-	Vector3<T> Vector3<T>::Zero()
+	constexpr Vector3<T> Vector3<T>::Zero()
 	{
-		Vector3 vector;
-		vector.MakeZero();
-
-		return vector;
+		return Vector3(F(0.0), F(0.0), F(0.0));
 	}
 
 	/*!
@@ -1292,6 +1264,9 @@ namespace Nz
 
 		return true;
 	}
+
+	template<typename T>
+	struct BulkSerializable<Vector3<T>> : BulkSerializable<T> {}; //< Components are serialized in memory order
 }
 
 /*!
@@ -1316,7 +1291,7 @@ std::ostream& operator<<(std::ostream& out, const Nz::Vector3<T>& vec)
 */
 
 template<typename T>
-Nz::Vector3<T> operator*(T scale, const Nz::Vector3<T>& vec)
+constexpr Nz::Vector3<T> operator*(T scale, const Nz::Vector3<T>& vec)
 {
 	return Nz::Vector3<T>(scale * vec.x, scale * vec.y, scale * vec.z);
 }
@@ -1332,15 +1307,13 @@ Nz::Vector3<T> operator*(T scale, const Nz::Vector3<T>& vec)
 */
 
 template<typename T>
-Nz::Vector3<T> operator/(T scale, const Nz::Vector3<T>& vec)
+constexpr Nz::Vector3<T> operator/(T scale, const Nz::Vector3<T>& vec)
 {
 	#if NAZARA_MATH_SAFE
 	if (Nz::NumberEquals(vec.x, F(0.0)) || Nz::NumberEquals(vec.y, F(0.0)) || Nz::NumberEquals(vec.z, F(0.0)))
 	{
-		Nz::String error("Division by zero");
-
-		NazaraError(error);
-		throw std::domain_error(error);
+		NazaraError("Division by zero");
+		throw std::domain_error("Division by zero");
 	}
 	#endif
 
@@ -21,81 +21,81 @@ namespace Nz
 	{
 		public:
 			Vector4() = default;
-			Vector4(T X, T Y, T Z, T W = 1.0);
-			Vector4(T X, T Y, const Vector2<T>& vec);
-			Vector4(T X, const Vector2<T>& vec, T W);
-			Vector4(T X, const Vector3<T>& vec);
-			explicit Vector4(T scale);
-			Vector4(const T vec[4]);
-			Vector4(const Vector2<T>& vec, T Z = 0.0, T W = 1.0);
-			Vector4(const Vector3<T>& vec, T W = 1.0);
-			template<typename U> explicit Vector4(const Vector4<U>& vec);
+			constexpr Vector4(T X, T Y, T Z, T W = 1.0);
+			constexpr Vector4(T X, T Y, const Vector2<T>& vec);
+			constexpr Vector4(T X, const Vector2<T>& vec, T W);
+			constexpr Vector4(T X, const Vector3<T>& vec);
+			constexpr explicit Vector4(T scale);
+			constexpr Vector4(const T vec[4]);
+			constexpr Vector4(const Vector2<T>& vec, T Z = 0.0, T W = 1.0);
+			constexpr Vector4(const Vector3<T>& vec, T W = 1.0);
+			template<typename U> constexpr explicit Vector4(const Vector4<U>& vec);
 			Vector4(const Vector4& vec) = default;
 			~Vector4() = default;
 
 			T AbsDotProduct(const Vector4& vec) const;
 
-			T DotProduct(const Vector4& vec) const;
+			constexpr T DotProduct(const Vector4& vec) const;
 
 			Vector4 GetNormal(T* length = nullptr) const;
 
-			Vector4& MakeUnitX();
-			Vector4& MakeUnitY();
-			Vector4& MakeUnitZ();
-			Vector4& MakeZero();
+			constexpr Vector4& MakeUnitX();
+			constexpr Vector4& MakeUnitY();
+			constexpr Vector4& MakeUnitZ();
+			constexpr Vector4& MakeZero();
 
-			Vector4& Maximize(const Vector4& vec);
-			Vector4& Minimize(const Vector4& vec);
+			constexpr Vector4& Maximize(const Vector4& vec);
+			constexpr Vector4& Minimize(const Vector4& vec);
 
 			Vector4& Normalize(T* length = nullptr);
 
-			Vector4& Set(T X, T Y, T Z, T W = 1.0);
-			Vector4& Set(T X, T Y, const Vector2<T>& vec);
-			Vector4& Set(T X, const Vector2<T>& vec, T W);
-			Vector4& Set(T X, const Vector3<T>& vec);
-			Vector4& Set(T scale);
-			Vector4& Set(const T vec[4]);
-			Vector4& Set(const Vector2<T>& vec, T Z = 0.0, T W = 1.0);
-			Vector4& Set(const Vector3<T>& vec, T W = 1.0);
-			Vector4& Set(const Vector4<T>& vec);
-			template<typename U> Vector4& Set(const Vector4<U>& vec);
+			constexpr Vector4& Set(T X, T Y, T Z, T W = 1.0);
+			constexpr Vector4& Set(T X, T Y, const Vector2<T>& vec);
+			constexpr Vector4& Set(T X, const Vector2<T>& vec, T W);
+			constexpr Vector4& Set(T X, const Vector3<T>& vec);
+			constexpr Vector4& Set(T scale);
+			constexpr Vector4& Set(const T vec[4]);
+			constexpr Vector4& Set(const Vector2<T>& vec, T Z = 0.0, T W = 1.0);
+			constexpr Vector4& Set(const Vector3<T>& vec, T W = 1.0);
+			constexpr Vector4& Set(const Vector4<T>& vec);
+			template<typename U> constexpr Vector4& Set(const Vector4<U>& vec);
 
 			String ToString() const;
 
 			operator T* ();
 			operator const T* () const;
 
-			const Vector4& operator+() const;
-			Vector4 operator-() const;
-
-			Vector4 operator+(const Vector4& vec) const;
-			Vector4 operator-(const Vector4& vec) const;
-			Vector4 operator*(const Vector4& vec) const;
-			Vector4 operator*(T scale) const;
-			Vector4 operator/(const Vector4& vec) const;
-			Vector4 operator/(T scale) const;
-
-			Vector4& operator+=(const Vector4& vec);
-			Vector4& operator-=(const Vector4& vec);
-			Vector4& operator*=(const Vector4& vec);
-			Vector4& operator*=(T scale);
-			Vector4& operator/=(const Vector4& vec);
-			Vector4& operator/=(T scale);
-
-			bool operator==(const Vector4& vec) const;
-			bool operator!=(const Vector4& vec) const;
-			bool operator<(const Vector4& vec) const;
-			bool operator<=(const Vector4& vec) const;
-			bool operator>(const Vector4& vec) const;
-			bool operator>=(const Vector4& vec) const;
+			constexpr const Vector4& operator+() const;
+			constexpr Vector4 operator-() const;
+
+			constexpr Vector4 operator+(const Vector4& vec) const;
+			constexpr Vector4 operator-(const Vector4& vec) const;
+			constexpr Vector4 operator*(const Vector4& vec) const;
+			constexpr Vector4 operator*(T scale) const;
+			constexpr Vector4 operator/(const Vector4& vec) const;
+			constexpr Vector4 operator/(T scale) const;
+
+			constexpr Vector4& operator+=(const Vector4& vec);
+			constexpr Vector4& operator-=(const Vector4& vec);
+			constexpr Vector4& operator*=(const Vector4& vec);
+			constexpr Vector4& operator*=(T scale);
+			constexpr Vector4& operator/=(const Vector4& vec);
+			constexpr Vector4& operator/=(T scale);
+
+			constexpr bool operator==(const Vector4& vec) const;
+			constexpr bool operator!=(const Vector4& vec) const;
+			constexpr bool operator<(const Vector4& vec) const;
+			constexpr bool operator<=(const Vector4& vec) const;
+			constexpr bool operator>(const Vector4& vec) const;
+			constexpr bool operator>=(const Vector4& vec) const;
 
 			static T DotProduct(const Vector4& vec1, const Vector4& vec2);
-			static Vector4 Lerp(const Vector4& from, const Vector4& to, T interpolation);
+			static constexpr Vector4 Lerp(const Vector4& from, const Vector4& to, T interpolation);
 			static Vector4 Normalize(const Vector4& vec);
-			static Vector4 UnitX();
-			static Vector4 UnitY();
-			static Vector4 UnitZ();
-			static Vector4 Zero();
+			static constexpr Vector4 UnitX();
+			static constexpr Vector4 UnitY();
+			static constexpr Vector4 UnitZ();
+			static constexpr Vector4 Zero();
 
 			T x, y, z, w;
 	};
@@ -113,8 +113,8 @@ namespace Nz
 
 template<typename T> std::ostream& operator<<(std::ostream& out, const Nz::Vector4<T>& vec);
 
-template<typename T> Nz::Vector4<T> operator*(T scale, const Nz::Vector4<T>& vec);
-template<typename T> Nz::Vector4<T> operator/(T scale, const Nz::Vector4<T>& vec);
+template<typename T> constexpr Nz::Vector4<T> operator*(T scale, const Nz::Vector4<T>& vec);
+template<typename T> constexpr Nz::Vector4<T> operator/(T scale, const Nz::Vector4<T>& vec);
 
 #include <Nazara/Math/Vector4.inl>
 
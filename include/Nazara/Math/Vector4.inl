@@ -32,9 +32,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(T X, T Y, T Z, T W)
+	constexpr Vector4<T>::Vector4(T X, T Y, T Z, T W) :
+	x(X),
+	y(Y),
+	z(Z),
+	w(W)
 	{
-		Set(X, Y, Z, W);
 	}
 
 	/*!
@@ -46,9 +49,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(T X, T Y, const Vector2<T>& vec)
+	constexpr Vector4<T>::Vector4(T X, T Y, const Vector2<T>& vec) :
+	x(X),
+	y(Y),
+	z(vec.x),
+	w(vec.y)
 	{
-		Set(X, Y, vec);
 	}
 
 	/*!
@@ -60,9 +66,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(T X, const Vector2<T>& vec, T W)
+	constexpr Vector4<T>::Vector4(T X, const Vector2<T>& vec, T W) :
+	x(X),
+	y(vec.x),
+	z(vec.y),
+	w(W)
 	{
-		Set(X, vec, W);
 	}
 
 	/*!
@@ -73,9 +82,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(T X, const Vector3<T>& vec)
+	constexpr Vector4<T>::Vector4(T X, const Vector3<T>& vec) :
+	x(X),
+	y(vec.x),
+	z(vec.y),
+	w(vec.z)
 	{
-		Set(X, vec);
 	}
 
 	/*!
@@ -85,9 +97,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(T scale)
+	constexpr Vector4<T>::Vector4(T scale) :
+	x(scale),
+	y(scale),
+	z(scale),
+	w(scale)
 	{
-		Set(scale);
 	}
 
 	/*!
@@ -97,9 +112,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(const T vec[4])
+	constexpr Vector4<T>::Vector4(const T vec[4]) :
+	x(vec[0]),
+	y(vec[1]),
+	z(vec[2]),
+	w(vec[3])
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -111,9 +129,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(const Vector2<T>& vec, T Z, T W)
+	constexpr Vector4<T>::Vector4(const Vector2<T>& vec, T Z, T W) :
+	x(vec.x),
+	y(vec.y),
+	z(Z),
+	w(W)
 	{
-		Set(vec, Z, W);
 	}
 
 	/*!
@@ -124,9 +145,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>::Vector4(const Vector3<T>& vec, T W)
+	constexpr Vector4<T>::Vector4(const Vector3<T>& vec, T W) :
+	x(vec.x),
+	y(vec.y),
+	z(vec.z),
+	w(W)
 	{
-		Set(vec, W);
 	}
 
 	/*!
@@ -137,9 +161,12 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Vector4<T>::Vector4(const Vector4<U>& vec)
+	constexpr Vector4<T>::Vector4(const Vector4<U>& vec) :
+	x(F(vec.x)),
+	y(F(vec.y)),
+	z(F(vec.z)),
+	w(F(vec.w))
 	{
-		Set(vec);
 	}
 
 	/*!
@@ -167,7 +194,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	T Vector4<T>::DotProduct(const Vector4& vec) const
+	constexpr T Vector4<T>::DotProduct(const Vector4& vec) const
 	{
 		return x*vec.x + y*vec.y + z*vec.z + w*vec.w;
 	}
@@ -198,7 +225,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::MakeUnitX()
+	constexpr Vector4<T>& Vector4<T>::MakeUnitX()
 	{
 		return Set(F(1.0), F(0.0), F(0.0), F(1.0));
 	}
@@ -211,7 +238,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::MakeUnitY()
+	constexpr Vector4<T>& Vector4<T>::MakeUnitY()
 	{
 		return Set(F(0.0), F(1.0), F(0.0), F(1.0));
 	}
@@ -224,7 +251,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::MakeUnitZ()
+	constexpr Vector4<T>& Vector4<T>::MakeUnitZ()
 	{
 		return Set(F(0.0), F(0.0), F(1.0), F(1.0));
 	}
@@ -237,7 +264,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::MakeZero()
+	constexpr Vector4<T>& Vector4<T>::MakeZero()
 	{
 		return Set(F(0.0), F(0.0), F(0.0), F(1.0));
 	}
@@ -252,7 +279,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Maximize(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::Maximize(const Vector4& vec)
 	{
 		if (vec.x > x)
 			x = vec.x;
@@ -279,7 +306,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Minimize(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::Minimize(const Vector4& vec)
 	{
 		if (vec.x < x)
 			x = vec.x;
@@ -332,7 +359,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(T X, T Y, T Z, T W)
+	constexpr Vector4<T>& Vector4<T>::Set(T X, T Y, T Z, T W)
 	{
 		x = X;
 		y = Y;
@@ -352,7 +379,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(T X, T Y, const Vector2<T>& vec)
+	constexpr Vector4<T>& Vector4<T>::Set(T X, T Y, const Vector2<T>& vec)
 	{
 		x = X;
 		y = Y;
@@ -372,7 +399,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(T X, const Vector2<T>& vec, T W)
+	constexpr Vector4<T>& Vector4<T>::Set(T X, const Vector2<T>& vec, T W)
 	{
 		x = X;
 		y = vec.x;
@@ -391,7 +418,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(T X, const Vector3<T>& vec)
+	constexpr Vector4<T>& Vector4<T>::Set(T X, const Vector3<T>& vec)
 	{
 		x = X;
 		y = vec.x;
@@ -409,7 +436,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(T scale)
+	constexpr Vector4<T>& Vector4<T>::Set(T scale)
 	{
 		x = scale;
 		y = scale;
@@ -427,9 +454,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(const T vec[4])
+	constexpr Vector4<T>& Vector4<T>::Set(const T vec[4])
 	{
-		std::memcpy(&x, vec, 4*sizeof(T));
+		x = vec[0];
+		y = vec[1];
+		z = vec[2];
+		w = vec[3];
 
 		return *this;
 	}
@@ -443,7 +473,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(const Vector2<T>& vec, T Z, T W)
+	constexpr Vector4<T>& Vector4<T>::Set(const Vector2<T>& vec, T Z, T W)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -461,7 +491,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(const Vector3<T>& vec, T W)
+	constexpr Vector4<T>& Vector4<T>::Set(const Vector3<T>& vec, T W)
 	{
 		x = vec.x;
 		y = vec.y;
@@ -479,9 +509,12 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::Set(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::Set(const Vector4& vec)
 	{
-		std::memcpy(this, &vec, sizeof(Vector4));
+		x = vec.x;
+		y = vec.y;
+		z = vec.z;
+		w = vec.w;
 
 		return *this;
 	}
@@ -495,7 +528,7 @@ namespace Nz
 
 	template<typename T>
 	template<typename U>
-	Vector4<T>& Vector4<T>::Set(const Vector4<U>& vec)
+	constexpr Vector4<T>& Vector4<T>::Set(const Vector4<U>& vec)
 	{
 		x = F(vec.x);
 		y = F(vec.y);
@@ -550,7 +583,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	const Vector4<T>& Vector4<T>::operator+() const
+	constexpr const Vector4<T>& Vector4<T>::operator+() const
 	{
 		return *this;
 	}
@@ -561,7 +594,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator-() const
+	constexpr Vector4<T> Vector4<T>::operator-() const
 	{
 		return Vector4(-x, -y, -z, -w);
 	}
@@ -574,7 +607,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator+(const Vector4& vec) const
+	constexpr Vector4<T> Vector4<T>::operator+(const Vector4& vec) const
 	{
 		return Vector4(x + vec.x, y + vec.y, z + vec.z, w + vec.w);
 	}
@@ -587,7 +620,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator-(const Vector4& vec) const
+	constexpr Vector4<T> Vector4<T>::operator-(const Vector4& vec) const
 	{
 		return Vector4(x - vec.x, y - vec.y, z - vec.z, w - vec.w);
 	}
@@ -600,7 +633,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator*(const Vector4& vec) const
+	constexpr Vector4<T> Vector4<T>::operator*(const Vector4& vec) const
 	{
 		return Vector4(x * vec.x, y * vec.y, z * vec.z, w * vec.w);
 	}
@@ -613,7 +646,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator*(T scale) const
+	constexpr Vector4<T> Vector4<T>::operator*(T scale) const
 	{
 		return Vector4(x * scale, y * scale, z * scale, w * scale);
 	}
@@ -629,15 +662,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator/(const Vector4& vec) const
+	constexpr Vector4<T> Vector4<T>::operator/(const Vector4& vec) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)) || NumberEquals(vec.z, F(0.0)) || NumberEquals(vec.w, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -655,15 +686,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::operator/(T scale) const
+	constexpr Vector4<T> Vector4<T>::operator/(T scale) const
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -678,7 +707,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator+=(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::operator+=(const Vector4& vec)
 	{
 		x += vec.x;
 		y += vec.y;
@@ -696,7 +725,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator-=(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::operator-=(const Vector4& vec)
 	{
 		x -= vec.x;
 		y -= vec.y;
@@ -714,7 +743,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator*=(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::operator*=(const Vector4& vec)
 	{
 		x *= vec.x;
 		y *= vec.y;
@@ -732,7 +761,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator*=(T scale)
+	constexpr Vector4<T>& Vector4<T>::operator*=(T scale)
 	{
 		x *= scale;
 		y *= scale;
@@ -753,15 +782,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator/=(const Vector4& vec)
+	constexpr Vector4<T>& Vector4<T>::operator/=(const Vector4& vec)
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)) || NumberEquals(vec.z, F(0.0)) || NumberEquals(vec.w, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -784,15 +811,13 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T>& Vector4<T>::operator/=(T scale)
+	constexpr Vector4<T>& Vector4<T>::operator/=(T scale)
 	{
 		#if NAZARA_MATH_SAFE
 		if (NumberEquals(scale, F(0.0)))
 		{
-			String error("Division by zero");
-
-			NazaraError(error);
-			throw std::domain_error(error);
+			NazaraError("Division by zero");
+			throw std::domain_error("Division by zero");
 		}
 		#endif
 
@@ -812,7 +837,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator==(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator==(const Vector4& vec) const
 	{
 		return NumberEquals(x, vec.x) &&
 		       NumberEquals(y, vec.y) &&
@@ -828,7 +853,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator!=(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator!=(const Vector4& vec) const
 	{
 		return !operator==(vec);
 	}
@@ -841,7 +866,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator<(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator<(const Vector4& vec) const
 	{
 		if (x == vec.x)
 		{
@@ -867,7 +892,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator<=(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator<=(const Vector4& vec) const
 	{
 		if (x == vec.x)
 		{
@@ -893,7 +918,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator>(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator>(const Vector4& vec) const
 	{
 		return !operator<=(vec);
 	}
@@ -906,7 +931,7 @@ namespace Nz
 	*/
 
 	template<typename T>
-	bool Vector4<T>::operator>=(const Vector4& vec) const
+	constexpr bool Vector4<T>::operator>=(const Vector4& vec) const
 	{
 		return !operator<(vec);
 	}
@@ -925,15 +950,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::Lerp(const Vector4& from, const Vector4& to, T interpolation)
+	constexpr Vector4<T> Vector4<T>::Lerp(const Vector4& from, const Vector4& to, T interpolation)
 	{
-		Vector4 dummy;
-		dummy.x = Nz::Lerp(from.x, to.x, interpolation);
-		dummy.y = Nz::Lerp(from.y, to.y, interpolation);
-		dummy.z = Nz::Lerp(from.z, to.z, interpolation);
-		dummy.w = Nz::Lerp(from.w, to.w, interpolation);
-
-		return dummy;
+		return Vector4(Nz::Lerp(from.x, to.x, interpolation), Nz::Lerp(from.y, to.y, interpolation), Nz::Lerp(from.z, to.z, interpolation), Nz::Lerp(from.w, to.w, interpolation));
 	}
 
 	/*!
@@ -959,12 +978,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::UnitX()
+	constexpr Vector4<T> Vector4<T>::UnitX()
 	{
-		Vector4 vector;
-		vector.MakeUnitX();
-
-		return vector;
+		return Vector4(F(1.0), F(0.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -975,12 +991,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::UnitY()
+	constexpr Vector4<T> Vector4<T>::UnitY()
 	{
-		Vector4 vector;
-		vector.MakeUnitY();
-
-		return vector;
+		return Vector4(F(0.0), F(1.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -991,12 +1004,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::UnitZ()
+	constexpr Vector4<T> Vector4<T>::UnitZ()
 	{
-		Vector4 vector;
-		vector.MakeUnitZ();
-
-		return vector;
+		return Vector4(F(0.0), F(0.0), F(1.0), F(1.0));
 	}
 
 	/*!
@@ -1007,12 +1017,9 @@ namespace Nz
 	*/
 
 	template<typename T>
-	Vector4<T> Vector4<T>::Zero()
+	constexpr Vector4<T> Vector4<T>::Zero()
 	{
-		Vector4 vector;
-		vector.MakeZero();
-
-		return vector;
+		return Vector4(F(0.0), F(0.0), F(0.0), F(1.0));
 	}
 
 	/*!
@@ -1064,6 +1071,9 @@ namespace Nz
 
 		return true;
 	}
+
+	template<typename T>
+	struct BulkSerializable<Vector4<T>> : BulkSerializable<T> {}; //< Components are serialized in memory order
 }
 
 /*!
@@ -1089,7 +1099,7 @@ std::ostream& operator<<(std::ostream& out, const Nz::Vector4<T>& vec)
 
 
 template<typename T>
-Nz::Vector4<T> operator*(T scale, const Nz::Vector4<T>& vec)
+constexpr Nz::Vector4<T> operator*(T scale, const Nz::Vector4<T>& vec)
 {
 	return Nz::Vector4<T>(scale * vec.x, scale * vec.y, scale * vec.z, scale * vec.w);
 }
@@ -1105,15 +1115,13 @@ Nz::Vector4<T> operator*(T scale, const Nz::Vector4<T>& vec)
 */
 
 template<typename T>
-Nz::Vector4<T> operator/(T scale, const Nz::Vector4<T>& vec)
+constexpr Nz::Vector4<T> operator/(T scale, const Nz::Vector4<T>& vec)
 {
 	#if NAZARA_MATH_SAFE
 	if (NumberEquals(vec.x, F(0.0)) || NumberEquals(vec.y, F(0.0)) || NumberEquals(vec.z, F(0.0)) || NumberEquals(vec.w, F(0.0)))
 	{
-		Nz::String error("Division by zero");
-
-		NazaraError(error);
-		throw std::domain_error(error);
+		NazaraError("Division by zero");
+		throw std::domain_error("Division by zero");
 	}
 	#endif
 
@@ -8,12 +8,15 @@
 #define NAZARA_ALGORITHM_NETWORK_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <functional>
 #include <tuple>
 
 namespace Nz
 {
+	NAZARA_NETWORK_API bool DecodeDelta(const void* reference, std::size_t referenceSize, const void* delta, std::size_t deltaSize, ByteArray* data);
+	NAZARA_NETWORK_API void EncodeDelta(const void* reference, std::size_t referenceSize, const void* data, std::size_t dataSize, ByteArray* delta);
 	NAZARA_NETWORK_API bool ParseIPAddress(const char* addressPtr, UInt8 result[16], UInt16* port = nullptr, bool* isIPv6 = nullptr, const char** endOfRead = nullptr);
 }
 
@@ -89,6 +89,24 @@ namespace Nz
 		SocketError_Max = SocketError_UnreachableHost
 	};
 
+	enum SocketPollEventFlags
+	{
+		SocketPollEvent_None  = 0x0,
+
+		SocketPollEvent_Read  = 0x1, //< The socket has data to read, a pending connection or has been closed by its peer
+		SocketPollEvent_Write = 0x2, //< The socket can send data or has finished connecting
+
+		SocketPollEvent_Max = SocketPollEvent_Write*2-1
+	};
+
+	enum SocketPollMode
+	{
+		SocketPollMode_EdgeTriggered,  //< Readiness is reported once when it happens, the socket has to be read or written until it would block
+		SocketPollMode_LevelTriggered, //< Readiness is reported by every wait, as long as it lasts
+
+		SocketPollMode_Max = SocketPollMode_LevelTriggered
+	};
+
 	enum SocketState
 	{
 		SocketState_Bound,        //< The socket is currently bound
@@ -11,6 +11,7 @@
 #include <Nazara/Core/String.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/Enums.hpp>
+#include <Nazara/Network/ResolveHandle.hpp>
 #include <array>
 #include <iosfwd>
 
@@ -55,8 +56,12 @@ namespace Nz
 			IpAddress& operator=(const IpAddress&) = default;
 			IpAddress& operator=(IpAddress&&) = default;
 
+			static void ClearResolveCache();
 			static String ResolveAddress(const IpAddress& address, String* service = nullptr, ResolveError* error = nullptr);
+			static ResolveHandle ResolveAddressAsync(const IpAddress& address, ResolveCallback callback = ResolveCallback());
 			static std::vector<HostnameInfo> ResolveHostname(NetProtocol procol, const String& hostname, const String& protocol = "http", ResolveError* error = nullptr);
+			static ResolveHandle ResolveHostnameAsync(NetProtocol procol, const String& hostname, const String& protocol = "http", ResolveCallback callback = ResolveCallback());
+			static void SetResolveCacheDuration(UInt32 msDuration);
 
 			inline friend std::ostream& operator<<(std::ostream& out, const IpAddress& address);
 
@@ -10,7 +10,6 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Core/MemoryStream.hpp>
-#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Network/Config.hpp>
 
@@ -21,6 +20,8 @@ namespace Nz
 		friend class Network;
 
 		public:
+			struct BufferPoolStats;
+
 			inline NetPacket();
 			inline NetPacket(UInt16 netCode, std::size_t minCapacity = 0);
 			inline NetPacket(UInt16 netCode, const void* ptr, std::size_t size);
@@ -49,6 +50,7 @@ namespace Nz
 
 			static bool DecodeHeader(const void* data, UInt16* packetSize, UInt16* netCode);
 			static bool EncodeHeader(void* data, UInt16 packetSize, UInt16 netCode);
+			static BufferPoolStats GetBufferPoolStats();
 
 			static constexpr std::size_t HeaderSize = sizeof(UInt16) + sizeof(UInt16); //< PacketSize + NetCode
 
@@ -64,9 +66,15 @@ namespace Nz
 			std::unique_ptr<ByteArray> m_buffer;
 			MemoryStream m_memoryStream;
 			UInt16 m_netCode;
+	};
 
-			static std::unique_ptr<Mutex> s_availableBuffersMutex;
-			static std::vector<std::pair<std::size_t, std::unique_ptr<ByteArray>>> s_availableBuffers;
+	struct NetPacket::BufferPoolStats
+	{
+		UInt64 acquiredBuffers;    //< Buffers requested by packets
+		UInt64 allocatedBuffers;   //< Requests which had to allocate a new buffer
+		UInt64 outstandingBuffers; //< Buffers currently owned by packets
+		UInt64 reusedBuffers;      //< Requests served by the pool
+		float hitRate;             //< Ratio of requests served by the pool
 	};
 }
 
@@ -25,6 +25,8 @@ namespace Nz
 
 			static void Uninitialize();
 
+			static constexpr bool ParallelInitialization = true;
+
 		private:
 			static unsigned int s_moduleReferenceCounter;
     };
@@ -10,14 +10,19 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/SpscQueue.hpp>
+#include <Nazara/Core/Thread.hpp>
 #include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Core/LZ4Compressor.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Network/RUdpMessage.hpp>
 #include <Nazara/Network/UdpSocket.hpp>
+#include <array>
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <queue>
 #include <random>
-#include <set>
 #include <unordered_map>
 
 namespace Nz
@@ -29,12 +34,17 @@ namespace Nz
 		friend class Network;
 
 		public:
+			struct PeerStatistics;
+			struct SimulationParameters;
+
 			using SequenceIndex = UInt16;
 
 			RUdpConnection();
 			RUdpConnection(const RUdpConnection&) = delete;
 			RUdpConnection(RUdpConnection&&) = default;
-			~RUdpConnection() = default;
+			~RUdpConnection();
+
+			bool Broadcast(const IpAddress* peerIps, std::size_t peerCount, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId = 0);
 
 			inline void Close();
 
@@ -42,40 +52,89 @@ namespace Nz
 			bool Connect(const String& hostName, NetProtocol protocol = NetProtocol_Any, const String& service = "http", ResolveError* error = nullptr);
 			inline void Disconnect();
 
+			void EnableAggregation(bool aggregation, std::size_t maxDatagramSize = 1200);
+			void EnableCompression(bool compression, std::size_t threshold = 128);
+			void EnableThreading(bool threaded);
+
 			inline IpAddress GetBoundAddress() const;
 			inline UInt16 GetBoundPort() const;
 			inline SocketError GetLastError() const;
+			bool GetPeerStatistics(const IpAddress& peerIp, PeerStatistics* statistics) const;
+
+			inline bool IsAggregationEnabled() const;
+			inline bool IsCompressionEnabled() const;
+			inline bool IsThreadingEnabled() const;
 
 			inline bool Listen(NetProtocol protocol, UInt16 port = 64266);
 			bool Listen(const IpAddress& address);
 
 			bool PollMessage(RUdpMessage* message);
 
-			bool Send(const IpAddress& clientIp, PacketPriority priority, PacketReliability reliability, const NetPacket& packet);
+			bool Send(const IpAddress& clientIp, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId = 0);
 
+			inline void SetBandwidthLimit(UInt32 bytesPerSecond);
+			void SetCompressionDictionary(const void* dictionary, std::size_t dictionarySize);
 			inline void SetProtocolId(UInt32 protocolId);
 			inline void SetTimeBeforeAck(UInt32 ms);
 
 			inline void SimulateNetwork(double packetLoss);
+			void SimulateNetwork(const SimulationParameters& parameters);
 
 			void Update();
 
 			RUdpConnection& operator=(const RUdpConnection&) = delete;
 			RUdpConnection& operator=(RUdpConnection&&) = default;
 
-			static constexpr std::size_t MessageHeader = sizeof(UInt16) + 2 * sizeof(SequenceIndex) + sizeof(UInt32); //< Protocol ID (begin) + Sequence ID + Remote Sequence ID + Ack bitfield
+			static constexpr std::size_t AggregateHeader = sizeof(UInt16) + sizeof(UInt8) + sizeof(UInt16); //< Net code + Flags + Payload size of each aggregated message
+			static constexpr std::size_t AckWindowSize = 128; //< Maximum number of packets waiting for an ack per peer (must divide the sequence range)
+			static constexpr std::size_t MessageHeader = sizeof(UInt16) + 2 * sizeof(SequenceIndex) + sizeof(UInt32) + sizeof(UInt8); //< Protocol ID (begin) + Sequence ID + Remote Sequence ID + Ack bitfield + Flags
 			static constexpr std::size_t MessageFooter = sizeof(UInt16); //< Protocol ID (end)
+			static constexpr std::size_t ReceiveBatchSize = 32; //< Maximum number of packets received by a single system call
 
 			// Signals:
-			NazaraSignal(OnConnectedToPeer,  RUdpConnection* /*connection*/);
-			NazaraSignal(OnPeerAcknowledged, RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
-			NazaraSignal(OnPeerConnection,   RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
-			NazaraSignal(OnPeerDisconnected, RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
+			NazaraSignal(OnConnectedToPeer,     RUdpConnection* /*connection*/);
+			NazaraSignal(OnMessageAcknowledged, RUdpConnection* /*connection*/, const IpAddress& /*adress*/, UInt32 /*messageId*/);
+			NazaraSignal(OnPeerAcknowledged,    RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
+			NazaraSignal(OnPeerConnection,      RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
+			NazaraSignal(OnPeerDisconnected,    RUdpConnection* /*connection*/, const IpAddress& /*adress*/);
+
+			struct PeerStatistics
+			{
+				float congestionWindow; //< Number of packets allowed to wait for an ack
+				float packetLoss; //< Recent ratio of lost packets, in range [0..1]
+				std::size_t inFlightPacketCount; //< Number of packets waiting for an ack
+				std::size_t pendingPacketCount; //< Number of packets waiting to be sent
+				UInt32 roundTripTime; //< Smoothed round-trip time, in microseconds
+				UInt32 roundTripTimeVariation; //< Mean deviation of the round-trip time (jitter), in microseconds
+				UInt64 bytesReceived;
+				UInt64 bytesSent;
+				UInt64 packetsLost;
+				UInt64 packetsReceived;
+				UInt64 packetsSent;
+			};
+
+			struct SimulationParameters
+			{
+				double packetLoss = 0.0; //< Ratio of received packets which are dropped, in range [0..1]
+				double reorderProbability = 0.0; //< Ratio of received packets held back for another latency, in range [0..1]
+				UInt32 bandwidth = 0; //< Bytes per second the incoming link can deliver, zero for unlimited
+				UInt32 jitter = 0; //< Maximum random delay added to the latency, in microseconds
+				UInt32 latency = 0; //< Delay before a received packet is processed, in microseconds
+			};
 
 		private:
+			struct DelayedPacket;
+			struct OutgoingMessage;
 			struct PeerData;
 			struct PendingAckPacket;
 			struct PendingPacket;
+			struct ThreadData;
+
+			enum MessageFlags
+			{
+				MessageFlag_Aggregated = 0x02, //< The payload holds many messages, each one prefixed by an aggregate header
+				MessageFlag_Compressed = 0x01  //< The payload is LZ4 compressed, and starts with its original size
+			};
 
 			enum PeerState
 			{
@@ -85,37 +144,73 @@ namespace Nz
 				PeerState_WillAck      //< Connected, received one or more packets and has no packets to send, waiting before sending an empty ack packet
 			};
 
+			std::size_t AggregatePackets(PeerData& peer, const PendingPacket* packets, std::size_t packetCount, PendingPacket* aggregate);
+			std::size_t AllocatePacket();
+			bool CanSendPacket(const PeerData& peer) const;
+			inline UInt64 ComputeRetransmissionTimeout(const PeerData& peer) const;
+			bool DecompressPacket(NetPacket& packet);
 			void DisconnectPeer(std::size_t peerIndex);
-			void EnqueuePacket(PeerData& peer, PacketPriority priority, PacketReliability reliability, const NetPacket& packet);
-			void EnqueuePacketInternal(PeerData& peer, PacketPriority priority, PacketReliability reliability, NetPacket&& data);
+			std::size_t EncodePacket(const NetPacket& packet);
+			void EnqueueMessage(const OutgoingMessage& message);
+			void EnqueuePacket(PeerData& peer, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId = 0);
+			void EnqueuePacketInternal(PeerData& peer, PacketPriority priority, PacketReliability reliability, std::size_t packetIndex, UInt32 messageId);
 			bool InitSocket(NetProtocol protocol);
 			void ProcessAcks(PeerData& peer, SequenceIndex lastAck, UInt32 ackBits);
 			PeerData& RegisterPeer(const IpAddress& address, PeerState state);
+			void OnAggregateReceived(const IpAddress& peerIp, NetPacket& packet);
 			void OnClientRequestingConnection(const IpAddress& address, SequenceIndex sequenceId, UInt64 token);
-			void OnPacketLost(PeerData& peer, PendingAckPacket&& packet);
+			void OnPacketLost(PeerData& peer, const PendingAckPacket& packet);
 			void OnPacketReceived(const IpAddress& peerIp, NetPacket&& packet);
-			void SendPacket(PeerData& peer, PendingPacket&& packet);
+			void ProcessNetwork();
+			void ProcessSimulatedPackets();
+			void RefillSendBudget(PeerData& peer);
+			inline void ReleasePacket(std::size_t packetIndex);
+			void SendPacket(PeerData& peer, PendingPacket packet);
+			void SimulateReception(const IpAddress& peerIp, NetPacket&& packet);
+			void ThreadMain();
+			void UpdateRoundTripTime(PeerData& peer, UInt32 sample);
 
 			static inline unsigned int ComputeSequenceDifference(SequenceIndex sequence, SequenceIndex sequence2);
 			static inline bool HasPendingPackets(PeerData& peer);
 			static bool Initialize();
 			static inline bool IsAckMoreRecent(SequenceIndex ack, SequenceIndex ack2);
+			static inline bool IsDeliveredLater(const DelayedPacket& first, const DelayedPacket& second);
 			static inline bool IsReliable(PacketReliability reliability);
 			static void Uninitialize();
 
+			struct DelayedPacket
+			{
+				IpAddress from;
+				NetPacket data;
+				UInt64 deliveryTime;
+				UInt64 order; //< Keeps the reception order of packets delivered at the same time
+			};
+
+			struct OutgoingMessage
+			{
+				IpAddress to;
+				NetPacket data;
+				std::vector<IpAddress> broadcastTo; //< Peers of a broadcast, the packet being copied once for all of them
+				PacketPriority priority;
+				PacketReliability reliability;
+				UInt32 messageId;
+			};
+
 			struct PendingPacket
 			{
 				PacketPriority priority;
 				PacketReliability reliability;
-				NetPacket data;
+				std::size_t packetIndex; //< In m_packets
+				UInt32 messageId;
 			};
 
 			struct PendingAckPacket
 			{
 				PacketPriority priority;
 				PacketReliability reliability;
-				NetPacket data;
+				std::size_t packetIndex; //< In m_packets
 				SequenceIndex sequenceId;
+				UInt32 messageId;
 				UInt64 timeSent;
 			};
 
@@ -126,34 +221,85 @@ namespace Nz
 				PeerData& operator=(PeerData&& other) = default;
 
 				std::array<std::vector<PendingPacket>, PacketPriority_Max + 1> pendingPackets;
-				std::deque<PendingAckPacket> pendingAckQueue;
-				std::set<UInt16> receivedQueue;
+				std::array<PendingAckPacket, AckWindowSize> pendingAcks; //< Indexed by sequence id modulo the window size
+				Bitset<UInt64> pendingAckSlots;
 				std::size_t index;
 				PeerState state;
 				IpAddress address;
 				SequenceIndex localSequence;
 				SequenceIndex remoteSequence;
+				bool hasRoundTripTime; //< Whether an ack has measured the round-trip time yet
+				double bandwidthCredit; //< Bytes which can be sent before reaching the bandwidth limit
+				double pacingCredit;    //< Packets which can be sent before exceeding the pacing rate
+				float congestionWindow;
+				float packetLoss;
+				float slowStartThreshold;
 				UInt32 roundTripTime;
+				UInt32 roundTripTimeVariation;
+				UInt64 bytesReceived;
+				UInt64 bytesSent;
+				UInt64 congestionTime; //< Last time the congestion window was reduced
+				UInt64 lastBudgetTime;
 				UInt64 lastPacketTime;
 				UInt64 lastPingTime;
+				UInt64 packetsLost;
+				UInt64 packetsReceived;
+				UInt64 packetsSent;
+				UInt64 receivedSequences; //< Bit n is set if remoteSequence - n has been received
 				UInt64 stateData1;
 			};
 
+			struct ThreadData
+			{
+				static constexpr std::size_t QueueCapacity = 1024;
+
+				SpscQueue<OutgoingMessage> outgoingMessages{QueueCapacity}; //< Filled by the game thread
+				SpscQueue<RUdpMessage> receivedMessages{QueueCapacity};     //< Filled by the network thread
+				std::atomic_bool isRunning;
+				Thread thread;
+			};
+
 			std::bernoulli_distribution m_packetLossProbability;
+			std::bernoulli_distribution m_reorderProbability;
+			static constexpr std::size_t PeerHeaderSize = NetPacket::HeaderSize + MessageHeader; //< Part of a datagram written for each peer, the rest being shared by broadcasts
+
+			using PeerHeader = std::array<UInt8, PeerHeaderSize>;
+
+			std::deque<NetPacket> m_packets; //< Pool of outgoing packets, deque elements keep their address while more are added
 			std::queue<RUdpMessage> m_receivedMessages;
+			std::size_t m_compressionThreshold;
+			std::size_t m_maxDatagramSize;
 			std::size_t m_peerIterator;
+			std::unique_ptr<ThreadData> m_threadData;
 			std::unordered_map<IpAddress, std::size_t> m_peerByIP;
+			std::vector<IpAddress> m_outgoingAddresses;
+			std::vector<IpAddress> m_receivedAddresses;
+			std::vector<DelayedPacket> m_delayedPackets; //< Heap of the packets held back by the simulation, earliest delivery first
+			std::vector<NetBuffer> m_outgoingBuffers;
+			std::vector<NetPacket> m_receivedPackets;
 			std::vector<PeerData> m_peers;
+			std::vector<PeerHeader> m_outgoingHeaders;
+			std::vector<const NetPacket*> m_outgoingPackets;
+			std::vector<std::size_t> m_freePackets;
+			std::vector<std::size_t> m_releasedPackets;
+			std::vector<UInt32> m_packetReferences; //< Number of pending packets referencing each packet of the pool
 			Bitset<UInt64> m_activeClients;
 			Clock m_clock;
+			LZ4Compressor m_compressor;
+			SimulationParameters m_simulation;
 			SocketError m_lastError;
 			UdpSocket m_socket;
+			UInt32 m_bandwidthLimit;
 			UInt32 m_forceAckSendTime;
 			UInt32 m_pingInterval;
 			UInt32 m_protocol;
 			UInt32 m_timeBeforePing;
 			UInt32 m_timeBeforeTimeOut;
 			UInt64 m_currentTime;
+			UInt64 m_delayedPacketCount;
+			UInt64 m_simulatedLinkTime; //< Time at which the simulated incoming link is done delivering the last packet
+			bool m_isAggregationEnabled;
+			bool m_isCompressionEnabled;
 			bool m_isSimulationEnabled;
 			bool m_shouldAcceptConnections;
 
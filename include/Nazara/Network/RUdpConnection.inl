@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Network/RUdpConnection.hpp>
+#include <algorithm>
 #include <utility>
 #include <Nazara/Network/Debug.hpp>
 
@@ -14,6 +15,8 @@ namespace Nz
 
 	inline void RUdpConnection::Close()
 	{
+		EnableThreading(false);
+
 		m_socket.Close();
 	}
 
@@ -58,6 +61,36 @@ namespace Nz
 		return m_lastError;
 	}
 
+	/*!
+	* \brief Checks whether small messages are aggregated into shared datagrams
+	* \return true If it is the case
+	*/
+
+	inline bool RUdpConnection::IsAggregationEnabled() const
+	{
+		return m_isAggregationEnabled;
+	}
+
+	/*!
+	* \brief Checks whether payloads are compressed
+	* \return true If it is the case
+	*/
+
+	inline bool RUdpConnection::IsCompressionEnabled() const
+	{
+		return m_isCompressionEnabled;
+	}
+
+	/*!
+	* \brief Checks whether a network thread updates the connection
+	* \return true If it is the case
+	*/
+
+	inline bool RUdpConnection::IsThreadingEnabled() const
+	{
+		return m_threadData != nullptr;
+	}
+
 	/*!
 	* \brief Listens to a socket
 	* \return true If successfully bound
@@ -94,6 +127,22 @@ namespace Nz
 		return Listen(any);
 	}
 
+	/*!
+	* \brief Limits the bandwidth used to send packets to each peer
+	*
+	* \param bytesPerSecond Maximum number of bytes sent to a peer per second, zero for no limit
+	*
+	* \remark Packets of higher priorities are sent first, immediate ones are sent even above the limit (which is then caught up on)
+	* \remark Produces a NazaraAssert if threading is enabled
+	*/
+
+	inline void RUdpConnection::SetBandwidthLimit(UInt32 bytesPerSecond)
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot change bandwidth limit while the network thread is running");
+
+		m_bandwidthLimit = bytesPerSecond;
+	}
+
 	/*!
 	* \brief Sets the protocol id
 	*
@@ -116,6 +165,35 @@ namespace Nz
 		m_forceAckSendTime = ms * 1000; //< Store in microseconds for easier handling
 	}
 
+	/*!
+	* \brief Releases a reference to a packet, giving it back to the pool once no peer references it
+	*
+	* \param packetIndex Index of the packet
+	*
+	* \remark The packet may still be waiting to be sent, it can only be reused after the current update
+	*/
+
+	inline void RUdpConnection::ReleasePacket(std::size_t packetIndex)
+	{
+		NazaraAssert(m_packetReferences[packetIndex] > 0, "Packet is not referenced");
+
+		if (--m_packetReferences[packetIndex] == 0)
+			m_releasedPackets.push_back(packetIndex);
+	}
+
+	/*!
+	* \brief Computes the time after which a packet waiting for an ack is considered lost
+	* \return Retransmission timeout in microseconds
+	*
+	* \param peer Data relative to the peer
+	*/
+
+	inline UInt64 RUdpConnection::ComputeRetransmissionTimeout(const PeerData& peer) const
+	{
+		// Acks may be delayed by the peer while it has nothing to send
+		return std::max<UInt64>(peer.roundTripTime + 4 * peer.roundTripTimeVariation, 2 * m_forceAckSendTime);
+	}
+
 	/*!
 	* \brief Computes the difference of sequence
 	* \return Delta between the two sequences
@@ -126,13 +204,7 @@ namespace Nz
 
 	inline unsigned int RUdpConnection::ComputeSequenceDifference(SequenceIndex sequence, SequenceIndex sequence2)
 	{
-		unsigned int difference;
-		if (sequence2 > sequence)
-			difference = std::numeric_limits<SequenceIndex>::max() - sequence2 + sequence;
-		else
-			difference = sequence - sequence2;
-
-		return difference;
+		return static_cast<SequenceIndex>(sequence - sequence2); //< Wraps around the sequence range
 	}
 
 	/*!
@@ -174,6 +246,22 @@ namespace Nz
 			return false; ///< Same ack
 	}
 
+	/*!
+	* \brief Orders the heap of delayed packets
+	* \return true If the first packet has to be delivered after the second one
+	*
+	* \param first First delayed packet
+	* \param second Second delayed packet
+	*/
+
+	inline bool RUdpConnection::IsDeliveredLater(const DelayedPacket& first, const DelayedPacket& second)
+	{
+		if (first.deliveryTime != second.deliveryTime)
+			return first.deliveryTime > second.deliveryTime;
+		else
+			return first.order > second.order;
+	}
+
 	/*!
 	* \brief Checks whether the connection is reliable
 	* \return true If it is the case
@@ -209,13 +297,10 @@ namespace Nz
 	{
 		NazaraAssert(packetLoss >= 0.0 && packetLoss <= 1.0, "Packet loss must be in range [0..1]");
 
-		if (packetLoss > 0.0)
-		{
-			m_isSimulationEnabled = true;
-			m_packetLossProbability = std::bernoulli_distribution(packetLoss);
-		}
-		else
-			m_isSimulationEnabled = false;
+		SimulationParameters parameters;
+		parameters.packetLoss = packetLoss;
+
+		SimulateNetwork(parameters);
 	}
 }
 
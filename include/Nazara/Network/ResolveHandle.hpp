@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_RESOLVEHANDLE_HPP
+#define NAZARA_RESOLVEHANDLE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/Enums.hpp>
+#include <functional>
+#include <vector>
+
+namespace Nz
+{
+	class AsyncResolver;
+	class ResolveHandle;
+	struct HostnameInfo;
+	struct ResolveState;
+
+	using ResolveCallback = std::function<void(const ResolveHandle& handle)>;
+
+	class NAZARA_NETWORK_API ResolveHandle
+	{
+		friend AsyncResolver;
+
+		public:
+			ResolveHandle();
+			ResolveHandle(const ResolveHandle& handle);
+			ResolveHandle(ResolveHandle&& handle) noexcept;
+			~ResolveHandle();
+
+			ResolveError GetError() const;
+			const String& GetHostname() const;
+			const std::vector<HostnameInfo>& GetResults() const;
+			const String& GetService() const;
+
+			bool IsDone() const;
+			bool IsValid() const;
+
+			void Reset();
+
+			void Wait() const;
+
+			ResolveHandle& operator=(const ResolveHandle& handle);
+			ResolveHandle& operator=(ResolveHandle&& handle) noexcept;
+
+		private:
+			explicit ResolveHandle(ResolveState* state);
+
+			ResolveState* m_state;
+	};
+}
+
+#endif // NAZARA_RESOLVEHANDLE_HPP
@@ -0,0 +1,64 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SOCKETPOLLER_HPP
+#define NAZARA_SOCKETPOLLER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Network/AbstractSocket.hpp>
+#include <Nazara/Network/Config.hpp>
+#include <Nazara/Network/Enums.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <vector>
+
+namespace Nz
+{
+	class SocketPollerImpl;
+
+	class NAZARA_NETWORK_API SocketPoller
+	{
+		public:
+			struct ReadySocket;
+
+			SocketPoller();
+			SocketPoller(const SocketPoller&) = delete;
+			inline SocketPoller(SocketPoller&& socketPoller);
+			~SocketPoller();
+
+			void Clear();
+
+			const std::vector<ReadySocket>& GetReadySockets() const;
+			std::size_t GetSocketCount() const;
+
+			bool IsReadyToRead(const AbstractSocket& socket) const;
+			bool IsReadyToWrite(const AbstractSocket& socket) const;
+			bool IsRegistered(const AbstractSocket& socket) const;
+
+			bool RegisterSocket(AbstractSocket& socket, UInt32 eventFlags, SocketPollMode mode = SocketPollMode_LevelTriggered, void* userdata = nullptr);
+			void UnregisterSocket(AbstractSocket& socket);
+			bool UpdateSocket(AbstractSocket& socket, UInt32 eventFlags, SocketPollMode mode = SocketPollMode_LevelTriggered, void* userdata = nullptr);
+
+			std::size_t Wait(int msTimeout, SocketError* error = nullptr);
+			void Wake();
+
+			SocketPoller& operator=(const SocketPoller&) = delete;
+			inline SocketPoller& operator=(SocketPoller&& socketPoller);
+
+			struct ReadySocket
+			{
+				SocketHandle handle;
+				UInt32 eventFlags; //< Combination of SocketPollEventFlags
+				void* userdata;
+			};
+
+		private:
+			SocketPollerImpl* m_impl;
+	};
+}
+
+#include <Nazara/Network/SocketPoller.inl>
+
+#endif // NAZARA_SOCKETPOLLER_HPP
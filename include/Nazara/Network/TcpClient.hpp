@@ -13,6 +13,7 @@
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Network/AbstractSocket.hpp>
 #include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/NetBuffer.hpp>
 
 namespace Nz
 {
@@ -33,6 +34,7 @@ namespace Nz
 
 			void EnableLowDelay(bool lowDelay);
 			void EnableKeepAlive(bool keepAlive, UInt64 msTime = 10000, UInt64 msInterval = 1000);
+			void EnableWriteCoalescing(bool coalescing, std::size_t flushSize = 1400, UInt32 msFlushDelay = 5);
 
 			bool EndOfStream() const override;
 
@@ -44,11 +46,13 @@ namespace Nz
 
 			inline bool IsLowDelayEnabled() const;
 			inline bool IsKeepAliveEnabled() const;
+			inline bool IsWriteCoalescingEnabled() const;
 
 			bool Receive(void* buffer, std::size_t size, std::size_t* received);
 			bool ReceivePacket(NetPacket* packet);
 
 			bool Send(const void* buffer, std::size_t size, std::size_t* sent);
+			bool SendMultiple(const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent);
 			bool SendPacket(const NetPacket& packet);
 
 			bool SetCursorPos(UInt64 offset) override;
@@ -58,6 +62,7 @@ namespace Nz
 			inline TcpClient& operator=(TcpClient&& tcpClient) = default;
 
 		private:
+			bool FlushWriteBuffer();
 			void FlushStream() override;
 
 			void OnClose() override;
@@ -66,6 +71,7 @@ namespace Nz
 			std::size_t ReadBlock(void* buffer, std::size_t size) override;
 			void Reset(SocketHandle handle, const IpAddress& peerAddress);
 			std::size_t WriteBlock(const void* buffer, std::size_t size) override;
+			bool WriteCoalesced(const void* buffer, std::size_t size);
 
 			struct PendingPacket
 			{
@@ -75,12 +81,17 @@ namespace Nz
 				bool headerReceived = false;
 			};
 
+			ByteArray m_writeBuffer;
 			IpAddress m_peerAddress;
 			PendingPacket m_pendingPacket;
+			std::size_t m_writeBufferFlushSize;
+			UInt32 m_writeBufferFlushDelay;
 			UInt64 m_keepAliveInterval;
 			UInt64 m_keepAliveTime;
+			UInt64 m_writeBufferTime;
 			bool m_isLowDelayEnabled;
 			bool m_isKeepAliveEnabled;
+			bool m_isWriteCoalescingEnabled;
 	};
 }
 
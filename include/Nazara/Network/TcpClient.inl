@@ -14,21 +14,28 @@ namespace Nz
 	inline TcpClient::TcpClient() :
 	AbstractSocket(SocketType_TCP),
 	Stream(StreamOption_Sequential),
+	m_writeBufferFlushSize(1400),
+	m_writeBufferFlushDelay(5),
 	m_keepAliveInterval(1000),   //TODO: Query OS default value
 	m_keepAliveTime(7'200'000),  //TODO: Query OS default value
+	m_writeBufferTime(0),
+	m_isLowDelayEnabled(false),  //TODO: Query OS default value
 	m_isKeepAliveEnabled(false), //TODO: Query OS default value
-	m_isLowDelayEnabled(false)   //TODO: Query OS default value
+	m_isWriteCoalescingEnabled(false)
 	{
 	}
 
 	/*!
-	* \brief Disconnects the connection
+	* \brief Disconnects the connection, after sending data waiting in the write buffer
 	*
 	* \see Close
 	*/
 
 	inline void TcpClient::Disconnect()
 	{
+		if (!m_writeBuffer.IsEmpty())
+			FlushWriteBuffer();
+
 		Close();
 	}
 
@@ -81,6 +88,16 @@ namespace Nz
 	{
 		return m_isKeepAliveEnabled;
 	}
+
+	/*!
+	* \brief Checks whether small writes are gathered before being sent
+	* \return true If it is the case
+	*/
+
+	inline bool TcpClient::IsWriteCoalescingEnabled() const
+	{
+		return m_isWriteCoalescingEnabled;
+	}
 }
 
 #include <Nazara/Network/DebugOff.hpp>
@@ -10,6 +10,9 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Network/AbstractSocket.hpp>
 #include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/NetBuffer.hpp>
+#include <memory>
+#include <vector>
 
 namespace Nz
 {
@@ -39,15 +42,21 @@ namespace Nz
 			std::size_t QueryMaxDatagramSize();
 
 			bool Receive(void* buffer, std::size_t size, IpAddress* from, std::size_t* received);
+			bool ReceiveMultiple(NetPacket* packets, IpAddress* from, std::size_t count, std::size_t* received);
 			bool ReceivePacket(NetPacket* packet, IpAddress* from);
 
 			bool Send(const IpAddress& to, const void* buffer, std::size_t size, std::size_t* sent);
+			bool SendMultiple(const IpAddress* to, const NetBuffer* buffers, std::size_t buffersPerDatagram, std::size_t count, std::size_t* sent);
+			bool SendMultiple(const IpAddress* to, const NetPacket* const* packets, std::size_t count, std::size_t* sent);
 			bool SendPacket(const IpAddress& to, const NetPacket& packet);
 
 		private:
 			void OnClose() override;
 			void OnOpened() override;
 
+			std::unique_ptr<UInt8[]> m_receiveBuffer; //< Storage of the datagrams of ReceiveMultiple, never initialized
+			std::vector<NetBuffer> m_buffers;
+			std::vector<std::size_t> m_bufferSizes;
 			IpAddress m_boundAddress;
 			bool m_isBroadCastingEnabled;
 	};
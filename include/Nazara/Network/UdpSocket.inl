@@ -35,6 +35,9 @@ namespace Nz
 
 	inline UdpSocket::UdpSocket(UdpSocket&& udpSocket) :
 	AbstractSocket(std::move(udpSocket)),
+	m_receiveBuffer(std::move(udpSocket.m_receiveBuffer)),
+	m_buffers(std::move(udpSocket.m_buffers)),
+	m_bufferSizes(std::move(udpSocket.m_bufferSizes)),
 	m_boundAddress(std::move(udpSocket.m_boundAddress))
 	{
 	}
@@ -7,6 +7,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Noise/MixerBase.hpp>
+#include <functional>
 
 namespace Nz
 {
@@ -20,10 +21,15 @@ namespace Nz
 			float Get(float x, float y, float scale) const override;
 			float Get(float x, float y, float z, float scale) const override;
 			float Get(float x, float y, float z, float w, float scale) const override;
+			void GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const override;
+			void GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const override;
+			std::size_t GetParametersHash() const override;
 
 			HybridMultiFractal& operator=(const HybridMultiFractal&) = delete;
 
 		private:
+			void ComputeGrid(std::size_t sampleCount, float scale, float* output, const std::function<void(float octaveScale, float* octave)>& sourceGrid) const;
+
 			const NoiseBase& m_source;
 			float m_value;
 			float m_remainder;
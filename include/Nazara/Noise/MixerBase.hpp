@@ -8,6 +8,7 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Noise/NoiseBase.hpp>
 #include <array>
+#include <vector>
 
 namespace Nz
 {
@@ -20,9 +21,12 @@ namespace Nz
 			virtual float Get(float x, float y, float scale) const = 0;
 			virtual float Get(float x, float y, float z, float scale) const = 0;
 			virtual float Get(float x, float y, float z, float w, float scale) const = 0;
+			virtual void GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const;
+			virtual void GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const;
 
 			float GetHurstParameter() const;
 			float GetLacunarity() const;
+			virtual std::size_t GetParametersHash() const;
 			float GetOctaveNumber() const;
 
 			void SetParameters(float hurst, float lacunarity, float octaves);
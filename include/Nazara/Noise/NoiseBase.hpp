@@ -24,6 +24,9 @@ namespace Nz
 			virtual float Get(float x, float y, float scale) const = 0;
 			virtual float Get(float x, float y, float z, float scale) const = 0;
 			virtual float Get(float x, float y, float z, float w, float scale) const = 0;
+			virtual void GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const;
+			virtual void GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const;
+			virtual std::size_t GetParametersHash() const;
 			float GetScale();
 
 			void SetScale(float scale);
@@ -0,0 +1,77 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#ifndef NAZARA_NOISETILEGENERATOR_HPP
+#define NAZARA_NOISETILEGENERATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Vector2.hpp>
+#include <Nazara/Noise/Config.hpp>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class MixerBase;
+	class NoiseBase;
+
+	// Generates 2D noise maps by square tiles, on the TaskScheduler workers, and keeps the most recently used tiles
+	class NAZARA_NOISE_API NoiseTileGenerator
+	{
+		public:
+			NoiseTileGenerator(const NoiseBase& source, unsigned int tileSize = 64, std::size_t cacheSize = 256);
+			NoiseTileGenerator(const MixerBase& source, unsigned int tileSize = 64, std::size_t cacheSize = 256);
+			NoiseTileGenerator(const NoiseTileGenerator&) = delete;
+			~NoiseTileGenerator() = default;
+
+			void ClearCache();
+
+			void Generate(const Vector2i& firstSample, const Vector2ui& sampleCount, float step, float scale, float* output);
+
+			std::size_t GetCachedTileCount() const;
+			std::size_t GetCacheSize() const;
+			unsigned int GetTileSize() const;
+
+			void SetCacheSize(std::size_t cacheSize);
+
+			NoiseTileGenerator& operator=(const NoiseTileGenerator&) = delete;
+
+		private:
+			struct TileKey
+			{
+				Vector2i coords;
+				std::size_t parametersHash;
+				float scale;
+				float step;
+
+				bool operator==(const TileKey& key) const;
+			};
+
+			struct TileKeyHash
+			{
+				std::size_t operator()(const TileKey& key) const;
+			};
+
+			struct Tile
+			{
+				TileKey key;
+				std::vector<float> samples;
+			};
+
+			using GridFunction = std::function<void(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output)>;
+
+			void Trim();
+
+			GridFunction m_gridFunction;
+			std::function<std::size_t()> m_parametersHashFunction;
+			std::list<Tile> m_tiles; //< Most recently used first
+			std::unordered_map<TileKey, std::list<Tile>::iterator, TileKeyHash> m_tilesByKey;
+			std::size_t m_cacheSize;
+			unsigned int m_tileSize;
+	};
+}
+
+#endif // NAZARA_NOISETILEGENERATOR_HPP
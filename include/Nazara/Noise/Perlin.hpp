@@ -22,6 +22,8 @@ namespace Nz
 			float Get(float x, float y, float scale) const override;
 			float Get(float x, float y, float z, float scale) const override;
 			float Get(float x, float y, float z, float w, float scale) const override;
+			void GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const override;
+			void GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const override;
 	};
 }
 
@@ -0,0 +1,55 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#ifndef NAZARA_STATICFBM_HPP
+#define NAZARA_STATICFBM_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Noise/NoiseBase.hpp>
+#include <array>
+#include <type_traits>
+
+namespace Nz
+{
+	// FBM whose source type and octave count are known at compile time: the source is owned and called without virtual dispatch,
+	// and the octave loops have a constant trip count. Being a NoiseBase, it can still be used wherever a generator is expected.
+	template<typename Source, unsigned int Octaves>
+	class StaticFBM : public NoiseBase
+	{
+		static_assert(std::is_base_of<NoiseBase, Source>::value, "Source must be a noise generator");
+		static_assert(Octaves > 0, "There must be at least one octave");
+
+		public:
+			StaticFBM(const Source& source = Source(), float hurst = 1.2f, float lacunarity = 5.f);
+			~StaticFBM() = default;
+
+			float Get(float x, float y, float scale) const override;
+			float Get(float x, float y, float z, float scale) const override;
+			float Get(float x, float y, float z, float w, float scale) const override;
+			void GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const override;
+			void GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const override;
+			float GetHurstParameter() const;
+			float GetLacunarity() const;
+			std::size_t GetParametersHash() const override;
+			Source& GetSource();
+			const Source& GetSource() const;
+
+			void SetParameters(float hurst, float lacunarity);
+
+			static constexpr unsigned int OctaveCount = Octaves;
+
+		private:
+			template<typename F> void ComputeGrid(std::size_t sampleCount, float scale, float* output, F sourceGrid) const;
+
+			std::array<float, Octaves> m_exponents;
+			Source m_source;
+			float m_hurst;
+			float m_invSum;
+			float m_lacunarity;
+	};
+}
+
+#include <Nazara/Noise/StaticFBM.inl>
+
+#endif // NAZARA_STATICFBM_HPP
@@ -0,0 +1,154 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Algorithm.hpp>
+#include <cmath>
+#include <vector>
+#include <Nazara/Noise/Debug.hpp>
+
+namespace Nz
+{
+	template<typename Source, unsigned int Octaves>
+	StaticFBM<Source, Octaves>::StaticFBM(const Source& source, float hurst, float lacunarity) :
+	m_source(source)
+	{
+		SetParameters(hurst, lacunarity);
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticFBM<Source, Octaves>::Get(float x, float y, float scale) const
+	{
+		float value = 0.f;
+		for (unsigned int i = 0; i < Octaves; ++i)
+		{
+			value += m_source.Source::Get(x, y, scale) * m_exponents[i];
+			scale *= m_lacunarity;
+		}
+
+		return value * m_invSum;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticFBM<Source, Octaves>::Get(float x, float y, float z, float scale) const
+	{
+		float value = 0.f;
+		for (unsigned int i = 0; i < Octaves; ++i)
+		{
+			value += m_source.Source::Get(x, y, z, scale) * m_exponents[i];
+			scale *= m_lacunarity;
+		}
+
+		return value * m_invSum;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticFBM<Source, Octaves>::Get(float x, float y, float z, float w, float scale) const
+	{
+		float value = 0.f;
+		for (unsigned int i = 0; i < Octaves; ++i)
+		{
+			value += m_source.Source::Get(x, y, z, w, scale) * m_exponents[i];
+			scale *= m_lacunarity;
+		}
+
+		return value * m_invSum;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticFBM<Source, Octaves>::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.Source::GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticFBM<Source, Octaves>::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y * size.z, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.Source::GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticFBM<Source, Octaves>::GetHurstParameter() const
+	{
+		return m_hurst;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticFBM<Source, Octaves>::GetLacunarity() const
+	{
+		return m_lacunarity;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	std::size_t StaticFBM<Source, Octaves>::GetParametersHash() const
+	{
+		std::size_t hash = m_source.Source::GetParametersHash();
+		HashCombine(hash, Octaves);
+		HashCombine(hash, m_hurst);
+		HashCombine(hash, m_lacunarity);
+
+		return hash;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	Source& StaticFBM<Source, Octaves>::GetSource()
+	{
+		return m_source;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	const Source& StaticFBM<Source, Octaves>::GetSource() const
+	{
+		return m_source;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticFBM<Source, Octaves>::SetParameters(float hurst, float lacunarity)
+	{
+		m_hurst = hurst;
+		m_lacunarity = lacunarity;
+
+		float frequency = 1.f;
+		float sum = 0.f;
+		for (unsigned int i = 0; i < Octaves; ++i)
+		{
+			m_exponents[i] = std::pow(frequency, -m_hurst);
+			frequency *= m_lacunarity;
+			sum += m_exponents[i];
+		}
+
+		m_invSum = 1.f / sum;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	template<typename F>
+	void StaticFBM<Source, Octaves>::ComputeGrid(std::size_t sampleCount, float scale, float* output, F sourceGrid) const
+	{
+		// The first octave is written in place, only the next ones need a buffer
+		sourceGrid(scale, output);
+		for (std::size_t j = 0; j < sampleCount; ++j)
+			output[j] *= m_exponents[0];
+
+		std::vector<float> octave((Octaves > 1) ? sampleCount : 0);
+		for (unsigned int i = 1; i < Octaves; ++i)
+		{
+			scale *= m_lacunarity;
+			sourceGrid(scale, octave.data());
+
+			float exponent = m_exponents[i];
+			for (std::size_t j = 0; j < sampleCount; ++j)
+				output[j] += octave[j] * exponent;
+		}
+
+		for (std::size_t j = 0; j < sampleCount; ++j)
+			output[j] *= m_invSum;
+	}
+}
+
+#include <Nazara/Noise/DebugOff.hpp>
@@ -0,0 +1,183 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <Nazara/Noise/Debug.hpp>
+
+namespace Nz
+{
+	template<typename Source, unsigned int Octaves>
+	StaticHybridMultiFractal<Source, Octaves>::StaticHybridMultiFractal(const Source& source, float hurst, float lacunarity) :
+	m_source(source)
+	{
+		SetParameters(hurst, lacunarity);
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticHybridMultiFractal<Source, Octaves>::Get(float x, float y, float scale) const
+	{
+		float value = (m_source.Source::Get(x, y, scale) + 1.f) * m_exponents[0];
+		float weight = value;
+
+		for (unsigned int i = 1; i < Octaves; ++i)
+		{
+			scale *= m_lacunarity;
+
+			float signal = (m_source.Source::Get(x, y, scale) + 1.f) * m_exponents[i];
+			weight = std::min(weight, 1.f);
+			value += weight * signal;
+			weight *= signal;
+		}
+
+		return value * m_invSum - 1.f;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticHybridMultiFractal<Source, Octaves>::Get(float x, float y, float z, float scale) const
+	{
+		float value = (m_source.Source::Get(x, y, z, scale) + 1.f) * m_exponents[0];
+		float weight = value;
+
+		for (unsigned int i = 1; i < Octaves; ++i)
+		{
+			scale *= m_lacunarity;
+
+			float signal = (m_source.Source::Get(x, y, z, scale) + 1.f) * m_exponents[i];
+			weight = std::min(weight, 1.f);
+			value += weight * signal;
+			weight *= signal;
+		}
+
+		return value * m_invSum - 1.f;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticHybridMultiFractal<Source, Octaves>::Get(float x, float y, float z, float w, float scale) const
+	{
+		float value = (m_source.Source::Get(x, y, z, w, scale) + 1.f) * m_exponents[0];
+		float weight = value;
+
+		for (unsigned int i = 1; i < Octaves; ++i)
+		{
+			scale *= m_lacunarity;
+
+			float signal = (m_source.Source::Get(x, y, z, w, scale) + 1.f) * m_exponents[i];
+			weight = std::min(weight, 1.f);
+			value += weight * signal;
+			weight *= signal;
+		}
+
+		return value * m_invSum - 1.f;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticHybridMultiFractal<Source, Octaves>::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.Source::GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticHybridMultiFractal<Source, Octaves>::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y * size.z, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.Source::GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticHybridMultiFractal<Source, Octaves>::GetHurstParameter() const
+	{
+		return m_hurst;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	float StaticHybridMultiFractal<Source, Octaves>::GetLacunarity() const
+	{
+		return m_lacunarity;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	std::size_t StaticHybridMultiFractal<Source, Octaves>::GetParametersHash() const
+	{
+		std::size_t hash = m_source.Source::GetParametersHash();
+		HashCombine(hash, Octaves);
+		HashCombine(hash, m_hurst);
+		HashCombine(hash, m_lacunarity);
+
+		return hash;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	Source& StaticHybridMultiFractal<Source, Octaves>::GetSource()
+	{
+		return m_source;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	const Source& StaticHybridMultiFractal<Source, Octaves>::GetSource() const
+	{
+		return m_source;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	void StaticHybridMultiFractal<Source, Octaves>::SetParameters(float hurst, float lacunarity)
+	{
+		m_hurst = hurst;
+		m_lacunarity = lacunarity;
+
+		float frequency = 1.f;
+		float sum = 0.f;
+		for (unsigned int i = 0; i < Octaves; ++i)
+		{
+			m_exponents[i] = std::pow(frequency, -m_hurst);
+			frequency *= m_lacunarity;
+			sum += m_exponents[i];
+		}
+
+		m_invSum = 1.f / sum;
+	}
+
+	template<typename Source, unsigned int Octaves>
+	template<typename F>
+	void StaticHybridMultiFractal<Source, Octaves>::ComputeGrid(std::size_t sampleCount, float scale, float* output, F sourceGrid) const
+	{
+		sourceGrid(scale, output);
+
+		std::vector<float> weights(sampleCount);
+		for (std::size_t j = 0; j < sampleCount; ++j)
+		{
+			output[j] = (output[j] + 1.f) * m_exponents[0];
+			weights[j] = output[j];
+		}
+
+		std::vector<float> octave((Octaves > 1) ? sampleCount : 0);
+		for (unsigned int i = 1; i < Octaves; ++i)
+		{
+			scale *= m_lacunarity;
+			sourceGrid(scale, octave.data());
+
+			float exponent = m_exponents[i];
+			for (std::size_t j = 0; j < sampleCount; ++j)
+			{
+				float signal = (octave[j] + 1.f) * exponent;
+				float weight = std::min(weights[j], 1.f);
+
+				output[j] += weight * signal;
+				weights[j] = weight * signal;
+			}
+		}
+
+		for (std::size_t j = 0; j < sampleCount; ++j)
+			output[j] = output[j] * m_invSum - 1.f;
+	}
+}
+
+#include <Nazara/Noise/DebugOff.hpp>
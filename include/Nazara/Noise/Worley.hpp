@@ -25,6 +25,7 @@ namespace Nz
 			float Get(float x, float y, float scale) const override;
 			float Get(float x, float y, float z, float scale) const override;
 			float Get(float x, float y, float z, float w, float scale) const override;
+			std::size_t GetParametersHash() const override;
 
 			void Set(WorleyFunction func);
 
@@ -7,6 +7,15 @@
 #ifndef NAZARA_ENUMS_PHYSICS_HPP
 #define NAZARA_ENUMS_PHYSICS_HPP
 
+enum ContactEventType
+{
+	ContactEventType_Begin,   //< The objects started touching during the step
+	ContactEventType_End,     //< The objects stopped touching during the step
+	ContactEventType_Persist, //< The objects were already touching before the step
+
+	ContactEventType_Max = ContactEventType_Persist
+};
+
 enum GeomType
 {
 	GeomType_Box,
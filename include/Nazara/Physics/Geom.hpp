@@ -8,6 +8,7 @@
 #define NAZARA_GEOM_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
 #include <Nazara/Core/ObjectLibrary.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
@@ -18,9 +19,11 @@
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Physics/Config.hpp>
 #include <Nazara/Physics/Enums.hpp>
+#include <functional>
 #include <unordered_map>
 
 class NewtonCollision;
+class NewtonWorld;
 
 namespace Nz
 {
@@ -28,7 +31,6 @@ namespace Nz
 	///TODO: HeightfieldGeom
 	///TODO: PlaneGeom ?
 	///TODO: SceneGeom
-	///TODO: TreeGeom
 
 	class PhysGeom;
 	class PhysWorld;
@@ -61,18 +63,30 @@ namespace Nz
 
 			static PhysGeomRef Build(const PrimitiveList& list);
 
+			static const String& GetCacheDirectory();
+			static void SetCacheDirectory(const String& directory);
+
 			// Signals:
 			NazaraSignal(OnPhysGeomRelease, const PhysGeom* /*physGeom*/);
 
 		protected:
 			virtual NewtonCollision* CreateHandle(PhysWorld* world) const = 0;
+			NewtonCollision* CreateCachedHandle(PhysWorld* world, const std::function<NewtonCollision*(NewtonWorld* world)>& builder) const;
+
+			PhysGeom* GetSharedGeom() const;
+			void RegisterSharedGeom();
 
 			static bool Initialize();
 			static void Uninitialize();
 
+			// Only set by the geoms built from raw data, which are then cached and shared
+			ByteArray m_contentHash;
+			mutable ByteArray m_serializedHandle;
 			mutable std::unordered_map<PhysWorld*, NewtonCollision*> m_handles;
 
 			static PhysGeomLibrary::LibraryMap s_library;
+			static std::unordered_map<String, PhysGeom*> s_sharedGeoms;
+			static String s_cacheDirectory;
 	};
 
 	class BoxGeom;
@@ -266,6 +280,31 @@ namespace Nz
 			Vector3f m_position;
 			float m_radius;
 	};
+
+	class TreeGeom;
+
+	using TreeGeomConstRef = ObjectRef<const TreeGeom>;
+	using TreeGeomRef = ObjectRef<TreeGeom>;
+
+	class NAZARA_PHYSICS_API TreeGeom : public PhysGeom
+	{
+		public:
+			TreeGeom(const void* vertices, unsigned int vertexCount, const UInt32* indices, unsigned int indexCount, unsigned int stride = sizeof(Vector3f), bool optimize = true);
+
+			void ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const override;
+			float ComputeVolume() const override;
+
+			GeomType GetType() const override;
+
+			template<typename... Args> static TreeGeomRef New(Args&&... args);
+
+		private:
+			NewtonCollision* CreateHandle(PhysWorld* world) const override;
+
+			std::vector<UInt32> m_indices;
+			std::vector<Vector3f> m_vertices;
+			bool m_optimize;
+	};
 }
 
 #include <Nazara/Physics/Geom.inl>
@@ -49,6 +49,11 @@ namespace Nz
 		std::unique_ptr<ConvexHullGeom> object(new ConvexHullGeom(std::forward<Args>(args)...));
 		object->SetPersistent(false);
 
+		// Identical hulls share the same object, and thus the same Newton collisions
+		if (PhysGeom* sharedGeom = object->GetSharedGeom())
+			return static_cast<ConvexHullGeom*>(sharedGeom);
+
+		object->RegisterSharedGeom();
 		return object.release();
 	}
 
@@ -78,6 +83,19 @@ namespace Nz
 
 		return object.release();
 	}
+
+	template<typename... Args>
+	TreeGeomRef TreeGeom::New(Args&&... args)
+	{
+		std::unique_ptr<TreeGeom> object(new TreeGeom(std::forward<Args>(args)...));
+		object->SetPersistent(false);
+
+		if (PhysGeom* sharedGeom = object->GetSharedGeom())
+			return static_cast<TreeGeom*>(sharedGeom);
+
+		object->RegisterSharedGeom();
+		return object.release();
+	}
 }
 
 #include <Nazara/Physics/DebugOff.hpp>
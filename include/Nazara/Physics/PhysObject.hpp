@@ -41,15 +41,21 @@ namespace Nz
 			const PhysGeomRef& GetGeom() const;
 			float GetGravityFactor() const;
 			NewtonBody* GetHandle() const;
+			Vector3f GetInterpolatedPosition(float interpolation) const;
+			Quaternionf GetInterpolatedRotation(float interpolation) const;
 			float GetMass() const;
 			Vector3f GetMassCenter(CoordSys coordSys = CoordSys_Local) const;
+			int GetMaterial() const;
 			const Matrix4f& GetMatrix() const;
 			Vector3f GetPosition() const;
+			UInt32 GetQueryMask() const;
 			Quaternionf GetRotation() const;
+			void* GetUserdata() const;
 			Vector3f GetVelocity() const;
 
 			bool IsAutoSleepEnabled() const;
 			bool IsMoveable() const;
+			bool IsMoving() const;
 			bool IsSleeping() const;
 
 			void SetAngularVelocity(const Vector3f& angularVelocity);
@@ -57,8 +63,11 @@ namespace Nz
 			void SetGravityFactor(float gravityFactor);
 			void SetMass(float mass);
 			void SetMassCenter(const Vector3f& center);
+			void SetMaterial(int material);
 			void SetPosition(const Vector3f& position);
+			void SetQueryMask(UInt32 queryMask);
 			void SetRotation(const Quaternionf& rotation);
+			void SetUserdata(void* userdata);
 			void SetVelocity(const Vector3f& velocity);
 
 			PhysObject& operator=(const PhysObject& object);
@@ -70,11 +79,15 @@ namespace Nz
 			static void TransformCallback(const NewtonBody* body, const float* matrix, int threadIndex);
 
 			Matrix4f m_matrix;
+			Matrix4f m_previousMatrix;
 			PhysGeomRef m_geom;
 			Vector3f m_forceAccumulator;
 			Vector3f m_torqueAccumulator;
 			NewtonBody* m_body;
 			PhysWorld* m_world;
+			UInt64 m_transformStep;
+			void* m_userdata;
+			UInt32 m_queryMask;
 			float m_gravityFactor;
 			float m_mass;
 	};
@@ -9,39 +9,169 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Physics/Config.hpp>
+#include <Nazara/Physics/Enums.hpp>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
+class NewtonBody;
+class NewtonCollision;
+class NewtonJoint;
+class NewtonMaterial;
 class NewtonWorld;
 
 namespace Nz
 {
+	class PhysGeom;
+	class PhysObject;
+	struct PhysOverlapQuery;
+	struct PhysQueryHit;
+	struct PhysRayQuery;
+	struct PhysSweepQuery;
+
+	struct PhysContactEvent
+	{
+		Vector3f normal;       //< Averaged over the contact points, as seen from the first object
+		Vector3f position;     //< Average of the contact points, the last known ones for an end event
+		PhysObject* first;
+		PhysObject* second;
+		ContactEventType type;
+		float normalSpeed;     //< Highest speed along the normal at the contact points
+	};
+
 	class NAZARA_PHYSICS_API PhysWorld
 	{
+		friend PhysObject;
+
 		public:
+			using ContactFilter = std::function<bool(const PhysObject& first, const PhysObject& second)>;
+
 			PhysWorld();
 			PhysWorld(const PhysWorld&) = delete;
 			PhysWorld(PhysWorld&&) = delete; ///TODO
 			~PhysWorld();
 
+			int CreateMaterial();
+
+			void EnableAsyncStep(bool asyncStep);
+			void EnableMaterialContactEvents(int firstMaterial, int secondMaterial, bool contactEvents);
+
+			const PhysContactEvent& GetContactEvent(std::size_t index) const;
+			std::size_t GetContactEventCount() const;
+			int GetDefaultMaterial() const;
 			Vector3f GetGravity() const;
 			NewtonWorld* GetHandle() const;
+			float GetInterpolationFactor() const;
+			unsigned int GetMaxStepCount() const;
+			unsigned int GetMaxThreadCount() const;
+			PhysObject* GetMovedObject(std::size_t index) const;
+			std::size_t GetMovedObjectCount() const;
+			UInt64 GetStepCount() const;
 			float GetStepSize() const;
+			unsigned int GetThreadCount() const;
+
+			bool IsAsyncStepEnabled() const;
+
+			void Overlap(const PhysOverlapQuery* queries, std::size_t queryCount, PhysObject** objects, std::size_t maxObjectsPerQuery, std::size_t* objectCounts, UInt32 queryMask = 0xFFFFFFFF);
+
+			void RayCast(const PhysRayQuery* queries, std::size_t queryCount, PhysQueryHit* hits, UInt32 queryMask = 0xFFFFFFFF);
 
 			void SetGravity(const Vector3f& gravity);
+			void SetMaterialCollidable(int firstMaterial, int secondMaterial, bool collidable);
+			void SetMaterialElasticity(int firstMaterial, int secondMaterial, float elasticity);
+			void SetMaterialFilter(int firstMaterial, int secondMaterial, ContactFilter filter);
+			void SetMaterialFriction(int firstMaterial, int secondMaterial, float staticFriction, float kineticFriction);
+			void SetMaxStepCount(unsigned int maxStepCount);
 			void SetSolverModel(unsigned int model);
 			void SetStepSize(float stepSize);
+			void SetThreadCount(unsigned int threadCount);
 
 			void Step(float timestep);
 
+			void Sweep(const PhysSweepQuery* queries, std::size_t queryCount, PhysQueryHit* hits, UInt32 queryMask = 0xFFFFFFFF);
+
+			void WaitForStep() const;
+
 			PhysWorld& operator=(const PhysWorld&) = delete;
 			PhysWorld& operator=(PhysWorld&&) = delete; ///TODO
 
 		private:
+			struct ContactRecord;
+			struct MaterialPair;
+
+			MaterialPair& GetMaterialPair(int firstMaterial, int secondMaterial);
+			void ProcessContacts();
+			void RegisterMovedObject(PhysObject* object);
+			template<typename F> void RunQueries(std::size_t queryCount, F function);
+			void UnregisterBody(const NewtonBody* body);
+
+			static void OnMaterialContacts(const NewtonJoint* contactJoint, float timestep, int threadIndex);
+			static int OnMaterialOverlap(const NewtonMaterial* material, const NewtonBody* firstBody, const NewtonBody* secondBody, int threadIndex);
+
+			struct ContactRecord
+			{
+				Vector3f normal;   //< As seen from the first body
+				Vector3f position;
+				const NewtonBody* first;  //< Lowest address of the pair
+				const NewtonBody* second;
+				float normalSpeed;
+			};
+
+			struct MaterialPair
+			{
+				ContactFilter filter;     //< Called by the solver threads
+				PhysWorld* world = nullptr;
+				bool contactEvents = false;
+			};
+
+			std::atomic<std::size_t> m_movedObjectCount;
+			std::unordered_map<UInt64, MaterialPair> m_materialPairs;
+			std::vector<std::vector<ContactRecord>> m_threadContacts; //< Filled by the solver threads, one buffer each
+			std::vector<ContactRecord> m_activeContacts;              //< Pairs touching after the last processed step, sorted
+			std::vector<ContactRecord> m_stepContacts;
+			std::vector<PhysContactEvent> m_contactEvents;
+			std::vector<NewtonCollision*> m_queryCollisions;
+			std::vector<PhysObject*> m_movedObjects;
 			Vector3f m_gravity;
 			NewtonWorld* m_world;
+			UInt64 m_firstStepOfCall;
+			UInt64 m_stepCount;
 			float m_stepSize;
 			float m_timestepAccumulator;
+			unsigned int m_maxStepCount;
+			bool m_hasPendingContacts;
+			bool m_isAsyncStepEnabled;
+	};
+
+	struct PhysOverlapQuery
+	{
+		Matrix4f transform;
+		const PhysGeom* geom;
+	};
+
+	struct PhysQueryHit
+	{
+		Vector3f normal;
+		Vector3f position;
+		PhysObject* object; //< nullptr if nothing was hit
+		float fraction;     //< Part of the ray or sweep travelled before the hit
+	};
+
+	struct PhysRayQuery
+	{
+		Vector3f from;
+		Vector3f to;
+	};
+
+	struct PhysSweepQuery
+	{
+		Matrix4f from;
+		Vector3f to;
+		const PhysGeom* geom; //< Must be convex
 	};
 }
 
@@ -34,7 +34,9 @@
 #include <Nazara/Renderer/ContextParameters.hpp>
 #include <Nazara/Renderer/DebugDrawer.hpp>
 #include <Nazara/Renderer/Enums.hpp>
+#include <Nazara/Renderer/GpuMemory.hpp>
 #include <Nazara/Renderer/GpuQuery.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/RenderBuffer.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
@@ -45,11 +47,15 @@
 #include <Nazara/Renderer/RenderWindow.hpp>
 #include <Nazara/Renderer/Shader.hpp>
 #include <Nazara/Renderer/ShaderStage.hpp>
+#include <Nazara/Renderer/StreamBuffer.hpp>
 #include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Renderer/TextureSampler.hpp>
+#include <Nazara/Renderer/TextureStreamer.hpp>
+#include <Nazara/Renderer/TextureUploadQueue.hpp>
 #include <Nazara/Renderer/UberShader.hpp>
 #include <Nazara/Renderer/UberShaderInstance.hpp>
 #include <Nazara/Renderer/UberShaderInstancePreprocessor.hpp>
 #include <Nazara/Renderer/UberShaderPreprocessor.hpp>
+#include <Nazara/Renderer/UploadWorker.hpp>
 
 #endif // NAZARA_GLOBAL_RENDERER_HPP
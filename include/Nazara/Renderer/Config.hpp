@@ -29,6 +29,9 @@
 
 /// Chaque modification d'un paramètre du module nécessite une recompilation de celui-ci
 
+// Le nombre de régions des buffers dynamiques mappés de façon persistante (ARB_buffer_storage), chaque réécriture complète passe à la région suivante
+#define NAZARA_RENDERER_BUFFER_REGION_COUNT 3
+
 // La taille du buffer d'Instancing (définit le nombre maximum d'instances en un rendu)
 #define NAZARA_RENDERER_INSTANCE_BUFFER_SIZE 524288 // 8192 matrices 4x4 flottantes
 
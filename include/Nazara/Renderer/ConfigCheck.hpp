@@ -18,6 +18,7 @@
 	#define NAZARA_RENDERER_MANAGE_MEMORY 0
 #endif
 
+NazaraCheckTypeAndVal(NAZARA_RENDERER_BUFFER_REGION_COUNT, integral, >, 0, " shall be a strictly positive integer");
 NazaraCheckTypeAndVal(NAZARA_RENDERER_INSTANCE_BUFFER_SIZE, integral, >, 0, " shall be a strictly positive integer");
 
 #undef NazaraCheckTypeAndVal
@@ -20,9 +20,13 @@ namespace Nz
 {
 	class Skeleton;
 
+	// Accumulates debug primitives from any thread, drawn by Flush() in a few draw calls
+	// Drawing state (colors, depth test, persistence) belongs to the calling thread
 	class NAZARA_RENDERER_API DebugDrawer
 	{
 		public:
+			static void Clear();
+
 			static void Draw(const BoundingVolumef& volume);
 			static void Draw(const Boxf& box);
 			static void Draw(const Boxi& box);
@@ -41,7 +45,10 @@ namespace Nz
 
 			static void EnableDepthBuffer(bool depthBuffer);
 
+			static void Flush();
+
 			static float GetLineWidth();
+			static unsigned int GetPersistence();
 			static float GetPointSize();
 			static Color GetPrimaryColor();
 			static Color GetSecondaryColor();
@@ -50,6 +57,7 @@ namespace Nz
 			static bool IsDepthBufferEnabled();
 
 			static void SetLineWidth(float width);
+			static void SetPersistence(unsigned int frameCount);
 			static void SetPointSize(float size);
 			static void SetPrimaryColor(const Color& color);
 			static void SetSecondaryColor(const Color& color);
@@ -19,6 +19,17 @@ namespace Nz
 		AttachmentPoint_Max = AttachmentPoint_Stencil
 	};
 
+	enum GpuMemoryCategory
+	{
+		GpuMemoryCategory_IndexBuffer,
+		GpuMemoryCategory_RenderBuffer,
+		GpuMemoryCategory_Texture,
+		GpuMemoryCategory_UniformBuffer,
+		GpuMemoryCategory_VertexBuffer,
+
+		GpuMemoryCategory_Max = GpuMemoryCategory_VertexBuffer
+	};
+
 	enum GpuQueryCondition
 	{
 		GpuQueryCondition_Region_NoWait,
@@ -75,10 +86,12 @@ namespace Nz
 	enum RendererCap
 	{
 		RendererCap_AnisotropicFilter,
+		RendererCap_BindlessTexture,
 		RendererCap_FP64,
 		RendererCap_Instancing,
+		RendererCap_MultiDrawIndirect,
 
-		RendererCap_Max = RendererCap_Instancing
+		RendererCap_Max = RendererCap_MultiDrawIndirect
 	};
 
 	enum RendererBufferFlags
@@ -118,6 +131,14 @@ namespace Nz
 
 		ShaderStageType_Max = ShaderStageType_Vertex
 	};
+
+	enum UniformBufferBinding
+	{
+		UniformBufferBinding_Material,
+		UniformBufferBinding_View,
+
+		UniformBufferBinding_Max = UniformBufferBinding_View
+	};
 }
 
 #endif // NAZARA_ENUMS_RENDERER_HPP
@@ -0,0 +1,64 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GPUMEMORY_HPP
+#define NAZARA_GPUMEMORY_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/Enums.hpp>
+#include <vector>
+
+namespace Nz
+{
+	// Accounts the video memory taken by textures, hardware buffers and render buffers, as computed from their format and size
+	// Drivers may pad or compress the storage, the memory they report (when they do) is available through QueryDriverMemory
+	class NAZARA_RENDERER_API GpuMemory
+	{
+		friend class Renderer;
+
+		public:
+			struct DriverMemory;
+			struct Usage;
+
+			GpuMemory() = delete;
+			~GpuMemory() = delete;
+
+			static void Allocate(const void* resource, GpuMemoryCategory category, UInt64 size);
+			static void Free(const void* resource);
+
+			static UInt64 GetAllocatedSize();
+			static UInt64 GetAllocatedSize(GpuMemoryCategory category);
+			static std::size_t GetResourceCount(GpuMemoryCategory category);
+			static std::vector<Usage> GetUsageByName();
+
+			static bool QueryDriverMemory(DriverMemory* memory);
+
+			static void SetDebugName(const void* resource, const String& name);
+
+			struct DriverMemory
+			{
+				UInt64 availableSize; //< Bytes of video memory still available
+				UInt64 evictedSize;   //< Bytes evicted to system memory since the context creation (zero if unknown)
+				UInt64 totalSize;     //< Bytes of dedicated video memory (zero if unknown)
+				unsigned int evictionCount; //< Zero if unknown
+			};
+
+			struct Usage
+			{
+				GpuMemoryCategory category;
+				String name; //< Empty for the resources without a debug name
+				UInt64 size;
+				std::size_t resourceCount;
+			};
+
+		private:
+			static void Uninitialize();
+	};
+}
+
+#endif // NAZARA_GPUMEMORY_HPP
@@ -0,0 +1,71 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_GPUTIMER_HPP
+#define NAZARA_GPUTIMER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <vector>
+
+#define NazaraGpuZoneVariable(line) NazaraGpuZone ## line
+#define NazaraGpuZoneName(line) NazaraGpuZoneVariable(line)
+#define NazaraGpuZone(name) Nz::GpuTimer::Scope NazaraGpuZoneName(__LINE__)(name)
+
+namespace Nz
+{
+	// Measures GPU time of nested scopes with timestamp queries, read a few frames later so the CPU never waits
+	class NAZARA_RENDERER_API GpuTimer
+	{
+		friend class Renderer;
+
+		public:
+			class Scope;
+			struct Timing;
+
+			GpuTimer() = delete;
+			~GpuTimer() = delete;
+
+			static void Begin(const char* name);
+
+			static void Enable(bool enable = true);
+			static void End();
+
+			static UInt64 GetFrameDuration();
+			static unsigned int GetLatency();
+			static UInt64 GetTiming(const char* name);
+			static const std::vector<Timing>& GetTimings();
+
+			static bool IsEnabled();
+
+			struct Timing
+			{
+				const char* name;
+				UInt64 duration; //< In nanoseconds
+				unsigned int depth; //< Number of enclosing scopes
+			};
+
+		private:
+			static void NextFrame();
+			static void Uninitialize();
+	};
+
+	class NAZARA_RENDERER_API GpuTimer::Scope
+	{
+		public:
+			inline Scope(const char* name);
+			Scope(const Scope&) = delete;
+			Scope(Scope&&) = delete;
+			inline ~Scope();
+
+			Scope& operator=(const Scope&) = delete;
+			Scope& operator=(Scope&&) = delete;
+	};
+}
+
+#include <Nazara/Renderer/GpuTimer.inl>
+
+#endif // NAZARA_GPUTIMER_HPP
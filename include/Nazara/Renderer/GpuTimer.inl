@@ -0,0 +1,20 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	inline GpuTimer::Scope::Scope(const char* name)
+	{
+		GpuTimer::Begin(name);
+	}
+
+	inline GpuTimer::Scope::~Scope()
+	{
+		GpuTimer::End();
+	}
+}
+
+#include <Nazara/Renderer/DebugOff.hpp>
@@ -29,14 +29,27 @@ namespace GLX
 	#include <GL3/glxext.h>
 #endif
 
+// KHR_parallel_shader_compile est plus récent que nos headers
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC) (GLuint count);
+
 namespace Nz
 {
 	enum OpenGLExtension
 	{
 		OpenGLExtension_AnisotropicFilter,
+		OpenGLExtension_BindlessTexture,
+		OpenGLExtension_BufferStorage,
 		OpenGLExtension_DebugOutput,
 		OpenGLExtension_FP64,
 		OpenGLExtension_GetProgramBinary,
+		OpenGLExtension_GpuMemoryInfo_ATI,
+		OpenGLExtension_GpuMemoryInfo_NVX,
+		OpenGLExtension_MultiDrawIndirect,
+		OpenGLExtension_ParallelShaderCompile,
 		OpenGLExtension_SeparateShaderObjects,
 		OpenGLExtension_Shader_ImageLoadStore,
 		OpenGLExtension_TextureCompression_s3tc,
@@ -82,6 +95,8 @@ namespace Nz
 			static void BindTexture(ImageType type, GLuint id);
 			static void BindTexture(unsigned int textureUnit, ImageType type, GLuint id);
 			static void BindTextureUnit(unsigned int textureUnit);
+			static void BindUniformBuffer(unsigned int bindingPoint, GLuint id, unsigned int offset = 0, unsigned int size = 0);
+			static void BindVertexArray(GLuint id);
 			static void BindViewport(const Recti& viewport);
 
 			static void DeleteBuffer(BufferType type, GLuint id);
@@ -160,6 +175,8 @@ NAZARA_RENDERER_API extern PFNGLBEGINCONDITIONALRENDERPROC   glBeginConditionalR
 NAZARA_RENDERER_API extern PFNGLBEGINQUERYPROC               glBeginQuery;
 NAZARA_RENDERER_API extern PFNGLBINDATTRIBLOCATIONPROC       glBindAttribLocation;
 NAZARA_RENDERER_API extern PFNGLBINDBUFFERPROC               glBindBuffer;
+NAZARA_RENDERER_API extern PFNGLBINDBUFFERBASEPROC           glBindBufferBase;
+NAZARA_RENDERER_API extern PFNGLBINDBUFFERRANGEPROC          glBindBufferRange;
 NAZARA_RENDERER_API extern PFNGLBINDFRAMEBUFFERPROC          glBindFramebuffer;
 NAZARA_RENDERER_API extern PFNGLBINDFRAGDATALOCATIONPROC     glBindFragDataLocation;
 NAZARA_RENDERER_API extern PFNGLBINDRENDERBUFFERPROC         glBindRenderbuffer;
@@ -170,11 +187,13 @@ NAZARA_RENDERER_API extern PFNGLBLENDFUNCPROC                glBlendFunc;
 NAZARA_RENDERER_API extern PFNGLBLENDFUNCSEPARATEPROC        glBlendFuncSeparate;
 NAZARA_RENDERER_API extern PFNGLBLITFRAMEBUFFERPROC          glBlitFramebuffer;
 NAZARA_RENDERER_API extern PFNGLBUFFERDATAPROC               glBufferData;
+NAZARA_RENDERER_API extern PFNGLBUFFERSTORAGEPROC            glBufferStorage;
 NAZARA_RENDERER_API extern PFNGLBUFFERSUBDATAPROC            glBufferSubData;
 NAZARA_RENDERER_API extern PFNGLCLEARPROC                    glClear;
 NAZARA_RENDERER_API extern PFNGLCLEARCOLORPROC               glClearColor;
 NAZARA_RENDERER_API extern PFNGLCLEARDEPTHPROC               glClearDepth;
 NAZARA_RENDERER_API extern PFNGLCLEARSTENCILPROC             glClearStencil;
+NAZARA_RENDERER_API extern PFNGLCLIENTWAITSYNCPROC           glClientWaitSync;
 NAZARA_RENDERER_API extern PFNGLCREATEPROGRAMPROC            glCreateProgram;
 NAZARA_RENDERER_API extern PFNGLCREATESHADERPROC             glCreateShader;
 NAZARA_RENDERER_API extern PFNGLCHECKFRAMEBUFFERSTATUSPROC   glCheckFramebufferStatus;
@@ -195,6 +214,7 @@ NAZARA_RENDERER_API extern PFNGLDELETEQUERIESPROC            glDeleteQueries;
 NAZARA_RENDERER_API extern PFNGLDELETERENDERBUFFERSPROC      glDeleteRenderbuffers;
 NAZARA_RENDERER_API extern PFNGLDELETESAMPLERSPROC           glDeleteSamplers;
 NAZARA_RENDERER_API extern PFNGLDELETESHADERPROC             glDeleteShader;
+NAZARA_RENDERER_API extern PFNGLDELETESYNCPROC               glDeleteSync;
 NAZARA_RENDERER_API extern PFNGLDELETETEXTURESPROC           glDeleteTextures;
 NAZARA_RENDERER_API extern PFNGLDELETEVERTEXARRAYSPROC       glDeleteVertexArrays;
 NAZARA_RENDERER_API extern PFNGLDEPTHFUNCPROC                glDepthFunc;
@@ -206,12 +226,15 @@ NAZARA_RENDERER_API extern PFNGLDRAWARRAYSINSTANCEDPROC      glDrawArraysInstanc
 NAZARA_RENDERER_API extern PFNGLDRAWBUFFERPROC               glDrawBuffer;
 NAZARA_RENDERER_API extern PFNGLDRAWBUFFERSPROC              glDrawBuffers;
 NAZARA_RENDERER_API extern PFNGLDRAWELEMENTSPROC             glDrawElements;
+NAZARA_RENDERER_API extern PFNGLDRAWELEMENTSBASEVERTEXPROC   glDrawElementsBaseVertex;
 NAZARA_RENDERER_API extern PFNGLDRAWELEMENTSINSTANCEDPROC    glDrawElementsInstanced;
+NAZARA_RENDERER_API extern PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC glDrawElementsInstancedBaseVertex;
 NAZARA_RENDERER_API extern PFNGLDRAWTEXTURENVPROC            glDrawTexture;
 NAZARA_RENDERER_API extern PFNGLENABLEPROC                   glEnable;
 NAZARA_RENDERER_API extern PFNGLENABLEVERTEXATTRIBARRAYPROC  glEnableVertexAttribArray;
 NAZARA_RENDERER_API extern PFNGLENDCONDITIONALRENDERPROC     glEndConditionalRender;
 NAZARA_RENDERER_API extern PFNGLENDQUERYPROC                 glEndQuery;
+NAZARA_RENDERER_API extern PFNGLFENCESYNCPROC                glFenceSync;
 NAZARA_RENDERER_API extern PFNGLFLUSHPROC                    glFlush;
 NAZARA_RENDERER_API extern PFNGLFRAMEBUFFERRENDERBUFFERPROC  glFramebufferRenderbuffer;
 NAZARA_RENDERER_API extern PFNGLFRAMEBUFFERTEXTUREPROC       glFramebufferTexture;
@@ -230,6 +253,7 @@ NAZARA_RENDERER_API extern PFNGLGENVERTEXARRAYSPROC          glGenVertexArrays;
 NAZARA_RENDERER_API extern PFNGLGETACTIVEUNIFORMPROC         glGetActiveUniform;
 NAZARA_RENDERER_API extern PFNGLGETBOOLEANVPROC              glGetBooleanv;
 NAZARA_RENDERER_API extern PFNGLGETBUFFERPARAMETERIVPROC     glGetBufferParameteriv;
+NAZARA_RENDERER_API extern PFNGLGETBUFFERSUBDATAPROC          glGetBufferSubData;
 NAZARA_RENDERER_API extern PFNGLGETDEBUGMESSAGELOGPROC       glGetDebugMessageLog;
 NAZARA_RENDERER_API extern PFNGLGETERRORPROC                 glGetError;
 NAZARA_RENDERER_API extern PFNGLGETFLOATVPROC                glGetFloatv;
@@ -239,6 +263,7 @@ NAZARA_RENDERER_API extern PFNGLGETPROGRAMIVPROC             glGetProgramiv;
 NAZARA_RENDERER_API extern PFNGLGETPROGRAMINFOLOGPROC        glGetProgramInfoLog;
 NAZARA_RENDERER_API extern PFNGLGETQUERYIVPROC               glGetQueryiv;
 NAZARA_RENDERER_API extern PFNGLGETQUERYOBJECTIVPROC         glGetQueryObjectiv;
+NAZARA_RENDERER_API extern PFNGLGETQUERYOBJECTUI64VPROC      glGetQueryObjectui64v;
 NAZARA_RENDERER_API extern PFNGLGETQUERYOBJECTUIVPROC        glGetQueryObjectuiv;
 NAZARA_RENDERER_API extern PFNGLGETSHADERINFOLOGPROC         glGetShaderInfoLog;
 NAZARA_RENDERER_API extern PFNGLGETSHADERIVPROC              glGetShaderiv;
@@ -250,13 +275,19 @@ NAZARA_RENDERER_API extern PFNGLGETTEXLEVELPARAMETERFVPROC   glGetTexLevelParame
 NAZARA_RENDERER_API extern PFNGLGETTEXLEVELPARAMETERIVPROC   glGetTexLevelParameteriv;
 NAZARA_RENDERER_API extern PFNGLGETTEXPARAMETERFVPROC        glGetTexParameterfv;
 NAZARA_RENDERER_API extern PFNGLGETTEXPARAMETERIVPROC        glGetTexParameteriv;
+NAZARA_RENDERER_API extern PFNGLGETTEXTURESAMPLERHANDLEARBPROC glGetTextureSamplerHandleARB;
+NAZARA_RENDERER_API extern PFNGLGETUNIFORMBLOCKINDEXPROC     glGetUniformBlockIndex;
 NAZARA_RENDERER_API extern PFNGLGETUNIFORMLOCATIONPROC       glGetUniformLocation;
 NAZARA_RENDERER_API extern PFNGLINVALIDATEBUFFERDATAPROC     glInvalidateBufferData;
 NAZARA_RENDERER_API extern PFNGLISENABLEDPROC                glIsEnabled;
 NAZARA_RENDERER_API extern PFNGLLINEWIDTHPROC                glLineWidth;
 NAZARA_RENDERER_API extern PFNGLLINKPROGRAMPROC              glLinkProgram;
+NAZARA_RENDERER_API extern PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC glMakeTextureHandleNonResidentARB;
+NAZARA_RENDERER_API extern PFNGLMAKETEXTUREHANDLERESIDENTARBPROC glMakeTextureHandleResidentARB;
 NAZARA_RENDERER_API extern PFNGLMAPBUFFERPROC                glMapBuffer;
 NAZARA_RENDERER_API extern PFNGLMAPBUFFERRANGEPROC           glMapBufferRange;
+NAZARA_RENDERER_API extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreads;
+NAZARA_RENDERER_API extern PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect;
 NAZARA_RENDERER_API extern PFNGLPIXELSTOREIPROC              glPixelStorei;
 NAZARA_RENDERER_API extern PFNGLPOINTSIZEPROC                glPointSize;
 NAZARA_RENDERER_API extern PFNGLPOLYGONMODEPROC              glPolygonMode;
@@ -279,6 +310,7 @@ NAZARA_RENDERER_API extern PFNGLPROGRAMUNIFORM4FVPROC        glProgramUniform4fv
 NAZARA_RENDERER_API extern PFNGLPROGRAMUNIFORM4IVPROC        glProgramUniform4iv;
 NAZARA_RENDERER_API extern PFNGLPROGRAMUNIFORMMATRIX4DVPROC  glProgramUniformMatrix4dv;
 NAZARA_RENDERER_API extern PFNGLPROGRAMUNIFORMMATRIX4FVPROC  glProgramUniformMatrix4fv;
+NAZARA_RENDERER_API extern PFNGLQUERYCOUNTERPROC              glQueryCounter;
 NAZARA_RENDERER_API extern PFNGLREADPIXELSPROC               glReadPixels;
 NAZARA_RENDERER_API extern PFNGLRENDERBUFFERSTORAGEPROC      glRenderbufferStorage;
 NAZARA_RENDERER_API extern PFNGLSAMPLERPARAMETERFPROC        glSamplerParameterf;
@@ -315,6 +347,7 @@ NAZARA_RENDERER_API extern PFNGLUNIFORM3IVPROC               glUniform3iv;
 NAZARA_RENDERER_API extern PFNGLUNIFORM4DVPROC               glUniform4dv;
 NAZARA_RENDERER_API extern PFNGLUNIFORM4FVPROC               glUniform4fv;
 NAZARA_RENDERER_API extern PFNGLUNIFORM4IVPROC               glUniform4iv;
+NAZARA_RENDERER_API extern PFNGLUNIFORMBLOCKBINDINGPROC      glUniformBlockBinding;
 NAZARA_RENDERER_API extern PFNGLUNIFORMMATRIX4DVPROC         glUniformMatrix4dv;
 NAZARA_RENDERER_API extern PFNGLUNIFORMMATRIX4FVPROC         glUniformMatrix4fv;
 NAZARA_RENDERER_API extern PFNGLUNMAPBUFFERPROC              glUnmapBuffer;
@@ -35,6 +35,7 @@ namespace Nz
 
 			bool AttachBuffer(AttachmentPoint attachmentPoint, UInt8 index, RenderBuffer* buffer);
 			bool AttachBuffer(AttachmentPoint attachmentPoint, UInt8 index, PixelFormatType format, unsigned int width, unsigned int height);
+			bool AttachLayeredTexture(AttachmentPoint attachmentPoint, UInt8 index, Texture* texture);
 			bool AttachTexture(AttachmentPoint attachmentPoint, UInt8 index, Texture* texture, unsigned int z = 0);
 
 			bool Create(bool lock = false);
@@ -20,9 +20,12 @@
 
 namespace Nz
 {
+	class Buffer;
 	class Color;
 	class Context;
+	class HardwareBuffer;
 	class IndexBuffer;
+	class OpenGL;
 	class RenderTarget;
 	class Shader;
 	class Texture;
@@ -30,9 +33,15 @@ namespace Nz
 
 	class NAZARA_RENDERER_API Renderer
 	{
+		friend HardwareBuffer;
+		friend OpenGL;
+		friend Shader;
 		friend Texture;
 
 		public:
+			struct DrawIndexedIndirectCommand;
+			struct FrameStats;
+
 			using DrawCall = void (*)(PrimitiveMode, unsigned int, unsigned int);
 			using DrawCallInstanced = void (*)(unsigned int, PrimitiveMode, unsigned int, unsigned int);
 
@@ -45,6 +54,8 @@ namespace Nz
 
 			static void DrawFullscreenQuad();
 			static void DrawIndexedPrimitives(PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount);
+			static void DrawIndexedPrimitives(PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount, unsigned int baseVertex);
+			static void DrawIndexedPrimitivesIndirect(PrimitiveMode mode, const DrawIndexedIndirectCommand* commands, unsigned int commandCount);
 			static void DrawIndexedPrimitivesInstanced(unsigned int instanceCount, PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount);
 			static void DrawPrimitives(PrimitiveMode mode, unsigned int firstVertex, unsigned int vertexCount);
 			static void DrawPrimitivesInstanced(unsigned int instanceCount, PrimitiveMode mode, unsigned int firstVertex, unsigned int vertexCount);
@@ -52,10 +63,12 @@ namespace Nz
 			static void Enable(RendererParameter parameter, bool enable);
 
 			static void EndCondition();
+			static void EndFrame();
 
 			static void Flush();
 
 			static RendererComparison GetDepthFunc();
+			static const FrameStats& GetFrameStats();
 			static VertexBuffer* GetInstanceBuffer();
 			static float GetLineWidth();
 			static Matrix4f GetMatrix(MatrixType type);
@@ -89,6 +102,7 @@ namespace Nz
 			static void SetFaceCulling(FaceSide faceSide);
 			static void SetFaceFilling(FaceFilling fillingMode);
 			static void SetIndexBuffer(const IndexBuffer* indexBuffer);
+			static void SetInstanceBuffer(const VertexBuffer* instanceBuffer, unsigned int firstInstance = 0);
 			static void SetLineWidth(float size);
 			static void SetMatrix(MatrixType type, const Matrix4f& matrix);
 			static void SetPointSize(float size);
@@ -104,21 +118,46 @@ namespace Nz
 			static bool SetTarget(const RenderTarget* target);
 			static void SetTexture(UInt8 unit, const Texture* texture);
 			static void SetTextureSampler(UInt8 textureUnit, const TextureSampler& sampler);
+			static void SetUniformBuffer(unsigned int bindingPoint, const Buffer* buffer);
 			static void SetVertexBuffer(const VertexBuffer* vertexBuffer);
 			static void SetViewport(const Recti& viewport);
 
 			static void Uninitialize();
 
+			struct DrawIndexedIndirectCommand // Same layout as OpenGL DrawElementsIndirectCommand
+			{
+				UInt32 indexCount;
+				UInt32 instanceCount;
+				UInt32 firstIndex; //< Relative to the start of the current index buffer
+				Int32 baseVertex;
+				UInt32 firstInstance; //< Relative to the first instance of the current instance buffer
+			};
+
+			struct FrameStats
+			{
+				UInt64 bufferUploadSize = 0; //< In bytes, through HardwareBuffer::Fill and write mappings
+				UInt64 primitiveCount = 0;
+				unsigned int drawCallCount = 0;
+				unsigned int instanceCount = 0;
+				unsigned int redundantCallCount = 0; //< Bindings and uniforms skipped because they were already set
+				unsigned int shaderChangeCount = 0;
+				unsigned int stateUpdateCount = 0; //< Draw calls which had to update the shader, matrices, textures or vertex arrays
+				unsigned int textureChangeCount = 0;
+			};
+
 		private:
+			static void CountBufferUpload(unsigned int size);
+			static void CountRedundantCall();
 			static void EnableInstancing(bool instancing);
 			static bool EnsureStateUpdate();
+			static void OnBufferRegionChange(const Buffer* buffer);
 			static void OnContextRelease(const Context* context);
-			static void OnIndexBufferRelease(const IndexBuffer* indexBuffer);
 			static void OnShaderReleased(const Shader* shader);
 			static void OnTextureReleased(const Texture* texture);
 			static void OnVertexBufferRelease(const VertexBuffer* vertexBuffer);
-			static void OnVertexDeclarationRelease(const VertexDeclaration* vertexDeclaration);
+			static bool SpecifyVertexAttribs(const VertexBuffer* vertexBuffer, bool instanceData, unsigned int firstInstance);
 			static void UpdateMatrix(MatrixType type);
+			static void UpdateViewUniformBuffer(const Vector2ui& targetSize);
 
 			static unsigned int s_moduleReferenceCounter;
 	};
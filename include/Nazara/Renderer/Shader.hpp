@@ -21,6 +21,7 @@
 #include <Nazara/Math/Vector4.hpp>
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Enums.hpp>
+#include <unordered_map>
 
 namespace Nz
 {
@@ -47,14 +48,18 @@ namespace Nz
 			bool AttachStageFromSource(ShaderStageType stage, const char* source, unsigned int length);
 			bool AttachStageFromSource(ShaderStageType stage, const String& source);
 
+			void BeginLinking();
 			void Bind() const;
 
 			bool Create();
 			void Destroy();
 
+			bool EndLinking();
+
 			ByteArray GetBinary() const;
 			String GetLog() const;
 			String GetSourceCode(ShaderStageType stage) const;
+			int GetUniformBlockIndex(const String& name) const;
 			int GetUniformLocation(const String& name) const;
 			int GetUniformLocation(ShaderUniform shaderUniform) const;
 
@@ -62,6 +67,8 @@ namespace Nz
 
 			bool IsBinaryRetrievable() const;
 			bool IsLinked() const;
+			bool IsLinking() const;
+			bool IsLinkingCompleted() const;
 			bool IsValid() const;
 
 			bool Link();
@@ -79,6 +86,7 @@ namespace Nz
 			void SendIntegerArray(int location, const int* values, unsigned int count) const;
 			void SendMatrix(int location, const Matrix4d& matrix) const;
 			void SendMatrix(int location, const Matrix4f& matrix) const;
+			void SendMatrixArray(int location, const Matrix4f* matrices, unsigned int count) const;
 			void SendVector(int location, const Vector2d& vector) const;
 			void SendVector(int location, const Vector2f& vector) const;
 			void SendVector(int location, const Vector2i& vector) const;
@@ -98,6 +106,8 @@ namespace Nz
 			void SendVectorArray(int location, const Vector4f* vectors, unsigned int count) const;
 			void SendVectorArray(int location, const Vector4i* vectors, unsigned int count) const;
 
+			void SetUniformBlockBinding(int blockIndex, unsigned int bindingPoint) const;
+
 			bool Validate() const;
 
 			// Fonctions OpenGL
@@ -115,13 +125,23 @@ namespace Nz
 			NazaraSignal(OnShaderUniformInvalidated, const Shader* /*shader*/);
 
 		private:
+			struct UniformValue
+			{
+				UInt8 data[sizeof(Matrix4f)];
+				std::size_t size = 0;
+			};
+
 			bool PostLinkage();
+			template<typename T> bool UpdateUniformCache(int location, const T& value) const;
 
 			static bool Initialize();
 			static void Uninitialize();
 
+			mutable std::unordered_map<int, UniformValue> m_uniformValues;
 			std::vector<unsigned int> m_attachedShaders[ShaderStageType_Max+1];
 			bool m_linked;
+			bool m_linking;
+			bool m_viewUniformBlock;
 			int m_uniformLocations[ShaderUniform_Max+1];
 			unsigned int m_program;
 
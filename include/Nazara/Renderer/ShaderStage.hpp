@@ -23,15 +23,19 @@ namespace Nz
 			ShaderStage(ShaderStage&& stage);
 			~ShaderStage();
 
+			void BeginCompilation();
 			bool Compile();
 
 			bool Create(ShaderStageType stage);
 			void Destroy();
 
+			bool EndCompilation();
+
 			String GetLog() const;
 			String GetSource() const;
 
 			bool IsCompiled() const;
+			bool IsCompiling() const;
 			bool IsValid() const;
 
 			void SetSource(const char* source, unsigned int length);
@@ -49,6 +53,7 @@ namespace Nz
 		private:
 			ShaderStageType m_stage;
 			bool m_compiled;
+			bool m_compiling;
 			unsigned int m_id;
 	};
 }
@@ -0,0 +1,59 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STREAMBUFFER_HPP
+#define NAZARA_STREAMBUFFER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/Enums.hpp>
+#include <deque>
+
+namespace Nz
+{
+	// Suballocates the many small dynamic uploads of a frame from a single ring buffer
+	// Allocations are mapped without synchronization, the GPU is only waited for when the ring wraps around onto a frame it may still read
+	// With ARB_buffer_storage, the ring stays persistently mapped and Map() only returns a pointer into it
+	class NAZARA_RENDERER_API StreamBuffer
+	{
+		public:
+			StreamBuffer(BufferType type, unsigned int size);
+			StreamBuffer(const StreamBuffer&) = delete;
+			StreamBuffer(StreamBuffer&&) = delete;
+			~StreamBuffer();
+
+			void EndFrame();
+
+			Buffer* GetBuffer();
+			const Buffer* GetBuffer() const;
+			unsigned int GetSize() const;
+
+			void* Map(unsigned int size, unsigned int alignment, unsigned int* offset);
+			void Unmap();
+
+			StreamBuffer& operator=(const StreamBuffer&) = delete;
+			StreamBuffer& operator=(StreamBuffer&&) = delete;
+
+		private:
+			void WaitForOldestFrame();
+
+			struct Frame
+			{
+				void* fence; //< GLsync
+				UInt64 endPosition;
+			};
+
+			std::deque<Frame> m_frames;
+			Buffer m_buffer;
+			UInt64 m_fencedPosition;
+			UInt64 m_releasedPosition;
+			UInt64 m_writePosition;
+			unsigned int m_size;
+	};
+}
+
+#endif // NAZARA_STREAMBUFFER_HPP
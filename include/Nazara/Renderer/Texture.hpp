@@ -19,10 +19,12 @@
 #include <Nazara/Utility/AbstractImage.hpp>
 #include <Nazara/Utility/CubemapParams.hpp>
 #include <Nazara/Utility/Image.hpp>
+#include <atomic>
 
 namespace Nz
 {
 	class Texture;
+	class TextureSampler;
 
 	using TextureConstRef = ObjectRef<const Texture>;
 	using TextureLibrary = ObjectLibrary<Texture>;
@@ -36,6 +38,8 @@ namespace Nz
 		friend TextureLibrary;
 		friend TextureManager;
 		friend class Renderer;
+		friend class TextureStreamer;
+		friend class TextureUploadQueue;
 
 		public:
 			Texture() = default;
@@ -66,6 +70,7 @@ namespace Nz
 			unsigned int GetWidth(UInt8 level = 0) const;
 
 			bool HasMipmaps() const;
+			bool HasPendingUploads() const;
 
 			void InvalidateMipmaps();
 			bool IsValid() const;
@@ -75,6 +80,7 @@ namespace Nz
 			bool LoadFromImage(const Image& image, bool generateMipmaps = true);
 			bool LoadFromMemory(const void* data, std::size_t size, const ImageParams& params = ImageParams(), bool generateMipmaps = true);
 			bool LoadFromStream(Stream& stream, const ImageParams& params = ImageParams(), bool generateMipmaps = true);
+			bool LoadFromView(const ImageView& view, bool generateMipmaps = true);
 
 			// LoadArray
 			bool LoadArrayFromFile(const String& filePath, const ImageParams& imageParams = ImageParams(), bool generateMipmaps = true, const Vector2ui& atlasSize = Vector2ui(2, 2));
@@ -107,6 +113,7 @@ namespace Nz
 			bool Update(const UInt8* pixels, const Rectui& rect, unsigned int z = 0, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0);
 
 			// Fonctions OpenGL
+			UInt64 GetBindlessHandle(const TextureSampler& sampler) const;
 			unsigned int GetOpenGLID() const;
 
 			Texture& operator=(const Texture&) = delete;
@@ -123,13 +130,18 @@ namespace Nz
 
 		private:
 			bool CreateTexture(bool proxy);
+			bool LoadFromView(const void* data, std::size_t size, const ImageParams& params, bool generateMipmaps);
+			bool UpdateLevel(const void* source, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level);
 
 			static bool Initialize();
 			static void Uninitialize();
 
 			TextureImpl* m_impl = nullptr;
+			std::atomic<unsigned int> m_pendingUploads{0};
 
 			static TextureLibrary::LibraryMap s_library;
+			static TextureManager::ManagerCache s_managerCache;
+			static TextureManager::ManagerLoads s_managerLoads;
 			static TextureManager::ManagerMap s_managerMap;
 			static TextureManager::ManagerParams s_managerParameters;
 	};
@@ -0,0 +1,86 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TEXTURESTREAMER_HPP
+#define NAZARA_TEXTURESTREAMER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Signal.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class TextureUploadQueue;
+
+	// Keeps only the mip levels a texture needs resident, within a global video memory budget
+	// Textures start with their coarsest levels, finer ones are streamed through an upload queue when requested
+	class NAZARA_RENDERER_API TextureStreamer
+	{
+		public:
+			TextureStreamer(TextureUploadQueue& uploadQueue, UInt64 memoryBudget, unsigned int minResidentSize = 64);
+			TextureStreamer(const TextureStreamer&) = delete;
+			TextureStreamer(TextureStreamer&&) = delete;
+			~TextureStreamer();
+
+			bool Add(Texture* texture, const Image& image);
+
+			UInt64 GetMemoryBudget() const;
+			UInt64 GetMemoryUsage() const;
+			unsigned int GetMinResidentSize() const;
+			UInt8 GetResidentLevel(const Texture* texture) const;
+			std::size_t GetTextureCount() const;
+
+			bool IsStreamed(const Texture* texture) const;
+
+			void Remove(const Texture* texture);
+			void RequestResolution(const Texture* texture, float resolution);
+
+			void SetMemoryBudget(UInt64 memoryBudget);
+
+			void Update();
+
+			TextureStreamer& operator=(const TextureStreamer&) = delete;
+			TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+		private:
+			struct Entry
+			{
+				NazaraSlot(Texture, OnTextureDestroy, textureDestroySlot);
+				NazaraSlot(Texture, OnTextureRelease, textureReleaseSlot);
+
+				Image image; //< Keeps the whole mip chain
+				Texture* texture;
+				TextureRef pendingTexture; //< Finer levels being uploaded, swapped with the texture once complete
+				UInt64 lastRequest; //< Frame of the last resolution request
+				float resolution; //< Largest resolution requested since the last update
+				UInt8 coarsestLevel;
+				UInt8 pendingLevel;
+				UInt8 residentLevel; //< First image level held by the texture
+			};
+
+			UInt8 ComputeLevel(const Entry& entry, float resolution) const;
+			void OnTextureInvalidation(const Texture* texture);
+			bool Rebuild(Entry& entry, UInt8 level);
+
+			static UInt64 ComputeMemoryUsage(const Image& image, UInt8 firstLevel);
+
+			mutable Mutex m_mutex;
+			std::unordered_map<const Texture*, Entry> m_entries;
+			std::vector<Entry*> m_candidates;
+			TextureUploadQueue& m_uploadQueue;
+			UInt64 m_frame;
+			UInt64 m_memoryBudget;
+			UInt64 m_memoryUsage;
+			unsigned int m_minResidentSize;
+	};
+}
+
+#endif // NAZARA_TEXTURESTREAMER_HPP
@@ -0,0 +1,91 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TEXTUREUPLOADQUEUE_HPP
+#define NAZARA_TEXTUREUPLOADQUEUE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <deque>
+#include <vector>
+
+namespace Nz
+{
+	// Streams texture uploads through a staging ring, persistently mapped in a pixel buffer object when supported
+	// Uploads may be enqueued from any thread, the render thread submits them with Process() within a per-frame byte budget
+	class NAZARA_RENDERER_API TextureUploadQueue
+	{
+		public:
+			TextureUploadQueue(unsigned int stagingSize, unsigned int frameBudget);
+			TextureUploadQueue(const TextureUploadQueue&) = delete;
+			TextureUploadQueue(TextureUploadQueue&&) = delete;
+			~TextureUploadQueue();
+
+			bool Enqueue(Texture* texture, const Image& image, UInt8 baseLevel = 0);
+			bool Enqueue(Texture* texture, const UInt8* pixels, const Boxui& box, unsigned int srcWidth = 0, unsigned int srcHeight = 0, UInt8 level = 0);
+
+			unsigned int GetFrameBudget() const;
+			std::size_t GetPendingUploadCount() const;
+			unsigned int GetStagingSize() const;
+
+			bool IsPersistentlyMapped() const;
+
+			void Process();
+
+			void SetFrameBudget(unsigned int frameBudget);
+
+			TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+			TextureUploadQueue& operator=(TextureUploadQueue&&) = delete;
+
+		private:
+			struct UploadRegion
+			{
+				const UInt8* pixels;
+				Boxui box;
+				unsigned int srcHeight;
+				unsigned int srcWidth;
+				UInt8 level;
+			};
+
+			bool EnqueueRegions(Texture* texture, const UploadRegion* regions, std::size_t regionCount);
+			void ReleaseCompletedUploads();
+
+			struct Batch
+			{
+				std::vector<TextureRef> textures;
+				void* fence; //< GLsync
+				UInt64 endPosition;
+			};
+
+			struct Upload
+			{
+				TextureRef texture;
+				Boxui box;
+				UInt64 endPosition;
+				unsigned int offset;
+				unsigned int size;
+				UInt8 level;
+				bool staged;
+			};
+
+			mutable Mutex m_mutex;
+			std::deque<Batch> m_batches;
+			std::deque<Upload> m_uploads;
+			std::vector<Upload> m_submittedUploads;
+			std::vector<UInt8> m_clientMemory;
+			UInt8* m_stagingPtr;
+			UInt64 m_releasedPosition;
+			UInt64 m_writePosition;
+			unsigned int m_bufferId;
+			unsigned int m_frameBudget;
+			unsigned int m_stagingSize;
+	};
+}
+
+#endif // NAZARA_TEXTUREUPLOADQUEUE_HPP
@@ -36,6 +36,12 @@ namespace Nz
 
 			virtual UberShaderInstance* Get(const ParameterList& parameters) const = 0;
 
+			virtual bool HasFlag(const String& flag) const;
+
+			virtual void Preload(const ParameterList& parameters) const;
+
+			virtual UberShaderInstance* TryGet(const ParameterList& parameters) const;
+
 			UberShader& operator=(const UberShader&) = delete;
 			UberShader& operator=(UberShader&&) = delete;
 
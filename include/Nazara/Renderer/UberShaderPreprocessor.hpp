@@ -29,18 +29,38 @@ namespace Nz
 			UberShaderPreprocessor() = default;
 			~UberShaderPreprocessor();
 
-			UberShaderInstance* Get(const ParameterList& parameters) const;
+			UberShaderInstance* Get(const ParameterList& parameters) const override;
+
+			bool HasFlag(const String& flag) const override;
+
+			void Preload(const ParameterList& parameters) const override;
 
 			void SetShader(ShaderStageType stage, const String& source, const String& shaderFlags, const String& requiredFlags = String());
 			bool SetShaderFromFile(ShaderStageType stage, const String& filePath, const String& shaderFlags, const String& requiredFlags = String());
 
+			UberShaderInstance* TryGet(const ParameterList& parameters) const override;
+
+			static const String& GetProgramCacheDirectory();
 			static bool IsSupported();
+			static void SetProgramCacheDirectory(const String& directory);
 			template<typename... Args> static UberShaderPreprocessorRef New(Args&&... args);
 
 			// Signals:
 			NazaraSignal(OnUberShaderPreprocessorRelease, const UberShaderPreprocessor* /*uberShaderPreprocessor*/);
 
 		private:
+			struct PendingInstance
+			{
+				ShaderRef shader;
+				ShaderStage* stages[ShaderStageType_Max+1];
+				String cachePath;
+				String driverId;
+			};
+
+			UberShaderInstance* BeginInstance(const ParameterList& parameters, UInt32 flags) const;
+			UInt32 ComputeFlags(const ParameterList& parameters) const;
+			UberShaderInstance* EndInstance(UInt32 flags) const;
+
 			struct CachedShader
 			{
 				mutable std::unordered_map<UInt32, ShaderStage> cache;
@@ -50,9 +70,12 @@ namespace Nz
 				bool present = false;
 			};
 
+			mutable std::unordered_map<UInt32, PendingInstance> m_pendingInstances;
 			mutable std::unordered_map<UInt32, UberShaderInstancePreprocessor> m_cache;
 			std::unordered_map<String, UInt32> m_flags;
 			CachedShader m_shaders[ShaderStageType_Max+1];
+
+			static String s_programCacheDirectory;
 	};
 }
 
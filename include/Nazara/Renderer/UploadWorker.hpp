@@ -0,0 +1,44 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_UPLOADWORKER_HPP
+#define NAZARA_UPLOADWORKER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Renderer/Config.hpp>
+#include <functional>
+
+namespace Nz
+{
+	// Runs resource jobs (texture creation and updates, buffer fills, shader compilation) on a dedicated thread owning a context shared with the others
+	// Once the GPU is done with a job, its callback is called by ProcessCallbacks(), on the thread of the caller
+	class NAZARA_RENDERER_API UploadWorker
+	{
+		public:
+			using Callback = std::function<void(bool succeeded)>;
+			using Job = std::function<bool()>;
+
+			UploadWorker() = delete;
+			~UploadWorker() = delete;
+
+			static bool AddJob(Job job, Callback callback = Callback());
+
+			static std::size_t GetPendingJobCount();
+
+			static bool Initialize();
+
+			static bool IsInitialized();
+			static bool IsWorkerThread();
+
+			static void ProcessCallbacks();
+
+			static void Uninitialize();
+
+			static void WaitForJobs();
+	};
+}
+
+#endif // NAZARA_UPLOADWORKER_HPP
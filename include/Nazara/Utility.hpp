@@ -56,9 +56,11 @@
 #include <Nazara/Utility/Keyboard.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/MeshBufferPool.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/Mouse.hpp>
 #include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/NodeHierarchy.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/Utility/Sequence.hpp>
 #include <Nazara/Utility/SimpleTextDrawer.hpp>
@@ -31,6 +31,7 @@ namespace Nz
 			virtual std::size_t GetFontCount() const = 0;
 			virtual const Glyph& GetGlyph(std::size_t index) const = 0;
 			virtual std::size_t GetGlyphCount() const = 0;
+			virtual UInt64 GetGlyphRevision() const;
 
 			struct Glyph
 			{
@@ -40,6 +41,12 @@ namespace Nz
 				AbstractImage* atlas;
 				bool flipped;
 			};
+
+			// Glyphes returned under the same revision are never modified afterwards, new glyphes can only be appended to them
+			static constexpr UInt64 InvalidRevision = 0;
+
+		protected:
+			static UInt64 GenerateRevision();
 	};
 }
 
@@ -13,15 +13,19 @@
 #include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Math/Vector4.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/Sequence.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <vector>
 
 namespace Nz
 {
 	struct SkinningData
 	{
 		const Joint* joints;
+		const Matrix4f* skinningMatrices; //< Skinning matrices of the joints, taken from their skeleton when null
 		const SkeletalMeshVertex* inputVertex;
 		MeshVertex* outputVertex;
 	};
@@ -34,6 +38,8 @@ namespace Nz
 		SparsePtr<Vector2f> uvPtr;
 	};
 
+	NAZARA_UTILITY_API bool CompactVertices(VertexBuffer* vertexBuffer);
+
 	NAZARA_UTILITY_API Boxf ComputeAABB(SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount);
 	NAZARA_UTILITY_API void ComputeBoxIndexVertexCount(const Vector3ui& subdivision, unsigned int* indexCount, unsigned int* vertexCount);
 	NAZARA_UTILITY_API unsigned int ComputeCacheMissCount(IndexIterator indices, unsigned int indexCount);
@@ -50,13 +56,28 @@ namespace Nz
 	NAZARA_UTILITY_API void GeneratePlane(const Vector2ui& subdivision, const Vector2f& size, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
 	NAZARA_UTILITY_API void GenerateUvSphere(float size, unsigned int sliceCount, unsigned int stackCount, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
 
+	NAZARA_UTILITY_API void InterpolateSequenceJoints(const SequenceJoint* jointsA, const SequenceJoint* jointsB, float interpolation, SequenceJoint* output, unsigned int jointCount);
+
 	NAZARA_UTILITY_API void OptimizeIndices(IndexIterator indices, unsigned int indexCount);
+	NAZARA_UTILITY_API void OptimizeMeshBuffers(IndexBuffer* indexBuffer, VertexBuffer* vertexBuffer, const MeshParams& params);
+	NAZARA_UTILITY_API void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount, float threshold = 1.05f);
+	NAZARA_UTILITY_API unsigned int OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, unsigned int vertexCount, std::size_t vertexStride);
+
+	NAZARA_UTILITY_API UInt16 PackHalf(float value);
+	NAZARA_UTILITY_API UInt32 PackNormalizedInt2101010(const Vector4f& value);
+
+	NAZARA_UTILITY_API void QuantizeVertices(VertexPointers vertexPointers, unsigned int vertexCount, unsigned int positionBits = 16);
+
+	NAZARA_UTILITY_API void SimplifyIndices(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount, unsigned int targetIndexCount, std::vector<UInt32>* simplifiedIndices);
 
 	NAZARA_UTILITY_API void SkinPosition(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 	NAZARA_UTILITY_API void SkinPositionNormal(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 	NAZARA_UTILITY_API void SkinPositionNormalTangent(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 
 	NAZARA_UTILITY_API void TransformVertices(VertexPointers vertexPointers, unsigned int vertexCount, const Matrix4f& matrix);
+
+	NAZARA_UTILITY_API float UnpackHalf(UInt16 value);
+	NAZARA_UTILITY_API Vector4f UnpackNormalizedInt2101010(UInt32 value);
 }
 
 #endif // NAZARA_ALGORITHM_UTILITY_HPP
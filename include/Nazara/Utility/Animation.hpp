@@ -31,6 +31,9 @@ namespace Nz
 		// La frame de début à charger
 		unsigned int startFrame = 0;
 
+		// Should skeletal animations be compressed once loaded ? (See Animation::Compress, frames are then decoded on demand)
+		bool compress = false;
+
 		bool IsValid() const;
 	};
 
@@ -58,6 +61,9 @@ namespace Nz
 
 			bool AddSequence(const Sequence& sequence);
 			void AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation) const;
+			void AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation, const unsigned int* indices, unsigned int indiceCount) const;
+
+			bool Compress(float positionTolerance = 0.001f, float rotationTolerance = 0.001f);
 
 			bool CreateSkeletal(unsigned int frameCount, unsigned int jointCount);
 			void Destroy();
@@ -66,6 +72,7 @@ namespace Nz
 
 			unsigned int GetFrameCount() const;
 			unsigned int GetJointCount() const;
+			std::size_t GetMemoryUsage() const;
 			Sequence* GetSequence(const String& sequenceName);
 			Sequence* GetSequence(unsigned int index);
 			const Sequence* GetSequence(const String& sequenceName) const;
@@ -79,6 +86,7 @@ namespace Nz
 			bool HasSequence(const String& sequenceName) const;
 			bool HasSequence(unsigned int index = 0) const;
 
+			bool IsCompressed() const;
 			bool IsLoopPointInterpolationEnabled() const;
 			bool IsValid() const;
 
@@ -103,6 +111,8 @@ namespace Nz
 
 			static AnimationLibrary::LibraryMap s_library;
 			static AnimationLoader::LoaderList s_loaders;
+			static AnimationManager::ManagerCache s_managerCache;
+			static AnimationManager::ManagerLoads s_managerLoads;
 			static AnimationManager::ManagerMap s_managerMap;
 			static AnimationManager::ManagerParams s_managerParameters;
 	};
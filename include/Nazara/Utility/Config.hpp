@@ -39,8 +39,12 @@
 #define NAZARA_UTILITY_STRICT_RESOURCE_PARSING 1
 
 // Fait tourner chaque fenêtre dans un thread séparé si le système le supporte
+// Les évènements sont alors reçus dès leur arrivée, indépendamment de la fréquence des appels à PollEvent
 #define NAZARA_UTILITY_THREADED_WINDOW 0
 
+// Nombre d'évènements en attente d'une fenêtre threadée, au-delà ils passent par une liste plus lente protégée par un mutex
+#define NAZARA_UTILITY_THREADED_WINDOW_EVENT_QUEUE_SIZE 1024
+
 // Protège les classes des accès concurrentiels
 //#define NAZARA_UTILITY_THREADSAFE 1
 
@@ -46,6 +46,7 @@ namespace Nz
 	enum BufferType
 	{
 		BufferType_Index,
+		BufferType_Uniform,
 		BufferType_Vertex,
 
 		BufferType_Max = BufferType_Vertex
@@ -75,8 +76,15 @@ namespace Nz
 		ComponentType_Int3,
 		ComponentType_Int4,
 		ComponentType_Quaternion,
-
-		ComponentType_Max = ComponentType_Quaternion
+		ComponentType_Half2,
+		ComponentType_Half4,
+		ComponentType_NormalizedByte4,
+		ComponentType_NormalizedShort2,
+		ComponentType_NormalizedShort4,
+		ComponentType_NormalizedUShort2,
+		ComponentType_NormalizedInt2101010, //< x, y, z on 10 bits and w on 2 bits, signed
+
+		ComponentType_Max = ComponentType_NormalizedInt2101010
 	};
 
 	enum CubemapFace
@@ -133,6 +141,14 @@ namespace Nz
 		ImageType_Max = ImageType_Cubemap
 	};
 
+	enum MipmapFilter
+	{
+		MipmapFilter_Box,    // Average of the covered pixels
+		MipmapFilter_Kaiser, // Kaiser-windowed sinc, sharper
+
+		MipmapFilter_Max = MipmapFilter_Kaiser
+	};
+
 	enum NodeType
 	{
 		NodeType_Default,  // Node
@@ -158,11 +174,14 @@ namespace Nz
 		PixelFormatType_Undefined = -1,
 
 		PixelFormatType_A8,              // 1*uint8
+		PixelFormatType_BC5,             // Two channels blocks
+		PixelFormatType_BC7,
 		PixelFormatType_BGR8,            // 3*uint8
 		PixelFormatType_BGRA8,           // 4*uint8
 		PixelFormatType_DXT1,
 		PixelFormatType_DXT3,
 		PixelFormatType_DXT5,
+		PixelFormatType_ETC2,            // RGBA8 blocks, with EAC alpha
 		PixelFormatType_L8,              // 1*uint8
 		PixelFormatType_LA8,             // 2*uint8
 		PixelFormatType_R8,              // 1*uint8
@@ -424,6 +443,7 @@ namespace Nz
 		WindowEventType_MouseWheelMoved,
 		WindowEventType_Moved,
 		WindowEventType_Quit,
+		WindowEventType_RawMouseMoved,
 		WindowEventType_Resized,
 		WindowEventType_TextEntered,
 
@@ -65,6 +65,14 @@ namespace Nz
 			int y;
 		};
 
+		// Utilisé par:
+		// -WindowEventType_RawMouseMoved
+		struct RawMouseMoveEvent
+		{
+			int deltaX;
+			int deltaY;
+		};
+
 		// Utilisé par:
 		// -WindowEventType_Resized
 		struct SizeEvent
@@ -82,6 +90,7 @@ namespace Nz
 		};
 
 		WindowEventType type;
+		UInt64 timestamp; // Réception de l'évènement, en microsecondes (GetElapsedMicroseconds)
 
 		union
 		{
@@ -107,6 +116,10 @@ namespace Nz
 			// -WindowEventType_Moved
 			PositionEvent position;
 
+			// Utilisé par:
+			// -WindowEventType_RawMouseMoved
+			RawMouseMoveEvent rawMouseMove;
+
 			// Utilisé par:
 			// -WindowEventType_Resized
 			SizeEvent size;
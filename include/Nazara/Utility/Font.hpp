@@ -58,11 +58,15 @@ namespace Nz
 			bool Create(FontData* data);
 			void Destroy();
 
+			void EnableDistanceField(bool distanceField);
+
 			bool ExtractGlyph(unsigned int characterSize, char32_t character, UInt32 style, FontGlyph* glyph) const;
 
 			const std::shared_ptr<AbstractAtlas>& GetAtlas() const;
 			std::size_t GetCachedGlyphCount(unsigned int characterSize, UInt32 style) const;
 			std::size_t GetCachedGlyphCount() const;
+			unsigned int GetDistanceFieldSize() const;
+			unsigned int GetDistanceFieldSpread() const;
 			String GetFamilyName() const;
 			int GetKerning(unsigned int characterSize, char32_t first, char32_t second) const;
 			const Glyph& GetGlyph(unsigned int characterSize, UInt32 style, char32_t character) const;
@@ -71,6 +75,7 @@ namespace Nz
 			const SizeInfo& GetSizeInfo(unsigned int characterSize) const;
 			String GetStyleName() const;
 
+			bool IsDistanceFieldEnabled() const;
 			bool IsValid() const;
 
 			bool Precache(unsigned int characterSize, UInt32 style, char32_t character) const;
@@ -82,6 +87,8 @@ namespace Nz
 			bool OpenFromStream(Stream& stream, const FontParams& params = FontParams());
 
 			void SetAtlas(const std::shared_ptr<AbstractAtlas>& atlas);
+			void SetDistanceFieldSize(unsigned int characterSize);
+			void SetDistanceFieldSpread(unsigned int spread);
 			void SetGlyphBorder(unsigned int borderSize);
 			void SetMinimumStepSize(unsigned int minimumStepSize);
 
@@ -136,6 +143,7 @@ namespace Nz
 			void OnAtlasLayerChange(const AbstractAtlas* atlas, AbstractImage* oldLayer, AbstractImage* newLayer);
 			void OnAtlasRelease(const AbstractAtlas* atlas);
 			const Glyph& PrecacheGlyph(GlyphMap& glyphMap, unsigned int characterSize, UInt32 style, char32_t character) const;
+			void PrecacheGlyphs(GlyphMap& glyphMap, unsigned int characterSize, UInt32 style, const char32_t* characters, std::size_t characterCount) const;
 
 			static bool Initialize();
 			static void Uninitialize();
@@ -149,6 +157,9 @@ namespace Nz
 			mutable std::unordered_map<UInt64, std::unordered_map<UInt64, int>> m_kerningCache;
 			mutable std::unordered_map<UInt64, GlyphMap> m_glyphes;
 			mutable std::unordered_map<UInt64, SizeInfo> m_sizeInfoCache;
+			bool m_distanceFieldEnabled;
+			unsigned int m_distanceFieldSize;
+			unsigned int m_distanceFieldSpread;
 			unsigned int m_glyphBorder;
 			unsigned int m_minimumStepSize;
 
@@ -21,7 +21,10 @@ namespace Nz
 			FontData() = default;
 			virtual ~FontData();
 
+			virtual bool ExtractDistanceField(unsigned int characterSize, char32_t character, UInt32 style, unsigned int spread, FontGlyph* dst);
+			virtual bool ExtractDistanceFields(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, unsigned int spread, FontGlyph* glyphs, bool* extracted);
 			virtual bool ExtractGlyph(unsigned int characterSize, char32_t character, UInt32 style, FontGlyph* dst) = 0;
+			virtual bool ExtractGlyphs(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, FontGlyph* glyphs, bool* extracted);
 
 			virtual String GetFamilyName() const = 0;
 			virtual String GetStyleName() const = 0;
@@ -35,6 +38,7 @@ namespace Nz
 			virtual float QueryUnderlinePosition(unsigned int characterSize) const = 0;
 			virtual float QueryUnderlineThickness(unsigned int characterSize) const = 0;
 
+			virtual bool SupportsDistanceField() const;
 			virtual bool SupportsStyle(UInt32 style) const = 0;
 	};
 }
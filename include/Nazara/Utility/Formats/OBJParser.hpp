@@ -47,6 +47,7 @@ namespace Nz
 			inline unsigned int GetTexCoordCount() const;
 
 			bool Parse(Stream& stream, std::size_t reservedVertexCount = 100);
+			bool Parse(const void* data, std::size_t size, std::size_t reservedVertexCount = 100);
 
 			bool Save(Stream& stream) const;
 
@@ -79,14 +80,12 @@ namespace Nz
 			};
 
 		private:
-			bool Advance(bool required = true);
 			template<typename T> void Emit(const T& text) const;
 			inline void EmitLine() const;
 			template<typename T> void EmitLine(const T& line) const;
 			inline void Error(const String& message);
 			inline void Flush() const;
 			inline void Warning(const String& message);
-			inline void UnrecognizedLine(bool error = false);
 
 			std::vector<Mesh> m_meshes;
 			std::vector<String> m_materials;
@@ -94,10 +93,8 @@ namespace Nz
 			std::vector<Vector4f> m_positions;
 			std::vector<Vector3f> m_texCoords;
 			mutable Stream* m_currentStream;
-			String m_currentLine;
 			String m_mtlLib;
 			mutable StringStream m_outputStream;
-			bool m_keepLastLine;
 			unsigned int m_lineCount;
 	};
 }
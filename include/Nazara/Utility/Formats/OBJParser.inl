@@ -167,16 +167,6 @@ namespace Nz
 	{
 		NazaraWarning(message + " at line #" + String::Number(m_lineCount));
 	}
-
-	inline void OBJParser::UnrecognizedLine(bool error)
-	{
-		String message = "Unrecognized \"" + m_currentLine + '"';
-
-		if (error)
-			Error(message);
-		else
-			Warning(message);
-	}
 }
 
 #include <Nazara/Utility/DebugOff.hpp>
@@ -34,6 +34,7 @@ namespace Nz
 			UInt32 GetStorage() const override;
 
 			bool Insert(const Image& image, Rectui* rect, bool* flipped, unsigned int* layerIndex) override;
+			bool Insert(SparsePtr<const Image> images, Rectui* rects, bool* flipped, unsigned int* layerIndices, unsigned int count) override;
 
 			void SetRectChoiceHeuristic(GuillotineBinPack::FreeRectChoiceHeuristic heuristic);
 			void SetRectSplitHeuristic(GuillotineBinPack::GuillotineSplitHeuristic heuristic);
@@ -41,6 +42,7 @@ namespace Nz
 		protected:
 			struct Layer;
 
+			bool GrowLayers();
 			virtual AbstractImage* ResizeImage(AbstractImage* oldImage, const Vector2ui& size) const;
 			bool ResizeLayer(Layer& layer, const Vector2ui& size);
 
@@ -56,6 +58,7 @@ namespace Nz
 				std::vector<QueuedGlyph> queuedGlyphs;
 				std::unique_ptr<AbstractImage> image;
 				GuillotineBinPack binPack;
+				Image staging; // Copie locale des couches matérielles, permettant de les mettre à jour en un seul envoi
 				unsigned int freedRectangles = 0;
 			};
 
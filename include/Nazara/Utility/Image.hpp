@@ -22,6 +22,8 @@
 #include <Nazara/Utility/AbstractImage.hpp>
 #include <Nazara/Utility/CubemapParams.hpp>
 #include <atomic>
+#include <list>
+#include <vector>
 
 ///TODO: Filtres
 
@@ -38,6 +40,17 @@ namespace Nz
 		bool IsValid() const;
 	};
 
+	// Levels of an image stored outside of any Image (a mapped file for example), usable without a copy
+	struct ImageView
+	{
+		ImageType type;
+		PixelFormatType format;
+		std::vector<const UInt8*> levels;
+		unsigned int depth;
+		unsigned int height;
+		unsigned int width;
+	};
+
 	class Image;
 
 	using ImageConstRef = ObjectRef<const Image>;
@@ -58,6 +71,8 @@ namespace Nz
 		public:
 			struct SharedImage;
 
+			using ViewLoader = bool (*)(ImageView* view, const void* data, std::size_t size, const ImageParams& parameters);
+
 			Image();
 			Image(ImageType type, PixelFormatType format, unsigned int width, unsigned int height, unsigned int depth = 1, UInt8 levelCount = 1);
 			Image(const Image& image);
@@ -78,6 +93,8 @@ namespace Nz
 			bool FlipHorizontally();
 			bool FlipVertically();
 
+			bool GenerateMipmaps(MipmapFilter filter = MipmapFilter_Box, bool sRGB = false);
+
 			const UInt8* GetConstPixels(unsigned int x = 0, unsigned int y = 0, unsigned int z = 0, UInt8 level = 0) const;
 			unsigned int GetDepth(UInt8 level = 0) const;
 			PixelFormatType GetFormat() const;
@@ -134,7 +151,10 @@ namespace Nz
 			static void Copy(UInt8* destination, const UInt8* source, PixelFormatType format, unsigned int width, unsigned int height, unsigned int depth = 1, unsigned int dstWidth = 0, unsigned int dstHeight = 0, unsigned int srcWidth = 0, unsigned int srcHeight = 0);
 			static UInt8 GetMaxLevel(unsigned int width, unsigned int height, unsigned int depth = 1);
 			static UInt8 GetMaxLevel(ImageType type, unsigned int width, unsigned int height, unsigned int depth = 1);
+			static bool LoadViewFromMemory(ImageView* view, const void* data, std::size_t size, const ImageParams& params = ImageParams());
 			template<typename... Args> static ImageRef New(Args&&... args);
+			static void RegisterViewLoader(ImageLoader::StreamChecker checkFunc, ViewLoader viewLoader);
+			static void UnregisterViewLoader(ImageLoader::StreamChecker checkFunc, ViewLoader viewLoader);
 
 			struct SharedImage
 			{
@@ -178,9 +198,12 @@ namespace Nz
 
 			static ImageLibrary::LibraryMap s_library;
 			static ImageLoader::LoaderList s_loaders;
+			static ImageManager::ManagerCache s_managerCache;
+			static ImageManager::ManagerLoads s_managerLoads;
 			static ImageManager::ManagerMap s_managerMap;
 			static ImageManager::ManagerParams s_managerParameters;
 			static ImageSaver::SaverList s_savers;
+			static std::list<std::pair<ImageLoader::StreamChecker, ViewLoader>> s_viewLoaders;
 		};
 }
 
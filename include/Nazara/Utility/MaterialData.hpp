@@ -28,6 +28,7 @@ namespace Nz
 		static constexpr const char* DepthBuffer              = "MatDepthBuffer";
 		static constexpr const char* DepthFunc                = "MatDepthfunc";
 		static constexpr const char* DepthSorting             = "MatDepthSorting";
+		static constexpr const char* DistanceField            = "MatDistanceField";
 		static constexpr const char* DepthWrite               = "MatDepthWrite";
 		static constexpr const char* DiffuseAnisotropyLevel   = "MatDiffuseAnisotropyLevel";
 		static constexpr const char* DiffuseColor             = "MatDiffuseColor";
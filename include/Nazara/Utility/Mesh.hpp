@@ -26,6 +26,8 @@
 
 namespace Nz
 {
+	class MeshBufferPool;
+
 	struct NAZARA_UTILITY_API MeshParams : ResourceParameters
 	{
 		MeshParams(); // Vérifie que le storage par défaut est supporté (software autrement)
@@ -48,6 +50,30 @@ namespace Nz
 		// Faut-il optimiser les index buffers ? (Rendu plus rapide, mais le chargement dure plus longtemps)
 		bool optimizeIndexBuffers = true;
 
+		// Should triangles be sorted to reduce overdraw ? (Only when optimizing index buffers)
+		bool optimizeOverdraw = true;
+
+		// Should vertices be stored in their first use order ? (Unused and duplicated vertices are removed as well)
+		bool optimizeVertexFetch = true;
+
+		// Should vertex attributes be snapped to a fixed point precision ? (Vertices differing only by noise get merged)
+		bool quantizeVertices = false;
+
+		// Should normals, tangents and texture coordinates of static meshes be stored in compact types ? (see Mesh::CompactVertices)
+		bool compactVertices = false;
+
+		// Number of simplified versions of static meshes to generate (see StaticMesh::GenerateLevelsOfDetail)
+		unsigned int levelOfDetailCount = 0;
+
+		// Ratio of triangles kept from one level of detail to the next
+		float levelOfDetailReduction = 0.5f;
+
+		// Projected size (relative to the viewport height) under which the first simplified level is used
+		float levelOfDetailScreenSize = 0.25f;
+
+		// Pool moving the buffers of static meshes to shared buffers once loaded, so they can be drawn together (see MeshBufferPool)
+		MeshBufferPool* bufferPool = nullptr;
+
 		bool IsValid() const;
 	};
 
@@ -84,10 +110,13 @@ namespace Nz
 			SubMesh* BuildSubMesh(const Primitive& primitive, const MeshParams& params = MeshParams());
 			void BuildSubMeshes(const PrimitiveList& list, const MeshParams& params = MeshParams());
 
+			void CompactVertices();
+
 			bool CreateSkeletal(unsigned int jointCount);
 			bool CreateStatic();
 			void Destroy();
 
+			void GenerateLevelsOfDetail(unsigned int levelCount, float reduction = 0.5f, float screenSize = 0.25f);
 			void GenerateNormals();
 			void GenerateNormalsAndTangents();
 			void GenerateTangents();
@@ -99,6 +128,7 @@ namespace Nz
 			ParameterList& GetMaterialData(unsigned int index);
 			const ParameterList& GetMaterialData(unsigned int index) const;
 			unsigned int GetMaterialCount() const;
+			std::size_t GetMemoryUsage() const;
 			Skeleton* GetSkeleton();
 			const Skeleton* GetSkeleton() const;
 			SubMesh* GetSubMesh(const String& identifier);
@@ -150,6 +180,8 @@ namespace Nz
 
 			static MeshLibrary::LibraryMap s_library;
 			static MeshLoader::LoaderList s_loaders;
+			static MeshManager::ManagerCache s_managerCache;
+			static MeshManager::ManagerLoads s_managerLoads;
 			static MeshManager::ManagerMap s_managerMap;
 			static MeshManager::ManagerParams s_managerParameters;
 			static MeshSaver::SaverList s_savers;
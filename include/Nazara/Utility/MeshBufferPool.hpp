@@ -0,0 +1,106 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MESHBUFFERPOOL_HPP
+#define NAZARA_MESHBUFFERPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Signal.hpp>
+#include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/Enums.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	class Mesh;
+	class StaticMesh;
+
+	// Suballocates the buffers of static geometry from a few large shared buffers, one set per vertex declaration (and per index size)
+	// Meshes sharing their buffers are drawn without switching bindings, and merged by the multi-draw path of the render techniques
+	class NAZARA_UTILITY_API MeshBufferPool
+	{
+		public:
+			MeshBufferPool(UInt32 storage = DataStorage_Hardware, unsigned int blockSize = 4 * 1024 * 1024);
+			MeshBufferPool(const MeshBufferPool&) = delete;
+			MeshBufferPool(MeshBufferPool&&) = delete;
+			~MeshBufferPool();
+
+			IndexBufferRef AllocateIndices(bool largeIndices, unsigned int indexCount);
+			VertexBufferRef AllocateVertices(const VertexDeclaration* vertexDeclaration, unsigned int vertexCount);
+
+			unsigned int GetBlockCount() const;
+			unsigned int GetBlockSize() const;
+			UInt32 GetStorage() const;
+			UInt64 GetUsedSize() const;
+
+			bool IsPooled(const IndexBuffer* indexBuffer) const;
+			bool IsPooled(const VertexBuffer* vertexBuffer) const;
+
+			bool Store(Mesh* mesh);
+			bool Store(StaticMesh* staticMesh);
+
+			MeshBufferPool& operator=(const MeshBufferPool&) = delete;
+			MeshBufferPool& operator=(MeshBufferPool&&) = delete;
+
+		private:
+			struct Allocation;
+			struct Block;
+			struct Pool;
+
+			bool Allocate(Pool& pool, BufferType type, unsigned int size, Block** block, unsigned int* offset);
+			Allocation& Track(const void* buffer, Pool& pool, Block* block, unsigned int offset, unsigned int size);
+			void Free(const void* buffer);
+			bool StoreIndices(const IndexBuffer* indexBuffer, IndexBufferRef* pooledBuffer);
+			bool StoreVertices(VertexBuffer* vertexBuffer);
+
+			struct Allocation
+			{
+				Block* block;
+				Pool* pool;
+				unsigned int offset;
+				unsigned int size;
+
+				NazaraSlot(IndexBuffer, OnIndexBufferRelease, onIndexBufferReleaseSlot);
+				NazaraSlot(VertexBuffer, OnVertexBufferRelease, onVertexBufferReleaseSlot);
+			};
+
+			struct Range
+			{
+				unsigned int offset;
+				unsigned int size;
+			};
+
+			struct Block
+			{
+				BufferRef buffer;
+				std::vector<Range> freeRanges; //< Sorted by offset, neighbour ranges are merged
+			};
+
+			struct Pool
+			{
+				std::vector<std::unique_ptr<Block>> blocks;
+				VertexDeclarationConstRef vertexDeclaration; //< Null for index pools
+				unsigned int stride;
+			};
+
+			mutable Mutex m_mutex;
+			std::unordered_map<const void*, Allocation> m_allocations; //< Pooled index and vertex buffers
+			std::unordered_map<const VertexDeclaration*, Pool> m_vertexPools;
+			Pool m_indexPools[2]; //< Small then large indices
+			UInt32 m_storage;
+			UInt64 m_usedSize;
+			unsigned int m_blockSize;
+	};
+}
+
+#endif // NAZARA_MESHBUFFERPOOL_HPP
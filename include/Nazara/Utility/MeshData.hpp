@@ -12,12 +12,14 @@
 namespace Nz
 {
 	class IndexBuffer;
+	class Skeleton;
 	class VertexBuffer;
 
 	struct MeshData
 	{
 		PrimitiveMode primitiveMode;
 		const IndexBuffer* indexBuffer;
+		const Skeleton* skeleton; //< Skeleton skinning the vertices while rendering, null if they are already in their final place
 		const VertexBuffer* vertexBuffer;
 	};
 }
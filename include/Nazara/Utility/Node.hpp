@@ -19,8 +19,12 @@
 
 namespace Nz
 {
+	class NodeHierarchy;
+
 	class NAZARA_UTILITY_API Node
 	{
+		friend NodeHierarchy;
+
 		public:
 			Node();
 			Node(const Node& node);
@@ -41,6 +45,7 @@ namespace Nz
 			Vector3f GetInitialScale() const;
 			virtual Vector3f GetLeft() const;
 			virtual NodeType GetNodeType() const;
+			const NodeHierarchy* GetHierarchy() const;
 			const Node* GetParent() const;
 			Vector3f GetPosition(CoordSys coordSys = CoordSys_Global) const;
 			virtual Vector3f GetRight() const;
@@ -79,6 +84,7 @@ namespace Nz
 			void SetScale(const Vector3f& scale, CoordSys coordSys = CoordSys_Local);
 			void SetScale(float scale, CoordSys coordSys = CoordSys_Local);
 			void SetScale(float scaleX, float scaleY, float scaleZ = 1.f, CoordSys coordSys = CoordSys_Local);
+			void SetTransform(const Vector3f& position, const Quaternionf& rotation, const Vector3f& scale, CoordSys coordSys = CoordSys_Local);
 			void SetTransformMatrix(const Matrix4f& matrix);
 
 			// Local -> global
@@ -93,6 +99,8 @@ namespace Nz
 
 			Node& operator=(const Node& node);
 
+			static void MoveNodes(Node* const* nodes, const Vector3f* movements, std::size_t count);
+
 			// Signals:
 			NazaraSignal(OnNodeInvalidation, const Node* /*node*/);
 			NazaraSignal(OnNodeNewParent, const Node* /*node*/, const Node* /*parent*/);
@@ -123,6 +131,12 @@ namespace Nz
 			bool m_inheritRotation;
 			bool m_inheritScale;
 			mutable bool m_transformMatrixUpdated;
+
+		private:
+			void InvalidateFromHierarchy() const;
+
+			NodeHierarchy* m_hierarchy;
+			std::size_t m_hierarchyIndex;
 	};
 }
 
@@ -0,0 +1,98 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_NODEHIERARCHY_HPP
+#define NAZARA_NODEHIERARCHY_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class Node;
+
+	// Keeps the derived transforms of many nodes in depth-sorted arrays: invalidating a registered node only marks it,
+	// its descendants are recomputed by a single linear pass in Update, which also emits their OnNodeInvalidation signal.
+	// Reading a registered node before that still returns up to date values.
+	class NAZARA_UTILITY_API NodeHierarchy
+	{
+		friend Node;
+
+		public:
+			NodeHierarchy();
+			NodeHierarchy(const NodeHierarchy&) = delete;
+			NodeHierarchy(NodeHierarchy&&) = delete;
+			~NodeHierarchy();
+
+			void Clear();
+
+			inline std::size_t GetNodeCount() const;
+
+			inline bool HasPendingInvalidations() const;
+
+			void Register(Node* node);
+
+			void Unregister(Node* node);
+
+			void Update();
+
+			NodeHierarchy& operator=(const NodeHierarchy&) = delete;
+			NodeHierarchy& operator=(NodeHierarchy&&) = delete;
+
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+		private:
+			enum InvalidationFlags : UInt8
+			{
+				InvalidationFlags_Self       = 0x1,
+				InvalidationFlags_Propagated = 0x2,
+				InvalidationFlags_Unsignaled = 0x4  //< Moved by Node::MoveNodes, its signal is left to Update
+			};
+
+			enum InheritFlags : UInt8
+			{
+				InheritFlags_Position = 0x1,
+				InheritFlags_Rotation = 0x2,
+				InheritFlags_Scale    = 0x4
+			};
+
+			void InvalidateNode(const Node* node);
+			inline void InvalidateOrder();
+			inline void InvalidatePosition(const Node* node);
+			inline bool IsInvalidated(std::size_t index) const;
+			void RemoveNode(Node* node);
+			void SortNodes();
+			void UpdateLevel(std::size_t firstIndex, std::size_t lastIndex);
+			void UpdateNode(std::size_t index, const Vector3f& parentPosition, const Quaternionf& parentRotation, const Vector3f& parentScale);
+			void UpdateRoot(std::size_t index);
+			void WriteNode(std::size_t index);
+
+			std::vector<Node*> m_invalidatedNodes;
+			std::vector<Node*> m_nodes;
+			std::vector<Matrix4f> m_transformMatrices;
+			std::vector<Quaternionf> m_derivedRotations;
+			std::vector<Quaternionf> m_localRotations;
+			std::vector<Vector3f> m_derivedPositions;
+			std::vector<Vector3f> m_derivedScales;
+			std::vector<Vector3f> m_localPositions;
+			std::vector<Vector3f> m_localScales;
+			std::vector<std::size_t> m_levelOffsets;
+			std::vector<std::size_t> m_parentIndices;
+			std::vector<UInt8> m_inheritFlags;
+			std::vector<UInt8> m_invalidationFlags;
+			bool m_orderInvalidated;
+			bool m_pendingInvalidations;
+	};
+}
+
+#include <Nazara/Utility/NodeHierarchy.inl>
+
+#endif // NAZARA_NODEHIERARCHY_HPP
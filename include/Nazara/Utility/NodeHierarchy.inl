@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t NodeHierarchy::GetNodeCount() const
+	{
+		return m_nodes.size();
+	}
+
+	inline bool NodeHierarchy::HasPendingInvalidations() const
+	{
+		return m_pendingInvalidations;
+	}
+
+	inline void NodeHierarchy::InvalidateOrder()
+	{
+		m_orderInvalidated = true;
+	}
+
+	// Only touches the node's own entries, so different nodes may be invalidated from different threads
+	inline void NodeHierarchy::InvalidatePosition(const Node* node)
+	{
+		std::size_t index = node->m_hierarchyIndex;
+
+		m_localPositions[index] = node->m_initialPosition + node->m_position;
+
+		if (!node->m_parent && node->m_transformMatrixUpdated && m_invalidationFlags[index] == 0)
+		{
+			// Only the translation of an up to date root changes, it is written right away and skipped by Update
+			m_derivedPositions[index] = m_localPositions[index];
+			m_transformMatrices[index].SetTranslation(m_derivedPositions[index]);
+
+			node->m_derivedPosition = m_derivedPositions[index];
+			node->m_transformMatrix.SetTranslation(m_derivedPositions[index]);
+
+			m_invalidationFlags[index] = InvalidationFlags_Unsignaled;
+		}
+		else
+		{
+			node->m_derivedUpdated = false;
+			node->m_transformMatrixUpdated = false;
+
+			m_invalidationFlags[index] |= InvalidationFlags_Self | InvalidationFlags_Unsignaled;
+		}
+	}
+
+	inline bool NodeHierarchy::IsInvalidated(std::size_t index) const
+	{
+		return m_invalidationFlags[index] != 0;
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
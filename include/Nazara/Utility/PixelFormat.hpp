@@ -13,7 +13,6 @@
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <functional>
-#include <map>
 
 ///TODO: Permettre la conversion automatique entre les formats via des renseignements de bits et de type pour chaque format.
 ///      Ce serait plus lent que la conversion spécialisée (qui ne disparaîtra donc pas) mais ça permettrait au moteur de faire la conversion
@@ -57,9 +56,11 @@ namespace Nz
 		friend class Utility;
 
 		public:
+			using CompressFunction = std::function<void(const UInt8* texels, UInt8* block)>;
 			using ConvertFunction = std::function<UInt8*(const UInt8* start, const UInt8* end, UInt8* dst)>;
-			using FlipFunction = std::function<void(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)>;
+			using FlipFunction = std::function<bool(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)>;
 
+			static bool Compress(PixelFormatType dstFormat, unsigned int width, unsigned int height, unsigned int depth, const void* src, void* dst);
 			static inline std::size_t ComputeSize(PixelFormatType format, unsigned int width, unsigned int height, unsigned int depth);
 
 			static inline bool Convert(PixelFormatType srcFormat, PixelFormatType dstFormat, const void* src, void* dst);
@@ -78,9 +79,11 @@ namespace Nz
 			static PixelFormatType IdentifyFormat(const PixelFormatInfo& info);
 
 			static inline bool IsCompressed(PixelFormatType format);
+			static inline bool IsCompressionSupported(PixelFormatType format);
 			static inline bool IsConversionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat);
 			static inline bool IsValid(PixelFormatType format);
 
+			static inline void SetCompressFunction(PixelFormatType format, CompressFunction func);
 			static inline void SetConvertFunction(PixelFormatType srcFormat, PixelFormatType dstFormat, ConvertFunction func);
 			static inline void SetFlipFunction(PixelFlipping flipping, PixelFormatType format, FlipFunction func);
 
@@ -89,8 +92,9 @@ namespace Nz
 			static void Uninitialize();
 
 			static PixelFormatInfo s_pixelFormatInfos[PixelFormatType_Max + 1];
+			static CompressFunction s_compressFunctions[PixelFormatType_Max+1];
 			static ConvertFunction s_convertFunctions[PixelFormatType_Max+1][PixelFormatType_Max+1];
-			static std::map<PixelFormatType, FlipFunction> s_flipFunctions[PixelFlipping_Max+1];
+			static FlipFunction s_flipFunctions[PixelFlipping_Max+1][PixelFormatType_Max+1];
 	};
 }
 
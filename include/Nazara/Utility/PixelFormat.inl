@@ -4,8 +4,10 @@
 
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -153,9 +155,12 @@ namespace Nz
 		{
 			switch (format)
 			{
+				case PixelFormatType_BC5:
+				case PixelFormatType_BC7:
 				case PixelFormatType_DXT1:
 				case PixelFormatType_DXT3:
 				case PixelFormatType_DXT5:
+				case PixelFormatType_ETC2:
 					return (((width + 3) / 4) * ((height + 3) / 4) * ((format == PixelFormatType_DXT1) ? 8 : 16)) * depth;
 
 				default:
@@ -220,7 +225,34 @@ namespace Nz
 			return false;
 		}
 
-		if (!func(reinterpret_cast<const UInt8*>(start), reinterpret_cast<const UInt8*>(end), reinterpret_cast<UInt8*>(dst)))
+		const UInt8* srcPtr = reinterpret_cast<const UInt8*>(start);
+		const UInt8* srcEnd = reinterpret_cast<const UInt8*>(end);
+		UInt8* dstPtr = reinterpret_cast<UInt8*>(dst);
+
+		std::size_t srcBpp = GetBytesPerPixel(srcFormat);
+		std::size_t dstBpp = GetBytesPerPixel(dstFormat);
+
+		bool succeeded;
+		if (srcBpp != 0 && dstBpp != 0) // Compressed formats cannot be cut at any pixel
+		{
+			// Large images are converted by bands of pixels spread across the workers
+			constexpr std::size_t bandSize = 64 * 1024;
+
+			std::size_t pixelCount = (srcEnd - srcPtr) / srcBpp;
+			std::atomic<bool> failed(false);
+			TaskScheduler::ParallelFor(0, pixelCount, bandSize, [&] (std::size_t first, std::size_t last)
+			{
+				const UInt8* bandEnd = (last == pixelCount) ? srcEnd : srcPtr + last * srcBpp;
+				if (!func(srcPtr + first * srcBpp, bandEnd, dstPtr + first * dstBpp))
+					failed.store(true, std::memory_order_relaxed);
+			});
+
+			succeeded = !failed.load(std::memory_order_relaxed);
+		}
+		else
+			succeeded = (func(srcPtr, srcEnd, dstPtr) != nullptr);
+
+		if (!succeeded)
 		{
 			NazaraError("Pixel format conversion from " + GetName(srcFormat) + " to " + GetName(dstFormat) + " failed");
 			return false;
@@ -239,87 +271,17 @@ namespace Nz
 		}
 		#endif
 
-		auto it = s_flipFunctions[flipping].find(format);
-		if (it != s_flipFunctions[flipping].end())
-			it->second(width, height, depth, reinterpret_cast<const UInt8*>(src), reinterpret_cast<UInt8*>(dst));
-		else
+		const FlipFunction& func = s_flipFunctions[flipping][format];
+		if (!func)
 		{
-			// Flipping générique
-
-			#if NAZARA_UTILITY_SAFE
-			if (IsCompressed(format))
-			{
-				NazaraError("No function to flip compressed format");
-				return false;
-			}
-			#endif
+			NazaraError("No function to flip " + GetName(format));
+			return false;
+		}
 
-			UInt8 bpp = GetBytesPerPixel(format);
-			unsigned int lineStride = width*bpp;
-			switch (flipping)
-			{
-				case PixelFlipping_Horizontally:
-				{
-					if (src == dst)
-					{
-						for (unsigned int z = 0; z < depth; ++z)
-						{
-							UInt8* ptr = reinterpret_cast<UInt8*>(dst) + width*height*z;
-							for (unsigned int y = 0; y < height/2; ++y)
-								std::swap_ranges(&ptr[y*lineStride], &ptr[(y+1)*lineStride-1], &ptr[(height-y-1)*lineStride]);
-						}
-					}
-					else
-					{
-						for (unsigned int z = 0; z < depth; ++z)
-						{
-							const UInt8* srcPtr = reinterpret_cast<const UInt8*>(src);
-							UInt8* dstPtr = reinterpret_cast<UInt8*>(dst) + (width-1)*height*depth*bpp;
-							for (unsigned int y = 0; y < height; ++y)
-							{
-								std::memcpy(dstPtr, srcPtr, lineStride);
-
-								srcPtr += lineStride;
-								dstPtr -= lineStride;
-							}
-						}
-					}
-					break;
-				}
-
-				case PixelFlipping_Vertically:
-				{
-					if (src == dst)
-					{
-						for (unsigned int z = 0; z < depth; ++z)
-						{
-							UInt8* ptr = reinterpret_cast<UInt8*>(dst) + width*height*z;
-							for (unsigned int y = 0; y < height; ++y)
-							{
-								for (unsigned int x = 0; x < width/2; ++x)
-									std::swap_ranges(&ptr[x*bpp], &ptr[(x+1)*bpp], &ptr[(width-x)*bpp]);
-
-								ptr += lineStride;
-							}
-						}
-					}
-					else
-					{
-						for (unsigned int z = 0; z < depth; ++z)
-						{
-							UInt8* ptr = reinterpret_cast<UInt8*>(dst) + width*height*z;
-							for (unsigned int y = 0; y < height; ++y)
-							{
-								for (unsigned int x = 0; x < width; ++x)
-									std::memcpy(&ptr[x*bpp], &ptr[(width-x)*bpp], bpp);
-
-								ptr += lineStride;
-							}
-						}
-					}
-					break;
-				}
-			}
+		if (!func(width, height, depth, reinterpret_cast<const UInt8*>(src), reinterpret_cast<UInt8*>(dst)))
+		{
+			NazaraError("Failed to flip " + GetName(format) + " pixels");
+			return false;
 		}
 
 		return true;
@@ -360,11 +322,20 @@ namespace Nz
 		return s_pixelFormatInfos[format].IsCompressed();
 	}
 
+	inline bool PixelFormat::IsCompressionSupported(PixelFormatType format)
+	{
+		return s_compressFunctions[format] != nullptr;
+	}
+
 	inline bool PixelFormat::IsConversionSupported(PixelFormatType srcFormat, PixelFormatType dstFormat)
 	{
 		if (srcFormat == dstFormat)
 			return true;
 
+		// Compression is done from RGBA8
+		if (IsCompressionSupported(dstFormat))
+			return srcFormat == PixelFormatType_RGBA8 || s_convertFunctions[srcFormat][PixelFormatType_RGBA8] != nullptr;
+
 		return s_convertFunctions[srcFormat][dstFormat] != nullptr;
 	}
 
@@ -373,6 +344,11 @@ namespace Nz
 		return format != PixelFormatType_Undefined;
 	}
 
+	inline void PixelFormat::SetCompressFunction(PixelFormatType format, CompressFunction func)
+	{
+		s_compressFunctions[format] = func;
+	}
+
 	inline void PixelFormat::SetConvertFunction(PixelFormatType srcFormat, PixelFormatType dstFormat, ConvertFunction func)
 	{
 		s_convertFunctions[srcFormat][dstFormat] = func;
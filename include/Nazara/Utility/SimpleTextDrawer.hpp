@@ -36,6 +36,7 @@ namespace Nz
 			std::size_t GetFontCount() const override;
 			const Glyph& GetGlyph(std::size_t index) const override;
 			std::size_t GetGlyphCount() const override;
+			UInt64 GetGlyphRevision() const override;
 			UInt32 GetStyle() const;
 			const String& GetText() const;
 
@@ -75,6 +76,7 @@ namespace Nz
 			String m_text;
 			mutable UInt32 m_previousCharacter;
 			UInt32 m_style;
+			mutable UInt64 m_glyphRevision;
 			mutable Vector2ui m_drawPos;
 			mutable bool m_colorUpdated;
 			mutable bool m_glyphUpdated;
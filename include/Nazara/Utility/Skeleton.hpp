@@ -49,6 +49,7 @@ namespace Nz
 			const Joint* GetJoints() const;
 			unsigned int GetJointCount() const;
 			int GetJointIndex(const String& jointName) const;
+			const Matrix4f* GetSkinningMatrices() const;
 
 			void Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation);
 			void Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation, unsigned int* indices, unsigned int indiceCount);
@@ -67,7 +68,11 @@ namespace Nz
 		private:
 			void InvalidateJoints();
 			void InvalidateJointMap();
+			void InvalidateJointOrder();
+			void InvalidateSkinningMatrices();
 			void UpdateJointMap() const;
+			void UpdateJointOrder() const;
+			void UpdateSkinningMatrices() const;
 
 			static bool Initialize();
 			static void Uninitialize();
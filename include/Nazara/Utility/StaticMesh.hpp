@@ -10,6 +10,7 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Utility/SubMesh.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -24,16 +25,23 @@ namespace Nz
 			StaticMesh(const Mesh* parent);
 			~StaticMesh();
 
+			void AddLevelOfDetail(const IndexBuffer* indexBuffer, float screenSize);
+
 			void Center();
+			void ClearLevelsOfDetail();
 
 			bool Create(VertexBuffer* vertexBuffer);
 			void Destroy();
 
 			bool GenerateAABB();
+			unsigned int GenerateLevelsOfDetail(unsigned int levelCount, float reduction = 0.5f, float screenSize = 0.25f);
 
 			const Boxf& GetAABB() const override;
 			AnimationType GetAnimationType() const final;
 			const IndexBuffer* GetIndexBuffer() const override;
+			const IndexBuffer* GetIndexBuffer(unsigned int levelOfDetail) const;
+			unsigned int GetLevelOfDetailCount() const;
+			float GetLevelOfDetailScreenSize(unsigned int levelOfDetail) const;
 			VertexBuffer* GetVertexBuffer();
 			const VertexBuffer* GetVertexBuffer() const;
 			unsigned int GetVertexCount() const override;
@@ -41,6 +49,8 @@ namespace Nz
 			bool IsAnimated() const final;
 			bool IsValid() const;
 
+			unsigned int SelectLevelOfDetail(float screenSize) const;
+
 			void SetAABB(const Boxf& aabb);
 			void SetIndexBuffer(const IndexBuffer* indexBuffer);
 
@@ -51,6 +61,13 @@ namespace Nz
 			NazaraSignal(OnStaticMeshRelease, const StaticMesh* /*staticMesh*/);
 
 		private:
+			struct LevelOfDetail
+			{
+				IndexBufferConstRef indexBuffer;
+				float screenSize;
+			};
+
+			std::vector<LevelOfDetail> m_levelsOfDetail;
 			Boxf m_aabb;
 			IndexBufferConstRef m_indexBuffer = nullptr;
 			VertexBufferRef m_vertexBuffer = nullptr;
@@ -29,6 +29,8 @@ namespace Nz
 			static unsigned int ComponentCount[ComponentType_Max+1];
 			static std::size_t ComponentStride[ComponentType_Max+1];
 
+			static constexpr bool ParallelInitialization = true;
+
 		private:
 			static unsigned int s_moduleReferenceCounter;
 	};
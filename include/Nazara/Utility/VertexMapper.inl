@@ -2,6 +2,8 @@
 // This file is part of the "Nazara Engine - Utility module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Utility.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -22,6 +24,15 @@ namespace Nz
 		if (enabled)
 		{
 			///TODO: Vérifier le rapport entre le type de l'attribut et le type template ?
+			#if NAZARA_UTILITY_SAFE
+			// Un composant compact (ex: half-float) ne peut pas être lu comme un vecteur de flottants
+			if (sizeof(T) > Utility::ComponentStride[type])
+			{
+				NazaraError("Attribute 0x" + String::Number(component, 16) + " (type: 0x" + String::Number(type, 16) + ") is smaller than the requested type");
+				return SparsePtr<T>();
+			}
+			#endif
+
 			return SparsePtr<T>(static_cast<UInt8*>(m_mapper.GetPointer()) + offset, declaration->GetStride());
 		}
 		else
@@ -22,6 +22,10 @@
 #if NAZARA_UTILITY_THREADED_WINDOW
 #include <Nazara/Core/ConditionVariable.hpp>
 #include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/SpscQueue.hpp>
+#include <atomic>
+#include <deque>
+#include <memory>
 #endif
 
 namespace Nz
@@ -53,6 +57,7 @@ namespace Nz
 			void Destroy();
 
 			void EnableKeyRepeat(bool enable);
+			void EnableRawMouseInput(bool enable);
 			void EnableSmoothScrolling(bool enable);
 
 			WindowHandle GetHandle() const;
@@ -66,6 +71,7 @@ namespace Nz
 			bool HasFocus() const;
 
 			bool IsMinimized() const;
+			bool IsRawMouseInputEnabled() const;
 			inline bool IsOpen(bool checkClosed = true);
 			inline bool IsOpen() const;
 			inline bool IsValid() const;
@@ -106,16 +112,26 @@ namespace Nz
 			void IgnoreNextMouseEvent(int mouseX, int mouseY) const;
 			inline void PushEvent(const WindowEvent& event);
 
+			#if NAZARA_UTILITY_THREADED_WINDOW
+			bool PopEvent(WindowEvent* event);
+			void PushOverflowEvent(const WindowEvent& event);
+			#endif
+
 			static bool Initialize();
 			static void Uninitialize();
 
-			std::queue<WindowEvent> m_events;
 			#if NAZARA_UTILITY_THREADED_WINDOW
-			ConditionVariable m_eventCondition;
-			Mutex m_eventMutex;
-			Mutex m_eventConditionMutex;
+			std::deque<WindowEvent> m_overflowEvents; //< Events which did not fit in m_events, newer than all of its events
+			std::unique_ptr<SpscQueue<WindowEvent>> m_events; //< Filled by the window thread only
+			std::unique_ptr<ConditionVariable> m_eventCondition;
+			std::unique_ptr<Mutex> m_eventConditionMutex;
+			std::unique_ptr<Mutex> m_overflowMutex;
+			std::atomic_bool m_hasOverflowEvents;
+			std::atomic_bool m_waitForEvent;
 			bool m_eventListener;
-			bool m_waitForEvent;
+			bool m_overflowWarned;
+			#else
+			std::queue<WindowEvent> m_events;
 			#endif
 			bool m_closed;
 			bool m_ownsWindow;
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Window.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -15,8 +16,14 @@ namespace Nz
 	inline Window::Window() :
 	#if NAZARA_UTILITY_THREADED_WINDOW
 	m_impl(nullptr),
+	m_events(new SpscQueue<WindowEvent>(NAZARA_UTILITY_THREADED_WINDOW_EVENT_QUEUE_SIZE)),
+	m_eventCondition(new ConditionVariable),
+	m_eventConditionMutex(new Mutex),
+	m_overflowMutex(new Mutex),
+	m_hasOverflowEvents(false),
+	m_waitForEvent(false),
 	m_eventListener(true),
-	m_waitForEvent(false)
+	m_overflowWarned(false)
 	#else
 	m_impl(nullptr)
 	#endif
@@ -26,8 +33,14 @@ namespace Nz
 	inline Window::Window(VideoMode mode, const String& title, UInt32 style) :
 	#if NAZARA_UTILITY_THREADED_WINDOW
 	m_impl(nullptr),
+	m_events(new SpscQueue<WindowEvent>(NAZARA_UTILITY_THREADED_WINDOW_EVENT_QUEUE_SIZE)),
+	m_eventCondition(new ConditionVariable),
+	m_eventConditionMutex(new Mutex),
+	m_overflowMutex(new Mutex),
+	m_hasOverflowEvents(false),
+	m_waitForEvent(false),
 	m_eventListener(true),
-	m_waitForEvent(false)
+	m_overflowWarned(false)
 	#else
 	m_impl(nullptr)
 	#endif
@@ -39,8 +52,14 @@ namespace Nz
 	inline Window::Window(WindowHandle handle) :
 	#if NAZARA_UTILITY_THREADED_WINDOW
 	m_impl(nullptr),
+	m_events(new SpscQueue<WindowEvent>(NAZARA_UTILITY_THREADED_WINDOW_EVENT_QUEUE_SIZE)),
+	m_eventCondition(new ConditionVariable),
+	m_eventConditionMutex(new Mutex),
+	m_overflowMutex(new Mutex),
+	m_hasOverflowEvents(false),
+	m_waitForEvent(false),
 	m_eventListener(true),
-	m_waitForEvent(false)
+	m_overflowWarned(false)
 	#else
 	m_impl(nullptr)
 	#endif
@@ -54,13 +73,18 @@ namespace Nz
 	*/
 	inline Window::Window(Window&& window) noexcept :
 	m_impl(window.m_impl),
+	#if NAZARA_UTILITY_THREADED_WINDOW
+	m_overflowEvents(std::move(window.m_overflowEvents)),
+	#endif
 	m_events(std::move(window.m_events)),
 	#if NAZARA_UTILITY_THREADED_WINDOW
 	m_eventCondition(std::move(window.m_eventCondition)),
-	m_eventMutex(std::move(window.m_eventMutex)),
 	m_eventConditionMutex(std::move(window.m_eventConditionMutex)),
+	m_overflowMutex(std::move(window.m_overflowMutex)),
+	m_hasOverflowEvents(window.m_hasOverflowEvents.load()),
+	m_waitForEvent(window.m_waitForEvent.load()),
 	m_eventListener(window.m_eventListener),
-	m_waitForEvent(window.m_waitForEvent),
+	m_overflowWarned(window.m_overflowWarned),
 	#endif
 	m_closed(window.m_closed),
 	m_ownsWindow(window.m_ownsWindow)
@@ -104,22 +128,27 @@ namespace Nz
 
 	inline void Window::PushEvent(const WindowEvent& event)
 	{
+		WindowEvent timedEvent = event;
+		timedEvent.timestamp = GetElapsedMicroseconds();
+
 		#if NAZARA_UTILITY_THREADED_WINDOW
-		m_eventMutex.Lock();
+		// Jamais bloquant : le thread de la fenêtre doit continuer à répondre au système
+		// Une fois la file pleine, les évènements vont dans la liste de débordement tant qu'elle n'est pas vidée, pour garder leur ordre
+		if (m_hasOverflowEvents || !m_events->Push(timedEvent))
+			PushOverflowEvent(timedEvent);
+		#else
+		m_events.push(timedEvent);
 		#endif
 
-		m_events.push(event);
 		if (event.type == WindowEventType_Resized)
 			OnWindowResized();
 
 		#if NAZARA_UTILITY_THREADED_WINDOW
-		m_eventMutex.Unlock();
-
 		if (m_waitForEvent)
 		{
-			m_eventConditionMutex.Lock();
-			m_eventCondition.Signal();
-			m_eventConditionMutex.Unlock();
+			m_eventConditionMutex->Lock();
+			m_eventCondition->Signal();
+			m_eventConditionMutex->Unlock();
 		}
 		#endif
 	}
@@ -141,10 +170,13 @@ namespace Nz
 
 		#if NAZARA_UTILITY_THREADED_WINDOW
 		m_eventCondition      = std::move(window.m_eventCondition);
-		m_eventMutex          = std::move(window.m_eventMutex);
 		m_eventConditionMutex = std::move(window.m_eventConditionMutex);
 		m_eventListener       = window.m_eventListener;
-		m_waitForEvent        = window.m_waitForEvent;
+		m_hasOverflowEvents   = window.m_hasOverflowEvents.load();
+		m_overflowEvents      = std::move(window.m_overflowEvents);
+		m_overflowMutex       = std::move(window.m_overflowMutex);
+		m_overflowWarned      = window.m_overflowWarned;
+		m_waitForEvent        = window.m_waitForEvent.load();
 		#endif
 
 		return *this;
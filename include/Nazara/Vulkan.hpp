@@ -29,13 +29,28 @@
 #ifndef NAZARA_GLOBAL_VULKAN_HPP
 #define NAZARA_GLOBAL_VULKAN_HPP
 
+#include <Nazara/Vulkan/CommandRecorder.hpp>
 #include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/DescriptorAllocator.hpp>
+#include <Nazara/Vulkan/DescriptorSetCache.hpp>
+#include <Nazara/Vulkan/DeviceMemoryAllocator.hpp>
+#include <Nazara/Vulkan/DynamicUniformBuffer.hpp>
+#include <Nazara/Vulkan/Enums.hpp>
+#include <Nazara/Vulkan/FrameRing.hpp>
+#include <Nazara/Vulkan/GraphicsPipelineState.hpp>
+#include <Nazara/Vulkan/LinearMemoryPool.hpp>
+#include <Nazara/Vulkan/PipelineManager.hpp>
+#include <Nazara/Vulkan/VkBuffer.hpp>
 #include <Nazara/Vulkan/VkCommandBuffer.hpp>
 #include <Nazara/Vulkan/VkCommandPool.hpp>
+#include <Nazara/Vulkan/VkDescriptorPool.hpp>
 #include <Nazara/Vulkan/VkDevice.hpp>
 #include <Nazara/Vulkan/VkDeviceObject.hpp>
+#include <Nazara/Vulkan/VkFence.hpp>
 #include <Nazara/Vulkan/VkInstance.hpp>
 #include <Nazara/Vulkan/VkLoader.hpp>
+#include <Nazara/Vulkan/VkPipelineCache.hpp>
+#include <Nazara/Vulkan/VkQueue.hpp>
 #include <Nazara/Vulkan/VkSemaphore.hpp>
 #include <Nazara/Vulkan/VkSurface.hpp>
 #include <Nazara/Vulkan/VkSwapchain.hpp>
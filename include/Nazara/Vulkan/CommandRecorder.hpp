@@ -0,0 +1,80 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_COMMANDRECORDER_HPP
+#define NAZARA_VULKAN_COMMANDRECORDER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/VkCommandBuffer.hpp>
+#include <Nazara/Vulkan/VkCommandPool.hpp>
+#include <Nazara/Vulkan/VkFence.hpp>
+#include <Nazara/Vulkan/VkQueue.hpp>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	// Records the frames in flight from every TaskScheduler worker: each thread owns a command pool per frame
+	// and records secondary command buffers for its slices of the work, which the primary command buffer executes in order
+	class NAZARA_VULKAN_API CommandRecorder
+	{
+		public:
+			CommandRecorder(Vk::Device& device);
+			CommandRecorder(const CommandRecorder&) = delete;
+			CommandRecorder(CommandRecorder&&) = delete;
+			~CommandRecorder();
+
+			bool BeginFrame();
+
+			bool Create(UInt32 queueFamilyIndex, unsigned int frameCount = 2);
+			void Destroy();
+
+			inline unsigned int GetFrameCount() const;
+			inline unsigned int GetFrameIndex() const;
+			Vk::CommandBuffer& GetPrimaryCommandBuffer();
+
+			template<typename F> bool RecordRenderPass(const VkRenderPassBeginInfo& renderPassInfo, std::size_t itemCount, std::size_t grainSize, F recordFunction);
+
+			bool Submit(Vk::Queue& queue, VkSemaphore waitSemaphore = VK_NULL_HANDLE, VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VkSemaphore signalSemaphore = VK_NULL_HANDLE);
+
+			CommandRecorder& operator=(const CommandRecorder&) = delete;
+			CommandRecorder& operator=(CommandRecorder&&) = delete;
+
+		private:
+			Vk::CommandBuffer* AcquireSecondaryBuffer(const VkRenderPassBeginInfo& renderPassInfo);
+			void ExecuteSecondaryBuffers();
+
+			struct ThreadPool
+			{
+				ThreadPool(Vk::Device& device);
+
+				Vk::CommandPool pool;
+				std::vector<Vk::CommandBuffer> secondaryBuffers; //< Reused each time the frame comes back
+				std::size_t usedBufferCount;
+			};
+
+			struct Frame
+			{
+				Frame(Vk::Device& device);
+
+				Vk::CommandPool primaryPool;
+				Vk::Fence fence; //< Signaled once the GPU is done with the frame commands
+				std::vector<Vk::CommandBuffer> primaryBuffer;
+				std::vector<std::unique_ptr<ThreadPool>> threadPools; //< Indexed by TaskScheduler::GetWorkerIndex()
+			};
+
+			std::vector<std::unique_ptr<Frame>> m_frames;
+			std::vector<VkCommandBuffer> m_chunkBuffers;
+			Vk::Device& m_device;
+			unsigned int m_currentFrame;
+			bool m_recording;
+	};
+}
+
+#include <Nazara/Vulkan/CommandRecorder.inl>
+
+#endif // NAZARA_VULKAN_COMMANDRECORDER_HPP
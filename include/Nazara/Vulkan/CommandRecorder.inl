@@ -0,0 +1,74 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/CommandRecorder.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <algorithm>
+#include <atomic>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	inline unsigned int CommandRecorder::GetFrameCount() const
+	{
+		return static_cast<unsigned int>(m_frames.size());
+	}
+
+	inline unsigned int CommandRecorder::GetFrameIndex() const
+	{
+		return m_currentFrame;
+	}
+
+	/*!
+	* \brief Records a render pass of the primary command buffer from every worker
+	* \return true if every slice has been recorded
+	*
+	* \param renderPassInfo Render pass to begin, its commands are all recorded in secondary command buffers
+	* \param itemCount Number of items to record (draws, batches, ...)
+	* \param grainSize Number of items recorded in a single secondary command buffer
+	* \param recordFunction Callable as recordFunction(Vk::CommandBuffer& commandBuffer, std::size_t first, std::size_t last), from any thread
+	*
+	* \remark The secondary command buffers are executed in the order of their items, whichever thread recorded them
+	*/
+	template<typename F>
+	bool CommandRecorder::RecordRenderPass(const VkRenderPassBeginInfo& renderPassInfo, std::size_t itemCount, std::size_t grainSize, F recordFunction)
+	{
+		NazaraAssert(m_recording, "BeginFrame must be called first");
+
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		// One slot per slice, a thread handling several consecutive slices at once only fills the first one
+		m_chunkBuffers.assign((itemCount + grainSize - 1) / grainSize, static_cast<VkCommandBuffer>(VK_NULL_HANDLE));
+
+		std::atomic_bool failed(false);
+		TaskScheduler::ParallelFor(0, itemCount, grainSize, [&](std::size_t first, std::size_t last)
+		{
+			Vk::CommandBuffer* commandBuffer = AcquireSecondaryBuffer(renderPassInfo);
+			if (!commandBuffer)
+			{
+				failed = true;
+				return;
+			}
+
+			recordFunction(*commandBuffer, first, last);
+
+			if (!commandBuffer->End())
+			{
+				failed = true;
+				return;
+			}
+
+			m_chunkBuffers[first / grainSize] = *commandBuffer;
+		});
+
+		GetPrimaryCommandBuffer().BeginRenderPass(renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		ExecuteSecondaryBuffers();
+		GetPrimaryCommandBuffer().EndRenderPass();
+
+		return !failed;
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
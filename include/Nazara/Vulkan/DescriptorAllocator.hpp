@@ -0,0 +1,51 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_DESCRIPTORALLOCATOR_HPP
+#define NAZARA_VULKAN_DESCRIPTORALLOCATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/VkDescriptorPool.hpp>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	// Allocates descriptor sets from a growing list of descriptor pools, all of them reset at once
+	// Pools are kept across resets, so a steady workload stops creating any
+	class NAZARA_VULKAN_API DescriptorAllocator
+	{
+		public:
+			DescriptorAllocator(Vk::Device& device);
+			DescriptorAllocator(const DescriptorAllocator&) = delete;
+			DescriptorAllocator(DescriptorAllocator&&) = delete;
+			~DescriptorAllocator() = default;
+
+			VkDescriptorSet Allocate(VkDescriptorSetLayout setLayout);
+
+			bool Create(std::vector<VkDescriptorPoolSize> poolSizes, UInt32 setsPerPool);
+			void Destroy();
+
+			std::size_t GetPoolCount() const;
+
+			void Reset();
+
+			DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+			DescriptorAllocator& operator=(DescriptorAllocator&&) = delete;
+
+		private:
+			mutable Mutex m_mutex;
+			std::vector<std::unique_ptr<Vk::DescriptorPool>> m_pools;
+			std::vector<VkDescriptorPoolSize> m_poolSizes;
+			std::size_t m_currentPool;
+			Vk::Device& m_device;
+			UInt32 m_setsPerPool;
+	};
+}
+
+#endif // NAZARA_VULKAN_DESCRIPTORALLOCATOR_HPP
@@ -0,0 +1,79 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_DESCRIPTORSETCACHE_HPP
+#define NAZARA_VULKAN_DESCRIPTORSETCACHE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/DescriptorAllocator.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	// Long-lived descriptor sets (material textures and parameters), written once and shared by every identical binding list
+	// Per-draw data is expected to go through dynamic uniform buffers, whose offsets don't change the set
+	class NAZARA_VULKAN_API DescriptorSetCache
+	{
+		public:
+			struct Binding;
+
+			DescriptorSetCache(Vk::Device& device);
+			DescriptorSetCache(const DescriptorSetCache&) = delete;
+			DescriptorSetCache(DescriptorSetCache&&) = delete;
+			~DescriptorSetCache() = default;
+
+			void Clear();
+
+			bool Create(std::vector<VkDescriptorPoolSize> poolSizes, UInt32 setsPerPool);
+			void Destroy();
+
+			VkDescriptorSet GetDescriptorSet(VkDescriptorSetLayout setLayout, const Binding* bindings, std::size_t bindingCount);
+			std::size_t GetDescriptorSetCount() const;
+
+			DescriptorSetCache& operator=(const DescriptorSetCache&) = delete;
+			DescriptorSetCache& operator=(DescriptorSetCache&&) = delete;
+
+			struct Binding
+			{
+				VkBuffer buffer = VK_NULL_HANDLE;
+				VkDescriptorType type;
+				VkDeviceSize offset = 0;
+				VkDeviceSize range = VK_WHOLE_SIZE;
+				VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				VkImageView imageView = VK_NULL_HANDLE;
+				VkSampler sampler = VK_NULL_HANDLE;
+				UInt32 binding;
+			};
+
+		private:
+			struct Key
+			{
+				std::vector<Binding> bindings;
+				VkDescriptorSetLayout setLayout;
+
+				bool operator==(const Key& key) const;
+			};
+
+			struct KeyHasher
+			{
+				std::size_t operator()(const Key& key) const;
+			};
+
+			mutable Mutex m_mutex;
+			std::unordered_map<Key, VkDescriptorSet, KeyHasher> m_descriptorSets;
+			std::vector<VkDescriptorBufferInfo> m_bufferInfos;
+			std::vector<VkDescriptorImageInfo> m_imageInfos;
+			std::vector<VkWriteDescriptorSet> m_writes;
+			DescriptorAllocator m_allocator;
+			Key m_lookupKey; //< Reused so that a lookup doesn't allocate
+			Vk::Device& m_device;
+	};
+}
+
+#endif // NAZARA_VULKAN_DESCRIPTORSETCACHE_HPP
@@ -0,0 +1,108 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_DEVICEMEMORYALLOCATOR_HPP
+#define NAZARA_VULKAN_DEVICEMEMORYALLOCATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Signal.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/Enums.hpp>
+#include <Nazara/Vulkan/VkDevice.hpp>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace Nz
+{
+	// Suballocates device memory out of large blocks with a buddy allocator, one pool of blocks per memory type and tiling
+	// Host visible blocks stay mapped as long as they live, big resources get their own device memory
+	class NAZARA_VULKAN_API DeviceMemoryAllocator
+	{
+		public:
+			struct Allocation;
+
+			DeviceMemoryAllocator(Vk::Device& device);
+			DeviceMemoryAllocator(const DeviceMemoryAllocator&) = delete;
+			DeviceMemoryAllocator(DeviceMemoryAllocator&&) = delete;
+			~DeviceMemoryAllocator();
+
+			bool Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags requiredProperties, Allocation* allocation, UInt32 flags = DeviceMemory_None, VkMemoryPropertyFlags preferredProperties = 0, void* userData = nullptr);
+
+			bool Create(VkPhysicalDevice physicalDevice, VkDeviceSize blockSize = 64 * 1024 * 1024);
+			std::size_t Defragment(VkDeviceSize maxMovedSize);
+			void Destroy();
+
+			void Free(const Allocation& allocation);
+
+			VkDeviceSize GetBlockSize() const;
+			UInt32 GetDeviceAllocationCount() const;
+			inline Vk::Device& GetDevice();
+			VkDeviceSize GetHeapBudget(UInt32 heapIndex) const;
+			VkDeviceSize GetHeapUsage(UInt32 heapIndex) const;
+			inline const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const;
+
+			void SetHeapBudget(UInt32 heapIndex, VkDeviceSize budget);
+
+			DeviceMemoryAllocator& operator=(const DeviceMemoryAllocator&) = delete;
+			DeviceMemoryAllocator& operator=(DeviceMemoryAllocator&&) = delete;
+
+			// Signals:
+			NazaraSignal(OnAllocationMove, DeviceMemoryAllocator* /*allocator*/, const Allocation& /*oldAllocation*/, const Allocation& /*newAllocation*/);
+
+			struct Allocation
+			{
+				VkDeviceMemory memory;
+				VkDeviceSize offset;
+				VkDeviceSize size;
+				UInt8* mappedPtr; //< Points to offset, null if the memory is not host visible
+				void* userData;
+				UInt32 flags;
+				UInt32 memoryType;
+				UInt8 order; //< Buddy order of the node holding the allocation
+			};
+
+		private:
+			struct Block
+			{
+				std::map<VkDeviceSize, Allocation> movableAllocations;
+				std::vector<std::set<VkDeviceSize>> freeNodes; //< Offsets of the free nodes of each order, order 0 being the whole block
+				VkDeviceMemory memory;
+				VkDeviceSize usedSize;
+				UInt8* mappedPtr;
+			};
+
+			struct Pool
+			{
+				std::vector<std::unique_ptr<Block>> blocks;
+				VkDeviceSize blockSize;
+			};
+
+			bool AllocateDeviceMemory(UInt32 memoryType, VkDeviceSize size, VkDeviceMemory* memory, UInt8** mappedPtr);
+			bool AllocateFromPool(UInt32 memoryType, UInt32 flags, VkDeviceSize nodeSize, const Block* excludedBlock, bool allowNewBlock, Allocation* allocation);
+			void FreeDeviceMemory(UInt32 memoryType, VkDeviceMemory memory, VkDeviceSize size);
+			inline Pool& GetPool(UInt32 memoryType, UInt32 flags);
+
+			static void ReleaseNode(Block& block, VkDeviceSize blockSize, VkDeviceSize offset, UInt8 order);
+			static bool TakeNode(Block& block, VkDeviceSize blockSize, UInt8 order, VkDeviceSize* offset);
+
+			mutable Mutex m_mutex;
+			std::vector<Pool> m_pools;
+			std::vector<VkDeviceSize> m_heapBudgets;
+			std::vector<VkDeviceSize> m_heapUsages;
+			Vk::Device& m_device;
+			VkDeviceSize m_blockSize;
+			VkPhysicalDeviceMemoryProperties m_memoryProperties;
+			UInt32 m_allocationCount;
+			UInt32 m_maxAllocationCount;
+	};
+}
+
+#include <Nazara/Vulkan/DeviceMemoryAllocator.inl>
+
+#endif // NAZARA_VULKAN_DEVICEMEMORYALLOCATOR_HPP
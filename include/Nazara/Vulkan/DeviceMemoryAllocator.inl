@@ -0,0 +1,27 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DeviceMemoryAllocator.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	inline Vk::Device& DeviceMemoryAllocator::GetDevice()
+	{
+		return m_device;
+	}
+
+	inline const VkPhysicalDeviceMemoryProperties& DeviceMemoryAllocator::GetMemoryProperties() const
+	{
+		return m_memoryProperties;
+	}
+
+	inline DeviceMemoryAllocator::Pool& DeviceMemoryAllocator::GetPool(UInt32 memoryType, UInt32 flags)
+	{
+		// Linear and optimal resources never share a block, which keeps them bufferImageGranularity apart
+		return m_pools[memoryType * 2 + ((flags & DeviceMemory_OptimalTiling) ? 1 : 0)];
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
@@ -0,0 +1,51 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_DYNAMICUNIFORMBUFFER_HPP
+#define NAZARA_VULKAN_DYNAMICUNIFORMBUFFER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/LinearMemoryPool.hpp>
+#include <Nazara/Vulkan/VkBuffer.hpp>
+
+namespace Nz
+{
+	// Per-draw uniform data, written into the current frame region of a single buffer and selected with a dynamic offset
+	// A descriptor set referring to the buffer (as VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) is shared by every draw
+	class NAZARA_VULKAN_API DynamicUniformBuffer
+	{
+		public:
+			DynamicUniformBuffer(DeviceMemoryAllocator& allocator);
+			DynamicUniformBuffer(const DynamicUniformBuffer&) = delete;
+			DynamicUniformBuffer(DynamicUniformBuffer&&) = delete;
+			~DynamicUniformBuffer() = default;
+
+			bool Create(VkDeviceSize frameSize, unsigned int frameCount, VkDeviceSize alignment = 256);
+			void Destroy();
+
+			inline VkDeviceSize GetAlignment() const;
+			inline Vk::Buffer& GetBuffer();
+			inline const Vk::Buffer& GetBuffer() const;
+			inline VkDeviceSize GetUsedSize() const;
+
+			void NextFrame();
+
+			bool Push(const void* data, VkDeviceSize size, UInt32* dynamicOffset);
+
+			DynamicUniformBuffer& operator=(const DynamicUniformBuffer&) = delete;
+			DynamicUniformBuffer& operator=(DynamicUniformBuffer&&) = delete;
+
+		private:
+			LinearMemoryPool m_pool;
+			Vk::Buffer m_buffer;
+			VkDeviceSize m_alignment;
+	};
+}
+
+#include <Nazara/Vulkan/DynamicUniformBuffer.inl>
+
+#endif // NAZARA_VULKAN_DYNAMICUNIFORMBUFFER_HPP
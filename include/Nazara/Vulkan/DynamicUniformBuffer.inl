@@ -0,0 +1,31 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DynamicUniformBuffer.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	inline VkDeviceSize DynamicUniformBuffer::GetAlignment() const
+	{
+		return m_alignment;
+	}
+
+	inline Vk::Buffer& DynamicUniformBuffer::GetBuffer()
+	{
+		return m_buffer;
+	}
+
+	inline const Vk::Buffer& DynamicUniformBuffer::GetBuffer() const
+	{
+		return m_buffer;
+	}
+
+	inline VkDeviceSize DynamicUniformBuffer::GetUsedSize() const
+	{
+		return m_pool.GetUsedSize();
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
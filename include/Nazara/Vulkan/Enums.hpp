@@ -0,0 +1,23 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ENUMS_VULKAN_HPP
+#define NAZARA_ENUMS_VULKAN_HPP
+
+namespace Nz
+{
+	enum DeviceMemoryFlags
+	{
+		DeviceMemory_None          = 0x0,
+		DeviceMemory_Dedicated     = 0x1, //< Gets its own device memory instead of a part of a block
+		DeviceMemory_Movable       = 0x2, //< May be relocated by DeviceMemoryAllocator::Defragment
+		DeviceMemory_OptimalTiling = 0x4, //< Bound to an image with optimal tiling
+
+		DeviceMemory_Max = DeviceMemory_OptimalTiling*2-1
+	};
+}
+
+#endif // NAZARA_ENUMS_VULKAN_HPP
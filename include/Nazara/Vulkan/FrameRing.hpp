@@ -0,0 +1,110 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_FRAMERING_HPP
+#define NAZARA_VULKAN_FRAMERING_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/CommandRecorder.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/DescriptorAllocator.hpp>
+#include <Nazara/Vulkan/DynamicUniformBuffer.hpp>
+#include <Nazara/Vulkan/LinearMemoryPool.hpp>
+#include <Nazara/Vulkan/VkSemaphore.hpp>
+#include <Nazara/Vulkan/VkSwapchain.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	// Frames in flight of a swapchain: the CPU records a frame while the GPU renders the previous ones
+	// Each frame owns its fence and command pools (through a CommandRecorder), swapchain semaphores, descriptor pools, uniform and upload regions,
+	// all of them recycled once the GPU is done with the frame, along with the resources it had to destroy
+	class NAZARA_VULKAN_API FrameRing
+	{
+		public:
+			struct Parameters;
+
+			FrameRing(Vk::Device& device);
+			FrameRing(const FrameRing&) = delete;
+			FrameRing(FrameRing&&) = delete;
+			~FrameRing();
+
+			bool BeginFrame(Vk::Swapchain& swapchain);
+
+			bool Create(Vk::Queue& queue, UInt32 queueFamilyIndex, const Parameters& parameters, DeviceMemoryAllocator* allocator = nullptr);
+			void Destroy();
+
+			template<typename T> void DestroyLater(T&& object);
+			void DestroyLater(std::function<void()> destructor);
+
+			inline CommandRecorder& GetCommandRecorder();
+			DescriptorAllocator& GetDescriptorAllocator();
+			inline unsigned int GetFrameCount() const;
+			inline unsigned int GetFrameIndex() const;
+			inline UInt32 GetImageIndex() const;
+			inline DynamicUniformBuffer* GetUniformBuffer();
+			inline LinearMemoryPool* GetUploadPool();
+
+			bool Present();
+
+			FrameRing& operator=(const FrameRing&) = delete;
+			FrameRing& operator=(FrameRing&&) = delete;
+
+			struct Parameters
+			{
+				std::vector<VkDescriptorPoolSize> descriptorPoolSizes; //< Descriptor pools of each frame, none if empty
+				VkDeviceSize uniformAlignment = 256;                  //< At least the device minUniformBufferOffsetAlignment
+				VkDeviceSize uniformSize = 0;                         //< Uniform region of each frame, none if zero (requires an allocator)
+				VkDeviceSize uploadSize = 0;                          //< Upload region of each frame, none if zero (requires an allocator)
+				UInt32 descriptorSetsPerPool = 256;
+				UInt32 uploadMemoryTypeBits = 0xFFFFFFFF;
+				unsigned int frameCount = 2;
+			};
+
+		private:
+			void RetireFrame(unsigned int frameIndex);
+
+			struct DeferredObject
+			{
+				virtual ~DeferredObject() = default;
+			};
+
+			template<typename T>
+			struct DeferredObjectHolder : DeferredObject
+			{
+				DeferredObjectHolder(T&& obj) : object(std::move(obj)) {}
+
+				T object;
+			};
+
+			struct Frame
+			{
+				Frame(Vk::Device& device);
+
+				std::vector<std::function<void()>> deferredDestructors;
+				std::vector<std::unique_ptr<DeferredObject>> deferredObjects;
+				DescriptorAllocator descriptorAllocator;
+				Vk::Semaphore imageAvailable;
+				Vk::Semaphore renderFinished;
+			};
+
+			std::unique_ptr<DynamicUniformBuffer> m_uniformBuffer;
+			std::unique_ptr<LinearMemoryPool> m_uploadPool;
+			std::vector<std::unique_ptr<Frame>> m_frames;
+			CommandRecorder m_recorder;
+			Vk::Device& m_device;
+			Vk::Swapchain* m_swapchain;
+			VkQueue m_queue;
+			UInt32 m_imageIndex;
+			unsigned int m_currentFrame;
+	};
+}
+
+#include <Nazara/Vulkan/FrameRing.inl>
+
+#endif // NAZARA_VULKAN_FRAMERING_HPP
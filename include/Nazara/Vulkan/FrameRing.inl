@@ -0,0 +1,57 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/FrameRing.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <type_traits>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Keeps an object alive until the GPU is done with the current frame
+	*
+	* \param object Object to destroy later (a Vulkan object wrapper for example), moved into the frame
+	*/
+	template<typename T>
+	void FrameRing::DestroyLater(T&& object)
+	{
+		static_assert(!std::is_lvalue_reference<T>::value, "Object must be moved into the frame");
+		NazaraAssert(!m_frames.empty(), "Frame ring must be created first");
+
+		m_frames[m_currentFrame]->deferredObjects.emplace_back(new DeferredObjectHolder<T>(std::move(object)));
+	}
+
+	inline CommandRecorder& FrameRing::GetCommandRecorder()
+	{
+		return m_recorder;
+	}
+
+	inline unsigned int FrameRing::GetFrameCount() const
+	{
+		return static_cast<unsigned int>(m_frames.size());
+	}
+
+	inline unsigned int FrameRing::GetFrameIndex() const
+	{
+		return m_currentFrame;
+	}
+
+	inline UInt32 FrameRing::GetImageIndex() const
+	{
+		return m_imageIndex;
+	}
+
+	inline DynamicUniformBuffer* FrameRing::GetUniformBuffer()
+	{
+		return m_uniformBuffer.get();
+	}
+
+	inline LinearMemoryPool* FrameRing::GetUploadPool()
+	{
+		return m_uploadPool.get();
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
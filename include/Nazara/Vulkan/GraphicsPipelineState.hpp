@@ -0,0 +1,71 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_GRAPHICSPIPELINESTATE_HPP
+#define NAZARA_VULKAN_GRAPHICSPIPELINESTATE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <vulkan/vulkan.h>
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace Nz
+{
+	// Everything a graphics pipeline is made of, by value so it can be hashed and compared
+	struct NAZARA_VULKAN_API GraphicsPipelineState
+	{
+		struct ShaderStage
+		{
+			String entryPoint = "main";
+			VkShaderModule module;
+			VkShaderStageFlagBits stage;
+		};
+
+		std::array<float, 4> blendConstants = {{0.f, 0.f, 0.f, 0.f}};
+		std::vector<VkPipelineColorBlendAttachmentState> blendAttachments;
+		std::vector<VkDynamicState> dynamicStates;
+		std::vector<ShaderStage> shaderStages;
+		std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+		std::vector<VkVertexInputBindingDescription> vertexBindings;
+		VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+		VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+		VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+		VkPipelineLayout layout = VK_NULL_HANDLE;
+		VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+		VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		VkRenderPass renderPass = VK_NULL_HANDLE;
+		VkSampleCountFlagBits sampleCount = VK_SAMPLE_COUNT_1_BIT;
+		VkStencilOpState stencilBack = {};
+		VkStencilOpState stencilFront = {};
+		UInt32 subpass = 0;
+		float depthBiasConstant = 0.f;
+		float depthBiasSlope = 0.f;
+		float lineWidth = 1.f;
+		bool depthBias = false;
+		bool depthTest = true;
+		bool depthWrite = true;
+		bool primitiveRestart = false;
+		bool stencilTest = false;
+
+		std::size_t ComputeHash() const;
+
+		bool operator==(const GraphicsPipelineState& state) const;
+		bool operator!=(const GraphicsPipelineState& state) const;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<Nz::GraphicsPipelineState>;
+}
+
+#include <Nazara/Vulkan/GraphicsPipelineState.inl>
+
+#endif // NAZARA_VULKAN_GRAPHICSPIPELINESTATE_HPP
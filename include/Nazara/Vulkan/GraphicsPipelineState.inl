@@ -0,0 +1,20 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/GraphicsPipelineState.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace std
+{
+	template<>
+	struct hash<Nz::GraphicsPipelineState>
+	{
+		size_t operator()(const Nz::GraphicsPipelineState& state) const
+		{
+			return state.ComputeHash();
+		}
+	};
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
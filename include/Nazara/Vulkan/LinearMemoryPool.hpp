@@ -0,0 +1,54 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_LINEARMEMORYPOOL_HPP
+#define NAZARA_VULKAN_LINEARMEMORYPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/DeviceMemoryAllocator.hpp>
+#include <atomic>
+
+namespace Nz
+{
+	// Bump allocator for transient data (uploads, per-frame constants), one region of a single device memory per frame in flight
+	// A region is reused when NextFrame comes back to it, the GPU must be done with it by then (see CommandRecorder::BeginFrame)
+	class NAZARA_VULKAN_API LinearMemoryPool
+	{
+		public:
+			LinearMemoryPool(DeviceMemoryAllocator& allocator);
+			LinearMemoryPool(const LinearMemoryPool&) = delete;
+			LinearMemoryPool(LinearMemoryPool&&) = delete;
+			~LinearMemoryPool();
+
+			bool Allocate(VkDeviceSize size, VkDeviceSize alignment, DeviceMemoryAllocator::Allocation* allocation);
+
+			bool Create(UInt32 memoryTypeBits, VkDeviceSize frameSize, unsigned int frameCount, VkMemoryPropertyFlags properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			void Destroy();
+
+			inline const DeviceMemoryAllocator::Allocation& GetAllocation() const;
+			inline unsigned int GetFrameCount() const;
+			inline VkDeviceSize GetFrameSize() const;
+			inline VkDeviceSize GetUsedSize() const;
+
+			void NextFrame();
+
+			LinearMemoryPool& operator=(const LinearMemoryPool&) = delete;
+			LinearMemoryPool& operator=(LinearMemoryPool&&) = delete;
+
+		private:
+			std::atomic<VkDeviceSize> m_usedSize;
+			DeviceMemoryAllocator::Allocation m_allocation;
+			DeviceMemoryAllocator& m_allocator;
+			VkDeviceSize m_frameSize;
+			unsigned int m_currentFrame;
+			unsigned int m_frameCount;
+	};
+}
+
+#include <Nazara/Vulkan/LinearMemoryPool.inl>
+
+#endif // NAZARA_VULKAN_LINEARMEMORYPOOL_HPP
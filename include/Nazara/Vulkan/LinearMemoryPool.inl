@@ -0,0 +1,34 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/LinearMemoryPool.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \brief Gets the whole device memory allocation of the pool, for resources spanning every frame region
+	*/
+	inline const DeviceMemoryAllocator::Allocation& LinearMemoryPool::GetAllocation() const
+	{
+		return m_allocation;
+	}
+
+	inline unsigned int LinearMemoryPool::GetFrameCount() const
+	{
+		return m_frameCount;
+	}
+
+	inline VkDeviceSize LinearMemoryPool::GetFrameSize() const
+	{
+		return m_frameSize;
+	}
+
+	inline VkDeviceSize LinearMemoryPool::GetUsedSize() const
+	{
+		return m_usedSize;
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
@@ -0,0 +1,74 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_PIPELINEMANAGER_HPP
+#define NAZARA_VULKAN_PIPELINEMANAGER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Vulkan/Config.hpp>
+#include <Nazara/Vulkan/GraphicsPipelineState.hpp>
+#include <Nazara/Vulkan/VkPipelineCache.hpp>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace Nz
+{
+	// Creates each graphics pipeline state only once, through a pipeline cache saved to disk between runs
+	// Pipelines may also be built by worker threads in the background, see Preload and TryGetPipeline
+	class NAZARA_VULKAN_API PipelineManager
+	{
+		public:
+			PipelineManager(Vk::Device& device);
+			PipelineManager(const PipelineManager&) = delete;
+			PipelineManager(PipelineManager&&) = delete;
+			~PipelineManager();
+
+			bool Create(VkPhysicalDevice physicalDevice, const String& cacheDirectory = String(), unsigned int workerCount = 1);
+			void Destroy();
+
+			VkPipeline GetPipeline(const GraphicsPipelineState& state);
+			std::size_t GetPipelineCount() const;
+
+			void Preload(const GraphicsPipelineState& state);
+
+			bool SaveCache();
+
+			VkPipeline TryGetPipeline(const GraphicsPipelineState& state);
+
+			PipelineManager& operator=(const PipelineManager&) = delete;
+			PipelineManager& operator=(PipelineManager&&) = delete;
+
+		private:
+			VkPipeline CreatePipeline(const GraphicsPipelineState& state);
+			void WorkerThread();
+
+			struct Entry
+			{
+				VkPipeline pipeline = VK_NULL_HANDLE; //< Stays null if the creation failed, it is not retried
+				bool queued = false;
+				bool ready = false;
+			};
+
+			mutable Mutex m_mutex;
+			std::deque<GraphicsPipelineState> m_queue;
+			std::unordered_map<GraphicsPipelineState, Entry> m_pipelines;
+			std::vector<Thread> m_workers;
+			ConditionVariable m_pipelineCondition;
+			ConditionVariable m_queueCondition;
+			String m_cacheFilePath;
+			Vk::Device& m_device;
+			Vk::PipelineCache m_pipelineCache;
+			VkPhysicalDeviceProperties m_deviceProperties;
+			bool m_running;
+	};
+}
+
+#endif // NAZARA_VULKAN_PIPELINEMANAGER_HPP
@@ -0,0 +1,67 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/VkBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace Vk
+	{
+		inline Buffer::Buffer(Device& device) :
+		DeviceObject(device)
+		{
+		}
+
+		inline bool Buffer::BindBufferMemory(VkDeviceMemory memory, VkDeviceSize offset)
+		{
+			m_lastErrorCode = m_device.vkBindBufferMemory(m_device, m_handle, memory, offset);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to bind buffer memory");
+				return false;
+			}
+
+			return true;
+		}
+
+		inline bool Buffer::Create(VkBufferCreateFlags flags, VkDeviceSize size, VkBufferUsageFlags usage, const VkAllocationCallbacks* allocator)
+		{
+			VkBufferCreateInfo createInfo =
+			{
+				VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+				nullptr,
+				flags,
+				size,
+				usage,
+				VK_SHARING_MODE_EXCLUSIVE,
+				0,
+				nullptr
+			};
+
+			return Create(createInfo, allocator);
+		}
+
+		inline VkMemoryRequirements Buffer::GetMemoryRequirements() const
+		{
+			VkMemoryRequirements memoryRequirements;
+			m_device.vkGetBufferMemoryRequirements(m_device, m_handle, &memoryRequirements);
+
+			return memoryRequirements;
+		}
+
+		inline VkResult Buffer::CreateHelper(Device& device, const VkBufferCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkBuffer* handle)
+		{
+			return device.vkCreateBuffer(device, createInfo, allocator, handle);
+		}
+
+		inline void Buffer::DestroyHelper(Device& device, VkBuffer handle, const VkAllocationCallbacks* allocator)
+		{
+			return device.vkDestroyBuffer(device, handle, allocator);
+		}
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
@@ -30,8 +30,14 @@ namespace Nz
 				inline bool Begin(VkCommandBufferUsageFlags flags, VkRenderPass renderPass, UInt32 subpass, VkFramebuffer framebuffer, bool occlusionQueryEnable, VkQueryControlFlags queryFlags, VkQueryPipelineStatisticFlags pipelineStatistics);
 				inline bool Begin(VkCommandBufferUsageFlags flags, bool occlusionQueryEnable, VkQueryControlFlags queryFlags, VkQueryPipelineStatisticFlags pipelineStatistics);
 
+				inline void BeginRenderPass(const VkRenderPassBeginInfo& beginInfo, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+
 				inline bool End();
 
+				inline void EndRenderPass();
+
+				inline void ExecuteCommands(UInt32 commandBufferCount, const VkCommandBuffer* commandBuffers);
+
 				inline void Free();
 
 				inline VkResult GetLastErrorCode() const;
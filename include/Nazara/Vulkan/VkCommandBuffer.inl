@@ -117,6 +117,11 @@ namespace Nz
 			return Begin(beginInfo);
 		}
 
+		inline void CommandBuffer::BeginRenderPass(const VkRenderPassBeginInfo& beginInfo, VkSubpassContents contents)
+		{
+			m_pool->GetDevice().vkCmdBeginRenderPass(m_handle, &beginInfo, contents);
+		}
+
 		inline bool CommandBuffer::End()
 		{
 			m_lastErrorCode = m_pool->GetDevice().vkEndCommandBuffer(m_handle);
@@ -129,6 +134,18 @@ namespace Nz
 			return true;
 		}
 
+		inline void CommandBuffer::EndRenderPass()
+		{
+			m_pool->GetDevice().vkCmdEndRenderPass(m_handle);
+		}
+
+		inline void CommandBuffer::ExecuteCommands(UInt32 commandBufferCount, const VkCommandBuffer* commandBuffers)
+		{
+			NazaraAssert(commandBufferCount == 0 || commandBuffers, "Invalid command buffers");
+
+			m_pool->GetDevice().vkCmdExecuteCommands(m_handle, commandBufferCount, commandBuffers);
+		}
+
 		inline void CommandBuffer::Free()
 		{
 			if (m_handle)
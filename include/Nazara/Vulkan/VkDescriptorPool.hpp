@@ -0,0 +1,46 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_VKDESCRIPTORPOOL_HPP
+#define NAZARA_VULKAN_VKDESCRIPTORPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/VkDeviceObject.hpp>
+
+namespace Nz 
+{
+	namespace Vk
+	{
+		class DescriptorPool : public DeviceObject<DescriptorPool, VkDescriptorPool, VkDescriptorPoolCreateInfo>
+		{
+			friend DeviceObject;
+
+			public:
+				inline DescriptorPool(Device& instance);
+				DescriptorPool(const DescriptorPool&) = delete;
+				DescriptorPool(DescriptorPool&&) = default;
+				~DescriptorPool() = default;
+
+				inline bool AllocateDescriptorSet(VkDescriptorSetLayout setLayout, VkDescriptorSet* descriptorSet);
+
+				using DeviceObject::Create;
+				inline bool Create(UInt32 maxSets, UInt32 poolSizeCount, const VkDescriptorPoolSize* poolSizes, VkDescriptorPoolCreateFlags flags = 0, const VkAllocationCallbacks* allocator = nullptr);
+
+				inline bool Reset();
+
+				DescriptorPool& operator=(const DescriptorPool&) = delete;
+				DescriptorPool& operator=(DescriptorPool&&) = delete;
+
+			private:
+				static inline VkResult CreateHelper(Device& device, const VkDescriptorPoolCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkDescriptorPool* handle);
+				static inline void DestroyHelper(Device& device, VkDescriptorPool handle, const VkAllocationCallbacks* allocator);
+		};
+	}
+}
+
+#include <Nazara/Vulkan/VkDescriptorPool.inl>
+
+#endif // NAZARA_VULKAN_VKDESCRIPTORPOOL_HPP
@@ -0,0 +1,78 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/VkDescriptorPool.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace Vk
+	{
+		inline DescriptorPool::DescriptorPool(Device& device) :
+		DeviceObject(device)
+		{
+		}
+
+		inline bool DescriptorPool::AllocateDescriptorSet(VkDescriptorSetLayout setLayout, VkDescriptorSet* descriptorSet)
+		{
+			VkDescriptorSetAllocateInfo allocateInfo =
+			{
+				VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+				nullptr,
+				m_handle,
+				1U,
+				&setLayout
+			};
+
+			m_lastErrorCode = m_device.vkAllocateDescriptorSets(m_device, &allocateInfo, descriptorSet);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to allocate descriptor set");
+				return false;
+			}
+
+			return true;
+		}
+
+		inline bool DescriptorPool::Create(UInt32 maxSets, UInt32 poolSizeCount, const VkDescriptorPoolSize* poolSizes, VkDescriptorPoolCreateFlags flags, const VkAllocationCallbacks* allocator)
+		{
+			VkDescriptorPoolCreateInfo createInfo =
+			{
+				VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+				nullptr,
+				flags,
+				maxSets,
+				poolSizeCount,
+				poolSizes
+			};
+
+			return Create(createInfo, allocator);
+		}
+
+		inline bool DescriptorPool::Reset()
+		{
+			m_lastErrorCode = m_device.vkResetDescriptorPool(m_device, m_handle, 0);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to reset descriptor pool");
+				return false;
+			}
+
+			return true;
+		}
+
+		inline VkResult DescriptorPool::CreateHelper(Device& device, const VkDescriptorPoolCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkDescriptorPool* handle)
+		{
+			return device.vkCreateDescriptorPool(device, createInfo, allocator, handle);
+		}
+
+		inline void DescriptorPool::DestroyHelper(Device& device, VkDescriptorPool handle, const VkAllocationCallbacks* allocator)
+		{
+			return device.vkDestroyDescriptorPool(device, handle, allocator);
+		}
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
@@ -55,6 +55,7 @@ namespace Nz
 
 				// Vulkan core
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkAllocateCommandBuffers);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkAllocateDescriptorSets);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkAllocateMemory);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkBeginCommandBuffer);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkBindBufferMemory);
@@ -110,10 +111,12 @@ namespace Nz
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateDescriptorPool);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateDescriptorSetLayout);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateEvent);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateFence);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateFramebuffer);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateGraphicsPipelines);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateImage);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateImageView);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateRenderPass);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkCreateSampler);
@@ -126,10 +129,12 @@ namespace Nz
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyDescriptorSetLayout);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyDevice);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyEvent);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyFence);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyFramebuffer);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyImage);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyImageView);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyPipeline);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkDestroySampler);
@@ -149,6 +154,7 @@ namespace Nz
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkGetImageSparseMemoryRequirements);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkGetImageSubresourceLayout);
+				NAZARA_VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkGetRenderAreaGranularity);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkInvalidateMappedMemoryRanges);
 				NAZARA_VULKAN_DEVICE_FUNCTION(vkMapMemory);
@@ -31,6 +31,8 @@ namespace Nz
 				inline const Device& GetDevice() const;
 				inline VkResult GetLastErrorCode() const;
 
+				inline bool IsValid() const;
+
 				DeviceObject& operator=(const DeviceObject&) = delete;
 				DeviceObject& operator=(DeviceObject&&) = delete;
 
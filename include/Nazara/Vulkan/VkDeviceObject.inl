@@ -2,7 +2,7 @@
 // This file is part of the "Nazara Engine - Vulkan"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
-#include <Nazara/Vulkan/VkCommandPool.hpp>
+#include <Nazara/Vulkan/VkDeviceObject.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Vulkan/VkDevice.hpp>
 #include <Nazara/Vulkan/Debug.hpp>
@@ -57,7 +57,10 @@ namespace Nz
 		inline void DeviceObject<C, VkType, CreateInfo>::Destroy()
 		{
 			if (m_handle != VK_NULL_HANDLE)
+			{
 				C::DestroyHelper(m_device, m_handle, (m_allocator.pfnAllocation) ? &m_allocator : nullptr);
+				m_handle = VK_NULL_HANDLE;
+			}
 		}
 
 		template<typename C, typename VkType, typename CreateInfo>
@@ -78,6 +81,12 @@ namespace Nz
 			return m_lastErrorCode;
 		}
 
+		template<typename C, typename VkType, typename CreateInfo>
+		inline bool DeviceObject<C, VkType, CreateInfo>::IsValid() const
+		{
+			return m_handle != VK_NULL_HANDLE;
+		}
+
 		template<typename C, typename VkType, typename CreateInfo>
 		inline DeviceObject<C, VkType, CreateInfo>::operator VkType()
 		{
@@ -0,0 +1,49 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_VULKAN_VKFENCE_HPP
+#define NAZARA_VULKAN_VKFENCE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Vulkan/VkDeviceObject.hpp>
+#include <limits>
+
+namespace Nz 
+{
+	namespace Vk
+	{
+		class Fence : public DeviceObject<Fence, VkFence, VkFenceCreateInfo>
+		{
+			friend DeviceObject;
+
+			public:
+				inline Fence(Device& instance);
+				Fence(const Fence&) = delete;
+				Fence(Fence&&) = default;
+				~Fence() = default;
+
+				using DeviceObject::Create;
+				inline bool Create(VkFenceCreateFlags flags = 0, const VkAllocationCallbacks* allocator = nullptr);
+
+				inline bool IsSignaled();
+
+				inline bool Reset();
+
+				inline bool Wait(UInt64 timeout = std::numeric_limits<UInt64>::max());
+
+				Fence& operator=(const Fence&) = delete;
+				Fence& operator=(Fence&&) = delete;
+
+			private:
+				static inline VkResult CreateHelper(Device& device, const VkFenceCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkFence* handle);
+				static inline void DestroyHelper(Device& device, VkFence handle, const VkAllocationCallbacks* allocator);
+		};
+	}
+}
+
+#include <Nazara/Vulkan/VkFence.inl>
+
+#endif // NAZARA_VULKAN_VKFENCE_HPP
@@ -0,0 +1,74 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/VkFence.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace Vk
+	{
+		inline Fence::Fence(Device& device) :
+		DeviceObject(device)
+		{
+		}
+
+		inline bool Fence::Create(VkFenceCreateFlags flags, const VkAllocationCallbacks* allocator)
+		{
+			VkFenceCreateInfo createInfo =
+			{
+				VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+				nullptr,
+				flags
+			};
+
+			return Create(createInfo, allocator);
+		}
+
+		inline bool Fence::IsSignaled()
+		{
+			m_lastErrorCode = m_device.vkGetFenceStatus(m_device, m_handle);
+			return m_lastErrorCode == VkResult::VK_SUCCESS;
+		}
+
+		inline bool Fence::Reset()
+		{
+			m_lastErrorCode = m_device.vkResetFences(m_device, 1U, &m_handle);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to reset fence");
+				return false;
+			}
+
+			return true;
+		}
+
+		inline bool Fence::Wait(UInt64 timeout)
+		{
+			m_lastErrorCode = m_device.vkWaitForFences(m_device, 1U, &m_handle, VK_TRUE, timeout);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				if (m_lastErrorCode != VkResult::VK_TIMEOUT)
+					NazaraError("Failed to wait for fence");
+
+				return false;
+			}
+
+			return true;
+		}
+
+		inline VkResult Fence::CreateHelper(Device& device, const VkFenceCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkFence* handle)
+		{
+			return device.vkCreateFence(device, createInfo, allocator, handle);
+		}
+
+		inline void Fence::DestroyHelper(Device& device, VkFence handle, const VkAllocationCallbacks* allocator)
+		{
+			return device.vkDestroyFence(device, handle, allocator);
+		}
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
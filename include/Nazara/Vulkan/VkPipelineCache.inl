@@ -0,0 +1,68 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/VkPipelineCache.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace Vk
+	{
+		inline PipelineCache::PipelineCache(Device& device) :
+		DeviceObject(device)
+		{
+		}
+
+		inline bool PipelineCache::Create(std::size_t initialDataSize, const void* initialData, const VkAllocationCallbacks* allocator)
+		{
+			VkPipelineCacheCreateInfo createInfo =
+			{
+				VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+				nullptr,
+				0,
+				initialDataSize,
+				initialData
+			};
+
+			return Create(createInfo, allocator);
+		}
+
+		inline bool PipelineCache::GetData(std::vector<UInt8>* data)
+		{
+			NazaraAssert(data, "Invalid data vector");
+
+			std::size_t dataSize = 0;
+			m_lastErrorCode = m_device.vkGetPipelineCacheData(m_device, m_handle, &dataSize, nullptr);
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to query pipeline cache data size");
+				return false;
+			}
+
+			data->resize(dataSize);
+			m_lastErrorCode = m_device.vkGetPipelineCacheData(m_device, m_handle, &dataSize, data->data());
+			if (m_lastErrorCode != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to query pipeline cache data");
+				return false;
+			}
+
+			data->resize(dataSize);
+			return true;
+		}
+
+		inline VkResult PipelineCache::CreateHelper(Device& device, const VkPipelineCacheCreateInfo* createInfo, const VkAllocationCallbacks* allocator, VkPipelineCache* handle)
+		{
+			return device.vkCreatePipelineCache(device, createInfo, allocator, handle);
+		}
+
+		inline void PipelineCache::DestroyHelper(Device& device, VkPipelineCache handle, const VkAllocationCallbacks* allocator)
+		{
+			return device.vkDestroyPipelineCache(device, handle, allocator);
+		}
+	}
+}
+
+#include <Nazara/Vulkan/DebugOff.hpp>
@@ -2,7 +2,7 @@
 // This file is part of the "Nazara Engine - Vulkan"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
-#include <Nazara/Vulkan/VkCommandPool.hpp>
+#include <Nazara/Vulkan/VkQueue.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Vulkan/VkDevice.hpp>
 #include <Nazara/Vulkan/Debug.hpp>
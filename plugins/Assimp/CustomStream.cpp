@@ -68,13 +68,15 @@ aiFile* StreamOpener(aiFileIO* fileIO, const char* filePath, const char* openMod
 {
     FileIOUserdata* fileIOUserdata = reinterpret_cast<FileIOUserdata*>(fileIO->UserData);
 
-	bool isOriginalStream = (std::strcmp(filePath, fileIOUserdata->originalFilePath) == 0);
+	bool isOriginalStream = (fileIOUserdata->originalStream && std::strcmp(filePath, fileIOUserdata->originalFilePath) == 0);
 	if (!isOriginalStream && strstr(filePath, StreamPath) != 0)
 		return nullptr;
 
-	aiUserData stream;
+	std::unique_ptr<StreamFile> file = std::make_unique<StreamFile>();
+
+	Stream* stream;
 	if (isOriginalStream)
-		stream = reinterpret_cast<aiUserData>(fileIOUserdata->originalStream);
+		stream = fileIOUserdata->originalStream;
 	else
 	{
 		ErrorFlags errFlags(ErrorFlag_ThrowExceptionDisabled, true);
@@ -109,32 +111,41 @@ aiFile* StreamOpener(aiFileIO* fileIO, const char* filePath, const char* openMod
 		if (!std::strchr(openMode, 'b'))
 			openModeEnum |= OpenMode_Text;
 
-		std::unique_ptr<File> file = std::make_unique<File>();
-		if (!file->Open(filePath, openModeEnum))
+		file->file = std::make_unique<File>();
+		if (!file->file->Open(filePath, openModeEnum))
 			return nullptr;
 
-		stream = reinterpret_cast<char*>(file.release());
+		stream = file->file.get();
+
+		// Files read by Assimp are mapped, reads are then copies from the mapping instead of system calls
+		if (openModeEnum == (OpenMode_ReadOnly | OpenMode_Text) || openModeEnum == OpenMode_ReadOnly)
+		{
+			ErrorFlags flags(ErrorFlag_Silent, true);
+
+			const void* data = file->file->Map();
+			if (data)
+			{
+				file->mapping = std::make_unique<MemoryView>(data, file->file->GetSize());
+				stream = file->mapping.get();
+			}
+		}
 	}
 
-	std::unique_ptr<aiFile> file = std::make_unique<aiFile>();
 	file->FileSizeProc = StreamSize;
 	file->FlushProc = StreamFlush;
 	file->ReadProc = StreamRead;
 	file->SeekProc = StreamSeek;
 	file->TellProc = StreamTell;
 	file->WriteProc = StreamWrite;
-	file->UserData = stream;
+	file->UserData = reinterpret_cast<aiUserData>(stream);
 
 	return file.release();
 }
 
 void StreamCloser(aiFileIO* fileIO, aiFile* file)
 {
-    FileIOUserdata* fileIOUserdata = reinterpret_cast<FileIOUserdata*>(fileIO->UserData);
-    Stream* fileUserdata = reinterpret_cast<Stream*>(file->UserData);
-    
-    if (fileUserdata != fileIOUserdata->originalStream)
-		delete reinterpret_cast<File*>(file->UserData);
+	NazaraUnused(fileIO);
 
-	delete file;
+	// The mapping is released before the file, the original stream is not owned
+	delete static_cast<StreamFile*>(file);
 }
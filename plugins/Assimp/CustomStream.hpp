@@ -7,8 +7,11 @@
 #ifndef NAZARA_ASSIMP_CUSTOM_STREAM_HPP
 #define NAZARA_ASSIMP_CUSTOM_STREAM_HPP
 
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <assimp/cfileio.h>
+#include <memory>
 
 constexpr const char StreamPath[] = "<Nazara:Stream>";
 
@@ -21,10 +24,17 @@ size_t StreamWrite(aiFile* file, const char* buffer, size_t size, size_t count);
 
 struct FileIOUserdata
 {
-    Nz::Stream* originalStream;
+    Nz::Stream* originalStream; //< Null if the original file has to be opened like the others
     const char* originalFilePath;
 };
 
+// UserData points to the stream to use, which is either the original stream, the file or its mapping
+struct StreamFile : aiFile
+{
+	std::unique_ptr<Nz::File> file;
+	std::unique_ptr<Nz::MemoryView> mapping;
+};
+
 aiFile* StreamOpener(aiFileIO* fileIO, const char* filePath, const char* openMode);
 void StreamCloser(aiFileIO* fileIO, aiFile* file);
 
@@ -23,12 +23,19 @@ SOFTWARE.
 */
 
 #include <CustomStream.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/CallOnExit.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
 #include <assimp/cfileio.h>
 #include <assimp/cimport.h>
 #include <assimp/config.h>
@@ -36,9 +43,26 @@ SOFTWARE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 using namespace Nz;
 
+struct ImportSettings
+{
+	unsigned int postProcess;
+	float smoothingAngle;
+	int triangleLimit;
+	int vertexLimit;
+};
+
+struct SubMeshBuffers
+{
+	IndexBufferRef indexBuffer;
+	VertexBufferRef vertexBuffer;
+	Boxf aabb;
+};
+
 void ProcessJoints(aiNode* node, Skeleton* skeleton, const std::set<Nz::String>& joints)
 {
 	Nz::String jointName(node->mName.data, node->mName.length);
@@ -65,6 +89,200 @@ void ProcessJoints(aiNode* node, Skeleton* skeleton, const std::set<Nz::String>&
 		ProcessJoints(node->mChildren[i], skeleton, joints);
 }
 
+ParameterList ConvertMaterial(const aiMaterial* aiMat, const String& directory)
+{
+	ParameterList matData;
+
+	auto ConvertColor = [&] (const char* aiKey, unsigned int aiType, unsigned int aiIndex, const char* colorKey)
+	{
+		aiColor4D color;
+		if (aiGetMaterialColor(aiMat, aiKey, aiType, aiIndex, &color) == aiReturn_SUCCESS)
+		{
+			matData.SetParameter(MaterialData::CustomDefined);
+
+			matData.SetParameter(colorKey, Color(static_cast<UInt8>(color.r * 255), static_cast<UInt8>(color.g * 255), static_cast<UInt8>(color.b * 255), static_cast<UInt8>(color.a * 255)));
+		}
+	};
+
+	auto ConvertTexture = [&] (aiTextureType aiType, const char* textureKey, const char* wrapKey = nullptr)
+	{
+		aiString path;
+		aiTextureMapMode mapMode[3];
+		if (aiGetMaterialTexture(aiMat, aiType, 0, &path, nullptr, nullptr, nullptr, nullptr, &mapMode[0], nullptr) == aiReturn_SUCCESS)
+		{
+			matData.SetParameter(MaterialData::CustomDefined);
+			matData.SetParameter(textureKey, directory + String(path.data, path.length));
+
+			if (wrapKey)
+			{
+				SamplerWrap wrap = SamplerWrap_Default;
+				switch (mapMode[0])
+				{
+					case aiTextureMapMode_Clamp:
+					case aiTextureMapMode_Decal:
+						wrap = SamplerWrap_Clamp;
+						break;
+
+					case aiTextureMapMode_Mirror:
+						wrap = SamplerWrap_MirroredRepeat;
+						break;
+
+					case aiTextureMapMode_Wrap:
+						wrap = SamplerWrap_Repeat;
+						break;
+
+					default:
+						NazaraWarning("Assimp texture map mode 0x" + String::Number(mapMode[0], 16) + " not handled");
+						break;
+				}
+
+				matData.SetParameter(wrapKey, static_cast<int>(wrap));
+			}
+		}
+	};
+
+	ConvertColor(AI_MATKEY_COLOR_AMBIENT, MaterialData::AmbientColor);
+	ConvertColor(AI_MATKEY_COLOR_DIFFUSE, MaterialData::DiffuseColor);
+	ConvertColor(AI_MATKEY_COLOR_SPECULAR, MaterialData::SpecularColor);
+
+	ConvertTexture(aiTextureType_DIFFUSE, MaterialData::DiffuseTexturePath, MaterialData::DiffuseWrap);
+	ConvertTexture(aiTextureType_EMISSIVE, MaterialData::EmissiveTexturePath);
+	ConvertTexture(aiTextureType_HEIGHT, MaterialData::HeightTexturePath);
+	ConvertTexture(aiTextureType_NORMALS, MaterialData::NormalTexturePath);
+	ConvertTexture(aiTextureType_OPACITY, MaterialData::AlphaTexturePath);
+	ConvertTexture(aiTextureType_SPECULAR, MaterialData::SpecularTexturePath, MaterialData::SpecularWrap);
+
+	aiString name;
+	if (aiGetMaterialString(aiMat, AI_MATKEY_NAME, &name) == aiReturn_SUCCESS)
+		matData.SetParameter(MaterialData::Name, String(name.data, name.length));
+
+	int iValue;
+	if (aiGetMaterialInteger(aiMat, AI_MATKEY_TWOSIDED, &iValue) == aiReturn_SUCCESS)
+		matData.SetParameter(MaterialData::FaceCulling, !iValue);
+
+	return matData;
+}
+
+SubMeshBuffers ConvertSubMesh(const aiMesh* iMesh, const Matrix4f& matrix, const MeshParams& parameters)
+{
+	unsigned int indexCount = iMesh->mNumFaces * 3;
+	unsigned int vertexCount = iMesh->mNumVertices;
+
+	// Buffers are filled in software storage, which any thread can map, the caller moves them to the requested storage
+	SubMeshBuffers buffers;
+
+	// Index buffer
+	bool largeIndices = (vertexCount > std::numeric_limits<UInt16>::max());
+
+	buffers.indexBuffer = IndexBuffer::New(largeIndices, indexCount, DataStorage_Software);
+
+	IndexMapper indexMapper(buffers.indexBuffer, BufferAccess_DiscardAndWrite);
+	IndexIterator index = indexMapper.begin();
+
+	for (unsigned int j = 0; j < iMesh->mNumFaces; ++j)
+	{
+		aiFace& face = iMesh->mFaces[j];
+		if (face.mNumIndices != 3)
+			NazaraWarning("Assimp plugin: This face is not a triangle!");
+
+		*index++ = face.mIndices[0];
+		*index++ = face.mIndices[1];
+		*index++ = face.mIndices[2];
+	}
+	indexMapper.Unmap();
+
+	// Vertex buffer
+	buffers.vertexBuffer = VertexBuffer::New(VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent), vertexCount, DataStorage_Software);
+
+	{
+		VertexMapper vertexMapper(buffers.vertexBuffer, BufferAccess_WriteOnly);
+
+		SparsePtr<Vector3f> normalPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Normal);
+		SparsePtr<Vector3f> positionPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Position);
+		SparsePtr<Vector3f> tangentPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Tangent);
+		SparsePtr<Vector2f> uvPtr = vertexMapper.GetComponentPtr<Vector2f>(VertexComponent_TexCoord);
+
+		bool hasTangents = iMesh->HasTangentsAndBitangents();
+		bool hasUVs = iMesh->HasTextureCoords(0);
+
+		for (unsigned int j = 0; j < vertexCount; ++j)
+		{
+			aiVector3D position = iMesh->mVertices[j];
+			aiVector3D normal = iMesh->mNormals[j];
+			aiVector3D tangent = (hasTangents) ? iMesh->mTangents[j] : aiVector3D(0.f, 1.f, 0.f);
+			aiVector3D uv = (hasUVs) ? iMesh->mTextureCoords[0][j] : aiVector3D(0.f);
+
+			*positionPtr++ = matrix * Vector3f(position.x, position.y, position.z);
+			*normalPtr++ = Vector3f(normal.x, normal.y, normal.z);
+			*tangentPtr++ = Vector3f(tangent.x, tangent.y, tangent.z);
+			*uvPtr++ = Vector2f(uv.x, uv.y);
+		}
+	}
+
+	OptimizeMeshBuffers(buffers.indexBuffer, buffers.vertexBuffer, parameters);
+
+	// The optimization may have removed or snapped vertices, the box is computed from what is left
+	VertexMapper vertexMapper(buffers.vertexBuffer, BufferAccess_ReadOnly);
+	buffers.aabb = ComputeAABB(vertexMapper.GetComponentPtr<const Vector3f>(VertexComponent_Position), buffers.vertexBuffer->GetVertexCount());
+
+	return buffers;
+}
+
+String GetCacheFilePath(const String& cacheDirectory, const String& filePath, const ImportSettings& settings, const MeshParams& parameters)
+{
+	// The cache only holds the imported data, the transformation and the centering are applied after loading it
+	std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_SHA1);
+	hash->Begin();
+
+	String absolutePath = File::AbsolutePath(filePath);
+	hash->Append(reinterpret_cast<const UInt8*>(absolutePath.GetConstBuffer()), absolutePath.GetSize());
+
+	UInt8 flags[] = {
+		static_cast<UInt8>(parameters.animated),
+		static_cast<UInt8>(parameters.optimizeIndexBuffers),
+		static_cast<UInt8>(parameters.optimizeOverdraw),
+		static_cast<UInt8>(parameters.optimizeVertexFetch),
+		static_cast<UInt8>(parameters.quantizeVertices)
+	};
+
+	hash->Append(flags, sizeof(flags));
+	hash->Append(reinterpret_cast<const UInt8*>(&settings), sizeof(ImportSettings));
+
+	return File::NormalizePath(cacheDirectory + NAZARA_DIRECTORY_SEPARATOR + hash->End().ToHex() + ".nmf");
+}
+
+ImportSettings GetImportSettings(const MeshParams& parameters)
+{
+	ImportSettings settings;
+	settings.postProcess = aiProcess_CalcTangentSpace     | aiProcess_JoinIdenticalVertices
+	                     | aiProcess_MakeLeftHanded       | aiProcess_Triangulate
+	                     | aiProcess_RemoveComponent      | aiProcess_GenSmoothNormals
+	                     | aiProcess_SplitLargeMeshes     | aiProcess_LimitBoneWeights 
+	                     | aiProcess_ImproveCacheLocality | aiProcess_RemoveRedundantMaterials 
+	                     | aiProcess_FixInfacingNormals   | aiProcess_SortByPType 
+	                     | aiProcess_FindInvalidData      | aiProcess_GenUVCoords 
+	                     | aiProcess_TransformUVCoords    | aiProcess_OptimizeMeshes 
+	                     | aiProcess_OptimizeGraph        | aiProcess_FlipWindingOrder 
+	                     | aiProcess_Debone;
+
+	if (parameters.flipUVs)
+		settings.postProcess |= aiProcess_FlipUVs;
+
+	if (parameters.optimizeIndexBuffers)
+		settings.postProcess |= aiProcess_ImproveCacheLocality;
+
+	settings.smoothingAngle = 80.f;
+	parameters.custom.GetFloatParameter("AssimpLoader_SmoothingAngle", &settings.smoothingAngle);
+
+	settings.triangleLimit = 1'000'000;
+	parameters.custom.GetIntegerParameter("AssimpLoader_TriangleLimit", &settings.triangleLimit);
+
+	settings.vertexLimit = 1'000'000;
+	parameters.custom.GetIntegerParameter("AssimpLoader_VertexLimit", &settings.vertexLimit);
+
+	return settings;
+}
+
 bool IsSupported(const String& extension)
 {
 	String dotExt = '.' + extension;
@@ -80,56 +298,39 @@ Ternary Check(Stream& stream, const MeshParams& parameters)
 	return Ternary_Unknown;
 }
 
-bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
+bool Import(Mesh* mesh, Stream* stream, const char* filePath, const String& directory, const String& cacheFilePath, const ImportSettings& settings, const MeshParams& parameters)
 {
-	Nz::String streamPath = stream.GetPath();
-
 	FileIOUserdata userdata;
-	userdata.originalFilePath = (!streamPath.IsEmpty()) ? streamPath.GetConstBuffer() : StreamPath;
-	userdata.originalStream = &stream;
+	userdata.originalFilePath = filePath;
+	userdata.originalStream = stream;
 
 	aiFileIO fileIO;
 	fileIO.CloseProc = StreamCloser;
 	fileIO.OpenProc = StreamOpener;
 	fileIO.UserData = reinterpret_cast<char*>(&userdata);
 
-	unsigned int postProcess = aiProcess_CalcTangentSpace     | aiProcess_JoinIdenticalVertices
-	                         | aiProcess_MakeLeftHanded       | aiProcess_Triangulate
-	                         | aiProcess_RemoveComponent      | aiProcess_GenSmoothNormals
-	                         | aiProcess_SplitLargeMeshes     | aiProcess_LimitBoneWeights 
-	                         | aiProcess_ImproveCacheLocality | aiProcess_RemoveRedundantMaterials 
-	                         | aiProcess_FixInfacingNormals   | aiProcess_SortByPType 
-	                         | aiProcess_FindInvalidData      | aiProcess_GenUVCoords 
-	                         | aiProcess_TransformUVCoords    | aiProcess_OptimizeMeshes 
-	                         | aiProcess_OptimizeGraph        | aiProcess_FlipWindingOrder 
-	                         | aiProcess_Debone;
-
-	if (parameters.flipUVs)
-		postProcess |= aiProcess_FlipUVs;
-
-	if (parameters.optimizeIndexBuffers)
-		postProcess |= aiProcess_ImproveCacheLocality;
-
-	float smoothingAngle = 80.f;
-	parameters.custom.GetFloatParameter("AssimpLoader_SmoothingAngle", &smoothingAngle);
-
-	int triangleLimit = 1'000'000;
-	parameters.custom.GetIntegerParameter("AssimpLoader_TriangleLimit", &triangleLimit);
-
-	int vertexLimit   = 1'000'000;
-	parameters.custom.GetIntegerParameter("AssimpLoader_VertexLimit", &vertexLimit);
-
 	aiPropertyStore* properties = aiCreatePropertyStore();
-	aiSetImportPropertyFloat(properties,   AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, smoothingAngle);
+	aiSetImportPropertyFloat(properties,   AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, settings.smoothingAngle);
 	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_LBW_MAX_WEIGHTS,         4);
 	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SBP_REMOVE,              ~aiPrimitiveType_TRIANGLE); //< We only want triangles
-	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,      triangleLimit);
-	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_VERTEX_LIMIT,        vertexLimit);
+	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,      settings.triangleLimit);
+	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_SLM_VERTEX_LIMIT,        settings.vertexLimit);
 	aiSetImportPropertyInteger(properties, AI_CONFIG_PP_RVC_FLAGS,               aiComponent_COLORS);
 
-	const aiScene* scene = aiImportFileExWithProperties(userdata.originalFilePath, postProcess, &fileIO, properties);
+	const aiScene* scene = aiImportFileExWithProperties(filePath, settings.postProcess, &fileIO, properties);
 	aiReleasePropertyStore(properties);
 
+	if (!scene)
+	{
+		NazaraError("Assimp failed to import file: " + String(aiGetErrorString()));
+		return false;
+	}
+
+	CallOnExit releaseScene([scene]()
+	{
+		aiReleaseImport(scene);
+	});
+
 	std::set<Nz::String> joints;
 
 	bool animatedMesh = false;
@@ -165,172 +366,129 @@ bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
 	else
 	{
 		mesh->CreateStatic();
-	
-		// aiMaterial index in scene => Material index and data in Mesh
-		std::unordered_map<unsigned int, std::pair<unsigned int, ParameterList>> materials;
+
+		// Static meshes, and the Nazara index of the materials they use (in order of first use)
+		std::vector<unsigned int> staticMeshes;
+		std::vector<unsigned int> usedMaterials;
+		std::unordered_map<unsigned int, unsigned int> materialIndices;
 
 		for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
 		{
 			aiMesh* iMesh = scene->mMeshes[i];
-			if (!iMesh->HasBones()) // Don't process skeletal meshs
-			{
-				unsigned int indexCount = iMesh->mNumFaces * 3;
-				unsigned int vertexCount = iMesh->mNumVertices;
+			if (iMesh->HasBones()) // Don't process skeletal meshs
+				continue;
 
-				// Index buffer
-				bool largeIndices = (vertexCount > std::numeric_limits<UInt16>::max());
+			staticMeshes.push_back(i);
 
-				IndexBufferRef indexBuffer = IndexBuffer::New(largeIndices, indexCount, parameters.storage);
+			if (materialIndices.emplace(iMesh->mMaterialIndex, static_cast<unsigned int>(usedMaterials.size())).second)
+				usedMaterials.push_back(iMesh->mMaterialIndex);
+		}
 
-				IndexMapper indexMapper(indexBuffer, BufferAccess_DiscardAndWrite);
-				IndexIterator index = indexMapper.begin();
+		// Written data is not transformed, the cache loading applies the transformation just like below
+		const Matrix4f& matrix = (cacheFilePath.IsEmpty()) ? parameters.matrix : Matrix4f::Identity();
 
-				for (unsigned int j = 0; j < iMesh->mNumFaces; ++j)
-				{
-					aiFace& face = iMesh->mFaces[j];
-					if (face.mNumIndices != 3)
-						NazaraWarning("Assimp plugin: This face is not a triangle!");
+		// Materials and submeshes do not depend on each other, they are converted by the TaskScheduler workers
+		std::vector<ParameterList> materials(usedMaterials.size());
+		TaskScheduler::ParallelFor(0, usedMaterials.size(), 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				materials[i] = ConvertMaterial(scene->mMaterials[usedMaterials[i]], directory);
+		});
 
-					*index++ = face.mIndices[0];
-					*index++ = face.mIndices[1];
-					*index++ = face.mIndices[2];
-				}
-				indexMapper.Unmap();
+		std::vector<SubMeshBuffers> subMeshBuffers(staticMeshes.size());
+		TaskScheduler::ParallelFor(0, staticMeshes.size(), 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				subMeshBuffers[i] = ConvertSubMesh(scene->mMeshes[staticMeshes[i]], matrix, parameters);
+		});
 
-				// Vertex buffer
-				VertexBufferRef vertexBuffer = VertexBuffer::New(VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent), vertexCount, parameters.storage);
-				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_WriteOnly);
+		for (std::size_t i = 0; i < staticMeshes.size(); ++i)
+		{
+			SubMeshBuffers& buffers = subMeshBuffers[i];
 
-				MeshVertex* vertex = static_cast<MeshVertex*>(vertexMapper.GetPointer());
-				for (unsigned int j = 0; j < vertexCount; ++j)
+			// Hardware buffers are created by the loading thread
+			if (parameters.storage != DataStorage_Software)
+			{
+				if (!buffers.indexBuffer->SetStorage(parameters.storage) || !buffers.vertexBuffer->SetStorage(parameters.storage))
 				{
-					aiVector3D position = iMesh->mVertices[j];
-					aiVector3D normal = iMesh->mNormals[j];
-					aiVector3D tangent = (iMesh->HasTangentsAndBitangents()) ? iMesh->mTangents[j] : aiVector3D(0.f, 1.f, 0.f);
-					aiVector3D uv = (iMesh->HasTextureCoords(0)) ? iMesh->mTextureCoords[0][j] : aiVector3D(0.f);
-
-					vertex->position = parameters.matrix * Vector3f(position.x, position.y, position.z);
-					vertex->normal.Set(normal.x, normal.y, normal.z);
-					vertex->tangent.Set(tangent.x, tangent.y, tangent.z);
-					vertex->uv.Set(uv.x, uv.y);
-					vertex++;
+					NazaraError("Failed to set buffers storage");
+					return false;
 				}
+			}
 
-				vertexMapper.Unmap();
-
-				// Submesh
-				StaticMeshRef subMesh = StaticMesh::New(mesh);
-				subMesh->Create(vertexBuffer);
+			// Submesh
+			StaticMeshRef subMesh = StaticMesh::New(mesh);
+			subMesh->Create(buffers.vertexBuffer);
 
-				subMesh->SetIndexBuffer(indexBuffer);
-				subMesh->GenerateAABB();
-				subMesh->SetMaterialIndex(iMesh->mMaterialIndex);
+			subMesh->SetIndexBuffer(buffers.indexBuffer);
+			subMesh->SetAABB(buffers.aabb);
+			subMesh->SetMaterialIndex(materialIndices[scene->mMeshes[staticMeshes[i]]->mMaterialIndex]);
 
-				auto matIt = materials.find(iMesh->mMaterialIndex);
-				if (matIt == materials.end())
-				{
-					ParameterList matData;
-					aiMaterial* aiMat = scene->mMaterials[iMesh->mMaterialIndex];
-
-					auto ConvertColor = [&] (const char* aiKey, unsigned int aiType, unsigned int aiIndex, const char* colorKey)
-					{
-						aiColor4D color;
-						if (aiGetMaterialColor(aiMat, aiKey, aiType, aiIndex, &color) == aiReturn_SUCCESS)
-						{
-							matData.SetParameter(MaterialData::CustomDefined);
-
-							matData.SetParameter(colorKey, Color(static_cast<UInt8>(color.r * 255), static_cast<UInt8>(color.g * 255), static_cast<UInt8>(color.b * 255), static_cast<UInt8>(color.a * 255)));
-						}
-					};
-
-					auto ConvertTexture = [&] (aiTextureType aiType, const char* textureKey, const char* wrapKey = nullptr)
-					{
-						aiString path;
-						aiTextureMapMode mapMode[3];
-						if (aiGetMaterialTexture(aiMat, aiType, 0, &path, nullptr, nullptr, nullptr, nullptr, &mapMode[0], nullptr) == aiReturn_SUCCESS)
-						{
-							matData.SetParameter(MaterialData::CustomDefined);
-							matData.SetParameter(textureKey, stream.GetDirectory() + String(path.data, path.length));
-
-							if (wrapKey)
-							{
-								SamplerWrap wrap = SamplerWrap_Default;
-								switch (mapMode[0])
-								{
-									case aiTextureMapMode_Clamp:
-									case aiTextureMapMode_Decal:
-										wrap = SamplerWrap_Clamp;
-										break;
-
-									case aiTextureMapMode_Mirror:
-										wrap = SamplerWrap_MirroredRepeat;
-										break;
-
-									case aiTextureMapMode_Wrap:
-										wrap = SamplerWrap_Repeat;
-										break;
-
-									default:
-										NazaraWarning("Assimp texture map mode 0x" + String::Number(mapMode[0], 16) + " not handled");
-										break;
-								}
-
-								matData.SetParameter(wrapKey, static_cast<int>(wrap));
-							}
-						}
-					};
-
-					ConvertColor(AI_MATKEY_COLOR_AMBIENT, MaterialData::AmbientColor);
-					ConvertColor(AI_MATKEY_COLOR_DIFFUSE, MaterialData::DiffuseColor);
-					ConvertColor(AI_MATKEY_COLOR_SPECULAR, MaterialData::SpecularColor);
-
-					ConvertTexture(aiTextureType_DIFFUSE, MaterialData::DiffuseTexturePath, MaterialData::DiffuseWrap);
-					ConvertTexture(aiTextureType_EMISSIVE, MaterialData::EmissiveTexturePath);
-					ConvertTexture(aiTextureType_HEIGHT, MaterialData::HeightTexturePath);
-					ConvertTexture(aiTextureType_NORMALS, MaterialData::NormalTexturePath);
-					ConvertTexture(aiTextureType_OPACITY, MaterialData::AlphaTexturePath);
-					ConvertTexture(aiTextureType_SPECULAR, MaterialData::SpecularTexturePath, MaterialData::SpecularWrap);
-
-					aiString name;
-					if (aiGetMaterialString(aiMat, AI_MATKEY_NAME, &name) == aiReturn_SUCCESS)
-						matData.SetParameter(MaterialData::Name, String(name.data, name.length));
-
-					int iValue;
-					if (aiGetMaterialInteger(aiMat, AI_MATKEY_TWOSIDED, &iValue) == aiReturn_SUCCESS)
-						matData.SetParameter(MaterialData::FaceCulling, !iValue);
-
-					matIt = materials.insert(std::make_pair(iMesh->mMaterialIndex, std::make_pair(materials.size(), std::move(matData)))).first;
-				}
+			mesh->AddSubMesh(subMesh);
+		}
 
-				subMesh->SetMaterialIndex(matIt->first);
+		mesh->SetMaterialCount(std::max<unsigned int>(static_cast<unsigned int>(materials.size()), 1));
+		for (std::size_t i = 0; i < materials.size(); ++i)
+			mesh->SetMaterialData(static_cast<unsigned int>(i), materials[i]);
 
-				mesh->AddSubMesh(subMesh);
-			}
+		if (!cacheFilePath.IsEmpty())
+		{
+			if (!mesh->SaveToFile(cacheFilePath, parameters))
+				NazaraWarning("Failed to write mesh cache " + cacheFilePath);
 
-			mesh->SetMaterialCount(std::max<unsigned int>(materials.size(), 1));
-			for (const auto& pair : materials)
-				mesh->SetMaterialData(pair.second.first, pair.second.second);
+			if (!parameters.matrix.IsIdentity())
+				mesh->Transform(parameters.matrix);
 		}
 
 		if (parameters.center)
 			mesh->Recenter();
 	}
 
-	aiReleaseImport(scene);
-
 	return true;
 }
 
+bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
+{
+	Nz::String streamPath = stream.GetPath();
+	const char* filePath = (!streamPath.IsEmpty()) ? streamPath.GetConstBuffer() : StreamPath;
+
+	return Import(mesh, &stream, filePath, stream.GetDirectory(), String(), GetImportSettings(parameters), parameters);
+}
+
+bool LoadFile(Mesh* mesh, const String& filePath, const MeshParams& parameters)
+{
+	ImportSettings settings = GetImportSettings(parameters);
+
+	// An imported mesh can be cached as a binary mesh (.nmf), which is loaded instead of importing the file again until it changes
+	String cacheFilePath;
+	String cacheDirectory;
+	if (parameters.custom.GetStringParameter("AssimpLoader_CacheDirectory", &cacheDirectory))
+	{
+		cacheFilePath = GetCacheFilePath(cacheDirectory, filePath, settings, parameters);
+
+		if (File::Exists(cacheFilePath) && File::GetLastWriteTime(cacheFilePath) >= File::GetLastWriteTime(filePath))
+		{
+			if (MeshLoader::LoadFromFile(mesh, cacheFilePath, parameters))
+				return true;
+
+			NazaraWarning("Failed to load mesh cache " + cacheFilePath + ", importing " + filePath + " again");
+		}
+	}
+
+	// The file is opened by the IO system of the plugin, which maps it
+	return Import(mesh, nullptr, filePath.GetConstBuffer(), File::GetDirectory(filePath), cacheFilePath, settings, parameters);
+}
+
 extern "C"
 {
 	NAZARA_EXPORT int PluginLoad()
 	{
-		Nz::MeshLoader::RegisterLoader(IsSupported, Check, Load);
+		Nz::MeshLoader::RegisterLoader(IsSupported, Check, Load, LoadFile);
 		return 1;
 	}
 
 	NAZARA_EXPORT void PluginUnload()
 	{
-		Nz::MeshLoader::UnregisterLoader(IsSupported, Check, Load);
+		Nz::MeshLoader::UnregisterLoader(IsSupported, Check, Load, LoadFile);
 	}
 }
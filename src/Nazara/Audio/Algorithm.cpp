@@ -0,0 +1,760 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_ALGORITHMAUDIO_X86
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_AVX2_FUNCTION
+		#define NAZARA_SSE2_FUNCTION
+	#else
+		#define NAZARA_AVX2_FUNCTION __attribute__((target("avx2")))
+		#define NAZARA_SSE2_FUNCTION __attribute__((target("sse2")))
+	#endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define NAZARA_ALGORITHMAUDIO_NEON
+	#include <arm_neon.h>
+#endif
+
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		/*********************************Kernels*********************************/
+		// Samples are converted, mixed and interleaved over whole files when loading, the kernels are dispatched
+		// at runtime to SIMD implementations and the generic ones handle the remaining samples
+
+		// Int16 <-> float conversions use the same scale, so converting back and forth is lossless
+		constexpr float Int16Scale = 32768.f;
+
+		void ConvertToFloatGeneric(const Int16* input, float* output, std::size_t sampleCount)
+		{
+			for (std::size_t i = 0; i < sampleCount; ++i)
+				output[i] = input[i] / Int16Scale;
+		}
+
+		void ConvertToInt16Generic(const float* input, Int16* output, std::size_t sampleCount)
+		{
+			for (std::size_t i = 0; i < sampleCount; ++i)
+			{
+				float sample = std::min(std::max(input[i] * Int16Scale, -32768.f), 32767.f);
+				output[i] = static_cast<Int16>(std::lrint(sample));
+			}
+		}
+
+		// The filter kernels blend two consecutive phases of the filter bank before applying it
+		float FilterSampleGeneric(const float* input, const float* filter, unsigned int tapCount, float factor)
+		{
+			const float* nextFilter = filter + tapCount;
+
+			float sample = 0.f;
+			for (unsigned int i = 0; i < tapCount; ++i)
+				sample += input[i] * (filter[i] + (nextFilter[i] - filter[i]) * factor);
+
+			return sample;
+		}
+
+		template<typename T>
+		void InterleaveStereoGeneric(const T* left, const T* right, T* output, unsigned int frameCount)
+		{
+			for (unsigned int i = 0; i < frameCount; ++i)
+			{
+				output[2*i] = left[i];
+				output[2*i + 1] = right[i];
+			}
+		}
+
+		template<typename T>
+		void MixStereoToMonoGeneric(const T* input, T* output, unsigned int frameCount)
+		{
+			MixToMono<T>(const_cast<T*>(input), output, 2, frameCount);
+		}
+
+		#ifdef NAZARA_ALGORITHMAUDIO_X86
+		NAZARA_AVX2_FUNCTION void ConvertToFloatAVX2(const Int16* input, float* output, std::size_t sampleCount)
+		{
+			__m256 scale = _mm256_set1_ps(1.f / Int16Scale);
+
+			std::size_t i = 0;
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				__m256i samples = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i])));
+				_mm256_storeu_ps(&output[i], _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+			}
+
+			ConvertToFloatGeneric(&input[i], &output[i], sampleCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void ConvertToFloatSSE2(const Int16* input, float* output, std::size_t sampleCount)
+		{
+			__m128 scale = _mm_set1_ps(1.f / Int16Scale);
+
+			std::size_t i = 0;
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				__m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+
+				// Sign extension: each sample is moved to the high half of a 32 bits integer, then shifted back
+				__m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+				__m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+
+				_mm_storeu_ps(&output[i], _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+				_mm_storeu_ps(&output[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+			}
+
+			ConvertToFloatGeneric(&input[i], &output[i], sampleCount - i);
+		}
+
+		NAZARA_AVX2_FUNCTION void ConvertToInt16AVX2(const float* input, Int16* output, std::size_t sampleCount)
+		{
+			__m256 scale = _mm256_set1_ps(Int16Scale);
+			__m256 minimum = _mm256_set1_ps(-32768.f);
+			__m256 maximum = _mm256_set1_ps(32767.f);
+
+			std::size_t i = 0;
+			for (; i + 16 <= sampleCount; i += 16)
+			{
+				__m256 low = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(&input[i]), scale), minimum), maximum);
+				__m256 high = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(&input[i + 8]), scale), minimum), maximum);
+
+				// Packing works on each lane, the 64 bits blocks have to be put back in order
+				__m256i samples = _mm256_packs_epi32(_mm256_cvtps_epi32(low), _mm256_cvtps_epi32(high));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]), _mm256_permute4x64_epi64(samples, _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+
+			ConvertToInt16Generic(&input[i], &output[i], sampleCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void ConvertToInt16SSE2(const float* input, Int16* output, std::size_t sampleCount)
+		{
+			__m128 scale = _mm_set1_ps(Int16Scale);
+			__m128 minimum = _mm_set1_ps(-32768.f);
+			__m128 maximum = _mm_set1_ps(32767.f);
+
+			std::size_t i = 0;
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				__m128 low = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&input[i]), scale), minimum), maximum);
+				__m128 high = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(&input[i + 4]), scale), minimum), maximum);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high)));
+			}
+
+			ConvertToInt16Generic(&input[i], &output[i], sampleCount - i);
+		}
+
+		NAZARA_AVX2_FUNCTION float FilterSampleAVX2(const float* input, const float* filter, unsigned int tapCount, float factor)
+		{
+			const float* nextFilter = filter + tapCount;
+
+			__m256 blend = _mm256_set1_ps(factor);
+			__m256 sum = _mm256_setzero_ps();
+			for (unsigned int i = 0; i < tapCount; i += 8)
+			{
+				__m256 coefficients = _mm256_loadu_ps(&filter[i]);
+				coefficients = _mm256_add_ps(coefficients, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&nextFilter[i]), coefficients), blend));
+
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(&input[i]), coefficients));
+			}
+
+			__m128 halfSum = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+			halfSum = _mm_add_ps(halfSum, _mm_movehl_ps(halfSum, halfSum));
+			halfSum = _mm_add_ss(halfSum, _mm_shuffle_ps(halfSum, halfSum, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			return _mm_cvtss_f32(halfSum);
+		}
+
+		NAZARA_SSE2_FUNCTION float FilterSampleSSE2(const float* input, const float* filter, unsigned int tapCount, float factor)
+		{
+			const float* nextFilter = filter + tapCount;
+
+			__m128 blend = _mm_set1_ps(factor);
+			__m128 sum = _mm_setzero_ps();
+			for (unsigned int i = 0; i < tapCount; i += 4)
+			{
+				__m128 coefficients = _mm_loadu_ps(&filter[i]);
+				coefficients = _mm_add_ps(coefficients, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&nextFilter[i]), coefficients), blend));
+
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&input[i]), coefficients));
+			}
+
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+
+			return _mm_cvtss_f32(sum);
+		}
+
+		NAZARA_AVX2_FUNCTION void InterleaveStereoInt16AVX2(const Int16* left, const Int16* right, Int16* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 16 <= frameCount; i += 16)
+			{
+				__m256i leftSamples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&left[i]));
+				__m256i rightSamples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&right[i]));
+
+				// Unpacking works on each lane, the lanes hold frames 0-3 and 8-11 (low) and 4-7 and 12-15 (high)
+				__m256i low = _mm256_unpacklo_epi16(leftSamples, rightSamples);
+				__m256i high = _mm256_unpackhi_epi16(leftSamples, rightSamples);
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[2*i]), _mm256_permute2x128_si256(low, high, 0x20));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[2*i + 16]), _mm256_permute2x128_si256(low, high, 0x31));
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void InterleaveStereoInt16SSE2(const Int16* left, const Int16* right, Int16* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				__m128i leftSamples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&left[i]));
+				__m128i rightSamples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&right[i]));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[2*i]), _mm_unpacklo_epi16(leftSamples, rightSamples));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[2*i + 8]), _mm_unpackhi_epi16(leftSamples, rightSamples));
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		NAZARA_AVX2_FUNCTION void InterleaveStereoFloatAVX2(const float* left, const float* right, float* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				__m256 leftSamples = _mm256_loadu_ps(&left[i]);
+				__m256 rightSamples = _mm256_loadu_ps(&right[i]);
+
+				__m256 low = _mm256_unpacklo_ps(leftSamples, rightSamples);
+				__m256 high = _mm256_unpackhi_ps(leftSamples, rightSamples);
+
+				_mm256_storeu_ps(&output[2*i], _mm256_permute2f128_ps(low, high, 0x20));
+				_mm256_storeu_ps(&output[2*i + 8], _mm256_permute2f128_ps(low, high, 0x31));
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void InterleaveStereoFloatSSE2(const float* left, const float* right, float* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 4 <= frameCount; i += 4)
+			{
+				__m128 leftSamples = _mm_loadu_ps(&left[i]);
+				__m128 rightSamples = _mm_loadu_ps(&right[i]);
+
+				_mm_storeu_ps(&output[2*i], _mm_unpacklo_ps(leftSamples, rightSamples));
+				_mm_storeu_ps(&output[2*i + 4], _mm_unpackhi_ps(leftSamples, rightSamples));
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		// The mixing kernels support in-place mixing: each iteration reads its frames before writing less samples than it read
+		NAZARA_AVX2_FUNCTION void MixStereoToMonoInt16AVX2(const Int16* input, Int16* output, unsigned int frameCount)
+		{
+			__m256i ones = _mm256_set1_epi16(1);
+
+			unsigned int i = 0;
+			for (; i + 16 <= frameCount; i += 16)
+			{
+				__m256i low = _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input[2*i])), ones);
+				__m256i high = _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&input[2*i + 16])), ones);
+
+				// Division rounding towards zero, like the generic version
+				low = _mm256_srai_epi32(_mm256_add_epi32(low, _mm256_srli_epi32(low, 31)), 1);
+				high = _mm256_srai_epi32(_mm256_add_epi32(high, _mm256_srli_epi32(high, 31)), 1);
+
+				__m256i samples = _mm256_packs_epi32(low, high);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&output[i]), _mm256_permute4x64_epi64(samples, _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void MixStereoToMonoInt16SSE2(const Int16* input, Int16* output, unsigned int frameCount)
+		{
+			__m128i ones = _mm_set1_epi16(1);
+
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				// Multiply-add sums each left and right pair into a 32 bits integer
+				__m128i low = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[2*i])), ones);
+				__m128i high = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[2*i + 8])), ones);
+
+				low = _mm_srai_epi32(_mm_add_epi32(low, _mm_srli_epi32(low, 31)), 1);
+				high = _mm_srai_epi32(_mm_add_epi32(high, _mm_srli_epi32(high, 31)), 1);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), _mm_packs_epi32(low, high));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+
+		NAZARA_AVX2_FUNCTION void MixStereoToMonoFloatAVX2(const float* input, float* output, unsigned int frameCount)
+		{
+			__m256 half = _mm256_set1_ps(0.5f);
+
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				__m256 first = _mm256_loadu_ps(&input[2*i]);
+				__m256 second = _mm256_loadu_ps(&input[2*i + 8]);
+
+				__m256 left = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+				__m256 right = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+				__m256 samples = _mm256_mul_ps(_mm256_add_ps(left, right), half);
+
+				_mm256_storeu_ps(&output[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(samples), _MM_SHUFFLE(3, 1, 2, 0))));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+
+		NAZARA_SSE2_FUNCTION void MixStereoToMonoFloatSSE2(const float* input, float* output, unsigned int frameCount)
+		{
+			__m128 half = _mm_set1_ps(0.5f);
+
+			unsigned int i = 0;
+			for (; i + 4 <= frameCount; i += 4)
+			{
+				__m128 first = _mm_loadu_ps(&input[2*i]);
+				__m128 second = _mm_loadu_ps(&input[2*i + 4]);
+
+				__m128 left = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+				__m128 right = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+
+				_mm_storeu_ps(&output[i], _mm_mul_ps(_mm_add_ps(left, right), half));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+		#endif
+
+		#ifdef NAZARA_ALGORITHMAUDIO_NEON
+		void ConvertToFloatNEON(const Int16* input, float* output, std::size_t sampleCount)
+		{
+			std::size_t i = 0;
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				int16x8_t samples = vld1q_s16(&input[i]);
+
+				vst1q_f32(&output[i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), 1.f / Int16Scale));
+				vst1q_f32(&output[i + 4], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), 1.f / Int16Scale));
+			}
+
+			ConvertToFloatGeneric(&input[i], &output[i], sampleCount - i);
+		}
+
+		void ConvertToInt16NEON(const float* input, Int16* output, std::size_t sampleCount)
+		{
+			std::size_t i = 0;
+			for (; i + 8 <= sampleCount; i += 8)
+			{
+				// Conversion and narrowing both saturate
+				int32x4_t low = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(&input[i]), Int16Scale));
+				int32x4_t high = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(&input[i + 4]), Int16Scale));
+
+				vst1q_s16(&output[i], vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+			}
+
+			ConvertToInt16Generic(&input[i], &output[i], sampleCount - i);
+		}
+
+		float FilterSampleNEON(const float* input, const float* filter, unsigned int tapCount, float factor)
+		{
+			const float* nextFilter = filter + tapCount;
+
+			float32x4_t sum = vdupq_n_f32(0.f);
+			for (unsigned int i = 0; i < tapCount; i += 4)
+			{
+				float32x4_t coefficients = vld1q_f32(&filter[i]);
+				coefficients = vmlaq_n_f32(coefficients, vsubq_f32(vld1q_f32(&nextFilter[i]), coefficients), factor);
+
+				sum = vmlaq_f32(sum, vld1q_f32(&input[i]), coefficients);
+			}
+
+			return vaddvq_f32(sum);
+		}
+
+		void InterleaveStereoInt16NEON(const Int16* left, const Int16* right, Int16* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				int16x8x2_t samples;
+				samples.val[0] = vld1q_s16(&left[i]);
+				samples.val[1] = vld1q_s16(&right[i]);
+
+				vst2q_s16(&output[2*i], samples);
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		void InterleaveStereoFloatNEON(const float* left, const float* right, float* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 4 <= frameCount; i += 4)
+			{
+				float32x4x2_t samples;
+				samples.val[0] = vld1q_f32(&left[i]);
+				samples.val[1] = vld1q_f32(&right[i]);
+
+				vst2q_f32(&output[2*i], samples);
+			}
+
+			InterleaveStereoGeneric(&left[i], &right[i], &output[2*i], frameCount - i);
+		}
+
+		void MixStereoToMonoInt16NEON(const Int16* input, Int16* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 8 <= frameCount; i += 8)
+			{
+				int16x8x2_t samples = vld2q_s16(&input[2*i]);
+
+				int32x4_t low = vaddl_s16(vget_low_s16(samples.val[0]), vget_low_s16(samples.val[1]));
+				int32x4_t high = vaddl_s16(vget_high_s16(samples.val[0]), vget_high_s16(samples.val[1]));
+
+				// Division rounding towards zero, like the generic version
+				low = vshrq_n_s32(vaddq_s32(low, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(low), 31))), 1);
+				high = vshrq_n_s32(vaddq_s32(high, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(high), 31))), 1);
+
+				vst1q_s16(&output[i], vcombine_s16(vmovn_s32(low), vmovn_s32(high)));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+
+		void MixStereoToMonoFloatNEON(const float* input, float* output, unsigned int frameCount)
+		{
+			unsigned int i = 0;
+			for (; i + 4 <= frameCount; i += 4)
+			{
+				float32x4x2_t samples = vld2q_f32(&input[2*i]);
+				vst1q_f32(&output[i], vmulq_n_f32(vaddq_f32(samples.val[0], samples.val[1]), 0.5f));
+			}
+
+			MixStereoToMonoGeneric(&input[2*i], &output[i], frameCount - i);
+		}
+		#endif
+
+		CpuKernel<void(const Int16*, float*, std::size_t)> s_convertToFloatKernel("Int16 to float samples conversion", &ConvertToFloatGeneric, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&ConvertToFloatAVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&ConvertToFloatSSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&ConvertToFloatNEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const float*, Int16*, std::size_t)> s_convertToInt16Kernel("Float to Int16 samples conversion", &ConvertToInt16Generic, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&ConvertToInt16AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&ConvertToInt16SSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&ConvertToInt16NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<float(const float*, const float*, unsigned int, float)> s_filterSampleKernel("Polyphase resampling filter", &FilterSampleGeneric, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&FilterSampleAVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&FilterSampleSSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&FilterSampleNEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const Int16*, const Int16*, Int16*, unsigned int)> s_interleaveStereoInt16Kernel("Int16 stereo interleaving", &InterleaveStereoGeneric<Int16>, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&InterleaveStereoInt16AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&InterleaveStereoInt16SSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&InterleaveStereoInt16NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const float*, const float*, float*, unsigned int)> s_interleaveStereoFloatKernel("Float stereo interleaving", &InterleaveStereoGeneric<float>, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&InterleaveStereoFloatAVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&InterleaveStereoFloatSSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&InterleaveStereoFloatNEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const Int16*, Int16*, unsigned int)> s_mixStereoToMonoInt16Kernel("Int16 stereo to mono mixing", &MixStereoToMonoGeneric<Int16>, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&MixStereoToMonoInt16AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&MixStereoToMonoInt16SSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&MixStereoToMonoInt16NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const float*, float*, unsigned int)> s_mixStereoToMonoFloatKernel("Float stereo to mono mixing", &MixStereoToMonoGeneric<float>, {
+			#ifdef NAZARA_ALGORITHMAUDIO_X86
+			{&MixStereoToMonoFloatAVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&MixStereoToMonoFloatSSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMAUDIO_NEON
+			{&MixStereoToMonoFloatNEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		/*******************************Resampling********************************/
+		// Windowed sinc filter, sampled in a bank of phases between two input samples
+		// The kernels blend the two phases surrounding the exact position, a multiple of eight taps keeps them vectorized
+		constexpr unsigned int ResamplingPhaseCount = 256;
+		constexpr unsigned int ResamplingTapCount = 32;
+		constexpr double ResamplingBandwidth = 0.95; //< Part of the lowest Nyquist frequency kept, leaving room for the transition band
+		constexpr double ResamplingKaiserBeta = 8.0;
+
+		double BesselI0(double value)
+		{
+			// Power series, converging quickly enough for the window parameters
+			double sum = 1.0;
+			double term = 1.0;
+			double halfValue = value / 2.0;
+			for (unsigned int k = 1; k < 32; ++k)
+			{
+				term *= halfValue / k;
+				sum += term * term;
+			}
+
+			return sum;
+		}
+
+		std::vector<float> BuildResamplingFilters(UInt32 inputRate, UInt32 outputRate)
+		{
+			const double halfTapCount = ResamplingTapCount / 2.0;
+
+			// When downsampling, the cutoff follows the output Nyquist frequency to avoid aliasing
+			double cutoff = ResamplingBandwidth * std::min(1.0, static_cast<double>(outputRate) / inputRate);
+			double windowNormalization = BesselI0(ResamplingKaiserBeta);
+
+			// One more phase than needed, the last one being blended with the one before it
+			std::vector<float> filters((ResamplingPhaseCount + 1) * ResamplingTapCount);
+			for (unsigned int phase = 0; phase <= ResamplingPhaseCount; ++phase)
+			{
+				for (unsigned int tap = 0; tap < ResamplingTapCount; ++tap)
+				{
+					// Distance between the output position and the input sample this tap applies to
+					double distance = static_cast<double>(phase) / ResamplingPhaseCount + halfTapCount - 1.0 - tap;
+
+					double x = M_PI * cutoff * distance;
+					double sinc = (std::abs(x) > 1e-9) ? std::sin(x) / x : 1.0;
+
+					double windowPosition = distance / halfTapCount;
+					double window = (std::abs(windowPosition) < 1.0) ? BesselI0(ResamplingKaiserBeta * std::sqrt(1.0 - windowPosition * windowPosition)) / windowNormalization : 0.0;
+
+					filters[phase * ResamplingTapCount + tap] = static_cast<float>(cutoff * sinc * window);
+				}
+			}
+
+			return filters;
+		}
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Converts Int16 samples to float samples in the [-1, 1[ range
+	*
+	* \param input Int16 samples
+	* \param output Float samples
+	* \param sampleCount Number of samples
+	*/
+	void ConvertSamples(const Int16* input, float* output, std::size_t sampleCount)
+	{
+		s_convertToFloatKernel(input, output, sampleCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Converts float samples to Int16 samples, rounding them and saturating out of range ones
+	*
+	* \param input Float samples
+	* \param output Int16 samples
+	* \param sampleCount Number of samples
+	*/
+	void ConvertSamples(const float* input, Int16* output, std::size_t sampleCount)
+	{
+		s_convertToInt16Kernel(input, output, sampleCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Gets the number of frames produced by Resample
+	* \return Number of frames once resampled
+	*
+	* \param frameCount Number of input frames
+	* \param inputRate Sample rate of the input
+	* \param outputRate Sample rate of the output
+	*/
+	unsigned int GetResampledFrameCount(unsigned int frameCount, UInt32 inputRate, UInt32 outputRate)
+	{
+		NazaraAssert(inputRate > 0, "Invalid input rate");
+
+		return static_cast<unsigned int>(static_cast<UInt64>(frameCount) * outputRate / inputRate);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Interleaves two channels into stereo frames
+	*
+	* \param left Samples of the left channel
+	* \param right Samples of the right channel
+	* \param output Output buffer, large enough to hold two samples per frame
+	* \param frameCount Number of frames
+	*/
+	void InterleaveStereo(const Int16* left, const Int16* right, Int16* output, unsigned int frameCount)
+	{
+		s_interleaveStereoInt16Kernel(left, right, output, frameCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Interleaves two channels into stereo frames
+	*
+	* \param left Samples of the left channel
+	* \param right Samples of the right channel
+	* \param output Output buffer, large enough to hold two samples per frame
+	* \param frameCount Number of frames
+	*/
+	void InterleaveStereo(const float* left, const float* right, float* output, unsigned int frameCount)
+	{
+		s_interleaveStereoFloatKernel(left, right, output, frameCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Mixes channels in mono, stereo frames being mixed by SIMD kernels
+	*
+	* \param input Input buffer with multiples channels
+	* \param output Output butter for mono
+	* \param channelCount Number of channels
+	* \param frameCount Number of frames
+	*
+	* \remark The input buffer may be the same as the output one
+	*/
+	void MixToMono(Int16* input, Int16* output, unsigned int channelCount, unsigned int frameCount)
+	{
+		if (channelCount == 2)
+			s_mixStereoToMonoInt16Kernel(input, output, frameCount);
+		else
+			MixToMono<Int16>(input, output, channelCount, frameCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Mixes channels in mono, stereo frames being mixed by SIMD kernels
+	*
+	* \param input Input buffer with multiples channels
+	* \param output Output butter for mono
+	* \param channelCount Number of channels
+	* \param frameCount Number of frames
+	*
+	* \remark The input buffer may be the same as the output one
+	*/
+	void MixToMono(float* input, float* output, unsigned int channelCount, unsigned int frameCount)
+	{
+		if (channelCount == 2)
+			s_mixStereoToMonoFloatKernel(input, output, frameCount);
+		else
+			MixToMono<float>(input, output, channelCount, frameCount);
+	}
+
+	/*!
+	* \ingroup audio
+	* \brief Changes the sample rate of interleaved samples
+	*
+	* Each output sample is computed by a Kaiser windowed sinc filter, interpolated from a bank of precomputed phases
+	*
+	* \param input Interleaved input samples
+	* \param output Output buffer, large enough to hold the number of frames given by GetResampledFrameCount
+	* \param channelCount Number of channels
+	* \param frameCount Number of input frames
+	* \param inputRate Sample rate of the input
+	* \param outputRate Sample rate of the output
+	*
+	* \remark The input buffer cannot be the same as the output one
+	*/
+	void Resample(const Int16* input, Int16* output, unsigned int channelCount, unsigned int frameCount, UInt32 inputRate, UInt32 outputRate)
+	{
+		NazaraAssert(channelCount > 0, "Invalid channel count");
+		NazaraAssert(inputRate > 0 && outputRate > 0, "Invalid sample rate");
+
+		if (inputRate == outputRate)
+		{
+			std::memcpy(output, input, frameCount * channelCount * sizeof(Int16));
+			return;
+		}
+
+		unsigned int outputFrameCount = GetResampledFrameCount(frameCount, inputRate, outputRate);
+		if (outputFrameCount == 0)
+			return;
+
+		std::vector<float> filters = BuildResamplingFilters(inputRate, outputRate);
+
+		std::vector<float> samples(static_cast<std::size_t>(frameCount) * channelCount);
+		ConvertSamples(input, samples.data(), samples.size());
+
+		// Channels are filtered one at a time, with zeroes on both sides for the taps going past the ends
+		std::vector<float> channel(frameCount + ResamplingTapCount);
+		std::vector<float> resampled(static_cast<std::size_t>(outputFrameCount) * channelCount);
+		std::vector<float> resampledChannels((channelCount == 2) ? 2 * outputFrameCount : 0);
+
+		auto filterSample = s_filterSampleKernel.Get();
+		for (unsigned int c = 0; c < channelCount; ++c)
+		{
+			for (unsigned int i = 0; i < frameCount; ++i)
+				channel[ResamplingTapCount / 2 + i] = samples[static_cast<std::size_t>(i) * channelCount + c];
+
+			// Stereo channels are interleaved afterwards by a kernel
+			float* channelOutput = (channelCount == 2) ? &resampledChannels[c * outputFrameCount] : &resampled[c];
+			unsigned int outputStride = (channelCount == 2) ? 1 : channelCount;
+
+			for (unsigned int i = 0; i < outputFrameCount; ++i)
+			{
+				// Exact position in the input, as a frame index and a fraction
+				UInt64 position = static_cast<UInt64>(i) * inputRate;
+				unsigned int frame = static_cast<unsigned int>(position / outputRate);
+				float phase = static_cast<float>(position % outputRate) * ResamplingPhaseCount / outputRate;
+
+				unsigned int phaseIndex = static_cast<unsigned int>(phase);
+				const float* filter = &filters[phaseIndex * ResamplingTapCount];
+
+				channelOutput[static_cast<std::size_t>(i) * outputStride] = filterSample(&channel[frame + 1], filter, ResamplingTapCount, phase - phaseIndex);
+			}
+		}
+
+		if (channelCount == 2)
+			InterleaveStereo(&resampledChannels[0], &resampledChannels[outputFrameCount], resampled.data(), outputFrameCount);
+
+		ConvertSamples(resampled.data(), output, resampled.size());
+	}
+}
@@ -3,10 +3,13 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/OpenAL.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
+#include <Nazara/Audio/SoundEmitter.hpp>
+#include <Nazara/Audio/VoiceManager.hpp>
 #include <Nazara/Audio/Formats/sndfileLoader.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Core.hpp>
@@ -183,6 +186,18 @@ namespace Nz
 			return false;
 		}
 
+		if (!AudioStreamer::Initialize(NAZARA_AUDIO_STREAMING_THREAD_COUNT))
+		{
+			NazaraError("Failed to initialize audio streamer");
+			return false;
+		}
+
+		if (!VoiceManager::Initialize(NAZARA_AUDIO_MAX_SOURCE_COUNT))
+		{
+			NazaraError("Failed to initialize voice manager");
+			return false;
+		}
+
 		// Definition of the orientation by default
 		SetListenerDirection(Vector3f::Forward());
 
@@ -390,6 +405,8 @@ namespace Nz
 		// Loaders
 		Loaders::Unregister_sndfile();
 
+		VoiceManager::Uninitialize();
+		AudioStreamer::Uninitialize();
 		SoundBuffer::Uninitialize();
 		OpenAL::Uninitialize();
 
@@ -399,5 +416,18 @@ namespace Nz
 		Core::Uninitialize();
 	}
 
+	/*!
+	* \brief Sends the settings changed on sound emitters since the last update to OpenAL
+	*
+	* Every change is applied at once, emitters left unchanged are skipped.
+	*
+	* \remark Should be called once per frame, after the emitters have been moved
+	*/
+
+	void Audio::Update()
+	{
+		SoundEmitter::FlushAllParameters();
+	}
+
 	unsigned int Audio::s_moduleReferenceCounter = 0;
 }
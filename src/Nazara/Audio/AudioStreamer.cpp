@@ -0,0 +1,215 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/AudioStreamer.hpp>
+#include <Nazara/Audio/Music.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <unordered_map>
+#include <vector>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct Entry
+		{
+			UInt64 nextUpdate = 0;
+			bool busy = false;
+			bool started = false;
+		};
+
+		// References to the entries stay valid while other musics are added or removed
+		std::unordered_map<Music*, Entry> s_entries;
+		std::vector<Thread> s_workers;
+		ConditionVariable s_entryReleased;
+		ConditionVariable s_workAvailable;
+		Mutex s_mutex;
+		bool s_running = false;
+	}
+
+	/*!
+	* \ingroup audio
+	* \class Nz::AudioStreamer
+	* \brief Audio class that streams every playing music from a shared pool of threads
+	*/
+
+	/*!
+	* \brief Starts the streaming threads
+	* \return true if successful
+	*
+	* \param workerCount Number of threads decoding and queuing buffers
+	*/
+
+	bool AudioStreamer::Initialize(unsigned int workerCount)
+	{
+		NazaraAssert(workerCount > 0, "Worker count must be over zero");
+
+		if (s_running)
+			return true;
+
+		s_running = true;
+
+		s_workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+			s_workers.emplace_back(WorkerThread);
+
+		return true;
+	}
+
+	/*!
+	* \brief Checks whether the streaming threads are running
+	* \return true if it is the case
+	*/
+
+	bool AudioStreamer::IsInitialized()
+	{
+		return s_running;
+	}
+
+	/*!
+	* \brief Hands a music to the streaming threads
+	*
+	* \param music Music to stream, its first buffers are filled by a worker as soon as possible
+	*
+	* \remark The music must be unregistered before being destroyed
+	*/
+
+	void AudioStreamer::Register(Music* music)
+	{
+		NazaraAssert(music, "Invalid music");
+
+		LockGuard lock(s_mutex);
+
+		// A worker may still be finishing a previous playback of this music
+		while (s_entries.find(music) != s_entries.end())
+			s_entryReleased.Wait(&s_mutex);
+
+		s_entries.emplace(music, Entry());
+		s_workAvailable.Signal();
+	}
+
+	/*!
+	* \brief Takes a music back from the streaming threads
+	* \return true if the music was still streaming, false if it had already reached its end
+	*
+	* \param music Music to stop streaming
+	*
+	* \remark Blocks while a worker is updating the music
+	*/
+
+	bool AudioStreamer::Unregister(Music* music)
+	{
+		LockGuard lock(s_mutex);
+
+		for (;;)
+		{
+			auto it = s_entries.find(music);
+			if (it == s_entries.end())
+				return false;
+
+			if (!it->second.busy)
+			{
+				s_entries.erase(it);
+				return true;
+			}
+
+			s_entryReleased.Wait(&s_mutex);
+		}
+	}
+
+	/*!
+	* \brief Stops the streaming threads
+	*
+	* \remark Musics still registered stop being streamed
+	*/
+
+	void AudioStreamer::Uninitialize()
+	{
+		if (!s_running)
+			return;
+
+		{
+			LockGuard lock(s_mutex);
+
+			s_running = false;
+			s_workAvailable.SignalAll();
+		}
+
+		for (Thread& thread : s_workers)
+			thread.Join();
+
+		s_workers.clear();
+		s_entries.clear();
+	}
+
+	void AudioStreamer::WorkerThread()
+	{
+		Thread::SetCurrentThreadName("Nz Audio Streamer");
+
+		LockGuard lock(s_mutex);
+		while (s_running)
+		{
+			// The music whose buffers run out first
+			Music* music = nullptr;
+			Entry* entry = nullptr;
+			for (auto& pair : s_entries)
+			{
+				if (pair.second.busy)
+					continue;
+
+				if (!entry || pair.second.nextUpdate < entry->nextUpdate)
+				{
+					music = pair.first;
+					entry = &pair.second;
+				}
+			}
+
+			if (!entry)
+			{
+				s_workAvailable.Wait(&s_mutex);
+				continue;
+			}
+
+			UInt64 now = GetElapsedMilliseconds();
+			if (entry->nextUpdate > now)
+			{
+				s_workAvailable.Wait(&s_mutex, static_cast<UInt32>(entry->nextUpdate - now));
+				continue;
+			}
+
+			bool started = entry->started;
+			entry->busy = true;
+
+			// Decoding may take a while, other workers keep going meanwhile
+			s_mutex.Unlock();
+
+			if (!started)
+				music->StartStreaming();
+
+			UInt32 nextUpdate;
+			bool active = music->UpdateStreaming(&nextUpdate);
+			if (!active)
+				music->StopStreaming();
+
+			s_mutex.Lock();
+
+			if (active)
+			{
+				entry->busy = false;
+				entry->nextUpdate = GetElapsedMilliseconds() + nextUpdate;
+				entry->started = true;
+			}
+			else
+				s_entries.erase(music);
+
+			s_entryReleased.SignalAll();
+		}
+	}
+}
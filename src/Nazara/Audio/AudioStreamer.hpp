@@ -0,0 +1,37 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_AUDIOSTREAMER_HPP
+#define NAZARA_AUDIOSTREAMER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	class Music;
+
+	// Drives every playing music from a small pool of worker threads
+	// Each music is only visited when its queued buffers are about to run out
+	class AudioStreamer
+	{
+		public:
+			AudioStreamer() = delete;
+			~AudioStreamer() = delete;
+
+			static bool Initialize(unsigned int workerCount);
+			static bool IsInitialized();
+
+			static void Register(Music* music);
+			static bool Unregister(Music* music);
+
+			static void Uninitialize();
+
+		private:
+			static void WorkerThread();
+	};
+}
+
+#endif // NAZARA_AUDIOSTREAMER_HPP
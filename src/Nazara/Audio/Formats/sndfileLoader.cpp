@@ -14,6 +14,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/ReadAheadStream.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <memory>
 #include <set>
@@ -118,7 +119,9 @@ namespace Nz
 						return false;
 					}
 
-					m_ownedStream = std::move(file);
+					// La lecture depuis le disque se fait en avance dans un autre thread, le décodage n'attend pas le disque
+					m_ownedFile = std::move(file);
+					m_ownedStream.reset(new ReadAheadStream(*m_ownedFile));
 					return Open(*m_ownedStream, forceMono);
 				}
 
@@ -203,7 +206,8 @@ namespace Nz
 
 			private:
 				std::vector<Int16> m_mixBuffer;
-				std::unique_ptr<Stream> m_ownedStream;
+				std::unique_ptr<File> m_ownedFile;
+				std::unique_ptr<Stream> m_ownedStream; // Détruit avant m_ownedFile, qu'il peut lire
 				AudioFormat m_format;
 				SNDFILE* m_handle;
 				bool m_mixToMono;
@@ -320,8 +324,68 @@ namespace Nz
 				return Ternary_False;
 		}
 
+		bool DecodeSoundBuffer(const void* data, std::size_t size, bool forceMono, UInt32 sampleRate, Int16* samples, unsigned int sampleCount)
+		{
+			MemoryView stream(data, size);
+
+			SF_INFO info;
+			info.format = 0;
+
+			SNDFILE* file = sf_open_virtual(&callbacks, SFM_READ, &info, &stream);
+			if (!file)
+			{
+				NazaraError("Failed to open sound: " + String(sf_strerror(file)));
+				return false;
+			}
+
+			CallOnExit onExit([file]
+			{
+				sf_close(file);
+			});
+
+			if (info.format & SF_FORMAT_VORBIS)
+				sf_command(file, SFC_SET_SCALE_FLOAT_INT_READ, nullptr, SF_TRUE);
+
+			// Le mixage en mono et le rééchantillonnage se font comme au chargement, dans un buffer temporaire à la taille d'origine
+			bool resample = (sampleRate != static_cast<UInt32>(info.samplerate));
+			if ((forceMono && info.channels > 1) || resample)
+			{
+				std::unique_ptr<Int16[]> channelSamples(new Int16[static_cast<std::size_t>(info.frames * info.channels)]);
+				if (sf_read_short(file, channelSamples.get(), info.frames * info.channels) != info.frames * info.channels)
+				{
+					NazaraError("Failed to read samples");
+					return false;
+				}
+
+				unsigned int channelCount = static_cast<unsigned int>(info.channels);
+				unsigned int frameCount = static_cast<unsigned int>(info.frames);
+				if (!resample)
+					MixToMono(channelSamples.get(), samples, channelCount, frameCount);
+				else
+				{
+					if (forceMono && channelCount > 1)
+					{
+						MixToMono(channelSamples.get(), channelSamples.get(), channelCount, frameCount);
+						channelCount = 1;
+					}
+
+					Resample(channelSamples.get(), samples, channelCount, frameCount, info.samplerate, sampleRate);
+				}
+			}
+			else if (sf_read_short(file, samples, sampleCount) != sampleCount)
+			{
+				NazaraError("Failed to read samples");
+				return false;
+			}
+
+			return true;
+		}
+
 		bool LoadSoundBuffer(SoundBuffer* soundBuffer, Stream& stream, const SoundBufferParams& parameters)
 		{
+			// Début du fichier, pour pouvoir le garder encodé en mémoire si demandé
+			UInt64 startPos = stream.GetCursorPos();
+
 			SF_INFO info;
 			info.format = 0;
 
@@ -353,6 +417,38 @@ namespace Nz
 			if (info.format & SF_FORMAT_VORBIS)
 				sf_command(file, SFC_SET_SCALE_FLOAT_INT_READ, nullptr, SF_TRUE);
 
+			if (parameters.keepCompressed)
+			{
+				std::vector<UInt8> data(static_cast<std::size_t>(stream.GetSize() - startPos));
+
+				stream.SetCursorPos(startPos);
+				if (stream.Read(data.data(), data.size()) != data.size())
+				{
+					NazaraError("Failed to read compressed sound");
+					return false;
+				}
+
+				bool forceMono = parameters.forceMono && format != AudioFormat_Mono;
+				if (forceMono)
+					format = AudioFormat_Mono;
+
+				UInt32 sampleRate = (parameters.sampleRate != 0) ? parameters.sampleRate : info.samplerate;
+
+				unsigned int decodedSampleCount = GetResampledFrameCount(static_cast<unsigned int>(info.frames), info.samplerate, sampleRate) * format;
+				SoundBuffer::Decoder decoder = [forceMono, sampleRate] (const void* encodedData, std::size_t size, Int16* samples, unsigned int sampleCount)
+				{
+					return DecodeSoundBuffer(encodedData, size, forceMono, sampleRate, samples, sampleCount);
+				};
+
+				if (!soundBuffer->CreateCompressed(format, decodedSampleCount, sampleRate, data.data(), data.size(), std::move(decoder)))
+				{
+					NazaraError("Failed to create sound buffer");
+					return false;
+				}
+
+				return true;
+			}
+
 			unsigned int sampleCount = static_cast<unsigned int>(info.frames * info.channels);
 			std::unique_ptr<Int16[]> samples(new Int16[sampleCount]);
 
@@ -372,7 +468,21 @@ namespace Nz
 				sampleCount = static_cast<unsigned int>(info.frames);
 			}
 
-			if (!soundBuffer->Create(format, sampleCount, info.samplerate, samples.get()))
+			// Un rééchantillonnage est-il demandé ?
+			UInt32 sampleRate = info.samplerate;
+			if (parameters.sampleRate != 0 && parameters.sampleRate != sampleRate)
+			{
+				unsigned int frameCount = GetResampledFrameCount(static_cast<unsigned int>(info.frames), sampleRate, parameters.sampleRate);
+
+				std::unique_ptr<Int16[]> resampledSamples(new Int16[frameCount * format]);
+				Resample(samples.get(), resampledSamples.get(), format, static_cast<unsigned int>(info.frames), sampleRate, parameters.sampleRate);
+
+				samples = std::move(resampledSamples);
+				sampleCount = frameCount * format;
+				sampleRate = parameters.sampleRate;
+			}
+
+			if (!soundBuffer->Create(format, sampleCount, sampleRate, samples.get()))
 			{
 				NazaraError("Failed to create sound buffer");
 				return false;
@@ -380,6 +490,13 @@ namespace Nz
 
 			return true;
 		}
+
+		bool LoadSoundBufferMemory(SoundBuffer* soundBuffer, const void* data, std::size_t size, const SoundBufferParams& parameters)
+		{
+			// Samples are decoded straight from the buffer (usually a file mapping)
+			MemoryView stream(data, size);
+			return LoadSoundBuffer(soundBuffer, stream, parameters);
+		}
 	}
 
 	namespace Loaders
@@ -387,13 +504,13 @@ namespace Nz
 		void Register_sndfile()
 		{
 			MusicLoader::RegisterLoader(Detail::IsSupported, Detail::CheckMusic, Detail::LoadMusicStream, Detail::LoadMusicFile, Detail::LoadMusicMemory);
-			SoundBufferLoader::RegisterLoader(Detail::IsSupported, Detail::CheckSoundBuffer, Detail::LoadSoundBuffer);
+			SoundBufferLoader::RegisterLoader(Detail::IsSupported, Detail::CheckSoundBuffer, Detail::LoadSoundBuffer, nullptr, Detail::LoadSoundBufferMemory);
 		}
 
 		void Unregister_sndfile()
 		{
 			MusicLoader::UnregisterLoader(Detail::IsSupported, Detail::CheckMusic, Detail::LoadMusicStream, Detail::LoadMusicFile, Detail::LoadMusicMemory);
-			SoundBufferLoader::UnregisterLoader(Detail::IsSupported, Detail::CheckSoundBuffer, Detail::LoadSoundBuffer);
+			SoundBufferLoader::UnregisterLoader(Detail::IsSupported, Detail::CheckSoundBuffer, Detail::LoadSoundBuffer, nullptr, Detail::LoadSoundBufferMemory);
 		}
 	}
 }
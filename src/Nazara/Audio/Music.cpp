@@ -4,10 +4,13 @@
 
 #include <Nazara/Audio/Music.hpp>
 #include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/AudioStreamer.hpp>
 #include <Nazara/Audio/OpenAL.hpp>
 #include <Nazara/Audio/SoundStream.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/Mutex.hpp>
-#include <Nazara/Core/Thread.hpp>
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <Nazara/Audio/Debug.hpp>
@@ -36,12 +39,13 @@ namespace Nz
 	{
 		ALenum audioFormat;
 		std::unique_ptr<SoundStream> stream;
+		ALuint buffers[NAZARA_AUDIO_STREAMED_BUFFER_COUNT];
+		std::atomic_bool streaming;
 		std::vector<Int16> chunkSamples;
 		Mutex bufferLock;
-		Thread thread;
 		UInt64 processedSamples;
 		bool loop = false;
-		bool streaming = false;
+		bool streamEnded = false;
 		unsigned int sampleRate;
 	};
 
@@ -78,6 +82,9 @@ namespace Nz
 		m_impl->audioFormat = OpenAL::AudioFormat[format];
 		m_impl->chunkSamples.resize(format * m_impl->sampleRate); // One second of samples
 		m_impl->stream.reset(soundStream);
+		m_impl->streaming = false;
+
+		alGenBuffers(NAZARA_AUDIO_STREAMED_BUFFER_COUNT, m_impl->buffers);
 
 		SetPlayingOffset(0);
 
@@ -94,6 +101,8 @@ namespace Nz
 		{
 			Stop();
 
+			alDeleteBuffers(NAZARA_AUDIO_STREAMED_BUFFER_COUNT, m_impl->buffers);
+
 			delete m_impl;
 			m_impl = nullptr;
 		}
@@ -177,7 +186,7 @@ namespace Nz
 		}
 		#endif
 		
-		// Prevent music thread from enqueing new buffers while we're getting the count
+		// Prevent streaming threads from enqueing new buffers while we're getting the count
 		Nz::LockGuard lock(m_impl->bufferLock);
 
 		ALint samples = 0;
@@ -338,6 +347,9 @@ namespace Nz
 		}
 		#endif
 
+		// The streaming threads start the source, they must not touch the pending settings
+		FlushParameters();
+
 		// Maybe we are already playing
 		if (m_impl->streaming)
 		{
@@ -357,9 +369,9 @@ namespace Nz
 		}
 		else
 		{
-			// Starting streaming's thread
+			// The first buffers are filled by the streaming threads, so Play never waits for decoding
 			m_impl->streaming = true;
-			m_impl->thread = Thread(&Music::MusicThread, this);
+			AudioStreamer::Register(this);
 		}
 	}
 
@@ -411,8 +423,11 @@ namespace Nz
 
 		if (m_impl->streaming)
 		{
+			// If the streamer already took the music back, it has reached its end and was cleaned up
+			if (AudioStreamer::Unregister(this))
+				StopStreaming();
+
 			m_impl->streaming = false;
-			m_impl->thread.Join();
 		}
 	}
 
@@ -454,65 +469,37 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Thread function for the music
+	* \brief Fills and queues the first buffers, then starts the source
+	*
+	* \remark Called by the streaming threads
 	*/
 
-	void Music::MusicThread()
+	void Music::StartStreaming()
 	{
-		// Allocation of streaming buffers
-		ALuint buffers[NAZARA_AUDIO_STREAMED_BUFFER_COUNT];
-		alGenBuffers(NAZARA_AUDIO_STREAMED_BUFFER_COUNT, buffers);
+		Nz::LockGuard lock(m_impl->bufferLock);
 
+		m_impl->streamEnded = false;
 		for (unsigned int i = 0; i < NAZARA_AUDIO_STREAMED_BUFFER_COUNT; ++i)
 		{
-			if (FillAndQueueBuffer(buffers[i]))
+			if (FillAndQueueBuffer(m_impl->buffers[i]))
+			{
+				m_impl->streamEnded = true;
 				break; // We have reached the end of the stream, there is no use to add new buffers
+			}
 		}
 
 		alSourcePlay(m_source);
+	}
 
-		// Reading loop (Filling new buffers as playing)
-		while (m_impl->streaming)
-		{
-			// The reading has stopped, we have reached the end of the stream
-			SoundStatus status = GetInternalStatus();
-			if (status == SoundStatus_Stopped)
-			{
-				m_impl->streaming = false;
-				break;
-			}
-
-			Nz::LockGuard lock(m_impl->bufferLock);
-
-			// We treat read buffers
-			ALint processedCount = 0;
-			alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processedCount);
-			while (processedCount--)
-			{
-				ALuint buffer;
-				alSourceUnqueueBuffers(m_source, 1, &buffer);
-				
-				ALint bits, size;
-				alGetBufferi(buffer, AL_BITS, &bits);
-				alGetBufferi(buffer, AL_SIZE, &size);
-				
-				if (bits != 0)
-					m_impl->processedSamples += (8 * size) / bits;
-
-				if (FillAndQueueBuffer(buffer))
-					break;
-			}
-
-			lock.Unlock();
-
-			// We go back to sleep
-			Thread::Sleep(50);
-		}
+	/*!
+	* \brief Stops the source and takes its buffers back
+	*/
 
-		// Stop playing of the sound (in the case where it has not been already done)
+	void Music::StopStreaming()
+	{
 		alSourceStop(m_source);
 
-		// We delete buffers from the stream
+		// Stopping the source marks every queued buffer as processed
 		ALint queuedBufferCount;
 		alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queuedBufferCount);
 
@@ -520,7 +507,64 @@ namespace Nz
 		for (ALint i = 0; i < queuedBufferCount; ++i)
 			alSourceUnqueueBuffers(m_source, 1, &buffer);
 
-		alDeleteBuffers(NAZARA_AUDIO_STREAMED_BUFFER_COUNT, buffers);
+		m_impl->streaming = false;
+	}
+
+	/*!
+	* \brief Refills the buffers the source is done with
+	* \return false if the music has reached its end
+	*
+	* \param nextUpdate Delay in milliseconds before the buffer being played runs out
+	*
+	* \remark Called by the streaming threads
+	*/
+
+	bool Music::UpdateStreaming(UInt32* nextUpdate)
+	{
+		Nz::LockGuard lock(m_impl->bufferLock);
+
+		ALint processedCount = 0;
+		alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processedCount);
+		while (processedCount-- > 0)
+		{
+			ALuint buffer;
+			alSourceUnqueueBuffers(m_source, 1, &buffer);
+
+			ALint bits, size;
+			alGetBufferi(buffer, AL_BITS, &bits);
+			alGetBufferi(buffer, AL_SIZE, &size);
+
+			if (bits != 0)
+				m_impl->processedSamples += (8 * size) / bits;
+
+			if (!m_impl->streamEnded)
+				m_impl->streamEnded = FillAndQueueBuffer(buffer);
+		}
+
+		ALint queuedCount = 0;
+		alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queuedCount);
+
+		if (GetInternalStatus() == SoundStatus_Stopped)
+		{
+			// Every buffer has been played, the music is over
+			if (queuedCount == 0)
+				return false;
+
+			// The source ran dry before being refilled, it stopped by itself
+			alSourcePlay(m_source);
+		}
+
+		// Come back once the buffer being played has been consumed, the next ones keep the source busy meanwhile
+		ALint sampleOffset = 0;
+		alGetSourcei(m_source, AL_SAMPLE_OFFSET, &sampleOffset);
+
+		UInt32 chunkFrames = static_cast<UInt32>(m_impl->chunkSamples.size() / m_impl->stream->GetFormat());
+		UInt32 remainingFrames = chunkFrames - static_cast<UInt32>(sampleOffset) % chunkFrames;
+
+		// Paused musics are still checked from time to time, to notice when they resume
+		*nextUpdate = std::min<UInt32>(static_cast<UInt32>(1000ULL * remainingFrames / m_impl->sampleRate) + 5, 250);
+
+		return true;
 	}
 
 	MusicLoader::LoaderList Music::s_loaders;
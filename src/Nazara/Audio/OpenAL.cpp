@@ -16,6 +16,8 @@ namespace Nz
 	namespace
 	{
 		DynLib s_library;
+		OpenALFunc s_deferUpdates = nullptr; //< alDeferUpdatesSOFT, from AL_SOFT_deferred_updates
+		OpenALFunc s_processUpdates = nullptr; //< alProcessUpdatesSOFT
 		String s_deviceName;
 		String s_rendererName;
 		String s_vendorName;
@@ -57,6 +59,22 @@ namespace Nz
 	* \remark This class is meant to be used by Module Audio
 	*/
 
+	/*!
+	* \brief Starts batching the changes made to sources and listener
+	*
+	* OpenAL applies nothing until ProcessUpdates is called, so that changes made together are heard together
+	*
+	* \remark Uses AL_SOFT_deferred_updates when available, context suspension otherwise
+	*/
+
+	void OpenAL::DeferUpdates()
+	{
+		if (s_deferUpdates)
+			s_deferUpdates();
+		else if (s_context)
+			alcSuspendContext(s_context);
+	}
+
 	/*!
 	* \brief Gets the entry for the function name
 	* \return Pointer to the function
@@ -277,6 +295,18 @@ namespace Nz
 		return s_library.IsLoaded();
 	}
 
+	/*!
+	* \brief Applies at once the changes made since DeferUpdates
+	*/
+
+	void OpenAL::ProcessUpdates()
+	{
+		if (s_processUpdates)
+			s_processUpdates();
+		else if (s_context)
+			alcProcessContext(s_context);
+	}
+
 	/*!
 	* \brief Queries the input devices
 	* \return Number of devices
@@ -362,6 +392,9 @@ namespace Nz
 				s_context = nullptr;
 			}
 
+			s_deferUpdates = nullptr;
+			s_processUpdates = nullptr;
+
 			if (!alcCloseDevice(s_device))
 				// We could not close the close, this means that it's still in use
 				NazaraWarning("Failed to close device");
@@ -449,6 +482,17 @@ namespace Nz
 		else if (alIsExtensionPresent("AL_LOKI_quadriphonic"))
 			AudioFormat[AudioFormat_Quad] = alGetEnumValue("AL_FORMAT_QUAD16_LOKI");
 
+		if (alIsExtensionPresent("AL_SOFT_deferred_updates"))
+		{
+			s_deferUpdates = reinterpret_cast<OpenALFunc>(alGetProcAddress("alDeferUpdatesSOFT"));
+			s_processUpdates = reinterpret_cast<OpenALFunc>(alGetProcAddress("alProcessUpdatesSOFT"));
+			if (!s_deferUpdates || !s_processUpdates)
+			{
+				s_deferUpdates = nullptr;
+				s_processUpdates = nullptr;
+			}
+		}
+
 		return true;
 	}
 
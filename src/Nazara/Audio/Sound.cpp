@@ -6,7 +6,10 @@
 #include <Nazara/Audio/Audio.hpp>
 #include <Nazara/Audio/Config.hpp>
 #include <Nazara/Audio/OpenAL.hpp>
+#include <Nazara/Audio/VoiceManager.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
@@ -20,15 +23,34 @@ namespace Nz
 	* \brief Audio class that represents a sound
 	*
 	* \remark Module Audio needs to be initialized to use this class
+	* \remark Sounds are virtual voices: they only get an OpenAL source from the VoiceManager while they are among the most audible
 	*/
 
+	/*!
+	* \brief Constructs a Sound object
+	*/
+
+	Sound::Sound() :
+	SoundEmitter(false),
+	m_status(SoundStatus_Stopped),
+	m_offsetTime(0),
+	m_offset(0),
+	m_voiceIndex(InvalidVoice),
+	m_priority(0),
+	m_openALBuffer(AL_NONE),
+	m_decodedBufferAttached(false),
+	m_looping(false)
+	{
+	}
+
 	/*!
 	* \brief Constructs a Sound object
 	*
 	* \param soundBuffer Buffer to read sound from
 	*/
 
-	Sound::Sound(const SoundBuffer* soundBuffer)
+	Sound::Sound(const SoundBuffer* soundBuffer) :
+	Sound()
 	{
 		SetBuffer(soundBuffer);
 	}
@@ -40,7 +62,15 @@ namespace Nz
 	*/
 
 	Sound::Sound(const Sound& sound) :
-	SoundEmitter(sound)
+	SoundEmitter(sound),
+	m_status(SoundStatus_Stopped),
+	m_offsetTime(0),
+	m_offset(0),
+	m_voiceIndex(InvalidVoice),
+	m_priority(sound.m_priority),
+	m_openALBuffer(AL_NONE),
+	m_decodedBufferAttached(false),
+	m_looping(false)
 	{
 		SetBuffer(sound.m_buffer);
 	}
@@ -64,7 +94,17 @@ namespace Nz
 
 	void Sound::EnableLooping(bool loop)
 	{
-		alSourcei(m_source, AL_LOOPING, loop);
+		// The virtual offset wraps from now on
+		if (m_status == SoundStatus_Playing && !m_source)
+		{
+			m_offset = ComputeVirtualOffset();
+			m_offsetTime = GetElapsedMicroseconds();
+		}
+
+		m_looping = loop;
+
+		if (m_source)
+			alSourcei(m_source, AL_LOOPING, loop);
 	}
 
 	/*!
@@ -98,10 +138,29 @@ namespace Nz
 
 	UInt32 Sound::GetPlayingOffset() const
 	{
-		ALint samples = 0;
-		alGetSourcei(m_source, AL_SAMPLE_OFFSET, &samples);
+		if (m_source && m_status != SoundStatus_Stopped)
+		{
+			ALint samples = 0;
+			alGetSourcei(m_source, AL_SAMPLE_OFFSET, &samples);
+
+			return static_cast<UInt32>(1000ULL * samples / m_buffer->GetSampleRate());
+		}
+
+		// Without a source, playback keeps advancing with time
+		if (m_status == SoundStatus_Playing)
+			return ComputeVirtualOffset();
 
-		return static_cast<UInt32>(1000ULL * samples / m_buffer->GetSampleRate());
+		return m_offset;
+	}
+
+	/*!
+	* \brief Gets the priority of the sound
+	* \return Priority used to give sources to sounds, before their audibility
+	*/
+
+	int Sound::GetPriority() const
+	{
+		return m_priority;
 	}
 
 	/*!
@@ -111,7 +170,19 @@ namespace Nz
 
 	SoundStatus Sound::GetStatus() const
 	{
-		return GetInternalStatus();
+		if (m_status == SoundStatus_Playing)
+		{
+			// The sound may have reached its end since the last voice update
+			if (m_source)
+			{
+				if (GetInternalStatus() == SoundStatus_Stopped)
+					return SoundStatus_Stopped;
+			}
+			else if (!m_looping && ComputeVirtualOffset() >= m_buffer->GetDuration())
+				return SoundStatus_Stopped;
+		}
+
+		return m_status;
 	}
 
 	/*!
@@ -121,10 +192,7 @@ namespace Nz
 
 	bool Sound::IsLooping() const
 	{
-		ALint loop;
-		alGetSourcei(m_source, AL_LOOPING, &loop);
-
-		return loop != AL_FALSE;
+		return m_looping;
 	}
 
 	/*!
@@ -223,7 +291,15 @@ namespace Nz
 
 	void Sound::Pause()
 	{
-		alSourcePause(m_source);
+		if (GetStatus() != SoundStatus_Playing)
+			return;
+
+		m_offset = GetPlayingOffset();
+		m_offsetTime = GetElapsedMicroseconds();
+		m_status = SoundStatus_Paused;
+
+		if (m_source)
+			alSourcePause(m_source);
 	}
 
 	/*!
@@ -242,7 +318,50 @@ namespace Nz
 		}
 		#endif
 
-		alSourcePlay(m_source);
+		SoundStatus status = GetStatus();
+		if (status == SoundStatus_Paused)
+		{
+			m_offsetTime = GetElapsedMicroseconds();
+			m_status = SoundStatus_Playing;
+
+			if (m_source)
+			{
+				FlushParameters();
+				alSourcePlay(m_source);
+			}
+
+			return;
+		}
+
+		// Like OpenAL, playing a sound again restarts it, a stopped sound starts from the offset it was given
+		if (status == SoundStatus_Playing || m_status == SoundStatus_Playing)
+			m_offset = 0;
+
+		if (m_buffer->IsCompressed() && !m_decodedBufferAttached)
+		{
+			m_openALBuffer = m_buffer->AcquireOpenALBuffer();
+			if (m_openALBuffer == AL_NONE)
+			{
+				NazaraError("Failed to decode sound buffer");
+				return;
+			}
+
+			m_decodedBufferAttached = true;
+		}
+
+		m_offsetTime = GetElapsedMicroseconds();
+		m_status = SoundStatus_Playing;
+
+		if (m_voiceIndex == InvalidVoice)
+			VoiceManager::Register(this);
+		else if (m_source)
+		{
+			FlushParameters();
+			alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(m_offset / 1000.f * m_buffer->GetSampleRate()));
+			alSourcePlay(m_source);
+		}
+		else
+			VoiceManager::AttachVoice(this);
 	}
 
 	/*!
@@ -270,10 +389,11 @@ namespace Nz
 
 		m_buffer = buffer;
 
-		if (m_buffer)
-			alSourcei(m_source, AL_BUFFER, m_buffer->GetOpenALBuffer());
+		// Compressed buffers are decoded by Play
+		if (m_buffer && !m_buffer->IsCompressed())
+			m_openALBuffer = m_buffer->GetOpenALBuffer();
 		else
-			alSourcei(m_source, AL_BUFFER, AL_NONE);
+			m_openALBuffer = AL_NONE;
 	}
 
 	/*!
@@ -284,15 +404,66 @@ namespace Nz
 
 	void Sound::SetPlayingOffset(UInt32 offset)
 	{
-		alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(offset/1000.f * m_buffer->GetSampleRate()));
+		m_offset = offset;
+		m_offsetTime = GetElapsedMicroseconds();
+
+		if (m_source)
+			alSourcei(m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(offset/1000.f * m_buffer->GetSampleRate()));
+	}
+
+	/*!
+	* \brief Sets the priority of the sound
+	*
+	* \param priority Sounds with a higher priority get a source first, whatever their audibility
+	*
+	* \see VoiceManager::Update
+	*/
+
+	void Sound::SetPriority(int priority)
+	{
+		m_priority = priority;
 	}
 
 	/*!
 	* \brief Stops the sound
+	*
+	* \remark The source goes back to the voice pool, and the decoded samples of a compressed buffer can be evicted from the cache
 	*/
 
 	void Sound::Stop()
 	{
-		alSourceStop(m_source);
+		if (m_voiceIndex != InvalidVoice)
+			VoiceManager::Unregister(this);
+
+		m_offset = 0;
+		m_status = SoundStatus_Stopped;
+
+		if (m_decodedBufferAttached)
+		{
+			m_buffer->ReleaseOpenALBuffer();
+			m_openALBuffer = AL_NONE;
+
+			m_decodedBufferAttached = false;
+		}
+	}
+
+	/*!
+	* \brief Computes the offset of a playing sound without a source
+	* \return Offset in milliseconds, wrapped when looping and clamped to the duration otherwise
+	*/
+
+	UInt32 Sound::ComputeVirtualOffset() const
+	{
+		UInt64 elapsed = static_cast<UInt64>((GetElapsedMicroseconds() - m_offsetTime) * m_pitch / 1000.0);
+		UInt64 offset = m_offset + elapsed;
+
+		UInt32 duration = m_buffer->GetDuration();
+		if (duration == 0)
+			return 0;
+
+		if (m_looping)
+			return static_cast<UInt32>(offset % duration);
+		else
+			return static_cast<UInt32>(std::min<UInt64>(offset, duration));
 	}
 }
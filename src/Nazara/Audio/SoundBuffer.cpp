@@ -8,8 +8,10 @@
 #include <Nazara/Audio/OpenAL.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <cstring>
+#include <list>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 #include <Nazara/Audio/Debug.hpp>
 
 ///FIXME: Adapt the creation
@@ -34,14 +36,34 @@ namespace Nz
 		return true;
 	}
 
+	namespace
+	{
+		struct DecodedBuffer
+		{
+			const SoundBuffer* owner;
+			ALuint buffer;
+			std::size_t size;
+			unsigned int userCount;
+		};
+
+		// Most recently used first, buffers still attached to a sound are never evicted
+		std::list<DecodedBuffer> s_decodedBuffers;
+		std::size_t s_decodedCacheSize = NAZARA_AUDIO_DECODED_CACHE_SIZE;
+		std::size_t s_decodedMemoryUsage = 0;
+	}
+
 	struct SoundBufferImpl
 	{
 		ALuint buffer;
 		AudioFormat format;
 		UInt32 duration;
 		std::unique_ptr<Int16[]> samples;
+		std::list<DecodedBuffer>::iterator decodedBuffer;
+		std::vector<UInt8> compressedData;
+		SoundBuffer::Decoder decoder;
 		UInt32 sampleCount;
 		UInt32 sampleRate;
+		bool decoded = false;
 	};
 
 	/*!
@@ -161,6 +183,73 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Creates a SoundBuffer object keeping its samples encoded in memory
+	* \return true if creation is successful
+	*
+	* \param format Format of the decoded audio
+	* \param sampleCount Number of decoded samples
+	* \param sampleRate Rate of samples
+	* \param data Encoded data, copied by the sound buffer
+	* \param size Size of the encoded data
+	* \param decoder Function decoding the data into sampleCount samples
+	*
+	* \remark Samples are only decoded when a sound starts playing the buffer, and stay decoded while they fit in the decoded cache
+	* \remark Produces a NazaraError if parameters are invalid with NAZARA_AUDIO_SAFE defined
+	*
+	* \see SetDecodedCacheSize
+	*/
+
+	bool SoundBuffer::CreateCompressed(AudioFormat format, unsigned int sampleCount, unsigned int sampleRate, const void* data, std::size_t size, Decoder decoder)
+	{
+		Destroy();
+
+		#if NAZARA_AUDIO_SAFE
+		if (!IsFormatSupported(format))
+		{
+			NazaraError("Audio format is not supported");
+			return false;
+		}
+
+		if (sampleCount == 0)
+		{
+			NazaraError("Sample count must be different from zero");
+			return false;
+		}
+
+		if (sampleRate == 0)
+		{
+			NazaraError("Sample rate must be different from zero");
+			return false;
+		}
+
+		if (!data || size == 0)
+		{
+			NazaraError("Invalid compressed data");
+			return false;
+		}
+
+		if (!decoder)
+		{
+			NazaraError("Invalid decoder");
+			return false;
+		}
+		#endif
+
+		const UInt8* bytes = static_cast<const UInt8*>(data);
+
+		m_impl = new SoundBufferImpl;
+		m_impl->buffer = AL_NONE;
+		m_impl->compressedData.assign(bytes, bytes + size);
+		m_impl->decoder = std::move(decoder);
+		m_impl->duration = static_cast<UInt32>((1000ULL*sampleCount / (format * sampleRate)));
+		m_impl->format = format;
+		m_impl->sampleCount = sampleCount;
+		m_impl->sampleRate = sampleRate;
+
+		return true;
+	}
+
 	/*!
 	* \brief Destroys the current sound buffer and frees resources
 	*/
@@ -171,6 +260,16 @@ namespace Nz
 		{
 			OnSoundBufferDestroy(this);
 
+			if (m_impl->decoded)
+			{
+				DecodedBuffer& decodedBuffer = *m_impl->decodedBuffer;
+				NazaraAssert(decodedBuffer.userCount == 0, "Decoded buffer is still attached to a sound");
+
+				alDeleteBuffers(1, &decodedBuffer.buffer);
+				s_decodedMemoryUsage -= decodedBuffer.size;
+				s_decodedBuffers.erase(m_impl->decodedBuffer);
+			}
+
 			delete m_impl;
 			m_impl = nullptr;
 		}
@@ -216,9 +315,26 @@ namespace Nz
 		return m_impl->format;
 	}
 
+	/*!
+	* \brief Gets the memory used by the samples
+	* \return Size in bytes, 0 if there is no sound buffer
+	*/
+
+	std::size_t SoundBuffer::GetMemoryUsage() const
+	{
+		if (!m_impl)
+			return 0;
+
+		// Decoded samples of a compressed buffer belong to the decoded cache
+		if (!m_impl->compressedData.empty())
+			return m_impl->compressedData.size();
+
+		return m_impl->sampleCount * sizeof(Int16);
+	}
+
 	/*!
 	* \brief Gets the internal raw samples
-	* \return Pointer to raw data
+	* \return Pointer to raw data, nullptr if the buffer is compressed
 	*
 	* \remark Produces a NazaraError if there is no sound buffer with NAZARA_AUDIO_SAFE defined
 	*/
@@ -276,6 +392,26 @@ namespace Nz
 		return m_impl->sampleRate;
 	}
 
+	/*!
+	* \brief Checks whether the sound buffer keeps its samples encoded
+	* \return true if it is the case
+	*/
+
+	bool SoundBuffer::IsCompressed() const
+	{
+		return m_impl && !m_impl->compressedData.empty();
+	}
+
+	/*!
+	* \brief Checks whether the samples of a compressed sound buffer are currently decoded
+	* \return true if it is the case, or if the sound buffer is not compressed
+	*/
+
+	bool SoundBuffer::IsDecoded() const
+	{
+		return m_impl && (m_impl->compressedData.empty() || m_impl->decoded);
+	}
+
 	/*!
 	* \brief Checks whether the sound buffer is valid
 	* \return true if it is the case
@@ -326,6 +462,28 @@ namespace Nz
 		return SoundBufferLoader::LoadFromStream(this, stream, params);
 	}
 
+	/*!
+	* \brief Gets the amount of memory decoded compressed buffers may keep
+	* \return Size in bytes
+	*/
+
+	std::size_t SoundBuffer::GetDecodedCacheSize()
+	{
+		return s_decodedCacheSize;
+	}
+
+	/*!
+	* \brief Gets the memory currently used by decoded compressed buffers
+	* \return Size in bytes
+	*
+	* \remark Can exceed the decoded cache size while sounds are playing
+	*/
+
+	std::size_t SoundBuffer::GetDecodedMemoryUsage()
+	{
+		return s_decodedMemoryUsage;
+	}
+
 	/*!
 	* \brief Checks whether the format is supported by the engine
 	* \return true if it is the case
@@ -338,6 +496,83 @@ namespace Nz
 		return Audio::IsFormatSupported(format);
 	}
 
+	/*!
+	* \brief Sets the amount of memory decoded compressed buffers may keep
+	*
+	* \param size Size in bytes, least recently played buffers are freed beyond it
+	*/
+
+	void SoundBuffer::SetDecodedCacheSize(std::size_t size)
+	{
+		s_decodedCacheSize = size;
+
+		EvictDecodedBuffers(0);
+	}
+
+	/*!
+	* \brief Gets the OpenAL buffer a sound must play, decoding the samples if needed
+	* \return The index of the OpenAL buffer, AL_NONE if decoding failed
+	*
+	* \remark Every call must be matched by a call to ReleaseOpenALBuffer
+	*/
+
+	unsigned int SoundBuffer::AcquireOpenALBuffer() const
+	{
+		NazaraAssert(m_impl, "Sound buffer not created");
+
+		if (m_impl->compressedData.empty())
+			return m_impl->buffer;
+
+		if (m_impl->decoded)
+		{
+			s_decodedBuffers.splice(s_decodedBuffers.begin(), s_decodedBuffers, m_impl->decodedBuffer);
+
+			DecodedBuffer& decodedBuffer = *m_impl->decodedBuffer;
+			decodedBuffer.userCount++;
+
+			return decodedBuffer.buffer;
+		}
+
+		std::size_t size = m_impl->sampleCount * sizeof(Int16);
+		EvictDecodedBuffers(size);
+
+		std::unique_ptr<Int16[]> samples(new Int16[m_impl->sampleCount]);
+		if (!m_impl->decoder(m_impl->compressedData.data(), m_impl->compressedData.size(), samples.get(), m_impl->sampleCount))
+		{
+			NazaraError("Failed to decode sound buffer");
+			return AL_NONE;
+		}
+
+		// We empty the error stack
+		while (alGetError() != AL_NO_ERROR);
+
+		ALuint buffer;
+		alGenBuffers(1, &buffer);
+		alBufferData(buffer, OpenAL::AudioFormat[m_impl->format], samples.get(), static_cast<ALsizei>(size), m_impl->sampleRate);
+
+		if (alGetError() != AL_NO_ERROR)
+		{
+			alDeleteBuffers(1, &buffer);
+
+			NazaraError("Failed to set OpenAL buffer");
+			return AL_NONE;
+		}
+
+		DecodedBuffer decodedBuffer;
+		decodedBuffer.buffer = buffer;
+		decodedBuffer.owner = this;
+		decodedBuffer.size = size;
+		decodedBuffer.userCount = 1;
+
+		s_decodedBuffers.push_front(decodedBuffer);
+		s_decodedMemoryUsage += size;
+
+		m_impl->decodedBuffer = s_decodedBuffers.begin();
+		m_impl->decoded = true;
+
+		return buffer;
+	}
+
 	/*!
 	* \brief Gets the internal OpenAL buffer
 	* \return The index of the OpenAL buffer
@@ -358,6 +593,54 @@ namespace Nz
 		return m_impl->buffer;
 	}
 
+	/*!
+	* \brief Tells the sound buffer a sound no longer plays the buffer returned by AcquireOpenALBuffer
+	*
+	* \remark The decoded samples stay in the cache until they get evicted
+	*/
+
+	void SoundBuffer::ReleaseOpenALBuffer() const
+	{
+		NazaraAssert(m_impl, "Sound buffer not created");
+
+		if (!m_impl->decoded)
+			return;
+
+		DecodedBuffer& decodedBuffer = *m_impl->decodedBuffer;
+		NazaraAssert(decodedBuffer.userCount > 0, "Decoded buffer is not in use");
+
+		decodedBuffer.userCount--;
+
+		// The cache may have grown over its size while every decoded buffer was in use
+		if (decodedBuffer.userCount == 0)
+			EvictDecodedBuffers(0);
+	}
+
+	/*!
+	* \brief Frees the least recently played decoded buffers until requiredSize bytes fit in the cache
+	*
+	* \param requiredSize Size of the buffer about to be decoded
+	*/
+
+	void SoundBuffer::EvictDecodedBuffers(std::size_t requiredSize)
+	{
+		auto it = s_decodedBuffers.end();
+		while (it != s_decodedBuffers.begin() && s_decodedMemoryUsage + requiredSize > s_decodedCacheSize)
+		{
+			--it;
+
+			DecodedBuffer& decodedBuffer = *it;
+			if (decodedBuffer.userCount > 0)
+				continue;
+
+			alDeleteBuffers(1, &decodedBuffer.buffer);
+			decodedBuffer.owner->m_impl->decoded = false;
+			s_decodedMemoryUsage -= decodedBuffer.size;
+
+			it = s_decodedBuffers.erase(it);
+		}
+	}
+
 	/*!
 	* \brief Initializes the libraries and managers
 	* \return true if initialization is successful
@@ -388,12 +671,22 @@ namespace Nz
 
 	void SoundBuffer::Uninitialize()
 	{
+		for (DecodedBuffer& decodedBuffer : s_decodedBuffers)
+		{
+			alDeleteBuffers(1, &decodedBuffer.buffer);
+			decodedBuffer.owner->m_impl->decoded = false;
+		}
+		s_decodedBuffers.clear();
+		s_decodedMemoryUsage = 0;
+
 		SoundBufferManager::Uninitialize();
 		SoundBufferLibrary::Uninitialize();
 	}
 
 	SoundBufferLibrary::LibraryMap SoundBuffer::s_library;
 	SoundBufferLoader::LoaderList SoundBuffer::s_loaders;
+	SoundBufferManager::ManagerCache SoundBuffer::s_managerCache;
+	SoundBufferManager::ManagerLoads SoundBuffer::s_managerLoads;
 	SoundBufferManager::ManagerMap SoundBuffer::s_managerMap;
 	SoundBufferManager::ManagerParams SoundBuffer::s_managerParameters;
 }
@@ -18,15 +18,36 @@ namespace Nz
 	*
 	* \remark Module Audio needs to be initialized to use this class
 	* \remark This class is abstract
+	* \remark Settings changed while the emitter has a source are sent to OpenAL by the next Audio::Update (or Play), emitters left unchanged cost nothing there
 	*/
 
 	/*!
 	* \brief Constructs a SoundEmitter object
+	*
+	* \param ownSource Whether the emitter creates its own OpenAL source, or gets one from the voice pool when needed
+	*
+	* \remark Emitter settings are kept even without a source, and applied to every source it gets
 	*/
 
-	SoundEmitter::SoundEmitter()
+	SoundEmitter::SoundEmitter(bool ownSource) :
+	m_source(0),
+	m_position(Vector3f::Zero()),
+	m_velocity(Vector3f::Zero()),
+	m_attenuation(1.f),
+	m_minDistance(1.f),
+	m_pitch(1.f),
+	m_volume(100.f),
+	m_ownsSource(ownSource),
+	m_spatialized(true),
+	m_dirtyParameters(0)
 	{
-		alGenSources(1, &m_source);
+		if (m_ownsSource)
+		{
+			ALuint source;
+			alGenSources(1, &source);
+
+			AttachSource(source);
+		}
 	}
 
 	/*!
@@ -37,24 +58,40 @@ namespace Nz
 	* \remark Position and velocity are not copied
 	*/
 
-	SoundEmitter::SoundEmitter(const SoundEmitter& emitter)
+	SoundEmitter::SoundEmitter(const SoundEmitter& emitter) :
+	m_source(0),
+	m_position(Vector3f::Zero()),
+	m_velocity(Vector3f::Zero()),
+	m_attenuation(emitter.m_attenuation),
+	m_minDistance(emitter.m_minDistance),
+	m_pitch(emitter.m_pitch),
+	m_volume(emitter.m_volume),
+	m_ownsSource(emitter.m_ownsSource),
+	m_spatialized(true),
+	m_dirtyParameters(0)
 	{
-		alGenSources(1, &m_source);
-
-		SetAttenuation(emitter.GetAttenuation());
-		SetMinDistance(emitter.GetMinDistance());
-		SetPitch(emitter.GetPitch());
 		// No copy for position or velocity
-		SetVolume(emitter.GetVolume());
+		if (m_ownsSource)
+		{
+			ALuint source;
+			alGenSources(1, &source);
+
+			AttachSource(source);
+		}
 	}
 
 	/*!
 	* \brief Destructs the object
+	*
+	* \remark Pooled sources must have been detached by the derived class
 	*/
 
 	SoundEmitter::~SoundEmitter()
 	{
-		alDeleteSources(1, &m_source);
+		ValidateParameters();
+
+		if (m_ownsSource)
+			alDeleteSources(1, &m_source);
 	}
 
 	/*!
@@ -65,7 +102,10 @@ namespace Nz
 
 	void SoundEmitter::EnableSpatialization(bool spatialization)
 	{
-		alSourcei(m_source, AL_SOURCE_RELATIVE, !spatialization);
+		m_spatialized = spatialization;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Spatialization);
 	}
 
 	/*!
@@ -75,10 +115,7 @@ namespace Nz
 
 	float SoundEmitter::GetAttenuation() const
 	{
-		ALfloat attenuation;
-		alGetSourcef(m_source, AL_ROLLOFF_FACTOR, &attenuation);
-
-		return attenuation;
+		return m_attenuation;
 	}
 
 	/*!
@@ -88,10 +125,7 @@ namespace Nz
 
 	float SoundEmitter::GetMinDistance() const
 	{
-		ALfloat distance;
-		alGetSourcef(m_source, AL_REFERENCE_DISTANCE, &distance);
-
-		return distance;
+		return m_minDistance;
 	}
 
 	/*!
@@ -101,10 +135,7 @@ namespace Nz
 
 	float SoundEmitter::GetPitch() const
 	{
-		ALfloat pitch;
-		alGetSourcef(m_source, AL_PITCH, &pitch);
-
-		return pitch;
+		return m_pitch;
 	}
 
 	/*!
@@ -114,10 +145,7 @@ namespace Nz
 
 	Vector3f SoundEmitter::GetPosition() const
 	{
-		Vector3f position;
-		alGetSourcefv(m_source, AL_POSITION, position);
-
-		return position;
+		return m_position;
 	}
 
 	/*!
@@ -127,10 +155,7 @@ namespace Nz
 
 	Vector3f SoundEmitter::GetVelocity() const
 	{
-		Vector3f velocity;
-		alGetSourcefv(m_source, AL_VELOCITY, velocity);
-
-		return velocity;
+		return m_velocity;
 	}
 
 	/*!
@@ -140,10 +165,7 @@ namespace Nz
 
 	float SoundEmitter::GetVolume() const
 	{
-		ALfloat gain;
-		alGetSourcef(m_source, AL_GAIN, &gain);
-
-		return gain * 100.f;
+		return m_volume;
 	}
 
 	/*!
@@ -153,10 +175,7 @@ namespace Nz
 
 	bool SoundEmitter::IsSpatialized() const
 	{
-		ALint relative;
-		alGetSourcei(m_source, AL_SOURCE_RELATIVE, &relative);
-
-		return relative == AL_FALSE;
+		return m_spatialized;
 	}
 
 	/*!
@@ -167,7 +186,10 @@ namespace Nz
 
 	void SoundEmitter::SetAttenuation(float attenuation)
 	{
-		alSourcef(m_source, AL_ROLLOFF_FACTOR, attenuation);
+		m_attenuation = attenuation;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Attenuation);
 	}
 
 	/*!
@@ -178,7 +200,10 @@ namespace Nz
 
 	void SoundEmitter::SetMinDistance(float minDistance)
 	{
-		alSourcef(m_source, AL_REFERENCE_DISTANCE, minDistance);
+		m_minDistance = minDistance;
+
+		if (m_source)
+			InvalidateParameter(Parameter_MinDistance);
 	}
 
 	/*!
@@ -189,7 +214,10 @@ namespace Nz
 
 	void SoundEmitter::SetPitch(float pitch)
 	{
-		alSourcef(m_source, AL_PITCH, pitch);
+		m_pitch = pitch;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Pitch);
 	}
 
 	/*!
@@ -200,7 +228,10 @@ namespace Nz
 
 	void SoundEmitter::SetPosition(const Vector3f& position)
 	{
-		alSourcefv(m_source, AL_POSITION, position);
+		m_position = position;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Position);
 	}
 
 	/*!
@@ -211,7 +242,7 @@ namespace Nz
 
 	void SoundEmitter::SetPosition(float x, float y, float z)
 	{
-		alSource3f(m_source, AL_POSITION, x, y, z);
+		SetPosition(Vector3f(x, y, z));
 	}
 
 	/*!
@@ -222,7 +253,10 @@ namespace Nz
 
 	void SoundEmitter::SetVelocity(const Vector3f& velocity)
 	{
-		alSourcefv(m_source, AL_VELOCITY, velocity);
+		m_velocity = velocity;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Velocity);
 	}
 
 	/*!
@@ -233,7 +267,7 @@ namespace Nz
 
 	void SoundEmitter::SetVelocity(float velX, float velY, float velZ)
 	{
-		alSource3f(m_source, AL_VELOCITY, velX, velY, velZ);
+		SetVelocity(Vector3f(velX, velY, velZ));
 	}
 
 	/*!
@@ -244,7 +278,85 @@ namespace Nz
 
 	void SoundEmitter::SetVolume(float volume)
 	{
-		alSourcef(m_source, AL_GAIN, volume * 0.01f);
+		m_volume = volume;
+
+		if (m_source)
+			InvalidateParameter(Parameter_Volume);
+	}
+
+	/*!
+	* \brief Gives a source to the emitter and applies its settings to it
+	*
+	* \param source OpenAL source
+	*/
+
+	void SoundEmitter::AttachSource(unsigned int source)
+	{
+		NazaraAssert(m_source == 0, "Emitter already has a source");
+
+		m_source = source;
+
+		// Everything is applied below, pending changes would only be sent twice
+		ValidateParameters();
+
+		alSourcef(m_source, AL_GAIN, m_volume * 0.01f);
+		alSourcef(m_source, AL_PITCH, m_pitch);
+		alSourcef(m_source, AL_REFERENCE_DISTANCE, m_minDistance);
+		alSourcef(m_source, AL_ROLLOFF_FACTOR, m_attenuation);
+		alSourcefv(m_source, AL_POSITION, m_position);
+		alSourcefv(m_source, AL_VELOCITY, m_velocity);
+		alSourcei(m_source, AL_SOURCE_RELATIVE, !m_spatialized);
+	}
+
+	/*!
+	* \brief Takes the source back from the emitter
+	* \return The OpenAL source the emitter had
+	*/
+
+	unsigned int SoundEmitter::DetachSource()
+	{
+		// The next source gets every setting on attachment
+		ValidateParameters();
+
+		unsigned int source = m_source;
+		m_source = 0;
+
+		return source;
+	}
+
+	/*!
+	* \brief Sends the settings changed since the last update to the source
+	*
+	* \remark Derived classes call this before starting the source, so that it never plays with outdated settings
+	*/
+
+	void SoundEmitter::FlushParameters()
+	{
+		if (m_dirtyParameters == 0)
+			return;
+
+		if (m_dirtyParameters & Parameter_Attenuation)
+			alSourcef(m_source, AL_ROLLOFF_FACTOR, m_attenuation);
+
+		if (m_dirtyParameters & Parameter_MinDistance)
+			alSourcef(m_source, AL_REFERENCE_DISTANCE, m_minDistance);
+
+		if (m_dirtyParameters & Parameter_Pitch)
+			alSourcef(m_source, AL_PITCH, m_pitch);
+
+		if (m_dirtyParameters & Parameter_Position)
+			alSourcefv(m_source, AL_POSITION, m_position);
+
+		if (m_dirtyParameters & Parameter_Spatialization)
+			alSourcei(m_source, AL_SOURCE_RELATIVE, !m_spatialized);
+
+		if (m_dirtyParameters & Parameter_Velocity)
+			alSourcefv(m_source, AL_VELOCITY, m_velocity);
+
+		if (m_dirtyParameters & Parameter_Volume)
+			alSourcef(m_source, AL_GAIN, m_volume * 0.01f);
+
+		ValidateParameters();
 	}
 
 	/*!
@@ -254,6 +366,9 @@ namespace Nz
 
 	SoundStatus SoundEmitter::GetInternalStatus() const
 	{
+		if (!m_source)
+			return SoundStatus_Stopped;
+
 		ALint state;
 		alGetSourcei(m_source, AL_SOURCE_STATE, &state);
 
@@ -275,4 +390,61 @@ namespace Nz
 
 		return SoundStatus_Stopped;
 	}
+
+	/*!
+	* \brief Marks a setting as changed, registering the emitter for the next update
+	*
+	* \param parameter Setting to send to the source
+	*/
+
+	void SoundEmitter::InvalidateParameter(Parameter parameter)
+	{
+		if (m_dirtyParameters == 0)
+		{
+			m_dirtyIndex = s_dirtyEmitters.size();
+			s_dirtyEmitters.push_back(this);
+		}
+
+		m_dirtyParameters |= parameter;
+	}
+
+	/*!
+	* \brief Clears the changed settings, unregistering the emitter from the next update
+	*/
+
+	void SoundEmitter::ValidateParameters()
+	{
+		if (m_dirtyParameters == 0)
+			return;
+
+		// Swap with the last dirty emitter
+		SoundEmitter* lastEmitter = s_dirtyEmitters.back();
+		s_dirtyEmitters[m_dirtyIndex] = lastEmitter;
+		lastEmitter->m_dirtyIndex = m_dirtyIndex;
+		s_dirtyEmitters.pop_back();
+
+		m_dirtyParameters = 0;
+	}
+
+	/*!
+	* \brief Sends the changed settings of every emitter to their sources
+	*
+	* \remark OpenAL applies them all at once, see OpenAL::DeferUpdates
+	*/
+
+	void SoundEmitter::FlushAllParameters()
+	{
+		if (s_dirtyEmitters.empty())
+			return;
+
+		OpenAL::DeferUpdates();
+
+		// FlushParameters removes the emitter from the list
+		while (!s_dirtyEmitters.empty())
+			s_dirtyEmitters.back()->FlushParameters();
+
+		OpenAL::ProcessUpdates();
+	}
+
+	std::vector<SoundEmitter*> SoundEmitter::s_dirtyEmitters;
 }
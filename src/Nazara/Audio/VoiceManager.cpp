@@ -0,0 +1,311 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/VoiceManager.hpp>
+#include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/OpenAL.hpp>
+#include <Nazara/Audio/Sound.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <vector>
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct VoiceScore
+		{
+			Sound* sound;
+			float audibility;
+			int priority;
+		};
+
+		std::vector<ALuint> s_freeSources;
+		std::vector<ALuint> s_sources;
+		std::vector<Sound*> s_finishedVoices;
+		std::vector<Sound*> s_voices;
+		std::vector<VoiceScore> s_scores;
+
+		float ComputeAudibility(const Sound* sound, const Vector3f& listenerPosition)
+		{
+			// Paused sounds are the first to give their source away
+			if (sound->GetStatus() != SoundStatus_Playing)
+				return -1.f;
+
+			float distance = (sound->IsSpatialized()) ? sound->GetPosition().Distance(listenerPosition) : sound->GetPosition().GetLength();
+
+			// Same model as OpenAL default one (AL_INVERSE_DISTANCE_CLAMPED)
+			float minDistance = sound->GetMinDistance();
+			float attenuation = minDistance + sound->GetAttenuation() * (std::max(distance, minDistance) - minDistance);
+			float gain = (attenuation > 0.f) ? minDistance / attenuation : 1.f;
+
+			return gain * sound->GetVolume();
+		}
+
+		void ReleaseFinishedVoices()
+		{
+			s_finishedVoices.clear();
+			for (Sound* sound : s_voices)
+			{
+				if (sound->GetStatus() == SoundStatus_Stopped)
+					s_finishedVoices.push_back(sound);
+			}
+
+			// Stop unregisters the voice, hence the copy
+			for (Sound* sound : s_finishedVoices)
+				sound->Stop();
+		}
+	}
+
+	/*!
+	* \ingroup audio
+	* \class Nz::VoiceManager
+	* \brief Audio class that shares a pool of OpenAL sources between all sounds
+	*
+	* Playing sounds are virtual voices: only the most audible ones get a source and are mixed,
+	* the other ones keep advancing their playing offset until they get a source back
+	*/
+
+	/*!
+	* \brief Gets the number of sounds currently owning a source
+	* \return Number of real voices
+	*/
+
+	std::size_t VoiceManager::GetRealVoiceCount()
+	{
+		return s_sources.size() - s_freeSources.size();
+	}
+
+	/*!
+	* \brief Gets the number of sources shared by sounds
+	* \return Size of the source pool
+	*/
+
+	std::size_t VoiceManager::GetSourceCount()
+	{
+		return s_sources.size();
+	}
+
+	/*!
+	* \brief Gets the number of playing or paused sounds
+	* \return Number of voices, virtual or not
+	*/
+
+	std::size_t VoiceManager::GetVoiceCount()
+	{
+		return s_voices.size();
+	}
+
+	/*!
+	* \brief Gives the sources to the most audible sounds
+	*
+	* Sounds are sorted by priority, then by their volume attenuated by their distance to the listener
+	*
+	* \remark Should be called once per frame, after the listener has moved
+	*/
+
+	void VoiceManager::Update()
+	{
+		ReleaseFinishedVoices();
+
+		if (s_voices.size() > s_sources.size())
+		{
+			Vector3f listenerPosition = Audio::GetListenerPosition();
+
+			s_scores.clear();
+			for (Sound* sound : s_voices)
+			{
+				VoiceScore score;
+				score.audibility = ComputeAudibility(sound, listenerPosition);
+				score.priority = sound->GetPriority();
+				score.sound = sound;
+
+				s_scores.push_back(score);
+			}
+
+			auto lastReal = s_scores.begin() + s_sources.size();
+			std::nth_element(s_scores.begin(), lastReal, s_scores.end(), [] (const VoiceScore& lhs, const VoiceScore& rhs)
+			{
+				if (lhs.priority != rhs.priority)
+					return lhs.priority > rhs.priority;
+
+				return lhs.audibility > rhs.audibility;
+			});
+
+			// Sources must be freed before being given to the sounds taking them over
+			for (auto it = lastReal; it != s_scores.end(); ++it)
+			{
+				if (it->sound->m_source)
+					DetachVoice(it->sound);
+			}
+
+			for (auto it = s_scores.begin(); it != lastReal; ++it)
+			{
+				if (!it->sound->m_source)
+					AttachVoice(it->sound);
+			}
+		}
+		else
+		{
+			for (Sound* sound : s_voices)
+			{
+				if (!sound->m_source)
+					AttachVoice(sound);
+			}
+		}
+	}
+
+	/*!
+	* \brief Gives a free source to a sound and resumes its playback on it
+	* \return true if a source was available
+	*
+	* \param sound Sound to attach
+	*/
+
+	bool VoiceManager::AttachVoice(Sound* sound)
+	{
+		NazaraAssert(!sound->m_source, "Sound already has a source");
+
+		// Sounds which reached their end may still hold a source
+		if (s_freeSources.empty())
+			ReleaseFinishedVoices();
+
+		if (s_freeSources.empty())
+			return false;
+
+		UInt32 offset = sound->GetPlayingOffset();
+
+		sound->AttachSource(s_freeSources.back());
+		s_freeSources.pop_back();
+
+		alSourcei(sound->m_source, AL_BUFFER, sound->m_openALBuffer);
+		alSourcei(sound->m_source, AL_LOOPING, sound->m_looping);
+		alSourcei(sound->m_source, AL_SAMPLE_OFFSET, static_cast<ALint>(offset / 1000.f * sound->m_buffer->GetSampleRate()));
+
+		// A paused sound keeps the source in its initial state, the offset is applied once it resumes
+		if (sound->m_status == SoundStatus_Playing)
+			alSourcePlay(sound->m_source);
+
+		return true;
+	}
+
+	/*!
+	* \brief Takes the source back from a sound, which keeps playing virtually
+	*
+	* \param sound Sound to detach
+	*/
+
+	void VoiceManager::DetachVoice(Sound* sound)
+	{
+		NazaraAssert(sound->m_source, "Sound has no source");
+
+		if (sound->m_status != SoundStatus_Stopped)
+		{
+			sound->m_offset = sound->GetPlayingOffset();
+			sound->m_offsetTime = GetElapsedMicroseconds();
+		}
+
+		unsigned int source = sound->DetachSource();
+		alSourceStop(source);
+		alSourcei(source, AL_BUFFER, AL_NONE);
+
+		s_freeSources.push_back(source);
+	}
+
+	/*!
+	* \brief Creates the source pool
+	* \return true if at least one source could be created
+	*
+	* \param maxSourceCount Maximum number of sources, less are created if OpenAL runs out of them
+	*/
+
+	bool VoiceManager::Initialize(unsigned int maxSourceCount)
+	{
+		// We empty the error stack
+		while (alGetError() != AL_NO_ERROR);
+
+		s_sources.reserve(maxSourceCount);
+		for (unsigned int i = 0; i < maxSourceCount; ++i)
+		{
+			ALuint source;
+			alGenSources(1, &source);
+
+			if (alGetError() != AL_NO_ERROR)
+				break;
+
+			s_sources.push_back(source);
+		}
+
+		if (s_sources.empty())
+		{
+			NazaraError("Failed to create sources");
+			return false;
+		}
+
+		s_freeSources = s_sources;
+
+		return true;
+	}
+
+	/*!
+	* \brief Adds a sound starting to play, and gives it a source if one is free
+	*
+	* \param sound Sound to add
+	*/
+
+	void VoiceManager::Register(Sound* sound)
+	{
+		NazaraAssert(sound->m_voiceIndex == Sound::InvalidVoice, "Sound is already registered");
+
+		sound->m_voiceIndex = s_voices.size();
+		s_voices.push_back(sound);
+
+		AttachVoice(sound);
+	}
+
+	/*!
+	* \brief Removes a stopped sound, its source goes back to the pool
+	*
+	* \param sound Sound to remove
+	*/
+
+	void VoiceManager::Unregister(Sound* sound)
+	{
+		NazaraAssert(sound->m_voiceIndex < s_voices.size() && s_voices[sound->m_voiceIndex] == sound, "Sound is not registered");
+
+		if (sound->m_source)
+			DetachVoice(sound);
+
+		Sound* lastSound = s_voices.back();
+		lastSound->m_voiceIndex = sound->m_voiceIndex;
+		s_voices[sound->m_voiceIndex] = lastSound;
+		s_voices.pop_back();
+
+		sound->m_voiceIndex = Sound::InvalidVoice;
+	}
+
+	/*!
+	* \brief Takes every source back and destroys the pool
+	*/
+
+	void VoiceManager::Uninitialize()
+	{
+		for (Sound* sound : s_voices)
+		{
+			if (sound->m_source)
+				DetachVoice(sound);
+
+			sound->m_voiceIndex = Sound::InvalidVoice;
+		}
+		s_voices.clear();
+
+		if (!s_sources.empty())
+			alDeleteSources(static_cast<ALsizei>(s_sources.size()), s_sources.data());
+
+		s_freeSources.clear();
+		s_sources.clear();
+	}
+}
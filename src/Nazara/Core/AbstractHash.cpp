@@ -13,6 +13,7 @@
 #include <Nazara/Core/Hash/SHA384.hpp>
 #include <Nazara/Core/Hash/SHA512.hpp>
 #include <Nazara/Core/Hash/Whirlpool.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -68,6 +69,9 @@ namespace Nz
 
 			case HashType_Whirlpool:
 				return std::make_unique<HashWhirlpool>();
+
+			case HashType_XXHash64:
+				return std::make_unique<HashXXHash64>();
 		}
 
 		NazaraInternalError("Hash type not handled (0x" + String::Number(type, 16) + ')');
@@ -0,0 +1,424 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ExclusiveLockGuard.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/SharedLockGuard.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		std::atomic<UInt64> s_nextLoggerId(1);
+
+		// Last queue used by this thread, the loggers are identified by an id as their address may be reused
+		thread_local UInt64 t_producerLoggerId = 0;
+		thread_local void* t_producerQueue = nullptr;
+
+		thread_local UInt64 t_consumerLoggerId = 0;
+	}
+
+	struct AsyncLogger::Entry
+	{
+		String message;
+		const char* file = nullptr;
+		const char* function = nullptr;
+		unsigned int line = 0;
+		ErrorType type = ErrorType_Normal;
+		bool isError = false;
+	};
+
+	struct AsyncLogger::ProducerQueue
+	{
+		ProducerQueue(std::size_t capacity) :
+		entries(new Entry[capacity]),
+		mask(capacity - 1),
+		producerThread(std::this_thread::get_id()),
+		head(0),
+		tail(0)
+		{
+		}
+
+		std::unique_ptr<Entry[]> entries;
+		std::size_t mask;
+		std::thread::id producerThread;
+
+		// Written by the background thread and by the producer thread respectively, kept on different cache lines
+		// Padded rather than aligned, as new does not honour an extended alignment before C++17
+		UInt8 headPadding[64];
+		std::atomic<std::size_t> head;
+		UInt8 tailPadding[64];
+		std::atomic<std::size_t> tail;
+		UInt8 endPadding[64];
+	};
+
+	/*!
+	* \ingroup core
+	* \class Nz::AsyncLogger
+	* \brief Core class that represents a logger writing through another one on a background thread
+	*
+	* Each writing thread pushes its entries into its own lock-free ring buffer, the background thread then
+	* hands them to the wrapped logger, which formats and writes them. Entries of a same thread keep their order.
+	*
+	* When a ring buffer is full, the overflow policy tells whether the writing thread waits or drops the entry.
+	* Dropped entries are reported by a warning once there is room again.
+	*
+	* \remark The ring buffer of a thread is kept until the logger is destroyed
+	*/
+
+	/*!
+	* \brief Constructs an AsyncLogger object writing through another logger
+	*
+	* \param logger Logger used by the background thread, the AsyncLogger takes ownership of it
+	* \param overflowPolicy What to do when the ring buffer of a thread is full
+	* \param queueCapacity Number of entries of the ring buffer of each thread, rounded up to a power of two
+	*/
+
+	AsyncLogger::AsyncLogger(AbstractLogger* logger, LogOverflowPolicy overflowPolicy, std::size_t queueCapacity) :
+	m_overflowPolicy(overflowPolicy),
+	m_droppedCount(0),
+	m_consumerSleeping(false),
+	m_shouldStop(false),
+	m_queueCapacity(GetNearestPowerOfTwo(std::max<std::size_t>(queueCapacity, 2))),
+	m_logger(logger),
+	m_id(s_nextLoggerId++),
+	m_thread(&AsyncLogger::ThreadProc, this)
+	{
+		NazaraAssert(logger, "Invalid logger");
+	}
+
+	/*!
+	* \brief Destructs the object, writing the remaining entries
+	*
+	* \remark No other thread should write into the logger at this point
+	*/
+
+	AsyncLogger::~AsyncLogger()
+	{
+		m_shouldStop.store(true, std::memory_order_release);
+		WakeConsumer();
+
+		m_thread.Join();
+	}
+
+	/*!
+	* \brief Enables the replication to the stdout of the wrapped logger
+	*
+	* \param enable If true, enables the replication
+	*/
+
+	void AsyncLogger::EnableStdReplication(bool enable)
+	{
+		m_logger->EnableStdReplication(enable);
+	}
+
+	/*!
+	* \brief Waits until every entry written before this call has been handed to the wrapped logger
+	*/
+
+	void AsyncLogger::Flush()
+	{
+		if (t_consumerLoggerId == m_id)
+			return; // Entries of the background thread are written right away
+
+		std::vector<std::pair<ProducerQueue*, std::size_t>> targets;
+		{
+			SharedLockGuard lock(m_queueMutex);
+
+			targets.reserve(m_queues.size());
+			for (const auto& queue : m_queues)
+				targets.emplace_back(queue.get(), queue->tail.load(std::memory_order_acquire));
+		}
+
+		for (const auto& target : targets)
+		{
+			while (target.first->head.load(std::memory_order_acquire) < target.second)
+			{
+				WakeConsumer();
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	/*!
+	* \brief Gets the number of entries dropped because of a full ring buffer
+	* \return Dropped entry count since the construction of the logger
+	*/
+
+	UInt64 AsyncLogger::GetDroppedCount() const
+	{
+		return m_droppedCount.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Gets the wrapped logger
+	* \return Logger used by the background thread
+	*/
+
+	AbstractLogger* AsyncLogger::GetLogger() const
+	{
+		return m_logger.get();
+	}
+
+	/*!
+	* \brief Gets the overflow policy
+	* \return What happens when the ring buffer of a thread is full
+	*/
+
+	LogOverflowPolicy AsyncLogger::GetOverflowPolicy() const
+	{
+		return m_overflowPolicy.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Checks whether or not the replication to the stdout of the wrapped logger is enabled
+	* \return true If replication is enabled
+	*/
+
+	bool AsyncLogger::IsStdReplicationEnabled()
+	{
+		return m_logger->IsStdReplicationEnabled();
+	}
+
+	/*!
+	* \brief Sets the overflow policy
+	*
+	* \param overflowPolicy What happens when the ring buffer of a thread is full
+	*/
+
+	void AsyncLogger::SetOverflowPolicy(LogOverflowPolicy overflowPolicy)
+	{
+		m_overflowPolicy.store(overflowPolicy, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Queues a string to be written in the log
+	*
+	* \param string String to log
+	*
+	* \see WriteError
+	*/
+
+	void AsyncLogger::Write(const String& string)
+	{
+		Push(ErrorType_Normal, string, 0, nullptr, nullptr, false);
+	}
+
+	/*!
+	* \brief Queues an error to be written in the log
+	*
+	* \param type The error type
+	* \param error The error text
+	* \param line The line the error occurred
+	* \param file The file the error occurred, which must outlive the logger (such as __FILE__)
+	* \param function The function the error occurred, which must outlive the logger (such as NAZARA_FUNCTION)
+	*
+	* \see Write
+	*/
+
+	void AsyncLogger::WriteError(ErrorType type, const String& error, unsigned int line, const char* file, const char* function)
+	{
+		Push(type, error, line, file, function, true);
+	}
+
+	/*!
+	* \brief Gets the ring buffer of the calling thread, creating it if needed
+	* \return Ring buffer of the thread
+	*/
+
+	AsyncLogger::ProducerQueue* AsyncLogger::GetProducerQueue()
+	{
+		if (t_producerLoggerId == m_id)
+			return static_cast<ProducerQueue*>(t_producerQueue);
+
+		std::thread::id threadId = std::this_thread::get_id();
+
+		ExclusiveLockGuard lock(m_queueMutex);
+
+		ProducerQueue* queue = nullptr;
+		for (const auto& producerQueue : m_queues)
+		{
+			if (producerQueue->producerThread == threadId)
+			{
+				queue = producerQueue.get();
+				break;
+			}
+		}
+
+		if (!queue)
+		{
+			m_queues.emplace_back(new ProducerQueue(m_queueCapacity));
+			queue = m_queues.back().get();
+		}
+
+		t_producerLoggerId = m_id;
+		t_producerQueue = queue;
+
+		return queue;
+	}
+
+	/*!
+	* \brief Hands the queued entries to the wrapped logger
+	* \return true If at least one entry was processed
+	*
+	* \remark Only called by the background thread
+	*/
+
+	bool AsyncLogger::ProcessEntries()
+	{
+		bool processed = false;
+
+		SharedLockGuard lock(m_queueMutex);
+		for (const auto& queue : m_queues)
+		{
+			std::size_t first = queue->head.load(std::memory_order_relaxed);
+			std::size_t head = first;
+			std::size_t tail = queue->tail.load(std::memory_order_acquire);
+			while (head != tail)
+			{
+				Entry& entry = queue->entries[head & queue->mask];
+				if (entry.isError)
+					m_logger->WriteError(entry.type, entry.message, entry.line, entry.file, entry.function);
+				else
+					m_logger->Write(entry.message);
+
+				entry.message.Clear();
+
+				// Frees the slot right away, a blocked producer may be waiting for it
+				queue->head.store(++head, std::memory_order_release);
+			}
+
+			processed |= (head != first);
+		}
+
+		return processed;
+	}
+
+	/*!
+	* \brief Pushes an entry into the ring buffer of the calling thread
+	*
+	* \param type The error type
+	* \param message The entry text
+	* \param line The line the error occurred
+	* \param file The file the error occurred
+	* \param function The function the error occurred
+	* \param isError Whether the entry is an error or a simple string
+	*/
+
+	void AsyncLogger::Push(ErrorType type, const String& message, unsigned int line, const char* file, const char* function, bool isError)
+	{
+		if (t_consumerLoggerId == m_id)
+		{
+			// Written while handing an entry to the logger (e.g. an I/O error), there is no one else to process it
+			if (isError)
+				m_logger->WriteError(type, message, line, file, function);
+			else
+				m_logger->Write(message);
+
+			return;
+		}
+
+		ProducerQueue* queue = GetProducerQueue();
+
+		std::size_t tail = queue->tail.load(std::memory_order_relaxed);
+		while (tail - queue->head.load(std::memory_order_acquire) > queue->mask)
+		{
+			if (m_overflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy_Drop)
+			{
+				m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			if (m_consumerSleeping.load(std::memory_order_seq_cst))
+				WakeConsumer();
+
+			std::this_thread::yield();
+		}
+
+		Entry& entry = queue->entries[tail & queue->mask];
+		entry.message = message;
+		entry.file = file;
+		entry.function = function;
+		entry.line = line;
+		entry.type = type;
+		entry.isError = isError;
+
+		queue->tail.store(tail + 1, std::memory_order_seq_cst);
+
+		// Pairs with the background thread going to sleep, one of them sees the other
+		if (m_consumerSleeping.load(std::memory_order_seq_cst))
+			WakeConsumer();
+	}
+
+	/*!
+	* \brief Main loop of the background thread
+	*/
+
+	void AsyncLogger::ThreadProc()
+	{
+		Thread::SetCurrentThreadName("Nz AsyncLogger");
+
+		t_consumerLoggerId = m_id;
+
+		UInt64 reportedDropCount = 0;
+		auto ReportDrops = [&]()
+		{
+			UInt64 droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+			if (droppedCount != reportedDropCount)
+			{
+				m_logger->WriteError(ErrorType_Warning, String::Number(droppedCount - reportedDropCount) + " log entries dropped (full queue)");
+				reportedDropCount = droppedCount;
+			}
+		};
+
+		while (!m_shouldStop.load(std::memory_order_acquire))
+		{
+			ReportDrops();
+
+			if (ProcessEntries())
+				continue;
+
+			LockGuard lock(m_wakeUpMutex);
+			m_consumerSleeping.store(true, std::memory_order_seq_cst);
+
+			bool pending = false;
+			{
+				SharedLockGuard queueLock(m_queueMutex);
+				for (const auto& queue : m_queues)
+				{
+					if (queue->tail.load(std::memory_order_seq_cst) != queue->head.load(std::memory_order_relaxed))
+					{
+						pending = true;
+						break;
+					}
+				}
+			}
+
+			if (!pending && !m_shouldStop.load(std::memory_order_acquire))
+				m_wakeUp.Wait(&m_wakeUpMutex, 100); // The timeout is only a safety net
+
+			m_consumerSleeping.store(false, std::memory_order_relaxed);
+		}
+
+		ProcessEntries();
+		ReportDrops();
+	}
+
+	/*!
+	* \brief Wakes the background thread up
+	*/
+
+	void AsyncLogger::WakeConsumer()
+	{
+		LockGuard lock(m_wakeUpMutex);
+		m_wakeUp.Signal();
+	}
+}
@@ -4,6 +4,7 @@
 
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 	#include <Nazara/Core/Win32/ClockImpl.hpp>
@@ -19,6 +20,16 @@
 	#include <Nazara/Core/ThreadSafetyOff.hpp>
 #endif
 
+#if defined(NAZARA_COMPILER_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+	#include <intrin.h>
+	#define NAZARA_CLOCK_RDTSCP
+#elif (defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_INTEL)) && (defined(__i386__) || defined(__x86_64__))
+	#include <x86intrin.h>
+	#define NAZARA_CLOCK_RDTSCP
+#elif (defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG)) && defined(__aarch64__)
+	#define NAZARA_CLOCK_CNTVCT
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -39,12 +50,115 @@ namespace Nz
 
 			return GetElapsedMicroseconds();
 		}
+
+		struct TimestampSource
+		{
+			ClockFunction function;
+			UInt64 frequency; //< Ticks per second
+		};
+
+		UInt64 GetTimestampFallback()
+		{
+			return GetElapsedMicroseconds();
+		}
+
+		#if defined(NAZARA_CLOCK_RDTSCP)
+		UInt64 GetTimestampRDTSCP()
+		{
+			// Unlike rdtsc, rdtscp waits for the previous instructions to be executed
+			unsigned int processorId;
+			return __rdtscp(&processorId);
+		}
+
+		UInt64 CalibrateRDTSCP()
+		{
+			// The frequency of the counter is not reported, it is measured against the high precision clock
+			// Both ends are read right after the clock ticks, to not lose up to a microsecond on each of them
+			auto WaitNextMicrosecond = [](UInt64* ticks) -> UInt64
+			{
+				UInt64 time = GetElapsedMicroseconds();
+
+				UInt64 nextTime;
+				while ((nextTime = GetElapsedMicroseconds()) == time);
+
+				*ticks = GetTimestampRDTSCP();
+				return nextTime;
+			};
+
+			UInt64 beginTicks;
+			UInt64 beginTime = WaitNextMicrosecond(&beginTicks);
+
+			UInt64 endTicks;
+			UInt64 endTime;
+			do
+			{
+				endTime = WaitNextMicrosecond(&endTicks);
+			}
+			while (endTime - beginTime < 20000);
+
+			return (endTicks - beginTicks) * 1000000ULL / (endTime - beginTime);
+		}
+		#elif defined(NAZARA_CLOCK_CNTVCT)
+		UInt64 GetTimestampCNTVCT()
+		{
+			UInt64 ticks;
+			asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks) :: "memory");
+
+			return ticks;
+		}
+		#endif
+
+		TimestampSource DetectTimestampSource()
+		{
+			TimestampSource source;
+
+			#if defined(NAZARA_CLOCK_RDTSCP)
+			// A TSC changing its rate with the power states (or differing between cores) cannot be converted to time
+			if (HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_InvariantTSC) && HardwareInfo::HasCapability(ProcessorCap_RDTSCP))
+			{
+				source.function = GetTimestampRDTSCP;
+				source.frequency = CalibrateRDTSCP();
+				if (source.frequency > 0)
+					return source;
+			}
+			#elif defined(NAZARA_CLOCK_CNTVCT)
+			UInt64 frequency;
+			asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+
+			if (frequency > 0)
+			{
+				source.function = GetTimestampCNTVCT;
+				source.frequency = frequency;
+				return source;
+			}
+			#endif
+
+			source.function = GetTimestampFallback;
+			source.frequency = 1000000;
+
+			return source;
+		}
+
+		const TimestampSource& GetTimestampSource()
+		{
+			static TimestampSource source = DetectTimestampSource();
+			return source;
+		}
+
+		UInt64 GetTimestampFirstRun()
+		{
+			GetTimestamp = GetTimestampSource().function;
+
+			return GetTimestamp();
+		}
 	}
 
 	/*!
 	* \ingroup core
 	* \class Nz::Clock
 	* \brief Utility class that measure the elapsed time
+	*
+	* With ClockMode_Timestamp, the clock reads the processor timestamp counter (see GetTimestamp), which is cheaper than the system clock when it is invariant
 	*/
 
 	/*!
@@ -52,12 +166,14 @@ namespace Nz
 	*
 	* \param startingValue The starting time value, in microseconds
 	* \param paused The clock pause state
+	* \param mode Source of the time
 	*/
-	Clock::Clock(UInt64 startingValue, bool paused) :
+	Clock::Clock(UInt64 startingValue, bool paused, ClockMode mode) :
+	m_mode(mode),
 	m_elapsedTime(startingValue),
-	m_refTime(GetElapsedMicroseconds()),
 	m_paused(paused)
 	{
+		m_refTime = GetReferenceTime();
 	}
 
 	/*!
@@ -83,7 +199,7 @@ namespace Nz
 
 		UInt64 elapsedMicroseconds = m_elapsedTime;
 		if (!m_paused)
-			elapsedMicroseconds += (GetElapsedMicroseconds() - m_refTime);
+			elapsedMicroseconds += GetTimeSinceReference();
 
 		return elapsedMicroseconds;
 	}
@@ -99,6 +215,15 @@ namespace Nz
 		return GetMicroseconds()/1000;
 	}
 
+	/*!
+	* Returns the source of the time of the clock
+	* \return Mode given to the constructor
+	*/
+	ClockMode Clock::GetMode() const
+	{
+		return m_mode;
+	}
+
 	/*!
 	* Returns the current pause state of the clock
 	* \return Boolean indicating if the clock is currently paused
@@ -126,7 +251,7 @@ namespace Nz
 
 		if (!m_paused)
 		{
-			m_elapsedTime += GetElapsedMicroseconds() - m_refTime;
+			m_elapsedTime += GetTimeSinceReference();
 			m_paused = true;
 		}
 	}
@@ -140,7 +265,7 @@ namespace Nz
 		NazaraLock(m_mutex);
 
 		m_elapsedTime = 0;
-		m_refTime = GetElapsedMicroseconds();
+		m_refTime = GetReferenceTime();
 		m_paused = false;
 	}
 
@@ -158,11 +283,56 @@ namespace Nz
 
 		if (m_paused)
 		{
-			m_refTime = GetElapsedMicroseconds();
+			m_refTime = GetReferenceTime();
 			m_paused = false;
 		}
 	}
 
+	/*!
+	* Returns the current time of the source of the clock
+	* \return Microseconds, or timestamp ticks with ClockMode_Timestamp
+	*/
+	UInt64 Clock::GetReferenceTime() const
+	{
+		return (m_mode == ClockMode_Timestamp) ? GetTimestamp() : GetElapsedMicroseconds();
+	}
+
+	/*!
+	* Returns the time elapsed since the reference time
+	* \return Microseconds elapsed
+	*/
+	UInt64 Clock::GetTimeSinceReference() const
+	{
+		UInt64 elapsed = GetReferenceTime() - m_refTime;
+		return (m_mode == ClockMode_Timestamp) ? TimestampToMicroseconds(elapsed) : elapsed;
+	}
+
+	/*!
+	* Returns the number of timestamp ticks per second
+	* \return Frequency of GetTimestamp
+	*
+	* \remark The first call may take a few milliseconds, to measure the frequency of the counter
+	*/
+	UInt64 GetTimestampFrequency()
+	{
+		return Detail::GetTimestampSource().frequency;
+	}
+
+	/*!
+	* Converts a timestamp (or a difference of timestamps) to microseconds
+	* \return Microseconds
+	*
+	* \param ticks Ticks from GetTimestamp
+	*/
+	UInt64 TimestampToMicroseconds(UInt64 ticks)
+	{
+		UInt64 frequency = GetTimestampFrequency();
+
+		// Split to keep ticks * 1000000 from overflowing
+		return (ticks / frequency) * 1000000ULL + (ticks % frequency) * 1000000ULL / frequency;
+	}
+
 	ClockFunction GetElapsedMicroseconds = Detail::GetElapsedMicrosecondsFirstRun;
 	ClockFunction GetElapsedMilliseconds = ClockImplGetElapsedMilliseconds;
+	ClockFunction GetTimestamp = Detail::GetTimestampFirstRun; //< Invariant TSC (x86) or generic timer (ARM64), the system clock otherwise
 }
@@ -4,11 +4,13 @@
 
 #include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Core/PluginManager.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/VirtualFileSystem.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -38,6 +40,9 @@ namespace Nz
 
 		Log::Initialize();
 
+		// Chooses once for all the implementation of the kernels using processor-specific instructions
+		CpuDispatch::Initialize();
+
 		NazaraNotice("Initialized: Core");
 		return true;
 	}
@@ -72,13 +77,15 @@ namespace Nz
 		// Free of module
 		s_moduleReferenceCounter = 0;
 
+		CpuDispatch::Uninitialize();
 		HardwareInfo::Uninitialize();
 		Log::Uninitialize();
 		PluginManager::Uninitialize();
 		TaskScheduler::Uninitialize();
+		VirtualFileSystem::Uninitialize();
 
 		NazaraNotice("Uninitialized: Core");
 	}
 
-	unsigned int Core::s_moduleReferenceCounter = 0;
+	std::atomic<unsigned int> Core::s_moduleReferenceCounter(0);
 }
@@ -0,0 +1,198 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		std::atomic<UInt64> s_disabledCapabilities(0);
+		bool s_initialized = false;
+	}
+
+	namespace Detail
+	{
+		/*!
+		* \brief Constructs a CpuKernelBase object and registers it
+		*
+		* \param name Name of the kernel
+		*/
+
+		CpuKernelBase::CpuKernelBase(const char* name) :
+		m_name(name),
+		m_next(nullptr)
+		{
+			CpuDispatch::Register(this);
+		}
+
+		/*!
+		* \brief Destructs the object and unregisters it
+		*/
+
+		CpuKernelBase::~CpuKernelBase()
+		{
+			CpuDispatch::Unregister(this);
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::CpuDispatch
+	* \brief Core class that keeps track of every CpuKernel and of the processor capabilities they may use
+	*
+	* \remark Kernels are expected to be registered during static initialization (of the engine or of a plugin), not concurrently
+	*/
+
+	/*!
+	* \brief Checks whether a set of capabilities is supported by the processor and enabled
+	* \return true if every capability of the mask is available
+	*
+	* \param capabilities Mask built with MakeCapabilities
+	*/
+
+	bool CpuDispatch::HasCapabilities(UInt64 capabilities)
+	{
+		if (capabilities == 0)
+			return true;
+
+		if (!HardwareInfo::Initialize())
+			return false;
+
+		if (capabilities & s_disabledCapabilities.load(std::memory_order_relaxed))
+			return false;
+
+		for (unsigned int i = 0; i <= ProcessorCap_Max; ++i)
+		{
+			if ((capabilities & (UInt64(1) << i)) && !HardwareInfo::HasCapability(static_cast<ProcessorCap>(i)))
+				return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Initializes the dispatcher, selecting the implementation of every registered kernel
+	* \return true if successful
+	*
+	* \remark Called by Core::Initialize
+	*/
+
+	bool CpuDispatch::Initialize()
+	{
+		if (s_initialized)
+			return true;
+
+		if (!HardwareInfo::Initialize())
+			NazaraWarning("Failed to initialize hardware info, only generic implementations will be used");
+
+		s_initialized = true;
+
+		SelectAll();
+
+		return true;
+	}
+
+	/*!
+	* \brief Checks whether a capability is supported by the processor and enabled
+	* \return true if kernels may use it
+	*
+	* \param capability Capability to check
+	*/
+
+	bool CpuDispatch::IsCapabilityEnabled(ProcessorCap capability)
+	{
+		return HasCapabilities(MakeCapabilities({capability}));
+	}
+
+	/*!
+	* \brief Checks whether the dispatcher is initialized
+	* \return true if it is
+	*/
+
+	bool CpuDispatch::IsInitialized()
+	{
+		return s_initialized;
+	}
+
+	/*!
+	* \brief Enables or disables the use of a capability by the kernels
+	*
+	* Every kernel selects its implementation again, this is meant for testing the different implementations
+	* or working around a faulty one, and must not be done while kernels are being called from other threads.
+	*
+	* \param capability Capability to enable or disable
+	* \param enable Whether kernels may use it, an enabled capability still needs to be supported by the processor
+	*/
+
+	void CpuDispatch::SetCapabilityEnabled(ProcessorCap capability, bool enable)
+	{
+		NazaraAssert(capability <= ProcessorCap_Max, "Capability out of enum");
+
+		UInt64 bit = UInt64(1) << capability;
+		if (enable)
+			s_disabledCapabilities.fetch_and(~bit, std::memory_order_relaxed);
+		else
+			s_disabledCapabilities.fetch_or(bit, std::memory_order_relaxed);
+
+		SelectAll();
+	}
+
+	/*!
+	* \brief Uninitializes the dispatcher
+	*
+	* \remark Kernels keep their current implementation
+	*/
+
+	void CpuDispatch::Uninitialize()
+	{
+		s_initialized = false;
+	}
+
+	/*!
+	* \brief Adds a kernel to the list
+	*
+	* \param kernel Kernel to register
+	*/
+
+	void CpuDispatch::Register(Detail::CpuKernelBase* kernel)
+	{
+		kernel->m_next = s_kernels;
+		s_kernels = kernel;
+
+		// The kernel is not fully constructed yet, it will select its implementation on its first call
+	}
+
+	/*!
+	* \brief Selects the implementation of every registered kernel
+	*/
+
+	void CpuDispatch::SelectAll()
+	{
+		for (Detail::CpuKernelBase* kernel = s_kernels; kernel; kernel = kernel->m_next)
+			kernel->Select();
+	}
+
+	/*!
+	* \brief Removes a kernel from the list
+	*
+	* \param kernel Kernel to unregister
+	*/
+
+	void CpuDispatch::Unregister(Detail::CpuKernelBase* kernel)
+	{
+		Detail::CpuKernelBase** link = &s_kernels;
+		while (*link && *link != kernel)
+			link = &(*link)->m_next;
+
+		if (*link)
+			*link = kernel->m_next;
+	}
+
+	// Constant-initialized, kernels may be registered before the dynamic initialization of this translation unit
+	Detail::CpuKernelBase* CpuDispatch::s_kernels = nullptr;
+}
@@ -28,4 +28,49 @@ void operator delete[](void* pointer) noexcept
 	Nz::MemoryManager::Free(pointer, true);
 }
 
+// The standard library uses the nothrow and sized (C++14) forms too, the default ones would receive our blocks
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+	try
+	{
+		return Nz::MemoryManager::Allocate(size, false);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& /*tag*/) noexcept
+{
+	try
+	{
+		return Nz::MemoryManager::Allocate(size, true);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void operator delete(void* pointer, const std::nothrow_t& /*tag*/) noexcept
+{
+	Nz::MemoryManager::Free(pointer, false);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t& /*tag*/) noexcept
+{
+	Nz::MemoryManager::Free(pointer, true);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+	Nz::MemoryManager::Free(pointer, false);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept
+{
+	Nz::MemoryManager::Free(pointer, true);
+}
+
 #endif // NAZARA_CORE_MANAGE_MEMORY
@@ -290,6 +290,20 @@ namespace Nz
 		return GetSize(m_filePath);
 	}
 
+	/*!
+	* \brief Checks whether the file content is mapped in memory
+	* \return true if mapped
+	*
+	* \see Map
+	*/
+
+	bool File::IsMapped() const
+	{
+		NazaraLock(m_mutex)
+
+		return m_impl && m_impl->IsMapped();
+	}
+
 	/*!
 	* \brief Checks whether the file is open
 	* \return true if open
@@ -302,6 +316,27 @@ namespace Nz
 		return m_impl != nullptr;
 	}
 
+	/*!
+	* \brief Maps the whole file content in memory for reading
+	* \return A read-only pointer to the GetSize() bytes of the file or nullptr if mapping failed
+	*
+	* The mapping stays valid until the file is closed or Unmap/SetSize is called, wrap it in a MemoryView to use it as a stream.
+	* Calling Map on an already mapped file returns the existing mapping.
+	*
+	* \remark The file must be open in read mode
+	* \remark Produces a NazaraError if the file is empty or if mapping failed
+	*/
+
+	const void* File::Map()
+	{
+		NazaraLock(m_mutex)
+
+		NazaraAssert(IsOpen(), "File is not open");
+		NazaraAssert(IsReadable(), "File is not readable");
+
+		return m_impl->Map();
+	}
+
 	/*!
 	* \brief Opens the file with flags
 	* \return true if opening is successful
@@ -473,6 +508,20 @@ namespace Nz
 		return m_impl->SetSize(size);
 	}
 
+	/*!
+	* \brief Releases the memory mapping of the file, if any
+	*
+	* \remark Pointers returned by Map are invalid after this call
+	*/
+
+	void File::Unmap()
+	{
+		NazaraLock(m_mutex)
+
+		if (m_impl)
+			m_impl->Unmap();
+	}
+
 	/*!
 	* \brief Sets the file path
 	* \return A reference to this
@@ -8,6 +8,7 @@
 
 #include <Nazara/Core/GuillotineBinPack.hpp>
 #include <Nazara/Core/Config.hpp>
+#include <Nazara/Math/Algorithm.hpp>
 #include <algorithm>
 #include <cstdlib>
 #include <cmath>
@@ -24,6 +25,19 @@ namespace Nz
 
 	namespace
 	{
+		/*!
+		* \brief Gets the key of a corner in the corner indices
+		* \return Key of the corner
+		*
+		* \param x X coordinate of the corner
+		* \param y Y coordinate of the corner
+		*/
+
+		UInt64 MakeCornerKey(unsigned int x, unsigned int y)
+		{
+			return (static_cast<UInt64>(x) << 32) | y;
+		}
+
 		/*!
 		* \brief Gets the score for fitting the area
 		* \return Score of the fitting
@@ -155,8 +169,15 @@ namespace Nz
 
 	void GuillotineBinPack::Clear()
 	{
+		for (std::vector<std::size_t>& bucket : m_buckets)
+			bucket.clear();
+
+		m_bucketMasks.fill(0);
+		m_freeRectsByBottomRight.clear();
+		m_freeRectsByTopLeft.clear();
 		m_freeRectangles.clear();
-		m_freeRectangles.push_back(Rectui(0, 0, m_width, m_height));
+
+		AddFreeRectangle(Rectui(0, 0, m_width, m_height), false);
 
 		m_usedArea = 0;
 	}
@@ -179,13 +200,13 @@ namespace Nz
 		m_height = std::max(newHeight, m_height);
 
 		if (m_width > oldWidth)
-			m_freeRectangles.push_back(Rectui(oldWidth, 0, m_width - oldWidth, oldHeight));
+			AddFreeRectangle(Rectui(oldWidth, 0, m_width - oldWidth, oldHeight), false);
 
 		if (m_height > oldHeight)
-			m_freeRectangles.push_back(Rectui(0, oldHeight, m_width, m_height - oldHeight));
+			AddFreeRectangle(Rectui(0, oldHeight, m_width, m_height - oldHeight), false);
 
-		// On va ensuite fusionner les rectangles tant que possible
-		while (MergeFreeRectangles());
+		// On va ensuite fusionner les rectangles tant que possible (une passe suffit)
+		MergeFreeRectangles();
 	}
 
 	/*!
@@ -211,7 +232,7 @@ namespace Nz
 
 	void GuillotineBinPack::FreeRectangle(const Rectui& rect)
 	{
-		m_freeRectangles.push_back(rect);
+		AddFreeRectangle(rect, false);
 
 		m_usedArea -= rect.width * rect.height;
 	}
@@ -300,6 +321,11 @@ namespace Nz
 	* \param merge Merge possible
 	* \param rectChoice Heuristic to use to free
 	* \param splitMethod Heuristic to use to split
+	*
+	* At each step, the best placement among every remaining rectangle is chosen, which costs O(count²) searches.
+	* InsertSorted is much faster for large batches.
+	*
+	* \see InsertSorted
 	*/
 
 	bool GuillotineBinPack::Insert(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod)
@@ -312,63 +338,28 @@ namespace Nz
 		while (!remainingRects.empty())
 		{
 			// Stores the penalty score of the best rectangle placement - bigger=worse, smaller=better.
-			bool bestFlipped;
-			std::size_t bestFreeRect;
-			std::size_t bestRect;
+			bool bestFlipped = false;
+			std::size_t bestFreeRect = 0;
+			std::size_t bestRect = 0;
 			int bestScore = std::numeric_limits<int>::max();
 
-			for (std::size_t i = 0; i < m_freeRectangles.size(); ++i)
+			for (std::size_t i = 0; i < remainingRects.size(); ++i)
 			{
-				Rectui& freeRect = m_freeRectangles[i];
+				const Rectui& rect = *remainingRects[i];
 
-				for (std::size_t j = 0; j < remainingRects.size(); ++j)
+				bool rectFlipped;
+				std::size_t freeRect;
+				int score;
+				if (FindFreeRectangle(rect.width, rect.height, rectChoice, &freeRect, &rectFlipped, &score) && score < bestScore)
 				{
-					Rectui& rect = *remainingRects[j];
+					bestFreeRect = freeRect;
+					bestRect = i;
+					bestFlipped = rectFlipped;
+					bestScore = score;
 
-					// If this rectangle is a perfect match, we pick it instantly.
-					if (rect.width == freeRect.width && rect.height == freeRect.height)
-					{
-						bestFreeRect = i;
-						bestRect = j;
-						bestFlipped = false;
-						bestScore = std::numeric_limits<int>::min();
-						i = m_freeRectangles.size(); // Force a jump out of the outer loop as well - we got an instant fit.
+					// We got an instant fit
+					if (bestScore == std::numeric_limits<int>::min())
 						break;
-					}
-					// If flipping this rectangle is a perfect match, pick that then.
-					else if (rect.height == freeRect.width && rect.width == freeRect.height)
-					{
-						bestFreeRect = i;
-						bestRect = j;
-						bestFlipped = true;
-						bestScore = std::numeric_limits<int>::min();
-						i = m_freeRectangles.size(); // Force a jump out of the outer loop as well - we got an instant fit.
-						break;
-					}
-					// Try if we can fit the rectangle upright.
-					else if (rect.width <= freeRect.width && rect.height <= freeRect.height)
-					{
-						int score = ScoreByHeuristic(rect.width, rect.height, freeRect, rectChoice);
-						if (score < bestScore)
-						{
-							bestFreeRect = i;
-							bestRect = j;
-							bestFlipped = false;
-							bestScore = score;
-						}
-					}
-					// If not, then perhaps flipping sideways will make it fit?
-					else if (rect.height <= freeRect.width && rect.width <= freeRect.height)
-					{
-						int score = ScoreByHeuristic(rect.height, rect.width, freeRect, rectChoice);
-						if (score < bestScore)
-						{
-							bestFreeRect = i;
-							bestRect = j;
-							bestFlipped = true;
-							bestScore = score;
-						}
-					}
 				}
 			}
 
@@ -390,12 +381,7 @@ namespace Nz
 
 			// Otherwise, we're good to go and do the actual packing.
 			std::ptrdiff_t position = remainingRects[bestRect] - rects;
-			Rectui& rect = *remainingRects[bestRect];
-			rect.x = m_freeRectangles[bestFreeRect].x;
-			rect.y = m_freeRectangles[bestFreeRect].y;
-
-			if (bestFlipped)
-				std::swap(rect.width, rect.height);
+			PlaceRectangle(bestFreeRect, *remainingRects[bestRect], bestFlipped, merge, splitMethod);
 
 			if (flipped)
 				flipped[position] = bestFlipped;
@@ -403,76 +389,98 @@ namespace Nz
 			if (inserted)
 				inserted[position] = true;
 
-			// Remove the free space we lost in the bin.
-			SplitFreeRectByHeuristic(m_freeRectangles[bestFreeRect], rect, splitMethod);
-			m_freeRectangles.erase(m_freeRectangles.begin() + bestFreeRect);
-
 			// Remove the rectangle we just packed from the input list.
 			remainingRects.erase(remainingRects.begin() + bestRect);
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Inserts rectangles in the area, from the biggest to the smallest
+	* \return true if each rectangle could be inserted
+	*
+	* \param rects List of rectangles
+	* \param flipped List of flipped rectangles, may be nullptr
+	* \param inserted List of inserted rectangles, may be nullptr
+	* \param count Count of rectangles
+	* \param merge Merge possible
+	* \param rectChoice Heuristic to use to free
+	* \param splitMethod Heuristic to use to split
+	*
+	* Rectangles are sorted by decreasing longer side then placed one at a time, in O(count log count).
+	* Unlike Insert, a rectangle which does not fit does not stop the insertion of the following ones.
+	*
+	* \see Insert
+	*/
+
+	bool GuillotineBinPack::InsertSorted(Rectui* rects, bool* flipped, bool* inserted, unsigned int count, bool merge, FreeRectChoiceHeuristic rectChoice, GuillotineSplitHeuristic splitMethod)
+	{
+		std::vector<unsigned int> order(count);
+		for (unsigned int i = 0; i < count; ++i)
+			order[i] = i;
+
+		std::stable_sort(order.begin(), order.end(), [rects](unsigned int lhs, unsigned int rhs)
+		{
+			const Rectui& first = rects[lhs];
+			const Rectui& second = rects[rhs];
+
+			unsigned int firstLongSide = std::max(first.width, first.height);
+			unsigned int secondLongSide = std::max(second.width, second.height);
+			if (firstLongSide != secondLongSide)
+				return firstLongSide > secondLongSide;
+
+			return std::min(first.width, first.height) > std::min(second.width, second.height);
+		});
 
-			// Perform a Rectangle Merge step if desired.
-			if (merge)
-				MergeFreeRectangles();
+		bool everyRectInserted = true;
+		for (unsigned int index : order)
+		{
+			Rectui& rect = rects[index];
+
+			bool rectFlipped;
+			std::size_t freeRect;
+			int score;
+			bool found = FindFreeRectangle(rect.width, rect.height, rectChoice, &freeRect, &rectFlipped, &score);
+			if (found)
+				PlaceRectangle(freeRect, rect, rectFlipped, merge, splitMethod);
+			else
+				everyRectInserted = false;
+
+			if (flipped)
+				flipped[index] = found && rectFlipped;
 
-			m_usedArea += rect.width * rect.height;
+			if (inserted)
+				inserted[index] = found;
 		}
 
-		return true;
+		return everyRectInserted;
 	}
 
 	/*!
 	* \brief Merges free rectangles together
-	* \return true if there was a merge (and thus if a merge is still possible)
+	* \return true if there was a merge
+	*
+	* \remark A single call merges everything which can be merged
 	*/
 
 	bool GuillotineBinPack::MergeFreeRectangles()
 	{
 		std::size_t oriSize = m_freeRectangles.size();
 
-		// Do a Theta(n^2) loop to see if any pair of free rectangles could me merged into one.
-		// Note that we miss any opportunities to merge three rectangles into one. (should call this function again to detect that)
-		for (std::size_t i = 0; i < m_freeRectangles.size(); ++i)
-		{
-			Rectui& firstRect = m_freeRectangles[i];
+		std::vector<FreeRect> freeRectangles;
+		freeRectangles.swap(m_freeRectangles);
 
-			for (std::size_t j = i+1; j < m_freeRectangles.size(); ++j)
-			{
-				Rectui& secondRect = m_freeRectangles[j];
+		for (std::vector<std::size_t>& bucket : m_buckets)
+			bucket.clear();
 
-				if (firstRect.width == secondRect.width && firstRect.x == secondRect.x)
-				{
-					if (firstRect.y == secondRect.y + secondRect.height)
-					{
-						firstRect.y -= secondRect.height;
-						firstRect.height += secondRect.height;
-						m_freeRectangles.erase(m_freeRectangles.begin() + j);
-						--j;
-					}
-					else if (firstRect.y + firstRect.height == secondRect.y)
-					{
-						firstRect.height += secondRect.height;
-						m_freeRectangles.erase(m_freeRectangles.begin() + j);
-						--j;
-					}
-				}
-				else if (firstRect.height == secondRect.height && firstRect.y == secondRect.y)
-				{
-					if (firstRect.x == secondRect.x + secondRect.width)
-					{
-						firstRect.x -= secondRect.width;
-						firstRect.width += secondRect.width;
-						m_freeRectangles.erase(m_freeRectangles.begin() + j);
-						--j;
-					}
-					else if (firstRect.x + firstRect.width == secondRect.x)
-					{
-						firstRect.width += secondRect.width;
-						m_freeRectangles.erase(m_freeRectangles.begin() + j);
-						--j;
-					}
-				}
-			}
-		}
+		m_bucketMasks.fill(0);
+		m_freeRectsByBottomRight.clear();
+		m_freeRectsByTopLeft.clear();
+
+		// Each rectangle merges with its neighbours when added, in O(1) thanks to the corner indices
+		for (const FreeRect& freeRect : freeRectangles)
+			AddFreeRectangle(freeRect.rect, true);
 
 		return m_freeRectangles.size() < oriSize;
 	}
@@ -515,15 +523,304 @@ namespace Nz
 		Reset(size.x, size.y);
 	}
 
+	/*!
+	* \brief Adds a free rectangle to the pool
+	*
+	* \param rect Free rectangle
+	* \param merge Should the rectangle be merged with its free neighbours sharing a whole side
+	*/
+
+	void GuillotineBinPack::AddFreeRectangle(Rectui rect, bool merge)
+	{
+		if (rect.width == 0 || rect.height == 0)
+			return;
+
+		bool merged = merge;
+		while (merged)
+		{
+			merged = false;
+
+			// Below
+			auto it = m_freeRectsByTopLeft.find(MakeCornerKey(rect.x, rect.y + rect.height));
+			if (it != m_freeRectsByTopLeft.end() && m_freeRectangles[it->second].rect.width == rect.width)
+			{
+				rect.height += m_freeRectangles[it->second].rect.height;
+				RemoveFreeRectangle(it->second);
+				merged = true;
+			}
+
+			// Above
+			it = m_freeRectsByBottomRight.find(MakeCornerKey(rect.x + rect.width, rect.y));
+			if (it != m_freeRectsByBottomRight.end() && m_freeRectangles[it->second].rect.width == rect.width)
+			{
+				unsigned int height = m_freeRectangles[it->second].rect.height;
+				rect.y -= height;
+				rect.height += height;
+				RemoveFreeRectangle(it->second);
+				merged = true;
+			}
+
+			// Right
+			it = m_freeRectsByTopLeft.find(MakeCornerKey(rect.x + rect.width, rect.y));
+			if (it != m_freeRectsByTopLeft.end() && m_freeRectangles[it->second].rect.height == rect.height)
+			{
+				rect.width += m_freeRectangles[it->second].rect.width;
+				RemoveFreeRectangle(it->second);
+				merged = true;
+			}
+
+			// Left
+			it = m_freeRectsByBottomRight.find(MakeCornerKey(rect.x, rect.y + rect.height));
+			if (it != m_freeRectsByBottomRight.end() && m_freeRectangles[it->second].rect.height == rect.height)
+			{
+				unsigned int width = m_freeRectangles[it->second].rect.width;
+				rect.x -= width;
+				rect.width += width;
+				RemoveFreeRectangle(it->second);
+				merged = true;
+			}
+		}
+
+		std::size_t index = m_freeRectangles.size();
+		unsigned int widthClass = GetSizeClass(rect.width);
+		unsigned int heightClass = GetSizeClass(rect.height);
+		unsigned int bucketIndex = widthClass * SizeClassCount + heightClass;
+
+		std::vector<std::size_t>& bucket = m_buckets[bucketIndex];
+
+		FreeRect freeRect;
+		freeRect.rect = rect;
+		freeRect.bucket = bucketIndex;
+		freeRect.bucketPosition = bucket.size();
+
+		m_freeRectangles.push_back(freeRect);
+		bucket.push_back(index);
+		m_bucketMasks[widthClass] |= 1U << heightClass;
+
+		m_freeRectsByBottomRight[MakeCornerKey(rect.x + rect.width, rect.y + rect.height)] = index;
+		m_freeRectsByTopLeft[MakeCornerKey(rect.x, rect.y)] = index;
+	}
+
+	/*!
+	* \brief Finds the best free rectangle for a rectangle to insert
+	* \return true if the rectangle fits somewhere
+	*
+	* \param width Width of the rectangle to insert
+	* \param height Height of the rectangle to insert
+	* \param rectChoice Heuristic to use to choose
+	* \param freeRectIndex Index of the best free rectangle
+	* \param flipped Whether the rectangle has to be flipped to fit in it
+	* \param score Score of the placement, std::numeric_limits<int>::min() for a perfect fit
+	*/
+
+	bool GuillotineBinPack::FindFreeRectangle(unsigned int width, unsigned int height, FreeRectChoiceHeuristic rectChoice, std::size_t* freeRectIndex, bool* flipped, int* score) const
+	{
+		// A perfect match is picked instantly, it can only be in one bucket per orientation
+		for (bool flip : {false, true})
+		{
+			unsigned int rectWidth = (flip) ? height : width;
+			unsigned int rectHeight = (flip) ? width : height;
+
+			for (std::size_t index : m_buckets[GetSizeClass(rectWidth) * SizeClassCount + GetSizeClass(rectHeight)])
+			{
+				const Rectui& freeRect = m_freeRectangles[index].rect;
+				if (freeRect.width == rectWidth && freeRect.height == rectHeight)
+				{
+					*freeRectIndex = index;
+					*flipped = flip;
+					*score = std::numeric_limits<int>::min();
+					return true;
+				}
+			}
+		}
+
+		*score = std::numeric_limits<int>::max();
+
+		FindFreeRectangleInBuckets(width, height, false, rectChoice, freeRectIndex, flipped, score);
+		FindFreeRectangleInBuckets(height, width, true, rectChoice, freeRectIndex, flipped, score);
+
+		return *score != std::numeric_limits<int>::max();
+	}
+
+	/*!
+	* \brief Searches the buckets for a better free rectangle, in one orientation
+	*
+	* \param width Width of the rectangle to insert, in this orientation
+	* \param height Height of the rectangle to insert, in this orientation
+	* \param flip Whether this orientation is the flipped one
+	* \param rectChoice Heuristic to use to choose
+	* \param freeRectIndex Index of the best free rectangle so far, updated if a better one is found
+	* \param flipped Whether the best free rectangle requires a flip, updated if a better one is found
+	* \param score Score of the best free rectangle so far, updated if a better one is found
+	*
+	* Only buckets whose rectangles may be large enough are visited, and those whose best possible score
+	* cannot beat the current one are skipped.
+	*/
+
+	void GuillotineBinPack::FindFreeRectangleInBuckets(unsigned int width, unsigned int height, bool flip, FreeRectChoiceHeuristic rectChoice, std::size_t* freeRectIndex, bool* flipped, int* score) const
+	{
+		unsigned int minWidthClass = GetSizeClass(width);
+		unsigned int minHeightClass = GetSizeClass(height);
+
+		for (unsigned int widthClass = minWidthClass; widthClass < SizeClassCount; ++widthClass)
+		{
+			UInt32 mask = m_bucketMasks[widthClass] & (~UInt32(0) << minHeightClass);
+			while (mask != 0)
+			{
+				unsigned int heightClass = IntegralLog2Pot(mask & (~mask + 1));
+				mask &= mask - 1;
+
+				// Bounds of the free rectangles sizes in this bucket
+				Int64 minWidth = std::max<Int64>(width, Int64(1) << widthClass);
+				Int64 minHeight = std::max<Int64>(height, Int64(1) << heightClass);
+				Int64 maxWidth = (widthClass + 1 < SizeClassCount) ? (Int64(2) << widthClass) - 1 : std::numeric_limits<unsigned int>::max();
+				Int64 maxHeight = (heightClass + 1 < SizeClassCount) ? (Int64(2) << heightClass) - 1 : std::numeric_limits<unsigned int>::max();
+
+				Int64 lowerBound;
+				switch (rectChoice)
+				{
+					case RectBestAreaFit:
+						lowerBound = minWidth * minHeight - Int64(width) * height;
+						break;
+
+					case RectBestLongSideFit:
+						lowerBound = std::max(minWidth - width, minHeight - height);
+						break;
+
+					case RectBestShortSideFit:
+						lowerBound = std::min(minWidth - width, minHeight - height);
+						break;
+
+					case RectWorstAreaFit:
+						lowerBound = -(maxWidth * maxHeight - Int64(width) * height);
+						break;
+
+					case RectWorstLongSideFit:
+						lowerBound = -std::max(maxWidth - width, maxHeight - height);
+						break;
+
+					case RectWorstShortSideFit:
+						lowerBound = -std::min(maxWidth - width, maxHeight - height);
+						break;
+
+					default:
+						lowerBound = std::numeric_limits<Int64>::min();
+						break;
+				}
+
+				if (lowerBound >= *score)
+					continue;
+
+				for (std::size_t index : m_buckets[widthClass * SizeClassCount + heightClass])
+				{
+					const Rectui& freeRect = m_freeRectangles[index].rect;
+					if (width <= freeRect.width && height <= freeRect.height)
+					{
+						int rectScore = ScoreByHeuristic(width, height, freeRect, rectChoice);
+						if (rectScore < *score)
+						{
+							*freeRectIndex = index;
+							*flipped = flip;
+							*score = rectScore;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/*!
+	* \brief Places a rectangle in a free rectangle and splits the leftover
+	*
+	* \param freeRectIndex Index of the free rectangle
+	* \param rect Rectangle to place, its position is updated (and its size, if flipped)
+	* \param flipped Whether the rectangle is flipped
+	* \param merge Should the leftover be merged with the neighbour free rectangles
+	* \param splitMethod Heuristic to use to split
+	*/
+
+	void GuillotineBinPack::PlaceRectangle(std::size_t freeRectIndex, Rectui& rect, bool flipped, bool merge, GuillotineSplitHeuristic splitMethod)
+	{
+		Rectui freeRect = m_freeRectangles[freeRectIndex].rect;
+
+		rect.x = freeRect.x;
+		rect.y = freeRect.y;
+
+		if (flipped)
+			std::swap(rect.width, rect.height);
+
+		// Remove the free space we lost in the bin.
+		RemoveFreeRectangle(freeRectIndex);
+		SplitFreeRectByHeuristic(freeRect, rect, splitMethod, merge);
+
+		m_usedArea += rect.width * rect.height;
+	}
+
+	/*!
+	* \brief Removes a free rectangle from the pool
+	*
+	* \param freeRectIndex Index of the free rectangle
+	*
+	* \remark The last free rectangle takes the index of the removed one
+	*/
+
+	void GuillotineBinPack::RemoveFreeRectangle(std::size_t freeRectIndex)
+	{
+		const FreeRect& freeRect = m_freeRectangles[freeRectIndex];
+		const Rectui& rect = freeRect.rect;
+
+		auto EraseCorner = [freeRectIndex](std::unordered_map<UInt64, std::size_t>& corners, UInt64 key)
+		{
+			auto it = corners.find(key);
+			if (it != corners.end() && it->second == freeRectIndex)
+				corners.erase(it);
+		};
+
+		EraseCorner(m_freeRectsByBottomRight, MakeCornerKey(rect.x + rect.width, rect.y + rect.height));
+		EraseCorner(m_freeRectsByTopLeft, MakeCornerKey(rect.x, rect.y));
+
+		std::vector<std::size_t>& bucket = m_buckets[freeRect.bucket];
+		std::size_t movedIndex = bucket.back();
+		bucket[freeRect.bucketPosition] = movedIndex;
+		m_freeRectangles[movedIndex].bucketPosition = freeRect.bucketPosition;
+		bucket.pop_back();
+
+		if (bucket.empty())
+			m_bucketMasks[freeRect.bucket / SizeClassCount] &= ~(1U << (freeRect.bucket % SizeClassCount));
+
+		std::size_t lastIndex = m_freeRectangles.size() - 1;
+		if (freeRectIndex != lastIndex)
+		{
+			// The last rectangle fills the hole, its references are updated
+			FreeRect& lastRect = m_freeRectangles[lastIndex];
+			m_buckets[lastRect.bucket][lastRect.bucketPosition] = freeRectIndex;
+
+			auto UpdateCorner = [freeRectIndex, lastIndex](std::unordered_map<UInt64, std::size_t>& corners, UInt64 key)
+			{
+				auto it = corners.find(key);
+				if (it != corners.end() && it->second == lastIndex)
+					it->second = freeRectIndex;
+			};
+
+			UpdateCorner(m_freeRectsByBottomRight, MakeCornerKey(lastRect.rect.x + lastRect.rect.width, lastRect.rect.y + lastRect.rect.height));
+			UpdateCorner(m_freeRectsByTopLeft, MakeCornerKey(lastRect.rect.x, lastRect.rect.y));
+
+			m_freeRectangles[freeRectIndex] = lastRect;
+		}
+
+		m_freeRectangles.pop_back();
+	}
+
 	/*!
 	* \brief Splits the free rectangle along axis
 	*
 	* \param freeRect Free rectangle to split
 	* \param placedRect Already placed rectangle
 	* \param splitHorizontal Split horizontally (or vertically)
+	* \param merge Should the new free rectangles be merged with their neighbours
 	*/
 
-	void GuillotineBinPack::SplitFreeRectAlongAxis(const Rectui& freeRect, const Rectui& placedRect, bool splitHorizontal)
+	void GuillotineBinPack::SplitFreeRectAlongAxis(const Rectui& freeRect, const Rectui& placedRect, bool splitHorizontal, bool merge)
 	{
 		// Form the two new rectangles.
 		Rectui bottom;
@@ -548,11 +845,8 @@ namespace Nz
 		}
 
 		// Add the new rectangles into the free rectangle pool if they weren't degenerate.
-		if (bottom.width > 0 && bottom.height > 0)
-			m_freeRectangles.push_back(bottom);
-
-		if (right.width > 0 && right.height > 0)
-			m_freeRectangles.push_back(right);
+		AddFreeRectangle(bottom, merge);
+		AddFreeRectangle(right, merge);
 	}
 
 	/*!
@@ -561,11 +855,12 @@ namespace Nz
 	* \param freeRect Free rectangle to split
 	* \param placedRect Already placed rectangle
 	* \param method Method used to split
+	* \param merge Should the new free rectangles be merged with their neighbours
 	*
 	* \remark Produces a NazaraError if enumeration GuillotineSplitHeuristic is invalid
 	*/
 
-	void GuillotineBinPack::SplitFreeRectByHeuristic(const Rectui& freeRect, const Rectui& placedRect, GuillotineSplitHeuristic method)
+	void GuillotineBinPack::SplitFreeRectByHeuristic(const Rectui& freeRect, const Rectui& placedRect, GuillotineSplitHeuristic method, bool merge)
 	{
 		// Compute the lengths of the leftover area
 		const int w = freeRect.width - placedRect.width;
@@ -618,7 +913,19 @@ namespace Nz
 		}
 
 		// Perform the actual split
-		SplitFreeRectAlongAxis(freeRect, placedRect, splitHorizontal);
+		SplitFreeRectAlongAxis(freeRect, placedRect, splitHorizontal, merge);
+	}
+
+	/*!
+	* \brief Gets the size class of a dimension
+	* \return Integral base 2 logarithm of the size, clamped to the last class
+	*
+	* \param size Width or height
+	*/
+
+	unsigned int GuillotineBinPack::GetSizeClass(unsigned int size)
+	{
+		return std::min(IntegralLog2(size), SizeClassCount - 1);
 	}
 
 	/*!
@@ -3,10 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 	#include <Nazara/Core/Win32/HardwareInfoImpl.hpp>
@@ -52,6 +54,27 @@ namespace Nz
 
 		static_assert(sizeof(vendorNames)/sizeof(const char*) == ProcessorVendor_Max+2, "Processor vendor name array is incomplete");
 
+		const std::vector<UInt64>& GetCoreMasks()
+		{
+			static std::vector<UInt64> coreMasks = []()
+			{
+				std::vector<UInt64> masks;
+				if (!HardwareInfoImpl::GetCoreProcessorMasks(&masks))
+				{
+					// Unknown topology, each logical processor is considered as a core
+					masks.clear();
+
+					unsigned int processorCount = std::min(HardwareInfo::GetProcessorCount(), 64U);
+					for (unsigned int i = 0; i < processorCount; ++i)
+						masks.push_back(UInt64(1) << i);
+				}
+
+				return masks;
+			}();
+
+			return coreMasks;
+		}
+
 		VendorString vendorStrings[] =
 		{
 			// Triés par ordre alphabétique (Majuscules primant sur minuscules)
@@ -101,6 +124,48 @@ namespace Nz
 		return HardwareInfoImpl::Cpuid(functionId, subFunctionId, result);
 	}
 
+	/*!
+	* \brief Gets the number of physical cores
+	* \return Number of physical cores, each of them may run several threads (hyperthreading)
+	*
+	* \remark Doesn't need the initialization of HardwareInfo
+	* \remark Only the first 64 logical processors are taken into account
+	*
+	* \see GetProcessorCount
+	*/
+
+	unsigned int HardwareInfo::GetCoreCount()
+	{
+		return static_cast<unsigned int>(GetCoreMasks().size());
+	}
+
+	/*!
+	* \brief Gets the logical processors of a physical core
+	* \return Bitmask of the logical processors of the core, usable as a thread affinity
+	*
+	* \param coreIndex Index of the core, less than GetCoreCount()
+	*
+	* \remark Doesn't need the initialization of HardwareInfo
+	* \remark Produces a NazaraError if coreIndex is out of range with NAZARA_CORE_SAFE defined
+	*
+	* \see Thread::SetAffinity
+	*/
+
+	UInt64 HardwareInfo::GetCoreProcessorMask(unsigned int coreIndex)
+	{
+		const std::vector<UInt64>& coreMasks = GetCoreMasks();
+
+		#if NAZARA_CORE_SAFE
+		if (coreIndex >= coreMasks.size())
+		{
+			NazaraError("Core index out of range (" + String::Number(coreIndex) + " >= " + String::Number(coreMasks.size()) + ')');
+			return 0;
+		}
+		#endif
+
+		return coreMasks[coreIndex];
+	}
+
 	/*!
 	* \brief Gets the brand of the processor
 	* \return String of the brand
@@ -204,6 +269,16 @@ namespace Nz
 		if (IsInitialized())
 			return true;
 
+		#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+		// There is no cpuid on ARM, NEON is guaranteed by the target the engine was compiled for
+		s_capabilities[ProcessorCap_NEON] = true;
+		#endif
+
+		#if defined(__aarch64__)
+		// The generic timer counter always runs at a constant rate, given by cntfrq_el0
+		s_capabilities[ProcessorCap_InvariantTSC] = true;
+		#endif
+
 		if (!HardwareInfoImpl::IsCpuidSupported())
 		{
 			NazaraError("Cpuid is not supported");
@@ -225,6 +300,7 @@ namespace Nz
 
 		// Note the order: EBX, EDX, ECX
 		UInt32 manufacturerId[3] = {ebx, edx, ecx};
+		UInt32 maxSupportedFunction = eax;
 
 		// Identification of conceptor
 		s_vendorEnum = ProcessorVendor_Unknown;
@@ -237,13 +313,23 @@ namespace Nz
 			}
 		}
 
-		if (eax >= 1)
+		bool hasAvxState = false;
+		bool hasAvx512State = false;
+		if (maxSupportedFunction >= 1)
 		{
 			// Retrieval of certain capacities of the processor (ECX et EDX, function 1)
 			HardwareInfoImpl::Cpuid(1, 0, registers);
 
-			s_capabilities[ProcessorCap_AVX]   = (ecx & (1U << 28)) != 0;
-			s_capabilities[ProcessorCap_FMA3]  = (ecx & (1U << 12)) != 0;
+			// AVX registers are only usable if the OS saves them on context switches (OSXSAVE, then XCR0)
+			if (ecx & (1U << 27))
+			{
+				UInt64 xcr0 = HardwareInfoImpl::Xgetbv(0);
+				hasAvxState = (xcr0 & 0x06) == 0x06;       // XMM and YMM
+				hasAvx512State = (xcr0 & 0xE6) == 0xE6;    // XMM, YMM, opmask and ZMM
+			}
+
+			s_capabilities[ProcessorCap_AVX]   = hasAvxState && (ecx & (1U << 28)) != 0;
+			s_capabilities[ProcessorCap_FMA3]  = hasAvxState && (ecx & (1U << 12)) != 0;
 			s_capabilities[ProcessorCap_MMX]   = (edx & (1U << 23)) != 0;
 			s_capabilities[ProcessorCap_SSE]   = (edx & (1U << 25)) != 0;
 			s_capabilities[ProcessorCap_SSE2]  = (edx & (1U << 26)) != 0;
@@ -251,6 +337,19 @@ namespace Nz
 			s_capabilities[ProcessorCap_SSSE3] = (ecx & (1U <<  9)) != 0;
 			s_capabilities[ProcessorCap_SSE41] = (ecx & (1U << 19)) != 0;
 			s_capabilities[ProcessorCap_SSE42] = (ecx & (1U << 20)) != 0;
+			s_capabilities[ProcessorCap_PCLMULQDQ] = (ecx & (1U << 1)) != 0;
+
+			if (maxSupportedFunction >= 7)
+			{
+				// Structured extended features (EBX, function 7, sub-function 0)
+				HardwareInfoImpl::Cpuid(7, 0, registers);
+
+				s_capabilities[ProcessorCap_AVX2]    = hasAvxState && (ebx & (1U << 5)) != 0;
+				s_capabilities[ProcessorCap_AVX512F] = hasAvx512State && (ebx & (1U << 16)) != 0;
+				s_capabilities[ProcessorCap_BMI1]    = (ebx & (1U << 3)) != 0;
+				s_capabilities[ProcessorCap_BMI2]    = (ebx & (1U << 8)) != 0;
+				s_capabilities[ProcessorCap_SHA]     = (ebx & (1U << 29)) != 0;
+			}
 		}
 
 		// Retrieval of biggest extended function handled (EAX, function 0x80000000)
@@ -263,9 +362,10 @@ namespace Nz
 			HardwareInfoImpl::Cpuid(0x80000001, 0, registers);
 
 			s_capabilities[ProcessorCap_x64]   = (edx & (1U << 29)) != 0; // Support of 64bits, independent of the OS
-			s_capabilities[ProcessorCap_FMA4]  = (ecx & (1U << 16)) != 0;
+			s_capabilities[ProcessorCap_FMA4]  = hasAvxState && (ecx & (1U << 16)) != 0;
 			s_capabilities[ProcessorCap_SSE4a] = (ecx & (1U <<  6)) != 0;
-			s_capabilities[ProcessorCap_XOP]   = (ecx & (1U << 11)) != 0;
+			s_capabilities[ProcessorCap_XOP]   = hasAvxState && (ecx & (1U << 11)) != 0;
+			s_capabilities[ProcessorCap_RDTSCP] = (edx & (1U << 27)) != 0;
 
 			if (maxSupportedExtendedFunction >= 0x80000004)
 			{
@@ -282,6 +382,14 @@ namespace Nz
 
 				// The character '\0' is already part of the string
 			}
+
+			if (maxSupportedExtendedFunction >= 0x80000007)
+			{
+				// Advanced power management (EDX, function 0x80000007), the TSC keeps its rate across P-, C- and T-states
+				HardwareInfoImpl::Cpuid(0x80000007, 0, registers);
+
+				s_capabilities[ProcessorCap_InvariantTSC] = (edx & (1U << 8)) != 0;
+			}
 		}
 
 		return true;
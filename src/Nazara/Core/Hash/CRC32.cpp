@@ -3,7 +3,21 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Hash/CRC32.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
 #include <Nazara/Core/Endianness.hpp>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_HASH_CRC32_PCLMUL
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_PCLMUL_FUNCTION
+	#else
+		#define NAZARA_PCLMUL_FUNCTION __attribute__((target("pclmul,sse4.1")))
+	#endif
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -65,6 +79,118 @@ namespace Nz
 			0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
 			0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 		};
+
+		UInt32 crc32_generic(UInt32 crc, const UInt8* data, std::size_t len)
+		{
+			while (len--)
+				crc = crc32_table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+			return crc;
+		}
+
+		#ifdef NAZARA_HASH_CRC32_PCLMUL
+		// Folds 64 bytes at a time with carry-less multiplications, then reduces to 32 bits (Barrett reduction)
+		// See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel, 2009)
+		// len must be a multiple of 16, of at least 64
+		NAZARA_PCLMUL_FUNCTION UInt32 crc32_pclmul(UInt32 crc, const UInt8* data, std::size_t len)
+		{
+			alignas(16) static const UInt64 k1k2[] = {0x0154442bd4ULL, 0x01c6e41596ULL};
+			alignas(16) static const UInt64 k3k4[] = {0x01751997d0ULL, 0x00ccaa009eULL};
+			alignas(16) static const UInt64 k5k0[] = {0x0163cd6124ULL, 0x0000000000ULL};
+			alignas(16) static const UInt64 poly[] = {0x01db710641ULL, 0x01f7011641ULL};
+
+			__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+			__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+			__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+			__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+
+			x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+			__m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+			data += 64;
+			len -= 64;
+
+			// Parallel fold blocks of 64 bytes
+			while (len >= 64)
+			{
+				__m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+				__m128i x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+				__m128i x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+				__m128i x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+				x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+				x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+				x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+				x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+				x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+				x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+				x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+				x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+
+				data += 64;
+				len -= 64;
+			}
+
+			// Fold into 128 bits
+			x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+			__m128i x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+			x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+			x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+			// Single fold blocks of 16 bytes
+			while (len >= 16)
+			{
+				x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+				x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+				x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+
+				data += 16;
+				len -= 16;
+			}
+
+			// Fold 128 bits to 64 bits
+			x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+			x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+			x1 = _mm_srli_si128(x1, 8);
+			x1 = _mm_xor_si128(x1, x2);
+
+			x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+			x2 = _mm_srli_si128(x1, 4);
+			x1 = _mm_and_si128(x1, x3);
+			x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+			x1 = _mm_xor_si128(x1, x2);
+
+			// Barrett reduce to 32 bits
+			x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+			x2 = _mm_and_si128(x1, x3);
+			x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+			x2 = _mm_and_si128(x2, x3);
+			x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+			x1 = _mm_xor_si128(x1, x2);
+
+			return static_cast<UInt32>(_mm_extract_epi32(x1, 1));
+		}
+		#endif
+
+		// Computes the CRC of the default polynomial over a length multiple of 16, of at least 64
+		CpuKernel<UInt32(UInt32, const UInt8*, std::size_t)> s_crc32Kernel("CRC32", &crc32_generic, {
+			#ifdef NAZARA_HASH_CRC32_PCLMUL
+			{&crc32_pclmul, "PCLMULQDQ", {ProcessorCap_PCLMULQDQ, ProcessorCap_SSE41}}
+			#endif
+		});
 	}
 
 	HashCRC32::HashCRC32(UInt32 polynomial)
@@ -100,6 +226,16 @@ namespace Nz
 
 	void HashCRC32::Append(const UInt8* data, std::size_t len)
 	{
+		// The accelerated implementations only exist for the default polynomial
+		if (m_state->table == crc32_table && len >= 64)
+		{
+			std::size_t foldedLength = len & ~std::size_t(15);
+			m_state->crc = s_crc32Kernel(m_state->crc, data, foldedLength);
+
+			data += foldedLength;
+			len -= foldedLength;
+		}
+
 		while (len--)
 			m_state->crc = m_state->table[(m_state->crc ^ *data++) & 0xFF] ^ (m_state->crc >> 8);
 	}
@@ -39,11 +39,24 @@
 
 #include <Nazara/Core/Hash/SHA/Internal.hpp>
 #include <Nazara/Core/Endianness.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
 #include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		bool HasSHAExtensions()
+		{
+			#ifdef NAZARA_HASH_SHA_INTRINSICS
+			static bool hasExtensions = HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_SHA) && HardwareInfo::HasCapability(ProcessorCap_SSE41);
+			return hasExtensions;
+			#else
+			return false;
+			#endif
+		}
+	}
 
 	/*** ENDIAN REVERSAL MACROS *******************************************/
 	#ifdef NAZARA_LITTLE_ENDIAN
@@ -323,6 +336,14 @@ namespace Nz
 	{
 		void SHA1_Internal_Transform(SHA_CTX* context, const UInt32* data)
 		{
+			#ifdef NAZARA_HASH_SHA_INTRINSICS
+			if (HasSHAExtensions())
+			{
+				SHA1_Internal_TransformSHANI(context, reinterpret_cast<const UInt8*>(data), 1);
+				return;
+			}
+			#endif
+
 			UInt32 a, b, c, d, e;
 			UInt32 T1, *W1;
 			int	j;
@@ -467,6 +488,18 @@ namespace Nz
 			}
 		}
 
+		#ifdef NAZARA_HASH_SHA_INTRINSICS
+		if (len >= 64 && HasSHAExtensions())
+		{
+			/* Process every complete block at once, keeping the state in registers */
+			std::size_t blockCount = len / 64;
+			SHA1_Internal_TransformSHANI(context, data, blockCount);
+			context->s1.bitcount += static_cast<UInt64>(blockCount) * 512;
+			len -= blockCount * 64;
+			data += blockCount * 64;
+		}
+		#endif
+
 		while (len >= 64)
 		{
 			/* Process as many complete blocks as we can */
@@ -591,6 +624,14 @@ namespace Nz
 
 	void SHA256_Internal_Transform(SHA_CTX* context, const UInt32* data)
 	{
+		#ifdef NAZARA_HASH_SHA_INTRINSICS
+		if (HasSHAExtensions())
+		{
+			SHA256_Internal_TransformSHANI(context, reinterpret_cast<const UInt8*>(data), 1);
+			return;
+		}
+		#endif
+
 		UInt32 a, b, c, d, e, f, g, h;
 		UInt32 T1, *W256;
 		int	j;
@@ -679,6 +720,18 @@ namespace Nz
 			}
 		}
 
+		#ifdef NAZARA_HASH_SHA_INTRINSICS
+		if (len >= 64 && HasSHAExtensions())
+		{
+			/* Process every complete block at once, keeping the state in registers */
+			std::size_t blockCount = len / 64;
+			SHA256_Internal_TransformSHANI(context, data, blockCount);
+			context->s256.bitcount += static_cast<UInt64>(blockCount) * 512;
+			len -= blockCount * 64;
+			data += blockCount * 64;
+		}
+		#endif
+
 		while (len >= 64)
 		{
 			/* Process as many complete blocks as we can */
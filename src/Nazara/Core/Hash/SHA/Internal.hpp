@@ -56,6 +56,12 @@
 #define SHA512_DIGEST_LENGTH          64
 #define SHA512_DIGEST_STRING_LENGTH  (SHA512_DIGEST_LENGTH * 2 + 1)
 
+// x86 SHA extensions, selected at runtime through HardwareInfo
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_HASH_SHA_INTRINSICS
+#endif
+
 namespace Nz
 {
 	union SHA_CTX
@@ -104,6 +110,11 @@ namespace Nz
 	void SHA512_Init(SHA_CTX*);
 	void SHA512_Update(SHA_CTX*, const UInt8*, std::size_t);
 	void SHA512_End(SHA_CTX*, UInt8*);
+
+	#ifdef NAZARA_HASH_SHA_INTRINSICS
+	void SHA1_Internal_TransformSHANI(SHA_CTX*, const UInt8*, std::size_t blockCount);
+	void SHA256_Internal_TransformSHANI(SHA_CTX*, const UInt8*, std::size_t blockCount);
+	#endif
 }
 
 #endif /* NAZARA_HASH_SHA2_INTERNAL_HPP */
@@ -0,0 +1,133 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// SHA-1 and SHA-256 block transforms using the x86 SHA extensions (SHA-NI)
+// They are only called after HardwareInfo reported ProcessorCap_SHA and ProcessorCap_SSE41
+
+#include <Nazara/Core/Hash/SHA/Internal.hpp>
+
+#ifdef NAZARA_HASH_SHA_INTRINSICS
+
+#include <immintrin.h>
+#include <Nazara/Core/Debug.hpp>
+
+#if defined(NAZARA_COMPILER_MSVC)
+	#define NAZARA_SHANI_FUNCTION
+#else
+	#define NAZARA_SHANI_FUNCTION __attribute__((target("sha,sse4.1")))
+#endif
+
+namespace Nz
+{
+	namespace
+	{
+		alignas(16) const UInt32 K256[64] =
+		{
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		// Five 4-rounds groups of SHA-1 sharing the same logical function
+		template<int Function>
+		NAZARA_SHANI_FUNCTION void SHA1_Rounds(__m128i& abcd, __m128i& previousAbcd, __m128i& e, __m128i (&w)[4], const UInt8* data, int firstGroup)
+		{
+			const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+			for (int i = firstGroup; i < firstGroup + 5; ++i)
+			{
+				__m128i& current = w[i & 3];
+				if (i < 4)
+					current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i * 16])), mask);
+				else
+					current = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(current, w[(i + 1) & 3]), w[(i + 2) & 3]), w[(i + 3) & 3]);
+
+				if (i == 0)
+					e = _mm_add_epi32(e, current);
+				else
+					e = _mm_sha1nexte_epu32(previousAbcd, current);
+
+				previousAbcd = abcd;
+				abcd = _mm_sha1rnds4_epu32(abcd, e, Function);
+			}
+		}
+	}
+
+	NAZARA_SHANI_FUNCTION void SHA1_Internal_TransformSHANI(SHA_CTX* context, const UInt8* data, std::size_t blockCount)
+	{
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(context->s1.state)), 0x1B);
+		__m128i e0 = _mm_set_epi32(static_cast<int>(context->s1.state[4]), 0, 0, 0);
+
+		for (std::size_t block = 0; block < blockCount; ++block, data += 64)
+		{
+			__m128i abcdSave = abcd;
+			__m128i e0Save = e0;
+
+			__m128i w[4];
+			__m128i previousAbcd;
+			__m128i e = e0;
+
+			SHA1_Rounds<0>(abcd, previousAbcd, e, w, data, 0);
+			SHA1_Rounds<1>(abcd, previousAbcd, e, w, data, 5);
+			SHA1_Rounds<2>(abcd, previousAbcd, e, w, data, 10);
+			SHA1_Rounds<3>(abcd, previousAbcd, e, w, data, 15);
+
+			e0 = _mm_sha1nexte_epu32(previousAbcd, e0Save);
+			abcd = _mm_add_epi32(abcd, abcdSave);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(context->s1.state), _mm_shuffle_epi32(abcd, 0x1B));
+		context->s1.state[4] = static_cast<UInt32>(_mm_extract_epi32(e0, 3));
+	}
+
+	NAZARA_SHANI_FUNCTION void SHA256_Internal_TransformSHANI(SHA_CTX* context, const UInt8* data, std::size_t blockCount)
+	{
+		const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+		// The instructions work on the (A, B, E, F) and (C, D, G, H) halves of the state
+		__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&context->s256.state[0])), 0xB1); // CDAB
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&context->s256.state[4])), 0x1B); // EFGH
+		__m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+		state1 = _mm_blend_epi16(state1, tmp, 0xF0); // CDGH
+
+		for (std::size_t block = 0; block < blockCount; ++block, data += 64)
+		{
+			__m128i abefSave = state0;
+			__m128i cdghSave = state1;
+
+			__m128i w[4];
+			for (int i = 0; i < 16; ++i)
+			{
+				__m128i& current = w[i & 3];
+				if (i < 4)
+					current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[i * 16])), mask);
+				else
+				{
+					__m128i schedule = _mm_add_epi32(_mm_sha256msg1_epu32(current, w[(i + 1) & 3]), _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+					current = _mm_sha256msg2_epu32(schedule, w[(i + 3) & 3]);
+				}
+
+				__m128i message = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(&K256[i * 4])));
+				state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+				state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(message, 0x0E));
+			}
+
+			state0 = _mm_add_epi32(state0, abefSave);
+			state1 = _mm_add_epi32(state1, cdghSave);
+		}
+
+		tmp = _mm_shuffle_epi32(state0, 0x1B); // FEBA
+		state1 = _mm_shuffle_epi32(state1, 0xB1); // DCHG
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&context->s256.state[0]), _mm_blend_epi16(tmp, state1, 0xF0)); // DCBA
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&context->s256.state[4]), _mm_alignr_epi8(state1, tmp, 8)); // HGFE
+	}
+}
+
+#endif // NAZARA_HASH_SHA_INTRINSICS
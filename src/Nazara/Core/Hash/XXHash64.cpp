@@ -0,0 +1,205 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// xxHash64, a fast non-cryptographic hash by Yann Collet
+// https://github.com/Cyan4973/xxHash
+
+#include <Nazara/Core/Hash/XXHash64.hpp>
+#include <Nazara/Core/Endianness.hpp>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct HashXXHash64_state
+	{
+		UInt64 seed;
+		UInt64 totalLength;
+		UInt64 accumulators[4];
+		UInt8 buffer[32];
+		std::size_t bufferSize;
+	};
+
+	namespace
+	{
+		const UInt64 prime1 = 11400714785074694791ULL;
+		const UInt64 prime2 = 14029467366897019727ULL;
+		const UInt64 prime3 =  1609587929392839161ULL;
+		const UInt64 prime4 =  9650029242287828579ULL;
+		const UInt64 prime5 =  2870177450012600261ULL;
+
+		inline UInt64 RotateLeft(UInt64 value, unsigned int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		inline UInt64 Read64(const UInt8* data)
+		{
+			UInt64 value;
+			std::memcpy(&value, data, sizeof(UInt64));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt64));
+			#endif
+
+			return value;
+		}
+
+		inline UInt32 Read32(const UInt8* data)
+		{
+			UInt32 value;
+			std::memcpy(&value, data, sizeof(UInt32));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt32));
+			#endif
+
+			return value;
+		}
+
+		inline UInt64 Round(UInt64 accumulator, UInt64 input)
+		{
+			accumulator += input * prime2;
+			accumulator = RotateLeft(accumulator, 31);
+			return accumulator * prime1;
+		}
+
+		inline UInt64 MergeRound(UInt64 hash, UInt64 accumulator)
+		{
+			hash ^= Round(0, accumulator);
+			return hash * prime1 + prime4;
+		}
+
+		void ProcessStripes(UInt64 accumulators[4], const UInt8* data, std::size_t stripeCount)
+		{
+			// Four independent lanes, kept in registers across the whole input
+			UInt64 v1 = accumulators[0];
+			UInt64 v2 = accumulators[1];
+			UInt64 v3 = accumulators[2];
+			UInt64 v4 = accumulators[3];
+
+			for (std::size_t i = 0; i < stripeCount; ++i, data += 32)
+			{
+				v1 = Round(v1, Read64(data));
+				v2 = Round(v2, Read64(data + 8));
+				v3 = Round(v3, Read64(data + 16));
+				v4 = Round(v4, Read64(data + 24));
+			}
+
+			accumulators[0] = v1;
+			accumulators[1] = v2;
+			accumulators[2] = v3;
+			accumulators[3] = v4;
+		}
+	}
+
+	HashXXHash64::HashXXHash64(UInt64 seed)
+	{
+		m_state = new HashXXHash64_state;
+		m_state->seed = seed;
+	}
+
+	HashXXHash64::~HashXXHash64()
+	{
+		delete m_state;
+	}
+
+	void HashXXHash64::Append(const UInt8* data, std::size_t len)
+	{
+		m_state->totalLength += len;
+
+		if (m_state->bufferSize + len < 32)
+		{
+			std::memcpy(&m_state->buffer[m_state->bufferSize], data, len);
+			m_state->bufferSize += len;
+			return;
+		}
+
+		if (m_state->bufferSize > 0)
+		{
+			std::size_t fillSize = 32 - m_state->bufferSize;
+			std::memcpy(&m_state->buffer[m_state->bufferSize], data, fillSize);
+			ProcessStripes(m_state->accumulators, m_state->buffer, 1);
+
+			data += fillSize;
+			len -= fillSize;
+			m_state->bufferSize = 0;
+		}
+
+		std::size_t stripeCount = len / 32;
+		ProcessStripes(m_state->accumulators, data, stripeCount);
+
+		data += stripeCount * 32;
+		len -= stripeCount * 32;
+
+		std::memcpy(m_state->buffer, data, len);
+		m_state->bufferSize = len;
+	}
+
+	void HashXXHash64::Begin()
+	{
+		m_state->accumulators[0] = m_state->seed + prime1 + prime2;
+		m_state->accumulators[1] = m_state->seed + prime2;
+		m_state->accumulators[2] = m_state->seed;
+		m_state->accumulators[3] = m_state->seed - prime1;
+		m_state->bufferSize = 0;
+		m_state->totalLength = 0;
+	}
+
+	ByteArray HashXXHash64::End()
+	{
+		UInt64 hash;
+		if (m_state->totalLength >= 32)
+		{
+			const UInt64* v = m_state->accumulators;
+			hash = RotateLeft(v[0], 1) + RotateLeft(v[1], 7) + RotateLeft(v[2], 12) + RotateLeft(v[3], 18);
+
+			for (unsigned int i = 0; i < 4; ++i)
+				hash = MergeRound(hash, v[i]);
+		}
+		else
+			hash = m_state->seed + prime5;
+
+		hash += m_state->totalLength;
+
+		const UInt8* ptr = m_state->buffer;
+		std::size_t len = m_state->bufferSize;
+
+		for (; len >= 8; len -= 8, ptr += 8)
+			hash = RotateLeft(hash ^ Round(0, Read64(ptr)), 27) * prime1 + prime4;
+
+		if (len >= 4)
+		{
+			hash = RotateLeft(hash ^ (UInt64(Read32(ptr)) * prime1), 23) * prime2 + prime3;
+			len -= 4;
+			ptr += 4;
+		}
+
+		for (; len > 0; --len, ++ptr)
+			hash = RotateLeft(hash ^ (*ptr * prime5), 11) * prime1;
+
+		hash ^= hash >> 33;
+		hash *= prime2;
+		hash ^= hash >> 29;
+		hash *= prime3;
+		hash ^= hash >> 32;
+
+		// Canonical representation is big endian
+		#ifdef NAZARA_LITTLE_ENDIAN
+		SwapBytes(&hash, sizeof(UInt64));
+		#endif
+
+		return ByteArray(reinterpret_cast<UInt8*>(&hash), 8);
+	}
+
+	std::size_t HashXXHash64::GetDigestLength() const
+	{
+		return 8;
+	}
+
+	const char* HashXXHash64::GetHashName() const
+	{
+		return "xxHash64";
+	}
+}
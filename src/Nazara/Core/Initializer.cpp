@@ -0,0 +1,116 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace Detail
+	{
+		namespace
+		{
+			void InitializeModule(InitializerModule& module)
+			{
+				UInt64 start = GetElapsedMicroseconds();
+				module.initialized = module.initialize();
+				module.initializationTime = GetElapsedMicroseconds() - start;
+			}
+		}
+
+		/*!
+		* \brief Initializes a list of modules
+		* \return true if every module was initialized, if not the initialized ones are uninitialized
+		*
+		* \param modules Modules to initialize, in order
+		* \param moduleCount Number of modules
+		* \param parallel Initialize the modules allowing it on the TaskScheduler before the other ones
+		*/
+
+		bool InitializeModules(InitializerModule* modules, std::size_t moduleCount, bool parallel)
+		{
+			for (std::size_t i = 0; i < moduleCount; ++i)
+			{
+				modules[i].initializationTime = 0;
+				modules[i].initialized = false;
+			}
+
+			bool succeeded = true;
+			if (parallel)
+			{
+				// Every parallel module depends on Core, which is initialized beforehand so that they only increment its counter
+				if (!Core::Initialize())
+				{
+					NazaraError("Failed to initialize core module");
+					return false;
+				}
+
+				std::vector<TaskHandle> tasks;
+				for (std::size_t i = 0; i < moduleCount; ++i)
+				{
+					if (modules[i].parallel)
+					{
+						InitializerModule& module = modules[i];
+						tasks.push_back(TaskScheduler::AddTask([&module]() { InitializeModule(module); }));
+					}
+				}
+
+				TaskScheduler::Wait(tasks);
+
+				for (std::size_t i = 0; i < moduleCount; ++i)
+				{
+					if (modules[i].parallel && !modules[i].initialized)
+						succeeded = false;
+				}
+
+				Core::Uninitialize();
+			}
+
+			if (succeeded)
+			{
+				for (std::size_t i = 0; i < moduleCount; ++i)
+				{
+					if (parallel && modules[i].parallel)
+						continue;
+
+					InitializeModule(modules[i]);
+					if (!modules[i].initialized)
+					{
+						succeeded = false;
+						break;
+					}
+				}
+			}
+
+			if (!succeeded)
+				UninitializeModules(modules, moduleCount);
+
+			return succeeded;
+		}
+
+		/*!
+		* \brief Uninitializes the initialized modules of a list, in reverse order
+		*
+		* \param modules Modules to uninitialize
+		* \param moduleCount Number of modules
+		*/
+
+		void UninitializeModules(InitializerModule* modules, std::size_t moduleCount)
+		{
+			for (std::size_t i = moduleCount; i-- > 0;)
+			{
+				if (modules[i].initialized)
+				{
+					modules[i].uninitialize();
+					modules[i].initialized = false;
+				}
+			}
+		}
+	}
+}
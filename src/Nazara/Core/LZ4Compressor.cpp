@@ -0,0 +1,322 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/LZ4Compressor.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr unsigned int HashLog = 12;
+		constexpr std::size_t HashTableSize = 1 << HashLog;
+		constexpr UInt32 EmptySlot = std::numeric_limits<UInt32>::max();
+		constexpr std::size_t LastLiterals = 5;    //< The last bytes of a block are always literals
+		constexpr std::size_t MatchFindLimit = 12; //< The last match starts at least this far from the end of a block
+		constexpr std::size_t MaxOffset = 65535;
+		constexpr std::size_t MinMatch = 4;
+
+		UInt32 Hash(UInt32 sequence)
+		{
+			return (sequence * 2654435761U) >> (32 - HashLog);
+		}
+
+		UInt32 Read32(const UInt8* ptr)
+		{
+			UInt32 value;
+			std::memcpy(&value, ptr, sizeof(UInt32));
+
+			return value;
+		}
+
+		UInt8* WriteLength(UInt8* output, std::size_t length)
+		{
+			for (; length >= 255; length -= 255)
+				*output++ = 255;
+
+			*output++ = static_cast<UInt8>(length);
+			return output;
+		}
+
+		bool WriteSequence(UInt8*& output, const UInt8* outputEnd, const UInt8* literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+		{
+			// Token, literal length, literals, then offset and match length (the last sequence has no match)
+			std::size_t requiredSize = 1 + literalLength / 255 + 1 + literalLength;
+			if (matchLength > 0)
+				requiredSize += sizeof(UInt16) + (matchLength - MinMatch) / 255 + 1;
+
+			if (static_cast<std::size_t>(outputEnd - output) < requiredSize)
+				return false;
+
+			UInt8* token = output++;
+			*token = static_cast<UInt8>(std::min<std::size_t>(literalLength, 15) << 4);
+			if (literalLength >= 15)
+				output = WriteLength(output, literalLength - 15);
+
+			std::copy(literals, literals + literalLength, output);
+			output += literalLength;
+
+			if (matchLength > 0)
+			{
+				*output++ = static_cast<UInt8>(offset & 0xFF);
+				*output++ = static_cast<UInt8>(offset >> 8);
+
+				matchLength -= MinMatch;
+				*token |= static_cast<UInt8>(std::min<std::size_t>(matchLength, 15));
+				if (matchLength >= 15)
+					output = WriteLength(output, matchLength - 15);
+			}
+
+			return true;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::LZ4Compressor
+	* \brief Core class that compresses and decompresses data blocks in the LZ4 block format
+	*
+	* Compression is fast and greedy, which suits packets compressed one by one before being sent.
+	* A dictionary shared by both sides (for example a typical packet) lets small packets refer to data they do not contain.
+	*
+	* \remark A compressor keeps a hash table between calls, it must not compress from multiple threads at once
+	*/
+
+	/*!
+	* \brief Constructs a LZ4Compressor object without dictionary
+	*/
+
+	LZ4Compressor::LZ4Compressor() :
+	m_dictionaryTable(HashTableSize, EmptySlot),
+	m_hashTable(HashTableSize)
+	{
+	}
+
+	/*!
+	* \brief Compresses a block
+	* \return Size of the compressed block, zero if it does not fit in the output
+	*
+	* \param input Data to compress
+	* \param inputSize Size of the data
+	* \param output Buffer receiving the compressed block
+	* \param outputCapacity Size of the output buffer, ComputeMaxCompressedSize gives a size always big enough
+	*/
+
+	std::size_t LZ4Compressor::Compress(const void* input, std::size_t inputSize, void* output, std::size_t outputCapacity)
+	{
+		NazaraAssert(input || inputSize == 0, "Invalid input");
+		NazaraAssert(output || outputCapacity == 0, "Invalid output");
+
+		const UInt8* in = static_cast<const UInt8*>(input);
+		UInt8* out = static_cast<UInt8*>(output);
+		const UInt8* outEnd = out + outputCapacity;
+
+		// Positions are counted from the beginning of the dictionary, which is followed by the input
+		std::size_t dictionarySize = m_dictionary.GetSize();
+		std::copy(m_dictionaryTable.begin(), m_dictionaryTable.end(), m_hashTable.begin());
+
+		auto MatchesSequence = [&](std::size_t position, UInt32 sequence)
+		{
+			if (position >= dictionarySize)
+				return Read32(&in[position - dictionarySize]) == sequence;
+			else if (position + MinMatch <= dictionarySize)
+				return Read32(&m_dictionary[position]) == sequence;
+			else
+			{
+				// Sequence crossing the end of the dictionary
+				UInt8 sequenceBytes[MinMatch];
+				for (std::size_t i = 0; i < MinMatch; ++i)
+					sequenceBytes[i] = GetByte(position + i, in);
+
+				return Read32(sequenceBytes) == sequence;
+			}
+		};
+
+		std::size_t anchor = 0;
+		if (inputSize > MatchFindLimit)
+		{
+			std::size_t matchStartLimit = inputSize - MatchFindLimit;
+			std::size_t matchEndLimit = inputSize - LastLiterals;
+
+			std::size_t position = 0;
+			while (position < matchStartLimit)
+			{
+				UInt32 sequence = Read32(&in[position]);
+				UInt32& slot = m_hashTable[Hash(sequence)];
+
+				std::size_t candidate = slot;
+				std::size_t virtualPosition = dictionarySize + position;
+				slot = static_cast<UInt32>(virtualPosition);
+
+				if (candidate == EmptySlot || virtualPosition - candidate > MaxOffset || !MatchesSequence(candidate, sequence))
+				{
+					// The longer we go without a match, the more bytes we skip
+					position += 1 + ((position - anchor) >> 6);
+					continue;
+				}
+
+				std::size_t matchLength = MinMatch;
+				while (position + matchLength < matchEndLimit && GetByte(candidate + matchLength, in) == in[position + matchLength])
+					++matchLength;
+
+				while (position > anchor && candidate > 0 && GetByte(candidate - 1, in) == in[position - 1])
+				{
+					--candidate;
+					--position;
+					++matchLength;
+				}
+
+				if (!WriteSequence(out, outEnd, &in[anchor], position - anchor, dictionarySize + position - candidate, matchLength))
+					return 0;
+
+				position += matchLength;
+				anchor = position;
+
+				// Positions inside the match are not indexed, except the one just before its end
+				m_hashTable[Hash(Read32(&in[position - 2]))] = static_cast<UInt32>(dictionarySize + position - 2);
+			}
+		}
+
+		if (!WriteSequence(out, outEnd, &in[anchor], inputSize - anchor, 0, 0))
+			return 0;
+
+		return out - static_cast<UInt8*>(output);
+	}
+
+	/*!
+	* \brief Decompresses a block
+	* \return true If the block is valid and decompresses to exactly outputSize bytes
+	*
+	* \param input Compressed block
+	* \param inputSize Size of the block
+	* \param output Buffer receiving the data
+	* \param outputSize Size of the decompressed data
+	*
+	* \remark The block must have been compressed with the same dictionary
+	* \remark Invalid blocks are rejected without reading or writing out of the buffers
+	*/
+
+	bool LZ4Compressor::Decompress(const void* input, std::size_t inputSize, void* output, std::size_t outputSize) const
+	{
+		NazaraAssert(input || inputSize == 0, "Invalid input");
+		NazaraAssert(output || outputSize == 0, "Invalid output");
+
+		const UInt8* in = static_cast<const UInt8*>(input);
+		const UInt8* inEnd = in + inputSize;
+		UInt8* outStart = static_cast<UInt8*>(output);
+		UInt8* out = outStart;
+		UInt8* outEnd = outStart + outputSize;
+
+		auto ReadLength = [&](std::size_t& length)
+		{
+			UInt8 byte;
+			do
+			{
+				if (in == inEnd)
+					return false;
+
+				byte = *in++;
+				length += byte;
+			}
+			while (byte == 255);
+
+			return true;
+		};
+
+		std::size_t dictionarySize = m_dictionary.GetSize();
+		for (;;)
+		{
+			if (in == inEnd)
+				return false;
+
+			UInt8 token = *in++;
+
+			std::size_t literalLength = token >> 4;
+			if (literalLength == 15 && !ReadLength(literalLength))
+				return false;
+
+			if (literalLength > static_cast<std::size_t>(inEnd - in) || literalLength > static_cast<std::size_t>(outEnd - out))
+				return false;
+
+			std::copy(in, in + literalLength, out);
+			in += literalLength;
+			out += literalLength;
+
+			// The last sequence has no match
+			if (in == inEnd)
+				break;
+
+			if (inEnd - in < 2)
+				return false;
+
+			std::size_t offset = in[0] | (in[1] << 8);
+			in += 2;
+
+			std::size_t matchLength = token & 0x0F;
+			if (matchLength == 15 && !ReadLength(matchLength))
+				return false;
+
+			matchLength += MinMatch;
+
+			std::size_t decompressedSize = out - outStart;
+			if (offset == 0 || offset > decompressedSize + dictionarySize || matchLength > static_cast<std::size_t>(outEnd - out))
+				return false;
+
+			const UInt8* match;
+			if (offset > decompressedSize)
+			{
+				// The match begins in the dictionary and may go on at the beginning of the output
+				std::size_t dictionaryPosition = dictionarySize - (offset - decompressedSize);
+				std::size_t dictionaryLength = std::min(matchLength, dictionarySize - dictionaryPosition);
+
+				std::memcpy(out, &m_dictionary[dictionaryPosition], dictionaryLength);
+				out += dictionaryLength;
+				matchLength -= dictionaryLength;
+
+				match = outStart;
+			}
+			else
+				match = out - offset;
+
+			// Matches may overlap the bytes they produce
+			for (; matchLength > 0; --matchLength)
+				*out++ = *match++;
+		}
+
+		return out == outEnd;
+	}
+
+	/*!
+	* \brief Sets the dictionary
+	*
+	* \param dictionary Data both sides expect to see in packets, nullptr to remove the dictionary
+	* \param dictionarySize Size of the dictionary, only its last MaxDictionarySize bytes are used
+	*
+	* \remark Both sides must use the same dictionary
+	*/
+
+	void LZ4Compressor::SetDictionary(const void* dictionary, std::size_t dictionarySize)
+	{
+		NazaraAssert(dictionary || dictionarySize == 0, "Invalid dictionary");
+
+		if (dictionarySize > MaxDictionarySize)
+		{
+			dictionary = static_cast<const UInt8*>(dictionary) + dictionarySize - MaxDictionarySize;
+			dictionarySize = MaxDictionarySize;
+		}
+
+		if (dictionarySize > 0)
+			m_dictionary = ByteArray(dictionary, dictionarySize);
+		else
+			m_dictionary.Clear();
+
+		std::fill(m_dictionaryTable.begin(), m_dictionaryTable.end(), EmptySlot);
+		for (std::size_t position = 0; position + MinMatch <= dictionarySize; ++position)
+			m_dictionaryTable[Hash(Read32(&m_dictionary[position]))] = static_cast<UInt32>(position);
+	}
+}
@@ -3,16 +3,26 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <new>
 #include <stdexcept>
+#include <thread>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 	#include <windows.h>
 #elif defined(NAZARA_PLATFORM_POSIX)
 	#include <pthread.h>
+	#if defined(__GLIBC__) || defined(NAZARA_PLATFORM_MACOSX)
+		#include <execinfo.h>
+		#define NAZARA_MEMORYMANAGER_BACKTRACE
+	#endif
 #endif
 
 // The only file that does not need to include Debug.hpp
@@ -23,24 +33,703 @@ namespace Nz
 	{
 		constexpr unsigned int s_allocatedId = 0xDEADB33FUL;
 		constexpr unsigned int s_freedId = 0x4B1DUL;
+		constexpr unsigned int s_maxModuleCount = 32;
+		constexpr unsigned int s_maxStackDepth = 16;
+		constexpr std::size_t s_moduleCacheSize = 64;
+		constexpr std::size_t s_moduleNameLength = 32;
+		constexpr std::size_t s_siteCapacity = 4096;
 
-		struct Block
+		enum FreeResult
+		{
+			FreeResult_ArrayMismatch, //< Freed, but with the wrong form of delete
+			FreeResult_DanglingPointer,
+			FreeResult_DoubleDelete,
+			FreeResult_Freed
+		};
+
+		struct ModuleCounters
+		{
+			Int64 allocatedSize;
+			Int64 allocationCount;
+			Int64 liveAllocationCount;
+			Int64 liveSize;
+		};
+
+		// Resolving the module of a file means parsing its path, the result is kept by each thread
+		struct ModuleCache
+		{
+			const char* files[s_moduleCacheSize];
+			UInt8 modules[s_moduleCacheSize];
+		};
+
+		struct SiteEntry
 		{
-			std::size_t size;
 			const char* file;
-			Block* prev;
-			Block* next;
-			bool array;
+			UInt32 stackHash;
+			UInt64 allocatedSize;
+			UInt64 allocationCount;
+			UInt64 liveAllocationCount;
+			UInt64 liveSize;
+			UInt64 sampleCount;
 			unsigned int line;
-			unsigned int magic;
+			bool used;
 		};
 
 		bool s_allocationFilling = true;
 		bool s_allocationLogging = false;
+		bool s_allocationSampling = false;
 		bool s_initialized = false;
 		const char* s_logFileName = "NazaraMemory.log";
+		thread_local ModuleCache s_moduleCache;
 		thread_local const char* s_nextFreeFile = "(Internal error)";
 		thread_local unsigned int s_nextFreeLine = 0;
+		thread_local unsigned int s_samplingCountdown = 0;
+		thread_local UInt32 s_samplingSeed = 0;
+
+		// Sites are stored in a fixed open-addressing table, as the manager cannot rely on an allocator itself
+		SiteEntry s_sites[s_siteCapacity];
+		SiteEntry s_overflowSite;
+		std::chrono::steady_clock::time_point s_samplingStart;
+		std::size_t s_siteCount = 0;
+		unsigned int s_samplingRate = 1024;
+
+		// Module 0 gathers the allocations made without position or outside of the engine
+		char s_moduleNames[s_maxModuleCount][s_moduleNameLength] = {"(unknown)"};
+		ModuleCounters s_sharedCounters[s_maxModuleCount]; //< Updated under the mutex
+		unsigned int s_moduleCount = 1;
+
+		#if defined(NAZARA_PLATFORM_WINDOWS)
+		CRITICAL_SECTION s_mutex;
+		#elif defined(NAZARA_PLATFORM_POSIX)
+		pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+		#else
+		#error Lack of implementation: Mutex
+		#endif
+
+		void LockMutex()
+		{
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			EnterCriticalSection(&s_mutex);
+			#elif defined(NAZARA_PLATFORM_POSIX)
+			pthread_mutex_lock(&s_mutex);
+			#endif
+		}
+
+		void UnlockMutex()
+		{
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			LeaveCriticalSection(&s_mutex);
+			#elif defined(NAZARA_PLATFORM_POSIX)
+			pthread_mutex_unlock(&s_mutex);
+			#endif
+		}
+
+		UInt32 CaptureStackHash()
+		{
+			// FNV-1a over the return addresses
+			UInt32 hash = 2166136261U;
+
+			#if defined(NAZARA_PLATFORM_WINDOWS)
+			void* frames[s_maxStackDepth];
+			USHORT frameCount = CaptureStackBackTrace(1, s_maxStackDepth, frames, nullptr);
+			#elif defined(NAZARA_MEMORYMANAGER_BACKTRACE)
+			void* frames[s_maxStackDepth];
+			int frameCount = backtrace(frames, s_maxStackDepth);
+			#else
+			void* frames[1] = {nullptr};
+			int frameCount = 0;
+			#endif
+
+			for (int i = 0; i < static_cast<int>(frameCount); ++i)
+			{
+				std::uintptr_t address = reinterpret_cast<std::uintptr_t>(frames[i]);
+				for (unsigned int j = 0; j < sizeof(address); ++j)
+				{
+					hash ^= static_cast<UInt8>(address >> (j * 8));
+					hash *= 16777619U;
+				}
+			}
+
+			return hash;
+		}
+
+		SiteEntry* GetSite(const char* file, unsigned int line, UInt32 stackHash)
+		{
+			std::size_t hash = stackHash ^ (reinterpret_cast<std::uintptr_t>(file) * 31U) ^ (line * 2654435761U);
+			for (std::size_t i = 0; i < s_siteCapacity; ++i)
+			{
+				SiteEntry& site = s_sites[(hash + i) % s_siteCapacity];
+				if (!site.used)
+				{
+					// Keep a few free entries, so lookups of unknown sites stay short
+					if (s_siteCount >= s_siteCapacity * 3 / 4)
+						break;
+
+					site = SiteEntry();
+					site.file = file;
+					site.line = line;
+					site.stackHash = stackHash;
+					site.used = true;
+					s_siteCount++;
+
+					return &site;
+				}
+
+				if (site.file == file && site.line == line && site.stackHash == stackHash)
+					return &site;
+			}
+
+			return &s_overflowSite;
+		}
+
+		// Must be called with the mutex locked
+		SiteEntry* RecordSample(const char* file, unsigned int line, UInt32 stackHash, std::size_t size, unsigned int weight)
+		{
+			// Each sample stands for the allocations made since the previous one
+			SiteEntry* site = GetSite(file, line, stackHash);
+			site->allocatedSize += static_cast<UInt64>(size) * weight;
+			site->allocationCount += weight;
+			site->liveAllocationCount += weight;
+			site->liveSize += static_cast<UInt64>(size) * weight;
+			site->sampleCount++;
+
+			return site;
+		}
+
+		UInt8 ResolveModule(const char* file)
+		{
+			// Engine files are under Nazara/<Module>/, the SDK ones under NDK/
+			const char* name = nullptr;
+			std::size_t length = 0;
+			for (const char* ptr = file; *ptr; ++ptr)
+			{
+				if (std::strncmp(ptr, "Nazara", 6) == 0 && (ptr[6] == '/' || ptr[6] == '\\'))
+				{
+					const char* end = std::strpbrk(ptr + 7, "/\\");
+					if (end)
+					{
+						name = ptr + 7;
+						length = end - name;
+					}
+				}
+				else if (std::strncmp(ptr, "NDK", 3) == 0 && (ptr[3] == '/' || ptr[3] == '\\'))
+				{
+					name = "SDK";
+					length = 3;
+				}
+			}
+
+			if (!name || length == 0 || length >= s_moduleNameLength)
+				return 0;
+
+			LockMutex();
+
+			unsigned int module = 0;
+			for (unsigned int i = 1; i < s_moduleCount; ++i)
+			{
+				if (std::strncmp(s_moduleNames[i], name, length) == 0 && s_moduleNames[i][length] == '\0')
+				{
+					module = i;
+					break;
+				}
+			}
+
+			if (module == 0 && s_moduleCount < s_maxModuleCount)
+			{
+				module = s_moduleCount++;
+				std::memcpy(s_moduleNames[module], name, length);
+				s_moduleNames[module][length] = '\0';
+			}
+
+			UnlockMutex();
+
+			return static_cast<UInt8>(module);
+		}
+
+		UInt8 GetModule(const char* file)
+		{
+			if (!file)
+				return 0;
+
+			// __FILE__ strings are unique per translation unit (at worst, a file is resolved a few times)
+			std::size_t index = (reinterpret_cast<std::uintptr_t>(file) >> 4) % s_moduleCacheSize;
+			if (s_moduleCache.files[index] != file)
+			{
+				s_moduleCache.modules[index] = ResolveModule(file);
+				s_moduleCache.files[index] = file;
+			}
+
+			return s_moduleCache.modules[index];
+		}
+
+		unsigned int NextSamplingInterval()
+		{
+			// Randomize the interval around the sampling rate, so periodic allocation patterns cannot alias with it
+			if (s_samplingSeed == 0)
+				s_samplingSeed = static_cast<UInt32>(reinterpret_cast<std::uintptr_t>(&s_samplingSeed)) | 1U;
+
+			s_samplingSeed ^= s_samplingSeed << 13;
+			s_samplingSeed ^= s_samplingSeed >> 17;
+			s_samplingSeed ^= s_samplingSeed << 5;
+
+			unsigned int rate = s_samplingRate;
+			if (rate <= 1)
+				return 1;
+
+			return 1 + s_samplingSeed % (2 * rate - 1);
+		}
+
+		void WriteSite(FILE* file, const MemoryManager::AllocationSite& site)
+		{
+			if (site.file)
+				std::fprintf(file, "%s:%u", site.file, site.line);
+			else
+				std::fputs("unknown position", file);
+
+			std::fprintf(file, " [stack %08X] -> %llu live bytes in %llu blocks, %llu bytes in %llu allocations (%.1f/s), %llu samples\n", site.stackHash,
+			             static_cast<unsigned long long>(site.liveSize), static_cast<unsigned long long>(site.liveAllocationCount),
+			             static_cast<unsigned long long>(site.allocatedSize), static_cast<unsigned long long>(site.allocationCount),
+			             site.allocationRate, static_cast<unsigned long long>(site.sampleCount));
+		}
+
+		#if NAZARA_CORE_MEMORYMANAGER_THREADCACHE
+		// Blocks up to 32 KiB are rounded to one of these sizes and recycled, bigger ones are allocated by malloc
+		constexpr std::size_t s_sizeClassCount = 40;
+		constexpr std::size_t s_sizeClasses[s_sizeClassCount] =
+		{
+			16,    32,    48,    64,    80,    96,    112,   128,
+			160,   192,   224,   256,   320,   384,   448,   512,
+			640,   768,   896,   1024,  1280,  1536,  1792,  2048,
+			2560,  3072,  3584,  4096,  5120,  6144,  7168,  8192,
+			10240, 12288, 14336, 16384, 20480, 24576, 28672, 32768
+		};
+
+		constexpr std::size_t s_chunkSize = 64 * 1024;
+		constexpr UInt8 s_largeClass = s_sizeClassCount;
+
+		// Precedes every block, keeps the user data aligned on 16 bytes
+		struct alignas(16) CachedHeader
+		{
+			std::size_t size;
+			UInt32 magic;
+			UInt8 sizeClass;
+			UInt8 module;
+			bool array;
+			bool sampled;
+		};
+
+		// Precedes the header of sampled blocks, which are always allocated by malloc
+		struct alignas(16) SampleHeader
+		{
+			SiteEntry* site;
+			unsigned int weight;
+		};
+
+		// Free blocks are linked through their header
+		struct FreeNode
+		{
+			FreeNode* next;
+		};
+
+		// Blocks shared between the threads, refilling or releasing a cache moves a whole batch at once
+		struct CentralList
+		{
+			std::atomic_flag lock = ATOMIC_FLAG_INIT;
+			FreeNode* head = nullptr;
+		};
+
+		struct ThreadCache
+		{
+			struct ClassCache
+			{
+				FreeNode* head;
+				unsigned int count;
+			};
+
+			// Only written by the owning thread, read by the others when gathering statistics
+			struct Counters
+			{
+				std::atomic<Int64> allocatedSize;
+				std::atomic<Int64> allocationCount;
+				std::atomic<Int64> liveAllocationCount; //< Can get negative when other threads allocated the blocks freed by this one
+				std::atomic<Int64> liveSize;
+			};
+
+			ClassCache classes[s_sizeClassCount];
+			Counters counters[s_maxModuleCount];
+			ThreadCache* next;
+			ThreadCache* prev;
+		};
+
+		struct ThreadCacheReleaser
+		{
+			~ThreadCacheReleaser();
+		};
+
+		CentralList s_centralLists[s_sizeClassCount];
+		ThreadCache* s_threadCaches = nullptr; //< Under the mutex
+		thread_local ThreadCache* s_threadCache = nullptr;
+		thread_local bool s_threadCacheReleased = false;
+
+		void AddRelaxed(std::atomic<Int64>& counter, Int64 value)
+		{
+			// Only the owning thread writes the counter, no need for an atomic addition
+			counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+		}
+
+		unsigned int GetBatchSize(unsigned int sizeClass)
+		{
+			return static_cast<unsigned int>(std::max<std::size_t>(2, std::min<std::size_t>(64, 16 * 1024 / s_sizeClasses[sizeClass])));
+		}
+
+		unsigned int GetSizeClass(std::size_t size)
+		{
+			if (size <= 128)
+				return (size > 0) ? static_cast<unsigned int>((size - 1) / 16) : 0;
+
+			// Four classes per power of two
+			std::size_t value = size - 1;
+			unsigned int highestBit = 7;
+			while ((value >> (highestBit + 1)) != 0)
+				highestBit++;
+
+			return 8 + (highestBit - 7) * 4 + static_cast<unsigned int>((value >> (highestBit - 2)) & 3);
+		}
+
+		void LockCentral(CentralList& list)
+		{
+			while (list.lock.test_and_set(std::memory_order_acquire))
+				std::this_thread::yield();
+		}
+
+		void UnlockCentral(CentralList& list)
+		{
+			list.lock.clear(std::memory_order_release);
+		}
+
+		void PushCentral(unsigned int sizeClass, FreeNode* first, FreeNode* last)
+		{
+			CentralList& list = s_centralLists[sizeClass];
+
+			LockCentral(list);
+			last->next = list.head;
+			list.head = first;
+			UnlockCentral(list);
+		}
+
+		// Takes up to count blocks from the central list, a new chunk is carved when it is empty
+		unsigned int FetchBlocks(unsigned int sizeClass, unsigned int count, FreeNode** blocks)
+		{
+			CentralList& list = s_centralLists[sizeClass];
+
+			LockCentral(list);
+
+			FreeNode* first = list.head;
+			FreeNode* last = nullptr;
+			unsigned int fetched = 0;
+			for (FreeNode* block = first; block && fetched < count; block = block->next)
+			{
+				last = block;
+				fetched++;
+			}
+
+			if (last)
+			{
+				list.head = last->next;
+				last->next = nullptr;
+			}
+
+			UnlockCentral(list);
+
+			if (fetched == 0)
+			{
+				// Chunks are never given back to the system, their blocks are recycled for the same class
+				std::size_t stride = sizeof(CachedHeader) + s_sizeClasses[sizeClass];
+				std::size_t blockCount = std::max<std::size_t>(count, s_chunkSize / stride);
+
+				UInt8* chunk = static_cast<UInt8*>(std::malloc(stride * blockCount));
+				if (!chunk)
+					return 0;
+
+				for (std::size_t i = 0; i < blockCount; ++i)
+					reinterpret_cast<FreeNode*>(&chunk[i * stride])->next = (i + 1 < blockCount) ? reinterpret_cast<FreeNode*>(&chunk[(i + 1) * stride]) : nullptr;
+
+				first = reinterpret_cast<FreeNode*>(chunk);
+				fetched = count;
+
+				if (blockCount > count)
+				{
+					last = reinterpret_cast<FreeNode*>(&chunk[(count - 1) * stride]);
+					PushCentral(sizeClass, last->next, reinterpret_cast<FreeNode*>(&chunk[(blockCount - 1) * stride]));
+					last->next = nullptr;
+				}
+			}
+
+			*blocks = first;
+			return fetched;
+		}
+
+		// Moves count blocks of the cache back to the central list
+		void ReleaseBlocks(unsigned int sizeClass, ThreadCache::ClassCache& classCache, unsigned int count)
+		{
+			FreeNode* first = classCache.head;
+			FreeNode* last = first;
+			for (unsigned int i = 1; i < count; ++i)
+				last = last->next;
+
+			classCache.head = last->next;
+			classCache.count -= count;
+
+			PushCentral(sizeClass, first, last);
+		}
+
+		ThreadCache* GetThreadCache()
+		{
+			if (s_threadCache || s_threadCacheReleased)
+				return s_threadCache;
+
+			void* memory = std::calloc(1, sizeof(ThreadCache));
+			if (!memory)
+				return nullptr;
+
+			ThreadCache* cache = new (memory) ThreadCache();
+
+			LockMutex();
+			cache->next = s_threadCaches;
+			cache->prev = nullptr;
+			if (s_threadCaches)
+				s_threadCaches->prev = cache;
+
+			s_threadCaches = cache;
+			UnlockMutex();
+
+			s_threadCache = cache;
+
+			// Gives the blocks back when the thread exits
+			static thread_local ThreadCacheReleaser releaser;
+			NazaraUnused(releaser);
+
+			return cache;
+		}
+
+		ThreadCacheReleaser::~ThreadCacheReleaser()
+		{
+			ThreadCache* cache = s_threadCache;
+
+			// Blocks freed by the destructors running after this one go straight to the central lists
+			s_threadCache = nullptr;
+			s_threadCacheReleased = true;
+
+			for (unsigned int i = 0; i < s_sizeClassCount; ++i)
+			{
+				ThreadCache::ClassCache& classCache = cache->classes[i];
+				if (classCache.count > 0)
+					ReleaseBlocks(i, classCache, classCache.count);
+			}
+
+			LockMutex();
+
+			for (unsigned int i = 0; i < s_maxModuleCount; ++i)
+			{
+				const ThreadCache::Counters& counters = cache->counters[i];
+				s_sharedCounters[i].allocatedSize += counters.allocatedSize.load(std::memory_order_relaxed);
+				s_sharedCounters[i].allocationCount += counters.allocationCount.load(std::memory_order_relaxed);
+				s_sharedCounters[i].liveAllocationCount += counters.liveAllocationCount.load(std::memory_order_relaxed);
+				s_sharedCounters[i].liveSize += counters.liveSize.load(std::memory_order_relaxed);
+			}
+
+			if (cache->prev)
+				cache->prev->next = cache->next;
+			else
+				s_threadCaches = cache->next;
+
+			if (cache->next)
+				cache->next->prev = cache->prev;
+
+			UnlockMutex();
+
+			cache->~ThreadCache();
+			std::free(cache);
+		}
+
+		void CountBlock(ThreadCache* cache, UInt8 module, std::size_t size, bool allocated)
+		{
+			Int64 sign = (allocated) ? 1 : -1;
+
+			if (cache)
+			{
+				ThreadCache::Counters& counters = cache->counters[module];
+				if (allocated)
+				{
+					AddRelaxed(counters.allocatedSize, size);
+					AddRelaxed(counters.allocationCount, 1);
+				}
+
+				AddRelaxed(counters.liveAllocationCount, sign);
+				AddRelaxed(counters.liveSize, sign * static_cast<Int64>(size));
+			}
+			else
+			{
+				LockMutex();
+
+				ModuleCounters& counters = s_sharedCounters[module];
+				if (allocated)
+				{
+					counters.allocatedSize += size;
+					counters.allocationCount++;
+				}
+
+				counters.liveAllocationCount += sign;
+				counters.liveSize += sign * static_cast<Int64>(size);
+
+				UnlockMutex();
+			}
+		}
+
+		void* AllocateBlock(std::size_t size, bool multi, const char* file, unsigned int line, UInt8 module, bool sampled, UInt32 stackHash)
+		{
+			ThreadCache* cache = GetThreadCache();
+
+			CachedHeader* header;
+			if (sampled)
+			{
+				SampleHeader* sample = static_cast<SampleHeader*>(std::malloc(sizeof(SampleHeader) + sizeof(CachedHeader) + size));
+				if (!sample)
+					return nullptr;
+
+				sample->weight = s_samplingRate;
+
+				LockMutex();
+				sample->site = RecordSample(file, line, stackHash, size, sample->weight);
+				UnlockMutex();
+
+				header = reinterpret_cast<CachedHeader*>(sample + 1);
+				header->sizeClass = s_largeClass;
+			}
+			else if (size > s_sizeClasses[s_sizeClassCount - 1])
+			{
+				header = static_cast<CachedHeader*>(std::malloc(sizeof(CachedHeader) + size));
+				if (!header)
+					return nullptr;
+
+				header->sizeClass = s_largeClass;
+			}
+			else
+			{
+				unsigned int sizeClass = GetSizeClass(size);
+
+				FreeNode* block;
+				if (cache)
+				{
+					ThreadCache::ClassCache& classCache = cache->classes[sizeClass];
+					if (!classCache.head)
+						classCache.count = FetchBlocks(sizeClass, GetBatchSize(sizeClass), &classCache.head);
+
+					block = classCache.head;
+					if (!block)
+						return nullptr;
+
+					classCache.head = block->next;
+					classCache.count--;
+				}
+				else if (FetchBlocks(sizeClass, 1, &block) == 0)
+					return nullptr;
+
+				header = reinterpret_cast<CachedHeader*>(block);
+				header->sizeClass = static_cast<UInt8>(sizeClass);
+			}
+
+			header->array = multi;
+			header->magic = s_allocatedId;
+			header->module = module;
+			header->sampled = sampled;
+			header->size = size;
+
+			CountBlock(cache, module, size, true);
+
+			return header + 1;
+		}
+
+		FreeResult FreeBlock(void* pointer, bool multi)
+		{
+			CachedHeader* header = static_cast<CachedHeader*>(pointer) - 1;
+			if (header->magic != s_allocatedId)
+				return (header->magic == s_freedId) ? FreeResult_DoubleDelete : FreeResult_DanglingPointer;
+
+			FreeResult result = (header->array != multi) ? FreeResult_ArrayMismatch : FreeResult_Freed;
+			header->magic = s_freedId;
+
+			if (s_allocationFilling)
+				std::memset(pointer, 0xFF, header->size);
+
+			ThreadCache* cache = GetThreadCache();
+			CountBlock(cache, header->module, header->size, false);
+
+			if (header->sampled)
+			{
+				SampleHeader* sample = reinterpret_cast<SampleHeader*>(header) - 1;
+
+				LockMutex();
+				sample->site->liveAllocationCount -= sample->weight;
+				sample->site->liveSize -= static_cast<UInt64>(header->size) * sample->weight;
+				UnlockMutex();
+
+				std::free(sample);
+			}
+			else if (header->sizeClass == s_largeClass)
+				std::free(header);
+			else
+			{
+				// The block joins the cache of the freeing thread, whichever thread allocated it
+				unsigned int sizeClass = header->sizeClass;
+				FreeNode* block = reinterpret_cast<FreeNode*>(header);
+
+				if (cache)
+				{
+					ThreadCache::ClassCache& classCache = cache->classes[sizeClass];
+					block->next = classCache.head;
+					classCache.head = block;
+
+					unsigned int batchSize = GetBatchSize(sizeClass);
+					if (++classCache.count > 2 * batchSize)
+						ReleaseBlocks(sizeClass, classCache, batchSize);
+				}
+				else
+					PushCentral(sizeClass, block, block);
+			}
+
+			return result;
+		}
+
+		// Must be called with the mutex locked
+		ModuleCounters GetModuleCounters(unsigned int module)
+		{
+			ModuleCounters counters = s_sharedCounters[module];
+			for (ThreadCache* cache = s_threadCaches; cache; cache = cache->next)
+			{
+				const ThreadCache::Counters& cacheCounters = cache->counters[module];
+				counters.allocatedSize += cacheCounters.allocatedSize.load(std::memory_order_relaxed);
+				counters.allocationCount += cacheCounters.allocationCount.load(std::memory_order_relaxed);
+				counters.liveAllocationCount += cacheCounters.liveAllocationCount.load(std::memory_order_relaxed);
+				counters.liveSize += cacheCounters.liveSize.load(std::memory_order_relaxed);
+			}
+
+			return counters;
+		}
+		#else
+		struct Block
+		{
+			std::size_t size;
+			const char* file;
+			Block* prev;
+			Block* next;
+			SiteEntry* site;
+			bool array;
+			unsigned int line;
+			unsigned int magic;
+			unsigned int sampleWeight;
+			UInt8 module;
+		};
 
 		Block s_list =
 		{
@@ -48,8 +737,11 @@ namespace Nz
 			nullptr,
 			&s_list,
 			&s_list,
+			nullptr,
 			false,
 			0,
+			0,
+			0,
 			0
 		};
 
@@ -57,19 +749,112 @@ namespace Nz
 		unsigned int s_allocatedBlock = 0;
 		std::size_t s_allocatedSize = 0;
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		CRITICAL_SECTION s_mutex;
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
-		#else
-		#error Lack of implementation: Mutex
+		// Every block is linked in a list, so leaks can be listed with their position
+		void* AllocateBlock(std::size_t size, bool multi, const char* file, unsigned int line, UInt8 module, bool sampled, UInt32 stackHash)
+		{
+			LockMutex();
+
+			Block* ptr = static_cast<Block*>(std::malloc(size+sizeof(Block)));
+			if (!ptr)
+			{
+				UnlockMutex();
+				return nullptr;
+			}
+
+			ptr->array = multi;
+			ptr->file = file;
+			ptr->line = line;
+			ptr->module = module;
+			ptr->size = size;
+			ptr->magic = s_allocatedId;
+
+			ptr->prev = s_list.prev;
+			ptr->next = &s_list;
+			s_list.prev->next = ptr;
+			s_list.prev = ptr;
+
+			s_allocatedBlock++;
+			s_allocatedSize += size;
+			s_allocationCount++;
+
+			ModuleCounters& counters = s_sharedCounters[module];
+			counters.allocatedSize += size;
+			counters.allocationCount++;
+			counters.liveAllocationCount++;
+			counters.liveSize += size;
+
+			if (sampled)
+			{
+				ptr->sampleWeight = s_samplingRate;
+				ptr->site = RecordSample(file, line, stackHash, size, ptr->sampleWeight);
+			}
+			else
+			{
+				ptr->site = nullptr;
+				ptr->sampleWeight = 0;
+			}
+
+			UnlockMutex();
+
+			return reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
+		}
+
+		FreeResult FreeBlock(void* pointer, bool multi)
+		{
+			Block* ptr = reinterpret_cast<Block*>(static_cast<UInt8*>(pointer) - sizeof(Block));
+			if (ptr->magic != s_allocatedId)
+				return (ptr->magic == s_freedId) ? FreeResult_DoubleDelete : FreeResult_DanglingPointer;
+
+			LockMutex();
+
+			FreeResult result = (ptr->array != multi) ? FreeResult_ArrayMismatch : FreeResult_Freed;
+
+			ptr->magic = s_freedId;
+			ptr->prev->next = ptr->next;
+			ptr->next->prev = ptr->prev;
+
+			s_allocatedBlock--;
+			s_allocatedSize -= ptr->size;
+
+			ModuleCounters& counters = s_sharedCounters[ptr->module];
+			counters.liveAllocationCount--;
+			counters.liveSize -= ptr->size;
+
+			if (ptr->site)
+			{
+				ptr->site->liveAllocationCount -= ptr->sampleWeight;
+				ptr->site->liveSize -= static_cast<UInt64>(ptr->size) * ptr->sampleWeight;
+			}
+
+			UnlockMutex();
+
+			if (s_allocationFilling)
+			{
+				UInt8* data = reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
+				std::memset(data, 0xFF, ptr->size);
+			}
+
+			std::free(ptr);
+
+			return result;
+		}
+
+		// Must be called with the mutex locked
+		ModuleCounters GetModuleCounters(unsigned int module)
+		{
+			return s_sharedCounters[module];
+		}
 		#endif
 	}
-	
+
 	/*!
 	* \ingroup core
 	* \class Nz::MemoryManager
 	* \brief Core class that represents a manager for the memory
+	*
+	* By default, every block is linked in a list under a global lock so leaks can be listed along with their position.
+	* With NAZARA_CORE_MEMORYMANAGER_THREADCACHE, blocks are rounded to size classes and recycled through per-thread caches instead,
+	* leaks are then only counted per module (and per site when sampling allocations), but the cost is close to the one of malloc.
 	*/
 
 	/*!
@@ -104,14 +889,23 @@ namespace Nz
 		if (!s_initialized)
 			Initialize();
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		EnterCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_lock(&s_mutex);
-		#endif
+		// Sampling decision and stack capture are made before locking, to keep the cost of unsampled allocations to a thread-local decrement
+		bool sampled = false;
+		UInt32 stackHash = 0;
+		if (s_allocationSampling)
+		{
+			if (s_samplingCountdown == 0)
+				s_samplingCountdown = NextSamplingInterval();
+
+			if (--s_samplingCountdown == 0)
+			{
+				sampled = true;
+				stackHash = CaptureStackHash();
+			}
+		}
 
-		Block* ptr = static_cast<Block*>(std::malloc(size+sizeof(Block)));
-		if (!ptr)
+		void* pointer = AllocateBlock(size, multi, file, line, GetModule(file), sampled, stackHash);
+		if (!pointer)
 		{
 			char timeStr[23];
 			TimeInfo(timeStr);
@@ -128,32 +922,16 @@ namespace Nz
 			throw std::bad_alloc();
 		}
 
-		ptr->array = multi;
-		ptr->file = file;
-		ptr->line = line;
-		ptr->size = size;
-		ptr->magic = s_allocatedId;
-
-		ptr->prev = s_list.prev;
-		ptr->next = &s_list;
-		s_list.prev->next = ptr;
-		s_list.prev = ptr;
-
-		s_allocatedBlock++;
-		s_allocatedSize += size;
-		s_allocationCount++;
-
 		if (s_allocationFilling)
-		{
-			UInt8* data = reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
-			std::memset(data, 0xFF, size);
-		}
+			std::memset(pointer, 0xFF, size);
 
 		if (s_allocationLogging)
 		{
 			char timeStr[23];
 			TimeInfo(timeStr);
 
+			LockMutex();
+
 			FILE* log = std::fopen(s_logFileName, "a");
 
 			if (file)
@@ -162,15 +940,37 @@ namespace Nz
 				std::fprintf(log, "%s Allocated %zu bytes at unknown position\n", timeStr, size);
 
 			std::fclose(log);
+
+			UnlockMutex();
 		}
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		LeaveCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_unlock(&s_mutex);
-		#endif
+		return pointer;
+	}
 
-		return reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
+	/*!
+	* \brief Writes the allocation sites recorded by sampling, sorted by live size
+	*
+	* \param filePath Path of the file to append the report to, the memory log is used if nullptr
+	*
+	* \see EnableAllocationSampling
+	*/
+
+	void MemoryManager::DumpAllocationSites(const char* filePath)
+	{
+		std::vector<AllocationSite> sites = GetAllocationSites();
+
+		FILE* log = std::fopen((filePath) ? filePath : s_logFileName, "a");
+		if (!log)
+			return;
+
+		char timeStr[23];
+		TimeInfo(timeStr);
+
+		std::fprintf(log, "%s Allocation sites (sampling rate: 1/%u, %zu sites):\n", timeStr, s_samplingRate, sites.size());
+		for (const AllocationSite& site : sites)
+			WriteSite(log, site);
+
+		std::fclose(log);
 	}
 
 	/*!
@@ -195,6 +995,31 @@ namespace Nz
 		s_allocationLogging = logAllocations;
 	}
 
+	/*!
+	* \brief Enables the sampling of the allocations
+	*
+	* When enabled, about one allocation out of the sampling rate is recorded along with its position and a hash of its call stack,
+	* per-site counters are then updated to give an estimation of the live memory and allocation rate of each call site.
+	* Unlike logging, this is cheap enough to be left enabled in production.
+	*
+	* \param sampleAllocations If true, samples allocations
+	*
+	* \see DumpAllocationSites, GetAllocationSites, SetAllocationSamplingRate
+	*/
+
+	void MemoryManager::EnableAllocationSampling(bool sampleAllocations)
+	{
+		if (sampleAllocations && !s_allocationSampling)
+		{
+			// Stack capture may allocate the first time it is used (ex: glibc loading libgcc), do it now
+			CaptureStackHash();
+
+			s_samplingStart = std::chrono::steady_clock::now();
+		}
+
+		s_allocationSampling = sampleAllocations;
+	}
+
 	/*!
 	* \brief Frees the pointer
 	*
@@ -209,69 +1034,48 @@ namespace Nz
 		if (!pointer)
 			return;
 
-		Block* ptr = reinterpret_cast<Block*>(static_cast<UInt8*>(pointer) - sizeof(Block));
-		if (ptr->magic != s_allocatedId)
+		FreeResult result = FreeBlock(pointer, multi);
+		if (result != FreeResult_Freed)
 		{
 			char timeStr[23];
 			TimeInfo(timeStr);
 
-			FILE* log = std::fopen(s_logFileName, "a");
-
-			const char* error = (ptr->magic == s_freedId) ? "double-delete" : "possible delete of dangling pointer";
-			if (s_nextFreeFile)
-				std::fprintf(log, "%s Warning: %s at %s:%u\n", timeStr, error, s_nextFreeFile, s_nextFreeLine);
-			else
-				std::fprintf(log, "%s Warning: %s at unknown position\n", timeStr, error);
+			LockMutex();
 
-			std::fclose(log);
-			return;
-		}
+			FILE* log = std::fopen(s_logFileName, "a");
 
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		EnterCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_lock(&s_mutex);
-		#endif
+			const char* error;
+			switch (result)
+			{
+				case FreeResult_ArrayMismatch:
+					error = (multi) ? "delete[] after new" : "delete after new[]";
+					break;
 
-		if (ptr->array != multi)
-		{
-			char timeStr[23];
-			TimeInfo(timeStr);
+				case FreeResult_DoubleDelete:
+					error = "double-delete";
+					break;
 
-			FILE* log = std::fopen(s_logFileName, "a");
+				default:
+					error = "possible delete of dangling pointer";
+					break;
+			}
 
-			const char* error = (multi) ? "delete[] after new" : "delete after new[]";
 			if (s_nextFreeFile)
 				std::fprintf(log, "%s Warning: %s at %s:%u\n", timeStr, error, s_nextFreeFile, s_nextFreeLine);
 			else
 				std::fprintf(log, "%s Warning: %s at unknown position\n", timeStr, error);
 
 			std::fclose(log);
-		}
 
-		ptr->magic = s_freedId;
-		ptr->prev->next = ptr->next;
-		ptr->next->prev = ptr->prev;
+			UnlockMutex();
 
-		s_allocatedBlock--;
-		s_allocatedSize -= ptr->size;
-
-		if (s_allocationFilling)
-		{
-			UInt8* data = reinterpret_cast<UInt8*>(ptr) + sizeof(Block);
-			std::memset(data, 0xFF, ptr->size);
+			// The block was not freed
+			if (result != FreeResult_ArrayMismatch)
+				return;
 		}
 
-		std::free(ptr);
-
 		s_nextFreeFile = nullptr;
 		s_nextFreeLine = 0;
-
-		#if defined(NAZARA_PLATFORM_WINDOWS)
-		LeaveCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_unlock(&s_mutex);
-		#endif
 	}
 
 	/*!
@@ -281,7 +1085,18 @@ namespace Nz
 
 	unsigned int MemoryManager::GetAllocatedBlockCount()
 	{
+		#if NAZARA_CORE_MEMORYMANAGER_THREADCACHE
+		Int64 blockCount = 0;
+
+		LockMutex();
+		for (unsigned int i = 0; i < s_moduleCount; ++i)
+			blockCount += GetModuleCounters(i).liveAllocationCount;
+		UnlockMutex();
+
+		return static_cast<unsigned int>(std::max<Int64>(blockCount, 0));
+		#else
 		return s_allocatedBlock;
+		#endif
 	}
 
 	/*!
@@ -291,7 +1106,18 @@ namespace Nz
 
 	std::size_t MemoryManager::GetAllocatedSize()
 	{
+		#if NAZARA_CORE_MEMORYMANAGER_THREADCACHE
+		Int64 allocatedSize = 0;
+
+		LockMutex();
+		for (unsigned int i = 0; i < s_moduleCount; ++i)
+			allocatedSize += GetModuleCounters(i).liveSize;
+		UnlockMutex();
+
+		return static_cast<std::size_t>(std::max<Int64>(allocatedSize, 0));
+		#else
 		return s_allocatedSize;
+		#endif
 	}
 
 	/*!
@@ -301,7 +1127,136 @@ namespace Nz
 
 	unsigned int MemoryManager::GetAllocationCount()
 	{
+		#if NAZARA_CORE_MEMORYMANAGER_THREADCACHE
+		Int64 allocationCount = 0;
+
+		LockMutex();
+		for (unsigned int i = 0; i < s_moduleCount; ++i)
+			allocationCount += GetModuleCounters(i).allocationCount;
+		UnlockMutex();
+
+		return static_cast<unsigned int>(allocationCount);
+		#else
 		return s_allocationCount;
+		#endif
+	}
+
+	/*!
+	* \brief Gets the sampling rate of the allocations
+	* \return Mean number of allocations between two samples
+	*/
+
+	unsigned int MemoryManager::GetAllocationSamplingRate()
+	{
+		return s_samplingRate;
+	}
+
+	/*!
+	* \brief Gets the allocation sites recorded by sampling
+	* \return Allocation sites, sorted by decreasing live size
+	*
+	* \remark Counters are estimations, obtained by weighting every sample by the sampling rate
+	* \remark Once the site table is full, new sites are merged into a single one with an unknown position and a zero stack hash
+	*/
+
+	std::vector<MemoryManager::AllocationSite> MemoryManager::GetAllocationSites()
+	{
+		if (!s_initialized)
+			Initialize();
+
+		// Reserve before locking, as the vector may itself use the memory manager
+		std::vector<AllocationSite> sites;
+		sites.reserve(s_siteCapacity + 1);
+
+		LockMutex();
+
+		double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - s_samplingStart).count();
+
+		auto AddSite = [&] (const SiteEntry& entry)
+		{
+			if (entry.sampleCount == 0 && entry.liveAllocationCount == 0)
+				return;
+
+			AllocationSite site;
+			site.allocatedSize = entry.allocatedSize;
+			site.allocationCount = entry.allocationCount;
+			site.allocationRate = (elapsedTime > 0.0) ? entry.allocationCount / elapsedTime : 0.0;
+			site.file = entry.file;
+			site.line = entry.line;
+			site.liveAllocationCount = entry.liveAllocationCount;
+			site.liveSize = entry.liveSize;
+			site.sampleCount = entry.sampleCount;
+			site.stackHash = entry.stackHash;
+
+			sites.push_back(site);
+		};
+
+		for (const SiteEntry& entry : s_sites)
+		{
+			if (entry.used)
+				AddSite(entry);
+		}
+
+		AddSite(s_overflowSite);
+
+		UnlockMutex();
+
+		std::sort(sites.begin(), sites.end(), [] (const AllocationSite& lhs, const AllocationSite& rhs)
+		{
+			if (lhs.liveSize != rhs.liveSize)
+				return lhs.liveSize > rhs.liveSize;
+
+			return lhs.allocatedSize > rhs.allocatedSize;
+		});
+
+		return sites;
+	}
+
+	/*!
+	* \brief Gets the memory used by each module
+	* \return Usage of the modules which allocated memory, sorted by decreasing live size
+	*
+	* The module of an allocation is deduced from the path of the file making it (Nazara/<Module>/ or NDK/),
+	* which is only known for the allocations made by the files including the Debug.hpp of a module managing its memory.
+	*
+	* \remark With NAZARA_CORE_MEMORYMANAGER_THREADCACHE, the counters of other threads are read without synchronization and may lag slightly
+	*/
+
+	std::vector<MemoryManager::ModuleUsage> MemoryManager::GetModuleUsages()
+	{
+		if (!s_initialized)
+			Initialize();
+
+		// Reserve before locking, as the vector may itself use the memory manager
+		std::vector<ModuleUsage> usages;
+		usages.reserve(s_maxModuleCount);
+
+		LockMutex();
+
+		for (unsigned int i = 0; i < s_moduleCount; ++i)
+		{
+			ModuleCounters counters = GetModuleCounters(i);
+			if (counters.allocationCount == 0)
+				continue;
+
+			ModuleUsage usage;
+			usage.allocatedSize = static_cast<UInt64>(counters.allocatedSize);
+			usage.allocationCount = static_cast<UInt64>(counters.allocationCount);
+			usage.liveAllocationCount = static_cast<UInt64>(std::max<Int64>(counters.liveAllocationCount, 0));
+			usage.liveSize = static_cast<UInt64>(std::max<Int64>(counters.liveSize, 0));
+			usage.name = s_moduleNames[i];
+
+			usages.push_back(usage);
+		}
+
+		UnlockMutex();
+
+		std::sort(usages.begin(), usages.end(), [] (const ModuleUsage& lhs, const ModuleUsage& rhs)
+		{
+			return lhs.liveSize > rhs.liveSize;
+		});
+
+		return usages;
 	}
 
 	/*!
@@ -324,6 +1279,16 @@ namespace Nz
 		return s_allocationLogging;
 	}
 
+	/*!
+	* \brief Checks whether the sampling of allocation is enabled
+	* \return true if it is sampling
+	*/
+
+	bool MemoryManager::IsAllocationSamplingEnabled()
+	{
+		return s_allocationSampling;
+	}
+
 	/*!
 	* \brief Sets the next free
 	*
@@ -337,6 +1302,50 @@ namespace Nz
 		s_nextFreeLine = line;
 	}
 
+	/*!
+	* \brief Resets the cumulative counters of the allocation sites
+	*
+	* \remark Live counters are kept, as they are still matched by blocks which have not been freed yet
+	*/
+
+	void MemoryManager::ResetAllocationSites()
+	{
+		if (!s_initialized)
+			Initialize();
+
+		LockMutex();
+
+		auto ResetSite = [] (SiteEntry& entry)
+		{
+			entry.allocatedSize = 0;
+			entry.allocationCount = 0;
+			entry.sampleCount = 0;
+		};
+
+		for (SiteEntry& entry : s_sites)
+			ResetSite(entry);
+
+		ResetSite(s_overflowSite);
+
+		s_samplingStart = std::chrono::steady_clock::now();
+
+		UnlockMutex();
+	}
+
+	/*!
+	* \brief Sets the sampling rate of the allocations
+	*
+	* \param sampleRate Mean number of allocations between two samples, 1 samples every allocation
+	*
+	* \remark Already sampled blocks keep the rate they were sampled with
+	*/
+
+	void MemoryManager::SetAllocationSamplingRate(unsigned int sampleRate)
+	{
+		s_samplingRate = std::max(sampleRate, 1U);
+		s_samplingCountdown = 0;
+	}
+
 	/*!
 	* \brief Initializes the MemoryManager
 	*/
@@ -383,12 +1392,6 @@ namespace Nz
 
 	void MemoryManager::Uninitialize()
 	{
-		#ifdef NAZARA_PLATFORM_WINDOWS
-		DeleteCriticalSection(&s_mutex);
-		#elif defined(NAZARA_PLATFORM_POSIX)
-		pthread_mutex_destroy(&s_mutex);
-		#endif
-
 		FILE* log = std::fopen(s_logFileName, "a");
 
 		char timeStr[23];
@@ -396,6 +1399,78 @@ namespace Nz
 
 		std::fprintf(log, "%s Application finished, checking leaks...\n", timeStr);
 
+		#if NAZARA_CORE_MEMORYMANAGER_THREADCACHE
+		// Threads may still allocate and free (and exit) after this, the mutex is kept
+		ModuleCounters leaks[s_maxModuleCount];
+		Int64 leakedBlocks = 0;
+		Int64 leakedSize = 0;
+
+		LockMutex();
+		unsigned int moduleCount = s_moduleCount;
+		for (unsigned int i = 0; i < moduleCount; ++i)
+		{
+			leaks[i] = GetModuleCounters(i);
+			leakedBlocks += leaks[i].liveAllocationCount;
+			leakedSize += leaks[i].liveSize;
+		}
+		UnlockMutex();
+
+		if (leakedBlocks <= 0)
+		{
+			std::fprintf(log, "%s ==============================\n", timeStr);
+			std::fprintf(log, "%s        No leak detected       \n", timeStr);
+			std::fprintf(log, "%s ==============================", timeStr);
+		}
+		else
+		{
+			std::fprintf(log, "%s ==============================\n", timeStr);
+			std::fprintf(log, "%s    Leaks have been detected   \n", timeStr);
+			std::fprintf(log, "%s ==============================\n\n", timeStr);
+			std::fputs("Leaks per module:\n", log);
+
+			for (unsigned int i = 0; i < moduleCount; ++i)
+			{
+				if (leaks[i].liveAllocationCount > 0)
+					std::fprintf(log, "-%s -> %lld bytes in %lld blocks\n", s_moduleNames[i], static_cast<long long>(leaks[i].liveSize), static_cast<long long>(leaks[i].liveAllocationCount));
+			}
+
+			// Only the sampled blocks have a position
+			bool sitesListed = false;
+			for (const SiteEntry& entry : s_sites)
+			{
+				if (!entry.used || entry.liveAllocationCount == 0)
+					continue;
+
+				if (!sitesListed)
+				{
+					std::fputs("\nLeaking sites (estimated from sampling):\n", log);
+					sitesListed = true;
+				}
+
+				AllocationSite site;
+				site.allocatedSize = entry.allocatedSize;
+				site.allocationCount = entry.allocationCount;
+				site.allocationRate = 0.0;
+				site.file = entry.file;
+				site.line = entry.line;
+				site.liveAllocationCount = entry.liveAllocationCount;
+				site.liveSize = entry.liveSize;
+				site.sampleCount = entry.sampleCount;
+				site.stackHash = entry.stackHash;
+
+				std::fputc('-', log);
+				WriteSite(log, site);
+			}
+
+			std::fprintf(log, "\n%lld blocks leaked (%lld bytes)", static_cast<long long>(leakedBlocks), static_cast<long long>(leakedSize));
+		}
+		#else
+		#ifdef NAZARA_PLATFORM_WINDOWS
+		DeleteCriticalSection(&s_mutex);
+		#elif defined(NAZARA_PLATFORM_POSIX)
+		pthread_mutex_destroy(&s_mutex);
+		#endif
+
 		if (s_allocatedBlock == 0)
 		{
 			std::fprintf(log, "%s ==============================\n", timeStr);
@@ -425,6 +1500,7 @@ namespace Nz
 
 			std::fprintf(log, "\n%u blocks leaked (%zu bytes)", s_allocatedBlock, s_allocatedSize);
 		}
+		#endif
 
 		std::fclose(log);
 	}
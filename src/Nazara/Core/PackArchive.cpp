@@ -0,0 +1,586 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/PackArchive.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LZ4Compressor.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr UInt32 PackMagic = 0x4B41504E; //< "NPAK" once written
+
+		UInt64 AlignOffset(UInt64 offset, UInt64 alignment)
+		{
+			return (offset + alignment - 1) & ~(alignment - 1);
+		}
+
+		UInt64 HashPath(const char* path, std::size_t length)
+		{
+			// FNV-1a
+			UInt64 hash = 14695981039346656037ULL;
+			for (std::size_t i = 0; i < length; ++i)
+			{
+				hash ^= static_cast<UInt8>(path[i]);
+				hash *= 1099511628211ULL;
+			}
+
+			return hash;
+		}
+
+		bool ListFiles(const String& directoryPath, const String& entryPrefix, std::vector<String>* entryPaths, std::vector<String>* filePaths)
+		{
+			Directory directory(directoryPath);
+			if (!directory.Open())
+			{
+				NazaraError("Failed to open directory \"" + directoryPath + '"');
+				return false;
+			}
+
+			while (directory.NextResult())
+			{
+				String entryPath = entryPrefix + directory.GetResultName();
+				if (directory.IsResultDirectory())
+				{
+					if (!ListFiles(directory.GetResultPath(), entryPath + '/', entryPaths, filePaths))
+						return false;
+				}
+				else
+				{
+					entryPaths->push_back(entryPath);
+					filePaths->push_back(directory.GetResultPath());
+				}
+			}
+
+			return true;
+		}
+
+		bool ReadWholeFile(const String& filePath, ByteArray* data)
+		{
+			File file(filePath, OpenMode_ReadOnly);
+			if (!file.IsOpen())
+			{
+				NazaraError("Failed to open \"" + filePath + '"');
+				return false;
+			}
+
+			std::size_t size = static_cast<std::size_t>(file.GetSize());
+			data->Resize(size);
+
+			if (size > 0 && file.Read(data->GetBuffer(), size) != size)
+			{
+				NazaraError("Failed to read \"" + filePath + '"');
+				return false;
+			}
+
+			return true;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::PackArchive
+	* \brief Core class that represents a read-only archive of many files
+	*
+	* Opening an archive maps it in memory, its index (sorted by the hash of the paths) is then searched in place.
+	* Entries are aligned in the archive: uncompressed ones can be used without copy, the others are LZ4 blocks to extract.
+	*
+	* Loading many small files from an archive saves the system calls needed to open, query and read each one of them.
+	*
+	* \remark Archives are written in the native byte order (little endian on every supported platform)
+	* \see VirtualFileSystem
+	*/
+
+	/*!
+	* \brief Constructs a PackArchive object by default
+	*/
+
+	PackArchive::PackArchive() :
+	m_data(nullptr),
+	m_entries(nullptr),
+	m_paths(nullptr),
+	m_entryCount(0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a PackArchive object and opens an archive
+	*
+	* \param filePath Path to the archive
+	*/
+
+	PackArchive::PackArchive(const String& filePath) :
+	PackArchive()
+	{
+		Open(filePath);
+	}
+
+	/*!
+	* \brief Constructs a PackArchive object by moving another one
+	*
+	* \param archive Archive to move
+	*/
+
+	PackArchive::PackArchive(PackArchive&& archive) noexcept :
+	m_file(std::move(archive.m_file)),
+	m_data(archive.m_data),
+	m_entries(archive.m_entries),
+	m_paths(archive.m_paths),
+	m_entryCount(archive.m_entryCount)
+	{
+		archive.m_data = nullptr;
+		archive.m_entries = nullptr;
+		archive.m_paths = nullptr;
+		archive.m_entryCount = 0;
+	}
+
+	/*!
+	* \brief Closes the archive, the data of its entries is not available anymore
+	*/
+
+	void PackArchive::Close()
+	{
+		m_file.Close();
+
+		m_data = nullptr;
+		m_entries = nullptr;
+		m_paths = nullptr;
+		m_entryCount = 0;
+	}
+
+	/*!
+	* \brief Extracts the data of an entry
+	* \return true If successful
+	*
+	* \param entry Entry of the archive
+	* \param buffer Buffer receiving the entry.size bytes of the entry
+	*
+	* \remark Produces a NazaraAssert if the archive is not open
+	* \remark Produces a NazaraError if the compressed data is invalid
+	*/
+
+	bool PackArchive::Extract(const Entry& entry, void* buffer) const
+	{
+		NazaraAssert(IsOpen(), "Archive is not open");
+		NazaraAssert(buffer || entry.size == 0, "Invalid buffer");
+
+		const UInt8* data = m_data + entry.offset;
+		if (entry.IsCompressed())
+		{
+			// Decompression only reads the (empty) dictionary, a compressor can be shared by every thread
+			static const LZ4Compressor decompressor;
+
+			if (!decompressor.Decompress(data, static_cast<std::size_t>(entry.storedSize), buffer, static_cast<std::size_t>(entry.size)))
+			{
+				NazaraError("Failed to decompress entry \"" + GetEntryPath(entry) + '"');
+				return false;
+			}
+		}
+		else if (entry.size > 0)
+			std::memcpy(buffer, data, static_cast<std::size_t>(entry.size));
+
+		return true;
+	}
+
+	/*!
+	* \brief Finds an entry
+	* \return A pointer to the entry, nullptr if the archive has no entry at this path
+	*
+	* \param entryPath Path of the entry (see NormalizePath)
+	*/
+
+	const PackArchive::Entry* PackArchive::FindEntry(const String& entryPath) const
+	{
+		if (m_entryCount == 0)
+			return nullptr;
+
+		String path = NormalizePath(entryPath);
+		UInt64 hash = HashPath(path.GetConstBuffer(), path.GetSize());
+
+		const Entry* end = m_entries + m_entryCount;
+		const Entry* entry = std::lower_bound(m_entries, end, hash, [](const Entry& lhs, UInt64 rhs)
+		{
+			return lhs.pathHash < rhs;
+		});
+
+		// Paths sharing the same hash follow each other
+		for (; entry != end && entry->pathHash == hash; ++entry)
+		{
+			if (entry->pathLength == path.GetSize() && std::memcmp(m_paths + entry->pathOffset, path.GetConstBuffer(), path.GetSize()) == 0)
+				return entry;
+		}
+
+		return nullptr;
+	}
+
+	/*!
+	* \brief Opens an archive
+	* \return true If successful
+	*
+	* \param filePath Path to the archive
+	*
+	* \remark Produces a NazaraError if the archive could not be opened or mapped, or if it is invalid
+	*/
+
+	bool PackArchive::Open(const String& filePath)
+	{
+		Close();
+
+		if (!m_file.Open(filePath, OpenMode_ReadOnly))
+		{
+			NazaraError("Failed to open pack \"" + filePath + '"');
+			return false;
+		}
+
+		auto Fail = [&](const String& error)
+		{
+			NazaraError("Invalid pack \"" + filePath + "\": " + error);
+			m_file.Close();
+
+			return false;
+		};
+
+		UInt64 size = m_file.GetSize();
+		if (size < sizeof(Header))
+			return Fail("too small");
+
+		const UInt8* data = static_cast<const UInt8*>(m_file.Map());
+		if (!data)
+			return Fail("failed to map it");
+
+		Header header;
+		std::memcpy(&header, data, sizeof(Header));
+
+		if (header.magic != PackMagic)
+			return Fail("bad magic");
+
+		if (header.version != FormatVersion)
+			return Fail("unsupported version " + String::Number(header.version));
+
+		if (header.indexOffset % alignof(Entry) != 0 || header.indexOffset > size || header.entryCount > (size - header.indexOffset) / sizeof(Entry))
+			return Fail("index out of bounds");
+
+		if (header.pathTableOffset > size || header.pathTableSize > size - header.pathTableOffset)
+			return Fail("path table out of bounds");
+
+		// The index is only validated once, lookups use it as is
+		const Entry* entries = reinterpret_cast<const Entry*>(data + header.indexOffset);
+		for (UInt32 i = 0; i < header.entryCount; ++i)
+		{
+			const Entry& entry = entries[i];
+			if (entry.offset > size || entry.storedSize > size - entry.offset)
+				return Fail("entry #" + String::Number(i) + " data out of bounds");
+
+			if (UInt64(entry.pathOffset) + entry.pathLength > header.pathTableSize)
+				return Fail("entry #" + String::Number(i) + " path out of bounds");
+
+			if (!entry.IsCompressed() && entry.storedSize != entry.size)
+				return Fail("entry #" + String::Number(i) + " has an invalid size");
+
+			if (i > 0 && entries[i - 1].pathHash > entry.pathHash)
+				return Fail("index is not sorted");
+		}
+
+		m_data = data;
+		m_entries = entries;
+		m_entryCount = header.entryCount;
+		m_paths = reinterpret_cast<const char*>(data + header.pathTableOffset);
+
+		return true;
+	}
+
+	/*!
+	* \brief Moves another archive into this one
+	* \return A reference to this
+	*
+	* \param archive Archive to move
+	*/
+
+	PackArchive& PackArchive::operator=(PackArchive&& archive) noexcept
+	{
+		m_file = std::move(archive.m_file);
+
+		std::swap(m_data, archive.m_data);
+		std::swap(m_entries, archive.m_entries);
+		std::swap(m_paths, archive.m_paths);
+		std::swap(m_entryCount, archive.m_entryCount);
+
+		return *this;
+	}
+
+	/*!
+	* \brief Builds an archive
+	* \return true If successful
+	*
+	* \param filePath Path of the archive to write
+	* \param entries Entries of the archive, their data being read from their file if empty
+	* \param alignment Alignment of the data of each entry, must be a power of two
+	*
+	* \remark Produces a NazaraError if an entry could not be read, if two entries share the same path or if the archive could not be written
+	*/
+
+	bool PackArchive::Build(const String& filePath, const std::vector<SourceEntry>& entries, UInt32 alignment)
+	{
+		std::vector<String> entryPaths;
+		entryPaths.reserve(entries.size());
+		for (const SourceEntry& entry : entries)
+			entryPaths.push_back(entry.path);
+
+		return WriteArchive(filePath, std::move(entryPaths), alignment, [&](std::size_t sourceIndex, ByteArray* data, bool* compress)
+		{
+			const SourceEntry& entry = entries[sourceIndex];
+			*compress = entry.compress;
+
+			if (!entry.data.IsEmpty() || entry.filePath.IsEmpty())
+			{
+				*data = entry.data;
+				return true;
+			}
+
+			return ReadWholeFile(entry.filePath, data);
+		});
+	}
+
+	/*!
+	* \brief Builds an archive of every file of a directory and its subdirectories
+	* \return true If successful
+	*
+	* \param filePath Path of the archive to write
+	* \param directoryPath Directory to pack, entries being named after their path relative to it
+	* \param compress Should the entries be compressed (when it makes them smaller)
+	* \param alignment Alignment of the data of each entry, must be a power of two
+	*
+	* \remark Files are read one after the other, the directory does not need to fit in memory
+	* \remark Produces a NazaraError if a file could not be read or if the archive could not be written
+	*/
+
+	bool PackArchive::BuildFromDirectory(const String& filePath, const String& directoryPath, bool compress, UInt32 alignment)
+	{
+		std::vector<String> entryPaths;
+		std::vector<String> filePaths;
+		if (!ListFiles(directoryPath, String(), &entryPaths, &filePaths))
+			return false;
+
+		return WriteArchive(filePath, std::move(entryPaths), alignment, [&](std::size_t sourceIndex, ByteArray* data, bool* compressData)
+		{
+			*compressData = compress;
+
+			return ReadWholeFile(filePaths[sourceIndex], data);
+		});
+	}
+
+	/*!
+	* \brief Computes the hash of an entry path
+	* \return Hash of the normalized path, as stored in the index
+	*
+	* \param entryPath Path of the entry
+	*/
+
+	UInt64 PackArchive::ComputePathHash(const String& entryPath)
+	{
+		String path = NormalizePath(entryPath);
+
+		return HashPath(path.GetConstBuffer(), path.GetSize());
+	}
+
+	/*!
+	* \brief Normalizes the path of an entry
+	* \return Path using slashes as separators, without leading slash or "./"
+	*
+	* \param entryPath Path of the entry
+	*/
+
+	String PackArchive::NormalizePath(const String& entryPath)
+	{
+		String path(entryPath);
+		path.Replace('\\', '/');
+
+		std::size_t start = 0;
+		const char* buffer = path.GetConstBuffer();
+		for (;;)
+		{
+			if (buffer[start] == '/')
+				start++;
+			else if (buffer[start] == '.' && buffer[start + 1] == '/')
+				start += 2;
+			else
+				break;
+		}
+
+		return (start > 0) ? path.SubString(start) : path;
+	}
+
+	/*!
+	* \brief Writes an archive
+	* \return true If successful
+	*
+	* \param filePath Path of the archive to write
+	* \param entryPaths Path of the entries
+	* \param alignment Alignment of the data of each entry
+	* \param dataLoader Function giving the data of an entry (by its index in entryPaths) and whether to compress it
+	*/
+
+	bool PackArchive::WriteArchive(const String& filePath, std::vector<String> entryPaths, UInt32 alignment, const DataLoader& dataLoader)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		std::size_t entryCount = entryPaths.size();
+		if (entryCount > std::numeric_limits<UInt32>::max())
+		{
+			NazaraError("Too many entries");
+			return false;
+		}
+
+		std::vector<UInt64> hashes(entryCount);
+		for (std::size_t i = 0; i < entryCount; ++i)
+		{
+			entryPaths[i] = NormalizePath(entryPaths[i]);
+			if (entryPaths[i].GetSize() > std::numeric_limits<UInt16>::max())
+			{
+				NazaraError("Entry path \"" + entryPaths[i] + "\" is too long");
+				return false;
+			}
+
+			hashes[i] = HashPath(entryPaths[i].GetConstBuffer(), entryPaths[i].GetSize());
+		}
+
+		// Entries are written in the order of the index, lookups then touch neighbouring pages
+		std::vector<std::size_t> order(entryCount);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs)
+		{
+			if (hashes[lhs] != hashes[rhs])
+				return hashes[lhs] < hashes[rhs];
+
+			return entryPaths[lhs] < entryPaths[rhs];
+		});
+
+		for (std::size_t i = 1; i < entryCount; ++i)
+		{
+			if (hashes[order[i - 1]] == hashes[order[i]] && entryPaths[order[i - 1]] == entryPaths[order[i]])
+			{
+				NazaraError("Entry \"" + entryPaths[order[i]] + "\" is present twice");
+				return false;
+			}
+		}
+
+		File file(filePath, OpenMode_WriteOnly | OpenMode_Truncate);
+		if (!file.IsOpen())
+		{
+			NazaraError("Failed to open \"" + filePath + "\" for writing");
+			return false;
+		}
+
+		std::vector<UInt8> padding(std::max<std::size_t>(alignment, alignof(Entry)), 0);
+		auto WritePadding = [&](UInt64 from, UInt64 to)
+		{
+			if (from == to)
+				return true;
+
+			return file.Write(padding.data(), static_cast<std::size_t>(to - from)) == to - from;
+		};
+
+		Header header;
+		std::memset(&header, 0, sizeof(Header));
+		if (file.Write(&header, sizeof(Header)) != sizeof(Header))
+		{
+			NazaraError("Failed to write header");
+			return false;
+		}
+
+		ByteArray data;
+		LZ4Compressor compressor;
+		String pathTable;
+		std::vector<Entry> index(entryCount);
+		std::vector<UInt8> compressedData;
+
+		UInt64 offset = sizeof(Header);
+		for (std::size_t i = 0; i < entryCount; ++i)
+		{
+			std::size_t sourceIndex = order[i];
+			const String& entryPath = entryPaths[sourceIndex];
+
+			bool compress = false;
+			data.Clear();
+			if (!dataLoader(sourceIndex, &data, &compress))
+			{
+				NazaraError("Failed to get data of entry \"" + entryPath + '"');
+				return false;
+			}
+
+			Entry& entry = index[i];
+			entry.flags = 0;
+			entry.offset = AlignOffset(offset, alignment);
+			entry.pathHash = hashes[sourceIndex];
+			entry.pathLength = static_cast<UInt16>(entryPath.GetSize());
+			entry.pathOffset = static_cast<UInt32>(pathTable.GetSize());
+			entry.size = data.GetSize();
+
+			const void* storedData = data.GetConstBuffer();
+			entry.storedSize = data.GetSize();
+
+			if (compress && !data.IsEmpty())
+			{
+				compressedData.resize(LZ4Compressor::ComputeMaxCompressedSize(data.GetSize()));
+
+				std::size_t compressedSize = compressor.Compress(data.GetConstBuffer(), data.GetSize(), compressedData.data(), compressedData.size());
+				if (compressedSize > 0 && compressedSize < data.GetSize())
+				{
+					entry.flags |= EntryFlag_Compressed;
+					entry.storedSize = compressedSize;
+					storedData = compressedData.data();
+				}
+			}
+
+			if (!WritePadding(offset, entry.offset) || (entry.storedSize > 0 && file.Write(storedData, static_cast<std::size_t>(entry.storedSize)) != entry.storedSize))
+			{
+				NazaraError("Failed to write entry \"" + entryPath + '"');
+				return false;
+			}
+
+			pathTable += entryPath;
+			if (pathTable.GetSize() > std::numeric_limits<UInt32>::max())
+			{
+				NazaraError("Path table is too big");
+				return false;
+			}
+
+			offset = entry.offset + entry.storedSize;
+		}
+
+		header.magic = PackMagic;
+		header.version = FormatVersion;
+		header.alignment = alignment;
+		header.entryCount = static_cast<UInt32>(entryCount);
+		header.indexOffset = AlignOffset(offset, alignof(Entry));
+		header.pathTableOffset = header.indexOffset + entryCount * sizeof(Entry);
+		header.pathTableSize = pathTable.GetSize();
+
+		std::size_t indexSize = entryCount * sizeof(Entry);
+		if (!WritePadding(offset, header.indexOffset) ||
+		    (indexSize > 0 && file.Write(index.data(), indexSize) != indexSize) ||
+		    (!pathTable.IsEmpty() && file.Write(pathTable.GetConstBuffer(), pathTable.GetSize()) != pathTable.GetSize()))
+		{
+			NazaraError("Failed to write index");
+			return false;
+		}
+
+		if (!file.SetCursorPos(0) || file.Write(&header, sizeof(Header)) != sizeof(Header))
+		{
+			NazaraError("Failed to write header");
+			return false;
+		}
+
+		return true;
+	}
+
+	static_assert(sizeof(PackArchive::Entry) == 40, "Entries must keep their layout, the index is read as is");
+}
@@ -5,45 +5,62 @@
 #include <Nazara/Core/ParameterList.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/MemoryHelper.hpp>
-#include <cstring>
+#include <Nazara/Core/Mutex.hpp>
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <new>
+#include <unordered_map>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	struct ParameterList::InternedKey
+	{
+		String name;
+		std::size_t hash;
+	};
+
+	namespace
+	{
+		const std::shared_ptr<const ParameterList>& GetEmptyParameterList()
+		{
+			static std::shared_ptr<const ParameterList> emptyList = std::make_shared<const ParameterList>();
+			return emptyList;
+		}
+	}
+
 	/*!
 	* \ingroup core
 	* \class Nz::ParameterList
 	* \brief Core class that represents a list of parameters
+	*
+	* Parameters are stored contiguously and indexed by an open addressing hash table.
+	* Their names are interned, every list setting a parameter with the same name shares the same key (and its precomputed hash).
+	*
+	* \see FrozenParameterList
 	*/
 
 	/*!
-	* \brief Constructs a ParameterList object by copy
-	*/
-	ParameterList::ParameterList(const ParameterList& list)
-	{
-		operator=(list);
-	}
-
-	/*!
-	* \brief Destructs the object and clears
+	* \brief Clears all the parameters
 	*/
-	ParameterList::~ParameterList()
+	void ParameterList::Clear()
 	{
-		Clear();
+		m_parameters.clear();
+		m_buckets.clear();
 	}
 
 	/*!
-	* \brief Clears all the parameters
+	* \brief Calls the callback with the name of every parameter of the list
+	*
+	* \param callback Function receiving the list and the parameter name
 	*/
-	void ParameterList::Clear()
+	void ParameterList::ForEach(const std::function<void(const ParameterList& list, const String& name)>& callback) const
 	{
-		for (auto it = m_parameters.begin(); it != m_parameters.end(); ++it)
-			DestroyValue(it->second);
-
-		m_parameters.clear();
+		for (const Parameter& parameter : m_parameters)
+			callback(*this, parameter.key->name);
 	}
 
 	/*!
@@ -65,27 +82,27 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Boolean:
-				*value = it->second.value.boolVal;
+				*value = parameter->value.boolVal;
 				return true;
 
 			case ParameterType_Integer:
-				*value = (it->second.value.intVal != 0);
+				*value = (parameter->value.intVal != 0);
 				return true;
 
 			case ParameterType_String:
 			{
 				bool converted;
-				if (it->second.value.stringVal.ToBool(&converted, String::CaseInsensitive))
+				if (parameter->value.stringVal.ToBool(&converted, String::CaseInsensitive))
 				{
 					*value = converted;
 					return true;
@@ -123,17 +140,17 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Color:
-				*value = it->second.value.colorVal;
+				*value = parameter->value.colorVal;
 				return true;
 
 			case ParameterType_Boolean:
@@ -169,27 +186,27 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Float:
-				*value = it->second.value.floatVal;
+				*value = parameter->value.floatVal;
 				return true;
 
 			case ParameterType_Integer:
-				*value = static_cast<float>(it->second.value.intVal);
+				*value = static_cast<float>(parameter->value.intVal);
 				return true;
 
 			case ParameterType_String:
 				{
 					double converted;
-					if (it->second.value.stringVal.ToDouble(&converted))
+					if (parameter->value.stringVal.ToDouble(&converted))
 					{
 						*value = static_cast<float>(converted);
 						return true;
@@ -230,31 +247,31 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Boolean:
-				*value = (it->second.value.boolVal) ? 1 : 0;
+				*value = (parameter->value.boolVal) ? 1 : 0;
 				return true;
 
 			case ParameterType_Float:
-				*value = static_cast<int>(it->second.value.floatVal);
+				*value = static_cast<int>(parameter->value.floatVal);
 				return true;
 
 			case ParameterType_Integer:
-				*value = it->second.value.intVal;
+				*value = parameter->value.intVal;
 				return true;
 
 			case ParameterType_String:
 				{
 					long long converted;
-					if (it->second.value.stringVal.ToInteger(&converted))
+					if (parameter->value.stringVal.ToInteger(&converted))
 					{
 						if (converted <= std::numeric_limits<int>::max() && converted >= std::numeric_limits<int>::min())
 						{
@@ -289,11 +306,11 @@ namespace Nz
 	{
 		NazaraAssert(type, "Invalid pointer");
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 			return false;
 
-		*type = it->second.type;
+		*type = parameter->type;
 
 		return true;
 	}
@@ -316,21 +333,21 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Pointer:
-				*value = it->second.value.ptrVal;
+				*value = parameter->value.ptrVal;
 				return true;
 
 			case ParameterType_Userdata:
-				*value = it->second.value.userdataVal->ptr;
+				*value = parameter->value.userdataVal->ptr;
 				return true;
 
 			case ParameterType_Boolean:
@@ -370,41 +387,41 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		switch (it->second.type)
+		switch (parameter->type)
 		{
 			case ParameterType_Boolean:
-				*value = String::Boolean(it->second.value.boolVal);
+				*value = String::Boolean(parameter->value.boolVal);
 				return true;
 
 			case ParameterType_Color:
-				*value = it->second.value.colorVal.ToString();
+				*value = parameter->value.colorVal.ToString();
 				return true;
 
 			case ParameterType_Float:
-				*value = String::Number(it->second.value.floatVal);
+				*value = String::Number(parameter->value.floatVal);
 				return true;
 
 			case ParameterType_Integer:
-				*value = String::Number(it->second.value.intVal);
+				*value = String::Number(parameter->value.intVal);
 				return true;
 
 			case ParameterType_String:
-				*value = it->second.value.stringVal;
+				*value = parameter->value.stringVal;
 				return true;
 
 			case ParameterType_Pointer:
-				*value = String::Pointer(it->second.value.ptrVal);
+				*value = String::Pointer(parameter->value.ptrVal);
 				return true;
 
 			case ParameterType_Userdata:
-				*value = String::Pointer(it->second.value.userdataVal->ptr);
+				*value = String::Pointer(parameter->value.userdataVal->ptr);
 				return true;
 
 			case ParameterType_None:
@@ -435,16 +452,16 @@ namespace Nz
 
 		ErrorFlags flags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
 
-		auto it = m_parameters.find(name);
-		if (it == m_parameters.end())
+		const Parameter* parameter = FindParameter(name);
+		if (!parameter)
 		{
 			NazaraError("Parameter \"" + name + "\" is not present");
 			return false;
 		}
 
-		if (it->second.type == ParameterType_Userdata)
+		if (parameter->type == ParameterType_Userdata)
 		{
-			*value = it->second.value.userdataVal->ptr;
+			*value = parameter->value.userdataVal->ptr;
 			return true;
 		}
 		else
@@ -454,6 +471,15 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Gets the number of parameters
+	* \return Number of parameters in the list
+	*/
+	std::size_t ParameterList::GetParameterCount() const
+	{
+		return m_parameters.size();
+	}
+
 	/*!
 	* \brief Checks whether the parameter list contains a parameter named `name`
 	* \return true if found
@@ -462,7 +488,7 @@ namespace Nz
 	*/
 	bool ParameterList::HasParameter(const String& name) const
 	{
-		return m_parameters.find(name) != m_parameters.end();
+		return FindParameter(name) != nullptr;
 	}
 
 	/*!
@@ -475,12 +501,43 @@ namespace Nz
 	*/
 	void ParameterList::RemoveParameter(const String& name)
 	{
-		auto it = m_parameters.find(name);
-		if (it != m_parameters.end())
+		if (m_parameters.empty())
+			return;
+
+		std::size_t bucket = FindBucket(name, std::hash<String>()(name));
+		UInt32 index = m_buckets[bucket];
+		if (index == 0)
+			return;
+
+		// Backward shift deletion, which keeps the probe sequences valid without any tombstone
+		std::size_t mask = m_buckets.size() - 1;
+		std::size_t hole = bucket;
+		for (std::size_t i = (hole + 1) & mask; m_buckets[i] != 0; i = (i + 1) & mask)
+		{
+			std::size_t idealBucket = m_parameters[m_buckets[i] - 1].key->hash & mask;
+			if (((i - idealBucket) & mask) >= ((i - hole) & mask))
+			{
+				m_buckets[hole] = m_buckets[i];
+				hole = i;
+			}
+		}
+		m_buckets[hole] = 0;
+
+		// Fill the gap in the parameter array with the last parameter
+		UInt32 lastIndex = static_cast<UInt32>(m_parameters.size());
+		if (index != lastIndex)
 		{
-			DestroyValue(it->second);
-			m_parameters.erase(it);
+			Parameter& parameter = m_parameters[index - 1];
+			parameter = std::move(m_parameters.back());
+
+			std::size_t lastBucket = parameter.key->hash & mask;
+			while (m_buckets[lastBucket] != lastIndex)
+				lastBucket = (lastBucket + 1) & mask;
+
+			m_buckets[lastBucket] = index;
 		}
+
+		m_parameters.pop_back();
 	}
 
 	/*!
@@ -618,29 +675,31 @@ namespace Nz
 		ss << "ParameterList(";
 		for (auto it = m_parameters.cbegin(); it != m_parameters.cend();)
 		{
-			ss << it->first << ": ";
-			switch (it->second.type)
+			const Parameter* parameter = &*it;
+
+			ss << parameter->key->name << ": ";
+			switch (parameter->type)
 			{
 				case ParameterType_Boolean:
-					ss << "Boolean(" << String::Boolean(it->second.value.boolVal) << ")";
+					ss << "Boolean(" << String::Boolean(parameter->value.boolVal) << ")";
 					break;
 				case ParameterType_Color:
-					ss << "Color(" << it->second.value.colorVal.ToString() << ")";
+					ss << "Color(" << parameter->value.colorVal.ToString() << ")";
 					break;
 				case ParameterType_Float:
-					ss << "Float(" << it->second.value.floatVal << ")";
+					ss << "Float(" << parameter->value.floatVal << ")";
 					break;
 				case ParameterType_Integer:
-					ss << "Integer(" << it->second.value.intVal << ")";
+					ss << "Integer(" << parameter->value.intVal << ")";
 					break;
 				case ParameterType_String:
-					ss << "String(" << it->second.value.stringVal << ")";
+					ss << "String(" << parameter->value.stringVal << ")";
 					break;
 				case ParameterType_Pointer:
-					ss << "Pointer(" << String::Pointer(it->second.value.ptrVal) << ")";
+					ss << "Pointer(" << String::Pointer(parameter->value.ptrVal) << ")";
 					break;
 				case ParameterType_Userdata:
-					ss << "Userdata(" << String::Pointer(it->second.value.userdataVal->ptr) << ")";
+					ss << "Userdata(" << String::Pointer(parameter->value.userdataVal->ptr) << ")";
 					break;
 				case ParameterType_None:
 					ss << "None";
@@ -675,85 +734,161 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Copies the content of the other parameter list to this
-	* \return A reference to this
+	* \brief Create an uninitialized value of a set name
+	*
+	* \param name Name of the parameter
 	*
-	* \param list List to assign
+	* \remark The previous value if any gets destroyed
 	*/
-	ParameterList& ParameterList::operator=(const ParameterList& list)
+	ParameterList::Parameter& ParameterList::CreateValue(const String& name)
 	{
-		Clear();
+		const InternedKey* key = InternKey(name);
+
+		// Keep the load factor under one half
+		if ((m_parameters.size() + 1) * 2 > m_buckets.size())
+			Rehash(std::max<std::size_t>(m_buckets.size() * 2, 16));
 
-		for (auto it = list.m_parameters.begin(); it != list.m_parameters.end(); ++it)
+		std::size_t bucket = FindBucket(name, key->hash);
+		if (UInt32 index = m_buckets[bucket])
 		{
-			Parameter& parameter = m_parameters[it->first];
+			Parameter& parameter = m_parameters[index - 1];
+			parameter.Destroy();
 
-			switch (it->second.type)
-			{
-				case ParameterType_Boolean:
-				case ParameterType_Color:
-				case ParameterType_Float:
-				case ParameterType_Integer:
-				case ParameterType_Pointer:
-					std::memcpy(&parameter, &it->second, sizeof(Parameter));
-					break;
+			return parameter;
+		}
 
-				case ParameterType_String:
-					parameter.type = ParameterType_String;
+		m_parameters.emplace_back(key);
+		m_buckets[bucket] = static_cast<UInt32>(m_parameters.size());
 
-					PlacementNew(&parameter.value.stringVal, it->second.value.stringVal);
-					break;
+		return m_parameters.back();
+	}
 
-				case ParameterType_Userdata:
-					parameter.type = ParameterType_Userdata;
-					parameter.value.userdataVal = it->second.value.userdataVal;
-					++(parameter.value.userdataVal->counter);
-					break;
+	/*!
+	* \brief Finds the bucket of a parameter
+	* \return Index of the bucket referencing the parameter, or of the empty bucket where it would be inserted
+	*
+	* \param name Name of the parameter
+	* \param hash Hash of the name
+	*
+	* \remark The bucket table must not be empty
+	*/
+	std::size_t ParameterList::FindBucket(const String& name, std::size_t hash) const
+	{
+		std::size_t mask = m_buckets.size() - 1;
+		for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+		{
+			UInt32 index = m_buckets[i];
+			if (index == 0)
+				return i;
 
-				case ParameterType_None:
-					parameter.type = ParameterType_None;
-					break;
-			}
+			const InternedKey* key = m_parameters[index - 1].key;
+			if (key->hash == hash && key->name == name)
+				return i;
 		}
-
-		return *this;
 	}
 
 	/*!
-	* \brief Create an uninitialized value of a set name
+	* \brief Finds a parameter
+	* \return Pointer to the parameter or nullptr if not present
 	*
 	* \param name Name of the parameter
-	* \param value Value of the parameter
+	*/
+	const ParameterList::Parameter* ParameterList::FindParameter(const String& name) const
+	{
+		if (m_parameters.empty())
+			return nullptr;
+
+		UInt32 index = m_buckets[FindBucket(name, std::hash<String>()(name))];
+		return (index != 0) ? &m_parameters[index - 1] : nullptr;
+	}
+
+	/*!
+	* \brief Rebuilds the bucket table
 	*
-	* \remark The previous value if any gets destroyed
+	* \param bucketCount New number of buckets, must be a power of two
 	*/
-	ParameterList::Parameter& ParameterList::CreateValue(const String& name)
+	void ParameterList::Rehash(std::size_t bucketCount)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
-		Parameter& parameter = pair.first->second;
+		NazaraAssert((bucketCount & (bucketCount - 1)) == 0, "Bucket count must be a power of two");
 
-		if (!pair.second)
-			DestroyValue(parameter);
+		m_buckets.assign(bucketCount, 0);
 
-		return parameter;
+		std::size_t mask = bucketCount - 1;
+		for (std::size_t i = 0; i < m_parameters.size(); ++i)
+		{
+			std::size_t bucket = m_parameters[i].key->hash & mask;
+			while (m_buckets[bucket] != 0)
+				bucket = (bucket + 1) & mask;
+
+			m_buckets[bucket] = static_cast<UInt32>(i + 1);
+		}
 	}
 
 	/*!
-	* \brief Destroys the value for the parameter
+	* \brief Gets the interned key of a parameter name
+	* \return Key shared by every list, which lives until the end of the program
 	*
-	* \param parameter Parameter to destroy
+	* \param name Name of the parameter
+	*
+	* \remark This function is thread-safe
 	*/
-	void ParameterList::DestroyValue(Parameter& parameter)
+	const ParameterList::InternedKey* ParameterList::InternKey(const String& name)
 	{
-		switch (parameter.type)
+		static Mutex mutex;
+		static std::unordered_map<String, std::unique_ptr<InternedKey>> keys;
+
+		LockGuard lock(mutex);
+
+		std::unique_ptr<InternedKey>& key = keys[name];
+		if (!key)
+		{
+			key.reset(new InternedKey);
+			key->name = name;
+			key->hash = std::hash<String>()(name);
+		}
+
+		return key.get();
+	}
+
+	ParameterList::Parameter::Parameter(const InternedKey* Key) :
+	type(ParameterType_None),
+	key(Key)
+	{
+	}
+
+	ParameterList::Parameter::Parameter(const Parameter& parameter) :
+	type(ParameterType_None),
+	key(parameter.key)
+	{
+		operator=(parameter);
+	}
+
+	ParameterList::Parameter::Parameter(Parameter&& parameter) noexcept :
+	type(ParameterType_None),
+	key(parameter.key)
+	{
+		operator=(std::move(parameter));
+	}
+
+	ParameterList::Parameter::~Parameter()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Destroys the value of the parameter, its type becomes ParameterType_None
+	*/
+	void ParameterList::Parameter::Destroy()
+	{
+		switch (type)
 		{
 			case ParameterType_String:
-				parameter.value.stringVal.~String();
+				value.stringVal.~String();
 				break;
 
 			case ParameterType_Userdata:
 				{
-					Parameter::UserdataValue* userdata = parameter.value.userdataVal;
+					UserdataValue* userdata = value.userdataVal;
 					if (--userdata->counter == 0)
 					{
 						userdata->destructor(userdata->ptr);
@@ -770,6 +905,131 @@ namespace Nz
 			case ParameterType_Pointer:
 				break;
 		}
+
+		type = ParameterType_None;
+	}
+
+	ParameterList::Parameter& ParameterList::Parameter::operator=(const Parameter& parameter)
+	{
+		if (this == &parameter)
+			return *this;
+
+		Destroy();
+
+		key = parameter.key;
+		switch (parameter.type)
+		{
+			case ParameterType_Boolean:
+				value.boolVal = parameter.value.boolVal;
+				break;
+
+			case ParameterType_Color:
+				PlacementNew(&value.colorVal, parameter.value.colorVal);
+				break;
+
+			case ParameterType_Float:
+				value.floatVal = parameter.value.floatVal;
+				break;
+
+			case ParameterType_Integer:
+				value.intVal = parameter.value.intVal;
+				break;
+
+			case ParameterType_Pointer:
+				value.ptrVal = parameter.value.ptrVal;
+				break;
+
+			case ParameterType_String:
+				PlacementNew(&value.stringVal, parameter.value.stringVal);
+				break;
+
+			case ParameterType_Userdata:
+				value.userdataVal = parameter.value.userdataVal;
+				++(value.userdataVal->counter);
+				break;
+
+			case ParameterType_None:
+				break;
+		}
+		type = parameter.type;
+
+		return *this;
+	}
+
+	ParameterList::Parameter& ParameterList::Parameter::operator=(Parameter&& parameter) noexcept
+	{
+		if (this == &parameter)
+			return *this;
+
+		switch (parameter.type)
+		{
+			case ParameterType_String:
+				Destroy();
+
+				key = parameter.key;
+				PlacementNew(&value.stringVal, std::move(parameter.value.stringVal));
+				type = ParameterType_String;
+				break;
+
+			case ParameterType_Userdata:
+				Destroy();
+
+				// We steal the reference of the other parameter
+				key = parameter.key;
+				value.userdataVal = parameter.value.userdataVal;
+				type = ParameterType_Userdata;
+
+				parameter.type = ParameterType_None;
+				break;
+
+			case ParameterType_Boolean:
+			case ParameterType_Color:
+			case ParameterType_Float:
+			case ParameterType_Integer:
+			case ParameterType_None:
+			case ParameterType_Pointer:
+				operator=(static_cast<const Parameter&>(parameter));
+				break;
+		}
+
+		return *this;
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::FrozenParameterList
+	* \brief Core class that represents an immutable parameter list, shared between its copies
+	*
+	* Copying a frozen list only increments a reference count, which makes it suitable to be stored by every resource
+	* built from the same parameters.
+	*/
+
+	/*!
+	* \brief Constructs an empty FrozenParameterList object
+	*/
+	FrozenParameterList::FrozenParameterList() :
+	m_list(GetEmptyParameterList())
+	{
+	}
+
+	/*!
+	* \brief Constructs a FrozenParameterList object by copying a parameter list
+	*
+	* \param list List to freeze
+	*/
+	FrozenParameterList::FrozenParameterList(const ParameterList& list) :
+	m_list(std::make_shared<const ParameterList>(list))
+	{
+	}
+
+	/*!
+	* \brief Constructs a FrozenParameterList object by moving a parameter list
+	*
+	* \param list List to freeze
+	*/
+	FrozenParameterList::FrozenParameterList(ParameterList&& list) :
+	m_list(std::make_shared<const ParameterList>(std::move(list)))
+	{
 	}
 }
 
@@ -10,6 +10,8 @@
 namespace Nz
 {
 	FileImpl::FileImpl(const File* parent) :
+	m_mappedData(nullptr),
+	m_mappedSize(0),
 	m_endOfFile(false),
 	m_endOfFileUpdated(true)
 	{
@@ -18,6 +20,8 @@ namespace Nz
 
 	void FileImpl::Close()
 	{
+		Unmap();
+
 		if (m_fileDescriptor != -1)
 			close(m_fileDescriptor);
 	}
@@ -49,6 +53,46 @@ namespace Nz
 		return static_cast<UInt64>(position);
 	}
 
+	bool FileImpl::IsMapped() const
+	{
+		return m_mappedData != nullptr;
+	}
+
+	const void* FileImpl::Map()
+	{
+		if (m_mappedData)
+			return m_mappedData;
+
+		struct stat64 fileSize;
+		if (fstat64(m_fileDescriptor, &fileSize) == -1)
+		{
+			NazaraError("Failed to get file size: " + Error::GetLastSystemError());
+			return nullptr;
+		}
+
+		if (fileSize.st_size == 0)
+		{
+			NazaraError("Cannot map an empty file");
+			return nullptr;
+		}
+
+		std::size_t size = static_cast<std::size_t>(fileSize.st_size);
+		void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fileDescriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			NazaraError("Failed to map file: " + Error::GetLastSystemError());
+			return nullptr;
+		}
+
+		// Loaders usually parse the whole file from the beginning
+		madvise(data, size, MADV_SEQUENTIAL);
+
+		m_mappedData = data;
+		m_mappedSize = size;
+
+		return m_mappedData;
+	}
+
 	bool FileImpl::Open(const String& filePath, UInt32 mode)
 	{
 		int flags;
@@ -120,9 +164,22 @@ namespace Nz
 
 	bool FileImpl::SetSize(UInt64 size)
 	{
+		Unmap();
+
 		return ftruncate64(m_fileDescriptor, size) != 0;
 	}
 
+	void FileImpl::Unmap()
+	{
+		if (m_mappedData)
+		{
+			munmap(m_mappedData, m_mappedSize);
+
+			m_mappedData = nullptr;
+			m_mappedSize = 0;
+		}
+	}
+
 	std::size_t FileImpl::Write(const void* buffer, std::size_t size)
 	{
 		lockf64(m_fileDescriptor, F_LOCK, size);
@@ -16,6 +16,7 @@
 #include <ctime>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -36,10 +37,13 @@ namespace Nz
 			bool EndOfFile() const;
 			void Flush();
 			UInt64 GetCursorPos() const;
+			bool IsMapped() const;
+			const void* Map();
 			bool Open(const String& filePath, UInt32 mode);
 			std::size_t Read(void* buffer, std::size_t size);
 			bool SetCursorPos(CursorPosition pos, Int64 offset);
 			bool SetSize(UInt64 size);
+			void Unmap();
 			std::size_t Write(const void* buffer, std::size_t size);
 
 			FileImpl& operator=(const FileImpl&) = delete;
@@ -55,6 +59,8 @@ namespace Nz
 			static bool Rename(const String& sourcePath, const String& targetPath);
 
 		private:
+			void* m_mappedData;
+			std::size_t m_mappedSize;
 			int m_fileDescriptor;
 			mutable bool m_endOfFile;
 			mutable bool m_endOfFileUpdated;
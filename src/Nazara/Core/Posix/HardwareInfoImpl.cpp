@@ -4,6 +4,9 @@
 
 #include <Nazara/Core/Posix/HardwareInfoImpl.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <utility>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -20,6 +23,53 @@ namespace Nz
 	#endif
 	}
 
+	bool HardwareInfoImpl::GetCoreProcessorMasks(std::vector<UInt64>* coreMasks)
+	{
+		#ifdef NAZARA_PLATFORM_LINUX
+		auto ReadTopologyValue = [](unsigned int processor, const char* name, int* value) -> bool
+		{
+			char path[128];
+			std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/topology/%s", processor, name);
+
+			FILE* file = std::fopen(path, "r");
+			if (!file)
+				return false;
+
+			bool succeeded = (std::fscanf(file, "%d", value) == 1);
+			std::fclose(file);
+
+			return succeeded;
+		};
+
+		// Logical processors sharing the same core of the same package are hyperthreads of a physical core
+		std::vector<std::pair<int, int>> cores;
+
+		unsigned int processorCount = std::min(GetProcessorCount(), 64U);
+		for (unsigned int processor = 0; processor < processorCount; ++processor)
+		{
+			int coreId;
+			int packageId;
+			if (!ReadTopologyValue(processor, "core_id", &coreId) || !ReadTopologyValue(processor, "physical_package_id", &packageId))
+				continue; // Offline processor
+
+			auto core = std::make_pair(packageId, coreId);
+			auto it = std::find(cores.begin(), cores.end(), core);
+			if (it == cores.end())
+			{
+				cores.push_back(core);
+				coreMasks->push_back(UInt64(1) << processor);
+			}
+			else
+				(*coreMasks)[it - cores.begin()] |= UInt64(1) << processor;
+		}
+
+		return !coreMasks->empty();
+		#else
+		NazaraUnused(coreMasks);
+		return false;
+		#endif
+	}
+
 	unsigned int HardwareInfoImpl::GetProcessorCount()
 	{
 		// Plus simple (et plus portable) que de passer par le CPUID
@@ -63,4 +113,19 @@ namespace Nz
 		#endif
 	#endif
 	}
+
+	UInt64 HardwareInfoImpl::Xgetbv(UInt32 index)
+	{
+	#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_INTEL)
+		UInt32 eax, edx;
+		asm volatile (".byte 0x0f, 0x01, 0xd0" // xgetbv, encoded for assemblers not knowing it
+					  : "=a" (eax), "=d" (edx) // output
+					  : "c" (index));          // input
+
+		return (UInt64(edx) << 32) | eax;
+	#else
+		NazaraInternalError("Xgetbv has been called although it is not supported");
+		return 0;
+	#endif
+	}
 }
@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Posix/SharedMutexImpl.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	SharedMutexImpl::SharedMutexImpl()
+	{
+		pthread_rwlockattr_t attr;
+		pthread_rwlockattr_init(&attr);
+
+		#ifdef __GLIBC__
+		// glibc favors readers by default, which may starve writers
+		pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+		#endif
+
+		pthread_rwlock_init(&m_handle, &attr);
+		pthread_rwlockattr_destroy(&attr);
+	}
+
+	SharedMutexImpl::~SharedMutexImpl()
+	{
+		pthread_rwlock_destroy(&m_handle);
+	}
+
+	void SharedMutexImpl::Lock()
+	{
+		pthread_rwlock_wrlock(&m_handle);
+	}
+
+	void SharedMutexImpl::LockShared()
+	{
+		pthread_rwlock_rdlock(&m_handle);
+	}
+
+	bool SharedMutexImpl::TryLock()
+	{
+		return pthread_rwlock_trywrlock(&m_handle) == 0;
+	}
+
+	bool SharedMutexImpl::TryLockShared()
+	{
+		return pthread_rwlock_tryrdlock(&m_handle) == 0;
+	}
+
+	void SharedMutexImpl::Unlock()
+	{
+		pthread_rwlock_unlock(&m_handle);
+	}
+
+	void SharedMutexImpl::UnlockShared()
+	{
+		pthread_rwlock_unlock(&m_handle);
+	}
+}
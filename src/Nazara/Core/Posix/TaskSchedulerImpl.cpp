@@ -5,11 +5,19 @@
 #include <Nazara/Core/Posix/TaskSchedulerImpl.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Posix/ThreadImpl.hpp>
+#include <Nazara/Core/String.hpp>
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	bool TaskSchedulerImpl::Initialize(unsigned int workerCount)
+	unsigned int TaskSchedulerImpl::GetWorkerCount()
+	{
+		return s_workerCount;
+	}
+
+	bool TaskSchedulerImpl::Initialize(unsigned int workerCount, const UInt64* workerAffinities)
 	{
 		if (IsInitialized())
 			return true; // Déjà initialisé
@@ -23,25 +31,28 @@ namespace Nz
 		#endif
 
 		s_workerCount = workerCount;
-		s_isDone = false;
-		s_isWaiting = false;
 		s_shouldFinish = false;
+		s_injectedTaskCount = 0;
+		s_pendingTaskCount = 0;
+		s_queuedTaskCount = 0;
+		s_sleepingWorkerCount = 0;
 
-		s_threads.reset(new pthread_t[workerCount]);
+		s_workers.reset(new Worker[workerCount]);
 
-		// On initialise les conditions variables, mutex et barrière.
-		pthread_cond_init(&s_cvEmpty, nullptr);
-		pthread_cond_init(&s_cvNotEmpty, nullptr);
-		pthread_mutex_init(&s_mutexQueue, nullptr);
-		pthread_barrier_init(&s_barrier, nullptr, workerCount + 1);
+		pthread_cond_init(&s_cvDone, nullptr);
+		pthread_cond_init(&s_cvWork, nullptr);
+		pthread_mutex_init(&s_mutexInjection, nullptr);
+		pthread_mutex_init(&s_mutexSleep, nullptr);
 
 		for (unsigned int i = 0; i < s_workerCount; ++i)
 		{
-			// Le thread va se lancer, attendre que tous se créent et attendre d'être réveillé.
-			pthread_create(&s_threads[i], nullptr, WorkerProc, nullptr);
-		}
+			Worker& worker = s_workers[i];
+			worker.affinity = (workerAffinities) ? workerAffinities[i] : 0;
+			worker.id = i;
+			worker.seed = i * 2654435761U + 1;
 
-		pthread_barrier_wait(&s_barrier); // On attend que les enfants soient bien créés.
+			pthread_create(&worker.thread, nullptr, WorkerProc, &worker);
+		}
 
 		return true;
 	}
@@ -51,19 +62,63 @@ namespace Nz
 		return s_workerCount > 0;
 	}
 
+	unsigned int TaskSchedulerImpl::GetWorkerIndex()
+	{
+		NazaraAssert(s_currentWorker, "Calling thread is not a worker");
+
+		return s_currentWorker->id;
+	}
+
+	bool TaskSchedulerImpl::IsWorkerThread()
+	{
+		return s_currentWorker != nullptr;
+	}
+
 	void TaskSchedulerImpl::Run(Functor** tasks, unsigned int count)
 	{
-		// On s'assure que des tâches ne sont pas déjà en cours
-		Wait();
+		if (count == 0)
+			return;
 
-		pthread_mutex_lock(&s_mutexQueue);
-		s_isDone = false;
+		// The counters must be increased before the tasks are made visible, a thief could run them immediately
+		s_pendingTaskCount += count;
+		s_queuedTaskCount += count;
 
-		while (count--)
-			s_tasks.push(*tasks++);
+		if (s_currentWorker)
+		{
+			// Tasks spawned from a worker go to its own deque, no lock involved
+			for (unsigned int i = 0; i < count; ++i)
+				s_currentWorker->queue.Push(tasks[i]);
+		}
+		else
+		{
+			// Tasks coming from outside are injected all at once, workers will take them by batches
+			pthread_mutex_lock(&s_mutexInjection);
+			s_injectedTasks.insert(s_injectedTasks.end(), tasks, tasks + count);
+			s_injectedTaskCount += count;
+			pthread_mutex_unlock(&s_mutexInjection);
+		}
 
-		pthread_cond_signal(&s_cvNotEmpty);
-		pthread_mutex_unlock(&s_mutexQueue);
+		WakeWorkers(count);
+	}
+
+	bool TaskSchedulerImpl::TryExecuteTask()
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (s_workerCount == 0)
+		{
+			NazaraError("Task scheduler is not initialized");
+			return false;
+		}
+		#endif
+
+		Functor* task = FetchTask(s_currentWorker);
+		if (!task)
+			return false;
+
+		--s_queuedTaskCount;
+		ExecuteTask(task);
+
+		return true;
 	}
 
 	void TaskSchedulerImpl::Uninitialize()
@@ -77,24 +132,31 @@ namespace Nz
 		#endif
 
 		// On réveille les threads pour qu'ils sortent de la boucle et terminent.
-		pthread_mutex_lock(&s_mutexQueue);
-		// On commence par vider la queue et demander qu'ils s'arrêtent.
-		std::queue<Functor*> emptyQueue;
-		std::swap(s_tasks, emptyQueue);
+		pthread_mutex_lock(&s_mutexSleep);
 		s_shouldFinish = true;
-		pthread_cond_broadcast(&s_cvNotEmpty);
-		pthread_mutex_unlock(&s_mutexQueue);
+		pthread_cond_broadcast(&s_cvWork);
+		pthread_mutex_unlock(&s_mutexSleep);
 
 		// On attend que chaque thread se termine
 		for (unsigned int i = 0; i < s_workerCount; ++i)
-			pthread_join(s_threads[i], nullptr);
+			pthread_join(s_workers[i].thread, nullptr);
+
+		// Les tâches restantes ne seront jamais exécutées
+		for (Functor* task : s_injectedTasks)
+			delete task;
+
+		s_injectedTasks.clear();
+		s_injectedTaskCount = 0;
+		s_workers.reset(); // Clears the deques
 
 		// Et on libère les ressources
-		pthread_barrier_destroy(&s_barrier);
-		pthread_cond_destroy(&s_cvEmpty);
-		pthread_cond_destroy(&s_cvNotEmpty);
-		pthread_mutex_destroy(&s_mutexQueue);
+		pthread_cond_destroy(&s_cvDone);
+		pthread_cond_destroy(&s_cvWork);
+		pthread_mutex_destroy(&s_mutexInjection);
+		pthread_mutex_destroy(&s_mutexSleep);
 
+		s_pendingTaskCount = 0;
+		s_queuedTaskCount = 0;
 		s_workerCount = 0;
 	}
 
@@ -106,90 +168,160 @@ namespace Nz
 			NazaraError("Task scheduler is not initialized");
 			return;
 		}
+
+		if (s_currentWorker)
+		{
+			NazaraError("A worker cannot wait for every task");
+			return;
+		}
 		#endif
 
-		Wait();
+		pthread_mutex_lock(&s_mutexSleep);
+		while (s_pendingTaskCount > 0)
+			pthread_cond_wait(&s_cvDone, &s_mutexSleep);
+		pthread_mutex_unlock(&s_mutexSleep);
+	}
+
+	void TaskSchedulerImpl::ExecuteTask(Functor* task)
+	{
+		// On exécute la tâche avant de la supprimer
+		task->Run();
+		delete task;
+
+		if (--s_pendingTaskCount == 0)
+		{
+			pthread_mutex_lock(&s_mutexSleep);
+			pthread_cond_broadcast(&s_cvDone);
+			pthread_mutex_unlock(&s_mutexSleep);
+		}
 	}
 
-	Functor* TaskSchedulerImpl::PopQueue()
+	Functor* TaskSchedulerImpl::FetchTask(Worker* worker)
 	{
+		// Our own work first (most recent task, still hot in cache)
+		if (worker)
+		{
+			if (Functor* task = worker->queue.Pop())
+				return task;
+		}
+
+		// Then tasks coming from outside, workers take their share of them to reduce contention on the injection mutex
 		Functor* task = nullptr;
+		if (s_injectedTaskCount > 0)
+		{
+			pthread_mutex_lock(&s_mutexInjection);
+			if (!s_injectedTasks.empty())
+			{
+				std::size_t injectedCount = s_injectedTasks.size();
+				std::size_t batchSize = (worker) ? std::max<std::size_t>(injectedCount / s_workerCount, 1) : 1;
+
+				task = s_injectedTasks.back();
+				for (std::size_t i = 1; i < batchSize; ++i)
+					worker->queue.Push(s_injectedTasks[injectedCount - i - 1]);
+
+				s_injectedTasks.resize(injectedCount - batchSize);
+				s_injectedTaskCount -= static_cast<unsigned int>(batchSize);
+			}
+			pthread_mutex_unlock(&s_mutexInjection);
 
-		pthread_mutex_lock(&s_mutexQueue);
+			if (task)
+				return task;
+		}
 
-		if (!s_tasks.empty())
+		// Nothing left for us, let's steal from the workers
+		return StealTask(worker);
+	}
+
+	Functor* TaskSchedulerImpl::StealTask(Worker* thief)
+	{
+		// Random starting victim to spread thieves among the workers
+		unsigned int offset = 0;
+		if (thief)
 		{
-			task = s_tasks.front();
-			s_tasks.pop();
+			thief->seed = thief->seed * 1103515245U + 12345U;
+			offset = (thief->seed >> 16) % s_workerCount;
 		}
 
-		pthread_mutex_unlock(&s_mutexQueue);
+		for (unsigned int i = 0; i < s_workerCount; ++i)
+		{
+			Worker& victim = s_workers[(offset + i) % s_workerCount];
+			if (&victim == thief)
+				continue;
+
+			if (Functor* task = victim.queue.Steal())
+				return task;
+		}
 
-		return task;
+		return nullptr;
 	}
 
-	void TaskSchedulerImpl::Wait()
+	void TaskSchedulerImpl::WakeWorkers(unsigned int count)
 	{
-		if (s_isDone)
+		// Paired with the sleeping worker check: either it sees the queued tasks or we see it sleeping
+		unsigned int sleepingCount = s_sleepingWorkerCount;
+		if (sleepingCount == 0)
 			return;
 
-		pthread_mutex_lock(&s_mutexQueue);
-		s_isWaiting = true;
-		pthread_cond_broadcast(&s_cvNotEmpty);
-		pthread_cond_wait(&s_cvEmpty, &s_mutexQueue);
-		pthread_mutex_unlock(&s_mutexQueue);
-
-		s_isDone = true;
+		pthread_mutex_lock(&s_mutexSleep);
+		if (count >= sleepingCount)
+			pthread_cond_broadcast(&s_cvWork);
+		else
+		{
+			for (unsigned int i = 0; i < count; ++i)
+				pthread_cond_signal(&s_cvWork);
+		}
+		pthread_mutex_unlock(&s_mutexSleep);
 	}
 
-	void* TaskSchedulerImpl::WorkerProc(void* /*userdata*/)
+	void* TaskSchedulerImpl::WorkerProc(void* userdata)
 	{
-		// On s'assure que tous les threads soient correctement lancés.
-		pthread_barrier_wait(&s_barrier);
+		Worker& worker = *static_cast<Worker*>(userdata);
+		s_currentWorker = &worker;
+
+		ThreadImpl::SetCurrentThreadName("Nz Worker #" + String::Number(worker.id));
+		if (worker.affinity != 0)
+			ThreadImpl::SetCurrentThreadAffinity(worker.affinity);
 
 		// On quitte s'il doit terminer.
 		while (!s_shouldFinish)
 		{
-			Functor* task = PopQueue();
-
+			Functor* task = FetchTask(&worker);
 			if (task)
 			{
-				// On exécute la tâche avant de la supprimer
-				task->Run();
-				delete task;
+				--s_queuedTaskCount;
+				ExecuteTask(task);
 			}
-			else
+			else if (s_queuedTaskCount == 0)
 			{
-				pthread_mutex_lock(&s_mutexQueue);
-				if (s_tasks.empty())
-					s_isDone = true;
+				pthread_mutex_lock(&s_mutexSleep);
+				++s_sleepingWorkerCount;
 
-				while (!(!s_tasks.empty() || s_isWaiting || s_shouldFinish))
-					pthread_cond_wait(&s_cvNotEmpty, &s_mutexQueue);
+				while (s_queuedTaskCount == 0 && !s_shouldFinish)
+					pthread_cond_wait(&s_cvWork, &s_mutexSleep);
 
-				if (s_tasks.empty() && s_isWaiting)
-				{
-					// On prévient le thread qui attend que les tâches soient effectuées.
-					s_isWaiting = false;
-					pthread_cond_signal(&s_cvEmpty);
-				}
-
-				pthread_mutex_unlock(&s_mutexQueue);
+				--s_sleepingWorkerCount;
+				pthread_mutex_unlock(&s_mutexSleep);
 			}
+			// Otherwise a task is being pushed or we lost a race against another thief, retry
 		}
 
+		s_currentWorker = nullptr;
+
 		return nullptr;
 	}
 
-	std::queue<Functor*> TaskSchedulerImpl::s_tasks;
-	std::unique_ptr<pthread_t[]> TaskSchedulerImpl::s_threads;
-	std::atomic<bool> TaskSchedulerImpl::s_isDone;
-	std::atomic<bool> TaskSchedulerImpl::s_isWaiting;
-	std::atomic<bool> TaskSchedulerImpl::s_shouldFinish;
+	std::unique_ptr<TaskSchedulerImpl::Worker[]> TaskSchedulerImpl::s_workers;
+	std::vector<Functor*> TaskSchedulerImpl::s_injectedTasks;
+	std::atomic_bool TaskSchedulerImpl::s_shouldFinish;
+	std::atomic_uint TaskSchedulerImpl::s_injectedTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_pendingTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_queuedTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_sleepingWorkerCount;
 	unsigned int TaskSchedulerImpl::s_workerCount;
+	thread_local TaskSchedulerImpl::Worker* TaskSchedulerImpl::s_currentWorker = nullptr;
 
-	pthread_mutex_t TaskSchedulerImpl::s_mutexQueue;
-	pthread_cond_t TaskSchedulerImpl::s_cvEmpty;
-	pthread_cond_t TaskSchedulerImpl::s_cvNotEmpty;
-	pthread_barrier_t TaskSchedulerImpl::s_barrier;
+	pthread_mutex_t TaskSchedulerImpl::s_mutexInjection;
+	pthread_mutex_t TaskSchedulerImpl::s_mutexSleep;
+	pthread_cond_t TaskSchedulerImpl::s_cvDone;
+	pthread_cond_t TaskSchedulerImpl::s_cvWork;
 }
@@ -9,10 +9,11 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/WorkStealingQueue.hpp>
 #include <atomic>
 #include <memory>
 #include <pthread.h>
-#include <queue>
+#include <vector>
 
 namespace Nz
 {
@@ -22,28 +23,48 @@ namespace Nz
 			TaskSchedulerImpl() = delete;
 			~TaskSchedulerImpl() = delete;
 
-			static bool Initialize(unsigned int workerCount);
+			static unsigned int GetWorkerCount();
+			static unsigned int GetWorkerIndex();
+			static bool Initialize(unsigned int workerCount, const UInt64* workerAffinities = nullptr);
 			static bool IsInitialized();
+			static bool IsWorkerThread();
 			static void Run(Functor** tasks, unsigned int count);
+			static bool TryExecuteTask();
 			static void Uninitialize();
 			static void WaitForTasks();
 
 		private:
-			static Functor* PopQueue();
-			static void Wait();
+			struct Worker;
+
+			static void ExecuteTask(Functor* task);
+			static Functor* FetchTask(Worker* worker);
+			static Functor* StealTask(Worker* thief);
+			static void WakeWorkers(unsigned int count);
 			static void* WorkerProc(void* userdata);
 
-			static std::queue<Functor*> s_tasks;
-			static std::unique_ptr<pthread_t[]> s_threads;
-			static std::atomic<bool> s_isDone;
-			static std::atomic<bool> s_isWaiting;
-			static std::atomic<bool> s_shouldFinish;
+			struct Worker
+			{
+				WorkStealingQueue queue;
+				pthread_t thread;
+				UInt64 affinity;
+				unsigned int id;
+				unsigned int seed;
+			};
+
+			static std::unique_ptr<Worker[]> s_workers;
+			static std::vector<Functor*> s_injectedTasks;
+			static std::atomic_bool s_shouldFinish;
+			static std::atomic_uint s_injectedTaskCount;
+			static std::atomic_uint s_pendingTaskCount;
+			static std::atomic_uint s_queuedTaskCount;
+			static std::atomic_uint s_sleepingWorkerCount;
 			static unsigned int s_workerCount;
+			static thread_local Worker* s_currentWorker;
 
-			static pthread_mutex_t s_mutexQueue;
-			static pthread_cond_t s_cvEmpty;
-			static pthread_cond_t s_cvNotEmpty;
-			static pthread_barrier_t s_barrier;
+			static pthread_mutex_t s_mutexInjection;
+			static pthread_mutex_t s_mutexSleep;
+			static pthread_cond_t s_cvDone;
+			static pthread_cond_t s_cvWork;
 	};
 }
 
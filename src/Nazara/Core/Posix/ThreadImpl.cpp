@@ -5,17 +5,56 @@
 #include <Nazara/Core/Posix/ThreadImpl.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/String.hpp>
+#include <sched.h>
+#include <semaphore.h>
 #include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/time.h>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	ThreadImpl::ThreadImpl(Functor* functor)
+	namespace
 	{
-		int error = pthread_create(&m_handle, nullptr, &ThreadImpl::ThreadProc, functor);
+		pid_t GetCurrentTid()
+		{
+			#ifdef NAZARA_PLATFORM_LINUX
+			return static_cast<pid_t>(syscall(SYS_gettid));
+			#else
+			return 0;
+			#endif
+		}
+	}
+
+	struct ThreadImpl::StartData
+	{
+		Functor* functor;
+		pid_t tid;
+		sem_t ready;
+	};
+
+	ThreadImpl::ThreadImpl(Functor* functor) :
+	m_tid(0)
+	{
+		// The thread publishes its kernel id before running, Linux needs it to change the priority of a single thread
+		StartData startData;
+		startData.functor = functor;
+		startData.tid = 0;
+		sem_init(&startData.ready, 0, 0);
+
+		int error = pthread_create(&m_handle, nullptr, &ThreadImpl::ThreadProc, &startData);
 		if (error != 0)
 			NazaraInternalError("Failed to create thread: " + Error::GetLastSystemError());
+		else
+		{
+			while (sem_wait(&startData.ready) != 0); // Interrupted by a signal
+
+			m_tid = startData.tid;
+		}
+
+		sem_destroy(&startData.ready);
 	}
 
 	void ThreadImpl::Detach()
@@ -28,9 +67,111 @@ namespace Nz
 		pthread_join(m_handle, nullptr);
 	}
 
+	bool ThreadImpl::SetAffinity(UInt64 processorMask)
+	{
+		return SetAffinity(m_handle, processorMask);
+	}
+
+	bool ThreadImpl::SetName(const String& name)
+	{
+		#ifdef NAZARA_PLATFORM_LINUX
+		// Linux limits names to 16 bytes, including the null terminator
+		return pthread_setname_np(m_handle, name.SubString(0, 14).GetConstBuffer()) == 0;
+		#else
+		NazaraUnused(name);
+		return false; // Other systems may only name the calling thread
+		#endif
+	}
+
+	bool ThreadImpl::SetPriority(ThreadPriority priority)
+	{
+		return SetPriority(m_handle, m_tid, priority);
+	}
+
+	bool ThreadImpl::SetCurrentThreadAffinity(UInt64 processorMask)
+	{
+		return SetAffinity(pthread_self(), processorMask);
+	}
+
+	bool ThreadImpl::SetCurrentThreadName(const String& name)
+	{
+		#if defined(NAZARA_PLATFORM_LINUX)
+		return pthread_setname_np(pthread_self(), name.SubString(0, 14).GetConstBuffer()) == 0;
+		#elif defined(NAZARA_PLATFORM_MACOSX)
+		return pthread_setname_np(name.GetConstBuffer()) == 0;
+		#else
+		NazaraUnused(name);
+		return false;
+		#endif
+	}
+
+	bool ThreadImpl::SetCurrentThreadPriority(ThreadPriority priority)
+	{
+		return SetPriority(pthread_self(), GetCurrentTid(), priority);
+	}
+
+	bool ThreadImpl::SetAffinity(pthread_t handle, UInt64 processorMask)
+	{
+		#ifdef NAZARA_PLATFORM_LINUX
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+
+		for (unsigned int i = 0; i < 64; ++i)
+		{
+			if (processorMask & (UInt64(1) << i))
+				CPU_SET(i, &cpuSet);
+		}
+
+		return pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuSet) == 0;
+		#else
+		NazaraUnused(handle);
+		NazaraUnused(processorMask);
+		return false; // No portable way to do it
+		#endif
+	}
+
+	bool ThreadImpl::SetPriority(pthread_t handle, pid_t tid, ThreadPriority priority)
+	{
+		#ifdef NAZARA_PLATFORM_LINUX
+		// The default policy (SCHED_OTHER) ignores the pthread priority, each thread has its own nice value though
+		NazaraUnused(handle);
+
+		static const int niceValues[] = {
+			10, // ThreadPriority_Lowest
+			5,  // ThreadPriority_Low
+			0,  // ThreadPriority_Normal
+			-5, // ThreadPriority_High
+			-10 // ThreadPriority_Highest
+		};
+
+		static_assert(sizeof(niceValues)/sizeof(int) == ThreadPriority_Max+1, "Nice value array is incomplete");
+
+		return tid != 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(tid), niceValues[priority]) == 0;
+		#else
+		NazaraUnused(tid);
+
+		int policy;
+		sched_param param;
+		if (pthread_getschedparam(handle, &policy, &param) != 0)
+			return false;
+
+		int minPriority = sched_get_priority_min(policy);
+		int maxPriority = sched_get_priority_max(policy);
+
+		param.sched_priority = minPriority + (maxPriority - minPriority) * priority / ThreadPriority_Max;
+
+		return pthread_setschedparam(handle, policy, &param) == 0;
+		#endif
+	}
+
 	void* ThreadImpl::ThreadProc(void* userdata)
 	{
-		Functor* func = static_cast<Functor*>(userdata);
+		StartData* startData = static_cast<StartData*>(userdata);
+		Functor* func = startData->functor;
+
+		startData->tid = GetCurrentTid();
+		sem_post(&startData->ready); // startData is invalid from here
+
 		func->Run();
 		delete func;
 
@@ -53,7 +194,7 @@ namespace Nz
 
 		// construct the time limit (current time + time to wait)
 		timespec ti;
-		ti.tv_nsec = (tv.tv_usec + (time % 1000)) * 1000;
+		ti.tv_nsec = (tv.tv_usec + (time % 1000) * 1000) * 1000;
 		ti.tv_sec = tv.tv_sec + (time / 1000) + (ti.tv_nsec / 1000000000);
 		ti.tv_nsec %= 1000000000;
 
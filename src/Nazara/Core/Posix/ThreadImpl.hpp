@@ -8,11 +8,14 @@
 #define NAZARA_THREADIMPL_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <pthread.h>
+#include <sys/types.h>
 
 namespace Nz
 {
 	struct Functor;
+	class String;
 
 	class ThreadImpl
 	{
@@ -22,12 +25,24 @@ namespace Nz
 			void Detach();
 			void Join();
 
+			bool SetAffinity(UInt64 processorMask);
+			bool SetName(const String& name);
+			bool SetPriority(ThreadPriority priority);
+
+			static bool SetCurrentThreadAffinity(UInt64 processorMask);
+			static bool SetCurrentThreadName(const String& name);
+			static bool SetCurrentThreadPriority(ThreadPriority priority);
 			static void Sleep(UInt32 time);
 
 		private:
+			struct StartData;
+
+			static bool SetAffinity(pthread_t handle, UInt64 processorMask);
+			static bool SetPriority(pthread_t handle, pid_t tid, ThreadPriority priority);
 			static void* ThreadProc(void* userdata);
 
 			pthread_t m_handle;
+			pid_t m_tid;
 	};
 }
 
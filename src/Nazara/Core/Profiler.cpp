@@ -0,0 +1,452 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/StringStream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		const std::size_t eventCapacity = 1 << 15; // Per thread, older events are overwritten
+		const std::size_t statsCapacity = 512; // Per thread, zones past this count are not part of the stats
+
+		std::atomic<bool> s_enabled(false);
+	}
+
+	struct Profiler::ThreadData
+	{
+		struct Event
+		{
+			std::atomic<const char*> name;
+			std::atomic<UInt64> beginTime;
+			std::atomic<UInt64> duration;
+		};
+
+		struct Stats
+		{
+			std::atomic<const char*> name;
+			std::atomic<UInt64> callCount;
+			std::atomic<UInt64> maxTime;
+			std::atomic<UInt64> selfTime;
+			std::atomic<UInt64> totalTime;
+		};
+
+		ThreadData(unsigned int threadId) :
+		events(new Event[eventCapacity]()),
+		eventCount(0),
+		firstEvent(0),
+		alive(true),
+		resetRequested(false),
+		currentZone(nullptr),
+		id(threadId)
+		{
+			ResetStats();
+		}
+
+		// Only called by the owning thread, only written with atomic stores so readers never lock it
+		void Record(const char* zoneName, UInt64 begin, UInt64 duration, UInt64 selfTime)
+		{
+			if (resetRequested.load(std::memory_order_acquire))
+			{
+				ResetStats();
+				resetRequested.store(false, std::memory_order_release);
+			}
+
+			UInt64 index = eventCount.load(std::memory_order_relaxed);
+
+			Event& event = events[index & (eventCapacity - 1)];
+			event.name.store(zoneName, std::memory_order_relaxed);
+			event.beginTime.store(begin, std::memory_order_relaxed);
+			event.duration.store(duration, std::memory_order_relaxed);
+
+			eventCount.store(index + 1, std::memory_order_release);
+
+			// Zones are identified by the address of their name, which is a string literal
+			std::size_t slot = (reinterpret_cast<std::uintptr_t>(zoneName) >> 3) & (statsCapacity - 1);
+			for (std::size_t i = 0; i < statsCapacity; ++i, slot = (slot + 1) & (statsCapacity - 1))
+			{
+				Stats& entry = stats[slot];
+
+				const char* entryName = entry.name.load(std::memory_order_relaxed);
+				if (!entryName)
+					entry.name.store(zoneName, std::memory_order_release);
+				else if (entryName != zoneName)
+					continue;
+
+				entry.callCount.store(entry.callCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				entry.selfTime.store(entry.selfTime.load(std::memory_order_relaxed) + selfTime, std::memory_order_relaxed);
+				entry.totalTime.store(entry.totalTime.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+
+				if (duration > entry.maxTime.load(std::memory_order_relaxed))
+					entry.maxTime.store(duration, std::memory_order_relaxed);
+
+				break;
+			}
+		}
+
+		void ResetStats()
+		{
+			for (Stats& entry : stats)
+			{
+				entry.callCount.store(0, std::memory_order_relaxed);
+				entry.maxTime.store(0, std::memory_order_relaxed);
+				entry.selfTime.store(0, std::memory_order_relaxed);
+				entry.totalTime.store(0, std::memory_order_relaxed);
+				entry.name.store(nullptr, std::memory_order_release);
+			}
+		}
+
+		std::unique_ptr<Event[]> events;
+		Stats stats[statsCapacity];
+		std::atomic<UInt64> eventCount;
+		std::atomic<UInt64> firstEvent;
+		std::atomic<bool> alive;
+		std::atomic<bool> resetRequested;
+		String name; //< Protected by the registry mutex
+		Zone* currentZone;
+		unsigned int id;
+	};
+
+	struct Profiler::ThreadRegistry
+	{
+		Mutex mutex;
+		std::vector<std::unique_ptr<ThreadData>> threads;
+	};
+
+	namespace
+	{
+		void WriteEscapedString(StringStream& ss, const char* string)
+		{
+			ss << '"';
+			for (; *string; ++string)
+			{
+				char character = *string;
+				if (character == '"' || character == '\\')
+					ss << '\\' << character;
+				else if (static_cast<unsigned char>(character) < 0x20)
+					ss << ' ';
+				else
+					ss << character;
+			}
+			ss << '"';
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::Profiler
+	* \brief Core class that records timed zones of code and reports them as statistics or as a Chrome trace
+	*
+	* Zones are declared with the NazaraProfileZone(name) macro, which times the rest of the scope when the profiler is enabled.
+	* Each thread records its zones into its own buffer, without taking any lock, only the readers (GetStats, ExportChromeTrace) do.
+	*
+	* \remark The name of a zone must live as long as the profiler, string literals are expected
+	* \remark Setting NAZARA_CORE_ENABLE_PROFILER to 0 removes the zones from the code
+	*/
+
+	/*!
+	* \brief Discards the recorded events and statistics of every thread
+	*
+	* \remark Statistics of running threads are reset when they end their next zone
+	*/
+	void Profiler::Clear()
+	{
+		ThreadRegistry& registry = GetRegistry();
+		LockGuard lock(registry.mutex);
+
+		for (auto& thread : registry.threads)
+		{
+			thread->firstEvent.store(thread->eventCount.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+			if (thread->alive.load(std::memory_order_acquire))
+				thread->resetRequested.store(true, std::memory_order_release);
+			else
+				thread->ResetStats();
+		}
+	}
+
+	/*!
+	* \brief Enables or disables the recording of zones
+	*
+	* \param enable Should the zones be recorded
+	*
+	* \remark The profiler is disabled by default, a disabled zone only costs a test
+	*/
+	void Profiler::Enable(bool enable)
+	{
+		// Zones are timed with GetTimestamp, its frequency is measured now rather than during the first zone
+		if (enable)
+			GetTimestampFrequency();
+
+		s_enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Exports the recorded events as a Chrome trace file, readable by chrome://tracing or Perfetto
+	* \return true if successful
+	*
+	* \param filePath Path of the file to write
+	*/
+	bool Profiler::ExportChromeTrace(const String& filePath)
+	{
+		File file(filePath, OpenMode_WriteOnly | OpenMode_Truncate);
+		if (!file.IsOpen())
+		{
+			NazaraError("Failed to open \"" + filePath + '"');
+			return false;
+		}
+
+		return ExportChromeTrace(file);
+	}
+
+	/*!
+	* \brief Exports the recorded events as a Chrome trace (JSON array format)
+	* \return true if successful
+	*
+	* \param stream Stream to write to
+	*/
+	bool Profiler::ExportChromeTrace(Stream& stream)
+	{
+		StringStream ss;
+		ss << "{\"traceEvents\":[";
+
+		bool first = true;
+		auto BeginEvent = [&]()
+		{
+			if (!first)
+				ss << ",\n";
+
+			first = false;
+		};
+
+		ThreadRegistry& registry = GetRegistry();
+		{
+			LockGuard lock(registry.mutex);
+
+			for (auto& thread : registry.threads)
+			{
+				if (!thread->name.IsEmpty())
+				{
+					BeginEvent();
+					ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread->id << ",\"args\":{\"name\":";
+					WriteEscapedString(ss, thread->name.GetConstBuffer());
+					ss << "}}";
+				}
+
+				UInt64 end = thread->eventCount.load(std::memory_order_acquire);
+				UInt64 begin = std::max(thread->firstEvent.load(std::memory_order_relaxed), (end > eventCapacity) ? end - eventCapacity : 0);
+
+				struct EventCopy
+				{
+					const char* name;
+					UInt64 beginTime;
+					UInt64 duration;
+				};
+
+				std::vector<EventCopy> events;
+				events.reserve(static_cast<std::size_t>(end - begin));
+
+				for (UInt64 i = begin; i < end; ++i)
+				{
+					const ThreadData::Event& event = thread->events[i & (eventCapacity - 1)];
+					events.push_back({event.name.load(std::memory_order_relaxed), event.beginTime.load(std::memory_order_relaxed), event.duration.load(std::memory_order_relaxed)});
+				}
+
+				// The thread may have overwritten the oldest events while we were copying them
+				std::atomic_thread_fence(std::memory_order_acquire);
+				UInt64 newEnd = thread->eventCount.load(std::memory_order_relaxed);
+				std::size_t overwritten = (newEnd > begin + eventCapacity) ? static_cast<std::size_t>(std::min(newEnd - eventCapacity - begin, end - begin)) : 0;
+
+				for (std::size_t i = overwritten; i < events.size(); ++i)
+				{
+					BeginEvent();
+					ss << "{\"name\":";
+					WriteEscapedString(ss, events[i].name);
+					ss << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread->id << ",\"ts\":" << TimestampToMicroseconds(events[i].beginTime) << ",\"dur\":" << TimestampToMicroseconds(events[i].duration) << '}';
+				}
+			}
+		}
+
+		ss << "],\"displayTimeUnit\":\"ms\"}\n";
+
+		if (!stream.Write(ss.ToString()))
+		{
+			NazaraError("Failed to write trace");
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Gets the statistics of each zone, merged from every thread
+	* \return Statistics sorted by decreasing total time (in microseconds)
+	*
+	* \remark The self time of a zone does not include the time spent in the zones it contains
+	*/
+	std::vector<Profiler::ZoneStats> Profiler::GetStats()
+	{
+		std::vector<ZoneStats> zoneStats;
+
+		ThreadRegistry& registry = GetRegistry();
+		{
+			LockGuard lock(registry.mutex);
+
+			for (auto& thread : registry.threads)
+			{
+				if (thread->resetRequested.load(std::memory_order_acquire))
+					continue;
+
+				for (const ThreadData::Stats& entry : thread->stats)
+				{
+					const char* name = entry.name.load(std::memory_order_acquire);
+					if (!name)
+						continue;
+
+					// The same zone name may have different addresses (and thus entries) if it appears in multiple places
+					auto it = std::find_if(zoneStats.begin(), zoneStats.end(), [name] (const ZoneStats& stats) { return std::strcmp(stats.name, name) == 0; });
+					if (it == zoneStats.end())
+					{
+						zoneStats.push_back({name, 0, 0, 0, 0});
+						it = zoneStats.end() - 1;
+					}
+
+					it->callCount += entry.callCount.load(std::memory_order_relaxed);
+					it->maxTime = std::max<UInt64>(it->maxTime, entry.maxTime.load(std::memory_order_relaxed));
+					it->selfTime += entry.selfTime.load(std::memory_order_relaxed);
+					it->totalTime += entry.totalTime.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Zones record timestamp ticks, only the merged values are converted
+		for (ZoneStats& stats : zoneStats)
+		{
+			stats.maxTime = TimestampToMicroseconds(stats.maxTime);
+			stats.selfTime = TimestampToMicroseconds(stats.selfTime);
+			stats.totalTime = TimestampToMicroseconds(stats.totalTime);
+		}
+
+		std::sort(zoneStats.begin(), zoneStats.end(), [] (const ZoneStats& lhs, const ZoneStats& rhs) { return lhs.totalTime > rhs.totalTime; });
+
+		return zoneStats;
+	}
+
+	/*!
+	* \brief Checks whether the zones are recorded
+	* \return true if the profiler is enabled
+	*/
+	bool Profiler::IsEnabled()
+	{
+		return s_enabled.load(std::memory_order_relaxed);
+	}
+
+	/*!
+	* \brief Sets the name of the calling thread, as shown in traces
+	*
+	* \param name Name of the thread
+	*/
+	void Profiler::SetThreadName(const String& name)
+	{
+		ThreadData* thread = GetThreadData();
+
+		LockGuard lock(GetRegistry().mutex);
+		thread->name = name;
+	}
+
+	/*!
+	* \brief Gets the list of the threads which recorded zones
+	* \return Registry of the threads
+	*/
+	auto Profiler::GetRegistry() -> ThreadRegistry&
+	{
+		static ThreadRegistry registry;
+		return registry;
+	}
+
+	/*!
+	* \brief Gets the profiling data of the calling thread, registering it on the first call
+	* \return Thread data
+	*/
+	Profiler::ThreadData* Profiler::GetThreadData()
+	{
+		struct ThreadDataHolder
+		{
+			~ThreadDataHolder()
+			{
+				if (data)
+					data->alive.store(false, std::memory_order_release);
+			}
+
+			ThreadData* data = nullptr;
+		};
+
+		thread_local ThreadDataHolder holder;
+		if (!holder.data)
+		{
+			ThreadRegistry& registry = GetRegistry();
+			LockGuard lock(registry.mutex);
+
+			registry.threads.emplace_back(new ThreadData(static_cast<unsigned int>(registry.threads.size() + 1)));
+			holder.data = registry.threads.back().get();
+		}
+
+		return holder.data;
+	}
+
+	/*!
+	* \class Nz::Profiler::Zone
+	* \brief Core class that times its own lifetime, see NazaraProfileZone
+	*/
+
+	/*!
+	* \brief Begins a zone if the profiler is enabled
+	*
+	* \param name Name of the zone, must outlive the profiler
+	*/
+	Profiler::Zone::Zone(const char* name) :
+	m_name(name),
+	m_thread(nullptr)
+	{
+		if (!s_enabled.load(std::memory_order_relaxed))
+			return;
+
+		m_thread = GetThreadData();
+		m_parent = m_thread->currentZone;
+		m_childTime = 0;
+
+		m_thread->currentZone = this;
+
+		m_beginTime = GetTimestamp();
+	}
+
+	/*!
+	* \brief Ends the zone and records it
+	*/
+	Profiler::Zone::~Zone()
+	{
+		if (!m_thread)
+			return;
+
+		UInt64 duration = GetTimestamp() - m_beginTime;
+
+		m_thread->currentZone = m_parent;
+		if (m_parent)
+			m_parent->m_childTime += duration;
+
+		m_thread->Record(m_name, m_beginTime, duration, duration - std::min(m_childTime, duration));
+	}
+}
@@ -0,0 +1,335 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ReadAheadStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/String.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::ReadAheadStream
+	* \brief Core class that decorates a readable stream and prefetches its next blocks on a background thread
+	*
+	* The I/O thread keeps up to blockCount blocks of blockSize bytes read ahead of the cursor, so sequential consumers
+	* only wait for the disk when they are faster than it. Seeking inside the prefetched window is free, seeking anywhere
+	* else discards the window and restarts prefetching from the new position.
+	*
+	* \remark The source must stay alive and must not be used by anything else while the ReadAheadStream exists
+	* \remark The size of the source is queried once, at construction
+	*/
+
+	/*!
+	* \brief Constructs a ReadAheadStream object reading from a source stream, starting at its current cursor position
+	*
+	* \param source Readable stream to prefetch
+	* \param blockSize Size of the reads done on the source
+	* \param blockCount Number of blocks to keep ahead of the cursor
+	*
+	* \remark Produces a NazaraAssert if source is not readable or blockSize/blockCount are zero
+	*/
+
+	ReadAheadStream::ReadAheadStream(Stream& source, std::size_t blockSize, unsigned int blockCount) :
+	Stream(source.GetStreamOptions(), OpenMode_ReadOnly),
+	m_source(source),
+	m_cursorPos(source.GetCursorPos()),
+	m_nextReadPos(m_cursorPos),
+	m_size(source.GetSize()),
+	m_blockSize(blockSize),
+	m_blockCount(blockCount),
+	m_generation(0),
+	m_running(true),
+	m_sourceEnded(false)
+	{
+		NazaraAssert(source.IsReadable(), "Source stream is not readable");
+		NazaraAssert(blockSize > 0, "Block size must be over zero");
+		NazaraAssert(blockCount > 0, "Block count must be over zero");
+
+		m_thread = Thread(&ReadAheadStream::IOThread, this);
+	}
+
+	/*!
+	* \brief Destructs the object, waiting for the pending read of the I/O thread to finish
+	*/
+
+	ReadAheadStream::~ReadAheadStream()
+	{
+		{
+			LockGuard lock(m_mutex);
+			m_running = false;
+		}
+
+		m_blockRequested.Signal();
+		m_thread.Join();
+	}
+
+	/*!
+	* \brief Checks whether the stream reached the end of the stream
+	* \return true if cursor is at the end of the stream
+	*/
+
+	bool ReadAheadStream::EndOfStream() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_cursorPos >= m_size;
+	}
+
+	/*!
+	* \brief Gets the position of the cursor
+	* \return Position of the cursor
+	*/
+
+	UInt64 ReadAheadStream::GetCursorPos() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_cursorPos;
+	}
+
+	/*!
+	* \brief Gets the directory of the source stream
+	* \return Directory of the source
+	*/
+
+	String ReadAheadStream::GetDirectory() const
+	{
+		return m_source.GetDirectory();
+	}
+
+	/*!
+	* \brief Gets the path of the source stream
+	* \return Path of the source
+	*/
+
+	String ReadAheadStream::GetPath() const
+	{
+		return m_source.GetPath();
+	}
+
+	/*!
+	* \brief Gets the size of the source stream
+	* \return Size of the source, as it was when this stream was constructed
+	*/
+
+	UInt64 ReadAheadStream::GetSize() const
+	{
+		return m_size;
+	}
+
+	/*!
+	* \brief Sets the position of the cursor
+	* \return true
+	*
+	* \param offset Offset according to the beginning of the stream
+	*
+	* \remark Moving outside of the prefetched window discards it
+	*/
+
+	bool ReadAheadStream::SetCursorPos(UInt64 offset)
+	{
+		LockGuard lock(m_mutex);
+
+		offset = std::min(offset, m_size);
+
+		UInt64 windowBegin = (m_blocks.empty()) ? m_nextReadPos : m_blocks.front().offset;
+		if (offset < windowBegin || offset > m_nextReadPos)
+		{
+			DiscardBlocks();
+
+			m_generation++; // Invalidates the read the I/O thread may be doing
+			m_nextReadPos = offset;
+			m_sourceEnded = false;
+		}
+
+		m_cursorPos = offset;
+		m_blockRequested.Signal();
+
+		return true;
+	}
+
+	/*!
+	* \brief Moves every block back to the free buffers
+	*
+	* \remark The mutex must be locked
+	*/
+
+	void ReadAheadStream::DiscardBlocks()
+	{
+		for (Block& block : m_blocks)
+			m_freeBuffers.emplace_back(std::move(block.data));
+
+		m_blocks.clear();
+	}
+
+	/*!
+	* \brief Finds the prefetched block containing an offset
+	* \return A pointer to the block or nullptr if this offset was not read yet
+	*
+	* \param offset Offset according to the beginning of the stream
+	*
+	* \remark The mutex must be locked
+	*/
+
+	auto ReadAheadStream::FindBlock(UInt64 offset) const -> const Block*
+	{
+		for (const Block& block : m_blocks)
+		{
+			if (offset >= block.offset && offset < block.offset + block.size)
+				return &block;
+		}
+
+		return nullptr;
+	}
+
+	/*!
+	* \brief Flushes the stream
+	*/
+
+	void ReadAheadStream::FlushStream()
+	{
+		// Nothing to do, the stream is read-only
+	}
+
+	/*!
+	* \brief Fills the read-ahead window, runs on the I/O thread
+	*/
+
+	void ReadAheadStream::IOThread()
+	{
+		Thread::SetCurrentThreadName("Nz ReadAhead");
+
+		LockGuard lock(m_mutex);
+
+		while (m_running)
+		{
+			UInt64 bytesAhead = (m_nextReadPos > m_cursorPos) ? m_nextReadPos - m_cursorPos : 0;
+			if (m_sourceEnded || bytesAhead >= UInt64(m_blockCount) * m_blockSize)
+			{
+				m_blockRequested.Wait(&m_mutex);
+				continue;
+			}
+
+			std::unique_ptr<UInt8[]> buffer;
+			if (!m_freeBuffers.empty())
+			{
+				buffer = std::move(m_freeBuffers.back());
+				m_freeBuffers.pop_back();
+			}
+			else
+				buffer.reset(new UInt8[m_blockSize]);
+
+			UInt64 offset = m_nextReadPos;
+			unsigned int generation = m_generation;
+
+			// The source is only ever used by this thread, the consumer can keep reading prefetched blocks meanwhile
+			lock.Unlock();
+
+			std::size_t readSize = 0;
+			if (m_source.GetCursorPos() == offset || m_source.SetCursorPos(offset))
+				readSize = m_source.Read(buffer.get(), m_blockSize);
+
+			lock.Lock();
+
+			if (generation != m_generation)
+			{
+				// The consumer seeked away while we were reading
+				m_freeBuffers.emplace_back(std::move(buffer));
+				continue;
+			}
+
+			if (readSize < m_blockSize)
+				m_sourceEnded = true;
+
+			if (readSize > 0)
+			{
+				// Keep the block before the cursor one around, for small backward seeks (as done by ReadLine)
+				while (m_blocks.size() > 1 && m_blocks[1].offset + m_blocks[1].size <= m_cursorPos)
+				{
+					m_freeBuffers.emplace_back(std::move(m_blocks.front().data));
+					m_blocks.pop_front();
+				}
+
+				Block block;
+				block.data = std::move(buffer);
+				block.offset = offset;
+				block.size = readSize;
+
+				m_blocks.emplace_back(std::move(block));
+				m_nextReadPos += readSize;
+			}
+			else
+				m_freeBuffers.emplace_back(std::move(buffer));
+
+			m_blockReady.SignalAll();
+		}
+	}
+
+	/*!
+	* \brief Reads blocks
+	* \return Number of blocks read
+	*
+	* \param buffer Preallocated buffer to contain information read, or nullptr to skip data
+	* \param size Size of the read and thus of the buffer
+	*
+	* \remark Waits for the I/O thread if the data is not prefetched yet
+	*/
+
+	std::size_t ReadAheadStream::ReadBlock(void* buffer, std::size_t size)
+	{
+		LockGuard lock(m_mutex);
+
+		if (!buffer)
+		{
+			UInt64 skipped = std::min<UInt64>(size, m_size - std::min(m_cursorPos, m_size));
+			lock.Unlock();
+
+			SetCursorPos(GetCursorPos() + skipped);
+			return static_cast<std::size_t>(skipped);
+		}
+
+		UInt8* ptr = static_cast<UInt8*>(buffer);
+
+		std::size_t readSize = 0;
+		while (readSize < size)
+		{
+			if (const Block* block = FindBlock(m_cursorPos))
+			{
+				std::size_t blockOffset = static_cast<std::size_t>(m_cursorPos - block->offset);
+				std::size_t copySize = std::min(size - readSize, block->size - blockOffset);
+				std::memcpy(&ptr[readSize], &block->data[blockOffset], copySize);
+
+				m_cursorPos += copySize;
+				readSize += copySize;
+
+				m_blockRequested.Signal();
+			}
+			else if (m_sourceEnded && m_cursorPos >= m_nextReadPos)
+				break;
+			else
+				m_blockReady.Wait(&m_mutex);
+		}
+
+		return readSize;
+	}
+
+	/*!
+	* \brief Writes blocks
+	* \return 0, the stream is read-only
+	*/
+
+	std::size_t ReadAheadStream::WriteBlock(const void* buffer, std::size_t size)
+	{
+		NazaraUnused(buffer);
+		NazaraUnused(size);
+
+		NazaraError("ReadAheadStream is read-only");
+		return 0;
+	}
+}
@@ -5,6 +5,8 @@
 #include <Nazara/Core/RefCounted.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <vector>
 
 #if NAZARA_CORE_THREADSAFE && NAZARA_THREADSAFETY_REFCOUNTED
 	#include <Nazara/Core/ThreadSafety.hpp>
@@ -16,21 +18,55 @@
 
 namespace Nz
 {
+	namespace
+	{
+		struct DeferredReleaseQueue
+		{
+			~DeferredReleaseQueue()
+			{
+				// Whatever was released by the thread is destroyed with it
+				RefCounted::FlushDeferredReleases();
+			}
+
+			std::vector<const RefCounted*> flushedObjects;
+			std::vector<const RefCounted*> pendingObjects;
+			bool enabled = false;
+		};
+
+		thread_local DeferredReleaseQueue t_deferredReleases;
+
+		void ForgetDeferredRelease(std::vector<const RefCounted*>& objects, const RefCounted* object)
+		{
+			auto it = std::find(objects.begin(), objects.end(), object);
+			if (it != objects.end())
+				*it = nullptr;
+		}
+	}
+
 	/*!
 	* \ingroup core
 	* \class Nz::RefCounted
 	* \brief Core class that represents a reference with a counter
+	*
+	* The counter is atomic by default, objects only shared within one thread can use RefCountingMode_SingleThreaded to skip atomic operations.
+	*
+	* Destruction of non-persistent objects normally happens as soon as their last reference is removed. A thread can instead enable deferred release,
+	* queuing those objects until FlushDeferredReleases is called, so destruction cascades happen at a controlled point (e.g. the end of a frame)
+	* instead of inside hot loops.
 	*/
 
 	/*!
 	* \brief Constructs a RefCounted object with a persistance aspect
 	*
 	* \param persistent if false, object is destroyed when no more referenced
+	* \param countingMode Whether references may be added and removed from any thread
 	*/
 
-	RefCounted::RefCounted(bool persistent) :
+	RefCounted::RefCounted(bool persistent, RefCountingMode countingMode) :
 	m_persistent(persistent),
-	m_referenceCount(0)
+	m_referenceCount(0),
+	m_releaseQueued(false),
+	m_singleThreaded(countingMode == RefCountingMode_SingleThreaded)
 	{
 	}
 
@@ -46,83 +82,133 @@ namespace Nz
 		if (m_referenceCount > 0)
 			NazaraWarning("Resource destroyed while still referenced " + String::Number(m_referenceCount) + " time(s)");
 		#endif
+
+		if (m_releaseQueued)
+		{
+			// Destroyed by hand while waiting for its deferred release
+			ForgetDeferredRelease(t_deferredReleases.pendingObjects, this);
+			ForgetDeferredRelease(t_deferredReleases.flushedObjects, this);
+		}
 	}
 
 	/*!
-	* \brief Adds a reference to the object
+	* \brief Sets the way references are counted
+	*
+	* \param countingMode Whether references may be added and removed from any thread
+	*
+	* \remark Must be done before the object is shared with other threads
 	*/
 
-	void RefCounted::AddReference() const
+	void RefCounted::SetCountingMode(RefCountingMode countingMode)
 	{
-		m_referenceCount++;
+		m_singleThreaded = (countingMode == RefCountingMode_SingleThreaded);
 	}
 
 	/*!
-	* \brief Gets the number of references to the object
-	* \return Number of references
+	* \brief Sets the persistence of the object
+	* \return true if object is deleted because no more referenced
+	*
+	* \param persistent Sets the persistence of the object
+	* \param checkReferenceCount Checks if the object should be destroyed if true
 	*/
 
-	unsigned int RefCounted::GetReferenceCount() const
+	bool RefCounted::SetPersistent(bool persistent, bool checkReferenceCount)
 	{
-		return m_referenceCount;
+		m_persistent = persistent;
+
+		if (checkReferenceCount && !persistent && m_referenceCount == 0)
+			return OnLastReferenceRemoved();
+		else
+			return false;
 	}
 
 	/*!
-	* \brief Checks whether the object is persistent
-	* \return true if object is not destroyed when no more referenced
+	* \brief Enables or disables deferred release for the calling thread
+	*
+	* \param enable Whether objects losing their last reference are queued instead of destroyed
+	*
+	* \remark Disabling it flushes the objects already queued
 	*/
 
-	bool RefCounted::IsPersistent() const
+	void RefCounted::EnableDeferredRelease(bool enable)
 	{
-		return m_persistent;
+		t_deferredReleases.enabled = enable;
+
+		if (!enable)
+			FlushDeferredReleases();
 	}
 
 	/*!
-	* \brief Removes a reference to the object
-	* \return true if object is deleted because no more referenced
+	* \brief Destroys the objects queued by deferred release on the calling thread
+	* \return Number of destroyed objects
 	*
-	* \remark Produces a NazaraError if counter is already 0 with NAZARA_CORE_SAFE defined
+	* Objects released during the flush (by the destructor of another one) are destroyed as well,
+	* objects referenced again since they were queued are kept alive.
 	*/
 
-	bool RefCounted::RemoveReference() const
+	std::size_t RefCounted::FlushDeferredReleases()
 	{
-		#if NAZARA_CORE_SAFE
-		if (m_referenceCount == 0)
+		DeferredReleaseQueue& queue = t_deferredReleases;
+
+		std::size_t destroyedCount = 0;
+		while (!queue.pendingObjects.empty())
 		{
-			NazaraError("Impossible to remove reference (Ref. counter is already 0)");
-			return false;
+			// Destructors may queue other objects, work on a separate list
+			std::swap(queue.flushedObjects, queue.pendingObjects);
+
+			for (std::size_t i = 0; i < queue.flushedObjects.size(); ++i)
+			{
+				const RefCounted* object = queue.flushedObjects[i];
+				if (!object)
+					continue; // Destroyed meanwhile
+
+				queue.flushedObjects[i] = nullptr;
+				object->m_releaseQueued = false;
+
+				if (object->GetReferenceCount() == 0 && !object->IsPersistent())
+				{
+					delete object;
+					destroyedCount++;
+				}
+			}
+
+			queue.flushedObjects.clear();
 		}
-		#endif
 
-		if (--m_referenceCount == 0 && !m_persistent)
-		{
-			delete this; // Suicide
+		return destroyedCount;
+	}
 
-			return true;
-		}
-		else
-			return false;
+	/*!
+	* \brief Checks whether deferred release is enabled for the calling thread
+	* \return true if objects losing their last reference are queued instead of destroyed
+	*/
+
+	bool RefCounted::IsDeferredReleaseEnabled()
+	{
+		return t_deferredReleases.enabled;
 	}
 
 	/*!
-	* \brief Sets the persistence of the object
-	* \return true if object is deleted because no more referenced
-	*
-	* \param persistent Sets the persistence of the object
-	* \param checkReferenceCount Checks if the object should be destroyed if true
+	* \brief Destroys or queues the object, once its last reference is removed
+	* \return true if object is deleted
 	*/
 
-	bool RefCounted::SetPersistent(bool persistent, bool checkReferenceCount)
+	bool RefCounted::OnLastReferenceRemoved() const
 	{
-		m_persistent = persistent;
+		if (m_releaseQueued)
+			return false; // Referenced again since it was queued, the queue keeps the responsibility of its destruction
 
-		if (checkReferenceCount && !persistent && m_referenceCount == 0)
+		DeferredReleaseQueue& queue = t_deferredReleases;
+		if (queue.enabled)
 		{
-			delete this;
+			m_releaseQueued = true;
+			queue.pendingObjects.push_back(this);
 
-			return true;
-		}
-		else
 			return false;
+		}
+
+		delete this; // Suicide
+
+		return true;
 	}
 }
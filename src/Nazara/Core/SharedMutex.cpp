@@ -0,0 +1,133 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/Error.hpp>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+	#include <Nazara/Core/Win32/SharedMutexImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+	#include <Nazara/Core/Posix/SharedMutexImpl.hpp>
+#else
+	#error Lack of implementation: SharedMutex
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::SharedMutex
+	* \brief Core class that represents a reader-writer lock
+	*
+	* Any number of threads may own the mutex in shared mode (to read) as long as no thread owns it in exclusive mode (to write).
+	* Waiting writers have priority over new readers where the system allows it, so that writers are not starved.
+	*
+	* \remark Unlike Mutex, the mutex is not recursive: a thread must not lock it again, in any mode, while owning it
+	* \remark Without NAZARA_CORE_WINDOWS_VISTA, the Windows implementation serializes readers
+	*
+	* \see ExclusiveLockGuard
+	* \see SharedLockGuard
+	*/
+
+	/*!
+	* \brief Constructs a SharedMutex object by default
+	*/
+
+	SharedMutex::SharedMutex()
+	{
+		m_impl = new SharedMutexImpl;
+	}
+
+	/*!
+	* \brief Destructs the object
+	*/
+
+	SharedMutex::~SharedMutex()
+	{
+		delete m_impl;
+	}
+
+	/*!
+	* \brief Locks the mutex in exclusive mode
+	*
+	* Blocks until no other thread owns the mutex, in any mode
+	*/
+
+	void SharedMutex::Lock()
+	{
+		NazaraAssert(m_impl, "Cannot lock a moved mutex");
+		m_impl->Lock();
+	}
+
+	/*!
+	* \brief Locks the mutex in shared mode
+	*
+	* Blocks until no thread owns the mutex in exclusive mode
+	*/
+
+	void SharedMutex::LockShared()
+	{
+		NazaraAssert(m_impl, "Cannot lock a moved mutex");
+		m_impl->LockShared();
+	}
+
+	/*!
+	* \brief Tries to lock the mutex in exclusive mode
+	* \return true if the lock was acquired successfully
+	*/
+
+	bool SharedMutex::TryLock()
+	{
+		NazaraAssert(m_impl, "Cannot lock a moved mutex");
+		return m_impl->TryLock();
+	}
+
+	/*!
+	* \brief Tries to lock the mutex in shared mode
+	* \return true if the lock was acquired successfully
+	*/
+
+	bool SharedMutex::TryLockShared()
+	{
+		NazaraAssert(m_impl, "Cannot lock a moved mutex");
+		return m_impl->TryLockShared();
+	}
+
+	/*!
+	* \brief Unlocks the mutex previously locked in exclusive mode
+	*/
+
+	void SharedMutex::Unlock()
+	{
+		NazaraAssert(m_impl, "Cannot unlock a moved mutex");
+		m_impl->Unlock();
+	}
+
+	/*!
+	* \brief Unlocks the mutex previously locked in shared mode
+	*/
+
+	void SharedMutex::UnlockShared()
+	{
+		NazaraAssert(m_impl, "Cannot unlock a moved mutex");
+		m_impl->UnlockShared();
+	}
+
+	/*!
+	* \brief Moves a mutex to another mutex object
+	* \return A reference to the object
+	*/
+
+	SharedMutex& SharedMutex::operator=(SharedMutex&& mutex) noexcept
+	{
+		delete m_impl;
+
+		m_impl = mutex.m_impl;
+		mutex.m_impl = nullptr;
+
+		return *this;
+	}
+}
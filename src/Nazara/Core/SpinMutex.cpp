@@ -0,0 +1,106 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/SpinMutex.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <algorithm>
+#include <thread>
+
+#if defined(NAZARA_COMPILER_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+	#include <intrin.h>
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		/*!
+		* \brief Hints the processor that the thread is spinning
+		*/
+
+		inline void CpuRelax()
+		{
+			#if defined(NAZARA_COMPILER_MSVC) && (defined(_M_IX86) || defined(_M_X64))
+			_mm_pause();
+			#elif (defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_INTEL)) && (defined(__i386__) || defined(__x86_64__))
+			__builtin_ia32_pause();
+			#else
+			std::this_thread::yield();
+			#endif
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::SpinMutex
+	* \brief Core class that represents a mutex spinning before blocking, for very short critical sections
+	*
+	* Locking and unlocking an uncontended SpinMutex are a single atomic operation, without system call.
+	* A thread finding the mutex locked spins for a while, hoping the owner releases it soon, and then blocks.
+	*
+	* The spin duration adapts itself: it is based on the average number of spins which were needed to acquire the mutex, so that
+	* threads stop wasting processor time on a mutex held for long and keep spinning on a mutex held for a few instructions.
+	*
+	* \remark The mutex is not recursive
+	*
+	* \see SpinLockGuard
+	*/
+
+	/*!
+	* \brief Constructs a SpinMutex object by default
+	*/
+
+	SpinMutex::SpinMutex() :
+	m_state(State_Unlocked),
+	m_averageSpinCount(0)
+	{
+	}
+
+	/*!
+	* \brief Acquires the mutex after a failed attempt, spinning then blocking
+	*/
+
+	void SpinMutex::LockSlow()
+	{
+		int averageSpinCount = m_averageSpinCount.load(std::memory_order_relaxed);
+		int maxSpinCount = std::min(MaxSpinCount, averageSpinCount * 2 + 10);
+
+		for (int spinCount = 1; spinCount <= maxSpinCount; ++spinCount)
+		{
+			CpuRelax();
+
+			if (m_state.load(std::memory_order_relaxed) == State_Unlocked && TryLock())
+			{
+				m_averageSpinCount.store(averageSpinCount + (spinCount - averageSpinCount) / 8, std::memory_order_relaxed);
+				return;
+			}
+		}
+
+		m_averageSpinCount.store(averageSpinCount + (maxSpinCount - averageSpinCount) / 8, std::memory_order_relaxed);
+
+		// Announces we are waiting, the owner will wake a thread up when unlocking
+		while (m_state.exchange(State_LockedWithWaiters, std::memory_order_acquire) != State_Unlocked)
+		{
+			LockGuard lock(m_parkMutex);
+
+			// Checked under the park mutex, the owner cannot signal between this check and the wait
+			if (m_state.load(std::memory_order_relaxed) == State_LockedWithWaiters)
+				m_parkCondition.Wait(&m_parkMutex);
+		}
+	}
+
+	/*!
+	* \brief Wakes up one of the threads blocked on the mutex
+	*/
+
+	void SpinMutex::WakeWaiter()
+	{
+		LockGuard lock(m_parkMutex);
+		m_parkCondition.Signal();
+	}
+
+	constexpr int SpinMutex::MaxSpinCount;
+}
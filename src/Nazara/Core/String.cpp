@@ -8,6 +8,7 @@
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/StringView.hpp>
 #include <Nazara/Core/Unicode.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <algorithm>
@@ -215,6 +216,17 @@ namespace Nz
 	{
 	}
 
+	/*!
+	* \brief Constructs a String object which is a copy of the characters referenced by a view
+	*
+	* \param string View to copy
+	*/
+
+	String::String(const StringView& string) :
+	String(string.GetConstBuffer(), string.GetSize())
+	{
+	}
+
 	/*!
 	* \brief Appends the character to the string
 	* \return A reference to this
@@ -2158,9 +2170,17 @@ namespace Nz
 			return std::u32string();
 
 		std::u32string str;
-		str.reserve(m_sharedString->size);
-
-		utf8::utf8to32(begin(), end(), std::back_inserter(str));
+		if (Unicode::IsValidUtf8(m_sharedString->string.get(), m_sharedString->size))
+		{
+			// A code point takes at least one byte
+			str.resize(m_sharedString->size);
+			str.resize(Unicode::Utf8ToUtf32(m_sharedString->string.get(), m_sharedString->size, &str[0]));
+		}
+		else
+		{
+			str.reserve(m_sharedString->size);
+			utf8::utf8to32(begin(), end(), std::back_inserter(str));
+		}
 
 		return str;
 	}
@@ -2180,7 +2200,15 @@ namespace Nz
 		str.reserve(m_sharedString->size);
 
 		if (sizeof(wchar_t) == 4) // I want a static_if :(
-			utf8::utf8to32(begin(), end(), std::back_inserter(str));
+		{
+			if (Unicode::IsValidUtf8(m_sharedString->string.get(), m_sharedString->size))
+			{
+				str.resize(m_sharedString->size);
+				str.resize(Unicode::Utf8ToUtf32(m_sharedString->string.get(), m_sharedString->size, reinterpret_cast<char32_t*>(&str[0])));
+			}
+			else
+				utf8::utf8to32(begin(), end(), std::back_inserter(str));
+		}
 		else
 		{
 			utf8::unchecked::iterator<const char*> it(m_sharedString->string.get());
@@ -2486,6 +2514,18 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Checks whether the string is valid UTF-8
+	* \return true if the string only holds complete, shortest form UTF-8 sequences
+	*
+	* \see Unicode::IsValidUtf8
+	*/
+
+	bool String::IsValidUtf8() const
+	{
+		return Unicode::IsValidUtf8(m_sharedString->string.get(), m_sharedString->size);
+	}
+
 	/*!
 	* \brief Checks whether the string matches the pattern
 	* \return true if string matches
@@ -3363,6 +3403,18 @@ namespace Nz
 		return Set(string.data(), string.size());
 	}
 
+	/*!
+	* \brief Sets the string with the characters referenced by a view
+	* \return A reference to this
+	*
+	* \param string View to copy
+	*/
+
+	String& String::Set(const StringView& string)
+	{
+		return Set(string.GetConstBuffer(), string.GetSize());
+	}
+
 	/*!
 	* \brief Sets the string with other string
 	* \return A reference to this
@@ -3456,6 +3508,7 @@ namespace Nz
 			p--;
 
 		*p = '\0';
+		newString->size = p - str;
 
 		return String(std::move(newString));
 	}
@@ -3469,7 +3522,45 @@ namespace Nz
 
 	String& String::Simplify(UInt32 flags)
 	{
-		return Set(Simplified(flags));
+		// Multi-byte separators could be overwritten before being skipped, only single-byte simplification is done in place
+		if (flags & HandleUtf8)
+			return Set(Simplified(flags));
+
+		if (m_sharedString->size == 0)
+			return *this;
+
+		// Simplifying never makes the string longer, the characters can be moved in place
+		EnsureOwnership();
+
+		char* str = m_sharedString->string.get();
+		char* p = str;
+		bool inword = false;
+
+		const char* limit = &str[m_sharedString->size];
+		for (const char* ptr = str; ptr != limit; ++ptr)
+		{
+			if (Unicode::GetCategory(*ptr) & Unicode::Category_Separator)
+			{
+				if (inword)
+				{
+					*p++ = ' ';
+					inword = false;
+				}
+			}
+			else
+			{
+				*p++ = *ptr;
+				inword = true;
+			}
+		}
+
+		if (!inword && p != str)
+			p--;
+
+		*p = '\0';
+		m_sharedString->size = p - str;
+
+		return *this;
 	}
 
 	/*!
@@ -3598,6 +3689,40 @@ namespace Nz
 		return Split(result, separation.m_sharedString->string.get(), separation.m_sharedString->size, start, flags);
 	}
 
+	/*!
+	* \brief Splits the string into views referencing its characters
+	* \return The number of splits
+	*
+	* \param result Resulting tokens, valid as long as the string is not modified
+	* \param separation Separation character
+	* \param start Index for the beginning of the search
+	* \param flags Flag for the look up
+	*
+	* \remark Unlike the String overloads, this does not allocate any string
+	*/
+
+	unsigned int String::Split(std::vector<StringView>& result, char separation, std::intmax_t start, UInt32 flags) const
+	{
+		return StringView(*this).Split(result, separation, start, flags);
+	}
+
+	/*!
+	* \brief Splits the string into views referencing its characters
+	* \return The number of splits
+	*
+	* \param result Resulting tokens, valid as long as the string is not modified
+	* \param separation Separation string
+	* \param start Index for the beginning of the search
+	* \param flags Flag for the look up
+	*
+	* \remark Unlike the String overloads, this does not allocate any string
+	*/
+
+	unsigned int String::Split(std::vector<StringView>& result, const StringView& separation, std::intmax_t start, UInt32 flags) const
+	{
+		return StringView(*this).Split(result, separation, start, flags);
+	}
+
 	/*!
 	* \brief Splits the string into others
 	* \return The number of splits
@@ -3654,6 +3779,23 @@ namespace Nz
 		return SplitAny(result, separations.m_sharedString->string.get(), start, flags);
 	}
 
+	/*!
+	* \brief Splits the string into views referencing its characters
+	* \return The number of splits
+	*
+	* \param result Resulting tokens, valid as long as the string is not modified
+	* \param separations List of characters of separation
+	* \param start Index for the beginning of the search
+	* \param flags Flag for the look up
+	*
+	* \remark Unlike the String overloads, this does not allocate any string
+	*/
+
+	unsigned int String::SplitAny(std::vector<StringView>& result, const StringView& separations, std::intmax_t start, UInt32 flags) const
+	{
+		return StringView(*this).SplitAny(result, separations, start, flags);
+	}
+
 	/*!
 	* \brief Checks whether the string begins with the character
 	* \return true if it the case
@@ -5897,6 +6039,7 @@ namespace Nz
 	}
 
 	const std::size_t String::npos(std::numeric_limits<std::size_t>::max());
+	constexpr std::size_t String::SharedString::SmallStringCapacity;
 }
 
 namespace std
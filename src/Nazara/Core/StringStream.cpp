@@ -1,4 +1,3 @@
-#include "..\..\..\include\Nazara\Core\StringStream.hpp"
 // Copyright (C) 2015 Jérôme Leclercq
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
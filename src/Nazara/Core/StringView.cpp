@@ -0,0 +1,719 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/StringView.hpp>
+#include <Nazara/Core/Unicode.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		inline bool IsSeparator(char character)
+		{
+			return (Unicode::GetCategory(character) & Unicode::Category_Separator) != 0;
+		}
+
+		inline char ToLower(char character)
+		{
+			if (character >= 'A' && character <= 'Z')
+				return character + ('a' - 'A');
+			else
+				return character;
+		}
+
+		inline bool CompareCharacters(const char* first, const char* second, std::size_t length, UInt32 flags)
+		{
+			if (flags & String::CaseInsensitive)
+			{
+				for (std::size_t i = 0; i < length; ++i)
+				{
+					if (ToLower(first[i]) != ToLower(second[i]))
+						return false;
+				}
+
+				return true;
+			}
+			else
+				return std::memcmp(first, second, length) == 0;
+		}
+
+		inline std::size_t GetStartPosition(std::intmax_t start, std::size_t size)
+		{
+			if (start < 0)
+				return (static_cast<std::size_t>(-start) > size) ? 0 : size - static_cast<std::size_t>(-start);
+			else
+				return static_cast<std::size_t>(start);
+		}
+	}
+
+	/*!
+	* \brief Checks whether the view ends with the character
+	* \return true if it is the case
+	*
+	* \param character Single character
+	* \param flags Flag for the look up
+	*/
+
+	bool StringView::EndsWith(char character, UInt32 flags) const
+	{
+		if (m_size == 0)
+			return false;
+
+		return CompareCharacters(&m_string[m_size - 1], &character, 1, flags);
+	}
+
+	/*!
+	* \brief Checks whether the view ends with the string
+	* \return true if it is the case
+	*
+	* \param string String to match
+	* \param flags Flag for the look up
+	*/
+
+	bool StringView::EndsWith(StringView string, UInt32 flags) const
+	{
+		if (string.m_size == 0 || string.m_size > m_size)
+			return false;
+
+		return CompareCharacters(&m_string[m_size - string.m_size], string.m_string, string.m_size, flags);
+	}
+
+	/*!
+	* \brief Checks whether the view references the same characters as another
+	* \return true if both views have the same content
+	*
+	* \param string View to compare with
+	* \param flags Flag for the comparison
+	*/
+
+	bool StringView::Equals(StringView string, UInt32 flags) const
+	{
+		if (m_size != string.m_size)
+			return false;
+
+		return CompareCharacters(m_string, string.m_string, m_size, flags);
+	}
+
+	/*!
+	* \brief Finds the first index of the character in the view
+	* \return Index in the view or npos
+	*
+	* \param character Single character
+	* \param start Index to begin the search, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	std::size_t StringView::Find(char character, std::intmax_t start, UInt32 flags) const
+	{
+		for (std::size_t pos = GetStartPosition(start, m_size); pos < m_size; ++pos)
+		{
+			if (CompareCharacters(&m_string[pos], &character, 1, flags))
+				return pos;
+		}
+
+		return npos;
+	}
+
+	/*!
+	* \brief Finds the first index of the string in the view
+	* \return Index in the view or npos
+	*
+	* \param string String to match
+	* \param start Index to begin the search, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	std::size_t StringView::Find(StringView string, std::intmax_t start, UInt32 flags) const
+	{
+		if (string.m_size == 0 || string.m_size > m_size)
+			return npos;
+
+		std::size_t lastPos = m_size - string.m_size;
+		for (std::size_t pos = GetStartPosition(start, m_size); pos <= lastPos; ++pos)
+		{
+			if (CompareCharacters(&m_string[pos], string.m_string, string.m_size, flags))
+				return pos;
+		}
+
+		return npos;
+	}
+
+	/*!
+	* \brief Finds the first index of any of the characters in the view
+	* \return Index in the view or npos
+	*
+	* \param characters Characters to match
+	* \param start Index to begin the search, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	std::size_t StringView::FindAny(StringView characters, std::intmax_t start, UInt32 flags) const
+	{
+		for (std::size_t pos = GetStartPosition(start, m_size); pos < m_size; ++pos)
+		{
+			for (char character : characters)
+			{
+				if (CompareCharacters(&m_string[pos], &character, 1, flags))
+					return pos;
+			}
+		}
+
+		return npos;
+	}
+
+	/*!
+	* \brief Finds the last index of the character in the view
+	* \return Index in the view or npos
+	*
+	* \param character Single character
+	* \param start Index to begin the backward search, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	std::size_t StringView::FindLast(char character, std::intmax_t start, UInt32 flags) const
+	{
+		if (m_size == 0)
+			return npos;
+
+		std::size_t pos = std::min(GetStartPosition(start, m_size), m_size - 1);
+		if (start < 0 && static_cast<std::size_t>(-start) > m_size)
+			return npos;
+
+		for (;;)
+		{
+			if (CompareCharacters(&m_string[pos], &character, 1, flags))
+				return pos;
+
+			if (pos-- == 0)
+				return npos;
+		}
+	}
+
+	/*!
+	* \brief Gets a word of the view
+	* \return View of the word, empty if there is no such word
+	*
+	* \param index Index of the word, words being separated by blanks
+	*/
+
+	StringView StringView::GetWord(unsigned int index) const
+	{
+		std::size_t startPos = GetWordPosition(index);
+		if (startPos == npos)
+			return StringView();
+
+		std::size_t endPos = startPos;
+		while (endPos < m_size && !IsSeparator(m_string[endPos]))
+			endPos++;
+
+		return StringView(&m_string[startPos], endPos - startPos);
+	}
+
+	/*!
+	* \brief Gets the position of a word in the view
+	* \return Position of the first character of the word or npos
+	*
+	* \param index Index of the word, words being separated by blanks
+	*/
+
+	std::size_t StringView::GetWordPosition(unsigned int index) const
+	{
+		unsigned int currentWord = 0;
+		bool inWord = false;
+
+		for (std::size_t pos = 0; pos < m_size; ++pos)
+		{
+			if (IsSeparator(m_string[pos]))
+				inWord = false;
+			else if (!inWord)
+			{
+				inWord = true;
+				if (++currentWord > index)
+					return pos;
+			}
+		}
+
+		return npos;
+	}
+
+	/*!
+	* \brief Splits the view into tokens referencing the same characters
+	* \return The number of tokens in result
+	*
+	* \param result Vector to append the tokens to, empty tokens are skipped
+	* \param separation Separation character
+	* \param start Index to begin the split, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	unsigned int StringView::Split(std::vector<StringView>& result, char separation, std::intmax_t start, UInt32 flags) const
+	{
+		return Split(result, StringView(&separation, 1), start, flags);
+	}
+
+	/*!
+	* \brief Splits the view into tokens referencing the same characters
+	* \return The number of tokens in result
+	*
+	* \param result Vector to append the tokens to, empty tokens are skipped
+	* \param separation Separation string
+	* \param start Index to begin the split, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	unsigned int StringView::Split(std::vector<StringView>& result, StringView separation, std::intmax_t start, UInt32 flags) const
+	{
+		if (separation.IsEmpty() || m_size == 0)
+			return static_cast<unsigned int>(result.size());
+
+		std::size_t tokenStart = GetStartPosition(start, m_size);
+		while (tokenStart < m_size)
+		{
+			std::size_t sep = Find(separation, tokenStart, flags);
+			std::size_t tokenEnd = (sep == npos) ? m_size : sep;
+
+			if (tokenEnd > tokenStart)
+				result.emplace_back(&m_string[tokenStart], tokenEnd - tokenStart);
+
+			if (sep == npos)
+				break;
+
+			tokenStart = sep + separation.m_size;
+		}
+
+		return static_cast<unsigned int>(result.size());
+	}
+
+	/*!
+	* \brief Splits the view into tokens referencing the same characters, using any of the separations
+	* \return The number of tokens in result
+	*
+	* \param result Vector to append the tokens to, empty tokens are skipped
+	* \param separations Separation characters
+	* \param start Index to begin the split, negative values are relative to the end
+	* \param flags Flag for the look up
+	*/
+
+	unsigned int StringView::SplitAny(std::vector<StringView>& result, StringView separations, std::intmax_t start, UInt32 flags) const
+	{
+		if (separations.IsEmpty() || m_size == 0)
+			return static_cast<unsigned int>(result.size());
+
+		std::size_t tokenStart = GetStartPosition(start, m_size);
+		while (tokenStart < m_size)
+		{
+			std::size_t sep = FindAny(separations, tokenStart, flags);
+			std::size_t tokenEnd = (sep == npos) ? m_size : sep;
+
+			if (tokenEnd > tokenStart)
+				result.emplace_back(&m_string[tokenStart], tokenEnd - tokenStart);
+
+			if (sep == npos)
+				break;
+
+			tokenStart = sep + 1;
+		}
+
+		return static_cast<unsigned int>(result.size());
+	}
+
+	/*!
+	* \brief Checks whether the view starts with the character
+	* \return true if it is the case
+	*
+	* \param character Single character
+	* \param flags Flag for the look up
+	*/
+
+	bool StringView::StartsWith(char character, UInt32 flags) const
+	{
+		if (m_size == 0)
+			return false;
+
+		return CompareCharacters(m_string, &character, 1, flags);
+	}
+
+	/*!
+	* \brief Checks whether the view starts with the string
+	* \return true if it is the case
+	*
+	* \param string String to match
+	* \param flags Flag for the look up
+	*/
+
+	bool StringView::StartsWith(StringView string, UInt32 flags) const
+	{
+		if (string.m_size == 0 || string.m_size > m_size)
+			return false;
+
+		return CompareCharacters(m_string, string.m_string, string.m_size, flags);
+	}
+
+	/*!
+	* \brief Returns a part of the view
+	* \return View of the characters between the two positions
+	*
+	* \param startPos Index of the first character, negative values are relative to the end
+	* \param endPos Index of the last character (included), negative values are relative to the end
+	*/
+
+	StringView StringView::SubString(std::intmax_t startPos, std::intmax_t endPos) const
+	{
+		if (m_size == 0)
+			return StringView();
+
+		std::size_t start = GetStartPosition(startPos, m_size);
+
+		if (endPos < 0)
+		{
+			endPos = static_cast<std::intmax_t>(m_size) + endPos;
+			if (endPos < 0)
+				return StringView();
+		}
+
+		std::size_t minEnd = std::min(static_cast<std::size_t>(endPos), m_size - 1);
+		if (start > minEnd)
+			return StringView();
+
+		return StringView(&m_string[start], minEnd - start + 1);
+	}
+
+	/*!
+	* \brief Returns the part of the view starting from a string
+	* \return View starting after the string (or from it, if included), empty if the string is not found
+	*
+	* \param string Pattern to find
+	* \param startPos Index to begin the search
+	* \param fromLast Only search for the last occurrence
+	* \param include Include the pattern
+	* \param flags Flag for the look up
+	*/
+
+	StringView StringView::SubStringFrom(StringView string, std::intmax_t startPos, bool fromLast, bool include, UInt32 flags) const
+	{
+		std::size_t pos = Find(string, startPos, flags);
+		if (pos == npos)
+			return StringView();
+
+		if (fromLast)
+		{
+			for (;;)
+			{
+				std::size_t nextPos = Find(string, pos + 1, flags);
+				if (nextPos == npos)
+					break;
+
+				pos = nextPos;
+			}
+		}
+
+		return SubString(pos + ((include) ? 0 : string.m_size));
+	}
+
+	/*!
+	* \brief Returns the part of the view up to a string
+	* \return View ending before the string (or after it, if included), the whole view if the string is not found
+	*
+	* \param string Pattern to find
+	* \param startPos Index to begin the search
+	* \param toLast Search for the last occurrence
+	* \param include Include the pattern
+	* \param flags Flag for the look up
+	*/
+
+	StringView StringView::SubStringTo(StringView string, std::intmax_t startPos, bool toLast, bool include, UInt32 flags) const
+	{
+		std::size_t pos = Find(string, startPos, flags);
+		if (pos == npos)
+			return *this;
+
+		if (toLast)
+		{
+			for (;;)
+			{
+				std::size_t nextPos = Find(string, pos + 1, flags);
+				if (nextPos == npos)
+					break;
+
+				pos = nextPos;
+			}
+		}
+
+		return StringView(m_string, pos + ((include) ? string.m_size : 0));
+	}
+
+	/*!
+	* \brief Converts the view to boolean
+	* \return true if successful
+	*
+	* \param value Boolean to fill, may be nullptr
+	* \param flags Flag for the look up
+	*
+	* \see String::ToBool
+	*/
+
+	bool StringView::ToBool(bool* value, UInt32 flags) const
+	{
+		StringView word = GetWord(0);
+		if (word.IsEmpty())
+			return false;
+
+		bool result;
+		if (word[0] == '1')
+			result = true;
+		else if (word[0] == '0')
+			result = false;
+		else if (word.Equals("true", flags))
+			result = true;
+		else if (word.Equals("false", flags))
+			result = false;
+		else
+			return false;
+
+		if (value)
+			*value = result;
+
+		return true;
+	}
+
+	/*!
+	* \brief Converts the view to double
+	* \return true if successful
+	*
+	* \param value Double to fill, may be nullptr
+	*
+	* \remark Unlike String::ToDouble, this fails if the view does not start with a number
+	*/
+
+	bool StringView::ToDouble(double* value) const
+	{
+		// strtod requires a null-terminated string, numbers are short enough to be copied on the stack
+		char buffer[64];
+
+		StringView trimmed = Trimmed();
+		if (trimmed.IsEmpty() || trimmed.m_size >= sizeof(buffer))
+			return false;
+
+		std::memcpy(buffer, trimmed.m_string, trimmed.m_size);
+		buffer[trimmed.m_size] = '\0';
+
+		char* end;
+		double result = std::strtod(buffer, &end);
+		if (end == buffer)
+			return false;
+
+		if (value)
+			*value = result;
+
+		return true;
+	}
+
+	/*!
+	* \brief Converts the view to integer
+	* \return true if successful
+	*
+	* \param value Integer to fill, may be nullptr
+	* \param radix Base of the number, between 2 and 36
+	*
+	* \remark Leading and trailing blanks are ignored
+	*/
+
+	bool StringView::ToInteger(long long* value, UInt8 radix) const
+	{
+		NazaraAssert(radix >= 2 && radix <= 36, "Radix must be between 2 and 36");
+
+		StringView trimmed = Trimmed();
+		if (trimmed.IsEmpty())
+			return false;
+
+		std::size_t pos = 0;
+		bool negative = false;
+		if (trimmed[0] == '-' || trimmed[0] == '+')
+		{
+			negative = (trimmed[0] == '-');
+			if (++pos == trimmed.m_size)
+				return false;
+		}
+
+		unsigned long long total = 0;
+		for (; pos < trimmed.m_size; ++pos)
+		{
+			char c = trimmed[pos];
+
+			unsigned int digit;
+			if (c >= '0' && c <= '9')
+				digit = c - '0';
+			else if (c >= 'a' && c <= 'z')
+				digit = c - 'a' + 10;
+			else if (c >= 'A' && c <= 'Z')
+				digit = c - 'A' + 10;
+			else
+				return false;
+
+			if (digit >= radix)
+				return false;
+
+			total = total * radix + digit;
+		}
+
+		if (value)
+			*value = (negative) ? -static_cast<long long>(total) : static_cast<long long>(total);
+
+		return true;
+	}
+
+	/*!
+	* \brief Copies the referenced characters into a String
+	* \return String holding a copy of the characters
+	*/
+
+	String StringView::ToString() const
+	{
+		return String(m_string, m_size);
+	}
+
+	/*!
+	* \brief Removes the blanks at the extremities of the view
+	* \return A reference to this
+	*
+	* \param flags Flag for the look up (String::TrimOnlyLeft or String::TrimOnlyRight)
+	*/
+
+	StringView& StringView::Trim(UInt32 flags)
+	{
+		return *this = Trimmed(flags);
+	}
+
+	/*!
+	* \brief Removes a character at the extremities of the view
+	* \return A reference to this
+	*
+	* \param character Character to remove
+	* \param flags Flag for the look up
+	*/
+
+	StringView& StringView::Trim(char character, UInt32 flags)
+	{
+		return *this = Trimmed(character, flags);
+	}
+
+	/*!
+	* \brief Gets the view without the blanks at its extremities
+	* \return Trimmed view
+	*
+	* \param flags Flag for the look up (String::TrimOnlyLeft or String::TrimOnlyRight)
+	*/
+
+	StringView StringView::Trimmed(UInt32 flags) const
+	{
+		std::size_t startPos = 0;
+		std::size_t endPos = m_size;
+
+		if ((flags & String::TrimOnlyRight) == 0)
+		{
+			while (startPos < endPos && (m_string[startPos] == '\t' || IsSeparator(m_string[startPos])))
+				startPos++;
+		}
+
+		if ((flags & String::TrimOnlyLeft) == 0)
+		{
+			while (endPos > startPos && (m_string[endPos - 1] == '\t' || IsSeparator(m_string[endPos - 1])))
+				endPos--;
+		}
+
+		return StringView(&m_string[startPos], endPos - startPos);
+	}
+
+	/*!
+	* \brief Gets the view without a character at its extremities
+	* \return Trimmed view
+	*
+	* \param character Character to remove
+	* \param flags Flag for the look up
+	*/
+
+	StringView StringView::Trimmed(char character, UInt32 flags) const
+	{
+		std::size_t startPos = 0;
+		std::size_t endPos = m_size;
+
+		if ((flags & String::TrimOnlyRight) == 0)
+		{
+			while (startPos < endPos && CompareCharacters(&m_string[startPos], &character, 1, flags))
+				startPos++;
+		}
+
+		if ((flags & String::TrimOnlyLeft) == 0)
+		{
+			while (endPos > startPos && CompareCharacters(&m_string[endPos - 1], &character, 1, flags))
+				endPos--;
+		}
+
+		return StringView(&m_string[startPos], endPos - startPos);
+	}
+
+	/*!
+	* \brief Checks whether two views reference the same characters
+	* \return true if it is the case
+	*
+	* \param first First view
+	* \param second Second view
+	*/
+
+	bool operator==(const StringView& first, const StringView& second)
+	{
+		return first.Equals(second);
+	}
+
+	/*!
+	* \brief Checks whether two views reference different characters
+	* \return false if it is the case
+	*
+	* \param first First view
+	* \param second Second view
+	*/
+
+	bool operator!=(const StringView& first, const StringView& second)
+	{
+		return !first.Equals(second);
+	}
+
+	/*!
+	* \brief Checks whether the first view is lexicographically less than the second
+	* \return true if it is the case
+	*
+	* \param first First view
+	* \param second Second view
+	*/
+
+	bool operator<(const StringView& first, const StringView& second)
+	{
+		int result = std::memcmp(first.m_string, second.m_string, std::min(first.m_size, second.m_size));
+		if (result != 0)
+			return result < 0;
+
+		return first.m_size < second.m_size;
+	}
+
+	/*!
+	* \brief Output operator
+	* \return The stream
+	*
+	* \param out The stream
+	* \param string The view to output
+	*/
+
+	std::ostream& operator<<(std::ostream& out, const StringView& string)
+	{
+		return out.write(string.GetConstBuffer(), string.GetSize());
+	}
+
+	const std::size_t StringView::npos(std::numeric_limits<std::size_t>::max());
+}
@@ -0,0 +1,139 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/TaskHandle.hpp>
+#include <Nazara/Core/TaskState.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup core
+	* \class Nz::TaskHandle
+	* \brief Core class that represents a lightweight reference to a task of the TaskScheduler
+	*
+	* Handles can be used to wait for a specific task or to declare dependencies between tasks
+	*/
+
+	/*!
+	* \brief Constructs an invalid TaskHandle object
+	*/
+
+	TaskHandle::TaskHandle() :
+	m_state(nullptr)
+	{
+	}
+
+	/*!
+	* \brief Constructs a TaskHandle object referencing the same task as another
+	*
+	* \param handle TaskHandle to copy
+	*/
+
+	TaskHandle::TaskHandle(const TaskHandle& handle) :
+	m_state(handle.m_state)
+	{
+		if (m_state)
+			m_state->AddReference();
+	}
+
+	/*!
+	* \brief Constructs a TaskHandle object by move semantic
+	*
+	* \param handle TaskHandle to move into this
+	*/
+
+	TaskHandle::TaskHandle(TaskHandle&& handle) noexcept :
+	m_state(handle.m_state)
+	{
+		handle.m_state = nullptr;
+	}
+
+	/*!
+	* \brief Constructs a TaskHandle from a task state
+	*
+	* \param state State of the task, the handle takes ownership of the reference
+	*/
+
+	TaskHandle::TaskHandle(TaskState* state) :
+	m_state(state)
+	{
+	}
+
+	/*!
+	* \brief Destructs the object and releases its reference to the task
+	*/
+
+	TaskHandle::~TaskHandle()
+	{
+		Reset();
+	}
+
+	/*!
+	* \brief Checks whether the task has been executed
+	* \return true If the task is done or if the handle is invalid
+	*/
+
+	bool TaskHandle::IsDone() const
+	{
+		return !m_state || m_state->done.load(std::memory_order_acquire);
+	}
+
+	/*!
+	* \brief Checks whether the handle references a task
+	* \return true If it is the case
+	*/
+
+	bool TaskHandle::IsValid() const
+	{
+		return m_state != nullptr;
+	}
+
+	/*!
+	* \brief Releases the task referenced by this handle
+	*
+	* \remark This does not cancel the task
+	*/
+
+	void TaskHandle::Reset()
+	{
+		if (m_state)
+		{
+			m_state->RemoveReference();
+			m_state = nullptr;
+		}
+	}
+
+	/*!
+	* \brief Makes the handle reference the same task as another
+	* \return A reference to this
+	*
+	* \param handle The other TaskHandle
+	*/
+
+	TaskHandle& TaskHandle::operator=(const TaskHandle& handle)
+	{
+		if (handle.m_state)
+			handle.m_state->AddReference();
+
+		Reset();
+		m_state = handle.m_state;
+
+		return *this;
+	}
+
+	/*!
+	* \brief Moves the TaskHandle into this
+	* \return A reference to this
+	*
+	* \param handle TaskHandle to move in this
+	*/
+
+	TaskHandle& TaskHandle::operator=(TaskHandle&& handle) noexcept
+	{
+		std::swap(m_state, handle.m_state);
+		return *this;
+	}
+}
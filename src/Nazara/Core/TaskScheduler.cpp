@@ -3,8 +3,14 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
 #include <Nazara/Core/HardwareInfo.hpp>
+#include <Nazara/Core/TaskState.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 	#include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
@@ -20,8 +26,36 @@ namespace Nz
 {
 	namespace
 	{
+		// Task states and runners are recycled through the caches of the threads creating and running them,
+		// tasks are added and run without going through the allocator once the pools are warm
+		ConcurrentMemoryPool& GetRunnerPool()
+		{
+			static ConcurrentMemoryPool pool(static_cast<unsigned int>(sizeof(TaskRunner)), 64);
+			return pool;
+		}
+
+		ConcurrentMemoryPool& GetStatePool()
+		{
+			// Blocks follow each other in the pool, the size keeps the functor storage aligned
+			constexpr std::size_t alignment = alignof(std::max_align_t);
+			constexpr std::size_t blockSize = (sizeof(TaskState) + alignment - 1) / alignment * alignment;
+
+			static ConcurrentMemoryPool pool(static_cast<unsigned int>(blockSize), 64);
+			return pool;
+		}
+
+		void SubmitTask(TaskState* state)
+		{
+			// Dependencies done, the task can go straight to the workers
+			state->AddReference();
+
+			Functor* runner = TaskRunner::New(state);
+			TaskSchedulerImpl::Run(&runner, 1);
+		}
+
 		std::vector<Functor*> s_pendingWorks;
 		unsigned int s_workerCount = 0;
+		bool s_workerPinning = false;
 	}
 
 	/*!
@@ -29,17 +63,37 @@ namespace Nz
 	* \class Nz::TaskScheduler
 	* \brief Core class that represents a pool of threads
 	*
+	* Each worker owns a lock-free deque of tasks, tasks added from a worker go into its own deque while idle workers steal work from the others
+	*
 	* \remark Initialized should be called first
 	*/
 
 	/*!
 	* \brief Gets the number of threads
-	* \return Number of threads, if none, the number of simulatenous threads on the processor is returned
+	* \return Number of threads, if none, the number of simulatenous threads on the processor is returned (or the number of physical cores if workers are pinned)
 	*/
 
 	unsigned int TaskScheduler::GetWorkerCount()
 	{
-		return (s_workerCount > 0) ? s_workerCount : HardwareInfo::GetProcessorCount();
+		if (s_workerCount > 0)
+			return s_workerCount;
+
+		return (s_workerPinning) ? HardwareInfo::GetCoreCount() : HardwareInfo::GetProcessorCount();
+	}
+
+	/*!
+	* \brief Gets the index of the worker running the calling thread
+	* \return Index of the worker, or the number of workers if the calling thread is not a worker
+	*
+	* \remark Per-thread resources can be kept in an array of GetWorkerCount() + 1 elements indexed by this value, the last one belonging to the threads outside the scheduler
+	*/
+
+	unsigned int TaskScheduler::GetWorkerIndex()
+	{
+		if (!TaskSchedulerImpl::IsWorkerThread())
+			return GetWorkerCount();
+
+		return TaskSchedulerImpl::GetWorkerIndex();
 	}
 
 	/*!
@@ -49,7 +103,33 @@ namespace Nz
 
 	bool TaskScheduler::Initialize()
 	{
-		return TaskSchedulerImpl::Initialize(GetWorkerCount());
+		if (TaskSchedulerImpl::IsInitialized())
+			return true;
+
+		unsigned int workerCount = GetWorkerCount();
+		if (!s_workerPinning)
+			return TaskSchedulerImpl::Initialize(workerCount);
+
+		// One worker per physical core, extra workers wrap around
+		std::vector<UInt64> affinities(workerCount);
+
+		unsigned int coreCount = HardwareInfo::GetCoreCount();
+		for (unsigned int i = 0; i < workerCount; ++i)
+			affinities[i] = HardwareInfo::GetCoreProcessorMask(i % coreCount);
+
+		return TaskSchedulerImpl::Initialize(workerCount, affinities.data());
+	}
+
+	/*!
+	* \brief Checks whether workers are pinned to physical cores
+	* \return true if each worker is restricted to the logical processors of one physical core
+	*
+	* \see SetWorkerPinning
+	*/
+
+	bool TaskScheduler::IsWorkerPinningEnabled()
+	{
+		return s_workerPinning;
 	}
 
 	/*!
@@ -94,6 +174,31 @@ namespace Nz
 		s_workerCount = workerCount;
 	}
 
+	/*!
+	* \brief Pins the workers to the physical cores
+	*
+	* \param enable If true, each worker is restricted to the logical processors of one physical core and, unless set otherwise, there is one worker per physical core
+	*
+	* Pinned workers keep their caches warm and do not compete for the same core, which reduces jitter under load.
+	*
+	* \remark Produce a NazaraError if the class is initialized and NAZARA_CORE_SAFE is defined
+	*
+	* \see HardwareInfo::GetCoreCount
+	*/
+
+	void TaskScheduler::SetWorkerPinning(bool enable)
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (TaskSchedulerImpl::IsInitialized())
+		{
+			NazaraError("Worker pinning cannot be changed while initialized");
+			return;
+		}
+		#endif
+
+		s_workerPinning = enable;
+	}
+
 	/*!
 	* \brief Uninitializes the TaskScheduler class
 	*/
@@ -104,6 +209,66 @@ namespace Nz
 			TaskSchedulerImpl::Uninitialize();
 	}
 
+	/*!
+	* \brief Waits for a specific task to be done
+	*
+	* \param handle Handle to the task to wait for
+	*
+	* Pending tasks are run first, and the calling thread executes other tasks while waiting instead of blocking
+	*
+	* \remark Produce a NazaraError if the class is not initialized
+	* \remark Can be called from a task
+	*/
+
+	void TaskScheduler::Wait(const TaskHandle& handle)
+	{
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize Task Scheduler");
+			return;
+		}
+
+		if (handle.IsDone())
+			return;
+
+		if (!TaskSchedulerImpl::IsWorkerThread())
+			Run();
+
+		while (!handle.IsDone())
+		{
+			if (!TaskSchedulerImpl::TryExecuteTask())
+				std::this_thread::yield();
+		}
+	}
+
+	/*!
+	* \brief Waits for multiple tasks to be done
+	*
+	* \param handles Handles to the tasks to wait for
+	*
+	* \see Wait
+	*/
+
+	void TaskScheduler::Wait(std::initializer_list<TaskHandle> handles)
+	{
+		for (const TaskHandle& handle : handles)
+			Wait(handle);
+	}
+
+	/*!
+	* \brief Waits for multiple tasks to be done
+	*
+	* \param handles Handles to the tasks to wait for
+	*
+	* \see Wait
+	*/
+
+	void TaskScheduler::Wait(const std::vector<TaskHandle>& handles)
+	{
+		for (const TaskHandle& handle : handles)
+			Wait(handle);
+	}
+
 	/*!
 	* \brief Waits for tasks to be done
 	*
@@ -123,21 +288,156 @@ namespace Nz
 
 	/*!
 	* \brief Adds a task on the pending list
+	* \return Handle to the task
 	*
+	* \param state State of the task, from NewTaskFunctor
 	* \param taskFunctor Functor represeting a task to be done
+	* \param dependencies Tasks which must be done before this one can run
+	* \param dependencyCount Number of dependencies
 	*
 	* \remark Produce a NazaraError if the class is not initialized
-	* \remark A task containing a call on this class is undefined behaviour
+	* \remark When called from a task, the new task is immediately pushed on the worker deque (no need to call Run)
+	* \remark Calling WaitForTasks from a task is undefined behaviour
 	*/
 
-	void TaskScheduler::AddTaskFunctor(Functor* taskFunctor)
+	TaskHandle TaskScheduler::AddTaskFunctor(TaskState* state, Functor* taskFunctor, const TaskHandle* dependencies, std::size_t dependencyCount)
 	{
+		state->functor = taskFunctor; // The state is owned by the handle
+
 		if (!Initialize())
 		{
 			NazaraError("Failed to initialize Task Scheduler");
-			return;
+			state->RemoveReference();
+			return TaskHandle();
+		}
+
+		for (std::size_t i = 0; i < dependencyCount; ++i)
+		{
+			TaskState* dependency = dependencies[i].m_state;
+			if (!dependency)
+				continue;
+
+			dependency->Lock();
+			if (!dependency->done.load(std::memory_order_relaxed))
+			{
+				state->AddReference();
+				state->dependencyCount++;
+				dependency->successors.push_back(state);
+			}
+			dependency->Unlock();
 		}
 
-		s_pendingWorks.push_back(taskFunctor);
+		// Releases the setup dependency, the task is still waiting on its unfinished dependencies if any
+		if (--state->dependencyCount == 0)
+		{
+			state->AddReference();
+
+			Functor* runner = TaskRunner::New(state);
+			if (TaskSchedulerImpl::IsWorkerThread())
+				TaskSchedulerImpl::Run(&runner, 1);
+			else
+				s_pendingWorks.push_back(runner);
+		}
+
+		return TaskHandle(state);
+	}
+
+	/*!
+	* \brief Allocates the state of a new task
+	* \return State of the task, with a reference owned by the caller
+	*
+	* \param functorStorage Pointer receiving the storage of the state where the functor can be built, nullptr if it is allocated apart
+	*/
+
+	TaskState* TaskScheduler::AllocateTaskState(void** functorStorage)
+	{
+		TaskState* state = TaskState::New();
+		NazaraAssert(state, "Failed to allocate task state");
+
+		if (functorStorage)
+			*functorStorage = state->functorStorage;
+
+		return state;
+	}
+
+	/*!
+	* \brief Gets the number of helper tasks to spawn for a parallel loop
+	* \return Number of tasks helping the calling thread, zero if the loop should run sequentially
+	*
+	* \param chunkCount Number of chunks of the loop
+	*/
+
+	std::size_t TaskScheduler::GetHelperCount(std::size_t chunkCount)
+	{
+		if (chunkCount <= 1 || !Initialize())
+			return 0;
+
+		return std::min<std::size_t>(TaskSchedulerImpl::GetWorkerCount(), chunkCount - 1);
+	}
+
+	/*!
+	* \brief Sends a task to the workers immediately, bypassing the pending list
+	* \return Handle to the task
+	*
+	* \param state State of the task, from NewTaskFunctor
+	* \param taskFunctor Functor represeting a task to be done
+	*
+	* \remark The scheduler must be initialized
+	*/
+
+	TaskHandle TaskScheduler::SpawnTaskFunctor(TaskState* state, Functor* taskFunctor)
+	{
+		state->functor = taskFunctor;
+		state->dependencyCount = 0;
+
+		SubmitTask(state);
+
+		return TaskHandle(state);
+	}
+
+	TaskState* TaskState::New()
+	{
+		return GetStatePool().New<TaskState>();
+	}
+
+	void TaskState::Release(TaskState* state)
+	{
+		GetStatePool().Delete(state);
+	}
+
+	TaskRunner* TaskRunner::New(TaskState* state)
+	{
+		// Built in place, the workers delete it through the pool (see operator delete)
+		TaskRunner* runner = static_cast<TaskRunner*>(GetRunnerPool().Allocate());
+		NazaraAssert(runner, "Failed to allocate task runner");
+
+		return PlacementNew(runner, state);
+	}
+
+	void TaskRunner::Free(void* ptr)
+	{
+		GetRunnerPool().Free(ptr);
+	}
+
+	void TaskRunner::Run()
+	{
+		state->functor->Run();
+		state->DestroyFunctor();
+
+		// Marks the task as done and grabs the successors registered so far, they can now be released
+		std::vector<TaskState*> successors;
+
+		state->Lock();
+		state->done.store(true, std::memory_order_release);
+		std::swap(successors, state->successors);
+		state->Unlock();
+
+		for (TaskState* successor : successors)
+		{
+			if (--successor->dependencyCount == 0)
+				SubmitTask(successor);
+
+			successor->RemoveReference();
+		}
 	}
 }
@@ -0,0 +1,116 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TASKSTATE_HPP
+#define NAZARA_TASKSTATE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Nz
+{
+	// Task states and runners are allocated from thread-caching pools (see TaskScheduler.cpp), never with new
+	struct TaskState
+	{
+		TaskState() :
+		functor(nullptr),
+		dependencyCount(1),
+		referenceCount(1),
+		done(false),
+		locked(false)
+		{
+		}
+
+		~TaskState()
+		{
+			DestroyFunctor();
+
+			// Successors of a task which never ran
+			for (TaskState* successor : successors)
+				successor->RemoveReference();
+		}
+
+		void AddReference()
+		{
+			referenceCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void DestroyFunctor()
+		{
+			if (!functor)
+				return;
+
+			// Small functors are built in the storage of the state (see TaskScheduler::NewTaskFunctor)
+			if (static_cast<void*>(functor) == functorStorage)
+				functor->~Functor();
+			else
+				delete functor;
+
+			functor = nullptr;
+		}
+
+		void Lock()
+		{
+			// Only held to register or to flush the successors, a spinlock is enough
+			while (locked.exchange(true, std::memory_order_acquire));
+		}
+
+		void RemoveReference()
+		{
+			if (referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Release(this);
+		}
+
+		void Unlock()
+		{
+			locked.store(false, std::memory_order_release);
+		}
+
+		static TaskState* New();
+		static void Release(TaskState* state);
+
+		alignas(std::max_align_t) UInt8 functorStorage[TaskScheduler::TaskFunctorSize];
+		Functor* functor;
+		std::vector<TaskState*> successors;
+		std::atomic_uint dependencyCount; // Unfinished dependencies, plus one while the task is being set up
+		std::atomic_uint referenceCount;
+		std::atomic_bool done;
+		std::atomic_bool locked;
+	};
+
+	// What the workers actually run, it holds a reference to the state until the task is done
+	struct TaskRunner : Functor
+	{
+		TaskRunner(TaskState* taskState) :
+		state(taskState)
+		{
+		}
+
+		~TaskRunner()
+		{
+			state->RemoveReference();
+		}
+
+		void Run() override;
+
+		// Workers delete the tasks they ran, the memory of a runner goes back to its pool
+		static void operator delete(void* ptr)
+		{
+			Free(ptr);
+		}
+
+		static TaskRunner* New(TaskState* state);
+		static void Free(void* ptr);
+
+		TaskState* state;
+	};
+}
+
+#endif // NAZARA_TASKSTATE_HPP
@@ -117,6 +117,94 @@ namespace Nz
 		m_impl = nullptr;
 	}
 
+	/*!
+	* \brief Restricts the thread to a set of logical processors
+	* \return true if the affinity was applied
+	*
+	* \param processorMask Bitmask of the logical processors the thread may run on, bit N being the logical processor N
+	*
+	* \remark Produce a NazaraError if the thread is not joinable or if the affinity could not be set
+	*
+	* \see HardwareInfo::GetCoreProcessorMask
+	*/
+
+	bool Thread::SetAffinity(UInt64 processorMask)
+	{
+		#if NAZARA_CORE_SAFE
+		if (!m_impl)
+		{
+			NazaraError("This thread is not joinable");
+			return false;
+		}
+		#endif
+
+		if (!m_impl->SetAffinity(processorMask))
+		{
+			NazaraError("Failed to set thread affinity: " + Error::GetLastSystemError());
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Names the thread, the name is shown by debuggers and profilers
+	* \return true if the name was applied
+	*
+	* \param name Name of the thread
+	*
+	* \remark Names may be truncated by the system (15 characters on Linux)
+	* \remark Produce a NazaraError if the thread is not joinable or if the name could not be set
+	*/
+
+	bool Thread::SetName(const String& name)
+	{
+		#if NAZARA_CORE_SAFE
+		if (!m_impl)
+		{
+			NazaraError("This thread is not joinable");
+			return false;
+		}
+		#endif
+
+		if (!m_impl->SetName(name))
+		{
+			NazaraError("Failed to set thread name");
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Sets the scheduling priority of the thread
+	* \return true if the priority was applied
+	*
+	* \param priority Priority of the thread relatively to the other threads of the process
+	*
+	* \remark Raising the priority above normal may require privileges on some systems
+	* \remark Produce a NazaraError if the thread is not joinable or if the priority could not be set
+	*/
+
+	bool Thread::SetPriority(ThreadPriority priority)
+	{
+		#if NAZARA_CORE_SAFE
+		if (!m_impl)
+		{
+			NazaraError("This thread is not joinable");
+			return false;
+		}
+		#endif
+
+		if (!m_impl->SetPriority(priority))
+		{
+			NazaraError("Failed to set thread priority: " + Error::GetLastSystemError());
+			return false;
+		}
+
+		return true;
+	}
+
 	/*!
 	* \brief Moves the other thread into this
 	* \return A reference to this
@@ -151,6 +239,48 @@ namespace Nz
 		return HardwareInfo::GetProcessorCount();
 	}
 
+	/*!
+	* \brief Restricts the calling thread to a set of logical processors
+	* \return true if the affinity was applied
+	*
+	* \param processorMask Bitmask of the logical processors the thread may run on, bit N being the logical processor N
+	*
+	* \see SetAffinity
+	*/
+
+	bool Thread::SetCurrentThreadAffinity(UInt64 processorMask)
+	{
+		return ThreadImpl::SetCurrentThreadAffinity(processorMask);
+	}
+
+	/*!
+	* \brief Names the calling thread
+	* \return true if the name was applied
+	*
+	* \param name Name of the thread
+	*
+	* \see SetName
+	*/
+
+	bool Thread::SetCurrentThreadName(const String& name)
+	{
+		return ThreadImpl::SetCurrentThreadName(name);
+	}
+
+	/*!
+	* \brief Sets the scheduling priority of the calling thread
+	* \return true if the priority was applied
+	*
+	* \param priority Priority of the thread relatively to the other threads of the process
+	*
+	* \see SetPriority
+	*/
+
+	bool Thread::SetCurrentThreadPriority(ThreadPriority priority)
+	{
+		return ThreadImpl::SetCurrentThreadPriority(priority);
+	}
+
 	/*!
 	* \brief Makes sleep this thread
 	*
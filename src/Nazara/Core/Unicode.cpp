@@ -4,6 +4,29 @@
 
 #include <Nazara/Core/Unicode.hpp>
 #include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <cstring>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_UNICODE_X86
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_AVX2_FUNCTION
+		#define NAZARA_SSE2_FUNCTION
+		#define NAZARA_SSSE3_FUNCTION
+	#else
+		#define NAZARA_AVX2_FUNCTION __attribute__((target("avx2")))
+		#define NAZARA_SSE2_FUNCTION __attribute__((target("sse2")))
+		#define NAZARA_SSSE3_FUNCTION __attribute__((target("ssse3")))
+	#endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define NAZARA_UNICODE_NEON
+	#include <arm_neon.h>
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 #if NAZARA_CORE_INCLUDE_UNICODEDATA
@@ -417,3 +440,536 @@ namespace Nz
 }
 
 #endif
+
+namespace Nz
+{
+	namespace
+	{
+		/*
+		UTF-8 validation using the lookup algorithm of John Keiser and Daniel Lemire ("Validating UTF-8 In Less Than One Instruction Per Byte")
+		Each pair of consecutive bytes is classified by three table lookups (high nibble of the first byte, low nibble of the first byte,
+		high nibble of the second byte), a pair is invalid if a flag is set in the three lookups.
+		*/
+		enum Utf8Error : UInt8
+		{
+			Utf8Error_TooShort   = 1 << 0, // 11______ 0_______ or 11______ 11______
+			Utf8Error_TooLong    = 1 << 1, // 0_______ 10______
+			Utf8Error_Overlong3  = 1 << 2, // 11100000 100_____
+			Utf8Error_TooLarge   = 1 << 3, // 11110100 1001____ (and above)
+			Utf8Error_Surrogate  = 1 << 4, // 11101101 101_____
+			Utf8Error_Overlong2  = 1 << 5, // 1100000_ 10______
+			Utf8Error_Overlong4  = 1 << 6, // 11110000 1000____
+			Utf8Error_TwoConts   = 1 << 7, // 10______ 10______
+			Utf8Error_TooLarge1000 = Utf8Error_Overlong4, // 11110101 1000____ (and above)
+
+			Utf8Error_Carry = Utf8Error_TooShort | Utf8Error_TooLong | Utf8Error_TwoConts
+		};
+
+		alignas(16) const UInt8 s_utf8Byte1High[16] = {
+			// 0_______ (ASCII)
+			Utf8Error_TooLong, Utf8Error_TooLong, Utf8Error_TooLong, Utf8Error_TooLong,
+			Utf8Error_TooLong, Utf8Error_TooLong, Utf8Error_TooLong, Utf8Error_TooLong,
+			// 10______ (continuation)
+			Utf8Error_TwoConts, Utf8Error_TwoConts, Utf8Error_TwoConts, Utf8Error_TwoConts,
+			// 1100____ (two bytes lead)
+			Utf8Error_TooShort | Utf8Error_Overlong2,
+			// 1101____ (two bytes lead)
+			Utf8Error_TooShort,
+			// 1110____ (three bytes lead)
+			Utf8Error_TooShort | Utf8Error_Overlong3 | Utf8Error_Surrogate,
+			// 1111____ (four bytes lead)
+			Utf8Error_TooShort | Utf8Error_TooLarge | Utf8Error_TooLarge1000 | Utf8Error_Overlong4
+		};
+
+		alignas(16) const UInt8 s_utf8Byte1Low[16] = {
+			// ____0000
+			Utf8Error_Carry | Utf8Error_Overlong3 | Utf8Error_Overlong2 | Utf8Error_Overlong4,
+			// ____0001
+			Utf8Error_Carry | Utf8Error_Overlong2,
+			// ____001_
+			Utf8Error_Carry,
+			Utf8Error_Carry,
+			// ____0100
+			Utf8Error_Carry | Utf8Error_TooLarge,
+			// ____0101 to ____1100
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			// ____1101
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000 | Utf8Error_Surrogate,
+			// ____111_
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000,
+			Utf8Error_Carry | Utf8Error_TooLarge | Utf8Error_TooLarge1000
+		};
+
+		alignas(16) const UInt8 s_utf8Byte2High[16] = {
+			// 0_______ (ASCII)
+			Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort,
+			Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort,
+			// 1000____
+			Utf8Error_TooLong | Utf8Error_Overlong2 | Utf8Error_TwoConts | Utf8Error_Overlong3 | Utf8Error_TooLarge1000 | Utf8Error_Overlong4,
+			// 1001____
+			Utf8Error_TooLong | Utf8Error_Overlong2 | Utf8Error_TwoConts | Utf8Error_Overlong3 | Utf8Error_TooLarge,
+			// 101_____
+			Utf8Error_TooLong | Utf8Error_Overlong2 | Utf8Error_TwoConts | Utf8Error_Surrogate | Utf8Error_TooLarge,
+			Utf8Error_TooLong | Utf8Error_Overlong2 | Utf8Error_TwoConts | Utf8Error_Surrogate | Utf8Error_TooLarge,
+			// 11______ (lead)
+			Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort, Utf8Error_TooShort
+		};
+
+		// A block is incomplete if one of its three last bytes starts a sequence going beyond it
+		alignas(32) const UInt8 s_utf8IncompleteMax[32] = {
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+		};
+
+		inline char32_t DecodeUtf8(const UInt8*& ptr)
+		{
+			// Input is known to be valid
+			UInt8 lead = *ptr++;
+			if (lead < 0x80)
+				return lead;
+			else if (lead < 0xE0)
+			{
+				char32_t codepoint = (char32_t(lead & 0x1F) << 6) | (ptr[0] & 0x3F);
+				ptr += 1;
+				return codepoint;
+			}
+			else if (lead < 0xF0)
+			{
+				char32_t codepoint = (char32_t(lead & 0x0F) << 12) | (char32_t(ptr[0] & 0x3F) << 6) | (ptr[1] & 0x3F);
+				ptr += 2;
+				return codepoint;
+			}
+			else
+			{
+				char32_t codepoint = (char32_t(lead & 0x07) << 18) | (char32_t(ptr[0] & 0x3F) << 12) | (char32_t(ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F);
+				ptr += 3;
+				return codepoint;
+			}
+		}
+
+		bool IsValidUtf8Generic(const char* str, std::size_t size)
+		{
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(str);
+			const UInt8* end = ptr + size;
+
+			while (ptr < end)
+			{
+				// ASCII fast path, eight bytes at a time
+				while (end - ptr >= 8)
+				{
+					UInt64 block;
+					std::memcpy(&block, ptr, sizeof(UInt64));
+					if (block & 0x8080808080808080ULL)
+						break;
+
+					ptr += 8;
+				}
+
+				if (ptr == end)
+					break;
+
+				UInt8 lead = *ptr;
+				if (lead < 0x80)
+				{
+					ptr++;
+					continue;
+				}
+
+				std::size_t length;
+				char32_t codepoint;
+				char32_t minimum;
+				if ((lead & 0xE0) == 0xC0)
+				{
+					length = 2;
+					codepoint = lead & 0x1F;
+					minimum = 0x80;
+				}
+				else if ((lead & 0xF0) == 0xE0)
+				{
+					length = 3;
+					codepoint = lead & 0x0F;
+					minimum = 0x800;
+				}
+				else if ((lead & 0xF8) == 0xF0)
+				{
+					length = 4;
+					codepoint = lead & 0x07;
+					minimum = 0x10000;
+				}
+				else
+					return false;
+
+				if (static_cast<std::size_t>(end - ptr) < length)
+					return false;
+
+				for (std::size_t i = 1; i < length; ++i)
+				{
+					if ((ptr[i] & 0xC0) != 0x80)
+						return false;
+
+					codepoint = (codepoint << 6) | (ptr[i] & 0x3F);
+				}
+
+				if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+					return false;
+
+				ptr += length;
+			}
+
+			return true;
+		}
+
+		std::size_t Utf8ToUtf32Generic(const char* str, std::size_t size, char32_t* output)
+		{
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(str);
+			const UInt8* end = ptr + size;
+			char32_t* out = output;
+
+			while (ptr < end)
+			{
+				if (end - ptr >= 8)
+				{
+					UInt64 block;
+					std::memcpy(&block, ptr, sizeof(UInt64));
+					if ((block & 0x8080808080808080ULL) == 0)
+					{
+						for (unsigned int i = 0; i < 8; ++i)
+							out[i] = ptr[i];
+
+						ptr += 8;
+						out += 8;
+						continue;
+					}
+				}
+
+				*out++ = DecodeUtf8(ptr);
+			}
+
+			return out - output;
+		}
+
+		#ifdef NAZARA_UNICODE_X86
+		NAZARA_SSSE3_FUNCTION void CheckUtf8BlockSSSE3(__m128i input, __m128i& previousInput, __m128i& previousIncomplete, __m128i& error)
+		{
+			if (_mm_movemask_epi8(input) == 0)
+			{
+				// ASCII only, the block is only wrong if the previous one ended in the middle of a sequence
+				error = _mm_or_si128(error, previousIncomplete);
+			}
+			else
+			{
+				const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+				__m128i prev1 = _mm_alignr_epi8(input, previousInput, 16 - 1);
+				__m128i byte1High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte1High)), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibbleMask));
+				__m128i byte1Low = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte1Low)), _mm_and_si128(prev1, nibbleMask));
+				__m128i byte2High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte2High)), _mm_and_si128(_mm_srli_epi16(input, 4), nibbleMask));
+				__m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+				// Bytes following a three or four bytes lead by two or three positions must be continuations
+				__m128i prev2 = _mm_alignr_epi8(input, previousInput, 16 - 2);
+				__m128i prev3 = _mm_alignr_epi8(input, previousInput, 16 - 3);
+				__m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8(char(0xE0 - 0x80)));
+				__m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+				__m128i mustBeContinuation = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8(char(0x80)));
+
+				error = _mm_or_si128(error, _mm_xor_si128(mustBeContinuation, specialCases));
+				previousIncomplete = _mm_subs_epu8(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&s_utf8IncompleteMax[16])));
+			}
+
+			previousInput = input;
+		}
+
+		NAZARA_SSSE3_FUNCTION bool IsValidUtf8SSSE3(const char* str, std::size_t size)
+		{
+			__m128i error = _mm_setzero_si128();
+			__m128i previousIncomplete = _mm_setzero_si128();
+			__m128i previousInput = _mm_setzero_si128();
+
+			const char* ptr = str;
+			const char* end = str + size;
+			for (; end - ptr >= 16; ptr += 16)
+				CheckUtf8BlockSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), previousInput, previousIncomplete, error);
+
+			// The remaining bytes are padded with zeroes, which also catches a sequence truncated by the end of the string
+			alignas(16) char lastBlock[16] = {};
+			std::memcpy(lastBlock, ptr, end - ptr);
+
+			CheckUtf8BlockSSSE3(_mm_load_si128(reinterpret_cast<const __m128i*>(lastBlock)), previousInput, previousIncomplete, error);
+
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+		}
+
+		NAZARA_AVX2_FUNCTION void CheckUtf8BlockAVX2(__m256i input, __m256i& previousInput, __m256i& previousIncomplete, __m256i& error)
+		{
+			if (_mm256_movemask_epi8(input) == 0)
+				error = _mm256_or_si256(error, previousIncomplete);
+			else
+			{
+				const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+				const __m256i byte1HighTable = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte1High)));
+				const __m256i byte1LowTable = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte1Low)));
+				const __m256i byte2HighTable = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(s_utf8Byte2High)));
+
+				// alignr works on 128 bits lanes, the upper half of the previous block has to be brought next to the lower half of this one
+				__m256i previousShifted = _mm256_permute2x128_si256(previousInput, input, 0x21);
+
+				__m256i prev1 = _mm256_alignr_epi8(input, previousShifted, 16 - 1);
+				__m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask));
+				__m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, nibbleMask));
+				__m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+				__m256i specialCases = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+				__m256i prev2 = _mm256_alignr_epi8(input, previousShifted, 16 - 2);
+				__m256i prev3 = _mm256_alignr_epi8(input, previousShifted, 16 - 3);
+				__m256i isThirdByte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(char(0xE0 - 0x80)));
+				__m256i isFourthByte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+				__m256i mustBeContinuation = _mm256_and_si256(_mm256_or_si256(isThirdByte, isFourthByte), _mm256_set1_epi8(char(0x80)));
+
+				error = _mm256_or_si256(error, _mm256_xor_si256(mustBeContinuation, specialCases));
+				previousIncomplete = _mm256_subs_epu8(input, _mm256_load_si256(reinterpret_cast<const __m256i*>(s_utf8IncompleteMax)));
+			}
+
+			previousInput = input;
+		}
+
+		NAZARA_AVX2_FUNCTION bool IsValidUtf8AVX2(const char* str, std::size_t size)
+		{
+			__m256i error = _mm256_setzero_si256();
+			__m256i previousIncomplete = _mm256_setzero_si256();
+			__m256i previousInput = _mm256_setzero_si256();
+
+			const char* ptr = str;
+			const char* end = str + size;
+			for (; end - ptr >= 32; ptr += 32)
+				CheckUtf8BlockAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)), previousInput, previousIncomplete, error);
+
+			alignas(32) char lastBlock[32] = {};
+			std::memcpy(lastBlock, ptr, end - ptr);
+
+			CheckUtf8BlockAVX2(_mm256_load_si256(reinterpret_cast<const __m256i*>(lastBlock)), previousInput, previousIncomplete, error);
+
+			return _mm256_movemask_epi8(_mm256_cmpeq_epi8(error, _mm256_setzero_si256())) == -1;
+		}
+
+		NAZARA_SSE2_FUNCTION std::size_t Utf8ToUtf32SSE2(const char* str, std::size_t size, char32_t* output)
+		{
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(str);
+			const UInt8* end = ptr + size;
+			char32_t* out = output;
+
+			const __m128i zero = _mm_setzero_si128();
+			while (end - ptr >= 16)
+			{
+				__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+				if (_mm_movemask_epi8(input) == 0)
+				{
+					__m128i low = _mm_unpacklo_epi8(input, zero);
+					__m128i high = _mm_unpackhi_epi8(input, zero);
+
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out +  0), _mm_unpacklo_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out +  4), _mm_unpackhi_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out +  8), _mm_unpacklo_epi16(high, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+
+					ptr += 16;
+					out += 16;
+				}
+				else
+				{
+					// Decodes the whole block one code point at a time (the last sequence may go beyond it)
+					const UInt8* blockEnd = ptr + 16;
+					while (ptr < blockEnd)
+						*out++ = DecodeUtf8(ptr);
+				}
+			}
+
+			while (ptr < end)
+				*out++ = DecodeUtf8(ptr);
+
+			return out - output;
+		}
+
+		NAZARA_AVX2_FUNCTION std::size_t Utf8ToUtf32AVX2(const char* str, std::size_t size, char32_t* output)
+		{
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(str);
+			const UInt8* end = ptr + size;
+			char32_t* out = output;
+
+			while (end - ptr >= 32)
+			{
+				__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+				if (_mm256_movemask_epi8(input) == 0)
+				{
+					for (unsigned int i = 0; i < 4; ++i)
+					{
+						__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr + i * 8));
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), _mm256_cvtepu8_epi32(bytes));
+					}
+
+					ptr += 32;
+					out += 32;
+				}
+				else
+				{
+					const UInt8* blockEnd = ptr + 32;
+					while (ptr < blockEnd)
+						*out++ = DecodeUtf8(ptr);
+				}
+			}
+
+			while (ptr < end)
+				*out++ = DecodeUtf8(ptr);
+
+			return out - output;
+		}
+		#endif
+
+		#ifdef NAZARA_UNICODE_NEON
+		void CheckUtf8BlockNEON(uint8x16_t input, uint8x16_t& previousInput, uint8x16_t& previousIncomplete, uint8x16_t& error)
+		{
+			if (vmaxvq_u8(input) < 0x80)
+				error = vorrq_u8(error, previousIncomplete);
+			else
+			{
+				uint8x16_t prev1 = vextq_u8(previousInput, input, 16 - 1);
+				uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(s_utf8Byte1High), vshrq_n_u8(prev1, 4));
+				uint8x16_t byte1Low = vqtbl1q_u8(vld1q_u8(s_utf8Byte1Low), vandq_u8(prev1, vdupq_n_u8(0x0F)));
+				uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(s_utf8Byte2High), vshrq_n_u8(input, 4));
+				uint8x16_t specialCases = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+
+				uint8x16_t prev2 = vextq_u8(previousInput, input, 16 - 2);
+				uint8x16_t prev3 = vextq_u8(previousInput, input, 16 - 3);
+				uint8x16_t isThirdByte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+				uint8x16_t isFourthByte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+				uint8x16_t mustBeContinuation = vandq_u8(vorrq_u8(isThirdByte, isFourthByte), vdupq_n_u8(0x80));
+
+				error = vorrq_u8(error, veorq_u8(mustBeContinuation, specialCases));
+				previousIncomplete = vqsubq_u8(input, vld1q_u8(&s_utf8IncompleteMax[16]));
+			}
+
+			previousInput = input;
+		}
+
+		bool IsValidUtf8NEON(const char* str, std::size_t size)
+		{
+			uint8x16_t error = vdupq_n_u8(0);
+			uint8x16_t previousIncomplete = vdupq_n_u8(0);
+			uint8x16_t previousInput = vdupq_n_u8(0);
+
+			const char* ptr = str;
+			const char* end = str + size;
+			for (; end - ptr >= 16; ptr += 16)
+				CheckUtf8BlockNEON(vld1q_u8(reinterpret_cast<const UInt8*>(ptr)), previousInput, previousIncomplete, error);
+
+			alignas(16) UInt8 lastBlock[16] = {};
+			std::memcpy(lastBlock, ptr, end - ptr);
+
+			CheckUtf8BlockNEON(vld1q_u8(lastBlock), previousInput, previousIncomplete, error);
+
+			return vmaxvq_u8(error) == 0;
+		}
+
+		std::size_t Utf8ToUtf32NEON(const char* str, std::size_t size, char32_t* output)
+		{
+			const UInt8* ptr = reinterpret_cast<const UInt8*>(str);
+			const UInt8* end = ptr + size;
+			char32_t* out = output;
+
+			while (end - ptr >= 16)
+			{
+				uint8x16_t input = vld1q_u8(ptr);
+				if (vmaxvq_u8(input) < 0x80)
+				{
+					uint16x8_t low = vmovl_u8(vget_low_u8(input));
+					uint16x8_t high = vmovl_u8(vget_high_u8(input));
+
+					UInt32* out32 = reinterpret_cast<UInt32*>(out);
+					vst1q_u32(out32 +  0, vmovl_u16(vget_low_u16(low)));
+					vst1q_u32(out32 +  4, vmovl_u16(vget_high_u16(low)));
+					vst1q_u32(out32 +  8, vmovl_u16(vget_low_u16(high)));
+					vst1q_u32(out32 + 12, vmovl_u16(vget_high_u16(high)));
+
+					ptr += 16;
+					out += 16;
+				}
+				else
+				{
+					const UInt8* blockEnd = ptr + 16;
+					while (ptr < blockEnd)
+						*out++ = DecodeUtf8(ptr);
+				}
+			}
+
+			while (ptr < end)
+				*out++ = DecodeUtf8(ptr);
+
+			return out - output;
+		}
+		#endif
+
+		CpuKernel<bool(const char*, std::size_t)> s_utf8ValidationKernel("UTF-8 validation", &IsValidUtf8Generic, {
+			#ifdef NAZARA_UNICODE_X86
+			{&IsValidUtf8AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&IsValidUtf8SSSE3, "SSSE3", {ProcessorCap_SSSE3}},
+			#endif
+			#ifdef NAZARA_UNICODE_NEON
+			{&IsValidUtf8NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<std::size_t(const char*, std::size_t, char32_t*)> s_utf8ToUtf32Kernel("UTF-8 to UTF-32", &Utf8ToUtf32Generic, {
+			#ifdef NAZARA_UNICODE_X86
+			{&Utf8ToUtf32AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&Utf8ToUtf32SSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_UNICODE_NEON
+			{&Utf8ToUtf32NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+	}
+
+	/*!
+	* \brief Checks whether a buffer is valid UTF-8
+	* \return true if the buffer only holds complete, shortest form sequences of code points up to U+10FFFF, surrogates excluded
+	*
+	* \param str Buffer to check
+	* \param size Size of the buffer in bytes
+	*
+	* \remark Uses SSSE3, AVX2 or NEON when available, pure ASCII parts are skipped quickly
+	*/
+
+	bool Unicode::IsValidUtf8(const char* str, std::size_t size)
+	{
+		NazaraAssert(str || size == 0, "Invalid buffer");
+
+		return s_utf8ValidationKernel(str, size);
+	}
+
+	/*!
+	* \brief Converts UTF-8 to UTF-32
+	* \return Number of code points written
+	*
+	* \param str Buffer to convert, which must be valid UTF-8
+	* \param size Size of the buffer in bytes
+	* \param output Buffer receiving the code points, it must be able to hold size code points
+	*
+	* \remark The input is not validated, use IsValidUtf8 first if it is not trusted
+	* \remark Uses SSE2, AVX2 or NEON when available, with a fast path for pure ASCII parts
+	*/
+
+	std::size_t Unicode::Utf8ToUtf32(const char* str, std::size_t size, char32_t* output)
+	{
+		NazaraAssert(str || size == 0, "Invalid buffer");
+		NazaraAssert(output || size == 0, "Invalid output buffer");
+
+		return s_utf8ToUtf32Kernel(str, size, output);
+	}
+}
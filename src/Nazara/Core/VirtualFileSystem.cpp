@@ -0,0 +1,251 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/VirtualFileSystem.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		String NormalizeMountPoint(const String& mountPoint)
+		{
+			String normalizedMountPoint = PackArchive::NormalizePath(mountPoint);
+			while (normalizedMountPoint.EndsWith('/'))
+				normalizedMountPoint.Resize(-1);
+
+			return normalizedMountPoint;
+		}
+	}
+
+	/*!
+	* \ingroup core
+	* \class Nz::VirtualFileSystem
+	* \brief Core class that resolves paths through mounted packs and directories
+	*
+	* Packs (see PackArchive) hold the assets of a release build, directories mounted over them override some of their files during development.
+	* ResourceLoader::LoadFromFile goes through the mounted packs and directories before the regular file system.
+	*
+	* \remark Mounting and unmounting must not happen while resources are loaded from other threads
+	*/
+
+	/*!
+	* \brief Checks whether a file exists in the mounted packs and directories, or in the file system
+	* \return true If it is the case
+	*
+	* \param path Path of the file
+	*/
+
+	bool VirtualFileSystem::Exists(const String& path)
+	{
+		Location location;
+		if (Find(path, &location))
+			return true;
+
+		return File::Exists(path);
+	}
+
+	/*!
+	* \brief Finds a file in the mounted packs and directories
+	* \return true If a pack or a directory holds it
+	*
+	* \param path Path of the file, relative to the mount points
+	* \param location Location of the file, valid until it is unmounted
+	*
+	* \remark The last mounted pack or directory holding the file is used
+	* \remark Produces a NazaraAssert if location is invalid
+	*/
+
+	bool VirtualFileSystem::Find(const String& path, Location* location)
+	{
+		NazaraAssert(location, "Invalid location");
+
+		if (s_mounts.empty())
+			return false;
+
+		String normalizedPath = PackArchive::NormalizePath(path);
+
+		for (auto it = s_mounts.rbegin(); it != s_mounts.rend(); ++it)
+		{
+			const Mount& mount = *it;
+
+			String relativePath;
+			if (mount.mountPoint.IsEmpty())
+				relativePath = normalizedPath;
+			else if (normalizedPath.GetSize() > mount.mountPoint.GetSize() && normalizedPath.StartsWith(mount.mountPoint) && normalizedPath[mount.mountPoint.GetSize()] == '/')
+				relativePath = normalizedPath.SubString(mount.mountPoint.GetSize() + 1);
+			else
+				continue;
+
+			if (mount.archive)
+			{
+				if (const PackArchive::Entry* entry = mount.archive->FindEntry(relativePath))
+				{
+					location->archive = mount.archive.get();
+					location->entry = entry;
+					location->filePath.Clear();
+
+					return true;
+				}
+			}
+			else
+			{
+				String filePath = mount.path + NAZARA_DIRECTORY_SEPARATOR + File::NormalizeSeparators(relativePath);
+				if (File::Exists(filePath))
+				{
+					location->archive = nullptr;
+					location->entry = nullptr;
+					location->filePath = std::move(filePath);
+
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+	* \brief Mounts a directory
+	* \return true If successful
+	*
+	* \param directoryPath Path to the directory
+	* \param mountPoint Path its files are found at, empty to find them at the root
+	*
+	* \remark The files of the directory override the ones of the packs and directories previously mounted
+	* \remark Produces a NazaraError if the directory does not exist
+	*/
+
+	bool VirtualFileSystem::MountDirectory(const String& directoryPath, const String& mountPoint)
+	{
+		if (!Directory::Exists(directoryPath))
+		{
+			NazaraError("Directory \"" + directoryPath + "\" does not exist");
+			return false;
+		}
+
+		Mount mount;
+		mount.mountPoint = NormalizeMountPoint(mountPoint);
+		mount.path = File::NormalizePath(directoryPath);
+
+		s_mounts.emplace_back(std::move(mount));
+		return true;
+	}
+
+	/*!
+	* \brief Mounts a pack
+	* \return true If successful
+	*
+	* \param packPath Path to the pack
+	* \param mountPoint Path its entries are found at, empty to find them at the root
+	*
+	* \remark The entries of the pack override the files of the packs and directories previously mounted
+	* \remark Produces a NazaraError if the pack could not be opened
+	*/
+
+	bool VirtualFileSystem::MountPack(const String& packPath, const String& mountPoint)
+	{
+		std::unique_ptr<PackArchive> archive = std::make_unique<PackArchive>();
+		if (!archive->Open(packPath))
+			return false;
+
+		Mount mount;
+		mount.archive = std::move(archive);
+		mount.mountPoint = NormalizeMountPoint(mountPoint);
+		mount.path = File::NormalizePath(packPath);
+
+		s_mounts.emplace_back(std::move(mount));
+		return true;
+	}
+
+	/*!
+	* \brief Reads a whole file from the mounted packs and directories, or from the file system
+	* \return true If successful
+	*
+	* \param path Path of the file
+	* \param data Buffer receiving the content of the file
+	*
+	* \remark Produces a NazaraAssert if data is invalid
+	* \remark Produces a NazaraError if the file could not be found or read
+	*/
+
+	bool VirtualFileSystem::ReadFile(const String& path, ByteArray* data)
+	{
+		NazaraAssert(data, "Invalid data");
+
+		Location location;
+		if (Find(path, &location) && location.archive)
+		{
+			data->Resize(static_cast<std::size_t>(location.entry->size));
+
+			return location.archive->Extract(*location.entry, data->GetBuffer());
+		}
+
+		String filePath = (location.filePath.IsEmpty()) ? path : location.filePath;
+
+		File file(filePath, OpenMode_ReadOnly);
+		if (!file.IsOpen())
+		{
+			NazaraError("Failed to open \"" + path + '"');
+			return false;
+		}
+
+		std::size_t size = static_cast<std::size_t>(file.GetSize());
+		data->Resize(size);
+
+		if (size > 0 && file.Read(data->GetBuffer(), size) != size)
+		{
+			NazaraError("Failed to read \"" + path + '"');
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Uninitializes the virtual file system, unmounting everything
+	*/
+
+	void VirtualFileSystem::Uninitialize()
+	{
+		UnmountAll();
+	}
+
+	/*!
+	* \brief Unmounts a pack or a directory
+	* \return true If it was mounted
+	*
+	* \param path Path to the pack or the directory, as given to MountPack or MountDirectory
+	*/
+
+	bool VirtualFileSystem::Unmount(const String& path)
+	{
+		String normalizedPath = File::NormalizePath(path);
+
+		for (auto it = s_mounts.begin(); it != s_mounts.end(); ++it)
+		{
+			if (it->path == normalizedPath)
+			{
+				s_mounts.erase(it);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+	* \brief Unmounts every pack and directory
+	*/
+
+	void VirtualFileSystem::UnmountAll()
+	{
+		s_mounts.clear();
+	}
+
+	std::vector<VirtualFileSystem::Mount> VirtualFileSystem::s_mounts;
+}
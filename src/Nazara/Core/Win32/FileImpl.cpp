@@ -12,6 +12,8 @@
 namespace Nz
 {
 	FileImpl::FileImpl(const File* parent) :
+	m_mapping(nullptr),
+	m_mappedData(nullptr),
 	m_endOfFile(false),
 	m_endOfFileUpdated(true)
 	{
@@ -20,6 +22,8 @@ namespace Nz
 
 	void FileImpl::Close()
 	{
+		Unmap();
+
 		CloseHandle(m_handle);
 	}
 
@@ -55,6 +59,50 @@ namespace Nz
 		return position.QuadPart;
 	}
 
+	bool FileImpl::IsMapped() const
+	{
+		return m_mappedData != nullptr;
+	}
+
+	const void* FileImpl::Map()
+	{
+		if (m_mappedData)
+			return m_mappedData;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(m_handle, &fileSize))
+		{
+			NazaraError("Failed to get file size: " + Error::GetLastSystemError());
+			return nullptr;
+		}
+
+		if (fileSize.QuadPart == 0)
+		{
+			NazaraError("Cannot map an empty file");
+			return nullptr;
+		}
+
+		m_mapping = CreateFileMappingW(m_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!m_mapping)
+		{
+			NazaraError("Failed to create file mapping: " + Error::GetLastSystemError());
+			return nullptr;
+		}
+
+		m_mappedData = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!m_mappedData)
+		{
+			NazaraError("Failed to map file: " + Error::GetLastSystemError());
+
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+
+			return nullptr;
+		}
+
+		return m_mappedData;
+	}
+
 	bool FileImpl::Open(const String& filePath, UInt32 mode)
 	{
 		DWORD access = 0;
@@ -161,6 +209,8 @@ namespace Nz
 
 	bool FileImpl::SetSize(UInt64 size)
 	{
+		Unmap();
+
 		UInt64 cursorPos = GetCursorPos();
 
 		CallOnExit resetCursor([this, cursorPos] ()
@@ -184,6 +234,18 @@ namespace Nz
 		return true;
 	}
 
+	void FileImpl::Unmap()
+	{
+		if (m_mappedData)
+		{
+			UnmapViewOfFile(m_mappedData);
+			CloseHandle(m_mapping);
+
+			m_mappedData = nullptr;
+			m_mapping = nullptr;
+		}
+	}
+
 	std::size_t FileImpl::Write(const void* buffer, std::size_t size)
 	{
 		DWORD written = 0;
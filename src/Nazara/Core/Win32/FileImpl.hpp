@@ -29,10 +29,13 @@ namespace Nz
 			bool EndOfFile() const;
 			void Flush();
 			UInt64 GetCursorPos() const;
+			bool IsMapped() const;
+			const void* Map();
 			bool Open(const String& filePath, UInt32 mode);
 			std::size_t Read(void* buffer, std::size_t size);
 			bool SetCursorPos(CursorPosition pos, Int64 offset);
 			bool SetSize(UInt64 size);
+			void Unmap();
 			std::size_t Write(const void* buffer, std::size_t size);
 
 			FileImpl& operator=(const FileImpl&) = delete;
@@ -49,6 +52,8 @@ namespace Nz
 
 		private:
 			HANDLE m_handle;
+			HANDLE m_mapping;
+			void* m_mappedData;
 			mutable bool m_endOfFile;
 			mutable bool m_endOfFileUpdated;
 	};
@@ -4,6 +4,7 @@
 
 #include <Nazara/Core/Win32/HardwareInfoImpl.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <memory>
 #include <windows.h>
 
 #ifdef NAZARA_COMPILER_MSVC
@@ -31,6 +32,27 @@ namespace Nz
 	#endif
 	}
 
+	bool HardwareInfoImpl::GetCoreProcessorMasks(std::vector<UInt64>* coreMasks)
+	{
+		DWORD size = 0;
+		GetLogicalProcessorInformation(nullptr, &size);
+		if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+			return false;
+
+		std::size_t infoCount = size / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+		std::unique_ptr<SYSTEM_LOGICAL_PROCESSOR_INFORMATION[]> infos(new SYSTEM_LOGICAL_PROCESSOR_INFORMATION[infoCount]);
+		if (!GetLogicalProcessorInformation(infos.get(), &size))
+			return false;
+
+		for (std::size_t i = 0; i < infoCount; ++i)
+		{
+			if (infos[i].Relationship == RelationProcessorCore)
+				coreMasks->push_back(static_cast<UInt64>(infos[i].ProcessorMask));
+		}
+
+		return !coreMasks->empty();
+	}
+
 	unsigned int HardwareInfoImpl::GetProcessorCount()
 	{
 		// Plus simple (et plus portable) que de passer par le CPUID
@@ -97,4 +119,21 @@ namespace Nz
 		#endif
 	#endif
 }
+
+	UInt64 HardwareInfoImpl::Xgetbv(UInt32 index)
+	{
+	#if defined(NAZARA_COMPILER_MSVC)
+		return _xgetbv(index);
+	#elif defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_INTEL)
+		UInt32 eax, edx;
+		asm volatile (".byte 0x0f, 0x01, 0xd0" // xgetbv, encoded for assemblers not knowing it
+					  : "=a" (eax), "=d" (edx) // output
+					  : "c" (index));          // input
+
+		return (UInt64(edx) << 32) | eax;
+	#else
+		NazaraInternalError("Xgetbv has been called although it is not supported");
+		return 0;
+	#endif
+	}
 }
@@ -8,6 +8,7 @@
 #define NAZARA_HARDWAREINFOIMPL_WINDOWS_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -15,9 +16,11 @@ namespace Nz
 	{
 		public:
 			static void Cpuid(UInt32 functionId, UInt32 subFunctionId, UInt32 registers[4]);
+			static bool GetCoreProcessorMasks(std::vector<UInt64>* coreMasks);
 			static unsigned int GetProcessorCount();
 			static UInt64 GetTotalMemory();
 			static bool IsCpuidSupported();
+			static UInt64 Xgetbv(UInt32 index);
 	};
 }
 
@@ -0,0 +1,93 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Win32/SharedMutexImpl.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	#if NAZARA_CORE_WINDOWS_VISTA
+	SharedMutexImpl::SharedMutexImpl()
+	{
+		InitializeSRWLock(&m_lock);
+	}
+
+	SharedMutexImpl::~SharedMutexImpl() = default;
+
+	void SharedMutexImpl::Lock()
+	{
+		AcquireSRWLockExclusive(&m_lock);
+	}
+
+	void SharedMutexImpl::LockShared()
+	{
+		AcquireSRWLockShared(&m_lock);
+	}
+
+	bool SharedMutexImpl::TryLock()
+	{
+		return TryAcquireSRWLockExclusive(&m_lock) != 0;
+	}
+
+	bool SharedMutexImpl::TryLockShared()
+	{
+		return TryAcquireSRWLockShared(&m_lock) != 0;
+	}
+
+	void SharedMutexImpl::Unlock()
+	{
+		ReleaseSRWLockExclusive(&m_lock);
+	}
+
+	void SharedMutexImpl::UnlockShared()
+	{
+		ReleaseSRWLockShared(&m_lock);
+	}
+	#else
+	// Slim reader/writer locks are not available on XP, readers are serialized
+	SharedMutexImpl::SharedMutexImpl()
+	{
+		#if NAZARA_CORE_WINDOWS_CS_SPINLOCKS > 0
+		InitializeCriticalSectionAndSpinCount(&m_criticalSection, NAZARA_CORE_WINDOWS_CS_SPINLOCKS);
+		#else
+		InitializeCriticalSection(&m_criticalSection);
+		#endif
+	}
+
+	SharedMutexImpl::~SharedMutexImpl()
+	{
+		DeleteCriticalSection(&m_criticalSection);
+	}
+
+	void SharedMutexImpl::Lock()
+	{
+		EnterCriticalSection(&m_criticalSection);
+	}
+
+	void SharedMutexImpl::LockShared()
+	{
+		EnterCriticalSection(&m_criticalSection);
+	}
+
+	bool SharedMutexImpl::TryLock()
+	{
+		return TryEnterCriticalSection(&m_criticalSection) != 0;
+	}
+
+	bool SharedMutexImpl::TryLockShared()
+	{
+		return TryEnterCriticalSection(&m_criticalSection) != 0;
+	}
+
+	void SharedMutexImpl::Unlock()
+	{
+		LeaveCriticalSection(&m_criticalSection);
+	}
+
+	void SharedMutexImpl::UnlockShared()
+	{
+		LeaveCriticalSection(&m_criticalSection);
+	}
+	#endif
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SHAREDMUTEXIMPL_HPP
+#define NAZARA_SHAREDMUTEXIMPL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <windows.h>
+
+namespace Nz
+{
+	class SharedMutexImpl
+	{
+		public:
+			SharedMutexImpl();
+			~SharedMutexImpl();
+
+			void Lock();
+			void LockShared();
+			bool TryLock();
+			bool TryLockShared();
+			void Unlock();
+			void UnlockShared();
+
+		private:
+			#if NAZARA_CORE_WINDOWS_VISTA
+			SRWLOCK m_lock;
+			#else
+			CRITICAL_SECTION m_criticalSection;
+			#endif
+	};
+}
+
+#endif // NAZARA_SHAREDMUTEXIMPL_HPP
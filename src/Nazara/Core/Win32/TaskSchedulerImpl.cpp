@@ -5,13 +5,21 @@
 #include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
-#include <cstdlib> // std::ldiv
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/Win32/ThreadImpl.hpp>
+#include <algorithm>
+#include <limits>
 #include <process.h>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	bool TaskSchedulerImpl::Initialize(std::size_t workerCount)
+	std::size_t TaskSchedulerImpl::GetWorkerCount()
+	{
+		return s_workerCount;
+	}
+
+	bool TaskSchedulerImpl::Initialize(std::size_t workerCount, const UInt64* workerAffinities)
 	{
 		if (IsInitialized())
 			return true; // Déjà initialisé
@@ -25,32 +33,33 @@ namespace Nz
 		#endif
 
 		s_workerCount = static_cast<DWORD>(workerCount);
-		s_doneEvents.reset(new HANDLE[workerCount]);
+		s_shouldFinish = false;
+		s_injectedTaskCount = 0;
+		s_pendingTaskCount = 0;
+		s_queuedTaskCount = 0;
+		s_sleepingWorkerCount = 0;
+
 		s_workers.reset(new Worker[workerCount]);
-		s_workerThreads.reset(new HANDLE[workerCount]);
 
-		// L'identifiant de chaque worker doit rester en vie jusqu'à ce que chaque thread soit correctement lancé
-		std::unique_ptr<std::size_t[]> workerIDs(new std::size_t[workerCount]);
+		#if NAZARA_CORE_WINDOWS_CS_SPINLOCKS > 0
+		InitializeCriticalSectionAndSpinCount(&s_injectionMutex, NAZARA_CORE_WINDOWS_CS_SPINLOCKS);
+		#else
+		InitializeCriticalSection(&s_injectionMutex);
+		#endif
+
+		s_doneEvent = CreateEventW(nullptr, false, false, nullptr); // Auto-reset
+		s_wakeSemaphore = CreateSemaphoreW(nullptr, 0, std::numeric_limits<LONG>::max(), nullptr);
 
 		for (std::size_t i = 0; i < workerCount; ++i)
 		{
-			// On initialise les évènements, mutex et threads de chaque worker
 			Worker& worker = s_workers[i];
-			InitializeCriticalSection(&worker.queueMutex);
-			worker.wakeEvent = CreateEventW(nullptr, false, false, nullptr);
-			worker.running = true;
-			worker.workCount = 0;
+			worker.affinity = (workerAffinities) ? workerAffinities[i] : 0;
+			worker.id = static_cast<unsigned int>(i);
+			worker.seed = static_cast<unsigned int>(i) * 2654435761U + 1;
 
-			s_doneEvents[i] = CreateEventW(nullptr, true, false, nullptr);
-
-			// Le thread va se lancer, signaler qu'il est prêt à travailler (s_doneEvents) et attendre d'être réveillé
-			workerIDs[i] = i;
-			s_workerThreads[i] = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &WorkerProc, &workerIDs[i], 0, nullptr));
+			worker.thread = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &WorkerProc, &worker, 0, nullptr));
 		}
 
-		// On attend que les workers se mettent en attente
-		WaitForMultipleObjects(s_workerCount, &s_doneEvents[0], true, INFINITE);
-
 		return true;
 	}
 
@@ -59,76 +68,101 @@ namespace Nz
 		return s_workerCount > 0;
 	}
 
+	unsigned int TaskSchedulerImpl::GetWorkerIndex()
+	{
+		NazaraAssert(s_currentWorker, "Calling thread is not a worker");
+
+		return s_currentWorker->id;
+	}
+
+	bool TaskSchedulerImpl::IsWorkerThread()
+	{
+		return s_currentWorker != nullptr;
+	}
+
 	void TaskSchedulerImpl::Run(Functor** tasks, std::size_t count)
 	{
-		// On s'assure que des tâches ne sont pas déjà en cours
-		WaitForMultipleObjects(s_workerCount, &s_doneEvents[0], true, INFINITE);
+		if (count == 0)
+			return;
 
-		std::lldiv_t div = std::lldiv(count, s_workerCount); // Division et modulo en une opération, y'a pas de petit profit
-		for (std::size_t i = 0; i < s_workerCount; ++i)
-		{
-			// On va maintenant répartir les tâches entre chaque worker et les envoyer dans la queue de chacun
-			Worker& worker = s_workers[i];
-			std::size_t taskCount = (i == 0) ? div.quot + div.rem : div.quot;
-			for (std::size_t j = 0; j < taskCount; ++j)
-				worker.queue.push(*tasks++);
+		// The counters must be increased before the tasks are made visible, a thief could run them immediately
+		s_pendingTaskCount += count;
+		s_queuedTaskCount += count;
 
-			// On stocke le nombre de tâches à côté dans un entier atomique pour éviter d'entrer inutilement dans une section critique
-			worker.workCount = taskCount;
+		if (s_currentWorker)
+		{
+			// Tasks spawned from a worker go to its own deque, no lock involved
+			for (std::size_t i = 0; i < count; ++i)
+				s_currentWorker->queue.Push(tasks[i]);
 		}
-
-		// On les lance une fois qu'ils sont tous initialisés (pour éviter qu'un worker ne passe en pause détectant une absence de travaux)
-		for (std::size_t i = 0; i < s_workerCount; ++i)
+		else
 		{
-			ResetEvent(s_doneEvents[i]);
-			SetEvent(s_workers[i].wakeEvent);
+			// Tasks coming from outside are injected all at once, workers will take them by batches
+			EnterCriticalSection(&s_injectionMutex);
+			s_injectedTasks.insert(s_injectedTasks.end(), tasks, tasks + count);
+			s_injectedTaskCount += count;
+			LeaveCriticalSection(&s_injectionMutex);
 		}
+
+		WakeWorkers(count);
 	}
 
-	void TaskSchedulerImpl::Uninitialize()
+	bool TaskSchedulerImpl::TryExecuteTask()
 	{
 		#ifdef NAZARA_CORE_SAFE
 		if (s_workerCount == 0)
 		{
 			NazaraError("Task scheduler is not initialized");
-			return;
+			return false;
 		}
 		#endif
 
-		// On commence par vider la queue de chaque worker pour s'assurer qu'ils s'arrêtent
-		for (unsigned int i = 0; i < s_workerCount; ++i)
-		{
-			Worker& worker = s_workers[i];
-			worker.running = false;
-			worker.workCount = 0;
-
-			EnterCriticalSection(&worker.queueMutex);
+		Functor* task = FetchTask(s_currentWorker);
+		if (!task)
+			return false;
 
-			std::queue<Functor*> emptyQueue;
-			std::swap(worker.queue, emptyQueue); // Et on vide la queue (merci std::swap)
+		--s_queuedTaskCount;
+		ExecuteTask(task);
 
-			LeaveCriticalSection(&worker.queueMutex);
+		return true;
+	}
 
-			// On réveille le worker pour qu'il sorte de la boucle et termine le thread
-			SetEvent(worker.wakeEvent);
+	void TaskSchedulerImpl::Uninitialize()
+	{
+		#ifdef NAZARA_CORE_SAFE
+		if (s_workerCount == 0)
+		{
+			NazaraError("Task scheduler is not initialized");
+			return;
 		}
+		#endif
 
-		// On attend que chaque thread se termine
-		WaitForMultipleObjects(s_workerCount, &s_workerThreads[0], true, INFINITE);
+		// On réveille les workers pour qu'ils sortent de la boucle et terminent
+		s_shouldFinish = true;
+		ReleaseSemaphore(s_wakeSemaphore, s_workerCount, nullptr);
 
-		// Et on libère les ressources
-		for (unsigned int i = 0; i < s_workerCount; ++i)
+		// On attend que chaque thread se termine
+		for (DWORD i = 0; i < s_workerCount; ++i)
 		{
-			Worker& worker = s_workers[i];
-			CloseHandle(s_doneEvents[i]);
-			CloseHandle(s_workerThreads[i]);
-			CloseHandle(worker.wakeEvent);
-			DeleteCriticalSection(&worker.queueMutex);
+			WaitForSingleObject(s_workers[i].thread, INFINITE);
+			CloseHandle(s_workers[i].thread);
 		}
 
-		s_doneEvents.reset();
-		s_workers.reset();
-		s_workerThreads.reset();
+		// Les tâches restantes ne seront jamais exécutées
+		for (Functor* task : s_injectedTasks)
+			delete task;
+
+		s_injectedTasks.clear();
+		s_workers.reset(); // Clears the deques
+
+		// Et on libère les ressources
+		CloseHandle(s_doneEvent);
+		CloseHandle(s_wakeSemaphore);
+		DeleteCriticalSection(&s_injectionMutex);
+
+		s_injectedTaskCount = 0;
+		s_pendingTaskCount = 0;
+		s_queuedTaskCount = 0;
 		s_workerCount = 0;
 	}
 
@@ -140,109 +174,155 @@ namespace Nz
 			NazaraError("Task scheduler is not initialized");
 			return;
 		}
+
+		if (s_currentWorker)
+		{
+			NazaraError("A worker cannot wait for every task");
+			return;
+		}
 		#endif
 
-		WaitForMultipleObjects(s_workerCount, &s_doneEvents[0], true, INFINITE);
+		// The done event may have been signaled by a previous batch, hence the loop
+		while (s_pendingTaskCount > 0)
+			WaitForSingleObject(s_doneEvent, INFINITE);
+	}
+
+	void TaskSchedulerImpl::ExecuteTask(Functor* task)
+	{
+		// On exécute la tâche avant de la supprimer
+		task->Run();
+		delete task;
+
+		if (--s_pendingTaskCount == 0)
+			SetEvent(s_doneEvent);
 	}
 
-	Functor* TaskSchedulerImpl::StealTask(std::size_t workerID)
+	Functor* TaskSchedulerImpl::FetchTask(Worker* worker)
 	{
-		bool shouldRetry;
-		do
+		// Our own work first (most recent task, still hot in cache)
+		if (worker)
 		{
-			shouldRetry = false;
-			for (std::size_t i = 0; i < s_workerCount; ++i)
+			if (Functor* task = worker->queue.Pop())
+				return task;
+		}
+
+		// Then tasks coming from outside, workers take their share of them to reduce contention on the injection mutex
+		Functor* task = nullptr;
+		if (s_injectedTaskCount > 0)
+		{
+			EnterCriticalSection(&s_injectionMutex);
+			if (!s_injectedTasks.empty())
 			{
-				// On ne vole pas la famille, ni soi-même.
-				if (i == workerID)
-					continue;
-
-				Worker& worker = s_workers[i];
-
-				// Ce worker a-t-il encore des tâches dans sa file d'attente ?
-				if (worker.workCount > 0)
-				{
-					Functor* task = nullptr;
-
-					// Est-ce qu'il utilise la queue maintenant ?
-					if (TryEnterCriticalSection(&worker.queueMutex))
-					{
-						// Non, super ! Profitons-en pour essayer de lui voler un job
-						if (!worker.queue.empty()) // On vérifie que la queue n'est pas vide (peut avoir changé avant le verrouillage)
-						{
-							// Et hop, on vole la tâche
-							task = worker.queue.front();
-							worker.queue.pop();
-							worker.workCount = worker.queue.size();
-						}
-
-						LeaveCriticalSection(&worker.queueMutex);
-					}
-					else
-						shouldRetry = true; // Il est encore possible d'avoir un job
-
-					// Avons-nous notre tâche ?
-					if (task)
-						return task; // Parfait, sortons de là !
-				}
+				std::size_t injectedCount = s_injectedTasks.size();
+				std::size_t batchSize = (worker) ? std::max<std::size_t>(injectedCount / s_workerCount, 1) : 1;
+
+				task = s_injectedTasks.back();
+				for (std::size_t i = 1; i < batchSize; ++i)
+					worker->queue.Push(s_injectedTasks[injectedCount - i - 1]);
+
+				s_injectedTasks.resize(injectedCount - batchSize);
+				s_injectedTaskCount -= batchSize;
 			}
+			LeaveCriticalSection(&s_injectionMutex);
+
+			if (task)
+				return task;
 		}
-		while (shouldRetry);
 
-		// Bon à priori plus aucun worker n'a de tâche
-		return nullptr;
+		// Nothing left for us, let's steal from the workers
+		return StealTask(worker);
 	}
 
-	unsigned int __stdcall TaskSchedulerImpl::WorkerProc(void* userdata)
+	Functor* TaskSchedulerImpl::StealTask(Worker* thief)
 	{
-		unsigned int workerID = *static_cast<unsigned int*>(userdata);
-		SetEvent(s_doneEvents[workerID]);
+		// Random starting victim to spread thieves among the workers
+		DWORD offset = 0;
+		if (thief)
+		{
+			thief->seed = thief->seed * 1103515245U + 12345U;
+			offset = (thief->seed >> 16) % s_workerCount;
+		}
+
+		for (DWORD i = 0; i < s_workerCount; ++i)
+		{
+			Worker& victim = s_workers[(offset + i) % s_workerCount];
+			if (&victim == thief)
+				continue;
 
-		Worker& worker = s_workers[workerID];
-		WaitForSingleObject(worker.wakeEvent, INFINITE);
+			if (Functor* task = victim.queue.Steal())
+				return task;
+		}
 
-		while (worker.running)
+		return nullptr;
+	}
+
+	bool TaskSchedulerImpl::TryConsumeSleeper()
+	{
+		unsigned int sleepingCount = s_sleepingWorkerCount;
+		while (sleepingCount > 0)
 		{
-			Functor* task = nullptr;
+			if (s_sleepingWorkerCount.compare_exchange_weak(sleepingCount, sleepingCount - 1))
+				return true;
+		}
 
-			if (worker.workCount > 0) // Permet d'éviter d'entrer inutilement dans une section critique
-			{
-				EnterCriticalSection(&worker.queueMutex);
-				if (!worker.queue.empty()) // Nécessaire car le workCount peut être tombé à zéro juste avant l'entrée dans la section critique
-				{
-					task = worker.queue.front();
-					worker.queue.pop();
-					worker.workCount = worker.queue.size();
-				}
-				LeaveCriticalSection(&worker.queueMutex);
-			}
+		return false;
+	}
+
+	void TaskSchedulerImpl::WakeWorkers(std::size_t count)
+	{
+		// Paired with the sleeping worker check: either it sees the queued tasks or we see it sleeping
+		LONG wakeCount = 0;
+		while (static_cast<std::size_t>(wakeCount) < count && TryConsumeSleeper())
+			wakeCount++;
+
+		if (wakeCount > 0)
+			ReleaseSemaphore(s_wakeSemaphore, wakeCount, nullptr);
+	}
 
-			// Que faire quand vous n'avez plus de travail ?
-			if (!task)
-				task = StealTask(workerID); // Voler le travail des autres !
+	unsigned int __stdcall TaskSchedulerImpl::WorkerProc(void* userdata)
+	{
+		Worker& worker = *static_cast<Worker*>(userdata);
+		s_currentWorker = &worker;
+
+		ThreadImpl::SetCurrentThreadName("Nz Worker #" + String::Number(worker.id));
+		if (worker.affinity != 0)
+			ThreadImpl::SetCurrentThreadAffinity(worker.affinity);
 
+		while (!s_shouldFinish)
+		{
+			Functor* task = FetchTask(&worker);
 			if (task)
 			{
-				// On exécute la tâche avant de la supprimer
-				task->Run();
-				delete task;
+				--s_queuedTaskCount;
+				ExecuteTask(task);
 			}
-			else
+			else if (s_queuedTaskCount == 0)
 			{
-				SetEvent(s_doneEvents[workerID]);
-				WaitForSingleObject(worker.wakeEvent, INFINITE);
+				++s_sleepingWorkerCount;
+
+				// If some work arrived in the meantime, we try to cancel our sleep
+				// If a producer already counted us, its semaphore token is ours and waiting will return immediately
+				if ((s_queuedTaskCount == 0 && !s_shouldFinish) || !TryConsumeSleeper())
+					WaitForSingleObject(s_wakeSemaphore, INFINITE);
 			}
+			// Otherwise a task is being pushed or we lost a race against another thief, retry
 		}
 
-		// Au cas où un thread attendrait sur WaitForTasks() pendant qu'un autre appellerait Uninitialize()
-		// Ça ne devrait pas arriver, mais comme ça ne coûte pas grand chose..
-		SetEvent(s_doneEvents[workerID]);
+		s_currentWorker = nullptr;
 
 		return 0;
 	}
 
-	std::unique_ptr<HANDLE[]> TaskSchedulerImpl::s_doneEvents; // Doivent être contigus
 	std::unique_ptr<TaskSchedulerImpl::Worker[]> TaskSchedulerImpl::s_workers;
-	std::unique_ptr<HANDLE[]> TaskSchedulerImpl::s_workerThreads; // Doivent être contigus
+	std::vector<Functor*> TaskSchedulerImpl::s_injectedTasks;
+	std::atomic_bool TaskSchedulerImpl::s_shouldFinish;
+	std::atomic_size_t TaskSchedulerImpl::s_injectedTaskCount;
+	std::atomic_size_t TaskSchedulerImpl::s_pendingTaskCount;
+	std::atomic_size_t TaskSchedulerImpl::s_queuedTaskCount;
+	std::atomic_uint TaskSchedulerImpl::s_sleepingWorkerCount;
+	CRITICAL_SECTION TaskSchedulerImpl::s_injectionMutex;
+	HANDLE TaskSchedulerImpl::s_doneEvent;
+	HANDLE TaskSchedulerImpl::s_wakeSemaphore;
 	DWORD TaskSchedulerImpl::s_workerCount;
+	thread_local TaskSchedulerImpl::Worker* TaskSchedulerImpl::s_currentWorker = nullptr;
 }
@@ -9,9 +9,10 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/WorkStealingQueue.hpp>
 #include <atomic>
 #include <memory>
-#include <queue>
+#include <vector>
 #include <windows.h>
 
 namespace Nz
@@ -22,30 +23,48 @@ namespace Nz
 			TaskSchedulerImpl() = delete;
 			~TaskSchedulerImpl() = delete;
 
-			static bool Initialize(std::size_t workerCount);
+			static std::size_t GetWorkerCount();
+			static unsigned int GetWorkerIndex();
+			static bool Initialize(std::size_t workerCount, const UInt64* workerAffinities = nullptr);
 			static bool IsInitialized();
+			static bool IsWorkerThread();
 			static void Run(Functor** tasks, std::size_t count);
+			static bool TryExecuteTask();
 			static void Uninitialize();
 			static void WaitForTasks();
 
 		private:
-			static Functor* StealTask(std::size_t workerID);
+			struct Worker;
+
+			static void ExecuteTask(Functor* task);
+			static Functor* FetchTask(Worker* worker);
+			static Functor* StealTask(Worker* thief);
+			static bool TryConsumeSleeper();
+			static void WakeWorkers(std::size_t count);
 			static unsigned int __stdcall WorkerProc(void* userdata);
 
 			struct Worker
 			{
-				std::atomic_size_t workCount;
-				std::queue<Functor*> queue;
-				CRITICAL_SECTION queueMutex;
-				HANDLE wakeEvent;
-				volatile bool running;
+				WorkStealingQueue queue;
+				HANDLE thread;
+				UInt64 affinity;
+				unsigned int id;
+				unsigned int seed;
 			};
 
-			static std::unique_ptr<HANDLE[]> s_doneEvents; // Doivent être contigus
 			static std::unique_ptr<Worker[]> s_workers;
-			static std::unique_ptr<HANDLE[]> s_workerThreads; // Doivent être contigus
+			static std::vector<Functor*> s_injectedTasks;
+			static std::atomic_bool s_shouldFinish;
+			static std::atomic_size_t s_injectedTaskCount;
+			static std::atomic_size_t s_pendingTaskCount;
+			static std::atomic_size_t s_queuedTaskCount;
+			static std::atomic_uint s_sleepingWorkerCount;
+			static CRITICAL_SECTION s_injectionMutex;
+			static HANDLE s_doneEvent;
+			static HANDLE s_wakeSemaphore;
 			static DWORD s_workerCount;
-};
+			static thread_local Worker* s_currentWorker;
+	};
 }
 
 #endif // NAZARA_TASKSCHEDULERIMPL_HPP
@@ -5,11 +5,54 @@
 #include <Nazara/Core/Win32/ThreadImpl.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/String.hpp>
 #include <process.h>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// SetThreadDescription is only available since Windows 10 (1607)
+		using SetThreadDescriptionFunc = HRESULT (WINAPI*)(HANDLE thread, PCWSTR description);
+
+		SetThreadDescriptionFunc GetSetThreadDescription()
+		{
+			static SetThreadDescriptionFunc func = reinterpret_cast<SetThreadDescriptionFunc>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+			return func;
+		}
+
+		#ifdef NAZARA_COMPILER_MSVC
+		// Source: https://msdn.microsoft.com/en-us/library/xcb2z8hs.aspx
+		#pragma pack(push, 8)
+		struct ThreadNameInfo
+		{
+			DWORD type;
+			LPCSTR name;
+			DWORD threadId;
+			DWORD flags;
+		};
+		#pragma pack(pop)
+
+		void RaiseThreadNameException(DWORD threadId, const char* name)
+		{
+			ThreadNameInfo info;
+			info.type = 0x1000;
+			info.name = name;
+			info.threadId = threadId;
+			info.flags = 0;
+
+			__try
+			{
+				RaiseException(0x406D1388, 0, sizeof(info) / sizeof(ULONG_PTR), reinterpret_cast<ULONG_PTR*>(&info));
+			}
+			__except (EXCEPTION_EXECUTE_HANDLER)
+			{
+			}
+		}
+		#endif
+	}
+
 	ThreadImpl::ThreadImpl(Functor* functor)
 	{
 		m_handle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &ThreadImpl::ThreadProc, functor, 0, nullptr));
@@ -29,6 +72,74 @@ namespace Nz
 		CloseHandle(m_handle);
 	}
 
+	bool ThreadImpl::SetAffinity(UInt64 processorMask)
+	{
+		return SetAffinity(m_handle, processorMask);
+	}
+
+	bool ThreadImpl::SetName(const String& name)
+	{
+		return SetName(m_handle, name);
+	}
+
+	bool ThreadImpl::SetPriority(ThreadPriority priority)
+	{
+		return SetPriority(m_handle, priority);
+	}
+
+	bool ThreadImpl::SetCurrentThreadAffinity(UInt64 processorMask)
+	{
+		return SetAffinity(GetCurrentThread(), processorMask);
+	}
+
+	bool ThreadImpl::SetCurrentThreadName(const String& name)
+	{
+		return SetName(GetCurrentThread(), name);
+	}
+
+	bool ThreadImpl::SetCurrentThreadPriority(ThreadPriority priority)
+	{
+		return SetPriority(GetCurrentThread(), priority);
+	}
+
+	bool ThreadImpl::SetAffinity(HANDLE handle, UInt64 processorMask)
+	{
+		return SetThreadAffinityMask(handle, static_cast<DWORD_PTR>(processorMask)) != 0;
+	}
+
+	bool ThreadImpl::SetName(HANDLE handle, const String& name)
+	{
+		SetThreadDescriptionFunc setThreadDescription = GetSetThreadDescription();
+		if (setThreadDescription)
+			return SUCCEEDED(setThreadDescription(handle, name.GetWideString().data()));
+
+		#ifdef NAZARA_COMPILER_MSVC
+		// Older systems only know the name through the attached debugger
+		if (IsDebuggerPresent())
+		{
+			RaiseThreadNameException(GetThreadId(handle), name.GetConstBuffer());
+			return true;
+		}
+		#endif
+
+		return false;
+	}
+
+	bool ThreadImpl::SetPriority(HANDLE handle, ThreadPriority priority)
+	{
+		static const int priorities[] = {
+			THREAD_PRIORITY_LOWEST,       // ThreadPriority_Lowest
+			THREAD_PRIORITY_BELOW_NORMAL, // ThreadPriority_Low
+			THREAD_PRIORITY_NORMAL,       // ThreadPriority_Normal
+			THREAD_PRIORITY_ABOVE_NORMAL, // ThreadPriority_High
+			THREAD_PRIORITY_HIGHEST       // ThreadPriority_Highest
+		};
+
+		static_assert(sizeof(priorities)/sizeof(int) == ThreadPriority_Max+1, "Thread priority array is incomplete");
+
+		return SetThreadPriority(handle, priorities[priority]) != 0;
+	}
+
 	unsigned int __stdcall ThreadImpl::ThreadProc(void* userdata)
 	{
 		Functor* func = static_cast<Functor*>(userdata);
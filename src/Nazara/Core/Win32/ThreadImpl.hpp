@@ -10,11 +10,13 @@
 #define NAZARA_THREADIMPL_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Enums.hpp>
 #include <windows.h>
 
 namespace Nz
 {
 	struct Functor;
+	class String;
 
 	class ThreadImpl
 	{
@@ -24,9 +26,19 @@ namespace Nz
 			void Detach();
 			void Join();
 
+			bool SetAffinity(UInt64 processorMask);
+			bool SetName(const String& name);
+			bool SetPriority(ThreadPriority priority);
+
+			static bool SetCurrentThreadAffinity(UInt64 processorMask);
+			static bool SetCurrentThreadName(const String& name);
+			static bool SetCurrentThreadPriority(ThreadPriority priority);
 			static void Sleep(UInt32 time);
 
 		private:
+			static bool SetAffinity(HANDLE handle, UInt64 processorMask);
+			static bool SetName(HANDLE handle, const String& name);
+			static bool SetPriority(HANDLE handle, ThreadPriority priority);
 			static unsigned int __stdcall ThreadProc(void* userdata);
 
 			HANDLE m_handle;
@@ -0,0 +1,130 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/WorkStealingQueue.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <Nazara/Core/Debug.hpp>
+
+// Chase-Lev deque, following "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013)
+// The owner pushes and pops at the bottom, thieves take from the top
+
+namespace Nz
+{
+	WorkStealingQueue::WorkStealingQueue(std::size_t capacity) :
+	m_top(0),
+	m_bottom(0)
+	{
+		m_buffers.emplace_back(new Buffer(GetNearestPowerOfTwo(std::max<std::size_t>(capacity, 2))));
+		m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+	}
+
+	WorkStealingQueue::~WorkStealingQueue()
+	{
+		Clear();
+	}
+
+	void WorkStealingQueue::Clear()
+	{
+		// Owner only, the workers must be stopped
+		while (Functor* task = Pop())
+			delete task;
+	}
+
+	bool WorkStealingQueue::IsEmpty() const
+	{
+		Int64 bottom = m_bottom.load(std::memory_order_relaxed);
+		Int64 top = m_top.load(std::memory_order_relaxed);
+
+		return bottom <= top;
+	}
+
+	Functor* WorkStealingQueue::Pop()
+	{
+		Int64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		m_bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Int64 top = m_top.load(std::memory_order_relaxed);
+
+		Functor* task = nullptr;
+		if (top <= bottom)
+		{
+			task = buffer->Get(bottom);
+			if (top == bottom)
+			{
+				// Last task, we are racing against thieves
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					task = nullptr;
+
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+		}
+		else
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+		return task;
+	}
+
+	void WorkStealingQueue::Push(Functor* task)
+	{
+		Int64 bottom = m_bottom.load(std::memory_order_relaxed);
+		Int64 top = m_top.load(std::memory_order_acquire);
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+		if (bottom - top > static_cast<Int64>(buffer->capacity) - 1)
+			buffer = Grow(buffer, top, bottom);
+
+		buffer->Put(bottom, task);
+		std::atomic_thread_fence(std::memory_order_release);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+
+	Functor* WorkStealingQueue::Steal()
+	{
+		Int64 top = m_top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		Int64 bottom = m_bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+		Functor* task = buffer->Get(top);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr; // Lost the race against another thief or the owner
+
+		return task;
+	}
+
+	WorkStealingQueue::Buffer* WorkStealingQueue::Grow(Buffer* buffer, Int64 top, Int64 bottom)
+	{
+		std::unique_ptr<Buffer> newBuffer(new Buffer(buffer->capacity * 2));
+		for (Int64 i = top; i < bottom; ++i)
+			newBuffer->Put(i, buffer->Get(i));
+
+		Buffer* newBufferPtr = newBuffer.get();
+		m_buffers.emplace_back(std::move(newBuffer));
+		m_buffer.store(newBufferPtr, std::memory_order_release);
+
+		return newBufferPtr;
+	}
+
+	WorkStealingQueue::Buffer::Buffer(std::size_t bufferCapacity) :
+	capacity(bufferCapacity),
+	mask(bufferCapacity - 1),
+	tasks(new std::atomic<Functor*>[bufferCapacity])
+	{
+	}
+
+	Functor* WorkStealingQueue::Buffer::Get(Int64 index) const
+	{
+		return tasks[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+	}
+
+	void WorkStealingQueue::Buffer::Put(Int64 index, Functor* task)
+	{
+		tasks[static_cast<std::size_t>(index) & mask].store(task, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_WORKSTEALINGQUEUE_HPP
+#define NAZARA_WORKSTEALINGQUEUE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Functor.hpp>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Nz
+{
+	class WorkStealingQueue
+	{
+		public:
+			WorkStealingQueue(std::size_t capacity = 256);
+			WorkStealingQueue(const WorkStealingQueue&) = delete;
+			WorkStealingQueue(WorkStealingQueue&&) = delete;
+			~WorkStealingQueue();
+
+			void Clear();
+
+			bool IsEmpty() const;
+
+			Functor* Pop();
+			void Push(Functor* task);
+
+			Functor* Steal();
+
+			WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+			WorkStealingQueue& operator=(WorkStealingQueue&&) = delete;
+
+		private:
+			struct Buffer
+			{
+				Buffer(std::size_t bufferCapacity);
+
+				Functor* Get(Int64 index) const;
+				void Put(Int64 index, Functor* task);
+
+				std::size_t capacity;
+				std::size_t mask;
+				std::unique_ptr<std::atomic<Functor*>[]> tasks;
+			};
+
+			Buffer* Grow(Buffer* buffer, Int64 top, Int64 bottom);
+
+			std::atomic<Int64> m_top;
+			std::atomic<Int64> m_bottom;
+			std::atomic<Buffer*> m_buffer;
+			std::vector<std::unique_ptr<Buffer>> m_buffers; // Old buffers may still be read by thieves, we keep them alive
+	};
+}
+
+#endif // NAZARA_WORKSTEALINGQUEUE_HPP
@@ -3,6 +3,10 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Renderer/TextureStreamer.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -15,6 +19,22 @@ namespace Nz
 	* \remark This class is abstract
 	*/
 
+	/*!
+	* \brief Constructs an AbstractRenderQueue object
+	*
+	* Per-frame data of the queue (lights, and transparent/custom drawables for derived queues) is allocated from a double-buffered frame arena, reset by Clear
+	*/
+
+	AbstractRenderQueue::AbstractRenderQueue() :
+	m_frameArena(std::make_unique<FrameArena>()),
+	m_viewer(nullptr),
+	m_textureStreamer(nullptr)
+	{
+		directionalLights = FrameVector<DirectionalLight>(*m_frameArena);
+		pointLights = FrameVector<PointLight>(*m_frameArena);
+		spotLights = FrameVector<SpotLight>(*m_frameArena);
+	}
+
 	AbstractRenderQueue::~AbstractRenderQueue() = default;
 
 	/*!
@@ -60,8 +80,56 @@ namespace Nz
 	{
 		NazaraUnused(fully);
 
-		directionalLights.clear();
-		pointLights.clear();
-		spotLights.clear();
+		m_stats = Stats();
+
+		// Containers using the arena have to be released before their frame gets reused, which happens on the next call
+		m_frameArena->NextFrame();
+
+		directionalLights = FrameVector<DirectionalLight>(*m_frameArena);
+		pointLights = FrameVector<PointLight>(*m_frameArena);
+		spotLights = FrameVector<SpotLight>(*m_frameArena);
+	}
+
+	/*!
+	* \brief Gets the arena holding the per-frame data of the queue
+	* \return Reference to the frame arena
+	*
+	* \remark Memory allocated from it is valid until the second call to Clear following the allocation
+	*/
+
+	FrameArena& AbstractRenderQueue::GetFrameArena()
+	{
+		return *m_frameArena;
+	}
+	/*!
+	* \brief Requests the resolution the textures of a material need for a mesh, from its size on screen
+	*
+	* \param material Material of the mesh
+	* \param meshAABB Box of the mesh
+	* \param transformMatrix Matrix of the mesh
+	*
+	* \remark The textures are assumed to be mapped once over the mesh
+	*/
+
+	void AbstractRenderQueue::RequestTextureResolutions(const Material* material, const Boxf& meshAABB, const Matrix4f& transformMatrix)
+	{
+		if (!m_textureStreamer || !m_viewer)
+			return;
+
+		Vector3f scale = transformMatrix.GetScale();
+		Vector3f center = transformMatrix.Transform(meshAABB.GetCenter());
+		float radius = meshAABB.GetRadius() * std::max({scale.x, scale.y, scale.z});
+
+		// The projection scales the size by 1/tan(fov/2), and perspective divides it by the distance
+		const Matrix4f& projectionMatrix = m_viewer->GetProjectionMatrix();
+		float distance = (projectionMatrix.m44 == 0.f) ? std::max(center.Distance(m_viewer->GetEyePosition()), m_viewer->GetZNear()) : 1.f;
+		float resolution = radius * projectionMatrix.m22 * m_viewer->GetViewport().height / distance;
+
+		const TextureRef* maps[] = {&material->GetAlphaMap(), &material->GetDiffuseMap(), &material->GetEmissiveMap(), &material->GetHeightMap(), &material->GetNormalMap(), &material->GetSpecularMap()};
+		for (const TextureRef* map : maps)
+		{
+			if (map->IsValid())
+				m_textureStreamer->RequestResolution(*map, resolution);
+		}
 	}
 }
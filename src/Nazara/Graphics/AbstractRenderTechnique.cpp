@@ -6,6 +6,9 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Graphics/RenderTechniques.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <algorithm>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -61,4 +64,177 @@ namespace Nz
 	{
 		return m_instancingEnabled;
 	}
+
+	/*!
+	* \brief Draws meshes sharing their buffers with a single multi-draw call
+	*
+	* \param entries Meshes to draw, every one of them must be batchable with the others
+	* \param entryCount Number of meshes
+	*
+	* \remark The instances of the meshes must be in the current instance buffer, one mesh after the other
+	*/
+
+	void AbstractRenderTechnique::DrawMeshBatch(const MeshBatchEntry* entries, unsigned int entryCount) const
+	{
+		NazaraAssert(entryCount > 0, "Invalid entry count");
+
+		// The buffers starting first in the shared buffers are bound, the other meshes are reached from them
+		const IndexBuffer* indexBuffer = entries[0].meshData->indexBuffer;
+		const VertexBuffer* vertexBuffer = entries[0].meshData->vertexBuffer;
+		for (unsigned int i = 1; i < entryCount; ++i)
+		{
+			const MeshData& meshData = *entries[i].meshData;
+
+			if (meshData.indexBuffer->GetStartOffset() < indexBuffer->GetStartOffset())
+				indexBuffer = meshData.indexBuffer;
+
+			if (meshData.vertexBuffer->GetStartOffset() < vertexBuffer->GetStartOffset())
+				vertexBuffer = meshData.vertexBuffer;
+		}
+
+		unsigned int indexStride = indexBuffer->GetStride();
+		unsigned int vertexStride = vertexBuffer->GetStride();
+
+		m_indirectCommands.resize(entryCount);
+
+		unsigned int firstInstance = 0;
+		for (unsigned int i = 0; i < entryCount; ++i)
+		{
+			const MeshData& meshData = *entries[i].meshData;
+
+			Renderer::DrawIndexedIndirectCommand& command = m_indirectCommands[i];
+			command.indexCount = meshData.indexBuffer->GetIndexCount();
+			command.instanceCount = static_cast<UInt32>(entries[i].instances->size());
+			command.firstIndex = (meshData.indexBuffer->GetStartOffset() - indexBuffer->GetStartOffset()) / indexStride;
+			command.baseVertex = static_cast<Int32>((meshData.vertexBuffer->GetStartOffset() - vertexBuffer->GetStartOffset()) / vertexStride);
+			command.firstInstance = firstInstance;
+
+			firstInstance += command.instanceCount;
+		}
+
+		Renderer::SetIndexBuffer(indexBuffer);
+		Renderer::SetVertexBuffer(vertexBuffer);
+		Renderer::DrawIndexedPrimitivesIndirect(entries[0].meshData->primitiveMode, m_indirectCommands.data(), entryCount);
+	}
+
+	/*!
+	* \brief Draws together the instanced meshes sharing their buffers
+	*
+	* \param meshInstances Meshes of a material, the instances of the drawn meshes are cleared
+	* \param maxInstanceCount Maximum number of instances streamed at once
+	* \param applyMaterial Function applying the material, called before the first draw
+	* \param streamInstances Function copying instances to the instance buffer and making it current
+	*
+	* \remark Meshes which could not be batched keep their instances and must be drawn the usual way
+	*/
+
+	void AbstractRenderTechnique::DrawMeshBatches(ForwardRenderQueue::MeshInstanceContainer& meshInstances, unsigned int maxInstanceCount, const std::function<void()>& applyMaterial, const InstanceStreamer& streamInstances) const
+	{
+		m_meshBatchEntries.clear();
+		for (auto& meshIt : meshInstances)
+		{
+			std::vector<Matrix4f>& instances = meshIt.second.instances;
+			if (!instances.empty() && instances.size() <= maxInstanceCount && IsMeshBatchable(meshIt.first))
+				m_meshBatchEntries.push_back(MeshBatchEntry{&meshIt.first, &instances});
+		}
+
+		std::stable_sort(m_meshBatchEntries.begin(), m_meshBatchEntries.end(), [] (const MeshBatchEntry& entry1, const MeshBatchEntry& entry2)
+		{
+			return MeshBatchLess(*entry1.meshData, *entry2.meshData);
+		});
+
+		bool materialApplied = false;
+		for (std::size_t batchStart = 0; batchStart < m_meshBatchEntries.size();)
+		{
+			const MeshBatchEntry& firstEntry = m_meshBatchEntries[batchStart];
+			unsigned int instanceCount = static_cast<unsigned int>(firstEntry.instances->size());
+
+			std::size_t batchEnd = batchStart + 1;
+			while (batchEnd < m_meshBatchEntries.size() && !MeshBatchLess(*firstEntry.meshData, *m_meshBatchEntries[batchEnd].meshData))
+			{
+				unsigned int entryInstanceCount = static_cast<unsigned int>(m_meshBatchEntries[batchEnd].instances->size());
+				if (instanceCount + entryInstanceCount > maxInstanceCount)
+					break;
+
+				instanceCount += entryInstanceCount;
+				++batchEnd;
+			}
+
+			// A single mesh gains nothing from a multi-draw
+			if (batchEnd - batchStart > 1)
+			{
+				if (!materialApplied)
+				{
+					applyMaterial();
+					materialApplied = true;
+				}
+
+				m_meshBatchInstances.clear();
+				for (std::size_t i = batchStart; i < batchEnd; ++i)
+					m_meshBatchInstances.insert(m_meshBatchInstances.end(), m_meshBatchEntries[i].instances->begin(), m_meshBatchEntries[i].instances->end());
+
+				if (streamInstances(m_meshBatchInstances.data(), instanceCount))
+				{
+					DrawMeshBatch(&m_meshBatchEntries[batchStart], static_cast<unsigned int>(batchEnd - batchStart));
+
+					for (std::size_t i = batchStart; i < batchEnd; ++i)
+						m_meshBatchEntries[i].instances->clear();
+				}
+			}
+
+			batchStart = batchEnd;
+		}
+	}
+
+	/*!
+	* \brief Checks whether a mesh can be drawn by a multi-draw call
+	* \return true If the mesh is indexed, its indices are aligned and it is not skinned
+	*
+	* \param meshData Data of the mesh
+	*/
+
+	bool AbstractRenderTechnique::IsMeshBatchable(const MeshData& meshData)
+	{
+		const IndexBuffer* indexBuffer = meshData.indexBuffer;
+
+		return indexBuffer && indexBuffer->GetStartOffset() % indexBuffer->GetStride() == 0 && !meshData.skeleton;
+	}
+
+	/*!
+	* \brief Orders meshes so that those which can be drawn together follow each other
+	* \return true If the first mesh comes before the second one
+	*
+	* \param mesh1 First mesh
+	* \param mesh2 Second mesh
+	*
+	* \remark Meshes are batchable together when neither comes before the other: they share their buffers, their vertex declaration and their primitive mode
+	*/
+
+	bool AbstractRenderTechnique::MeshBatchLess(const MeshData& mesh1, const MeshData& mesh2)
+	{
+		if (mesh1.primitiveMode != mesh2.primitiveMode)
+			return mesh1.primitiveMode < mesh2.primitiveMode;
+
+		const IndexBuffer* indexBuffer1 = mesh1.indexBuffer;
+		const IndexBuffer* indexBuffer2 = mesh2.indexBuffer;
+		if (indexBuffer1->GetBuffer() != indexBuffer2->GetBuffer())
+			return indexBuffer1->GetBuffer() < indexBuffer2->GetBuffer();
+
+		if (indexBuffer1->GetStride() != indexBuffer2->GetStride())
+			return indexBuffer1->GetStride() < indexBuffer2->GetStride();
+
+		const VertexBuffer* vertexBuffer1 = mesh1.vertexBuffer;
+		const VertexBuffer* vertexBuffer2 = mesh2.vertexBuffer;
+		if (vertexBuffer1->GetBuffer() != vertexBuffer2->GetBuffer())
+			return vertexBuffer1->GetBuffer() < vertexBuffer2->GetBuffer();
+
+		if (vertexBuffer1->GetVertexDeclaration() != vertexBuffer2->GetVertexDeclaration())
+			return vertexBuffer1->GetVertexDeclaration() < vertexBuffer2->GetVertexDeclaration();
+
+		// The offsets between the meshes must be whole numbers of vertices
+		unsigned int vertexAlignment1 = vertexBuffer1->GetStartOffset() % vertexBuffer1->GetStride();
+		unsigned int vertexAlignment2 = vertexBuffer2->GetStartOffset() % vertexBuffer2->GetStride();
+
+		return vertexAlignment1 < vertexAlignment2;
+	}
 }
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/DeferredBloomPass.hpp>
+#include <Nazara/Graphics/DeferredRenderTechnique.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
@@ -37,7 +38,9 @@ namespace Nz
 		m_gaussianBlurShaderFilterLocation = m_gaussianBlurShader->GetUniformLocation("Filter");
 
 		for (unsigned int i = 0; i < 2; ++i)
-			m_bloomTextures[i] = Texture::New();
+			m_bloomTextures[i] = nullptr;
+
+		m_bloomRTT.Create();
 	}
 
 	DeferredBloomPass::~DeferredBloomPass() = default;
@@ -88,6 +91,7 @@ namespace Nz
 	*
 	* \param i Index of the texture
 	*
+	* \remark Bloom textures are borrowed from the technique during the processing of the pass only, nullptr is returned outside of it
 	* \remark Produces a NazaraError with NAZARA_GRAPHICS_SAFE defined if index is invalid
 	*/
 
@@ -117,6 +121,20 @@ namespace Nz
 	{
 		NazaraUnused(sceneData);
 
+		// The blur targets only live for the duration of the pass, other passes may reuse them afterwards
+		for (unsigned int i = 0; i < 2; ++i)
+			m_bloomTextures[i] = m_deferredTechnique->AcquireTransientTexture(PixelFormatType_RGBA8, m_dimensions.x / 8, m_dimensions.y / 8);
+
+		if (!m_bloomTextures[0] || !m_bloomTextures[1])
+		{
+			NazaraError("Failed to acquire bloom textures");
+			ReleaseTextures();
+			return false;
+		}
+
+		for (unsigned int i = 0; i < 2; ++i)
+			m_bloomRTT.AttachTexture(AttachmentPoint_Color, i, m_bloomTextures[i]);
+
 		Renderer::SetRenderStates(m_bloomStates);
 		Renderer::SetTextureSampler(0, m_bilinearSampler);
 		Renderer::SetTextureSampler(1, m_bilinearSampler);
@@ -169,35 +187,26 @@ namespace Nz
 		Renderer::SetTexture(1, m_workTextures[secondWorkTexture]);
 		Renderer::DrawFullscreenQuad();
 
+		ReleaseTextures();
+
 		return true;
 	}
 
 	/*!
-	* \brief Resizes the texture sizes
-	* \return true If successful
-	*
-	* \param dimensions Dimensions for the compute texture
+	* \brief Gives back the blur textures to the transient pool of the technique
 	*/
 
-	bool DeferredBloomPass::Resize(const Vector2ui& dimensions)
+	void DeferredBloomPass::ReleaseTextures() const
 	{
-		DeferredRenderPass::Resize(dimensions);
-
-		m_bloomRTT.Create(true);
 		for (unsigned int i = 0; i < 2; ++i)
 		{
-			m_bloomTextures[i]->Create(ImageType_2D, PixelFormatType_RGBA8, dimensions.x / 8, dimensions.y / 8);
-			m_bloomRTT.AttachTexture(AttachmentPoint_Color, i, m_bloomTextures[i]);
-		}
-		m_bloomRTT.Unlock();
-
-		if (!m_bloomRTT.IsComplete())
-		{
-			NazaraError("Incomplete RTT");
-			return false;
+			if (m_bloomTextures[i])
+			{
+				m_bloomRTT.Detach(AttachmentPoint_Color, i);
+				m_deferredTechnique->ReleaseTransientTexture(m_bloomTextures[i]);
+				m_bloomTextures[i] = nullptr;
+			}
 		}
-
-		return true;
 	}
 
 	/*!
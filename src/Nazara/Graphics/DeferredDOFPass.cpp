@@ -4,6 +4,7 @@
 
 #include <Nazara/Graphics/DeferredDOFPass.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/DeferredRenderTechnique.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
 #include <memory>
@@ -27,7 +28,7 @@ namespace Nz
 
 			"uniform sampler2D BlurTexture;\n"
 			"uniform sampler2D ColorTexture;\n"
-			"uniform sampler2D GBuffer1;\n"
+			"uniform sampler2D GBuffer2;\n"
 			"uniform vec2 InvTargetSize;" "\n"
 
 			"float Distance = 30.0;\n"
@@ -46,7 +47,7 @@ namespace Nz
 				"// Get our bloom pixel from bloom texture\n"
 				"vec3 blur = textureLod(BlurTexture, texCoord, 0.0).rgb;\n"
 
-				"float depth = textureLod(GBuffer1, texCoord, 0.0).w;\n"
+				"float depth = textureLod(GBuffer2, texCoord, 0.0).x;\n"
 				"depth = (2.0 * 0.1) / (1000.0 + 0.1 - depth * (1000.0 - 0.1));"
 				"depth = 1.0 - depth;\n"
 
@@ -111,13 +112,15 @@ namespace Nz
 		m_dofShader = BuildDepthOfFieldShader();
 		m_dofShader->SendInteger(m_dofShader->GetUniformLocation("ColorTexture"), 0);
 		m_dofShader->SendInteger(m_dofShader->GetUniformLocation("BlurTexture"), 1);
-		m_dofShader->SendInteger(m_dofShader->GetUniformLocation("GBuffer1"), 2);
+		m_dofShader->SendInteger(m_dofShader->GetUniformLocation("GBuffer2"), 2);
 
 		m_gaussianBlurShader = ShaderLibrary::Get("DeferredGaussianBlur");
 		m_gaussianBlurShaderFilterLocation = m_gaussianBlurShader->GetUniformLocation("Filter");
 
 		for (unsigned int i = 0; i < 2; ++i)
-			m_dofTextures[i] = Texture::New();
+			m_dofTextures[i] = nullptr;
+
+		m_dofRTT.Create();
 
 		m_bilinearSampler.SetAnisotropyLevel(1);
 		m_bilinearSampler.SetFilterMode(SamplerFilter_Bilinear);
@@ -145,6 +148,20 @@ namespace Nz
 	{
 		NazaraUnused(sceneData);
 
+		// The blur targets only live for the duration of the pass, other passes may reuse them afterwards
+		for (unsigned int i = 0; i < 2; ++i)
+			m_dofTextures[i] = m_deferredTechnique->AcquireTransientTexture(PixelFormatType_RGBA8, m_dimensions.x/4, m_dimensions.y/4);
+
+		if (!m_dofTextures[0] || !m_dofTextures[1])
+		{
+			NazaraError("Failed to acquire depth of field textures");
+			ReleaseTextures();
+			return false;
+		}
+
+		for (unsigned int i = 0; i < 2; ++i)
+			m_dofRTT.AttachTexture(AttachmentPoint_Color, i, m_dofTextures[i]);
+
 		Renderer::SetTextureSampler(0, m_pointSampler);
 		Renderer::SetTextureSampler(1, m_bilinearSampler);
 		Renderer::SetTextureSampler(2, m_pointSampler);
@@ -179,37 +196,28 @@ namespace Nz
 		Renderer::SetShader(m_dofShader);
 		Renderer::SetTexture(0, m_workTextures[secondWorkTexture]);
 		Renderer::SetTexture(1, m_dofTextures[1]);
-		Renderer::SetTexture(2, m_GBuffer[1]);
+		Renderer::SetTexture(2, m_GBuffer[2]);
 		Renderer::DrawFullscreenQuad();
 
+		ReleaseTextures();
+
 		return true;
 	}
 
 	/*!
-	* \brief Resizes the texture sizes
-	* \return true If successful
-	*
-	* \param dimensions Dimensions for the compute texture
+	* \brief Gives back the blur textures to the transient pool of the technique
 	*/
 
-	bool DeferredDOFPass::Resize(const Vector2ui& dimensions)
+	void DeferredDOFPass::ReleaseTextures() const
 	{
-		DeferredRenderPass::Resize(dimensions);
-
-		m_dofRTT.Create(true);
 		for (unsigned int i = 0; i < 2; ++i)
 		{
-			m_dofTextures[i]->Create(ImageType_2D, PixelFormatType_RGBA8, dimensions.x/4, dimensions.y/4);
-			m_dofRTT.AttachTexture(AttachmentPoint_Color, i, m_dofTextures[i]);
-		}
-		m_dofRTT.Unlock();
-
-		if (!m_dofRTT.IsComplete())
-		{
-			NazaraError("Incomplete RTT");
-			return false;
+			if (m_dofTextures[i])
+			{
+				m_dofRTT.Detach(AttachmentPoint_Color, i);
+				m_deferredTechnique->ReleaseTransientTexture(m_dofTextures[i]);
+				m_dofTextures[i] = nullptr;
+			}
 		}
-
-		return true;
 	}
 }
@@ -44,6 +44,21 @@ namespace Nz
 
 	DeferredFinalPass::~DeferredFinalPass() = default;
 
+	/*!
+	* \brief Gets the stage of the final pass in a fused shader
+	* \return true, the final pass only copies the pixels to the target of the viewer
+	*
+	* \param stage Output stage
+	*/
+
+	bool DeferredFinalPass::GetFusedStage(FusedStage* stage) const
+	{
+		stage->declarations.Clear();
+		stage->function.Clear();
+
+		return true;
+	}
+
 	/*!
 	* \brief Processes the work on the data while working with textures
 	* \return true
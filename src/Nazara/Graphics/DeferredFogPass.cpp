@@ -13,6 +13,30 @@ namespace Nz
 {
 	namespace
 	{
+		// Shared by the fog shader and the fused post-process shaders
+		const char* s_fogDeclarations =
+		"uniform sampler2D FogDepthTexture;\n"
+
+		"vec4 ApplyFog(vec4 color, vec2 texCoord)\n"
+		"{\n"
+		"\t" "const float n = 0.1;\n"
+		"\t" "const float f = 1000.0;\n"
+
+		"\t" "float depth = textureLod(FogDepthTexture, texCoord, 0.0).x*2.0 - 1.0;\n"
+		"\t" "float linearDepth = (2.0 * n) / (f + n - depth * (f - n));\n"
+
+		"\t" "float lumThreshold = 0.8;\n"
+		"\t" "float luminosity = dot(color.rgb, vec3(0.299, 0.587, 0.114));\n"
+		"\t" "float lumFactor = max(luminosity - lumThreshold, 0.0) / (1.0-lumThreshold);\n"
+
+		"\t" "vec4 fogColor = vec4(0.5, 0.5, 0.5, 1.0);\n"
+		"\t" "vec2 fogrange = vec2(0, 50);\n"
+		"\t" "float fogeffect = clamp( 1.0 - (fogrange.y - linearDepth*0.5*f) / (fogrange.y - fogrange.x) , 0.0, 1.0 ) * fogColor.w;\n"
+		"\t" "fogeffect = max(fogeffect-lumFactor, 0.0);\n"
+
+		"\t" "return vec4(color.rgb*(1.0-fogeffect) + fogColor.rgb * fogeffect, 1.0);\n"
+		"}\n";
+
 		/*!
 		* \brief Builds the shader for the fog
 		* \return Reference to the shader newly created
@@ -20,63 +44,20 @@ namespace Nz
 
 		ShaderRef BuildFogShader()
 		{
-			/*const UInt8 fragmentSource[] = {
-					#include <Nazara/Graphics/Resources/DeferredShading/Shaders/FXAA.frag.h>
-			};*/
-
-			const char* fragmentSource =
+			String fragmentSource =
 			"#version 140\n"
 
 			"out vec4 RenderTarget0;\n"
 
 			"uniform sampler2D ColorTexture;\n"
-			"uniform sampler2D GBuffer2;\n"
-			"uniform mat4 InvViewProjMatrix;\n"
-			"uniform vec2 InvTargetSize;\n"
-			"uniform vec3 EyePosition;\n"
-
-			"float n = 0.1;"
-			"float f = 1000.0;"
-
-			"float color_to_float(vec3 color)\n"
-			"{\n"
-				"const vec3 byte_to_float = vec3(1.0, 1.0/256, 1.0/(256*256));\n"
-				"return dot(color, byte_to_float);\n"
-			"}\n"
+			"uniform vec2 InvTargetSize;\n";
 
+			fragmentSource += s_fogDeclarations;
+			fragmentSource +=
 			"void main()\n"
-			"{"
-			"vec2 texCoord = gl_FragCoord.xy * InvTargetSize;\n"
-			"\t" "vec3 color = texture(ColorTexture, texCoord).xyz;\n"
-			"vec4 gVec2 = textureLod(GBuffer2, texCoord, 0.0);\n"
-			"float depth = color_to_float(gVec2.xyz)*2.0 - 1.0;\n"
-			"float linearDepth = (2 * n) / (f + n - depth * (f - n));"
-
-			"vec3 viewSpace = vec3(texCoord*2.0 - 1.0, depth);\n"
-
-			"vec4 worldPos = InvViewProjMatrix * vec4(viewSpace, 1.0);\n"
-			"worldPos.xyz /= worldPos.w;\n"
-
-			/*"float lumThreshold = 0.1;"
-			"float lumMultipler = 2.0;"
-			//"float lumFactor = max(dot(color, vec3(0.299, 0.587, 0.114)) - lumThreshold, 0.0) / (1.0-lumThreshold);"
-			"float fogFactor = (1.0 - clamp(worldPos.y-2.0, 0.0, 1.0)) - lumFactor*lumMultipler;"
-			"fogFactor += (1.0 - clamp(EyePosition.y-2.5, 0.0, 1.0));"
-			"fogFactor = clamp(fogFactor, 0.0, 1.0);"*/
-
-			"float lumThreshold = 0.8;"
-			"float lumMultipler = 2.0;"
-			"float luminosity = dot(color, vec3(0.299, 0.587, 0.114));"
-			"float lumFactor = max(luminosity - lumThreshold, 0.0) / (1.0-lumThreshold);"
-
-			"vec4 fogColor = vec4(0.5, 0.5, 0.5, 1.0);\n"
-			"vec2 fogrange = vec2(0, 50);\n"
-			"float fogeffect = clamp( 1.0 - (fogrange.y - linearDepth*0.5*f) / (fogrange.y - fogrange.x) , 0.0, 1.0 ) * fogColor.w;\n"
-			"fogeffect = max(fogeffect-lumFactor, 0.0);"
-
-			//fogeffect*=(1.0 - int(depth));
-			"\t" "vec3 fragmentColor = color*(1.0-fogeffect) + fogColor.rgb * fogeffect;\n"
-			"\t" "RenderTarget0 = vec4(fragmentColor, 1.0);\n"
+			"{\n"
+			"\t" "vec2 texCoord = gl_FragCoord.xy * InvTargetSize;\n"
+			"\t" "RenderTarget0 = ApplyFog(texture(ColorTexture, texCoord), texCoord);\n"
 			"}";
 
 			const char* vertexSource =
@@ -97,7 +78,7 @@ namespace Nz
 					return nullptr;
 			}
 
-			if (!shader->AttachStageFromSource(ShaderStageType_Fragment, fragmentSource/*String(reinterpret_cast<const char*>(fragmentSource), sizeof(fragmentSource))*/))
+			if (!shader->AttachStageFromSource(ShaderStageType_Fragment, fragmentSource))
 			{
 					NazaraError("Failed to load fragment shader");
 					return nullptr;
@@ -116,7 +97,7 @@ namespace Nz
 			}
 
 			shader->SendInteger(shader->GetUniformLocation("ColorTexture"), 0);
-			shader->SendInteger(shader->GetUniformLocation("GBuffer2"), 1);
+			shader->SendInteger(shader->GetUniformLocation("FogDepthTexture"), 1);
 
 			return shader;
 		}
@@ -146,6 +127,39 @@ namespace Nz
 
 	DeferredFogPass::~DeferredFogPass() = default;
 
+	/*!
+	* \brief Binds the depth texture of the fog in a fused shader
+	*
+	* \param sceneData Data for the scene
+	* \param shader Fused shader
+	* \param textureUnit First texture unit available, incremented by the one used by the fog
+	*/
+
+	void DeferredFogPass::ApplyFusedStage(const SceneData& sceneData, const Shader* shader, UInt8* textureUnit) const
+	{
+		NazaraUnused(sceneData);
+
+		UInt8 unit = (*textureUnit)++;
+		Renderer::SetTexture(unit, m_GBuffer[2]);
+		Renderer::SetTextureSampler(unit, m_pointSampler);
+		shader->SendInteger(shader->GetUniformLocation("FogDepthTexture"), unit);
+	}
+
+	/*!
+	* \brief Gets the stage of the fog in a fused shader
+	* \return true, the fog only depends on the color and the depth of the pixel
+	*
+	* \param stage Output stage
+	*/
+
+	bool DeferredFogPass::GetFusedStage(FusedStage* stage) const
+	{
+		stage->declarations = s_fogDeclarations;
+		stage->function = "ApplyFog";
+
+		return true;
+	}
+
 	/*!
 	* \brief Processes the work on the data while working with textures
 	* \return true
@@ -8,6 +8,7 @@
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/DeferredRenderTechnique.hpp>
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
@@ -58,7 +59,7 @@ namespace Nz
 
 		bool instancingEnabled = m_deferredTechnique->IsInstancingEnabled();
 
-		m_GBufferRTT->SetColorTargets({0, 1, 2}); // G-Buffer
+		m_GBufferRTT->SetColorTargets({0, 1}); // G-Buffer
 		Renderer::SetTarget(m_GBufferRTT);
 		Renderer::SetViewport(Recti(0, 0, m_dimensions.x, m_dimensions.y));
 
@@ -96,21 +97,9 @@ namespace Nz
 						if (useInstancing)
 							flags |= ShaderFlags_Instancing;
 
-						const Shader* shader = material->Apply(flags);
-
-						// The uniforms are conserved in our program, there's no point to send them back if they don't change
-						if (shader != lastShader)
-						{
-							// Index of uniforms in the shader
-							shaderUniforms = GetShaderUniforms(shader);
-
-							// Ambient color for the scene
-							shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-							// Position of the camera
-							shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
-
-							lastShader = shader;
-						}
+						const Shader* shader = nullptr;
+						bool skinning = false;
+						UInt8 skinningTextureUnit = 0;
 
 						// Meshes
 						for (auto& meshIt : meshInstances)
@@ -121,6 +110,37 @@ namespace Nz
 							std::vector<Matrix4f>& instances = meshEntry.instances;
 							if (!instances.empty())
 							{
+								// Meshes skinned on the GPU come last and need the shader reading their joints from a texture
+								bool skinned = (meshData.skeleton != nullptr);
+								if (!shader || skinned != skinning)
+								{
+									UInt8 freeTextureUnit;
+									shader = material->Apply((skinned) ? flags | ShaderFlags_Skinning : flags, 0, &freeTextureUnit);
+
+									// The uniforms are conserved in our program, there's no point to send them back if they don't change
+									if (shader != lastShader)
+									{
+										// Index of uniforms in the shader
+										shaderUniforms = GetShaderUniforms(shader);
+
+										// Ambient color for the scene
+										shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+										// Position of the camera
+										shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+										lastShader = shader;
+									}
+
+									skinning = skinned;
+									skinningTextureUnit = freeTextureUnit;
+								}
+
+								if (skinning)
+								{
+									SkinningManager::BindSkinningTexture(meshData.skeleton, skinningTextureUnit);
+									shader->SendInteger(shaderUniforms->skinningMatrices, skinningTextureUnit);
+								}
+
 								const IndexBuffer* indexBuffer = meshData.indexBuffer;
 								const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
 
@@ -193,6 +213,10 @@ namespace Nz
 			}
 		}
 
+		// The lighting passes read the depth of the G-Buffer while testing against it, they work on a copy
+		Rectui rect(0, 0, m_dimensions.x, m_dimensions.y);
+		RenderTexture::Blit(m_GBufferRTT, rect, m_workRTT, rect, RendererBuffer_Depth | RendererBuffer_Stencil);
+
 		return false; // We only fill the G-Buffer, the work texture are unchanged
 	}
 
@@ -209,9 +233,9 @@ namespace Nz
 
 		/*
 		G-Buffer:
-		Texture0: Diffuse Color + Flags
-		Texture1: Encoded normal
-		Texture2: Specular value + Shininess
+		Texture0: Diffuse Color + Specular
+		Texture1: Encoded normal + Shininess
+		Texture2: Depth + Stencil, positions are reconstructed from it
 		Texture3: N/A
 		*/
 
@@ -225,18 +249,17 @@ namespace Nz
 			m_depthStencilBuffer->Create(PixelFormatType_Depth24Stencil8, width, height);
 
 			m_GBuffer[0]->Create(ImageType_2D, PixelFormatType_RGBA8, width, height); // Texture 0 : Diffuse Color + Specular
-			m_GBuffer[1]->Create(ImageType_2D, PixelFormatType_RG16F, width, height); // Texture 1 : Encoded normal
-			m_GBuffer[2]->Create(ImageType_2D, PixelFormatType_RGBA8, width, height); // Texture 2 : Depth (24bits) + Shininess
+			m_GBuffer[1]->Create(ImageType_2D, PixelFormatType_RGBA8, width, height); // Texture 1 : Octahedral normal (2x12 bits) + Shininess
+			m_GBuffer[2]->Create(ImageType_2D, PixelFormatType_Depth24Stencil8, width, height); // Texture 2 : Depth + Stencil
 
 			m_GBufferRTT->Create(true);
 
 			m_GBufferRTT->AttachTexture(AttachmentPoint_Color, 0, m_GBuffer[0]);
 			m_GBufferRTT->AttachTexture(AttachmentPoint_Color, 1, m_GBuffer[1]);
-			m_GBufferRTT->AttachTexture(AttachmentPoint_Color, 2, m_GBuffer[2]);
 
 			// Texture 3 : Emission map ?
 
-			m_GBufferRTT->AttachBuffer(AttachmentPoint_DepthStencil, 0, m_depthStencilBuffer);
+			m_GBufferRTT->AttachTexture(AttachmentPoint_DepthStencil, 0, m_GBuffer[2]);
 
 			m_GBufferRTT->Unlock();
 
@@ -285,6 +308,7 @@ namespace Nz
 
 			uniforms.eyePosition = shader->GetUniformLocation("EyePosition");
 			uniforms.sceneAmbient = shader->GetUniformLocation("SceneAmbient");
+			uniforms.skinningMatrices = shader->GetUniformLocation("SkinningMatrices");
 			uniforms.textureOverlay = shader->GetUniformLocation("TextureOverlay");
 
 			it = m_shaderUniforms.emplace(shader, std::move(uniforms)).first;
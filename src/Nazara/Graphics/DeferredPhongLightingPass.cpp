@@ -8,11 +8,73 @@
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/RenderTexture.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		/*!
+		* \brief Computes the part of the screen covered by a light volume
+		* \return false If the volume is out of the screen
+		*
+		* \param viewer Viewer of the scene
+		* \param dimensions Dimensions of the screen
+		* \param center Center of the bounding sphere of the volume
+		* \param radius Radius of the bounding sphere of the volume
+		* \param rect Rectangle to fill, in pixels from the top left corner of the screen
+		*/
+
+		bool ComputeLightScissorRect(const AbstractViewer* viewer, const Vector2ui& dimensions, const Vector3f& center, float radius, Recti* rect)
+		{
+			Recti screen(0, 0, dimensions.x, dimensions.y);
+
+			// The projection of a volume crossing the near plane can cover anything
+			float nearDistance = radius + viewer->GetZNear();
+			if (viewer->GetEyePosition().SquaredDistance(center) <= nearDistance * nearDistance)
+			{
+				*rect = screen;
+				return true;
+			}
+
+			Matrix4f viewProjMatrix = viewer->GetViewMatrix() * viewer->GetProjectionMatrix();
+			Boxf box(center - Vector3f(radius), Vector3f(radius * 2.f));
+
+			Vector2f min(std::numeric_limits<float>::infinity());
+			Vector2f max(-std::numeric_limits<float>::infinity());
+			for (unsigned int i = 0; i <= BoxCorner_Max; ++i)
+			{
+				Vector4f position = viewProjMatrix.Transform(Vector4f(box.GetCorner(static_cast<BoxCorner>(i)), 1.f));
+				if (position.w <= 0.f)
+				{
+					*rect = screen;
+					return true;
+				}
+
+				Vector2f ndc(position.x / position.w, position.y / position.w);
+				min.Minimize(ndc);
+				max.Maximize(ndc);
+			}
+
+			min.Maximize(Vector2f(-1.f));
+			max.Minimize(Vector2f(1.f));
+			if (min.x >= max.x || min.y >= max.y)
+				return false;
+
+			int left = static_cast<int>(std::floor((min.x * 0.5f + 0.5f) * dimensions.x));
+			int right = static_cast<int>(std::ceil((max.x * 0.5f + 0.5f) * dimensions.x));
+			int top = static_cast<int>(std::floor((0.5f - max.y * 0.5f) * dimensions.y));
+			int bottom = static_cast<int>(std::ceil((0.5f - min.y * 0.5f) * dimensions.y));
+
+			rect->Set(left, top, right - left, bottom - top);
+			return true;
+		}
+	}
+
 	/*!
 	* \ingroup graphics
 	* \class Nz::DeferredPhongLightingPass
@@ -147,6 +209,7 @@ namespace Nz
 		{
 			// http://www.altdevblogaday.com/2011/08/08/stencil-buffer-optimisation-for-deferred-lights/
 			lightStates.cullingSide = FaceSide_Front;
+			lightStates.scissorTest = true;
 			lightStates.stencilTest = true;
 			lightStates.stencilDepthFail.back = StencilOperation_Invert;
 			lightStates.stencilDepthFail.front = StencilOperation_Invert;
@@ -181,6 +244,13 @@ namespace Nz
 					m_pointSpotLightShader->SendVector(m_pointSpotLightUniforms.locations.parameters1, Vector4f(light.position, light.attenuation));
 					m_pointSpotLightShader->SendVector(m_pointSpotLightUniforms.locations.parameters2, Vector4f(0.f, 0.f, 0.f, light.invRadius));
 
+					// Neither the stencil marking nor the lighting are rasterized out of the projection of the volume
+					Recti scissorRect;
+					if (!ComputeLightScissorRect(sceneData.viewer, m_dimensions, light.position, light.radius * 1.1f, &scissorRect))
+						continue;
+
+					Renderer::SetScissorRect(scissorRect);
+
 					lightMatrix.SetScale(Vector3f(light.radius * 1.1f)); // To correct imperfections due to the sphere
 					lightMatrix.SetTranslation(light.position);
 
@@ -213,6 +283,7 @@ namespace Nz
 					Renderer::Enable(RendererParameter_DepthBuffer, true);
 					Renderer::Enable(RendererParameter_DepthWrite, true);
 					Renderer::Enable(RendererParameter_FaceCulling, false);
+					Renderer::Enable(RendererParameter_ScissorTest, false);
 					Renderer::Enable(RendererParameter_StencilTest, false);
 					Renderer::SetFaceFilling(FaceFilling_Line);
 
@@ -235,6 +306,7 @@ namespace Nz
 					Renderer::Enable(RendererParameter_DepthBuffer, false);
 					Renderer::Enable(RendererParameter_DepthWrite, false);
 					Renderer::Enable(RendererParameter_FaceCulling, true);
+					Renderer::Enable(RendererParameter_ScissorTest, true);
 					Renderer::Enable(RendererParameter_StencilTest, true);
 					Renderer::SetFaceFilling(FaceFilling_Fill);
 				}
@@ -256,6 +328,17 @@ namespace Nz
 					m_pointSpotLightShader->SendVector(m_pointSpotLightUniforms.locations.parameters3, Vector2f(light.innerAngleCosine, light.outerAngleCosine));
 
 					float baseRadius = light.radius * light.outerAngleTangent * 1.1f;
+
+					// Sphere around the cone, from its apex to its base
+					Vector3f coneCenter = light.position + light.direction * (light.radius * 0.5f);
+					float coneRadius = std::sqrt(light.radius * light.radius * 0.25f + baseRadius * baseRadius);
+
+					Recti scissorRect;
+					if (!ComputeLightScissorRect(sceneData.viewer, m_dimensions, coneCenter, coneRadius, &scissorRect))
+						continue;
+
+					Renderer::SetScissorRect(scissorRect);
+
 					lightMatrix.MakeTransform(light.position, Quaternionf::RotationBetween(Vector3f::Forward(), light.direction), Vector3f(baseRadius, baseRadius, light.radius));
 
 					Renderer::SetMatrix(MatrixType_World, lightMatrix);
@@ -288,6 +371,7 @@ namespace Nz
 					Renderer::Enable(RendererParameter_DepthBuffer, true);
 					Renderer::Enable(RendererParameter_DepthWrite, true);
 					Renderer::Enable(RendererParameter_FaceCulling, false);
+					Renderer::Enable(RendererParameter_ScissorTest, false);
 					Renderer::Enable(RendererParameter_StencilTest, false);
 					Renderer::SetFaceFilling(FaceFilling_Line);
 
@@ -310,11 +394,13 @@ namespace Nz
 					Renderer::Enable(RendererParameter_DepthBuffer, false);
 					Renderer::Enable(RendererParameter_DepthWrite, false);
 					Renderer::Enable(RendererParameter_FaceCulling, true);
+					Renderer::Enable(RendererParameter_ScissorTest, true);
 					Renderer::Enable(RendererParameter_StencilTest, true);
 					Renderer::SetFaceFilling(FaceFilling_Fill);
 				}
 			}
 
+			Renderer::Enable(RendererParameter_ScissorTest, false);
 			Renderer::Enable(RendererParameter_StencilTest, false);
 		}
 
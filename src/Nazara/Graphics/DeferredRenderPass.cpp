@@ -26,6 +26,23 @@ namespace Nz
 
 	DeferredRenderPass::~DeferredRenderPass() = default;
 
+	/*!
+	* \brief Binds the textures and sends the uniforms of the stage of the pass in a fused shader
+	*
+	* \param sceneData Data for the scene
+	* \param shader Fused shader, holding the declarations of the stage
+	* \param textureUnit First texture unit available, to be incremented by the number of units used
+	*
+	* \remark Only called if GetFusedStage returned true
+	*/
+
+	void DeferredRenderPass::ApplyFusedStage(const SceneData& sceneData, const Shader* shader, UInt8* textureUnit) const
+	{
+		NazaraUnused(sceneData);
+		NazaraUnused(shader);
+		NazaraUnused(textureUnit);
+	}
+
 	/*!
 	* \brief Enables the deferred rendering
 	*
@@ -37,6 +54,23 @@ namespace Nz
 		m_enabled = enable;
 	}
 
+	/*!
+	* \brief Gets the stage of the pass in a fused shader
+	* \return true If the pass can be fused with the per-pixel passes around it
+	*
+	* \param stage Output stage
+	*
+	* \remark Only passes whose output pixels depend on the same input pixel can be fused, the ones reading the neighbours (blur, antialiasing) cannot
+	* \remark By default, passes cannot be fused
+	*/
+
+	bool DeferredRenderPass::GetFusedStage(FusedStage* stage) const
+	{
+		NazaraUnused(stage);
+
+		return false;
+	}
+
 	/*!
 	* \brief Initializes the deferred forward pass which needs the deferred technique
 	*
@@ -207,6 +207,8 @@ namespace Nz
 
 	void DeferredRenderQueue::AddMesh(int renderOrder, const Material* material, const MeshData& meshData, const Boxf& meshAABB, const Matrix4f& transformMatrix)
 	{
+		RequestTextureResolutions(material, meshAABB, transformMatrix);
+
 		if (material->IsEnabled(RendererParameter_Blend))
 			// One transparent material ? I don't like it, go see if I'm in the forward queue
 			m_forwardQueue->AddMesh(renderOrder, material, meshData, meshAABB, transformMatrix);
@@ -259,11 +261,12 @@ namespace Nz
 	* \param vertices Buffer of data for the sprites
 	* \param spriteCount Number of sprites
 	* \param overlay Texture of the sprites
+	* \param textureLayer Layer of the material diffuse map sampled by the sprites, when it is a texture array
 	*/
 
-	void DeferredRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay)
+	void DeferredRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay, unsigned int textureLayer)
 	{
-		m_forwardQueue->AddSprites(renderOrder, material, vertices, spriteCount, overlay);
+		m_forwardQueue->AddSprites(renderOrder, material, vertices, spriteCount, overlay, textureLayer);
 	}
 
 	/*!
@@ -390,20 +393,10 @@ namespace Nz
 
 	bool DeferredRenderQueue::BatchedModelMaterialComparator::operator()(const Material* mat1, const Material* mat2) const
 	{
-		const UberShader* uberShader1 = mat1->GetShader();
-		const UberShader* uberShader2 = mat2->GetShader();
-		if (uberShader1 != uberShader2)
-			return uberShader1 < uberShader2;
-
-		const Shader* shader1 = mat1->GetShaderInstance(ShaderFlags_Deferred)->GetShader();
-		const Shader* shader2 = mat2->GetShaderInstance(ShaderFlags_Deferred)->GetShader();
-		if (shader1 != shader2)
-			return shader1 < shader2;
-
-		const Texture* diffuseMap1 = mat1->GetDiffuseMap();
-		const Texture* diffuseMap2 = mat2->GetDiffuseMap();
-		if (diffuseMap1 != diffuseMap2)
-			return diffuseMap1 < diffuseMap2;
+		UInt32 sortKey1 = mat1->GetSortKey();
+		UInt32 sortKey2 = mat2->GetSortKey();
+		if (sortKey1 != sortKey2)
+			return sortKey1 < sortKey2;
 
 		return mat1 < mat2;
 	}
@@ -418,6 +411,10 @@ namespace Nz
 
 	bool DeferredRenderQueue::MeshDataComparator::operator()(const MeshData& data1, const MeshData& data2) const
 	{
+		// Meshes skinned on the GPU come last, so that each material switches to its skinning shader only once
+		if (data1.skeleton != data2.skeleton)
+			return data1.skeleton < data2.skeleton;
+
 		const Buffer* buffer1;
 		const Buffer* buffer2;
 
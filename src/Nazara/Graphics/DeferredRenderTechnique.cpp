@@ -21,15 +21,19 @@
 #include <Nazara/Graphics/Drawable.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Graphics/Sprite.hpp>
 #include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/Shader.hpp>
 #include <Nazara/Renderer/ShaderStage.hpp>
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <random>
+#include <stdexcept>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
@@ -118,6 +122,60 @@ namespace Nz
 			ShaderLibrary::Register(name, shader);
 			return shader;
 		}
+
+		/*!
+		* \brief Builds a shader chaining the stages of fused passes
+		* \return Reference to the shader newly created
+		*
+		* \param fragmentSource Source of the fragment stage
+		* \param err Pointer to string to contain error message
+		*/
+
+		ShaderRef BuildFusedShader(const String& fragmentSource, String* err)
+		{
+			ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
+
+			const char vertexSource[] =
+			"#version 140\n"
+
+			"in vec3 VertexPosition;\n"
+
+			"void main()\n"
+			"{\n"
+				"gl_Position = vec4(VertexPosition, 1.0);"
+			"}\n";
+
+			ShaderRef shader = Shader::New();
+			if (!shader->Create())
+			{
+				err->Set("Failed to create shader: " + Error::GetLastError());
+				return nullptr;
+			}
+
+			if (!shader->AttachStageFromSource(ShaderStageType_Fragment, fragmentSource))
+			{
+				err->Set("Failed to attach fragment stage: " + Error::GetLastError());
+				return nullptr;
+			}
+
+			if (!shader->AttachStageFromSource(ShaderStageType_Vertex, vertexSource))
+			{
+				err->Set("Failed to attach vertex stage: " + Error::GetLastError());
+				return nullptr;
+			}
+
+			if (!shader->Link())
+			{
+				err->Set("Failed to link shader: " + Error::GetLastError());
+				return nullptr;
+			}
+
+			shader->SendInteger(shader->GetUniformLocation("ColorTexture"), 0);
+
+			return shader;
+		}
+
+		const unsigned int s_transientTextureLifetime = 60; // Frames a transient texture can stay unused before being freed
 	}
 
 	/*!
@@ -134,16 +192,29 @@ namespace Nz
 
 	DeferredRenderTechnique::DeferredRenderTechnique() :
 	m_renderQueue(static_cast<ForwardRenderQueue*>(m_forwardTechnique.GetRenderQueue())),
-	m_GBufferSize(0U)
+	m_GBufferSize(0U),
+	m_passFusionEnabled(true)
 	{
 		m_depthStencilBuffer = RenderBuffer::New();
 
+		m_fusedSampler.SetAnisotropyLevel(1);
+		m_fusedSampler.SetFilterMode(SamplerFilter_Nearest);
+		m_fusedSampler.SetWrapMode(SamplerWrap_Clamp);
+
+		m_fusedStates.depthBuffer = false;
+
 		for (unsigned int i = 0; i < 2; ++i)
 			m_workTextures[i] = Texture::New();
 
 		for (unsigned int i = 0; i < 3; ++i)
 			m_GBuffer[i] = Texture::New();
-			
+
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize deferred shaders");
+			throw std::runtime_error("Constructor failed");
+		}
+
 		try
 		{
 			ErrorFlags errFlags(ErrorFlag_ThrowException);
@@ -227,6 +298,52 @@ namespace Nz
 
 	DeferredRenderTechnique::~DeferredRenderTechnique() = default;
 
+	/*!
+	* \brief Acquires a texture from the transient pool for the current frame
+	* \return Pointer to the texture or nullptr if it could not be created
+	*
+	* \param format Pixel format of the texture
+	* \param width Width of the texture
+	* \param height Height of the texture
+	*
+	* \remark The texture must be given back with ReleaseTransientTexture as soon as the pass which acquired it no longer reads it, its content is undefined once acquired
+	* \remark Passes whose uses of the pool do not overlap share the same textures when asking for the same format and dimensions
+	*/
+
+	Texture* DeferredRenderTechnique::AcquireTransientTexture(PixelFormatType format, unsigned int width, unsigned int height) const
+	{
+		for (TransientTexture& transientTexture : m_transientTextures)
+		{
+			if (transientTexture.acquired)
+				continue;
+
+			const Texture* texture = transientTexture.texture;
+			if (texture->GetFormat() == format && texture->GetWidth() == width && texture->GetHeight() == height)
+			{
+				transientTexture.acquired = true;
+				transientTexture.used = true;
+
+				return transientTexture.texture;
+			}
+		}
+
+		TextureRef texture = Texture::New();
+		if (!texture->Create(ImageType_2D, format, width, height))
+		{
+			NazaraError("Failed to create transient texture");
+			return nullptr;
+		}
+
+		TransientTexture transientTexture;
+		transientTexture.texture = texture;
+		transientTexture.acquired = true;
+		transientTexture.used = true;
+
+		m_transientTextures.push_back(std::move(transientTexture));
+
+		return texture;
+	}
+
 	/*!
 	* \brief Clears the data
 	*
@@ -250,6 +367,23 @@ namespace Nz
 
 	bool DeferredRenderTechnique::Draw(const SceneData& sceneData) const
 	{
+		static const char* passNames[] =
+		{
+			"DeferredRenderTechnique::AA",       // RenderPassType_AA
+			"DeferredRenderTechnique::Bloom",    // RenderPassType_Bloom
+			"DeferredRenderTechnique::DOF",      // RenderPassType_DOF
+			"DeferredRenderTechnique::Final",    // RenderPassType_Final
+			"DeferredRenderTechnique::Fog",      // RenderPassType_Fog
+			"DeferredRenderTechnique::Forward",  // RenderPassType_Forward
+			"DeferredRenderTechnique::Lighting", // RenderPassType_Lighting
+			"DeferredRenderTechnique::Geometry", // RenderPassType_Geometry
+			"DeferredRenderTechnique::SSAO"      // RenderPassType_SSAO
+		};
+
+		static_assert(sizeof(passNames) / sizeof(const char*) == RenderPassType_Max + 1, "Pass name array is incomplete");
+
+		NazaraGpuZone("DeferredRenderTechnique::Draw");
+
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
 		Recti viewerViewport = sceneData.viewer->GetViewport();
 
@@ -263,21 +397,56 @@ namespace Nz
 			}
 		}
 
-		unsigned int sceneTexture = 0;
-		unsigned int workTexture = 1;
+		// Skeletal meshes skinned on the CPU must be up to date before being drawn
+		SkinningManager::Skin();
+
+		m_enabledPasses.clear();
 		for (auto& passIt : m_passes)
 		{
 			for (auto& passIt2 : passIt.second)
 			{
 				const DeferredRenderPass* pass = passIt2.second.get();
 				if (pass->IsEnabled())
+					m_enabledPasses.emplace_back(passIt.first, pass);
+			}
+		}
+
+		unsigned int sceneTexture = 0;
+		unsigned int workTexture = 1;
+		std::size_t passIndex = 0;
+		while (passIndex < m_enabledPasses.size())
+		{
+			// Consecutive per-pixel passes are drawn at once, by a shader chaining their stages
+			std::size_t fusedPassCount = (m_passFusionEnabled) ? GatherFusedStages(passIndex) : 0;
+			if (fusedPassCount > 1)
+			{
+				NazaraGpuZone("DeferredRenderTechnique::FusedPasses");
+
+				bool swapTextures;
+				if (DrawFusedPasses(sceneData, passIndex, fusedPassCount, workTexture, sceneTexture, &swapTextures))
 				{
-					if (pass->Process(sceneData, workTexture, sceneTexture))
+					if (swapTextures)
 						std::swap(workTexture, sceneTexture);
+
+					passIndex += fusedPassCount;
+					continue;
 				}
 			}
+
+			RenderPassType passType = m_enabledPasses[passIndex].first;
+			const DeferredRenderPass* pass = m_enabledPasses[passIndex].second;
+			{
+				NazaraGpuZone(passNames[passType]);
+
+				if (pass->Process(sceneData, workTexture, sceneTexture))
+					std::swap(workTexture, sceneTexture);
+			}
+
+			passIndex++;
 		}
 
+		UpdateTransientTextures();
+
 		return true;
 	}
 
@@ -300,6 +469,22 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Enables the fusion of the per-pixel passes
+	*
+	* \param enable Should the consecutive passes which can be fused be drawn at once
+	*
+	* \remark Passes like fog and the final one are fused, saving the bandwidth of the intermediate work textures, while antialiasing and blurs still have their own draw
+	* \remark Enabled by default
+	*
+	* \see DeferredRenderPass::GetFusedStage
+	*/
+
+	void DeferredRenderTechnique::EnablePassFusion(bool enable)
+	{
+		m_passFusionEnabled = enable;
+	}
+
 	/*!
 	* \brief Gets the stencil buffer
 	* \return Pointer to the rendering buffer
@@ -446,6 +631,16 @@ namespace Nz
 		return false;
 	}
 
+	/*!
+	* \brief Checks whether the per-pixel passes are fused
+	* \return true If it is the case
+	*/
+
+	bool DeferredRenderTechnique::IsPassFusionEnabled() const
+	{
+		return m_passFusionEnabled;
+	}
+
 	/*!
 	* \brief Resets the pass
 	* \return Pointer to the new deferred render pass
@@ -505,6 +700,22 @@ namespace Nz
 		return smartPtr.release();
 	}
 
+	/*!
+	* \brief Gives back a texture to the transient pool
+	*
+	* \param texture Texture acquired with AcquireTransientTexture
+	*
+	* \remark Produces a NazaraAssert if the texture is not an acquired transient texture
+	*/
+
+	void DeferredRenderTechnique::ReleaseTransientTexture(const Texture* texture) const
+	{
+		auto it = std::find_if(m_transientTextures.begin(), m_transientTextures.end(), [texture] (const TransientTexture& transientTexture) { return transientTexture.texture == texture; });
+		NazaraAssert(it != m_transientTextures.end() && it->acquired, "Texture is not an acquired transient texture");
+
+		it->acquired = false;
+	}
+
 	/*!
 	* \brief Sets the pass
 	*
@@ -538,6 +749,143 @@ namespace Nz
 		return Renderer::GetMaxColorAttachments() >= 4 && Renderer::GetMaxRenderTargets() >= 4;
 	}
 
+	/*!
+	* \brief Draws consecutive passes at once, with a shader chaining their stages
+	* \return true If successful, false if the fused shader is not available and the passes must be processed separately
+	*
+	* \param sceneData Data of the scene
+	* \param firstPass Index of the first pass in the enabled passes
+	* \param passCount Number of passes, whose stages were gathered by GatherFusedStages
+	* \param workTexture Index of the work texture to draw to
+	* \param sceneTexture Index of the work texture holding the scene
+	* \param swapTextures Output telling whether the work textures must be swapped, which is not the case when drawing to the viewer
+	*/
+
+	bool DeferredRenderTechnique::DrawFusedPasses(const SceneData& sceneData, std::size_t firstPass, std::size_t passCount, unsigned int workTexture, unsigned int sceneTexture, bool* swapTextures) const
+	{
+		const Shader* shader = GetFusedShader();
+		if (!shader)
+			return false;
+
+		// The final pass presents the scene to the viewer, the other ones draw to a work texture
+		bool drawToViewer = (m_enabledPasses[firstPass + passCount - 1].first == RenderPassType_Final);
+		if (drawToViewer)
+			sceneData.viewer->ApplyView();
+		else
+		{
+			m_workRTT.SetColorTarget(workTexture);
+			Renderer::SetTarget(&m_workRTT);
+			Renderer::SetViewport(Recti(0, 0, m_GBufferSize.x, m_GBufferSize.y));
+		}
+
+		Renderer::SetRenderStates(m_fusedStates);
+		Renderer::SetShader(shader);
+		Renderer::SetTexture(0, m_workTextures[sceneTexture]);
+		Renderer::SetTextureSampler(0, m_fusedSampler);
+
+		UInt8 textureUnit = 1;
+		for (std::size_t i = firstPass; i < firstPass + passCount; ++i)
+			m_enabledPasses[i].second->ApplyFusedStage(sceneData, shader, &textureUnit);
+
+		Renderer::DrawFullscreenQuad();
+
+		*swapTextures = !drawToViewer;
+		return true;
+	}
+
+	/*!
+	* \brief Gathers the stages of the consecutive passes which can be fused
+	* \return Number of passes gathered
+	*
+	* \param firstPass Index of the first pass in the enabled passes
+	*
+	* \remark A pass whose stage is already gathered (like a second fog pass) ends the gathering, its declarations cannot appear twice in a shader
+	*/
+
+	std::size_t DeferredRenderTechnique::GatherFusedStages(std::size_t firstPass) const
+	{
+		m_fusedStages.clear();
+
+		std::size_t passIndex = firstPass;
+		for (; passIndex < m_enabledPasses.size(); ++passIndex)
+		{
+			DeferredRenderPass::FusedStage stage;
+			if (!m_enabledPasses[passIndex].second->GetFusedStage(&stage))
+				break;
+
+			if (!stage.function.IsEmpty())
+			{
+				auto it = std::find_if(m_fusedStages.begin(), m_fusedStages.end(), [&stage](const DeferredRenderPass::FusedStage& fusedStage)
+				{
+					return fusedStage.function == stage.function;
+				});
+
+				if (it != m_fusedStages.end())
+					break;
+			}
+
+			m_fusedStages.emplace_back(std::move(stage));
+		}
+
+		return passIndex - firstPass;
+	}
+
+	/*!
+	* \brief Gets the shader chaining the gathered stages, building it on first use
+	* \return Pointer to the shader or nullptr if it could not be built
+	*
+	* \remark Produces a NazaraWarning the first time a shader fails to build
+	*/
+
+	const Shader* DeferredRenderTechnique::GetFusedShader() const
+	{
+		String key;
+		for (const DeferredRenderPass::FusedStage& stage : m_fusedStages)
+		{
+			key += stage.function;
+			key += ';';
+		}
+
+		auto it = m_fusedShaders.find(key);
+		if (it != m_fusedShaders.end())
+			return it->second;
+
+		String fragmentSource =
+		"#version 140\n"
+
+		"out vec4 RenderTarget0;\n"
+
+		"uniform sampler2D ColorTexture;\n"
+		"uniform vec2 InvTargetSize;\n";
+
+		for (const DeferredRenderPass::FusedStage& stage : m_fusedStages)
+			fragmentSource += stage.declarations;
+
+		fragmentSource +=
+		"void main()\n"
+		"{\n"
+		"\t" "vec2 texCoord = gl_FragCoord.xy * InvTargetSize;\n"
+		"\t" "vec4 color = texture(ColorTexture, texCoord);\n";
+
+		for (const DeferredRenderPass::FusedStage& stage : m_fusedStages)
+		{
+			if (!stage.function.IsEmpty())
+				fragmentSource += "\t" "color = " + stage.function + "(color, texCoord);\n";
+		}
+
+		fragmentSource +=
+		"\t" "RenderTarget0 = color;\n"
+		"}\n";
+
+		String error;
+		ShaderRef shader = BuildFusedShader(fragmentSource, &error);
+		if (!shader)
+			NazaraWarning("Failed to build fused passes shader, they will be drawn separately: " + error);
+
+		// Failures are cached as well, to only try once
+		return m_fusedShaders.emplace(std::move(key), std::move(shader)).first->second;
+	}
+
 	/*!
 	* \brief Resizes the texture sizes used for the render technique
 	* \return true If successful
@@ -559,6 +907,9 @@ namespace Nz
 
 			m_GBufferSize = dimensions;
 
+			// Textures sized from the previous dimensions won't be asked for anymore
+			m_transientTextures.clear();
+
 			return true;
 		}
 		catch (const std::exception& e)
@@ -573,10 +924,14 @@ namespace Nz
 	* \return true If successful
 	*
 	* \remark Produces a NazaraError if one shader creation failed
+	* \remark Called by the first constructed technique rather than by the Graphics module, as compiling the shaders is expensive
 	*/
 
 	bool DeferredRenderTechnique::Initialize()
 	{
+		if (s_initialized)
+			return true;
+
 		const char vertexSource_Basic[] =
 		"#version 140\n"
 
@@ -705,6 +1060,7 @@ namespace Nz
 			NazaraWarning("Failed to register gaussian blur shader, certain features will not work: " + error);
 		}
 
+		s_initialized = true;
 		return true;
 	}
 
@@ -714,6 +1070,11 @@ namespace Nz
 
 	void DeferredRenderTechnique::Uninitialize()
 	{
+		if (!s_initialized)
+			return;
+
+		s_initialized = false;
+
 		ShaderLibrary::Unregister("DeferredGBufferClear");
 		ShaderLibrary::Unregister("DeferredDirectionnalLight");
 		ShaderLibrary::Unregister("DeferredPointSpotLight");
@@ -723,6 +1084,33 @@ namespace Nz
 		ShaderLibrary::Unregister("DeferredGaussianBlur");
 	}
 
+	/*!
+	* \brief Frees the transient textures no pass acquired for a while
+	*
+	* \remark Produces a NazaraAssert if a transient texture was not released by the pass which acquired it
+	*/
+
+	void DeferredRenderTechnique::UpdateTransientTextures() const
+	{
+		for (TransientTexture& transientTexture : m_transientTextures)
+		{
+			NazaraAssert(!transientTexture.acquired, "Transient texture was not released");
+
+			if (transientTexture.used)
+				transientTexture.unusedFrameCount = 0;
+			else
+				transientTexture.unusedFrameCount++;
+
+			transientTexture.used = false;
+		}
+
+		// Disabled passes don't keep their intermediate textures alive
+		m_transientTextures.erase(std::remove_if(m_transientTextures.begin(), m_transientTextures.end(), [] (const TransientTexture& transientTexture)
+		{
+			return transientTexture.unusedFrameCount > s_transientTextureLifetime;
+		}), m_transientTextures.end());
+	}
+
 	/*!
 	* \brief Functor to compare two render pass
 	* \return true If first render pass is "smaller" than the second one
@@ -735,4 +1123,6 @@ namespace Nz
 	{
 		return RenderPassPriority[pass1] < RenderPassPriority[pass2];
 	}
+
+	bool DeferredRenderTechnique::s_initialized = false;
 }
@@ -376,11 +376,12 @@ namespace Nz
 	* \param vertices Buffer of data for the sprites
 	* \param spriteCount Number of sprites
 	* \param overlay Texture of the sprites
+	* \param textureLayer Layer of the material diffuse map sampled by the sprites, when it is a texture array
 	*
 	* \remark Produces a NazaraAssert if material is invalid
 	*/
 
-	void DepthRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay)
+	void DepthRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay, unsigned int textureLayer)
 	{
 		NazaraAssert(material, "Invalid material");
 		NazaraUnused(renderOrder);
@@ -394,7 +395,7 @@ namespace Nz
 		else
 			material = m_baseMaterial;
 
-		ForwardRenderQueue::AddSprites(0, material, vertices, spriteCount, overlay);
+		ForwardRenderQueue::AddSprites(0, material, vertices, spriteCount, overlay, textureLayer);
 	}
 }
 
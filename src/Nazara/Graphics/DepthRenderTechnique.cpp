@@ -10,12 +10,15 @@
 #include <Nazara/Graphics/Drawable.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Graphics/Sprite.hpp>
 #include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
@@ -48,14 +51,47 @@ namespace Nz
 	*/
 
 	DepthRenderTechnique::DepthRenderTechnique() :
-		m_vertexBuffer(BufferType_Vertex)
+		m_vertexBuffer(BufferType_Vertex, s_vertexBufferSize),
+		m_cubemapFlags(0),
+		m_cubemapFaceMask(0),
+		m_layeredMaterialsSkipped(false),
+		m_nonLayeredMaterialsSkipped(false)
 	{
 		ErrorFlags flags(ErrorFlag_ThrowException, true);
 
-		m_vertexBuffer.Create(s_vertexBufferSize, DataStorage_Hardware, BufferUsage_Dynamic);
+		m_billboardPointBuffer.Reset(&s_billboardVertexDeclaration, m_vertexBuffer.GetBuffer());
+		m_spriteBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ_Color_UV), m_vertexBuffer.GetBuffer());
+	}
+
+	/*!
+	* \brief Draws to a single face again, after EnableCubemapLayering
+	*/
+
+	void DepthRenderTechnique::DisableCubemapLayering()
+	{
+		m_cubemapFlags = 0;
+	}
+
+	/*!
+	* \brief Draws every face of a layered cubemap target at once
+	*
+	* A geometry shader projects each triangle with the matrix of every face it touches, and routes it to the layer of that face.
+	* The view and projection matrices of the renderer are not used for the meshes (the billboards are still oriented by the view matrix).
+	*
+	* \param viewProjMatrices View-projection matrices of the six faces, in the order of CubemapFace
+	* \param faceMask Bit mask of the faces to draw (faces of which no caster is visible can be skipped)
+	*
+	* \remark The render target must have its depth attached with RenderTexture::AttachLayeredTexture
+	* \remark Materials whose shader does not handle FLAG_CUBEMAPLAYERED (only Basic does) are skipped, see HasSkippedNonLayeredMaterials
+	*/
 
-		m_billboardPointBuffer.Reset(&s_billboardVertexDeclaration, &m_vertexBuffer);
-		m_spriteBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ_Color_UV), &m_vertexBuffer);
+	void DepthRenderTechnique::EnableCubemapLayering(const Matrix4f* viewProjMatrices, UInt8 faceMask)
+	{
+		NazaraAssert(viewProjMatrices, "Invalid matrices");
+
+		std::copy(viewProjMatrices, viewProjMatrices + 6, m_cubemapViewProjMatrices.begin());
+		m_cubemapFaceMask = faceMask;
+		m_cubemapFlags = ShaderFlags_CubemapLayered;
 	}
 
 	/*!
@@ -84,6 +120,13 @@ namespace Nz
 
 	bool DepthRenderTechnique::Draw(const SceneData& sceneData) const
 	{
+		NazaraGpuZone("DepthRenderTechnique::Draw");
+
+		// Skeletal meshes skinned on the CPU must be up to date before being drawn
+		SkinningManager::Skin();
+
+		m_nonLayeredMaterialsSkipped = false;
+
 		for (auto& pair : m_renderQueue.layers)
 		{
 			ForwardRenderQueue::Layer& layer = pair.second;
@@ -101,6 +144,9 @@ namespace Nz
 				drawable->Draw();
 		}
 
+		// Parts of the stream buffer used by this frame may only be overwritten once the GPU is done with them
+		m_vertexBuffer.EndFrame();
+
 		return true;
 	}
 
@@ -220,6 +266,9 @@ namespace Nz
 			const Material* material = matIt.first;
 			auto& matEntry = matIt.second;
 
+			if (!IsMaterialDrawn(material))
+				continue;
+
 			if (matEntry.enabled)
 			{
 				auto& overlayMap = matEntry.overlayMap;
@@ -232,7 +281,7 @@ namespace Nz
 					if (spriteChainCount > 0)
 					{
 						// We begin to apply the material (and get the shader activated doing so)
-						UInt32 flags = 0;
+						UInt32 flags = m_cubemapFlags;
 						if (overlay)
 							flags |= ShaderFlags_TextureOverlay;
 
@@ -256,6 +305,7 @@ namespace Nz
 							shader->SendInteger(shaderUniforms->textureOverlay, overlayUnit);
 							// Position of the camera
 							shader->SendVector(shaderUniforms->eyePosition, Renderer::GetMatrix(MatrixType_ViewProj).GetTranslation());
+							SendCubemapUniforms(shader, shaderUniforms);
 
 							lastShader = shader;
 						}
@@ -265,17 +315,25 @@ namespace Nz
 
 						do
 						{
-							// We open the buffer in writing mode
-							BufferMapper<VertexBuffer> vertexMapper(m_spriteBuffer, BufferAccess_DiscardAndWrite);
-							VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(vertexMapper.GetPointer());
+							unsigned int maxSpriteCount = std::min(s_maxQuads, m_spriteBuffer.GetVertexCount()/4);
+
+							// We count the sprites of this batch first, only them are streamed
+							unsigned int batchSpriteCount = 0;
+							for (unsigned int chain = spriteChain, chainOffset = spriteChainOffset; chain < spriteChainCount && batchSpriteCount < maxSpriteCount; ++chain, chainOffset = 0)
+								batchSpriteCount += std::min(maxSpriteCount - batchSpriteCount, spriteChainVector[chain].spriteCount - chainOffset);
+
+							// We suballocate them from the stream buffer, without waiting on the previous draws
+							unsigned int vertexOffset;
+							VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(m_vertexBuffer.Map(batchSpriteCount*4*sizeof(VertexStruct_XYZ_Color_UV), sizeof(VertexStruct_XYZ_Color_UV), &vertexOffset));
+							if (!vertices)
+								break;
 
 							unsigned int spriteCount = 0;
-							unsigned int maxSpriteCount = std::min(s_maxQuads, m_spriteBuffer.GetVertexCount()/4);
 
 							do
 							{
 								ForwardRenderQueue::SpriteChain_XYZ_Color_UV& currentChain = spriteChainVector[spriteChain];
-								unsigned int count = std::min(maxSpriteCount - spriteCount, currentChain.spriteCount - spriteChainOffset);
+								unsigned int count = std::min(batchSpriteCount - spriteCount, currentChain.spriteCount - spriteChainOffset);
 
 								std::memcpy(vertices, currentChain.vertices + spriteChainOffset*4, 4*count*sizeof(VertexStruct_XYZ_Color_UV));
 								vertices += count*4;
@@ -290,11 +348,11 @@ namespace Nz
 									spriteChainOffset = 0;
 								}
 							}
-							while (spriteCount < maxSpriteCount && spriteChain < spriteChainCount);
+							while (spriteCount < batchSpriteCount);
 
-							vertexMapper.Unmap();
+							m_vertexBuffer.Unmap();
 
-							Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, spriteCount*6);
+							Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, spriteCount*6, vertexOffset/sizeof(VertexStruct_XYZ_Color_UV));
 						}
 						while (spriteChain < spriteChainCount);
 
@@ -333,11 +391,14 @@ namespace Nz
 				auto& entry = matIt.second;
 				auto& billboardVector = entry.billboards;
 
+				if (!IsMaterialDrawn(material))
+					continue;
+
 				unsigned int billboardCount = billboardVector.size();
 				if (billboardCount > 0)
 				{
 					// We begin to apply the material (and get the shader activated doing so)
-					const Shader* shader = material->Apply(ShaderFlags_Billboard | ShaderFlags_Instancing | ShaderFlags_VertexColor);
+					const Shader* shader = material->Apply(m_cubemapFlags | ShaderFlags_Billboard | ShaderFlags_Instancing | ShaderFlags_VertexColor);
 
 					// Uniforms are conserved in our program, there's no point to send them back until they change
 					if (shader != lastShader)
@@ -347,6 +408,7 @@ namespace Nz
 
 						// Position of the camera
 						shader->SendVector(shaderUniforms->eyePosition, Renderer::GetMatrix(MatrixType_ViewProj).GetTranslation());
+						SendCubemapUniforms(shader, shaderUniforms);
 
 						lastShader = shader;
 					}
@@ -380,11 +442,14 @@ namespace Nz
 				auto& entry = matIt.second;
 				auto& billboardVector = entry.billboards;
 
+				if (!IsMaterialDrawn(material))
+					continue;
+
 				unsigned int billboardCount = billboardVector.size();
 				if (billboardCount > 0)
 				{
 					// We begin to apply the material (and get the shader activated doing so)
-					const Shader* shader = material->Apply(ShaderFlags_Billboard | ShaderFlags_VertexColor);
+					const Shader* shader = material->Apply(m_cubemapFlags | ShaderFlags_Billboard | ShaderFlags_VertexColor);
 
 					// Uniforms are conserved in our program, there's no point to send them back until they change
 					if (shader != lastShader)
@@ -394,6 +459,7 @@ namespace Nz
 
 						// Position of the camera
 						shader->SendVector(shaderUniforms->eyePosition, Renderer::GetMatrix(MatrixType_ViewProj).GetTranslation());
+						SendCubemapUniforms(shader, shaderUniforms);
 
 						lastShader = shader;
 					}
@@ -406,8 +472,10 @@ namespace Nz
 						unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
 						billboardCount -= renderedBillboardCount;
 
-						BufferMapper<VertexBuffer> vertexMapper(m_billboardPointBuffer, BufferAccess_DiscardAndWrite, 0, renderedBillboardCount*4);
-						BillboardPoint* vertices = reinterpret_cast<BillboardPoint*>(vertexMapper.GetPointer());
+						unsigned int vertexOffset;
+						BillboardPoint* vertices = reinterpret_cast<BillboardPoint*>(m_vertexBuffer.Map(renderedBillboardCount*4*sizeof(BillboardPoint), sizeof(BillboardPoint), &vertexOffset));
+						if (!vertices)
+							break;
 
 						for (unsigned int i = 0; i < renderedBillboardCount; ++i)
 						{
@@ -442,9 +510,9 @@ namespace Nz
 							vertices++;
 						}
 
-						vertexMapper.Unmap();
+						m_vertexBuffer.Unmap();
 
-						Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, renderedBillboardCount*6);
+						Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, renderedBillboardCount*6, vertexOffset/sizeof(BillboardPoint));
 					}
 					while (billboardCount > 0);
 
@@ -470,6 +538,9 @@ namespace Nz
 		{
 			auto& matEntry = matIt.second;
 
+			if (!IsMaterialDrawn(matIt.first))
+				continue;
+
 			if (matEntry.enabled)
 			{
 				ForwardRenderQueue::MeshInstanceContainer& meshInstances = matEntry.meshMap;
@@ -479,17 +550,35 @@ namespace Nz
 					const Material* material = matIt.first;
 
 					bool instancing = m_instancingEnabled && matEntry.instancingEnabled;
+					UInt32 flags = (instancing) ? m_cubemapFlags | ShaderFlags_Instancing : m_cubemapFlags;
 
-					// We begin to apply the material (and get the shader activated doing so)
-					UInt8 freeTextureUnit;
-					const Shader* shader = material->Apply((instancing) ? ShaderFlags_Instancing : 0, 0, &freeTextureUnit);
+					const Shader* shader = nullptr;
+					bool skinning = false;
+					UInt8 skinningTextureUnit = 0;
 
-					// Uniforms are conserved in our program, there's no point to send them back until they change
-					if (shader != lastShader)
+					// Meshes sharing their buffers are drawn first, one multi-draw call for each of their groups
+					if (instancing && Renderer::HasCapability(RendererCap_MultiDrawIndirect))
 					{
-						// Index of uniforms in the shader
-						shaderUniforms = GetShaderUniforms(shader);
-						lastShader = shader;
+						auto ApplyMaterial = [&] ()
+						{
+							shader = material->Apply(flags);
+							if (shader != lastShader)
+							{
+								shaderUniforms = GetShaderUniforms(shader);
+								SendCubemapUniforms(shader, shaderUniforms);
+								lastShader = shader;
+							}
+						};
+
+						auto StreamInstances = [] (const Matrix4f* instanceMatrices, unsigned int instanceCount)
+						{
+							VertexBuffer* instanceBuffer = Renderer::GetInstanceBuffer();
+							instanceBuffer->SetVertexDeclaration(VertexDeclaration::Get(VertexLayout_Matrix4));
+
+							return instanceBuffer->Fill(instanceMatrices, 0, instanceCount, true);
+						};
+
+						DrawMeshBatches(meshInstances, Renderer::GetInstanceBuffer()->GetVertexCount(), ApplyMaterial, StreamInstances);
 					}
 
 					// Meshes
@@ -503,6 +592,33 @@ namespace Nz
 
 						if (!instances.empty())
 						{
+							// Meshes skinned on the GPU come last and need the shader reading their joints from a texture
+							bool skinned = (meshData.skeleton != nullptr);
+							if (!shader || skinned != skinning)
+							{
+								// We begin to apply the material (and get the shader activated doing so)
+								UInt8 freeTextureUnit;
+								shader = material->Apply((skinned) ? flags | ShaderFlags_Skinning : flags, 0, &freeTextureUnit);
+
+								// Uniforms are conserved in our program, there's no point to send them back until they change
+								if (shader != lastShader)
+								{
+									// Index of uniforms in the shader
+									shaderUniforms = GetShaderUniforms(shader);
+									SendCubemapUniforms(shader, shaderUniforms);
+									lastShader = shader;
+								}
+
+								skinning = skinned;
+								skinningTextureUnit = freeTextureUnit;
+							}
+
+							if (skinning)
+							{
+								SkinningManager::BindSkinningTexture(meshData.skeleton, skinningTextureUnit);
+								shader->SendInteger(shaderUniforms->skinningMatrices, skinningTextureUnit);
+							}
+
 							const IndexBuffer* indexBuffer = meshData.indexBuffer;
 							const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
 
@@ -590,7 +706,10 @@ namespace Nz
 			uniforms.shaderReleaseSlot.Connect(shader->OnShaderRelease, this, &DepthRenderTechnique::OnShaderInvalidated);
 			uniforms.shaderUniformInvalidatedSlot.Connect(shader->OnShaderUniformInvalidated, this, &DepthRenderTechnique::OnShaderInvalidated);
 
+			uniforms.cubemapFaceMask = shader->GetUniformLocation("CubemapFaceMask");
+			uniforms.cubemapViewProjMatrices = shader->GetUniformLocation("CubemapViewProjMatrices");
 			uniforms.eyePosition = shader->GetUniformLocation("EyePosition");
+			uniforms.skinningMatrices = shader->GetUniformLocation("SkinningMatrices");
 			uniforms.textureOverlay = shader->GetUniformLocation("TextureOverlay");
 
 			it = m_shaderUniforms.emplace(shader, std::move(uniforms)).first;
@@ -599,6 +718,47 @@ namespace Nz
 		return &it->second;
 	}
 
+	/*!
+	* \brief Sends the matrices and the face mask of the layered cubemap to a shader, if layered rendering is enabled
+	*
+	* \param shader Shader to send the uniforms to
+	* \param uniforms Uniforms of the shader
+	*/
+
+	void DepthRenderTechnique::SendCubemapUniforms(const Shader* shader, const ShaderUniforms* uniforms) const
+	{
+		if (m_cubemapFlags == 0)
+			return;
+
+		shader->SendInteger(uniforms->cubemapFaceMask, m_cubemapFaceMask);
+		shader->SendMatrixArray(uniforms->cubemapViewProjMatrices, m_cubemapViewProjMatrices.data(), 6);
+	}
+
+	/*!
+	* \brief Checks whether a material is drawn by the current pass
+	* \return true If the material must be drawn
+	*
+	* \param material Material of the objects
+	*
+	* \remark Layered draws skip the materials whose shader can not route primitives to cubemap faces, and remember it
+	*/
+
+	bool DepthRenderTechnique::IsMaterialDrawn(const Material* material) const
+	{
+		const UberShader* uberShader = material->GetShader();
+		bool layerable = uberShader && uberShader->HasFlag("FLAG_CUBEMAPLAYERED");
+
+		if (m_cubemapFlags != 0)
+		{
+			if (!layerable)
+				m_nonLayeredMaterialsSkipped = true;
+
+			return layerable;
+		}
+
+		return !m_layeredMaterialsSkipped || !layerable;
+	}
+
 	/*!
 	* \brief Handle the invalidation of a shader
 	*
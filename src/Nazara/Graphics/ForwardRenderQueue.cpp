@@ -5,18 +5,127 @@
 #include <Nazara/Graphics/ForwardRenderQueue.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/Light.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <array>
+#include <cstring>
 #include <Nazara/Graphics/Debug.hpp>
 
 ///TODO: Replace sinus/cosinus by a lookup table (which will lead to a speed up about 10x)
 
 namespace Nz
 {
+	namespace
+	{
+		// Sort keys hold, from the most significant bits: the layer (8 bits), the command type (3 bits) and 53 bits depending on the type
+		// - Opaque models: material (24 bits), skinning (1 bit), mesh (16 bits), depth from front to back (12 bits)
+		// - Transparent models: depth from back to front (32 bits), material (21 bits)
+		// - Sprites: material (24 bits), overlay (16 bits)
+		// - Billboards: material (24 bits), depth from back to front if the material sorts them (29 bits)
+		// - Drawables: order of addition (32 bits)
+		const unsigned int s_layerShift = 56;
+		const unsigned int s_typeShift = 53;
+
+		const UInt64 s_billboardDepthMask = (1ULL << 29) - 1;
+		const UInt64 s_opaqueDepthMask = (1ULL << 12) - 1;
+		const UInt64 s_transparentDepthMask = 0xFFFFFFFFULL << 21;
+
+		UInt32 HashPointer(const void* pointer)
+		{
+			// Pointers are aligned and close to each other, their bits have to be mixed before being truncated
+			UInt64 value = reinterpret_cast<std::uintptr_t>(pointer);
+			value ^= value >> 33;
+			value *= 0xFF51AFD7ED558CCDULL;
+			value ^= value >> 33;
+
+			return static_cast<UInt32>(value);
+		}
+
+		UInt32 GetDepthKey(float depth)
+		{
+			// Flipping the sign bit of positive floats and every bit of negative ones makes them sort as unsigned integers
+			UInt32 bits;
+			std::memcpy(&bits, &depth, sizeof(float));
+
+			return (bits & 0x80000000U) ? ~bits : bits | 0x80000000U;
+		}
+
+		UInt64 GetMaterialKey(const Material* material)
+		{
+			// Materials sharing an uber shader are kept together; hash collisions only cost more state changes
+			return (static_cast<UInt64>(HashPointer(material->GetShader()) & 0xFF) << 16) | (HashPointer(material) & 0xFFFF);
+		}
+
+		UInt64 GetMeshKey(const MeshData& meshData)
+		{
+			return (HashPointer(meshData.vertexBuffer) ^ HashPointer(meshData.indexBuffer) ^ HashPointer(meshData.skeleton)) & 0xFFFF;
+		}
+
+		void RadixSort(FrameVector<ForwardRenderQueue::Command>& commands, FrameVector<ForwardRenderQueue::Command>& buffer)
+		{
+			std::size_t commandCount = commands.size();
+			if (commandCount < 2)
+				return;
+
+			// Least significant digit first, every pass being stable
+			std::array<std::array<std::size_t, 256>, 8> offsets = {};
+			for (const ForwardRenderQueue::Command& command : commands)
+			{
+				for (unsigned int digit = 0; digit < 8; ++digit)
+					offsets[digit][(command.sortKey >> (digit * 8)) & 0xFF]++;
+			}
+
+			buffer.resize(commandCount);
+
+			ForwardRenderQueue::Command* source = commands.data();
+			ForwardRenderQueue::Command* destination = buffer.data();
+			for (unsigned int digit = 0; digit < 8; ++digit)
+			{
+				unsigned int shift = digit * 8;
+				auto& digitOffsets = offsets[digit];
+
+				// Every key shares this digit (as the layer often does), the pass would change nothing
+				if (digitOffsets[(source[0].sortKey >> shift) & 0xFF] == commandCount)
+					continue;
+
+				std::size_t offset = 0;
+				for (std::size_t& digitOffset : digitOffsets)
+				{
+					std::size_t count = digitOffset;
+					digitOffset = offset;
+					offset += count;
+				}
+
+				for (std::size_t i = 0; i < commandCount; ++i)
+					destination[digitOffsets[(source[i].sortKey >> shift) & 0xFF]++] = source[i];
+
+				std::swap(source, destination);
+			}
+
+			if (source != commands.data())
+				std::copy(source, source + commandCount, commands.data());
+		}
+	}
+
 	/*!
 	* \ingroup graphics
 	* \class Nz::ForwardRenderQueue
 	* \brief Graphics class that represents the rendering queue for forward rendering
+	*
+	* By default, the queue batches its content in maps per layer, material and mesh.
+	* It can instead record a flat command list, where each addition appends a 64 bits sort key and its data,
+	* sorted once per frame by Sort (materials and meshes are hashed into the key, so nothing has to be invalidated between frames)
 	*/
 
+	/*!
+	* \brief Constructs a ForwardRenderQueue object by default
+	*/
+
+	ForwardRenderQueue::ForwardRenderQueue() :
+	m_commandListEnabled(false)
+	{
+		ResetCommandList();
+	}
+
 	/*!
 	* \brief Adds billboard to the queue
 	*
@@ -34,21 +143,7 @@ namespace Nz
 	{
 		NazaraAssert(material, "Invalid material");
 
-		auto& billboards = GetLayer(renderOrder).billboards;
-
-		auto it = billboards.find(material);
-		if (it == billboards.end())
-		{
-			BatchedBillboardEntry entry;
-			entry.materialReleaseSlot.Connect(material->OnMaterialRelease, this, &ForwardRenderQueue::OnMaterialInvalidation);
-
-			it = billboards.insert(std::make_pair(material, std::move(entry))).first;
-		}
-
-		BatchedBillboardEntry& entry = it->second;
-
-		auto& billboardVector = entry.billboards;
-		billboardVector.push_back(BillboardData{color, position, size, sinCos});
+		*GetBillboardData(renderOrder, material, 1) = BillboardData{color, position, size, sinCos};
 	}
 
 	/*!
@@ -390,9 +485,21 @@ namespace Nz
 		}
 		#endif
 
+		m_stats.instanceCount++;
+
+		if (m_commandListEnabled)
+		{
+			unsigned int index = commandList.drawables.size();
+			commandList.drawables.push_back(drawable);
+
+			AddCommand(renderOrder, CommandType_Drawable, index, index);
+			return;
+		}
+
 		auto& otherDrawables = GetLayer(renderOrder).otherDrawables;
 
 		otherDrawables.push_back(drawable);
+		m_stats.batchCount++;
 	}
 
 	/*!
@@ -411,6 +518,27 @@ namespace Nz
 	{
 		NazaraAssert(material, "Invalid material");
 
+		m_stats.instanceCount++;
+
+		RequestTextureResolutions(material, meshAABB, transformMatrix);
+
+		if (m_commandListEnabled)
+		{
+			unsigned int index = commandList.models.size();
+			commandList.models.push_back(ModelCommandData{transformMatrix, meshData, meshAABB.GetSquaredBoundingSphere(), material});
+
+			// Depth bits are filled by Sort
+			if (material->IsEnabled(RendererParameter_Blend))
+				AddCommand(renderOrder, CommandType_TransparentModel, GetMaterialKey(material) & 0x1FFFFF, index);
+			else
+			{
+				UInt64 skinningKey = (meshData.skeleton) ? 1 : 0;
+				AddCommand(renderOrder, CommandType_OpaqueModel, (GetMaterialKey(material) << 29) | (skinningKey << 28) | (GetMeshKey(meshData) << 12), index);
+			}
+
+			return;
+		}
+
 		if (material->IsEnabled(RendererParameter_Blend))
 		{
 			Layer& currentLayer = GetLayer(renderOrder);
@@ -428,6 +556,7 @@ namespace Nz
 			data.transformMatrix = transformMatrix;
 
 			transparentModels.push_back(index);
+			m_stats.batchCount++;
 		}
 		else
 		{
@@ -463,6 +592,9 @@ namespace Nz
 			}
 
 			std::vector<Matrix4f>& instances = it2->second.instances;
+			if (instances.empty())
+				m_stats.batchCount++;
+
 			instances.push_back(transformMatrix);
 
 			// Do we have enough instances to perform instancing ?
@@ -479,14 +611,27 @@ namespace Nz
 	* \param vertices Buffer of data for the sprites
 	* \param spriteCount Number of sprites
 	* \param overlay Texture of the sprites
+	* \param textureLayer Layer of the material diffuse map sampled by the sprites, when it is a texture array
 	*
 	* \remark Produces a NazaraAssert if material is invalid
+	* \remark Sprites sharing a material whose diffuse map is a texture array are drawn together whatever their layer
 	*/
 
-	void ForwardRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay)
+	void ForwardRenderQueue::AddSprites(int renderOrder, const Material* material, const VertexStruct_XYZ_Color_UV* vertices, unsigned int spriteCount, const Texture* overlay, unsigned int textureLayer)
 	{
 		NazaraAssert(material, "Invalid material");
 
+		m_stats.instanceCount += spriteCount;
+
+		if (m_commandListEnabled)
+		{
+			unsigned int index = commandList.sprites.size();
+			commandList.sprites.push_back(SpriteCommandData{material, overlay, {vertices, spriteCount, textureLayer}});
+
+			AddCommand(renderOrder, CommandType_Sprites, (GetMaterialKey(material) << 16) | (HashPointer(overlay) & 0xFFFF), index);
+			return;
+		}
+
 		Layer& currentLayer = GetLayer(renderOrder);
 		auto& basicSprites = currentLayer.basicSprites;
 
@@ -515,7 +660,10 @@ namespace Nz
 		}
 
 		auto& spriteVector = overlayIt->second.spriteChains;
-		spriteVector.push_back(SpriteChain_XYZ_Color_UV({vertices, spriteCount}));
+		if (spriteVector.empty())
+			m_stats.batchCount++;
+
+		spriteVector.push_back(SpriteChain_XYZ_Color_UV({vertices, spriteCount, textureLayer}));
 	}
 
 	/*!
@@ -528,6 +676,8 @@ namespace Nz
 	{
 		AbstractRenderQueue::Clear(fully);
 
+		ResetCommandList();
+
 		if (fully)
 			layers.clear();
 		else
@@ -539,19 +689,96 @@ namespace Nz
 					layers.erase(it++);
 				else
 				{
-					layer.otherDrawables.clear();
-					layer.transparentModels.clear();
-					layer.transparentModelData.clear();
+					ResetFrameData(layer);
 					++it;
 				}
 			}
 		}
 	}
 
+	/*!
+	* \brief Enables the command list, replacing the batching maps of the layers
+	*
+	* \param enable Should the queue record a command list
+	*
+	* \remark This should be changed between two frames, as the queued content is not moved from one representation to the other
+	*/
+
+	void ForwardRenderQueue::EnableCommandList(bool enable)
+	{
+		m_commandListEnabled = enable;
+	}
+
+	/*!
+	* \brief Checks whether the queue records a command list
+	* \return true If the command list is enabled
+	*/
+
+	bool ForwardRenderQueue::IsCommandListEnabled() const
+	{
+		return m_commandListEnabled;
+	}
+
+	/*!
+	* \brief Appends the command list of another queue to this one
+	*
+	* \param renderQueue Queue whose commands are appended, after the ones of this queue
+	*
+	* \remark Meant to gather the queues filled by different threads, merging them in a fixed order gives the same result as filling a single queue
+	* \remark Lights are not merged, statistics are summed
+	* \remark Both queues must have their command list enabled
+	*/
+
+	void ForwardRenderQueue::MergeCommandList(const ForwardRenderQueue& renderQueue)
+	{
+		NazaraAssert(m_commandListEnabled && renderQueue.m_commandListEnabled, "Both queues must record a command list");
+		NazaraAssert(&renderQueue != this, "Cannot merge a queue with itself");
+
+		const CommandList& otherList = renderQueue.commandList;
+
+		std::array<UInt32, CommandType_Max + 1> indexOffsets;
+		indexOffsets[CommandType_OpaqueModel] = static_cast<UInt32>(commandList.models.size());
+		indexOffsets[CommandType_TransparentModel] = indexOffsets[CommandType_OpaqueModel];
+		indexOffsets[CommandType_Sprites] = static_cast<UInt32>(commandList.sprites.size());
+		indexOffsets[CommandType_Billboards] = static_cast<UInt32>(commandList.billboardCommands.size());
+		indexOffsets[CommandType_Drawable] = static_cast<UInt32>(commandList.drawables.size());
+
+		unsigned int billboardOffset = commandList.billboards.size();
+
+		commandList.billboards.insert(commandList.billboards.end(), otherList.billboards.begin(), otherList.billboards.end());
+		commandList.drawables.insert(commandList.drawables.end(), otherList.drawables.begin(), otherList.drawables.end());
+		commandList.models.insert(commandList.models.end(), otherList.models.begin(), otherList.models.end());
+		commandList.sprites.insert(commandList.sprites.end(), otherList.sprites.begin(), otherList.sprites.end());
+
+		commandList.billboardCommands.reserve(commandList.billboardCommands.size() + otherList.billboardCommands.size());
+		for (const BillboardCommandData& data : otherList.billboardCommands)
+			commandList.billboardCommands.push_back(BillboardCommandData{data.material, data.billboardCount, data.firstBillboard + billboardOffset});
+
+		commandList.commands.reserve(commandList.commands.size() + otherList.commands.size());
+		for (const Command& command : otherList.commands)
+		{
+			CommandType type = GetCommandType(command.sortKey);
+			UInt32 index = command.index + indexOffsets[type];
+
+			// Drawables are sorted by their index, which has to follow
+			UInt64 sortKey = command.sortKey;
+			if (type == CommandType_Drawable)
+				sortKey = (sortKey & ~UInt64(0xFFFFFFFF)) | index;
+
+			commandList.commands.push_back(Command{sortKey, index});
+		}
+
+		m_stats.batchCount += renderQueue.m_stats.batchCount;
+		m_stats.culledObjectCount += renderQueue.m_stats.culledObjectCount;
+		m_stats.instanceCount += renderQueue.m_stats.instanceCount;
+	}
+
 	/*!
 	* \brief Sorts the object according to the viewer position, furthest to nearest
 	*
 	* \param viewer Viewer of the scene
+	*
+	* \remark With the command list, this completes the depth bits of the sort keys and sorts the whole list at once
 	*/
 
 	void ForwardRenderQueue::Sort(const AbstractViewer* viewer)
@@ -560,6 +787,52 @@ namespace Nz
 		Vector3f viewerPos = viewer->GetEyePosition();
 		Vector3f viewerNormal = viewer->GetForward();
 
+		if (m_commandListEnabled)
+		{
+			for (Command& command : commandList.commands)
+			{
+				switch (GetCommandType(command.sortKey))
+				{
+					case CommandType_Billboards:
+					{
+						const BillboardCommandData& data = commandList.billboardCommands[command.index];
+						if (data.material->IsDepthSortingEnabled())
+						{
+							float distance = viewerPos.SquaredDistance(commandList.billboards[data.firstBillboard].center);
+							command.sortKey = (command.sortKey & ~s_billboardDepthMask) | (~GetDepthKey(distance) >> 3);
+						}
+						break;
+					}
+
+					case CommandType_OpaqueModel:
+					{
+						// Front to back, to take advantage of early depth testing
+						float distance = viewerPos.SquaredDistance(commandList.models[command.index].transformMatrix.GetTranslation());
+						command.sortKey = (command.sortKey & ~s_opaqueDepthMask) | (GetDepthKey(distance) >> 20);
+						break;
+					}
+
+					case CommandType_TransparentModel:
+					{
+						const ModelCommandData& data = commandList.models[command.index];
+						Spheref sphere(data.transformMatrix.GetTranslation() + data.squaredBoundingSphere.GetPosition(), data.squaredBoundingSphere.radius);
+
+						float distance = nearPlane.Distance(sphere.GetNegativeVertex(viewerNormal));
+						command.sortKey = (command.sortKey & ~s_transparentDepthMask) | (static_cast<UInt64>(~GetDepthKey(distance)) << 21);
+						break;
+					}
+
+					case CommandType_Drawable:
+					case CommandType_Sprites:
+						break;
+				}
+			}
+
+			FrameVector<Command> buffer(GetFrameArena());
+			RadixSort(commandList.commands, buffer);
+			return;
+		}
+
 		for (auto& pair : layers)
 		{
 			Layer& layer = pair.second;
@@ -593,16 +866,83 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Gets the layer of a command
+	* \return Layer index, the render orders being shifted by 128 and clamped to [0, 255]
+	*
+	* \param sortKey Sort key of the command
+	*/
+
+	UInt8 ForwardRenderQueue::GetCommandLayer(UInt64 sortKey)
+	{
+		return static_cast<UInt8>(sortKey >> s_layerShift);
+	}
+
+	/*!
+	* \brief Gets the type of a command
+	* \return Command type
+	*
+	* \param sortKey Sort key of the command
+	*/
+
+	ForwardRenderQueue::CommandType ForwardRenderQueue::GetCommandType(UInt64 sortKey)
+	{
+		return static_cast<CommandType>((sortKey >> s_typeShift) & 0x7);
+	}
+
+	/*!
+	* \brief Appends a command to the command list
+	*
+	* \param renderOrder Order of rendering, render orders outside of [-128, 127] share the first or the last layer
+	* \param type Type of the command
+	* \param typeKey Lower bits of the sort key, depending on the type
+	* \param index Index of the command data
+	*/
+
+	void ForwardRenderQueue::AddCommand(int renderOrder, CommandType type, UInt64 typeKey, unsigned int index)
+	{
+		UInt64 layer = static_cast<UInt64>(Clamp(renderOrder + 128, 0, 255));
+
+		commandList.commands.push_back(Command{(layer << s_layerShift) | (static_cast<UInt64>(type) << s_typeShift) | typeKey, index});
+	}
+
 	/*!
 	* \brief Gets the billboard data
 	* \return Pointer to the data of the billboards
 	*
 	* \param renderOrder Order of rendering
 	* \param material Material of the billboard
+	* \param count Number of billboards to allocate
 	*/
 
 	ForwardRenderQueue::BillboardData* ForwardRenderQueue::GetBillboardData(int renderOrder, const Material* material, unsigned int count)
 	{
+		m_stats.instanceCount += count;
+
+		if (m_commandListEnabled)
+		{
+			unsigned int firstBillboard = commandList.billboards.size();
+			commandList.billboards.resize(firstBillboard + count);
+
+			// Billboards sorted by depth need a command each, the others are drawn in their order of addition
+			UInt64 materialKey = GetMaterialKey(material) << 29;
+			if (material->IsDepthSortingEnabled())
+			{
+				for (unsigned int i = 0; i < count; ++i)
+				{
+					AddCommand(renderOrder, CommandType_Billboards, materialKey, commandList.billboardCommands.size());
+					commandList.billboardCommands.push_back(BillboardCommandData{material, 1, firstBillboard + i});
+				}
+			}
+			else
+			{
+				AddCommand(renderOrder, CommandType_Billboards, materialKey, commandList.billboardCommands.size());
+				commandList.billboardCommands.push_back(BillboardCommandData{material, count, firstBillboard});
+			}
+
+			return &commandList.billboards[firstBillboard];
+		}
+
 		auto& billboards = GetLayer(renderOrder).billboards;
 
 		auto it = billboards.find(material);
@@ -618,6 +958,9 @@ namespace Nz
 
 		auto& billboardVector = entry.billboards;
 		unsigned int prevSize = billboardVector.size();
+		if (prevSize == 0)
+			m_stats.batchCount++;
+
 		billboardVector.resize(prevSize + count);
 
 		return &billboardVector[prevSize];
@@ -634,8 +977,11 @@ namespace Nz
 	{
 		auto it = layers.find(i);
 		if (it == layers.end())
+		{
 			it = layers.insert(std::make_pair(i, Layer())).first;
-		
+			ResetFrameData(it->second);
+		}
+
 		Layer& layer = it->second;
 		layer.clearCount = 0;
 
@@ -742,20 +1088,10 @@ namespace Nz
 
 	bool ForwardRenderQueue::BatchedBillboardComparator::operator()(const Material* mat1, const Material* mat2) const
 	{
-		const UberShader* uberShader1 = mat1->GetShader();
-		const UberShader* uberShader2 = mat2->GetShader();
-		if (uberShader1 != uberShader2)
-			return uberShader1 < uberShader2;
-
-		const Shader* shader1 = mat1->GetShaderInstance(ShaderFlags_Billboard | ShaderFlags_VertexColor)->GetShader();
-		const Shader* shader2 = mat2->GetShaderInstance(ShaderFlags_Billboard | ShaderFlags_VertexColor)->GetShader();
-		if (shader1 != shader2)
-			return shader1 < shader2;
-
-		const Texture* diffuseMap1 = mat1->GetDiffuseMap();
-		const Texture* diffuseMap2 = mat2->GetDiffuseMap();
-		if (diffuseMap1 != diffuseMap2)
-			return diffuseMap1 < diffuseMap2;
+		UInt32 sortKey1 = mat1->GetSortKey();
+		UInt32 sortKey2 = mat2->GetSortKey();
+		if (sortKey1 != sortKey2)
+			return sortKey1 < sortKey2;
 
 		return mat1 < mat2;
 	}
@@ -770,20 +1106,10 @@ namespace Nz
 
 	bool ForwardRenderQueue::BatchedModelMaterialComparator::operator()(const Material* mat1, const Material* mat2) const
 	{
-		const UberShader* uberShader1 = mat1->GetShader();
-		const UberShader* uberShader2 = mat2->GetShader();
-		if (uberShader1 != uberShader2)
-			return uberShader1 < uberShader2;
-
-		const Shader* shader1 = mat1->GetShaderInstance()->GetShader();
-		const Shader* shader2 = mat2->GetShaderInstance()->GetShader();
-		if (shader1 != shader2)
-			return shader1 < shader2;
-
-		const Texture* diffuseMap1 = mat1->GetDiffuseMap();
-		const Texture* diffuseMap2 = mat2->GetDiffuseMap();
-		if (diffuseMap1 != diffuseMap2)
-			return diffuseMap1 < diffuseMap2;
+		UInt32 sortKey1 = mat1->GetSortKey();
+		UInt32 sortKey2 = mat2->GetSortKey();
+		if (sortKey1 != sortKey2)
+			return sortKey1 < sortKey2;
 
 		return mat1 < mat2;
 	}
@@ -798,20 +1124,10 @@ namespace Nz
 
 	bool ForwardRenderQueue::BatchedSpriteMaterialComparator::operator()(const Material* mat1, const Material* mat2)
 	{
-		const UberShader* uberShader1 = mat1->GetShader();
-		const UberShader* uberShader2 = mat2->GetShader();
-		if (uberShader1 != uberShader2)
-			return uberShader1 < uberShader2;
-
-		const Shader* shader1 = mat1->GetShaderInstance()->GetShader();
-		const Shader* shader2 = mat2->GetShaderInstance()->GetShader();
-		if (shader1 != shader2)
-			return shader1 < shader2;
-
-		const Texture* diffuseMap1 = mat1->GetDiffuseMap();
-		const Texture* diffuseMap2 = mat2->GetDiffuseMap();
-		if (diffuseMap1 != diffuseMap2)
-			return diffuseMap1 < diffuseMap2;
+		UInt32 sortKey1 = mat1->GetSortKey();
+		UInt32 sortKey2 = mat2->GetSortKey();
+		if (sortKey1 != sortKey2)
+			return sortKey1 < sortKey2;
 
 		return mat1 < mat2;
 	}
@@ -826,6 +1142,10 @@ namespace Nz
 
 	bool ForwardRenderQueue::MeshDataComparator::operator()(const MeshData& data1, const MeshData& data2) const
 	{
+		// Meshes skinned on the GPU come last, so that each material switches to its skinning shader only once
+		if (data1.skeleton != data2.skeleton)
+			return data1.skeleton < data2.skeleton;
+
 		const Buffer* buffer1;
 		const Buffer* buffer2;
 
@@ -841,4 +1161,35 @@ namespace Nz
 
 		return data1.primitiveMode < data2.primitiveMode;
 	}
+
+	/*!
+	* \brief Resets the command list, making it use the current frame of the arena
+	*/
+
+	void ForwardRenderQueue::ResetCommandList()
+	{
+		FrameArena& frameArena = GetFrameArena();
+
+		commandList.billboards = FrameVector<BillboardData>(frameArena);
+		commandList.billboardCommands = FrameVector<BillboardCommandData>(frameArena);
+		commandList.commands = FrameVector<Command>(frameArena);
+		commandList.drawables = FrameVector<const Drawable*>(frameArena);
+		commandList.models = FrameVector<ModelCommandData>(frameArena);
+		commandList.sprites = FrameVector<SpriteCommandData>(frameArena);
+	}
+
+	/*!
+	* \brief Resets the per-frame containers of a layer, making them use the current frame of the arena
+	*
+	* \param layer Layer to reset
+	*/
+
+	void ForwardRenderQueue::ResetFrameData(Layer& layer)
+	{
+		FrameArena& frameArena = GetFrameArena();
+
+		layer.otherDrawables = FrameVector<const Drawable*>(frameArena);
+		layer.transparentModels = TransparentModelContainer(frameArena);
+		layer.transparentModelData = FrameVector<TransparentModelData>(frameArena);
+	}
 }
@@ -5,17 +5,22 @@
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/OffsetOf.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/Drawable.hpp>
 #include <Nazara/Graphics/Light.hpp>
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Graphics/Sprite.hpp>
 #include <Nazara/Renderer/Config.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
@@ -33,8 +38,58 @@ namespace Nz
 			Vector2f uv;
 		};
 
+		struct LayeredSpriteVertex
+		{
+			Vector3f position;
+			Color color;
+			Vector2f uv;
+			float layer;
+		};
+
+		bool IsSameMesh(const MeshData& data1, const MeshData& data2)
+		{
+			return data1.indexBuffer == data2.indexBuffer && data1.vertexBuffer == data2.vertexBuffer && data1.skeleton == data2.skeleton && data1.primitiveMode == data2.primitiveMode;
+		}
+
 		unsigned int s_maxQuads = std::numeric_limits<UInt16>::max() / 6;
 		unsigned int s_vertexBufferSize = 4 * 1024 * 1024; // 4 MiB
+		unsigned int s_instanceBufferSize = 4 * 1024 * 1024; // 4 MiB, 65536 matrices
+
+		// Light clusters: screen tiles, split in exponential depth slices
+		const unsigned int s_clusterCountX = 16;
+		const unsigned int s_clusterCountY = 9;
+		const unsigned int s_clusterCountZ = 24;
+		const unsigned int s_clusterIndexWidth = 1024; //< Width of the texture holding the light indices
+
+		bool EnsureDataTexture(TextureRef& texture, PixelFormatType format, unsigned int width, unsigned int height)
+		{
+			if (texture && texture->GetWidth() == width && texture->GetHeight() >= height)
+				return true;
+
+			// Grown by steps, to avoid reallocating it each time a light or a billboard is added
+			unsigned int textureHeight = std::max(height, (texture) ? texture->GetHeight() * 2 : 16U);
+
+			TextureRef newTexture = Texture::New();
+			if (!newTexture->Create(ImageType_2D, format, width, std::min(textureHeight, Renderer::GetMaxTextureSize())))
+			{
+				NazaraError("Failed to create data texture");
+				return false;
+			}
+
+			texture = std::move(newTexture);
+			return true;
+		}
+
+		bool IsDepthPrepassSuitable(const Material* material)
+		{
+			// Alpha tested surfaces need their own depth material to discard the same fragments in both passes
+			if (material->IsAlphaTestEnabled() && !material->HasDepthMaterial())
+				return false;
+
+			RendererComparison depthFunc = material->GetDepthFunc();
+			return material->IsEnabled(RendererParameter_DepthBuffer) && material->IsEnabled(RendererParameter_DepthWrite) &&
+			       (depthFunc == RendererComparison_Less || depthFunc == RendererComparison_LessOrEqual);
+		}
 	}
 
 	/*!
@@ -48,15 +103,22 @@ namespace Nz
 	*/
 
 	ForwardRenderTechnique::ForwardRenderTechnique() :
-	m_vertexBuffer(BufferType_Vertex),
-	m_maxLightPassPerObject(3)
+	m_instanceStream(BufferType_Vertex, s_instanceBufferSize),
+	m_vertexBuffer(BufferType_Vertex, s_vertexBufferSize),
+	m_maxLightPassPerObject(3),
+	m_clusteredLightingEnabled(false),
+	m_depthPrepassEnabled(false)
 	{
 		ErrorFlags flags(ErrorFlag_ThrowException, true);
 
-		m_vertexBuffer.Create(s_vertexBufferSize, DataStorage_Hardware, BufferUsage_Dynamic);
+		// Untextured, the basic shader only reads the positions of the vertices
+		m_depthPrepassMaterial = Material::New();
+		m_depthPrepassMaterial->Enable(RendererParameter_ColorWrite, false);
 
-		m_billboardPointBuffer.Reset(&s_billboardVertexDeclaration, &m_vertexBuffer);
-		m_spriteBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ_Color_UV), &m_vertexBuffer);
+		m_billboardPointBuffer.Reset(&s_billboardVertexDeclaration, m_vertexBuffer.GetBuffer());
+		m_instanceBuffer.Reset(VertexDeclaration::Get(VertexLayout_Matrix4), m_instanceStream.GetBuffer());
+		m_layeredSpriteBuffer.Reset(&s_layeredSpriteDeclaration, m_vertexBuffer.GetBuffer());
+		m_spriteBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ_Color_UV), m_vertexBuffer.GetBuffer());
 	}
 
 	/*!
@@ -86,16 +148,32 @@ namespace Nz
 
 	bool ForwardRenderTechnique::Draw(const SceneData& sceneData) const
 	{
+		NazaraProfileZone("ForwardRenderTechnique::Draw");
+		NazaraGpuZone("ForwardRenderTechnique::Draw");
+
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
 
 		m_renderQueue.Sort(sceneData.viewer);
 
+		BuildLightClusters(sceneData.viewer);
+
+		// Skeletal meshes skinned on the CPU must be up to date before being drawn
+		SkinningManager::Skin();
+
+		if (m_renderQueue.IsCommandListEnabled())
+			DrawCommandList(sceneData);
+
 		for (auto& pair : m_renderQueue.layers)
 		{
 			ForwardRenderQueue::Layer& layer = pair.second;
 
 			if (!layer.opaqueModels.empty())
+			{
+				if (m_depthPrepassEnabled)
+					DrawDepthPrepass(layer);
+
 				DrawOpaqueModels(sceneData, layer);
+			}
 
 			if (!layer.transparentModels.empty())
 				DrawTransparentModels(sceneData, layer);
@@ -110,9 +188,43 @@ namespace Nz
 				drawable->Draw();
 		}
 
+		// Parts of the stream buffers used by this frame may only be overwritten once the GPU is done with them
+		m_instanceStream.EndFrame();
+		m_vertexBuffer.EndFrame();
+
 		return true;
 	}
 
+	/*!
+	* \brief Enables the clustered lighting
+	*
+	* \param enable Should the point and spot lights without shadows be sorted in clusters of the view frustum
+	*
+	* \remark The clustered lights are all shaded in a single pass, each fragment looping over the lights of its cluster, instead of being chosen per object
+	* \remark Only the shaders supporting FLAG_CLUSTEREDLIGHTING (like the PhongLighting one) use the clusters, the other ones still get these lights per object
+	* \remark Requires a perspective viewer and float textures
+	*/
+
+	void ForwardRenderTechnique::EnableClusteredLighting(bool enable)
+	{
+		m_clusteredLightingEnabled = enable;
+	}
+
+	/*!
+	* \brief Enables the depth pre-pass
+	*
+	* \param enable Should the depth of the opaque models be rendered before shading them
+	*
+	* \remark The opaque models are then shaded with an equal depth test and without depth writes, each visible pixel being lit only once
+	* \remark Models using their depth material are rendered with it, alpha tested models without depth material skip the pre-pass
+	* \remark Only the layers of the render queue benefit from it, not its command list
+	*/
+
+	void ForwardRenderTechnique::EnableDepthPrepass(bool enable)
+	{
+		m_depthPrepassEnabled = enable;
+	}
+
 	/*!
 	* \brief Gets the maximum number of lights available per pass per object
 	* \return Maximum number of light simulatenously per object
@@ -143,6 +255,26 @@ namespace Nz
 		return RenderTechniqueType_BasicForward;
 	}
 
+	/*!
+	* \brief Checks whether the clustered lighting is enabled
+	* \return true If point and spot lights without shadows are sorted in clusters
+	*/
+
+	bool ForwardRenderTechnique::IsClusteredLightingEnabled() const
+	{
+		return m_clusteredLightingEnabled;
+	}
+
+	/*!
+	* \brief Checks whether the depth pre-pass is enabled
+	* \return true If the depth of the opaque models is rendered before shading them
+	*/
+
+	bool ForwardRenderTechnique::IsDepthPrepassEnabled() const
+	{
+		return m_depthPrepassEnabled;
+	}
+
 	/*!
 	* \brief Sets the maximum number of lights available per pass per object
 	*
@@ -210,8 +342,28 @@ namespace Nz
 			s_billboardInstanceDeclaration.EnableComponent(VertexComponent_InstanceData1, ComponentType_Float4, NazaraOffsetOf(ForwardRenderQueue::BillboardData, size)); // Englobe sincos
 			s_billboardInstanceDeclaration.EnableComponent(VertexComponent_InstanceData2, ComponentType_Color,  NazaraOffsetOf(ForwardRenderQueue::BillboardData, color));
 
+			// Declaration used when the billboards are read from a texture: there is no vertex attribute, the shader only needs gl_VertexID
+			// (the quad buffer is bound only because a draw call requires a vertex buffer)
+			s_billboardPullingDeclaration.SetStride(sizeof(Vector2f));
+			s_billboardPullingBuffer.Reset(&s_billboardPullingDeclaration, s_quadVertexBuffer.GetBuffer());
+			s_billboardPullingSupported = Texture::IsFormatSupported(PixelFormatType_RGBA32F);
+
+			// Declaration used when rendering sprites sampling a texture array, the layer being sent with each vertex
+			s_layeredSpriteDeclaration.EnableComponent(VertexComponent_Color,     ComponentType_Color,  NazaraOffsetOf(LayeredSpriteVertex, color));
+			s_layeredSpriteDeclaration.EnableComponent(VertexComponent_Position,  ComponentType_Float3, NazaraOffsetOf(LayeredSpriteVertex, position));
+			s_layeredSpriteDeclaration.EnableComponent(VertexComponent_TexCoord,  ComponentType_Float2, NazaraOffsetOf(LayeredSpriteVertex, uv));
+			s_layeredSpriteDeclaration.EnableComponent(VertexComponent_Userdata0, ComponentType_Float1, NazaraOffsetOf(LayeredSpriteVertex, layer));
+
 			s_shadowSampler.SetFilterMode(SamplerFilter_Bilinear);
 			s_shadowSampler.SetWrapMode(SamplerWrap_Clamp);
+
+			s_billboardSampler.SetAnisotropyLevel(1);
+			s_billboardSampler.SetFilterMode(SamplerFilter_Nearest);
+			s_billboardSampler.SetWrapMode(SamplerWrap_Clamp);
+
+			s_clusterSampler.SetAnisotropyLevel(1);
+			s_clusterSampler.SetFilterMode(SamplerFilter_Nearest);
+			s_clusterSampler.SetWrapMode(SamplerWrap_Clamp);
 		}
 		catch (const std::exception& e)
 		{
@@ -228,18 +380,242 @@ namespace Nz
 
 	void ForwardRenderTechnique::Uninitialize()
 	{
+		s_billboardPullingBuffer.Reset();
 		s_quadIndexBuffer.Reset();
 		s_quadVertexBuffer.Reset();
 	}
 
+	/*!
+	* \brief Binds the buffers used to draw billboards
+	*
+	* \param drawMode How the billboards are sent to the vertex shader
+	*/
+
+	void ForwardRenderTechnique::BindBillboardBuffers(BillboardDrawMode drawMode) const
+	{
+		switch (drawMode)
+		{
+			case BillboardDrawMode_Instancing:
+			{
+				VertexBuffer* instanceBuffer = Renderer::GetInstanceBuffer();
+				instanceBuffer->SetVertexDeclaration(&s_billboardInstanceDeclaration);
+
+				Renderer::SetVertexBuffer(&s_quadVertexBuffer);
+				break;
+			}
+
+			case BillboardDrawMode_VertexPulling:
+				Renderer::SetVertexBuffer(&s_billboardPullingBuffer);
+				break;
+
+			case BillboardDrawMode_Vertices:
+				Renderer::SetIndexBuffer(&s_quadIndexBuffer);
+				Renderer::SetVertexBuffer(&m_billboardPointBuffer);
+				break;
+		}
+	}
+
+	/*!
+	* \brief Sorts the point and spot lights without shadow map in the clusters of the view frustum
+	*
+	* \param viewer Viewer of the scene
+	*
+	* \remark The clusters are only built when the clustered lighting is enabled and some of these lights are in view
+	*/
+
+	void ForwardRenderTechnique::BuildLightClusters(const AbstractViewer* viewer) const
+	{
+		LightClusters& clusters = m_lightClusters;
+		clusters.active = false;
+
+		if (!m_clusteredLightingEnabled || (m_renderQueue.pointLights.empty() && m_renderQueue.spotLights.empty()))
+			return;
+
+		if (!Texture::IsFormatSupported(PixelFormatType_RGBA32F))
+			return;
+
+		const RenderTarget* target = viewer->GetTarget();
+		const Matrix4f& projectionMatrix = viewer->GetProjectionMatrix();
+		if (!target || projectionMatrix.m44 != 0.f) // Orthographic projection, depth slices don't make sense
+			return;
+
+		NazaraProfileZone("ForwardRenderTechnique::BuildLightClusters");
+
+		const Matrix4f& viewMatrix = viewer->GetViewMatrix();
+		Recti viewport = viewer->GetViewport();
+		Vector3f eyePosition = viewer->GetEyePosition();
+		Vector3f forward = viewer->GetForward();
+		float zNear = viewer->GetZNear();
+		float zFar = viewer->GetZFar();
+
+		float logDepthRatio = std::log(zFar / zNear);
+		clusters.depthAxis = forward;
+		clusters.slicing.Set(s_clusterCountZ / logDepthRatio, -(s_clusterCountZ * std::log(zNear)) / logDepthRatio);
+
+		// gl_FragCoord starts at the bottom of the target
+		clusters.tiles.Set(float(viewport.x), float(target->GetHeight() - viewport.height - viewport.y), float(s_clusterCountX) / viewport.width, float(s_clusterCountY) / viewport.height);
+
+		auto GetSlice = [&clusters] (float depth) -> unsigned int
+		{
+			return static_cast<unsigned int>(Clamp(static_cast<int>(std::log(depth) * clusters.slicing.x + clusters.slicing.y), 0, int(s_clusterCountZ) - 1));
+		};
+
+		auto GetTile = [] (float ndc, unsigned int tileCount) -> unsigned int
+		{
+			return static_cast<unsigned int>(Clamp(static_cast<int>((ndc * 0.5f + 0.5f) * tileCount), 0, int(tileCount) - 1));
+		};
+
+		unsigned int maxLightCount = Renderer::GetMaxTextureSize();
+
+		clusters.lightData.clear();
+		clusters.lightRanges.clear();
+
+		auto AddLight = [&] (const Vector3f& position, float radius, std::initializer_list<float> texels)
+		{
+			if (clusters.lightRanges.size() >= maxLightCount)
+				return;
+
+			float depth = forward.DotProduct(position - eyePosition);
+			if (depth + radius <= zNear || depth - radius >= zFar)
+				return;
+
+			LightClusterRange range;
+			range.minZ = GetSlice(std::max(depth - radius, zNear));
+			range.maxZ = GetSlice(std::min(depth + radius, zFar));
+
+			if (depth - radius <= zNear)
+			{
+				// The light surrounds the near plane, it may reach any tile
+				range.minX = 0;
+				range.maxX = s_clusterCountX - 1;
+				range.minY = 0;
+				range.maxY = s_clusterCountY - 1;
+			}
+			else
+			{
+				// Screen bounds of the corners of the view-space box surrounding the light, all of them being in front of the viewer
+				Vector3f viewPosition = viewMatrix.Transform(position);
+
+				Vector2f ndcMin(std::numeric_limits<float>::infinity());
+				Vector2f ndcMax(-std::numeric_limits<float>::infinity());
+				for (unsigned int corner = 0; corner < 8; ++corner)
+				{
+					Vector3f offset((corner & 1) ? radius : -radius, (corner & 2) ? radius : -radius, (corner & 4) ? radius : -radius);
+					Vector4f clipPosition = projectionMatrix.Transform(Vector4f(viewPosition + offset, 1.f));
+
+					Vector2f ndc(clipPosition.x / clipPosition.w, clipPosition.y / clipPosition.w);
+					ndcMin.Minimize(ndc);
+					ndcMax.Maximize(ndc);
+				}
+
+				if (ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f)
+					return;
+
+				range.minX = GetTile(ndcMin.x, s_clusterCountX);
+				range.maxX = GetTile(ndcMax.x, s_clusterCountX);
+				range.minY = GetTile(ndcMin.y, s_clusterCountY);
+				range.maxY = GetTile(ndcMax.y, s_clusterCountY);
+			}
+
+			clusters.lightRanges.push_back(range);
+			clusters.lightData.insert(clusters.lightData.end(), texels);
+		};
+
+		for (const auto& light : m_renderQueue.pointLights)
+		{
+			if (light.shadowMap)
+				continue;
+
+			AddLight(light.position, light.radius, {light.color.r / 255.f, light.color.g / 255.f, light.color.b / 255.f, float(LightType_Point),
+			                                        light.position.x, light.position.y, light.position.z, light.attenuation,
+			                                        0.f, 0.f, 0.f, light.invRadius,
+			                                        light.ambientFactor, light.diffuseFactor, 0.f, 0.f});
+		}
+
+		for (const auto& light : m_renderQueue.spotLights)
+		{
+			if (light.shadowMap)
+				continue;
+
+			AddLight(light.position, light.radius, {light.color.r / 255.f, light.color.g / 255.f, light.color.b / 255.f, float(LightType_Spot),
+			                                        light.position.x, light.position.y, light.position.z, light.attenuation,
+			                                        light.direction.x, light.direction.y, light.direction.z, light.invRadius,
+			                                        light.ambientFactor, light.diffuseFactor, light.innerAngleCosine, light.outerAngleCosine});
+		}
+
+		unsigned int lightCount = clusters.lightRanges.size();
+		if (lightCount == 0)
+			return;
+
+		// Counting the lights of each cluster, then giving each cluster its part of the index list
+		const unsigned int tileCount = s_clusterCountX * s_clusterCountY;
+		const unsigned int clusterCount = tileCount * s_clusterCountZ;
+
+		clusters.clusterCursors.assign(clusterCount, 0);
+		for (const LightClusterRange& range : clusters.lightRanges)
+		{
+			for (unsigned int z = range.minZ; z <= range.maxZ; ++z)
+				for (unsigned int y = range.minY; y <= range.maxY; ++y)
+					for (unsigned int x = range.minX; x <= range.maxX; ++x)
+						clusters.clusterCursors[z * tileCount + y * s_clusterCountX + x]++;
+		}
+
+		clusters.gridData.resize(clusterCount * 2);
+
+		unsigned int indexCount = 0;
+		for (unsigned int i = 0; i < clusterCount; ++i)
+		{
+			unsigned int clusterLightCount = clusters.clusterCursors[i];
+			clusters.gridData[i * 2 + 0] = float(indexCount);
+			clusters.gridData[i * 2 + 1] = float(clusterLightCount);
+
+			clusters.clusterCursors[i] = indexCount;
+			indexCount += clusterLightCount;
+		}
+
+		unsigned int indexRowCount = (indexCount + s_clusterIndexWidth - 1) / s_clusterIndexWidth;
+		if (indexRowCount > Renderer::GetMaxTextureSize())
+		{
+			NazaraWarning("Too many lights in the light clusters, falling back to per-object lighting");
+			return;
+		}
+
+		clusters.indexData.resize(indexRowCount * s_clusterIndexWidth);
+		for (unsigned int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+		{
+			const LightClusterRange& range = clusters.lightRanges[lightIndex];
+			for (unsigned int z = range.minZ; z <= range.maxZ; ++z)
+				for (unsigned int y = range.minY; y <= range.maxY; ++y)
+					for (unsigned int x = range.minX; x <= range.maxX; ++x)
+						clusters.indexData[clusters.clusterCursors[z * tileCount + y * s_clusterCountX + x]++] = float(lightIndex);
+		}
+
+		// Upload
+		if (!EnsureDataTexture(clusters.gridTexture, PixelFormatType_RG32F, tileCount, s_clusterCountZ) ||
+		    !EnsureDataTexture(clusters.indexTexture, PixelFormatType_R32F, s_clusterIndexWidth, indexRowCount) ||
+		    !EnsureDataTexture(clusters.lightTexture, PixelFormatType_RGBA32F, 4, lightCount))
+			return;
+
+		if (!clusters.gridTexture->Update(reinterpret_cast<const UInt8*>(clusters.gridData.data()), Rectui(0, 0, tileCount, s_clusterCountZ)) ||
+		    !clusters.indexTexture->Update(reinterpret_cast<const UInt8*>(clusters.indexData.data()), Rectui(0, 0, s_clusterIndexWidth, indexRowCount)) ||
+		    !clusters.lightTexture->Update(reinterpret_cast<const UInt8*>(clusters.lightData.data()), Rectui(0, 0, 4, lightCount)))
+		{
+			NazaraError("Failed to update light cluster textures");
+			return;
+		}
+
+		clusters.active = true;
+	}
+
 	/*!
 	* \brief Chooses the nearest lights for one object
 	*
 	* \param object Sphere symbolising the object
 	* \param includeDirectionalLights Should directional lights be included in the computation
+	* \param includeClusteredLights Should the lights sorted in the light clusters be included (they are shaded by the shaders reading the clusters)
 	*/
 
-	void ForwardRenderTechnique::ChooseLights(const Spheref& object, bool includeDirectionalLights) const
+	void ForwardRenderTechnique::ChooseLights(const Spheref& object, bool includeDirectionalLights, bool includeClusteredLights) const
 	{
 		m_lights.clear();
 
@@ -256,9 +632,15 @@ namespace Nz
 			}
 		}
 
+		// Only the lights without shadow map are clustered
+		bool skipClusteredLights = !includeClusteredLights && m_lightClusters.active;
+
 		for (unsigned int i = 0; i < m_renderQueue.pointLights.size(); ++i)
 		{
 			const auto& light = m_renderQueue.pointLights[i];
+			if (skipClusteredLights && !light.shadowMap)
+				continue;
+
 			if (IsPointLightSuitable(object, light))
 				m_lights.push_back({LightType_Point, ComputePointLightScore(object, light), i});
 		}
@@ -266,6 +648,9 @@ namespace Nz
 		for (unsigned int i = 0; i < m_renderQueue.spotLights.size(); ++i)
 		{
 			const auto& light = m_renderQueue.spotLights[i];
+			if (skipClusteredLights && !light.shadowMap)
+				continue;
+
 			if (IsSpotLightSuitable(object, light))
 				m_lights.push_back({LightType_Spot, ComputeSpotLightScore(object, light), i});
 		}
@@ -288,6 +673,8 @@ namespace Nz
 
 	void ForwardRenderTechnique::DrawBasicSprites(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
 	{
+		NazaraGpuZone("ForwardRenderTechnique::DrawBasicSprites");
+
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
 
 		const Shader* lastShader = nullptr;
@@ -295,7 +682,6 @@ namespace Nz
 
 		Renderer::SetIndexBuffer(&s_quadIndexBuffer);
 		Renderer::SetMatrix(MatrixType_World, Matrix4f::Identity());
-		Renderer::SetVertexBuffer(&m_spriteBuffer);
 
 		for (auto& matIt : layer.basicSprites)
 		{
@@ -313,74 +699,7 @@ namespace Nz
 					unsigned int spriteChainCount = spriteChainVector.size();
 					if (spriteChainCount > 0)
 					{
-						// We begin to apply the material (and get the shader activated doing so)
-						UInt32 flags = ShaderFlags_VertexColor;
-						if (overlay)
-							flags |= ShaderFlags_TextureOverlay;
-
-						UInt8 overlayUnit;
-						const Shader* shader = material->Apply(flags, 0, &overlayUnit);
-
-						if (overlay)
-						{
-							overlayUnit++;
-							Renderer::SetTexture(overlayUnit, overlay);
-							Renderer::SetTextureSampler(overlayUnit, material->GetDiffuseSampler());
-						}
-
-						// Uniforms are conserved in our program, there's no point to send them back until they change
-						if (shader != lastShader)
-						{
-							// Index of uniforms in the shader
-							shaderUniforms = GetShaderUniforms(shader);
-
-							// Ambiant color of the scene
-							shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-							// Overlay
-							shader->SendInteger(shaderUniforms->textureOverlay, overlayUnit);
-							// Position of the camera
-							shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
-
-							lastShader = shader;
-						}
-
-						unsigned int spriteChain = 0; // Which chain of sprites are we treating
-						unsigned int spriteChainOffset = 0; // Where was the last offset where we stopped in the last chain
-
-						do
-						{
-							// We open the buffer in writing mode
-							BufferMapper<VertexBuffer> vertexMapper(m_spriteBuffer, BufferAccess_DiscardAndWrite);
-							VertexStruct_XYZ_Color_UV* vertices = static_cast<VertexStruct_XYZ_Color_UV*>(vertexMapper.GetPointer());
-
-							unsigned int spriteCount = 0;
-							unsigned int maxSpriteCount = std::min(s_maxQuads, m_spriteBuffer.GetVertexCount() / 4);
-
-							do
-							{
-								ForwardRenderQueue::SpriteChain_XYZ_Color_UV& currentChain = spriteChainVector[spriteChain];
-								unsigned int count = std::min(maxSpriteCount - spriteCount, currentChain.spriteCount - spriteChainOffset);
-
-								std::memcpy(vertices, currentChain.vertices + spriteChainOffset * 4, 4 * count * sizeof(VertexStruct_XYZ_Color_UV));
-								vertices += count * 4;
-
-								spriteCount += count;
-								spriteChainOffset += count;
-
-								// Have we treated the entire chain ?
-								if (spriteChainOffset == currentChain.spriteCount)
-								{
-									spriteChain++;
-									spriteChainOffset = 0;
-								}
-							}
-							while (spriteCount < maxSpriteCount && spriteChain < spriteChainCount);
-
-							vertexMapper.Unmap();
-
-							Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, spriteCount * 6);
-						}
-						while (spriteChain < spriteChainCount);
+						DrawSpriteChains(sceneData, material, overlay, spriteChainVector.data(), spriteChainCount, lastShader, shaderUniforms);
 
 						spriteChainVector.clear();
 					}
@@ -393,161 +712,166 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Draws billboards
+	* \brief Draws billboards sharing a material
 	*
 	* \param sceneData Data of the scene
-	* \param layer Layer of the rendering
+	* \param material Material of the billboards
+	* \param billboards Billboards to draw
+	* \param billboardCount Number of billboards
+	* \param drawMode How the billboards are sent to the vertex shader
+	* \param lastShader Last shader used, updated if the material activates another one
+	* \param shaderUniforms Uniforms of the last shader, updated along with it
 	*
-	* \remark Produces a NazaraAssert is viewer is invalid
+	* \remark The buffers matching the draw mode must be bound (see BindBillboardBuffers)
 	*/
 
-	void ForwardRenderTechnique::DrawBillboards(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
+	void ForwardRenderTechnique::DrawBillboardBatch(const SceneData& sceneData, const Material* material, const ForwardRenderQueue::BillboardData* billboards, unsigned int billboardCount, BillboardDrawMode drawMode, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms) const
 	{
-		NazaraAssert(sceneData.viewer, "Invalid viewer");
+		UInt32 flags = ShaderFlags_Billboard | ShaderFlags_VertexColor;
+		if (drawMode == BillboardDrawMode_Instancing)
+			flags |= ShaderFlags_Instancing;
+		else if (drawMode == BillboardDrawMode_VertexPulling)
+			flags |= ShaderFlags_VertexPulling;
+
+		// We begin to apply the material (and get the shader activated doing so)
+		UInt8 freeTextureUnit;
+		const Shader* shader = material->Apply(flags, 0, &freeTextureUnit);
+
+		// Uniforms are conserved in our program, there's no point to send them back until they change
+		if (shader != lastShader)
+		{
+			// Index of uniforms in the shader
+			shaderUniforms = GetShaderUniforms(shader);
 
-		const Shader* lastShader = nullptr;
-		const ShaderUniforms* shaderUniforms = nullptr;
+			// Ambiant color of the scene
+			shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+			// Position of the camera
+			shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+			lastShader = shader;
+		}
 
-		if (Renderer::HasCapability(RendererCap_Instancing))
+		const ForwardRenderQueue::BillboardData* data = billboards;
+		switch (drawMode)
 		{
-			VertexBuffer* instanceBuffer = Renderer::GetInstanceBuffer();
-			instanceBuffer->SetVertexDeclaration(&s_billboardInstanceDeclaration);
+			case BillboardDrawMode_Instancing:
+			{
+				VertexBuffer* instanceBuffer = Renderer::GetInstanceBuffer();
+				unsigned int maxBillboardPerDraw = instanceBuffer->GetVertexCount();
+				do
+				{
+					unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
+					billboardCount -= renderedBillboardCount;
 
-			Renderer::SetVertexBuffer(&s_quadVertexBuffer);
+					instanceBuffer->Fill(data, 0, renderedBillboardCount, true);
+					data += renderedBillboardCount;
 
-			for (auto& matIt : layer.billboards)
-			{
-				const Material* material = matIt.first;
-				auto& entry = matIt.second;
-				auto& billboardVector = entry.billboards;
+					Renderer::DrawPrimitivesInstanced(renderedBillboardCount, PrimitiveMode_TriangleStrip, 0, 4);
+				}
+				while (billboardCount > 0);
+				break;
+			}
 
-				unsigned int billboardCount = billboardVector.size();
-				if (billboardCount > 0)
+			case BillboardDrawMode_VertexPulling:
+			{
+				// Each billboard takes a row of three texels, only the texture height limits the billboards drawn at once
+				unsigned int maxBillboardPerDraw = Renderer::GetMaxTextureSize();
+				do
 				{
-					// We begin to apply the material (and get the shader activated doing so)
-					const Shader* shader = material->Apply(ShaderFlags_Billboard | ShaderFlags_Instancing | ShaderFlags_VertexColor);
+					unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
+					billboardCount -= renderedBillboardCount;
 
-					// Uniforms are conserved in our program, there's no point to send them back until they change
-					if (shader != lastShader)
+					m_billboardTexels.resize(renderedBillboardCount * 3);
+					Vector4f* texels = m_billboardTexels.data();
+					for (unsigned int i = 0; i < renderedBillboardCount; ++i)
 					{
-						// Index of uniforms in the shader
-						shaderUniforms = GetShaderUniforms(shader);
+						const ForwardRenderQueue::BillboardData& billboard = *data++;
 
-						// Ambiant color of the scene
-						shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-						// Position of the camera
-						shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+						texels->Set(billboard.center, 0.f);
+						texels++;
 
-						lastShader = shader;
+						texels->Set(billboard.size.x, billboard.size.y, billboard.sinCos.x, billboard.sinCos.y);
+						texels++;
+
+						texels->Set(billboard.color.r / 255.f, billboard.color.g / 255.f, billboard.color.b / 255.f, billboard.color.a / 255.f);
+						texels++;
 					}
 
-					const ForwardRenderQueue::BillboardData* data = &billboardVector[0];
-					unsigned int maxBillboardPerDraw = instanceBuffer->GetVertexCount();
-					do
+					if (!EnsureDataTexture(m_billboardTexture, PixelFormatType_RGBA32F, 3, renderedBillboardCount) ||
+					    !m_billboardTexture->Update(reinterpret_cast<const UInt8*>(m_billboardTexels.data()), Rectui(0, 0, 3, renderedBillboardCount)))
 					{
-						unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
-						billboardCount -= renderedBillboardCount;
-
-						instanceBuffer->Fill(data, 0, renderedBillboardCount, true);
-						data += renderedBillboardCount;
-
-						Renderer::DrawPrimitivesInstanced(renderedBillboardCount, PrimitiveMode_TriangleStrip, 0, 4);
+						NazaraError("Failed to update billboard texture");
+						break;
 					}
-					while (billboardCount > 0);
 
-					billboardVector.clear();
+					Renderer::SetTexture(freeTextureUnit, m_billboardTexture);
+					Renderer::SetTextureSampler(freeTextureUnit, s_billboardSampler);
+					shader->SendInteger(shaderUniforms->billboardData, freeTextureUnit);
+
+					Renderer::DrawPrimitives(PrimitiveMode_TriangleList, 0, renderedBillboardCount * 6);
 				}
+				while (billboardCount > 0);
+				break;
 			}
-		}
-		else
-		{
-			Renderer::SetIndexBuffer(&s_quadIndexBuffer);
-			Renderer::SetVertexBuffer(&m_billboardPointBuffer);
 
-			for (auto& matIt : layer.billboards)
+			case BillboardDrawMode_Vertices:
 			{
-				const Material* material = matIt.first;
-				auto& entry = matIt.second;
-				auto& billboardVector = entry.billboards;
-
-				unsigned int billboardCount = billboardVector.size();
-				if (billboardCount > 0)
+				unsigned int maxBillboardPerDraw = std::min(s_maxQuads, m_billboardPointBuffer.GetVertexCount() / 4);
+				do
 				{
-					// We begin to apply the material (and get the shader activated doing so)
-					const Shader* shader = material->Apply(ShaderFlags_Billboard | ShaderFlags_VertexColor);
-
-					// Uniforms are conserved in our program, there's no point to send them back until they change
-					if (shader != lastShader)
-					{
-						// Index of uniforms in the shader
-						shaderUniforms = GetShaderUniforms(shader);
-
-						// Ambiant color of the scene
-						shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-						// Position of the camera
-						shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
-
-						lastShader = shader;
-					}
+					unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
+					billboardCount -= renderedBillboardCount;
 
-					const ForwardRenderQueue::BillboardData* data = &billboardVector[0];
-					unsigned int maxBillboardPerDraw = std::min(s_maxQuads, m_billboardPointBuffer.GetVertexCount() / 4);
+					unsigned int vertexOffset;
+					BillboardPoint* vertices = static_cast<BillboardPoint*>(m_vertexBuffer.Map(renderedBillboardCount * 4 * sizeof(BillboardPoint), sizeof(BillboardPoint), &vertexOffset));
+					if (!vertices)
+						break;
 
-					do
+					for (unsigned int i = 0; i < renderedBillboardCount; ++i)
 					{
-						unsigned int renderedBillboardCount = std::min(billboardCount, maxBillboardPerDraw);
-						billboardCount -= renderedBillboardCount;
-
-						BufferMapper<VertexBuffer> vertexMapper(m_billboardPointBuffer, BufferAccess_DiscardAndWrite, 0, renderedBillboardCount * 4);
-						BillboardPoint* vertices = static_cast<BillboardPoint*>(vertexMapper.GetPointer());
-
-						for (unsigned int i = 0; i < renderedBillboardCount; ++i)
-						{
-							const ForwardRenderQueue::BillboardData& billboard = *data++;
-
-							vertices->color = billboard.color;
-							vertices->position = billboard.center;
-							vertices->sinCos = billboard.sinCos;
-							vertices->size = billboard.size;
-							vertices->uv.Set(0.f, 1.f);
-							vertices++;
-
-							vertices->color = billboard.color;
-							vertices->position = billboard.center;
-							vertices->sinCos = billboard.sinCos;
-							vertices->size = billboard.size;
-							vertices->uv.Set(1.f, 1.f);
-							vertices++;
-
-							vertices->color = billboard.color;
-							vertices->position = billboard.center;
-							vertices->sinCos = billboard.sinCos;
-							vertices->size = billboard.size;
-							vertices->uv.Set(0.f, 0.f);
-							vertices++;
-
-							vertices->color = billboard.color;
-							vertices->position = billboard.center;
-							vertices->sinCos = billboard.sinCos;
-							vertices->size = billboard.size;
-							vertices->uv.Set(1.f, 0.f);
-							vertices++;
-						}
-
-						vertexMapper.Unmap();
-
-						Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, renderedBillboardCount * 6);
+						const ForwardRenderQueue::BillboardData& billboard = *data++;
+
+						vertices->color = billboard.color;
+						vertices->position = billboard.center;
+						vertices->sinCos = billboard.sinCos;
+						vertices->size = billboard.size;
+						vertices->uv.Set(0.f, 1.f);
+						vertices++;
+
+						vertices->color = billboard.color;
+						vertices->position = billboard.center;
+						vertices->sinCos = billboard.sinCos;
+						vertices->size = billboard.size;
+						vertices->uv.Set(1.f, 1.f);
+						vertices++;
+
+						vertices->color = billboard.color;
+						vertices->position = billboard.center;
+						vertices->sinCos = billboard.sinCos;
+						vertices->size = billboard.size;
+						vertices->uv.Set(0.f, 0.f);
+						vertices++;
+
+						vertices->color = billboard.color;
+						vertices->position = billboard.center;
+						vertices->sinCos = billboard.sinCos;
+						vertices->size = billboard.size;
+						vertices->uv.Set(1.f, 0.f);
+						vertices++;
 					}
-					while (billboardCount > 0);
 
-					billboardVector.clear();
+					m_vertexBuffer.Unmap();
+
+					Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, renderedBillboardCount * 6, vertexOffset / sizeof(BillboardPoint));
 				}
+				while (billboardCount > 0);
+				break;
 			}
 		}
 	}
 
 	/*!
-	* \brief Draws opaques models
+	* \brief Draws billboards
 	*
 	* \param sceneData Data of the scene
 	* \param layer Layer of the rendering
@@ -555,302 +879,898 @@ namespace Nz
 	* \remark Produces a NazaraAssert is viewer is invalid
 	*/
 
-	void ForwardRenderTechnique::DrawOpaqueModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
+	void ForwardRenderTechnique::DrawBillboards(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
 	{
+		NazaraGpuZone("ForwardRenderTechnique::DrawBillboards");
+
 		NazaraAssert(sceneData.viewer, "Invalid viewer");
 
 		const Shader* lastShader = nullptr;
 		const ShaderUniforms* shaderUniforms = nullptr;
 
-		for (auto& matIt : layer.opaqueModels)
+		BillboardDrawMode drawMode = GetBillboardDrawMode();
+		BindBillboardBuffers(drawMode);
+
+		for (auto& matIt : layer.billboards)
 		{
-			auto& matEntry = matIt.second;
+			const Material* material = matIt.first;
+			auto& entry = matIt.second;
+			auto& billboardVector = entry.billboards;
 
-			if (matEntry.enabled)
+			unsigned int billboardCount = billboardVector.size();
+			if (billboardCount > 0)
 			{
-				ForwardRenderQueue::MeshInstanceContainer& meshInstances = matEntry.meshMap;
+				DrawBillboardBatch(sceneData, material, billboardVector.data(), billboardCount, drawMode, lastShader, shaderUniforms);
 
-				if (!meshInstances.empty())
-				{
-					const Material* material = matIt.first;
+				billboardVector.clear();
+			}
+		}
+	}
 
-					// We only use instancing when no light (other than directional) is active
-					// This is because instancing is not compatible with the search of nearest lights
-					// Deferred shading does not have this problem
-					bool noPointSpotLight = m_renderQueue.pointLights.empty() && m_renderQueue.spotLights.empty();
-					bool instancing = m_instancingEnabled && (!material->IsLightingEnabled() || noPointSpotLight) && matEntry.instancingEnabled;
+	/*!
+	* \brief Draws the sorted command list of the queue
+	*
+	* \param sceneData Data of the scene
+	*
+	* \remark Produces a NazaraAssert is viewer is invalid
+	*/
 
-					// We begin to apply the material (and get the shader activated doing so)
-					UInt8 freeTextureUnit;
-					const Shader* shader = material->Apply((instancing) ? ShaderFlags_Instancing : 0, 0, &freeTextureUnit);
+	void ForwardRenderTechnique::DrawCommandList(const SceneData& sceneData) const
+	{
+		NazaraGpuZone("ForwardRenderTechnique::DrawCommandList");
 
-					// Uniforms are conserved in our program, there's no point to send them back until they change
-					if (shader != lastShader)
-					{
-						// Index of uniforms in the shader
-						shaderUniforms = GetShaderUniforms(shader);
+		NazaraAssert(sceneData.viewer, "Invalid viewer");
 
-						// Ambiant color of the scene
-						shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-						// Position of the camera
-						shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+		const ForwardRenderQueue::CommandList& commandList = m_renderQueue.commandList;
+		const auto& commands = commandList.commands;
 
-						lastShader = shader;
-					}
+		BillboardDrawMode billboardDrawMode = GetBillboardDrawMode();
 
-					// Meshes
-					for (auto& meshIt : meshInstances)
+		std::size_t commandCount = commands.size();
+		std::size_t groupStart = 0;
+		while (groupStart < commandCount)
+		{
+			// Commands of the same layer and type follow each other, and are drawn the same way the layers would be
+			UInt8 layer = ForwardRenderQueue::GetCommandLayer(commands[groupStart].sortKey);
+			ForwardRenderQueue::CommandType type = ForwardRenderQueue::GetCommandType(commands[groupStart].sortKey);
+
+			std::size_t groupEnd = groupStart + 1;
+			while (groupEnd < commandCount && ForwardRenderQueue::GetCommandLayer(commands[groupEnd].sortKey) == layer && ForwardRenderQueue::GetCommandType(commands[groupEnd].sortKey) == type)
+				groupEnd++;
+
+			const Shader* lastShader = nullptr;
+			const ShaderUniforms* shaderUniforms = nullptr;
+
+			switch (type)
+			{
+				case ForwardRenderQueue::CommandType_Billboards:
+				{
+					BindBillboardBuffers(billboardDrawMode);
+
+					for (std::size_t i = groupStart; i < groupEnd;)
 					{
-						const MeshData& meshData = meshIt.first;
-						auto& meshEntry = meshIt.second;
+						const Material* material = commandList.billboardCommands[commands[i].index].material;
 
-						const Spheref& squaredBoundingSphere = meshEntry.squaredBoundingSphere;
-						std::vector<Matrix4f>& instances = meshEntry.instances;
+						// Billboards of a material are gathered, unless they come from a single command
+						m_commandBillboards.clear();
 
-						if (!instances.empty())
+						std::size_t j = i;
+						for (; j < groupEnd; ++j)
 						{
-							const IndexBuffer* indexBuffer = meshData.indexBuffer;
-							const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
+							const ForwardRenderQueue::BillboardCommandData& data = commandList.billboardCommands[commands[j].index];
+							if (data.material != material)
+								break;
 
-							// Handle draw call before rendering loop
-							Renderer::DrawCall drawFunc;
-							Renderer::DrawCallInstanced instancedDrawFunc;
-							unsigned int indexCount;
+							const ForwardRenderQueue::BillboardData* billboards = &commandList.billboards[data.firstBillboard];
+							m_commandBillboards.insert(m_commandBillboards.end(), billboards, billboards + data.billboardCount);
+						}
 
-							if (indexBuffer)
-							{
-								drawFunc = Renderer::DrawIndexedPrimitives;
-								instancedDrawFunc = Renderer::DrawIndexedPrimitivesInstanced;
-								indexCount = indexBuffer->GetIndexCount();
-							}
-							else
-							{
-								drawFunc = Renderer::DrawPrimitives;
-								instancedDrawFunc = Renderer::DrawPrimitivesInstanced;
-								indexCount = vertexBuffer->GetVertexCount();
-							}
+						if (!m_commandBillboards.empty())
+							DrawBillboardBatch(sceneData, material, m_commandBillboards.data(), m_commandBillboards.size(), billboardDrawMode, lastShader, shaderUniforms);
+
+						i = j;
+					}
+					break;
+				}
 
-							Renderer::SetIndexBuffer(indexBuffer);
-							Renderer::SetVertexBuffer(vertexBuffer);
+				case ForwardRenderQueue::CommandType_Drawable:
+				{
+					for (std::size_t i = groupStart; i < groupEnd; ++i)
+						commandList.drawables[commands[i].index]->Draw();
 
-							if (instancing)
-							{
-								// We compute the number of instances that we will be able to draw this time (depending on the instancing buffer size)
-								VertexBuffer* instanceBuffer = Renderer::GetInstanceBuffer();
-								instanceBuffer->SetVertexDeclaration(VertexDeclaration::Get(VertexLayout_Matrix4));
-
-								// With instancing, impossible to select the lights for each object
-								// So, it's only activated for directional lights
-								unsigned int lightCount = m_renderQueue.directionalLights.size();
-								unsigned int lightIndex = 0;
-								RendererComparison oldDepthFunc = Renderer::GetDepthFunc();
-
-								unsigned int passCount = (lightCount == 0) ? 1 : (lightCount - 1) / NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS + 1;
-								for (unsigned int pass = 0; pass < passCount; ++pass)
-								{
-									if (shaderUniforms->hasLightUniforms)
-									{
-										unsigned int renderedLightCount = std::min(lightCount, NazaraSuffixMacro(NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS, U));
-										lightCount -= renderedLightCount;
-
-										if (pass == 1)
-										{
-											// To add the result of light computations
-											// We won't interfeer with materials parameters because we only render opaques objects
-											// (A.K.A., without blending)
-											// About the depth function, it must be applied only the first time
-											Renderer::Enable(RendererParameter_Blend, true);
-											Renderer::SetBlendFunc(BlendFunc_One, BlendFunc_One);
-											Renderer::SetDepthFunc(RendererComparison_Equal);
-										}
-
-										// Sends the uniforms
-										for (unsigned int i = 0; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
-											SendLightUniforms(shader, shaderUniforms->lightUniforms, lightIndex++, shaderUniforms->lightOffset * i, freeTextureUnit + i);
-
-										// And we give them to draw
-										drawFunc(meshData.primitiveMode, 0, indexCount);
-									}
-
-									const Matrix4f* instanceMatrices = &instances[0];
-									unsigned int instanceCount = instances.size();
-									unsigned int maxInstanceCount = instanceBuffer->GetVertexCount(); // Maximum number of instance in one batch
-
-									while (instanceCount > 0)
-									{
-										// We compute the number of instances that we will be able to draw this time (depending on the instancing buffer size)
-										unsigned int renderedInstanceCount = std::min(instanceCount, maxInstanceCount);
-										instanceCount -= renderedInstanceCount;
-
-										// We fill the instancing buffer with our world matrices
-										instanceBuffer->Fill(instanceMatrices, 0, renderedInstanceCount, true);
-										instanceMatrices += renderedInstanceCount;
-
-										// And we draw
-										instancedDrawFunc(renderedInstanceCount, meshData.primitiveMode, 0, indexCount);
-									}
-								}
-
-								// We don't forget to disable the blending to avoid to interfeer with the rest of the rendering
-								Renderer::Enable(RendererParameter_Blend, false);
-								Renderer::SetDepthFunc(oldDepthFunc);
-							}
-							else
+					break;
+				}
+
+				case ForwardRenderQueue::CommandType_OpaqueModel:
+				{
+					const Material* appliedMaterial = nullptr;
+					const Shader* shader = nullptr;
+					UInt32 appliedFlags = 0;
+					UInt8 freeTextureUnit = 0;
+
+					for (std::size_t i = groupStart; i < groupEnd;)
+					{
+						const ForwardRenderQueue::ModelCommandData& modelData = commandList.models[commands[i].index];
+						const Material* material = modelData.material;
+						const MeshData& meshData = modelData.meshData;
+
+						// Instances of a mesh using the same material are gathered
+						m_commandInstances.clear();
+
+						std::size_t j = i;
+						for (; j < groupEnd; ++j)
+						{
+							const ForwardRenderQueue::ModelCommandData& instanceData = commandList.models[commands[j].index];
+							if (instanceData.material != material || !IsSameMesh(instanceData.meshData, meshData))
+								break;
+
+							m_commandInstances.push_back(instanceData.transformMatrix);
+						}
+
+						// Same conditions as the batched models (see DrawOpaqueModels)
+						bool instancing = m_instancingEnabled && m_commandInstances.size() >= NAZARA_GRAPHICS_INSTANCING_MIN_INSTANCES_COUNT;
+
+						UInt32 flags = (instancing) ? ShaderFlags_Instancing : 0;
+						if (meshData.skeleton)
+							flags |= ShaderFlags_Skinning;
+
+						if (m_lightClusters.active && material->IsLightingEnabled())
+							flags |= ShaderFlags_ClusteredLighting;
+
+						if (material != appliedMaterial || flags != appliedFlags)
+						{
+							// We begin to apply the material (and get the shader activated doing so)
+							shader = material->Apply(flags, 0, &freeTextureUnit);
+
+							// Uniforms are conserved in our program, there's no point to send them back until they change
+							if (shader != lastShader)
 							{
-								if (shaderUniforms->hasLightUniforms)
-								{
-									for (const Matrix4f& matrix : instances)
-									{
-										// Choose the lights depending on an object position and apparent radius
-										ChooseLights(Spheref(matrix.GetTranslation() + squaredBoundingSphere.GetPosition(), squaredBoundingSphere.radius));
-
-										unsigned int lightCount = m_lights.size();
-
-										Renderer::SetMatrix(MatrixType_World, matrix);
-										unsigned int lightIndex = 0;
-										RendererComparison oldDepthFunc = Renderer::GetDepthFunc(); // In the case where we have to change it
-
-										unsigned int passCount = (lightCount == 0) ? 1 : (lightCount - 1) / NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS + 1;
-										for (unsigned int pass = 0; pass < passCount; ++pass)
-										{
-											lightCount -= std::min(lightCount, NazaraSuffixMacro(NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS, U));
-
-											if (pass == 1)
-											{
-												// To add the result of light computations
-												// We won't interfeer with materials parameters because we only render opaques objects
-												// (A.K.A., without blending)
-												// About the depth function, it must be applied only the first time
-												Renderer::Enable(RendererParameter_Blend, true);
-												Renderer::SetBlendFunc(BlendFunc_One, BlendFunc_One);
-												Renderer::SetDepthFunc(RendererComparison_Equal);
-											}
-
-											// Sends the light uniforms to the shader
-											for (unsigned int i = 0; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
-												SendLightUniforms(shader, shaderUniforms->lightUniforms, lightIndex++, shaderUniforms->lightOffset*i, freeTextureUnit + i);
-
-											// And we draw
-											drawFunc(meshData.primitiveMode, 0, indexCount);
-										}
-
-										Renderer::Enable(RendererParameter_Blend, false);
-										Renderer::SetDepthFunc(oldDepthFunc);
-									}
-								}
-								else
-								{
-									// Without instancing, we must do a draw call for each instance
-									// This may be faster than instancing under a certain number
-									// Due to the time to modify the instancing buffer
-									for (const Matrix4f& matrix : instances)
-									{
-										Renderer::SetMatrix(MatrixType_World, matrix);
-										drawFunc(meshData.primitiveMode, 0, indexCount);
-									}
-								}
+								// Index of uniforms in the shader
+								shaderUniforms = GetShaderUniforms(shader);
+
+								// Ambiant color of the scene
+								shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+								// Position of the camera
+								shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+								lastShader = shader;
 							}
-							instances.clear();
+
+							// The joints texture takes the first free unit, lights come after it
+							if (meshData.skeleton)
+								freeTextureUnit++;
+
+							appliedMaterial = material;
+							appliedFlags = flags;
 						}
+
+						DrawMeshInstances(shader, shaderUniforms, freeTextureUnit, meshData, modelData.squaredBoundingSphere, m_commandInstances.data(), m_commandInstances.size(), instancing);
+
+						i = j;
 					}
+					break;
 				}
 
-				// And we set the data back to zero
-				matEntry.enabled = false;
-				matEntry.instancingEnabled = false;
+				case ForwardRenderQueue::CommandType_Sprites:
+				{
+					Renderer::SetIndexBuffer(&s_quadIndexBuffer);
+					Renderer::SetMatrix(MatrixType_World, Matrix4f::Identity());
+
+					for (std::size_t i = groupStart; i < groupEnd;)
+					{
+						const ForwardRenderQueue::SpriteCommandData& spriteData = commandList.sprites[commands[i].index];
+
+						// Chains of sprites sharing a material and an overlay are gathered
+						m_commandSpriteChains.clear();
+
+						std::size_t j = i;
+						for (; j < groupEnd; ++j)
+						{
+							const ForwardRenderQueue::SpriteCommandData& chainData = commandList.sprites[commands[j].index];
+							if (chainData.material != spriteData.material || chainData.overlay != spriteData.overlay)
+								break;
+
+							if (chainData.spriteChain.spriteCount > 0)
+								m_commandSpriteChains.push_back(chainData.spriteChain);
+						}
+
+						if (!m_commandSpriteChains.empty())
+							DrawSpriteChains(sceneData, spriteData.material, spriteData.overlay, m_commandSpriteChains.data(), m_commandSpriteChains.size(), lastShader, shaderUniforms);
+
+						i = j;
+					}
+					break;
+				}
+
+				case ForwardRenderQueue::CommandType_TransparentModel:
+				{
+					unsigned int lightCount = 0;
+
+					for (std::size_t i = groupStart; i < groupEnd; ++i)
+					{
+						const ForwardRenderQueue::ModelCommandData& modelData = commandList.models[commands[i].index];
+						const Matrix4f& matrix = modelData.transformMatrix;
+
+						Spheref squaredBoundingSphere(matrix.GetTranslation() + modelData.squaredBoundingSphere.GetPosition(), modelData.squaredBoundingSphere.radius);
+						DrawTransparentModel(sceneData, modelData.material, modelData.meshData, matrix, squaredBoundingSphere, lastShader, shaderUniforms, lightCount);
+					}
+					break;
+				}
 			}
+
+			groupStart = groupEnd;
 		}
 	}
 
 	/*!
-	* \brief Draws transparent models
+	* \brief Draws the depth of the opaque models of a layer
 	*
-	* \param sceneData Data of the scene
 	* \param layer Layer of the rendering
 	*
-	* \remark Produces a NazaraAssert is viewer is invalid
+	* \remark The instances are kept for DrawOpaqueModels
 	*/
 
-	void ForwardRenderTechnique::DrawTransparentModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
+	void ForwardRenderTechnique::DrawDepthPrepass(ForwardRenderQueue::Layer& layer) const
 	{
-		NazaraAssert(sceneData.viewer, "Invalid viewer");
+		NazaraGpuZone("ForwardRenderTechnique::DrawDepthPrepass");
 
 		const Shader* lastShader = nullptr;
 		const ShaderUniforms* shaderUniforms = nullptr;
-		unsigned int lightCount = 0;
 
-		for (unsigned int index : layer.transparentModels)
+		for (auto& matIt : layer.opaqueModels)
 		{
-			const ForwardRenderQueue::TransparentModelData& modelData = layer.transparentModelData[index];
+			const Material* material = matIt.first;
+			auto& matEntry = matIt.second;
+
+			if (!matEntry.enabled || matEntry.meshMap.empty() || !IsDepthPrepassSuitable(material))
+				continue;
+
+			const Material* depthMaterial = (material->HasDepthMaterial()) ? material->GetDepthMaterial() : m_depthPrepassMaterial;
 
-			// Material
-			const Material* material = modelData.material;
+			bool instancing = m_instancingEnabled && matEntry.instancingEnabled;
+			UInt32 flags = (instancing) ? ShaderFlags_Instancing : 0;
 
-			// We begin to apply the material (and get the shader activated doing so)
-			UInt8 freeTextureUnit;
-			const Shader* shader = material->Apply(0, 0, &freeTextureUnit);
+			const Shader* shader = nullptr;
+			bool skinning = false;
+			UInt8 freeTextureUnit = 0;
 
-			// Uniforms are conserved in our program, there's no point to send them back until they change
-			if (shader != lastShader)
+			for (auto& meshIt : matEntry.meshMap)
 			{
-				// Index of uniforms in the shader
-				shaderUniforms = GetShaderUniforms(shader);
+				const MeshData& meshData = meshIt.first;
+				auto& meshEntry = meshIt.second;
 
-				// Ambiant color of the scene
-				shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
-				// Position of the camera
-				shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+				const std::vector<Matrix4f>& instances = meshEntry.instances;
+				if (instances.empty())
+					continue;
 
-				// We send the directional lights if there is one (same for all)
-				if (shaderUniforms->hasLightUniforms)
+				bool skinned = (meshData.skeleton != nullptr);
+				if (!shader || skinned != skinning)
 				{
-					lightCount = std::min(m_renderQueue.directionalLights.size(), static_cast<decltype(m_renderQueue.directionalLights.size())>(NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS));
+					shader = depthMaterial->Apply((skinned) ? flags | ShaderFlags_Skinning : flags, 0, &freeTextureUnit);
+					if (shader != lastShader)
+					{
+						shaderUniforms = GetShaderUniforms(shader);
+						lastShader = shader;
+					}
+
+					// The depth written must be the one the shading pass will compare to, whatever the depth material does
+					Renderer::Enable(RendererParameter_ColorWrite, false);
+					Renderer::Enable(RendererParameter_DepthBuffer, true);
+					Renderer::Enable(RendererParameter_DepthWrite, true);
+					Renderer::Enable(RendererParameter_FaceCulling, material->IsEnabled(RendererParameter_FaceCulling));
+					Renderer::SetDepthFunc(material->GetDepthFunc());
+					Renderer::SetFaceCulling(material->GetFaceCulling());
 
-					for (unsigned int i = 0; i < lightCount; ++i)
-						SendLightUniforms(shader, shaderUniforms->lightUniforms, i, shaderUniforms->lightOffset * i, freeTextureUnit++);
+					if (skinned)
+						freeTextureUnit++;
+
+					skinning = skinned;
 				}
 
-				lastShader = shader;
+				DrawMeshInstances(shader, shaderUniforms, freeTextureUnit, meshData, meshEntry.squaredBoundingSphere, instances.data(), instances.size(), instancing);
 			}
+		}
+	}
+
+	/*!
+	* \brief Draws the instances of a mesh, the material being already applied
+	*
+	* \param shader Shader activated by the material
+	* \param shaderUniforms Uniforms of the shader
+	* \param freeTextureUnit First texture unit free after the material (and the skinning texture, if any)
+	* \param meshData Data of the mesh
+	* \param squaredBoundingSphere Bounding sphere of the mesh, relative to its instances
+	* \param instances World matrices of the instances
+	* \param instanceCount Number of instances
+	* \param instancing Should the instances be drawn with instancing
+	*/
+
+	void ForwardRenderTechnique::DrawMeshInstances(const Shader* shader, const ShaderUniforms* shaderUniforms, UInt8 freeTextureUnit, const MeshData& meshData, const Spheref& squaredBoundingSphere, const Matrix4f* instances, unsigned int instanceCount, bool instancing) const
+	{
+		if (meshData.skeleton)
+		{
+			UInt8 skinningTextureUnit = freeTextureUnit - 1;
 
-			// Mesh
-			const Matrix4f& matrix = modelData.transformMatrix;
-			const MeshData& meshData = modelData.meshData;
+			SkinningManager::BindSkinningTexture(meshData.skeleton, skinningTextureUnit);
+			shader->SendInteger(shaderUniforms->skinningMatrices, skinningTextureUnit);
+		}
 
-			const IndexBuffer* indexBuffer = meshData.indexBuffer;
-			const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
+		const IndexBuffer* indexBuffer = meshData.indexBuffer;
+		const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
 
-			// Handle draw call before the rendering loop
-			Renderer::DrawCall drawFunc;
-			unsigned int indexCount;
+		// Handle draw call before rendering loop
+		Renderer::DrawCall drawFunc;
+		Renderer::DrawCallInstanced instancedDrawFunc;
+		unsigned int indexCount;
 
-			if (indexBuffer)
+		if (indexBuffer)
+		{
+			drawFunc = Renderer::DrawIndexedPrimitives;
+			instancedDrawFunc = Renderer::DrawIndexedPrimitivesInstanced;
+			indexCount = indexBuffer->GetIndexCount();
+		}
+		else
+		{
+			drawFunc = Renderer::DrawPrimitives;
+			instancedDrawFunc = Renderer::DrawPrimitivesInstanced;
+			indexCount = vertexBuffer->GetVertexCount();
+		}
+
+		Renderer::SetIndexBuffer(indexBuffer);
+		Renderer::SetVertexBuffer(vertexBuffer);
+
+		// The clustered lights are shaded by the first pass, the others only get the lights chosen for the objects
+		bool clustered = m_lightClusters.active && shaderUniforms->clusterLights != -1;
+		UInt8 clusterTextureUnit = freeTextureUnit + NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS;
+
+		if (instancing)
+		{
+			// The matrices are streamed once in the instance ring buffer, draws then reference their range by its first instance
+			auto DrawInstances = [&] (const Matrix4f* instanceMatrices, unsigned int remainingInstanceCount)
 			{
-				drawFunc = Renderer::DrawIndexedPrimitives;
-				indexCount = indexBuffer->GetIndexCount();
+				unsigned int maxInstanceCount = m_instanceBuffer.GetVertexCount(); // Maximum number of instance in one batch
+
+				while (remainingInstanceCount > 0)
+				{
+					unsigned int renderedInstanceCount = std::min(remainingInstanceCount, maxInstanceCount);
+					remainingInstanceCount -= renderedInstanceCount;
+
+					unsigned int firstInstance;
+					if (!StreamInstances(instanceMatrices, renderedInstanceCount, &firstInstance))
+						return;
+
+					instanceMatrices += renderedInstanceCount;
+
+					Renderer::SetInstanceBuffer(&m_instanceBuffer, firstInstance);
+					instancedDrawFunc(renderedInstanceCount, meshData.primitiveMode, 0, indexCount);
+				}
+			};
+
+			if (shaderUniforms->hasLightUniforms)
+			{
+				// The lights are chosen for each instance, the instances lit by the same lights being drawn together
+				// In a field of objects, the neighbours mostly share their lights and the batches stay large
+				auto IsLightIndexLess = [] (const LightIndex& light1, const LightIndex& light2)
+				{
+					if (light1.type != light2.type)
+						return light1.type < light2.type;
+
+					return light1.index < light2.index;
+				};
+
+				m_instanceLightSets.clear();
+				m_instanceLightIndices.clear();
+
+				for (unsigned int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+				{
+					ChooseLights(Spheref(instances[instanceIndex].GetTranslation() + squaredBoundingSphere.GetPosition(), squaredBoundingSphere.radius), true, !clustered);
+
+					// Every light gets its pass anyway, ordering them by identity makes the sets comparable
+					std::sort(m_lights.begin(), m_lights.end(), IsLightIndexLess);
+
+					m_instanceLightSets.push_back(InstanceLightSet{static_cast<unsigned int>(m_instanceLightIndices.size()), static_cast<unsigned int>(m_lights.size()), instanceIndex});
+					m_instanceLightIndices.insert(m_instanceLightIndices.end(), m_lights.begin(), m_lights.end());
+				}
+
+				auto IsSetLess = [this, &IsLightIndexLess] (const InstanceLightSet& set1, const InstanceLightSet& set2)
+				{
+					auto lights1 = m_instanceLightIndices.begin() + set1.firstLight;
+					auto lights2 = m_instanceLightIndices.begin() + set2.firstLight;
+
+					return std::lexicographical_compare(lights1, lights1 + set1.lightCount, lights2, lights2 + set2.lightCount, IsLightIndexLess);
+				};
+
+				std::stable_sort(m_instanceLightSets.begin(), m_instanceLightSets.end(), IsSetLess);
+
+				// The matrices of every group are streamed together, each group and each of its passes only reference their range
+				m_lightSetInstances.clear();
+				for (const InstanceLightSet& lightSet : m_instanceLightSets)
+					m_lightSetInstances.push_back(instances[lightSet.instanceIndex]);
+
+				unsigned int firstInstance = 0;
+				bool streamed = (instanceCount <= m_instanceBuffer.GetVertexCount());
+				if (streamed && !StreamInstances(m_lightSetInstances.data(), instanceCount, &firstInstance))
+					return;
+
+				RendererComparison oldDepthFunc = Renderer::GetDepthFunc();
+
+				for (std::size_t groupStart = 0; groupStart < m_instanceLightSets.size();)
+				{
+					const InstanceLightSet& lightSet = m_instanceLightSets[groupStart];
+
+					std::size_t groupEnd = groupStart + 1;
+					while (groupEnd < m_instanceLightSets.size() && !IsSetLess(lightSet, m_instanceLightSets[groupEnd]))
+						++groupEnd;
+
+					unsigned int groupInstanceCount = static_cast<unsigned int>(groupEnd - groupStart);
+
+					auto lightBegin = m_instanceLightIndices.begin() + lightSet.firstLight;
+					m_lights.assign(lightBegin, lightBegin + lightSet.lightCount);
+
+					unsigned int lightCount = m_lights.size();
+					unsigned int lightIndex = 0;
+
+					unsigned int passCount = (lightCount == 0) ? 1 : (lightCount - 1) / NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS + 1;
+					for (unsigned int pass = 0; pass < passCount; ++pass)
+					{
+						if (pass == 1)
+						{
+							// To add the result of light computations
+							// We won't interfeer with materials parameters because we only render opaques objects
+							// (A.K.A., without blending)
+							// About the depth function, it must be applied only the first time
+							Renderer::Enable(RendererParameter_Blend, true);
+							Renderer::SetBlendFunc(BlendFunc_One, BlendFunc_One);
+							Renderer::SetDepthFunc(RendererComparison_Equal);
+						}
+
+						// Sends the uniforms
+						for (unsigned int i = 0; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
+							SendLightUniforms(shader, shaderUniforms->lightUniforms, lightIndex++, shaderUniforms->lightOffset * i, freeTextureUnit + i);
+
+						if (clustered)
+							SendClusterUniforms(shader, shaderUniforms, clusterTextureUnit, pass == 0);
+
+						if (streamed)
+						{
+							Renderer::SetInstanceBuffer(&m_instanceBuffer, firstInstance + static_cast<unsigned int>(groupStart));
+							instancedDrawFunc(groupInstanceCount, meshData.primitiveMode, 0, indexCount);
+						}
+						else
+							DrawInstances(&m_lightSetInstances[groupStart], groupInstanceCount);
+					}
+
+					// We don't forget to disable the blending to avoid to interfeer with the rest of the rendering
+					Renderer::Enable(RendererParameter_Blend, false);
+					Renderer::SetDepthFunc(oldDepthFunc);
+
+					groupStart = groupEnd;
+				}
+			}
+			else
+				DrawInstances(instances, instanceCount);
+		}
+		else
+		{
+			if (shaderUniforms->hasLightUniforms)
+			{
+				for (unsigned int instanceIndex = 0; instanceIndex < instanceCount; ++instanceIndex)
+				{
+					const Matrix4f& matrix = instances[instanceIndex];
+
+					// Choose the lights depending on an object position and apparent radius
+					ChooseLights(Spheref(matrix.GetTranslation() + squaredBoundingSphere.GetPosition(), squaredBoundingSphere.radius), true, !clustered);
+
+					unsigned int lightCount = m_lights.size();
+
+					Renderer::SetMatrix(MatrixType_World, matrix);
+					unsigned int lightIndex = 0;
+					RendererComparison oldDepthFunc = Renderer::GetDepthFunc(); // In the case where we have to change it
+
+					unsigned int passCount = (lightCount == 0) ? 1 : (lightCount - 1) / NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS + 1;
+					for (unsigned int pass = 0; pass < passCount; ++pass)
+					{
+						lightCount -= std::min(lightCount, NazaraSuffixMacro(NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS, U));
+
+						if (pass == 1)
+						{
+							// To add the result of light computations
+							// We won't interfeer with materials parameters because we only render opaques objects
+							// (A.K.A., without blending)
+							// About the depth function, it must be applied only the first time
+							Renderer::Enable(RendererParameter_Blend, true);
+							Renderer::SetBlendFunc(BlendFunc_One, BlendFunc_One);
+							Renderer::SetDepthFunc(RendererComparison_Equal);
+						}
+
+						// Sends the light uniforms to the shader
+						for (unsigned int i = 0; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
+							SendLightUniforms(shader, shaderUniforms->lightUniforms, lightIndex++, shaderUniforms->lightOffset*i, freeTextureUnit + i);
+
+						if (clustered)
+							SendClusterUniforms(shader, shaderUniforms, clusterTextureUnit, pass == 0);
+
+						// And we draw
+						drawFunc(meshData.primitiveMode, 0, indexCount);
+					}
+
+					Renderer::Enable(RendererParameter_Blend, false);
+					Renderer::SetDepthFunc(oldDepthFunc);
+				}
 			}
 			else
 			{
-				drawFunc = Renderer::DrawPrimitives;
-				indexCount = vertexBuffer->GetVertexCount();
+				// Without instancing, we must do a draw call for each instance
+				// This may be faster than instancing under a certain number
+				// Due to the time to modify the instancing buffer
+				for (unsigned int i = 0; i < instanceCount; ++i)
+				{
+					Renderer::SetMatrix(MatrixType_World, instances[i]);
+					drawFunc(meshData.primitiveMode, 0, indexCount);
+				}
 			}
+		}
+	}
+
+	/*!
+	* \brief Draws opaques models
+	*
+	* \param sceneData Data of the scene
+	* \param layer Layer of the rendering
+	*
+	* \remark Produces a NazaraAssert is viewer is invalid
+	*/
+
+	void ForwardRenderTechnique::DrawOpaqueModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
+	{
+		NazaraGpuZone("ForwardRenderTechnique::DrawOpaqueModels");
 
-			Renderer::SetIndexBuffer(indexBuffer);
-			Renderer::SetVertexBuffer(vertexBuffer);
+		NazaraAssert(sceneData.viewer, "Invalid viewer");
+
+		const Shader* lastShader = nullptr;
+		const ShaderUniforms* shaderUniforms = nullptr;
 
-			if (shaderUniforms->hasLightUniforms && lightCount < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS)
+		for (auto& matIt : layer.opaqueModels)
+		{
+			auto& matEntry = matIt.second;
+
+			if (matEntry.enabled)
 			{
-				// Compute the closest lights
-				Vector3f position = matrix.GetTranslation() + modelData.squaredBoundingSphere.GetPosition();
-				float radius = modelData.squaredBoundingSphere.radius;
-				ChooseLights(Spheref(position, radius), false);
+				ForwardRenderQueue::MeshInstanceContainer& meshInstances = matEntry.meshMap;
+
+				if (!meshInstances.empty())
+				{
+					const Material* material = matIt.first;
+					bool depthPrepassed = m_depthPrepassEnabled && IsDepthPrepassSuitable(material);
+
+					// Lit instances are grouped by the lights affecting them (see DrawMeshInstances)
+					bool instancing = m_instancingEnabled && matEntry.instancingEnabled;
+					UInt32 flags = (instancing) ? ShaderFlags_Instancing : 0;
+					if (m_lightClusters.active && material->IsLightingEnabled())
+						flags |= ShaderFlags_ClusteredLighting;
+
+					const Shader* shader = nullptr;
+					bool skinning = false;
+					UInt8 freeTextureUnit = 0;
+
+					auto ApplyMaterial = [&] (bool skinned)
+					{
+						// We begin to apply the material (and get the shader activated doing so)
+						shader = material->Apply((skinned) ? flags | ShaderFlags_Skinning : flags, 0, &freeTextureUnit);
 
-				for (unsigned int i = lightCount; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
-					SendLightUniforms(shader, shaderUniforms->lightUniforms, i, shaderUniforms->lightOffset*i, freeTextureUnit++);
+						// Uniforms are conserved in our program, there's no point to send them back until they change
+						if (shader != lastShader)
+						{
+							// Index of uniforms in the shader
+							shaderUniforms = GetShaderUniforms(shader);
+
+							// Ambiant color of the scene
+							shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+							// Position of the camera
+							shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+							lastShader = shader;
+						}
+
+						// The depth buffer already holds the nearest surfaces, only their fragments are shaded
+						if (depthPrepassed)
+						{
+							Renderer::Enable(RendererParameter_DepthWrite, false);
+							Renderer::SetDepthFunc(RendererComparison_Equal);
+						}
+
+						// The joints texture takes the first free unit, lights come after it
+						if (skinned)
+							freeTextureUnit++;
+
+						skinning = skinned;
+					};
+
+					// Unlit meshes sharing their buffers don't need lights chosen for each of them, they are drawn by multi-draw calls
+					if (instancing && !material->IsLightingEnabled() && Renderer::HasCapability(RendererCap_MultiDrawIndirect))
+					{
+						auto StreamBatchInstances = [this] (const Matrix4f* instanceMatrices, unsigned int instanceCount)
+						{
+							unsigned int firstInstance;
+							if (!StreamInstances(instanceMatrices, instanceCount, &firstInstance))
+								return false;
+
+							Renderer::SetInstanceBuffer(&m_instanceBuffer, firstInstance);
+							return true;
+						};
+
+						DrawMeshBatches(meshInstances, m_instanceBuffer.GetVertexCount(), [&ApplyMaterial] () { ApplyMaterial(false); }, StreamBatchInstances);
+					}
+
+					// Meshes
+					for (auto& meshIt : meshInstances)
+					{
+						const MeshData& meshData = meshIt.first;
+						auto& meshEntry = meshIt.second;
+
+						const Spheref& squaredBoundingSphere = meshEntry.squaredBoundingSphere;
+						std::vector<Matrix4f>& instances = meshEntry.instances;
+
+						if (!instances.empty())
+						{
+							// Meshes skinned on the GPU come last and need the shader reading their joints from a texture
+							bool skinned = (meshData.skeleton != nullptr);
+							if (!shader || skinned != skinning)
+								ApplyMaterial(skinned);
+
+							DrawMeshInstances(shader, shaderUniforms, freeTextureUnit, meshData, squaredBoundingSphere, instances.data(), instances.size(), instancing);
+
+							instances.clear();
+						}
+					}
+				}
+
+				// And we set the data back to zero
+				matEntry.enabled = false;
+				matEntry.instancingEnabled = false;
 			}
+		}
+	}
+
+	/*!
+	* \brief Draws chains of sprites sharing a material and an overlay
+	*
+	* \param sceneData Data of the scene
+	* \param material Material of the sprites
+	* \param overlay Overlay texture of the sprites, may be null
+	* \param spriteChains Chains of sprites to draw
+	* \param spriteChainCount Number of chains
+	* \param lastShader Last shader used, updated if the material activates another one
+	* \param shaderUniforms Uniforms of the last shader, updated along with it
+	*
+	* \remark The quad index buffer must be bound, the sprite vertex buffer matching the material is bound by this function
+	*/
+
+	void ForwardRenderTechnique::DrawSpriteChains(const SceneData& sceneData, const Material* material, const Texture* overlay, const ForwardRenderQueue::SpriteChain_XYZ_Color_UV* spriteChains, unsigned int spriteChainCount, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms) const
+	{
+		// We begin to apply the material (and get the shader activated doing so)
+		UInt32 flags = ShaderFlags_VertexColor;
+		if (overlay)
+			flags |= ShaderFlags_TextureOverlay;
+
+		UInt8 overlayUnit;
+		const Shader* shader = material->Apply(flags, 0, &overlayUnit);
+
+		if (overlay)
+		{
+			overlayUnit++;
+			Renderer::SetTexture(overlayUnit, overlay);
+			Renderer::SetTextureSampler(overlayUnit, material->GetDiffuseSampler());
+		}
 
-			Renderer::SetMatrix(MatrixType_World, matrix);
-			drawFunc(meshData.primitiveMode, 0, indexCount);
+		// Uniforms are conserved in our program, there's no point to send them back until they change
+		if (shader != lastShader)
+		{
+			// Index of uniforms in the shader
+			shaderUniforms = GetShaderUniforms(shader);
+
+			// Ambiant color of the scene
+			shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+			// Overlay
+			shader->SendInteger(shaderUniforms->textureOverlay, overlayUnit);
+			// Position of the camera
+			shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+			lastShader = shader;
+		}
+
+		// With a texture array, the layer of each chain is sent along its vertices so chains of different layers share the draw calls
+		const Texture* diffuseMap = material->GetDiffuseMap();
+		bool layered = (diffuseMap && diffuseMap->GetType() == ImageType_2D_Array);
+		const VertexBuffer& spriteBuffer = (layered) ? m_layeredSpriteBuffer : m_spriteBuffer;
+		unsigned int vertexStride = spriteBuffer.GetVertexDeclaration()->GetStride();
+
+		Renderer::SetVertexBuffer(&spriteBuffer);
+
+		unsigned int spriteChain = 0; // Which chain of sprites are we treating
+		unsigned int spriteChainOffset = 0; // Where was the last offset where we stopped in the last chain
+
+		do
+		{
+			unsigned int maxSpriteCount = std::min(s_maxQuads, spriteBuffer.GetVertexCount() / 4);
+
+			// We count the sprites of this batch first, only them are streamed
+			unsigned int batchSpriteCount = 0;
+			for (unsigned int chain = spriteChain, chainOffset = spriteChainOffset; chain < spriteChainCount && batchSpriteCount < maxSpriteCount; ++chain, chainOffset = 0)
+				batchSpriteCount += std::min(maxSpriteCount - batchSpriteCount, spriteChains[chain].spriteCount - chainOffset);
+
+			// We suballocate them from the stream buffer, without waiting on the previous draws
+			unsigned int vertexOffset;
+			UInt8* vertices = static_cast<UInt8*>(m_vertexBuffer.Map(batchSpriteCount * 4 * vertexStride, vertexStride, &vertexOffset));
+			if (!vertices)
+				break;
+
+			unsigned int spriteCount = 0;
+
+			do
+			{
+				const ForwardRenderQueue::SpriteChain_XYZ_Color_UV& currentChain = spriteChains[spriteChain];
+				unsigned int count = std::min(batchSpriteCount - spriteCount, currentChain.spriteCount - spriteChainOffset);
+
+				const VertexStruct_XYZ_Color_UV* chainVertices = currentChain.vertices + spriteChainOffset * 4;
+				if (layered)
+				{
+					float layer = static_cast<float>(currentChain.textureLayer);
+
+					LayeredSpriteVertex* layeredVertices = reinterpret_cast<LayeredSpriteVertex*>(vertices);
+					for (unsigned int i = 0; i < count * 4; ++i)
+					{
+						layeredVertices[i].position = chainVertices[i].position;
+						layeredVertices[i].color = chainVertices[i].color;
+						layeredVertices[i].uv = chainVertices[i].uv;
+						layeredVertices[i].layer = layer;
+					}
+				}
+				else
+					std::memcpy(vertices, chainVertices, 4 * count * sizeof(VertexStruct_XYZ_Color_UV));
+
+				vertices += count * 4 * vertexStride;
+
+				spriteCount += count;
+				spriteChainOffset += count;
+
+				// Have we treated the entire chain ?
+				if (spriteChainOffset == currentChain.spriteCount)
+				{
+					spriteChain++;
+					spriteChainOffset = 0;
+				}
+			}
+			while (spriteCount < batchSpriteCount);
+
+			m_vertexBuffer.Unmap();
+
+			Renderer::DrawIndexedPrimitives(PrimitiveMode_TriangleList, 0, spriteCount * 6, vertexOffset / vertexStride);
+		}
+		while (spriteChain < spriteChainCount);
+	}
+
+	/*!
+	* \brief Draws a transparent model
+	*
+	* \param sceneData Data of the scene
+	* \param material Material of the model
+	* \param meshData Data of the mesh
+	* \param matrix World matrix of the model
+	* \param squaredBoundingSphere Bounding sphere of the model, in world space
+	* \param lastShader Last shader used, updated if the material activates another one
+	* \param shaderUniforms Uniforms of the last shader, updated along with it
+	* \param lightCount Number of directional lights sent to the last shader, updated along with it
+	*/
+
+	void ForwardRenderTechnique::DrawTransparentModel(const SceneData& sceneData, const Material* material, const MeshData& meshData, const Matrix4f& matrix, const Spheref& squaredBoundingSphere, const Shader*& lastShader, const ShaderUniforms*& shaderUniforms, unsigned int& lightCount) const
+	{
+		UInt32 flags = (meshData.skeleton) ? ShaderFlags_Skinning : 0;
+		if (m_lightClusters.active && material->IsLightingEnabled())
+			flags |= ShaderFlags_ClusteredLighting;
+
+		// We begin to apply the material (and get the shader activated doing so)
+		UInt8 freeTextureUnit;
+		const Shader* shader = material->Apply(flags, 0, &freeTextureUnit);
+
+		// The joints texture takes the first free unit, lights come after it, then the light clusters
+		UInt8 skinningTextureUnit = 0;
+		if (meshData.skeleton)
+			skinningTextureUnit = freeTextureUnit++;
+
+		UInt8 clusterTextureUnit = freeTextureUnit + NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS;
+
+		// Uniforms are conserved in our program, there's no point to send them back until they change
+		if (shader != lastShader)
+		{
+			// Index of uniforms in the shader
+			shaderUniforms = GetShaderUniforms(shader);
+
+			// Ambiant color of the scene
+			shader->SendColor(shaderUniforms->sceneAmbient, sceneData.ambientColor);
+			// Position of the camera
+			shader->SendVector(shaderUniforms->eyePosition, sceneData.viewer->GetEyePosition());
+
+			// We send the directional lights if there is one (same for all)
+			if (shaderUniforms->hasLightUniforms)
+			{
+				lightCount = std::min(m_renderQueue.directionalLights.size(), static_cast<decltype(m_renderQueue.directionalLights.size())>(NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS));
+
+				for (unsigned int i = 0; i < lightCount; ++i)
+					SendLightUniforms(shader, shaderUniforms->lightUniforms, i, shaderUniforms->lightOffset * i, freeTextureUnit++);
+			}
+
+			lastShader = shader;
+		}
+
+		if (meshData.skeleton)
+		{
+			SkinningManager::BindSkinningTexture(meshData.skeleton, skinningTextureUnit);
+			shader->SendInteger(shaderUniforms->skinningMatrices, skinningTextureUnit);
+		}
+
+		const IndexBuffer* indexBuffer = meshData.indexBuffer;
+		const VertexBuffer* vertexBuffer = meshData.vertexBuffer;
+
+		// Handle draw call before the rendering loop
+		Renderer::DrawCall drawFunc;
+		unsigned int indexCount;
+
+		if (indexBuffer)
+		{
+			drawFunc = Renderer::DrawIndexedPrimitives;
+			indexCount = indexBuffer->GetIndexCount();
+		}
+		else
+		{
+			drawFunc = Renderer::DrawPrimitives;
+			indexCount = vertexBuffer->GetVertexCount();
+		}
+
+		Renderer::SetIndexBuffer(indexBuffer);
+		Renderer::SetVertexBuffer(vertexBuffer);
+
+		bool clustered = m_lightClusters.active && shaderUniforms->clusterLights != -1;
+		if (clustered)
+			SendClusterUniforms(shader, shaderUniforms, clusterTextureUnit, true);
+
+		if (shaderUniforms->hasLightUniforms && lightCount < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS)
+		{
+			// Compute the closest lights
+			ChooseLights(squaredBoundingSphere, false, !clustered);
+
+			for (unsigned int i = lightCount; i < NAZARA_GRAPHICS_MAX_LIGHT_PER_PASS; ++i)
+				SendLightUniforms(shader, shaderUniforms->lightUniforms, i, shaderUniforms->lightOffset*i, freeTextureUnit++);
+		}
+
+		Renderer::SetMatrix(MatrixType_World, matrix);
+		drawFunc(meshData.primitiveMode, 0, indexCount);
+	}
+
+	/*!
+	* \brief Draws transparent models
+	*
+	* \param sceneData Data of the scene
+	* \param layer Layer of the rendering
+	*
+	* \remark Produces a NazaraAssert is viewer is invalid
+	*/
+
+	void ForwardRenderTechnique::DrawTransparentModels(const SceneData& sceneData, ForwardRenderQueue::Layer& layer) const
+	{
+		NazaraGpuZone("ForwardRenderTechnique::DrawTransparentModels");
+
+		NazaraAssert(sceneData.viewer, "Invalid viewer");
+
+		const Shader* lastShader = nullptr;
+		const ShaderUniforms* shaderUniforms = nullptr;
+		unsigned int lightCount = 0;
+
+		for (unsigned int index : layer.transparentModels)
+		{
+			const ForwardRenderQueue::TransparentModelData& modelData = layer.transparentModelData[index];
+
+			DrawTransparentModel(sceneData, modelData.material, modelData.meshData, modelData.transformMatrix, modelData.squaredBoundingSphere, lastShader, shaderUniforms, lightCount);
 		}
 	}
 
@@ -870,8 +1790,18 @@ namespace Nz
 			uniforms.shaderReleaseSlot.Connect(shader->OnShaderRelease, this, &ForwardRenderTechnique::OnShaderInvalidated);
 			uniforms.shaderUniformInvalidatedSlot.Connect(shader->OnShaderUniformInvalidated, this, &ForwardRenderTechnique::OnShaderInvalidated);
 
+			uniforms.billboardData = shader->GetUniformLocation("BillboardData");
+			uniforms.clusterCount = shader->GetUniformLocation("ClusterCount");
+			uniforms.clusterDepthAxis = shader->GetUniformLocation("ClusterDepthAxis");
+			uniforms.clusterGrid = shader->GetUniformLocation("ClusterGrid");
+			uniforms.clusterLightIndices = shader->GetUniformLocation("ClusterLightIndices");
+			uniforms.clusterLights = shader->GetUniformLocation("ClusterLights");
+			uniforms.clusterLightsEnabled = shader->GetUniformLocation("ClusterLightsEnabled");
+			uniforms.clusterSlicing = shader->GetUniformLocation("ClusterSlicing");
+			uniforms.clusterTiles = shader->GetUniformLocation("ClusterTiles");
 			uniforms.eyePosition = shader->GetUniformLocation("EyePosition");
 			uniforms.sceneAmbient = shader->GetUniformLocation("SceneAmbient");
+			uniforms.skinningMatrices = shader->GetUniformLocation("SkinningMatrices");
 			uniforms.textureOverlay = shader->GetUniformLocation("TextureOverlay");
 
 			int type0Location = shader->GetUniformLocation("Lights[0].type");
@@ -885,6 +1815,7 @@ namespace Nz
 				uniforms.lightUniforms.locations.type = type0Location;
 				uniforms.lightUniforms.locations.color = shader->GetUniformLocation("Lights[0].color");
 				uniforms.lightUniforms.locations.factors = shader->GetUniformLocation("Lights[0].factors");
+				uniforms.lightUniforms.locations.lightCascadeMatrix = shader->GetUniformLocation("LightCascadeMatrix[0]");
 				uniforms.lightUniforms.locations.lightViewProjMatrix = shader->GetUniformLocation("LightViewProjMatrix[0]");
 				uniforms.lightUniforms.locations.parameters1 = shader->GetUniformLocation("Lights[0].parameters1");
 				uniforms.lightUniforms.locations.parameters2 = shader->GetUniformLocation("Lights[0].parameters2");
@@ -913,9 +1844,91 @@ namespace Nz
 		m_shaderUniforms.erase(shader);
 	}
 
+	/*!
+	* \brief Sends the light clusters to a shader reading them
+	*
+	* \param shader Shader to send uniforms to
+	* \param shaderUniforms Uniforms of the shader
+	* \param availableTextureUnit First of the three texture units the clusters are bound to
+	* \param enable Should the shader loop over the lights of the clusters (only one pass of an object must do it)
+	*/
+
+	void ForwardRenderTechnique::SendClusterUniforms(const Shader* shader, const ShaderUniforms* shaderUniforms, UInt8 availableTextureUnit, bool enable) const
+	{
+		shader->SendBoolean(shaderUniforms->clusterLightsEnabled, enable);
+		if (!enable)
+			return;
+
+		Renderer::SetTexture(availableTextureUnit, m_lightClusters.gridTexture);
+		Renderer::SetTextureSampler(availableTextureUnit, s_clusterSampler);
+		shader->SendInteger(shaderUniforms->clusterGrid, availableTextureUnit++);
+
+		Renderer::SetTexture(availableTextureUnit, m_lightClusters.indexTexture);
+		Renderer::SetTextureSampler(availableTextureUnit, s_clusterSampler);
+		shader->SendInteger(shaderUniforms->clusterLightIndices, availableTextureUnit++);
+
+		Renderer::SetTexture(availableTextureUnit, m_lightClusters.lightTexture);
+		Renderer::SetTextureSampler(availableTextureUnit, s_clusterSampler);
+		shader->SendInteger(shaderUniforms->clusterLights, availableTextureUnit);
+
+		shader->SendVector(shaderUniforms->clusterCount, Vector3i(s_clusterCountX, s_clusterCountY, s_clusterCountZ));
+		shader->SendVector(shaderUniforms->clusterDepthAxis, m_lightClusters.depthAxis);
+		shader->SendVector(shaderUniforms->clusterSlicing, m_lightClusters.slicing);
+		shader->SendVector(shaderUniforms->clusterTiles, m_lightClusters.tiles);
+	}
+
+	/*!
+	* \brief Copies instance matrices to the instance ring buffer
+	* \return true If successful
+	*
+	* \param instances World matrices of the instances
+	* \param instanceCount Number of instances, must fit in the ring buffer
+	* \param firstInstance Output parameter receiving the index of the first copied instance in the instance buffer
+	*/
+
+	bool ForwardRenderTechnique::StreamInstances(const Matrix4f* instances, unsigned int instanceCount, unsigned int* firstInstance) const
+	{
+		NazaraAssert(instanceCount <= m_instanceBuffer.GetVertexCount(), "Too many instances for the instance buffer");
+
+		unsigned int offset;
+		void* ptr = m_instanceStream.Map(instanceCount * sizeof(Matrix4f), sizeof(Matrix4f), &offset);
+		if (!ptr)
+		{
+			NazaraError("Failed to map instance buffer");
+			return false;
+		}
+
+		std::memcpy(ptr, instances, instanceCount * sizeof(Matrix4f));
+		m_instanceStream.Unmap();
+
+		*firstInstance = offset / sizeof(Matrix4f);
+		return true;
+	}
+
+	/*!
+	* \brief Gets the way billboards are drawn by the renderer
+	* \return Vertex pulling if float textures are supported, instancing otherwise, or else four vertices per billboard
+	*/
+
+	ForwardRenderTechnique::BillboardDrawMode ForwardRenderTechnique::GetBillboardDrawMode()
+	{
+		if (s_billboardPullingSupported)
+			return BillboardDrawMode_VertexPulling;
+		else if (Renderer::HasCapability(RendererCap_Instancing))
+			return BillboardDrawMode_Instancing;
+		else
+			return BillboardDrawMode_Vertices;
+	}
+
 	IndexBuffer ForwardRenderTechnique::s_quadIndexBuffer;
+	TextureSampler ForwardRenderTechnique::s_billboardSampler;
+	TextureSampler ForwardRenderTechnique::s_clusterSampler;
 	TextureSampler ForwardRenderTechnique::s_shadowSampler;
+	VertexBuffer ForwardRenderTechnique::s_billboardPullingBuffer;
 	VertexBuffer ForwardRenderTechnique::s_quadVertexBuffer;
 	VertexDeclaration ForwardRenderTechnique::s_billboardInstanceDeclaration;
+	VertexDeclaration ForwardRenderTechnique::s_billboardPullingDeclaration;
 	VertexDeclaration ForwardRenderTechnique::s_billboardVertexDeclaration;
+	VertexDeclaration ForwardRenderTechnique::s_layeredSpriteDeclaration;
+	bool ForwardRenderTechnique::s_billboardPullingSupported;
 }
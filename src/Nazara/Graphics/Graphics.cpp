@@ -15,8 +15,10 @@
 #include <Nazara/Graphics/ParticleController.hpp>
 #include <Nazara/Graphics/ParticleDeclaration.hpp>
 #include <Nazara/Graphics/ParticleGenerator.hpp>
+#include <Nazara/Graphics/ParticleGpuSimulator.hpp>
 #include <Nazara/Graphics/ParticleRenderer.hpp>
 #include <Nazara/Graphics/RenderTechniques.hpp>
+#include <Nazara/Graphics/SkeletalModel.hpp>
 #include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Graphics/SkyboxBackground.hpp>
 #include <Nazara/Graphics/Sprite.hpp>
@@ -87,12 +89,24 @@ namespace Nz
 			return false;
 		}
 
+		if (!ParticleGpuSimulator::Initialize())
+		{
+			NazaraError("Failed to initialize particle GPU simulators");
+			return false;
+		}
+
 		if (!ParticleRenderer::Initialize())
 		{
 			NazaraError("Failed to initialize particle renderers");
 			return false;
 		}
 
+		if (!SkeletalModel::Initialize())
+		{
+			NazaraError("Failed to initialize skeletal models");
+			return false;
+		}
+
 		if (!SkinningManager::Initialize())
 		{
 			NazaraError("Failed to initialize skinning manager");
@@ -136,15 +150,9 @@ namespace Nz
 
 		RenderTechniques::Register(RenderTechniques::ToString(RenderTechniqueType_BasicForward), 0, []() -> AbstractRenderTechnique* { return new ForwardRenderTechnique; });
 
+		// Deferred shaders are compiled by the first DeferredRenderTechnique
 		if (DeferredRenderTechnique::IsSupported())
-		{
-			if (DeferredRenderTechnique::Initialize())
-				RenderTechniques::Register(RenderTechniques::ToString(RenderTechniqueType_DeferredShading), 20, []() -> AbstractRenderTechnique* { return new DeferredRenderTechnique; });
-			else
-			{
-				NazaraWarning("Failed to initialize Deferred Rendering");
-			}
-		}
+			RenderTechniques::Register(RenderTechniques::ToString(RenderTechniqueType_DeferredShading), 20, []() -> AbstractRenderTechnique* { return new DeferredRenderTechnique; });
 
 		Font::SetDefaultAtlas(std::make_shared<GuillotineTextureAtlas>());
 
@@ -217,7 +225,9 @@ namespace Nz
 		DepthRenderTechnique::Uninitialize();
 		ForwardRenderTechnique::Uninitialize();
 		SkinningManager::Uninitialize();
+		SkeletalModel::Uninitialize();
 		ParticleRenderer::Uninitialize();
+		ParticleGpuSimulator::Uninitialize();
 		ParticleGenerator::Uninitialize();
 		ParticleDeclaration::Uninitialize();
 		ParticleController::Uninitialize();
@@ -10,6 +10,7 @@
 #include <Nazara/Math/Sphere.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/Shader.hpp>
+#include <cmath>
 #include <cstring>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -35,7 +36,11 @@ namespace Nz
 	m_shadowMapFormat(PixelFormatType_Depth16),
 	m_shadowMapSize(512, 512),
 	m_shadowCastingEnabled(false),
-	m_shadowMapUpdated(false)
+	m_shadowMapUpdated(false),
+	m_fittedShadowCascades(0),
+	m_shadowCascadeCount(1),
+	m_shadowCascadeUpdateInterval(1),
+	m_shadowCascadeSplitLambda(0.75f)
 	{
 		SetAmbientFactor((type == LightType_Directional) ? 0.2f : 0.f);
 		SetAttenuation(0.9f);
@@ -62,6 +67,19 @@ namespace Nz
 								   0.f, 0.f, 0.5f, 0.f,
 								   0.5f, 0.5f, 0.5f, 1.f);
 
+		// The texture coordinates of a shadow map sharing an atlas are moved into its region
+		Matrix4f regionMatrix(Matrix4f::Identity());
+		if (m_shadowAtlas && m_type != LightType_Point)
+		{
+			float invAtlasWidth = 1.f / m_shadowAtlas->GetWidth();
+			float invAtlasHeight = 1.f / m_shadowAtlas->GetHeight();
+
+			regionMatrix.Set(m_shadowAtlasRegion.width * invAtlasWidth, 0.f, 0.f, 0.f,
+			                 0.f, m_shadowAtlasRegion.height * invAtlasHeight, 0.f, 0.f,
+			                 0.f, 0.f, 1.f, 0.f,
+			                 m_shadowAtlasRegion.x * invAtlasWidth, m_shadowAtlasRegion.y * invAtlasHeight, 0.f, 1.f);
+		}
+
 		switch (m_type)
 		{
 			case LightType_Directional:
@@ -72,7 +90,28 @@ namespace Nz
 				light.diffuseFactor = m_diffuseFactor;
 				light.direction = transformMatrix.Transform(Vector3f::Forward(), 0.f);
 				light.shadowMap = m_shadowMap.Get();
-				light.transformMatrix = Matrix4f::ViewMatrix(transformMatrix.GetRotation() * Vector3f::Forward() * 100.f, transformMatrix.GetRotation()) * Matrix4f::Ortho(0.f, 100.f, 100.f, 0.f, 1.f, 100.f) * biasMatrix;
+				light.transformMatrix = Matrix4f::ViewMatrix(transformMatrix.GetRotation() * Vector3f::Forward() * 100.f, transformMatrix.GetRotation()) * Matrix4f::Ortho(0.f, 100.f, 100.f, 0.f, 1.f, 100.f) * biasMatrix * regionMatrix;
+
+				// The cascades are only used once they have all been rendered in the current shadow map
+				if (m_shadowMap && m_fittedShadowCascades == (1U << m_shadowCascadeCount) - 1U)
+				{
+					light.cascadeCount = m_shadowCascadeCount;
+
+					float invCascadeCount = 1.f / m_shadowCascadeCount;
+					for (unsigned int i = 0; i < m_shadowCascadeCount; ++i)
+					{
+						// Each cascade has its own slice of the width of the shadow map
+						Matrix4f atlasMatrix(invCascadeCount, 0.f, 0.f, 0.f,
+						                     0.f, 1.f, 0.f, 0.f,
+						                     0.f, 0.f, 1.f, 0.f,
+						                     i * invCascadeCount, 0.f, 0.f, 1.f);
+
+						light.cascadeMatrices[i] = m_shadowCascadeMatrices[i] * biasMatrix * atlasMatrix * regionMatrix;
+						light.cascadeSplits[i] = m_shadowCascadeSplits[i];
+					}
+				}
+				else
+					light.cascadeCount = 0;
 
 				renderQueue->AddDirectionalLight(light);
 				break;
@@ -109,7 +148,7 @@ namespace Nz
 				light.position = transformMatrix.GetTranslation();
 				light.radius = m_radius;
 				light.shadowMap = m_shadowMap.Get();
-				light.transformMatrix = Matrix4f::ViewMatrix(transformMatrix.GetTranslation(), transformMatrix.GetRotation()) * Matrix4f::Perspective(m_outerAngle*2.f, 1.f, 0.1f, m_radius) * biasMatrix;
+				light.transformMatrix = Matrix4f::ViewMatrix(transformMatrix.GetTranslation(), transformMatrix.GetRotation()) * Matrix4f::Perspective(m_outerAngle*2.f, 1.f, 0.1f, m_radius) * biasMatrix * regionMatrix;
 
 				renderQueue->AddSpotLight(light);
 				break;
@@ -169,6 +208,40 @@ namespace Nz
 		return false;
 	}
 
+	/*!
+	* \brief Computes the view depths splitting the view of a camera between shadow cascades
+	*
+	* \param zNear Near plane of the camera
+	* \param zFar Far plane of the camera
+	* \param cascadeCount Number of cascades
+	* \param lambda Blend factor between uniform (0) and logarithmic (1) splits
+	* \param splitDistances Array of cascadeCount values receiving the depth where each cascade ends (the last one being zFar)
+	*
+	* \remark Produces a NazaraAssert if a parameter is invalid
+	*/
+
+	void Light::ComputeShadowCascadeSplits(float zNear, float zFar, unsigned int cascadeCount, float lambda, float* splitDistances)
+	{
+		NazaraAssert(zNear > 0.f && zNear < zFar, "Invalid depth range");
+		NazaraAssert(cascadeCount > 0, "Invalid cascade count");
+		NazaraAssert(splitDistances, "Invalid split distances");
+
+		// Logarithmic splits keep a constant texel density along the view but leave almost nothing to the far cascades,
+		// the uniform ones do the opposite, the practical scheme blends both
+		float ratio = zFar / zNear;
+		for (unsigned int i = 1; i < cascadeCount; ++i)
+		{
+			float t = static_cast<float>(i) / cascadeCount;
+
+			float logSplit = zNear * std::pow(ratio, t);
+			float uniformSplit = zNear + (zFar - zNear) * t;
+
+			splitDistances[i - 1] = Lerp(uniformSplit, logSplit, lambda);
+		}
+
+		splitDistances[cascadeCount - 1] = zFar;
+	}
+
 	/*!
 	* \brief Updates the bounding volume by a matrix
 	*
@@ -255,12 +328,28 @@ namespace Nz
 
 	void Light::UpdateShadowMap() const
 	{
-		if (m_shadowCastingEnabled)
+		if (m_shadowCastingEnabled && m_shadowAtlas && m_type != LightType_Point)
+			m_shadowMap = m_shadowAtlas; // Created and sized by its owner
+		else if (m_shadowCastingEnabled)
 		{
-			if (!m_shadowMap)
+			if (!m_shadowMap || m_shadowMap == m_shadowAtlas)
 				m_shadowMap = Texture::New();
 
-			m_shadowMap->Create((m_type == LightType_Point) ? ImageType_Cubemap : ImageType_2D, m_shadowMapFormat, m_shadowMapSize.x, m_shadowMapSize.y);
+			switch (m_type)
+			{
+				case LightType_Directional:
+					// The cascades are laid out side by side
+					m_shadowMap->Create(ImageType_2D, m_shadowMapFormat, m_shadowMapSize.x * m_shadowCascadeCount, m_shadowMapSize.y);
+					break;
+
+				case LightType_Point:
+					m_shadowMap->Create(ImageType_Cubemap, m_shadowMapFormat, m_shadowMapSize.x, m_shadowMapSize.y);
+					break;
+
+				case LightType_Spot:
+					m_shadowMap->Create(ImageType_2D, m_shadowMapFormat, m_shadowMapSize.x, m_shadowMapSize.y);
+					break;
+			}
 		}
 		else
 			m_shadowMap.Reset();
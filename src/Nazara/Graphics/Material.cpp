@@ -7,10 +7,12 @@
 #endif
 
 #include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/UberShaderPreprocessor.hpp>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
@@ -23,6 +25,10 @@ namespace Nz
 			#include <Nazara/Graphics/Resources/Shaders/Basic/core.frag.h>
 		};
 
+		const UInt8 r_basicGeometryShader[] = {
+			#include <Nazara/Graphics/Resources/Shaders/Basic/core.geom.h>
+		};
+
 		const UInt8 r_basicVertexShader[] = {
 			#include <Nazara/Graphics/Resources/Shaders/Basic/core.vert.h>
 		};
@@ -34,6 +40,33 @@ namespace Nz
 		const UInt8 r_phongLightingVertexShader[] = {
 			#include <Nazara/Graphics/Resources/Shaders/PhongLighting/core.vert.h>
 		};
+
+		// Binding point of the MaterialParameters uniform block, std140 layout
+		constexpr unsigned int s_uniformBufferBinding = UniformBufferBinding_Material;
+
+		struct UniformBlock
+		{
+			Vector4f ambient;
+			Vector4f diffuse;
+			Vector4f specular;
+			float alphaThreshold;
+			float shininess;
+			float padding[2];
+			UInt64 textureHandles[6]; //< Bindless handles of the alpha, diffuse, emissive, height, normal and specular maps
+		};
+
+		static_assert(sizeof(UniformBlock) == 112, "Uniform block must follow the std140 layout");
+
+		Vector4f ColorToVector(const Color& color)
+		{
+			return Vector4f(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
+		}
+
+		// Fibonacci hashing, so that every bit of the hash has an influence on the kept ones
+		UInt32 FoldHash(std::size_t hash, unsigned int bitCount)
+		{
+			return static_cast<UInt32>((static_cast<UInt64>(hash) * 11400714819323198485ULL) >> (64 - bitCount));
+		}
 	}
 
 	/*!
@@ -67,25 +100,41 @@ namespace Nz
 	const Shader* Material::Apply(UInt32 shaderFlags, UInt8 textureUnit, UInt8* lastUsedUnit) const
 	{
 		const ShaderInstance& instance = m_shaders[shaderFlags];
-		if (!instance.uberInstance)
+		if (!instance.uberInstance || instance.fallback || instance.bindlessTextures != s_bindlessTextures)
 			GenerateShader(shaderFlags);
 
 		instance.uberInstance->Activate();
 
-		if (instance.uniforms[MaterialUniform_AlphaThreshold] != -1)
-			instance.shader->SendFloat(instance.uniforms[MaterialUniform_AlphaThreshold], m_alphaThreshold);
+		if (instance.uniformBlock != -1)
+		{
+			// Texture storage may have been replaced (by streaming for example), which changes the handles
+			if (instance.bindlessTextures)
+				UpdateBindlessHandles();
+
+			// Parameters are only uploaded when the material changes
+			if (!m_uniformBufferUpdated)
+				UpdateUniformBuffer();
 
-		if (instance.uniforms[MaterialUniform_Ambient] != -1)
-			instance.shader->SendColor(instance.uniforms[MaterialUniform_Ambient], m_ambientColor);
+			Renderer::SetUniformBuffer(s_uniformBufferBinding, m_uniformBuffer);
+		}
+		else
+		{
+			// Custom shaders may still use one uniform per parameter
+			if (instance.uniforms[MaterialUniform_AlphaThreshold] != -1)
+				instance.shader->SendFloat(instance.uniforms[MaterialUniform_AlphaThreshold], m_alphaThreshold);
 
-		if (instance.uniforms[MaterialUniform_Diffuse] != -1)
-			instance.shader->SendColor(instance.uniforms[MaterialUniform_Diffuse], m_diffuseColor);
+			if (instance.uniforms[MaterialUniform_Ambient] != -1)
+				instance.shader->SendColor(instance.uniforms[MaterialUniform_Ambient], m_ambientColor);
 
-		if (instance.uniforms[MaterialUniform_Shininess] != -1)
-			instance.shader->SendFloat(instance.uniforms[MaterialUniform_Shininess], m_shininess);
+			if (instance.uniforms[MaterialUniform_Diffuse] != -1)
+				instance.shader->SendColor(instance.uniforms[MaterialUniform_Diffuse], m_diffuseColor);
 
-		if (instance.uniforms[MaterialUniform_Specular] != -1)
-			instance.shader->SendColor(instance.uniforms[MaterialUniform_Specular], m_specularColor);
+			if (instance.uniforms[MaterialUniform_Shininess] != -1)
+				instance.shader->SendFloat(instance.uniforms[MaterialUniform_Shininess], m_shininess);
+
+			if (instance.uniforms[MaterialUniform_Specular] != -1)
+				instance.shader->SendColor(instance.uniforms[MaterialUniform_Specular], m_specularColor);
+		}
 
 		if (m_alphaMap && instance.uniforms[MaterialUniform_AlphaMap] != -1)
 		{
@@ -179,6 +228,9 @@ namespace Nz
 		if (matData.GetBooleanParameter(MaterialData::DepthSorting, &isEnabled))
 			EnableDepthSorting(isEnabled);
 
+		if (matData.GetBooleanParameter(MaterialData::DistanceField, &isEnabled))
+			EnableDistanceField(isEnabled);
+
 		if (matData.GetColorParameter(MaterialData::DiffuseColor, &color))
 			SetDiffuseColor(color);
 
@@ -310,6 +362,31 @@ namespace Nz
 		SetShader(matParams.shaderName);
 	}
 
+	/*!
+	* \brief Checks whether the shader variant for the given flags is built
+	* \return true If Apply would use the real variant instead of a fallback
+	*
+	* \param shaderFlags Flags for the shader
+	*
+	* \remark Meant to be polled by a loading screen after WarmUpShader
+	*/
+
+	bool Material::IsShaderReady(UInt32 shaderFlags) const
+	{
+		const ShaderInstance& instance = m_shaders[shaderFlags];
+		if (instance.uberInstance && !instance.fallback)
+			return true;
+
+		ParameterList list;
+		FillShaderParameters(shaderFlags, &list);
+
+		if (!m_uberShader->TryGet(list))
+			return false;
+
+		GenerateShader(shaderFlags);
+		return true;
+	}
+
 	void Material::SaveToParameters(ParameterList* matData)
 	{
 		NazaraAssert(matData, "Invalid ParameterList");
@@ -320,6 +397,7 @@ namespace Nz
 		matData->SetParameter(MaterialData::CullingSide, int(GetFaceCulling()));
 		matData->SetParameter(MaterialData::DepthFunc, int(GetDepthFunc()));
 		matData->SetParameter(MaterialData::DepthSorting, IsDepthSortingEnabled());
+		matData->SetParameter(MaterialData::DistanceField, IsDistanceFieldEnabled());
 		matData->SetParameter(MaterialData::DiffuseColor, GetDiffuseColor());
 		matData->SetParameter(MaterialData::DstBlend, int(GetDstBlend()));
 		matData->SetParameter(MaterialData::FaceFilling, int(GetFaceFilling()));
@@ -433,6 +511,7 @@ namespace Nz
 		m_ambientColor = Color(128, 128, 128);
 		m_depthSortingEnabled = false;
 		m_diffuseColor = Color::White;
+		m_distanceFieldEnabled = false;
 		m_diffuseSampler = TextureSampler();
 		m_lightingEnabled = true;
 		m_shadowCastingEnabled = true;
@@ -445,9 +524,34 @@ namespace Nz
 		m_states.faceCulling = true;
 		m_transformEnabled = true;
 
+		m_bindlessHandles.fill(0);
+		InvalidateUniformBuffer();
+
 		SetShader("Basic");
 	}
 
+	/*!
+	* \brief Starts building the shader variant for the given flags without waiting for it
+	*
+	* \param shaderFlags Flags for the shader
+	*
+	* \remark Calling this on every material of a level during loading lets the driver compile the variants in parallel
+	*
+	* \see IsShaderReady
+	*/
+
+	void Material::WarmUpShader(UInt32 shaderFlags) const
+	{
+		const ShaderInstance& instance = m_shaders[shaderFlags];
+		if (instance.uberInstance && !instance.fallback)
+			return;
+
+		ParameterList list;
+		FillShaderParameters(shaderFlags, &list);
+
+		m_uberShader->Preload(list);
+	}
+
 	/*!
 	* \brief Copies the other material
 	*
@@ -463,6 +567,7 @@ namespace Nz
 		m_depthSortingEnabled  = material.m_depthSortingEnabled;
 		m_diffuseColor         = material.m_diffuseColor;
 		m_diffuseSampler       = material.m_diffuseSampler;
+		m_distanceFieldEnabled = material.m_distanceFieldEnabled;
 		m_lightingEnabled      = material.m_lightingEnabled;
 		m_shininess            = material.m_shininess;
 		m_shadowCastingEnabled = material.m_shadowCastingEnabled;
@@ -484,41 +589,108 @@ namespace Nz
 
 		// We copy the instances of the shader too
 		std::memcpy(&m_shaders[0], &material.m_shaders[0], (ShaderFlags_Max + 1) * sizeof(ShaderInstance));
+
+		// The uniform buffer is not shared, each material owns its parameters
+		m_bindlessHandles.fill(0);
+
+		InvalidateSortKey();
+		InvalidateUniformBuffer();
+	}
+
+	/*!
+	* \brief Fills the parameters selecting the shader variant for the given flags
+	*
+	* \param flags Flags for the shader
+	* \param list Parameter list to fill
+	*/
+
+	void Material::FillShaderParameters(UInt32 flags, ParameterList* list) const
+	{
+		list->SetParameter("ALPHA_MAPPING", m_alphaMap.IsValid());
+		list->SetParameter("ALPHA_TEST", m_alphaTestEnabled);
+		list->SetParameter("BINDLESS_TEXTURES", s_bindlessTextures);
+		list->SetParameter("COMPUTE_TBNMATRIX", m_normalMap.IsValid() || m_heightMap.IsValid());
+		list->SetParameter("DIFFUSE_MAPPING", m_diffuseMap.IsValid());
+		list->SetParameter("DISTANCE_FIELD", m_distanceFieldEnabled);
+		list->SetParameter("EMISSIVE_MAPPING", m_emissiveMap.IsValid());
+		list->SetParameter("LIGHTING", m_lightingEnabled);
+		list->SetParameter("MATERIAL_UNIFORM_BUFFER", true);
+		list->SetParameter("NORMAL_MAPPING", m_normalMap.IsValid());
+		list->SetParameter("PARALLAX_MAPPING", m_heightMap.IsValid());
+		list->SetParameter("SHADOW_MAPPING", m_shadowReceiveEnabled);
+		list->SetParameter("SPECULAR_MAPPING", m_specularMap.IsValid());
+		list->SetParameter("TEXTURE_ARRAY", m_diffuseMap.IsValid() && m_diffuseMap->GetType() == ImageType_2D_Array);
+		list->SetParameter("TEXTURE_MAPPING", m_alphaMap.IsValid() || m_diffuseMap.IsValid() || m_emissiveMap.IsValid() ||
+											  m_normalMap.IsValid() || m_heightMap.IsValid() || m_specularMap.IsValid() ||
+											  flags & ShaderFlags_TextureOverlay);
+		list->SetParameter("TRANSFORM", m_transformEnabled);
+
+		list->SetParameter("FLAG_BILLBOARD", static_cast<bool>((flags & ShaderFlags_Billboard) != 0));
+		list->SetParameter("FLAG_CLUSTEREDLIGHTING", static_cast<bool>((flags & ShaderFlags_ClusteredLighting) != 0));
+		list->SetParameter("FLAG_CUBEMAPLAYERED", static_cast<bool>((flags & ShaderFlags_CubemapLayered) != 0));
+		list->SetParameter("FLAG_DEFERRED", static_cast<bool>((flags & ShaderFlags_Deferred) != 0));
+		list->SetParameter("FLAG_INSTANCING", static_cast<bool>((flags & ShaderFlags_Instancing) != 0));
+		list->SetParameter("FLAG_SKINNING", static_cast<bool>((flags & ShaderFlags_Skinning) != 0));
+		list->SetParameter("FLAG_TEXTUREOVERLAY", static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
+		list->SetParameter("FLAG_VERTEXCOLOR", static_cast<bool>((flags & ShaderFlags_VertexColor) != 0));
+		list->SetParameter("FLAG_VERTEXPULLING", static_cast<bool>((flags & ShaderFlags_VertexPulling) != 0));
 	}
 
 	/*!
 	* \brief Generates the shader based on flag
 	*
 	* \param flags Flag for the shaer
+	*
+	* \remark With asynchronous compilation, a variant without any material feature is used until the requested one is built
 	*/
 
 	void Material::GenerateShader(UInt32 flags) const
 	{
 		ParameterList list;
-		list.SetParameter("ALPHA_MAPPING", m_alphaMap.IsValid());
-		list.SetParameter("ALPHA_TEST", m_alphaTestEnabled);
-		list.SetParameter("COMPUTE_TBNMATRIX", m_normalMap.IsValid() || m_heightMap.IsValid());
-		list.SetParameter("DIFFUSE_MAPPING", m_diffuseMap.IsValid());
-		list.SetParameter("EMISSIVE_MAPPING", m_emissiveMap.IsValid());
-		list.SetParameter("LIGHTING", m_lightingEnabled);
-		list.SetParameter("NORMAL_MAPPING", m_normalMap.IsValid());
-		list.SetParameter("PARALLAX_MAPPING", m_heightMap.IsValid());
-		list.SetParameter("SHADOW_MAPPING", m_shadowReceiveEnabled);
-		list.SetParameter("SPECULAR_MAPPING", m_specularMap.IsValid());
-		list.SetParameter("TEXTURE_MAPPING", m_alphaMap.IsValid() || m_diffuseMap.IsValid() || m_emissiveMap.IsValid() ||
-											 m_normalMap.IsValid() || m_heightMap.IsValid() || m_specularMap.IsValid() ||
-											 flags & ShaderFlags_TextureOverlay);
-		list.SetParameter("TRANSFORM", m_transformEnabled);
-
-		list.SetParameter("FLAG_BILLBOARD", static_cast<bool>((flags & ShaderFlags_Billboard) != 0));
-		list.SetParameter("FLAG_DEFERRED", static_cast<bool>((flags & ShaderFlags_Deferred) != 0));
-		list.SetParameter("FLAG_INSTANCING", static_cast<bool>((flags & ShaderFlags_Instancing) != 0));
-		list.SetParameter("FLAG_TEXTUREOVERLAY", static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
-		list.SetParameter("FLAG_VERTEXCOLOR", static_cast<bool>((flags & ShaderFlags_VertexColor) != 0));
+		FillShaderParameters(flags, &list);
+
+		UberShaderInstance* uberInstance;
+		bool fallback = false;
+		if (s_asyncShaderCompilation)
+		{
+			uberInstance = m_uberShader->TryGet(list);
+			if (!uberInstance)
+			{
+				// Only the flags affecting vertex input and outputs are kept, this variant is shared by most materials
+				ParameterList fallbackList;
+				fallbackList.SetParameter("BINDLESS_TEXTURES", s_bindlessTextures);
+				fallbackList.SetParameter("MATERIAL_UNIFORM_BUFFER", true);
+				fallbackList.SetParameter("TEXTURE_MAPPING", static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
+				fallbackList.SetParameter("TRANSFORM", m_transformEnabled);
+
+				fallbackList.SetParameter("FLAG_BILLBOARD", static_cast<bool>((flags & ShaderFlags_Billboard) != 0));
+				fallbackList.SetParameter("FLAG_CUBEMAPLAYERED", static_cast<bool>((flags & ShaderFlags_CubemapLayered) != 0));
+				fallbackList.SetParameter("FLAG_DEFERRED", static_cast<bool>((flags & ShaderFlags_Deferred) != 0));
+				fallbackList.SetParameter("FLAG_INSTANCING", static_cast<bool>((flags & ShaderFlags_Instancing) != 0));
+				fallbackList.SetParameter("FLAG_SKINNING", static_cast<bool>((flags & ShaderFlags_Skinning) != 0));
+				fallbackList.SetParameter("FLAG_TEXTUREOVERLAY", static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
+				fallbackList.SetParameter("FLAG_VERTEXCOLOR", static_cast<bool>((flags & ShaderFlags_VertexColor) != 0));
+				fallbackList.SetParameter("FLAG_VERTEXPULLING", static_cast<bool>((flags & ShaderFlags_VertexPulling) != 0));
+
+				uberInstance = m_uberShader->Get(fallbackList);
+				fallback = true;
+			}
+		}
+		else
+			uberInstance = m_uberShader->Get(list);
 
 		ShaderInstance& instance = m_shaders[flags];
-		instance.uberInstance = m_uberShader->Get(list);
+		instance.bindlessTextures = s_bindlessTextures;
+		instance.fallback = fallback;
+
+		// Still waiting on the same fallback, uniforms are already cached
+		if (instance.uberInstance == uberInstance)
+			return;
+
+		instance.uberInstance = uberInstance;
 		instance.shader = instance.uberInstance->GetShader();
+		instance.uniformBlock = instance.shader->GetUniformBlockIndex("MaterialParameters");
+		instance.shader->SetUniformBlockBinding(instance.uniformBlock, s_uniformBufferBinding);
 
 		#define CacheUniform(name) instance.uniforms[MaterialUniform_##name] = instance.shader->GetUniformLocation("Material" #name)
 
@@ -537,6 +709,167 @@ namespace Nz
 		#undef CacheUniform
 	}
 
+	/*!
+	* \brief Fetches the bindless handles of the textures, invalidating the uniform buffer if they changed
+	*/
+
+	void Material::UpdateBindlessHandles() const
+	{
+		const TextureRef* maps[] = {&m_alphaMap, &m_diffuseMap, &m_emissiveMap, &m_heightMap, &m_normalMap, &m_specularMap};
+
+		for (std::size_t i = 0; i < m_bindlessHandles.size(); ++i)
+		{
+			const TextureRef& map = *maps[i];
+
+			UInt64 handle = 0;
+			if (map)
+				handle = map->GetBindlessHandle((&map == &m_specularMap) ? m_specularSampler : m_diffuseSampler);
+
+			if (m_bindlessHandles[i] != handle)
+			{
+				m_bindlessHandles[i] = handle;
+				m_uniformBufferUpdated = false;
+			}
+		}
+	}
+
+	/*!
+	* \brief Computes the sort key of the material
+	*
+	* \remark The twelve most significant bits identify the pipeline, the ten next ones the render states and the ten last ones the textures
+	*/
+
+	void Material::UpdateSortKey() const
+	{
+		std::size_t pipelineHash = 0;
+		HashCombine(pipelineHash, m_uberShader.Get());
+		HashCombine(pipelineHash, m_alphaMap.IsValid());
+		HashCombine(pipelineHash, m_alphaTestEnabled);
+		HashCombine(pipelineHash, m_diffuseMap.IsValid());
+		HashCombine(pipelineHash, m_distanceFieldEnabled);
+		HashCombine(pipelineHash, m_emissiveMap.IsValid());
+		HashCombine(pipelineHash, m_heightMap.IsValid());
+		HashCombine(pipelineHash, m_lightingEnabled);
+		HashCombine(pipelineHash, m_normalMap.IsValid());
+		HashCombine(pipelineHash, m_shadowReceiveEnabled);
+		HashCombine(pipelineHash, m_specularMap.IsValid());
+		HashCombine(pipelineHash, m_transformEnabled);
+
+		std::size_t statesHash = 0;
+		HashCombine(statesHash, m_states.blending);
+		HashCombine(statesHash, m_states.colorWrite);
+		HashCombine(statesHash, m_states.cullingSide);
+		HashCombine(statesHash, m_states.depthBuffer);
+		HashCombine(statesHash, m_states.depthFunc);
+		HashCombine(statesHash, m_states.depthWrite);
+		HashCombine(statesHash, m_states.dstBlend);
+		HashCombine(statesHash, m_states.faceCulling);
+		HashCombine(statesHash, m_states.faceFilling);
+		HashCombine(statesHash, m_states.scissorTest);
+		HashCombine(statesHash, m_states.srcBlend);
+		HashCombine(statesHash, m_states.stencilTest);
+
+		std::size_t texturesHash = 0;
+		HashCombine(texturesHash, m_diffuseMap.Get());
+		HashCombine(texturesHash, m_alphaMap.Get());
+		HashCombine(texturesHash, m_emissiveMap.Get());
+		HashCombine(texturesHash, m_heightMap.Get());
+		HashCombine(texturesHash, m_normalMap.Get());
+		HashCombine(texturesHash, m_specularMap.Get());
+
+		m_sortKey = (FoldHash(pipelineHash, 12) << 20) | (FoldHash(statesHash, 10) << 10) | FoldHash(texturesHash, 10);
+		m_sortKeyUpdated = true;
+	}
+
+	/*!
+	* \brief Uploads the parameters of the material to its uniform buffer
+	*
+	* \remark The buffer is created on first use, by the thread owning the context
+	*/
+
+	void Material::UpdateUniformBuffer() const
+	{
+		if (!m_uniformBuffer)
+		{
+			BufferRef uniformBuffer = Buffer::New(BufferType_Uniform);
+			if (!uniformBuffer->Create(sizeof(UniformBlock), DataStorage_Hardware, BufferUsage_Dynamic))
+			{
+				NazaraError("Failed to create uniform buffer");
+				return;
+			}
+
+			m_uniformBuffer = std::move(uniformBuffer);
+		}
+
+		UniformBlock block;
+		block.ambient = ColorToVector(m_ambientColor);
+		block.diffuse = ColorToVector(m_diffuseColor);
+		block.specular = ColorToVector(m_specularColor);
+		block.alphaThreshold = m_alphaThreshold;
+		block.shininess = m_shininess;
+		std::copy(m_bindlessHandles.begin(), m_bindlessHandles.end(), block.textureHandles);
+
+		m_uniformBuffer->Fill(&block, 0, sizeof(UniformBlock));
+		m_uniformBufferUpdated = true;
+	}
+
+	/*!
+	* \brief Enables asynchronous compilation of shader variants
+	*
+	* \param enable Should variants be compiled without stalling the rendering
+	*
+	* \remark While a variant is being compiled, materials are rendered with a plain variant sharing the same shader flags
+	* \remark Compilation only overlaps with rendering if the driver supports KHR_parallel_shader_compile
+	*/
+
+	void Material::EnableAsyncShaderCompilation(bool enable)
+	{
+		s_asyncShaderCompilation = enable;
+	}
+
+	/*!
+	* \brief Enables bindless textures
+	* \return true If bindless textures are now in the requested state
+	*
+	* \param enable Should materials reference their textures by handles stored in their uniform buffer
+	*
+	* \remark Materials no longer bind texture units, only their uniform buffer changes between them
+	* \remark Once a texture is used through a handle, its parameters (as its mipmap range) cannot change anymore
+	* \remark Produces a NazaraError if enabled without RendererCap_BindlessTexture
+	*/
+
+	bool Material::EnableBindlessTextures(bool enable)
+	{
+		if (enable && !Renderer::HasCapability(RendererCap_BindlessTexture))
+		{
+			NazaraError("Bindless textures are not supported");
+			return false;
+		}
+
+		s_bindlessTextures = enable;
+		return true;
+	}
+
+	/*!
+	* \brief Checks whether shader variants are compiled asynchronously
+	* \return true If it is the case
+	*/
+
+	bool Material::IsAsyncShaderCompilationEnabled()
+	{
+		return s_asyncShaderCompilation;
+	}
+
+	/*!
+	* \brief Checks whether materials use bindless textures
+	* \return true If it is the case
+	*/
+
+	bool Material::IsBindlessTexturesEnabled()
+	{
+		return s_bindlessTextures;
+	}
+
 	/*!
 	* \brief Initializes the material librairies
 	* \return true If successful
@@ -563,10 +896,12 @@ namespace Nz
 			UberShaderPreprocessorRef uberShader = UberShaderPreprocessor::New();
 
 			String fragmentShader(reinterpret_cast<const char*>(r_basicFragmentShader), sizeof(r_basicFragmentShader));
+			String geometryShader(reinterpret_cast<const char*>(r_basicGeometryShader), sizeof(r_basicGeometryShader));
 			String vertexShader(reinterpret_cast<const char*>(r_basicVertexShader), sizeof(r_basicVertexShader));
 
-			uberShader->SetShader(ShaderStageType_Fragment, fragmentShader, "FLAG_TEXTUREOVERLAY ALPHA_MAPPING ALPHA_TEST AUTO_TEXCOORDS DIFFUSE_MAPPING");
-			uberShader->SetShader(ShaderStageType_Vertex, vertexShader, "FLAG_BILLBOARD FLAG_INSTANCING FLAG_VERTEXCOLOR TEXTURE_MAPPING TRANSFORM UNIFORM_VERTEX_DEPTH");
+			uberShader->SetShader(ShaderStageType_Fragment, fragmentShader, "FLAG_TEXTUREOVERLAY ALPHA_MAPPING ALPHA_TEST AUTO_TEXCOORDS BINDLESS_TEXTURES DIFFUSE_MAPPING DISTANCE_FIELD MATERIAL_UNIFORM_BUFFER TEXTURE_ARRAY");
+			uberShader->SetShader(ShaderStageType_Geometry, geometryShader, "TEXTURE_ARRAY", "FLAG_CUBEMAPLAYERED");
+			uberShader->SetShader(ShaderStageType_Vertex, vertexShader, "FLAG_BILLBOARD FLAG_CUBEMAPLAYERED FLAG_INSTANCING FLAG_SKINNING FLAG_VERTEXCOLOR FLAG_VERTEXPULLING TEXTURE_ARRAY TEXTURE_MAPPING TRANSFORM UNIFORM_VERTEX_DEPTH");
 
 			UberShaderLibrary::Register("Basic", uberShader);
 		}
@@ -578,8 +913,8 @@ namespace Nz
 			String fragmentShader(reinterpret_cast<const char*>(r_phongLightingFragmentShader), sizeof(r_phongLightingFragmentShader));
 			String vertexShader(reinterpret_cast<const char*>(r_phongLightingVertexShader), sizeof(r_phongLightingVertexShader));
 
-			uberShader->SetShader(ShaderStageType_Fragment, fragmentShader, "FLAG_DEFERRED FLAG_TEXTUREOVERLAY ALPHA_MAPPING ALPHA_TEST AUTO_TEXCOORDS DIFFUSE_MAPPING EMISSIVE_MAPPING LIGHTING NORMAL_MAPPING PARALLAX_MAPPING SHADOW_MAPPING SPECULAR_MAPPING");
-			uberShader->SetShader(ShaderStageType_Vertex, vertexShader, "FLAG_BILLBOARD FLAG_DEFERRED FLAG_INSTANCING FLAG_VERTEXCOLOR COMPUTE_TBNMATRIX LIGHTING PARALLAX_MAPPING SHADOW_MAPPING TEXTURE_MAPPING TRANSFORM UNIFORM_VERTEX_DEPTH");
+			uberShader->SetShader(ShaderStageType_Fragment, fragmentShader, "FLAG_CLUSTEREDLIGHTING FLAG_DEFERRED FLAG_TEXTUREOVERLAY ALPHA_MAPPING ALPHA_TEST AUTO_TEXCOORDS BINDLESS_TEXTURES DIFFUSE_MAPPING DISTANCE_FIELD EMISSIVE_MAPPING LIGHTING MATERIAL_UNIFORM_BUFFER NORMAL_MAPPING PARALLAX_MAPPING SHADOW_MAPPING SPECULAR_MAPPING TEXTURE_ARRAY");
+			uberShader->SetShader(ShaderStageType_Vertex, vertexShader, "FLAG_BILLBOARD FLAG_DEFERRED FLAG_INSTANCING FLAG_SKINNING FLAG_VERTEXCOLOR FLAG_VERTEXPULLING COMPUTE_TBNMATRIX LIGHTING PARALLAX_MAPPING SHADOW_MAPPING TEXTURE_ARRAY TEXTURE_MAPPING TRANSFORM UNIFORM_VERTEX_DEPTH");
 
 			UberShaderLibrary::Register("PhongLighting", uberShader);
 		}
@@ -605,7 +940,12 @@ namespace Nz
 		mat->EnableLighting(false);
 		mat->SetDstBlend(BlendFunc_InvSrcAlpha);
 		mat->SetSrcBlend(BlendFunc_SrcAlpha);
-		MaterialLibrary::Register("Translucent2D", std::move(mat));
+		MaterialLibrary::Register("Translucent2D", mat);
+
+		// Shared by the text sprites using distance field fonts, so their glyphes can be batched together
+		mat = New(*mat);
+		mat->EnableDistanceField(true);
+		MaterialLibrary::Register("TranslucentDistanceField2D", std::move(mat));
 
 		return true;
 	}
@@ -625,7 +965,11 @@ namespace Nz
 
 	MaterialLibrary::LibraryMap Material::s_library;
 	MaterialLoader::LoaderList Material::s_loaders;
+	MaterialManager::ManagerCache Material::s_managerCache;
+	MaterialManager::ManagerLoads Material::s_managerLoads;
 	MaterialManager::ManagerMap Material::s_managerMap;
 	MaterialManager::ManagerParams Material::s_managerParameters;
 	MaterialRef Material::s_defaultMaterial = nullptr;
+	bool Material::s_asyncShaderCompilation = false;
+	bool Material::s_bindlessTextures = false;
 }
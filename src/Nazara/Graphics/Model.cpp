@@ -4,14 +4,37 @@
 
 #include <Nazara/Graphics/Model.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Projected size of the bounding sphere of a box, relative to the viewport height
+		float ComputeScreenSize(const AbstractViewer& viewer, const Boxf& aabb, const Matrix4f& transformMatrix)
+		{
+			Vector3f scale = transformMatrix.GetScale();
+			float radius = aabb.GetLengths().GetLength() * 0.5f * std::max({scale.x, scale.y, scale.z});
+
+			const Matrix4f& projectionMatrix = viewer.GetProjectionMatrix();
+			if (projectionMatrix.m44 != 0.f)
+				return radius * projectionMatrix.m22; // Orthographic projection, the size doesn't depend on the distance
+
+			float distance = viewer.GetEyePosition().Distance(transformMatrix.Transform(aabb.GetCenter()));
+			if (distance <= radius)
+				return std::numeric_limits<float>::infinity();
+
+			return radius * projectionMatrix.m22 / distance;
+		}
+	}
+
 	/*!
 	* \ingroup graphics
 	* \class Nz::Model
@@ -67,19 +90,28 @@ namespace Nz
 	*
 	* \param renderQueue Queue to be added
 	* \param instanceData Data used for this instance
+	*
+	* When the queue has a viewer, submeshes having levels of detail are submitted with the one matching their projected size
 	*/
 
 	void Model::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
 	{
+		const AbstractViewer* viewer = renderQueue->GetViewer();
+
 		unsigned int submeshCount = m_mesh->GetSubMeshCount();
 		for (unsigned int i = 0; i < submeshCount; ++i)
 		{
 			const StaticMesh* mesh = static_cast<const StaticMesh*>(m_mesh->GetSubMesh(i));
 			Material* material = m_materials[mesh->GetMaterialIndex()];
 
+			unsigned int levelOfDetail = 0;
+			if (viewer && mesh->GetLevelOfDetailCount() > 1)
+				levelOfDetail = mesh->SelectLevelOfDetail(ComputeScreenSize(*viewer, mesh->GetAABB(), *instanceData.transformMatrix));
+
 			MeshData meshData;
-			meshData.indexBuffer = mesh->GetIndexBuffer();
+			meshData.indexBuffer = mesh->GetIndexBuffer(levelOfDetail);
 			meshData.primitiveMode = mesh->GetPrimitiveMode();
+			meshData.skeleton = nullptr;
 			meshData.vertexBuffer = mesh->GetVertexBuffer();
 
 			renderQueue->AddMesh(instanceData.renderOrder, material, meshData, mesh->GetAABB(), *instanceData.transformMatrix);
@@ -355,6 +387,8 @@ namespace Nz
 		else
 			m_materials[index] = Material::GetDefault();
 
+		InvalidateInstanceData(0);
+
 		return true;
 	}
 
@@ -384,6 +418,8 @@ namespace Nz
 			m_materials[index] = material;
 		else
 			m_materials[index] = Material::GetDefault();
+
+		InvalidateInstanceData(0);
 	}
 
 	/*!
@@ -430,6 +466,8 @@ namespace Nz
 		else
 			m_materials[index] = Material::GetDefault();
 
+		InvalidateInstanceData(0);
+
 		return true;
 	}
 
@@ -467,6 +505,8 @@ namespace Nz
 			m_materials[index] = material;
 		else
 			m_materials[index] = Material::GetDefault();
+
+		InvalidateInstanceData(0);
 	}
 
 	/*!
@@ -504,6 +544,7 @@ namespace Nz
 		}
 
 		InvalidateBoundingVolume();
+		InvalidateInstanceData(0);
 	}
 
 	/*!
@@ -525,6 +566,8 @@ namespace Nz
 		#endif
 
 		m_skin = skin;
+
+		InvalidateInstanceData(0);
 	}
 
 	/*!
@@ -38,6 +38,18 @@ namespace Nz
 		OnParticleControllerRelease(this);
 	}
 
+	/*!
+	* \brief Checks whether the controller can be applied on disjoint ranges of particles by multiple threads at once
+	* \return false by default
+	*
+	* \remark Controllers overriding this to return true must only touch the particles of the range they are given (killing them is allowed)
+	*/
+
+	bool ParticleController::IsParallelizable() const
+	{
+		return false;
+	}
+
 	/*!
 	* \brief Initializes the particle controller librairies
 	* \return true If successful
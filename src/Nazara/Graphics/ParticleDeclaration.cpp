@@ -261,6 +261,16 @@ namespace Nz
 			case ComponentType_Int4:
 			case ComponentType_Quaternion:
 				return true;
+
+			// Particles are updated by the CPU, which only works on plain types
+			case ComponentType_Half2:
+			case ComponentType_Half4:
+			case ComponentType_NormalizedByte4:
+			case ComponentType_NormalizedShort2:
+			case ComponentType_NormalizedShort4:
+			case ComponentType_NormalizedUShort2:
+			case ComponentType_NormalizedInt2101010:
+				return false;
 		}
 
 		NazaraError("Component type not handled (0x" + String::Number(type, 16) + ')');
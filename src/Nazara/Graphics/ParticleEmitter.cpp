@@ -57,14 +57,19 @@ namespace Nz
 				unsigned int emissionCountInt = static_cast<unsigned int>(emissionCount);
 				unsigned int maxParticleCount = emissionCountInt * m_emissionCount;
 
-				// We get the number of particles that we are able to create (depending on the free space)
-				unsigned int particleCount = std::min(maxParticleCount, system.GetMaxParticleCount() - system.GetParticleCount());
-				if (particleCount == 0)
+				// We get the number of particles that we are able to create (depending on the free space, which the simulation LOD may reduce)
+				unsigned int particleLimit = system.GetParticleLimit();
+				if (system.GetParticleCount() >= particleLimit)
 					return;
 
+				unsigned int particleCount = std::min(maxParticleCount, particleLimit - system.GetParticleCount());
+
 				// And we emit our particles
-				void* particles = system.GenerateParticles(particleCount);
-				ParticleMapper mapper(particles, system.GetDeclaration());
+				unsigned int firstParticle = system.GetParticleCount();
+				if (!system.GenerateParticles(particleCount))
+					return;
+
+				ParticleMapper mapper = system.GetParticleMapper(firstParticle);
 
 				SetupParticles(mapper, particleCount);
 
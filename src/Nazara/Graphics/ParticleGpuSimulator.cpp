@@ -0,0 +1,703 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/ParticleGpuSimulator.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Graphics/ParticleMapper.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		const unsigned int s_maxStateWidth = 1024;
+
+		// State textures hold a particle per texel, a slot is alive as long as its remaining life is positive
+		const char* r_simulationFragmentSource =
+		"#version 140\n"
+
+		"out vec4 RenderTarget0;\n"
+		"out vec4 RenderTarget1;\n"
+
+		"uniform float ElapsedTime;\n"
+		"uniform vec3 Gravity;\n"
+		"uniform sampler2D State0;\n"
+		"uniform sampler2D State1;\n"
+
+		"void main()\n"
+		"{\n"
+			"ivec2 texel = ivec2(gl_FragCoord.xy);\n"
+			"vec4 state0 = texelFetch(State0, texel, 0);\n"
+			"vec4 state1 = texelFetch(State1, texel, 0);\n"
+
+			"if (state0.w > 0.0)\n"
+			"{\n"
+				"state1.xyz += Gravity * ElapsedTime;\n"
+				"state0.xyz += state1.xyz * ElapsedTime;\n"
+				"state0.w -= ElapsedTime;\n"
+			"}\n"
+
+			"RenderTarget0 = state0;\n"
+			"RenderTarget1 = state1;\n"
+		"}\n";
+
+		const char* r_simulationVertexSource =
+		"#version 140\n"
+
+		"in vec3 VertexPosition;\n"
+
+		"void main()\n"
+		"{\n"
+			"gl_Position = vec4(VertexPosition, 1.0);\n"
+		"}\n";
+
+		const char* r_renderFragmentSource =
+		"#version 140\n"
+
+		"in vec4 vColor;\n"
+		"in vec2 vTexCoord;\n"
+
+		"out vec4 RenderTarget0;\n"
+
+		"uniform sampler2D DiffuseMap;\n"
+		"uniform bool HasDiffuseMap;\n"
+
+		"void main()\n"
+		"{\n"
+			"vec4 color = vColor;\n"
+			"if (HasDiffuseMap)\n"
+				"color *= texture(DiffuseMap, vTexCoord);\n"
+
+			"RenderTarget0 = color;\n"
+		"}\n";
+
+		const char* r_renderVertexSource =
+		"#version 140\n"
+
+		"in vec2 VertexPosition;\n"
+		"in vec2 InstanceData0;\n"
+
+		"out vec4 vColor;\n"
+		"out vec2 vTexCoord;\n"
+
+		"uniform vec4 EndColor;\n"
+		"uniform float EndSize;\n"
+		"uniform vec4 StartColor;\n"
+		"uniform float StartSize;\n"
+		"uniform sampler2D State0;\n"
+		"uniform sampler2D State1;\n"
+		"uniform mat4 ViewMatrix;\n"
+		"uniform mat4 ViewProjMatrix;\n"
+
+		"void main()\n"
+		"{\n"
+			"vec4 state0 = texelFetch(State0, ivec2(InstanceData0), 0);\n"
+			"vec4 state1 = texelFetch(State1, ivec2(InstanceData0), 0);\n"
+
+			"vTexCoord = VertexPosition + 0.5;\n"
+
+			"if (state0.w <= 0.0)\n"
+			"{\n"
+				"// Dead particles collapse to a single point, which doesn't produce any fragment\n"
+				"gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"
+				"vColor = vec4(0.0);\n"
+				"return;\n"
+			"}\n"
+
+			"float age = clamp(1.0 - state0.w / state1.w, 0.0, 1.0);\n"
+			"float size = mix(StartSize, EndSize, age);\n"
+
+			"vec3 cameraRight = vec3(ViewMatrix[0][0], ViewMatrix[1][0], ViewMatrix[2][0]);\n"
+			"vec3 cameraUp = vec3(ViewMatrix[0][1], ViewMatrix[1][1], ViewMatrix[2][1]);\n"
+			"vec3 vertexPos = state0.xyz + (cameraRight*VertexPosition.x + cameraUp*VertexPosition.y) * size;\n"
+
+			"gl_Position = ViewProjMatrix * vec4(vertexPos, 1.0);\n"
+			"vColor = mix(StartColor, EndColor, age);\n"
+		"}\n";
+
+		ShaderRef BuildShader(const char* vertexSource, const char* fragmentSource)
+		{
+			ShaderRef shader = Shader::New();
+			if (!shader->Create())
+			{
+				NazaraError("Failed to create shader");
+				return nullptr;
+			}
+
+			if (!shader->AttachStageFromSource(ShaderStageType_Fragment, fragmentSource))
+			{
+				NazaraError("Failed to load fragment shader");
+				return nullptr;
+			}
+
+			if (!shader->AttachStageFromSource(ShaderStageType_Vertex, vertexSource))
+			{
+				NazaraError("Failed to load vertex shader");
+				return nullptr;
+			}
+
+			if (!shader->Link())
+			{
+				NazaraError("Failed to link shader");
+				return nullptr;
+			}
+
+			return shader;
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class Nz::ParticleGpuSimulator
+	* \brief Graphics class that simulates and draws particles without them leaving the GPU
+	*
+	* Particles are stored one per texel in floating-point textures, updated by rendering into the other set of textures.
+	* Only newly spawned particles are uploaded, the built-in controllers (gravity, velocity, life, color and size over life) then run on the GPU
+	* and the particles are drawn as camera-facing billboards straight from the state textures.
+	*
+	* \remark Spawned particles are written in a ring, if more particles are alive than the simulator can hold, the oldest ones are replaced
+	*/
+
+	/*!
+	* \brief Constructs a ParticleGpuSimulator object able to hold a number of particles
+	*
+	* \param maxParticleCount Maximum number of particles alive at once
+	*
+	* \remark Produces a NazaraAssert if maxParticleCount is zero
+	*/
+
+	ParticleGpuSimulator::ParticleGpuSimulator(unsigned int maxParticleCount) :
+	m_endColor(Color::White),
+	m_startColor(Color::White),
+	m_material(Material::GetDefault()),
+	m_gravity(Vector3f::Zero()),
+	m_endSize(1.f),
+	m_startSize(1.f),
+	m_maxParticleCount(maxParticleCount)
+	{
+		NazaraAssert(maxParticleCount > 0, "Invalid max particle count");
+
+		CreateStates();
+	}
+
+	/*!
+	* \brief Constructs a ParticleGpuSimulator object with the settings of another one
+	*
+	* \param simulator ParticleGpuSimulator to copy the settings from
+	*
+	* \remark The particles of the other simulator are not copied
+	*/
+
+	ParticleGpuSimulator::ParticleGpuSimulator(const ParticleGpuSimulator& simulator) :
+	Drawable(simulator),
+	m_endColor(simulator.m_endColor),
+	m_startColor(simulator.m_startColor),
+	m_material(simulator.m_material),
+	m_gravity(simulator.m_gravity),
+	m_endSize(simulator.m_endSize),
+	m_startSize(simulator.m_startSize),
+	m_maxParticleCount(simulator.m_maxParticleCount)
+	{
+		CreateStates();
+	}
+
+	ParticleGpuSimulator::~ParticleGpuSimulator() = default;
+
+	/*!
+	* \brief Draws the alive particles as billboards facing the camera
+	*
+	* \remark Uses the render states and the diffuse map of the material
+	*/
+
+	void ParticleGpuSimulator::Draw() const
+	{
+		if (m_usedParticleCount == 0)
+			return;
+
+		Renderer::SetRenderStates(m_material->GetRenderStates());
+		Renderer::SetShader(s_renderShader);
+
+		s_renderShader->SendColor(s_renderShader->GetUniformLocation("EndColor"), m_endColor);
+		s_renderShader->SendFloat(s_renderShader->GetUniformLocation("EndSize"), m_endSize);
+		s_renderShader->SendColor(s_renderShader->GetUniformLocation("StartColor"), m_startColor);
+		s_renderShader->SendFloat(s_renderShader->GetUniformLocation("StartSize"), m_startSize);
+
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			Renderer::SetTexture(i, m_stateTextures[m_currentState][i]);
+			Renderer::SetTextureSampler(i, s_stateSampler);
+		}
+
+		bool hasDiffuseMap = m_material->HasDiffuseMap();
+		s_renderShader->SendBoolean(s_renderShader->GetUniformLocation("HasDiffuseMap"), hasDiffuseMap);
+		if (hasDiffuseMap)
+		{
+			Renderer::SetTexture(2, m_material->GetDiffuseMap());
+			Renderer::SetTextureSampler(2, m_material->GetDiffuseSampler());
+		}
+
+		Renderer::SetInstanceBuffer(&m_instanceBuffer);
+		Renderer::SetVertexBuffer(&s_quadVertexBuffer);
+		Renderer::DrawPrimitivesInstanced(m_usedParticleCount, PrimitiveMode_TriangleStrip, 0, 4);
+
+		// Instanced rendering of other objects expects the instance buffer of the renderer
+		Renderer::SetInstanceBuffer(nullptr);
+	}
+
+	/*!
+	* \brief Gets the color of the particles at the end of their life
+	* \return Color at the end of the life
+	*/
+
+	const Color& ParticleGpuSimulator::GetEndColor() const
+	{
+		return m_endColor;
+	}
+
+	/*!
+	* \brief Gets the size of the particles at the end of their life
+	* \return Size at the end of the life
+	*/
+
+	float ParticleGpuSimulator::GetEndSize() const
+	{
+		return m_endSize;
+	}
+
+	/*!
+	* \brief Gets the acceleration applied to the particles
+	* \return Gravity applied to the velocity
+	*/
+
+	const Vector3f& ParticleGpuSimulator::GetGravity() const
+	{
+		return m_gravity;
+	}
+
+	/*!
+	* \brief Gets the material used to draw the particles
+	* \return Reference to the material
+	*/
+
+	const MaterialRef& ParticleGpuSimulator::GetMaterial() const
+	{
+		return m_material;
+	}
+
+	/*!
+	* \brief Gets the maximum number of particles alive at once
+	* \return Maximum number of particles
+	*/
+
+	unsigned int ParticleGpuSimulator::GetMaxParticleCount() const
+	{
+		return m_maxParticleCount;
+	}
+
+	/*!
+	* \brief Gets the color of the particles at the beginning of their life
+	* \return Color at the beginning of the life
+	*/
+
+	const Color& ParticleGpuSimulator::GetStartColor() const
+	{
+		return m_startColor;
+	}
+
+	/*!
+	* \brief Gets the size of the particles at the beginning of their life
+	* \return Size at the beginning of the life
+	*/
+
+	float ParticleGpuSimulator::GetStartSize() const
+	{
+		return m_startSize;
+	}
+
+	/*!
+	* \brief Gets the current state texture
+	* \return Pointer to the texture, 0 holds the positions and remaining lives, 1 the velocities and total lives
+	*
+	* \param i Index of the state texture
+	*
+	* \remark Produces a NazaraAssert if index is invalid
+	*/
+
+	Texture* ParticleGpuSimulator::GetStateTexture(unsigned int i) const
+	{
+		NazaraAssert(i < 2, "State texture index out of range");
+
+		return m_stateTextures[m_currentState][i];
+	}
+
+	/*!
+	* \brief Gets the number of slots spawned particles were written to
+	* \return Number of particles drawn, dead ones included
+	*/
+
+	unsigned int ParticleGpuSimulator::GetUsedParticleCount() const
+	{
+		return m_usedParticleCount;
+	}
+
+	/*!
+	* \brief Kills every particles
+	*/
+
+	void ParticleGpuSimulator::KillParticles()
+	{
+		m_spawnCursor = 0;
+		m_usedParticleCount = 0;
+	}
+
+	/*!
+	* \brief Sets the color of the particles over their life
+	*
+	* \param startColor Color at the beginning of the life
+	* \param endColor Color at the end of the life
+	*/
+
+	void ParticleGpuSimulator::SetColorOverLife(const Color& startColor, const Color& endColor)
+	{
+		m_endColor = endColor;
+		m_startColor = startColor;
+	}
+
+	/*!
+	* \brief Sets the acceleration applied to the particles
+	*
+	* \param gravity Gravity applied to the velocity
+	*/
+
+	void ParticleGpuSimulator::SetGravity(const Vector3f& gravity)
+	{
+		m_gravity = gravity;
+	}
+
+	/*!
+	* \brief Sets the material used to draw the particles
+	*
+	* \param material Material whose render states and diffuse map are used, the default material if invalid
+	*/
+
+	void ParticleGpuSimulator::SetMaterial(MaterialRef material)
+	{
+		m_material = (material) ? std::move(material) : Material::GetDefault();
+	}
+
+	/*!
+	* \brief Sets the size of the particles over their life
+	*
+	* \param startSize Size at the beginning of the life
+	* \param endSize Size at the end of the life
+	*/
+
+	void ParticleGpuSimulator::SetSizeOverLife(float startSize, float endSize)
+	{
+		m_endSize = endSize;
+		m_startSize = startSize;
+	}
+
+	/*!
+	* \brief Simulates the particles
+	*
+	* \param elapsedTime Delta time between the previous frame
+	*
+	* \remark The current target and viewport of the renderer are restored afterwards
+	*/
+
+	void ParticleGpuSimulator::Simulate(float elapsedTime)
+	{
+		if (m_usedParticleCount == 0)
+			return;
+
+		const RenderTarget* previousTarget = Renderer::GetTarget();
+		Recti previousViewport = Renderer::GetViewport();
+
+		unsigned int nextState = 1 - m_currentState;
+
+		m_stateRTT[nextState].SetColorTargets({0, 1});
+		Renderer::SetTarget(&m_stateRTT[nextState]);
+		Renderer::SetViewport(Recti(0, 0, m_stateSize.x, m_stateSize.y));
+
+		Renderer::SetRenderStates(s_simulationStates);
+		Renderer::SetShader(s_simulationShader);
+
+		s_simulationShader->SendFloat(s_simulationShader->GetUniformLocation("ElapsedTime"), elapsedTime);
+		s_simulationShader->SendVector(s_simulationShader->GetUniformLocation("Gravity"), m_gravity);
+
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			Renderer::SetTexture(i, m_stateTextures[m_currentState][i]);
+			Renderer::SetTextureSampler(i, s_stateSampler);
+		}
+
+		Renderer::DrawFullscreenQuad();
+
+		m_currentState = nextState;
+
+		if (previousTarget)
+		{
+			Renderer::SetTarget(previousTarget);
+			Renderer::SetViewport(previousViewport);
+		}
+	}
+
+	/*!
+	* \brief Uploads newly generated particles to the GPU
+	*
+	* \param mapper Mapper to the particles to spawn, their position, velocity and life are read
+	* \param count Number of particles to spawn
+	*
+	* \remark A particle without life component lives forever, integer lives are read as milliseconds and floating-point ones as seconds
+	* \remark Produces a NazaraError if the position component of the particles is not enabled
+	*/
+
+	void ParticleGpuSimulator::Spawn(const ParticleMapper& mapper, unsigned int count)
+	{
+		unsigned int capacity = m_stateSize.x * m_stateSize.y;
+
+		// Only the last ones would survive if more particles than the simulator can hold are spawned at once
+		unsigned int firstParticle = (count > capacity) ? count - capacity : 0;
+		count -= firstParticle;
+
+		if (count == 0)
+			return;
+
+		const ParticleDeclaration* declaration = mapper.GetDeclaration();
+
+		bool enabled;
+		ComponentType type;
+
+		m_spawnStates[0].resize(count);
+		m_spawnStates[1].resize(count);
+
+		declaration->GetComponent(ParticleComponent_Position, &enabled, &type, nullptr);
+		if (!enabled)
+		{
+			NazaraError("Particles need a position to be simulated");
+			return;
+		}
+
+		if (type == ComponentType_Float2)
+		{
+			SparsePtr<const Vector2f> positionPtr = mapper.GetComponentPtr<Vector2f>(ParticleComponent_Position);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[0][i].Set(positionPtr[firstParticle + i].x, positionPtr[firstParticle + i].y, 0.f, 0.f);
+		}
+		else
+		{
+			SparsePtr<const Vector3f> positionPtr = mapper.GetComponentPtr<Vector3f>(ParticleComponent_Position);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[0][i].Set(positionPtr[firstParticle + i], 0.f);
+		}
+
+		declaration->GetComponent(ParticleComponent_Velocity, &enabled, &type, nullptr);
+		if (!enabled)
+		{
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[1][i] = Vector4f::Zero();
+		}
+		else if (type == ComponentType_Float2)
+		{
+			SparsePtr<const Vector2f> velocityPtr = mapper.GetComponentPtr<Vector2f>(ParticleComponent_Velocity);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[1][i].Set(velocityPtr[firstParticle + i].x, velocityPtr[firstParticle + i].y, 0.f, 0.f);
+		}
+		else
+		{
+			SparsePtr<const Vector3f> velocityPtr = mapper.GetComponentPtr<Vector3f>(ParticleComponent_Velocity);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[1][i].Set(velocityPtr[firstParticle + i], 0.f);
+		}
+
+		declaration->GetComponent(ParticleComponent_Life, &enabled, &type, nullptr);
+		if (!enabled)
+		{
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[0][i].w = std::numeric_limits<float>::max();
+		}
+		else if (type == ComponentType_Int1)
+		{
+			SparsePtr<const UInt32> lifePtr = mapper.GetComponentPtr<UInt32>(ParticleComponent_Life);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[0][i].w = lifePtr[firstParticle + i] / 1000.f;
+		}
+		else
+		{
+			SparsePtr<const float> lifePtr = mapper.GetComponentPtr<float>(ParticleComponent_Life);
+			for (unsigned int i = 0; i < count; ++i)
+				m_spawnStates[0][i].w = lifePtr[firstParticle + i];
+		}
+
+		// The total life gives the age of the particle, for the properties evolving over life
+		for (unsigned int i = 0; i < count; ++i)
+			m_spawnStates[1][i].w = m_spawnStates[0][i].w;
+
+		// The ring may wrap around in the middle of the spawned particles
+		unsigned int firstCount = std::min(count, capacity - m_spawnCursor);
+		UploadStates(m_spawnCursor, firstCount, &m_spawnStates[0][0], &m_spawnStates[1][0]);
+		if (firstCount < count)
+			UploadStates(0, count - firstCount, &m_spawnStates[0][firstCount], &m_spawnStates[1][firstCount]);
+
+		m_spawnCursor = (m_spawnCursor + count) % capacity;
+		m_usedParticleCount = std::min(m_usedParticleCount + count, capacity);
+	}
+
+	/*!
+	* \brief Creates the state textures and the instance buffer referencing their texels
+	*
+	* \remark Produces a NazaraError if the state render textures are not complete
+	*/
+
+	void ParticleGpuSimulator::CreateStates()
+	{
+		m_currentState = 0;
+		m_spawnCursor = 0;
+		m_usedParticleCount = 0;
+
+		// Whole rows are allocated, the last one may hold a few more particles than asked for
+		m_stateSize.x = std::min(m_maxParticleCount, s_maxStateWidth);
+		m_stateSize.y = (m_maxParticleCount + m_stateSize.x - 1) / m_stateSize.x;
+
+		unsigned int capacity = m_stateSize.x * m_stateSize.y;
+
+		// Dead particles (null life) everywhere
+		std::vector<Vector4f> emptyStates(capacity, Vector4f::Zero());
+
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			m_stateRTT[i].Create(true);
+			for (unsigned int j = 0; j < 2; ++j)
+			{
+				m_stateTextures[i][j] = Texture::New();
+				m_stateTextures[i][j]->Create(ImageType_2D, PixelFormatType_RGBA32F, m_stateSize.x, m_stateSize.y);
+				m_stateTextures[i][j]->Update(reinterpret_cast<const UInt8*>(emptyStates.data()));
+
+				m_stateRTT[i].AttachTexture(AttachmentPoint_Color, j, m_stateTextures[i][j]);
+			}
+			m_stateRTT[i].Unlock();
+
+			if (!m_stateRTT[i].IsComplete())
+				NazaraError("Incomplete particle state RTT");
+		}
+
+		std::vector<Vector2f> texels(capacity);
+		for (unsigned int i = 0; i < capacity; ++i)
+			texels[i].Set(static_cast<float>(i % m_stateSize.x), static_cast<float>(i / m_stateSize.x));
+
+		m_instanceBuffer.Reset(&s_instanceDeclaration, capacity, DataStorage_Hardware, BufferUsage_Static);
+		m_instanceBuffer.Fill(texels.data(), 0, capacity);
+	}
+
+	/*!
+	* \brief Writes the states of consecutive slots in the current state textures
+	*
+	* \param firstSlot Index of the first slot to write
+	* \param count Number of slots to write, they must not go past the last slot
+	* \param state0 Positions and remaining lives of the particles
+	* \param state1 Velocities and total lives of the particles
+	*/
+
+	void ParticleGpuSimulator::UploadStates(unsigned int firstSlot, unsigned int count, const Vector4f* state0, const Vector4f* state1)
+	{
+		const Vector4f* states[2] = {state0, state1};
+
+		while (count > 0)
+		{
+			unsigned int x = firstSlot % m_stateSize.x;
+			unsigned int y = firstSlot / m_stateSize.x;
+
+			// Whole rows are sent at once, the others slot by slot until the end of their row
+			Rectui rect;
+			if (x == 0 && count >= m_stateSize.x)
+				rect.Set(0, y, m_stateSize.x, count / m_stateSize.x);
+			else
+				rect.Set(x, y, std::min(count, m_stateSize.x - x), 1);
+
+			unsigned int slotCount = rect.width * rect.height;
+			for (unsigned int i = 0; i < 2; ++i)
+			{
+				m_stateTextures[m_currentState][i]->Update(reinterpret_cast<const UInt8*>(states[i]), rect);
+				states[i] += slotCount;
+			}
+
+			firstSlot += slotCount;
+			count -= slotCount;
+		}
+	}
+
+	/*!
+	* \brief Initializes the shaders and buffers shared by the simulators
+	* \return true If successful
+	*
+	* \remark Produces a NazaraError if a shader could not be built
+	*/
+
+	bool ParticleGpuSimulator::Initialize()
+	{
+		try
+		{
+			ErrorFlags flags(ErrorFlag_ThrowException, true);
+
+			s_instanceDeclaration.EnableComponent(VertexComponent_InstanceData0, ComponentType_Float2, 0);
+
+			s_quadVertexBuffer.Reset(VertexDeclaration::Get(VertexLayout_XY), 4, DataStorage_Hardware, BufferUsage_Static);
+
+			float vertices[2 * 4] = {
+			   -0.5f, -0.5f,
+				0.5f, -0.5f,
+			   -0.5f, 0.5f,
+				0.5f, 0.5f,
+			};
+
+			s_quadVertexBuffer.FillRaw(vertices, 0, sizeof(vertices));
+
+			s_simulationShader = BuildShader(r_simulationVertexSource, r_simulationFragmentSource);
+			s_simulationShader->SendInteger(s_simulationShader->GetUniformLocation("State0"), 0);
+			s_simulationShader->SendInteger(s_simulationShader->GetUniformLocation("State1"), 1);
+
+			s_renderShader = BuildShader(r_renderVertexSource, r_renderFragmentSource);
+			s_renderShader->SendInteger(s_renderShader->GetUniformLocation("State0"), 0);
+			s_renderShader->SendInteger(s_renderShader->GetUniformLocation("State1"), 1);
+			s_renderShader->SendInteger(s_renderShader->GetUniformLocation("DiffuseMap"), 2);
+
+			s_simulationStates.depthBuffer = false;
+
+			s_stateSampler.SetAnisotropyLevel(1);
+			s_stateSampler.SetFilterMode(SamplerFilter_Nearest);
+			s_stateSampler.SetWrapMode(SamplerWrap_Clamp);
+		}
+		catch (const std::exception& e)
+		{
+			NazaraError("Failed to initialise: " + String(e.what()));
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Uninitializes the shaders and buffers shared by the simulators
+	*/
+
+	void ParticleGpuSimulator::Uninitialize()
+	{
+		s_quadVertexBuffer.Reset();
+		s_renderShader.Reset();
+		s_simulationShader.Reset();
+	}
+
+	RenderStates ParticleGpuSimulator::s_simulationStates;
+	ShaderRef ParticleGpuSimulator::s_renderShader;
+	ShaderRef ParticleGpuSimulator::s_simulationShader;
+	TextureSampler ParticleGpuSimulator::s_stateSampler;
+	VertexBuffer ParticleGpuSimulator::s_quadVertexBuffer;
+	VertexDeclaration ParticleGpuSimulator::s_instanceDeclaration;
+}
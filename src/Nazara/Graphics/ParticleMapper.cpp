@@ -23,10 +23,40 @@ namespace Nz
 
 	ParticleMapper::ParticleMapper(void* buffer, const ParticleDeclaration* declaration) :
 	m_declaration(declaration),
-	m_ptr(static_cast<UInt8*>(buffer))
+	m_storage(ParticleStorage_Interleaved),
+	m_ptr(static_cast<UInt8*>(buffer)),
+	m_firstParticle(0),
+	m_maxParticleCount(0)
+	{
+	}
+
+	/*!
+	* \brief Constructs a ParticleMapper object with a buffer storing each component separately
+	*
+	* \param buffer Raw buffer storing the particles data, each component has an array of maxParticleCount elements starting at its offset times maxParticleCount
+	* \param declaration Declaration of the particle
+	* \param maxParticleCount Number of particles the buffer can hold
+	* \param firstParticle Index of the particle mapped as the first one
+	*/
+
+	ParticleMapper::ParticleMapper(void* buffer, const ParticleDeclaration* declaration, unsigned int maxParticleCount, unsigned int firstParticle) :
+	m_declaration(declaration),
+	m_storage(ParticleStorage_Separate),
+	m_ptr(static_cast<UInt8*>(buffer)),
+	m_firstParticle(firstParticle),
+	m_maxParticleCount(maxParticleCount)
 	{
 	}
 
 	ParticleMapper::~ParticleMapper() = default;
 
+	/*!
+	* \brief Gets the declaration of the mapped particles
+	* \return Declaration of the particle
+	*/
+
+	const ParticleDeclaration* ParticleMapper::GetDeclaration() const
+	{
+		return m_declaration;
+	}
 }
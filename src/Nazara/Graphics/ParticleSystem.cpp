@@ -5,9 +5,19 @@
 #include <Nazara/Graphics/ParticleSystem.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/SparsePtr.hpp>
 #include <Nazara/Core/StringStream.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Graphics/ParticleGpuSimulator.hpp>
 #include <Nazara/Graphics/ParticleMapper.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -24,10 +34,11 @@ namespace Nz
 	*
 	* \param maxParticleCount Maximum number of particles to generate
 	* \param layout Enumeration for the layout of data information for the particles
+	* \param storage How the components of the particles are laid out in memory
 	*/
 
-	ParticleSystem::ParticleSystem(unsigned int maxParticleCount, ParticleLayout layout) :
-	ParticleSystem(maxParticleCount, ParticleDeclaration::Get(layout))
+	ParticleSystem::ParticleSystem(unsigned int maxParticleCount, ParticleLayout layout, ParticleStorage storage) :
+	ParticleSystem(maxParticleCount, ParticleDeclaration::Get(layout), storage)
 	{
 	}
 
@@ -36,13 +47,22 @@ namespace Nz
 	*
 	* \param maxParticleCount Maximum number of particles to generate
 	* \param declaration Data information for the particles
+	* \param storage How the components of the particles are laid out in memory
+	*
+	* \remark Separate storage gives controllers contiguous arrays for each component, which they can process in a vectorized way
 	*/
 
-	ParticleSystem::ParticleSystem(unsigned int maxParticleCount, ParticleDeclarationConstRef declaration) :
+	ParticleSystem::ParticleSystem(unsigned int maxParticleCount, ParticleDeclarationConstRef declaration, ParticleStorage storage) :
 	m_declaration(std::move(declaration)),
+	m_storage(storage),
+	m_particleBoundsValid(false),
 	m_processing(false),
+	m_simulationLODEnabled(false),
+	m_timeSinceUpdate(0.f),
+	m_projectedSize(std::numeric_limits<float>::infinity()),
 	m_maxParticleCount(maxParticleCount),
-	m_particleCount(0)
+	m_particleCount(0),
+	m_particleLimit(maxParticleCount)
 	{
 		// In case of error, the constructor can only throw an exception
 		ErrorFlags flags(ErrorFlag_ThrowException, true);
@@ -60,21 +80,33 @@ namespace Nz
 
 	ParticleSystem::ParticleSystem(const ParticleSystem& system) :
 	Renderable(system),
+	m_gpuSimulator((system.m_gpuSimulator) ? std::make_unique<ParticleGpuSimulator>(*system.m_gpuSimulator) : nullptr),
 	m_controllers(system.m_controllers),
 	m_generators(system.m_generators),
 	m_declaration(system.m_declaration),
 	m_renderer(system.m_renderer),
+	m_particleBounds(system.m_particleBounds),
+	m_storage(system.m_storage),
+	m_simulationLOD(system.m_simulationLOD),
+	m_particleBoundsValid(system.m_particleBoundsValid),
 	m_processing(false),
+	m_simulationLODEnabled(system.m_simulationLODEnabled),
+	m_timeSinceUpdate(0.f),
+	m_projectedSize(std::numeric_limits<float>::infinity()),
 	m_maxParticleCount(system.m_maxParticleCount),
 	m_particleCount(system.m_particleCount),
+	m_particleLimit(system.m_particleLimit),
 	m_particleSize(system.m_particleSize)
 	{
 		ErrorFlags flags(ErrorFlag_ThrowException, true);
 
 		ResizeBuffer();
 
-		// We only copy alive particles
-		std::memcpy(m_buffer.data(), system.m_buffer.data(), system.m_particleCount*m_particleSize);
+		// We only copy alive particles, unless they are spread over the whole buffer
+		if (m_storage == ParticleStorage_Separate)
+			std::memcpy(m_buffer.data(), system.m_buffer.data(), m_buffer.size());
+		else
+			std::memcpy(m_buffer.data(), system.m_buffer.data(), system.m_particleCount*m_particleSize);
 	}
 
 	ParticleSystem::~ParticleSystem() = default;
@@ -130,19 +162,59 @@ namespace Nz
 	* \param renderQueue Queue to be added
 	* \param transformMatrix Transformation matrix for the system
 	*
+	* \remark With GPU simulation, the simulator draws the particles itself and the inner renderer is not used
+	* \remark With simulation LOD enabled, the projected size of the system is recorded for the next update, queues without viewer only mark it as visible
 	* \remark Produces a NazaraAssert if inner renderer is invalid
 	* \remark Produces a NazaraAssert if renderQueue is invalid
 	*/
 
 	void ParticleSystem::AddToRenderQueue(AbstractRenderQueue* renderQueue, const Matrix4f& transformMatrix) const
 	{
-		NazaraAssert(m_renderer, "Invalid particle renderer");
 		NazaraAssert(renderQueue, "Invalid renderqueue");
 		NazaraUnused(transformMatrix);
 
+		if (m_simulationLODEnabled)
+		{
+			float projectedSize = 0.f;
+			if (const AbstractViewer* viewer = renderQueue->GetViewer())
+			{
+				EnsureBoundingVolumeUpdated();
+
+				if (m_boundingVolume.IsFinite())
+				{
+					Spheref sphere = m_boundingVolume.aabb.GetBoundingSphere();
+					const Matrix4f& projectionMatrix = viewer->GetProjectionMatrix();
+
+					// Fraction of the viewport height covered by the bounding sphere
+					if (NumberEquals(projectionMatrix.m44, 1.f))
+						projectedSize = sphere.radius * projectionMatrix.m22;
+					else
+					{
+						float depth = viewer->GetForward().DotProduct(sphere.GetPosition() - viewer->GetEyePosition());
+						if (depth > sphere.radius)
+							projectedSize = sphere.radius * projectionMatrix.m22 / depth;
+						else
+							projectedSize = std::numeric_limits<float>::infinity();
+					}
+				}
+				else
+					projectedSize = std::numeric_limits<float>::infinity();
+			}
+
+			m_projectedSize = std::max(m_projectedSize, projectedSize);
+		}
+
+		if (m_gpuSimulator)
+		{
+			renderQueue->AddDrawable(0, m_gpuSimulator.get());
+			return;
+		}
+
+		NazaraAssert(m_renderer, "Invalid particle renderer");
+
 		if (m_particleCount > 0)
 		{
-			ParticleMapper mapper(m_buffer.data(), m_declaration);
+			ParticleMapper mapper = GetParticleMapper();
 			m_renderer->Render(*this, mapper, 0, m_particleCount - 1, renderQueue);
 		}
 	}
@@ -153,6 +225,9 @@ namespace Nz
 	* \param mapper Mapper containing layout information of each particle
 	* \param particleCount Number of particles
 	* \param elapsedTime Delta time between the previous frame
+	*
+	* \remark Parallelizable controllers are applied on disjoint ranges of particles by multiple threads at once, using the TaskScheduler
+	* \remark The other ones are applied on the whole range by the calling thread, in the order they were added
 	*/
 
 	void ParticleSystem::ApplyControllers(ParticleMapper& mapper, unsigned int particleCount, float elapsedTime)
@@ -165,8 +240,26 @@ namespace Nz
 			m_processing = false;
 		});
 
-		for (ParticleController* controller : m_controllers)
-			controller->Apply(*this, mapper, 0, particleCount - 1, elapsedTime);
+		std::size_t controllerIndex = 0;
+		while (controllerIndex < m_controllers.size())
+		{
+			std::size_t firstController = controllerIndex;
+			while (controllerIndex < m_controllers.size() && m_controllers[controllerIndex]->IsParallelizable())
+				controllerIndex++;
+
+			if (controllerIndex > firstController)
+			{
+				// Consecutive parallelizable controllers are applied one chunk after the other, a chunk stays in cache from one controller to the next
+				std::size_t lastController = controllerIndex;
+				TaskScheduler::ParallelFor(0, particleCount, 2048, [&] (std::size_t first, std::size_t last)
+				{
+					for (std::size_t i = firstController; i < lastController; ++i)
+						m_controllers[i]->Apply(*this, mapper, static_cast<unsigned int>(first), static_cast<unsigned int>(last - 1), elapsedTime);
+				});
+			}
+			else
+				m_controllers[controllerIndex++]->Apply(*this, mapper, 0, particleCount - 1, elapsedTime);
+		}
 
 		onExit.CallAndReset();
 
@@ -185,6 +278,23 @@ namespace Nz
 		m_dyingParticles.clear();
 	}
 
+	/*!
+	* \brief Culls the particle system if not in the frustum
+	* \return true If the particles are in the frustum
+	*
+	* \param frustum Symbolizing the field of view
+	* \param transformMatrix Matrix transformation for our object (unused, the particles being in world space)
+	*
+	* \remark Without simulation LOD, the bounding volume is infinite and the system is never culled
+	*/
+
+	bool ParticleSystem::Cull(const Frustumf& frustum, const Matrix4f& transformMatrix) const
+	{
+		EnsureBoundingVolumeUpdated();
+
+		return Renderable::Cull(frustum, transformMatrix);
+	}
+
 	/*!
 	* \brief Creates one particle
 	* \return Pointer to the particle memory buffer
@@ -198,6 +308,8 @@ namespace Nz
 	/*!
 	* \brief Creates multiple particles
 	* \return Pointer to the first particle memory buffer
+	*
+	* \remark With separate storage, the components of the particles are not next to each other and the pointer is only meant to be checked against nullptr, use GetParticleMapper to access them
 	*/
 
 	void* ParticleSystem::CreateParticles(unsigned int count)
@@ -205,13 +317,61 @@ namespace Nz
 		if (count == 0)
 			return nullptr;
 
-		if (m_particleCount + count > m_maxParticleCount)
+		if (m_particleCount + count > m_particleLimit)
 			return nullptr;
 
 		unsigned int particlesIndex = m_particleCount;
 		m_particleCount += count;
 
-		return &m_buffer[particlesIndex * m_particleSize];
+		if (m_storage == ParticleStorage_Separate)
+			return m_buffer.data();
+		else
+			return &m_buffer[particlesIndex * m_particleSize];
+	}
+
+	/*!
+	* \brief Enables the simulation of the particles by the GPU
+	*
+	* \param gpuSimulation Should the particles be simulated by the GPU
+	*
+	* \remark Once enabled, emitted particles are generated on the CPU then handed over to the simulator of GetGpuSimulator, controllers are not applied by Update anymore
+	* \remark The update then issues rendering commands and must happen on the thread owning the rendering context
+	*/
+
+	void ParticleSystem::EnableGpuSimulation(bool gpuSimulation)
+	{
+		if (gpuSimulation == IsGpuSimulationEnabled())
+			return;
+
+		if (gpuSimulation)
+			m_gpuSimulator = std::make_unique<ParticleGpuSimulator>(m_maxParticleCount);
+		else
+			m_gpuSimulator.reset();
+	}
+
+	/*!
+	* \brief Enables the level of detail of the simulation
+	*
+	* \param simulationLOD Should the simulation follow the visibility and the projected size of the system
+	*
+	* \remark Once enabled, the bounding volume of the system follows its particles, which are culled by it, and systems which were not rendered since the last update are frozen (or slowed down) before catching up once visible again
+	* \remark The smaller the system is on screen, the less often it is simulated and the less particles it emits
+	*
+	* \see SetSimulationLOD
+	*/
+
+	void ParticleSystem::EnableSimulationLOD(bool simulationLOD)
+	{
+		if (m_simulationLODEnabled == simulationLOD)
+			return;
+
+		m_simulationLODEnabled = simulationLOD;
+		m_particleBoundsValid = false;
+		m_particleLimit = m_maxParticleCount;
+		m_projectedSize = std::numeric_limits<float>::infinity();
+		m_timeSinceUpdate = 0.f;
+
+		InvalidateBoundingVolume();
 	}
 
 	/*!
@@ -231,11 +391,13 @@ namespace Nz
 
 	void* ParticleSystem::GenerateParticles(unsigned int count)
 	{
+		unsigned int firstParticle = m_particleCount;
+
 		void* ptr = CreateParticles(count);
 		if (!ptr)
 			return nullptr;
 
-		ParticleMapper mapper(ptr, m_declaration);
+		ParticleMapper mapper = GetParticleMapper(firstParticle);
 		for (ParticleGenerator* generator : m_generators)
 			generator->Generate(*this, mapper, 0, count - 1);
 
@@ -262,6 +424,16 @@ namespace Nz
 		return m_stepSize;
 	}
 
+	/*!
+	* \brief Gets the GPU simulator of the particles
+	* \return Pointer to the simulator, nullptr if the GPU simulation is not enabled
+	*/
+
+	ParticleGpuSimulator* ParticleSystem::GetGpuSimulator() const
+	{
+		return m_gpuSimulator.get();
+	}
+
 	/*!
 	* \brief Gets the maximum number of particles
 	* \return Current maximum number
@@ -282,6 +454,31 @@ namespace Nz
 		return m_particleCount;
 	}
 
+	/*!
+	* \brief Gets the number of particles the system can currently hold
+	* \return Maximum number of particles, lowered by the simulation LOD of small or culled systems
+	*/
+
+	unsigned int ParticleSystem::GetParticleLimit() const
+	{
+		return m_particleLimit;
+	}
+
+	/*!
+	* \brief Gets a mapper to the components of the particles
+	* \return Mapper whose first particle is the particle of index firstParticle
+	*
+	* \param firstParticle Index of the particle mapped as the first one
+	*/
+
+	ParticleMapper ParticleSystem::GetParticleMapper(unsigned int firstParticle) const
+	{
+		if (m_storage == ParticleStorage_Separate)
+			return ParticleMapper(m_buffer.data(), m_declaration, m_maxParticleCount, firstParticle);
+		else
+			return ParticleMapper(&m_buffer[firstParticle * m_particleSize], m_declaration);
+	}
+
 	/*!
 	* \brief Gets the size of particles
 	* \return Current size
@@ -292,6 +489,38 @@ namespace Nz
 		return m_particleSize;
 	}
 
+	/*!
+	* \brief Gets the largest projected size of the system since the last update
+	* \return Fraction of the viewport height covered by the system, negative if it wasn't rendered
+	*
+	* \remark Only tracked with simulation LOD enabled
+	*/
+
+	float ParticleSystem::GetProjectedSize() const
+	{
+		return m_projectedSize;
+	}
+
+	/*!
+	* \brief Gets the level of detail parameters of the simulation
+	* \return Simulation LOD parameters
+	*/
+
+	const ParticleSystemLOD& ParticleSystem::GetSimulationLOD() const
+	{
+		return m_simulationLOD;
+	}
+
+	/*!
+	* \brief Gets the way the components of the particles are laid out in memory
+	* \return Storage of the particles
+	*/
+
+	ParticleStorage ParticleSystem::GetStorage() const
+	{
+		return m_storage;
+	}
+
 	/*!
 	* \brief Checks whether the fixed step is enabled
 	* \return true If it is the case
@@ -302,6 +531,26 @@ namespace Nz
 		return m_fixedStepEnabled;
 	}
 
+	/*!
+	* \brief Checks whether the particles are simulated by the GPU
+	* \return true If it is the case
+	*/
+
+	bool ParticleSystem::IsGpuSimulationEnabled() const
+	{
+		return m_gpuSimulator != nullptr;
+	}
+
+	/*!
+	* \brief Checks whether the level of detail of the simulation is enabled
+	* \return true If it is the case
+	*/
+
+	bool ParticleSystem::IsSimulationLODEnabled() const
+	{
+		return m_simulationLODEnabled;
+	}
+
 	/*!
 	* \brief Kills one particle
 	*
@@ -315,13 +564,36 @@ namespace Nz
 		if (m_processing)
 		{
 			// The buffer is being modified, we can not reduce its size, we put the particle in the waiting list
+			// Controllers may run on multiple threads at once
+			LockGuard lock(m_dyingParticlesMutex);
 			m_dyingParticles.insert(index);
 			return;
 		}
 
 		// We move the last alive particle to the place of this one
 		if (--m_particleCount > 0)
-			std::memcpy(&m_buffer[index * m_particleSize], &m_buffer[m_particleCount * m_particleSize], m_particleSize);
+		{
+			if (m_storage == ParticleStorage_Separate)
+			{
+				for (unsigned int i = 0; i <= ParticleComponent_Max; ++i)
+				{
+					bool enabled;
+					ComponentType type;
+					unsigned int offset;
+					m_declaration->GetComponent(static_cast<ParticleComponent>(i), &enabled, &type, &offset);
+
+					if (enabled)
+					{
+						std::size_t componentStride = Utility::ComponentStride[type];
+						UInt8* componentPtr = &m_buffer[offset * m_maxParticleCount];
+
+						std::memcpy(&componentPtr[index * componentStride], &componentPtr[m_particleCount * componentStride], componentStride);
+					}
+				}
+			}
+			else
+				std::memcpy(&m_buffer[index * m_particleSize], &m_buffer[m_particleCount * m_particleSize], m_particleSize);
+		}
 	}
 
 	/*!
@@ -394,25 +666,83 @@ namespace Nz
 		m_renderer = renderer;
 	}
 
+	/*!
+	* \brief Sets the level of detail parameters of the simulation
+	*
+	* \param simulationLOD Simulation LOD parameters
+	*
+	* \remark Produces a NazaraAssert if the sizes, rates or factors are negative
+	*/
+
+	void ParticleSystem::SetSimulationLOD(const ParticleSystemLOD& simulationLOD)
+	{
+		NazaraAssert(simulationLOD.boundsMargin >= 0.f && simulationLOD.culledUpdateRate >= 0.f && simulationLOD.maxCatchUpTime >= 0.f, "Invalid simulation LOD");
+		NazaraAssert(simulationLOD.fullRateSize > 0.f && simulationLOD.minUpdateRate > 0.f, "Invalid simulation LOD");
+		NazaraAssert(simulationLOD.minEmissionFactor >= 0.f && simulationLOD.minEmissionFactor <= 1.f, "Invalid simulation LOD");
+
+		m_simulationLOD = simulationLOD;
+	}
+
 	/*!
 	* \brief Updates the system
 	*
 	* \param elapsedTime Delta time between the previous frame
+	*
+	* \remark With simulation LOD enabled, the update may be skipped, the time elapsed being simulated by a later update
 	*/
 
 	void ParticleSystem::Update(float elapsedTime)
 	{
-		// Emission
-		for (ParticleEmitter* emitter : m_emitters)
-			emitter->Emit(*this, elapsedTime);
+		if (!m_simulationLODEnabled)
+		{
+			Simulate(elapsedTime, 1.f);
+			return;
+		}
 
-		// Update
-		if (m_particleCount > 0)
+		float projectedSize = m_projectedSize;
+		m_projectedSize = -1.f;
+
+		m_timeSinceUpdate += elapsedTime;
+
+		// Culled systems are frozen (or slowed down), the smallest visible ones are simulated less often
+		float updateInterval = 0.f;
+		if (projectedSize < 0.f)
 		{
-			///TODO: Update using threads
-			ParticleMapper mapper(m_buffer.data(), m_declaration);
-			ApplyControllers(mapper, m_particleCount, elapsedTime);
+			if (m_simulationLOD.culledUpdateRate <= 0.f)
+			{
+				// Only the time which will be caught up is kept
+				m_timeSinceUpdate = std::min(m_timeSinceUpdate, m_simulationLOD.maxCatchUpTime);
+				return;
+			}
+
+			updateInterval = 1.f / m_simulationLOD.culledUpdateRate;
 		}
+		else if (projectedSize < m_simulationLOD.fullRateSize)
+			updateInterval = (1.f - projectedSize / m_simulationLOD.fullRateSize) / m_simulationLOD.minUpdateRate;
+
+		if (m_timeSinceUpdate < updateInterval)
+			return;
+
+		// The emission rate and the particle cap follow the projected size as well
+		float sizeFactor = Clamp(projectedSize / m_simulationLOD.fullRateSize, 0.f, 1.f);
+		float emissionFactor = Lerp(m_simulationLOD.minEmissionFactor, 1.f, sizeFactor);
+
+		m_particleLimit = static_cast<unsigned int>(std::ceil(m_maxParticleCount * emissionFactor));
+
+		// Skipped time is caught up by steps no longer than the ones of the smallest visible systems
+		float simulatedTime = std::min(m_timeSinceUpdate, m_simulationLOD.maxCatchUpTime);
+		float maxStep = 1.f / m_simulationLOD.minUpdateRate;
+		m_timeSinceUpdate = 0.f;
+
+		while (simulatedTime > 0.f)
+		{
+			float step = std::min(simulatedTime, maxStep);
+			Simulate(step, emissionFactor);
+
+			simulatedTime -= step;
+		}
+
+		UpdateParticleBounds();
 	}
 
 	/*!
@@ -443,23 +773,35 @@ namespace Nz
 
 		m_controllers = system.m_controllers;
 		m_declaration = system.m_declaration;
+		m_gpuSimulator = (system.m_gpuSimulator) ? std::make_unique<ParticleGpuSimulator>(*system.m_gpuSimulator) : nullptr;
 		m_generators = system.m_generators;
 		m_maxParticleCount = system.m_maxParticleCount;
+		m_particleBounds = system.m_particleBounds;
+		m_particleBoundsValid = system.m_particleBoundsValid;
 		m_particleCount = system.m_particleCount;
+		m_particleLimit = system.m_particleLimit;
 		m_particleSize = system.m_particleSize;
 		m_renderer = system.m_renderer;
+		m_simulationLOD = system.m_simulationLOD;
+		m_simulationLODEnabled = system.m_simulationLODEnabled;
 		m_stepSize = system.m_stepSize;
+		m_storage = system.m_storage;
 
 		// The copy can not (or should not) happen during the update, there is no use to copy
 		m_dyingParticles.clear();
 		m_processing = false;
+		m_projectedSize = std::numeric_limits<float>::infinity();
 		m_stepAccumulator = 0.f;
+		m_timeSinceUpdate = 0.f;
 
 		m_buffer.clear(); // To avoid a copy due to resize() which will be pointless
 		ResizeBuffer();
 
-		// We only copy alive particles
-		std::memcpy(m_buffer.data(), system.m_buffer.data(), system.m_particleCount * m_particleSize);
+		// We only copy alive particles, unless they are spread over the whole buffer
+		if (m_storage == ParticleStorage_Separate)
+			std::memcpy(m_buffer.data(), system.m_buffer.data(), m_buffer.size());
+		else
+			std::memcpy(m_buffer.data(), system.m_buffer.data(), system.m_particleCount * m_particleSize);
 
 		return *this;
 	}
@@ -470,8 +812,14 @@ namespace Nz
 
 	void ParticleSystem::MakeBoundingVolume() const
 	{
-		///TODO: Compute the AABB (taking into account the size of particles)
-		m_boundingVolume.MakeInfinite();
+		if (m_simulationLODEnabled && m_particleBoundsValid)
+		{
+			// The particles being in world space, so are their bounds
+			m_boundingVolume.Set(m_particleBounds);
+			m_boundingVolume.Update(Matrix4f::Identity());
+		}
+		else
+			m_boundingVolume.MakeInfinite();
 	}
 
 	/*!
@@ -495,4 +843,91 @@ namespace Nz
 			NazaraError(stream.ToString());
 		}
 	}
+
+	/*!
+	* \brief Simulates the system
+	*
+	* \param elapsedTime Time to simulate
+	* \param emissionFactor Factor applied to the emission of the emitters
+	*/
+
+	void ParticleSystem::Simulate(float elapsedTime, float emissionFactor)
+	{
+		// Emission
+		for (ParticleEmitter* emitter : m_emitters)
+			emitter->Emit(*this, elapsedTime * emissionFactor);
+
+		// Update
+		if (m_gpuSimulator)
+		{
+			// Particles only go through the CPU to be generated, the GPU takes care of them from then on
+			if (m_particleCount > 0)
+			{
+				m_gpuSimulator->Spawn(GetParticleMapper(), m_particleCount);
+				KillParticles();
+			}
+
+			m_gpuSimulator->Simulate(elapsedTime);
+		}
+		else if (m_particleCount > 0)
+		{
+			ParticleMapper mapper = GetParticleMapper();
+			ApplyControllers(mapper, m_particleCount, elapsedTime);
+		}
+	}
+
+	/*!
+	* \brief Computes the bounds of the particles for the simulation LOD
+	*
+	* \remark The previous bounds are kept while the system is empty, GPU simulated particles being out of reach their bounds stay infinite
+	*/
+
+	void ParticleSystem::UpdateParticleBounds()
+	{
+		if (m_gpuSimulator)
+		{
+			if (m_particleBoundsValid)
+			{
+				m_particleBoundsValid = false;
+				InvalidateBoundingVolume();
+			}
+
+			return;
+		}
+
+		if (m_particleCount == 0)
+			return;
+
+		ParticleMapper mapper = GetParticleMapper();
+
+		Vector3f minimum(std::numeric_limits<float>::infinity());
+		Vector3f maximum(-std::numeric_limits<float>::infinity());
+
+		if (SparsePtr<Vector3f> positionPtr = mapper.GetComponentPtr<Vector3f>(ParticleComponent_Position))
+		{
+			for (unsigned int i = 0; i < m_particleCount; ++i)
+			{
+				minimum.Minimize(positionPtr[i]);
+				maximum.Maximize(positionPtr[i]);
+			}
+		}
+		else if (SparsePtr<Vector2f> position2DPtr = mapper.GetComponentPtr<Vector2f>(ParticleComponent_Position))
+		{
+			for (unsigned int i = 0; i < m_particleCount; ++i)
+			{
+				minimum.Minimize(Vector3f(position2DPtr[i], 0.f));
+				maximum.Maximize(Vector3f(position2DPtr[i], 0.f));
+			}
+		}
+		else
+			return;
+
+		minimum -= Vector3f(m_simulationLOD.boundsMargin);
+		maximum += Vector3f(m_simulationLOD.boundsMargin);
+
+		m_particleBounds.Set(minimum, maximum);
+		m_particleBoundsValid = true;
+
+		InvalidateBoundingVolume();
+	}
 }
@@ -16,22 +16,19 @@ uniform mat4 InvViewProjMatrix;
 uniform vec2 InvTargetSize;
 uniform vec4 SceneAmbient;
 
-float ColorToFloat(vec3 color)
-{ 	
-	const vec3 byte_to_float = vec3(1.0, 1.0/256, 1.0/(256*256));
-	return dot(color, byte_to_float);
-}
-
-#define kPI 3.1415926536
-
-vec3 DecodeNormal(in vec4 encodedNormal)
+vec3 DecodeNormal(in vec3 encodedNormal)
 {
-	//return encodedNormal.xyz*2.0 - 1.0;	
-	float a = encodedNormal.x * kPI;
-    vec2 scth = vec2(sin(a), cos(a));
+	// Deux composantes de 12 bits réparties sur trois octets, puis projection octaédrique inverse
+	vec3 bytes = floor(encodedNormal*255.0 + 0.5);
+	float highX = floor(bytes.z / 16.0);
+	vec2 quantized = bytes.xy + vec2(highX, bytes.z - highX*16.0) * 256.0;
+	vec2 octahedral = quantized/4095.0 * 2.0 - 1.0;
+
+	vec3 normal = vec3(octahedral, 1.0 - abs(octahedral.x) - abs(octahedral.y));
+	if (normal.z < 0.0)
+		normal.xy = (1.0 - abs(normal.yx)) * vec2((normal.x >= 0.0) ? 1.0 : -1.0, (normal.y >= 0.0) ? 1.0 : -1.0);
 
-    vec2 scphi = vec2(sqrt(1.0 - encodedNormal.y*encodedNormal.y), encodedNormal.y);
-    return vec3(scth.y*scphi.x, scth.x*scphi.x, scphi.y);
+	return normalize(normal);
 }
 
 void main()
@@ -39,13 +36,12 @@ void main()
 	vec2 texCoord = gl_FragCoord.xy * InvTargetSize;
 	vec4 gVec0 = textureLod(GBuffer0, texCoord, 0.0);
 	vec4 gVec1 = textureLod(GBuffer1, texCoord, 0.0);
-	vec4 gVec2 = textureLod(GBuffer2, texCoord, 0.0);
 
 	vec3 diffuseColor = gVec0.xyz;
-	vec3 normal = DecodeNormal(gVec1);
+	vec3 normal = DecodeNormal(gVec1.xyz);
 	float specularMultiplier = gVec0.w;
-	float depth = ColorToFloat(gVec2.xyz);
-	float shininess = (gVec2.w == 0.0) ? 0.0 : exp2(gVec2.w*10.5);
+	float depth = textureLod(GBuffer2, texCoord, 0.0).x;
+	float shininess = (gVec1.w == 0.0) ? 0.0 : exp2(gVec1.w*10.5);
 
 	vec3 lightDir = -LightDirection.xyz;
 
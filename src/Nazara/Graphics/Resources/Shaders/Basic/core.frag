@@ -1,3 +1,7 @@
+#if BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #if EARLY_FRAGMENT_TESTS && !ALPHA_TEST
 layout(early_fragment_tests) in;
 #endif
@@ -5,16 +9,60 @@ layout(early_fragment_tests) in;
 /********************Entrant********************/
 in vec4 vColor;
 in vec2 vTexCoord;
+#if TEXTURE_ARRAY
+flat in float vTextureLayer;
+#endif
 
 /********************Sortant********************/
 out vec4 RenderTarget0;
 
 /********************Uniformes********************/
-uniform vec2 InvTargetSize;
-uniform sampler2D MaterialAlphaMap;
+layout(std140) uniform ViewParameters
+{
+	mat4 ProjMatrix;
+	mat4 InvProjMatrix;
+	mat4 ViewMatrix;
+	mat4 InvViewMatrix;
+	mat4 ViewProjMatrix;
+	mat4 InvViewProjMatrix;
+	vec3 EyePosition;
+	vec2 TargetSize;
+	vec2 InvTargetSize;
+};
+#if MATERIAL_UNIFORM_BUFFER
+layout(std140) uniform MaterialParameters
+{
+	vec4 MaterialAmbient;
+	vec4 MaterialDiffuse;
+	vec4 MaterialSpecular;
+	float MaterialAlphaThreshold;
+	float MaterialShininess;
+	#if BINDLESS_TEXTURES
+	vec2 MaterialPadding;
+	sampler2D MaterialAlphaMap;
+		#if TEXTURE_ARRAY
+	sampler2DArray MaterialDiffuseMap;
+		#else
+	sampler2D MaterialDiffuseMap;
+		#endif
+	sampler2D MaterialEmissiveMap;
+	sampler2D MaterialHeightMap;
+	sampler2D MaterialNormalMap;
+	sampler2D MaterialSpecularMap;
+	#endif
+};
+#else
 uniform float MaterialAlphaThreshold;
 uniform vec4 MaterialDiffuse;
+#endif
+#if !BINDLESS_TEXTURES
+uniform sampler2D MaterialAlphaMap;
+	#if TEXTURE_ARRAY
+uniform sampler2DArray MaterialDiffuseMap;
+	#else
 uniform sampler2D MaterialDiffuseMap;
+	#endif
+#endif
 uniform sampler2D TextureOverlay;
 
 /********************Fonctions********************/
@@ -29,7 +77,11 @@ void main()
 #endif
 
 #if DIFFUSE_MAPPING
+	#if TEXTURE_ARRAY
+	fragmentColor *= texture(MaterialDiffuseMap, vec3(texCoord, vTextureLayer));
+	#else
 	fragmentColor *= texture(MaterialDiffuseMap, texCoord);
+	#endif
 #endif
 
 #if ALPHA_MAPPING
@@ -37,7 +89,15 @@ void main()
 #endif
 
 #if FLAG_TEXTUREOVERLAY
+	#if DISTANCE_FIELD
+	// The overlay alpha holds a signed distance to the edge (0.5), antialiased over a screen pixel
+	vec4 overlay = texture(TextureOverlay, texCoord);
+	float edgeWidth = 0.7 * fwidth(overlay.a);
+	overlay.a = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, overlay.a);
+	fragmentColor *= overlay;
+	#else
 	fragmentColor *= texture(TextureOverlay, texCoord);
+	#endif
 #endif
 
 #if ALPHA_TEST
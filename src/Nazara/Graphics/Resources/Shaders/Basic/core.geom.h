@@ -0,0 +1 @@
+47,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,69,110,116,114,97,110,116,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,47,13,10,108,97,121,111,117,116,40,116,114,105,97,110,103,108,101,115,41,32,105,110,59,13,10,13,10,105,110,32,118,101,99,52,32,118,76,97,121,101,114,101,100,67,111,108,111,114,91,93,59,13,10,105,110,32,118,101,99,50,32,118,76,97,121,101,114,101,100,84,101,120,67,111,111,114,100,91,93,59,13,10,35,105,102,32,84,69,88,84,85,82,69,95,65,82,82,65,89,13,10,102,108,97,116,32,105,110,32,102,108,111,97,116,32,118,76,97,121,101,114,101,100,84,101,120,116,117,114,101,76,97,121,101,114,91,93,59,13,10,35,101,110,100,105,102,13,10,13,10,47,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,83,111,114,116,97,110,116,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,47,13,10,108,97,121,111,117,116,40,116,114,105,97,110,103,108,101,95,115,116,114,105,112,44,32,109,97,120,95,118,101,114,116,105,99,101,115,32,61,32,49,56,41,32,111,117,116,59,13,10,13,10,111,117,116,32,118,101,99,52,32,118,67,111,108,111,114,59,13,10,111,117,116,32,118,101,99,50,32,118,84,101,120,67,111,111,114,100,59,13,10,35,105,102,32,84,69,88,84,85,82,69,95,65,82,82,65,89,13,10,102,108,97,116,32,111,117,116,32,102,108,111,97,116,32,118,84,101,120,116,117,114,101,76,97,121,101,114,59,13,10,35,101,110,100,105,102,13,10,13,10,47,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,85,110,105,102,111,114,109,101,115,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,47,13,10,117,110,105,102,111,114,109,32,105,110,116,32,67,117,98,101,109,97,112,70,97,99,101,77,97,115,107,59,13,10,117,110,105,102,111,114,109,32,109,97,116,52,32,67,117,98,101,109,97,112,86,105,101,119,80,114,111,106,77,97,116,114,105,99,101,115,91,54,93,59,13,10,13,10,47,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,70,111,110,99,116,105,111,110,115,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,42,47,13,10,98,111,111,108,32,73,115,79,117,116,115,105,100,101,70,97,99,101,40,118,101,99,52,32,112,111,115,105,116,105,111,110,48,44,32,118,101,99,52,32,112,111,115,105,116,105,111,110,49,44,32,118,101,99,52,32,112,111,115,105,116,105,111,110,50,41,13,10,123,13,10,9,47,47,32,84,104,101,32,116,114,105,97,110,103,108,101,32,105,115,32,111,117,116,115,105,100,101,32,111,102,32,116,104,101,32,102,97,99,101,32,105,102,32,105,116,115,32,116,104,114,101,101,32,118,101,114,116,105,99,101,115,32,97,114,101,32,111,110,32,116,104,101,32,119,114,111,110,103,32,115,105,100,101,32,111,102,32,111,110,101,32,111,102,32,116,104,101,32,99,108,105,112,32,112,108,97,110,101,115,13,10,9,118,101,99,51,32,119,32,61,32,118,101,99,51,40,112,111,115,105,116,105,111,110,48,46,119,44,32,112,111,115,105,116,105,111,110,49,46,119,44,32,112,111,115,105,116,105,111,110,50,46,119,41,59,13,10,9,118,101,99,51,32,120,32,61,32,118,101,99,51,40,112,111,115,105,116,105,111,110,48,46,120,44,32,112,111,115,105,116,105,111,110,49,46,120,44,32,112,111,115,105,116,105,111,110,50,46,120,41,59,13,10,9,118,101,99,51,32,121,32,61,32,118,101,99,51,40,112,111,115,105,116,105,111,110,48,46,121,44,32,112,111,115,105,116,105,111,110,49,46,121,44,32,112,111,115,105,116,105,111,110,50,46,121,41,59,13,10,9,118,101,99,51,32,122,32,61,32,118,101,99,51,40,112,111,115,105,116,105,111,110,48,46,122,44,32,112,111,115,105,116,105,111,110,49,46,122,44,32,112,111,115,105,116,105,111,110,50,46,122,41,59,13,10,13,10,9,114,101,116,117,114,110,32,97,108,108,40,108,101,115,115,84,104,97,110,40,120,44,32,45,119,41,41,32,124,124,32,97,108,108,40,103,114,101,97,116,101,114,84,104,97,110,40,120,44,32,119,41,41,32,124,124,13,10,9,32,32,32,32,32,32,32,97,108,108,40,108,101,115,115,84,104,97,110,40,121,44,32,45,119,41,41,32,124,124,32,97,108,108,40,103,114,101,97,116,101,114,84,104,97,110,40,121,44,32,119,41,41,32,124,124,13,10,9,32,32,32,32,32,32,32,97,108,108,40,108,101,115,115,84,104,97,110,40,122,44,32,45,119,41,41,32,124,124,32,97,108,108,40,103,114,101,97,116,101,114,84,104,97,110,40,122,44,32,119,41,41,59,13,10,125,13,10,13,10,118,111,105,100,32,109,97,105,110,40,41,13,10,123,13,10,9,47,47,32,84,104,101,32,118,101,114,116,105,99,101,115,32,97,114,101,32,105,110,32,119,111,114,108,100,32,115,112,97,99,101,44,32,101,97,99,104,32,102,97,99,101,32,111,102,32,116,104,101,32,99,117,98,101,109,97,112,32,112,114,111,106,101,99,116,115,32,116,104,101,109,13,10,9,102,111,114,32,40,105,110,116,32,102,97,99,101,32,61,32,48,59,32,102,97,99,101,32,60,32,54,59,32,43,43,102,97,99,101,41,13,10,9,123,13,10,9,9,105,102,32,40,40,67,117,98,101,109,97,112,70,97,99,101,77,97,115,107,32,38,32,40,49,32,60,60,32,102,97,99,101,41,41,32,61,61,32,48,41,13,10,9,9,9,99,111,110,116,105,110,117,101,59,13,10,13,10,9,9,118,101,99,52,32,112,111,115,105,116,105,111,110,115,91,51,93,59,13,10,9,9,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,51,59,32,43,43,105,41,13,10,9,9,9,112,111,115,105,116,105,111,110,115,91,105,93,32,61,32,67,117,98,101,109,97,112,86,105,101,119,80,114,111,106,77,97,116,114,105,99,101,115,91,102,97,99,101,93,32,42,32,103,108,95,105,110,91,105,93,46,103,108,95,80,111,115,105,116,105,111,110,59,13,10,13,10,9,9,105,102,32,40,73,115,79,117,116,115,105,100,101,70,97,99,101,40,112,111,115,105,116,105,111,110,115,91,48,93,44,32,112,111,115,105,116,105,111,110,115,91,49,93,44,32,112,111,115,105,116,105,111,110,115,91,50,93,41,41,13,10,9,9,9,99,111,110,116,105,110,117,101,59,13,10,13,10,9,9,102,111,114,32,40,105,110,116,32,105,32,61,32,48,59,32,105,32,60,32,51,59,32,43,43,105,41,13,10,9,9,123,13,10,9,9,9,103,108,95,76,97,121,101,114,32,61,32,102,97,99,101,59,13,10,9,9,9,103,108,95,80,111,115,105,116,105,111,110,32,61,32,112,111,115,105,116,105,111,110,115,91,105,93,59,13,10,13,10,9,9,9,118,67,111,108,111,114,32,61,32,118,76,97,121,101,114,101,100,67,111,108,111,114,91,105,93,59,13,10,9,9,9,118,84,101,120,67,111,111,114,100,32,61,32,118,76,97,121,101,114,101,100,84,101,120,67,111,111,114,100,91,105,93,59,13,10,35,105,102,32,84,69,88,84,85,82,69,95,65,82,82,65,89,13,10,9,9,9,118,84,101,120,116,117,114,101,76,97,121,101,114,32,61,32,118,76,97,121,101,114,101,100,84,101,120,116,117,114,101,76,97,121,101,114,91,105,93,59,13,10,35,101,110,100,105,102,13,10,13,10,9,9,9,69,109,105,116,86,101,114,116,101,120,40,41,59,13,10,9,9,125,13,10,13,10,9,9,69,110,100,80,114,105,109,105,116,105,118,101,40,41,59,13,10,9,125,13,10,125,13,10,
\ No newline at end of file
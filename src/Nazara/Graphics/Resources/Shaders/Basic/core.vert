@@ -12,19 +12,91 @@ in vec3 VertexPosition;
 in vec2 VertexTexCoord;
 in vec4 VertexUserdata0;
 
+#if FLAG_SKINNING
+in ivec4 VertexUserdata1;
+#endif
+
 /********************Sortant********************/
+#if FLAG_CUBEMAPLAYERED
+// Relayed to the fragment shader by the geometry shader
+#define vColor vLayeredColor
+#define vTexCoord vLayeredTexCoord
+#define vTextureLayer vLayeredTextureLayer
+#endif
+
 out vec4 vColor;
 out vec2 vTexCoord;
+#if TEXTURE_ARRAY
+flat out float vTextureLayer;
+#endif
 
 /********************Uniformes********************/
+layout(std140) uniform ViewParameters
+{
+	mat4 ProjMatrix;
+	mat4 InvProjMatrix;
+	mat4 ViewMatrix;
+	mat4 InvViewMatrix;
+	mat4 ViewProjMatrix;
+	mat4 InvViewProjMatrix;
+	vec3 EyePosition;
+	vec2 TargetSize;
+	vec2 InvTargetSize;
+};
 uniform float VertexDepth;
-uniform mat4 ViewMatrix;
-uniform mat4 ViewProjMatrix;
+uniform mat4 WorldMatrix;
 uniform mat4 WorldViewProjMatrix;
+#if FLAG_SKINNING
+uniform sampler2D SkinningMatrices;
+#endif
+#if FLAG_BILLBOARD && FLAG_VERTEXPULLING
+uniform sampler2D BillboardData;
+#endif
 
 /********************Fonctions********************/
+#if FLAG_BILLBOARD && FLAG_VERTEXPULLING
+// Corners of the two triangles of a billboard, in the order of the quad index buffer
+const vec2 BillboardCorners[6] = vec2[6](vec2(-0.5, 0.5), vec2(-0.5, -0.5), vec2(0.5, 0.5),
+                                         vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5));
+#endif
+
+vec4 ProjectWorldPosition(vec3 worldPosition)
+{
+#if FLAG_CUBEMAPLAYERED
+	return vec4(worldPosition, 1.0); // Projected on each face by the geometry shader
+#else
+	return ViewProjMatrix * vec4(worldPosition, 1.0);
+#endif
+}
+
+#if FLAG_SKINNING
+mat4 GetSkinningMatrix()
+{
+	// Each joint matrix is stored in a row of four texels, unused weights are zero
+	mat4 skinningMatrix = mat4(0.0);
+	for (int i = 0; i < 4; ++i)
+	{
+		int joint = VertexUserdata1[i];
+		mat4 jointMatrix = mat4(texelFetch(SkinningMatrices, ivec2(0, joint), 0),
+		                        texelFetch(SkinningMatrices, ivec2(1, joint), 0),
+		                        texelFetch(SkinningMatrices, ivec2(2, joint), 0),
+		                        texelFetch(SkinningMatrices, ivec2(3, joint), 0));
+
+		skinningMatrix += VertexUserdata0[i] * jointMatrix;
+	}
+
+	return skinningMatrix;
+}
+#endif
+
 void main()
 {
+#if FLAG_SKINNING
+	vec3 vertexPosition = vec3(GetSkinningMatrix() * vec4(VertexPosition, 1.0));
+#else
+	vec3 vertexPosition = VertexPosition;
+#endif
+
 #if FLAG_VERTEXCOLOR
 	vec4 color = VertexColor;
 #else
@@ -34,24 +106,48 @@ void main()
 	vec2 texCoords;
 
 #if FLAG_BILLBOARD
-	#if FLAG_INSTANCING
+	#if FLAG_VERTEXPULLING
+	// Each billboard is stored in a row of three texels and expanded into six vertices
+	int billboardIndex = gl_VertexID / 6;
+	vec4 billboardData0 = texelFetch(BillboardData, ivec2(0, billboardIndex), 0);
+	vec4 billboardData1 = texelFetch(BillboardData, ivec2(1, billboardIndex), 0);
+	vec4 billboardColor = texelFetch(BillboardData, ivec2(2, billboardIndex), 0);
+
+	vec2 billboardCorner = BillboardCorners[gl_VertexID % 6];
+	vec3 billboardCenter = billboardData0.xyz;
+	vec2 billboardSize = billboardData1.xy;
+	vec2 billboardSinCos = billboardData1.zw;
+
+	vec2 rotatedPosition;
+	rotatedPosition.x = billboardCorner.x*billboardSinCos.y - billboardCorner.y*billboardSinCos.x;
+	rotatedPosition.y = billboardCorner.y*billboardSinCos.y + billboardCorner.x*billboardSinCos.x;
+	rotatedPosition *= billboardSize;
+
+	vec3 cameraRight = vec3(ViewMatrix[0][0], ViewMatrix[1][0], ViewMatrix[2][0]);
+	vec3 cameraUp = vec3(ViewMatrix[0][1], ViewMatrix[1][1], ViewMatrix[2][1]);
+	vec3 vertexPos = billboardCenter + cameraRight*rotatedPosition.x + cameraUp*rotatedPosition.y;
+
+	gl_Position = ProjectWorldPosition(vertexPos);
+	color = billboardColor;
+	texCoords = billboardCorner + 0.5;
+	#elif FLAG_INSTANCING
 	vec3 billboardCenter = InstanceData0;
 	vec2 billboardSize = InstanceData1.xy;
 	vec2 billboardSinCos = InstanceData1.zw;
 	vec4 billboardColor = InstanceData2;
 
 	vec2 rotatedPosition;
-	rotatedPosition.x = VertexPosition.x*billboardSinCos.y - VertexPosition.y*billboardSinCos.x;
-	rotatedPosition.y = VertexPosition.y*billboardSinCos.y + VertexPosition.x*billboardSinCos.x;
+	rotatedPosition.x = vertexPosition.x*billboardSinCos.y - vertexPosition.y*billboardSinCos.x;
+	rotatedPosition.y = vertexPosition.y*billboardSinCos.y + vertexPosition.x*billboardSinCos.x;
 	rotatedPosition *= billboardSize;
 
 	vec3 cameraRight = vec3(ViewMatrix[0][0], ViewMatrix[1][0], ViewMatrix[2][0]);
 	vec3 cameraUp = vec3(ViewMatrix[0][1], ViewMatrix[1][1], ViewMatrix[2][1]);
 	vec3 vertexPos = billboardCenter + cameraRight*rotatedPosition.x + cameraUp*rotatedPosition.y;
 
-	gl_Position = ViewProjMatrix * vec4(vertexPos, 1.0);
+	gl_Position = ProjectWorldPosition(vertexPos);
 	color = billboardColor;
-	texCoords = VertexPosition.xy + 0.5;
+	texCoords = vertexPosition.xy + 0.5;
 	#else
 	vec2 billboardCorner = VertexTexCoord - 0.5;
 	vec2 billboardSize = VertexUserdata0.xy;
@@ -64,31 +160,33 @@ void main()
 
 	vec3 cameraRight = vec3(ViewMatrix[0][0], ViewMatrix[1][0], ViewMatrix[2][0]);
 	vec3 cameraUp = vec3(ViewMatrix[0][1], ViewMatrix[1][1], ViewMatrix[2][1]);
-	vec3 vertexPos = VertexPosition + cameraRight*rotatedPosition.x + cameraUp*rotatedPosition.y;
+	vec3 vertexPos = vertexPosition + cameraRight*rotatedPosition.x + cameraUp*rotatedPosition.y;
 
-	gl_Position = ViewProjMatrix * vec4(vertexPos, 1.0);
+	gl_Position = ProjectWorldPosition(vertexPos);
 	texCoords = VertexTexCoord;
 	#endif
 	texCoords.y = 1.0 - texCoords.y;
 #else
 	#if FLAG_INSTANCING
 		#if TRANSFORM
-	gl_Position = ViewProjMatrix * InstanceData0 * vec4(VertexPosition, 1.0);
+	gl_Position = ProjectWorldPosition(vec3(InstanceData0 * vec4(vertexPosition, 1.0)));
 		#else
 			#if UNIFORM_VERTEX_DEPTH
-	gl_Position = InstanceData0 * vec4(VertexPosition.xy, VertexDepth, 1.0);
+	gl_Position = InstanceData0 * vec4(vertexPosition.xy, VertexDepth, 1.0);
 			#else
-	gl_Position = InstanceData0 * vec4(VertexPosition, 1.0);
+	gl_Position = InstanceData0 * vec4(vertexPosition, 1.0);
 			#endif
 		#endif
 	#else
-		#if TRANSFORM
-	gl_Position = WorldViewProjMatrix * vec4(VertexPosition, 1.0);
+		#if TRANSFORM && FLAG_CUBEMAPLAYERED
+	gl_Position = WorldMatrix * vec4(vertexPosition, 1.0);
+		#elif TRANSFORM
+	gl_Position = WorldViewProjMatrix * vec4(vertexPosition, 1.0);
 		#else
 			#if UNIFORM_VERTEX_DEPTH
-	gl_Position = vec4(VertexPosition.xy, VertexDepth, 1.0);
+	gl_Position = vec4(vertexPosition.xy, VertexDepth, 1.0);
 			#else
-	gl_Position = vec4(VertexPosition, 1.0);
+	gl_Position = vec4(vertexPosition, 1.0);
 			#endif
 		#endif
 	#endif
@@ -100,4 +198,12 @@ void main()
 #if TEXTURE_MAPPING
 	vTexCoord = vec2(texCoords);
 #endif
+
+#if TEXTURE_ARRAY
+	#if FLAG_BILLBOARD || FLAG_SKINNING
+	vTextureLayer = 0.0;
+	#else
+	vTextureLayer = VertexUserdata0.x; // Layer of the sprite (zero for the meshes, which have no such attribute)
+	#endif
+#endif
 }
@@ -1,3 +1,7 @@
+#if BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture : require
+#endif
+
 #if EARLY_FRAGMENT_TESTS && !ALPHA_TEST
 layout(early_fragment_tests) in;
 #endif
@@ -12,6 +16,9 @@ in vec4 vLightSpacePos[3];
 in mat3 vLightToWorld;
 in vec3 vNormal;
 in vec2 vTexCoord;
+#if TEXTURE_ARRAY
+flat in float vTextureLayer;
+#endif
 in vec3 vViewDir;
 in vec3 vWorldPos;
 
@@ -21,6 +28,19 @@ out vec4 RenderTarget1;
 out vec4 RenderTarget2;
 
 /********************Uniformes********************/
+layout(std140) uniform ViewParameters
+{
+	mat4 ProjMatrix;
+	mat4 InvProjMatrix;
+	mat4 ViewMatrix;
+	mat4 InvViewMatrix;
+	mat4 ViewProjMatrix;
+	mat4 InvViewProjMatrix;
+	vec3 EyePosition;
+	vec2 TargetSize;
+	vec2 InvTargetSize;
+};
+
 struct Light
 {
 	int type;
@@ -37,25 +57,66 @@ struct Light
 uniform Light Lights[3];
 uniform samplerCube PointLightShadowMap[3];
 uniform sampler2D DirectionalSpotLightShadowMap[3];
+uniform mat4 LightCascadeMatrix[12]; // Quatre cascades par lumière directionnelle, côte à côte dans sa shadow map
+
+#if FLAG_CLUSTEREDLIGHTING
+// Lumières sans ombres, rangées par cellule de la pyramide de vue
+uniform bool ClusterLightsEnabled;
+uniform ivec3 ClusterCount;
+uniform vec3 ClusterDepthAxis;
+uniform sampler2D ClusterGrid;         // Par cellule : (premier indice, nombre de lumières)
+uniform sampler2D ClusterLightIndices; // Indices des lumières, à la suite
+uniform sampler2D ClusterLights;       // Quatre texels par lumière
+uniform vec2 ClusterSlicing;           // log(profondeur) * x + y donne la tranche
+uniform vec4 ClusterTiles;             // Origine du viewport et inverse de la taille d'une tuile
+#endif
 
 // Matériau
-uniform sampler2D MaterialAlphaMap;
+#if MATERIAL_UNIFORM_BUFFER
+layout(std140) uniform MaterialParameters
+{
+	vec4 MaterialAmbient;
+	vec4 MaterialDiffuse;
+	vec4 MaterialSpecular;
+	float MaterialAlphaThreshold;
+	float MaterialShininess;
+	#if BINDLESS_TEXTURES
+	vec2 MaterialPadding;           // Les handles sont alignés sur 8 octets, à la suite du bloc de base
+	sampler2D MaterialAlphaMap;
+		#if TEXTURE_ARRAY
+	sampler2DArray MaterialDiffuseMap;
+		#else
+	sampler2D MaterialDiffuseMap;
+		#endif
+	sampler2D MaterialEmissiveMap;
+	sampler2D MaterialHeightMap;
+	sampler2D MaterialNormalMap;
+	sampler2D MaterialSpecularMap;
+	#endif
+};
+#else
 uniform float MaterialAlphaThreshold;
 uniform vec4 MaterialAmbient;
 uniform vec4 MaterialDiffuse;
+uniform float MaterialShininess;
+uniform vec4 MaterialSpecular;
+#endif
+#if !BINDLESS_TEXTURES
+uniform sampler2D MaterialAlphaMap;
+	#if TEXTURE_ARRAY
+uniform sampler2DArray MaterialDiffuseMap;
+	#else
 uniform sampler2D MaterialDiffuseMap;
+	#endif
 uniform sampler2D MaterialEmissiveMap;
 uniform sampler2D MaterialHeightMap;
 uniform sampler2D MaterialNormalMap;
-uniform float MaterialShininess;
-uniform vec4 MaterialSpecular;
 uniform sampler2D MaterialSpecularMap;
+#endif
 
 // Autres
 uniform float ParallaxBias = -0.03;
 uniform float ParallaxScale = 0.02;
-uniform vec2 InvTargetSize;
-uniform vec3 EyePosition;
 uniform vec4 SceneAmbient;
 
 uniform sampler2D TextureOverlay;
@@ -79,10 +140,18 @@ vec3 FloatToColor(float f)
 
 #define kPI 3.1415926536
 
-vec4 EncodeNormal(in vec3 normal)
+vec3 EncodeNormal(in vec3 normal)
 {
-	//return vec4(normal*0.5 + 0.5, 0.0);
-	return vec4(vec2(atan(normal.y, normal.x)/kPI, normal.z), 0.0, 0.0);
+	// Projection octaédrique, puis deux composantes de 12 bits réparties sur trois octets
+	vec2 octahedral = normal.xy / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+	if (normal.z < 0.0)
+		octahedral = (1.0 - abs(octahedral.yx)) * vec2((octahedral.x >= 0.0) ? 1.0 : -1.0, (octahedral.y >= 0.0) ? 1.0 : -1.0);
+
+	vec2 quantized = floor((octahedral*0.5 + 0.5) * 4095.0 + 0.5);
+	vec2 high = floor(quantized / 256.0);
+	vec2 low = quantized - high*256.0;
+
+	return vec3(low, high.x*16.0 + high.y) / 255.0;
 }
 
 float VectorToDepthValue(vec3 vec, float zNear, float zFar)
@@ -97,7 +166,29 @@ float VectorToDepthValue(vec3 vec, float zNear, float zFar)
 #if SHADOW_MAPPING
 float CalculateDirectionalShadowFactor(int lightIndex)
 {
-	vec4 lightSpacePos = vLightSpacePos[lightIndex];
+	vec4 lightSpacePos;
+
+	// parameters2 : profondeur de fin de chaque cascade, parameters3.x : nombre de cascades
+	int cascadeCount = int(Lights[lightIndex].parameters3.x);
+	if (cascadeCount > 0)
+	{
+		float depth = -(ViewMatrix * vec4(vWorldPos, 1.0)).z;
+
+		int cascade = cascadeCount - 1;
+		for (int i = 0; i < cascadeCount - 1; ++i)
+		{
+			if (depth < Lights[lightIndex].parameters2[i])
+			{
+				cascade = i;
+				break;
+			}
+		}
+
+		lightSpacePos = LightCascadeMatrix[lightIndex*4 + cascade] * vec4(vWorldPos, 1.0);
+	}
+	else
+		lightSpacePos = vLightSpacePos[lightIndex];
+
 	return (texture(DirectionalSpotLightShadowMap[lightIndex], lightSpacePos.xy).x >= (lightSpacePos.z - 0.0005)) ? 1.0 : 0.0;
 }
 
@@ -141,11 +232,23 @@ void main()
 #endif
 
 #if DIFFUSE_MAPPING
+	#if TEXTURE_ARRAY
+	diffuseColor *= texture(MaterialDiffuseMap, vec3(texCoord, vTextureLayer));
+	#else
 	diffuseColor *= texture(MaterialDiffuseMap, texCoord);
+	#endif
 #endif
 
 #if FLAG_TEXTUREOVERLAY
+	#if DISTANCE_FIELD
+	// The overlay alpha holds a signed distance to the edge (0.5), antialiased over a screen pixel
+	vec4 overlay = texture(TextureOverlay, texCoord);
+	float edgeWidth = 0.7 * fwidth(overlay.a);
+	overlay.a = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, overlay.a);
+	diffuseColor *= overlay;
+	#else
 	diffuseColor *= texture(TextureOverlay, texCoord);
+	#endif
 #endif
 
 #if FLAG_DEFERRED
@@ -173,12 +276,11 @@ void main()
 
 	/*
 	Texture0: Diffuse Color + Specular
-	Texture1: Normal + Specular
-	Texture2: Encoded depth + Shininess
+	Texture1: Encoded normal + Shininess
+	Texture2: Depth (lue depuis le depth buffer)
 	*/
 	RenderTarget0 = vec4(diffuseColor.rgb, dot(specularColor, vec3(0.3, 0.59, 0.11)));
-	RenderTarget1 = vec4(EncodeNormal(normal));
-	RenderTarget2 = vec4(FloatToColor(gl_FragCoord.z), (MaterialShininess == 0.0) ? 0.0 : max(log2(MaterialShininess), 0.1)/10.5); // http://www.guerrilla-games.com/publications/dr_kz2_rsx_dev07.pdf
+	RenderTarget1 = vec4(EncodeNormal(normal), (MaterialShininess == 0.0) ? 0.0 : max(log2(MaterialShininess), 0.1)/10.5); // http://www.guerrilla-games.com/publications/dr_kz2_rsx_dev07.pdf
 	#else // LIGHTING
 	RenderTarget0 = vec4(diffuseColor.rgb, 0.0);
 	#endif
@@ -458,6 +560,64 @@ void main()
 		}
 	}
 	
+		#if FLAG_CLUSTEREDLIGHTING
+	if (ClusterLightsEnabled)
+	{
+		vec3 eyeVec = normalize(EyePosition - vWorldPos);
+
+		ivec2 tile = ivec2((gl_FragCoord.xy - ClusterTiles.xy) * ClusterTiles.zw);
+		float depth = max(dot(vWorldPos - EyePosition, ClusterDepthAxis), 0.0001);
+		int slice = int(log(depth) * ClusterSlicing.x + ClusterSlicing.y);
+		ivec3 cluster = clamp(ivec3(tile, slice), ivec3(0), ClusterCount - ivec3(1));
+
+		vec2 clusterData = texelFetch(ClusterGrid, ivec2(cluster.x + cluster.y * ClusterCount.x, cluster.z), 0).xy;
+		int firstIndex = int(clusterData.x);
+		int clusterLightCount = int(clusterData.y);
+		int indexWidth = textureSize(ClusterLightIndices, 0).x;
+
+		for (int i = 0; i < clusterLightCount; ++i)
+		{
+			int index = firstIndex + i;
+			int lightIndex = int(texelFetch(ClusterLightIndices, ivec2(index % indexWidth, index / indexWidth), 0).x);
+
+			vec4 colorType = texelFetch(ClusterLights, ivec2(0, lightIndex), 0);
+			vec4 positionAttenuation = texelFetch(ClusterLights, ivec2(1, lightIndex), 0);
+			vec4 directionInvRadius = texelFetch(ClusterLights, ivec2(2, lightIndex), 0);
+			vec4 factorsAngles = texelFetch(ClusterLights, ivec2(3, lightIndex), 0);
+
+			vec3 worldToLight = positionAttenuation.xyz - vWorldPos;
+			float lightDistance = length(worldToLight);
+			worldToLight /= lightDistance; // Normalisation
+
+			float att = max(positionAttenuation.w - directionInvRadius.w * lightDistance, 0.0);
+
+			// Ambient
+			lightAmbient += att * colorType.rgb * factorsAngles.x * (MaterialAmbient.rgb + SceneAmbient.rgb);
+
+			if (int(colorType.w) == LIGHT_SPOT)
+			{
+				float curAngle = dot(directionInvRadius.xyz, -worldToLight);
+				att *= max((curAngle - factorsAngles.w) / (factorsAngles.z - factorsAngles.w), 0.0);
+			}
+
+			// Diffuse
+			float lambert = max(dot(normal, worldToLight), 0.0);
+
+			lightDiffuse += att * lambert * colorType.rgb * factorsAngles.y;
+
+			// Specular
+			if (MaterialShininess > 0.0)
+			{
+				vec3 reflection = reflect(-worldToLight, normal);
+				float specularFactor = max(dot(reflection, eyeVec), 0.0);
+				specularFactor = pow(specularFactor, MaterialShininess);
+
+				lightSpecular += att * specularFactor * colorType.rgb;
+			}
+		}
+	}
+		#endif // FLAG_CLUSTEREDLIGHTING
+
 	lightSpecular *= MaterialSpecular.rgb;
 		#if SPECULAR_MAPPING
 	lightSpecular *= texture(MaterialSpecularMap, texCoord).rgb; // Utiliser l'alpha de MaterialSpecular n'aurait aucun sens
@@ -3,17 +3,38 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Graphics/SkeletalModel.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Graphics/SkinningManager.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Renderer/UberShader.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		bool IsSkinnedByShader(const Material* material)
+		{
+			if (!material->GetShader()->HasFlag("FLAG_SKINNING"))
+				return false;
+
+			// Depth passes use their own material, which must be able to skin the mesh as well
+			if (material->HasDepthMaterial() && !material->GetDepthMaterial()->GetShader()->HasFlag("FLAG_SKINNING"))
+				return false;
+
+			return true;
+		}
+	}
+
 	/*!
 	* \ingroup graphics
 	* \class Nz::SkeletalModel
@@ -42,7 +63,11 @@ namespace Nz
 
 	SkeletalModel::SkeletalModel() :
 	m_currentSequence(nullptr),
-	m_animationEnabled(true)
+	m_animationEnabled(true),
+	m_animationLODEnabled(false),
+	m_interpolation(0.f),
+	m_timeSinceUpdate(0.f),
+	m_projectedSize(std::numeric_limits<float>::infinity())
 	{
 	}
 
@@ -51,6 +76,8 @@ namespace Nz
 	*
 	* \param renderQueue Queue to be added
 	* \param instanceData Data for the instance
+	*
+	* \remark With animation LOD enabled, the projected size of the model is recorded for the next animation update, queues without viewer (such as shadow map ones) only mark it as visible
 	*/
 
 	void SkeletalModel::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
@@ -58,6 +85,41 @@ namespace Nz
 		if (!m_mesh)
 			return;
 
+		const Skeleton* skeleton = GetRenderSkeleton();
+
+		if (m_animationLODEnabled)
+		{
+			float projectedSize = 0.f;
+			if (const AbstractViewer* viewer = renderQueue->GetViewer())
+			{
+				Boxf aabb = skeleton->GetAABB();
+				if (instanceData.volume.IsFinite())
+					aabb = instanceData.volume.aabb;
+				else
+					aabb.Transform(*instanceData.transformMatrix);
+
+				Spheref sphere = aabb.GetBoundingSphere();
+				const Matrix4f& projectionMatrix = viewer->GetProjectionMatrix();
+
+				// Fraction of the viewport height covered by the bounding sphere
+				if (NumberEquals(projectionMatrix.m44, 1.f))
+					projectedSize = sphere.radius * projectionMatrix.m22;
+				else
+				{
+					float depth = viewer->GetForward().DotProduct(sphere.GetPosition() - viewer->GetEyePosition());
+					if (depth > sphere.radius)
+						projectedSize = sphere.radius * projectionMatrix.m22 / depth;
+					else
+						projectedSize = std::numeric_limits<float>::infinity();
+				}
+			}
+
+			m_projectedSize = std::max(m_projectedSize, projectedSize);
+		}
+
+		// Joints are read from a texture when skinning on the GPU, one row per joint
+		bool gpuSkinning = SkinningManager::IsGpuSkinningSupported() && skeleton->GetJointCount() <= Renderer::GetMaxTextureSize();
+
 		unsigned int submeshCount = m_mesh->GetSubMeshCount();
 		for (unsigned int i = 0; i < submeshCount; ++i)
 		{
@@ -67,9 +129,20 @@ namespace Nz
 			MeshData meshData;
 			meshData.indexBuffer = mesh->GetIndexBuffer();
 			meshData.primitiveMode = mesh->GetPrimitiveMode();
-			meshData.vertexBuffer = SkinningManager::GetBuffer(mesh, &m_skeleton);
 
-			renderQueue->AddMesh(instanceData.renderOrder, material, meshData, m_skeleton.GetAABB(), *instanceData.transformMatrix);
+			if (gpuSkinning && IsSkinnedByShader(material))
+			{
+				meshData.skeleton = skeleton;
+				meshData.vertexBuffer = mesh->GetVertexBuffer();
+			}
+			else
+			{
+				// Custom shaders don't know how to skin vertices, do it on the CPU instead
+				meshData.skeleton = nullptr;
+				meshData.vertexBuffer = SkinningManager::GetBuffer(mesh, skeleton);
+			}
+
+			renderQueue->AddMesh(instanceData.renderOrder, material, meshData, skeleton->GetAABB(), *instanceData.transformMatrix);
 		}
 	}
 
@@ -78,6 +151,7 @@ namespace Nz
 	*
 	* \param elapsedTime Delta time between two frames
 	*
+	* \remark With animation LOD enabled, the skeleton may be updated less often, partially, or replaced by a pose shared with other models, depending on the projected size recorded since the last call
 	* \remark Produces a NazaraError with NAZARA_GRAPHICS_SAFE defined if there is no animation
 	*/
 
@@ -117,6 +191,45 @@ namespace Nz
 			}
 		}
 
+		if (m_animationLODEnabled)
+		{
+			float projectedSize = m_projectedSize;
+			m_projectedSize = -1.f;
+
+			m_timeSinceUpdate += elapsedTime;
+
+			// Culled models keep their pose, and thus their skinned vertices, until they are rendered again
+			if (projectedSize < 0.f && m_animationLOD.skipCulled)
+				return;
+
+			if (projectedSize < m_animationLOD.fullRateSize)
+			{
+				float updateInterval = (1.f - std::max(projectedSize, 0.f) / m_animationLOD.fullRateSize) / m_animationLOD.minUpdateRate;
+				if (m_timeSinceUpdate < updateInterval)
+					return;
+			}
+
+			m_timeSinceUpdate = 0.f;
+
+			if (projectedSize < m_animationLOD.sharedPoseSize)
+			{
+				UseSharedPose();
+				InvalidateBoundingVolume();
+				return;
+			}
+
+			// Our own skeleton wasn't animated while the pose was shared, every joint has to be updated
+			bool wasShared = m_sharedPose.IsValid();
+			ReleaseSharedPose();
+
+			if (!wasShared && projectedSize < m_animationLOD.reducedJointSize && !m_reducedJoints.empty())
+			{
+				m_animation->AnimateSkeleton(&m_skeleton, m_currentFrame, m_nextFrame, m_interpolation, m_reducedJoints.data(), static_cast<unsigned int>(m_reducedJoints.size()));
+				InvalidateBoundingVolume();
+				return;
+			}
+		}
+
 		m_animation->AnimateSkeleton(&m_skeleton, m_currentFrame, m_nextFrame, m_interpolation);
 
 		InvalidateBoundingVolume();
@@ -153,6 +266,29 @@ namespace Nz
 		m_animationEnabled = animation;
 	}
 
+	/*!
+	* \brief Enables the level of detail of the animation
+	*
+	* \param animationLOD Should the animation be updated according to the projected size of the model
+	*
+	* \remark Disabling it makes the model use its own skeleton again, on the next animation update
+	*
+	* \see SetAnimationLOD
+	*/
+
+	void SkeletalModel::EnableAnimationLOD(bool animationLOD)
+	{
+		m_animationLODEnabled = animationLOD;
+		m_projectedSize = std::numeric_limits<float>::infinity();
+		m_timeSinceUpdate = 0.f;
+
+		if (!m_animationLODEnabled && m_sharedPose)
+		{
+			ReleaseSharedPose();
+			InvalidateBoundingVolume();
+		}
+	}
+
 	/*!
 	* \brief Gets the animation of the model
 	* \return Pointer to the animation
@@ -163,6 +299,28 @@ namespace Nz
 		return m_animation;
 	}
 
+	/*!
+	* \brief Gets the level of detail parameters of the animation
+	* \return Parameters used when animation LOD is enabled
+	*/
+
+	const SkeletalModelLOD& SkeletalModel::GetAnimationLOD() const
+	{
+		return m_animationLOD;
+	}
+
+	/*!
+	* \brief Gets the projected size of the model
+	* \return Largest fraction of the viewport height covered by the model since the last animation update, negative if it wasn't rendered
+	*
+	* \remark Only recorded when animation LOD is enabled
+	*/
+
+	float SkeletalModel::GetProjectedSize() const
+	{
+		return m_projectedSize;
+	}
+
 	/*!
 	* \brief Gets the skeleton of the model
 	* \return Pointer to the skeleton
@@ -170,6 +328,8 @@ namespace Nz
 
 	Skeleton* SkeletalModel::GetSkeleton()
 	{
+		// The skeleton is about to be modified, it has to be the one used for rendering
+		ReleaseSharedPose();
 		InvalidateBoundingVolume();
 
 		return &m_skeleton;
@@ -221,6 +381,26 @@ namespace Nz
 		return m_animationEnabled;
 	}
 
+	/*!
+	* \brief Checks whether the level of detail of the animation is enabled
+	* \return true If it is the case
+	*/
+
+	bool SkeletalModel::IsAnimationLODEnabled() const
+	{
+		return m_animationLODEnabled;
+	}
+
+	/*!
+	* \brief Checks whether the model is rendered with a pose shared with other models
+	* \return true If it is the case
+	*/
+
+	bool SkeletalModel::IsPoseShared() const
+	{
+		return m_sharedPose.IsValid();
+	}
+
 	/*!
 	* \brief Loads the skeleton model from file
 	* \return true if loading is successful
@@ -269,6 +449,8 @@ namespace Nz
 	{
 		Model::Reset();
 
+		ReleaseSharedPose();
+		m_reducedJoints.clear();
 		m_skeleton.Destroy();
 	}
 
@@ -313,6 +495,8 @@ namespace Nz
 		}
 		#endif
 
+		ReleaseSharedPose();
+
 		m_animation = animation;
 		if (m_animation)
 		{
@@ -325,6 +509,24 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Sets the level of detail parameters of the animation
+	*
+	* \param animationLOD Parameters used when animation LOD is enabled
+	*
+	* \see EnableAnimationLOD
+	*/
+
+	void SkeletalModel::SetAnimationLOD(const SkeletalModelLOD& animationLOD)
+	{
+		NazaraAssert(animationLOD.fullRateSize > 0.f, "Full rate size must be positive");
+		NazaraAssert(animationLOD.minUpdateRate > 0.f, "Minimum update rate must be positive");
+
+		m_animationLOD = animationLOD;
+
+		MakeReducedJoints();
+	}
+
 	/*!
 	* \brief Sets the mesh for the model
 	*
@@ -345,6 +547,8 @@ namespace Nz
 
 		Model::SetMesh(mesh);
 
+		ReleaseSharedPose();
+
 		if (m_mesh)
 		{
 			if (m_animation && m_animation->GetJointCount() != m_mesh->GetJointCount())
@@ -355,6 +559,8 @@ namespace Nz
 
 			m_skeleton = *m_mesh->GetSkeleton(); // Copy of skeleton template
 		}
+
+		MakeReducedJoints();
 	}
 
 	/*!
@@ -425,13 +631,62 @@ namespace Nz
 		m_nextFrame = m_currentSequence->firstFrame;
 	}
 
+	/*!
+	* \brief Gets the skeleton the model is rendered with
+	* \return Pointer to the shared pose if there is one, or to the skeleton of the model
+	*/
+
+	const Skeleton* SkeletalModel::GetRenderSkeleton() const
+	{
+		return (m_sharedPose) ? m_sharedPose.Get() : &m_skeleton;
+	}
+
 	/*
 	* \brief Makes the bounding volume of this text
 	*/
 
 	void SkeletalModel::MakeBoundingVolume() const
 	{
-		m_boundingVolume.Set(m_skeleton.GetAABB());
+		m_boundingVolume.Set(GetRenderSkeleton()->GetAABB());
+	}
+
+	/*!
+	* \brief Builds the list of the joints animated by distant models
+	*
+	* \remark Only the joints close enough to a root joint are kept, the others follow their parents with their last local transform
+	*/
+
+	void SkeletalModel::MakeReducedJoints()
+	{
+		m_reducedJoints.clear();
+
+		if (!m_skeleton.IsValid())
+			return;
+
+		unsigned int jointCount = m_skeleton.GetJointCount();
+		const Joint* joints = m_skeleton.GetJoints();
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			unsigned int depth = 0;
+			for (const Node* parent = joints[i].GetParent(); parent; parent = parent->GetParent())
+				depth++;
+
+			if (depth <= m_animationLOD.reducedJointDepth)
+				m_reducedJoints.push_back(i);
+		}
+
+		// Nothing to save
+		if (m_reducedJoints.size() == jointCount)
+			m_reducedJoints.clear();
+	}
+
+	/*!
+	* \brief Stops using a shared pose, the model is rendered with its own skeleton again
+	*/
+
+	void SkeletalModel::ReleaseSharedPose()
+	{
+		m_sharedPose.Reset();
 	}
 
 	/*!
@@ -445,5 +700,70 @@ namespace Nz
 			AdvanceAnimation(m_scene->GetUpdateTime());*/
 	}
 
+	/*!
+	* \brief Makes the model use the pose of its current animation frame, shared with the other models playing the same frame
+	*
+	* \remark Models sharing a pose share their skinned vertices as well, the pose is only animated and skinned once
+	*/
+
+	void SkeletalModel::UseSharedPose()
+	{
+		SharedPoseKey key(m_animation, m_mesh, m_currentFrame);
+
+		LockGuard lock(s_sharedPoseMutex);
+
+		auto it = s_sharedPoses.find(key);
+		if (it == s_sharedPoses.end())
+		{
+			// Models don't unregister their pose when destroyed, poses only referenced by the cache are released from time to time
+			if (s_sharedPoses.size() >= s_sharedPoseSweepSize)
+			{
+				for (auto poseIt = s_sharedPoses.begin(); poseIt != s_sharedPoses.end();)
+				{
+					if (poseIt->second.skeleton->GetReferenceCount() == 1)
+						poseIt = s_sharedPoses.erase(poseIt);
+					else
+						++poseIt;
+				}
+
+				s_sharedPoseSweepSize = std::max<std::size_t>(s_sharedPoses.size() * 2, 64);
+			}
+
+			SharedPose pose;
+			pose.animation = m_animation;
+			pose.mesh = m_mesh;
+			pose.skeleton = Skeleton::New(*m_mesh->GetSkeleton());
+			m_animation->AnimateSkeleton(pose.skeleton, m_currentFrame, m_currentFrame, 0.f);
+
+			it = s_sharedPoses.emplace(key, std::move(pose)).first;
+		}
+
+		m_sharedPose = it->second.skeleton;
+	}
+
+	/*!
+	* \brief Initializes the skeletal models
+	* \return true If successful
+	*/
+
+	bool SkeletalModel::Initialize()
+	{
+		s_sharedPoseSweepSize = 64;
+
+		return true;
+	}
+
+	/*!
+	* \brief Uninitializes the skeletal models
+	*/
+
+	void SkeletalModel::Uninitialize()
+	{
+		s_sharedPoses.clear();
+	}
+
+	std::map<SkeletalModel::SharedPoseKey, SkeletalModel::SharedPose> SkeletalModel::s_sharedPoses;
+	Mutex SkeletalModel::s_sharedPoseMutex;
 	SkeletalModelLoader::LoaderList SkeletalModel::s_loaders;
+	std::size_t SkeletalModel::s_sharedPoseSweepSize;
 }
@@ -4,11 +4,19 @@
 
 #include <Nazara/Graphics/SkinningManager.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <Nazara/Graphics/Debug.hpp>
@@ -22,17 +30,27 @@ namespace Nz
 			NazaraSlot(SkeletalMesh, OnSkeletalMeshDestroy, skeletalMeshDestroySlot);
 
 			VertexBufferRef buffer;
+			UInt64 lastUsedFrame;
 			bool updated;
 		};
 
 		using MeshMap = std::unordered_map<const SkeletalMesh*, BufferData>;
 
-		struct MeshData
+		struct SkeletonData
 		{
 			NazaraSlot(Skeleton, OnSkeletonDestroy, skeletonDestroySlot);
 			NazaraSlot(Skeleton, OnSkeletonJointsInvalidated, skeletonJointsInvalidatedSlot);
 
 			MeshMap meshMap;
+			TextureRef skinningTexture;
+			UInt64 lastUsedFrame = 0;
+			bool skinningTextureUpdated = false;
+		};
+
+		struct PooledBuffer
+		{
+			VertexBufferRef buffer;
+			UInt64 releaseFrame;
 		};
 
 		struct QueueData
@@ -42,9 +60,117 @@ namespace Nz
 			VertexBuffer* buffer;
 		};
 
-		using SkeletonMap = std::unordered_map<const Skeleton*, MeshData>;
+		using BufferPool = std::unordered_map<unsigned int, std::vector<PooledBuffer>>; //< By vertex count, the layout being always the same
+		using SkeletonMap = std::unordered_map<const Skeleton*, SkeletonData>;
+		BufferPool s_bufferPool;
 		SkeletonMap s_cache;
+		Mutex s_cacheMutex; //< Render queues may be filled by multiple threads
 		std::vector<QueueData> s_skinningQueue;
+		TextureSampler s_skinningSampler;
+		UInt64 s_frameIndex;
+		unsigned int s_maxIdleFrameCount;
+		bool s_gpuSkinningSupported;
+
+		/*!
+		* \brief Takes a skinned output buffer from the pool, or creates it
+		* \return A vertex buffer holding vertexCount vertices
+		*
+		* \param vertexCount Number of vertices of the mesh
+		*
+		* \remark New buffers start in software storage and are only moved to the hardware by Skin, on the rendering thread
+		*/
+
+		VertexBufferRef AcquireBuffer(unsigned int vertexCount)
+		{
+			auto it = s_bufferPool.find(vertexCount);
+			if (it != s_bufferPool.end() && !it->second.empty())
+			{
+				// The most recently released one, the oldest ones being freed first
+				VertexBufferRef buffer = std::move(it->second.back().buffer);
+				it->second.pop_back();
+
+				return buffer;
+			}
+
+			const VertexDeclaration* declaration = VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent);
+
+			// Built step by step, the constructors changing the (global) error flags
+			BufferRef storage = Buffer::New(BufferType_Vertex);
+			storage->Create(vertexCount * declaration->GetStride(), DataStorage_Software, BufferUsage_Dynamic);
+
+			VertexBufferRef vertexBuffer = VertexBuffer::New();
+			vertexBuffer->Reset(declaration, storage.Get());
+
+			return vertexBuffer;
+		}
+
+		void ReleaseBuffer(VertexBufferRef buffer)
+		{
+			s_bufferPool[buffer->GetVertexCount()].push_back(PooledBuffer{std::move(buffer), s_frameIndex});
+		}
+
+		void ReleaseBuffers(MeshMap& meshMap)
+		{
+			for (auto& pair : meshMap)
+				ReleaseBuffer(std::move(pair.second.buffer));
+
+			meshMap.clear();
+		}
+
+		/*!
+		* \brief Gives the buffers of the pairs which were not used recently back to the pool, and frees the buffers pooled for too long
+		*/
+
+		void RecycleIdleBuffers()
+		{
+			if (s_frameIndex <= s_maxIdleFrameCount)
+				return;
+
+			UInt64 oldestFrame = s_frameIndex - s_maxIdleFrameCount;
+
+			for (auto skeletonIt = s_cache.begin(); skeletonIt != s_cache.end();)
+			{
+				SkeletonData& skeletonData = skeletonIt->second;
+				if (skeletonData.lastUsedFrame < oldestFrame)
+				{
+					// Neither skinned nor bound for a while, its slots are disconnected along with it
+					ReleaseBuffers(skeletonData.meshMap);
+					skeletonIt = s_cache.erase(skeletonIt);
+					continue;
+				}
+
+				MeshMap& meshMap = skeletonData.meshMap;
+				for (auto meshIt = meshMap.begin(); meshIt != meshMap.end();)
+				{
+					if (meshIt->second.lastUsedFrame < oldestFrame)
+					{
+						ReleaseBuffer(std::move(meshIt->second.buffer));
+						meshIt = meshMap.erase(meshIt);
+					}
+					else
+						++meshIt;
+				}
+
+				++skeletonIt;
+			}
+
+			for (auto poolIt = s_bufferPool.begin(); poolIt != s_bufferPool.end();)
+			{
+				std::vector<PooledBuffer>& buffers = poolIt->second;
+
+				// Released in order, the ones to free are at the front
+				auto firstKept = std::find_if(buffers.begin(), buffers.end(), [oldestFrame] (const PooledBuffer& pooledBuffer)
+				{
+					return pooledBuffer.releaseFrame >= oldestFrame;
+				});
+				buffers.erase(buffers.begin(), firstKept);
+
+				if (buffers.empty())
+					poolIt = s_bufferPool.erase(poolIt);
+				else
+					++poolIt;
+			}
+		}
 
 		/*!
 		* \brief Skins the mesh for a single thread context
@@ -63,6 +189,7 @@ namespace Nz
 			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
 			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
 			skinningData.joints = skeleton->GetJoints();
+			skinningData.skinningMatrices = skeleton->GetSkinningMatrices();
 
 			SkinPositionNormalTangent(skinningData, 0, mesh->GetVertexCount());
 		}
@@ -84,21 +211,12 @@ namespace Nz
 			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
 			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
 			skinningData.joints = skeleton->GetJoints();
+			skinningData.skinningMatrices = skeleton->GetSkinningMatrices();
 
-			// To avoid different threads to update the same matrix at the same time
-			// We try to update them before launching the tasks
-			unsigned int jointCount = skeleton->GetJointCount();
-			for (unsigned int i = 0; i < jointCount; ++i)
-				skinningData.joints[i].EnsureSkinningMatrixUpdate();
-
-			unsigned int workerCount = TaskScheduler::GetWorkerCount();
-
-			std::ldiv_t div = std::ldiv(mesh->GetVertexCount(), workerCount);
-			for (unsigned int i = 0; i < workerCount; ++i)
-				TaskScheduler::AddTask(SkinPositionNormalTangent, skinningData, i*div.quot, (i == workerCount-1) ? div.quot + div.rem : div.quot);
-
-			TaskScheduler::Run();
-			TaskScheduler::WaitForTasks();
+			TaskScheduler::ParallelFor(0, mesh->GetVertexCount(), 1024, [&skinningData] (std::size_t first, std::size_t last)
+			{
+				SkinPositionNormalTangent(skinningData, static_cast<unsigned int>(first), static_cast<unsigned int>(last - first));
+			});
 		}
 	}
 
@@ -110,11 +228,13 @@ namespace Nz
 
 	/*!
 	* \brief Gets the vertex buffer from a skeletal mesh with its skeleton
-	* \return A pointer to the vertex buffer newly created
+	* \return A pointer to the skinned vertex buffer
 	*
 	* \param mesh Skeletal mesh to get vertex buffer from
 	* \param skeleton Skeleton to consider for getting data
 	*
+	* \remark Thread-safe, new buffers start in software storage and are only moved to the hardware by Skin, on the rendering thread
+	* \remark The buffer has to be requested every frame, it is given to other pairs once unused for GetMaxIdleFrameCount frames
 	* \remark Produces a NazaraError with NAZARA_GRAPHICS_SAFE defined if mesh is invalid
 	* \remark Produces a NazaraError with NAZARA_GRAPHICS_SAFE defined if skeleton is invalid
 	*/
@@ -135,40 +255,44 @@ namespace Nz
 		}
 		#endif
 
-		ErrorFlags flags(ErrorFlag_ThrowException);
+		LockGuard lock(s_cacheMutex);
 
 		SkeletonMap::iterator it = s_cache.find(skeleton);
 		if (it == s_cache.end())
 		{
-			MeshData meshData;
-			meshData.skeletonDestroySlot.Connect(skeleton->OnSkeletonDestroy, OnSkeletonRelease);
-			meshData.skeletonJointsInvalidatedSlot.Connect(skeleton->OnSkeletonJointsInvalidated, OnSkeletonInvalidated);
+			SkeletonData skeletonData;
+			skeletonData.skeletonDestroySlot.Connect(skeleton->OnSkeletonDestroy, OnSkeletonRelease);
+			skeletonData.skeletonJointsInvalidatedSlot.Connect(skeleton->OnSkeletonJointsInvalidated, OnSkeletonInvalidated);
 
-			it = s_cache.insert(std::make_pair(skeleton, std::move(meshData))).first;
+			it = s_cache.insert(std::make_pair(skeleton, std::move(skeletonData))).first;
 		}
 
+		it->second.lastUsedFrame = s_frameIndex;
+
 		VertexBuffer* buffer;
 
 		MeshMap& meshMap = it->second.meshMap;
 		MeshMap::iterator it2 = meshMap.find(mesh);
 		if (it2 == meshMap.end())
 		{
-			VertexBufferRef vertexBuffer = VertexBuffer::New(VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent), mesh->GetVertexCount(), DataStorage_Hardware, BufferUsage_Dynamic);
-
 			BufferData data;
 			data.skeletalMeshDestroySlot.Connect(mesh->OnSkeletalMeshDestroy, OnSkeletalMeshDestroy);
-			data.buffer = vertexBuffer;
+			data.buffer = AcquireBuffer(mesh->GetVertexCount());
+			data.lastUsedFrame = s_frameIndex;
 			data.updated = true;
 
-			meshMap.insert(std::make_pair(mesh, std::move(data)));
+			buffer = data.buffer;
 
-			s_skinningQueue.push_back(QueueData{mesh, skeleton, vertexBuffer});
+			meshMap.insert(std::make_pair(mesh, std::move(data)));
 
-			buffer = vertexBuffer;
+			s_skinningQueue.push_back(QueueData{mesh, skeleton, buffer});
 		}
 		else
 		{
+			// Skinned again only if the joints were invalidated since the last time
 			BufferData& data = it2->second;
+			data.lastUsedFrame = s_frameIndex;
+
 			if (!data.updated)
 			{
 				s_skinningQueue.push_back(QueueData{mesh, skeleton, data.buffer});
@@ -181,16 +305,152 @@ namespace Nz
 		return buffer;
 	}
 
+	/*!
+	* \brief Binds the texture holding the skinning matrices of a skeleton, for skinning on the GPU
+	* \return true If successful
+	*
+	* \param skeleton Skeleton to consider for getting data
+	* \param textureUnit Texture unit the shader reads the matrices from
+	*
+	* \remark Each joint takes a row of four RGBA32F texels, one per matrix row
+	* \remark The texture is only updated once per skeleton invalidation, no matter how many meshes are using it
+	* \remark Produces a NazaraError with NAZARA_GRAPHICS_SAFE defined if skeleton is invalid
+	*/
+
+	bool SkinningManager::BindSkinningTexture(const Skeleton* skeleton, UInt8 textureUnit)
+	{
+		#if NAZARA_GRAPHICS_SAFE
+		if (!skeleton)
+		{
+			NazaraError("Invalid skeleton");
+			return false;
+		}
+		#endif
+
+		NazaraAssert(s_gpuSkinningSupported, "GPU skinning is not supported");
+
+		SkeletonMap::iterator it = s_cache.find(skeleton);
+		if (it == s_cache.end())
+		{
+			SkeletonData skeletonData;
+			skeletonData.skeletonDestroySlot.Connect(skeleton->OnSkeletonDestroy, OnSkeletonRelease);
+			skeletonData.skeletonJointsInvalidatedSlot.Connect(skeleton->OnSkeletonJointsInvalidated, OnSkeletonInvalidated);
+
+			it = s_cache.insert(std::make_pair(skeleton, std::move(skeletonData))).first;
+		}
+
+		SkeletonData& skeletonData = it->second;
+		skeletonData.lastUsedFrame = s_frameIndex;
+
+		if (!skeletonData.skinningTextureUpdated)
+		{
+			unsigned int jointCount = skeleton->GetJointCount();
+
+			Texture* texture = skeletonData.skinningTexture;
+			if (!texture || texture->GetHeight() != jointCount)
+			{
+				skeletonData.skinningTexture = Texture::New();
+				texture = skeletonData.skinningTexture;
+
+				if (!texture->Create(ImageType_2D, PixelFormatType_RGBA32F, 4, jointCount))
+				{
+					NazaraError("Failed to create skinning texture");
+					skeletonData.skinningTexture.Reset();
+					return false;
+				}
+			}
+
+			if (!texture->Update(reinterpret_cast<const UInt8*>(skeleton->GetSkinningMatrices())))
+			{
+				NazaraError("Failed to update skinning texture");
+				return false;
+			}
+
+			skeletonData.skinningTextureUpdated = true;
+		}
+
+		Renderer::SetTexture(textureUnit, skeletonData.skinningTexture);
+		Renderer::SetTextureSampler(textureUnit, s_skinningSampler);
+
+		return true;
+	}
+
+	/*!
+	* \brief Checks whether skeletal models can be skinned on the GPU
+	* \return true If the renderer can send joint indices and sample float textures
+	*/
+
+	bool SkinningManager::IsGpuSkinningSupported()
+	{
+		return s_gpuSkinningSupported;
+	}
+
 	/*!
 	* \brief Skins the skeletal mesh
 	*/
 
 	void SkinningManager::Skin()
 	{
-		for (QueueData& data : s_skinningQueue)
-			s_skinFunc(data.mesh, data.skeleton, data.buffer);
+		NazaraProfileZone("SkinningManager::Skin");
 
-		s_skinningQueue.clear();
+		if (!s_skinningQueue.empty())
+		{
+			// Chosen on first use, so that the task scheduler threads are not started by the module initialization
+			if (!s_skinFunc)
+			{
+				if (TaskScheduler::Initialize())
+					s_skinFunc = Skin_MultiCPU;
+				else
+					s_skinFunc = Skin_MonoCPU;
+			}
+
+			ErrorFlags flags(ErrorFlag_ThrowException);
+
+			for (QueueData& data : s_skinningQueue)
+			{
+				// Hardware buffers can only be created by the thread owning the context
+				if (!data.buffer->IsHardware())
+					data.buffer->SetStorage(DataStorage_Hardware);
+
+				s_skinFunc(data.mesh, data.skeleton, data.buffer);
+			}
+
+			s_skinningQueue.clear();
+		}
+
+		// Instances which are no longer rendered give their buffers to the next ones
+		LockGuard lock(s_cacheMutex);
+
+		RecycleIdleBuffers();
+		s_frameIndex++;
+	}
+
+	/*!
+	* \brief Gets the number of frames a skinned buffer is kept without being used
+	* \return Number of calls to Skin
+	*
+	* \see SetMaxIdleFrameCount
+	*/
+
+	unsigned int SkinningManager::GetMaxIdleFrameCount()
+	{
+		return s_maxIdleFrameCount;
+	}
+
+	/*!
+	* \brief Sets the number of frames a skinned buffer is kept without being used
+	*
+	* A (skeleton, mesh) pair which was not requested during this many calls to Skin gives its buffer back to a pool,
+	* from which the pairs of meshes having the same vertex count take their buffers. Pooled buffers are freed after as many calls.
+	*
+	* \param frameCount Number of calls to Skin, usually once per frame and render technique
+	*/
+
+	void SkinningManager::SetMaxIdleFrameCount(unsigned int frameCount)
+	{
+		LockGuard lock(s_cacheMutex);
+
+		s_maxIdleFrameCount = frameCount;
 	}
 
 	/*!
@@ -200,11 +460,14 @@ namespace Nz
 
 	bool SkinningManager::Initialize()
 	{
-		///TODO: GPU Skinning
-		if (TaskScheduler::Initialize())
-			s_skinFunc = Skin_MultiCPU;
-		else
-			s_skinFunc = Skin_MonoCPU;
+		s_frameIndex = 0;
+		s_gpuSkinningSupported = Renderer::IsComponentTypeSupported(ComponentType_Int4) && Texture::IsFormatSupported(PixelFormatType_RGBA32F);
+		s_maxIdleFrameCount = 120;
+		s_skinFunc = nullptr;
+
+		s_skinningSampler.SetAnisotropyLevel(1);
+		s_skinningSampler.SetFilterMode(SamplerFilter_Nearest);
+		s_skinningSampler.SetWrapMode(SamplerWrap_Clamp);
 
 		return true; // Nothing particular to do
 	}
@@ -217,10 +480,18 @@ namespace Nz
 
 	void SkinningManager::OnSkeletalMeshDestroy(const SkeletalMesh* mesh)
 	{
+		LockGuard lock(s_cacheMutex);
+
 		for (auto& pair : s_cache)
 		{
 			MeshMap& meshMap = pair.second.meshMap;
-			meshMap.erase(mesh);
+
+			auto it = meshMap.find(mesh);
+			if (it != meshMap.end())
+			{
+				ReleaseBuffer(std::move(it->second.buffer));
+				meshMap.erase(it);
+			}
 		}
 	}
 
@@ -232,8 +503,11 @@ namespace Nz
 
 	void SkinningManager::OnSkeletonInvalidated(const Skeleton* skeleton)
 	{
-		for (auto& pair : s_cache.at(skeleton).meshMap)
+		SkeletonData& skeletonData = s_cache.at(skeleton);
+		for (auto& pair : skeletonData.meshMap)
 			pair.second.updated = false;
+
+		skeletonData.skinningTextureUpdated = false;
 	}
 
 	/*!
@@ -244,7 +518,14 @@ namespace Nz
 
 	void SkinningManager::OnSkeletonRelease(const Skeleton* skeleton)
 	{
-		s_cache.erase(skeleton);
+		LockGuard lock(s_cacheMutex);
+
+		auto it = s_cache.find(skeleton);
+		if (it != s_cache.end())
+		{
+			ReleaseBuffers(it->second.meshMap);
+			s_cache.erase(it);
+		}
 	}
 
 	/*!
@@ -253,6 +534,7 @@ namespace Nz
 
 	void SkinningManager::Uninitialize()
 	{
+		s_bufferPool.clear();
 		s_cache.clear();
 		s_skinningQueue.clear();
 	}
@@ -0,0 +1,519 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Graphics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Graphics/StaticBatch.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Utility/Buffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/MeshData.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <Nazara/Graphics/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool HasComponent(const VertexDeclaration* declaration, VertexComponent component, ComponentType expectedType)
+		{
+			bool enabled;
+			ComponentType type;
+			std::size_t offset;
+			declaration->GetComponent(component, &enabled, &type, &offset);
+
+			return enabled && type == expectedType;
+		}
+
+		bool IsBatchable(const StaticMesh* subMesh)
+		{
+			return subMesh->GetPrimitiveMode() == PrimitiveMode_TriangleList &&
+			       HasComponent(subMesh->GetVertexBuffer()->GetVertexDeclaration(), VertexComponent_Position, ComponentType_Float3);
+		}
+	}
+
+	/*!
+	* \ingroup graphics
+	* \class Nz::StaticBatch
+	* \brief Graphics class that merges static models and sprites sharing a material
+	*
+	* The submeshes of the models are copied, transformed by the matrix of their model, into a vertex buffer and an index buffer per material.
+	* Those buffers live as long as the batch and are only rebuilt when a member changes (when it invalidates its instance data), or when Invalidate is called.
+	* The sprites are merged in a chain per material (and texture layer), queued with a single call.
+	*
+	* \remark Only triangle lists with floating point positions are merged, other submeshes are queued one by one with their model transform
+	* \remark Models are merged with their first level of detail
+	*/
+
+	/*!
+	* \brief Adds a model to the batch
+	*
+	* \param model Static model to merge
+	* \param transformMatrix Transform of the model relative to the batch
+	*
+	* \remark Produces a NazaraError if the model is animated
+	*/
+
+	void StaticBatch::AddModel(Model* model, const Matrix4f& transformMatrix)
+	{
+		NazaraAssert(model, "Invalid model");
+
+		if (model->IsAnimated())
+		{
+			NazaraError("Animated models cannot be batched");
+			return;
+		}
+
+		m_models.emplace_back();
+
+		ModelMember& member = m_models.back();
+		member.model = model;
+		member.transformMatrix = transformMatrix;
+		member.onInvalidateDataSlot.Connect(model->OnInstancedRenderableInvalidateData, [this] (const InstancedRenderable*, UInt32) { Invalidate(); });
+
+		Invalidate();
+	}
+
+	/*!
+	* \brief Adds a sprite to the batch
+	*
+	* \param sprite Sprite to merge
+	* \param transformMatrix Transform of the sprite relative to the batch
+	*/
+
+	void StaticBatch::AddSprite(Sprite* sprite, const Matrix4f& transformMatrix)
+	{
+		NazaraAssert(sprite, "Invalid sprite");
+
+		m_sprites.emplace_back();
+
+		SpriteMember& member = m_sprites.back();
+		member.sprite = sprite;
+		member.transformMatrix = transformMatrix;
+		member.onInvalidateDataSlot.Connect(sprite->OnInstancedRenderableInvalidateData, [this] (const InstancedRenderable*, UInt32) { Invalidate(); });
+
+		Invalidate();
+	}
+
+	/*!
+	* \brief Adds the batches to the rendering queue
+	*
+	* \param renderQueue Queue to be added
+	* \param instanceData Data for the instance
+	*/
+
+	void StaticBatch::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
+	{
+		EnsureBatchesUpdated();
+
+		const Matrix4f& transformMatrix = *instanceData.transformMatrix;
+
+		for (const MeshBatch& batch : m_meshBatches)
+		{
+			MeshData meshData;
+			meshData.indexBuffer = batch.indexBuffer;
+			meshData.primitiveMode = PrimitiveMode_TriangleList;
+			meshData.skeleton = nullptr;
+			meshData.vertexBuffer = batch.vertexBuffer;
+
+			renderQueue->AddMesh(instanceData.renderOrder, batch.material, meshData, batch.aabb, transformMatrix);
+		}
+
+		for (const UnbatchedMesh& mesh : m_unbatchedMeshes)
+		{
+			MeshData meshData;
+			meshData.indexBuffer = mesh.subMesh->GetIndexBuffer();
+			meshData.primitiveMode = mesh.subMesh->GetPrimitiveMode();
+			meshData.skeleton = nullptr;
+			meshData.vertexBuffer = mesh.subMesh->GetVertexBuffer();
+
+			renderQueue->AddMesh(instanceData.renderOrder, mesh.material, meshData, mesh.subMesh->GetAABB(), Matrix4f::ConcatenateAffine(mesh.transformMatrix, transformMatrix));
+		}
+
+		if (!m_spriteBatches.empty())
+		{
+			const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData.data.data());
+			NazaraAssert(instanceData.data.size() == sizeof(InstanceHeader) + m_spriteVertices.size() * sizeof(VertexStruct_XYZ_Color_UV) && header->revision == m_revision, "Instance data is not up to date");
+
+			const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(header + 1);
+			for (const SpriteBatch& batch : m_spriteBatches)
+				renderQueue->AddSprites(instanceData.renderOrder, batch.material, &vertices[batch.firstSprite * 4], static_cast<unsigned int>(batch.spriteCount), nullptr, batch.textureLayer);
+		}
+	}
+
+	/*!
+	* \brief Removes every member of the batch
+	*/
+
+	void StaticBatch::Clear()
+	{
+		m_models.clear();
+		m_sprites.clear();
+
+		Invalidate();
+	}
+
+	/*!
+	* \brief Gets the number of draws the batch is queued with (merged meshes, sprite chains and submeshes which could not be merged)
+	* \return Number of batches
+	*/
+
+	std::size_t StaticBatch::GetBatchCount() const
+	{
+		EnsureBatchesUpdated();
+
+		return m_meshBatches.size() + m_spriteBatches.size() + m_unbatchedMeshes.size();
+	}
+
+	/*!
+	* \brief Marks the batches as outdated, they will be rebuilt when next used
+	*
+	* \remark Members invalidate the batch by themselves when their material or their appearance change, this is needed when the geometry of a mesh is modified
+	*/
+
+	void StaticBatch::Invalidate()
+	{
+		m_batchesUpdated = false;
+
+		InvalidateBoundingVolume();
+		InvalidateInstanceData(0);
+	}
+
+	/*!
+	* \brief Removes a model from the batch
+	* \return true If the model was a member of the batch
+	*
+	* \param model Model to remove (every instance of it)
+	*/
+
+	bool StaticBatch::RemoveModel(const Model* model)
+	{
+		auto it = std::remove_if(m_models.begin(), m_models.end(), [model] (const ModelMember& member) { return member.model == model; });
+		if (it == m_models.end())
+			return false;
+
+		m_models.erase(it, m_models.end());
+		Invalidate();
+
+		return true;
+	}
+
+	/*!
+	* \brief Removes a sprite from the batch
+	* \return true If the sprite was a member of the batch
+	*
+	* \param sprite Sprite to remove (every instance of it)
+	*/
+
+	bool StaticBatch::RemoveSprite(const Sprite* sprite)
+	{
+		auto it = std::remove_if(m_sprites.begin(), m_sprites.end(), [sprite] (const SpriteMember& member) { return member.sprite == sprite; });
+		if (it == m_sprites.end())
+			return false;
+
+		m_sprites.erase(it, m_sprites.end());
+		Invalidate();
+
+		return true;
+	}
+
+	void StaticBatch::BuildBatches() const
+	{
+		BuildMeshBatches();
+		BuildSpriteBatches();
+	}
+
+	void StaticBatch::BuildMeshBatches() const
+	{
+		struct PendingMesh
+		{
+			const StaticMesh* subMesh;
+			const Matrix4f* transformMatrix;
+		};
+
+		struct PendingBatch
+		{
+			Material* material;
+			std::vector<PendingMesh> meshes;
+			unsigned int indexCount = 0;
+			unsigned int vertexCount = 0;
+		};
+
+		m_meshBatches.clear();
+		m_unbatchedMeshes.clear();
+
+		// Regroupement des sous-maillages par matériau, dans l'ordre d'ajout
+		std::vector<PendingBatch> pendingBatches;
+		std::unordered_map<Material*, std::size_t> batchByMaterial;
+
+		for (const ModelMember& member : m_models)
+		{
+			const Mesh* mesh = member.model->GetMesh();
+			if (!mesh || mesh->IsAnimable())
+				continue;
+
+			unsigned int skin = member.model->GetSkin();
+			unsigned int subMeshCount = mesh->GetSubMeshCount();
+			for (unsigned int i = 0; i < subMeshCount; ++i)
+			{
+				const StaticMesh* subMesh = static_cast<const StaticMesh*>(mesh->GetSubMesh(i));
+				Material* material = member.model->GetMaterial(skin, subMesh->GetMaterialIndex());
+				if (!material)
+					continue;
+
+				if (!IsBatchable(subMesh))
+				{
+					UnbatchedMesh unbatchedMesh;
+					unbatchedMesh.material = material;
+					unbatchedMesh.subMesh = subMesh;
+					unbatchedMesh.transformMatrix = member.transformMatrix;
+
+					m_unbatchedMeshes.push_back(unbatchedMesh);
+					continue;
+				}
+
+				auto it = batchByMaterial.find(material);
+				if (it == batchByMaterial.end())
+				{
+					it = batchByMaterial.emplace(material, pendingBatches.size()).first;
+
+					pendingBatches.emplace_back();
+					pendingBatches.back().material = material;
+				}
+
+				PendingBatch& pendingBatch = pendingBatches[it->second];
+				pendingBatch.indexCount += (subMesh->GetIndexBuffer()) ? subMesh->GetIndexBuffer()->GetIndexCount() : subMesh->GetVertexCount();
+				pendingBatch.vertexCount += subMesh->GetVertexCount();
+				pendingBatch.meshes.push_back({subMesh, &member.transformMatrix});
+			}
+		}
+
+		UInt32 storage = (Buffer::IsStorageSupported(DataStorage_Hardware)) ? DataStorage_Hardware : DataStorage_Software;
+		const VertexDeclaration* declaration = VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent);
+
+		std::vector<VertexStruct_XYZ_Normal_UV_Tangent> vertices;
+		std::vector<UInt32> indices;
+
+		for (const PendingBatch& pendingBatch : pendingBatches)
+		{
+			if (pendingBatch.vertexCount == 0 || pendingBatch.indexCount == 0)
+				continue;
+
+			vertices.resize(pendingBatch.vertexCount);
+			indices.resize(pendingBatch.indexCount);
+
+			Boxf aabb;
+			bool firstVertex = true;
+			unsigned int indexOffset = 0;
+			unsigned int vertexOffset = 0;
+
+			for (const PendingMesh& pendingMesh : pendingBatch.meshes)
+			{
+				const StaticMesh* subMesh = pendingMesh.subMesh;
+				const Matrix4f& transformMatrix = *pendingMesh.transformMatrix;
+				const VertexDeclaration* meshDeclaration = subMesh->GetVertexBuffer()->GetVertexDeclaration();
+
+				// Les normales et tangentes suivent la transposée de l'inverse, pour rester correctes sous une mise à l'échelle non-uniforme
+				Matrix4f normalMatrix;
+				if (!transformMatrix.GetInverseAffine(&normalMatrix))
+					normalMatrix = transformMatrix;
+				normalMatrix.Transpose();
+
+				VertexMapper vertexMapper(subMesh);
+				SparsePtr<Vector3f> positionPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Position);
+				SparsePtr<Vector3f> normalPtr;
+				SparsePtr<Vector3f> tangentPtr;
+				SparsePtr<Vector2f> uvPtr;
+
+				if (HasComponent(meshDeclaration, VertexComponent_Normal, ComponentType_Float3))
+					normalPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Normal);
+
+				if (HasComponent(meshDeclaration, VertexComponent_Tangent, ComponentType_Float3))
+					tangentPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Tangent);
+
+				if (HasComponent(meshDeclaration, VertexComponent_TexCoord, ComponentType_Float2))
+					uvPtr = vertexMapper.GetComponentPtr<Vector2f>(VertexComponent_TexCoord);
+
+				unsigned int vertexCount = subMesh->GetVertexCount();
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					VertexStruct_XYZ_Normal_UV_Tangent& vertex = vertices[vertexOffset + i];
+					vertex.position = transformMatrix.Transform(positionPtr[i]);
+					vertex.normal = (normalPtr) ? Vector3f::Normalize(normalMatrix.Transform(normalPtr[i], 0.f)) : Vector3f::Up();
+					vertex.tangent = (tangentPtr) ? Vector3f::Normalize(normalMatrix.Transform(tangentPtr[i], 0.f)) : Vector3f::Right();
+					vertex.uv = (uvPtr) ? uvPtr[i] : Vector2f::Zero();
+
+					if (firstVertex)
+					{
+						aabb.Set(vertex.position, vertex.position);
+						firstVertex = false;
+					}
+					else
+						aabb.ExtendTo(vertex.position);
+				}
+
+				IndexMapper indexMapper(subMesh);
+				unsigned int indexCount = indexMapper.GetIndexCount();
+				for (unsigned int i = 0; i < indexCount; ++i)
+					indices[indexOffset + i] = vertexOffset + indexMapper.Get(i);
+
+				indexOffset += indexCount;
+				vertexOffset += vertexCount;
+			}
+
+			MeshBatch batch;
+			batch.aabb = aabb;
+			batch.material = pendingBatch.material;
+			batch.vertexBuffer = VertexBuffer::New(declaration, pendingBatch.vertexCount, storage, BufferUsage_Static);
+			batch.vertexBuffer->Fill(vertices.data(), 0, pendingBatch.vertexCount);
+
+			bool largeIndices = (pendingBatch.vertexCount > std::numeric_limits<UInt16>::max());
+			batch.indexBuffer = IndexBuffer::New(largeIndices, pendingBatch.indexCount, storage, BufferUsage_Static);
+			if (largeIndices)
+				batch.indexBuffer->Fill(indices.data(), 0, pendingBatch.indexCount);
+			else
+			{
+				std::vector<UInt16> smallIndices(indices.begin(), indices.end());
+				batch.indexBuffer->Fill(smallIndices.data(), 0, pendingBatch.indexCount);
+			}
+
+			m_meshBatches.push_back(std::move(batch));
+		}
+	}
+
+	void StaticBatch::BuildSpriteBatches() const
+	{
+		m_spriteBatches.clear();
+		m_spriteVertices.clear();
+		m_revision++;
+
+		// Regroupement des sprites par matériau et couche de texture, dans l'ordre d'ajout
+		std::vector<std::vector<VertexStruct_XYZ_Color_UV>> batchVertices;
+		std::map<std::pair<const Material*, unsigned int>, std::size_t> batchByKey;
+
+		for (const SpriteMember& member : m_sprites)
+		{
+			const Sprite* sprite = member.sprite;
+			const MaterialRef& material = sprite->GetMaterial();
+			if (!material)
+				continue;
+
+			auto key = std::make_pair(static_cast<const Material*>(material), sprite->GetTextureLayer());
+			auto it = batchByKey.find(key);
+			if (it == batchByKey.end())
+			{
+				it = batchByKey.emplace(key, m_spriteBatches.size()).first;
+
+				SpriteBatch batch;
+				batch.material = material;
+				batch.textureLayer = key.second;
+
+				m_spriteBatches.push_back(batch);
+				batchVertices.emplace_back();
+			}
+
+			// Le sprite génère lui-même ses sommets, dans l'espace du batch
+			Matrix4f transformMatrix = member.transformMatrix;
+			InstanceData spriteData(transformMatrix);
+			static_cast<const InstancedRenderable*>(sprite)->UpdateData(&spriteData);
+
+			const VertexStruct_XYZ_Color_UV* spriteVertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(spriteData.data.data());
+
+			std::vector<VertexStruct_XYZ_Color_UV>& vertices = batchVertices[it->second];
+			vertices.insert(vertices.end(), spriteVertices, spriteVertices + 4);
+		}
+
+		for (std::size_t i = 0; i < m_spriteBatches.size(); ++i)
+		{
+			SpriteBatch& batch = m_spriteBatches[i];
+			batch.firstSprite = m_spriteVertices.size() / 4;
+			batch.spriteCount = batchVertices[i].size() / 4;
+
+			m_spriteVertices.insert(m_spriteVertices.end(), batchVertices[i].begin(), batchVertices[i].end());
+		}
+	}
+
+	/*
+	* \brief Makes the bounding volume of the batch, from its merged geometry
+	*/
+
+	void StaticBatch::MakeBoundingVolume() const
+	{
+		EnsureBatchesUpdated();
+
+		Boxf aabb;
+		bool empty = true;
+
+		auto ExtendTo = [&aabb, &empty] (const Boxf& box)
+		{
+			if (empty)
+			{
+				aabb = box;
+				empty = false;
+			}
+			else
+				aabb.ExtendTo(box);
+		};
+
+		for (const MeshBatch& batch : m_meshBatches)
+			ExtendTo(batch.aabb);
+
+		for (const UnbatchedMesh& mesh : m_unbatchedMeshes)
+		{
+			Boxf meshAABB = mesh.subMesh->GetAABB();
+			meshAABB.Transform(mesh.transformMatrix);
+
+			ExtendTo(meshAABB);
+		}
+
+		for (const VertexStruct_XYZ_Color_UV& vertex : m_spriteVertices)
+			ExtendTo(Boxf(vertex.position, vertex.position));
+
+		if (empty)
+			m_boundingVolume.MakeNull();
+		else
+			m_boundingVolume.Set(aabb);
+	}
+
+	/*!
+	* \brief Updates the sprite vertices of an instance of the batch
+	*
+	* \param instanceData Data of the instance
+	*/
+
+	void StaticBatch::UpdateData(InstanceData* instanceData) const
+	{
+		EnsureBatchesUpdated();
+
+		// Layout: header, then the vertices of every sprite chain, transformed by the instance matrix
+		std::size_t dataSize = sizeof(InstanceHeader) + m_spriteVertices.size() * sizeof(VertexStruct_XYZ_Color_UV);
+		const Matrix4f& transformMatrix = *instanceData->transformMatrix;
+
+		if (instanceData->data.size() == dataSize)
+		{
+			const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData->data.data());
+			if (header->revision == m_revision && header->transformMatrix == transformMatrix)
+				return;
+		}
+		else
+			instanceData->data.resize(dataSize);
+
+		InstanceHeader* header = reinterpret_cast<InstanceHeader*>(instanceData->data.data());
+		header->revision = m_revision;
+		header->transformMatrix = transformMatrix;
+
+		VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(header + 1);
+		for (std::size_t i = 0; i < m_spriteVertices.size(); ++i)
+		{
+			vertices[i] = m_spriteVertices[i];
+			vertices[i].position = transformMatrix.Transform(m_spriteVertices[i].position);
+		}
+	}
+}
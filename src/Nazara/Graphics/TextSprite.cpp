@@ -4,9 +4,9 @@
 
 #include <Nazara/Graphics/TextSprite.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
-#include <Nazara/Core/SparsePtr.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
+#include <cstring>
 #include <memory>
 #include <Nazara/Utility/Font.hpp>
 #include <Nazara/Graphics/Debug.hpp>
@@ -17,6 +17,8 @@ namespace Nz
 	* \ingroup graphics
 	* \class Nz::TextSprite
 	* \brief Graphics class that represents the rendering of a sprite containing text
+	*
+	* Every quad remembers when it was last modified, so instances only rebuild the quads changed since their last update.
 	*/
 
 	/*!
@@ -28,9 +30,13 @@ namespace Nz
 
 	void TextSprite::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
 	{
-		if (!m_material)
+		if (!m_material || m_renderInfos.empty())
 			return;
 
+		const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData.data.data());
+		NazaraAssert(header->quadCount == m_localVertices.size() / 4, "Instance data is not up to date");
+
+		const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(header + 1);
 		for (auto& pair : m_renderInfos)
 		{
 			Texture* overlay = pair.first;
@@ -38,7 +44,6 @@ namespace Nz
 
 			if (indices.count > 0)
 			{
-				const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(instanceData.data.data());
 				renderQueue->AddSprites(instanceData.renderOrder, m_material, &vertices[indices.first * 4], indices.count, overlay);
 			}
 		}
@@ -50,6 +55,9 @@ namespace Nz
 	* \param drawer Drawer used to compose the text
 	*
 	* \remark Produces a NazaraAssert if atlas does not use a hardware storage
+	* \remark The material is replaced by a copy toggling distance field rendering when it does not match the fonts (the default materials are replaced by their shared counterpart)
+	* \remark If the drawer only appended glyphes since the last update (same glyph revision), only their vertices are computed
+	* \remark Otherwise the glyphes are compared to the previous ones and only the quads which changed are marked as modified
 	*/
 
 	void TextSprite::Update(const AbstractTextDrawer& drawer)
@@ -64,10 +72,14 @@ namespace Nz
 			pair.second.used = false;
 
 		// ... until they are marked as used by the drawer
+		std::size_t distanceFieldFontCount = 0;
 		std::size_t fontCount = drawer.GetFontCount();
 		for (std::size_t i = 0; i < fontCount; ++i)
 		{
 			Font* font = drawer.GetFont(i);
+			if (font->IsDistanceFieldEnabled())
+				distanceFieldFontCount++;
+
 			const AbstractAtlas* atlas = font->GetAtlas().get();
 			NazaraAssert(atlas->GetStorage() & DataStorage_Hardware, "Font uses a non-hardware atlas which cannot be used by text sprites");
 
@@ -85,6 +97,27 @@ namespace Nz
 			it->second.used = true;
 		}
 
+		// Distance field glyphes have to be thresholded by the shader, which applies to the whole sprite
+		bool distanceField = (distanceFieldFontCount > 0);
+		if (distanceField && distanceFieldFontCount != fontCount)
+			NazaraWarning("Text mixes distance field and bitmap fonts, bitmap glyphes will be rendered as distance fields");
+
+		if (m_material && m_material->IsDistanceFieldEnabled() != distanceField)
+		{
+			// The shared materials keep being shared, a copy would prevent batching with the other text sprites
+			const char* sharedMaterials[2] = {"Translucent2D", "TranslucentDistanceField2D"};
+
+			if (m_material == MaterialLibrary::Get(sharedMaterials[!distanceField]))
+				SetMaterial(MaterialLibrary::Get(sharedMaterials[distanceField]));
+			else
+			{
+				MaterialRef material = Material::New(*m_material);
+				material->EnableDistanceField(distanceField);
+
+				SetMaterial(std::move(material));
+			}
+		}
+
 		// Remove unused atlas slots
 		auto atlasIt = m_atlases.begin();
 		while (atlasIt != m_atlases.end())
@@ -96,101 +129,102 @@ namespace Nz
 		}
 
 		std::size_t glyphCount = drawer.GetGlyphCount();
-		m_localVertices.resize(glyphCount * 4);
-
-		// Reset glyph count for every texture to zero
-		for (auto& pair : m_renderInfos)
-			pair.second.count = 0;
+		UInt64 glyphRevision = drawer.GetGlyphRevision();
 
-		// Count glyph count for each texture
-		Texture* lastTexture = nullptr;
-		unsigned int* count = nullptr;
-		for (std::size_t i = 0; i < glyphCount; ++i)
-		{
-			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
+		// While the drawer keeps the same revision, its previous glyphes (and our vertices) are unchanged
+		std::size_t previousGlyphCount = m_localVertices.size() / 4;
+		bool appendOnly = (glyphRevision != AbstractTextDrawer::InvalidRevision && glyphRevision == m_glyphRevision && glyphCount >= previousGlyphCount);
+		if (!appendOnly || !AppendGlyphs(drawer, previousGlyphCount, glyphCount))
+			UpdateGlyphs(drawer, glyphCount);
 
-			Texture* texture = static_cast<Texture*>(glyph.atlas);
-			if (lastTexture != texture)
-			{
-				auto it = m_renderInfos.find(texture);
-				if (it == m_renderInfos.end())
-					it = m_renderInfos.insert(std::make_pair(texture, RenderIndices{0U, 0U})).first;
+		m_glyphRevision = glyphRevision;
 
-				count = &it->second.count;
-				lastTexture = texture;
-			}
+		m_localBounds = drawer.GetBounds();
 
-			(*count)++;
-		}
+		InvalidateBoundingVolume();
+		InvalidateInstanceData(0);
 
-		// Attributes indices and reinitialize glyph count to zero to use it as a counter in the next loop
-		// This is because the 1st glyph can use texture A, the 2nd glyph can use texture B and the 3th glyph C can use texture A again
-		// so we need a counter to know where to write informations
-		// also remove unused render infos
-		unsigned int index = 0;
-		auto infoIt = m_renderInfos.begin();
-		while (infoIt != m_renderInfos.end())
-		{
-			RenderIndices& indices = infoIt->second;
-			if (indices.count == 0)
-				m_renderInfos.erase(infoIt++); //< No glyph uses this texture, remove from indices
-			else
-			{
-				indices.first = index;
+		clearOnFail.Reset();
+	}
 
-				index += indices.count;
-				indices.count = 0;
-				++infoIt;
-			}
-		}
+	/*!
+	* \brief Appends the vertices of the glyphes added to the drawer since the last update
+	* \return true if the glyphes could be appended
+	*
+	* \param drawer Drawer used to compose the text
+	* \param firstGlyph Index of the first new glyph
+	* \param glyphCount Glyph count of the drawer
+	*
+	* \remark New glyphes can only be appended to the texture whose vertices are the last ones, otherwise every glyph has to be updated
+	*/
 
-		lastTexture = nullptr;
-		RenderIndices* indices = nullptr;
-		for (unsigned int i = 0; i < glyphCount; ++i)
-		{
-			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
+	bool TextSprite::AppendGlyphs(const AbstractTextDrawer& drawer, std::size_t firstGlyph, std::size_t glyphCount)
+	{
+		if (firstGlyph == glyphCount)
+			return true;
 
-			Texture* texture = static_cast<Texture*>(glyph.atlas);
-			if (lastTexture != texture)
-			{
-				indices = &m_renderInfos[texture]; //< We changed texture, adjust the pointer
-				lastTexture = texture;
-			}
+		if (m_renderInfos.empty())
+			return false;
 
-			// First, compute the uv coordinates from our atlas rect
-			Vector2ui size(texture->GetSize());
-			float invWidth = 1.f / size.x;
-			float invHeight = 1.f / size.y;
+		// Find which texture owns the last vertices
+		auto lastInfoIt = m_renderInfos.begin();
+		for (auto it = m_renderInfos.begin(); it != m_renderInfos.end(); ++it)
+		{
+			if (it->second.first > lastInfoIt->second.first)
+				lastInfoIt = it;
+		}
 
-			Rectf uvRect(glyph.atlasRect);
-			uvRect.x *= invWidth;
-			uvRect.y *= invHeight;
-			uvRect.width *= invWidth;
-			uvRect.height *= invHeight;
+		Texture* texture = lastInfoIt->first;
+		RenderIndices& indices = lastInfoIt->second;
 
-			// Our glyph may be flipped in the atlas, to render it correctly we need to change the uv coordinates accordingly
-			const RectCorner normalCorners[4] = {RectCorner_LeftTop, RectCorner_RightTop, RectCorner_LeftBottom, RectCorner_RightBottom};
-			const RectCorner flippedCorners[4] = {RectCorner_LeftBottom, RectCorner_LeftTop, RectCorner_RightBottom, RectCorner_RightTop};
+		for (std::size_t i = firstGlyph; i < glyphCount; ++i)
+		{
+			if (drawer.GetGlyph(i).atlas != texture)
+				return false;
+		}
 
-			// Set the position, color and UV of our vertices
-			for (unsigned int j = 0; j < 4; ++j)
-			{
-				// Remember that indices->count is a counter here, not a count value
-				m_localVertices[indices->count * 4 + j].color = glyph.color;
-				m_localVertices[indices->count * 4 + j].position.Set(glyph.corners[j]);
-				m_localVertices[indices->count * 4 + j].uv.Set(uvRect.GetCorner((glyph.flipped) ? flippedCorners[j] : normalCorners[j]));
-			}
+		m_localVertices.resize(glyphCount * 4);
+		for (std::size_t i = firstGlyph; i < glyphCount; ++i)
+			MakeGlyphVertices(drawer.GetGlyph(i), texture, &m_localVertices[i * 4]);
 
-			// Increment the counter, go to next glyph
-			indices->count++;
-		}
+		m_quadRevisions.resize(glyphCount, ++m_revision);
 
-		m_localBounds = drawer.GetBounds();
+		indices.count += static_cast<unsigned int>(glyphCount - firstGlyph);
+		return true;
+	}
 
-		InvalidateBoundingVolume();
-		InvalidateInstanceData(0);
+	/*!
+	* \brief Makes the local vertices of a glyph
+	*
+	* \param glyph Glyph of the drawer
+	* \param texture Atlas layer of the glyph
+	* \param vertices Pointer to the four vertices to write
+	*/
 
-		clearOnFail.Reset();
+	void TextSprite::MakeGlyphVertices(const AbstractTextDrawer::Glyph& glyph, const Texture* texture, VertexStruct_XY_Color_UV* vertices)
+	{
+		// First, compute the uv coordinates from our atlas rect
+		Vector2ui size(texture->GetSize());
+		float invWidth = 1.f / size.x;
+		float invHeight = 1.f / size.y;
+
+		Rectf uvRect(glyph.atlasRect);
+		uvRect.x *= invWidth;
+		uvRect.y *= invHeight;
+		uvRect.width *= invWidth;
+		uvRect.height *= invHeight;
+
+		// Our glyph may be flipped in the atlas, to render it correctly we need to change the uv coordinates accordingly
+		const RectCorner normalCorners[4] = {RectCorner_LeftTop, RectCorner_RightTop, RectCorner_LeftBottom, RectCorner_RightBottom};
+		const RectCorner flippedCorners[4] = {RectCorner_LeftBottom, RectCorner_LeftTop, RectCorner_RightBottom, RectCorner_RightTop};
+
+		// Set the position, color and UV of our vertices
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			vertices[j].color = glyph.color;
+			vertices[j].position.Set(glyph.corners[j]);
+			vertices[j].uv.Set(uvRect.GetCorner((glyph.flipped) ? flippedCorners[j] : normalCorners[j]));
+		}
 	}
 
 	/*
@@ -263,61 +297,174 @@ namespace Nz
 			Vector2f scale = Vector2f(oldSize) / Vector2f(newSize); // ratio of the old one to the new one
 
 			// Now we will iterate through each coordinates of the concerned texture to multiply them by the ratio
-			SparsePtr<Vector2f> texCoordPtr(&m_localVertices[indices.first].uv, sizeof(VertexStruct_XYZ_Color_UV));
+			++m_revision;
 			for (unsigned int i = 0; i < indices.count; ++i)
 			{
 				for (unsigned int j = 0; j < 4; ++j)
-					m_localVertices[i*4 + j].uv *= scale;
+					m_localVertices[(indices.first + i) * 4 + j].uv *= scale;
+
+				m_quadRevisions[indices.first + i] = m_revision;
 			}
 
+			InvalidateVertices();
+
 			// We get rid off the old texture and we set the new one at the place (same for indices)
 			m_renderInfos.erase(it);
 			m_renderInfos.insert(std::make_pair(newTexture, std::move(indices)));
 		}
 	}
 
+	/*!
+	* \brief Updates the vertices of every glyph of the drawer
+	*
+	* \param drawer Drawer used to compose the text
+	* \param glyphCount Glyph count of the drawer
+	*
+	* \remark Only the quads whose vertices differ from the previous ones get a new revision
+	*/
+
+	void TextSprite::UpdateGlyphs(const AbstractTextDrawer& drawer, std::size_t glyphCount)
+	{
+		std::size_t previousGlyphCount = m_localVertices.size() / 4;
+
+		m_localVertices.resize(glyphCount * 4);
+		m_quadRevisions.resize(glyphCount);
+		++m_revision;
+
+		// Reset glyph count for every texture to zero
+		for (auto& pair : m_renderInfos)
+			pair.second.count = 0;
+
+		// Count glyph count for each texture
+		Texture* lastTexture = nullptr;
+		unsigned int* count = nullptr;
+		for (std::size_t i = 0; i < glyphCount; ++i)
+		{
+			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
+
+			Texture* texture = static_cast<Texture*>(glyph.atlas);
+			if (lastTexture != texture)
+			{
+				auto it = m_renderInfos.find(texture);
+				if (it == m_renderInfos.end())
+					it = m_renderInfos.insert(std::make_pair(texture, RenderIndices{0U, 0U})).first;
+
+				count = &it->second.count;
+				lastTexture = texture;
+			}
+
+			(*count)++;
+		}
+
+		// Attributes indices and reinitialize glyph count to zero to use it as a counter in the next loop
+		// This is because the 1st glyph can use texture A, the 2nd glyph can use texture B and the 3th glyph C can use texture A again
+		// so we need a counter to know where to write informations
+		// also remove unused render infos
+		unsigned int index = 0;
+		auto infoIt = m_renderInfos.begin();
+		while (infoIt != m_renderInfos.end())
+		{
+			RenderIndices& indices = infoIt->second;
+			if (indices.count == 0)
+				m_renderInfos.erase(infoIt++); //< No glyph uses this texture, remove from indices
+			else
+			{
+				indices.first = index;
+
+				index += indices.count;
+				indices.count = 0;
+				++infoIt;
+			}
+		}
+
+		lastTexture = nullptr;
+		RenderIndices* indices = nullptr;
+		for (unsigned int i = 0; i < glyphCount; ++i)
+		{
+			const AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
+
+			Texture* texture = static_cast<Texture*>(glyph.atlas);
+			if (lastTexture != texture)
+			{
+				indices = &m_renderInfos[texture]; //< We changed texture, adjust the pointer
+				lastTexture = texture;
+			}
+
+			// Remember that indices->count is a counter here, not a count value
+			std::size_t quadIndex = indices->first + indices->count;
+
+			VertexStruct_XY_Color_UV glyphVertices[4];
+			MakeGlyphVertices(glyph, texture, glyphVertices);
+
+			VertexStruct_XY_Color_UV* vertices = &m_localVertices[quadIndex * 4];
+			if (quadIndex >= previousGlyphCount || std::memcmp(vertices, glyphVertices, sizeof(glyphVertices)) != 0)
+			{
+				std::memcpy(vertices, glyphVertices, sizeof(glyphVertices));
+				m_quadRevisions[quadIndex] = m_revision;
+			}
+
+			// Increment the counter, go to next glyph
+			indices->count++;
+		}
+	}
+
 	/*!
 	* \brief Updates the data of the sprite
 	*
 	* \param instanceData Data of the instance
+	*
+	* \remark Only the quads modified since the last update of this instance are rebuilt, unless the instance has moved or the color or scale changed
 	*/
 
 	void TextSprite::UpdateData(InstanceData* instanceData) const
 	{
-		instanceData->data.resize(m_localVertices.size() * sizeof(VertexStruct_XYZ_Color_UV));
-		VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(instanceData->data.data());
+		std::size_t quadCount = m_localVertices.size() / 4;
+		const Matrix4f& transformMatrix = *instanceData->transformMatrix;
 
-		SparsePtr<Color> colorPtr(&vertices[0].color, sizeof(VertexStruct_XYZ_Color_UV));
-		SparsePtr<Vector3f> posPtr(&vertices[0].position, sizeof(VertexStruct_XYZ_Color_UV));
-		SparsePtr<Vector2f> texCoordPtr(&vertices[0].uv, sizeof(VertexStruct_XYZ_Color_UV));
+		bool fullUpdate = true;
+		UInt32 previousQuadCount = 0;
+		UInt32 previousRevision = 0;
+		if (instanceData->data.size() >= sizeof(InstanceHeader))
+		{
+			const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData->data.data());
+			fullUpdate = (header->color != m_color || header->scale != m_scale || header->transformMatrix != transformMatrix);
+			previousQuadCount = header->quadCount;
+			previousRevision = header->revision;
+		}
 
-		// We will not initialize the final vertices (those send to the RenderQueue)
-		// With the help of the coordinates axis, the matrix and our color attribute
-		for (auto& pair : m_renderInfos)
+		// Layout: header, then the final vertices (those sent to the RenderQueue)
+		instanceData->data.resize(sizeof(InstanceHeader) + m_localVertices.size() * sizeof(VertexStruct_XYZ_Color_UV));
+
+		InstanceHeader* header = reinterpret_cast<InstanceHeader*>(instanceData->data.data());
+		VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(header + 1);
+
+		for (std::size_t i = 0; i < quadCount; ++i)
 		{
-			RenderIndices& indices = pair.second;
-			if (indices.count == 0)
-				continue; //< Ignore empty render indices
+			if (!fullUpdate && i < previousQuadCount && m_quadRevisions[i] <= previousRevision)
+				continue;
 
-			SparsePtr<Color> color = colorPtr + indices.first * 4;
-			SparsePtr<Vector3f> pos = posPtr + indices.first * 4;
-			SparsePtr<Vector2f> uv = texCoordPtr + indices.first * 4;
-			VertexStruct_XY_Color_UV* localVertex = &m_localVertices[indices.first * 4];
-			for (unsigned int i = 0; i < indices.count; ++i)
+			// With the help of the coordinates axis, the matrix and our color attribute
+			const VertexStruct_XY_Color_UV* localVertex = &m_localVertices[i * 4];
+			VertexStruct_XYZ_Color_UV* vertex = &vertices[i * 4];
+			for (unsigned int j = 0; j < 4; ++j)
 			{
-				for (unsigned int j = 0; j < 4; ++j)
-				{
-					Vector3f localPos = localVertex->position.x*Vector3f::Right() + localVertex->position.y*Vector3f::Down();
-					localPos *= m_scale;
+				Vector3f localPos = localVertex->position.x*Vector3f::Right() + localVertex->position.y*Vector3f::Down();
+				localPos *= m_scale;
 
-					*pos++ = instanceData->transformMatrix->Transform(localPos);
-					*color++ = m_color * localVertex->color;
-					*uv++ = localVertex->uv;
+				vertex->position = transformMatrix.Transform(localPos);
+				vertex->color = m_color * localVertex->color;
+				vertex->uv = localVertex->uv;
 
-					localVertex++;
-				}
+				localVertex++;
+				vertex++;
 			}
 		}
+
+		header->transformMatrix = transformMatrix;
+		header->color = m_color;
+		header->scale = m_scale;
+		header->quadCount = static_cast<UInt32>(quadCount);
+		header->revision = m_revision;
 	}
 
 	TextSpriteLibrary::LibraryMap TextSprite::s_library;
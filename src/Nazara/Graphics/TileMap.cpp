@@ -6,17 +6,26 @@
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/AbstractViewer.hpp>
 #include <Nazara/Math/Rect.hpp>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		const unsigned int s_chunkSize = 16; // Tiles per side of a chunk
+	}
+
 	/*!
 	* \ingroup graphics
 	* \class Nz::TileMap
 	* \brief Graphics class that represent several tiles of the same size assembled into a grid
 	*  This class is far more efficient than using a sprite for every tile
+	*
+	* The tiles are grouped into square chunks, each instance caches the vertices of every chunk and only rebuilds those modified since its last update.
+	* Chunks outside of the frustum of the render queue viewer are not sent to the render queue.
 	*/
 
 	/*!
@@ -27,67 +36,227 @@ namespace Nz
 	*/
 	void TileMap::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
 	{
-		const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(instanceData.data.data());
+		std::size_t chunkCount = m_chunks.size();
+		std::size_t layerCount = m_layers.size();
 
-		std::size_t spriteCount = 0;
-		for (const Layer& layer : m_layers)
+		const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData.data.data());
+		NazaraAssert(header->chunkCount == chunkCount && header->layerCount == layerCount, "Instance data is not up to date");
+		NazaraUnused(header);
+
+		const Boxf* chunkBoxes = reinterpret_cast<const Boxf*>(header + 1);
+		const UInt32* layerSpriteCounts = reinterpret_cast<const UInt32*>(chunkBoxes + chunkCount);
+		const VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<const VertexStruct_XYZ_Color_UV*>(layerSpriteCounts + chunkCount * layerCount);
+
+		// Without a viewer (as for shadow maps), every chunk is queued
+		const AbstractViewer* viewer = renderQueue->GetViewer();
+
+		for (std::size_t i = 0; i < chunkCount; ++i)
 		{
-			if (layer.material)
-				renderQueue->AddSprites(instanceData.renderOrder, layer.material, &vertices[spriteCount], layer.tiles.size());
+			if (viewer && !viewer->GetFrustum().Contains(chunkBoxes[i]))
+			{
+				renderQueue->ReportCulledObjects(1);
+				continue;
+			}
 
-			spriteCount += layer.tiles.size();
+			std::size_t firstVertex = m_chunks[i].firstVertex;
+			for (std::size_t layerIndex = 0; layerIndex < layerCount; ++layerIndex)
+			{
+				UInt32 spriteCount = layerSpriteCounts[i * layerCount + layerIndex];
+				if (spriteCount == 0)
+					continue;
+
+				const Layer& layer = m_layers[layerIndex];
+				if (layer.material)
+					renderQueue->AddSprites(instanceData.renderOrder, layer.material, &vertices[firstVertex], spriteCount);
+
+				firstVertex += 4 * spriteCount;
+			}
 		}
 	}
 
+	/*!
+	* \brief Marks the chunk of a tile as modified
+	*
+	* \param tileIndex Index of the modified tile
+	*/
+	void TileMap::InvalidateTile(std::size_t tileIndex)
+	{
+		std::size_t chunkCountX = (m_mapSize.x + s_chunkSize - 1) / s_chunkSize;
+		std::size_t chunkX = (tileIndex % m_mapSize.x) / s_chunkSize;
+		std::size_t chunkY = (tileIndex / m_mapSize.x) / s_chunkSize;
+
+		m_chunks[chunkY * chunkCountX + chunkX].revision = ++m_revision;
+	}
+
+	/*!
+	* \brief Marks every chunk as modified
+	*/
+	void TileMap::InvalidateTiles()
+	{
+		++m_revision;
+		for (Chunk& chunk : m_chunks)
+			chunk.revision = m_revision;
+	}
+
 	void TileMap::MakeBoundingVolume() const
 	{
 		Nz::Vector2f size = GetSize();
 		m_boundingVolume.Set(Vector3f(0.f), size.x*Vector3f::Right() + size.y*Vector3f::Down());
 	}
 
-	void TileMap::UpdateData(InstanceData* instanceData) const
+	/*!
+	* \brief Splits the map into chunks of s_chunkSize * s_chunkSize tiles (or less on the borders)
+	*
+	* The vertices of a chunk are stored contiguously, four per tile of the chunk
+	*/
+	void TileMap::MakeChunks()
 	{
-		std::size_t spriteCount = 0;
-		for (const Layer& layer : m_layers)
-			spriteCount += layer.tiles.size();
+		unsigned int chunkCountX = (m_mapSize.x + s_chunkSize - 1) / s_chunkSize;
+		unsigned int chunkCountY = (m_mapSize.y + s_chunkSize - 1) / s_chunkSize;
 
-		instanceData->data.resize(4 * spriteCount * sizeof(VertexStruct_XYZ_Color_UV));
-		VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(instanceData->data.data());
+		m_chunks.clear();
+		m_chunks.reserve(chunkCountX * chunkCountY);
 
-		spriteCount = 0;
-		for (const Layer& layer : m_layers)
+		std::size_t firstVertex = 0;
+		for (unsigned int y = 0; y < chunkCountY; ++y)
 		{
-			SparsePtr<Color> colorPtr(&vertices[spriteCount].color, sizeof(VertexStruct_XYZ_Color_UV));
-			SparsePtr<Vector3f> posPtr(&vertices[spriteCount].position, sizeof(VertexStruct_XYZ_Color_UV));
-			SparsePtr<Vector2f> texCoordPtr(&vertices[spriteCount].uv, sizeof(VertexStruct_XYZ_Color_UV));
+			for (unsigned int x = 0; x < chunkCountX; ++x)
+			{
+				Chunk chunk;
+				chunk.firstTile.Set(x * s_chunkSize, y * s_chunkSize);
+				chunk.tileCount.Set(std::min(m_mapSize.x - chunk.firstTile.x, s_chunkSize), std::min(m_mapSize.y - chunk.firstTile.y, s_chunkSize));
+				chunk.firstVertex = firstVertex;
+				chunk.revision = m_revision;
+
+				firstVertex += 4 * chunk.tileCount.x * chunk.tileCount.y;
 
-			for (std::size_t tileIndex : layer.tiles)
+				m_chunks.push_back(chunk);
+			}
+		}
+	}
+
+	/*!
+	* \brief Builds the vertices of the enabled tiles of a chunk, grouped by layer
+	*
+	* \param chunk Chunk to build
+	* \param transformMatrix Matrix of the instance
+	* \param layerSpriteCounts Array receiving the number of tiles of each layer in the chunk
+	* \param vertices Vertices of the chunk
+	*/
+	void TileMap::UpdateChunk(const Chunk& chunk, const Matrix4f& transformMatrix, UInt32* layerSpriteCounts, VertexStruct_XYZ_Color_UV* vertices) const
+	{
+		std::size_t layerCount = m_layers.size();
+		std::fill(layerSpriteCounts, layerSpriteCounts + layerCount, 0U);
+
+		for (unsigned int y = 0; y < chunk.tileCount.y; ++y)
+		{
+			const Tile* tile = &m_tiles[(chunk.firstTile.y + y) * m_mapSize.x + chunk.firstTile.x];
+			for (unsigned int x = 0; x < chunk.tileCount.x; ++x, ++tile)
 			{
-				const Tile& tile = m_tiles[tileIndex];
-				NazaraAssert(tile.enabled, "Tile specified for rendering is not enabled");
+				if (tile->enabled)
+					layerSpriteCounts[tile->layerIndex]++;
+			}
+		}
+
+		// Sprite index where each layer begins in the chunk
+		std::vector<std::size_t> layerCursors(layerCount);
+
+		std::size_t spriteCount = 0;
+		for (std::size_t i = 0; i < layerCount; ++i)
+		{
+			layerCursors[i] = spriteCount;
+			spriteCount += layerSpriteCounts[i];
+		}
+
+		for (unsigned int y = 0; y < chunk.tileCount.y; ++y)
+		{
+			unsigned int tileY = chunk.firstTile.y + y;
+
+			const Tile* tile = &m_tiles[tileY * m_mapSize.x + chunk.firstTile.x];
+			for (unsigned int x = 0; x < chunk.tileCount.x; ++x, ++tile)
+			{
+				if (!tile->enabled)
+					continue;
+
+				unsigned int tileX = chunk.firstTile.x + x;
+				Vector3f tileLeftCorner(tileX * m_tileSize.x, tileY * -m_tileSize.y, 0.f);
+
+				VertexStruct_XYZ_Color_UV* vertex = &vertices[4 * layerCursors[tile->layerIndex]++];
+
+				vertex->color = tile->color;
+				vertex->position = transformMatrix.Transform(tileLeftCorner);
+				vertex->uv = tile->textureCoords.GetCorner(RectCorner_LeftTop);
+				vertex++;
+
+				vertex->color = tile->color;
+				vertex->position = transformMatrix.Transform(tileLeftCorner + m_tileSize.x * Vector3f::Right());
+				vertex->uv = tile->textureCoords.GetCorner(RectCorner_RightTop);
+				vertex++;
 
-				std::size_t x = tileIndex % m_mapSize.x;
-				std::size_t y = tileIndex / m_mapSize.x;
-				Vector3f tileLeftCorner(x * m_tileSize.x, y * -m_tileSize.y, 0.f);
+				vertex->color = tile->color;
+				vertex->position = transformMatrix.Transform(tileLeftCorner + m_tileSize.y * Vector3f::Down());
+				vertex->uv = tile->textureCoords.GetCorner(RectCorner_LeftBottom);
+				vertex++;
 
-				*colorPtr++ = tile.color;
-				*posPtr++ = instanceData->transformMatrix->Transform(tileLeftCorner);
-				*texCoordPtr++ = tile.textureCoords.GetCorner(RectCorner_LeftTop);
+				vertex->color = tile->color;
+				vertex->position = transformMatrix.Transform(tileLeftCorner + m_tileSize.x * Vector3f::Right() + m_tileSize.y * Vector3f::Down());
+				vertex->uv = tile->textureCoords.GetCorner(RectCorner_RightBottom);
+			}
+		}
+	}
 
-				*colorPtr++ = tile.color;
-				*posPtr++ = instanceData->transformMatrix->Transform(tileLeftCorner + m_tileSize.x * Vector3f::Right());
-				*texCoordPtr++ = tile.textureCoords.GetCorner(RectCorner_RightTop);
+	/*!
+	* \brief Updates the vertices cached by an instance
+	*
+	* \param instanceData Data of the instance
+	*
+	* \remark Only the chunks modified since the last update of this instance are rebuilt, unless the instance has moved
+	*/
+	void TileMap::UpdateData(InstanceData* instanceData) const
+	{
+		std::size_t chunkCount = m_chunks.size();
+		std::size_t layerCount = m_layers.size();
 
-				*colorPtr++ = tile.color;
-				*posPtr++ = instanceData->transformMatrix->Transform(tileLeftCorner + m_tileSize.y * Vector3f::Down());
-				*texCoordPtr++ = tile.textureCoords.GetCorner(RectCorner_LeftBottom);
+		// Layout: header, world AABB of each chunk, sprite count of each layer of each chunk, vertices of each chunk
+		std::size_t dataSize = sizeof(InstanceHeader) + chunkCount * sizeof(Boxf) + chunkCount * layerCount * sizeof(UInt32) + 4 * m_tiles.size() * sizeof(VertexStruct_XYZ_Color_UV);
+		const Matrix4f& transformMatrix = *instanceData->transformMatrix;
 
-				*colorPtr++ = tile.color;
-				*posPtr++ = instanceData->transformMatrix->Transform(tileLeftCorner + m_tileSize.x * Vector3f::Right() + m_tileSize.y * Vector3f::Down());
-				*texCoordPtr++ = tile.textureCoords.GetCorner(RectCorner_RightBottom);
+		bool fullUpdate = true;
+		if (instanceData->data.size() == dataSize)
+		{
+			const InstanceHeader* header = reinterpret_cast<const InstanceHeader*>(instanceData->data.data());
+			fullUpdate = (header->chunkCount != chunkCount || header->layerCount != layerCount || header->transformMatrix != transformMatrix);
+		}
+		else
+			instanceData->data.resize(dataSize);
+
+		InstanceHeader* header = reinterpret_cast<InstanceHeader*>(instanceData->data.data());
+		Boxf* chunkBoxes = reinterpret_cast<Boxf*>(header + 1);
+		UInt32* layerSpriteCounts = reinterpret_cast<UInt32*>(chunkBoxes + chunkCount);
+		VertexStruct_XYZ_Color_UV* vertices = reinterpret_cast<VertexStruct_XYZ_Color_UV*>(layerSpriteCounts + chunkCount * layerCount);
+
+		for (std::size_t i = 0; i < chunkCount; ++i)
+		{
+			const Chunk& chunk = m_chunks[i];
+
+			if (fullUpdate)
+			{
+				Vector3f topLeft(chunk.firstTile.x * m_tileSize.x, chunk.firstTile.y * -m_tileSize.y, 0.f);
+				Vector3f bottomRight = topLeft + (chunk.tileCount.x * m_tileSize.x) * Vector3f::Right() + (chunk.tileCount.y * m_tileSize.y) * Vector3f::Down();
+
+				chunkBoxes[i].Set(topLeft, bottomRight);
+				chunkBoxes[i].Transform(transformMatrix);
 			}
-			spriteCount += layer.tiles.size();
+			else if (chunk.revision <= header->revision)
+				continue;
+
+			UpdateChunk(chunk, transformMatrix, &layerSpriteCounts[i * layerCount], &vertices[chunk.firstVertex]);
 		}
+
+		header->transformMatrix = transformMatrix;
+		header->chunkCount = static_cast<UInt32>(chunkCount);
+		header->layerCount = static_cast<UInt32>(layerCount);
+		header->revision = m_revision;
 	}
 
 	bool TileMap::Initialize()
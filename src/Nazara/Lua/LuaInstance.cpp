@@ -6,13 +6,21 @@
 #include <Lua/lauxlib.h>
 #include <Lua/lua.h>
 #include <Lua/lualib.h>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/MemoryHelper.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Core/StringStream.hpp>
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include <unordered_map>
 #include <Nazara/Lua/Debug.hpp>
@@ -129,17 +137,165 @@ namespace Nz
 		};
 
 		static_assert(sizeof(s_types)/sizeof(int) == LuaType_Max+1, "Lua type array is incomplete");
+
+		constexpr UInt32 BytecodeCacheFileMagic = 0x4E4C4232; // "NLB2"
+		constexpr std::size_t BytecodeDigestSize = 20; // SHA1
+
+		// Lua does not verify bytecode, a damaged file must never reach luaL_loadbufferx
+		struct BytecodeCacheFileHeader
+		{
+			UInt32 magic;
+			UInt32 size;
+			UInt8 digest[BytecodeDigestSize]; //< Of the bytecode following the header
+		};
+
+		static_assert(sizeof(BytecodeCacheFileHeader) == 2 * sizeof(UInt32) + BytecodeDigestSize, "Bytecode cache header must not be padded");
+
+		// Compiled chunks shared by every instance, by content hash
+		std::unordered_map<String, ByteArray> s_bytecodeCache;
+		Mutex s_bytecodeCacheMutex;
+		std::atomic<UInt32> s_bytecodeCacheFileCounter(0);
+
+		int BytecodeWriter(lua_State* state, const void* data, std::size_t size, void* userdata)
+		{
+			NazaraUnused(state);
+
+			static_cast<ByteArray*>(userdata)->Append(data, size);
+			return 0;
+		}
+
+		ByteArray ComputeBytecodeDigest(const ByteArray& bytecode)
+		{
+			std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_SHA1);
+			hash->Begin();
+			hash->Append(bytecode.GetConstBuffer(), bytecode.GetSize());
+
+			return hash->End();
+		}
+
+		String GetBytecodeCacheFilePath(const String& contentHash)
+		{
+			return File::NormalizePath(LuaInstance::GetBytecodeCacheDirectory() + NAZARA_DIRECTORY_SEPARATOR + contentHash + ".luac");
+		}
+
+		void DiscardBytecodeCacheFile(File& file)
+		{
+			// Removed so that the next save can take its place, even where a rename does not replace an existing file
+			NazaraWarning("Bytecode cache file " + file.GetPath() + " is corrupted, ignoring it");
+
+			ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
+
+			file.Close();
+			File::Delete(file.GetPath());
+		}
+
+		String GetFrameName(const lua_Debug& info)
+		{
+			String name;
+			if (info.name)
+				name = info.name;
+			else if (std::strcmp(info.what, "main") == 0)
+				name = "main chunk";
+			else
+				name = '?';
+
+			if (std::strcmp(info.what, "C") == 0)
+				name += " [C]";
+			else
+				name += " (" + String(info.short_src) + ':' + String::Number(info.linedefined) + ')';
+
+			// Frames of a folded stack are separated by semicolons
+			name.Replace(';', ':');
+
+			return name;
+		}
+
+		bool LoadBytecodeCacheFile(const String& contentHash, ByteArray* bytecode)
+		{
+			File file(GetBytecodeCacheFilePath(contentHash));
+			if (!file.Exists() || !file.Open(OpenMode_ReadOnly))
+				return false;
+
+			BytecodeCacheFileHeader header;
+			if (file.Read(&header, sizeof(header)) != sizeof(header) || header.magic != BytecodeCacheFileMagic || header.size != file.GetSize() - sizeof(header))
+			{
+				DiscardBytecodeCacheFile(file);
+				return false;
+			}
+
+			bytecode->Resize(header.size);
+			if (file.Read(bytecode->GetBuffer(), header.size) != header.size)
+			{
+				DiscardBytecodeCacheFile(file);
+				bytecode->Clear();
+				return false;
+			}
+
+			ByteArray digest = ComputeBytecodeDigest(*bytecode);
+			if (digest.GetSize() != BytecodeDigestSize || std::memcmp(digest.GetConstBuffer(), header.digest, BytecodeDigestSize) != 0)
+			{
+				DiscardBytecodeCacheFile(file);
+				bytecode->Clear();
+				return false;
+			}
+
+			return true;
+		}
+
+		void SaveBytecodeCacheFile(const String& contentHash, const ByteArray& bytecode)
+		{
+			BytecodeCacheFileHeader header;
+			header.magic = BytecodeCacheFileMagic;
+			header.size = static_cast<UInt32>(bytecode.GetSize());
+
+			ByteArray digest = ComputeBytecodeDigest(bytecode);
+			std::memcpy(header.digest, digest.GetConstBuffer(), BytecodeDigestSize);
+
+			// Written under a name of its own then renamed, so a reader (or another process) never sees a partial file
+			String filePath = GetBytecodeCacheFilePath(contentHash);
+			String tempFilePath = filePath + '.' + String::Number(GetElapsedMicroseconds()) + '-' + String::Number(s_bytecodeCacheFileCounter++) + ".tmp";
+
+			{
+				File file(tempFilePath);
+				if (!file.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+				{
+					NazaraWarning("Failed to write bytecode cache file " + file.GetPath());
+					return;
+				}
+
+				if (file.Write(&header, sizeof(header)) != sizeof(header) || file.Write(bytecode.GetConstBuffer(), bytecode.GetSize()) != bytecode.GetSize())
+				{
+					NazaraWarning("Failed to write bytecode cache file " + file.GetPath());
+					file.Close();
+					File::Delete(tempFilePath);
+					return;
+				}
+			}
+
+			// Atomic replacement on POSIX systems, elsewhere the rename fails if another writer got there first, with the same bytecode
+			ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowExceptionDisabled);
+
+			if (!File::Rename(tempFilePath, filePath))
+				File::Delete(tempFilePath);
+		}
 	}
 
 	LuaInstance::LuaInstance() :
 	m_memoryLimit(0),
 	m_memoryUsage(0),
+	m_profilerLastSample(0),
+	m_profilerSampleCount(0),
+	m_profilerInstructionInterval(1000),
+	m_profilerMicrosecondInterval(0),
+	m_profilerRunning(false),
 	m_timeLimit(1000),
 	m_level(0)
 	{
+		m_freeBlocks.fill(nullptr);
+
 		m_state = lua_newstate(MemoryAllocator, this);
 		lua_atpanic(m_state, AtPanic);
-		lua_sethook(m_state, TimeLimiter, LUA_MASKCOUNT, 1000);
+		UpdateHook();
 		luaL_openlibs(m_state);
 	}
 
@@ -413,7 +569,10 @@ namespace Nz
 
 		file.Close();
 
-		return Execute(source);
+		if (!LoadChunk(source.GetConstBuffer(), length, '@' + filePath))
+			return false;
+
+		return Run(0, 0);
 	}
 
 	bool LuaInstance::ExecuteFromMemory(const void* data, std::size_t size)
@@ -478,11 +637,41 @@ namespace Nz
 		return m_memoryLimit;
 	}
 
+	const LuaMemoryStats& LuaInstance::GetMemoryStats() const
+	{
+		return m_memoryStats;
+	}
+
 	UInt32 LuaInstance::GetMemoryUsage() const
 	{
 		return m_memoryUsage;
 	}
 
+	const std::unordered_map<String, LuaFunctionSamples>& LuaInstance::GetProfilerFunctions() const
+	{
+		return m_profilerFunctions;
+	}
+
+	String LuaInstance::GetProfilerReport() const
+	{
+		// Folded stacks ("outer;inner samples" by line), as read by flamegraph.pl or speedscope
+		String report;
+		for (const auto& pair : m_profilerStacks)
+		{
+			report += pair.first;
+			report += ' ';
+			report += String::Number(pair.second);
+			report += '\n';
+		}
+
+		return report;
+	}
+
+	UInt64 LuaInstance::GetProfilerSampleCount() const
+	{
+		return m_profilerSampleCount;
+	}
+
 	LuaType LuaInstance::GetMetatable(const char* tname) const
 	{
 		return FromLuaType(luaL_getmetatable(m_state, tname));
@@ -498,6 +687,16 @@ namespace Nz
 		return lua_getmetatable(m_state, index) != 0;
 	}
 
+	LuaType LuaInstance::GetRawField(long long n, int tableIndex) const
+	{
+		return FromLuaType(lua_rawgeti(m_state, tableIndex, n));
+	}
+
+	LuaType LuaInstance::GetRawField(const void* key, int tableIndex) const
+	{
+		return FromLuaType(lua_rawgetp(m_state, tableIndex, key));
+	}
+
 	unsigned int LuaInstance::GetStackTop() const
 	{
 		return lua_gettop(m_state);
@@ -586,6 +785,11 @@ namespace Nz
 		return IsOfType(index, tname.GetConstBuffer());
 	}
 
+	bool LuaInstance::IsProfilerRunning() const
+	{
+		return m_profilerRunning;
+	}
+
 	bool LuaInstance::IsValid(int index) const
 	{
 		return lua_isnoneornil(m_state, index) == 0;
@@ -714,6 +918,13 @@ namespace Nz
 		lua_replace(m_state, index);
 	}
 
+	void LuaInstance::ResetProfiler()
+	{
+		m_profilerFunctions.clear();
+		m_profilerStacks.clear();
+		m_profilerSampleCount = 0;
+	}
+
 	void LuaInstance::SetField(const char* name, int tableIndex) const
 	{
 		lua_setfield(m_state, tableIndex, name);
@@ -754,6 +965,16 @@ namespace Nz
 		m_memoryLimit = memoryLimit;
 	}
 
+	void LuaInstance::SetRawField(long long n, int tableIndex) const
+	{
+		lua_rawseti(m_state, tableIndex, n);
+	}
+
+	void LuaInstance::SetRawField(const void* key, int tableIndex) const
+	{
+		lua_rawsetp(m_state, tableIndex, key);
+	}
+
 	void LuaInstance::SetTable(int index) const
 	{
 		lua_settable(m_state, index);
@@ -763,15 +984,32 @@ namespace Nz
 	{
 		if (m_timeLimit != timeLimit)
 		{
-			if (m_timeLimit == 0)
-				lua_sethook(m_state, TimeLimiter, LUA_MASKCOUNT, 1000);
-			else if (timeLimit == 0)
-				lua_sethook(m_state, TimeLimiter, 0, 1000);
-
 			m_timeLimit = timeLimit;
+
+			UpdateHook();
 		}
 	}
 
+	// Samples are taken by the instruction hook every instructionInterval instructions, or at the first hook call once microsecondInterval is elapsed
+	void LuaInstance::StartProfiler(UInt32 instructionInterval, UInt32 microsecondInterval)
+	{
+		NazaraAssert(instructionInterval > 0, "Instruction interval must be over zero");
+
+		m_profilerInstructionInterval = instructionInterval;
+		m_profilerLastSample = GetElapsedMicroseconds();
+		m_profilerMicrosecondInterval = microsecondInterval;
+		m_profilerRunning = true;
+
+		UpdateHook();
+	}
+
+	void LuaInstance::StopProfiler()
+	{
+		m_profilerRunning = false;
+
+		UpdateHook();
+	}
+
 	bool LuaInstance::ToBoolean(int index) const
 	{
 		return lua_toboolean(m_state, index) != 0;
@@ -824,6 +1062,17 @@ namespace Nz
 		return luaL_testudata(m_state, index, tname.GetConstBuffer());
 	}
 
+	void LuaInstance::ClearBytecodeCache()
+	{
+		LockGuard lock(s_bytecodeCacheMutex);
+		s_bytecodeCache.clear();
+	}
+
+	const String& LuaInstance::GetBytecodeCacheDirectory()
+	{
+		return s_bytecodeCacheDirectory;
+	}
+
 	int LuaInstance::GetIndexOfUpValue(int upValue)
 	{
 		return lua_upvalueindex(upValue);
@@ -837,6 +1086,124 @@ namespace Nz
 		return instance;
 	}
 
+	int LuaInstance::GetRegistryIndex()
+	{
+		return LUA_REGISTRYINDEX;
+	}
+
+	void LuaInstance::SetBytecodeCacheDirectory(const String& directory)
+	{
+		s_bytecodeCacheDirectory = directory;
+	}
+
+	void* LuaInstance::AllocateBlock(std::size_t size)
+	{
+		if (size > PoolMaxBlockSize)
+			return std::malloc(size);
+
+		std::size_t sizeClass = (size - 1) / PoolGranularity;
+		if (!m_freeBlocks[sizeClass])
+		{
+			std::size_t blockSize = (sizeClass + 1) * PoolGranularity;
+			std::size_t blockCount = PoolChunkSize / blockSize;
+
+			m_poolChunks.emplace_back(new UInt8[blockCount * blockSize]);
+			m_memoryStats.poolCapacity += blockCount * blockSize;
+
+			UInt8* chunk = m_poolChunks.back().get();
+			for (std::size_t i = blockCount; i-- > 0;)
+			{
+				void* block = &chunk[i * blockSize];
+				*static_cast<void**>(block) = m_freeBlocks[sizeClass];
+				m_freeBlocks[sizeClass] = block;
+			}
+		}
+
+		void* block = m_freeBlocks[sizeClass];
+		m_freeBlocks[sizeClass] = *static_cast<void**>(block);
+		m_memoryStats.pooledAllocationCount++;
+
+		return block;
+	}
+
+	void LuaInstance::FreeBlock(void* block, std::size_t size)
+	{
+		if (size > PoolMaxBlockSize)
+		{
+			std::free(block);
+			return;
+		}
+
+		std::size_t sizeClass = (size - 1) / PoolGranularity;
+		*static_cast<void**>(block) = m_freeBlocks[sizeClass];
+		m_freeBlocks[sizeClass] = block;
+	}
+
+	bool LuaInstance::LoadChunk(const void* source, std::size_t size, const String& chunkName)
+	{
+		// Bytecode is only valid for the Lua version and number types which produced it, and embeds the chunk name
+		std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_SHA1);
+		hash->Begin();
+
+		UInt32 header[3] = {LUA_VERSION_NUM, sizeof(lua_Integer), sizeof(lua_Number)};
+		hash->Append(reinterpret_cast<const UInt8*>(header), sizeof(header));
+		hash->Append(reinterpret_cast<const UInt8*>(chunkName.GetConstBuffer()), chunkName.GetSize() + 1);
+		hash->Append(static_cast<const UInt8*>(source), size);
+
+		String contentHash = hash->End().ToHex();
+
+		ByteArray bytecode;
+		{
+			LockGuard lock(s_bytecodeCacheMutex);
+
+			auto it = s_bytecodeCache.find(contentHash);
+			if (it != s_bytecodeCache.end())
+				bytecode = it->second;
+		}
+
+		bool fromDisk = false;
+		if (bytecode.IsEmpty() && !s_bytecodeCacheDirectory.IsEmpty())
+			fromDisk = LoadBytecodeCacheFile(contentHash, &bytecode);
+
+		if (!bytecode.IsEmpty())
+		{
+			if (luaL_loadbufferx(m_state, reinterpret_cast<const char*>(bytecode.GetConstBuffer()), bytecode.GetSize(), chunkName.GetConstBuffer(), "b") == 0)
+			{
+				if (fromDisk)
+				{
+					LockGuard lock(s_bytecodeCacheMutex);
+					s_bytecodeCache[contentHash] = std::move(bytecode);
+				}
+
+				return true;
+			}
+
+			NazaraWarning("Failed to load cached bytecode of " + chunkName + ": " + lua_tostring(m_state, -1));
+			lua_pop(m_state, 1);
+
+			bytecode.Clear();
+		}
+
+		if (luaL_loadbufferx(m_state, static_cast<const char*>(source), size, chunkName.GetConstBuffer(), "t") != 0)
+		{
+			m_lastError = lua_tostring(m_state, -1);
+			lua_pop(m_state, 1);
+
+			return false;
+		}
+
+		// Debug informations are kept, error messages and tracebacks stay the same as with the source
+		lua_dump(m_state, BytecodeWriter, &bytecode, 0);
+
+		if (!s_bytecodeCacheDirectory.IsEmpty())
+			SaveBytecodeCacheFile(contentHash, bytecode);
+
+		LockGuard lock(s_bytecodeCacheMutex);
+		s_bytecodeCache[contentHash] = std::move(bytecode);
+
+		return true;
+	}
+
 	bool LuaInstance::Run(int argCount, int resultCount)
 	{
 		if (m_level++ == 0)
@@ -857,34 +1224,127 @@ namespace Nz
 		return true;
 	}
 
+	void LuaInstance::TakeProfilerSample(lua_State* state)
+	{
+		m_profilerFrames.clear();
+
+		lua_Debug info;
+		for (int level = 0; lua_getstack(state, level, &info) != 0; ++level)
+		{
+			lua_getinfo(state, "Sn", &info);
+			m_profilerFrames.push_back(GetFrameName(info));
+		}
+
+		if (m_profilerFrames.empty())
+			return;
+
+		m_profilerSampleCount++;
+		m_profilerFunctions[m_profilerFrames.front()].exclusiveSamples++;
+
+		String stack;
+		for (auto it = m_profilerFrames.rbegin(); it != m_profilerFrames.rend(); ++it)
+		{
+			// A recursive function counts once by sample
+			if (std::find(it + 1, m_profilerFrames.rend(), *it) == m_profilerFrames.rend())
+				m_profilerFunctions[*it].inclusiveSamples++;
+
+			if (!stack.IsEmpty())
+				stack += ';';
+
+			stack += *it;
+		}
+
+		m_profilerStacks[stack]++;
+	}
+
+	void LuaInstance::UpdateHook()
+	{
+		// The time limit and the profiler share the count hook, the time limit is then checked at the profiler rate
+		int mask = (m_timeLimit != 0 || m_profilerRunning) ? LUA_MASKCOUNT : 0;
+		int count = (m_profilerRunning) ? static_cast<int>(m_profilerInstructionInterval) : 1000;
+
+		lua_sethook(m_state, InstructionHook, mask, count);
+	}
+
+	void LuaInstance::InstructionHook(lua_State* state, lua_Debug* debug)
+	{
+		NazaraUnused(debug);
+
+		LuaInstance* instance = GetInstance(state);
+		if (instance->m_profilerRunning)
+		{
+			if (instance->m_profilerMicrosecondInterval == 0)
+				instance->TakeProfilerSample(state);
+			else
+			{
+				UInt64 now = GetElapsedMicroseconds();
+				if (now - instance->m_profilerLastSample >= instance->m_profilerMicrosecondInterval)
+				{
+					instance->m_profilerLastSample = now;
+					instance->TakeProfilerSample(state);
+				}
+			}
+		}
+
+		if (instance->m_timeLimit != 0 && instance->m_clock.GetMilliseconds() > instance->m_timeLimit)
+			luaL_error(state, "maximum execution time exceeded");
+	}
+
 	void* LuaInstance::MemoryAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
 	{
 		LuaInstance* instance = static_cast<LuaInstance*>(ud);
 		std::size_t& memoryLimit = instance->m_memoryLimit;
 		std::size_t& memoryUsage = instance->m_memoryUsage;
 
+		LuaMemoryStats& stats = instance->m_memoryStats;
+
 		if (nsize == 0)
 		{
-			memoryUsage -= osize;
-			std::free(ptr);
+			if (ptr)
+			{
+				memoryUsage -= osize;
+				instance->FreeBlock(ptr, osize);
+				stats.freeCount++;
+			}
 
 			return nullptr;
 		}
 		else
 		{
-			std::size_t usage = memoryUsage + nsize;
-			if (ptr)
-				usage -= osize;
+			// Without a block, osize is the type of the object being created
+			if (!ptr)
+				osize = 0;
 
+			std::size_t usage = memoryUsage + nsize - osize;
 			if (memoryLimit != 0 && usage > memoryLimit)
 			{
 				NazaraError("Lua memory usage is over memory limit (" + String::Number(usage) + " > " + String::Number(memoryLimit) + ')');
 				return nullptr;
 			}
 
+			void* block;
+			if (osize > PoolMaxBlockSize && nsize > PoolMaxBlockSize)
+				block = std::realloc(ptr, nsize);
+			else if (ptr && osize <= PoolMaxBlockSize && nsize <= PoolMaxBlockSize && (osize - 1) / PoolGranularity == (nsize - 1) / PoolGranularity)
+				block = ptr; //< Same size class
+			else
+			{
+				block = instance->AllocateBlock(nsize);
+				if (block && ptr)
+				{
+					std::memcpy(block, ptr, std::min(osize, nsize));
+					instance->FreeBlock(ptr, osize);
+				}
+			}
+
+			if (!block)
+				return nullptr;
+
 			memoryUsage = usage;
+			stats.allocationCount++;
+			stats.peakUsage = std::max(stats.peakUsage, usage);
 
-			return std::realloc(ptr, nsize);
+			return block;
 		}
 	}
 
@@ -894,12 +1354,5 @@ namespace Nz
 		return func(*GetInstance(state));
 	}
 
-	void LuaInstance::TimeLimiter(lua_State* state, lua_Debug* debug)
-	{
-		NazaraUnused(debug);
-
-		LuaInstance* instance = GetInstance(state);
-		if (instance->m_clock.GetMilliseconds() > instance->m_timeLimit)
-			luaL_error(state, "maximum execution time exceeded");
-	}
+	String LuaInstance::s_bytecodeCacheDirectory;
 }
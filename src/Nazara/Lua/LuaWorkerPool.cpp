@@ -0,0 +1,167 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Lua scripting module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Lua/LuaWorkerPool.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <iterator>
+#include <Nazara/Lua/Debug.hpp>
+
+namespace Nz
+{
+	// The instances are all built here, so that the initializer (ex: Ndk::LuaAPI::RegisterClasses) never runs concurrently
+	LuaWorkerPool::LuaWorkerPool(const Initializer& initializer)
+	{
+		std::size_t instanceCount = TaskScheduler::GetWorkerCount() + 1;
+
+		m_instances.reserve(instanceCount);
+		for (std::size_t i = 0; i < instanceCount; ++i)
+		{
+			m_instances.emplace_back(std::make_unique<LuaInstance>());
+			if (initializer)
+				initializer(*m_instances.back());
+		}
+	}
+
+	LuaWorkerPool::~LuaWorkerPool()
+	{
+		// Jobs reference the pool
+		WaitForJobs();
+	}
+
+	// Calls the global function functionName with the input as a string, the string it returns is posted as the result of the job
+	TaskHandle LuaWorkerPool::Call(const String& functionName, ByteArray input, UInt64 jobId)
+	{
+		return Dispatch([this, functionName, input = std::move(input), jobId](LuaInstance& instance)
+		{
+			CallFunction(instance, functionName, input, jobId);
+		});
+	}
+
+	// Runs the code on every instance (to define the functions called by the jobs), must not be called while jobs are running
+	bool LuaWorkerPool::Execute(const String& code)
+	{
+		for (auto& instance : m_instances)
+		{
+			if (!instance->Execute(code))
+			{
+				NazaraError("Failed to execute code: " + instance->GetLastError());
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// The file is compiled once, the other instances get its bytecode from the cache of LuaInstance
+	bool LuaWorkerPool::ExecuteFromFile(const String& filePath)
+	{
+		for (auto& instance : m_instances)
+		{
+			if (!instance->ExecuteFromFile(filePath))
+			{
+				NazaraError("Failed to execute \"" + filePath + "\": " + instance->GetLastError());
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool LuaWorkerPool::PollResult(Result* result)
+	{
+		NazaraAssert(result, "Invalid result");
+
+		LockGuard lock(m_resultMutex);
+
+		if (m_results.empty())
+			return false;
+
+		*result = std::move(m_results.front());
+		m_results.pop_front();
+
+		return true;
+	}
+
+	// Moves every result posted so far at the end of the vector, cheaper than polling them one by one
+	std::size_t LuaWorkerPool::PollResults(std::vector<Result>* results)
+	{
+		NazaraAssert(results, "Invalid results");
+
+		LockGuard lock(m_resultMutex);
+
+		std::size_t resultCount = m_results.size();
+		results->insert(results->end(), std::make_move_iterator(m_results.begin()), std::make_move_iterator(m_results.end()));
+		m_results.clear();
+
+		return resultCount;
+	}
+
+	// Can be called from the jobs
+	void LuaWorkerPool::PostResult(Result result)
+	{
+		LockGuard lock(m_resultMutex);
+
+		m_results.emplace_back(std::move(result));
+	}
+
+	// Jobs are dispatched and waited for by the thread owning the pool
+	void LuaWorkerPool::WaitForJobs()
+	{
+		TaskScheduler::Wait(m_jobs);
+		m_jobs.clear();
+	}
+
+	void LuaWorkerPool::CallFunction(LuaInstance& instance, const String& functionName, const ByteArray& input, UInt64 jobId)
+	{
+		Result result;
+		result.jobId = jobId;
+
+		if (instance.GetGlobal(functionName) == LuaType_Function)
+		{
+			instance.PushString(reinterpret_cast<const char*>(input.GetConstBuffer()), input.GetSize());
+			if (instance.Call(1, 1))
+			{
+				std::size_t length;
+				const char* output = instance.ToString(-1, &length);
+				if (output)
+					result.data = ByteArray(output, length);
+
+				instance.Pop();
+
+				result.succeeded = true;
+			}
+			else
+				result.error = instance.GetLastError();
+		}
+		else
+		{
+			instance.Pop();
+
+			result.error = '"' + functionName + "\" is not a function";
+		}
+
+		PostResult(std::move(result));
+	}
+
+	// A worker always gets its own instance, the threads helping while they wait on a task share the last one
+	// Jobs must not wait on other tasks, the worker could run another job on the same instance meanwhile
+	LuaInstance& LuaWorkerPool::LockInstance()
+	{
+		std::size_t index = TaskScheduler::GetWorkerIndex();
+		if (index + 1 < m_instances.size())
+			return *m_instances[index];
+
+		m_externalMutex.Lock();
+
+		return *m_instances.back();
+	}
+
+	void LuaWorkerPool::UnlockInstance(LuaInstance& instance)
+	{
+		if (&instance == m_instances.back().get())
+			m_externalMutex.Unlock();
+	}
+}
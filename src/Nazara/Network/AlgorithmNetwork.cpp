@@ -4,6 +4,7 @@
 
 #include <Nazara/Network/Algorithm.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
 #include <cstring>
 #include <Nazara/Network/Debug.hpp>
 
@@ -11,6 +12,50 @@ namespace Nz
 {
 	namespace Detail
 	{
+		/*!
+		* \brief Reads a variable-length integer (seven bits per byte, the high bit telling whether more bytes follow)
+		* \return true If successful
+		*
+		* \param ptr Pointer to the integer, moved past it
+		* \param end End of the buffer
+		* \param value Integer read
+		*/
+
+		bool ReadVarInt(const UInt8*& ptr, const UInt8* end, std::size_t* value)
+		{
+			std::size_t result = 0;
+			for (unsigned int shift = 0; shift < 8 * sizeof(std::size_t); shift += 7)
+			{
+				if (ptr == end)
+					return false;
+
+				UInt8 byte = *ptr++;
+				result |= static_cast<std::size_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					*value = result;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		/*!
+		* \brief Writes a variable-length integer
+		*
+		* \param output Byte array to append the integer to
+		* \param value Integer to write
+		*/
+
+		void WriteVarInt(ByteArray* output, std::size_t value)
+		{
+			for (; value >= 0x80; value >>= 7)
+				output->PushBack(static_cast<UInt8>(value | 0x80));
+
+			output->PushBack(static_cast<UInt8>(value));
+		}
+
 		/*!
 		* \brief Parses a decimal number
 		* \return true If successful
@@ -79,7 +124,136 @@ namespace Nz
 	}
 
 	/*!
-    * \ingroup network
+	* \ingroup network
+	* \brief Decodes data encoded by EncodeDelta
+	* \return true If the delta is valid
+	*
+	* \param reference Data the delta was computed against
+	* \param referenceSize Size of the reference
+	* \param delta Encoded delta
+	* \param deltaSize Size of the delta
+	* \param data Byte array receiving the decoded data
+	*
+	* \remark Produces a NazaraAssert if data is invalid
+	*/
+
+	bool DecodeDelta(const void* reference, std::size_t referenceSize, const void* delta, std::size_t deltaSize, ByteArray* data)
+	{
+		NazaraAssert(reference || referenceSize == 0, "Invalid reference");
+		NazaraAssert(delta || deltaSize == 0, "Invalid delta");
+		NazaraAssert(data, "Invalid data");
+
+		const UInt8* referenceBytes = static_cast<const UInt8*>(reference);
+		const UInt8* ptr = static_cast<const UInt8*>(delta);
+		const UInt8* end = ptr + deltaSize;
+
+		std::size_t dataSize;
+		if (!Detail::ReadVarInt(ptr, end, &dataSize) || dataSize > referenceSize + deltaSize)
+			return false; //< Bytes past the reference are always stored in the delta
+
+		data->Resize(dataSize);
+		UInt8* output = data->GetBuffer();
+
+		std::size_t position = 0;
+		while (position < dataSize)
+		{
+			std::size_t unchangedCount;
+			std::size_t changedCount;
+			if (!Detail::ReadVarInt(ptr, end, &unchangedCount) || !Detail::ReadVarInt(ptr, end, &changedCount))
+				return false;
+
+			std::size_t unchangedLimit = std::min(dataSize, referenceSize);
+			if (unchangedCount + changedCount == 0 || unchangedCount > ((position < unchangedLimit) ? unchangedLimit - position : 0))
+				return false;
+
+			if (changedCount > dataSize - position - unchangedCount || changedCount > static_cast<std::size_t>(end - ptr))
+				return false;
+
+			if (unchangedCount > 0)
+			{
+				std::memcpy(&output[position], &referenceBytes[position], unchangedCount);
+				position += unchangedCount;
+			}
+
+			for (std::size_t i = 0; i < changedCount; ++i, ++position)
+				output[position] = *ptr++ ^ ((position < referenceSize) ? referenceBytes[position] : 0);
+		}
+
+		return ptr == end;
+	}
+
+	/*!
+	* \ingroup network
+	* \brief Encodes data against a reference, typically the last snapshot the peer acknowledged
+	*
+	* Both are XORed together, runs of unchanged bytes are then stored as their length and changed bytes as their XOR.
+	* Data which barely changes from the reference shrinks to a few bytes, and what is left compresses well.
+	*
+	* \param reference Data the peer already has, bytes past its end are stored as they are
+	* \param referenceSize Size of the reference, zero to encode data on its own
+	* \param data Data to encode
+	* \param dataSize Size of the data
+	* \param delta Byte array receiving the encoded delta (its content is replaced)
+	*
+	* \remark Produces a NazaraAssert if delta is invalid
+	*/
+
+	void EncodeDelta(const void* reference, std::size_t referenceSize, const void* data, std::size_t dataSize, ByteArray* delta)
+	{
+		NazaraAssert(reference || referenceSize == 0, "Invalid reference");
+		NazaraAssert(data || dataSize == 0, "Invalid data");
+		NazaraAssert(delta, "Invalid delta");
+
+		// Isolated unchanged bytes cost less inside a run of changed bytes than as a run of their own
+		constexpr std::size_t MinUnchangedRun = 3;
+
+		const UInt8* referenceBytes = static_cast<const UInt8*>(reference);
+		const UInt8* dataBytes = static_cast<const UInt8*>(data);
+
+		auto Difference = [&](std::size_t position) -> UInt8
+		{
+			return dataBytes[position] ^ ((position < referenceSize) ? referenceBytes[position] : 0);
+		};
+
+		auto IsUnchanged = [&](std::size_t position)
+		{
+			return position < referenceSize && dataBytes[position] == referenceBytes[position];
+		};
+
+		delta->Clear(true);
+		Detail::WriteVarInt(delta, dataSize);
+
+		std::size_t position = 0;
+		while (position < dataSize)
+		{
+			std::size_t unchangedStart = position;
+			while (position < dataSize && IsUnchanged(position))
+				++position;
+
+			std::size_t changedStart = position;
+			std::size_t unchangedCount = 0;
+			for (; position < dataSize; ++position)
+			{
+				if (!IsUnchanged(position))
+					unchangedCount = 0;
+				else if (++unchangedCount == MinUnchangedRun)
+				{
+					// These unchanged bytes start the next run
+					position -= MinUnchangedRun - 1;
+					break;
+				}
+			}
+
+			Detail::WriteVarInt(delta, changedStart - unchangedStart);
+			Detail::WriteVarInt(delta, position - changedStart);
+
+			for (std::size_t i = changedStart; i < position; ++i)
+				delta->PushBack(Difference(i));
+		}
+	}
+
+	/*!
+	* \ingroup network
 	* \brief Parse a textual IPv4 or IPv6 address
 	* \return true If successful
 	*
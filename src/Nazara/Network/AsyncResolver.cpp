@@ -0,0 +1,341 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/AsyncResolver.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Network/ResolveState.hpp>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+#include <Nazara/Network/Win32/IpAddressImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+#include <Nazara/Network/Posix/IpAddressImpl.hpp>
+#else
+#error Missing implementation: Network
+#endif
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr std::size_t MaxCacheSize = 256;
+		constexpr unsigned int ResolverThreadCount = 2; //< Resolutions spend their time waiting for the network, few threads are enough
+
+		struct CacheEntry
+		{
+			std::vector<HostnameInfo> results;
+			String hostname;
+			String service;
+			UInt64 expirationTime;
+		};
+
+		struct ResolverData
+		{
+			std::deque<ResolveState*> requests;
+			std::unordered_map<IpAddress, CacheEntry> addressCache;
+			std::unordered_map<String, CacheEntry> hostnameCache;
+			std::vector<Thread> threads;
+			ConditionVariable requestCondition;
+			Mutex mutex;
+			UInt64 cacheDuration = 60'000'000; //< 60s, the system resolver does not give the TTL of records
+			bool shouldStop = false;
+		};
+
+		ResolverData* s_resolver = nullptr;
+
+		String GetHostnameKey(const ResolveState* state)
+		{
+			return String::Number(state->protocol) + ':' + state->service + ':' + state->hostname;
+		}
+
+		template<typename K>
+		const CacheEntry* FindInCache(std::unordered_map<K, CacheEntry>& cache, const K& key, UInt64 currentTime)
+		{
+			auto it = cache.find(key);
+			if (it == cache.end())
+				return nullptr;
+
+			if (currentTime >= it->second.expirationTime)
+			{
+				cache.erase(it);
+				return nullptr;
+			}
+
+			return &it->second;
+		}
+
+		template<typename K>
+		void StoreInCache(std::unordered_map<K, CacheEntry>& cache, const K& key, const ResolveState* state, UInt64 currentTime)
+		{
+			if (s_resolver->cacheDuration == 0)
+				return;
+
+			// Expired entries are only removed once the cache gets big
+			if (cache.size() >= MaxCacheSize)
+			{
+				for (auto it = cache.begin(); it != cache.end();)
+				{
+					if (currentTime >= it->second.expirationTime)
+						it = cache.erase(it);
+					else
+						++it;
+				}
+
+				if (cache.size() >= MaxCacheSize)
+					cache.clear();
+			}
+
+			CacheEntry& entry = cache[key];
+			entry.expirationTime = currentTime + s_resolver->cacheDuration;
+			entry.hostname = state->hostname;
+			entry.results = state->results;
+			entry.service = state->service;
+		}
+	}
+
+	/*!
+	* \brief Removes every cached resolution
+	*/
+
+	void AsyncResolver::ClearCache()
+	{
+		if (!s_resolver)
+			return;
+
+		LockGuard lock(s_resolver->mutex);
+		s_resolver->addressCache.clear();
+		s_resolver->hostnameCache.clear();
+	}
+
+	/*!
+	* \brief Initializes the resolver, its threads are only started by the first resolution
+	* \return true
+	*/
+
+	bool AsyncResolver::Initialize()
+	{
+		s_resolver = new ResolverData;
+		return true;
+	}
+
+	/*!
+	* \brief Resolves the hostname of an address in the background
+	* \return Handle of the resolution
+	*
+	* \param address IP address to resolve
+	* \param callback Optional function called once the resolution is done
+	*/
+
+	ResolveHandle AsyncResolver::ResolveAddress(const IpAddress& address, ResolveCallback callback)
+	{
+		ResolveState* state = new ResolveState;
+		state->address = address;
+		state->callback = std::move(callback);
+		state->isReverse = true;
+
+		return Submit(state);
+	}
+
+	/*!
+	* \brief Resolves the addresses of a hostname in the background
+	* \return Handle of the resolution
+	*
+	* \param protocol Net protocol to use
+	* \param hostname Hostname to resolve
+	* \param service Service used (http, ...)
+	* \param callback Optional function called once the resolution is done
+	*/
+
+	ResolveHandle AsyncResolver::ResolveHostname(NetProtocol protocol, const String& hostname, const String& service, ResolveCallback callback)
+	{
+		ResolveState* state = new ResolveState;
+		state->callback = std::move(callback);
+		state->hostname = hostname;
+		state->protocol = protocol;
+		state->service = service;
+
+		return Submit(state);
+	}
+
+	/*!
+	* \brief Sets how long successful resolutions are cached
+	*
+	* \param msDuration Duration in milliseconds, zero to disable the cache
+	*/
+
+	void AsyncResolver::SetCacheDuration(UInt32 msDuration)
+	{
+		if (!s_resolver)
+			return;
+
+		LockGuard lock(s_resolver->mutex);
+		s_resolver->cacheDuration = msDuration * UInt64(1000);
+
+		if (msDuration == 0)
+		{
+			s_resolver->addressCache.clear();
+			s_resolver->hostnameCache.clear();
+		}
+	}
+
+	/*!
+	* \brief Stops the resolver threads, pending resolutions fail with ResolveError_NotInitialized
+	*/
+
+	void AsyncResolver::Uninitialize()
+	{
+		if (!s_resolver)
+			return;
+
+		{
+			LockGuard lock(s_resolver->mutex);
+			s_resolver->shouldStop = true;
+			s_resolver->requestCondition.SignalAll();
+		}
+
+		// Running resolutions cannot be interrupted, they end by themselves
+		for (Thread& thread : s_resolver->threads)
+			thread.Join();
+
+		for (ResolveState* state : s_resolver->requests)
+		{
+			state->error = ResolveError_NotInitialized;
+
+			Complete(state);
+			state->RemoveReference();
+		}
+
+		delete s_resolver;
+		s_resolver = nullptr;
+	}
+
+	/*!
+	* \brief Marks a resolution as done and calls its callback
+	*
+	* \param state State of the resolution
+	*/
+
+	void AsyncResolver::Complete(ResolveState* state)
+	{
+		state->doneMutex.Lock();
+		state->done.store(true, std::memory_order_release);
+		state->doneCondition.SignalAll();
+		state->doneMutex.Unlock();
+
+		if (state->callback)
+		{
+			state->AddReference();
+			state->callback(ResolveHandle(state));
+		}
+	}
+
+	/*!
+	* \brief Answers a resolution from the cache, or queues it for the resolver threads
+	* \return Handle of the resolution
+	*
+	* \param state State of the resolution, the handle takes ownership of its reference
+	*/
+
+	ResolveHandle AsyncResolver::Submit(ResolveState* state)
+	{
+		ResolveHandle handle(state);
+
+		if (!s_resolver)
+		{
+			state->error = ResolveError_NotInitialized;
+			Complete(state);
+
+			return handle;
+		}
+
+		bool isCached = false;
+		{
+			LockGuard lock(s_resolver->mutex);
+
+			UInt64 currentTime = GetElapsedMicroseconds();
+			const CacheEntry* entry;
+			if (state->isReverse)
+				entry = FindInCache(s_resolver->addressCache, state->address, currentTime);
+			else
+				entry = FindInCache(s_resolver->hostnameCache, GetHostnameKey(state), currentTime);
+
+			if (entry)
+			{
+				state->hostname = entry->hostname;
+				state->results = entry->results;
+				state->service = entry->service;
+
+				isCached = true;
+			}
+			else
+			{
+				if (s_resolver->threads.empty())
+				{
+					for (unsigned int i = 0; i < ResolverThreadCount; ++i)
+						s_resolver->threads.emplace_back(&AsyncResolver::ThreadMain);
+				}
+
+				state->AddReference(); //< Owned by the queue until resolved
+				s_resolver->requests.push_back(state);
+				s_resolver->requestCondition.Signal();
+			}
+		}
+
+		// Callbacks may start other resolutions, they are never called with the lock held
+		if (isCached)
+			Complete(state);
+
+		return handle;
+	}
+
+	/*!
+	* \brief Resolves queued requests until the resolver is uninitialized
+	*/
+
+	void AsyncResolver::ThreadMain()
+	{
+		for (;;)
+		{
+			ResolveState* state;
+			{
+				LockGuard lock(s_resolver->mutex);
+				while (s_resolver->requests.empty() && !s_resolver->shouldStop)
+					s_resolver->requestCondition.Wait(&s_resolver->mutex);
+
+				if (s_resolver->shouldStop)
+					return;
+
+				state = s_resolver->requests.front();
+				s_resolver->requests.pop_front();
+			}
+
+			if (state->isReverse)
+				IpAddressImpl::ResolveAddress(state->address, &state->hostname, &state->service, &state->error);
+			else
+				state->results = IpAddressImpl::ResolveHostname(state->protocol, state->hostname, state->service, &state->error);
+
+			if (state->error == ResolveError_NoError)
+			{
+				LockGuard lock(s_resolver->mutex);
+
+				UInt64 currentTime = GetElapsedMicroseconds();
+				if (state->isReverse)
+					StoreInCache(s_resolver->addressCache, state->address, state, currentTime);
+				else
+					StoreInCache(s_resolver->hostnameCache, GetHostnameKey(state), state, currentTime);
+			}
+
+			Complete(state);
+			state->RemoveReference();
+		}
+	}
+}
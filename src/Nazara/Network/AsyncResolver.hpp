@@ -0,0 +1,42 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_ASYNCRESOLVER_HPP
+#define NAZARA_ASYNCRESOLVER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/ResolveHandle.hpp>
+
+namespace Nz
+{
+	struct ResolveState;
+
+	class AsyncResolver
+	{
+		public:
+			AsyncResolver() = delete;
+			~AsyncResolver() = delete;
+
+			static void ClearCache();
+
+			static bool Initialize();
+
+			static ResolveHandle ResolveAddress(const IpAddress& address, ResolveCallback callback);
+			static ResolveHandle ResolveHostname(NetProtocol protocol, const String& hostname, const String& service, ResolveCallback callback);
+
+			static void SetCacheDuration(UInt32 msDuration);
+
+			static void Uninitialize();
+
+		private:
+			static void Complete(ResolveState* state);
+			static ResolveHandle Submit(ResolveState* state);
+			static void ThreadMain();
+	};
+}
+
+#endif // NAZARA_ASYNCRESOLVER_HPP
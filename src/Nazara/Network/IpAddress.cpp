@@ -6,8 +6,10 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/StringStream.hpp>
 #include <Nazara/Network/Algorithm.hpp>
+#include <Nazara/Network/AsyncResolver.hpp>
 #include <algorithm>
 #include <limits>
+#include <utility>
 #include <Nazara/Network/SystemSocket.hpp>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
@@ -180,6 +182,15 @@ namespace Nz
 		return stream;
 	}
 
+	/*!
+	* \brief Removes every resolution cached by the asynchronous resolver
+	*/
+
+	void IpAddress::ClearResolveCache()
+	{
+		AsyncResolver::ClearCache();
+	}
+
 	/*!
 	* \brief Resolves the address based on the IP
 	* \return Hostname of the address
@@ -201,6 +212,26 @@ namespace Nz
 		return hostname;
 	}
 
+	/*!
+	* \brief Resolves the address based on the IP, without blocking
+	* \return Handle of the resolution, to poll or wait for the hostname and service
+	*
+	* \param address IP address to resolve
+	* \param callback Optional function called once the resolution is done
+	*
+	* \remark The callback is called from a resolver thread, or immediately from this one if the result is cached
+	* \remark Produces a NazaraAssert if address is invalid
+	*
+	* \see ResolveHostnameAsync
+	*/
+
+	ResolveHandle IpAddress::ResolveAddressAsync(const IpAddress& address, ResolveCallback callback)
+	{
+		NazaraAssert(address.IsValid(), "Invalid address");
+
+		return AsyncResolver::ResolveAddress(address, std::move(callback));
+	}
+
 	/*!
 	* \brief Resolves the address based on the hostname
 	* \return Informations about the host: IP(s) of the address, names, ...
@@ -220,6 +251,42 @@ namespace Nz
 		return IpAddressImpl::ResolveHostname(protocol, hostname, service, error);
 	}
 
+	/*!
+	* \brief Resolves the address based on the hostname, without blocking
+	* \return Handle of the resolution, to poll or wait for the informations about the host
+	*
+	* \param protocol Net protocol to use
+	* \param hostname Hostname to resolve
+	* \param service Specify the service used (http, ...)
+	* \param callback Optional function called once the resolution is done
+	*
+	* Resolutions run on a small pool of threads, successful ones are cached for a minute by default (see SetResolveCacheDuration).
+	* A callback calling SocketPoller::Wake lets a network loop waiting on a poller handle the results as soon as they are known.
+	*
+	* \remark The callback is called from a resolver thread, or immediately from this one if the result is cached
+	* \remark Produces a NazaraAssert if net protocol is set to unknown
+	*/
+
+	ResolveHandle IpAddress::ResolveHostnameAsync(NetProtocol protocol, const String& hostname, const String& service, ResolveCallback callback)
+	{
+		NazaraAssert(protocol != NetProtocol_Unknown, "Invalid protocol");
+
+		return AsyncResolver::ResolveHostname(protocol, hostname, service, std::move(callback));
+	}
+
+	/*!
+	* \brief Sets how long successful asynchronous resolutions are cached
+	*
+	* \param msDuration Duration in milliseconds, zero to disable the cache
+	*
+	* \remark The system resolver does not give the TTL of DNS records, this duration applies to every resolution
+	*/
+
+	void IpAddress::SetResolveCacheDuration(UInt32 msDuration)
+	{
+		AsyncResolver::SetCacheDuration(msDuration);
+	}
+
 	IpAddress IpAddress::AnyIpV4(0, 0, 0, 0);
 	IpAddress IpAddress::AnyIpV6(0, 0, 0, 0, 0, 0, 0, 0, 0);
 	IpAddress IpAddress::BroadcastIpV4(255, 255, 255, 255);
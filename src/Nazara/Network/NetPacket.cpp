@@ -3,12 +3,206 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Network/NetPacket.hpp>
-#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Buffers are recycled by size class, each thread keeps its own cache and exchanges magazines of buffers with a lock-free global pool
+		constexpr std::size_t BufferSizeClassCount = 5; //< 128, 512, 2048, 8192 and 32768 bytes
+		constexpr std::size_t MagazineSize = 32;
+		constexpr UInt32 MagazineCount = 1024; //< Buffers beyond MagazineCount * MagazineSize (plus the thread caches) are freed
+
+		struct Magazine
+		{
+			std::array<ByteArray*, MagazineSize> buffers;
+			std::atomic<UInt32> next;
+		};
+
+		std::unique_ptr<Magazine[]> s_magazines;
+		std::atomic<UInt64> s_emptyMagazines; // Tagged indices (ABA protection): [32 bits tag | 32 bits index + 1]
+		std::array<std::atomic<UInt64>, BufferSizeClassCount> s_fullMagazines;
+		std::atomic_bool s_isPoolInitialized(false);
+
+		// Thread caches only publish their statistics when they exchange a magazine
+		std::atomic<UInt64> s_acquiredBuffers;
+		std::atomic<UInt64> s_allocatedBuffers;
+		std::atomic<UInt64> s_releasedBuffers;
+		std::atomic<UInt64> s_reusedBuffers;
+
+		std::size_t GetSizeClassCapacity(std::size_t sizeClass)
+		{
+			return std::size_t(128) << (2 * sizeClass);
+		}
+
+		UInt32 PopMagazine(std::atomic<UInt64>& stack)
+		{
+			UInt64 head = stack.load(std::memory_order_acquire);
+			for (;;)
+			{
+				UInt32 index = static_cast<UInt32>(head & 0xFFFFFFFF);
+				if (index == 0)
+					return MagazineCount;
+
+				// The magazine may be popped and pushed again meanwhile, the tag makes the exchange fail if so
+				UInt32 next = s_magazines[index - 1].next.load(std::memory_order_relaxed);
+				UInt64 newHead = ((head >> 32) + 1) << 32 | next;
+				if (stack.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire))
+					return index - 1;
+			}
+		}
+
+		void PushMagazine(std::atomic<UInt64>& stack, UInt32 index)
+		{
+			Magazine& magazine = s_magazines[index];
+
+			UInt64 head = stack.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				magazine.next.store(static_cast<UInt32>(head & 0xFFFFFFFF), std::memory_order_relaxed);
+				UInt64 newHead = ((head >> 32) + 1) << 32 | (index + 1);
+				if (stack.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
+		}
+
+		struct BufferCache
+		{
+			~BufferCache()
+			{
+				Flush();
+			}
+
+			std::unique_ptr<ByteArray> Acquire(std::size_t minCapacity)
+			{
+				std::size_t sizeClass = 0;
+				while (sizeClass < BufferSizeClassCount - 1 && GetSizeClassCapacity(sizeClass) < minCapacity)
+					sizeClass++;
+
+				acquiredBuffers++;
+
+				if (counts[sizeClass] == 0 && !Refill(sizeClass))
+				{
+					allocatedBuffers++;
+
+					std::unique_ptr<ByteArray> buffer = std::make_unique<ByteArray>();
+					buffer->Reserve(GetSizeClassCapacity(sizeClass));
+					return buffer;
+				}
+
+				reusedBuffers++;
+				return std::unique_ptr<ByteArray>(buffers[sizeClass][--counts[sizeClass]]);
+			}
+
+			void Flush()
+			{
+				for (std::size_t sizeClass = 0; sizeClass < BufferSizeClassCount; ++sizeClass)
+				{
+					while (counts[sizeClass] > 0)
+					{
+						if (!PublishMagazine(sizeClass))
+						{
+							for (std::size_t i = 0; i < counts[sizeClass]; ++i)
+								delete buffers[sizeClass][i];
+
+							counts[sizeClass] = 0;
+						}
+					}
+				}
+
+				PublishStats();
+			}
+
+			void PublishStats()
+			{
+				s_acquiredBuffers.fetch_add(acquiredBuffers, std::memory_order_relaxed);
+				s_allocatedBuffers.fetch_add(allocatedBuffers, std::memory_order_relaxed);
+				s_releasedBuffers.fetch_add(releasedBuffers, std::memory_order_relaxed);
+				s_reusedBuffers.fetch_add(reusedBuffers, std::memory_order_relaxed);
+
+				acquiredBuffers = 0;
+				allocatedBuffers = 0;
+				releasedBuffers = 0;
+				reusedBuffers = 0;
+			}
+
+			bool PublishMagazine(std::size_t sizeClass)
+			{
+				if (!s_isPoolInitialized.load(std::memory_order_acquire))
+					return false;
+
+				UInt32 magazineIndex = PopMagazine(s_emptyMagazines);
+				if (magazineIndex == MagazineCount)
+					return false; //< The global pool is full
+
+				// Hands the oldest buffers over, so the most recently used ones stay in the cache
+				std::size_t count = std::min(counts[sizeClass], MagazineSize);
+
+				Magazine& magazine = s_magazines[magazineIndex];
+				std::copy(buffers[sizeClass].begin(), buffers[sizeClass].begin() + count, magazine.buffers.begin());
+				std::fill(magazine.buffers.begin() + count, magazine.buffers.end(), nullptr);
+				std::move(buffers[sizeClass].begin() + count, buffers[sizeClass].begin() + counts[sizeClass], buffers[sizeClass].begin());
+				counts[sizeClass] -= count;
+
+				PushMagazine(s_fullMagazines[sizeClass], magazineIndex);
+				PublishStats();
+				return true;
+			}
+
+			bool Refill(std::size_t sizeClass)
+			{
+				if (!s_isPoolInitialized.load(std::memory_order_acquire))
+					return false;
+
+				UInt32 magazineIndex = PopMagazine(s_fullMagazines[sizeClass]);
+				if (magazineIndex == MagazineCount)
+					return false;
+
+				Magazine& magazine = s_magazines[magazineIndex];
+				for (ByteArray* buffer : magazine.buffers)
+				{
+					if (buffer)
+						buffers[sizeClass][counts[sizeClass]++] = buffer;
+				}
+
+				PushMagazine(s_emptyMagazines, magazineIndex);
+				PublishStats();
+
+				return counts[sizeClass] > 0;
+			}
+
+			void Release(std::unique_ptr<ByteArray> buffer)
+			{
+				// Buffers are classified by what they can hold without reallocating
+				std::size_t capacity = buffer->GetCapacity();
+				std::size_t sizeClass = BufferSizeClassCount - 1;
+				while (sizeClass > 0 && GetSizeClassCapacity(sizeClass) > capacity)
+					sizeClass--;
+
+				releasedBuffers++;
+
+				if (counts[sizeClass] == buffers[sizeClass].size() && !PublishMagazine(sizeClass))
+					return; //< Freed with its unique_ptr
+
+				buffers[sizeClass][counts[sizeClass]++] = buffer.release();
+			}
+
+			std::array<std::array<ByteArray*, 2 * MagazineSize>, BufferSizeClassCount> buffers;
+			std::array<std::size_t, BufferSizeClassCount> counts = {};
+			UInt64 acquiredBuffers = 0;
+			UInt64 allocatedBuffers = 0;
+			UInt64 releasedBuffers = 0;
+			UInt64 reusedBuffers = 0;
+		};
+
+		thread_local BufferCache t_bufferCache;
+	}
+
 	/*!
 	* \ingroup network
 	* \class Nz::NetPacket
@@ -93,6 +287,29 @@ namespace Nz
 		return Serialize(context, packetSize) && Serialize(context, netCode);
 	}
 
+	/*!
+	* \brief Gets the statistics of the buffer pool
+	* \return Pool statistics
+	*
+	* \remark Other threads publish their statistics when they exchange buffers with the global pool, the values may lag behind
+	*/
+
+	NetPacket::BufferPoolStats NetPacket::GetBufferPoolStats()
+	{
+		t_bufferCache.PublishStats();
+
+		BufferPoolStats stats;
+		stats.acquiredBuffers = s_acquiredBuffers.load(std::memory_order_relaxed);
+		stats.allocatedBuffers = s_allocatedBuffers.load(std::memory_order_relaxed);
+		stats.reusedBuffers = s_reusedBuffers.load(std::memory_order_relaxed);
+
+		UInt64 releasedBuffers = s_releasedBuffers.load(std::memory_order_relaxed);
+		stats.outstandingBuffers = (stats.acquiredBuffers > releasedBuffers) ? stats.acquiredBuffers - releasedBuffers : 0;
+		stats.hitRate = (stats.acquiredBuffers > 0) ? static_cast<float>(stats.reusedBuffers) / stats.acquiredBuffers : 0.f;
+
+		return stats;
+	}
+
 	/*!
 	* \brief Operation to do when stream is empty
 	*/
@@ -111,10 +328,7 @@ namespace Nz
 		if (!m_buffer)
 			return;
 
-		std::size_t size = m_buffer->GetSize();
-
-		Nz::LockGuard lock(*s_availableBuffersMutex);
-		s_availableBuffers.emplace_back(std::make_pair(size, std::move(m_buffer)));
+		t_bufferCache.Release(std::move(m_buffer));
 	}
 
 	/*!
@@ -131,20 +345,9 @@ namespace Nz
 	{
 		NazaraAssert(minCapacity >= cursorPos, "Cannot init stream with a smaller capacity than wanted cursor pos");
 
-		{
-			Nz::LockGuard lock(*s_availableBuffersMutex);
-
-			FreeStream(); //< In case it wasn't released yet
-
-			if (!s_availableBuffers.empty())
-			{
-				m_buffer = std::move(s_availableBuffers.back().second);
-				s_availableBuffers.pop_back();
-			}
-		}
-
+		// A packet which is reset keeps its buffer
 		if (!m_buffer)
-			m_buffer = std::make_unique<ByteArray>();
+			m_buffer = t_bufferCache.Acquire(static_cast<std::size_t>(minCapacity));
 
 		m_buffer->Resize(static_cast<std::size_t>(cursorPos));
 
@@ -160,20 +363,46 @@ namespace Nz
 
 	bool NetPacket::Initialize()
 	{
-		s_availableBuffersMutex = std::make_unique<Mutex>();
+		s_magazines.reset(new Magazine[MagazineCount]);
+
+		s_emptyMagazines.store(0, std::memory_order_relaxed);
+		for (std::atomic<UInt64>& fullMagazines : s_fullMagazines)
+			fullMagazines.store(0, std::memory_order_relaxed);
+
+		for (UInt32 i = 0; i < MagazineCount; ++i)
+			PushMagazine(s_emptyMagazines, i);
+
+		s_acquiredBuffers = 0;
+		s_allocatedBuffers = 0;
+		s_releasedBuffers = 0;
+		s_reusedBuffers = 0;
+
+		s_isPoolInitialized.store(true, std::memory_order_release);
 		return true;
 	}
 
 	/*!
 	* \brief Uninitializes the NetPacket class
+	*
+	* \remark Caches of other threads are freed when these threads exit
 	*/
 
 	void NetPacket::Uninitialize()
 	{
-		s_availableBuffers.clear();
-		s_availableBuffersMutex.reset();
-	}
+		t_bufferCache.Flush();
+
+		s_isPoolInitialized.store(false, std::memory_order_release);
 
-	std::unique_ptr<Mutex> NetPacket::s_availableBuffersMutex;
-	std::vector<std::pair<std::size_t, std::unique_ptr<ByteArray>>> NetPacket::s_availableBuffers;
+		for (std::atomic<UInt64>& fullMagazines : s_fullMagazines)
+		{
+			UInt32 magazineIndex;
+			while ((magazineIndex = PopMagazine(fullMagazines)) != MagazineCount)
+			{
+				for (ByteArray* buffer : s_magazines[magazineIndex].buffers)
+					delete buffer;
+			}
+		}
+
+		s_magazines.reset();
+	}
 }
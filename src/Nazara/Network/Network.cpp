@@ -7,6 +7,7 @@
 #include <Nazara/Core/Core.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Network/AsyncResolver.hpp>
 #include <Nazara/Network/Config.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Network/RUdpConnection.hpp>
@@ -76,6 +77,12 @@ namespace Nz
 			return false;
 		}
 
+		if (!AsyncResolver::Initialize())
+		{
+			NazaraError("Failed to initialize asynchronous resolver");
+			return false;
+		}
+
 		onExit.Reset();
 
 		NazaraNotice("Initialized: Network module");
@@ -112,6 +119,7 @@ namespace Nz
 		s_moduleReferenceCounter = 0;
 
 		// Uninitialize module here
+		AsyncResolver::Uninitialize();
 		RUdpConnection::Uninitialize();
 		NetPacket::Uninitialize();
 		SocketImpl::Uninitialize();
@@ -7,9 +7,12 @@
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Network/Posix/IpAddressImpl.hpp>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <Nazara/Network/Debug.hpp>
 
@@ -17,6 +20,15 @@ namespace Nz
 {
 	constexpr int SOCKET_ERROR = -1;
 
+	namespace
+	{
+		#ifdef __linux__
+		constexpr std::size_t MaxDatagramBatch = 64; //< Datagrams sent or received by a single syscall
+		#endif
+		constexpr std::size_t MaxDatagramBuffers = 4; //< Buffers gathered in a single datagram
+		constexpr std::size_t MaxSendBuffers = 64; //< Buffers gathered by a single syscall
+	}
+
 	SocketHandle SocketImpl::Accept(SocketHandle handle, IpAddress* address, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -139,16 +151,14 @@ namespace Nz
 		if (state == SocketState_Connecting)
 		{
 			// http://developerweb.net/viewtopic.php?id=3196
-			fd_set localSet;
-			FD_ZERO(&localSet);
-			FD_SET(handle, &localSet);
-
-			timeval tv;
-			tv.tv_sec = static_cast<long>(msTimeout / 1000ULL);
-			tv.tv_usec = static_cast<long>((msTimeout % 1000ULL) * 1000ULL);
-
-			int ret = select(0, nullptr, &localSet, &localSet, (msTimeout > 0) ? &tv : nullptr);
-			if (ret == SOCKET_ERROR)
+			// poll has no limit on the handle value, unlike select
+			pollfd descriptor;
+			descriptor.events = POLLOUT;
+			descriptor.fd = handle;
+			descriptor.revents = 0;
+
+			int ret = poll(&descriptor, 1, (msTimeout > 0) ? static_cast<int>(msTimeout) : -1);
+			if (ret > 0)
 			{
 				int code = GetLastErrorCode(handle, error);
 				if (code < 0) //< GetLastErrorCode() failed
@@ -258,7 +268,8 @@ namespace Nz
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
 
-		u_long availableBytes;
+		// FIONREAD writes an int, a wider variable would keep garbage in its upper bytes
+		int availableBytes;
 		if (ioctl(handle, FIONREAD, &availableBytes) == SOCKET_ERROR)
 		{
 			if (error)
@@ -270,7 +281,7 @@ namespace Nz
 		if (error)
 			*error = SocketError_NoError;
 
-		return availableBytes;
+		return static_cast<std::size_t>(availableBytes);
 	}
 
 	bool SocketImpl::QueryBroadcasting(SocketHandle handle, SocketError* error)
@@ -497,6 +508,104 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::ReceiveMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, IpAddress* from, std::size_t* read, std::size_t* received, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		#ifdef __linux__
+		std::array<mmsghdr, MaxDatagramBatch> messages;
+		std::array<iovec, MaxDatagramBatch> vectors;
+		std::array<IpAddressImpl::SockAddrBuffer, MaxDatagramBatch> names;
+
+		std::size_t datagramCount = 0;
+		while (datagramCount < bufferCount)
+		{
+			unsigned int batchSize = static_cast<unsigned int>(std::min(bufferCount - datagramCount, MaxDatagramBatch));
+			for (unsigned int i = 0; i < batchSize; ++i)
+			{
+				const NetBuffer& buffer = buffers[datagramCount + i];
+				vectors[i].iov_base = buffer.data;
+				vectors[i].iov_len = buffer.dataLength;
+
+				std::memset(&messages[i], 0, sizeof(mmsghdr));
+				messages[i].msg_hdr.msg_name = names[i].data();
+				messages[i].msg_hdr.msg_namelen = static_cast<socklen_t>(names[i].size());
+				messages[i].msg_hdr.msg_iov = &vectors[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			// Only the first datagram may block, the following ones are read if they are already there
+			int messageCount = recvmmsg(handle, messages.data(), batchSize, (datagramCount == 0) ? MSG_WAITFORONE : MSG_DONTWAIT, nullptr);
+			if (messageCount == SOCKET_ERROR)
+			{
+				int errorCode = GetLastErrorCode();
+
+				// The error will be reported by the next call, once the received datagrams have been handled
+				if (errorCode == EWOULDBLOCK || datagramCount > 0)
+					break;
+
+				if (error)
+					*error = TranslateErrnoToResolveError(errorCode);
+
+				return false;
+			}
+
+			for (int i = 0; i < messageCount; ++i)
+			{
+				if (from)
+					from[datagramCount + i] = IpAddressImpl::FromSockAddr(reinterpret_cast<const sockaddr*>(names[i].data()));
+
+				if (read)
+					read[datagramCount + i] = messages[i].msg_len;
+			}
+
+			datagramCount += messageCount;
+			if (static_cast<unsigned int>(messageCount) < batchSize)
+				break;
+		}
+		#else
+		std::size_t datagramCount = 0;
+		for (; datagramCount < bufferCount; ++datagramCount)
+		{
+			const NetBuffer& buffer = buffers[datagramCount];
+
+			IpAddressImpl::SockAddrBuffer nameBuffer;
+			socklen_t nameLength = static_cast<socklen_t>(nameBuffer.size());
+
+			// Only the first datagram may block, the following ones are read if they are already there
+			int byteRead = recvfrom(handle, buffer.data, buffer.dataLength, (datagramCount == 0) ? 0 : MSG_DONTWAIT, reinterpret_cast<sockaddr*>(nameBuffer.data()), &nameLength);
+			if (byteRead == SOCKET_ERROR)
+			{
+				int errorCode = GetLastErrorCode();
+
+				// The error will be reported by the next call, once the received datagrams have been handled
+				if (errorCode == EWOULDBLOCK || datagramCount > 0)
+					break;
+
+				if (error)
+					*error = TranslateErrnoToResolveError(errorCode);
+
+				return false;
+			}
+
+			if (from)
+				from[datagramCount] = IpAddressImpl::FromSockAddr(reinterpret_cast<const sockaddr*>(nameBuffer.data()));
+
+			if (read)
+				read[datagramCount] = byteRead;
+		}
+		#endif
+
+		if (received)
+			*received = datagramCount;
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::Send(SocketHandle handle, const void* buffer, int length, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -520,6 +629,133 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		// Buffers past the limit are left to the next call, as are the bytes the socket did not accept
+		std::array<iovec, MaxSendBuffers> vectors;
+		std::size_t vectorCount = std::min(bufferCount, MaxSendBuffers);
+		for (std::size_t i = 0; i < vectorCount; ++i)
+		{
+			vectors[i].iov_base = buffers[i].data;
+			vectors[i].iov_len = buffers[i].dataLength;
+		}
+
+		msghdr message;
+		std::memset(&message, 0, sizeof(msghdr));
+		message.msg_iov = vectors.data();
+		message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(vectorCount);
+
+		ssize_t byteSent = sendmsg(handle, &message, 0);
+		if (byteSent == SOCKET_ERROR)
+		{
+			if (error)
+				*error = TranslateErrnoToResolveError(GetLastErrorCode());
+
+			return false; //< Error
+		}
+
+		if (sent)
+			*sent = static_cast<std::size_t>(byteSent);
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t buffersPerDatagram, std::size_t datagramCount, const IpAddress* to, std::size_t* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && to && datagramCount > 0, "Invalid buffers");
+		NazaraAssert(buffersPerDatagram > 0 && buffersPerDatagram <= MaxDatagramBuffers, "Invalid buffer count per datagram");
+
+		// Each datagram gathers its buffers (like a header shared by no other datagram followed by a shared payload)
+		#ifdef __linux__
+		std::array<mmsghdr, MaxDatagramBatch> messages;
+		std::array<iovec, MaxDatagramBatch * MaxDatagramBuffers> vectors;
+		std::array<IpAddressImpl::SockAddrBuffer, MaxDatagramBatch> names;
+
+		std::size_t sentCount = 0;
+		while (sentCount < datagramCount)
+		{
+			unsigned int batchSize = static_cast<unsigned int>(std::min(datagramCount - sentCount, MaxDatagramBatch));
+			for (unsigned int i = 0; i < batchSize; ++i)
+			{
+				iovec* datagramVectors = &vectors[i * buffersPerDatagram];
+				for (std::size_t j = 0; j < buffersPerDatagram; ++j)
+				{
+					const NetBuffer& buffer = buffers[(sentCount + i) * buffersPerDatagram + j];
+					datagramVectors[j].iov_base = buffer.data;
+					datagramVectors[j].iov_len = buffer.dataLength;
+				}
+
+				std::memset(&messages[i], 0, sizeof(mmsghdr));
+				messages[i].msg_hdr.msg_name = names[i].data();
+				messages[i].msg_hdr.msg_namelen = IpAddressImpl::ToSockAddr(to[sentCount + i], names[i].data());
+				messages[i].msg_hdr.msg_iov = datagramVectors;
+				messages[i].msg_hdr.msg_iovlen = static_cast<decltype(messages[i].msg_hdr.msg_iovlen)>(buffersPerDatagram);
+			}
+
+			// A datagram which cannot be sent stops the batch, its error is returned by the next call
+			int messageCount = sendmmsg(handle, messages.data(), batchSize, 0);
+			if (messageCount == SOCKET_ERROR)
+			{
+				if (error)
+					*error = TranslateErrnoToResolveError(GetLastErrorCode());
+
+				if (sent)
+					*sent = sentCount;
+
+				return false;
+			}
+
+			sentCount += messageCount;
+		}
+		#else
+		std::array<iovec, MaxDatagramBuffers> vectors;
+		IpAddressImpl::SockAddrBuffer nameBuffer;
+
+		for (std::size_t sentCount = 0; sentCount < datagramCount; ++sentCount)
+		{
+			for (std::size_t j = 0; j < buffersPerDatagram; ++j)
+			{
+				const NetBuffer& buffer = buffers[sentCount * buffersPerDatagram + j];
+				vectors[j].iov_base = buffer.data;
+				vectors[j].iov_len = buffer.dataLength;
+			}
+
+			msghdr message;
+			std::memset(&message, 0, sizeof(msghdr));
+			message.msg_name = nameBuffer.data();
+			message.msg_namelen = IpAddressImpl::ToSockAddr(to[sentCount], nameBuffer.data());
+			message.msg_iov = vectors.data();
+			message.msg_iovlen = static_cast<decltype(message.msg_iovlen)>(buffersPerDatagram);
+
+			if (sendmsg(handle, &message, 0) == SOCKET_ERROR)
+			{
+				if (error)
+					*error = TranslateErrnoToResolveError(GetLastErrorCode());
+
+				if (sent)
+					*sent = sentCount;
+
+				return false;
+			}
+		}
+		#endif
+
+		if (sent)
+			*sent = datagramCount;
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendTo(SocketHandle handle, const void* buffer, int length, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -0,0 +1,364 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Posix/SocketPollerImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	SocketPollerImpl::SocketPollerImpl()
+	{
+		#ifdef NAZARA_NETWORK_EPOLL
+		m_handle = epoll_create1(EPOLL_CLOEXEC);
+		#else
+		m_handle = kqueue();
+		#endif
+
+		if (m_handle == -1)
+			NazaraError("Failed to create poller: " + Error::GetLastSystemError());
+
+		// Other threads write to the pipe to interrupt a wait
+		if (pipe(m_wakeUpPipe) == 0)
+		{
+			for (int fd : m_wakeUpPipe)
+			{
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+				fcntl(fd, F_SETFD, FD_CLOEXEC);
+			}
+
+			RegisterWakeUp();
+		}
+		else
+		{
+			NazaraError("Failed to create wake up pipe: " + Error::GetLastSystemError());
+			m_wakeUpPipe[0] = -1;
+			m_wakeUpPipe[1] = -1;
+		}
+	}
+
+	SocketPollerImpl::~SocketPollerImpl()
+	{
+		if (m_handle != -1)
+			close(m_handle);
+
+		for (int fd : m_wakeUpPipe)
+		{
+			if (fd != -1)
+				close(fd);
+		}
+	}
+
+	void SocketPollerImpl::Clear()
+	{
+		// Closing the poller removes every socket at once
+		if (m_handle != -1)
+			close(m_handle);
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		m_handle = epoll_create1(EPOLL_CLOEXEC);
+		#else
+		m_handle = kqueue();
+		#endif
+
+		if (m_handle == -1)
+			NazaraError("Failed to create poller: " + Error::GetLastSystemError());
+
+		RegisterWakeUp();
+
+		m_readySockets.clear();
+		m_sockets.clear();
+	}
+
+	const std::vector<SocketPoller::ReadySocket>& SocketPollerImpl::GetReadySockets() const
+	{
+		return m_readySockets;
+	}
+
+	std::size_t SocketPollerImpl::GetSocketCount() const
+	{
+		return m_sockets.size();
+	}
+
+	UInt32 SocketPollerImpl::GetReadyFlags(SocketHandle socket) const
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end())
+			return SocketPollEvent_None;
+
+		return it->second.readyFlags;
+	}
+
+	bool SocketPollerImpl::IsRegistered(SocketHandle socket) const
+	{
+		return m_sockets.find(socket) != m_sockets.end();
+	}
+
+	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		epoll_event event;
+		event.data.fd = socket;
+		event.events = ((eventFlags & SocketPollEvent_Read) ? static_cast<UInt32>(EPOLLIN | EPOLLRDHUP) : 0U) |
+		               ((eventFlags & SocketPollEvent_Write) ? static_cast<UInt32>(EPOLLOUT) : 0U) |
+		               ((mode == SocketPollMode_EdgeTriggered) ? static_cast<UInt32>(EPOLLET) : 0U);
+
+		if (epoll_ctl(m_handle, EPOLL_CTL_ADD, socket, &event) == -1)
+		{
+			NazaraError("Failed to register socket: " + Error::GetLastSystemError());
+			return false;
+		}
+		#else
+		if (!Control(socket, SocketPollEvent_None, eventFlags, mode))
+			return false;
+		#endif
+
+		Registration& registration = m_sockets[socket];
+		registration.eventFlags = eventFlags;
+		registration.mode = mode;
+		registration.readyFlags = SocketPollEvent_None;
+		registration.readyIndex = 0;
+		registration.userdata = userdata;
+
+		return true;
+	}
+
+	void SocketPollerImpl::UnregisterSocket(SocketHandle socket)
+	{
+		auto it = m_sockets.find(socket);
+		NazaraAssert(it != m_sockets.end(), "Socket is not registered");
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		// Older kernels require a non-null event, even if it is ignored
+		epoll_event event;
+		if (epoll_ctl(m_handle, EPOLL_CTL_DEL, socket, &event) == -1)
+			NazaraWarning("Failed to unregister socket: " + Error::GetLastSystemError());
+		#else
+		Control(socket, it->second.eventFlags, SocketPollEvent_None, it->second.mode);
+		#endif
+
+		// The socket may not be valid anymore, it must not be reported by the last wait
+		if (it->second.readyFlags != SocketPollEvent_None)
+		{
+			std::size_t index = it->second.readyIndex;
+			m_readySockets.erase(m_readySockets.begin() + index);
+
+			for (std::size_t i = index; i < m_readySockets.size(); ++i)
+				m_sockets[m_readySockets[i].handle].readyIndex = i;
+		}
+
+		m_sockets.erase(it);
+	}
+
+	bool SocketPollerImpl::UpdateSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		auto it = m_sockets.find(socket);
+		NazaraAssert(it != m_sockets.end(), "Socket is not registered");
+
+		Registration& registration = it->second;
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		epoll_event event;
+		event.data.fd = socket;
+		event.events = ((eventFlags & SocketPollEvent_Read) ? static_cast<UInt32>(EPOLLIN | EPOLLRDHUP) : 0U) |
+		               ((eventFlags & SocketPollEvent_Write) ? static_cast<UInt32>(EPOLLOUT) : 0U) |
+		               ((mode == SocketPollMode_EdgeTriggered) ? static_cast<UInt32>(EPOLLET) : 0U);
+
+		if (epoll_ctl(m_handle, EPOLL_CTL_MOD, socket, &event) == -1)
+		{
+			NazaraError("Failed to update socket: " + Error::GetLastSystemError());
+			return false;
+		}
+		#else
+		// Filters have to be added again when the mode changes
+		UInt32 previousFlags = (mode == registration.mode) ? registration.eventFlags : SocketPollEvent_None;
+		if (mode != registration.mode)
+			Control(socket, registration.eventFlags, SocketPollEvent_None, registration.mode);
+
+		if (!Control(socket, previousFlags, eventFlags, mode))
+			return false;
+		#endif
+
+		registration.eventFlags = eventFlags;
+		registration.mode = mode;
+		registration.userdata = userdata;
+
+		return true;
+	}
+
+	std::size_t SocketPollerImpl::Wait(int msTimeout, SocketError* error)
+	{
+		for (const SocketPoller::ReadySocket& readySocket : m_readySockets)
+			m_sockets[readySocket.handle].readyFlags = SocketPollEvent_None;
+
+		m_readySockets.clear();
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		m_events.resize(m_sockets.size() + 1); //< Wake up pipe
+
+		int eventCount = epoll_wait(m_handle, m_events.data(), static_cast<int>(m_events.size()), msTimeout);
+		#else
+		// Read and write readiness are reported by two different filters
+		m_events.resize(2 * m_sockets.size() + 1);
+
+		timespec timeout;
+		timeout.tv_sec = msTimeout / 1000;
+		timeout.tv_nsec = (msTimeout % 1000) * 1000000L;
+
+		int eventCount = kevent(m_handle, nullptr, 0, m_events.data(), static_cast<int>(m_events.size()), (msTimeout >= 0) ? &timeout : nullptr);
+		#endif
+
+		if (eventCount == -1)
+		{
+			int errorCode = SocketImpl::GetLastErrorCode();
+
+			// A signal interrupting the wait is not an error
+			if (error)
+				*error = (errorCode == EINTR) ? SocketError_NoError : SocketImpl::TranslateErrnoToResolveError(errorCode);
+
+			return 0;
+		}
+
+		for (int i = 0; i < eventCount; ++i)
+		{
+			#ifdef NAZARA_NETWORK_EPOLL
+			const epoll_event& event = m_events[i];
+			if (event.data.fd == m_wakeUpPipe[0])
+			{
+				DrainWakeUp();
+				continue;
+			}
+
+			// Errors and hang-ups are reported to both directions, the next read or write returns them
+			UInt32 eventFlags = SocketPollEvent_None;
+			if (event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+				eventFlags |= SocketPollEvent_Read;
+
+			if (event.events & (EPOLLOUT | EPOLLHUP | EPOLLERR))
+				eventFlags |= SocketPollEvent_Write;
+
+			ReportEvents(event.data.fd, eventFlags);
+			#else
+			const struct kevent& event = m_events[i];
+			if (static_cast<int>(event.ident) == m_wakeUpPipe[0])
+			{
+				DrainWakeUp();
+				continue;
+			}
+
+			UInt32 eventFlags = SocketPollEvent_None;
+			if (event.flags & EV_ERROR)
+				eventFlags = SocketPollEvent_Read | SocketPollEvent_Write;
+			else if (event.filter == EVFILT_READ)
+				eventFlags = SocketPollEvent_Read;
+			else if (event.filter == EVFILT_WRITE)
+				eventFlags = SocketPollEvent_Write;
+
+			ReportEvents(static_cast<SocketHandle>(event.ident), eventFlags);
+			#endif
+		}
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return m_readySockets.size();
+	}
+
+	void SocketPollerImpl::Wake()
+	{
+		// A full pipe already wakes the poller up
+		UInt8 byte = 0;
+		if (write(m_wakeUpPipe[1], &byte, sizeof(byte)) == -1 && errno != EAGAIN)
+			NazaraWarning("Failed to wake poller up: " + Error::GetLastSystemError());
+	}
+
+	#ifndef NAZARA_NETWORK_EPOLL
+	bool SocketPollerImpl::Control(SocketHandle socket, UInt32 previousFlags, UInt32 eventFlags, SocketPollMode mode)
+	{
+		struct kevent changes[2];
+		int changeCount = 0;
+
+		auto UpdateFilter = [&](UInt32 flag, short filter)
+		{
+			if (eventFlags & flag)
+				EV_SET(&changes[changeCount++], socket, filter, EV_ADD | ((mode == SocketPollMode_EdgeTriggered) ? EV_CLEAR : 0), 0, 0, nullptr);
+			else if (previousFlags & flag)
+				EV_SET(&changes[changeCount++], socket, filter, EV_DELETE, 0, 0, nullptr);
+		};
+
+		UpdateFilter(SocketPollEvent_Read, EVFILT_READ);
+		UpdateFilter(SocketPollEvent_Write, EVFILT_WRITE);
+
+		if (changeCount > 0 && kevent(m_handle, changes, changeCount, nullptr, 0, nullptr) == -1)
+		{
+			NazaraError("Failed to update socket filters: " + Error::GetLastSystemError());
+			return false;
+		}
+
+		return true;
+	}
+	#endif
+
+	void SocketPollerImpl::DrainWakeUp()
+	{
+		UInt8 buffer[64];
+		while (read(m_wakeUpPipe[0], buffer, sizeof(buffer)) > 0);
+	}
+
+	void SocketPollerImpl::RegisterWakeUp()
+	{
+		if (m_handle == -1 || m_wakeUpPipe[0] == -1)
+			return;
+
+		#ifdef NAZARA_NETWORK_EPOLL
+		epoll_event event;
+		event.data.fd = m_wakeUpPipe[0];
+		event.events = EPOLLIN;
+
+		if (epoll_ctl(m_handle, EPOLL_CTL_ADD, m_wakeUpPipe[0], &event) == -1)
+			NazaraError("Failed to register wake up pipe: " + Error::GetLastSystemError());
+		#else
+		struct kevent change;
+		EV_SET(&change, m_wakeUpPipe[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+
+		if (kevent(m_handle, &change, 1, nullptr, 0, nullptr) == -1)
+			NazaraError("Failed to register wake up pipe: " + Error::GetLastSystemError());
+		#endif
+	}
+
+	void SocketPollerImpl::ReportEvents(SocketHandle socket, UInt32 eventFlags)
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end())
+			return;
+
+		// Only the requested events are reported
+		Registration& registration = it->second;
+		eventFlags &= registration.eventFlags;
+		if (eventFlags == SocketPollEvent_None)
+			return;
+
+		if (registration.readyFlags == SocketPollEvent_None)
+		{
+			registration.readyIndex = m_readySockets.size();
+
+			SocketPoller::ReadySocket readySocket;
+			readySocket.handle = socket;
+			readySocket.eventFlags = eventFlags;
+			readySocket.userdata = registration.userdata;
+
+			m_readySockets.push_back(readySocket);
+		}
+		else
+			m_readySockets[registration.readyIndex].eventFlags |= eventFlags;
+
+		registration.readyFlags |= eventFlags;
+	}
+}
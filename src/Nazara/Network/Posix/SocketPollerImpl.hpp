@@ -0,0 +1,79 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SOCKETPOLLERIMPL_HPP
+#define NAZARA_SOCKETPOLLERIMPL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+	#define NAZARA_NETWORK_EPOLL
+	#include <sys/epoll.h>
+#else
+	#include <sys/event.h>
+#endif
+
+namespace Nz
+{
+	class SocketPollerImpl
+	{
+		public:
+			SocketPollerImpl();
+			SocketPollerImpl(const SocketPollerImpl&) = delete;
+			SocketPollerImpl(SocketPollerImpl&&) = delete;
+			~SocketPollerImpl();
+
+			void Clear();
+
+			const std::vector<SocketPoller::ReadySocket>& GetReadySockets() const;
+			std::size_t GetSocketCount() const;
+
+			UInt32 GetReadyFlags(SocketHandle socket) const;
+
+			bool IsRegistered(SocketHandle socket) const;
+
+			bool RegisterSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata);
+			void UnregisterSocket(SocketHandle socket);
+			bool UpdateSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata);
+
+			std::size_t Wait(int msTimeout, SocketError* error);
+			void Wake();
+
+			SocketPollerImpl& operator=(const SocketPollerImpl&) = delete;
+			SocketPollerImpl& operator=(SocketPollerImpl&&) = delete;
+
+		private:
+			struct Registration
+			{
+				SocketPollMode mode;
+				UInt32 eventFlags;
+				UInt32 readyFlags; //< Events reported by the last wait
+				std::size_t readyIndex;
+				void* userdata;
+			};
+
+			bool Control(SocketHandle socket, UInt32 previousFlags, UInt32 eventFlags, SocketPollMode mode);
+			void DrainWakeUp();
+			void RegisterWakeUp();
+			void ReportEvents(SocketHandle socket, UInt32 eventFlags);
+
+			#ifdef NAZARA_NETWORK_EPOLL
+			std::vector<epoll_event> m_events;
+			#else
+			std::vector<struct kevent> m_events;
+			#endif
+			std::unordered_map<SocketHandle, Registration> m_sockets;
+			std::vector<SocketPoller::ReadySocket> m_readySockets;
+			int m_handle;
+			int m_wakeUpPipe[2]; //< Read and write ends
+	};
+}
+
+#endif // NAZARA_SOCKETPOLLERIMPL_HPP
@@ -5,15 +5,42 @@
 #include <Nazara/Network/RUdpConnection.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/Profiler.hpp>
 #include <Nazara/Network/NetPacket.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		constexpr double MaxBandwidthBurst = 0.1; //< Seconds of bandwidth which can be saved up
+		constexpr double MaxPacingBurst = 4.0; //< Packets which can be sent at once despite pacing
+		constexpr float InitialCongestionWindow = 16.f;
+		constexpr float MinCongestionWindow = 2.f;
+		constexpr float PacketLossSmoothing = 1.f / 16.f;
+	}
+
 	/*!
 	* \ingroup network
 	* \class Nz::RUdpConnection
 	* \brief Network class that represents a reliable UDP connection
+	*
+	* The connection is either updated by the thread calling Update, or by its own network thread once threading is enabled.
+	* In the latter case, acks and resends do not depend on the frame time of the game thread.
+	*
+	* Payloads can be compressed, and messages can be tracked until the peer acknowledges them:
+	* snapshots delta encoded (see EncodeDelta) against the last acknowledged one take a fraction of their size.
+	*
+	* Small messages sent during the same update are aggregated into datagrams sharing a single header and ack bitfield.
+	*
+	* Broadcast encodes a packet once for many peers, each datagram gathering a header written for its peer with the shared payload.
+	*
+	* Sending is paced over the round-trip time measured from acks, and the number of packets waiting for an ack is
+	* limited by a congestion window which shrinks when packets are lost (as TCP does), so resends do not flood a degraded link.
 	*/
 
 	/*!
@@ -21,16 +48,92 @@ namespace Nz
 	*/
 
 	RUdpConnection::RUdpConnection() :
+	m_compressionThreshold(128),
+	m_maxDatagramSize(1200), //< Fits the path MTU of nearly every route (IPv6 guarantees 1280 bytes)
 	m_peerIterator(0),
+	m_bandwidthLimit(0),
 	m_forceAckSendTime(10'000), //< 10ms
 	m_pingInterval(1'000'000), //< 1s
 	m_protocol(0x4E4E6574), //< "NNet"
 	m_timeBeforePing(500'000), //< 0.5s
 	m_timeBeforeTimeOut(10'000'000), //< 10s
 	m_currentTime(0),
+	m_delayedPacketCount(0),
+	m_simulatedLinkTime(0),
+	m_isAggregationEnabled(true),
+	m_isCompressionEnabled(false),
 	m_isSimulationEnabled(false),
 	m_shouldAcceptConnections(true)
 	{
+		m_receivedAddresses.resize(ReceiveBatchSize);
+		m_receivedPackets.resize(ReceiveBatchSize);
+	}
+
+	/*!
+	* \brief Destructs the object and stops its network thread
+	*/
+
+	RUdpConnection::~RUdpConnection()
+	{
+		EnableThreading(false);
+	}
+
+	/*!
+	* \brief Sends the same packet to many peers
+	* \return true If every peer exists (false may result from disconnected clients)
+	*
+	* \param peerIps Array of the IpAddress of the peers
+	* \param peerCount Number of peers
+	* \param priority Priority of the packet
+	* \param reliability Policy of reliability of the packet
+	* \param packet Packet to send
+	* \param messageId Identifier reported by OnMessageAcknowledged once a peer received the packet, zero to not track it
+	*
+	* \remark The packet is encoded (and compressed) once, its payload is shared by the peers until each one of them received it
+	* \remark While threaded, the packet is handed to the network thread, false means its queue is full and packets to unknown peers are silently dropped
+	* \remark Produces a NazaraAssert if peerIps is invalid
+	*/
+
+	bool RUdpConnection::Broadcast(const IpAddress* peerIps, std::size_t peerCount, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId)
+	{
+		NazaraAssert(peerIps || peerCount == 0, "Invalid peers");
+
+		if (peerCount == 0)
+			return true;
+
+		if (m_threadData)
+		{
+			OutgoingMessage outgoingMessage;
+			outgoingMessage.broadcastTo.assign(peerIps, peerIps + peerCount);
+			outgoingMessage.data.Reset(packet.GetNetCode(), packet.GetConstData() + NetPacket::HeaderSize, packet.GetDataSize());
+			outgoingMessage.messageId = messageId;
+			outgoingMessage.priority = priority;
+			outgoingMessage.reliability = reliability;
+
+			return m_threadData->outgoingMessages.Push(std::move(outgoingMessage));
+		}
+
+		std::size_t packetIndex = EncodePacket(packet);
+		m_packetReferences[packetIndex] = 0;
+
+		bool everyPeerExists = true;
+		for (std::size_t i = 0; i < peerCount; ++i)
+		{
+			auto it = m_peerByIP.find(peerIps[i]);
+			if (it == m_peerByIP.end())
+			{
+				everyPeerExists = false; /// Silently fail (probably a disconnected client)
+				continue;
+			}
+
+			m_packetReferences[packetIndex]++;
+			EnqueuePacketInternal(m_peers[it->second], priority, reliability, packetIndex, messageId);
+		}
+
+		if (m_packetReferences[packetIndex] == 0)
+			m_releasedPackets.push_back(packetIndex);
+
+		return everyPeerExists;
 	}
 
 	/*!
@@ -39,6 +142,7 @@ namespace Nz
 	*
 	* \param remoteAddress Address to connect to
 	*
+	* \remark Produces a NazaraAssert if threading is enabled
 	* \remark Produces a NazaraAssert if socket is not bound
 	* \remark Produces a NazaraAssert if remote is invalid
 	* \remark Produces a NazaraAssert if port is not specified
@@ -46,6 +150,7 @@ namespace Nz
 
 	bool RUdpConnection::Connect(const IpAddress& remoteAddress)
 	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot connect while the network thread is running");
 		NazaraAssert(m_socket.GetState() == SocketState_Bound, "Socket must be bound first");
 		NazaraAssert(remoteAddress.IsValid(), "Invalid remote address");
 		NazaraAssert(remoteAddress.GetPort() != 0, "Remote address has no port");
@@ -95,6 +200,137 @@ namespace Nz
 		return Connect(hostnameAddress);
 	}
 
+	/*!
+	* \brief Enables or disables the aggregation of small messages
+	*
+	* \param aggregation Should messages of the same priority and reliability be packed into shared datagrams
+	* \param maxDatagramSize Maximum size of an aggregated datagram, which should not exceed the path MTU
+	*
+	* \remark Messages tracked by an identifier, and those bigger than the datagram size, are always sent alone
+	* \remark Aggregated messages can be received whether aggregation is enabled or not
+	* \remark Produces a NazaraAssert if threading is enabled
+	*/
+
+	void RUdpConnection::EnableAggregation(bool aggregation, std::size_t maxDatagramSize)
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot change aggregation while the network thread is running");
+
+		// Message payload sizes are stored on 16 bits
+		m_maxDatagramSize = std::min<std::size_t>(maxDatagramSize, std::numeric_limits<UInt16>::max());
+		m_isAggregationEnabled = aggregation;
+	}
+
+	/*!
+	* \brief Enables or disables the compression of payloads
+	*
+	* \param compression Should payloads be LZ4 compressed (each one is only sent compressed if it gets smaller)
+	* \param threshold Size from which a payload is compressed
+	*
+	* \remark Compressed messages can be received whether compression is enabled or not
+	* \remark Produces a NazaraAssert if threading is enabled
+	*/
+
+	void RUdpConnection::EnableCompression(bool compression, std::size_t threshold)
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot change compression while the network thread is running");
+
+		// Tiny payloads cannot get smaller once their original size is added
+		constexpr std::size_t MinCompressionThreshold = 16;
+
+		m_compressionThreshold = std::max(threshold, MinCompressionThreshold);
+		m_isCompressionEnabled = compression;
+	}
+
+	/*!
+	* \brief Enables or disables the network thread
+	*
+	* \param threaded Should a network thread own the socket and update the connection
+	*
+	* \remark While threaded, Update does nothing, Send and PollMessage exchange messages with the network thread through lock-free queues
+	* \remark Signals are emitted from the network thread while it runs
+	* \remark The connection must not be moved while threaded
+	* \remark Produces a NazaraAssert if socket is not bound
+	*/
+
+	void RUdpConnection::EnableThreading(bool threaded)
+	{
+		if (threaded == IsThreadingEnabled())
+			return;
+
+		if (threaded)
+		{
+			NazaraAssert(m_socket.GetState() == SocketState_Bound, "Socket must be bound first");
+
+			m_threadData = std::make_unique<ThreadData>();
+			m_threadData->isRunning = true;
+			m_threadData->thread = Thread(&RUdpConnection::ThreadMain, this);
+			m_threadData->thread.SetName("RUdpConnection");
+		}
+		else
+		{
+			m_threadData->isRunning = false;
+			m_threadData->thread.Join();
+
+			// Messages which were not exchanged yet are kept, in order
+			std::queue<RUdpMessage> receivedMessages;
+
+			RUdpMessage receivedMessage;
+			while (m_threadData->receivedMessages.Pop(&receivedMessage))
+				receivedMessages.emplace(std::move(receivedMessage));
+
+			for (; !m_receivedMessages.empty(); m_receivedMessages.pop())
+				receivedMessages.emplace(std::move(m_receivedMessages.front()));
+
+			m_receivedMessages = std::move(receivedMessages);
+
+			OutgoingMessage outgoingMessage;
+			while (m_threadData->outgoingMessages.Pop(&outgoingMessage))
+				EnqueueMessage(outgoingMessage);
+
+			m_threadData.reset();
+		}
+	}
+
+	/*!
+	* \brief Gets the statistics of the connection to a peer
+	* \return true If the peer is known
+	*
+	* \param peerIp IpAddress of the peer
+	* \param statistics Statistics to fill
+	*
+	* \remark Produces a NazaraAssert if threading is enabled
+	* \remark Produces a NazaraAssert if statistics is invalid
+	*/
+
+	bool RUdpConnection::GetPeerStatistics(const IpAddress& peerIp, PeerStatistics* statistics) const
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot get statistics while the network thread is running");
+		NazaraAssert(statistics, "Invalid statistics");
+
+		auto it = m_peerByIP.find(peerIp);
+		if (it == m_peerByIP.end())
+			return false;
+
+		const PeerData& peer = m_peers[it->second];
+
+		statistics->bytesReceived = peer.bytesReceived;
+		statistics->bytesSent = peer.bytesSent;
+		statistics->congestionWindow = peer.congestionWindow;
+		statistics->inFlightPacketCount = peer.pendingAckSlots.Count();
+		statistics->packetLoss = peer.packetLoss;
+		statistics->packetsLost = peer.packetsLost;
+		statistics->packetsReceived = peer.packetsReceived;
+		statistics->packetsSent = peer.packetsSent;
+		statistics->roundTripTime = peer.roundTripTime;
+		statistics->roundTripTimeVariation = peer.roundTripTimeVariation;
+
+		statistics->pendingPacketCount = 0;
+		for (const std::vector<PendingPacket>& pendingPackets : peer.pendingPackets)
+			statistics->pendingPacketCount += pendingPackets.size();
+
+		return true;
+	}
+
 	/*!
 	* \brief Listens to a socket
 	* \return true If successfully bound
@@ -104,6 +340,8 @@ namespace Nz
 
 	bool RUdpConnection::Listen(const IpAddress& address)
 	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot listen while the network thread is running");
+
 		if (!InitSocket(address.GetProtocol()))
 			return false;
 
@@ -123,6 +361,9 @@ namespace Nz
 	{
 		NazaraAssert(message, "Invalid message");
 
+		if (m_threadData)
+			return m_threadData->receivedMessages.Pop(message);
+
 		if (m_receivedMessages.empty())
 			return false;
 
@@ -139,30 +380,115 @@ namespace Nz
 	* \param priority Priority of the packet
 	* \param reliability Policy of reliability of the packet
 	* \param packet Packet to send
+	* \param messageId Identifier reported by OnMessageAcknowledged once the peer received the packet, zero to not track it
+	*
+	* \remark While threaded, the packet is handed to the network thread, false means its queue is full and packets to unknown peers are silently dropped
 	*/
 
-	bool RUdpConnection::Send(const IpAddress& peerIp, PacketPriority priority, PacketReliability reliability, const NetPacket& packet)
+	bool RUdpConnection::Send(const IpAddress& peerIp, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId)
 	{
+		if (m_threadData)
+		{
+			OutgoingMessage outgoingMessage;
+			outgoingMessage.data.Reset(packet.GetNetCode(), packet.GetConstData() + NetPacket::HeaderSize, packet.GetDataSize());
+			outgoingMessage.messageId = messageId;
+			outgoingMessage.priority = priority;
+			outgoingMessage.reliability = reliability;
+			outgoingMessage.to = peerIp;
+
+			return m_threadData->outgoingMessages.Push(std::move(outgoingMessage));
+		}
+
 		auto it = m_peerByIP.find(peerIp);
 		if (it == m_peerByIP.end())
 			return false; /// Silently fail (probably a disconnected client)
 
-		EnqueuePacket(m_peers[it->second], priority, reliability, packet);
+		EnqueuePacket(m_peers[it->second], priority, reliability, packet, messageId);
 		return true;
 	}
 
+	/*!
+	* \brief Sets the dictionary used to compress and decompress payloads
+	*
+	* \param dictionary Data commonly found in payloads (like a typical snapshot), nullptr to remove it
+	* \param dictionarySize Size of the dictionary
+	*
+	* \remark Both peers must use the same dictionary
+	* \remark Produces a NazaraAssert if threading is enabled
+	*/
+
+	void RUdpConnection::SetCompressionDictionary(const void* dictionary, std::size_t dictionarySize)
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot change compression while the network thread is running");
+
+		m_compressor.SetDictionary(dictionary, dictionarySize);
+	}
+
+	/*!
+	* \brief Simulates a degraded network on received packets
+	*
+	* Packets are delayed by the latency and a random part of the jitter, some of them are held back for another latency
+	* (so later ones overtake them) and the bandwidth limits how fast they are delivered. Lost packets are dropped
+	* once their peer is known, so connection requests always get through.
+	*
+	* \param parameters Properties of the simulated link, default ones disable the simulation
+	*
+	* \remark Packets held back when the simulation is disabled are delivered on the next update
+	* \remark Produces a NazaraAssert if threading is enabled
+	* \remark Produces a NazaraAssert if packetLoss or reorderProbability is not in between 0.0 and 1.0
+	*/
+
+	void RUdpConnection::SimulateNetwork(const SimulationParameters& parameters)
+	{
+		NazaraAssert(!IsThreadingEnabled(), "Cannot change simulation while the network thread is running");
+		NazaraAssert(parameters.packetLoss >= 0.0 && parameters.packetLoss <= 1.0, "Packet loss must be in range [0..1]");
+		NazaraAssert(parameters.reorderProbability >= 0.0 && parameters.reorderProbability <= 1.0, "Reorder probability must be in range [0..1]");
+
+		m_simulation = parameters;
+		m_isSimulationEnabled = (parameters.packetLoss > 0.0 || parameters.reorderProbability > 0.0 || parameters.bandwidth > 0 || parameters.jitter > 0 || parameters.latency > 0);
+
+		m_packetLossProbability = std::bernoulli_distribution(parameters.packetLoss);
+		m_reorderProbability = std::bernoulli_distribution(parameters.reorderProbability);
+	}
+
 	/*!
 	* \brief Updates the reliable connection
+	*
+	* \remark Does nothing while threaded, as the network thread updates the connection
 	*/
 
 	void RUdpConnection::Update()
 	{
+		if (m_threadData)
+			return;
+
+		ProcessNetwork();
+	}
+
+	/*!
+	* \brief Receives packets, processes acks and sends pending packets
+	*/
+
+	void RUdpConnection::ProcessNetwork()
+	{
+		NazaraProfileZone("RUdpConnection::ProcessNetwork");
+
 		m_currentTime = m_clock.GetMicroseconds();
 
-		NetPacket receivedPacket;
-		IpAddress senderIp;
-		while (m_socket.ReceivePacket(&receivedPacket, &senderIp))
-			OnPacketReceived(senderIp, std::move(receivedPacket));
+		std::size_t receivedCount;
+		while (m_socket.ReceiveMultiple(m_receivedPackets.data(), m_receivedAddresses.data(), m_receivedPackets.size(), &receivedCount) && receivedCount > 0)
+		{
+			for (std::size_t i = 0; i < receivedCount; ++i)
+			{
+				if (m_isSimulationEnabled)
+					SimulateReception(m_receivedAddresses[i], std::move(m_receivedPackets[i]));
+				else
+					OnPacketReceived(m_receivedAddresses[i], std::move(m_receivedPackets[i]));
+			}
+		}
+
+		if (!m_delayedPackets.empty())
+			ProcessSimulatedPackets();
 
 		//for (unsigned int i = m_activeClients.FindFirst(); i != m_activeClients.npos; i = m_activeClients.FindNext(i))
 		//{
@@ -193,30 +519,270 @@ namespace Nz
 			{
 				NetPacket acknowledgePacket(NetCode_Acknowledge);
 				EnqueuePacket(peer, PacketPriority_Low, PacketReliability_Reliable, acknowledgePacket);
+
+				peer.state = PeerState_Connected; //< Do not enqueue another one if congestion delays it
 			}
 
-			for (unsigned int priority = PacketPriority_Highest; priority <= PacketPriority_Lowest; ++priority)
+			for (std::size_t slot = peer.pendingAckSlots.FindFirst(); slot != peer.pendingAckSlots.npos; slot = peer.pendingAckSlots.FindNext(slot))
 			{
-				std::vector<PendingPacket>& pendingPackets = peer.pendingPackets[priority];
-				for (PendingPacket& packetData : pendingPackets)
-					SendPacket(peer, std::move(packetData));
-
-				pendingPackets.clear();
+				const PendingAckPacket& pendingAck = peer.pendingAcks[slot];
+				if (m_currentTime - pendingAck.timeSent > ComputeRetransmissionTimeout(peer))
+				{
+					peer.pendingAckSlots.Reset(slot);
+					OnPacketLost(peer, pendingAck);
+				}
 			}
 
-			auto it = peer.pendingAckQueue.begin();
-			while (it != peer.pendingAckQueue.end())
+			RefillSendBudget(peer);
+
+			for (unsigned int priority = PacketPriority_Highest; priority <= PacketPriority_Lowest; ++priority)
 			{
-				if (m_currentTime - it->timeSent > 2 * peer.roundTripTime)
+				// Packets lost while sending (when the ack window is full) are enqueued again, they will be sent on the next update
+				std::vector<PendingPacket>& pendingPackets = peer.pendingPackets[priority];
+				std::size_t packetCount = pendingPackets.size();
+				std::size_t sentCount = 0;
+				while (sentCount < packetCount)
 				{
-					OnPacketLost(peer, std::move(*it));
-					it = peer.pendingAckQueue.erase(it);
+					// Packets which cannot be sent yet wait for the next update, in order
+					if (priority != PacketPriority_Immediate && !CanSendPacket(peer))
+						break;
+
+					PendingPacket packet;
+					sentCount += AggregatePackets(peer, &pendingPackets[sentCount], packetCount - sentCount, &packet);
+
+					SendPacket(peer, packet);
 				}
-				else
-					++it;
+
+				pendingPackets.erase(pendingPackets.begin(), pendingPackets.begin() + sentCount);
 			}
 		}
 		//m_activeClients.Reset();
+
+		// Every packet of this update is sent at once, each datagram gathering the header of its peer and the (maybe shared) rest of the packet
+		std::size_t datagramCount = m_outgoingPackets.size();
+		m_outgoingBuffers.resize(2 * datagramCount);
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			const NetPacket& data = *m_outgoingPackets[i];
+
+			NetBuffer& header = m_outgoingBuffers[2 * i];
+			header.data = m_outgoingHeaders[i].data();
+			header.dataLength = PeerHeaderSize;
+
+			NetBuffer& payload = m_outgoingBuffers[2 * i + 1];
+			payload.data = const_cast<UInt8*>(data.GetConstData()) + PeerHeaderSize; //< Only read by the system
+			payload.dataLength = static_cast<std::size_t>(data.GetSize()) - PeerHeaderSize;
+		}
+
+		std::size_t sendOffset = 0;
+		while (sendOffset < datagramCount)
+		{
+			std::size_t sentCount;
+			if (m_socket.SendMultiple(&m_outgoingAddresses[sendOffset], &m_outgoingBuffers[2 * sendOffset], 2, datagramCount - sendOffset, &sentCount))
+				break;
+
+			// A packet which could not be sent will be handled as a lost one, the following ones are still sent
+			sendOffset += sentCount + 1;
+		}
+
+		m_outgoingAddresses.clear();
+		m_outgoingHeaders.clear();
+		m_outgoingPackets.clear();
+
+		// Packets released during this update are not referenced anymore
+		m_freePackets.insert(m_freePackets.end(), m_releasedPackets.begin(), m_releasedPackets.end());
+		m_releasedPackets.clear();
+	}
+
+	/*!
+	* \brief Handles the packets held back by the network simulation which are due
+	*/
+
+	void RUdpConnection::ProcessSimulatedPackets()
+	{
+		while (!m_delayedPackets.empty() && (!m_isSimulationEnabled || m_delayedPackets.front().deliveryTime <= m_currentTime))
+		{
+			std::pop_heap(m_delayedPackets.begin(), m_delayedPackets.end(), IsDeliveredLater);
+
+			DelayedPacket delayedPacket = std::move(m_delayedPackets.back());
+			m_delayedPackets.pop_back();
+
+			OnPacketReceived(delayedPacket.from, std::move(delayedPacket.data));
+		}
+	}
+
+	/*!
+	* \brief Packs the first pending packets into a single one
+	* \return Number of pending packets replaced by the aggregate (one if the first packet is sent alone)
+	*
+	* \param peer Data relative to the peer
+	* \param packets Pending packets of the same priority, in sending order
+	* \param packetCount Number of pending packets (at least one)
+	* \param aggregate Pending packet to send in place of those which were aggregated
+	*/
+
+	std::size_t RUdpConnection::AggregatePackets(PeerData& peer, const PendingPacket* packets, std::size_t packetCount, PendingPacket* aggregate)
+	{
+		constexpr std::size_t PayloadOffset = NetPacket::HeaderSize + MessageHeader;
+
+		*aggregate = packets[0];
+
+		// Connection handshake must be sent as is, and tracked messages are acknowledged by their own sequence
+		if (!m_isAggregationEnabled || (peer.state != PeerState_Connected && peer.state != PeerState_WillAck))
+			return 1;
+
+		auto IsAggregable = [&](const PendingPacket& packet)
+		{
+			if (packet.messageId != 0 || packet.reliability != packets[0].reliability)
+				return false;
+
+			const NetPacket& data = m_packets[packet.packetIndex];
+			if (data.GetConstData()[PayloadOffset - sizeof(UInt8)] & MessageFlag_Aggregated)
+				return false; //< Lost aggregates are sent again as they are
+
+			switch (data.GetNetCode())
+			{
+				case NetCode_Acknowledge:
+				case NetCode_AcknowledgeConnection:
+				case NetCode_Invalid:
+				case NetCode_Ping:
+				case NetCode_Pong:
+				case NetCode_RequestConnection:
+					return false;
+
+				default:
+					return true;
+			}
+		};
+
+		std::size_t datagramSize = PayloadOffset + MessageFooter;
+		std::size_t aggregatedCount = 0;
+		for (; aggregatedCount < packetCount; ++aggregatedCount)
+		{
+			const PendingPacket& packet = packets[aggregatedCount];
+			if (!IsAggregable(packet))
+				break;
+
+			std::size_t messageSize = AggregateHeader + static_cast<std::size_t>(m_packets[packet.packetIndex].GetSize()) - PayloadOffset - MessageFooter;
+			if (datagramSize + messageSize > m_maxDatagramSize)
+				break;
+
+			datagramSize += messageSize;
+		}
+
+		if (aggregatedCount < 2)
+			return 1;
+
+		UInt16 protocolBegin = static_cast<UInt16>(m_protocol & 0xFFFF);
+		UInt16 protocolEnd = static_cast<UInt16>((m_protocol & 0xFFFF0000) >> 16);
+
+		std::size_t packetIndex = AllocatePacket();
+
+		NetPacket& data = m_packets[packetIndex];
+		data.Reset(NetCode_Invalid, datagramSize - NetPacket::HeaderSize);
+		data << protocolBegin;
+
+		data.GetStream()->SetCursorPos(PayloadOffset - sizeof(UInt8));
+		data << static_cast<UInt8>(MessageFlag_Aggregated);
+
+		// Messages keep their own flags, as they may have been compressed
+		for (std::size_t i = 0; i < aggregatedCount; ++i)
+		{
+			const NetPacket& message = m_packets[packets[i].packetIndex];
+			const UInt8* messageData = message.GetConstData();
+			std::size_t payloadSize = static_cast<std::size_t>(message.GetSize()) - PayloadOffset - MessageFooter;
+
+			data << message.GetNetCode() << messageData[PayloadOffset - sizeof(UInt8)] << static_cast<UInt16>(payloadSize);
+			data.Write(messageData + PayloadOffset, payloadSize);
+
+			ReleasePacket(packets[i].packetIndex);
+		}
+
+		data << protocolEnd;
+
+		aggregate->packetIndex = packetIndex;
+
+		return aggregatedCount;
+	}
+
+	/*!
+	* \brief Takes a packet from the pool
+	* \return Index of the packet, referenced once
+	*/
+
+	std::size_t RUdpConnection::AllocatePacket()
+	{
+		if (m_freePackets.empty())
+		{
+			m_packets.emplace_back();
+			m_packetReferences.push_back(1);
+
+			return m_packets.size() - 1;
+		}
+
+		std::size_t packetIndex = m_freePackets.back();
+		m_freePackets.pop_back();
+
+		m_packetReferences[packetIndex] = 1;
+
+		return packetIndex;
+	}
+
+	/*!
+	* \brief Checks whether congestion control, pacing and bandwidth limit allow a packet to be sent to a peer
+	* \return true If a packet can be sent
+	*
+	* \param peer Data relative to the peer
+	*/
+
+	bool RUdpConnection::CanSendPacket(const PeerData& peer) const
+	{
+		if (peer.pendingAckSlots.Count() >= peer.congestionWindow)
+			return false;
+
+		if (peer.hasRoundTripTime && peer.pacingCredit < 1.0)
+			return false;
+
+		if (m_bandwidthLimit > 0 && peer.bandwidthCredit <= 0.0)
+			return false;
+
+		return true;
+	}
+
+	/*!
+	* \brief Decompresses the payload of a received packet
+	* \return true If the payload is valid
+	*
+	* \param packet Packet whose cursor is at the beginning of the compressed payload, replaced by the decompressed packet
+	*/
+
+	bool RUdpConnection::DecompressPacket(NetPacket& packet)
+	{
+		constexpr std::size_t PayloadOffset = NetPacket::HeaderSize + MessageHeader;
+		if (packet.GetSize() < PayloadOffset + sizeof(UInt16) + MessageFooter)
+			return false;
+
+		UInt16 payloadSize;
+		packet >> payloadSize;
+
+		const UInt8* compressedData = packet.GetConstData() + PayloadOffset + sizeof(UInt16);
+		std::size_t compressedSize = static_cast<std::size_t>(packet.GetSize()) - PayloadOffset - sizeof(UInt16) - MessageFooter;
+
+		// The message header and footer are kept around the payload, as they are for uncompressed packets
+		NetPacket decompressedPacket(packet.GetNetCode(), MessageHeader + payloadSize + MessageFooter);
+		decompressedPacket.Resize(PayloadOffset + payloadSize + MessageFooter);
+
+		UInt8* data = decompressedPacket.GetData();
+		if (!m_compressor.Decompress(compressedData, compressedSize, data + PayloadOffset, payloadSize))
+			return false;
+
+		std::memcpy(data + NetPacket::HeaderSize, packet.GetConstData() + NetPacket::HeaderSize, MessageHeader);
+		std::memcpy(data + PayloadOffset + payloadSize, compressedData + compressedSize, MessageFooter);
+
+		decompressedPacket.GetStream()->SetCursorPos(PayloadOffset);
+		packet = std::move(decompressedPacket);
+
+		return true;
 	}
 
 	/*!
@@ -237,6 +803,15 @@ namespace Nz
 		// Remove from IP lookup table
 		m_peerByIP.erase(peer.address);
 
+		for (std::vector<PendingPacket>& pendingPackets : peer.pendingPackets)
+		{
+			for (const PendingPacket& pendingPacket : pendingPackets)
+				ReleasePacket(pendingPacket.packetIndex);
+		}
+
+		for (std::size_t slot = peer.pendingAckSlots.FindFirst(); slot != peer.pendingAckSlots.npos; slot = peer.pendingAckSlots.FindNext(slot))
+			ReleasePacket(peer.pendingAcks[slot].packetIndex);
+
 		// Can we safely "remove" this slot?
 		if (m_peerIterator >= m_peers.size() - 1 || peerIndex > m_peerIterator)
 		{
@@ -265,42 +840,112 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Enqueues a packet in the sending list
+	* \brief Encodes a packet in the pool, with the message header and footer around its (maybe compressed) payload
+	* \return Index of the packet, referenced once
 	*
-	* \param peer Data relative to the peer
-	* \param priority Priority of the packet
-	* \param reliability Policy of reliability of the packet
-	* \param packet Packet to send
+	* \param packet Packet to encode
+	*
+	* \remark The sequence fields of the message header are left blank, they are written for each peer when sending the packet
 	*/
 
-	void RUdpConnection::EnqueuePacket(PeerData& peer, PacketPriority priority, PacketReliability reliability, const NetPacket& packet)
+	std::size_t RUdpConnection::EncodePacket(const NetPacket& packet)
 	{
+		constexpr std::size_t PayloadOffset = NetPacket::HeaderSize + MessageHeader;
+
 		UInt16 protocolBegin = static_cast<UInt16>(m_protocol & 0xFFFF);
 		UInt16 protocolEnd = static_cast<UInt16>((m_protocol & 0xFFFF0000) >> 16);
 
-		NetPacket data(packet.GetNetCode(), MessageHeader + packet.GetDataSize() + MessageFooter);
+		const UInt8* payload = packet.GetConstData() + NetPacket::HeaderSize;
+		std::size_t payloadSize = packet.GetDataSize();
+
+		std::size_t packetIndex = AllocatePacket();
+
+		NetPacket& data = m_packets[packetIndex];
+		data.Reset(packet.GetNetCode(), MessageHeader + payloadSize + MessageFooter);
 		data << protocolBegin;
 
-		data.GetStream()->SetCursorPos(NetPacket::HeaderSize + MessageHeader);
-		data.Write(packet.GetConstData() + NetPacket::HeaderSize, packet.GetDataSize());
+		UInt8 flags = 0;
+		data.GetStream()->SetCursorPos(PayloadOffset);
+
+		if (m_isCompressionEnabled && payloadSize >= m_compressionThreshold && payloadSize <= std::numeric_limits<UInt16>::max())
+		{
+			// The compressed payload is only kept if it is smaller, including its original size
+			std::size_t maxCompressedSize = payloadSize - sizeof(UInt16) - 1;
+			data.Resize(PayloadOffset + sizeof(UInt16) + maxCompressedSize);
+
+			std::size_t compressedSize = m_compressor.Compress(payload, payloadSize, data.GetData() + PayloadOffset + sizeof(UInt16), maxCompressedSize);
+			if (compressedSize > 0)
+			{
+				data << static_cast<UInt16>(payloadSize);
+
+				data.Resize(PayloadOffset + sizeof(UInt16) + compressedSize);
+				data.GetStream()->SetCursorPos(PayloadOffset + sizeof(UInt16) + compressedSize);
+
+				flags |= MessageFlag_Compressed;
+			}
+			else
+				data.Resize(PayloadOffset);
+		}
+
+		if ((flags & MessageFlag_Compressed) == 0)
+			data.Write(payload, payloadSize);
 
 		data << protocolEnd;
-		EnqueuePacketInternal(peer, priority, reliability, std::move(data));
+
+		data.GetStream()->SetCursorPos(PayloadOffset - sizeof(UInt8));
+		data << flags;
+
+		return packetIndex;
 	}
 
 	/*!
-	* \brief Enqueues internally a packet in the sending list
+	* \brief Enqueues a message handed by the game thread
+	*
+	* \param message Message to enqueue, to its peer or to the peers of its broadcast
+	*/
+
+	void RUdpConnection::EnqueueMessage(const OutgoingMessage& message)
+	{
+		if (message.broadcastTo.empty())
+		{
+			auto it = m_peerByIP.find(message.to);
+			if (it != m_peerByIP.end())
+				EnqueuePacket(m_peers[it->second], message.priority, message.reliability, message.data, message.messageId);
+		}
+		else
+			Broadcast(message.broadcastTo.data(), message.broadcastTo.size(), message.priority, message.reliability, message.data, message.messageId);
+	}
+
+	/*!
+	* \brief Enqueues a packet in the sending list
 	*
 	* \param peer Data relative to the peer
 	* \param priority Priority of the packet
 	* \param reliability Policy of reliability of the packet
 	* \param packet Packet to send
+	* \param messageId Identifier reported once the peer acknowledges the packet, zero to not track it
 	*/
 
-	void RUdpConnection::EnqueuePacketInternal(PeerData& peer, PacketPriority priority, PacketReliability reliability, NetPacket&& data)
+	void RUdpConnection::EnqueuePacket(PeerData& peer, PacketPriority priority, PacketReliability reliability, const NetPacket& packet, UInt32 messageId)
+	{
+		EnqueuePacketInternal(peer, priority, reliability, EncodePacket(packet), messageId);
+	}
+
+	/*!
+	* \brief Enqueues internally a packet in the sending list
+	*
+	* \param peer Data relative to the peer
+	* \param priority Priority of the packet
+	* \param reliability Policy of reliability of the packet
+	* \param packetIndex Index of the packet to send
+	* \param messageId Identifier reported once the peer acknowledges the packet, zero to not track it
+	*/
+
+	void RUdpConnection::EnqueuePacketInternal(PeerData& peer, PacketPriority priority, PacketReliability reliability, std::size_t packetIndex, UInt32 messageId)
 	{
 		PendingPacket pendingPacket;
-		pendingPacket.data = std::move(data);
+		pendingPacket.messageId = messageId;
+		pendingPacket.packetIndex = packetIndex;
 		pendingPacket.priority = priority;
 		pendingPacket.reliability = reliability;
 
@@ -339,25 +984,36 @@ namespace Nz
 
 	void RUdpConnection::ProcessAcks(PeerData& peer, SequenceIndex lastAck, UInt32 ackBits)
 	{
-		auto it = peer.pendingAckQueue.begin();
-		while (it != peer.pendingAckQueue.end())
+		// Bit n of ackBits acknowledges lastAck - n - 1
+		UInt64 acks = (static_cast<UInt64>(ackBits) << 1) | 1;
+		for (unsigned int difference = 0; acks != 0; ++difference, acks >>= 1)
 		{
-			bool acked = false;
-			if (lastAck == it->sequenceId)
-				acked = true;
-			else if (!IsAckMoreRecent(it->sequenceId, lastAck))
-			{
-				unsigned int difference = ComputeSequenceDifference(lastAck, it->sequenceId);
-				if (difference <= 32)
-					acked = (ackBits >> (difference - 1)) & 1;
-			}
+			if ((acks & 1) == 0)
+				continue;
 
-			if (acked)
+			SequenceIndex sequenceId = static_cast<SequenceIndex>(lastAck - difference);
+			std::size_t slot = sequenceId % AckWindowSize;
+			if (peer.pendingAckSlots.Test(slot) && peer.pendingAcks[slot].sequenceId == sequenceId)
 			{
-				it = peer.pendingAckQueue.erase(it);
+				peer.pendingAckSlots.Reset(slot);
+				ReleasePacket(peer.pendingAcks[slot].packetIndex);
+
+				// Older packets were acknowledged by previous acks, only the most recent one is fresh enough to be timed
+				if (difference == 0)
+					UpdateRoundTripTime(peer, static_cast<UInt32>(m_currentTime - peer.pendingAcks[slot].timeSent));
+
+				// Slow start doubles the window every round-trip, then it grows by one packet per round-trip
+				if (peer.congestionWindow < peer.slowStartThreshold)
+					peer.congestionWindow += 1.f;
+				else
+					peer.congestionWindow += 1.f / peer.congestionWindow;
+
+				peer.congestionWindow = std::min(peer.congestionWindow, static_cast<float>(AckWindowSize));
+				peer.packetLoss -= peer.packetLoss * PacketLossSmoothing;
+
+				if (peer.pendingAcks[slot].messageId != 0)
+					OnMessageAcknowledged(this, peer.address, peer.pendingAcks[slot].messageId);
 			}
-			else
-				++it;
 		}
 	}
 
@@ -378,9 +1034,26 @@ namespace Nz
 		data.index = m_peers.size();
 		data.lastPacketTime = m_currentTime;
 		data.lastPingTime = m_currentTime;
+		data.pendingAckSlots.Resize(AckWindowSize);
+		data.receivedSequences = 0;
 		data.roundTripTime = 1'000'000; ///< Okay that's quite a lot
+		data.roundTripTimeVariation = 0;
 		data.state = state;
 
+		data.bandwidthCredit = 0.0;
+		data.bytesReceived = 0;
+		data.bytesSent = 0;
+		data.congestionTime = m_currentTime;
+		data.congestionWindow = InitialCongestionWindow;
+		data.hasRoundTripTime = false;
+		data.lastBudgetTime = m_currentTime;
+		data.pacingCredit = 0.0;
+		data.packetLoss = 0.f;
+		data.packetsLost = 0;
+		data.packetsReceived = 0;
+		data.packetsSent = 0;
+		data.slowStartThreshold = static_cast<float>(AckWindowSize);
+
 		m_activeClients.UnboundedSet(data.index);
 		m_peerByIP[address] = data.index;
 
@@ -419,12 +1092,74 @@ namespace Nz
 	* \param packet Pending packet
 	*/
 
-	void RUdpConnection::OnPacketLost(PeerData& peer, PendingAckPacket&& packet)
+	void RUdpConnection::OnPacketLost(PeerData& peer, const PendingAckPacket& packet)
 	{
 		//NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Lost packet " + String::Number(packet.sequenceId));
 
+		peer.packetLoss += (1.f - peer.packetLoss) * PacketLossSmoothing;
+		peer.packetsLost++;
+
+		// Packets sent before the last reduction were lost to the same congestion, the window is only halved once for them
+		if (packet.timeSent > peer.congestionTime)
+		{
+			peer.slowStartThreshold = std::max(peer.congestionWindow / 2.f, MinCongestionWindow);
+			peer.congestionWindow = peer.slowStartThreshold;
+			peer.congestionTime = m_currentTime;
+		}
+
 		if (IsReliable(packet.reliability))
-			EnqueuePacketInternal(peer, packet.priority, packet.reliability, std::move(packet.data));
+			EnqueuePacketInternal(peer, packet.priority, packet.reliability, packet.packetIndex, packet.messageId);
+		else
+			ReleasePacket(packet.packetIndex);
+	}
+
+	/*!
+	* \brief Splits an aggregated packet into the messages it holds
+	*
+	* \param peerIp IpAddress of the peer
+	* \param packet Aggregated packet, whose header has already been processed
+	*/
+
+	void RUdpConnection::OnAggregateReceived(const IpAddress& peerIp, NetPacket& packet)
+	{
+		constexpr std::size_t PayloadOffset = NetPacket::HeaderSize + MessageHeader;
+
+		const UInt8* data = packet.GetConstData();
+		std::size_t footerOffset = static_cast<std::size_t>(packet.GetSize()) - MessageFooter;
+		std::size_t offset = PayloadOffset;
+
+		while (offset + AggregateHeader <= footerOffset)
+		{
+			UInt16 netCode;
+			UInt8 flags;
+			UInt16 payloadSize;
+
+			packet.GetStream()->SetCursorPos(offset);
+			packet >> netCode >> flags >> payloadSize;
+
+			offset += AggregateHeader;
+			if (payloadSize > footerOffset - offset)
+				return; //< Ignore the remaining of a malformed packet
+
+			// Each message gets the header and footer of the aggregate, as if it was received alone
+			NetPacket message(netCode, MessageHeader + payloadSize + MessageFooter);
+			message.Write(data + NetPacket::HeaderSize, MessageHeader - sizeof(UInt8));
+			message << flags;
+			message.Write(data + offset, payloadSize);
+			message.Write(data + footerOffset, MessageFooter);
+			message.GetStream()->SetCursorPos(PayloadOffset);
+
+			offset += payloadSize;
+
+			if ((flags & MessageFlag_Compressed) && !DecompressPacket(message))
+				continue; //< Ignore
+
+			RUdpMessage receivedMessage;
+			receivedMessage.from = peerIp;
+			receivedMessage.data = std::move(message);
+
+			m_receivedMessages.emplace(std::move(receivedMessage));
+		}
 	}
 
 	/*!
@@ -442,6 +1177,7 @@ namespace Nz
 		SequenceIndex sequenceId;
 		SequenceIndex lastAck;
 		UInt32 ackBits;
+		UInt8 flags;
 
 		packet.GetStream()->SetCursorPos(packet.GetSize() - MessageFooter);
 		packet >> protocolEnd;
@@ -453,7 +1189,10 @@ namespace Nz
 		if (protocolId != m_protocol)
 			return; ///< Ignore
 
-		packet >> sequenceId >> lastAck >> ackBits;
+		packet >> sequenceId >> lastAck >> ackBits >> flags;
+
+		if ((flags & MessageFlag_Compressed) && !DecompressPacket(packet))
+			return; ///< Ignore
 
 		auto it = m_peerByIP.find(peerIp);
 		if (it == m_peerByIP.end())
@@ -482,8 +1221,12 @@ namespace Nz
 			PeerData& peer = m_peers[it->second];
 			peer.lastPacketTime = m_currentTime;
 
-			if (peer.receivedQueue.find(sequenceId) != peer.receivedQueue.end())
-				return; //< Ignore
+			if (!IsAckMoreRecent(sequenceId, peer.remoteSequence))
+			{
+				unsigned int difference = ComputeSequenceDifference(peer.remoteSequence, sequenceId);
+				if (difference >= 64 || (peer.receivedSequences >> difference) & 1)
+					return; //< Ignore duplicated packets, and those too old to be tracked
+			}
 
 			if (m_isSimulationEnabled && m_packetLossProbability(s_randomGenerator))
 			{
@@ -491,6 +1234,9 @@ namespace Nz
 				return;
 			}
 
+			peer.bytesReceived += packet.GetSize();
+			peer.packetsReceived++;
+
 			///< Receiving a packet from an acknowledged client means the connection works in both ways
 			if (peer.state == PeerState_Aknowledged && packet.GetNetCode() != NetCode_RequestConnection)
 			{
@@ -499,67 +1245,79 @@ namespace Nz
 			}
 
 			if (IsAckMoreRecent(sequenceId, peer.remoteSequence))
+			{
+				unsigned int difference = ComputeSequenceDifference(sequenceId, peer.remoteSequence);
+				peer.receivedSequences = ((difference < 64) ? peer.receivedSequences << difference : 0) | 1;
 				peer.remoteSequence = sequenceId;
+			}
+			else
+				peer.receivedSequences |= UInt64(1) << ComputeSequenceDifference(peer.remoteSequence, sequenceId);
 
 			ProcessAcks(peer, lastAck, ackBits);
 
-			peer.receivedQueue.insert(sequenceId);
-
-			switch (packet.GetNetCode())
+			if (flags & MessageFlag_Aggregated)
 			{
-				case NetCode_Acknowledge:
-					return; //< Do not switch to will ack mode (to prevent infinite replies, just let's ping/pong do that)
-
-				case NetCode_AcknowledgeConnection:
+				NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received aggregated messages from " + peerIp.ToString());
+				OnAggregateReceived(peerIp, packet);
+			}
+			else
+			{
+				switch (packet.GetNetCode())
 				{
-					if (peer.state == PeerState_Connected)
-						break;
-
-					IpAddress externalAddress;
-					UInt64 token;
-					packet /*>> externalAddress*/ >> token;
+					case NetCode_Acknowledge:
+						return; //< Do not switch to will ack mode (to prevent infinite replies, just let's ping/pong do that)
 
-					NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_AcknowledgeConnection from " + peerIp.ToString() + ": " + String::Number(token));
-					if (token == ~peer.stateData1)
+					case NetCode_AcknowledgeConnection:
 					{
-						peer.state = PeerState_Connected;
-						OnConnectedToPeer(this);
-					}
-					else
-					{
-						NazaraNotice("Received wrong token (" + String::Number(token) + " instead of " + String::Number(~peer.stateData1) + ") from client " + peer.address);
-						return; //< Ignore
-					}
+						if (peer.state == PeerState_Connected)
+							break;
+
+						IpAddress externalAddress;
+						UInt64 token;
+						packet /*>> externalAddress*/ >> token;
+
+						NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_AcknowledgeConnection from " + peerIp.ToString() + ": " + String::Number(token));
+						if (token == ~peer.stateData1)
+						{
+							peer.state = PeerState_Connected;
+							OnConnectedToPeer(this);
+						}
+						else
+						{
+							NazaraNotice("Received wrong token (" + String::Number(token) + " instead of " + String::Number(~peer.stateData1) + ") from client " + peer.address);
+							return; //< Ignore
+						}
 
-					break;
-				}
+						break;
+					}
 
-				case NetCode_RequestConnection:
-					NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_RequestConnection from " + peerIp.ToString());
-					return; //< Ignore
+					case NetCode_RequestConnection:
+						NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_RequestConnection from " + peerIp.ToString());
+						return; //< Ignore
 
-				case NetCode_Ping:
-				{
-					NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_Ping from " + peerIp.ToString());
+					case NetCode_Ping:
+					{
+						NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_Ping from " + peerIp.ToString());
 
-					NetPacket pongPacket(NetCode_Pong);
-					EnqueuePacket(peer, PacketPriority_Low, PacketReliability_Unreliable, pongPacket);
-					break;
-				}
+						NetPacket pongPacket(NetCode_Pong);
+						EnqueuePacket(peer, PacketPriority_Low, PacketReliability_Unreliable, pongPacket);
+						break;
+					}
 
-				case NetCode_Pong:
-					NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_Pong from " + peerIp.ToString());
-					break;
+					case NetCode_Pong:
+						NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received NetCode_Pong from " + peerIp.ToString());
+						break;
 
-				default:
-				{
-					NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received 0x" + String::Number(packet.GetNetCode(), 16) + " from " + peerIp.ToString());
-					RUdpMessage receivedMessage;
-					receivedMessage.from = peerIp;
-					receivedMessage.data = std::move(packet);
+					default:
+					{
+						NazaraNotice(m_socket.GetBoundAddress().ToString() + ": Received 0x" + String::Number(packet.GetNetCode(), 16) + " from " + peerIp.ToString());
+						RUdpMessage receivedMessage;
+						receivedMessage.from = peerIp;
+						receivedMessage.data = std::move(packet);
 
-					m_receivedMessages.emplace(std::move(receivedMessage));
-					break;
+						m_receivedMessages.emplace(std::move(receivedMessage));
+						break;
+					}
 				}
 			}
 
@@ -571,48 +1329,174 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Gives a peer the pacing and bandwidth budgets accumulated since the last update
+	*
+	* \param peer Data relative to the peer
+	*/
+
+	void RUdpConnection::RefillSendBudget(PeerData& peer)
+	{
+		double elapsedTime = static_cast<double>(m_currentTime - peer.lastBudgetTime);
+		peer.lastBudgetTime = m_currentTime;
+
+		// Unused budgets only allow a short burst, but the whole time since the last update can always be caught up on
+		if (peer.hasRoundTripTime)
+		{
+			// A congestion window worth of packets is spread over a round-trip
+			double credit = elapsedTime * peer.congestionWindow / std::max<UInt32>(peer.roundTripTime, 1);
+			peer.pacingCredit = std::min(peer.pacingCredit + credit, std::max(credit, MaxPacingBurst));
+		}
+
+		if (m_bandwidthLimit > 0)
+		{
+			double credit = elapsedTime * m_bandwidthLimit / 1'000'000.0;
+			peer.bandwidthCredit = std::min(peer.bandwidthCredit + credit, std::max(credit, m_bandwidthLimit * MaxBandwidthBurst));
+		}
+	}
+
 	/*!
 	* \brief Sends a packet to a peer
 	*
 	* \param peer Data relative to the peer
-	* \param packet Pending packet
+	* \param packet Pending packet (taken by value, as losing a packet enqueues it again)
 	*/
 
-	void RUdpConnection::SendPacket(PeerData& peer, PendingPacket&& packet)
+	void RUdpConnection::SendPacket(PeerData& peer, PendingPacket packet)
 	{
 		if (peer.state == PeerState_WillAck)
 			peer.state = PeerState_Connected;
 
 		SequenceIndex remoteSequence = peer.remoteSequence;
+		UInt32 previousAcks = static_cast<UInt32>(peer.receivedSequences >> 1);
 
-		UInt32 previousAcks = 0;
-		for (SequenceIndex ack : peer.receivedQueue)
-		{
-			if (ack == remoteSequence)
-				continue;
+		SequenceIndex sequenceId = ++peer.localSequence;
 
-			unsigned int difference = ComputeSequenceDifference(remoteSequence, ack);
-			if (difference <= 32U)
-				previousAcks |= (1U << (difference - 1));
-		}
+		std::size_t slot = sequenceId % AckWindowSize;
+		if (peer.pendingAckSlots.Test(slot))
+			OnPacketLost(peer, peer.pendingAcks[slot]); //< The window is full, its oldest packet is handled as a lost one
 
-		SequenceIndex sequenceId = ++peer.localSequence;
+		// The packet may be shared with other peers, the header of this peer is written on the side
+		const NetPacket& data = m_packets[packet.packetIndex];
+
+		m_outgoingHeaders.emplace_back();
+		PeerHeader& header = m_outgoingHeaders.back();
 
-		packet.data.GetStream()->SetCursorPos(NetPacket::HeaderSize + sizeof(UInt16)); ///< Protocol begin has already been filled
-		packet.data << sequenceId;
-		packet.data << remoteSequence;
-		packet.data << previousAcks;
+		NetPacket::EncodeHeader(header.data(), static_cast<UInt16>(data.GetSize()), data.GetNetCode());
+		std::memcpy(header.data() + NetPacket::HeaderSize, data.GetConstData() + NetPacket::HeaderSize, MessageHeader); ///< Protocol begin and flags have already been filled
 
-		m_socket.SendPacket(peer.address, packet.data);
+		ByteStream headerStream(header.data() + NetPacket::HeaderSize + sizeof(UInt16), 2 * sizeof(SequenceIndex) + sizeof(UInt32));
+		headerStream << sequenceId;
+		headerStream << remoteSequence;
+		headerStream << previousAcks;
 
-		PendingAckPacket pendingAckPacket;
-		pendingAckPacket.data = std::move(packet.data);
+		PendingAckPacket& pendingAckPacket = peer.pendingAcks[slot];
+		pendingAckPacket.messageId = packet.messageId;
+		pendingAckPacket.packetIndex = packet.packetIndex;
 		pendingAckPacket.priority = packet.priority;
 		pendingAckPacket.reliability = packet.reliability;
 		pendingAckPacket.sequenceId = sequenceId;
 		pendingAckPacket.timeSent = m_currentTime;
 
-		peer.pendingAckQueue.emplace_back(std::move(pendingAckPacket));
+		peer.pendingAckSlots.Set(slot);
+
+		peer.bandwidthCredit -= data.GetSize();
+		peer.bytesSent += data.GetSize();
+		peer.pacingCredit -= 1.0;
+		peer.packetsSent++;
+
+		// Sent at the end of the update
+		m_outgoingAddresses.push_back(peer.address);
+		m_outgoingPackets.push_back(&data);
+	}
+
+	/*!
+	* \brief Holds a received packet back until the simulated link delivers it
+	*
+	* \param peerIp Address of the sender
+	* \param packet Received packet
+	*/
+
+	void RUdpConnection::SimulateReception(const IpAddress& peerIp, NetPacket&& packet)
+	{
+		UInt64 deliveryTime = m_currentTime;
+
+		// Packets are queued on the link, each one taking its size over the bandwidth to go through
+		if (m_simulation.bandwidth > 0)
+		{
+			m_simulatedLinkTime = std::max(m_simulatedLinkTime, m_currentTime) + packet.GetSize() * 1'000'000ULL / m_simulation.bandwidth;
+			deliveryTime = m_simulatedLinkTime;
+		}
+
+		deliveryTime += m_simulation.latency;
+		if (m_simulation.jitter > 0)
+			deliveryTime += std::uniform_int_distribution<UInt32>(0, m_simulation.jitter)(s_randomGenerator);
+
+		if (m_reorderProbability(s_randomGenerator))
+			deliveryTime += std::max<UInt64>(m_simulation.latency + m_simulation.jitter, 1'000);
+
+		DelayedPacket delayedPacket;
+		delayedPacket.data = std::move(packet);
+		delayedPacket.deliveryTime = deliveryTime;
+		delayedPacket.from = peerIp;
+		delayedPacket.order = m_delayedPacketCount++;
+
+		m_delayedPackets.push_back(std::move(delayedPacket));
+		std::push_heap(m_delayedPackets.begin(), m_delayedPackets.end(), IsDeliveredLater);
+	}
+
+	/*!
+	* \brief Updates the connection until threading is disabled
+	*/
+
+	void RUdpConnection::ThreadMain()
+	{
+		// Datagrams wake the thread up at once, the timeout bounds the delay of acks and resends
+		constexpr int msUpdateInterval = 1;
+
+		SocketPoller poller;
+		poller.RegisterSocket(m_socket, SocketPollEvent_Read);
+
+		OutgoingMessage outgoingMessage;
+		while (m_threadData->isRunning)
+		{
+			while (m_threadData->outgoingMessages.Pop(&outgoingMessage))
+				EnqueueMessage(outgoingMessage);
+
+			ProcessNetwork();
+
+			// Messages the game thread did not poll yet wait on this side
+			while (!m_receivedMessages.empty() && m_threadData->receivedMessages.Push(std::move(m_receivedMessages.front())))
+				m_receivedMessages.pop();
+
+			poller.Wait(msUpdateInterval);
+		}
+
+		poller.UnregisterSocket(m_socket);
+	}
+
+	/*!
+	* \brief Updates the round-trip time estimation of a peer with a new measure
+	*
+	* \param peer Data relative to the peer
+	* \param sample Time between the sending of a packet and the reception of its ack, in microseconds
+	*/
+
+	void RUdpConnection::UpdateRoundTripTime(PeerData& peer, UInt32 sample)
+	{
+		// Estimation from RFC 6298, the variation is used as the jitter of the connection
+		if (peer.hasRoundTripTime)
+		{
+			UInt32 deviation = (sample > peer.roundTripTime) ? sample - peer.roundTripTime : peer.roundTripTime - sample;
+			peer.roundTripTimeVariation = (3 * peer.roundTripTimeVariation + deviation) / 4;
+			peer.roundTripTime = (7 * peer.roundTripTime + sample) / 8;
+		}
+		else
+		{
+			peer.hasRoundTripTime = true;
+			peer.roundTripTime = sample;
+			peer.roundTripTimeVariation = sample / 2;
+		}
 	}
 
 	/*!
@@ -0,0 +1,212 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/ResolveHandle.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Network/ResolveState.hpp>
+#include <utility>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::ResolveHandle
+	* \brief Network class that represents a lightweight reference to an asynchronous resolution
+	*
+	* Handles are returned by IpAddress::ResolveAddressAsync and IpAddress::ResolveHostnameAsync,
+	* they can be polled, waited for, or given to the completion callback.
+	*/
+
+	/*!
+	* \brief Constructs an invalid ResolveHandle object
+	*/
+
+	ResolveHandle::ResolveHandle() :
+	m_state(nullptr)
+	{
+	}
+
+	/*!
+	* \brief Constructs a ResolveHandle object referencing the same resolution as another
+	*
+	* \param handle ResolveHandle to copy
+	*/
+
+	ResolveHandle::ResolveHandle(const ResolveHandle& handle) :
+	m_state(handle.m_state)
+	{
+		if (m_state)
+			m_state->AddReference();
+	}
+
+	/*!
+	* \brief Constructs a ResolveHandle object by move semantic
+	*
+	* \param handle ResolveHandle to move into this
+	*/
+
+	ResolveHandle::ResolveHandle(ResolveHandle&& handle) noexcept :
+	m_state(handle.m_state)
+	{
+		handle.m_state = nullptr;
+	}
+
+	/*!
+	* \brief Constructs a ResolveHandle from a resolution state
+	*
+	* \param state State of the resolution, the handle takes ownership of the reference
+	*/
+
+	ResolveHandle::ResolveHandle(ResolveState* state) :
+	m_state(state)
+	{
+	}
+
+	/*!
+	* \brief Destructs the object and releases its reference to the resolution
+	*/
+
+	ResolveHandle::~ResolveHandle()
+	{
+		Reset();
+	}
+
+	/*!
+	* \brief Gets the error of the resolution
+	* \return ResolveError_NoError if it succeeded
+	*
+	* \remark Produces a NazaraAssert if the resolution is not done
+	*/
+
+	ResolveError ResolveHandle::GetError() const
+	{
+		NazaraAssert(IsValid() && IsDone(), "Resolution is not done");
+
+		return m_state->error;
+	}
+
+	/*!
+	* \brief Gets the hostname of the resolution
+	* \return Resolved hostname for an address resolution, requested hostname otherwise
+	*
+	* \remark Produces a NazaraAssert if the resolution is not done
+	*/
+
+	const String& ResolveHandle::GetHostname() const
+	{
+		NazaraAssert(IsValid() && IsDone(), "Resolution is not done");
+
+		return m_state->hostname;
+	}
+
+	/*!
+	* \brief Gets the informations about the host
+	* \return Resolved addresses for a hostname resolution, empty otherwise
+	*
+	* \remark Produces a NazaraAssert if the resolution is not done
+	*/
+
+	const std::vector<HostnameInfo>& ResolveHandle::GetResults() const
+	{
+		NazaraAssert(IsValid() && IsDone(), "Resolution is not done");
+
+		return m_state->results;
+	}
+
+	/*!
+	* \brief Gets the service of the resolution
+	* \return Resolved service for an address resolution, requested service otherwise
+	*
+	* \remark Produces a NazaraAssert if the resolution is not done
+	*/
+
+	const String& ResolveHandle::GetService() const
+	{
+		NazaraAssert(IsValid() && IsDone(), "Resolution is not done");
+
+		return m_state->service;
+	}
+
+	/*!
+	* \brief Checks whether the resolution is done
+	* \return true If the results (or the error) are available, or if the handle is invalid
+	*/
+
+	bool ResolveHandle::IsDone() const
+	{
+		return !m_state || m_state->done.load(std::memory_order_acquire);
+	}
+
+	/*!
+	* \brief Checks whether the handle references a resolution
+	* \return true If it is the case
+	*/
+
+	bool ResolveHandle::IsValid() const
+	{
+		return m_state != nullptr;
+	}
+
+	/*!
+	* \brief Releases the resolution referenced by this handle
+	*
+	* \remark This does not cancel the resolution, its callback is still called
+	*/
+
+	void ResolveHandle::Reset()
+	{
+		if (m_state)
+		{
+			m_state->RemoveReference();
+			m_state = nullptr;
+		}
+	}
+
+	/*!
+	* \brief Blocks until the resolution is done
+	*/
+
+	void ResolveHandle::Wait() const
+	{
+		if (IsDone())
+			return;
+
+		LockGuard lock(m_state->doneMutex);
+		while (!m_state->done.load(std::memory_order_acquire))
+			m_state->doneCondition.Wait(&m_state->doneMutex);
+	}
+
+	/*!
+	* \brief Makes the handle reference the same resolution as another
+	* \return A reference to this
+	*
+	* \param handle The other ResolveHandle
+	*/
+
+	ResolveHandle& ResolveHandle::operator=(const ResolveHandle& handle)
+	{
+		if (handle.m_state)
+			handle.m_state->AddReference();
+
+		Reset();
+		m_state = handle.m_state;
+
+		return *this;
+	}
+
+	/*!
+	* \brief Moves the ResolveHandle into this
+	* \return A reference to this
+	*
+	* \param handle ResolveHandle to move in this
+	*/
+
+	ResolveHandle& ResolveHandle::operator=(ResolveHandle&& handle) noexcept
+	{
+		std::swap(m_state, handle.m_state);
+		return *this;
+	}
+}
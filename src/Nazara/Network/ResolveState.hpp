@@ -0,0 +1,56 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_RESOLVESTATE_HPP
+#define NAZARA_RESOLVESTATE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/ResolveHandle.hpp>
+#include <atomic>
+#include <vector>
+
+namespace Nz
+{
+	struct ResolveState
+	{
+		ResolveState() :
+		error(ResolveError_NoError),
+		isReverse(false),
+		referenceCount(1),
+		done(false)
+		{
+		}
+
+		void AddReference()
+		{
+			referenceCount.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void RemoveReference()
+		{
+			if (referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete this;
+		}
+
+		ConditionVariable doneCondition;
+		IpAddress address;
+		Mutex doneMutex;
+		NetProtocol protocol;
+		ResolveCallback callback;
+		ResolveError error;
+		String hostname;
+		String service;
+		std::vector<HostnameInfo> results;
+		bool isReverse; // Resolves the hostname of the address instead of the addresses of the hostname
+		std::atomic_uint referenceCount;
+		std::atomic_bool done; // Results are only written by the resolver before this is set
+	};
+}
+
+#endif // NAZARA_RESOLVESTATE_HPP
@@ -0,0 +1,196 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/SocketPoller.hpp>
+#include <Nazara/Core/Error.hpp>
+
+#if defined(NAZARA_PLATFORM_WINDOWS)
+#include <Nazara/Network/Win32/SocketImpl.hpp>
+#include <Nazara/Network/Win32/SocketPollerImpl.hpp>
+#elif defined(NAZARA_PLATFORM_POSIX)
+#include <Nazara/Network/Posix/SocketImpl.hpp>
+#include <Nazara/Network/Posix/SocketPollerImpl.hpp>
+#else
+#error Missing implementation: SocketPoller
+#endif
+
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup network
+	* \class Nz::SocketPoller
+	* \brief Network class that waits for the readiness of many sockets at once
+	*
+	* Sockets are registered once for read and/or write readiness, then a single wait reports those which are ready.
+	* It relies on epoll on Linux, kqueue on BSD and macOS, WSAPoll (or select before Vista) on Windows.
+	*
+	* \remark Edge-triggered sockets must be non-blocking, and read or written until they would block
+	* \remark Windows has no edge-triggered polling, such sockets are reported as level-triggered ones (which is compatible with their use)
+	* \remark Other threads can interrupt a wait with Wake, for example once an asynchronous resolution (see IpAddress::ResolveHostnameAsync) is done
+	*/
+
+	/*!
+	* \brief Constructs a SocketPoller object
+	*/
+
+	SocketPoller::SocketPoller() :
+	m_impl(new SocketPollerImpl)
+	{
+	}
+
+	/*!
+	* \brief Destructs the object
+	*/
+
+	SocketPoller::~SocketPoller()
+	{
+		delete m_impl;
+	}
+
+	/*!
+	* \brief Unregisters every socket
+	*/
+
+	void SocketPoller::Clear()
+	{
+		m_impl->Clear();
+	}
+
+	/*!
+	* \brief Gets the sockets reported by the last wait
+	* \return Ready sockets, with their events and the userdata they were registered with
+	*/
+
+	const std::vector<SocketPoller::ReadySocket>& SocketPoller::GetReadySockets() const
+	{
+		return m_impl->GetReadySockets();
+	}
+
+	/*!
+	* \brief Gets the number of registered sockets
+	* \return Number of sockets
+	*/
+
+	std::size_t SocketPoller::GetSocketCount() const
+	{
+		return m_impl->GetSocketCount();
+	}
+
+	/*!
+	* \brief Checks whether the last wait reported a socket as ready to read
+	* \return true if the socket can be read without blocking
+	*
+	* \param socket Socket to check
+	*/
+
+	bool SocketPoller::IsReadyToRead(const AbstractSocket& socket) const
+	{
+		return (m_impl->GetReadyFlags(socket.GetNativeHandle()) & SocketPollEvent_Read) != 0;
+	}
+
+	/*!
+	* \brief Checks whether the last wait reported a socket as ready to write
+	* \return true if the socket can be written without blocking
+	*
+	* \param socket Socket to check
+	*/
+
+	bool SocketPoller::IsReadyToWrite(const AbstractSocket& socket) const
+	{
+		return (m_impl->GetReadyFlags(socket.GetNativeHandle()) & SocketPollEvent_Write) != 0;
+	}
+
+	/*!
+	* \brief Checks whether a socket is registered
+	* \return true if the socket is polled
+	*
+	* \param socket Socket to check
+	*/
+
+	bool SocketPoller::IsRegistered(const AbstractSocket& socket) const
+	{
+		return m_impl->IsRegistered(socket.GetNativeHandle());
+	}
+
+	/*!
+	* \brief Registers a socket
+	* \return true if the socket could be registered
+	*
+	* \param socket Socket to poll, it must stay open while registered
+	* \param eventFlags Combination of SocketPollEventFlags to wait for
+	* \param mode Whether readiness is reported when it happens or as long as it lasts
+	* \param userdata Pointer reported with the socket when it is ready
+	*
+	* \remark Produces a NazaraAssert if the socket is invalid or already registered
+	*/
+
+	bool SocketPoller::RegisterSocket(AbstractSocket& socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		NazaraAssert(socket.GetNativeHandle() != SocketImpl::InvalidHandle, "Invalid socket");
+		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
+
+		return m_impl->RegisterSocket(socket.GetNativeHandle(), eventFlags, mode, userdata);
+	}
+
+	/*!
+	* \brief Unregisters a socket
+	*
+	* \param socket Socket to stop polling, it will not be reported by the last wait anymore
+	*
+	* \remark Produces a NazaraAssert if the socket is not registered
+	* \remark Sockets must be unregistered before being closed
+	*/
+
+	void SocketPoller::UnregisterSocket(AbstractSocket& socket)
+	{
+		NazaraAssert(IsRegistered(socket), "Socket is not registered");
+
+		m_impl->UnregisterSocket(socket.GetNativeHandle());
+	}
+
+	/*!
+	* \brief Changes the events a socket is polled for
+	* \return true if the socket could be updated
+	*
+	* \param socket Registered socket
+	* \param eventFlags Combination of SocketPollEventFlags to wait for
+	* \param mode Whether readiness is reported when it happens or as long as it lasts
+	* \param userdata Pointer reported with the socket when it is ready
+	*
+	* \remark Produces a NazaraAssert if the socket is not registered
+	*/
+
+	bool SocketPoller::UpdateSocket(AbstractSocket& socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		NazaraAssert(IsRegistered(socket), "Socket is not registered");
+
+		return m_impl->UpdateSocket(socket.GetNativeHandle(), eventFlags, mode, userdata);
+	}
+
+	/*!
+	* \brief Waits until at least one socket is ready
+	* \return Number of ready sockets, zero on timeout, wake up or error
+	*
+	* \param msTimeout Maximum time to wait in milliseconds, -1 to wait indefinitely and 0 to return immediately
+	* \param error Optional argument to get the error
+	*/
+
+	std::size_t SocketPoller::Wait(int msTimeout, SocketError* error)
+	{
+		return m_impl->Wait(msTimeout, error);
+	}
+
+	/*!
+	* \brief Interrupts the current or next wait
+	*
+	* \remark This can be called from any thread
+	*/
+
+	void SocketPoller::Wake()
+	{
+		m_impl->Wake();
+	}
+}
@@ -4,7 +4,10 @@
 
 #include <Nazara/Network/TcpClient.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <Nazara/Network/NetPacket.hpp>
 
@@ -24,6 +27,9 @@ namespace Nz
 	* \ingroup network
 	* \class Nz::TcpClient
 	* \brief Network class that represents a client in a TCP connection
+	*
+	* With write coalescing, packets and stream writes are gathered in a buffer sent once it is big or old enough,
+	* so many small messages take a single system call. Flush sends it at once, for example at the end of a frame.
 	*/
 
 	/*!
@@ -106,6 +112,7 @@ namespace Nz
 	* \param lowDelay Should low delay be used
 	*
 	* \remark This may produce lag
+	* \remark Enabling low delay sends the data waiting in the write buffer
 	*/
 
 	void TcpClient::EnableLowDelay(bool lowDelay)
@@ -117,6 +124,9 @@ namespace Nz
 
 			m_isLowDelayEnabled = lowDelay;
 		}
+
+		if (lowDelay && !m_writeBuffer.IsEmpty())
+			FlushWriteBuffer();
 	}
 
 	/*!
@@ -140,6 +150,28 @@ namespace Nz
 		}
 	}
 
+	/*!
+	* \brief Enables the gathering of small writes before sending them
+	*
+	* \param coalescing Should packets and stream writes be gathered
+	* \param flushSize Size from which gathered data is sent (a write reaching it is sent along without being copied)
+	* \param msFlushDelay Time in milliseconds after which gathered data is sent by the next write
+	*
+	* \remark Data is only sent by writes or by Flush, call it when no more writes are expected for a while
+	* \remark Coalescing is best used with low delay enabled, each flush is then sent at once instead of waiting for Nagle's algorithm
+	* \remark Disabling coalescing sends the data waiting in the write buffer
+	*/
+
+	void TcpClient::EnableWriteCoalescing(bool coalescing, std::size_t flushSize, UInt32 msFlushDelay)
+	{
+		m_isWriteCoalescingEnabled = coalescing;
+		m_writeBufferFlushDelay = msFlushDelay;
+		m_writeBufferFlushSize = flushSize;
+
+		if (!coalescing && !m_writeBuffer.IsEmpty())
+			FlushWriteBuffer();
+	}
+
 	/*!
 	* \brief Checks whether the stream reached the end of the stream
 	* \return true if there is no more available bytes
@@ -305,6 +337,51 @@ namespace Nz
 		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
 		NazaraAssert(buffer && size > 0, "Invalid buffer");
 
+		// Data waiting in the write buffer comes first, it is sent by the same system call
+		std::array<NetBuffer, 2> buffers;
+		std::size_t bufferCount = 0;
+		if (!m_writeBuffer.IsEmpty())
+		{
+			buffers[bufferCount].data = m_writeBuffer.GetBuffer();
+			buffers[bufferCount].dataLength = m_writeBuffer.GetSize();
+			bufferCount++;
+		}
+
+		buffers[bufferCount].data = const_cast<void*>(buffer);
+		buffers[bufferCount].dataLength = size;
+		bufferCount++;
+
+		std::size_t totalByteSent;
+		bool result = SendMultiple(buffers.data(), bufferCount, &totalByteSent);
+
+		std::size_t writeBufferSent = std::min(totalByteSent, m_writeBuffer.GetSize());
+		m_writeBuffer.Erase(m_writeBuffer.begin(), m_writeBuffer.begin() + writeBufferSent);
+
+		if (sent)
+			*sent = totalByteSent - writeBufferSent;
+
+		return result;
+	}
+
+	/*!
+	* \brief Sends multiple buffers at once, one after the other
+	* \return true If every buffer was sent
+	*
+	* \param buffers Buffers to send, gathered by a single system call (scatter/gather I/O)
+	* \param bufferCount Number of buffers
+	* \param sent Optional argument to get the number of bytes sent
+	*
+	* \remark Large sending are handled, you do not need to call this multiple time
+	* \remark Data waiting in the write buffer is not sent first, Flush should be called before if there is some
+	* \remark Produces a NazaraAssert if socket is invalid
+	* \remark Produces a NazaraAssert if buffers are invalid
+	*/
+
+	bool TcpClient::SendMultiple(const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
 		CallOnExit updateSent;
 		std::size_t totalByteSent = 0;
 		if (sent)
@@ -315,11 +392,24 @@ namespace Nz
 			});
 		}
 
-		while (totalByteSent < size)
+		std::size_t bufferIndex = 0;
+		std::size_t bufferOffset = 0; //< Bytes of the current buffer already sent
+		while (bufferIndex < bufferCount)
 		{
-			int sendSize = static_cast<int>(std::min<std::size_t>(size - totalByteSent, std::numeric_limits<int>::max())); //< Handle very large send
-			int sentSize;
-			if (!SocketImpl::Send(m_handle, static_cast<const UInt8*>(buffer) + totalByteSent, sendSize, &sentSize, &m_lastError))
+			std::size_t sentSize;
+			bool result;
+			if (bufferOffset > 0)
+			{
+				// A buffer which was partially sent is finished on its own
+				int sendSize = static_cast<int>(std::min<std::size_t>(buffers[bufferIndex].dataLength - bufferOffset, std::numeric_limits<int>::max())); //< Handle very large send
+				int partSent;
+				result = SocketImpl::Send(m_handle, static_cast<const UInt8*>(buffers[bufferIndex].data) + bufferOffset, sendSize, &partSent, &m_lastError);
+				sentSize = static_cast<std::size_t>(partSent);
+			}
+			else
+				result = SocketImpl::SendMultiple(m_handle, &buffers[bufferIndex], bufferCount - bufferIndex, &sentSize, &m_lastError);
+
+			if (!result)
 			{
 				switch (m_lastError)
 				{
@@ -336,6 +426,12 @@ namespace Nz
 			}
 
 			totalByteSent += sentSize;
+
+			sentSize += bufferOffset;
+			while (bufferIndex < bufferCount && sentSize >= buffers[bufferIndex].dataLength)
+				sentSize -= buffers[bufferIndex++].dataLength;
+
+			bufferOffset = sentSize;
 		}
 
 		UpdateState(SocketState_Connected);
@@ -349,6 +445,7 @@ namespace Nz
 	* \param packet Packet to send
 	*
 	* \remark Produces a NazaraError if packet could not be prepared for sending
+	* \remark The packet is gathered with the following ones if write coalescing is enabled
 	*/
 
 	bool TcpClient::SendPacket(const NetPacket& packet)
@@ -362,6 +459,9 @@ namespace Nz
 			return false;
 		}
 
+		if (m_isWriteCoalescingEnabled)
+			return WriteCoalesced(ptr, size);
+
 		return Send(ptr, size, nullptr);
 	}
 
@@ -434,11 +534,31 @@ namespace Nz
 	}
 
 	/*!
-	* \brief Flushes the stream
+	* \brief Sends the data waiting in the write buffer
+	* \return true If successful
+	*/
+
+	bool TcpClient::FlushWriteBuffer()
+	{
+		NetBuffer buffer;
+		buffer.data = m_writeBuffer.GetBuffer();
+		buffer.dataLength = m_writeBuffer.GetSize();
+
+		std::size_t sent;
+		bool result = SendMultiple(&buffer, 1, &sent);
+		m_writeBuffer.Erase(m_writeBuffer.begin(), m_writeBuffer.begin() + sent);
+
+		return result;
+	}
+
+	/*!
+	* \brief Flushes the stream, sending the data waiting in the write buffer
 	*/
 
 	void TcpClient::FlushStream()
 	{
+		if (!m_writeBuffer.IsEmpty())
+			FlushWriteBuffer();
 	}
 
 	/*!
@@ -451,6 +571,7 @@ namespace Nz
 
 		m_openMode = OpenMode_NotOpen;
 		m_peerAddress = IpAddress::Invalid;
+		m_writeBuffer.Clear();
 	}
 
 	/*!
@@ -547,10 +668,39 @@ namespace Nz
 			});
 		}
 
+		if (m_isWriteCoalescingEnabled)
+			return (WriteCoalesced(buffer, size)) ? size : 0;
+
 		std::size_t sent;
 		if (!Send(buffer, size, &sent))
 			sent = 0;
 
 		return sent;
 	}
+
+	/*!
+	* \brief Gathers data in the write buffer, which is sent once it is big or old enough
+	* \return true If successful
+	*
+	* \param buffer Data to send
+	* \param size Size of the data
+	*/
+
+	bool TcpClient::WriteCoalesced(const void* buffer, std::size_t size)
+	{
+		// Data reaching the flush size is sent with the write buffer, without being copied
+		if (m_writeBuffer.GetSize() + size >= m_writeBufferFlushSize)
+			return Send(buffer, size, nullptr);
+
+		UInt64 now = GetElapsedMilliseconds();
+		if (m_writeBuffer.IsEmpty())
+			m_writeBufferTime = now;
+
+		m_writeBuffer.Append(buffer, size);
+
+		if (now - m_writeBufferTime >= m_writeBufferFlushDelay)
+			return FlushWriteBuffer();
+
+		return true;
+	}
 }
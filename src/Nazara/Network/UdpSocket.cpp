@@ -4,6 +4,8 @@
 
 #include <Nazara/Network/UdpSocket.hpp>
 #include <Nazara/Network/NetPacket.hpp>
+#include <cstring>
+#include <utility>
 
 #if defined(NAZARA_PLATFORM_WINDOWS)
 #include <Nazara/Network/Win32/SocketImpl.hpp>
@@ -101,6 +103,84 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Receives many packets with as few system calls as possible
+	* \return true If no error occurred, even if no packet was received
+	*
+	* \param packets Array of packets to fill, the valid packets are written to its front
+	* \param from Optional array of the same size to get the IpAddress of their peers
+	* \param count Maximum number of packets to receive
+	* \param received Optional argument to get the number of valid packets received
+	*
+	* \remark Only the first packet may block, the following ones are received if they are already available
+	* \remark Produces a NazaraAssert if socket is invalid
+	* \remark Produces a NazaraAssert if packets are invalid
+	* \remark Produces a NazaraWarning if a packet's header is invalid, the packet is then discarded
+	*/
+
+	bool UdpSocket::ReceiveMultiple(NetPacket* packets, IpAddress* from, std::size_t count, std::size_t* received)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Socket hasn't been created");
+		NazaraAssert(packets && count > 0, "Invalid packets");
+
+		// Same as ReceivePacket, any datagram size is accepted: the datagrams are received in raw buffers kept between calls,
+		// and only their actual size is copied to the packets
+		constexpr std::size_t MaxDatagramSize = std::numeric_limits<UInt16>::max();
+		if (m_buffers.size() < count)
+		{
+			m_receiveBuffer.reset(new UInt8[count * MaxDatagramSize]);
+			m_buffers.resize(count);
+			m_bufferSizes.resize(count);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				m_buffers[i].data = &m_receiveBuffer[i * MaxDatagramSize];
+				m_buffers[i].dataLength = MaxDatagramSize;
+			}
+		}
+
+		std::size_t datagramCount;
+		if (!SocketImpl::ReceiveMultiple(m_handle, m_buffers.data(), count, from, m_bufferSizes.data(), &datagramCount, &m_lastError))
+			return false;
+
+		std::size_t packetCount = 0;
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			std::size_t size = m_bufferSizes[i];
+
+			const UInt8* data = static_cast<const UInt8*>(m_buffers[i].data);
+
+			Nz::UInt16 netCode;
+			Nz::UInt16 packetSize;
+			if (size < NetPacket::HeaderSize || !NetPacket::DecodeHeader(data, &packetSize, &netCode))
+			{
+				m_lastError = SocketError_Packet;
+				NazaraWarning("Invalid header data");
+				continue;
+			}
+
+			if (packetSize != size)
+			{
+				m_lastError = SocketError_Packet;
+				NazaraWarning("Invalid packet size (packet size is " + String::Number(packetSize) + " bytes, received " + String::Number(size) + " bytes)");
+				continue;
+			}
+
+			if (from && packetCount != i)
+				from[packetCount] = from[i];
+
+			NetPacket& packet = packets[packetCount++];
+			packet.Reset(netCode, size - NetPacket::HeaderSize);
+			packet.Resize(size);
+			std::memcpy(packet.GetData(), data, size);
+		}
+
+		if (received)
+			*received = packetCount;
+
+		return true;
+	}
+
 	/*!
 	* \brief Receives the packet available
 	* \return true If packet received
@@ -179,6 +259,81 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Sends many datagrams, each one gathered from many buffers, with as few system calls as possible
+	* \return true If every datagram was sent
+	*
+	* \param to Array of the IpAddress of their peers
+	* \param buffers Array of the buffers of the datagrams, buffersPerDatagram consecutive buffers making one datagram
+	* \param buffersPerDatagram Number of buffers gathered in each datagram (at most four)
+	* \param count Number of datagrams to send
+	* \param sent Optional argument to get the number of datagrams sent before an error occurred
+	*
+	* \remark Buffers may be shared between datagrams, which allows to send the same payload to many peers with their own header without copying it
+	* \remark Produces a NazaraAssert if socket is invalid
+	* \remark Produces a NazaraAssert if buffers are invalid
+	*/
+
+	bool UdpSocket::SendMultiple(const IpAddress* to, const NetBuffer* buffers, std::size_t buffersPerDatagram, std::size_t count, std::size_t* sent)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Socket hasn't been created");
+		NazaraAssert(to && buffers && count > 0, "Invalid buffers");
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			NazaraAssert(to[i].IsValid(), "Invalid ip address");
+			NazaraAssert(to[i].GetProtocol() == m_protocol, "IP Address has a different protocol than the socket");
+		}
+
+		return SocketImpl::SendMultiple(m_handle, buffers, buffersPerDatagram, count, to, sent, &m_lastError);
+	}
+
+	/*!
+	* \brief Sends many packets with as few system calls as possible
+	* \return true If every packet was sent
+	*
+	* \param to Array of the IpAddress of their peers
+	* \param packets Array of pointers to the packets to send
+	* \param count Number of packets to send
+	* \param sent Optional argument to get the number of packets sent before an error occurred
+	*
+	* \remark Produces a NazaraAssert if socket is invalid
+	* \remark Produces a NazaraAssert if packets are invalid
+	* \remark Produces a NazaraError if a packet could not be prepared for sending
+	*/
+
+	bool UdpSocket::SendMultiple(const IpAddress* to, const NetPacket* const* packets, std::size_t count, std::size_t* sent)
+	{
+		NazaraAssert(m_handle != SocketImpl::InvalidHandle, "Socket hasn't been created");
+		NazaraAssert(to && packets && count > 0, "Invalid packets");
+
+		m_buffers.resize(count);
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			NazaraAssert(to[i].IsValid(), "Invalid ip address");
+			NazaraAssert(to[i].GetProtocol() == m_protocol, "IP Address has a different protocol than the socket");
+
+			std::size_t size = 0;
+			const void* ptr = packets[i]->OnSend(&size);
+			if (!ptr)
+			{
+				m_lastError = SocketError_Packet;
+				NazaraError("Failed to prepare packet");
+
+				if (sent)
+					*sent = 0;
+
+				return false;
+			}
+
+			m_buffers[i].data = const_cast<void*>(ptr); //< Only read by the system
+			m_buffers[i].dataLength = size;
+		}
+
+		return SocketImpl::SendMultiple(m_handle, m_buffers.data(), 1, count, to, sent, &m_lastError);
+	}
+
 	/*!
 	* \brief Sends the packet available
 	* \return true If packet sent
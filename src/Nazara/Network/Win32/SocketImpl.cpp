@@ -6,6 +6,9 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <Nazara/Network/Win32/IpAddressImpl.hpp>
+#include <algorithm>
+#include <array>
+#include <limits>
 
 #include <Winsock2.h>
 #ifdef NAZARA_COMPILER_MINGW
@@ -26,6 +29,12 @@ struct tcp_keepalive
 
 namespace Nz
 {
+	namespace
+	{
+		constexpr std::size_t MaxDatagramBuffers = 4; //< Buffers gathered in a single datagram
+		constexpr std::size_t MaxSendBuffers = 64; //< Buffers gathered by a single call
+	}
+
 	SocketHandle SocketImpl::Accept(SocketHandle handle, IpAddress* address, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -514,6 +523,50 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::ReceiveMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, IpAddress* from, std::size_t* read, std::size_t* received, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		std::size_t datagramCount = 0;
+		for (; datagramCount < bufferCount; ++datagramCount)
+		{
+			// Only the first datagram may block, the following ones are read if they are already there
+			if (datagramCount > 0 && QueryAvailableBytes(handle) == 0)
+				break;
+
+			const NetBuffer& buffer = buffers[datagramCount];
+
+			int byteRead;
+			SocketError receiveError;
+			if (!ReceiveFrom(handle, buffer.data, static_cast<int>(buffer.dataLength), (from) ? &from[datagramCount] : nullptr, &byteRead, &receiveError))
+			{
+				// The error will be reported by the next call, once the received datagrams have been handled
+				if (datagramCount > 0)
+					break;
+
+				if (error)
+					*error = receiveError;
+
+				return false;
+			}
+
+			if (byteRead == 0)
+				break; //< No more datagram
+
+			if (read)
+				read[datagramCount] = byteRead;
+		}
+
+		if (received)
+			*received = datagramCount;
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::Send(SocketHandle handle, const void* buffer, int length, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -537,6 +590,81 @@ namespace Nz
 		return true;
 	}
 
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t bufferCount, std::size_t* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && bufferCount > 0, "Invalid buffers");
+
+		// Buffers past the limit are left to the next call, as are the bytes the socket did not accept
+		std::array<WSABUF, MaxSendBuffers> wsaBuffers;
+		std::size_t wsaBufferCount = std::min(bufferCount, MaxSendBuffers);
+		for (std::size_t i = 0; i < wsaBufferCount; ++i)
+		{
+			wsaBuffers[i].buf = static_cast<CHAR*>(buffers[i].data);
+			wsaBuffers[i].len = static_cast<ULONG>(std::min<std::size_t>(buffers[i].dataLength, std::numeric_limits<ULONG>::max()));
+		}
+
+		DWORD byteSent;
+		if (WSASend(handle, wsaBuffers.data(), static_cast<DWORD>(wsaBufferCount), &byteSent, 0, nullptr, nullptr) == SOCKET_ERROR)
+		{
+			if (error)
+				*error = TranslateWSAErrorToSocketError(WSAGetLastError());
+
+			return false; //< Error
+		}
+
+		if (sent)
+			*sent = byteSent;
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
+	bool SocketImpl::SendMultiple(SocketHandle handle, const NetBuffer* buffers, std::size_t buffersPerDatagram, std::size_t datagramCount, const IpAddress* to, std::size_t* sent, SocketError* error)
+	{
+		NazaraAssert(handle != InvalidHandle, "Invalid handle");
+		NazaraAssert(buffers && to && datagramCount > 0, "Invalid buffers");
+		NazaraAssert(buffersPerDatagram > 0 && buffersPerDatagram <= MaxDatagramBuffers, "Invalid buffer count per datagram");
+
+		// Each datagram gathers its buffers (like a header shared by no other datagram followed by a shared payload)
+		std::array<WSABUF, MaxDatagramBuffers> wsaBuffers;
+		IpAddressImpl::SockAddrBuffer nameBuffer;
+
+		for (std::size_t i = 0; i < datagramCount; ++i)
+		{
+			for (std::size_t j = 0; j < buffersPerDatagram; ++j)
+			{
+				const NetBuffer& buffer = buffers[i * buffersPerDatagram + j];
+				wsaBuffers[j].buf = static_cast<CHAR*>(buffer.data);
+				wsaBuffers[j].len = static_cast<ULONG>(buffer.dataLength);
+			}
+
+			int nameLength = IpAddressImpl::ToSockAddr(to[i], nameBuffer.data());
+
+			DWORD byteSent;
+			if (WSASendTo(handle, wsaBuffers.data(), static_cast<DWORD>(buffersPerDatagram), &byteSent, 0, reinterpret_cast<const sockaddr*>(nameBuffer.data()), nameLength, nullptr, nullptr) == SOCKET_ERROR)
+			{
+				if (error)
+					*error = TranslateWSAErrorToSocketError(WSAGetLastError());
+
+				if (sent)
+					*sent = i;
+
+				return false;
+			}
+		}
+
+		if (sent)
+			*sent = datagramCount;
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return true;
+	}
+
 	bool SocketImpl::SendTo(SocketHandle handle, const void* buffer, int length, const IpAddress& to, int* sent, SocketError* error)
 	{
 		NazaraAssert(handle != InvalidHandle, "Invalid handle");
@@ -0,0 +1,325 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Network/Win32/SocketPollerImpl.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Network/Win32/SocketImpl.hpp>
+#include <Nazara/Network/Debug.hpp>
+
+namespace Nz
+{
+	SocketPollerImpl::SocketPollerImpl()
+	{
+		// Windows cannot poll pipes, other threads send a datagram to this loopback socket to interrupt a wait
+		m_wakeUpSocket = SocketImpl::Create(NetProtocol_IPv4, SocketType_UDP, nullptr);
+		if (m_wakeUpSocket == SocketImpl::InvalidHandle)
+		{
+			NazaraError("Failed to create wake up socket");
+			return;
+		}
+
+		if (SocketImpl::Bind(m_wakeUpSocket, IpAddress::LoopbackIpV4, nullptr) != SocketState_Bound || !SocketImpl::SetBlocking(m_wakeUpSocket, false))
+		{
+			NazaraError("Failed to bind wake up socket");
+
+			SocketImpl::Close(m_wakeUpSocket);
+			m_wakeUpSocket = SocketImpl::InvalidHandle;
+			return;
+		}
+
+		m_wakeUpAddress = SocketImpl::QuerySocketAddress(m_wakeUpSocket);
+
+		RegisterWakeUp();
+	}
+
+	SocketPollerImpl::~SocketPollerImpl()
+	{
+		if (m_wakeUpSocket != SocketImpl::InvalidHandle)
+			SocketImpl::Close(m_wakeUpSocket);
+	}
+
+	void SocketPollerImpl::Clear()
+	{
+		m_pollSockets.clear();
+		m_readySockets.clear();
+		m_sockets.clear();
+
+		RegisterWakeUp();
+	}
+
+	const std::vector<SocketPoller::ReadySocket>& SocketPollerImpl::GetReadySockets() const
+	{
+		return m_readySockets;
+	}
+
+	std::size_t SocketPollerImpl::GetSocketCount() const
+	{
+		return m_sockets.size();
+	}
+
+	UInt32 SocketPollerImpl::GetReadyFlags(SocketHandle socket) const
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end())
+			return SocketPollEvent_None;
+
+		return it->second.readyFlags;
+	}
+
+	bool SocketPollerImpl::IsRegistered(SocketHandle socket) const
+	{
+		return m_sockets.find(socket) != m_sockets.end();
+	}
+
+	bool SocketPollerImpl::RegisterSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		NazaraAssert(!IsRegistered(socket), "Socket is already registered");
+
+		// Neither WSAPoll nor select are edge-triggered, readiness is reported as long as it lasts
+		NazaraUnused(mode);
+
+		Registration& registration = m_sockets[socket];
+		registration.eventFlags = eventFlags;
+		registration.index = m_pollSockets.size();
+		registration.readyFlags = SocketPollEvent_None;
+		registration.readyIndex = 0;
+		registration.userdata = userdata;
+
+		#ifdef NAZARA_NETWORK_WSAPOLL
+		WSAPOLLFD pollSocket;
+		pollSocket.fd = socket;
+		pollSocket.events = ((eventFlags & SocketPollEvent_Read) ? POLLRDNORM : 0) | ((eventFlags & SocketPollEvent_Write) ? POLLWRNORM : 0);
+		pollSocket.revents = 0;
+
+		m_pollSockets.push_back(pollSocket);
+		#else
+		m_pollSockets.push_back(socket);
+		#endif
+
+		return true;
+	}
+
+	void SocketPollerImpl::UnregisterSocket(SocketHandle socket)
+	{
+		auto it = m_sockets.find(socket);
+		NazaraAssert(it != m_sockets.end(), "Socket is not registered");
+
+		// The last polled socket takes the place of the removed one
+		std::size_t index = it->second.index;
+		if (index != m_pollSockets.size() - 1)
+		{
+			m_pollSockets[index] = m_pollSockets.back();
+
+			#ifdef NAZARA_NETWORK_WSAPOLL
+			m_sockets[m_pollSockets[index].fd].index = index;
+			#else
+			m_sockets[m_pollSockets[index]].index = index;
+			#endif
+		}
+		m_pollSockets.pop_back();
+
+		// The socket may not be valid anymore, it must not be reported by the last wait
+		if (it->second.readyFlags != SocketPollEvent_None)
+		{
+			std::size_t readyIndex = it->second.readyIndex;
+			m_readySockets.erase(m_readySockets.begin() + readyIndex);
+
+			for (std::size_t i = readyIndex; i < m_readySockets.size(); ++i)
+				m_sockets[m_readySockets[i].handle].readyIndex = i;
+		}
+
+		m_sockets.erase(it);
+	}
+
+	bool SocketPollerImpl::UpdateSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata)
+	{
+		auto it = m_sockets.find(socket);
+		NazaraAssert(it != m_sockets.end(), "Socket is not registered");
+
+		NazaraUnused(mode);
+
+		Registration& registration = it->second;
+		registration.eventFlags = eventFlags;
+		registration.userdata = userdata;
+
+		#ifdef NAZARA_NETWORK_WSAPOLL
+		m_pollSockets[registration.index].events = ((eventFlags & SocketPollEvent_Read) ? POLLRDNORM : 0) | ((eventFlags & SocketPollEvent_Write) ? POLLWRNORM : 0);
+		#endif
+
+		return true;
+	}
+
+	std::size_t SocketPollerImpl::Wait(int msTimeout, SocketError* error)
+	{
+		for (const SocketPoller::ReadySocket& readySocket : m_readySockets)
+			m_sockets[readySocket.handle].readyFlags = SocketPollEvent_None;
+
+		m_readySockets.clear();
+
+		// Both WSAPoll and select fail without any socket
+		if (m_pollSockets.empty())
+		{
+			if (msTimeout > 0)
+				Thread::Sleep(msTimeout);
+
+			if (error)
+				*error = SocketError_NoError;
+
+			return 0;
+		}
+
+		#ifdef NAZARA_NETWORK_WSAPOLL
+		int eventCount = WSAPoll(m_pollSockets.data(), static_cast<ULONG>(m_pollSockets.size()), msTimeout);
+		if (eventCount == SOCKET_ERROR)
+		{
+			if (error)
+				*error = SocketImpl::TranslateWSAErrorToSocketError(WSAGetLastError());
+
+			return 0;
+		}
+
+		for (WSAPOLLFD& pollSocket : m_pollSockets)
+		{
+			if (eventCount == 0)
+				break;
+
+			if (pollSocket.revents == 0)
+				continue;
+
+			eventCount--;
+
+			if (pollSocket.fd == m_wakeUpSocket)
+			{
+				DrainWakeUp();
+				continue;
+			}
+
+			// Errors and hang-ups are reported to both directions, the next read or write returns them
+			UInt32 eventFlags = SocketPollEvent_None;
+			if (pollSocket.revents & (POLLRDNORM | POLLHUP | POLLERR))
+				eventFlags |= SocketPollEvent_Read;
+
+			if (pollSocket.revents & (POLLWRNORM | POLLHUP | POLLERR))
+				eventFlags |= SocketPollEvent_Write;
+
+			ReportEvents(pollSocket.fd, eventFlags);
+		}
+		#else
+		// Windows fd_set is a count followed by an array, it can be allocated for more than FD_SETSIZE sockets
+		m_readSet.resize(m_pollSockets.size() + 1);
+		m_writeSet.resize(m_pollSockets.size() + 1);
+
+		fd_set* readSet = reinterpret_cast<fd_set*>(m_readSet.data());
+		fd_set* writeSet = reinterpret_cast<fd_set*>(m_writeSet.data());
+		readSet->fd_count = 0;
+		writeSet->fd_count = 0;
+
+		for (SocketHandle socket : m_pollSockets)
+		{
+			if (socket == m_wakeUpSocket)
+			{
+				readSet->fd_array[readSet->fd_count++] = socket;
+				continue;
+			}
+
+			UInt32 eventFlags = m_sockets[socket].eventFlags;
+			if (eventFlags & SocketPollEvent_Read)
+				readSet->fd_array[readSet->fd_count++] = socket;
+
+			if (eventFlags & SocketPollEvent_Write)
+				writeSet->fd_array[writeSet->fd_count++] = socket;
+		}
+
+		timeval timeout;
+		timeout.tv_sec = msTimeout / 1000;
+		timeout.tv_usec = (msTimeout % 1000) * 1000;
+
+		int eventCount = select(0, readSet, writeSet, nullptr, (msTimeout >= 0) ? &timeout : nullptr);
+		if (eventCount == SOCKET_ERROR)
+		{
+			if (error)
+				*error = SocketImpl::TranslateWSAErrorToSocketError(WSAGetLastError());
+
+			return 0;
+		}
+
+		// Sets only keep the ready sockets once select returns
+		for (u_int i = 0; i < readSet->fd_count; ++i)
+		{
+			if (readSet->fd_array[i] == m_wakeUpSocket)
+				DrainWakeUp();
+			else
+				ReportEvents(readSet->fd_array[i], SocketPollEvent_Read);
+		}
+
+		for (u_int i = 0; i < writeSet->fd_count; ++i)
+			ReportEvents(writeSet->fd_array[i], SocketPollEvent_Write);
+		#endif
+
+		if (error)
+			*error = SocketError_NoError;
+
+		return m_readySockets.size();
+	}
+
+	void SocketPollerImpl::Wake()
+	{
+		if (m_wakeUpSocket != SocketImpl::InvalidHandle)
+			SocketImpl::SendTo(m_wakeUpSocket, "", 1, m_wakeUpAddress, nullptr, nullptr);
+	}
+
+	void SocketPollerImpl::DrainWakeUp()
+	{
+		char buffer[64];
+		int read;
+		while (SocketImpl::ReceiveFrom(m_wakeUpSocket, buffer, sizeof(buffer), nullptr, &read, nullptr) && read > 0);
+	}
+
+	void SocketPollerImpl::RegisterWakeUp()
+	{
+		if (m_wakeUpSocket == SocketImpl::InvalidHandle)
+			return;
+
+		#ifdef NAZARA_NETWORK_WSAPOLL
+		WSAPOLLFD pollSocket;
+		pollSocket.fd = m_wakeUpSocket;
+		pollSocket.events = POLLRDNORM;
+		pollSocket.revents = 0;
+
+		m_pollSockets.push_back(pollSocket);
+		#else
+		m_pollSockets.push_back(m_wakeUpSocket);
+		#endif
+	}
+
+	void SocketPollerImpl::ReportEvents(SocketHandle socket, UInt32 eventFlags)
+	{
+		auto it = m_sockets.find(socket);
+		if (it == m_sockets.end())
+			return;
+
+		// Only the requested events are reported
+		Registration& registration = it->second;
+		eventFlags &= registration.eventFlags;
+		if (eventFlags == SocketPollEvent_None)
+			return;
+
+		if (registration.readyFlags == SocketPollEvent_None)
+		{
+			registration.readyIndex = m_readySockets.size();
+
+			SocketPoller::ReadySocket readySocket;
+			readySocket.handle = socket;
+			readySocket.eventFlags = eventFlags;
+			readySocket.userdata = registration.userdata;
+
+			m_readySockets.push_back(readySocket);
+		}
+		else
+			m_readySockets[registration.readyIndex].eventFlags |= eventFlags; //< Reported in both sets by select
+
+		registration.readyFlags |= eventFlags;
+	}
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Network module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SOCKETPOLLERIMPL_HPP
+#define NAZARA_SOCKETPOLLERIMPL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Network/IpAddress.hpp>
+#include <Nazara/Network/SocketHandle.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <unordered_map>
+#include <vector>
+#include <winsock2.h>
+
+// WSAPoll is only available since Vista, select is used otherwise
+#if NAZARA_WINNT >= 0x0600
+	#define NAZARA_NETWORK_WSAPOLL
+#endif
+
+namespace Nz
+{
+	class SocketPollerImpl
+	{
+		public:
+			SocketPollerImpl();
+			SocketPollerImpl(const SocketPollerImpl&) = delete;
+			SocketPollerImpl(SocketPollerImpl&&) = delete;
+			~SocketPollerImpl();
+
+			void Clear();
+
+			const std::vector<SocketPoller::ReadySocket>& GetReadySockets() const;
+			std::size_t GetSocketCount() const;
+
+			UInt32 GetReadyFlags(SocketHandle socket) const;
+
+			bool IsRegistered(SocketHandle socket) const;
+
+			bool RegisterSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata);
+			void UnregisterSocket(SocketHandle socket);
+			bool UpdateSocket(SocketHandle socket, UInt32 eventFlags, SocketPollMode mode, void* userdata);
+
+			std::size_t Wait(int msTimeout, SocketError* error);
+			void Wake();
+
+			SocketPollerImpl& operator=(const SocketPollerImpl&) = delete;
+			SocketPollerImpl& operator=(SocketPollerImpl&&) = delete;
+
+		private:
+			struct Registration
+			{
+				UInt32 eventFlags;
+				UInt32 readyFlags; //< Events reported by the last wait
+				std::size_t index; //< Position in the polled sockets
+				std::size_t readyIndex;
+				void* userdata;
+			};
+
+			void DrainWakeUp();
+			void RegisterWakeUp();
+			void ReportEvents(SocketHandle socket, UInt32 eventFlags);
+
+			#ifdef NAZARA_NETWORK_WSAPOLL
+			std::vector<WSAPOLLFD> m_pollSockets;
+			#else
+			std::vector<SocketHandle> m_pollSockets;
+			std::vector<SOCKET> m_readSet;
+			std::vector<SOCKET> m_writeSet;
+			#endif
+			std::unordered_map<SocketHandle, Registration> m_sockets;
+			std::vector<SocketPoller::ReadySocket> m_readySockets;
+			IpAddress m_wakeUpAddress;
+			SocketHandle m_wakeUpSocket; //< Always the first polled socket, it is never moved by unregistrations
+	};
+}
+
+#endif // NAZARA_SOCKETPOLLERIMPL_HPP
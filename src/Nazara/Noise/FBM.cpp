@@ -3,6 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Noise/FBM.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
 #include <Nazara/Noise/Debug.hpp>
 
 namespace Nz
@@ -59,4 +62,59 @@ namespace Nz
 
 		return value / m_sum;
 	}
+
+	void FBM::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	void FBM::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y * size.z, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	std::size_t FBM::GetParametersHash() const
+	{
+		std::size_t hash = MixerBase::GetParametersHash();
+		HashCombine(hash, m_source.GetParametersHash());
+
+		return hash;
+	}
+
+	// Same as Get, but each octave is computed for the whole grid at once
+	void FBM::ComputeGrid(std::size_t sampleCount, float scale, float* output, const std::function<void(float octaveScale, float* octave)>& sourceGrid) const
+	{
+		std::fill(output, output + sampleCount, 0.f);
+
+		std::vector<float> octave(sampleCount);
+		for(int i = 0; i < m_octaves; ++i)
+		{
+			sourceGrid(scale, octave.data());
+
+			float exponent = m_exponent_array.at(i);
+			for (std::size_t j = 0; j < sampleCount; ++j)
+				output[j] += octave[j] * exponent;
+
+			scale *= m_lacunarity;
+		}
+
+		float remainder = m_octaves - static_cast<int>(m_octaves);
+		if(std::fabs(remainder) > 0.01f)
+		{
+			sourceGrid(scale, octave.data());
+
+			float exponent = m_exponent_array.at(static_cast<int>(m_octaves-1));
+			for (std::size_t j = 0; j < sampleCount; ++j)
+				output[j] += remainder * octave[j] * exponent;
+		}
+
+		for (std::size_t j = 0; j < sampleCount; ++j)
+			output[j] /= m_sum;
+	}
 }
@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Noise/HybridMultiFractal.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <algorithm>
 #include <Nazara/Noise/Debug.hpp>
 
 namespace Nz
@@ -95,4 +97,77 @@ namespace Nz
 
 		return value / m_sum - offset;
 	}
+
+	void HybridMultiFractal::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	void HybridMultiFractal::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		ComputeGrid(std::size_t(size.x) * size.y * size.z, scale, output, [&](float octaveScale, float* octave)
+		{
+			m_source.GetGrid(origin, step, size, octaveScale, octave);
+		});
+	}
+
+	std::size_t HybridMultiFractal::GetParametersHash() const
+	{
+		std::size_t hash = MixerBase::GetParametersHash();
+		HashCombine(hash, m_source.GetParametersHash());
+
+		return hash;
+	}
+
+	// Same as Get, but each octave is computed for the whole grid at once
+	void HybridMultiFractal::ComputeGrid(std::size_t sampleCount, float scale, float* output, const std::function<void(float octaveScale, float* octave)>& sourceGrid) const
+	{
+		float offset = 1.0f;
+
+		std::vector<float> octave(sampleCount);
+		sourceGrid(scale, octave.data());
+
+		std::vector<float> weights(sampleCount);
+		float exponent = m_exponent_array.at(0);
+		for (std::size_t j = 0; j < sampleCount; ++j)
+		{
+			output[j] = (octave[j] + offset) * exponent;
+			weights[j] = output[j];
+		}
+
+		scale *= m_lacunarity;
+
+		for(int i(1) ; i < m_octaves; ++i)
+		{
+			sourceGrid(scale, octave.data());
+
+			exponent = m_exponent_array.at(i);
+			for (std::size_t j = 0; j < sampleCount; ++j)
+			{
+				float weight = std::min(weights[j], 1.f);
+				float signal = (octave[j] + offset) * exponent;
+
+				output[j] += weight * signal;
+				weights[j] = weight * signal;
+			}
+
+			scale *= m_lacunarity;
+		}
+
+		float remainder = m_octaves - static_cast<int>(m_octaves);
+		if (remainder > 0.f)
+		{
+			sourceGrid(scale, octave.data());
+
+			exponent = m_exponent_array.at(static_cast<int>(m_octaves-1));
+			for (std::size_t j = 0; j < sampleCount; ++j)
+				output[j] += remainder * octave[j] * exponent;
+		}
+
+		for (std::size_t j = 0; j < sampleCount; ++j)
+			output[j] = output[j] / m_sum - offset;
+	}
 }
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Noise/MixerBase.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <cmath>
 #include <Nazara/Noise/Debug.hpp>
 
@@ -16,6 +17,30 @@ namespace Nz
 		Recompute();
 	}
 
+	void MixerBase::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		for (unsigned int y = 0; y < size.y; ++y)
+		{
+			float posY = origin.y + y * step.y;
+			for (unsigned int x = 0; x < size.x; ++x)
+				*output++ = Get(origin.x + x * step.x, posY, scale);
+		}
+	}
+
+	void MixerBase::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		for (unsigned int z = 0; z < size.z; ++z)
+		{
+			float posZ = origin.z + z * step.z;
+			for (unsigned int y = 0; y < size.y; ++y)
+			{
+				float posY = origin.y + y * step.y;
+				for (unsigned int x = 0; x < size.x; ++x)
+					*output++ = Get(origin.x + x * step.x, posY, posZ, scale);
+			}
+		}
+	}
+
 	float MixerBase::GetHurstParameter() const
 	{
 		return m_hurst;
@@ -26,6 +51,16 @@ namespace Nz
 		return m_lacunarity;
 	}
 
+	std::size_t MixerBase::GetParametersHash() const
+	{
+		std::size_t hash = 0;
+		HashCombine(hash, m_hurst);
+		HashCombine(hash, m_lacunarity);
+		HashCombine(hash, m_octaves);
+
+		return hash;
+	}
+
 	float MixerBase::GetOctaveNumber() const
 	{
 		return m_octaves;
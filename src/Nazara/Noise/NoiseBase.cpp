@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Noise/NoiseBase.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <numeric>
 #include <Nazara/Noise/Debug.hpp>
 
@@ -17,6 +18,41 @@ namespace Nz
 		std::iota(m_permutations.begin(), m_permutations.begin() + 256, 0);
 	}
 
+	// Samples are written row by row, x varying first
+	void NoiseBase::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		for (unsigned int y = 0; y < size.y; ++y)
+		{
+			float posY = origin.y + y * step.y;
+			for (unsigned int x = 0; x < size.x; ++x)
+				*output++ = Get(origin.x + x * step.x, posY, scale);
+		}
+	}
+
+	void NoiseBase::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		for (unsigned int z = 0; z < size.z; ++z)
+		{
+			float posZ = origin.z + z * step.z;
+			for (unsigned int y = 0; y < size.y; ++y)
+			{
+				float posY = origin.y + y * step.y;
+				for (unsigned int x = 0; x < size.x; ++x)
+					*output++ = Get(origin.x + x * step.x, posY, posZ, scale);
+			}
+		}
+	}
+
+	// Identifies the noise produced, the permutations depend on the seed and on the number of shuffles
+	std::size_t NoiseBase::GetParametersHash() const
+	{
+		std::size_t hash = 0;
+		for (std::size_t i = 0; i < 256; ++i)
+			HashCombine(hash, m_permutations[i]);
+
+		return hash;
+	}
+
 	float NoiseBase::GetScale()
 	{
 		return m_scale;
@@ -0,0 +1,192 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Noise/NoiseTileGenerator.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Noise/MixerBase.hpp>
+#include <Nazara/Noise/NoiseBase.hpp>
+#include <algorithm>
+#include <Nazara/Noise/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		int FloorDivide(int value, int divisor)
+		{
+			return (value >= 0) ? value / divisor : -((-value - 1) / divisor) - 1;
+		}
+	}
+
+	NoiseTileGenerator::NoiseTileGenerator(const NoiseBase& source, unsigned int tileSize, std::size_t cacheSize) :
+	m_cacheSize(cacheSize),
+	m_tileSize(tileSize)
+	{
+		NazaraAssert(tileSize > 0, "Tile size must be over zero");
+
+		m_gridFunction = [&source](const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output)
+		{
+			source.GetGrid(origin, step, size, scale, output);
+		};
+
+		m_parametersHashFunction = [&source]() { return source.GetParametersHash(); };
+	}
+
+	NoiseTileGenerator::NoiseTileGenerator(const MixerBase& source, unsigned int tileSize, std::size_t cacheSize) :
+	m_cacheSize(cacheSize),
+	m_tileSize(tileSize)
+	{
+		NazaraAssert(tileSize > 0, "Tile size must be over zero");
+
+		m_gridFunction = [&source](const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output)
+		{
+			source.GetGrid(origin, step, size, scale, output);
+		};
+
+		m_parametersHashFunction = [&source]() { return source.GetParametersHash(); };
+	}
+
+	void NoiseTileGenerator::ClearCache()
+	{
+		m_tiles.clear();
+		m_tilesByKey.clear();
+	}
+
+	// Sample (i, j) is at (i * step, j * step), samples are written row by row, x varying first
+	void NoiseTileGenerator::Generate(const Vector2i& firstSample, const Vector2ui& sampleCount, float step, float scale, float* output)
+	{
+		if (sampleCount.x == 0 || sampleCount.y == 0)
+			return;
+
+		int tileSize = static_cast<int>(m_tileSize);
+		Vector2i firstTile(FloorDivide(firstSample.x, tileSize), FloorDivide(firstSample.y, tileSize));
+		Vector2i lastTile(FloorDivide(firstSample.x + static_cast<int>(sampleCount.x) - 1, tileSize), FloorDivide(firstSample.y + static_cast<int>(sampleCount.y) - 1, tileSize));
+		Vector2ui tileCount(lastTile.x - firstTile.x + 1, lastTile.y - firstTile.y + 1);
+
+		// Parameters may have changed since the last call (new seed, octaves, ...), their tiles are then left to expire
+		TileKey key;
+		key.parametersHash = m_parametersHashFunction();
+		key.scale = scale;
+		key.step = step;
+
+		std::vector<const float*> tileSamples(tileCount.x * tileCount.y);
+		std::vector<Tile> newTiles;
+		std::vector<std::size_t> newTileIndices;
+		for (unsigned int y = 0; y < tileCount.y; ++y)
+		{
+			for (unsigned int x = 0; x < tileCount.x; ++x)
+			{
+				key.coords.Set(firstTile.x + static_cast<int>(x), firstTile.y + static_cast<int>(y));
+
+				auto it = m_tilesByKey.find(key);
+				if (it != m_tilesByKey.end())
+				{
+					m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+					tileSamples[y * tileCount.x + x] = it->second->samples.data();
+				}
+				else
+				{
+					newTiles.emplace_back();
+					newTiles.back().key = key;
+					newTileIndices.push_back(y * tileCount.x + x);
+				}
+			}
+		}
+
+		TaskScheduler::ParallelFor(0, newTiles.size(), 1, [&](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Tile& tile = newTiles[i];
+				tile.samples.resize(m_tileSize * m_tileSize);
+
+				Vector2f origin(static_cast<float>(tile.key.coords.x * tileSize) * step, static_cast<float>(tile.key.coords.y * tileSize) * step);
+				m_gridFunction(origin, Vector2f(step), Vector2ui(m_tileSize), scale, tile.samples.data());
+			}
+		});
+
+		for (std::size_t i = 0; i < newTiles.size(); ++i)
+			tileSamples[newTileIndices[i]] = newTiles[i].samples.data();
+
+		for (unsigned int y = 0; y < sampleCount.y; ++y)
+		{
+			int sampleY = firstSample.y + static_cast<int>(y);
+			int tileY = FloorDivide(sampleY, tileSize);
+			int rowInTile = sampleY - tileY * tileSize;
+
+			float* row = &output[y * sampleCount.x];
+			unsigned int x = 0;
+			while (x < sampleCount.x)
+			{
+				int sampleX = firstSample.x + static_cast<int>(x);
+				int tileX = FloorDivide(sampleX, tileSize);
+				int columnInTile = sampleX - tileX * tileSize;
+				unsigned int copyCount = std::min<unsigned int>(tileSize - columnInTile, sampleCount.x - x);
+
+				const float* samples = tileSamples[(tileY - firstTile.y) * tileCount.x + (tileX - firstTile.x)];
+				std::copy(samples + rowInTile * tileSize + columnInTile, samples + rowInTile * tileSize + columnInTile + copyCount, row + x);
+
+				x += copyCount;
+			}
+		}
+
+		// Tiles are only cached once copied, a big request would otherwise evict its own tiles
+		for (Tile& tile : newTiles)
+		{
+			m_tiles.emplace_front(std::move(tile));
+			m_tilesByKey[m_tiles.front().key] = m_tiles.begin();
+		}
+
+		Trim();
+	}
+
+	std::size_t NoiseTileGenerator::GetCachedTileCount() const
+	{
+		return m_tiles.size();
+	}
+
+	std::size_t NoiseTileGenerator::GetCacheSize() const
+	{
+		return m_cacheSize;
+	}
+
+	unsigned int NoiseTileGenerator::GetTileSize() const
+	{
+		return m_tileSize;
+	}
+
+	void NoiseTileGenerator::SetCacheSize(std::size_t cacheSize)
+	{
+		m_cacheSize = cacheSize;
+
+		Trim();
+	}
+
+	void NoiseTileGenerator::Trim()
+	{
+		while (m_tiles.size() > m_cacheSize)
+		{
+			m_tilesByKey.erase(m_tiles.back().key);
+			m_tiles.pop_back();
+		}
+	}
+
+	bool NoiseTileGenerator::TileKey::operator==(const TileKey& key) const
+	{
+		return coords == key.coords && parametersHash == key.parametersHash && scale == key.scale && step == key.step;
+	}
+
+	std::size_t NoiseTileGenerator::TileKeyHash::operator()(const TileKey& key) const
+	{
+		std::size_t hash = key.parametersHash;
+		HashCombine(hash, key.coords.x);
+		HashCombine(hash, key.coords.y);
+		HashCombine(hash, key.scale);
+		HashCombine(hash, key.step);
+
+		return hash;
+	}
+}
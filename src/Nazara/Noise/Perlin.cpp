@@ -4,12 +4,127 @@
 
 #include <Nazara/Noise/Perlin.hpp>
 #include <Nazara/Noise/NoiseTools.hpp>
+#include <Nazara/Noise/SimdTools.hpp>
 #include <exception>
 #include <stdexcept>
 #include <Nazara/Noise/Debug.hpp>
 
 namespace Nz
 {
+	#ifdef NAZARA_MATH_SSE2
+	namespace
+	{
+		inline __m128 Fade(__m128 t)
+		{
+			__m128 polynomial = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.f)), _mm_set1_ps(15.f))), _mm_set1_ps(10.f));
+			return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), polynomial);
+		}
+
+		__m128 Perlin2D(__m128 x, __m128 y, float scale, const std::size_t* permutations, const Vector2f* gradients)
+		{
+			__m128 xc = _mm_mul_ps(x, _mm_set1_ps(scale));
+			__m128 yc = _mm_mul_ps(y, _mm_set1_ps(scale));
+
+			__m128i x0 = Detail::SimdFastFloor(xc);
+			__m128i y0 = Detail::SimdFastFloor(yc);
+
+			__m128 tempx[2] = {_mm_sub_ps(xc, _mm_cvtepi32_ps(x0)), _mm_sub_ps(xc, _mm_cvtepi32_ps(_mm_add_epi32(x0, _mm_set1_epi32(1))))};
+			__m128 tempy[2] = {_mm_sub_ps(yc, _mm_cvtepi32_ps(y0)), _mm_sub_ps(yc, _mm_cvtepi32_ps(_mm_add_epi32(y0, _mm_set1_epi32(1))))};
+
+			alignas(16) int cellX[4];
+			alignas(16) int cellY[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellX), x0);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellY), y0);
+
+			// SSE2 has no gather, permutations are looked up lane by lane
+			alignas(16) float gradientX[4][4];
+			alignas(16) float gradientY[4][4];
+			for (unsigned int lane = 0; lane < 4; ++lane)
+			{
+				int ii = cellX[lane] & 255;
+				int jj = cellY[lane] & 255;
+
+				for (unsigned int corner = 0; corner < 4; ++corner)
+				{
+					const Vector2f& gradient = gradients[permutations[ii + (corner & 1) + permutations[jj + (corner >> 1)]] & 7];
+					gradientX[corner][lane] = gradient.x;
+					gradientY[corner][lane] = gradient.y;
+				}
+			}
+
+			__m128 dots[4];
+			for (unsigned int corner = 0; corner < 4; ++corner)
+			{
+				dots[corner] = _mm_add_ps(_mm_mul_ps(_mm_load_ps(gradientX[corner]), tempx[corner & 1]),
+				                          _mm_mul_ps(_mm_load_ps(gradientY[corner]), tempy[corner >> 1]));
+			}
+
+			__m128 Cx = Fade(tempx[0]);
+			__m128 Cy = Fade(tempy[0]);
+
+			return Detail::SimdLerp(Detail::SimdLerp(dots[0], dots[1], Cx), Detail::SimdLerp(dots[2], dots[3], Cx), Cy);
+		}
+
+		__m128 Perlin3D(__m128 x, __m128 y, __m128 z, float scale, const std::size_t* permutations, const Vector3f* gradients)
+		{
+			__m128 xc = _mm_mul_ps(x, _mm_set1_ps(scale));
+			__m128 yc = _mm_mul_ps(y, _mm_set1_ps(scale));
+			__m128 zc = _mm_mul_ps(z, _mm_set1_ps(scale));
+
+			__m128i x0 = Detail::SimdFastFloor(xc);
+			__m128i y0 = Detail::SimdFastFloor(yc);
+			__m128i z0 = Detail::SimdFastFloor(zc);
+
+			__m128 tempx[2] = {_mm_sub_ps(xc, _mm_cvtepi32_ps(x0)), _mm_sub_ps(xc, _mm_cvtepi32_ps(_mm_add_epi32(x0, _mm_set1_epi32(1))))};
+			__m128 tempy[2] = {_mm_sub_ps(yc, _mm_cvtepi32_ps(y0)), _mm_sub_ps(yc, _mm_cvtepi32_ps(_mm_add_epi32(y0, _mm_set1_epi32(1))))};
+			__m128 tempz[2] = {_mm_sub_ps(zc, _mm_cvtepi32_ps(z0)), _mm_sub_ps(zc, _mm_cvtepi32_ps(_mm_add_epi32(z0, _mm_set1_epi32(1))))};
+
+			alignas(16) int cellX[4];
+			alignas(16) int cellY[4];
+			alignas(16) int cellZ[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellX), x0);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellY), y0);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellZ), z0);
+
+			alignas(16) float gradientX[8][4];
+			alignas(16) float gradientY[8][4];
+			alignas(16) float gradientZ[8][4];
+			for (unsigned int lane = 0; lane < 4; ++lane)
+			{
+				int ii = cellX[lane] & 255;
+				int jj = cellY[lane] & 255;
+				int kk = cellZ[lane] & 255;
+
+				for (unsigned int corner = 0; corner < 8; ++corner)
+				{
+					const Vector3f& gradient = gradients[permutations[ii + (corner & 1) + permutations[jj + ((corner >> 1) & 1) + permutations[kk + (corner >> 2)]]] & 15];
+					gradientX[corner][lane] = gradient.x;
+					gradientY[corner][lane] = gradient.y;
+					gradientZ[corner][lane] = gradient.z;
+				}
+			}
+
+			__m128 dots[8];
+			for (unsigned int corner = 0; corner < 8; ++corner)
+			{
+				__m128 dot = _mm_add_ps(_mm_mul_ps(_mm_load_ps(gradientX[corner]), tempx[corner & 1]),
+				                        _mm_mul_ps(_mm_load_ps(gradientY[corner]), tempy[(corner >> 1) & 1]));
+
+				dots[corner] = _mm_add_ps(dot, _mm_mul_ps(_mm_load_ps(gradientZ[corner]), tempz[corner >> 2]));
+			}
+
+			__m128 Cx = Fade(tempx[0]);
+			__m128 Cy = Fade(tempy[0]);
+			__m128 Cz = Fade(tempz[0]);
+
+			__m128 Li5 = Detail::SimdLerp(Detail::SimdLerp(dots[0], dots[1], Cx), Detail::SimdLerp(dots[2], dots[3], Cx), Cy);
+			__m128 Li6 = Detail::SimdLerp(Detail::SimdLerp(dots[4], dots[5], Cx), Detail::SimdLerp(dots[6], dots[7], Cx), Cy);
+
+			return Detail::SimdLerp(Li5, Li6, Cz);
+		}
+	}
+	#endif
+
 	Perlin::Perlin(unsigned int seed) :
 	Perlin()
 	{
@@ -273,4 +388,52 @@ namespace Nz
 
 		return Li13 + Cw*(Li14-Li13);
 	}
+
+	void Perlin::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		for (unsigned int y = 0; y < size.y; ++y)
+		{
+			float posY = origin.y + y * step.y;
+			unsigned int x = 0;
+
+			#ifdef NAZARA_MATH_SSE2
+			for (; x + 4 <= size.x; x += 4)
+			{
+				__m128 values = Perlin2D(Detail::SimdGridPositions(origin.x, step.x, x), _mm_set1_ps(posY), scale, m_permutations.data(), s_gradients2.data());
+				_mm_storeu_ps(&output[x], values);
+			}
+			#endif
+
+			for (; x < size.x; ++x)
+				output[x] = Perlin::Get(origin.x + x * step.x, posY, scale);
+
+			output += size.x;
+		}
+	}
+
+	void Perlin::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		for (unsigned int z = 0; z < size.z; ++z)
+		{
+			float posZ = origin.z + z * step.z;
+			for (unsigned int y = 0; y < size.y; ++y)
+			{
+				float posY = origin.y + y * step.y;
+				unsigned int x = 0;
+
+				#ifdef NAZARA_MATH_SSE2
+				for (; x + 4 <= size.x; x += 4)
+				{
+					__m128 values = Perlin3D(Detail::SimdGridPositions(origin.x, step.x, x), _mm_set1_ps(posY), _mm_set1_ps(posZ), scale, m_permutations.data(), s_gradients3.data());
+					_mm_storeu_ps(&output[x], values);
+				}
+				#endif
+
+				for (; x < size.x; ++x)
+					output[x] = Perlin::Get(origin.x + x * step.x, posY, posZ, scale);
+
+				output += size.x;
+			}
+		}
+	}
 }
@@ -0,0 +1,38 @@
+// Copyright (C) 2016 Rémi Bèges
+// This file is part of the "Nazara Engine - Noise module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#ifndef NAZARA_NOISE_SIMDTOOLS_HPP
+#define NAZARA_NOISE_SIMDTOOLS_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Simd.hpp>
+
+#ifdef NAZARA_MATH_SSE2
+namespace Nz
+{
+	namespace Detail
+	{
+		// Same rounding as fastfloor (which also moves negative integers one unit down), so grids match Get
+		inline __m128i SimdFastFloor(__m128 n)
+		{
+			__m128 negativeOffset = _mm_and_ps(_mm_cmplt_ps(n, _mm_setzero_ps()), _mm_set1_ps(1.f));
+			return _mm_cvttps_epi32(_mm_sub_ps(n, negativeOffset));
+		}
+
+		// Positions of the four grid samples starting at index first along an axis
+		inline __m128 SimdGridPositions(float origin, float step, unsigned int first)
+		{
+			__m128 indices = _mm_add_ps(_mm_set1_ps(static_cast<float>(first)), _mm_set_ps(3.f, 2.f, 1.f, 0.f));
+			return _mm_add_ps(_mm_set1_ps(origin), _mm_mul_ps(indices, _mm_set1_ps(step)));
+		}
+
+		inline __m128 SimdLerp(__m128 from, __m128 to, __m128 interpolation)
+		{
+			return _mm_add_ps(from, _mm_mul_ps(interpolation, _mm_sub_ps(to, from)));
+		}
+	}
+}
+#endif
+
+#endif // NAZARA_NOISE_SIMDTOOLS_HPP
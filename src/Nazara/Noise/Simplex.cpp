@@ -4,6 +4,7 @@
 
 #include <Nazara/Noise/Simplex.hpp>
 #include <Nazara/Noise/NoiseTools.hpp>
+#include <Nazara/Noise/SimdTools.hpp>
 #include <exception>
 #include <stdexcept>
 #include <Nazara/Noise/Debug.hpp>
@@ -18,6 +19,184 @@ namespace Nz
 		constexpr float s_UnskewCoeff3D = 1.f / 6.f;
 		constexpr float s_SkewCoeff4D   = (float(M_SQRT5) - 1.f)/4.f;
 		constexpr float s_UnskewCoeff4D = (5.f - float(M_SQRT5))/20.f;
+
+		#ifdef NAZARA_MATH_SSE2
+		// Contribution of a corner, zero when it is too far from the sample
+		inline __m128 CornerContribution(__m128 c, __m128 dot)
+		{
+			__m128 c2 = _mm_mul_ps(c, c);
+			return _mm_andnot_ps(_mm_cmple_ps(c, _mm_setzero_ps()), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(c2, c), c), dot));
+		}
+
+		__m128 Simplex2D(__m128 x, __m128 y, float scale, const std::size_t* permutations, const Vector2f* gradients)
+		{
+			__m128 one = _mm_set1_ps(1.f);
+			__m128 xc = _mm_mul_ps(x, _mm_set1_ps(scale));
+			__m128 yc = _mm_mul_ps(y, _mm_set1_ps(scale));
+
+			__m128 sum = _mm_mul_ps(_mm_add_ps(xc, yc), _mm_set1_ps(s_SkewCoeff2D));
+			__m128i skewedCubeOriginX = Detail::SimdFastFloor(_mm_add_ps(xc, sum));
+			__m128i skewedCubeOriginY = Detail::SimdFastFloor(_mm_add_ps(yc, sum));
+
+			sum = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(skewedCubeOriginX, skewedCubeOriginY)), _mm_set1_ps(s_UnskewCoeff2D));
+			__m128 distX = _mm_sub_ps(xc, _mm_sub_ps(_mm_cvtepi32_ps(skewedCubeOriginX), sum));
+			__m128 distY = _mm_sub_ps(yc, _mm_sub_ps(_mm_cvtepi32_ps(skewedCubeOriginY), sum));
+
+			__m128 off1Mask = _mm_cmpgt_ps(distX, distY);
+
+			__m128 dx[3];
+			__m128 dy[3];
+			dx[0] = _mm_xor_ps(distX, _mm_set1_ps(-0.f));
+			dy[0] = _mm_xor_ps(distY, _mm_set1_ps(-0.f));
+			dx[1] = _mm_sub_ps(_mm_add_ps(dx[0], _mm_and_ps(off1Mask, one)), _mm_set1_ps(s_UnskewCoeff2D));
+			dy[1] = _mm_sub_ps(_mm_add_ps(dy[0], _mm_andnot_ps(off1Mask, one)), _mm_set1_ps(s_UnskewCoeff2D));
+			dx[2] = _mm_add_ps(dx[0], _mm_set1_ps(1.f - 2.f * s_UnskewCoeff2D));
+			dy[2] = _mm_add_ps(dy[0], _mm_set1_ps(1.f - 2.f * s_UnskewCoeff2D));
+
+			alignas(16) int cellX[4];
+			alignas(16) int cellY[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellX), skewedCubeOriginX);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellY), skewedCubeOriginY);
+			int off1Bits = _mm_movemask_ps(off1Mask);
+
+			// SSE2 has no gather, permutations are looked up lane by lane
+			alignas(16) float gradientX[3][4];
+			alignas(16) float gradientY[3][4];
+			for (unsigned int lane = 0; lane < 4; ++lane)
+			{
+				int ii = cellX[lane] & 255;
+				int jj = cellY[lane] & 255;
+				int off1x = (off1Bits >> lane) & 1;
+				int off1y = 1 - off1x;
+
+				std::size_t gi[3] =
+				{
+					permutations[ii + permutations[jj]] & 7,
+					permutations[ii + off1x + permutations[jj + off1y]] & 7,
+					permutations[ii + 1 + permutations[jj + 1]] & 7
+				};
+
+				for (unsigned int corner = 0; corner < 3; ++corner)
+				{
+					gradientX[corner][lane] = gradients[gi[corner]].x;
+					gradientY[corner][lane] = gradients[gi[corner]].y;
+				}
+			}
+
+			__m128 n = _mm_setzero_ps();
+			for (unsigned int corner = 0; corner < 3; ++corner)
+			{
+				__m128 c = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.5f), _mm_mul_ps(dx[corner], dx[corner])), _mm_mul_ps(dy[corner], dy[corner]));
+				__m128 dot = _mm_add_ps(_mm_mul_ps(_mm_load_ps(gradientX[corner]), dx[corner]), _mm_mul_ps(_mm_load_ps(gradientY[corner]), dy[corner]));
+
+				n = _mm_add_ps(n, CornerContribution(c, dot));
+			}
+
+			return _mm_mul_ps(n, _mm_set1_ps(70.f));
+		}
+
+		__m128 Simplex3D(__m128 x, __m128 y, __m128 z, float scale, const std::size_t* permutations, const Vector3f* gradients)
+		{
+			__m128 one = _mm_set1_ps(1.f);
+			__m128 xc = _mm_mul_ps(x, _mm_set1_ps(scale));
+			__m128 yc = _mm_mul_ps(y, _mm_set1_ps(scale));
+			__m128 zc = _mm_mul_ps(z, _mm_set1_ps(scale));
+
+			__m128 sum = _mm_mul_ps(_mm_add_ps(_mm_add_ps(xc, yc), zc), _mm_set1_ps(s_SkewCoeff3D));
+			__m128i skewedCubeOriginX = Detail::SimdFastFloor(_mm_add_ps(xc, sum));
+			__m128i skewedCubeOriginY = Detail::SimdFastFloor(_mm_add_ps(yc, sum));
+			__m128i skewedCubeOriginZ = Detail::SimdFastFloor(_mm_add_ps(zc, sum));
+
+			sum = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(skewedCubeOriginX, skewedCubeOriginY), skewedCubeOriginZ)), _mm_set1_ps(s_UnskewCoeff3D));
+
+			__m128 dx[4];
+			__m128 dy[4];
+			__m128 dz[4];
+			dx[0] = _mm_sub_ps(xc, _mm_sub_ps(_mm_cvtepi32_ps(skewedCubeOriginX), sum));
+			dy[0] = _mm_sub_ps(yc, _mm_sub_ps(_mm_cvtepi32_ps(skewedCubeOriginY), sum));
+			dz[0] = _mm_sub_ps(zc, _mm_sub_ps(_mm_cvtepi32_ps(skewedCubeOriginZ), sum));
+
+			// Branchless version of the simplex selection of Get, ties are resolved the same way
+			__m128 xy = _mm_cmpge_ps(dx[0], dy[0]);
+			__m128 yz = _mm_cmpge_ps(dy[0], dz[0]);
+			__m128 xz = _mm_cmpge_ps(dx[0], dz[0]);
+			__m128 allBits = _mm_cmpeq_ps(one, one);
+
+			__m128 off1x = _mm_and_ps(xy, _mm_or_ps(yz, xz));
+			__m128 off1y = _mm_andnot_ps(xy, yz);
+			__m128 off1z = _mm_xor_ps(_mm_or_ps(off1x, off1y), allBits);
+			__m128 off2x = _mm_or_ps(xy, _mm_and_ps(yz, xz));
+			__m128 off2y = _mm_or_ps(_mm_xor_ps(xy, allBits), yz);
+			__m128 off2z = _mm_xor_ps(_mm_and_ps(yz, xz), allBits);
+
+			dx[1] = _mm_add_ps(_mm_sub_ps(dx[0], _mm_and_ps(off1x, one)), _mm_set1_ps(s_UnskewCoeff3D));
+			dy[1] = _mm_add_ps(_mm_sub_ps(dy[0], _mm_and_ps(off1y, one)), _mm_set1_ps(s_UnskewCoeff3D));
+			dz[1] = _mm_add_ps(_mm_sub_ps(dz[0], _mm_and_ps(off1z, one)), _mm_set1_ps(s_UnskewCoeff3D));
+
+			dx[2] = _mm_add_ps(_mm_sub_ps(dx[0], _mm_and_ps(off2x, one)), _mm_set1_ps(2.f * s_UnskewCoeff3D));
+			dy[2] = _mm_add_ps(_mm_sub_ps(dy[0], _mm_and_ps(off2y, one)), _mm_set1_ps(2.f * s_UnskewCoeff3D));
+			dz[2] = _mm_add_ps(_mm_sub_ps(dz[0], _mm_and_ps(off2z, one)), _mm_set1_ps(2.f * s_UnskewCoeff3D));
+
+			dx[3] = _mm_add_ps(_mm_sub_ps(dx[0], one), _mm_set1_ps(3.f * s_UnskewCoeff3D));
+			dy[3] = _mm_add_ps(_mm_sub_ps(dy[0], one), _mm_set1_ps(3.f * s_UnskewCoeff3D));
+			dz[3] = _mm_add_ps(_mm_sub_ps(dz[0], one), _mm_set1_ps(3.f * s_UnskewCoeff3D));
+
+			alignas(16) int cellX[4];
+			alignas(16) int cellY[4];
+			alignas(16) int cellZ[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellX), skewedCubeOriginX);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellY), skewedCubeOriginY);
+			_mm_store_si128(reinterpret_cast<__m128i*>(cellZ), skewedCubeOriginZ);
+
+			int off1Bits[3] = {_mm_movemask_ps(off1x), _mm_movemask_ps(off1y), _mm_movemask_ps(off1z)};
+			int off2Bits[3] = {_mm_movemask_ps(off2x), _mm_movemask_ps(off2y), _mm_movemask_ps(off2z)};
+
+			alignas(16) float gradientX[4][4];
+			alignas(16) float gradientY[4][4];
+			alignas(16) float gradientZ[4][4];
+			for (unsigned int lane = 0; lane < 4; ++lane)
+			{
+				int ii = cellX[lane] & 255;
+				int jj = cellY[lane] & 255;
+				int kk = cellZ[lane] & 255;
+
+				int off1[3];
+				int off2[3];
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					off1[i] = (off1Bits[i] >> lane) & 1;
+					off2[i] = (off2Bits[i] >> lane) & 1;
+				}
+
+				std::size_t gi[4] =
+				{
+					permutations[ii +           permutations[jj +           permutations[kk          ]]] % 12,
+					permutations[ii + off1[0] + permutations[jj + off1[1] + permutations[kk + off1[2]]]] % 12,
+					permutations[ii + off2[0] + permutations[jj + off2[1] + permutations[kk + off2[2]]]] % 12,
+					permutations[ii + 1 +       permutations[jj + 1 +       permutations[kk + 1      ]]] % 12
+				};
+
+				for (unsigned int corner = 0; corner < 4; ++corner)
+				{
+					gradientX[corner][lane] = gradients[gi[corner]].x;
+					gradientY[corner][lane] = gradients[gi[corner]].y;
+					gradientZ[corner][lane] = gradients[gi[corner]].z;
+				}
+			}
+
+			__m128 n = _mm_setzero_ps();
+			for (unsigned int corner = 0; corner < 4; ++corner)
+			{
+				__m128 c = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.6f), _mm_mul_ps(dx[corner], dx[corner])), _mm_mul_ps(dy[corner], dy[corner])), _mm_mul_ps(dz[corner], dz[corner]));
+				__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(gradientX[corner]), dx[corner]), _mm_mul_ps(_mm_load_ps(gradientY[corner]), dy[corner])),
+				                        _mm_mul_ps(_mm_load_ps(gradientZ[corner]), dz[corner]));
+
+				n = _mm_add_ps(n, CornerContribution(c, dot));
+			}
+
+			return _mm_mul_ps(n, _mm_set1_ps(32.f));
+		}
+		#endif
 	}
 
 	Simplex::Simplex(unsigned int seed)
@@ -372,4 +551,52 @@ namespace Nz
 
 		return (n1+n2+n3+n4+n5)*27.f;
 	}
+
+	void Simplex::GetGrid(const Vector2f& origin, const Vector2f& step, const Vector2ui& size, float scale, float* output) const
+	{
+		for (unsigned int y = 0; y < size.y; ++y)
+		{
+			float posY = origin.y + y * step.y;
+			unsigned int x = 0;
+
+			#ifdef NAZARA_MATH_SSE2
+			for (; x + 4 <= size.x; x += 4)
+			{
+				__m128 values = Simplex2D(Detail::SimdGridPositions(origin.x, step.x, x), _mm_set1_ps(posY), scale, m_permutations.data(), s_gradients2.data());
+				_mm_storeu_ps(&output[x], values);
+			}
+			#endif
+
+			for (; x < size.x; ++x)
+				output[x] = Simplex::Get(origin.x + x * step.x, posY, scale);
+
+			output += size.x;
+		}
+	}
+
+	void Simplex::GetGrid(const Vector3f& origin, const Vector3f& step, const Vector3ui& size, float scale, float* output) const
+	{
+		for (unsigned int z = 0; z < size.z; ++z)
+		{
+			float posZ = origin.z + z * step.z;
+			for (unsigned int y = 0; y < size.y; ++y)
+			{
+				float posY = origin.y + y * step.y;
+				unsigned int x = 0;
+
+				#ifdef NAZARA_MATH_SSE2
+				for (; x + 4 <= size.x; x += 4)
+				{
+					__m128 values = Simplex3D(Detail::SimdGridPositions(origin.x, step.x, x), _mm_set1_ps(posY), _mm_set1_ps(posZ), scale, m_permutations.data(), s_gradients3.data());
+					_mm_storeu_ps(&output[x], values);
+				}
+				#endif
+
+				for (; x < size.x; ++x)
+					output[x] = Simplex::Get(origin.x + x * step.x, posY, posZ, scale);
+
+				output += size.x;
+			}
+		}
+	}
 }
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Noise/Worley.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Noise/NoiseTools.hpp>
 #include <exception>
 #include <stdexcept>
@@ -119,6 +120,14 @@ namespace Nz
 		throw std::runtime_error("Worley 4D not available yet.");
 	}
 
+	std::size_t Worley::GetParametersHash() const
+	{
+		std::size_t hash = NoiseBase::GetParametersHash();
+		HashCombine(hash, static_cast<int>(m_function));
+
+		return hash;
+	}
+
 	void Worley::Set(WorleyFunction func)
 	{
 		m_function = func;
@@ -3,8 +3,13 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Physics/Geom.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
 #include <Nazara/Physics/PhysWorld.hpp>
 #include <Newton/Newton.h>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <Nazara/Physics/Debug.hpp>
 
@@ -33,12 +38,99 @@ namespace Nz
 			NazaraError("Primitive type not handled (0x" + String::Number(primitive.type, 16) + ')');
 			return PhysGeomRef();
 		}
+
+		constexpr UInt32 CacheFileMagic = 0x4C4F434E; // "NCOL"
+
+		struct DeserializationData
+		{
+			const UInt8* data;
+			std::size_t remainingSize;
+		};
+
+		template<typename T>
+		void AppendToHash(AbstractHash* hash, const T* data, std::size_t count)
+		{
+			hash->Append(reinterpret_cast<const UInt8*>(data), count * sizeof(T));
+		}
+
+		std::unique_ptr<AbstractHash> BeginContentHash(GeomType type)
+		{
+			std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_SHA1);
+			hash->Begin();
+
+			// A serialized collision can only be loaded by the Newton version which produced it
+			Int32 header[2] = {type, NewtonWorldGetVersion()};
+			AppendToHash(hash.get(), header, 2);
+
+			return hash;
+		}
+
+		void DeserializeFromBuffer(void* const serializeHandle, void* const buffer, int size)
+		{
+			DeserializationData* data = static_cast<DeserializationData*>(serializeHandle);
+
+			// Newton has no way to report an error, a truncated buffer is filled with zeros
+			std::size_t readSize = std::min<std::size_t>(size, data->remainingSize);
+			std::memcpy(buffer, data->data, readSize);
+			std::memset(static_cast<UInt8*>(buffer) + readSize, 0, size - readSize);
+
+			data->data += readSize;
+			data->remainingSize -= readSize;
+		}
+
+		void SerializeToBuffer(void* const serializeHandle, const void* const buffer, int size)
+		{
+			static_cast<ByteArray*>(serializeHandle)->Append(buffer, size);
+		}
+
+		String GetCacheFilePath(const ByteArray& contentHash)
+		{
+			return File::NormalizePath(PhysGeom::GetCacheDirectory() + NAZARA_DIRECTORY_SEPARATOR + contentHash.ToHex() + ".ncol");
+		}
+
+		bool LoadCacheFile(const ByteArray& contentHash, ByteArray* serializedHandle)
+		{
+			File file(GetCacheFilePath(contentHash));
+			if (!file.Exists() || !file.Open(OpenMode_ReadOnly))
+				return false;
+
+			UInt32 header[2];
+			if (file.Read(header, sizeof(header)) != sizeof(header) || header[0] != CacheFileMagic || header[1] != file.GetSize() - sizeof(header))
+			{
+				NazaraWarning("Collision cache file " + file.GetPath() + " is corrupted, ignoring it");
+				return false;
+			}
+
+			serializedHandle->Resize(header[1]);
+			return file.Read(serializedHandle->GetBuffer(), header[1]) == header[1];
+		}
+
+		void SaveCacheFile(const ByteArray& contentHash, const ByteArray& serializedHandle)
+		{
+			File file(GetCacheFilePath(contentHash));
+			if (!file.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+			{
+				NazaraWarning("Failed to write collision cache file " + file.GetPath());
+				return;
+			}
+
+			UInt32 header[2] = {CacheFileMagic, static_cast<UInt32>(serializedHandle.GetSize())};
+			file.Write(header, sizeof(header));
+			file.Write(serializedHandle.GetConstBuffer(), serializedHandle.GetSize());
+		}
 	}
 
 	PhysGeom::~PhysGeom()
 	{
 		for (auto& pair : m_handles)
 			NewtonDestroyCollision(pair.second);
+
+		if (!m_contentHash.IsEmpty())
+		{
+			auto it = s_sharedGeoms.find(m_contentHash.ToHex());
+			if (it != s_sharedGeoms.end() && it->second == this)
+				s_sharedGeoms.erase(it);
+		}
 	}
 
 	Boxf PhysGeom::ComputeAABB(const Vector3f& translation, const Quaternionf& rotation, const Vector3f& scale) const
@@ -148,6 +240,60 @@ namespace Nz
 			return CreateGeomFromPrimitive(list.GetPrimitive(0));
 	}
 
+	const String& PhysGeom::GetCacheDirectory()
+	{
+		return s_cacheDirectory;
+	}
+
+	void PhysGeom::SetCacheDirectory(const String& directory)
+	{
+		s_cacheDirectory = directory;
+	}
+
+	NewtonCollision* PhysGeom::CreateCachedHandle(PhysWorld* world, const std::function<NewtonCollision*(NewtonWorld* world)>& builder) const
+	{
+		NazaraAssert(!m_contentHash.IsEmpty(), "Geom has no content hash");
+
+		NewtonWorld* newtonWorld = world->GetHandle();
+
+		if (m_serializedHandle.IsEmpty() && !s_cacheDirectory.IsEmpty())
+			LoadCacheFile(m_contentHash, &m_serializedHandle);
+
+		if (!m_serializedHandle.IsEmpty())
+		{
+			DeserializationData data;
+			data.data = m_serializedHandle.GetConstBuffer();
+			data.remainingSize = m_serializedHandle.GetSize();
+
+			NewtonCollision* collision = NewtonCreateCollisionFromSerialization(newtonWorld, &DeserializeFromBuffer, &data);
+			if (collision)
+				return collision;
+
+			NazaraWarning("Failed to load serialized collision, building it");
+			m_serializedHandle.Clear();
+		}
+
+		NewtonCollision* collision = builder(newtonWorld);
+
+		// Loading the serialized collision is much faster than building it again, for the other worlds as for the next runs
+		NewtonCollisionSerialize(newtonWorld, collision, &SerializeToBuffer, &m_serializedHandle);
+		if (!s_cacheDirectory.IsEmpty())
+			SaveCacheFile(m_contentHash, m_serializedHandle);
+
+		return collision;
+	}
+
+	PhysGeom* PhysGeom::GetSharedGeom() const
+	{
+		auto it = s_sharedGeoms.find(m_contentHash.ToHex());
+		return (it != s_sharedGeoms.end()) ? it->second : nullptr;
+	}
+
+	void PhysGeom::RegisterSharedGeom()
+	{
+		s_sharedGeoms[m_contentHash.ToHex()] = this;
+	}
+
 	bool PhysGeom::Initialize()
 	{
 		if (!PhysGeomLibrary::Initialize())
@@ -165,6 +311,8 @@ namespace Nz
 	}
 
 	PhysGeomLibrary::LibraryMap PhysGeom::s_library;
+	std::unordered_map<String, PhysGeom*> PhysGeom::s_sharedGeoms;
+	String PhysGeom::s_cacheDirectory;
 
 	/********************************** BoxGeom **********************************/
 
@@ -335,6 +483,12 @@ namespace Nz
 		}
 		else // Fast path
 			std::memcpy(m_vertices.data(), vertices, vertexCount*sizeof(Vector3f));
+
+		std::unique_ptr<AbstractHash> hash = BeginContentHash(GeomType_ConvexHull);
+		AppendToHash(hash.get(), &m_tolerance, 1);
+		AppendToHash(hash.get(), static_cast<const float*>(m_matrix), 16);
+		AppendToHash(hash.get(), m_vertices.data(), m_vertices.size());
+		m_contentHash = hash->End();
 	}
 
 	ConvexHullGeom::ConvexHullGeom(const void* vertices, unsigned int vertexCount, unsigned int stride, float tolerance, const Vector3f& translation, const Quaternionf& rotation) :
@@ -344,12 +498,15 @@ namespace Nz
 
 	GeomType ConvexHullGeom::GetType() const
 	{
-		return GeomType_Compound;
+		return GeomType_ConvexHull;
 	}
 
 	NewtonCollision* ConvexHullGeom::CreateHandle(PhysWorld* world) const
 	{
-		return NewtonCreateConvexHull(world->GetHandle(), m_vertices.size(), reinterpret_cast<const float*>(m_vertices.data()), sizeof(Vector3f), m_tolerance, 0, m_matrix);
+		return CreateCachedHandle(world, [this] (NewtonWorld* newtonWorld)
+		{
+			return NewtonCreateConvexHull(newtonWorld, m_vertices.size(), reinterpret_cast<const float*>(m_vertices.data()), sizeof(Vector3f), m_tolerance, 0, m_matrix);
+		});
 	}
 
 	/******************************* CylinderGeom ********************************/
@@ -452,4 +609,74 @@ namespace Nz
 	{
 		return NewtonCreateSphere(world->GetHandle(), m_radius, 0, Matrix4f::Translate(m_position));
 	}
+
+	/********************************* TreeGeom **********************************/
+
+	TreeGeom::TreeGeom(const void* vertices, unsigned int vertexCount, const UInt32* indices, unsigned int indexCount, unsigned int stride, bool optimize) :
+	m_indices(indices, indices + indexCount),
+	m_optimize(optimize)
+	{
+		NazaraAssert(indexCount % 3 == 0, "Index count must be a multiple of three");
+
+		const UInt8* ptr = static_cast<const UInt8*>(vertices);
+
+		m_vertices.resize(vertexCount);
+		if (stride != sizeof(Vector3f))
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+				m_vertices[i] = *reinterpret_cast<const Vector3f*>(ptr + stride*i);
+		}
+		else // Fast path
+			std::memcpy(m_vertices.data(), vertices, vertexCount*sizeof(Vector3f));
+
+		std::unique_ptr<AbstractHash> hash = BeginContentHash(GeomType_Tree);
+		AppendToHash(hash.get(), &m_optimize, 1);
+		AppendToHash(hash.get(), m_indices.data(), m_indices.size());
+		AppendToHash(hash.get(), m_vertices.data(), m_vertices.size());
+		m_contentHash = hash->End();
+	}
+
+	void TreeGeom::ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const
+	{
+		// Tree collisions are only meant for static bodies
+		if (inertia)
+			inertia->MakeZero();
+
+		if (center)
+			center->MakeZero();
+	}
+
+	float TreeGeom::ComputeVolume() const
+	{
+		return 0.f;
+	}
+
+	GeomType TreeGeom::GetType() const
+	{
+		return GeomType_Tree;
+	}
+
+	NewtonCollision* TreeGeom::CreateHandle(PhysWorld* world) const
+	{
+		return CreateCachedHandle(world, [this] (NewtonWorld* newtonWorld)
+		{
+			NewtonCollision* collision = NewtonCreateTreeCollision(newtonWorld, 0);
+
+			NewtonTreeCollisionBeginBuild(collision);
+			for (std::size_t i = 0; i < m_indices.size(); i += 3)
+			{
+				Vector3f triangle[3];
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					NazaraAssert(m_indices[i + j] < m_vertices.size(), "Vertex index out of range");
+					triangle[j] = m_vertices[m_indices[i + j]];
+				}
+
+				NewtonTreeCollisionAddFace(collision, 3, reinterpret_cast<const float*>(triangle), sizeof(Vector3f), 0);
+			}
+			NewtonTreeCollisionEndBuild(collision, (m_optimize) ? 1 : 0);
+
+			return collision;
+		});
+	}
 }
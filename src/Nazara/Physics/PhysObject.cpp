@@ -19,10 +19,14 @@ namespace Nz
 
 	PhysObject::PhysObject(PhysWorld* world, PhysGeomRef geom, const Matrix4f& mat) :
 	m_matrix(mat),
+	m_previousMatrix(mat),
 	m_geom(std::move(geom)),
 	m_forceAccumulator(Vector3f::Zero()),
 	m_torqueAccumulator(Vector3f::Zero()),
 	m_world(world),
+	m_transformStep(0),
+	m_userdata(nullptr),
+	m_queryMask(0xFFFFFFFF),
 	m_gravityFactor(1.f),
 	m_mass(0.f)
 	{
@@ -37,10 +41,14 @@ namespace Nz
 
 	PhysObject::PhysObject(const PhysObject& object) :
 	m_matrix(object.m_matrix),
+	m_previousMatrix(object.m_matrix),
 	m_geom(object.m_geom),
 	m_forceAccumulator(Vector3f::Zero()),
 	m_torqueAccumulator(Vector3f::Zero()),
 	m_world(object.m_world),
+	m_transformStep(0),
+	m_userdata(object.m_userdata),
+	m_queryMask(object.m_queryMask),
 	m_gravityFactor(object.m_gravityFactor),
 	m_mass(0.f)
 	{
@@ -50,29 +58,42 @@ namespace Nz
 		m_body = NewtonCreateDynamicBody(m_world->GetHandle(), m_geom->GetHandle(m_world), m_matrix);
 		NewtonBodySetUserData(m_body, this);
 		SetMass(object.m_mass);
+		SetMaterial(object.GetMaterial());
 	}
 
 	PhysObject::PhysObject(PhysObject&& object) :
 	m_matrix(std::move(object.m_matrix)),
+	m_previousMatrix(std::move(object.m_previousMatrix)),
 	m_geom(std::move(object.m_geom)),
 	m_forceAccumulator(std::move(object.m_forceAccumulator)),
 	m_torqueAccumulator(std::move(object.m_torqueAccumulator)),
 	m_body(object.m_body),
 	m_world(object.m_world),
+	m_transformStep(object.m_transformStep),
+	m_userdata(object.m_userdata),
+	m_queryMask(object.m_queryMask),
 	m_gravityFactor(object.m_gravityFactor),
 	m_mass(object.m_mass)
 	{
+		if (m_body)
+			NewtonBodySetUserData(m_body, this); //< Callbacks and contact events find the object through the body
+
 		object.m_body = nullptr;
 	}
 
 	PhysObject::~PhysObject()
 	{
 		if (m_body)
+		{
+			m_world->UnregisterBody(m_body);
 			NewtonDestroyBody(m_body);
+		}
 	}
 
 	void PhysObject::AddForce(const Vector3f& force, CoordSys coordSys)
 	{
+		m_world->WaitForStep(); //< Accumulators are consumed by the force callback
+
 		switch (coordSys)
 		{
 			case CoordSys_Global:
@@ -90,6 +111,8 @@ namespace Nz
 
 	void PhysObject::AddForce(const Vector3f& force, const Vector3f& point, CoordSys coordSys)
 	{
+		m_world->WaitForStep(); //< Accumulators are consumed by the force callback
+
 		switch (coordSys)
 		{
 			case CoordSys_Global:
@@ -107,6 +130,8 @@ namespace Nz
 
 	void PhysObject::AddTorque(const Vector3f& torque, CoordSys coordSys)
 	{
+		m_world->WaitForStep(); //< Accumulators are consumed by the force callback
+
 		switch (coordSys)
 		{
 			case CoordSys_Global:
@@ -158,6 +183,23 @@ namespace Nz
 		return m_body;
 	}
 
+	Vector3f PhysObject::GetInterpolatedPosition(float interpolation) const
+	{
+		// The previous pose is only relevant if the object moved during the last step
+		if (!IsMoving())
+			return m_matrix.GetTranslation();
+
+		return Vector3f::Lerp(m_previousMatrix.GetTranslation(), m_matrix.GetTranslation(), interpolation);
+	}
+
+	Quaternionf PhysObject::GetInterpolatedRotation(float interpolation) const
+	{
+		if (!IsMoving())
+			return m_matrix.GetRotation();
+
+		return Quaternionf::Slerp(m_previousMatrix.GetRotation(), m_matrix.GetRotation(), interpolation);
+	}
+
 	float PhysObject::GetMass() const
 	{
 		return m_mass;
@@ -181,6 +223,11 @@ namespace Nz
 		return center;
 	}
 
+	int PhysObject::GetMaterial() const
+	{
+		return NewtonBodyGetMaterialGroupID(m_body);
+	}
+
 	const Matrix4f& PhysObject::GetMatrix() const
 	{
 		return m_matrix;
@@ -191,11 +238,21 @@ namespace Nz
 		return m_matrix.GetTranslation();
 	}
 
+	UInt32 PhysObject::GetQueryMask() const
+	{
+		return m_queryMask;
+	}
+
 	Quaternionf PhysObject::GetRotation() const
 	{
 		return m_matrix.GetRotation();
 	}
 
+	void* PhysObject::GetUserdata() const
+	{
+		return m_userdata;
+	}
+
 	Vector3f PhysObject::GetVelocity() const
 	{
 		Vector3f velocity;
@@ -214,6 +271,12 @@ namespace Nz
 		return m_mass > 0.f;
 	}
 
+	bool PhysObject::IsMoving() const
+	{
+		// Sleeping objects are not transformed by the steps
+		return m_transformStep != 0 && m_transformStep == m_world->GetStepCount();
+	}
+
 	bool PhysObject::IsSleeping() const
 	{
 		return NewtonBodyGetSleepState(m_body) != 0;
@@ -271,18 +334,37 @@ namespace Nz
 			NewtonBodySetCentreOfMass(m_body, center);
 	}
 
+	void PhysObject::SetMaterial(int material)
+	{
+		// Material pairs decide how objects collide and whether their contacts are reported, see PhysWorld
+		m_world->WaitForStep();
+
+		NewtonBodySetMaterialGroupID(m_body, material);
+	}
+
 	void PhysObject::SetPosition(const Vector3f& position)
 	{
 		m_matrix.SetTranslation(position);
 		UpdateBody();
 	}
 
+	void PhysObject::SetQueryMask(UInt32 queryMask)
+	{
+		// Only filters PhysWorld queries, collisions between objects are not affected
+		m_queryMask = queryMask;
+	}
+
 	void PhysObject::SetRotation(const Quaternionf& rotation)
 	{
 		m_matrix.SetRotation(rotation);
 		UpdateBody();
 	}
 
+	void PhysObject::SetUserdata(void* userdata)
+	{
+		m_userdata = userdata;
+	}
+
 	void PhysObject::SetVelocity(const Vector3f& velocity)
 	{
 		NewtonBodySetVelocity(m_body, velocity);
@@ -297,8 +379,11 @@ namespace Nz
 	void PhysObject::UpdateBody()
 	{
 		NewtonBodySetMatrix(m_body, m_matrix);
+		m_previousMatrix = m_matrix; //< Teleportation, not interpolated
 
-		if (NumberEquals(m_mass, 0.f))
+		if (!NumberEquals(m_mass, 0.f))
+			NewtonBodySetSleepState(m_body, 0); //< So that the next step reports the object as moved
+		else
 		{
 			// http://newtondynamics.com/wiki/index.php5?title=Can_i_dynamicly_move_a_TriMesh%3F
 			Vector3f min, max;
@@ -319,7 +404,10 @@ namespace Nz
 	PhysObject& PhysObject::operator=(PhysObject&& object)
 	{
 		if (m_body)
+		{
+			m_world->UnregisterBody(m_body);
 			NewtonDestroyBody(m_body);
+		}
 
 		m_body               = object.m_body;
 		m_forceAccumulator   = std::move(object.m_forceAccumulator);
@@ -327,9 +415,16 @@ namespace Nz
 		m_gravityFactor      = object.m_gravityFactor;
 		m_mass               = object.m_mass;
 		m_matrix             = std::move(object.m_matrix);
+		m_previousMatrix     = std::move(object.m_previousMatrix);
+		m_queryMask          = object.m_queryMask;
 		m_torqueAccumulator  = std::move(object.m_torqueAccumulator);
+		m_transformStep      = object.m_transformStep;
+		m_userdata           = object.m_userdata;
 		m_world              = object.m_world;
 
+		if (m_body)
+			NewtonBodySetUserData(m_body, this);
+
 		object.m_body = nullptr;
 
 		return *this;
@@ -340,6 +435,8 @@ namespace Nz
 		NazaraUnused(timeStep);
 		NazaraUnused(threadIndex);
 
+		// Called concurrently for different bodies by the solver threads, only this object is written
+
 		PhysObject* me = static_cast<PhysObject*>(NewtonBodyGetUserData(body));
 
 		if (!NumberEquals(me->m_gravityFactor, 0.f))
@@ -361,8 +458,15 @@ namespace Nz
 	{
 		NazaraUnused(threadIndex);
 
+		// Same as ForceAndTorqueCallback, the matrix is only read by the owner once the step is over
 		PhysObject* me = static_cast<PhysObject*>(NewtonBodyGetUserData(body));
+		PhysWorld* world = me->m_world;
+		if (me->m_transformStep < world->m_firstStepOfCall)
+			world->RegisterMovedObject(me);
+
+		me->m_previousMatrix = me->m_matrix;
 		me->m_matrix.Set(matrix);
+		me->m_transformStep = world->GetStepCount();
 
 		/*for (std::set<PhysObjectListener*>::iterator it = me->m_listeners.begin(); it != me->m_listeners.end(); ++it)
 			(*it)->PhysObjectOnUpdate(me);*/
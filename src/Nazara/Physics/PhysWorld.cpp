@@ -3,15 +3,90 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Physics/PhysWorld.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Physics/Geom.hpp>
+#include <Nazara/Physics/PhysObject.hpp>
 #include <Newton/Newton.h>
+#include <algorithm>
+#include <cmath>
 #include <Nazara/Physics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		constexpr int MaxOverlapContacts = 64;
+
+		struct QueryData
+		{
+			PhysQueryHit* hit;
+			UInt32 queryMask;
+		};
+
+		PhysObject* GetObject(const NewtonBody* body)
+		{
+			return static_cast<PhysObject*>(NewtonBodyGetUserData(body));
+		}
+
+		UInt64 GetMaterialPairKey(int firstMaterial, int secondMaterial)
+		{
+			// Newton does not care about the order of the materials of a pair
+			if (firstMaterial > secondMaterial)
+				std::swap(firstMaterial, secondMaterial);
+
+			return (static_cast<UInt64>(static_cast<UInt32>(firstMaterial)) << 32) | static_cast<UInt32>(secondMaterial);
+		}
+
+		unsigned int QueryPrefilter(const NewtonBody* body, const NewtonCollision* collision, void* userData)
+		{
+			NazaraUnused(collision);
+
+			const QueryData* data = static_cast<const QueryData*>(userData);
+
+			// Bodies which were not created through a PhysObject are never filtered
+			PhysObject* object = GetObject(body);
+			return (!object || (object->GetQueryMask() & data->queryMask) != 0) ? 1 : 0;
+		}
+
+		float RayFilter(const NewtonBody* body, const NewtonCollision* shapeHit, const float* hitContact, const float* hitNormal, long long collisionID, void* userData, float intersectParam)
+		{
+			NazaraUnused(collisionID);
+			NazaraUnused(shapeHit);
+
+			PhysQueryHit* hit = static_cast<QueryData*>(userData)->hit;
+			if (intersectParam <= hit->fraction)
+			{
+				hit->fraction = intersectParam;
+				hit->normal.Set(hitNormal);
+				hit->object = GetObject(body);
+				hit->position.Set(hitContact);
+			}
+
+			// Newton then only reports the hits closer than this one
+			return intersectParam;
+		}
+
+		void ResetHit(PhysQueryHit* hit)
+		{
+			hit->fraction = 1.f;
+			hit->normal = Vector3f::Zero();
+			hit->object = nullptr;
+			hit->position = Vector3f::Zero();
+		}
+	}
+
 	PhysWorld::PhysWorld() :
+	m_movedObjectCount(0),
 	m_gravity(Vector3f::Zero()),
+	m_firstStepOfCall(1),
+	m_stepCount(0),
 	m_stepSize(0.005f),
-	m_timestepAccumulator(0.f)
+	m_timestepAccumulator(0.f),
+	m_maxStepCount(50),
+	m_hasPendingContacts(false),
+	m_isAsyncStepEnabled(false)
 	{
 		m_world = NewtonCreate();
 		NewtonWorldSetUserData(m_world, this);
@@ -19,9 +94,52 @@ namespace Nz
 
 	PhysWorld::~PhysWorld()
 	{
+		WaitForStep();
 		NewtonDestroy(m_world);
 	}
 
+	int PhysWorld::CreateMaterial()
+	{
+		WaitForStep();
+
+		return NewtonMaterialCreateGroupID(m_world);
+	}
+
+	void PhysWorld::EnableAsyncStep(bool asyncStep)
+	{
+		if (!asyncStep)
+			WaitForStep();
+
+		m_isAsyncStepEnabled = asyncStep;
+	}
+
+	void PhysWorld::EnableMaterialContactEvents(int firstMaterial, int secondMaterial, bool contactEvents)
+	{
+		WaitForStep(); //< Read by the solver threads
+
+		GetMaterialPair(firstMaterial, secondMaterial).contactEvents = contactEvents;
+	}
+
+	const PhysContactEvent& PhysWorld::GetContactEvent(std::size_t index) const
+	{
+		NazaraAssert(index < GetContactEventCount(), "Contact event index out of range");
+
+		return m_contactEvents[index];
+	}
+
+	std::size_t PhysWorld::GetContactEventCount() const
+	{
+		// Events of the last Step call, an asynchronous step only reports its own at the beginning of the next call
+		WaitForStep();
+
+		return m_contactEvents.size();
+	}
+
+	int PhysWorld::GetDefaultMaterial() const
+	{
+		return NewtonMaterialGetDefaultGroupID(m_world);
+	}
+
 	Vector3f PhysWorld::GetGravity() const
 	{
 		return m_gravity;
@@ -32,16 +150,155 @@ namespace Nz
 		return m_world;
 	}
 
+	float PhysWorld::GetInterpolationFactor() const
+	{
+		// Fraction of a step elapsed since the last one, to blend the previous and current poses of the objects
+		return m_timestepAccumulator / m_stepSize;
+	}
+
+	unsigned int PhysWorld::GetMaxStepCount() const
+	{
+		return m_maxStepCount;
+	}
+
+	unsigned int PhysWorld::GetMaxThreadCount() const
+	{
+		return NewtonGetMaxThreadsCount(m_world);
+	}
+
+	PhysObject* PhysWorld::GetMovedObject(std::size_t index) const
+	{
+		NazaraAssert(index < GetMovedObjectCount(), "Moved object index out of range");
+
+		return m_movedObjects[index];
+	}
+
+	std::size_t PhysWorld::GetMovedObjectCount() const
+	{
+		// Objects moved by the last Step call, whichever number of steps it ran
+		WaitForStep();
+
+		return m_movedObjectCount.load(std::memory_order_relaxed);
+	}
+
+	UInt64 PhysWorld::GetStepCount() const
+	{
+		return m_stepCount;
+	}
+
 	float PhysWorld::GetStepSize() const
 	{
 		return m_stepSize;
 	}
 
+	unsigned int PhysWorld::GetThreadCount() const
+	{
+		return NewtonGetThreadsCount(m_world);
+	}
+
+	bool PhysWorld::IsAsyncStepEnabled() const
+	{
+		return m_isAsyncStepEnabled;
+	}
+
+	void PhysWorld::Overlap(const PhysOverlapQuery* queries, std::size_t queryCount, PhysObject** objects, std::size_t maxObjectsPerQuery, std::size_t* objectCounts, UInt32 queryMask)
+	{
+		NazaraAssert(queryCount == 0 || (queries && objects && objectCounts), "Invalid buffers");
+
+		WaitForStep();
+
+		// Geometries may create their handle for this world, which cannot be done concurrently
+		m_queryCollisions.resize(queryCount);
+		for (std::size_t i = 0; i < queryCount; ++i)
+		{
+			NazaraAssert(queries[i].geom, "Invalid geometry");
+			m_queryCollisions[i] = queries[i].geom->GetHandle(this);
+		}
+
+		RunQueries(queryCount, [&](std::size_t index, int threadIndex)
+		{
+			QueryData data;
+			data.hit = nullptr;
+			data.queryMask = queryMask;
+
+			NewtonWorldConvexCastReturnInfo contacts[MaxOverlapContacts];
+			int contactCount = NewtonWorldCollide(m_world, queries[index].transform, m_queryCollisions[index], &data, &QueryPrefilter, contacts, MaxOverlapContacts, threadIndex);
+
+			// An object touched at multiple points is only reported once
+			PhysObject** queryObjects = &objects[index * maxObjectsPerQuery];
+			std::size_t objectCount = 0;
+			for (int i = 0; i < contactCount && objectCount < maxObjectsPerQuery; ++i)
+			{
+				PhysObject* object = GetObject(contacts[i].m_hitBody);
+				if (object && std::find(queryObjects, queryObjects + objectCount, object) == queryObjects + objectCount)
+					queryObjects[objectCount++] = object;
+			}
+
+			objectCounts[index] = objectCount;
+		});
+	}
+
+	void PhysWorld::RayCast(const PhysRayQuery* queries, std::size_t queryCount, PhysQueryHit* hits, UInt32 queryMask)
+	{
+		NazaraAssert(queryCount == 0 || (queries && hits), "Invalid buffers");
+
+		WaitForStep();
+
+		RunQueries(queryCount, [&](std::size_t index, int threadIndex)
+		{
+			PhysQueryHit* hit = &hits[index];
+			ResetHit(hit);
+
+			QueryData data;
+			data.hit = hit;
+			data.queryMask = queryMask;
+
+			NewtonWorldRayCast(m_world, queries[index].from, queries[index].to, &RayFilter, &data, &QueryPrefilter, threadIndex);
+		});
+	}
+
 	void PhysWorld::SetGravity(const Vector3f& gravity)
 	{
+		WaitForStep(); //< Read by the force callbacks
+
 		m_gravity = gravity;
 	}
 
+	void PhysWorld::SetMaterialCollidable(int firstMaterial, int secondMaterial, bool collidable)
+	{
+		WaitForStep();
+
+		NewtonMaterialSetDefaultCollidable(m_world, firstMaterial, secondMaterial, (collidable) ? 1 : 0);
+	}
+
+	void PhysWorld::SetMaterialElasticity(int firstMaterial, int secondMaterial, float elasticity)
+	{
+		WaitForStep();
+
+		NewtonMaterialSetDefaultElasticity(m_world, firstMaterial, secondMaterial, elasticity);
+	}
+
+	void PhysWorld::SetMaterialFilter(int firstMaterial, int secondMaterial, ContactFilter filter)
+	{
+		// The filter runs on the solver threads when the bounding boxes of two objects overlap, before any contact is computed
+		// It has to be thread-safe and must not modify the world, returning false prevents the objects from colliding
+		WaitForStep();
+
+		GetMaterialPair(firstMaterial, secondMaterial).filter = std::move(filter);
+	}
+
+	void PhysWorld::SetMaterialFriction(int firstMaterial, int secondMaterial, float staticFriction, float kineticFriction)
+	{
+		WaitForStep();
+
+		NewtonMaterialSetDefaultFriction(m_world, firstMaterial, secondMaterial, staticFriction, kineticFriction);
+	}
+
+	void PhysWorld::SetMaxStepCount(unsigned int maxStepCount)
+	{
+		m_maxStepCount = maxStepCount;
+	}
+
 	void PhysWorld::SetSolverModel(unsigned int model)
 	{
 		NewtonSetSolverModel(m_world, model);
@@ -52,14 +309,298 @@ namespace Nz
 		m_stepSize = stepSize;
 	}
 
+	void PhysWorld::SetThreadCount(unsigned int threadCount)
+	{
+		NazaraAssert(threadCount > 0, "Thread count must be over zero");
+
+		// Islands are solved across the worker threads, body callbacks may then run concurrently
+		WaitForStep();
+		NewtonSetThreadsCount(m_world, static_cast<int>(threadCount));
+	}
+
 	void PhysWorld::Step(float timestep)
 	{
+		NazaraProfileZone("PhysWorld::Step");
+
+		// The previous asynchronous step has to be over before bodies are touched again
+		WaitForStep();
+
+		m_contactEvents.clear();
+		if (m_hasPendingContacts)
+		{
+			ProcessContacts();
+			m_hasPendingContacts = false;
+		}
+
+		// Contacts are recorded without locking by the solver threads, one buffer each
+		m_threadContacts.resize(std::max(GetThreadCount(), 1U));
+
+		// Objects register themselves during the first step of this call which moves them, there can't be more than the bodies
+		m_firstStepOfCall = m_stepCount + 1;
+		m_movedObjectCount.store(0, std::memory_order_relaxed);
+		m_movedObjects.resize(NewtonWorldGetBodyCount(m_world));
+
 		m_timestepAccumulator += timestep;
 
+		// A slow frame would otherwise require even more steps on the next one, the late time is dropped instead
+		float maxTimestep = m_maxStepCount * m_stepSize;
+		if (m_maxStepCount > 0 && m_timestepAccumulator >= maxTimestep + m_stepSize)
+			m_timestepAccumulator = maxTimestep + std::fmod(m_timestepAccumulator, m_stepSize);
+
 		while (m_timestepAccumulator >= m_stepSize)
 		{
-			NewtonUpdate(m_world, m_stepSize);
 			m_timestepAccumulator -= m_stepSize;
+			m_stepCount++;
+
+			// The last step runs in the background, until the next Step or WaitForStep call
+			if (m_isAsyncStepEnabled && m_timestepAccumulator < m_stepSize)
+			{
+				NewtonUpdateAsync(m_world, m_stepSize);
+				m_hasPendingContacts = true;
+			}
+			else
+			{
+				NewtonUpdate(m_world, m_stepSize);
+				ProcessContacts();
+			}
 		}
 	}
+
+	void PhysWorld::Sweep(const PhysSweepQuery* queries, std::size_t queryCount, PhysQueryHit* hits, UInt32 queryMask)
+	{
+		NazaraAssert(queryCount == 0 || (queries && hits), "Invalid buffers");
+
+		WaitForStep();
+
+		m_queryCollisions.resize(queryCount);
+		for (std::size_t i = 0; i < queryCount; ++i)
+		{
+			NazaraAssert(queries[i].geom, "Invalid geometry");
+			m_queryCollisions[i] = queries[i].geom->GetHandle(this);
+		}
+
+		RunQueries(queryCount, [&](std::size_t index, int threadIndex)
+		{
+			PhysQueryHit* hit = &hits[index];
+			ResetHit(hit);
+
+			QueryData data;
+			data.hit = hit;
+			data.queryMask = queryMask;
+
+			float hitParam;
+			NewtonWorldConvexCastReturnInfo contact;
+			if (NewtonWorldConvexCast(m_world, queries[index].from, queries[index].to, m_queryCollisions[index], &hitParam, &data, &QueryPrefilter, &contact, 1, threadIndex) > 0)
+			{
+				hit->fraction = hitParam;
+				hit->normal.Set(contact.m_normal);
+				hit->object = GetObject(contact.m_hitBody);
+				hit->position.Set(contact.m_point);
+			}
+		});
+	}
+
+	void PhysWorld::WaitForStep() const
+	{
+		if (m_isAsyncStepEnabled)
+			NewtonWaitForUpdateToFinish(m_world);
+	}
+
+	PhysWorld::MaterialPair& PhysWorld::GetMaterialPair(int firstMaterial, int secondMaterial)
+	{
+		MaterialPair& pair = m_materialPairs[GetMaterialPairKey(firstMaterial, secondMaterial)];
+		if (!pair.world)
+		{
+			// Nodes of an unordered_map are never moved, Newton can keep a pointer to the pair
+			pair.world = this;
+			NewtonMaterialSetCollisionCallback(m_world, firstMaterial, secondMaterial, &pair, &OnMaterialOverlap, &OnMaterialContacts);
+		}
+
+		return pair;
+	}
+
+	void PhysWorld::ProcessContacts()
+	{
+		auto ComparePairs = [](const ContactRecord& lhs, const ContactRecord& rhs)
+		{
+			return (lhs.first != rhs.first) ? lhs.first < rhs.first : lhs.second < rhs.second;
+		};
+
+		auto AddEvent = [this](const ContactRecord& contact, ContactEventType type)
+		{
+			PhysObject* first = GetObject(contact.first);
+			PhysObject* second = GetObject(contact.second);
+			if (!first || !second)
+				return;
+
+			PhysContactEvent contactEvent;
+			contactEvent.first = first;
+			contactEvent.normal = contact.normal;
+			contactEvent.normalSpeed = contact.normalSpeed;
+			contactEvent.position = contact.position;
+			contactEvent.second = second;
+			contactEvent.type = type;
+
+			m_contactEvents.push_back(contactEvent);
+		};
+
+		auto EndContact = [&](const ContactRecord& contact)
+		{
+			// Newton does not report the contacts of sleeping objects, they are still touching
+			auto IsResting = [](const PhysObject* object)
+			{
+				return object->IsSleeping() || !object->IsMoveable();
+			};
+
+			PhysObject* first = GetObject(contact.first);
+			PhysObject* second = GetObject(contact.second);
+			if (first && second && IsResting(first) && IsResting(second))
+				m_stepContacts.push_back(contact);
+			else
+				AddEvent(contact, ContactEventType_End);
+		};
+
+		m_stepContacts.clear();
+		for (std::vector<ContactRecord>& threadContacts : m_threadContacts)
+		{
+			m_stepContacts.insert(m_stepContacts.end(), threadContacts.begin(), threadContacts.end());
+			threadContacts.clear();
+		}
+
+		if (m_stepContacts.empty() && m_activeContacts.empty())
+			return;
+
+		// Both lists being sorted, the pairs which began, persisted or ended are found in a single pass
+		std::sort(m_stepContacts.begin(), m_stepContacts.end(), ComparePairs);
+
+		std::size_t stepContactCount = m_stepContacts.size();
+		auto previousIt = m_activeContacts.begin();
+		for (std::size_t i = 0; i < stepContactCount; ++i)
+		{
+			ContactRecord contact = m_stepContacts[i]; //< Copied, the vector may grow in the loop
+			for (; previousIt != m_activeContacts.end() && ComparePairs(*previousIt, contact); ++previousIt)
+				EndContact(*previousIt);
+
+			if (previousIt != m_activeContacts.end() && !ComparePairs(contact, *previousIt))
+			{
+				AddEvent(contact, ContactEventType_Persist);
+				++previousIt;
+			}
+			else
+				AddEvent(contact, ContactEventType_Begin);
+		}
+
+		for (; previousIt != m_activeContacts.end(); ++previousIt)
+			EndContact(*previousIt);
+
+		// Pairs kept for sleeping objects were appended in order
+		std::inplace_merge(m_stepContacts.begin(), m_stepContacts.begin() + stepContactCount, m_stepContacts.end(), ComparePairs);
+		std::swap(m_activeContacts, m_stepContacts);
+	}
+
+	void PhysWorld::RegisterMovedObject(PhysObject* object)
+	{
+		// Called concurrently by the solver threads
+		m_movedObjects[m_movedObjectCount.fetch_add(1, std::memory_order_relaxed)] = object;
+	}
+
+	template<typename F>
+	void PhysWorld::RunQueries(std::size_t queryCount, F function)
+	{
+		if (queryCount == 0)
+			return;
+
+		// Newton requires concurrent queries to use distinct thread indices, there is one slot of queries per solver thread
+		std::size_t slotCount = std::min<std::size_t>(GetThreadCount(), queryCount);
+		std::size_t queriesPerSlot = (queryCount + slotCount - 1) / slotCount;
+
+		TaskScheduler::ParallelFor(0, slotCount, 1, [&](std::size_t firstSlot, std::size_t lastSlot)
+		{
+			for (std::size_t slot = firstSlot; slot < lastSlot; ++slot)
+			{
+				std::size_t lastQuery = std::min((slot + 1) * queriesPerSlot, queryCount);
+				for (std::size_t i = slot * queriesPerSlot; i < lastQuery; ++i)
+					function(i, static_cast<int>(slot));
+			}
+		});
+	}
+
+	void PhysWorld::UnregisterBody(const NewtonBody* body)
+	{
+		// The contacts of a destroyed body end without any event
+		WaitForStep();
+
+		auto UsesBody = [body](const ContactRecord& contact)
+		{
+			return contact.first == body || contact.second == body;
+		};
+
+		m_activeContacts.erase(std::remove_if(m_activeContacts.begin(), m_activeContacts.end(), UsesBody), m_activeContacts.end());
+		for (std::vector<ContactRecord>& threadContacts : m_threadContacts)
+			threadContacts.erase(std::remove_if(threadContacts.begin(), threadContacts.end(), UsesBody), threadContacts.end());
+	}
+
+	void PhysWorld::OnMaterialContacts(const NewtonJoint* contactJoint, float timestep, int threadIndex)
+	{
+		NazaraUnused(timestep);
+
+		// Called by the solver threads, each one only writes its own buffer
+		const NewtonBody* firstBody = NewtonJointGetBody0(contactJoint);
+		const NewtonBody* secondBody = NewtonJointGetBody1(contactJoint);
+		if (firstBody > secondBody)
+			std::swap(firstBody, secondBody);
+
+		const MaterialPair* pair = nullptr;
+		ContactRecord record;
+		record.first = firstBody;
+		record.normal = Vector3f::Zero();
+		record.normalSpeed = 0.f;
+		record.position = Vector3f::Zero();
+		record.second = secondBody;
+
+		unsigned int contactCount = 0;
+		for (void* contact = NewtonContactJointGetFirstContact(contactJoint); contact; contact = NewtonContactJointGetNextContact(contactJoint, contact))
+		{
+			NewtonMaterial* material = NewtonContactGetMaterial(contact);
+			if (!pair)
+			{
+				pair = static_cast<const MaterialPair*>(NewtonMaterialGetMaterialPairUserData(material));
+				if (!pair || !pair->contactEvents)
+					return;
+			}
+
+			Vector3f normal;
+			Vector3f position;
+			NewtonMaterialGetContactPositionAndNormal(material, firstBody, position, normal);
+
+			record.normal += normal;
+			record.normalSpeed = std::max(record.normalSpeed, std::abs(NewtonMaterialGetContactNormalSpeed(material)));
+			record.position += position;
+			contactCount++;
+		}
+
+		if (contactCount == 0)
+			return;
+
+		record.normal.Normalize();
+		record.position /= static_cast<float>(contactCount);
+
+		pair->world->m_threadContacts[threadIndex].push_back(record);
+	}
+
+	int PhysWorld::OnMaterialOverlap(const NewtonMaterial* material, const NewtonBody* firstBody, const NewtonBody* secondBody, int threadIndex)
+	{
+		NazaraUnused(threadIndex);
+
+		const MaterialPair* pair = static_cast<const MaterialPair*>(NewtonMaterialGetMaterialPairUserData(material));
+		if (!pair || !pair->filter)
+			return 1;
+
+		PhysObject* first = GetObject(firstBody);
+		PhysObject* second = GetObject(secondBody);
+		if (!first || !second)
+			return 1;
+
+		return (pair->filter(*first, *second)) ? 1 : 0;
+	}
 }
@@ -4,6 +4,8 @@
 
 #include <Nazara/Renderer/DebugDrawer.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/RenderStates.hpp>
@@ -14,134 +16,168 @@
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
 #include <Nazara/Utility/VertexStruct.hpp>
+#include <algorithm>
 #include <memory>
+#include <vector>
 #include <Nazara/Renderer/Debug.hpp>
 
-///TODO: Améliorer
-
 namespace Nz
 {
 	namespace
 	{
+		struct Group
+		{
+			std::vector<VertexStruct_XYZ_Color> lines;
+			std::vector<VertexStruct_XYZ_Color> points;
+			unsigned int remainingFrames;
+			bool depthBuffer;
+		};
+
+		struct ThreadBuffer
+		{
+			std::vector<Group> groups;
+			Color primaryColor = Color::Red;
+			Color secondaryColor = Color::Green;
+			unsigned int persistence = 0;
+			bool depthBuffer = true;
+		};
+
+		const BoxCorner s_boxEdges[24] =
+		{
+			BoxCorner_NearLeftBottom,  BoxCorner_NearRightBottom,
+			BoxCorner_NearLeftBottom,  BoxCorner_NearLeftTop,
+			BoxCorner_NearLeftBottom,  BoxCorner_FarLeftBottom,
+			BoxCorner_FarRightTop,     BoxCorner_FarLeftTop,
+			BoxCorner_FarRightTop,     BoxCorner_FarRightBottom,
+			BoxCorner_FarRightTop,     BoxCorner_NearRightTop,
+			BoxCorner_FarLeftBottom,   BoxCorner_FarRightBottom,
+			BoxCorner_FarLeftBottom,   BoxCorner_FarLeftTop,
+			BoxCorner_NearLeftTop,     BoxCorner_NearRightTop,
+			BoxCorner_NearLeftTop,     BoxCorner_FarLeftTop,
+			BoxCorner_NearRightBottom, BoxCorner_NearRightTop,
+			BoxCorner_NearRightBottom, BoxCorner_FarRightBottom
+		};
+
 		static Shader* s_shader = nullptr;
-		static Color s_primaryColor;
-		static Color s_secondaryColor;
+		static Mutex s_mutex;
 		static RenderStates s_renderStates;
 		static VertexBuffer s_vertexBuffer;
+		static std::vector<Group> s_retainedGroups;
+		static std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+		static std::vector<VertexStruct_XYZ_Color> s_vertices;
 		static bool s_initialized = false;
-		static int s_colorLocation = -1;
-	}
+		static unsigned int s_generation = 1;
 
-	void DebugDrawer::Draw(const BoundingVolumef& volume)
-	{
-		if (!Initialize())
+		thread_local ThreadBuffer* t_threadBuffer = nullptr;
+		thread_local unsigned int t_generation = 0;
+
+		ThreadBuffer& GetThreadBuffer()
 		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+			// Chaque thread écrit dans son propre tampon, seul l'enregistrement est protégé
+			if (!t_threadBuffer || t_generation != s_generation)
+			{
+				LockGuard lock(s_mutex);
 
-		if (!volume.IsFinite())
-			return;
+				s_threadBuffers.emplace_back(new ThreadBuffer);
+				t_threadBuffer = s_threadBuffers.back().get();
+				t_generation = s_generation;
+			}
 
-		Color oldPrimaryColor = s_primaryColor;
+			return *t_threadBuffer;
+		}
 
-		Draw(volume.aabb);
+		Group& GetGroup(ThreadBuffer& buffer)
+		{
+			for (Group& group : buffer.groups)
+			{
+				if (group.depthBuffer == buffer.depthBuffer && group.remainingFrames == buffer.persistence)
+					return group;
+			}
 
-		s_primaryColor = s_secondaryColor;
-		Draw(volume.obb);
+			buffer.groups.emplace_back();
 
-		s_primaryColor = oldPrimaryColor;
-	}
+			Group& group = buffer.groups.back();
+			group.depthBuffer = buffer.depthBuffer;
+			group.remainingFrames = buffer.persistence;
 
-	void DebugDrawer::Draw(const Boxi& box)
-	{
-		Draw(Boxf(box));
-	}
+			return group;
+		}
 
-	void DebugDrawer::Draw(const Boxf& box)
-	{
-		if (!Initialize())
+		void AddVertex(std::vector<VertexStruct_XYZ_Color>& vertices, const Vector3f& position, const Color& color)
 		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+			vertices.emplace_back();
 
-		BufferMapper<VertexBuffer> mapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, 24);
-		VertexStruct_XYZ* vertex = static_cast<VertexStruct_XYZ*>(mapper.GetPointer());
+			VertexStruct_XYZ_Color& vertex = vertices.back();
+			vertex.color = color;
+			vertex.position = position;
+		}
 
-		Vector3f max, min;
-		max = box.GetMaximum();
-		min = box.GetMinimum();
+		template<typename T>
+		void AddCorners(const T& volume)
+		{
+			ThreadBuffer& buffer = GetThreadBuffer();
+			Group& group = GetGroup(buffer);
 
-		vertex->position.Set(min.x, min.y, min.z);
-		vertex++;
-		vertex->position.Set(max.x, min.y, min.z);
-		vertex++;
+			for (BoxCorner corner : s_boxEdges)
+				AddVertex(group.lines, volume.GetCorner(corner), buffer.primaryColor);
+		}
 
-		vertex->position.Set(min.x, min.y, min.z);
-		vertex++;
-		vertex->position.Set(min.x, max.y, min.z);
-		vertex++;
+		template<typename F>
+		void AddMeshLines(const StaticMesh* subMesh, F func)
+		{
+			ThreadBuffer& buffer = GetThreadBuffer();
+			Group& group = GetGroup(buffer);
 
-		vertex->position.Set(min.x, min.y, min.z);
-		vertex++;
-		vertex->position.Set(min.x, min.y, max.z);
-		vertex++;
+			unsigned int vertexCount = subMesh->GetVertexCount();
 
-		vertex->position.Set(max.x, max.y, max.z);
-		vertex++;
-		vertex->position.Set(min.x, max.y, max.z);
-		vertex++;
+			BufferMapper<VertexBuffer> mapper(subMesh->GetVertexBuffer(), BufferAccess_ReadOnly);
+			const MeshVertex* vertex = static_cast<const MeshVertex*>(mapper.GetPointer());
 
-		vertex->position.Set(max.x, max.y, max.z);
-		vertex++;
-		vertex->position.Set(max.x, min.y, max.z);
-		vertex++;
+			group.lines.reserve(group.lines.size() + vertexCount*2);
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				AddVertex(group.lines, vertex->position, buffer.primaryColor);
+				AddVertex(group.lines, vertex->position + func(*vertex)*0.01f, buffer.primaryColor);
 
-		vertex->position.Set(max.x, max.y, max.z);
-		vertex++;
-		vertex->position.Set(max.x, max.y, min.z);
-		vertex++;
+				vertex++;
+			}
+		}
+	}
 
-		vertex->position.Set(min.x, min.y, max.z);
-		vertex++;
-		vertex->position.Set(max.x, min.y, max.z);
-		vertex++;
+	void DebugDrawer::Clear()
+	{
+		LockGuard lock(s_mutex);
 
-		vertex->position.Set(min.x, min.y, max.z);
-		vertex++;
-		vertex->position.Set(min.x, max.y, max.z);
-		vertex++;
+		for (auto& buffer : s_threadBuffers)
+			buffer->groups.clear();
 
-		vertex->position.Set(min.x, max.y, min.z);
-		vertex++;
-		vertex->position.Set(max.x, max.y, min.z);
-		vertex++;
+		s_retainedGroups.clear();
+	}
 
-		vertex->position.Set(min.x, max.y, min.z);
-		vertex++;
-		vertex->position.Set(min.x, max.y, max.z);
-		vertex++;
+	void DebugDrawer::Draw(const BoundingVolumef& volume)
+	{
+		if (!volume.IsFinite())
+			return;
 
-		vertex->position.Set(max.x, min.y, min.z);
-		vertex++;
-		vertex->position.Set(max.x, max.y, min.z);
-		vertex++;
+		ThreadBuffer& buffer = GetThreadBuffer();
+		Color oldPrimaryColor = buffer.primaryColor;
 
-		vertex->position.Set(max.x, min.y, min.z);
-		vertex++;
-		vertex->position.Set(max.x, min.y, max.z);
-		vertex++;
+		Draw(volume.aabb);
 
-		mapper.Unmap();
+		buffer.primaryColor = buffer.secondaryColor;
+		Draw(volume.obb);
 
-		Renderer::SetRenderStates(s_renderStates);
-		Renderer::SetShader(s_shader);
-		Renderer::SetVertexBuffer(&s_vertexBuffer);
+		buffer.primaryColor = oldPrimaryColor;
+	}
 
-		s_shader->SendColor(s_colorLocation, s_primaryColor);
+	void DebugDrawer::Draw(const Boxi& box)
+	{
+		Draw(Boxf(box));
+	}
 
-		Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, 24);
+	void DebugDrawer::Draw(const Boxf& box)
+	{
+		AddCorners(box);
 	}
 
 	void DebugDrawer::Draw(const Boxui& box)
@@ -151,217 +187,33 @@ namespace Nz
 
 	void DebugDrawer::Draw(const Frustumf& frustum)
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
-
-		BufferMapper<VertexBuffer> mapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, 24);
-		VertexStruct_XYZ* vertex = static_cast<VertexStruct_XYZ*>(mapper.GetPointer());
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(frustum.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-		vertex->position.Set(frustum.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		mapper.Unmap();
-
-		Renderer::SetRenderStates(s_renderStates);
-		Renderer::SetShader(s_shader);
-		Renderer::SetVertexBuffer(&s_vertexBuffer);
-
-		s_shader->SendColor(s_colorLocation, s_primaryColor);
-
-		Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, 24);
+		AddCorners(frustum);
 	}
 
 	void DebugDrawer::Draw(const OrientedBoxf& orientedBox)
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
-
-		BufferMapper<VertexBuffer> mapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, 24);
-		VertexStruct_XYZ* vertex = static_cast<VertexStruct_XYZ*>(mapper.GetPointer());
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightTop));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearLeftTop));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarLeftTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightTop));
-		vertex++;
-
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_NearRightBottom));
-		vertex++;
-		vertex->position.Set(orientedBox.GetCorner(BoxCorner_FarRightBottom));
-		vertex++;
-
-		mapper.Unmap();
-
-		Renderer::SetRenderStates(s_renderStates);
-		Renderer::SetShader(s_shader);
-		Renderer::SetVertexBuffer(&s_vertexBuffer);
-
-		s_shader->SendColor(s_colorLocation, s_primaryColor);
-
-		Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, 24);
+		AddCorners(orientedBox);
 	}
 
 	void DebugDrawer::Draw(const Skeleton* skeleton)
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+		ThreadBuffer& buffer = GetThreadBuffer();
+		Group& group = GetGroup(buffer);
 
 		unsigned int jointCount = skeleton->GetJointCount();
-		if (s_vertexBuffer.GetVertexCount() < jointCount*2)
-		{
-			NazaraError("Debug buffer not large enougth to draw object");
-			return;
-		}
-
-		BufferMapper<VertexBuffer> mapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, jointCount*2);
-		VertexStruct_XYZ* vertex = static_cast<VertexStruct_XYZ*>(mapper.GetPointer());
-
-		unsigned int vertexCount = 0;
 		for (unsigned int i = 0; i < jointCount; ++i)
 		{
 			const Node* joint = skeleton->GetJoint(i);
 			const Node* parent = joint->GetParent();
 			if (parent)
 			{
-				vertex->position = joint->GetPosition();
-				vertex++;
+				AddVertex(group.lines, joint->GetPosition(), buffer.primaryColor);
+				AddVertex(group.lines, parent->GetPosition(), buffer.primaryColor);
 
-				vertex->position = parent->GetPosition();
-				vertex++;
-
-				vertexCount += 2;
+				AddVertex(group.points, joint->GetPosition(), buffer.secondaryColor);
+				AddVertex(group.points, parent->GetPosition(), buffer.secondaryColor);
 			}
 		}
-
-		mapper.Unmap();
-
-		if (vertexCount > 0)
-		{
-			Renderer::SetRenderStates(s_renderStates);
-			Renderer::SetShader(s_shader);
-			Renderer::SetVertexBuffer(&s_vertexBuffer);
-
-			s_shader->SendColor(s_colorLocation, s_primaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, vertexCount);
-
-			s_shader->SendColor(s_colorLocation, s_secondaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_PointList, 0, vertexCount);
-		}
 	}
 
 	void DebugDrawer::Draw(const Vector3f& position, float size)
@@ -371,86 +223,37 @@ namespace Nz
 
 	void DebugDrawer::DrawAxes(const Vector3f& position, float size)
 	{
-		Color oldPrimaryColor = s_primaryColor;
-		s_primaryColor = Color::Red;
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		Color oldPrimaryColor = buffer.primaryColor;
+		buffer.primaryColor = Color::Red;
 		DrawLine(position, position + Vector3f::UnitX() * 3.f * size / 4.f);
-		s_primaryColor = Color::Green;
+		buffer.primaryColor = Color::Green;
 		DrawLine(position, position + Vector3f::UnitY() * 3.f * size / 4.f);
-		s_primaryColor = Color::Blue;
+		buffer.primaryColor = Color::Blue;
 		DrawLine(position, position + Vector3f::UnitZ() * 3.f * size / 4.f);
 
-		s_primaryColor = Color::Red;
+		buffer.primaryColor = Color::Red;
 		DrawCone(position + Vector3f::UnitX() * size, EulerAnglesf(0.f, 90.f, 0.f), 15, size / 4.f);
-		s_primaryColor = Color::Green;
+		buffer.primaryColor = Color::Green;
 		DrawCone(position + Vector3f::UnitY() * size, EulerAnglesf(-90.f, 0.f, 0.f), 15, size / 4.f);
-		s_primaryColor = Color::Blue;
+		buffer.primaryColor = Color::Blue;
 		DrawCone(position + Vector3f::UnitZ() * size, EulerAnglesf(0.f, 0.f, 0.f), 15, size / 4.f);
-		s_primaryColor = oldPrimaryColor;
+		buffer.primaryColor = oldPrimaryColor;
 	}
 
 	void DebugDrawer::DrawBinormals(const StaticMesh* subMesh)
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
-
-		unsigned int normalCount = subMesh->GetVertexCount();
-		unsigned int vertexCount = normalCount*2;
-		if (s_vertexBuffer.GetVertexCount() < vertexCount)
-		{
-			NazaraError("Debug buffer not large enougth to draw object");
-			return;
-		}
-
-		BufferMapper<VertexBuffer> inputMapper(subMesh->GetVertexBuffer(), BufferAccess_ReadOnly);
-		BufferMapper<VertexBuffer> outputMapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, vertexCount);
-
-		MeshVertex* inputVertex = static_cast<MeshVertex*>(inputMapper.GetPointer());
-		VertexStruct_XYZ* outputVertex = static_cast<VertexStruct_XYZ*>(outputMapper.GetPointer());
-
-		for (unsigned int i = 0; i < normalCount; ++i)
-		{
-			outputVertex->position = inputVertex->position;
-			outputVertex++;
-
-			outputVertex->position = inputVertex->position + Vector3f::CrossProduct(inputVertex->normal, inputVertex->tangent)*0.01f;
-			outputVertex++;
-
-			inputVertex++;
-		}
-
-		inputMapper.Unmap();
-		outputMapper.Unmap();
-
-		if (vertexCount > 0)
-		{
-			Renderer::SetRenderStates(s_renderStates);
-			Renderer::SetShader(s_shader);
-			Renderer::SetVertexBuffer(&s_vertexBuffer);
-
-			s_shader->SendColor(s_colorLocation, s_primaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, vertexCount);
-		}
+		AddMeshLines(subMesh, [] (const MeshVertex& vertex) { return Vector3f::CrossProduct(vertex.normal, vertex.tangent); });
 	}
 
 	void DebugDrawer::DrawCone(const Vector3f& origin, const Quaternionf& rotation, float angle, float length)
 	{
-		if (!Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
-
 		Matrix4f transformMatrix;
 		transformMatrix.MakeIdentity();
 		transformMatrix.SetRotation(rotation);
 		transformMatrix.SetTranslation(origin);
 
-		BufferMapper<VertexBuffer> mapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, 16);
-		VertexStruct_XYZ* vertex = static_cast<VertexStruct_XYZ*>(mapper.GetPointer());
-
 		// On calcule le reste des points
 		Vector3f base(Vector3f::Forward()*length);
 
@@ -460,204 +263,202 @@ namespace Nz
 		Vector3f lExtend = Vector3f::Left()*radius;
 		Vector3f uExtend = Vector3f::Up()*radius;
 
-		vertex->position.Set(transformMatrix * Vector3f::Zero());
-		vertex++;
-		vertex->position.Set(transformMatrix * (base + lExtend + uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * (base + lExtend + uExtend));
-		vertex++;
-		vertex->position.Set(transformMatrix * (base + lExtend - uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * Vector3f::Zero());
-		vertex++;
-		vertex->position.Set(transformMatrix * (base + lExtend - uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * (base + lExtend - uExtend));
-		vertex++;
-		vertex->position.Set(transformMatrix * (base - lExtend - uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * Vector3f::Zero());
-		vertex++;
-		vertex->position.Set(transformMatrix * (base - lExtend + uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * (base - lExtend + uExtend));
-		vertex++;
-		vertex->position.Set(transformMatrix * (base - lExtend - uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * Vector3f::Zero());
-		vertex++;
-		vertex->position.Set(transformMatrix * (base - lExtend - uExtend));
-		vertex++;
-
-		vertex->position.Set(transformMatrix * (base - lExtend + uExtend));
-		vertex++;
-		vertex->position.Set(transformMatrix * (base + lExtend + uExtend));
-		vertex++;
-
-		mapper.Unmap();
+		Vector3f apex = transformMatrix * Vector3f::Zero();
+		Vector3f corners[4] =
+		{
+			transformMatrix * (base + lExtend + uExtend),
+			transformMatrix * (base + lExtend - uExtend),
+			transformMatrix * (base - lExtend - uExtend),
+			transformMatrix * (base - lExtend + uExtend)
+		};
 
-		Renderer::SetRenderStates(s_renderStates);
-		Renderer::SetShader(s_shader);
-		Renderer::SetVertexBuffer(&s_vertexBuffer);
+		ThreadBuffer& buffer = GetThreadBuffer();
+		Group& group = GetGroup(buffer);
 
-		s_shader->SendColor(s_colorLocation, s_primaryColor);
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			AddVertex(group.lines, apex, buffer.primaryColor);
+			AddVertex(group.lines, corners[i], buffer.primaryColor);
 
-		Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, 16);
+			AddVertex(group.lines, corners[i], buffer.primaryColor);
+			AddVertex(group.lines, corners[(i + 1) % 4], buffer.primaryColor);
+		}
 	}
 
 	void DebugDrawer::DrawLine(const Vector3f& p1, const Vector3f& p2)
 	{
-		if (!s_initialized && !Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+		ThreadBuffer& buffer = GetThreadBuffer();
+		Group& group = GetGroup(buffer);
 
-		VertexStruct_XYZ buffer[2];
-		buffer[0].position = p1;
-		buffer[1].position = p2;
-
-		s_vertexBuffer.Fill(&buffer[0], 0, 2);
-
-		Renderer::SetRenderStates(s_renderStates);
-		Renderer::SetShader(s_shader);
-		Renderer::SetVertexBuffer(&s_vertexBuffer);
-
-		s_shader->SendColor(s_colorLocation, s_primaryColor);
-		Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, 2);
+		AddVertex(group.lines, p1, buffer.primaryColor);
+		AddVertex(group.lines, p2, buffer.primaryColor);
 	}
 
 	void DebugDrawer::DrawPoints(const Vector3f* ptr, unsigned int pointCount)
 	{
-		static_assert(sizeof(VertexStruct_XYZ) == sizeof(Vector3f), "VertexStruct_XYZ is no longer equal to Vector3f, please rewrite this");
+		ThreadBuffer& buffer = GetThreadBuffer();
+		Group& group = GetGroup(buffer);
 
-		if (!s_initialized && !Initialize())
-		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+		group.points.reserve(group.points.size() + pointCount);
+		for (unsigned int i = 0; i < pointCount; ++i)
+			AddVertex(group.points, ptr[i], buffer.primaryColor);
+	}
 
-		if (pointCount > 0)
-		{
-			s_vertexBuffer.Fill(ptr, 0, pointCount);
+	void DebugDrawer::DrawNormals(const StaticMesh* subMesh)
+	{
+		AddMeshLines(subMesh, [] (const MeshVertex& vertex) { return vertex.normal; });
+	}
 
-			Renderer::SetRenderStates(s_renderStates);
-			Renderer::SetShader(s_shader);
-			Renderer::SetVertexBuffer(&s_vertexBuffer);
+	void DebugDrawer::DrawTangents(const StaticMesh* subMesh)
+	{
+		AddMeshLines(subMesh, [] (const MeshVertex& vertex) { return vertex.tangent; });
+	}
 
-			s_shader->SendColor(s_colorLocation, s_primaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_PointList, 0, pointCount);
-		}
+	void DebugDrawer::EnableDepthBuffer(bool depthBuffer)
+	{
+		GetThreadBuffer().depthBuffer = depthBuffer;
 	}
 
-	void DebugDrawer::DrawNormals(const StaticMesh* subMesh)
+	void DebugDrawer::Flush()
 	{
-		if (!s_initialized && !Initialize())
+		if (!Initialize())
 		{
 			NazaraError("Failed to initialize Debug Drawer");
 			return;
 		}
 
-		unsigned int normalCount = subMesh->GetVertexCount();
-		unsigned int vertexCount = normalCount*2;
-		if (s_vertexBuffer.GetVertexCount() < vertexCount)
-		{
-			NazaraError("Debug buffer not large enougth to draw object");
-			return;
-		}
-
-		BufferMapper<VertexBuffer> inputMapper(subMesh->GetVertexBuffer(), BufferAccess_ReadOnly);
-		BufferMapper<VertexBuffer> outputMapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, vertexCount);
+		LockGuard lock(s_mutex);
 
-		MeshVertex* inputVertex = static_cast<MeshVertex*>(inputMapper.GetPointer());
-		VertexStruct_XYZ* outputVertex = static_cast<VertexStruct_XYZ*>(outputMapper.GetPointer());
-
-		for (unsigned int i = 0; i < normalCount; ++i)
+		// Les primitives de tous les threads rejoignent celles conservées des frames précédentes
+		// Aucun thread ne doit dessiner pendant ce temps
+		for (auto& buffer : s_threadBuffers)
 		{
-			outputVertex->position = inputVertex->position;
-			outputVertex++;
-
-			outputVertex->position = inputVertex->position + inputVertex->normal*0.01f;
-			outputVertex++;
-
-			inputVertex++;
+			for (Group& group : buffer->groups)
+			{
+				if (group.lines.empty() && group.points.empty())
+					continue;
+
+				auto it = std::find_if(s_retainedGroups.begin(), s_retainedGroups.end(), [&group] (const Group& retainedGroup)
+				{
+					return retainedGroup.depthBuffer == group.depthBuffer && retainedGroup.remainingFrames == group.remainingFrames;
+				});
+
+				if (it == s_retainedGroups.end())
+				{
+					s_retainedGroups.emplace_back();
+					it = s_retainedGroups.end() - 1;
+					it->depthBuffer = group.depthBuffer;
+					it->remainingFrames = group.remainingFrames;
+				}
+
+				it->lines.insert(it->lines.end(), group.lines.begin(), group.lines.end());
+				it->points.insert(it->points.end(), group.points.begin(), group.points.end());
+
+				// On garde la mémoire pour la frame suivante
+				group.lines.clear();
+				group.points.clear();
+			}
 		}
 
-		inputMapper.Unmap();
-		outputMapper.Unmap();
-
-		if (vertexCount > 0)
+		// Un seul envoi pour toutes les primitives, puis un appel de dessin par type et par test de profondeur
+		struct Range
 		{
-			Renderer::SetRenderStates(s_renderStates);
-			Renderer::SetShader(s_shader);
-			Renderer::SetVertexBuffer(&s_vertexBuffer);
+			PrimitiveMode mode;
+			unsigned int first;
+			unsigned int count;
+			bool depthBuffer;
+		};
 
-			s_shader->SendColor(s_colorLocation, s_primaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, vertexCount);
-		}
-	}
+		Range ranges[4];
+		unsigned int rangeCount = 0;
 
-	void DebugDrawer::DrawTangents(const StaticMesh* subMesh)
-	{
-		if (!s_initialized && !Initialize())
+		s_vertices.clear();
+		for (bool depthBuffer : {true, false})
 		{
-			NazaraError("Failed to initialize Debug Drawer");
-			return;
-		}
+			for (PrimitiveMode mode : {PrimitiveMode_LineList, PrimitiveMode_PointList})
+			{
+				Range& range = ranges[rangeCount++];
+				range.depthBuffer = depthBuffer;
+				range.first = static_cast<unsigned int>(s_vertices.size());
+				range.mode = mode;
 
-		unsigned int tangentCount = subMesh->GetVertexCount();
-		unsigned int vertexCount = tangentCount*2;
-		if (s_vertexBuffer.GetVertexCount() < vertexCount)
-		{
-			NazaraError("Debug buffer not large enougth to draw object");
-			return;
-		}
+				for (const Group& group : s_retainedGroups)
+				{
+					if (group.depthBuffer != depthBuffer)
+						continue;
 
-		BufferMapper<VertexBuffer> inputMapper(subMesh->GetVertexBuffer(), BufferAccess_ReadOnly);
-		BufferMapper<VertexBuffer> outputMapper(s_vertexBuffer, BufferAccess_DiscardAndWrite, 0, vertexCount);
+					const auto& vertices = (mode == PrimitiveMode_LineList) ? group.lines : group.points;
+					s_vertices.insert(s_vertices.end(), vertices.begin(), vertices.end());
+				}
 
-		MeshVertex* inputVertex = static_cast<MeshVertex*>(inputMapper.GetPointer());
-		VertexStruct_XYZ* outputVertex = static_cast<VertexStruct_XYZ*>(outputMapper.GetPointer());
+				range.count = static_cast<unsigned int>(s_vertices.size()) - range.first;
+			}
+		}
 
-		for (unsigned int i = 0; i < tangentCount; ++i)
+		if (!s_vertices.empty())
 		{
-			outputVertex->position = inputVertex->position;
-			outputVertex++;
+			Renderer::SetMatrix(MatrixType_World, Matrix4f::Identity());
+			Renderer::SetShader(s_shader);
+			Renderer::SetVertexBuffer(&s_vertexBuffer);
 
-			outputVertex->position = inputVertex->position + inputVertex->tangent*0.01f;
-			outputVertex++;
+			unsigned int capacity = s_vertexBuffer.GetVertexCount();
+			unsigned int vertexCount = static_cast<unsigned int>(s_vertices.size());
+			unsigned int uploadedFirst = 0;
+			unsigned int uploadedCount = 0;
 
-			inputVertex++;
+			for (unsigned int i = 0; i < rangeCount; ++i)
+			{
+				const Range& range = ranges[i];
+				if (range.count == 0)
+					continue;
+
+				s_renderStates.depthBuffer = range.depthBuffer;
+				Renderer::SetRenderStates(s_renderStates);
+
+				// Au-delà de la capacité du buffer, les primitives sont envoyées par morceaux
+				unsigned int primitiveSize = (range.mode == PrimitiveMode_LineList) ? 2 : 1;
+				unsigned int first = range.first;
+				unsigned int count = range.count;
+				while (count > 0)
+				{
+					if (first < uploadedFirst || first + primitiveSize > uploadedFirst + uploadedCount)
+					{
+						uploadedFirst = first;
+						uploadedCount = std::min(vertexCount - first, capacity);
+
+						s_vertexBuffer.Fill(&s_vertices[first], 0, uploadedCount, true);
+					}
+
+					unsigned int drawCount = std::min(count, uploadedFirst + uploadedCount - first);
+					drawCount -= drawCount % primitiveSize;
+
+					Renderer::DrawPrimitives(range.mode, first - uploadedFirst, drawCount);
+
+					first += drawCount;
+					count -= drawCount;
+				}
+			}
 		}
 
-		inputMapper.Unmap();
-		outputMapper.Unmap();
-
-		if (vertexCount > 0)
+		// Les primitives persistantes restent pour les frames suivantes
+		auto it = std::remove_if(s_retainedGroups.begin(), s_retainedGroups.end(), [] (const Group& group)
 		{
-			Renderer::SetRenderStates(s_renderStates);
-			Renderer::SetShader(s_shader);
-			Renderer::SetVertexBuffer(&s_vertexBuffer);
+			return group.remainingFrames == 0;
+		});
+		s_retainedGroups.erase(it, s_retainedGroups.end());
 
-			s_shader->SendColor(s_colorLocation, s_primaryColor);
-			Renderer::DrawPrimitives(PrimitiveMode_LineList, 0, vertexCount);
-		}
+		for (Group& group : s_retainedGroups)
+			group.remainingFrames--;
 	}
 
-	void DebugDrawer::EnableDepthBuffer(bool depthBuffer)
+	float DebugDrawer::GetLineWidth()
 	{
-		s_renderStates.depthBuffer = depthBuffer;
+		return s_renderStates.lineWidth;
 	}
 
-	float DebugDrawer::GetLineWidth()
+	unsigned int DebugDrawer::GetPersistence()
 	{
-		return s_renderStates.lineWidth;
+		return GetThreadBuffer().persistence;
 	}
 
 	float DebugDrawer::GetPointSize()
@@ -667,12 +468,12 @@ namespace Nz
 
 	Color DebugDrawer::GetPrimaryColor()
 	{
-		return s_primaryColor;
+		return GetThreadBuffer().primaryColor;
 	}
 
 	Color DebugDrawer::GetSecondaryColor()
 	{
-		return s_secondaryColor;
+		return GetThreadBuffer().secondaryColor;
 	}
 
 	bool DebugDrawer::Initialize()
@@ -680,14 +481,13 @@ namespace Nz
 		if (!s_initialized)
 		{
 			// s_shader
-			s_shader = ShaderLibrary::Get("DebugSimple");
-			s_colorLocation = s_shader->GetUniformLocation("Color");
+			s_shader = ShaderLibrary::Get("DebugColor");
 
 			// s_vertexBuffer
 			try
 			{
 				ErrorFlags flags(ErrorFlag_ThrowException, true);
-				s_vertexBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ), 65365, DataStorage_Hardware, BufferUsage_Dynamic);
+				s_vertexBuffer.Reset(VertexDeclaration::Get(VertexLayout_XYZ_Color), 65536, DataStorage_Hardware, BufferUsage_Dynamic);
 			}
 			catch (const std::exception& e)
 			{
@@ -697,10 +497,6 @@ namespace Nz
 				return false;
 			}
 
-			s_primaryColor = Color::Red;
-			s_renderStates.depthBuffer = true;
-			s_secondaryColor = Color::Green;
-
 			s_initialized = true;
 		}
 
@@ -709,7 +505,7 @@ namespace Nz
 
 	bool DebugDrawer::IsDepthBufferEnabled()
 	{
-		return s_renderStates.depthBuffer;
+		return GetThreadBuffer().depthBuffer;
 	}
 
 	void DebugDrawer::SetLineWidth(float width)
@@ -717,6 +513,11 @@ namespace Nz
 		s_renderStates.lineWidth = width;
 	}
 
+	void DebugDrawer::SetPersistence(unsigned int frameCount)
+	{
+		GetThreadBuffer().persistence = frameCount;
+	}
+
 	void DebugDrawer::SetPointSize(float size)
 	{
 		s_renderStates.pointSize = size;
@@ -724,18 +525,26 @@ namespace Nz
 
 	void DebugDrawer::SetPrimaryColor(const Color& color)
 	{
-		s_primaryColor = color;
+		GetThreadBuffer().primaryColor = color;
 	}
 
 	void DebugDrawer::SetSecondaryColor(const Color& color)
 	{
-		s_secondaryColor = color;
+		GetThreadBuffer().secondaryColor = color;
 	}
 
 	void DebugDrawer::Uninitialize()
 	{
+		LockGuard lock(s_mutex);
+
 		s_shader = nullptr;
 		s_vertexBuffer.Reset();
 		s_initialized = false;
+
+		// Les tampons des threads sont recréés à leur prochain dessin
+		s_retainedGroups.clear();
+		s_threadBuffers.clear();
+		s_vertices.clear();
+		s_generation++;
 	}
 }
@@ -0,0 +1,249 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/GpuMemory.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <array>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct Allocation
+		{
+			GpuMemoryCategory category;
+			String name;
+			UInt64 size;
+		};
+
+		struct CategoryUsage
+		{
+			UInt64 size = 0;
+			std::size_t resourceCount = 0;
+		};
+
+		// Les ressources peuvent être créées par les contextes des threads d'envoi
+		Mutex s_mutex;
+		std::array<CategoryUsage, GpuMemoryCategory_Max + 1> s_categories;
+		std::unordered_map<const void*, Allocation> s_allocations;
+	}
+
+	/*!
+	* \brief Accounts the memory of a resource, replacing its previous size
+	*
+	* \param resource Resource owning the memory (a texture, a buffer, ...)
+	* \param category Kind of resource
+	* \param size Bytes of video memory taken by the resource
+	*/
+
+	void GpuMemory::Allocate(const void* resource, GpuMemoryCategory category, UInt64 size)
+	{
+		NazaraAssert(resource, "Invalid resource");
+
+		if (!Renderer::IsInitialized())
+			return;
+
+		LockGuard lock(s_mutex);
+
+		auto it = s_allocations.find(resource);
+		if (it == s_allocations.end())
+		{
+			Allocation allocation;
+			allocation.category = category;
+			allocation.size = 0;
+
+			it = s_allocations.emplace(resource, std::move(allocation)).first;
+			s_categories[category].resourceCount++;
+		}
+
+		Allocation& allocation = it->second;
+		NazaraAssert(allocation.category == category, "Resource category cannot change");
+
+		s_categories[category].size += size - allocation.size;
+		allocation.size = size;
+	}
+
+	/*!
+	* \brief Stops accounting the memory of a resource, with its debug name
+	*
+	* \param resource Resource which was accounted, nothing happens if it was not
+	*/
+
+	void GpuMemory::Free(const void* resource)
+	{
+		// Les ressources libérées par la libération du module (ou après) ne sont déjà plus comptées
+		if (!Renderer::IsInitialized())
+			return;
+
+		LockGuard lock(s_mutex);
+
+		auto it = s_allocations.find(resource);
+		if (it == s_allocations.end())
+			return;
+
+		CategoryUsage& categoryUsage = s_categories[it->second.category];
+		categoryUsage.resourceCount--;
+		categoryUsage.size -= it->second.size;
+
+		s_allocations.erase(it);
+	}
+
+	UInt64 GpuMemory::GetAllocatedSize()
+	{
+		LockGuard lock(s_mutex);
+
+		UInt64 size = 0;
+		for (const CategoryUsage& categoryUsage : s_categories)
+			size += categoryUsage.size;
+
+		return size;
+	}
+
+	UInt64 GpuMemory::GetAllocatedSize(GpuMemoryCategory category)
+	{
+		NazaraAssert(category <= GpuMemoryCategory_Max, "Category out of enum");
+
+		LockGuard lock(s_mutex);
+
+		return s_categories[category].size;
+	}
+
+	std::size_t GpuMemory::GetResourceCount(GpuMemoryCategory category)
+	{
+		NazaraAssert(category <= GpuMemoryCategory_Max, "Category out of enum");
+
+		LockGuard lock(s_mutex);
+
+		return s_categories[category].resourceCount;
+	}
+
+	/*!
+	* \brief Sums the memory of the resources sharing a category and a debug name
+	* \return Usage of each category and name, sorted by category then by name
+	*/
+
+	std::vector<GpuMemory::Usage> GpuMemory::GetUsageByName()
+	{
+		LockGuard lock(s_mutex);
+
+		std::map<std::tuple<GpuMemoryCategory, String>, CategoryUsage> usages;
+		for (const auto& pair : s_allocations)
+		{
+			const Allocation& allocation = pair.second;
+
+			CategoryUsage& usage = usages[std::make_tuple(allocation.category, allocation.name)];
+			usage.resourceCount++;
+			usage.size += allocation.size;
+		}
+
+		std::vector<Usage> result;
+		result.reserve(usages.size());
+
+		for (const auto& pair : usages)
+		{
+			Usage usage;
+			usage.category = std::get<0>(pair.first);
+			usage.name = std::get<1>(pair.first);
+			usage.resourceCount = pair.second.resourceCount;
+			usage.size = pair.second.size;
+
+			result.push_back(std::move(usage));
+		}
+
+		return result;
+	}
+
+	/*!
+	* \brief Queries the video memory reported by the driver
+	* \return true If the driver supports GL_NVX_gpu_memory_info or GL_ATI_meminfo
+	*
+	* \param memory Reported memory, unknown values are set to zero
+	*
+	* \remark Produces a NazaraError if there is no active context
+	*/
+
+	bool GpuMemory::QueryDriverMemory(DriverMemory* memory)
+	{
+		NazaraAssert(memory, "Invalid memory");
+
+		if (Context::GetCurrent() == nullptr)
+		{
+			NazaraError("No active context");
+			return false;
+		}
+
+		// Les deux extensions comptent en kilo-octets
+		if (OpenGL::IsSupported(OpenGLExtension_GpuMemoryInfo_NVX))
+		{
+			GLint available, evicted, evictionCount, total;
+			glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+			glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &total);
+			glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX, &evicted);
+			glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &evictionCount);
+
+			memory->availableSize = static_cast<UInt64>(available) * 1024;
+			memory->evictedSize = static_cast<UInt64>(evicted) * 1024;
+			memory->evictionCount = static_cast<unsigned int>(evictionCount);
+			memory->totalSize = static_cast<UInt64>(total) * 1024;
+
+			return true;
+		}
+		else if (OpenGL::IsSupported(OpenGLExtension_GpuMemoryInfo_ATI))
+		{
+			// Mémoire libre totale, plus grand bloc libre, puis la même chose pour la mémoire auxiliaire
+			GLint textureFree[4];
+			glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, textureFree);
+
+			memory->availableSize = static_cast<UInt64>(textureFree[0]) * 1024;
+			memory->evictedSize = 0;
+			memory->evictionCount = 0;
+			memory->totalSize = 0;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	/*!
+	* \brief Names an accounted resource, its memory is then reported under this name by GetUsageByName
+	*
+	* \param resource Resource which is accounted
+	* \param name Debug name, kept until the resource is freed
+	*
+	* \remark Produces a NazaraError if the resource is not accounted
+	*/
+
+	void GpuMemory::SetDebugName(const void* resource, const String& name)
+	{
+		LockGuard lock(s_mutex);
+
+		auto it = s_allocations.find(resource);
+		if (it == s_allocations.end())
+		{
+			NazaraError("Resource memory is not accounted");
+			return;
+		}
+
+		it->second.name = name;
+	}
+
+	void GpuMemory::Uninitialize()
+	{
+		// Les ressources encore en vie ne sont plus comptées, leur libération n'aura pas d'effet
+		LockGuard lock(s_mutex);
+
+		s_allocations.clear();
+		s_categories.fill(CategoryUsage());
+	}
+}
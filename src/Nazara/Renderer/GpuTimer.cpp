@@ -0,0 +1,235 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/GpuTimer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/OpenGL.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Les résultats sont lus avec ce nombre de frames de retard au plus, le GPU a ainsi le temps de les produire
+		const unsigned int s_frameCount = 4;
+
+		struct PendingScope
+		{
+			const char* name;
+			unsigned int beginQuery;
+			unsigned int endQuery;
+			unsigned int depth;
+		};
+
+		struct Frame
+		{
+			std::vector<GLuint> queries;
+			std::vector<PendingScope> scopes;
+			unsigned int queryCount = 0;
+			bool pending = false;
+		};
+
+		std::array<Frame, s_frameCount> s_frames;
+		std::vector<GpuTimer::Timing> s_timings;
+		std::vector<std::size_t> s_scopeStack;
+		unsigned int s_currentFrame = 0;
+		bool s_enabled = false;
+
+		GLuint AcquireQuery(Frame& frame)
+		{
+			if (frame.queryCount == frame.queries.size())
+			{
+				// On double la réserve de requêtes de la frame, elle est conservée pour les frames suivantes
+				std::size_t oldSize = frame.queries.size();
+				frame.queries.resize(std::max<std::size_t>(oldSize * 2, 16));
+				glGenQueries(static_cast<GLsizei>(frame.queries.size() - oldSize), &frame.queries[oldSize]);
+			}
+
+			return frame.queries[frame.queryCount++];
+		}
+
+		bool ResolveFrame(Frame& frame)
+		{
+			if (frame.queryCount > 0)
+			{
+				// Les requêtes se terminent dans l'ordre, la dernière suffit à savoir si la frame est prête
+				GLuint available = GL_FALSE;
+				glGetQueryObjectuiv(frame.queries[frame.queryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+				if (available == GL_FALSE)
+					return false;
+			}
+
+			s_timings.clear();
+			for (const PendingScope& scope : frame.scopes)
+			{
+				GLuint64 begin, end;
+				glGetQueryObjectui64v(frame.queries[scope.beginQuery], GL_QUERY_RESULT, &begin);
+				glGetQueryObjectui64v(frame.queries[scope.endQuery], GL_QUERY_RESULT, &end);
+
+				GpuTimer::Timing timing;
+				timing.name = scope.name;
+				timing.duration = (end > begin) ? end - begin : 0;
+				timing.depth = scope.depth;
+
+				s_timings.push_back(timing);
+			}
+
+			return true;
+		}
+
+		void ResetFrame(Frame& frame)
+		{
+			frame.scopes.clear();
+			frame.queryCount = 0;
+			frame.pending = false;
+		}
+	}
+
+	void GpuTimer::Begin(const char* name)
+	{
+		if (!s_enabled)
+			return;
+
+		#ifdef NAZARA_DEBUG
+		if (Context::GetCurrent() == nullptr)
+		{
+			NazaraError("No active context");
+			return;
+		}
+		#endif
+
+		Frame& frame = s_frames[s_currentFrame];
+
+		PendingScope scope;
+		scope.name = name;
+		scope.beginQuery = frame.queryCount;
+		scope.endQuery = scope.beginQuery;
+		scope.depth = static_cast<unsigned int>(s_scopeStack.size());
+
+		glQueryCounter(AcquireQuery(frame), GL_TIMESTAMP);
+
+		s_scopeStack.push_back(frame.scopes.size());
+		frame.scopes.push_back(scope);
+	}
+
+	void GpuTimer::Enable(bool enable)
+	{
+		s_enabled = enable;
+	}
+
+	void GpuTimer::End()
+	{
+		// Le minuteur a pu être activé au milieu d'une portée
+		if (s_scopeStack.empty())
+			return;
+
+		#ifdef NAZARA_DEBUG
+		if (Context::GetCurrent() == nullptr)
+		{
+			NazaraError("No active context");
+			return;
+		}
+		#endif
+
+		Frame& frame = s_frames[s_currentFrame];
+
+		frame.scopes[s_scopeStack.back()].endQuery = frame.queryCount;
+		glQueryCounter(AcquireQuery(frame), GL_TIMESTAMP);
+
+		s_scopeStack.pop_back();
+	}
+
+	UInt64 GpuTimer::GetFrameDuration()
+	{
+		UInt64 duration = 0;
+		for (const Timing& timing : s_timings)
+		{
+			if (timing.depth == 0)
+				duration += timing.duration;
+		}
+
+		return duration;
+	}
+
+	unsigned int GpuTimer::GetLatency()
+	{
+		return s_frameCount - 1;
+	}
+
+	UInt64 GpuTimer::GetTiming(const char* name)
+	{
+		UInt64 duration = 0;
+		for (const Timing& timing : s_timings)
+		{
+			if (timing.name == name || std::strcmp(timing.name, name) == 0)
+				duration += timing.duration;
+		}
+
+		return duration;
+	}
+
+	const std::vector<GpuTimer::Timing>& GpuTimer::GetTimings()
+	{
+		return s_timings;
+	}
+
+	bool GpuTimer::IsEnabled()
+	{
+		return s_enabled;
+	}
+
+	void GpuTimer::NextFrame()
+	{
+		if (!s_scopeStack.empty())
+		{
+			NazaraWarning(String::Number(s_scopeStack.size()) + " GPU timer scope(s) still open at end of frame");
+
+			while (!s_scopeStack.empty())
+				End();
+		}
+
+		Frame& current = s_frames[s_currentFrame];
+		if (current.queryCount > 0)
+		{
+			current.pending = true;
+			s_currentFrame = (s_currentFrame + 1) % s_frameCount;
+		}
+
+		// On lit les frames de la plus ancienne à la plus récente, sans jamais attendre le GPU
+		for (unsigned int i = 0; i < s_frameCount; ++i)
+		{
+			Frame& frame = s_frames[(s_currentFrame + i) % s_frameCount];
+			if (!frame.pending)
+				continue;
+
+			if (!ResolveFrame(frame))
+				break;
+
+			ResetFrame(frame);
+		}
+
+		// Si le GPU a trop de retard, les résultats de la frame réutilisée sont abandonnés plutôt que d'attendre
+		ResetFrame(s_frames[s_currentFrame]);
+	}
+
+	void GpuTimer::Uninitialize()
+	{
+		for (Frame& frame : s_frames)
+		{
+			if (!frame.queries.empty())
+				glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+
+			frame.queries.clear();
+			ResetFrame(frame);
+		}
+
+		s_scopeStack.clear();
+		s_timings.clear();
+		s_currentFrame = 0;
+	}
+}
@@ -6,16 +6,38 @@
 #include <Nazara/Core/Clock.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/GpuMemory.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
 #include <cstring>
 #include <stdexcept>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Majorant de GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, les régions peuvent ainsi être liées à un point de liaison d'uniform buffer
+		const unsigned int s_regionAlignment = 256;
+
+		const GpuMemoryCategory s_memoryCategories[] = {
+			GpuMemoryCategory_IndexBuffer,   // BufferType_Index
+			GpuMemoryCategory_UniformBuffer, // BufferType_Uniform
+			GpuMemoryCategory_VertexBuffer   // BufferType_Vertex
+		};
+
+		static_assert(sizeof(s_memoryCategories)/sizeof(GpuMemoryCategory) == BufferType_Max+1, "Buffer type array is incomplete");
+	}
+
 	HardwareBuffer::HardwareBuffer(Buffer* parent, BufferType type) :
 	m_type(type),
-	m_parent(parent)
+	m_parent(parent),
+	m_persistentPtr(nullptr),
+	m_region(0),
+	m_regionCount(NAZARA_RENDERER_BUFFER_REGION_COUNT),
+	m_regionSize(0),
+	m_regionStride(0),
+	m_directMapping(false)
 	{
 	}
 
@@ -30,7 +52,36 @@ namespace Nz
 
 		OpenGL::BindBuffer(m_type, m_buffer);
 
-		glBufferData(OpenGL::BufferTarget[m_type], size, nullptr, OpenGL::BufferUsage[usage]);
+		m_persistentPtr = nullptr;
+		m_region = 0;
+		m_regionSize = size;
+		m_regionStride = size;
+
+		// Un buffer dynamique est réparti en plusieurs régions d'un même stockage mappé en permanence,
+		// chaque réécriture complète passe à une région que le GPU n'utilise plus au lieu d'attendre ou de réallouer
+		if (usage == BufferUsage_Dynamic && OpenGL::IsSupported(OpenGLExtension_BufferStorage))
+		{
+			m_regionStride = ((size + s_regionAlignment - 1) / s_regionAlignment) * s_regionAlignment;
+
+			GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(OpenGL::BufferTarget[m_type], m_regionStride * m_regionCount, nullptr, mapFlags | GL_DYNAMIC_STORAGE_BIT);
+
+			m_persistentPtr = static_cast<UInt8*>(glMapBufferRange(OpenGL::BufferTarget[m_type], 0, m_regionStride * m_regionCount, mapFlags));
+			if (!m_persistentPtr)
+			{
+				NazaraError("Failed to map persistent buffer (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+
+				OpenGL::DeleteBuffer(m_type, m_buffer);
+				return false;
+			}
+
+			m_fences.assign(m_regionCount, nullptr);
+		}
+		else
+			glBufferData(OpenGL::BufferTarget[m_type], size, nullptr, OpenGL::BufferUsage[usage]);
+
+		// Les régions d'un buffer dynamique occupent toutes la mémoire vidéo
+		GpuMemory::Allocate(this, s_memoryCategories[m_type], static_cast<UInt64>(m_regionStride) * ((m_persistentPtr) ? m_regionCount : 1));
 
 		return true;
 	}
@@ -39,7 +90,19 @@ namespace Nz
 	{
 		Context::EnsureContext();
 
+		for (GLsync fence : m_fences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+		}
+		m_fences.clear();
+
+		// La suppression du buffer le démappe
+		m_persistentPtr = nullptr;
+
 		OpenGL::DeleteBuffer(m_type, m_buffer);
+
+		GpuMemory::Free(this);
 	}
 
 	bool HardwareBuffer::Fill(const void* data, unsigned int offset, unsigned int size, bool forceDiscard)
@@ -51,6 +114,23 @@ namespace Nz
 		if (!forceDiscard)
 			forceDiscard = (size == totalSize);
 
+		if (m_persistentPtr)
+		{
+			Renderer::CountBufferUpload(size);
+
+			if (forceDiscard && NextRegion())
+			{
+				std::memcpy(m_persistentPtr + GetRegionOffset() + offset, data, size);
+				return true;
+			}
+
+			// La région courante peut encore être lue par le GPU, glBufferSubData est synchronisé par le pilote
+			OpenGL::BindBuffer(m_type, m_buffer);
+			glBufferSubData(OpenGL::BufferTarget[m_type], GetRegionOffset() + offset, size, data);
+
+			return true;
+		}
+
 		OpenGL::BindBuffer(m_type, m_buffer);
 
 		// Il semblerait que glBuffer(Sub)Data soit plus performant que glMapBuffer(Range) en dessous d'un certain seuil
@@ -62,6 +142,8 @@ namespace Nz
 				glBufferData(OpenGL::BufferTarget[m_type], totalSize, nullptr, OpenGL::BufferUsage[m_parent->GetUsage()]); // Discard
 
 			glBufferSubData(OpenGL::BufferTarget[m_type], offset, size, data);
+
+			Renderer::CountBufferUpload(size);
 		}
 		else
 		{
@@ -89,6 +171,31 @@ namespace Nz
 	{
 		Context::EnsureContext();
 
+		// Bigger fills go through here too
+		if (access != BufferAccess_ReadOnly)
+			Renderer::CountBufferUpload(size);
+
+		if (m_persistentPtr)
+		{
+			m_directMapping = (access == BufferAccess_DiscardAndWrite && NextRegion());
+			if (m_directMapping)
+				return m_persistentPtr + GetRegionOffset() + offset;
+
+			// Sans région libre, on écrit dans une copie locale envoyée lors du démappage
+			m_mappingAccess = access;
+			m_mappingBuffer.resize(size);
+			m_mappingOffset = offset;
+			m_mappingSize = size;
+
+			if (access == BufferAccess_ReadOnly || access == BufferAccess_ReadWrite)
+			{
+				OpenGL::BindBuffer(m_type, m_buffer);
+				glGetBufferSubData(OpenGL::BufferTarget[m_type], GetRegionOffset() + offset, size, m_mappingBuffer.data());
+			}
+
+			return m_mappingBuffer.data();
+		}
+
 		OpenGL::BindBuffer(m_type, m_buffer);
 
 		if (glMapBufferRange)
@@ -111,6 +218,18 @@ namespace Nz
 	{
 		Context::EnsureContext();
 
+		if (m_persistentPtr)
+		{
+			// Le mapping étant cohérent, les écritures directes sont déjà visibles du GPU
+			if (!m_directMapping && m_mappingAccess != BufferAccess_ReadOnly)
+			{
+				OpenGL::BindBuffer(m_type, m_buffer);
+				glBufferSubData(OpenGL::BufferTarget[m_type], GetRegionOffset() + m_mappingOffset, m_mappingSize, m_mappingBuffer.data());
+			}
+
+			return true;
+		}
+
 		OpenGL::BindBuffer(m_type, m_buffer);
 
 		if (glUnmapBuffer(OpenGL::BufferTarget[m_type]) != GL_TRUE)
@@ -133,5 +252,73 @@ namespace Nz
 	unsigned int HardwareBuffer::GetOpenGLID() const
 	{
 		return m_buffer;
-}
+	}
+
+	UInt8* HardwareBuffer::GetPersistentPointer() const
+	{
+		return m_persistentPtr;
+	}
+
+	unsigned int HardwareBuffer::GetRegionCount() const
+	{
+		return (m_persistentPtr) ? m_regionCount : 1;
+	}
+
+	unsigned int HardwareBuffer::GetRegionOffset() const
+	{
+		return m_region * m_regionStride;
+	}
+
+	bool HardwareBuffer::IsPersistent() const
+	{
+		return m_persistentPtr != nullptr;
+	}
+
+	bool HardwareBuffer::SetRegionCount(unsigned int regionCount)
+	{
+		NazaraAssert(regionCount > 0, "Region count must be over zero");
+
+		if (m_regionCount == regionCount)
+			return true;
+
+		m_regionCount = regionCount;
+
+		// Le stockage d'un buffer persistant est immuable, il faut le recréer (son contenu est perdu)
+		if (!m_persistentPtr)
+			return true;
+
+		Destroy();
+		return Create(m_regionSize, BufferUsage_Dynamic);
+	}
+
+	bool HardwareBuffer::NextRegion()
+	{
+		unsigned int nextRegion = (m_region + 1) % m_regionCount;
+
+		// On ne bloque jamais : si le GPU lit encore la région suivante, l'appelant se rabat sur une copie synchronisée par le pilote
+		GLsync& nextFence = m_fences[nextRegion];
+		if (nextFence)
+		{
+			GLenum result = glClientWaitSync(nextFence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED)
+				return false;
+
+			if (result == GL_WAIT_FAILED)
+			{
+				NazaraError("Failed to check buffer region fence (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+				return false;
+			}
+
+			glDeleteSync(nextFence);
+			nextFence = nullptr;
+		}
+
+		// Les commandes déjà envoyées utilisent la région courante, elle sera libre une fois celles-ci exécutées
+		m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_region = nextRegion;
+
+		Renderer::OnBufferRegionChange(m_parent);
+
+		return true;
+	}
 }
@@ -10,6 +10,7 @@
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Utility/AbstractBuffer.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -33,10 +34,30 @@ namespace Nz
 			void Bind() const;
 			unsigned int GetOpenGLID() const;
 
+			// Buffers dynamiques mappés de façon persistante (ARB_buffer_storage)
+			UInt8* GetPersistentPointer() const;
+			unsigned int GetRegionCount() const;
+			unsigned int GetRegionOffset() const;
+			bool IsPersistent() const;
+			bool SetRegionCount(unsigned int regionCount);
+
 		private:
+			bool NextRegion();
+
+			std::vector<GLsync> m_fences;
+			std::vector<UInt8> m_mappingBuffer;
+			BufferAccess m_mappingAccess;
 			GLuint m_buffer;
 			BufferType m_type;
 			Buffer* m_parent;
+			UInt8* m_persistentPtr;
+			unsigned int m_mappingOffset;
+			unsigned int m_mappingSize;
+			unsigned int m_region;
+			unsigned int m_regionCount;
+			unsigned int m_regionSize;
+			unsigned int m_regionStride;
+			bool m_directMapping;
 	};
 }
 
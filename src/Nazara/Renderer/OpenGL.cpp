@@ -3,11 +3,15 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/RenderTarget.hpp>
 #if defined(NAZARA_PLATFORM_GLX)
 #include <Nazara/Utility/X11/Display.hpp>
@@ -81,6 +85,9 @@ namespace Nz
 			GLuint currentProgram = 0;
 			GLuint samplers[32] = {0}; // 32 est pour l'instant la plus haute limite (GL_TEXTURE31)
 			GLuint texturesBinding[32] = {0}; // 32 est pour l'instant la plus haute limite (GL_TEXTURE31)
+			GLuint uniformBuffersBinding[36] = {0}; // 36 est le minimum garanti par OpenGL 3.3 (GL_MAX_UNIFORM_BUFFER_BINDINGS)
+			unsigned int uniformBuffersOffset[36] = {0};
+			GLuint vertexArray = 0;
 			Recti currentScissorBox = Recti(0, 0, 0, 0);
 			Recti currentViewport = Recti(0, 0, 0, 0);
 			RenderStates renderStates; // Toujours synchronisé avec OpenGL
@@ -91,7 +98,8 @@ namespace Nz
 		};
 
 		std::set<String> s_openGLextensionSet;
-		std::unordered_map<const Context*, ContextStates> s_contexts;
+		std::unordered_map<const Context*, ContextStates> s_contexts; // Protégé par s_contextsMutex, des contextes partagés vivent sur d'autres threads
+		Mutex s_contextsMutex;
 		thread_local ContextStates* s_contextStates = nullptr;
 		String s_rendererName;
 		String s_vendorName;
@@ -328,11 +336,17 @@ namespace Nz
 		}
 		#endif
 
+		// Le binding de l'index buffer fait partie de l'état du VAO, on ne touche donc qu'à celui du VAO par défaut
+		if (type == BufferType_Index && s_contextStates->vertexArray != 0)
+			BindVertexArray(0);
+
 		if (s_contextStates->buffersBinding[type] != id)
 		{
 			glBindBuffer(BufferTarget[type], id);
 			s_contextStates->buffersBinding[type] = id;
 		}
+		else
+			Renderer::CountRedundantCall();
 	}
 
 	void OpenGL::BindProgram(GLuint id)
@@ -350,6 +364,8 @@ namespace Nz
 			glUseProgram(id);
 			s_contextStates->currentProgram = id;
 		}
+		else
+			Renderer::CountRedundantCall();
 	}
 
 	void OpenGL::BindSampler(GLuint unit, GLuint id)
@@ -373,6 +389,8 @@ namespace Nz
 			glBindSampler(unit, id);
 			s_contextStates->samplers[unit] = id;
 		}
+		else
+			Renderer::CountRedundantCall();
 	}
 
 	void OpenGL::BindScissorBox(const Recti& scissorBox)
@@ -429,6 +447,8 @@ namespace Nz
 			glBindTexture(TextureTarget[type], id);
 			s_contextStates->texturesBinding[s_contextStates->textureUnit] = id;
 		}
+		else
+			Renderer::CountRedundantCall();
 	}
 
 	void OpenGL::BindTexture(unsigned int textureUnit, ImageType type, GLuint id)
@@ -448,6 +468,8 @@ namespace Nz
 			glBindTexture(TextureTarget[type], id);
 			s_contextStates->texturesBinding[textureUnit] = id;
 		}
+		else
+			Renderer::CountRedundantCall();
 	}
 
 	void OpenGL::BindTextureUnit(unsigned int textureUnit)
@@ -467,6 +489,61 @@ namespace Nz
 		}
 	}
 
+	void OpenGL::BindUniformBuffer(unsigned int bindingPoint, GLuint id, unsigned int offset, unsigned int size)
+	{
+		#ifdef NAZARA_DEBUG
+		if (!s_contextStates)
+		{
+			NazaraError("No context activated");
+			return;
+		}
+		#endif
+
+		#if NAZARA_RENDERER_SAFE
+		if (bindingPoint >= CountOf(s_contextStates->uniformBuffersBinding))
+		{
+			NazaraError("Uniform buffer binding point out of range (" + String::Number(bindingPoint) + " >= " + String::Number(CountOf(s_contextStates->uniformBuffersBinding)) + ')');
+			return;
+		}
+		#endif
+
+		if (s_contextStates->uniformBuffersBinding[bindingPoint] != id || s_contextStates->uniformBuffersOffset[bindingPoint] != offset)
+		{
+			// Une taille nulle lie le buffer entier
+			if (size > 0)
+				glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, id, offset, size);
+			else
+				glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, id);
+
+			s_contextStates->uniformBuffersBinding[bindingPoint] = id;
+			s_contextStates->uniformBuffersOffset[bindingPoint] = offset;
+
+			// glBindBufferBase modifie également le point de liaison générique
+			s_contextStates->buffersBinding[BufferType_Uniform] = id;
+		}
+		else
+			Renderer::CountRedundantCall();
+	}
+
+	void OpenGL::BindVertexArray(GLuint id)
+	{
+		#ifdef NAZARA_DEBUG
+		if (!s_contextStates)
+		{
+			NazaraError("No context activated");
+			return;
+		}
+		#endif
+
+		if (s_contextStates->vertexArray != id)
+		{
+			glBindVertexArray(id);
+			s_contextStates->vertexArray = id;
+		}
+		else
+			Renderer::CountRedundantCall();
+	}
+
 	void OpenGL::BindViewport(const Recti& viewport)
 	{
 		#ifdef NAZARA_DEBUG
@@ -519,6 +596,15 @@ namespace Nz
 		glDeleteBuffers(1, &id);
 		if (s_contextStates->buffersBinding[type] == id)
 			s_contextStates->buffersBinding[type] = 0;
+
+		if (type == BufferType_Uniform)
+		{
+			for (GLuint& binding : s_contextStates->uniformBuffersBinding)
+			{
+				if (binding == id)
+					binding = 0;
+			}
+		}
 	}
 
 	void OpenGL::DeleteFrameBuffer(const Context* context, GLuint id)
@@ -527,7 +613,10 @@ namespace Nz
 		if (Context::GetCurrent() == context)
 			glDeleteFramebuffers(1, &id);
 		else
+		{
+			LockGuard lock(s_contextsMutex);
 			s_contexts[context].garbage.emplace_back(GarbageResourceType_FrameBuffer, id);
+		}
 	}
 
 	void OpenGL::DeleteProgram(GLuint id)
@@ -593,9 +682,17 @@ namespace Nz
 	{
 		// Si le contexte est actif, ne nous privons pas
 		if (Context::GetCurrent() == context)
-			glDeleteFramebuffers(1, &id);
+		{
+			glDeleteVertexArrays(1, &id);
+
+			if (s_contextStates->vertexArray == id)
+				s_contextStates->vertexArray = 0;
+		}
 		else
+		{
+			LockGuard lock(s_contextsMutex);
 			s_contexts[context].garbage.emplace_back(GarbageResourceType_VertexArray, id);
+		}
 	}
 
 	GLuint OpenGL::GetCurrentBuffer(BufferType type)
@@ -886,6 +983,8 @@ namespace Nz
 			glBeginQuery = reinterpret_cast<PFNGLBEGINQUERYPROC>(LoadEntry("glBeginQuery"));
 			glBindAttribLocation = reinterpret_cast<PFNGLBINDATTRIBLOCATIONPROC>(LoadEntry("glBindAttribLocation"));
 			glBindBuffer = reinterpret_cast<PFNGLBINDBUFFERPROC>(LoadEntry("glBindBuffer"));
+			glBindBufferBase = reinterpret_cast<PFNGLBINDBUFFERBASEPROC>(LoadEntry("glBindBufferBase"));
+			glBindBufferRange = reinterpret_cast<PFNGLBINDBUFFERRANGEPROC>(LoadEntry("glBindBufferRange"));
 			glBindFragDataLocation = reinterpret_cast<PFNGLBINDFRAGDATALOCATIONPROC>(LoadEntry("glBindFragDataLocation"));
 			glBindFramebuffer = reinterpret_cast<PFNGLBINDFRAMEBUFFERPROC>(LoadEntry("glBindFramebuffer"));
 			glBindRenderbuffer = reinterpret_cast<PFNGLBINDRENDERBUFFERPROC>(LoadEntry("glBindRenderbuffer"));
@@ -901,6 +1000,7 @@ namespace Nz
 			glClearColor = reinterpret_cast<PFNGLCLEARCOLORPROC>(LoadEntry("glClearColor"));
 			glClearDepth = reinterpret_cast<PFNGLCLEARDEPTHPROC>(LoadEntry("glClearDepth"));
 			glClearStencil = reinterpret_cast<PFNGLCLEARSTENCILPROC>(LoadEntry("glClearStencil"));
+			glClientWaitSync = reinterpret_cast<PFNGLCLIENTWAITSYNCPROC>(LoadEntry("glClientWaitSync"));
 			glCheckFramebufferStatus = reinterpret_cast<PFNGLCHECKFRAMEBUFFERSTATUSPROC>(LoadEntry("glCheckFramebufferStatus"));
 			glCreateProgram = reinterpret_cast<PFNGLCREATEPROGRAMPROC>(LoadEntry("glCreateProgram"));
 			glCreateShader = reinterpret_cast<PFNGLCREATESHADERPROC>(LoadEntry("glCreateShader"));
@@ -918,6 +1018,7 @@ namespace Nz
 			glDeleteRenderbuffers = reinterpret_cast<PFNGLDELETERENDERBUFFERSPROC>(LoadEntry("glDeleteRenderbuffers"));
 			glDeleteSamplers = reinterpret_cast<PFNGLDELETESAMPLERSPROC>(LoadEntry("glDeleteSamplers"));
 			glDeleteShader = reinterpret_cast<PFNGLDELETESHADERPROC>(LoadEntry("glDeleteShader"));
+			glDeleteSync = reinterpret_cast<PFNGLDELETESYNCPROC>(LoadEntry("glDeleteSync"));
 			glDeleteTextures = reinterpret_cast<PFNGLDELETETEXTURESPROC>(LoadEntry("glDeleteTextures"));
 			glDeleteVertexArrays = reinterpret_cast<PFNGLDELETEVERTEXARRAYSPROC>(LoadEntry("glDeleteVertexArrays"));
 			glDepthFunc = reinterpret_cast<PFNGLDEPTHFUNCPROC>(LoadEntry("glDepthFunc"));
@@ -929,11 +1030,14 @@ namespace Nz
 			glDrawBuffer = reinterpret_cast<PFNGLDRAWBUFFERPROC>(LoadEntry("glDrawBuffer"));
 			glDrawBuffers = reinterpret_cast<PFNGLDRAWBUFFERSPROC>(LoadEntry("glDrawBuffers"));
 			glDrawElements = reinterpret_cast<PFNGLDRAWELEMENTSPROC>(LoadEntry("glDrawElements"));
+			glDrawElementsBaseVertex = reinterpret_cast<PFNGLDRAWELEMENTSBASEVERTEXPROC>(LoadEntry("glDrawElementsBaseVertex"));
 			glDrawElementsInstanced = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDPROC>(LoadEntry("glDrawElementsInstanced"));
+			glDrawElementsInstancedBaseVertex = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC>(LoadEntry("glDrawElementsInstancedBaseVertex"));
 			glEnable = reinterpret_cast<PFNGLENABLEPROC>(LoadEntry("glEnable"));
 			glEnableVertexAttribArray = reinterpret_cast<PFNGLENABLEVERTEXATTRIBARRAYPROC>(LoadEntry("glEnableVertexAttribArray"));
 			glEndConditionalRender = reinterpret_cast<PFNGLENDCONDITIONALRENDERPROC>(LoadEntry("glEndConditionalRender"));
 			glEndQuery = reinterpret_cast<PFNGLENDQUERYPROC>(LoadEntry("glEndQuery"));
+			glFenceSync = reinterpret_cast<PFNGLFENCESYNCPROC>(LoadEntry("glFenceSync"));
 			glFlush = reinterpret_cast<PFNGLFLUSHPROC>(LoadEntry("glFlush"));
 			glFramebufferRenderbuffer = reinterpret_cast<PFNGLFRAMEBUFFERRENDERBUFFERPROC>(LoadEntry("glFramebufferRenderbuffer"));
 			glFramebufferTexture = reinterpret_cast<PFNGLFRAMEBUFFERTEXTUREPROC>(LoadEntry("glFramebufferTexture"));
@@ -952,11 +1056,13 @@ namespace Nz
 			glGetActiveUniform = reinterpret_cast<PFNGLGETACTIVEUNIFORMPROC>(LoadEntry("glGetActiveUniform"));
 			glGetBooleanv = reinterpret_cast<PFNGLGETBOOLEANVPROC>(LoadEntry("glGetBooleanv"));
 			glGetBufferParameteriv = reinterpret_cast<PFNGLGETBUFFERPARAMETERIVPROC>(LoadEntry("glGetBufferParameteriv"));
+			glGetBufferSubData = reinterpret_cast<PFNGLGETBUFFERSUBDATAPROC>(LoadEntry("glGetBufferSubData"));
 			glGetError = reinterpret_cast<PFNGLGETERRORPROC>(LoadEntry("glGetError"));
 			glGetFloatv = reinterpret_cast<PFNGLGETFLOATVPROC>(LoadEntry("glGetFloatv"));
 			glGetIntegerv = reinterpret_cast<PFNGLGETINTEGERVPROC>(LoadEntry("glGetIntegerv"));
 			glGetQueryiv = reinterpret_cast<PFNGLGETQUERYIVPROC>(LoadEntry("glGetQueryiv"));
 			glGetQueryObjectiv = reinterpret_cast<PFNGLGETQUERYOBJECTIVPROC>(LoadEntry("glGetQueryObjectiv"));
+			glGetQueryObjectui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VPROC>(LoadEntry("glGetQueryObjectui64v"));
 			glGetQueryObjectuiv = reinterpret_cast<PFNGLGETQUERYOBJECTUIVPROC>(LoadEntry("glGetQueryObjectuiv"));
 			glGetProgramiv = reinterpret_cast<PFNGLGETPROGRAMIVPROC>(LoadEntry("glGetProgramiv"));
 			glGetProgramInfoLog = reinterpret_cast<PFNGLGETPROGRAMINFOLOGPROC>(LoadEntry("glGetProgramInfoLog"));
@@ -969,6 +1075,7 @@ namespace Nz
 			glGetTexLevelParameteriv = reinterpret_cast<PFNGLGETTEXLEVELPARAMETERIVPROC>(LoadEntry("glGetTexLevelParameteriv"));
 			glGetTexParameterfv = reinterpret_cast<PFNGLGETTEXPARAMETERFVPROC>(LoadEntry("glGetTexParameterfv"));
 			glGetTexParameteriv = reinterpret_cast<PFNGLGETTEXPARAMETERIVPROC>(LoadEntry("glGetTexParameteriv"));
+			glGetUniformBlockIndex = reinterpret_cast<PFNGLGETUNIFORMBLOCKINDEXPROC>(LoadEntry("glGetUniformBlockIndex"));
 			glGetUniformLocation = reinterpret_cast<PFNGLGETUNIFORMLOCATIONPROC>(LoadEntry("glGetUniformLocation"));
 			glIsEnabled = reinterpret_cast<PFNGLISENABLEDPROC>(LoadEntry("glIsEnabled"));
 			glLineWidth = reinterpret_cast<PFNGLLINEWIDTHPROC>(LoadEntry("glLineWidth"));
@@ -978,6 +1085,7 @@ namespace Nz
 			glPixelStorei = reinterpret_cast<PFNGLPIXELSTOREIPROC>(LoadEntry("glPixelStorei"));
 			glPointSize = reinterpret_cast<PFNGLPOINTSIZEPROC>(LoadEntry("glPointSize"));
 			glPolygonMode = reinterpret_cast<PFNGLPOLYGONMODEPROC>(LoadEntry("glPolygonMode"));
+			glQueryCounter = reinterpret_cast<PFNGLQUERYCOUNTERPROC>(LoadEntry("glQueryCounter"));
 			glReadPixels = reinterpret_cast<PFNGLREADPIXELSPROC>(LoadEntry("glReadPixels"));
 			glRenderbufferStorage = reinterpret_cast<PFNGLRENDERBUFFERSTORAGEPROC>(LoadEntry("glRenderbufferStorage"));
 			glSamplerParameterf = reinterpret_cast<PFNGLSAMPLERPARAMETERFPROC>(LoadEntry("glSamplerParameterf"));
@@ -1005,6 +1113,7 @@ namespace Nz
 			glUniform3iv = reinterpret_cast<PFNGLUNIFORM3IVPROC>(LoadEntry("glUniform3iv"));
 			glUniform4fv = reinterpret_cast<PFNGLUNIFORM4FVPROC>(LoadEntry("glUniform4fv"));
 			glUniform4iv = reinterpret_cast<PFNGLUNIFORM4IVPROC>(LoadEntry("glUniform4iv"));
+			glUniformBlockBinding = reinterpret_cast<PFNGLUNIFORMBLOCKBINDINGPROC>(LoadEntry("glUniformBlockBinding"));
 			glUniformMatrix4fv = reinterpret_cast<PFNGLUNIFORMMATRIX4FVPROC>(LoadEntry("glUniformMatrix4fv"));
 			glUnmapBuffer = reinterpret_cast<PFNGLUNMAPBUFFERPROC>(LoadEntry("glUnmapBuffer"));
 			glUseProgram = reinterpret_cast<PFNGLUSEPROGRAMPROC>(LoadEntry("glUseProgram"));
@@ -1066,6 +1175,38 @@ namespace Nz
 		// AnisotropicFilter
 		s_openGLextensions[OpenGLExtension_AnisotropicFilter] = IsSupported("GL_EXT_texture_filter_anisotropic");
 
+		// BindlessTexture
+		if (IsSupported("GL_ARB_bindless_texture"))
+		{
+			try
+			{
+				glGetTextureSamplerHandleARB = reinterpret_cast<PFNGLGETTEXTURESAMPLERHANDLEARBPROC>(LoadEntry("glGetTextureSamplerHandleARB"));
+				glMakeTextureHandleNonResidentARB = reinterpret_cast<PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC>(LoadEntry("glMakeTextureHandleNonResidentARB"));
+				glMakeTextureHandleResidentARB = reinterpret_cast<PFNGLMAKETEXTUREHANDLERESIDENTARBPROC>(LoadEntry("glMakeTextureHandleResidentARB"));
+
+				s_openGLextensions[OpenGLExtension_BindlessTexture] = true;
+			}
+			catch (const std::exception& e)
+			{
+				NazaraWarning("Failed to load ARB_bindless_texture: " + String(e.what()));
+			}
+		}
+
+		// BufferStorage
+		if (s_openglVersion >= 440 || IsSupported("GL_ARB_buffer_storage"))
+		{
+			try
+			{
+				glBufferStorage = reinterpret_cast<PFNGLBUFFERSTORAGEPROC>(LoadEntry("glBufferStorage"));
+
+				s_openGLextensions[OpenGLExtension_BufferStorage] = true;
+			}
+			catch (const std::exception& e)
+			{
+				NazaraWarning("Failed to load ARB_buffer_storage: " + String(e.what()));
+			}
+		}
+
 		// DebugOutput
 		if (s_openglVersion >= 430 || IsSupported("GL_KHR_debug"))
 		{
@@ -1137,6 +1278,39 @@ namespace Nz
 			}
 		}
 
+		// GpuMemoryInfo (de simples valeurs lues par glGetIntegerv, sans fonction à charger)
+		s_openGLextensions[OpenGLExtension_GpuMemoryInfo_ATI] = IsSupported("GL_ATI_meminfo");
+		s_openGLextensions[OpenGLExtension_GpuMemoryInfo_NVX] = IsSupported("GL_NVX_gpu_memory_info");
+
+		// MultiDrawIndirect (le champ baseInstance des commandes n'est respecté qu'avec ARB_base_instance)
+		if (s_openglVersion >= 430 || (IsSupported("GL_ARB_multi_draw_indirect") && IsSupported("GL_ARB_base_instance")))
+		{
+			try
+			{
+				glMultiDrawElementsIndirect = reinterpret_cast<PFNGLMULTIDRAWELEMENTSINDIRECTPROC>(LoadEntry("glMultiDrawElementsIndirect"));
+
+				s_openGLextensions[OpenGLExtension_MultiDrawIndirect] = true;
+			}
+			catch (const std::exception& e)
+			{
+				NazaraWarning("Failed to load ARB_multi_draw_indirect: " + String(e.what()));
+			}
+		}
+
+		// ParallelShaderCompile
+		if (IsSupported("GL_KHR_parallel_shader_compile") || IsSupported("GL_ARB_parallel_shader_compile"))
+		{
+			glMaxShaderCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(LoadEntry("glMaxShaderCompilerThreadsKHR", false));
+			if (!glMaxShaderCompilerThreads)
+				glMaxShaderCompilerThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(LoadEntry("glMaxShaderCompilerThreadsARB", false));
+
+			// On laisse le pilote choisir le nombre de threads de compilation
+			if (glMaxShaderCompilerThreads)
+				glMaxShaderCompilerThreads(0xFFFFFFFF);
+
+			s_openGLextensions[OpenGLExtension_ParallelShaderCompile] = true;
+		}
+
 		// SeparateShaderObjects
 		if (s_openglVersion >= 400 || IsSupported("GL_ARB_separate_shader_objects"))
 		{
@@ -1394,6 +1568,18 @@ namespace Nz
 				else
 					return false;
 
+			case PixelFormatType_BC5:
+				format->dataFormat = GL_RG;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RG_RGTC2;
+				return true;
+
+			case PixelFormatType_BC7:
+				format->dataFormat = GL_RGBA;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+				return true;
+
 			case PixelFormatType_BGR8:
 				format->dataFormat = GL_BGR;
 				format->dataType = GL_UNSIGNED_BYTE;
@@ -1424,6 +1610,12 @@ namespace Nz
 				format->internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
 				return true;
 
+			case PixelFormatType_ETC2:
+				format->dataFormat = GL_RGBA;
+				format->dataType = GL_UNSIGNED_BYTE;
+				format->internalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+				return true;
+
 			case PixelFormatType_L8:
 				if (type == FormatType_Texture) // Format supporté uniquement par les textures
 				{
@@ -1813,6 +2005,8 @@ namespace Nz
 
 	void OpenGL::OnContextChanged(const Context* newContext)
 	{
+		LockGuard lock(s_contextsMutex);
+
 		s_contextStates = (newContext) ? &s_contexts[newContext] : nullptr;
 		if (s_contextStates)
 		{
@@ -1827,6 +2021,8 @@ namespace Nz
 
 					case GarbageResourceType_VertexArray:
 						glDeleteVertexArrays(1, &pair.second);
+						if (s_contextStates->vertexArray == pair.second)
+							s_contextStates->vertexArray = 0;
 						break;
 				}
 			}
@@ -1840,6 +2036,7 @@ namespace Nz
 		** Il serait possible d'activer le contexte avant sa destruction afin de libérer les éventuelles ressources mortes-vivantes,
 		** mais un driver bien conçu va libérer ces ressources de lui-même.
 		*/
+		LockGuard lock(s_contextsMutex);
 		s_contexts.erase(context);
 	}
 
@@ -1893,18 +2090,20 @@ namespace Nz
 	GLenum OpenGL::BufferTarget[] =
 	{
 		GL_ELEMENT_ARRAY_BUFFER, // BufferType_Index,
+		GL_UNIFORM_BUFFER,       // BufferType_Uniform,
 		GL_ARRAY_BUFFER,		 // BufferType_Vertex
 	};
 
-	static_assert(BufferType_Max + 1 == 2, "Buffer target array is incomplete");
+	static_assert(BufferType_Max + 1 == 3, "Buffer target array is incomplete");
 
 	GLenum OpenGL::BufferTargetBinding[] =
 	{
 		GL_ELEMENT_ARRAY_BUFFER_BINDING, // BufferType_Index,
+		GL_UNIFORM_BUFFER_BINDING,       // BufferType_Uniform,
 		GL_ARRAY_BUFFER_BINDING,		 // BufferType_Vertex
 	};
 
-	static_assert(BufferType_Max + 1 == 2, "Buffer target binding array is incomplete");
+	static_assert(BufferType_Max + 1 == 3, "Buffer target binding array is incomplete");
 
 	GLenum OpenGL::BufferUsage[] =
 	{
@@ -1931,10 +2130,17 @@ namespace Nz
 		GL_INT,           // ComponentType_Int2
 		GL_INT,           // ComponentType_Int3
 		GL_INT,           // ComponentType_Int4
-		GL_FLOAT          // ComponentType_Quaternion
+		GL_FLOAT,         // ComponentType_Quaternion
+		GL_HALF_FLOAT,    // ComponentType_Half2
+		GL_HALF_FLOAT,    // ComponentType_Half4
+		GL_BYTE,          // ComponentType_NormalizedByte4
+		GL_SHORT,         // ComponentType_NormalizedShort2
+		GL_SHORT,         // ComponentType_NormalizedShort4
+		GL_UNSIGNED_SHORT, // ComponentType_NormalizedUShort2
+		GL_INT_2_10_10_10_REV // ComponentType_NormalizedInt2101010
 	};
 
-	static_assert(ComponentType_Max + 1 == 14, "Attribute type array is incomplete");
+	static_assert(ComponentType_Max + 1 == 21, "Attribute type array is incomplete");
 
 	GLenum OpenGL::CubemapFace[] =
 	{
@@ -2123,6 +2329,8 @@ PFNGLBEGINCONDITIONALRENDERPROC   glBeginConditionalRender   = nullptr;
 PFNGLBEGINQUERYPROC               glBeginQuery               = nullptr;
 PFNGLBINDATTRIBLOCATIONPROC       glBindAttribLocation       = nullptr;
 PFNGLBINDBUFFERPROC               glBindBuffer               = nullptr;
+PFNGLBINDBUFFERBASEPROC           glBindBufferBase           = nullptr;
+PFNGLBINDBUFFERRANGEPROC          glBindBufferRange          = nullptr;
 PFNGLBINDFRAMEBUFFERPROC          glBindFramebuffer          = nullptr;
 PFNGLBINDFRAGDATALOCATIONPROC     glBindFragDataLocation     = nullptr;
 PFNGLBINDRENDERBUFFERPROC         glBindRenderbuffer         = nullptr;
@@ -2133,11 +2341,13 @@ PFNGLBLENDFUNCPROC                glBlendFunc                = nullptr;
 PFNGLBLENDFUNCSEPARATEPROC        glBlendFuncSeparate        = nullptr;
 PFNGLBLITFRAMEBUFFERPROC          glBlitFramebuffer          = nullptr;
 PFNGLBUFFERDATAPROC               glBufferData               = nullptr;
+PFNGLBUFFERSTORAGEPROC            glBufferStorage            = nullptr;
 PFNGLBUFFERSUBDATAPROC            glBufferSubData            = nullptr;
 PFNGLCLEARPROC                    glClear                    = nullptr;
 PFNGLCLEARCOLORPROC               glClearColor               = nullptr;
 PFNGLCLEARDEPTHPROC               glClearDepth               = nullptr;
 PFNGLCLEARSTENCILPROC             glClearStencil             = nullptr;
+PFNGLCLIENTWAITSYNCPROC           glClientWaitSync           = nullptr;
 PFNGLCREATEPROGRAMPROC            glCreateProgram            = nullptr;
 PFNGLCREATESHADERPROC             glCreateShader             = nullptr;
 PFNGLCHECKFRAMEBUFFERSTATUSPROC   glCheckFramebufferStatus   = nullptr;
@@ -2158,6 +2368,7 @@ PFNGLDELETEQUERIESPROC            glDeleteQueries            = nullptr;
 PFNGLDELETERENDERBUFFERSPROC      glDeleteRenderbuffers      = nullptr;
 PFNGLDELETESAMPLERSPROC           glDeleteSamplers           = nullptr;
 PFNGLDELETESHADERPROC             glDeleteShader             = nullptr;
+PFNGLDELETESYNCPROC               glDeleteSync               = nullptr;
 PFNGLDELETETEXTURESPROC           glDeleteTextures           = nullptr;
 PFNGLDELETEVERTEXARRAYSPROC       glDeleteVertexArrays       = nullptr;
 PFNGLDEPTHFUNCPROC                glDepthFunc                = nullptr;
@@ -2169,12 +2380,15 @@ PFNGLDRAWARRAYSINSTANCEDPROC      glDrawArraysInstanced      = nullptr;
 PFNGLDRAWBUFFERPROC               glDrawBuffer               = nullptr;
 PFNGLDRAWBUFFERSPROC              glDrawBuffers              = nullptr;
 PFNGLDRAWELEMENTSPROC             glDrawElements             = nullptr;
+PFNGLDRAWELEMENTSBASEVERTEXPROC   glDrawElementsBaseVertex   = nullptr;
 PFNGLDRAWELEMENTSINSTANCEDPROC    glDrawElementsInstanced    = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC glDrawElementsInstancedBaseVertex = nullptr;
 PFNGLDRAWTEXTURENVPROC            glDrawTexture              = nullptr;
 PFNGLENABLEPROC                   glEnable                   = nullptr;
 PFNGLENABLEVERTEXATTRIBARRAYPROC  glEnableVertexAttribArray  = nullptr;
 PFNGLENDCONDITIONALRENDERPROC     glEndConditionalRender     = nullptr;
 PFNGLENDQUERYPROC                 glEndQuery                 = nullptr;
+PFNGLFENCESYNCPROC                glFenceSync                = nullptr;
 PFNGLFLUSHPROC                    glFlush                    = nullptr;
 PFNGLFRAMEBUFFERRENDERBUFFERPROC  glFramebufferRenderbuffer  = nullptr;
 PFNGLFRAMEBUFFERTEXTUREPROC       glFramebufferTexture       = nullptr;
@@ -2193,6 +2407,7 @@ PFNGLGENVERTEXARRAYSPROC          glGenVertexArrays          = nullptr;
 PFNGLGETACTIVEUNIFORMPROC         glGetActiveUniform         = nullptr;
 PFNGLGETBOOLEANVPROC              glGetBooleanv              = nullptr;
 PFNGLGETBUFFERPARAMETERIVPROC     glGetBufferParameteriv     = nullptr;
+PFNGLGETBUFFERSUBDATAPROC         glGetBufferSubData         = nullptr;
 PFNGLGETDEBUGMESSAGELOGPROC       glGetDebugMessageLog       = nullptr;
 PFNGLGETERRORPROC                 glGetError                 = nullptr;
 PFNGLGETFLOATVPROC                glGetFloatv                = nullptr;
@@ -2202,6 +2417,7 @@ PFNGLGETPROGRAMIVPROC             glGetProgramiv             = nullptr;
 PFNGLGETPROGRAMINFOLOGPROC        glGetProgramInfoLog        = nullptr;
 PFNGLGETQUERYIVPROC               glGetQueryiv               = nullptr;
 PFNGLGETQUERYOBJECTIVPROC         glGetQueryObjectiv         = nullptr;
+PFNGLGETQUERYOBJECTUI64VPROC      glGetQueryObjectui64v      = nullptr;
 PFNGLGETQUERYOBJECTUIVPROC        glGetQueryObjectuiv        = nullptr;
 PFNGLGETSHADERINFOLOGPROC         glGetShaderInfoLog         = nullptr;
 PFNGLGETSHADERIVPROC              glGetShaderiv              = nullptr;
@@ -2213,13 +2429,19 @@ PFNGLGETTEXLEVELPARAMETERFVPROC   glGetTexLevelParameterfv   = nullptr;
 PFNGLGETTEXLEVELPARAMETERIVPROC   glGetTexLevelParameteriv   = nullptr;
 PFNGLGETTEXPARAMETERFVPROC        glGetTexParameterfv        = nullptr;
 PFNGLGETTEXPARAMETERIVPROC        glGetTexParameteriv        = nullptr;
+PFNGLGETTEXTURESAMPLERHANDLEARBPROC glGetTextureSamplerHandleARB = nullptr;
+PFNGLGETUNIFORMBLOCKINDEXPROC     glGetUniformBlockIndex     = nullptr;
 PFNGLGETUNIFORMLOCATIONPROC       glGetUniformLocation       = nullptr;
 PFNGLINVALIDATEBUFFERDATAPROC     glInvalidateBufferData     = nullptr;
 PFNGLISENABLEDPROC                glIsEnabled                = nullptr;
 PFNGLLINEWIDTHPROC                glLineWidth                = nullptr;
 PFNGLLINKPROGRAMPROC              glLinkProgram              = nullptr;
+PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC glMakeTextureHandleNonResidentARB = nullptr;
+PFNGLMAKETEXTUREHANDLERESIDENTARBPROC glMakeTextureHandleResidentARB = nullptr;
 PFNGLMAPBUFFERPROC                glMapBuffer                = nullptr;
 PFNGLMAPBUFFERRANGEPROC           glMapBufferRange           = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC glMaxShaderCompilerThreads = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC glMultiDrawElementsIndirect = nullptr;
 PFNGLPIXELSTOREIPROC              glPixelStorei              = nullptr;
 PFNGLPOINTSIZEPROC                glPointSize                = nullptr;
 PFNGLPOLYGONMODEPROC              glPolygonMode              = nullptr;
@@ -2242,6 +2464,7 @@ PFNGLPROGRAMUNIFORM4FVPROC        glProgramUniform4fv        = nullptr;
 PFNGLPROGRAMUNIFORM4IVPROC        glProgramUniform4iv        = nullptr;
 PFNGLPROGRAMUNIFORMMATRIX4DVPROC  glProgramUniformMatrix4dv  = nullptr;
 PFNGLPROGRAMUNIFORMMATRIX4FVPROC  glProgramUniformMatrix4fv  = nullptr;
+PFNGLQUERYCOUNTERPROC             glQueryCounter             = nullptr;
 PFNGLREADPIXELSPROC               glReadPixels               = nullptr;
 PFNGLRENDERBUFFERSTORAGEPROC      glRenderbufferStorage      = nullptr;
 PFNGLSAMPLERPARAMETERFPROC        glSamplerParameterf        = nullptr;
@@ -2278,6 +2501,7 @@ PFNGLUNIFORM3IVPROC               glUniform3iv               = nullptr;
 PFNGLUNIFORM4DVPROC               glUniform4dv               = nullptr;
 PFNGLUNIFORM4FVPROC               glUniform4fv               = nullptr;
 PFNGLUNIFORM4IVPROC               glUniform4iv               = nullptr;
+PFNGLUNIFORMBLOCKBINDINGPROC      glUniformBlockBinding      = nullptr;
 PFNGLUNIFORMMATRIX4DVPROC         glUniformMatrix4dv         = nullptr;
 PFNGLUNIFORMMATRIX4FVPROC         glUniformMatrix4fv         = nullptr;
 PFNGLUNMAPBUFFERPROC              glUnmapBuffer              = nullptr;
@@ -5,6 +5,7 @@
 #include <Nazara/Renderer/RenderBuffer.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/GpuMemory.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <Nazara/Renderer/Debug.hpp>
@@ -71,6 +72,8 @@ namespace Nz
 		m_id = renderBuffer;
 		m_width = width;
 
+		GpuMemory::Allocate(this, GpuMemoryCategory_RenderBuffer, PixelFormat::ComputeSize(format, width, height, 1));
+
 		return true;
 	}
 
@@ -85,6 +88,8 @@ namespace Nz
 			GLuint renderBuffer = m_id;
 			glDeleteRenderbuffers(1, &renderBuffer); // Les Renderbuffers sont partagés entre les contextes: Ne posera pas de problème
 			m_id = 0;
+
+			GpuMemory::Free(this);
 		}
 	}
 
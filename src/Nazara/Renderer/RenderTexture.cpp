@@ -36,6 +36,9 @@ namespace Nz
 			unsigned int width;
 		};
 
+		// Valeur de z attachant toutes les couches de la texture (rendu en couches, par un geometry shader)
+		constexpr unsigned int s_allLayers = std::numeric_limits<unsigned int>::max();
+
 		unsigned int attachmentIndex[AttachmentPoint_Max+1] =
 		{
 			3, // AttachmentPoint_Color
@@ -191,6 +194,26 @@ namespace Nz
 		return true;
 	}
 
+	bool RenderTexture::AttachLayeredTexture(AttachmentPoint attachmentPoint, UInt8 index, Texture* texture)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!texture || !texture->IsValid())
+		{
+			NazaraError("Invalid texture");
+			return false;
+		}
+
+		ImageType type = texture->GetType();
+		if (type != ImageType_1D_Array && type != ImageType_2D_Array && type != ImageType_3D && type != ImageType_Cubemap)
+		{
+			NazaraError("Texture has no layer");
+			return false;
+		}
+		#endif
+
+		return AttachTexture(attachmentPoint, index, texture, s_allLayers);
+	}
+
 	bool RenderTexture::AttachTexture(AttachmentPoint attachmentPoint, UInt8 index, Texture* texture, unsigned int z)
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -238,7 +261,7 @@ namespace Nz
 		}
 
 		unsigned int depth = (texture->GetType() == ImageType_Cubemap) ? 6 : texture->GetDepth();
-		if (z >= depth)
+		if (z != s_allLayers && z >= depth)
 		{
 			NazaraError("Z value exceeds depth (" + String::Number(z) + " >= (" + String::Number(depth) + ')');
 			return false;
@@ -262,28 +285,33 @@ namespace Nz
 		// Détachement de l'attache précédente (Si il y a)
 		Detach(attachmentPoint, index);
 
-		switch (texture->GetType())
+		if (z == s_allLayers)
+			glFramebufferTexture(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, texture->GetOpenGLID(), 0);
+		else
 		{
-			case ImageType_1D:
-				glFramebufferTexture1D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_1D, texture->GetOpenGLID(), 0);
-				break;
+			switch (texture->GetType())
+			{
+				case ImageType_1D:
+					glFramebufferTexture1D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_1D, texture->GetOpenGLID(), 0);
+					break;
 
-			case ImageType_1D_Array:
-			case ImageType_2D_Array:
-				glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, texture->GetOpenGLID(), 0, z);
-				break;
+				case ImageType_1D_Array:
+				case ImageType_2D_Array:
+					glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, texture->GetOpenGLID(), 0, z);
+					break;
 
-			case ImageType_2D:
-				glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_2D, texture->GetOpenGLID(), 0);
-				break;
+				case ImageType_2D:
+					glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_2D, texture->GetOpenGLID(), 0);
+					break;
 
-			case ImageType_3D:
-				glFramebufferTexture3D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_3D, texture->GetOpenGLID(), 0, z);
-				break;
+				case ImageType_3D:
+					glFramebufferTexture3D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, GL_TEXTURE_3D, texture->GetOpenGLID(), 0, z);
+					break;
 
-			case ImageType_Cubemap:
-				glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, OpenGL::CubemapFace[z], texture->GetOpenGLID(), 0);
-				break;
+				case ImageType_Cubemap:
+					glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, OpenGL::Attachment[attachmentPoint]+index, OpenGL::CubemapFace[z], texture->GetOpenGLID(), 0);
+					break;
+			}
 		}
 
 		Unlock();
@@ -146,6 +146,8 @@ namespace Nz
 
 		if (m_context && m_parameters.doubleBuffered)
 			m_context->SwapBuffers();
+
+		Renderer::EndFrame();
 	}
 
 	void RenderWindow::EnableVerticalSync(bool enabled)
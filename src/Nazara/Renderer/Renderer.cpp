@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Color.hpp>
 #include <Nazara/Core/Error.hpp>
@@ -12,6 +13,8 @@
 #include <Nazara/Renderer/Config.hpp>
 #include <Nazara/Renderer/Context.hpp>
 #include <Nazara/Renderer/DebugDrawer.hpp>
+#include <Nazara/Renderer/GpuMemory.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
 #include <Nazara/Renderer/HardwareBuffer.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/RenderBuffer.hpp>
@@ -19,12 +22,13 @@
 #include <Nazara/Renderer/Shader.hpp>
 #include <Nazara/Renderer/Texture.hpp>
 #include <Nazara/Renderer/UberShader.hpp>
+#include <Nazara/Renderer/UploadWorker.hpp>
 #include <Nazara/Utility/AbstractBuffer.hpp>
+#include <Nazara/Utility/Buffer.hpp>
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/Utility.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
-#include <map>
 #include <memory>
 #include <set>
 #include <stdexcept>
@@ -33,12 +37,18 @@
 #include <vector>
 #include <Nazara/Renderer/Debug.hpp>
 
-///TODO: Manager les VAO (permettre plusieurs draw calls sans rebinder le VAO)
-
 namespace Nz
 {
 	namespace
 	{
+		const UInt8 r_colorFragmentShader[] = {
+			#include <Nazara/Renderer/Resources/Shaders/Debug/color.frag.h>
+		};
+
+		const UInt8 r_colorVertexShader[] = {
+			#include <Nazara/Renderer/Resources/Shaders/Debug/color.vert.h>
+		};
+
 		const UInt8 r_coreFragmentShader[] = {
 			#include <Nazara/Renderer/Resources/Shaders/Debug/core.frag.h>
 		};
@@ -82,15 +92,36 @@ namespace Nz
 		struct VAO_Entry
 		{
 			GLuint vao;
+			unsigned int firstInstance; // Instance pointée par les attributs d'instancing
+			unsigned int instanceRegionOffset; // Région des buffers persistants pointée par les attributs
+			unsigned int vertexRegionOffset;
 
 			NazaraSlot(IndexBuffer, OnIndexBufferRelease, onIndexBufferReleaseSlot);
+			NazaraSlot(VertexBuffer, OnVertexBufferRelease, onInstanceBufferReleaseSlot);
 			NazaraSlot(VertexBuffer, OnVertexBufferRelease, onVertexBufferReleaseSlot);
 			NazaraSlot(VertexDeclaration, OnVertexDeclarationRelease, onInstancingDeclarationReleaseSlot);
 			NazaraSlot(VertexDeclaration, OnVertexDeclarationRelease, onVertexDeclarationReleaseSlot);
 		};
 
-		using VAO_Key = std::tuple<const IndexBuffer*, const VertexBuffer*, const VertexDeclaration*, const VertexDeclaration*>;
-		using VAO_Map = std::map<VAO_Key, VAO_Entry>;
+		using VAO_Key = std::tuple<const IndexBuffer*, const VertexBuffer*, const VertexDeclaration*, const VertexDeclaration*, const VertexBuffer*>;
+
+		struct VAO_KeyHash
+		{
+			std::size_t operator()(const VAO_Key& key) const
+			{
+				std::size_t seed = 0;
+				HashCombine(seed, std::get<0>(key));
+				HashCombine(seed, std::get<1>(key));
+				HashCombine(seed, std::get<2>(key));
+				HashCombine(seed, std::get<3>(key));
+				HashCombine(seed, std::get<4>(key));
+
+				return seed;
+			}
+		};
+
+		// Les entrées gardent leur adresse (leurs slots y sont connectés), d'où une table à noeuds
+		using VAO_Map = std::unordered_map<VAO_Key, VAO_Entry, VAO_KeyHash>;
 
 		struct Context_Entry
 		{
@@ -101,28 +132,122 @@ namespace Nz
 
 		using Context_Map = std::unordered_map<const Context*, Context_Entry>;
 
+		unsigned int GetPrimitiveCount(PrimitiveMode mode, unsigned int vertexCount)
+		{
+			switch (mode)
+			{
+				case PrimitiveMode_LineList:
+					return vertexCount / 2;
+
+				case PrimitiveMode_LineStrip:
+					return (vertexCount > 1) ? vertexCount - 1 : 0;
+
+				case PrimitiveMode_PointList:
+					return vertexCount;
+
+				case PrimitiveMode_TriangleFan:
+				case PrimitiveMode_TriangleStrip:
+					return (vertexCount > 2) ? vertexCount - 2 : 0;
+
+				case PrimitiveMode_TriangleList:
+					return vertexCount / 3;
+			}
+
+			return 0;
+		}
+
+		// Contenu du bloc ViewParameters, en suivant l'alignement std140
+		struct ViewUniformBlock
+		{
+			Matrix4f projMatrix;
+			Matrix4f invProjMatrix;
+			Matrix4f viewMatrix;
+			Matrix4f invViewMatrix;
+			Matrix4f viewProjMatrix;
+			Matrix4f invViewProjMatrix;
+			Vector3f eyePosition;
+			float padding;
+			Vector2f targetSize;
+			Vector2f invTargetSize;
+		};
+
+		static_assert(sizeof(ViewUniformBlock) == 416, "View uniform block must follow the std140 layout");
+
 		Context_Map s_vaos;
+		VAO_Entry* s_lastVAOEntry = nullptr; // Entrée du dernier VAO utilisé, évite la recherche si la configuration n'a pas changé
+		VAO_Key s_lastVAOKey;
+		const Context* s_lastVAOContext = nullptr;
 		std::vector<unsigned int> s_dirtyTextureUnits;
+		std::vector<Renderer::DrawIndexedIndirectCommand> s_indirectCommands;
 		std::vector<TextureUnit> s_textureUnits;
 		GLuint s_currentVAO = 0;
+		GLuint s_indirectBuffer = 0;
 		VertexBuffer s_instanceBuffer;
 		VertexBuffer s_fullscreenQuadBuffer;
+		BufferRef s_viewUniformBuffer;
 		MatrixUnit s_matrices[MatrixType_Max + 1];
 		RenderStates s_states;
+		Renderer::FrameStats s_currentFrameStats;
+		Renderer::FrameStats s_lastFrameStats;
 		Vector2ui s_targetSize;
+		Vector2ui s_viewUniformTargetSize;
 		UInt8 s_maxAnisotropyLevel;
 		UInt32 s_updateFlags;
 		const IndexBuffer* s_indexBuffer;
 		const RenderTarget* s_target;
 		const Shader* s_shader;
+		const VertexBuffer* s_currentInstanceBuffer;
 		const VertexBuffer* s_vertexBuffer;
 		bool s_capabilities[RendererCap_Max + 1];
 		bool s_instancing;
+		bool s_viewUniformBufferUpdated;
+		unsigned int s_firstInstance;
 		unsigned int s_maxColorAttachments;
 		unsigned int s_maxRenderTarget;
 		unsigned int s_maxTextureSize;
 		unsigned int s_maxTextureUnit;
 		unsigned int s_maxVertexAttribs;
+
+		void ReleaseVAO(const Context* context, const VAO_Key& key)
+		{
+			auto it = s_vaos.find(context);
+			if (it == s_vaos.end())
+				return;
+
+			VAO_Map& vaos = it->second.vaoMap;
+
+			auto vaoIt = vaos.find(key);
+			if (vaoIt == vaos.end())
+				return;
+
+			if (s_lastVAOEntry == &vaoIt->second)
+			{
+				s_lastVAOContext = nullptr;
+				s_lastVAOEntry = nullptr;
+			}
+
+			// Suppression du VAO:
+			// Comme celui-ci est local à son contexte de création, sa suppression n'est possible que si
+			// son contexte d'origine est actif, sinon il faudra le mettre en file d'attente
+			// Ceci est géré par la méthode OpenGL::DeleteVertexArray
+			OpenGL::DeleteVertexArray(context, vaoIt->second.vao);
+
+			// Les slots de l'entrée sont déconnectés par sa destruction, y compris celui en cours d'appel
+			vaos.erase(vaoIt);
+		}
+
+		// Les buffers persistants sont lus depuis leur région courante
+		unsigned int GetIndexBufferOffset()
+		{
+			HardwareBuffer* indexBufferImpl = static_cast<HardwareBuffer*>(s_indexBuffer->GetBuffer()->GetImpl());
+			return s_indexBuffer->GetStartOffset() + indexBufferImpl->GetRegionOffset();
+		}
+
+		unsigned int GetRegionOffset(const VertexBuffer* vertexBuffer)
+		{
+			HardwareBuffer* vertexBufferImpl = static_cast<HardwareBuffer*>(vertexBuffer->GetBuffer()->GetImpl());
+			return vertexBufferImpl->GetRegionOffset();
+		}
 	}
 
 	void Renderer::BeginCondition(const GpuQuery& query, GpuQueryCondition condition)
@@ -191,10 +316,18 @@ namespace Nz
 		}
 
 		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		glBindVertexArray(0);
+
+		s_currentFrameStats.drawCallCount++;
+		s_currentFrameStats.instanceCount++;
+		s_currentFrameStats.primitiveCount += 2;
 	}
 
 	void Renderer::DrawIndexedPrimitives(PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount)
+	{
+		DrawIndexedPrimitives(mode, firstIndex, indexCount, 0);
+	}
+
+	void Renderer::DrawIndexedPrimitives(PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount, unsigned int baseVertex)
 	{
 		#ifdef NAZARA_DEBUG
 		if (Context::GetCurrent() == nullptr)
@@ -228,7 +361,7 @@ namespace Nz
 
 		GLenum type;
 		UInt8* offset = nullptr;
-		offset += s_indexBuffer->GetStartOffset();
+		offset += GetIndexBufferOffset();
 
 		if (s_indexBuffer->HasLargeIndices())
 		{
@@ -241,8 +374,142 @@ namespace Nz
 			type = GL_UNSIGNED_SHORT;
 		}
 
-		glDrawElements(OpenGL::PrimitiveMode[mode], indexCount, type, offset);
-		glBindVertexArray(0);
+		// Les indices sont relatifs au sommet de base (permet de dessiner depuis n'importe quelle partie du vertex buffer)
+		glDrawElementsBaseVertex(OpenGL::PrimitiveMode[mode], indexCount, type, offset, baseVertex);
+
+		s_currentFrameStats.drawCallCount++;
+		s_currentFrameStats.instanceCount++;
+		s_currentFrameStats.primitiveCount += GetPrimitiveCount(mode, indexCount);
+	}
+
+	void Renderer::DrawIndexedPrimitivesIndirect(PrimitiveMode mode, const DrawIndexedIndirectCommand* commands, unsigned int commandCount)
+	{
+		#ifdef NAZARA_DEBUG
+		if (Context::GetCurrent() == nullptr)
+		{
+			NazaraError("No active context");
+			return;
+		}
+
+		if (mode > PrimitiveMode_Max)
+		{
+			NazaraError("Primitive mode out of enum");
+			return;
+		}
+		#endif
+
+		#if NAZARA_RENDERER_SAFE
+		if (!s_indexBuffer)
+		{
+			NazaraError("No index buffer");
+			return;
+		}
+
+		if (!commands && commandCount > 0)
+		{
+			NazaraError("Invalid commands");
+			return;
+		}
+
+		unsigned int maxInstanceCount = s_currentInstanceBuffer->GetVertexCount() - s_firstInstance;
+		for (unsigned int i = 0; i < commandCount; ++i)
+		{
+			if (commands[i].firstInstance + commands[i].instanceCount > maxInstanceCount)
+			{
+				NazaraError("Command #" + String::Number(i) + " instances are out of the instance buffer (" + String::Number(commands[i].firstInstance + commands[i].instanceCount) + " > " + String::Number(maxInstanceCount) + ')');
+				return;
+			}
+		}
+		#endif
+
+		if (commandCount == 0)
+			return;
+
+		EnableInstancing(true);
+
+		if (!EnsureStateUpdate())
+		{
+			NazaraError("Failed to update states: " + Error::GetLastError());
+			return;
+		}
+
+		GLenum type;
+		unsigned int indexSize;
+		if (s_indexBuffer->HasLargeIndices())
+		{
+			indexSize = sizeof(UInt32);
+			type = GL_UNSIGNED_INT;
+		}
+		else
+		{
+			indexSize = sizeof(UInt16);
+			type = GL_UNSIGNED_SHORT;
+		}
+
+		NazaraAssert(GetIndexBufferOffset() % indexSize == 0, "Index buffer start offset must be aligned on the index size");
+		unsigned int startIndex = GetIndexBufferOffset() / indexSize;
+
+		UInt64 primitiveCount = 0;
+		unsigned int instanceCount = 0;
+
+		if (s_capabilities[RendererCap_MultiDrawIndirect])
+		{
+			// Les commandes ne connaissent pas le début de l'index buffer dans le buffer OpenGL, on l'y ajoute
+			s_indirectCommands.assign(commands, commands + commandCount);
+			for (DrawIndexedIndirectCommand& command : s_indirectCommands)
+			{
+				command.firstIndex += startIndex;
+
+				instanceCount += command.instanceCount;
+				primitiveCount += static_cast<UInt64>(GetPrimitiveCount(mode, command.indexCount)) * command.instanceCount;
+			}
+
+			// Le buffer est réalloué à chaque appel, le pilote n'a ainsi pas à attendre la fin des rendus précédents
+			unsigned int size = commandCount * sizeof(DrawIndexedIndirectCommand);
+
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, s_indirectBuffer);
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, size, s_indirectCommands.data(), GL_STREAM_DRAW);
+
+			glMultiDrawElementsIndirect(OpenGL::PrimitiveMode[mode], type, nullptr, commandCount, 0);
+
+			s_currentFrameStats.bufferUploadSize += size;
+			s_currentFrameStats.drawCallCount++;
+		}
+		else
+		{
+			// Sans baseInstance, chaque commande décale elle-même le début des données d'instance
+			const VertexBuffer* instanceBuffer = s_currentInstanceBuffer;
+			unsigned int firstInstance = s_firstInstance;
+
+			for (unsigned int i = 0; i < commandCount; ++i)
+			{
+				const DrawIndexedIndirectCommand& command = commands[i];
+				if (command.instanceCount == 0)
+					continue;
+
+				SetInstanceBuffer(instanceBuffer, firstInstance + command.firstInstance);
+
+				if (!EnsureStateUpdate())
+				{
+					NazaraError("Failed to update states: " + Error::GetLastError());
+					break;
+				}
+
+				UInt8* offset = nullptr;
+				offset += (startIndex + command.firstIndex) * indexSize;
+
+				glDrawElementsInstancedBaseVertex(OpenGL::PrimitiveMode[mode], command.indexCount, type, offset, command.instanceCount, command.baseVertex);
+
+				instanceCount += command.instanceCount;
+				primitiveCount += static_cast<UInt64>(GetPrimitiveCount(mode, command.indexCount)) * command.instanceCount;
+				s_currentFrameStats.drawCallCount++;
+			}
+
+			SetInstanceBuffer(instanceBuffer, firstInstance);
+		}
+
+		s_currentFrameStats.instanceCount += instanceCount;
+		s_currentFrameStats.primitiveCount += primitiveCount;
 	}
 
 	void Renderer::DrawIndexedPrimitivesInstanced(unsigned int instanceCount, PrimitiveMode mode, unsigned int firstIndex, unsigned int indexCount)
@@ -274,7 +541,7 @@ namespace Nz
 			return;
 		}
 
-		unsigned int maxInstanceCount = s_instanceBuffer.GetVertexCount();
+		unsigned int maxInstanceCount = s_currentInstanceBuffer->GetVertexCount() - s_firstInstance;
 		if (instanceCount > maxInstanceCount)
 		{
 			NazaraError("Instance count is over maximum instance count (" + String::Number(instanceCount) + " >= " NazaraStringifyMacro(NAZARA_RENDERER_MAX_INSTANCES) ")");
@@ -292,7 +559,7 @@ namespace Nz
 
 		GLenum type;
 		UInt8* offset = nullptr;
-		offset += s_indexBuffer->GetStartOffset();
+		offset += GetIndexBufferOffset();
 
 		if (s_indexBuffer->HasLargeIndices())
 		{
@@ -306,7 +573,10 @@ namespace Nz
 		}
 
 		glDrawElementsInstanced(OpenGL::PrimitiveMode[mode], indexCount, type, offset, instanceCount);
-		glBindVertexArray(0);
+
+		s_currentFrameStats.drawCallCount++;
+		s_currentFrameStats.instanceCount += instanceCount;
+		s_currentFrameStats.primitiveCount += static_cast<UInt64>(GetPrimitiveCount(mode, indexCount)) * instanceCount;
 	}
 
 	void Renderer::DrawPrimitives(PrimitiveMode mode, unsigned int firstVertex, unsigned int vertexCount)
@@ -334,7 +604,10 @@ namespace Nz
 		}
 
 		glDrawArrays(OpenGL::PrimitiveMode[mode], firstVertex, vertexCount);
-		glBindVertexArray(0);
+
+		s_currentFrameStats.drawCallCount++;
+		s_currentFrameStats.instanceCount++;
+		s_currentFrameStats.primitiveCount += GetPrimitiveCount(mode, vertexCount);
 	}
 
 	void Renderer::DrawPrimitivesInstanced(unsigned int instanceCount, PrimitiveMode mode, unsigned int firstVertex, unsigned int vertexCount)
@@ -360,7 +633,7 @@ namespace Nz
 			return;
 		}
 
-		unsigned int maxInstanceCount = s_instanceBuffer.GetVertexCount();
+		unsigned int maxInstanceCount = s_currentInstanceBuffer->GetVertexCount() - s_firstInstance;
 		if (instanceCount > maxInstanceCount)
 		{
 			NazaraError("Instance count is over maximum instance count (" + String::Number(instanceCount) + " >= " NazaraStringifyMacro(NAZARA_RENDERER_MAX_INSTANCES) ")");
@@ -377,7 +650,10 @@ namespace Nz
 		}
 
 		glDrawArraysInstanced(OpenGL::PrimitiveMode[mode], firstVertex, vertexCount, instanceCount);
-		glBindVertexArray(0);
+
+		s_currentFrameStats.drawCallCount++;
+		s_currentFrameStats.instanceCount += instanceCount;
+		s_currentFrameStats.primitiveCount += static_cast<UInt64>(GetPrimitiveCount(mode, vertexCount)) * instanceCount;
 	}
 
 	void Renderer::Enable(RendererParameter parameter, bool enable)
@@ -443,6 +719,14 @@ namespace Nz
 		glEndConditionalRender();
 	}
 
+	void Renderer::EndFrame()
+	{
+		s_lastFrameStats = s_currentFrameStats;
+		s_currentFrameStats = FrameStats();
+
+		GpuTimer::NextFrame();
+	}
+
 	void Renderer::Flush()
 	{
 		#ifdef NAZARA_DEBUG
@@ -461,9 +745,23 @@ namespace Nz
 		return s_states.depthFunc;
 	}
 
+	const Renderer::FrameStats& Renderer::GetFrameStats()
+	{
+		return s_lastFrameStats;
+	}
+
 	VertexBuffer* Renderer::GetInstanceBuffer()
 	{
-		s_updateFlags |= Update_VAO;
+		// Le buffer d'instancing du renderer redevient celui utilisé par les rendus instanciés
+		// (les changements de région de son remplissage sont signalés par OnBufferRegionChange)
+		if (s_currentInstanceBuffer != &s_instanceBuffer || s_firstInstance != 0)
+		{
+			s_currentInstanceBuffer = &s_instanceBuffer;
+			s_firstInstance = 0;
+
+			s_updateFlags |= Update_VAO;
+		}
+
 		return &s_instanceBuffer;
 	}
 
@@ -611,8 +909,10 @@ namespace Nz
 
 		// Récupération des capacités d'OpenGL
 		s_capabilities[RendererCap_AnisotropicFilter] = OpenGL::IsSupported(OpenGLExtension_AnisotropicFilter);
+		s_capabilities[RendererCap_BindlessTexture] = OpenGL::IsSupported(OpenGLExtension_BindlessTexture);
 		s_capabilities[RendererCap_FP64] = OpenGL::IsSupported(OpenGLExtension_FP64);
 		s_capabilities[RendererCap_Instancing] = true; // Supporté par OpenGL 3.3
+		s_capabilities[RendererCap_MultiDrawIndirect] = OpenGL::IsSupported(OpenGLExtension_MultiDrawIndirect);
 
 		Context::EnsureContext();
 
@@ -648,6 +948,8 @@ namespace Nz
 
 		s_states = RenderStates();
 
+		s_currentInstanceBuffer = &s_instanceBuffer;
+		s_firstInstance = 0;
 		s_indexBuffer = nullptr;
 		s_shader = nullptr;
 		s_target = nullptr;
@@ -672,6 +974,18 @@ namespace Nz
 			return false;
 		}
 
+		s_viewUniformBuffer = Buffer::New(BufferType_Uniform);
+		if (!s_viewUniformBuffer->Create(sizeof(ViewUniformBlock), DataStorage_Hardware, BufferUsage_Dynamic))
+		{
+			NazaraError("Failed to create view uniform buffer");
+			return false;
+		}
+
+		s_viewUniformBufferUpdated = false;
+
+		if (s_capabilities[RendererCap_MultiDrawIndirect])
+			glGenBuffers(1, &s_indirectBuffer);
+
 		if (s_capabilities[RendererCap_Instancing])
 		{
 			try
@@ -746,6 +1060,34 @@ namespace Nz
 
 		ShaderLibrary::Register("DebugSimple", debugShader);
 
+		// Variante utilisant la couleur des sommets, pour dessiner des primitives de couleurs différentes en un seul appel
+		ShaderRef debugColorShader = Shader::New();
+		if (!debugColorShader->Create())
+		{
+			NazaraError("Failed to create debug color shader");
+			return false;
+		}
+
+		if (!debugColorShader->AttachStageFromSource(ShaderStageType_Fragment, reinterpret_cast<const char*>(r_colorFragmentShader), sizeof(r_colorFragmentShader)))
+		{
+			NazaraError("Failed to attach fragment stage");
+			return false;
+		}
+
+		if (!debugColorShader->AttachStageFromSource(ShaderStageType_Vertex, reinterpret_cast<const char*>(r_colorVertexShader), sizeof(r_colorVertexShader)))
+		{
+			NazaraError("Failed to attach vertex stage");
+			return false;
+		}
+
+		if (!debugColorShader->Link())
+		{
+			NazaraError("Failed to link shader");
+			return false;
+		}
+
+		ShaderLibrary::Register("DebugColor", debugColorShader);
+
 		onExit.Reset();
 
 		NazaraNotice("Initialized: Renderer module");
@@ -761,7 +1103,14 @@ namespace Nz
 			case ComponentType_Float2:
 			case ComponentType_Float3:
 			case ComponentType_Float4:
-				return true; // Supportés nativement
+			case ComponentType_Half2:
+			case ComponentType_Half4:
+			case ComponentType_NormalizedByte4:
+			case ComponentType_NormalizedShort2:
+			case ComponentType_NormalizedShort4:
+			case ComponentType_NormalizedUShort2:
+			case ComponentType_NormalizedInt2101010:
+				return true; // Supportés nativement (OpenGL 3.3)
 
 			case ComponentType_Double1:
 			case ComponentType_Double2:
@@ -954,6 +1303,28 @@ namespace Nz
 		}
 	}
 
+	void Renderer::SetInstanceBuffer(const VertexBuffer* instanceBuffer, unsigned int firstInstance)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (instanceBuffer && !instanceBuffer->IsHardware())
+		{
+			NazaraError("Buffer must be hardware");
+			return;
+		}
+		#endif
+
+		// Un buffer nul restaure le buffer d'instancing du renderer
+		if (!instanceBuffer)
+			instanceBuffer = &s_instanceBuffer;
+
+		if (s_currentInstanceBuffer != instanceBuffer || s_firstInstance != firstInstance)
+		{
+			s_currentInstanceBuffer = instanceBuffer;
+			s_firstInstance = firstInstance;
+			s_updateFlags |= Update_VAO;
+		}
+	}
+
 	void Renderer::SetLineWidth(float width)
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -990,6 +1361,7 @@ namespace Nz
 				s_matrices[MatrixType_InvWorldViewProj].updated = false;
 				s_matrices[MatrixType_ViewProj].updated = false;
 				s_matrices[MatrixType_WorldViewProj].updated = false;
+				s_viewUniformBufferUpdated = false;
 				break;
 
 			case MatrixType_View:
@@ -1000,6 +1372,7 @@ namespace Nz
 				s_matrices[MatrixType_ViewProj].updated = false;
 				s_matrices[MatrixType_World].updated = false;
 				s_matrices[MatrixType_WorldViewProj].updated = false;
+				s_viewUniformBufferUpdated = false;
 				break;
 
 			case MatrixType_World:
@@ -1013,6 +1386,7 @@ namespace Nz
 			// Matrices combinées
 			case MatrixType_ViewProj:
 				s_matrices[MatrixType_InvViewProj].updated = false;
+				s_viewUniformBufferUpdated = false;
 				break;
 
 			case MatrixType_WorldView:
@@ -1027,6 +1401,9 @@ namespace Nz
 			case MatrixType_InvProjection:
 			case MatrixType_InvView:
 			case MatrixType_InvViewProj:
+				s_viewUniformBufferUpdated = false;
+				break;
+
 			case MatrixType_InvWorld:
 			case MatrixType_InvWorldView:
 			case MatrixType_InvWorldViewProj:
@@ -1076,6 +1453,8 @@ namespace Nz
 		{
 			s_shader = shader;
 			s_updateFlags |= Update_Shader;
+
+			s_currentFrameStats.shaderChangeCount++;
 		}
 	}
 
@@ -1324,6 +1703,8 @@ namespace Nz
 
 			s_dirtyTextureUnits.push_back(unit);
 			s_updateFlags |= Update_Textures;
+
+			s_currentFrameStats.textureChangeCount++;
 		}
 	}
 
@@ -1347,6 +1728,36 @@ namespace Nz
 		s_updateFlags |= Update_Textures;
 	}
 
+	void Renderer::SetUniformBuffer(unsigned int bindingPoint, const Buffer* buffer)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (buffer && buffer->GetType() != BufferType_Uniform)
+		{
+			NazaraError("Buffer must be a uniform buffer");
+			return;
+		}
+
+		if (buffer && !buffer->IsHardware())
+		{
+			NazaraError("Buffer must be hardware");
+			return;
+		}
+		#endif
+
+		if (buffer)
+		{
+			HardwareBuffer* bufferImpl = static_cast<HardwareBuffer*>(buffer->GetImpl());
+
+			// Seule la région courante d'un buffer persistant est liée
+			if (bufferImpl->IsPersistent())
+				OpenGL::BindUniformBuffer(bindingPoint, bufferImpl->GetOpenGLID(), bufferImpl->GetRegionOffset(), buffer->GetSize());
+			else
+				OpenGL::BindUniformBuffer(bindingPoint, bufferImpl->GetOpenGLID());
+		}
+		else
+			OpenGL::BindUniformBuffer(bindingPoint, 0);
+	}
+
 	void Renderer::SetVertexBuffer(const VertexBuffer* vertexBuffer)
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -1383,6 +1794,10 @@ namespace Nz
 		// Libération du module
 		s_moduleReferenceCounter = 0;
 
+		// Le worker termine ses travaux tant que les ressources et contextes existent encore
+		UploadWorker::Uninitialize();
+
+		ShaderLibrary::Unregister("DebugColor");
 		ShaderLibrary::Unregister("DebugSimple");
 
 		UberShader::Uninitialize();
@@ -1391,12 +1806,22 @@ namespace Nz
 		Shader::Uninitialize();
 		RenderBuffer::Uninitialize();
 		DebugDrawer::Uninitialize();
+		GpuTimer::Uninitialize();
 
 		s_textureUnits.clear();
 
 		// Libération des buffers
 		s_fullscreenQuadBuffer.Reset();
 		s_instanceBuffer.Reset();
+		s_viewUniformBuffer.Reset();
+
+		if (s_indirectBuffer)
+		{
+			glDeleteBuffers(1, &s_indirectBuffer);
+			s_indirectBuffer = 0;
+		}
+
+		s_indirectCommands.clear();
 
 		// Libération des VAOs
 		for (auto& pair : s_vaos)
@@ -1411,7 +1836,10 @@ namespace Nz
 			}
 		}
 		s_vaos.clear();
+		s_lastVAOContext = nullptr;
+		s_lastVAOEntry = nullptr;
 
+		GpuMemory::Uninitialize();
 		OpenGL::Uninitialize();
 
 		NazaraNotice("Uninitialized: Renderer module");
@@ -1420,6 +1848,16 @@ namespace Nz
 		Utility::Uninitialize();
 	}
 
+	void Renderer::CountBufferUpload(unsigned int size)
+	{
+		s_currentFrameStats.bufferUploadSize += size;
+	}
+
+	void Renderer::CountRedundantCall()
+	{
+		s_currentFrameStats.redundantCallCount++;
+	}
+
 	void Renderer::EnableInstancing(bool instancing)
 	{
 		if (s_instancing != instancing)
@@ -1502,8 +1940,19 @@ namespace Nz
 			s_targetSize.Set(targetSize);
 		}
 
+		// Les programmes utilisant le bloc ViewParameters n'ont pas d'uniformes de vue individuelles
+		if (s_shader->m_viewUniformBlock)
+		{
+			if (!s_viewUniformBufferUpdated || s_viewUniformTargetSize != targetSize)
+				UpdateViewUniformBuffer(targetSize);
+
+			SetUniformBuffer(UniformBufferBinding_View, s_viewUniformBuffer);
+		}
+
 		if (s_updateFlags != Update_None)
 		{
+			s_currentFrameStats.stateUpdateCount++;
+
 			if (s_updateFlags & Update_Textures)
 			{
 				for (unsigned int i : s_dirtyTextureUnits)
@@ -1551,190 +2000,133 @@ namespace Nz
 				// Note: Les VAOs ne sont pas partagés entre les contextes, nous avons donc un tableau de VAOs par contexte
 				const Context* context = Context::GetCurrent();
 
-				auto it = s_vaos.find(context);
-				if (it == s_vaos.end())
-				{
-					Context_Entry entry;
-					entry.onReleaseSlot.Connect(context->OnContextRelease, OnContextRelease);
-
-					it = s_vaos.insert(std::make_pair(context, std::move(entry))).first;
-				}
-
-				VAO_Map& vaoMap = it->second.vaoMap;
-
 				// Notre clé est composée de ce qui définit un VAO
 				const VertexDeclaration* vertexDeclaration = s_vertexBuffer->GetVertexDeclaration();
-				const VertexDeclaration* instancingDeclaration = (s_instancing) ? s_instanceBuffer.GetVertexDeclaration() : nullptr;
-				VAO_Key key(s_indexBuffer, s_vertexBuffer, vertexDeclaration, instancingDeclaration);
+				const VertexBuffer* instanceBuffer = (s_instancing) ? s_currentInstanceBuffer : nullptr;
+				const VertexDeclaration* instancingDeclaration = (s_instancing) ? instanceBuffer->GetVertexDeclaration() : nullptr;
+				VAO_Key key(s_indexBuffer, s_vertexBuffer, vertexDeclaration, instancingDeclaration, instanceBuffer);
 
-				// On recherche un VAO existant avec notre configuration
-				auto vaoIt = vaoMap.find(key);
-				if (vaoIt == vaoMap.end())
+				// Les rendus successifs utilisent généralement les mêmes buffers, ce qui nous évite la recherche
+				if (!s_lastVAOEntry || s_lastVAOContext != context || s_lastVAOKey != key)
 				{
-					// On créé notre VAO
-					glGenVertexArrays(1, &s_currentVAO);
-					glBindVertexArray(s_currentVAO);
+					auto it = s_vaos.find(context);
+					if (it == s_vaos.end())
+					{
+						Context_Entry entry;
+						entry.onReleaseSlot.Connect(context->OnContextRelease, OnContextRelease);
 
-					// On l'ajoute à notre liste
-					VAO_Entry entry;
-					entry.vao = s_currentVAO;
+						it = s_vaos.insert(std::make_pair(context, std::move(entry))).first;
+					}
 
-					// Connect the slots
-					if (s_indexBuffer)
-						entry.onIndexBufferReleaseSlot.Connect(s_indexBuffer->OnIndexBufferRelease, OnIndexBufferRelease);
+					VAO_Map& vaoMap = it->second.vaoMap;
 
-					if (instancingDeclaration)
-						entry.onInstancingDeclarationReleaseSlot.Connect(instancingDeclaration->OnVertexDeclarationRelease, OnVertexDeclarationRelease);
+					// On recherche un VAO existant avec notre configuration
+					auto vaoIt = vaoMap.find(key);
+					if (vaoIt == vaoMap.end())
+					{
+						// On créé notre VAO
+						glGenVertexArrays(1, &s_currentVAO);
+						OpenGL::BindVertexArray(s_currentVAO);
 
-					entry.onVertexBufferReleaseSlot.Connect(s_vertexBuffer->OnVertexBufferRelease, OnVertexBufferRelease);
-					entry.onVertexDeclarationReleaseSlot.Connect(vertexDeclaration->OnVertexDeclarationRelease, OnVertexDeclarationRelease);
+						// On l'ajoute à notre liste
+						VAO_Entry entry;
+						entry.firstInstance = s_firstInstance;
+						entry.instanceRegionOffset = (instanceBuffer) ? GetRegionOffset(instanceBuffer) : 0;
+						entry.vertexRegionOffset = GetRegionOffset(s_vertexBuffer);
+						entry.vao = s_currentVAO;
 
-					vaoIt = vaoMap.insert(std::make_pair(key, std::move(entry))).first;
+						// La libération de l'un des éléments de la clé libère directement ce VAO, sans parcourir les autres
+						auto OnRelease = [context, key]() { ReleaseVAO(context, key); };
 
-					// And begin to program it
-					bool updateFailed = false;
+						if (s_indexBuffer)
+							entry.onIndexBufferReleaseSlot.Connect(s_indexBuffer->OnIndexBufferRelease, [OnRelease](const IndexBuffer*) { OnRelease(); });
 
-					// Pour éviter la duplication de code, on va utiliser une astuce via une boucle for
-					for (unsigned int i = 0; i < (s_instancing ? 2U : 1U); ++i)
-					{
-						// Selon l'itération nous choisissons un buffer différent
-						const VertexBuffer* vertexBuffer = (i == 0) ? s_vertexBuffer : &s_instanceBuffer;
+						if (instanceBuffer)
+						{
+							entry.onInstanceBufferReleaseSlot.Connect(instanceBuffer->OnVertexBufferRelease, [OnRelease](const VertexBuffer* vertexBuffer)
+							{
+								OnVertexBufferRelease(vertexBuffer);
+								OnRelease();
+							});
+
+							entry.onInstancingDeclarationReleaseSlot.Connect(instancingDeclaration->OnVertexDeclarationRelease, [OnRelease](const VertexDeclaration*) { OnRelease(); });
+						}
+
+						entry.onVertexBufferReleaseSlot.Connect(s_vertexBuffer->OnVertexBufferRelease, [OnRelease](const VertexBuffer* vertexBuffer)
+						{
+							OnVertexBufferRelease(vertexBuffer);
+							OnRelease();
+						});
+						entry.onVertexDeclarationReleaseSlot.Connect(vertexDeclaration->OnVertexDeclarationRelease, [OnRelease](const VertexDeclaration*) { OnRelease(); });
 
-						HardwareBuffer* vertexBufferImpl = static_cast<HardwareBuffer*>(vertexBuffer->GetBuffer()->GetImpl());
-						glBindBuffer(OpenGL::BufferTarget[BufferType_Vertex], vertexBufferImpl->GetOpenGLID());
+						vaoIt = vaoMap.insert(std::make_pair(key, std::move(entry))).first;
 
-						unsigned int bufferOffset = vertexBuffer->GetStartOffset();
-						vertexDeclaration = vertexBuffer->GetVertexDeclaration();
-						unsigned int stride = vertexDeclaration->GetStride();
+						// And begin to program it
+						bool updateFailed = !SpecifyVertexAttribs(s_vertexBuffer, false, 0);
+						if (!updateFailed && s_instancing)
+							updateFailed = !SpecifyVertexAttribs(s_currentInstanceBuffer, true, s_firstInstance);
 
-						// On définit les bornes (une fois de plus selon l'itération)
-						unsigned int start = (i == 0) ? VertexComponent_FirstVertexData : VertexComponent_FirstInstanceData;
-						unsigned int end = (i == 0) ? VertexComponent_LastVertexData : VertexComponent_LastInstanceData;
-						for (unsigned int j = start; j <= end; ++j)
+						if (!s_instancing)
 						{
-							ComponentType type;
-							bool enabled;
-							std::size_t offset;
-							vertexDeclaration->GetComponent(static_cast<VertexComponent>(j), &enabled, &type, &offset);
+							// Je ne sais pas si c'est vraiment nécessaire de désactiver les attributs, sur mon ordinateur ça ne pose aucun problème
+							// mais dans le doute, je laisse ça comme ça.
+							for (unsigned int i = VertexComponent_FirstInstanceData; i <= VertexComponent_LastInstanceData; ++i)
+								glDisableVertexAttribArray(OpenGL::VertexComponentIndex[i]);
+						}
 
-							if (enabled)
-							{
-								if (!IsComponentTypeSupported(type))
-								{
-									NazaraError("Invalid vertex declaration " + String::Pointer(vertexDeclaration) + ": Vertex component 0x" + String::Number(j, 16) + " (type: 0x" + String::Number(type, 16) + ") is not supported");
-									updateFailed = true;
-									break;
-								}
-
-								glEnableVertexAttribArray(OpenGL::VertexComponentIndex[j]);
-
-								switch (type)
-								{
-									case ComponentType_Color:
-									{
-										glVertexAttribPointer(OpenGL::VertexComponentIndex[j],
-															  Utility::ComponentCount[type],
-															  OpenGL::ComponentType[type],
-															  GL_TRUE,
-															  stride,
-															  reinterpret_cast<void*>(bufferOffset + offset));
-
-										break;
-									}
-
-									case ComponentType_Double1:
-									case ComponentType_Double2:
-									case ComponentType_Double3:
-									case ComponentType_Double4:
-									{
-										glVertexAttribLPointer(OpenGL::VertexComponentIndex[j],
-															   Utility::ComponentCount[type],
-															   OpenGL::ComponentType[type],
-															   stride,
-															   reinterpret_cast<void*>(bufferOffset + offset));
-
-										break;
-									}
-
-									case ComponentType_Float1:
-									case ComponentType_Float2:
-									case ComponentType_Float3:
-									case ComponentType_Float4:
-									{
-										glVertexAttribPointer(OpenGL::VertexComponentIndex[j],
-															  Utility::ComponentCount[type],
-															  OpenGL::ComponentType[type],
-															  GL_FALSE,
-															  stride,
-															  reinterpret_cast<void*>(bufferOffset + offset));
-
-										break;
-									}
-
-									case ComponentType_Int1:
-									case ComponentType_Int2:
-									case ComponentType_Int3:
-									case ComponentType_Int4:
-									{
-										glVertexAttribIPointer(OpenGL::VertexComponentIndex[j],
-															   Utility::ComponentCount[type],
-															   OpenGL::ComponentType[type],
-															   stride,
-															   reinterpret_cast<void*>(bufferOffset + offset));
-
-										break;
-									}
-
-									default:
-									{
-										NazaraInternalError("Unsupported component type (0x" + String::Number(type, 16) + ')');
-										break;
-									}
-								}
-
-								// Les attributs d'instancing ont un diviseur spécifique (pour dépendre de l'instance en cours)
-								if (i == 1)
-									glVertexAttribDivisor(OpenGL::VertexComponentIndex[j], 1);
-							}
-							else
-								glDisableVertexAttribArray(OpenGL::VertexComponentIndex[j]);
+						// Et on active l'index buffer (Un seul index buffer par VAO)
+						if (s_indexBuffer)
+						{
+							HardwareBuffer* indexBufferImpl = static_cast<HardwareBuffer*>(s_indexBuffer->GetBuffer()->GetImpl());
+							glBindBuffer(OpenGL::BufferTarget[BufferType_Index], indexBufferImpl->GetOpenGLID());
 						}
-					}
+						else
+							glBindBuffer(OpenGL::BufferTarget[BufferType_Index], 0);
 
-					if (!s_instancing)
-					{
-						// Je ne sais pas si c'est vraiment nécessaire de désactiver les attributs, sur mon ordinateur ça ne pose aucun problème
-						// mais dans le doute, je laisse ça comme ça.
-						for (unsigned int i = VertexComponent_FirstInstanceData; i <= VertexComponent_LastInstanceData; ++i)
-							glDisableVertexAttribArray(OpenGL::VertexComponentIndex[i]);
+						// On invalide les bindings des buffers (car nous les avons défini manuellement)
+						OpenGL::SetBuffer(BufferType_Index, 0);
+						OpenGL::SetBuffer(BufferType_Vertex, 0);
+
+						if (updateFailed)
+						{
+							// La création de notre VAO a échoué, libérons-le et marquons-le comme problématique
+							OpenGL::BindVertexArray(0);
+							glDeleteVertexArrays(1, &vaoIt->second.vao);
+							vaoIt->second.vao = 0;
+						}
 					}
 
-					// Et on active l'index buffer (Un seul index buffer par VAO)
-					if (s_indexBuffer)
+					s_lastVAOContext = context;
+					s_lastVAOEntry = &vaoIt->second;
+					s_lastVAOKey = key;
+				}
+
+				// Notre VAO existe déjà (ou vient d'être programmé), il est donc inutile de le reprogrammer
+				VAO_Entry& entry = *s_lastVAOEntry;
+				s_currentVAO = entry.vao;
+
+				// À moins que les instances ne commencent ailleurs dans le buffer d'instancing
+				if (s_instancing && s_currentVAO && (entry.firstInstance != s_firstInstance || entry.instanceRegionOffset != GetRegionOffset(instanceBuffer)))
+				{
+					OpenGL::BindVertexArray(s_currentVAO);
+					if (SpecifyVertexAttribs(s_currentInstanceBuffer, true, s_firstInstance))
 					{
-						HardwareBuffer* indexBufferImpl = static_cast<HardwareBuffer*>(s_indexBuffer->GetBuffer()->GetImpl());
-						glBindBuffer(OpenGL::BufferTarget[BufferType_Index], indexBufferImpl->GetOpenGLID());
+						entry.firstInstance = s_firstInstance;
+						entry.instanceRegionOffset = GetRegionOffset(instanceBuffer);
 					}
-					else
-						glBindBuffer(OpenGL::BufferTarget[BufferType_Index], 0);
 
-					// On invalide les bindings des buffers (car nous les avons défini manuellement)
-					OpenGL::SetBuffer(BufferType_Index, 0);
 					OpenGL::SetBuffer(BufferType_Vertex, 0);
+				}
 
-					if (updateFailed)
-					{
-						// La création de notre VAO a échoué, libérons-le et marquons-le comme problématique
-						glDeleteVertexArrays(1, &vaoIt->second.vao);
-						vaoIt->second.vao = 0;
-						s_currentVAO = 0;
-					}
-					else
-						glBindVertexArray(0); // On marque la fin de la construction du VAO en le débindant
+				// Ou que le vertex buffer soit passé à une autre région
+				if (s_currentVAO && entry.vertexRegionOffset != GetRegionOffset(s_vertexBuffer))
+				{
+					OpenGL::BindVertexArray(s_currentVAO);
+					if (SpecifyVertexAttribs(s_vertexBuffer, false, 0))
+						entry.vertexRegionOffset = GetRegionOffset(s_vertexBuffer);
+
+					OpenGL::SetBuffer(BufferType_Vertex, 0);
 				}
-				else
-					// Notre VAO existe déjà, il est donc inutile de le reprogrammer
-					s_currentVAO = vaoIt->second.vao;
 
 				// En cas de non-support des VAOs, les attributs doivent être respécifiés à chaque frame
 				s_updateFlags &= ~Update_VAO;
@@ -1753,7 +2145,8 @@ namespace Nz
 			return false;
 		}
 
-		glBindVertexArray(s_currentVAO);
+		// Le VAO reste lié entre deux rendus, il ne sera rebindé que s'il change
+		OpenGL::BindVertexArray(s_currentVAO);
 
 		// On vérifie que les textures actuellement bindées sont bien nos textures
 		// Ceci à cause du fait qu'il est possible que des opérations sur les textures aient eu lieu
@@ -1782,38 +2175,25 @@ namespace Nz
 		return true;
 	}
 
-	void Renderer::OnContextRelease(const Context* context)
+	void Renderer::OnBufferRegionChange(const Buffer* buffer)
 	{
-		s_vaos.erase(context);
+		// Les attributs du VAO pointent sur l'ancienne région
+		if (s_vertexBuffer && s_vertexBuffer->GetBuffer() == buffer)
+			s_updateFlags |= Update_VAO;
+
+		if (s_instancing && s_currentInstanceBuffer && s_currentInstanceBuffer->GetBuffer() == buffer)
+			s_updateFlags |= Update_VAO;
 	}
 
-	void Renderer::OnIndexBufferRelease(const IndexBuffer* indexBuffer)
+	void Renderer::OnContextRelease(const Context* context)
 	{
-		for (auto& pair : s_vaos)
+		if (s_lastVAOContext == context)
 		{
-			const Context* context = pair.first;
-			VAO_Map& vaos = pair.second.vaoMap;
-
-			auto it = vaos.begin();
-			while (it != vaos.end())
-			{
-				const VAO_Key& key = it->first;
-				const IndexBuffer* vaoIndexBuffer = std::get<0>(key);
-
-				if (vaoIndexBuffer == indexBuffer)
-				{
-					// Suppression du VAO:
-					// Comme celui-ci est local à son contexte de création, sa suppression n'est possible que si
-					// son contexte d'origine est actif, sinon il faudra le mettre en file d'attente
-					// Ceci est géré par la méthode OpenGL::DeleteVertexArray
-
-					OpenGL::DeleteVertexArray(context, it->second.vao);
-					vaos.erase(it++);
-				}
-				else
-					++it;
-			}
+			s_lastVAOContext = nullptr;
+			s_lastVAOEntry = nullptr;
 		}
+
+		s_vaos.erase(context);
 	}
 
 	void Renderer::OnShaderReleased(const Shader* shader)
@@ -1838,61 +2218,125 @@ namespace Nz
 
 	void Renderer::OnVertexBufferRelease(const VertexBuffer* vertexBuffer)
 	{
-		for (auto& pair : s_vaos)
+		// Les VAOs utilisant ce buffer sont libérés par leurs propres slots
+		if (s_currentInstanceBuffer == vertexBuffer)
 		{
-			const Context* context = pair.first;
-			VAO_Map& vaos = pair.second.vaoMap;
-
-			auto it = vaos.begin();
-			while (it != vaos.end())
-			{
-				const VAO_Key& key = it->first;
-				const VertexBuffer* vaoVertexBuffer = std::get<1>(key);
-
-				if (vaoVertexBuffer == vertexBuffer)
-				{
-					// Suppression du VAO:
-					// Comme celui-ci est local à son contexte de création, sa suppression n'est possible que si
-					// son contexte d'origine est actif, sinon il faudra le mettre en file d'attente
-					// Ceci est géré par la méthode OpenGL::DeleteVertexArray
-
-					OpenGL::DeleteVertexArray(context, it->second.vao);
-					vaos.erase(it++);
-				}
-				else
-					++it;
-			}
+			s_currentInstanceBuffer = &s_instanceBuffer;
+			s_firstInstance = 0;
 		}
 	}
 
-	void Renderer::OnVertexDeclarationRelease(const VertexDeclaration* vertexDeclaration)
+	bool Renderer::SpecifyVertexAttribs(const VertexBuffer* vertexBuffer, bool instanceData, unsigned int firstInstance)
 	{
-		for (auto& pair : s_vaos)
+		HardwareBuffer* vertexBufferImpl = static_cast<HardwareBuffer*>(vertexBuffer->GetBuffer()->GetImpl());
+		glBindBuffer(OpenGL::BufferTarget[BufferType_Vertex], vertexBufferImpl->GetOpenGLID());
+
+		const VertexDeclaration* vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+		unsigned int stride = vertexDeclaration->GetStride();
+
+		// La première instance est émulée en décalant le début des attributs d'instancing (glDraw*BaseInstance requiert OpenGL 4.2)
+		unsigned int bufferOffset = vertexBuffer->GetStartOffset() + vertexBufferImpl->GetRegionOffset() + firstInstance*stride;
+
+		// On définit les bornes selon le type de données
+		unsigned int start = (instanceData) ? VertexComponent_FirstInstanceData : VertexComponent_FirstVertexData;
+		unsigned int end = (instanceData) ? VertexComponent_LastInstanceData : VertexComponent_LastVertexData;
+		for (unsigned int j = start; j <= end; ++j)
 		{
-			const Context* context = pair.first;
-			VAO_Map& vaos = pair.second.vaoMap;
+			ComponentType type;
+			bool enabled;
+			std::size_t offset;
+			vertexDeclaration->GetComponent(static_cast<VertexComponent>(j), &enabled, &type, &offset);
 
-			auto it = vaos.begin();
-			while (it != vaos.end())
+			if (enabled)
 			{
-				const VAO_Key& key = it->first;
-				const VertexDeclaration* vaoVertexDeclaration = std::get<2>(key);
-				const VertexDeclaration* vaoInstancingDeclaration = std::get<3>(key);
+				if (!IsComponentTypeSupported(type))
+				{
+					NazaraError("Invalid vertex declaration " + String::Pointer(vertexDeclaration) + ": Vertex component 0x" + String::Number(j, 16) + " (type: 0x" + String::Number(type, 16) + ") is not supported");
+					return false;
+				}
+
+				glEnableVertexAttribArray(OpenGL::VertexComponentIndex[j]);
 
-				if (vaoVertexDeclaration == vertexDeclaration || vaoInstancingDeclaration == vertexDeclaration)
+				switch (type)
 				{
-					// Suppression du VAO:
-					// Comme celui-ci est local à son contexte de création, sa suppression n'est possible que si
-					// son contexte d'origine est actif, sinon il faudra le mettre en file d'attente
-					// Ceci est géré par la méthode OpenGL::DeleteVertexArray
+					case ComponentType_Color:
+					case ComponentType_NormalizedByte4:
+					case ComponentType_NormalizedShort2:
+					case ComponentType_NormalizedShort4:
+					case ComponentType_NormalizedUShort2:
+					case ComponentType_NormalizedInt2101010:
+					{
+						glVertexAttribPointer(OpenGL::VertexComponentIndex[j],
+											  Utility::ComponentCount[type],
+											  OpenGL::ComponentType[type],
+											  GL_TRUE,
+											  stride,
+											  reinterpret_cast<void*>(bufferOffset + offset));
+
+						break;
+					}
 
-					OpenGL::DeleteVertexArray(context, it->second.vao);
-					vaos.erase(it++);
+					case ComponentType_Double1:
+					case ComponentType_Double2:
+					case ComponentType_Double3:
+					case ComponentType_Double4:
+					{
+						glVertexAttribLPointer(OpenGL::VertexComponentIndex[j],
+											   Utility::ComponentCount[type],
+											   OpenGL::ComponentType[type],
+											   stride,
+											   reinterpret_cast<void*>(bufferOffset + offset));
+
+						break;
+					}
+
+					case ComponentType_Float1:
+					case ComponentType_Float2:
+					case ComponentType_Float3:
+					case ComponentType_Float4:
+					case ComponentType_Half2:
+					case ComponentType_Half4:
+					{
+						glVertexAttribPointer(OpenGL::VertexComponentIndex[j],
+											  Utility::ComponentCount[type],
+											  OpenGL::ComponentType[type],
+											  GL_FALSE,
+											  stride,
+											  reinterpret_cast<void*>(bufferOffset + offset));
+
+						break;
+					}
+
+					case ComponentType_Int1:
+					case ComponentType_Int2:
+					case ComponentType_Int3:
+					case ComponentType_Int4:
+					{
+						glVertexAttribIPointer(OpenGL::VertexComponentIndex[j],
+											   Utility::ComponentCount[type],
+											   OpenGL::ComponentType[type],
+											   stride,
+											   reinterpret_cast<void*>(bufferOffset + offset));
+
+						break;
+					}
+
+					default:
+					{
+						NazaraInternalError("Unsupported component type (0x" + String::Number(type, 16) + ')');
+						break;
+					}
 				}
-				else
-					++it;
+
+				// Les attributs d'instancing ont un diviseur spécifique (pour dépendre de l'instance en cours)
+				if (instanceData)
+					glVertexAttribDivisor(OpenGL::VertexComponentIndex[j], 1);
 			}
+			else
+				glDisableVertexAttribArray(OpenGL::VertexComponentIndex[j]);
 		}
+
+		return true;
 	}
 
 	void Renderer::UpdateMatrix(MatrixType type)
@@ -1999,5 +2443,32 @@ namespace Nz
 		}
 	}
 
+	void Renderer::UpdateViewUniformBuffer(const Vector2ui& targetSize)
+	{
+		for (MatrixType type : {MatrixType_Projection, MatrixType_InvProjection, MatrixType_View, MatrixType_InvView, MatrixType_ViewProj, MatrixType_InvViewProj})
+		{
+			if (!s_matrices[type].updated)
+				UpdateMatrix(type);
+		}
+
+		ViewUniformBlock block;
+		block.projMatrix = s_matrices[MatrixType_Projection].matrix;
+		block.invProjMatrix = s_matrices[MatrixType_InvProjection].matrix;
+		block.viewMatrix = s_matrices[MatrixType_View].matrix;
+		block.invViewMatrix = s_matrices[MatrixType_InvView].matrix;
+		block.viewProjMatrix = s_matrices[MatrixType_ViewProj].matrix;
+		block.invViewProjMatrix = s_matrices[MatrixType_InvViewProj].matrix;
+		block.eyePosition = block.invViewMatrix.GetTranslation();
+		block.padding = 0.f;
+		block.targetSize = Vector2f(targetSize);
+		block.invTargetSize = 1.f / block.targetSize;
+
+		// Le buffer entier est réécrit, son ancien contenu est donc abandonné plutôt qu'attendu
+		s_viewUniformBuffer->Fill(&block, 0, sizeof(ViewUniformBlock));
+
+		s_viewUniformBufferUpdated = true;
+		s_viewUniformTargetSize = targetSize;
+	}
+
 	unsigned int Renderer::s_moduleReferenceCounter = 0;
 }
@@ -0,0 +1,13 @@
+#version 140
+
+/********************Entrant********************/
+in vec4 vColor;
+
+/********************Sortant********************/
+out vec4 RenderTarget0;
+
+/********************Fonctions********************/
+void main()
+{
+	RenderTarget0 = vColor;
+}
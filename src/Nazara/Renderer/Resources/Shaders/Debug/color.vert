@@ -0,0 +1,18 @@
+#version 140
+
+/********************Entrant********************/
+in vec4 VertexColor;
+in vec3 VertexPosition;
+
+/********************Sortant********************/
+out vec4 vColor;
+
+/********************Uniformes********************/
+uniform mat4 WorldViewProjMatrix;
+
+/********************Fonctions********************/
+void main()
+{
+	vColor = VertexColor;
+	gl_Position = WorldViewProjMatrix * vec4(VertexPosition, 1.0);
+}
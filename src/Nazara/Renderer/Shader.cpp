@@ -8,12 +8,15 @@
 #include <Nazara/Renderer/OpenGL.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/ShaderStage.hpp>
+#include <cstring>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
 	Shader::Shader() :
 	m_linked(false),
+	m_linking(false),
+	m_viewUniformBlock(false),
 	m_program(0)
 	{
 	}
@@ -40,7 +43,7 @@ namespace Nz
 			return;
 		}
 
-		if (!shaderStage.IsCompiled())
+		if (!shaderStage.IsCompiled() && !shaderStage.IsCompiling())
 		{
 			NazaraError("Shader stage must be compiled");
 			return;
@@ -124,6 +127,17 @@ namespace Nz
 		return true;
 	}
 
+	void Shader::BeginLinking()
+	{
+		Context::EnsureContext();
+
+		// Les étapes compilées en arrière-plan sont liées en même temps
+		glLinkProgram(m_program);
+
+		m_linked = false;
+		m_linking = true;
+	}
+
 	void Shader::Bind() const
 	{
 		OpenGL::BindProgram(m_program);
@@ -141,6 +155,7 @@ namespace Nz
 		}
 
 		m_linked = false;
+		m_linking = false;
 
 		glBindAttribLocation(m_program, OpenGL::VertexComponentIndex[VertexComponent_InstanceData0], "InstanceData0");
 		glBindAttribLocation(m_program, OpenGL::VertexComponentIndex[VertexComponent_InstanceData1], "InstanceData1");
@@ -187,6 +202,23 @@ namespace Nz
 		}
 	}
 
+	bool Shader::EndLinking()
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!m_linking)
+		{
+			NazaraError("Shader linking has not been started");
+			return false;
+		}
+		#endif
+
+		Context::EnsureContext();
+
+		m_linking = false;
+
+		return PostLinkage();
+	}
+
 	ByteArray Shader::GetBinary() const
 	{
 		ByteArray byteArray;
@@ -198,7 +230,7 @@ namespace Nz
 
 		if (binaryLength > 0)
 		{
-			byteArray.Reserve(sizeof(UInt64) + binaryLength);
+			byteArray.Resize(sizeof(UInt64) + binaryLength);
 
 			UInt8* buffer = byteArray.GetBuffer();
 
@@ -277,6 +309,14 @@ namespace Nz
 		return source;
 	}
 
+	int Shader::GetUniformBlockIndex(const String& name) const
+	{
+		Context::EnsureContext();
+
+		GLuint index = glGetUniformBlockIndex(m_program, name.GetConstBuffer());
+		return (index != GL_INVALID_INDEX) ? static_cast<int>(index) : -1;
+	}
+
 	int Shader::GetUniformLocation(const String& name) const
 	{
 		Context::EnsureContext();
@@ -304,6 +344,28 @@ namespace Nz
 		return m_linked;
 	}
 
+	bool Shader::IsLinking() const
+	{
+		return m_linking;
+	}
+
+	bool Shader::IsLinkingCompleted() const
+	{
+		if (!m_linking)
+			return true;
+
+		// Sans KHR_parallel_shader_compile, on ne peut pas savoir si le pilote a terminé sans attendre
+		if (!OpenGL::IsSupported(OpenGLExtension_ParallelShaderCompile))
+			return true;
+
+		Context::EnsureContext();
+
+		GLint completed;
+		glGetProgramiv(m_program, GL_COMPLETION_STATUS_KHR, &completed);
+
+		return completed == GL_TRUE;
+	}
+
 	bool Shader::IsValid() const
 	{
 		return m_program != 0;
@@ -311,11 +373,9 @@ namespace Nz
 
 	bool Shader::Link()
 	{
-		Context::EnsureContext();
+		BeginLinking();
 
-		glLinkProgram(m_program);
-
-		return PostLinkage();
+		return EndLinking();
 	}
 
 	bool Shader::LoadFromBinary(const void* buffer, unsigned int size)
@@ -358,6 +418,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, value))
+			return;
+
 		if (glProgramUniform1i)
 			glProgramUniform1i(m_program, location, value);
 		else
@@ -372,6 +435,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, color))
+			return;
+
 		Vector4f vecColor(color.r/255.f, color.g/255.f, color.b/255.f, color.a/255.f);
 
 		if (glProgramUniform4fv)
@@ -416,6 +482,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, value))
+			return;
+
 		if (glProgramUniform1f)
 			glProgramUniform1f(m_program, location, value);
 		else
@@ -444,6 +513,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, value))
+			return;
+
 		if (glProgramUniform1i)
 			glProgramUniform1i(m_program, location, value);
 		else
@@ -486,6 +558,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, matrix))
+			return;
+
 		if (glProgramUniformMatrix4fv)
 			glProgramUniformMatrix4fv(m_program, location, 1, GL_FALSE, matrix);
 		else
@@ -495,6 +570,20 @@ namespace Nz
 		}
 	}
 
+	void Shader::SendMatrixArray(int location, const Matrix4f* matrices, unsigned int count) const
+	{
+		if (location == -1)
+			return;
+
+		if (glProgramUniformMatrix4fv)
+			glProgramUniformMatrix4fv(m_program, location, count, GL_FALSE, reinterpret_cast<const float*>(matrices));
+		else
+		{
+			OpenGL::BindProgram(m_program);
+			glUniformMatrix4fv(location, count, GL_FALSE, reinterpret_cast<const float*>(matrices));
+		}
+	}
+
 	void Shader::SendVector(int location, const Vector2d& vector) const
 	{
 		if (location == -1)
@@ -514,6 +603,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform2fv)
 			glProgramUniform2fv(m_program, location, 1, vector);
 		else
@@ -528,6 +620,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform2fv)
 			glProgramUniform2iv(m_program, location, 1, vector);
 		else
@@ -556,6 +651,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform3fv)
 			glProgramUniform3fv(m_program, location, 1, vector);
 		else
@@ -570,6 +668,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform3iv)
 			glProgramUniform3iv(m_program, location, 1, vector);
 		else
@@ -598,6 +699,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform4fv)
 			glProgramUniform4fv(m_program, location, 1, vector);
 		else
@@ -612,6 +716,9 @@ namespace Nz
 		if (location == -1)
 			return;
 
+		if (!UpdateUniformCache(location, vector))
+			return;
+
 		if (glProgramUniform4iv)
 			glProgramUniform4iv(m_program, location, 1, vector);
 		else
@@ -747,6 +854,14 @@ namespace Nz
 		}
 	}
 
+	void Shader::SetUniformBlockBinding(int blockIndex, unsigned int bindingPoint) const
+	{
+		if (blockIndex == -1)
+			return;
+
+		glUniformBlockBinding(m_program, blockIndex, bindingPoint);
+	}
+
 	bool Shader::Validate() const
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -782,12 +897,32 @@ namespace Nz
 		return ShaderStage::IsSupported(stage);
 	}
 
+	template<typename T>
+	bool Shader::UpdateUniformCache(int location, const T& value) const
+	{
+		static_assert(sizeof(T) <= sizeof(UniformValue::data), "Uniform value is too big to be cached");
+
+		// Les valeurs des uniformes sont propres au programme, inutile de renvoyer ce qu'il possède déjà
+		UniformValue& cachedValue = m_uniformValues[location];
+		if (cachedValue.size == sizeof(T) && std::memcmp(cachedValue.data, &value, sizeof(T)) == 0)
+		{
+			Renderer::CountRedundantCall();
+			return false;
+		}
+
+		std::memcpy(cachedValue.data, &value, sizeof(T));
+		cachedValue.size = sizeof(T);
+
+		return true;
+	}
+
 	bool Shader::PostLinkage()
 	{
 		GLint success;
 		glGetProgramiv(m_program, GL_LINK_STATUS, &success);
 
 		m_linked = (success == GL_TRUE);
+		m_uniformValues.clear(); // L'édition des liens remet les uniformes à leur valeur par défaut
 		if (m_linked)
 		{
 			// Pour éviter de se tromper entre le nom et la constante
@@ -810,6 +945,12 @@ namespace Nz
 
 			#undef CacheUniform
 
+			// Le bloc ViewParameters est partagé par tous les programmes, le Renderer le met à jour une fois par vue
+			GLuint viewBlock = glGetUniformBlockIndex(m_program, "ViewParameters");
+			m_viewUniformBlock = (viewBlock != GL_INVALID_INDEX);
+			if (m_viewUniformBlock)
+				glUniformBlockBinding(m_program, viewBlock, UniformBufferBinding_View);
+
 			OnShaderUniformInvalidated(this);
 
 			return true;
@@ -11,6 +11,7 @@ namespace Nz
 {
 	ShaderStage::ShaderStage() :
 	m_compiled(false),
+	m_compiling(false),
 	m_id(0)
 	{
 	}
@@ -24,6 +25,7 @@ namespace Nz
 	ShaderStage::ShaderStage(ShaderStage&& stage) :
 	m_stage(stage.m_stage),
 	m_compiled(stage.m_compiled),
+	m_compiling(stage.m_compiling),
 	m_id(stage.m_id)
 	{
 		stage.m_id = 0;
@@ -34,29 +36,28 @@ namespace Nz
 		Destroy();
 	}
 
-	bool ShaderStage::Compile()
+	void ShaderStage::BeginCompilation()
 	{
 		#if NAZARA_RENDERER_SAFE
 		if (!m_id)
 		{
 			NazaraError("Shader stage is not initialized");
-			return false;
+			return;
 		}
 		#endif
 
+		// Le statut n'est pas demandé ici, ce qui permet au pilote de compiler en arrière-plan
 		glCompileShader(m_id);
 
-		GLint success;
-		glGetShaderiv(m_id, GL_COMPILE_STATUS, &success);
+		m_compiled = false;
+		m_compiling = true;
+	}
 
-		m_compiled = (success == GL_TRUE);
-		if (m_compiled)
-			return true;
-		else
-		{
-			NazaraError("Failed to compile shader stage: " + GetLog());
-			return false;
-		}
+	bool ShaderStage::Compile()
+	{
+		BeginCompilation();
+
+		return m_compiling && EndCompilation();
 	}
 
 	bool ShaderStage::Create(ShaderStageType stage)
@@ -72,6 +73,7 @@ namespace Nz
 	void ShaderStage::Destroy()
 	{
 		m_compiled = false;
+		m_compiling = false;
 		if (m_id)
 		{
 			glDeleteShader(m_id);
@@ -79,6 +81,31 @@ namespace Nz
 		}
 	}
 
+	bool ShaderStage::EndCompilation()
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!m_compiling)
+		{
+			NazaraError("Shader stage compilation has not been started");
+			return false;
+		}
+		#endif
+
+		m_compiling = false;
+
+		GLint success;
+		glGetShaderiv(m_id, GL_COMPILE_STATUS, &success);
+
+		m_compiled = (success == GL_TRUE);
+		if (m_compiled)
+			return true;
+		else
+		{
+			NazaraError("Failed to compile shader stage: " + GetLog());
+			return false;
+		}
+	}
+
 	String ShaderStage::GetLog() const
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -132,6 +159,11 @@ namespace Nz
 		return m_compiled;
 	}
 
+	bool ShaderStage::IsCompiling() const
+	{
+		return m_compiling;
+	}
+
 	bool ShaderStage::IsValid() const
 	{
 		return m_id != 0;
@@ -203,6 +235,7 @@ namespace Nz
 		Destroy();
 
 		m_compiled = shader.m_compiled;
+		m_compiling = shader.m_compiling;
 		m_id = shader.m_id;
 		m_stage = shader.m_stage;
 
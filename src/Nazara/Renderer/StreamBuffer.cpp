@@ -0,0 +1,171 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/StreamBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/HardwareBuffer.hpp>
+#include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		const GLuint64 s_fenceTimeout = 1000000000ULL; // 1s, in nanoseconds
+	}
+
+	// Positions are in bytes since the creation of the buffer (padding skipped at the end of the ring included),
+	// their remainder by the size of the buffer gives the offset in the buffer
+
+	StreamBuffer::StreamBuffer(BufferType type, unsigned int size) :
+	m_buffer(type),
+	m_fencedPosition(0),
+	m_releasedPosition(0),
+	m_writePosition(0),
+	m_size(size)
+	{
+		ErrorFlags flags(ErrorFlag_ThrowException, true);
+
+		m_buffer.Create(size, DataStorage_Hardware, BufferUsage_Dynamic);
+
+		// The ring already fences its frames, a persistent mapping doesn't need more than one region
+		HardwareBuffer* impl = static_cast<HardwareBuffer*>(m_buffer.GetImpl());
+		impl->SetRegionCount(1);
+	}
+
+	StreamBuffer::~StreamBuffer()
+	{
+		if (!m_frames.empty())
+		{
+			Context::EnsureContext();
+
+			for (Frame& frame : m_frames)
+				glDeleteSync(static_cast<GLsync>(frame.fence));
+		}
+	}
+
+	void StreamBuffer::EndFrame()
+	{
+		// Nothing written since the last fence
+		if (m_writePosition == m_fencedPosition)
+			return;
+
+		Context::EnsureContext();
+
+		Frame frame;
+		frame.endPosition = m_writePosition;
+		frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_frames.push_back(frame);
+		m_fencedPosition = m_writePosition;
+	}
+
+	Buffer* StreamBuffer::GetBuffer()
+	{
+		return &m_buffer;
+	}
+
+	const Buffer* StreamBuffer::GetBuffer() const
+	{
+		return &m_buffer;
+	}
+
+	unsigned int StreamBuffer::GetSize() const
+	{
+		return m_size;
+	}
+
+	void* StreamBuffer::Map(unsigned int size, unsigned int alignment, unsigned int* offset)
+	{
+		NazaraAssert(size > 0 && size <= m_size, "Invalid size");
+		NazaraAssert(alignment > 0, "Invalid alignment");
+		NazaraAssert(offset, "Invalid offset pointer");
+
+		unsigned int writeOffset = static_cast<unsigned int>(m_writePosition % m_size);
+		unsigned int allocationOffset = ((writeOffset + alignment - 1) / alignment) * alignment;
+
+		// The allocation has to be contiguous, skip the end of the buffer if it doesn't fit
+		UInt64 position;
+		if (allocationOffset > m_size - size)
+		{
+			position = m_writePosition + (m_size - writeOffset);
+			allocationOffset = 0;
+		}
+		else
+			position = m_writePosition + (allocationOffset - writeOffset);
+
+		UInt64 endPosition = position + size;
+		while (endPosition - m_releasedPosition > m_size)
+		{
+			if (m_frames.empty())
+			{
+				// The GPU doesn't use anything anymore, the allocation can start anywhere
+				if (m_releasedPosition == m_writePosition)
+				{
+					m_releasedPosition = position;
+					break;
+				}
+
+				// The current frame itself went around the ring, we have to wait for the GPU to catch up
+				EndFrame();
+			}
+
+			WaitForOldestFrame();
+		}
+
+		m_writePosition = endPosition;
+
+		*offset = allocationOffset;
+
+		// Writes go straight to GPU-visible memory when the buffer is persistently mapped
+		HardwareBuffer* impl = static_cast<HardwareBuffer*>(m_buffer.GetImpl());
+		if (impl->IsPersistent())
+			return impl->GetPersistentPointer() + allocationOffset;
+
+		Context::EnsureContext();
+
+		impl->Bind();
+
+		// Synchronization was done by us
+		void* ptr = glMapBufferRange(OpenGL::BufferTarget[m_buffer.GetType()], allocationOffset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (!ptr)
+		{
+			NazaraError("Failed to map stream buffer (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+			return nullptr;
+		}
+
+		return ptr;
+	}
+
+	void StreamBuffer::Unmap()
+	{
+		HardwareBuffer* impl = static_cast<HardwareBuffer*>(m_buffer.GetImpl());
+		if (impl->IsPersistent())
+			return; // Coherent mapping, nothing to flush
+
+		Context::EnsureContext();
+
+		impl->Unmap();
+	}
+
+	void StreamBuffer::WaitForOldestFrame()
+	{
+		Frame& frame = m_frames.front();
+		GLsync fence = static_cast<GLsync>(frame.fence);
+
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_fenceTimeout);
+		while (result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, 0, s_fenceTimeout);
+
+		if (result == GL_WAIT_FAILED)
+			NazaraError("Failed to wait for stream buffer fence (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+
+		glDeleteSync(fence);
+
+		m_releasedPosition = frame.endPosition;
+		m_frames.pop_front();
+	}
+}
@@ -6,18 +6,24 @@
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
 #include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/GpuMemory.hpp>
 #include <Nazara/Renderer/Renderer.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Renderer/TextureSampler.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
 #include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 #include <Nazara/Renderer/Debug.hpp>
 
 namespace Nz
 {
 	struct TextureImpl
 	{
+		std::vector<std::pair<GLuint, GLuint64>> bindlessHandles; // Par sampler
 		GLuint id;
 		ImageType type;
 		PixelFormatType format;
@@ -203,6 +209,8 @@ namespace Nz
 			return false;
 		}
 
+		GpuMemory::Allocate(this, GpuMemoryCategory_Texture, GetMemoryUsage());
+
 		onExit.Reset();
 		return true;
 	}
@@ -214,7 +222,12 @@ namespace Nz
 			OnTextureDestroy(this);
 
 			Context::EnsureContext();
+
+			for (const auto& pair : m_impl->bindlessHandles)
+				glMakeTextureHandleNonResidentARB(pair.second);
+
 			OpenGL::DeleteTexture(m_impl->id);
+			GpuMemory::Free(this);
 
 			delete m_impl;
 			m_impl = nullptr;
@@ -279,6 +292,8 @@ namespace Nz
 			///FIXME: Est-ce que cette opération est seulement possible ?
 			m_impl->levelCount = Image::GetMaxLevel(m_impl->width, m_impl->height, m_impl->depth);
 			SetMipmapRange(0, m_impl->levelCount-1);
+
+			GpuMemory::Allocate(this, GpuMemoryCategory_Texture, GetMemoryUsage());
 		}
 
 		if (!m_impl->mipmapping && enable)
@@ -374,29 +389,11 @@ namespace Nz
 		}
 		#endif
 
-		unsigned int width = m_impl->width;
-		unsigned int height = m_impl->height;
-		unsigned int depth = m_impl->depth;
-
-		unsigned int size = 0;
-		for (unsigned int i = 0; i < m_impl->levelCount; ++i)
-		{
-			size += width * height * depth;
-
-			if (width > 1)
-				width >>= 1;
-
-			if (height > 1)
-				height >>= 1;
-
-			if (depth > 1)
-				depth >>= 1;
-		}
-
-		if (m_impl->type == ImageType_Cubemap)
-			size *= 6;
+		std::size_t size = 0;
+		for (UInt8 level = 0; level < m_impl->levelCount; ++level)
+			size += GetMemoryUsage(level);
 
-		return size * PixelFormat::GetBytesPerPixel(m_impl->format);
+		return size;
 	}
 
 	std::size_t Texture::GetMemoryUsage(UInt8 level) const
@@ -415,10 +412,26 @@ namespace Nz
 		}
 		#endif
 
-		return (GetLevelSize(m_impl->width, level)) *
-			   (GetLevelSize(m_impl->height, level)) *
-			   ((m_impl->type == ImageType_Cubemap) ? 6 : GetLevelSize(m_impl->depth, level)) *
-			   PixelFormat::GetBytesPerPixel(m_impl->format);
+		// Les couches d'un tableau (la hauteur d'un tableau 1D, la profondeur d'un tableau 2D) ne sont pas réduites par les niveaux
+		unsigned int width = GetLevelSize(m_impl->width, level);
+		unsigned int height = (m_impl->type == ImageType_1D_Array) ? m_impl->height : GetLevelSize(m_impl->height, level);
+		unsigned int depth;
+		switch (m_impl->type)
+		{
+			case ImageType_2D_Array:
+				depth = m_impl->depth;
+				break;
+
+			case ImageType_Cubemap:
+				depth = 6;
+				break;
+
+			default:
+				depth = GetLevelSize(m_impl->depth, level);
+				break;
+		}
+
+		return PixelFormat::ComputeSize(m_impl->format, width, height, depth);
 	}
 
 	Vector3ui Texture::GetSize(UInt8 level) const
@@ -473,6 +486,12 @@ namespace Nz
 		return m_impl->levelCount > 1;
 	}
 
+	bool Texture::HasPendingUploads() const
+	{
+		// Ne nécessite pas une texture valide, une texture détruite peut encore attendre ses envois
+		return m_pendingUploads > 0;
+	}
+
 	void Texture::InvalidateMipmaps()
 	{
 		#if NAZARA_RENDERER_SAFE
@@ -493,6 +512,20 @@ namespace Nz
 
 	bool Texture::LoadFromFile(const String& filePath, const ImageParams& params, bool generateMipmaps)
 	{
+		// Files already in a format the GPU understands are uploaded from their mapping, without an intermediate image
+		File file(filePath);
+		if (file.Open(OpenMode_ReadOnly))
+		{
+			ErrorFlags flags(ErrorFlag_Silent);
+
+			const void* data = file.Map();
+			if (data && LoadFromView(data, static_cast<std::size_t>(file.GetSize()), params, generateMipmaps))
+			{
+				SetFilePath(filePath);
+				return true;
+			}
+		}
+
 		Image image;
 		if (!image.LoadFromFile(filePath, params))
 		{
@@ -543,9 +576,61 @@ namespace Nz
 			}
 		}
 
-		ImageType type = newImage.GetType();
-		UInt8 levelCount = newImage.GetLevelCount();
-		if (!Create(type, format, newImage.GetWidth(), newImage.GetHeight(), newImage.GetDepth(), (generateMipmaps) ? 0xFF : levelCount))
+		ImageView view;
+		view.type = newImage.GetType();
+		view.format = format;
+		view.width = newImage.GetWidth();
+		view.height = newImage.GetHeight();
+		view.depth = newImage.GetDepth();
+
+		for (UInt8 level = 0; level < newImage.GetLevelCount(); ++level)
+			view.levels.push_back(newImage.GetConstPixels(0, 0, 0, level));
+
+		if (!LoadFromView(view, generateMipmaps))
+			return false;
+
+		// Keep resource path info
+		SetFilePath(image.GetFilePath());
+
+		return true;
+	}
+
+	bool Texture::LoadFromMemory(const void* data, std::size_t size, const ImageParams& params, bool generateMipmaps)
+	{
+		{
+			ErrorFlags flags(ErrorFlag_Silent);
+			if (LoadFromView(data, size, params, generateMipmaps))
+				return true;
+		}
+
+		Image image;
+		if (!image.LoadFromMemory(data, size, params))
+		{
+			NazaraError("Failed to load image");
+			return false;
+		}
+
+		return LoadFromImage(image, generateMipmaps);
+	}
+
+	bool Texture::LoadFromView(const ImageView& view, bool generateMipmaps)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (view.levels.empty())
+		{
+			NazaraError("View must have at least one level");
+			return false;
+		}
+
+		if (!IsFormatSupported(view.format))
+		{
+			NazaraError("Format " + PixelFormat::GetName(view.format) + " not supported");
+			return false;
+		}
+		#endif
+
+		UInt8 levelCount = static_cast<UInt8>(view.levels.size());
+		if (!Create(view.type, view.format, view.width, view.height, view.depth, (generateMipmaps) ? 0xFF : levelCount))
 		{
 			NazaraError("Failed to create texture");
 			return false;
@@ -556,13 +641,17 @@ namespace Nz
 			Destroy();
 		});
 
-		if (type == ImageType_Cubemap)
+		if (view.type == ImageType_Cubemap)
 		{
 			for (UInt8 level = 0; level < levelCount; ++level)
 			{
+				unsigned int width = GetWidth(level);
+				unsigned int height = GetHeight(level);
+				std::size_t faceSize = PixelFormat::ComputeSize(view.format, width, height, 1);
+
 				for (unsigned int i = 0; i <= CubemapFace_Max; ++i)
 				{
-					if (!Update(newImage.GetConstPixels(0, 0, i, level), Rectui(0, 0, newImage.GetWidth(level), newImage.GetHeight(level)), i, level))
+					if (!Update(view.levels[level] + i*faceSize, Rectui(0, 0, width, height), i, level))
 					{
 						NazaraError("Failed to update texture");
 						return false;
@@ -574,7 +663,7 @@ namespace Nz
 		{
 			for (UInt8 level = 0; level < levelCount; ++level)
 			{
-				if (!Update(newImage.GetConstPixels(0, 0, 0, level), level))
+				if (!Update(view.levels[level], level))
 				{
 					NazaraError("Failed to update texture");
 					return false;
@@ -582,26 +671,11 @@ namespace Nz
 			}
 		}
 
-		// Keep resource path info
-		SetFilePath(image.GetFilePath());
-
 		destroyOnExit.Reset();
 
 		return true;
 	}
 
-	bool Texture::LoadFromMemory(const void* data, std::size_t size, const ImageParams& params, bool generateMipmaps)
-	{
-		Image image;
-		if (!image.LoadFromMemory(data, size, params))
-		{
-			NazaraError("Failed to load image");
-			return false;
-		}
-
-		return LoadFromImage(image, generateMipmaps);
-	}
-
 	bool Texture::LoadFromStream(Stream& stream, const ImageParams& params, bool generateMipmaps)
 	{
 		Image image;
@@ -872,6 +946,12 @@ namespace Nz
 			NazaraError("Minimum level cannot be greater than maximum level (" + String::Number(minLevel) + " < " + String::Number(maxLevel) + ')');
 			return false;
 		}
+
+		if (!m_impl->bindlessHandles.empty())
+		{
+			NazaraError("Texture parameters cannot change once a bindless handle was created");
+			return false;
+		}
 		#endif
 
 		OpenGL::BindTexture(m_impl->type, m_impl->id);
@@ -1010,72 +1090,55 @@ namespace Nz
 		}
 		#endif
 
-		OpenGL::Format format;
-		if (!OpenGL::TranslateFormat(m_impl->format, &format, OpenGL::FormatType_Texture))
-		{
-			NazaraError("Failed to get OpenGL format");
-			return false;
-		}
+		return UpdateLevel(pixels, box, srcWidth, srcHeight, level);
+	}
 
-		SetUnpackAlignement(PixelFormat::GetBytesPerPixel(m_impl->format));
-		glPixelStorei(GL_UNPACK_ROW_LENGTH, srcWidth);
-		glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, srcHeight);
+	bool Texture::Update(const UInt8* pixels, const Rectui& rect, unsigned int z, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		return Update(pixels, Boxui(rect.x, rect.y, z, rect.width, rect.height, 1), srcWidth, srcHeight, level);
+	}
 
-		OpenGL::BindTexture(m_impl->type, m_impl->id);
+	UInt64 Texture::GetBindlessHandle(const TextureSampler& sampler) const
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Texture must be valid");
+			return 0;
+		}
 
-		if (PixelFormat::IsCompressed(m_impl->format))
+		if (!OpenGL::IsSupported(OpenGLExtension_BindlessTexture))
 		{
-			switch (m_impl->type)
-			{
-				case ImageType_1D:
-					glCompressedTexSubImage1D(GL_TEXTURE_1D, level, box.x, box.width, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, 1, 1), pixels);
-					break;
+			NazaraError("Bindless textures are not supported");
+			return 0;
+		}
+		#endif
 
-				case ImageType_1D_Array:
-				case ImageType_2D:
-					glCompressedTexSubImage2D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.width, box.height, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, 1), pixels);
-					break;
+		// La texture n'est jamais liée à une unité, le Renderer ne peut donc pas mettre à jour ses mipmaps
+		EnsureMipmapsUpdate();
 
-				case ImageType_2D_Array:
-				case ImageType_3D:
-					glCompressedTexSubImage3D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.z, box.width, box.height, box.depth, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, box.depth), pixels);
-					break;
+		TextureSampler textureSampler(sampler);
+		textureSampler.UseMipmaps(m_impl->levelCount > 1);
 
-				case ImageType_Cubemap:
-					glCompressedTexSubImage2D(OpenGL::CubemapFace[box.z], level, box.x, box.y, box.width, box.height, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, box.depth), pixels);
-					break;
-			}
-		}
-		else
+		GLuint samplerId = textureSampler.GetOpenGLID();
+		for (const auto& pair : m_impl->bindlessHandles)
 		{
-			switch (m_impl->type)
-			{
-				case ImageType_1D:
-					glTexSubImage1D(GL_TEXTURE_1D, level, box.x, box.width, format.dataFormat, format.dataType, pixels);
-					break;
-
-				case ImageType_1D_Array:
-				case ImageType_2D:
-					glTexSubImage2D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.width, box.height, format.dataFormat, format.dataType, pixels);
-					break;
-
-				case ImageType_2D_Array:
-				case ImageType_3D:
-					glTexSubImage3D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.z, box.width, box.height, box.depth, format.dataFormat, format.dataType, pixels);
-					break;
+			if (pair.first == samplerId)
+				return pair.second;
+		}
 
-				case ImageType_Cubemap:
-					glTexSubImage2D(OpenGL::CubemapFace[box.z], level, box.x, box.y, box.width, box.height, format.dataFormat, format.dataType, pixels);
-					break;
-			}
+		GLuint64 handle = glGetTextureSamplerHandleARB(m_impl->id, samplerId);
+		if (!handle)
+		{
+			NazaraError("Failed to get bindless handle (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+			return 0;
 		}
 
-		return true;
-	}
+		// Le handle reste résident jusqu'à la destruction de la texture, les paramètres de celle-ci sont alors figés
+		glMakeTextureHandleResidentARB(handle);
+		m_impl->bindlessHandles.emplace_back(samplerId, handle);
 
-	bool Texture::Update(const UInt8* pixels, const Rectui& rect, unsigned int z, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
-	{
-		return Update(pixels, Boxui(rect.x, rect.y, z, rect.width, rect.height, 1), srcWidth, srcHeight, level);
+		return handle;
 	}
 
 	unsigned int Texture::GetOpenGLID() const
@@ -1165,6 +1228,15 @@ namespace Nz
 			case PixelFormatType_DXT5:
 				return OpenGL::IsSupported(OpenGLExtension_TextureCompression_s3tc);
 
+			case PixelFormatType_BC5:
+				return OpenGL::GetVersion() >= 300;
+
+			case PixelFormatType_BC7:
+				return OpenGL::GetVersion() >= 420;
+
+			case PixelFormatType_ETC2:
+				return OpenGL::GetVersion() >= 430;
+
 			case PixelFormatType_Undefined:
 				break;
 		}
@@ -1318,6 +1390,80 @@ namespace Nz
 		return true;
 	}
 
+	bool Texture::LoadFromView(const void* data, std::size_t size, const ImageParams& params, bool generateMipmaps)
+	{
+		ImageView view;
+		if (!Image::LoadViewFromMemory(&view, data, size, params) || !IsFormatSupported(view.format))
+			return false;
+
+		return LoadFromView(view, generateMipmaps);
+	}
+
+	bool Texture::UpdateLevel(const void* source, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		OpenGL::Format format;
+		if (!OpenGL::TranslateFormat(m_impl->format, &format, OpenGL::FormatType_Texture))
+		{
+			NazaraError("Failed to get OpenGL format");
+			return false;
+		}
+
+		SetUnpackAlignement(PixelFormat::GetBytesPerPixel(m_impl->format));
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, srcWidth);
+		glPixelStorei(GL_UNPACK_IMAGE_HEIGHT, srcHeight);
+
+		OpenGL::BindTexture(m_impl->type, m_impl->id);
+
+		if (PixelFormat::IsCompressed(m_impl->format))
+		{
+			switch (m_impl->type)
+			{
+				case ImageType_1D:
+					glCompressedTexSubImage1D(GL_TEXTURE_1D, level, box.x, box.width, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, 1, 1), source);
+					break;
+
+				case ImageType_1D_Array:
+				case ImageType_2D:
+					glCompressedTexSubImage2D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.width, box.height, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, 1), source);
+					break;
+
+				case ImageType_2D_Array:
+				case ImageType_3D:
+					glCompressedTexSubImage3D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.z, box.width, box.height, box.depth, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, box.depth), source);
+					break;
+
+				case ImageType_Cubemap:
+					glCompressedTexSubImage2D(OpenGL::CubemapFace[box.z], level, box.x, box.y, box.width, box.height, format.internalFormat, PixelFormat::ComputeSize(m_impl->format, box.width, box.height, box.depth), source);
+					break;
+			}
+		}
+		else
+		{
+			switch (m_impl->type)
+			{
+				case ImageType_1D:
+					glTexSubImage1D(GL_TEXTURE_1D, level, box.x, box.width, format.dataFormat, format.dataType, source);
+					break;
+
+				case ImageType_1D_Array:
+				case ImageType_2D:
+					glTexSubImage2D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.width, box.height, format.dataFormat, format.dataType, source);
+					break;
+
+				case ImageType_2D_Array:
+				case ImageType_3D:
+					glTexSubImage3D(OpenGL::TextureTarget[m_impl->type], level, box.x, box.y, box.z, box.width, box.height, box.depth, format.dataFormat, format.dataType, source);
+					break;
+
+				case ImageType_Cubemap:
+					glTexSubImage2D(OpenGL::CubemapFace[box.z], level, box.x, box.y, box.width, box.height, format.dataFormat, format.dataType, source);
+					break;
+			}
+		}
+
+		return true;
+	}
+
 	bool Texture::Initialize()
 	{
 		if (!TextureLibrary::Initialize())
@@ -1342,6 +1488,8 @@ namespace Nz
 	}
 
 	TextureLibrary::LibraryMap Texture::s_library;
+	TextureManager::ManagerCache Texture::s_managerCache;
+	TextureManager::ManagerLoads Texture::s_managerLoads;
 	TextureManager::ManagerMap Texture::s_managerMap;
 	TextureManager::ManagerParams Texture::s_managerParameters;
 }
@@ -0,0 +1,333 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/TextureStreamer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Renderer/TextureUploadQueue.hpp>
+#include <algorithm>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Majorant du remplissage ajouté par la queue d'envoi pour aligner chaque région
+		const unsigned int s_regionPadding = 16;
+	}
+
+	TextureStreamer::TextureStreamer(TextureUploadQueue& uploadQueue, UInt64 memoryBudget, unsigned int minResidentSize) :
+	m_uploadQueue(uploadQueue),
+	m_frame(1),
+	m_memoryBudget(memoryBudget),
+	m_memoryUsage(0),
+	m_minResidentSize(minResidentSize)
+	{
+		NazaraAssert(minResidentSize > 0, "Invalid minimum resident size");
+	}
+
+	TextureStreamer::~TextureStreamer() = default;
+
+	bool TextureStreamer::Add(Texture* texture, const Image& image)
+	{
+		NazaraAssert(texture, "Invalid texture");
+
+		#if NAZARA_RENDERER_SAFE
+		if (!image.IsValid())
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+		#endif
+
+		LockGuard lock(m_mutex);
+
+		if (m_entries.find(texture) != m_entries.end())
+		{
+			NazaraError("Texture is already streamed");
+			return false;
+		}
+
+		Entry entry;
+		entry.image = image;
+		entry.texture = texture;
+		entry.lastRequest = 0;
+		entry.resolution = 0.f;
+
+		// Le niveau toujours résident est le premier à tenir dans la taille minimale
+		UInt8 level = 0;
+		while (level + 1 < image.GetLevelCount() && std::max(image.GetWidth(level), image.GetHeight(level)) > m_minResidentSize)
+			level++;
+
+		entry.coarsestLevel = level;
+		entry.pendingLevel = level;
+
+		// Les niveaux grossiers sont petits, ils sont envoyés immédiatement pour que la texture soit utilisable
+		if (!Rebuild(entry, level))
+		{
+			NazaraError("Failed to create texture resident levels");
+			return false;
+		}
+
+		m_memoryUsage += ComputeMemoryUsage(image, level);
+
+		entry.textureDestroySlot.Connect(texture->OnTextureDestroy, this, &TextureStreamer::OnTextureInvalidation);
+		entry.textureReleaseSlot.Connect(texture->OnTextureRelease, this, &TextureStreamer::OnTextureInvalidation);
+
+		m_entries.insert(std::make_pair(texture, std::move(entry)));
+
+		return true;
+	}
+
+	UInt64 TextureStreamer::GetMemoryBudget() const
+	{
+		return m_memoryBudget;
+	}
+
+	UInt64 TextureStreamer::GetMemoryUsage() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_memoryUsage;
+	}
+
+	unsigned int TextureStreamer::GetMinResidentSize() const
+	{
+		return m_minResidentSize;
+	}
+
+	UInt8 TextureStreamer::GetResidentLevel(const Texture* texture) const
+	{
+		LockGuard lock(m_mutex);
+
+		auto it = m_entries.find(texture);
+		if (it == m_entries.end())
+			return 0;
+
+		return it->second.residentLevel;
+	}
+
+	std::size_t TextureStreamer::GetTextureCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_entries.size();
+	}
+
+	bool TextureStreamer::IsStreamed(const Texture* texture) const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_entries.find(texture) != m_entries.end();
+	}
+
+	void TextureStreamer::Remove(const Texture* texture)
+	{
+		LockGuard lock(m_mutex);
+
+		auto it = m_entries.find(texture);
+		if (it == m_entries.end())
+			return;
+
+		// La texture garde ses niveaux actuels, seul le suivi s'arrête
+		Entry& entry = it->second;
+		m_memoryUsage -= ComputeMemoryUsage(entry.image, entry.residentLevel);
+		if (entry.pendingTexture)
+			m_memoryUsage -= ComputeMemoryUsage(entry.image, entry.pendingLevel);
+
+		m_entries.erase(it);
+	}
+
+	void TextureStreamer::RequestResolution(const Texture* texture, float resolution)
+	{
+		LockGuard lock(m_mutex);
+
+		auto it = m_entries.find(texture);
+		if (it == m_entries.end())
+			return;
+
+		// On garde la plus grande résolution demandée pendant la frame
+		Entry& entry = it->second;
+		if (entry.lastRequest != m_frame)
+		{
+			entry.lastRequest = m_frame;
+			entry.resolution = resolution;
+		}
+		else
+			entry.resolution = std::max(entry.resolution, resolution);
+	}
+
+	void TextureStreamer::SetMemoryBudget(UInt64 memoryBudget)
+	{
+		LockGuard lock(m_mutex);
+
+		m_memoryBudget = memoryBudget;
+	}
+
+	void TextureStreamer::Update()
+	{
+		LockGuard lock(m_mutex);
+
+		// Les textures dont les niveaux fins ont fini d'être envoyés les reçoivent
+		for (auto& pair : m_entries)
+		{
+			Entry& entry = pair.second;
+			if (entry.pendingTexture && !entry.pendingTexture->HasPendingUploads())
+			{
+				m_memoryUsage -= ComputeMemoryUsage(entry.image, entry.residentLevel);
+
+				// L'objet Texture reste le même pour les matériaux, seul son stockage change
+				std::swap(entry.texture->m_impl, entry.pendingTexture->m_impl);
+				entry.pendingTexture.Reset();
+				entry.residentLevel = entry.pendingLevel;
+			}
+		}
+
+		m_candidates.clear();
+		for (auto& pair : m_entries)
+		{
+			Entry& entry = pair.second;
+			if (entry.pendingTexture || entry.lastRequest != m_frame)
+				continue;
+
+			UInt8 level = ComputeLevel(entry, entry.resolution);
+
+			// Un envoi doit tenir dans la mémoire de transit
+			while (level < entry.residentLevel && ComputeMemoryUsage(entry.image, level) + (entry.image.GetLevelCount() - level) * 6 * s_regionPadding > m_uploadQueue.GetStagingSize())
+				level++;
+
+			if (level < entry.residentLevel)
+			{
+				entry.pendingLevel = level;
+				m_candidates.push_back(&entry);
+			}
+		}
+
+		// Les textures les plus éloignées de la résolution demandée passent en premier
+		std::sort(m_candidates.begin(), m_candidates.end(), [] (const Entry* lhs, const Entry* rhs)
+		{
+			return lhs->residentLevel - lhs->pendingLevel > rhs->residentLevel - rhs->pendingLevel;
+		});
+
+		for (Entry* entry : m_candidates)
+		{
+			UInt64 memoryUsage = ComputeMemoryUsage(entry->image, entry->pendingLevel);
+
+			// L'ancien stockage est conservé jusqu'à la fin de l'envoi, il faut de la place pour les deux
+			// On libère les niveaux fins des textures demandées le moins récemment
+			while (m_memoryUsage + memoryUsage > m_memoryBudget)
+			{
+				Entry* victim = nullptr;
+				UInt8 victimLevel = 0;
+				for (auto& pair : m_entries)
+				{
+					Entry& other = pair.second;
+					if (other.pendingTexture || &other == entry)
+						continue;
+
+					// Une texture encore demandée ne descend que jusqu'à la résolution voulue
+					UInt8 level = (other.lastRequest == m_frame) ? ComputeLevel(other, other.resolution) : other.coarsestLevel;
+					if (level <= other.residentLevel)
+						continue;
+
+					if (!victim || other.lastRequest < victim->lastRequest)
+					{
+						victim = &other;
+						victimLevel = level;
+					}
+				}
+
+				if (!victim)
+					break;
+
+				UInt64 victimUsage = ComputeMemoryUsage(victim->image, victim->residentLevel);
+				if (!Rebuild(*victim, victimLevel))
+					break;
+
+				m_memoryUsage -= victimUsage;
+				m_memoryUsage += ComputeMemoryUsage(victim->image, victimLevel);
+			}
+
+			if (m_memoryUsage + memoryUsage > m_memoryBudget)
+				break;
+
+			Vector3ui size = entry->image.GetSize(entry->pendingLevel);
+
+			TextureRef texture = Texture::New();
+			if (!texture->Create(entry->image.GetType(), entry->image.GetFormat(), size.x, size.y, size.z, entry->image.GetLevelCount() - entry->pendingLevel))
+			{
+				NazaraError("Failed to create streamed texture");
+				continue;
+			}
+
+			// La mémoire de transit est pleine, on réessaiera à la prochaine mise à jour
+			if (!m_uploadQueue.Enqueue(texture, entry->image, entry->pendingLevel))
+				break;
+
+			entry->pendingTexture = std::move(texture);
+			m_memoryUsage += memoryUsage;
+		}
+
+		m_frame++;
+	}
+
+	UInt8 TextureStreamer::ComputeLevel(const Entry& entry, float resolution) const
+	{
+		// Le niveau le plus grossier dont la taille couvre encore la résolution demandée
+		UInt8 level = entry.coarsestLevel;
+		while (level > 0 && std::max(entry.image.GetWidth(level), entry.image.GetHeight(level)) < resolution)
+			level--;
+
+		return level;
+	}
+
+	void TextureStreamer::OnTextureInvalidation(const Texture* texture)
+	{
+		Remove(texture);
+	}
+
+	bool TextureStreamer::Rebuild(Entry& entry, UInt8 level)
+	{
+		const Image& image = entry.image;
+		Vector3ui size = image.GetSize(level);
+
+		TextureRef texture = Texture::New();
+		if (!texture->Create(image.GetType(), image.GetFormat(), size.x, size.y, size.z, image.GetLevelCount() - level))
+		{
+			NazaraError("Failed to create texture");
+			return false;
+		}
+
+		bool cubemap = (image.GetType() == ImageType_Cubemap);
+		for (UInt8 i = level; i < image.GetLevelCount(); ++i)
+		{
+			unsigned int sliceCount = (cubemap) ? 6 : 1;
+			unsigned int depth = (cubemap) ? 1 : image.GetDepth(i);
+
+			for (unsigned int slice = 0; slice < sliceCount; ++slice)
+			{
+				if (!texture->Update(image.GetConstPixels(0, 0, slice, i), Boxui(0, 0, slice, image.GetWidth(i), image.GetHeight(i), depth), 0, 0, i - level))
+				{
+					NazaraError("Failed to update texture level #" + String::Number(i - level));
+					return false;
+				}
+			}
+		}
+
+		// L'ancien stockage est détruit avec la texture temporaire
+		std::swap(entry.texture->m_impl, texture->m_impl);
+		entry.residentLevel = level;
+
+		return true;
+	}
+
+	UInt64 TextureStreamer::ComputeMemoryUsage(const Image& image, UInt8 firstLevel)
+	{
+		UInt64 memoryUsage = 0;
+		for (UInt8 level = firstLevel; level < image.GetLevelCount(); ++level)
+			memoryUsage += image.GetMemoryUsage(level);
+
+		return memoryUsage;
+	}
+}
@@ -0,0 +1,452 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/TextureUploadQueue.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/OpenGL.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Suffisant pour l'alignement de tous les formats de pixels
+		const unsigned int s_stagingAlignment = 16;
+
+		unsigned int ComputeRegionSize(PixelFormatType format, const Boxui& box)
+		{
+			return static_cast<unsigned int>(PixelFormat::ComputeSize(format, box.width, box.height, box.depth));
+		}
+	}
+
+	// Comme pour StreamBuffer, les positions sont en octets depuis la création de la queue
+	// et leur reste par la taille du ring donne l'offset dans la mémoire de transit
+
+	TextureUploadQueue::TextureUploadQueue(unsigned int stagingSize, unsigned int frameBudget) :
+	m_stagingPtr(nullptr),
+	m_releasedPosition(0),
+	m_writePosition(0),
+	m_bufferId(0),
+	m_frameBudget(frameBudget),
+	m_stagingSize(stagingSize)
+	{
+		NazaraAssert(stagingSize > 0, "Invalid staging size");
+
+		Context::EnsureContext();
+
+		// Avec ARB_buffer_storage, le PBO reste mappé et les threads y écrivent directement
+		if (OpenGL::IsSupported(OpenGLExtension_BufferStorage))
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glGenBuffers(1, &m_bufferId);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_bufferId);
+			glBufferStorage(GL_PIXEL_UNPACK_BUFFER, stagingSize, nullptr, flags);
+
+			m_stagingPtr = static_cast<UInt8*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, stagingSize, flags));
+			if (!m_stagingPtr)
+			{
+				NazaraWarning("Failed to map texture upload buffer (OpenGL error : 0x" + String::Number(glGetError(), 16) + "), falling back to client memory");
+
+				glDeleteBuffers(1, &m_bufferId);
+				m_bufferId = 0;
+			}
+
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		if (!m_bufferId)
+		{
+			m_clientMemory.resize(stagingSize);
+			m_stagingPtr = m_clientMemory.data();
+		}
+	}
+
+	TextureUploadQueue::~TextureUploadQueue()
+	{
+		Context::EnsureContext();
+
+		for (Batch& batch : m_batches)
+		{
+			glDeleteSync(static_cast<GLsync>(batch.fence));
+
+			for (TextureRef& texture : batch.textures)
+				texture->m_pendingUploads--;
+		}
+
+		for (Upload& upload : m_uploads)
+			upload.texture->m_pendingUploads--;
+
+		if (m_bufferId)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_bufferId);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			glDeleteBuffers(1, &m_bufferId);
+		}
+	}
+
+	bool TextureUploadQueue::Enqueue(Texture* texture, const Image& image, UInt8 baseLevel)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!texture || !texture->IsValid())
+		{
+			NazaraError("Texture must be valid");
+			return false;
+		}
+
+		if (!image.IsValid())
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+
+		if (image.GetFormat() != texture->GetFormat())
+		{
+			NazaraError("Image format does not match texture format");
+			return false;
+		}
+
+		if (baseLevel >= image.GetLevelCount())
+		{
+			NazaraError("Base level out of image bounds (" + String::Number(baseLevel) + " >= " + String::Number(image.GetLevelCount()) + ')');
+			return false;
+		}
+
+		if (image.GetType() != texture->GetType() || image.GetSize(baseLevel) != texture->GetSize())
+		{
+			NazaraError("Image size does not match texture size");
+			return false;
+		}
+		#endif
+
+		// Tous les niveaux sont envoyés ensemble, la texture n'est jamais partiellement remplie
+		// Le niveau baseLevel de l'image devient le niveau 0 de la texture
+		bool cubemap = (texture->GetType() == ImageType_Cubemap);
+		UInt8 levelCount = std::min<UInt8>(image.GetLevelCount() - baseLevel, texture->GetLevelCount());
+
+		std::vector<UploadRegion> regions;
+		for (UInt8 level = 0; level < levelCount; ++level)
+		{
+			unsigned int width = image.GetWidth(baseLevel + level);
+			unsigned int height = image.GetHeight(baseLevel + level);
+
+			// Les faces d'un cubemap sont envoyées une par une
+			unsigned int sliceCount = (cubemap) ? 6 : 1;
+			unsigned int depth = (cubemap) ? 1 : image.GetDepth(baseLevel + level);
+
+			for (unsigned int slice = 0; slice < sliceCount; ++slice)
+			{
+				UploadRegion region;
+				region.pixels = image.GetConstPixels(0, 0, slice, baseLevel + level);
+				region.box = Boxui(0, 0, slice, width, height, depth);
+				region.level = level;
+				region.srcHeight = 0;
+				region.srcWidth = 0;
+
+				regions.push_back(region);
+			}
+		}
+
+		return EnqueueRegions(texture, regions.data(), regions.size());
+	}
+
+	bool TextureUploadQueue::Enqueue(Texture* texture, const UInt8* pixels, const Boxui& box, unsigned int srcWidth, unsigned int srcHeight, UInt8 level)
+	{
+		#if NAZARA_RENDERER_SAFE
+		if (!texture || !texture->IsValid())
+		{
+			NazaraError("Texture must be valid");
+			return false;
+		}
+
+		if (!pixels)
+		{
+			NazaraError("Invalid pixel source");
+			return false;
+		}
+
+		if (!box.IsValid())
+		{
+			NazaraError("Invalid box");
+			return false;
+		}
+
+		if (level >= texture->GetLevelCount())
+		{
+			NazaraError("Level out of bounds (" + String::Number(level) + " >= " + String::Number(texture->GetLevelCount()) + ')');
+			return false;
+		}
+
+		bool cubemap = (texture->GetType() == ImageType_Cubemap);
+		unsigned int depth = (cubemap) ? 6 : texture->GetDepth(level);
+		if (box.x + box.width > texture->GetWidth(level) || box.y + box.height > texture->GetHeight(level) || box.z + box.depth > depth || (cubemap && box.depth > 1))
+		{
+			NazaraError("Cube dimensions are out of bounds");
+			return false;
+		}
+
+		if (PixelFormat::IsCompressed(texture->GetFormat()) && ((srcWidth != 0 && srcWidth != box.width) || (srcHeight != 0 && srcHeight != box.height)))
+		{
+			NazaraError("Compressed pixels must be tightly packed");
+			return false;
+		}
+		#endif
+
+		UploadRegion region;
+		region.pixels = pixels;
+		region.box = box;
+		region.level = level;
+		region.srcHeight = srcHeight;
+		region.srcWidth = srcWidth;
+
+		return EnqueueRegions(texture, &region, 1);
+	}
+
+	unsigned int TextureUploadQueue::GetFrameBudget() const
+	{
+		return m_frameBudget;
+	}
+
+	std::size_t TextureUploadQueue::GetPendingUploadCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_uploads.size();
+	}
+
+	unsigned int TextureUploadQueue::GetStagingSize() const
+	{
+		return m_stagingSize;
+	}
+
+	bool TextureUploadQueue::IsPersistentlyMapped() const
+	{
+		return m_bufferId != 0;
+	}
+
+	void TextureUploadQueue::Process()
+	{
+		Context::EnsureContext();
+
+		ReleaseCompletedUploads();
+
+		m_submittedUploads.clear();
+
+		{
+			LockGuard lock(m_mutex);
+
+			// Les envois sont soumis dans l'ordre de leur réservation, la mémoire de transit étant libérée dans ce même ordre
+			UInt64 submittedSize = 0;
+			while (!m_uploads.empty() && m_uploads.front().staged)
+			{
+				Upload& upload = m_uploads.front();
+
+				// Au moins un envoi par frame, même s'il dépasse à lui seul le budget
+				if (!m_submittedUploads.empty() && submittedSize + upload.size > m_frameBudget)
+					break;
+
+				submittedSize += upload.size;
+
+				m_submittedUploads.push_back(std::move(upload));
+				m_uploads.pop_front();
+			}
+		}
+
+		if (m_submittedUploads.empty())
+			return;
+
+		if (m_bufferId)
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_bufferId);
+
+		for (Upload& upload : m_submittedUploads)
+		{
+			// La texture a pu être détruite depuis
+			if (!upload.texture->IsValid())
+				continue;
+
+			// Avec un PBO lié, la source est un offset dans celui-ci
+			const UInt8* source = (m_bufferId) ? nullptr : m_clientMemory.data();
+			source += upload.offset;
+
+			upload.texture->UpdateLevel(source, upload.box, 0, 0, upload.level);
+		}
+
+		UInt64 endPosition = m_submittedUploads.back().endPosition;
+
+		if (m_bufferId)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			// La mémoire de transit et les textures ne seront libérées qu'une fois les copies effectuées par le GPU
+			Batch batch;
+			batch.endPosition = endPosition;
+			batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			for (Upload& upload : m_submittedUploads)
+				batch.textures.push_back(std::move(upload.texture));
+
+			m_batches.push_back(std::move(batch));
+		}
+		else
+		{
+			// Depuis la mémoire cliente, OpenGL a copié les pixels avant de rendre la main
+			for (Upload& upload : m_submittedUploads)
+				upload.texture->m_pendingUploads--;
+
+			LockGuard lock(m_mutex);
+			m_releasedPosition = endPosition;
+		}
+
+		m_submittedUploads.clear();
+	}
+
+	void TextureUploadQueue::SetFrameBudget(unsigned int frameBudget)
+	{
+		m_frameBudget = frameBudget;
+	}
+
+	bool TextureUploadQueue::EnqueueRegions(Texture* texture, const UploadRegion* regions, std::size_t regionCount)
+	{
+		PixelFormatType format = texture->GetFormat();
+
+		unsigned int totalSize = 0;
+		for (std::size_t i = 0; i < regionCount; ++i)
+			totalSize += (ComputeRegionSize(format, regions[i].box) + s_stagingAlignment - 1) / s_stagingAlignment * s_stagingAlignment;
+
+		if (totalSize > m_stagingSize)
+		{
+			NazaraError("Upload is too big for the staging memory (" + String::Number(totalSize) + " > " + String::Number(m_stagingSize) + ')');
+			return false;
+		}
+
+		std::vector<Upload*> uploads(regionCount);
+		unsigned int allocationOffset;
+
+		{
+			LockGuard lock(m_mutex);
+
+			unsigned int writeOffset = static_cast<unsigned int>(m_writePosition % m_stagingSize);
+			allocationOffset = (writeOffset + s_stagingAlignment - 1) / s_stagingAlignment * s_stagingAlignment;
+
+			// L'allocation doit être contiguë, la fin du ring est sautée si elle n'y tient pas
+			UInt64 position;
+			if (allocationOffset > m_stagingSize - totalSize)
+			{
+				position = m_writePosition + (m_stagingSize - writeOffset);
+				allocationOffset = 0;
+			}
+			else
+				position = m_writePosition + (allocationOffset - writeOffset);
+
+			// Plus rien n'est en vol, l'allocation peut commencer n'importe où
+			if (m_releasedPosition == m_writePosition)
+				m_releasedPosition = position;
+
+			UInt64 endPosition = position + totalSize;
+
+			// Pas de place pour l'instant, l'appelant réessaiera une fois des envois terminés
+			if (endPosition - m_releasedPosition > m_stagingSize)
+				return false;
+
+			m_writePosition = endPosition;
+
+			// Chaque envoi ne libère que sa propre partie, les suivants pouvant être soumis à une autre frame
+			unsigned int offset = allocationOffset;
+			for (std::size_t i = 0; i < regionCount; ++i)
+			{
+				Upload upload;
+				upload.box = regions[i].box;
+				upload.level = regions[i].level;
+				upload.offset = offset;
+				upload.size = ComputeRegionSize(format, regions[i].box);
+				upload.staged = false;
+				upload.texture = texture;
+
+				offset += (upload.size + s_stagingAlignment - 1) / s_stagingAlignment * s_stagingAlignment;
+				upload.endPosition = position + (offset - allocationOffset);
+
+				// Les références sur les éléments d'une deque restent valides après un push_back
+				m_uploads.push_back(std::move(upload));
+				uploads[i] = &m_uploads.back();
+			}
+
+			texture->m_pendingUploads += static_cast<unsigned int>(regionCount);
+		}
+
+		// La copie se fait hors du verrou, d'autres threads peuvent réserver en parallèle
+		for (std::size_t i = 0; i < regionCount; ++i)
+		{
+			const UploadRegion& region = regions[i];
+			UInt8* dst = m_stagingPtr + uploads[i]->offset;
+
+			unsigned int srcWidth = (region.srcWidth != 0) ? region.srcWidth : region.box.width;
+			unsigned int srcHeight = (region.srcHeight != 0) ? region.srcHeight : region.box.height;
+
+			if (PixelFormat::IsCompressed(format) || (srcWidth == region.box.width && srcHeight == region.box.height))
+				std::memcpy(dst, region.pixels, uploads[i]->size);
+			else
+			{
+				// Les pixels sont resserrés, le PBO ne contient que la boîte
+				unsigned int bpp = PixelFormat::GetBytesPerPixel(format);
+				unsigned int rowSize = region.box.width * bpp;
+				unsigned int srcRowPitch = srcWidth * bpp;
+				unsigned int srcSlicePitch = srcRowPitch * srcHeight;
+
+				for (unsigned int z = 0; z < region.box.depth; ++z)
+				{
+					const UInt8* src = region.pixels + z * srcSlicePitch;
+					for (unsigned int y = 0; y < region.box.height; ++y)
+					{
+						std::memcpy(dst, src, rowSize);
+
+						dst += rowSize;
+						src += srcRowPitch;
+					}
+				}
+			}
+		}
+
+		LockGuard lock(m_mutex);
+		for (Upload* upload : uploads)
+			upload->staged = true;
+
+		return true;
+	}
+
+	void TextureUploadQueue::ReleaseCompletedUploads()
+	{
+		while (!m_batches.empty())
+		{
+			Batch& batch = m_batches.front();
+			GLsync fence = static_cast<GLsync>(batch.fence);
+
+			// On ne bloque jamais, les envois non terminés seront vérifiés à la prochaine frame
+			GLenum result = glClientWaitSync(fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED)
+				break;
+
+			if (result == GL_WAIT_FAILED)
+				NazaraError("Failed to check texture upload fence (OpenGL error : 0x" + String::Number(glGetError(), 16) + ')');
+
+			glDeleteSync(fence);
+
+			for (TextureRef& texture : batch.textures)
+				texture->m_pendingUploads--;
+
+			{
+				LockGuard lock(m_mutex);
+				m_releasedPosition = batch.endPosition;
+			}
+
+			m_batches.pop_front();
+		}
+	}
+}
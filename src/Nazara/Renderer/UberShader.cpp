@@ -12,6 +12,25 @@ namespace Nz
 		OnUberShaderRelease(this);
 	}
 
+	bool UberShader::HasFlag(const String& flag) const
+	{
+		NazaraUnused(flag);
+
+		// By default we can't know which flags are handled
+		return false;
+	}
+
+	void UberShader::Preload(const ParameterList& parameters) const
+	{
+		// By default instances can only be built synchronously
+		Get(parameters);
+	}
+
+	UberShaderInstance* UberShader::TryGet(const ParameterList& parameters) const
+	{
+		return Get(parameters);
+	}
+
 	bool UberShader::Initialize()
 	{
 		if (!UberShaderLibrary::Initialize())
@@ -3,6 +3,9 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Renderer/UberShaderPreprocessor.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Directory.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
 #include <Nazara/Core/File.hpp>
 #include <Nazara/Renderer/OpenGL.hpp>
@@ -12,103 +15,110 @@
 
 namespace Nz
 {
-	UberShaderPreprocessor::~UberShaderPreprocessor()
+	namespace
 	{
-		OnUberShaderPreprocessorRelease(this);
-	}
+		const UInt32 s_programCacheMagic = 0x4E5A5043; // "NZPC"
+		const UInt32 s_programCacheVersion = 1;
 
-	UberShaderInstance* UberShaderPreprocessor::Get(const ParameterList& parameters) const
-	{
-		// Première étape, transformer les paramètres en un flag
-		UInt32 flags = 0;
-		for (auto it = m_flags.begin(); it != m_flags.end(); ++it)
+		// Le binaire d'un programme n'est valide que pour le pilote qui l'a produit
+		String GetDriverIdentifier()
 		{
-			if (parameters.HasParameter(it->first))
-			{
-				bool value;
-				if (parameters.GetBooleanParameter(it->first, &value) && value)
-					flags |= it->second;
-			}
-		}
+			const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
 
-		// Le shader fait-il partie du cache ?
-		auto shaderIt = m_cache.find(flags);
+			return OpenGL::GetVendorName() + '|' + OpenGL::GetRendererName() + '|' + ((version) ? version : "");
+		}
 
-		// Si non, il nous faut le construire
-		if (shaderIt == m_cache.end())
+		bool LoadCachedProgram(const String& filePath, const String& driverId, Shader* shader)
 		{
-			try
-			{
-				// Une exception sera lancée à la moindre erreur et celle-ci ne sera pas enregistrée dans le log (car traitée dans le bloc catch)
-				ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowException, true);
+			File file(filePath);
+			if (!file.Open(OpenMode_ReadOnly))
+				return false;
 
-				ShaderRef shader = Shader::New();
-				shader->Create();
+			ByteStream stream(&file);
 
-				for (unsigned int i = 0; i <= ShaderStageType_Max; ++i)
-				{
-					const CachedShader& shaderStage = m_shaders[i];
+			UInt32 magic = 0;
+			UInt32 version = 0;
+			stream >> magic >> version;
+			if (magic != s_programCacheMagic || version != s_programCacheVersion)
+				return false;
 
-					// Le shader stage est-il activé dans cette version du shader ?
-					if (shaderStage.present && (flags & shaderStage.requiredFlags) == shaderStage.requiredFlags)
-					{
-						UInt32 stageFlags = 0;
-						for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
-						{
-							if (parameters.HasParameter(it->first))
-							{
-								bool value;
-								if (parameters.GetBooleanParameter(it->first, &value) && value)
-									stageFlags |= it->second;
-							}
-						}
+			String cachedDriverId;
+			UInt32 binarySize = 0;
+			stream >> cachedDriverId >> binarySize;
 
-						auto stageIt = shaderStage.cache.find(stageFlags);
-						if (stageIt == shaderStage.cache.end())
-						{
-							ShaderStage stage;
-							stage.Create(static_cast<ShaderStageType>(i));
+			// Le pilote a changé depuis l'écriture de l'entrée, celle-ci sera remplacée
+			if (cachedDriverId != driverId || binarySize == 0)
+				return false;
 
-							unsigned int glslVersion = OpenGL::GetGLSLVersion();
+			ByteArray binary(binarySize);
+			if (file.Read(binary.GetBuffer(), binarySize) != binarySize)
+				return false;
 
-							StringStream code;
-							code << "#version " << glslVersion << "\n\n";
+			return shader->LoadFromBinary(binary.GetConstBuffer(), binarySize);
+		}
 
-							code << "#define GLSL_VERSION " << glslVersion << "\n\n";
+		void SaveCachedProgram(const String& filePath, const String& driverId, const Shader& shader)
+		{
+			ByteArray binary = shader.GetBinary();
+			if (binary.IsEmpty())
+				return;
 
-							code << "#define EARLY_FRAGMENT_TEST " << (glslVersion >= 420 || OpenGL::IsSupported(OpenGLExtension_Shader_ImageLoadStore)) << "\n\n";
+			File file(filePath);
+			if (!file.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+			{
+				NazaraWarning("Failed to open program cache file \"" + filePath + '"');
+				return;
+			}
 
-							for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
-								code << "#define " << it->first << ' ' << ((stageFlags & it->second) ? '1' : '0') << '\n';
+			ByteStream stream(&file);
+			stream << s_programCacheMagic << s_programCacheVersion << driverId << static_cast<UInt32>(binary.GetSize());
 
-							code << "\n#line 1\n"; // Pour que les éventuelles erreurs du shader se réfèrent à la bonne ligne
-							code << shaderStage.source;
+			if (!file.Write(binary))
+				NazaraWarning("Failed to write program cache file \"" + filePath + '"');
+		}
+	}
 
-							stage.SetSource(code);
-							stage.Compile();
+	UberShaderPreprocessor::~UberShaderPreprocessor()
+	{
+		OnUberShaderPreprocessorRelease(this);
+	}
 
-							stageIt = shaderStage.cache.emplace(flags, std::move(stage)).first;
-						}
+	UberShaderInstance* UberShaderPreprocessor::Get(const ParameterList& parameters) const
+	{
+		UInt32 flags = ComputeFlags(parameters);
 
-						shader->AttachStage(static_cast<ShaderStageType>(i), stageIt->second);
-					}
-				}
+		// Le shader fait-il partie du cache ?
+		auto shaderIt = m_cache.find(flags);
+		if (shaderIt != m_cache.end())
+			return &shaderIt->second;
 
-				shader->Link();
+		// Si non, il nous faut le construire, ou attendre la fin de sa construction
+		if (m_pendingInstances.find(flags) == m_pendingInstances.end())
+		{
+			UberShaderInstance* instance = BeginInstance(parameters, flags);
+			if (instance)
+				return instance;
+		}
 
-				// On construit l'instant
-				shaderIt = m_cache.emplace(flags, shader.Get()).first;
-			}
-			catch (const std::exception&)
-			{
-				ErrorFlags errFlags(ErrorFlag_ThrowExceptionDisabled);
+		return EndInstance(flags);
+	}
 
-				NazaraError("Failed to build UberShader instance: " + Error::GetLastError());
-				throw;
-			}
-		}
+	const String& UberShaderPreprocessor::GetProgramCacheDirectory()
+	{
+		return s_programCacheDirectory;
+	}
 
-		return &shaderIt->second;
+	bool UberShaderPreprocessor::HasFlag(const String& flag) const
+	{
+		return m_flags.find(flag) != m_flags.end();
+	}
+
+	void UberShaderPreprocessor::Preload(const ParameterList& parameters) const
+	{
+		UInt32 flags = ComputeFlags(parameters);
+
+		if (m_cache.find(flags) == m_cache.end() && m_pendingInstances.find(flags) == m_pendingInstances.end())
+			BeginInstance(parameters, flags);
 	}
 
 	void UberShaderPreprocessor::SetShader(ShaderStageType stage, const String& source, const String& shaderFlags, const String& requiredFlags)
@@ -180,8 +190,212 @@ namespace Nz
 		return true;
 	}
 
+	UberShaderInstance* UberShaderPreprocessor::TryGet(const ParameterList& parameters) const
+	{
+		UInt32 flags = ComputeFlags(parameters);
+
+		auto shaderIt = m_cache.find(flags);
+		if (shaderIt != m_cache.end())
+			return &shaderIt->second;
+
+		auto pendingIt = m_pendingInstances.find(flags);
+		if (pendingIt == m_pendingInstances.end())
+		{
+			// Une construction tout juste lancée n'est jamais attendue, le pilote a au moins jusqu'au prochain appel
+			return BeginInstance(parameters, flags);
+		}
+
+		if (!pendingIt->second.shader->IsLinkingCompleted())
+			return nullptr;
+
+		return EndInstance(flags);
+	}
+
+	UberShaderInstance* UberShaderPreprocessor::BeginInstance(const ParameterList& parameters, UInt32 flags) const
+	{
+		try
+		{
+			// Une exception sera lancée à la moindre erreur et celle-ci ne sera pas enregistrée dans le log (car traitée dans le bloc catch)
+			ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowException, true);
+
+			// On génère d'abord le code de chaque étape, celui-ci sert aussi de clé au cache sur disque
+			String stageCodes[ShaderStageType_Max+1];
+			UInt32 stageFlags[ShaderStageType_Max+1] = {};
+
+			unsigned int glslVersion = OpenGL::GetGLSLVersion();
+
+			for (unsigned int i = 0; i <= ShaderStageType_Max; ++i)
+			{
+				const CachedShader& shaderStage = m_shaders[i];
+
+				// Le shader stage est-il activé dans cette version du shader ?
+				if (shaderStage.present && (flags & shaderStage.requiredFlags) == shaderStage.requiredFlags)
+				{
+					for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
+					{
+						if (parameters.HasParameter(it->first))
+						{
+							bool value;
+							if (parameters.GetBooleanParameter(it->first, &value) && value)
+								stageFlags[i] |= it->second;
+						}
+					}
+
+					StringStream code;
+					code << "#version " << glslVersion << "\n\n";
+
+					code << "#define GLSL_VERSION " << glslVersion << "\n\n";
+
+					code << "#define EARLY_FRAGMENT_TEST " << (glslVersion >= 420 || OpenGL::IsSupported(OpenGLExtension_Shader_ImageLoadStore)) << "\n\n";
+
+					for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
+						code << "#define " << it->first << ' ' << ((stageFlags[i] & it->second) ? '1' : '0') << '\n';
+
+					code << "\n#line 1\n"; // Pour que les éventuelles erreurs du shader se réfèrent à la bonne ligne
+					code << shaderStage.source;
+
+					stageCodes[i] = code;
+				}
+			}
+
+			PendingInstance pending;
+			pending.shader = Shader::New();
+			pending.shader->Create();
+
+			if (!s_programCacheDirectory.IsEmpty() && pending.shader->IsBinaryRetrievable())
+			{
+				std::unique_ptr<AbstractHash> hash = AbstractHash::Get(HashType_XXHash64);
+				hash->Begin();
+				hash->Append(reinterpret_cast<const UInt8*>(&flags), sizeof(UInt32));
+				for (unsigned int i = 0; i <= ShaderStageType_Max; ++i)
+				{
+					hash->Append(reinterpret_cast<const UInt8*>(&i), sizeof(unsigned int));
+					hash->Append(reinterpret_cast<const UInt8*>(stageCodes[i].GetConstBuffer()), stageCodes[i].GetSize());
+				}
+
+				pending.cachePath = s_programCacheDirectory + NAZARA_DIRECTORY_SEPARATOR + hash->End().ToHex() + ".nzpc";
+				pending.driverId = GetDriverIdentifier();
+
+				// Une entrée invalide ou périmée n'est pas une erreur, le programme est simplement recompilé
+				ErrorFlags cacheFlags(ErrorFlag_Silent, true);
+				if (LoadCachedProgram(pending.cachePath, pending.driverId, pending.shader))
+					return &m_cache.emplace(flags, pending.shader.Get()).first->second;
+			}
+
+			for (unsigned int i = 0; i <= ShaderStageType_Max; ++i)
+			{
+				pending.stages[i] = nullptr;
+				if (stageCodes[i].IsEmpty())
+					continue;
+
+				const CachedShader& shaderStage = m_shaders[i];
+
+				// Les étapes sont compilées sans attendre, leur statut n'est vérifié qu'à la fin de la construction
+				auto stageIt = shaderStage.cache.find(stageFlags[i]);
+				if (stageIt == shaderStage.cache.end())
+				{
+					ShaderStage stage;
+					stage.Create(static_cast<ShaderStageType>(i));
+					stage.SetSource(stageCodes[i]);
+					stage.BeginCompilation();
+
+					stageIt = shaderStage.cache.emplace(stageFlags[i], std::move(stage)).first;
+				}
+
+				pending.shader->AttachStage(static_cast<ShaderStageType>(i), stageIt->second);
+				pending.stages[i] = &stageIt->second;
+			}
+
+			pending.shader->BeginLinking();
+
+			m_pendingInstances.emplace(flags, std::move(pending));
+			return nullptr;
+		}
+		catch (const std::exception&)
+		{
+			ErrorFlags errFlags(ErrorFlag_ThrowExceptionDisabled);
+
+			NazaraError("Failed to build UberShader instance: " + Error::GetLastError());
+			throw;
+		}
+	}
+
+	UInt32 UberShaderPreprocessor::ComputeFlags(const ParameterList& parameters) const
+	{
+		UInt32 flags = 0;
+		for (auto it = m_flags.begin(); it != m_flags.end(); ++it)
+		{
+			if (parameters.HasParameter(it->first))
+			{
+				bool value;
+				if (parameters.GetBooleanParameter(it->first, &value) && value)
+					flags |= it->second;
+			}
+		}
+
+		return flags;
+	}
+
+	UberShaderInstance* UberShaderPreprocessor::EndInstance(UInt32 flags) const
+	{
+		auto pendingIt = m_pendingInstances.find(flags);
+		NazaraAssert(pendingIt != m_pendingInstances.end(), "Instance is not being built");
+
+		PendingInstance pending = std::move(pendingIt->second);
+		m_pendingInstances.erase(pendingIt);
+
+		try
+		{
+			ErrorFlags errFlags(ErrorFlag_Silent | ErrorFlag_ThrowException, true);
+
+			// Une étape peut être partagée entre plusieurs instances, seule la première en attend la compilation
+			for (ShaderStage* stage : pending.stages)
+			{
+				if (!stage)
+					continue;
+
+				if (stage->IsCompiling())
+					stage->EndCompilation();
+				else if (!stage->IsCompiled())
+					NazaraError("Shader stage failed to compile");
+			}
+
+			pending.shader->EndLinking();
+
+			if (!pending.cachePath.IsEmpty())
+			{
+				ErrorFlags cacheFlags(ErrorFlag_ThrowExceptionDisabled, true);
+				SaveCachedProgram(pending.cachePath, pending.driverId, *pending.shader);
+			}
+
+			// On construit l'instant
+			return &m_cache.emplace(flags, pending.shader.Get()).first->second;
+		}
+		catch (const std::exception&)
+		{
+			ErrorFlags errFlags(ErrorFlag_ThrowExceptionDisabled);
+
+			NazaraError("Failed to build UberShader instance: " + Error::GetLastError());
+			throw;
+		}
+	}
+
 	bool UberShaderPreprocessor::IsSupported()
 	{
 		return true; // Forcément supporté
 	}
+
+	void UberShaderPreprocessor::SetProgramCacheDirectory(const String& directory)
+	{
+		// Une chaîne vide désactive le cache sur disque
+		if (!directory.IsEmpty() && !Directory::Exists(directory) && !Directory::Create(directory, true))
+		{
+			NazaraError("Failed to create program cache directory \"" + directory + '"');
+			return;
+		}
+
+		s_programCacheDirectory = directory;
+	}
+
+	String UberShaderPreprocessor::s_programCacheDirectory;
 }
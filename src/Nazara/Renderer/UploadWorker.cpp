@@ -0,0 +1,266 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Renderer module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Renderer/UploadWorker.hpp>
+#include <Nazara/Core/ConditionVariable.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Renderer/Context.hpp>
+#include <Nazara/Renderer/OpenGL.hpp>
+#include <deque>
+#include <exception>
+#include <vector>
+#include <Nazara/Renderer/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct CompletedJob
+		{
+			UploadWorker::Callback callback;
+			bool succeeded;
+		};
+
+		struct PendingJob
+		{
+			UploadWorker::Callback callback;
+			UploadWorker::Job job;
+		};
+
+		struct SubmittedJob
+		{
+			UploadWorker::Callback callback;
+			GLsync fence;
+			bool succeeded;
+		};
+
+		ConditionVariable s_idleCondition;
+		ConditionVariable s_jobCondition;
+		Mutex s_mutex;
+		Thread s_thread;
+		std::deque<PendingJob> s_jobs;
+		std::vector<CompletedJob> s_completedJobs;
+		std::size_t s_pendingJobCount = 0;
+		bool s_initialized = false;
+		bool s_running = false;
+		bool s_started = false;
+		thread_local bool t_isWorker = false;
+
+		void CompleteJob(SubmittedJob& job)
+		{
+			glDeleteSync(job.fence);
+
+			LockGuard lock(s_mutex);
+
+			s_completedJobs.push_back({std::move(job.callback), job.succeeded});
+			s_pendingJobCount--;
+
+			s_idleCondition.SignalAll();
+		}
+
+		void Worker()
+		{
+			Thread::SetCurrentThreadName("UploadWorker");
+
+			t_isWorker = true;
+
+			// Le contexte est partagé avec le contexte de référence, et donc avec tous les autres
+			Context context;
+			bool created = context.Create();
+			if (!created)
+				NazaraError("Failed to create upload context");
+
+			{
+				LockGuard lock(s_mutex);
+
+				s_running = created;
+				s_started = true;
+				s_idleCondition.SignalAll();
+			}
+
+			if (!created)
+				return;
+
+			std::deque<SubmittedJob> submittedJobs;
+			for (;;)
+			{
+				PendingJob job;
+				bool hasJob = false;
+				{
+					LockGuard lock(s_mutex);
+
+					while (s_running && s_jobs.empty() && submittedJobs.empty())
+						s_jobCondition.Wait(&s_mutex);
+
+					if (!s_running && s_jobs.empty() && submittedJobs.empty())
+						break;
+
+					if (!s_jobs.empty())
+					{
+						job = std::move(s_jobs.front());
+						s_jobs.pop_front();
+						hasJob = true;
+					}
+				}
+
+				if (hasJob)
+				{
+					bool succeeded;
+					try
+					{
+						succeeded = job.job();
+					}
+					catch (const std::exception& e)
+					{
+						NazaraError("Upload job failed: " + String(e.what()));
+						succeeded = false;
+					}
+
+					// glFlush rend la barrière visible des autres contextes
+					GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+					glFlush();
+
+					submittedJobs.push_back({std::move(job.callback), fence, succeeded});
+				}
+
+				// Les barrières d'un même contexte sont franchies dans l'ordre
+				// Sans nouveau travail, on attend un peu la plus ancienne plutôt que de tourner à vide
+				GLuint64 timeout = (hasJob) ? 0 : 1000000;
+				while (!submittedJobs.empty())
+				{
+					GLenum result = glClientWaitSync(submittedJobs.front().fence, 0, timeout);
+					if (result == GL_TIMEOUT_EXPIRED)
+						break;
+
+					if (result == GL_WAIT_FAILED)
+						NazaraWarning("Failed to wait for upload fence");
+
+					CompleteJob(submittedJobs.front());
+					submittedJobs.pop_front();
+
+					timeout = 0;
+				}
+			}
+
+			context.Destroy();
+		}
+	}
+
+	bool UploadWorker::AddJob(Job job, Callback callback)
+	{
+		NazaraAssert(job, "Invalid job");
+
+		if (!Initialize())
+		{
+			NazaraError("Failed to initialize upload worker");
+			return false;
+		}
+
+		LockGuard lock(s_mutex);
+
+		s_jobs.push_back({std::move(callback), std::move(job)});
+		s_pendingJobCount++;
+
+		s_jobCondition.Signal();
+
+		return true;
+	}
+
+	std::size_t UploadWorker::GetPendingJobCount()
+	{
+		LockGuard lock(s_mutex);
+
+		return s_pendingJobCount;
+	}
+
+	bool UploadWorker::Initialize()
+	{
+		LockGuard lock(s_mutex);
+
+		if (s_initialized)
+			return true;
+
+		s_started = false;
+		s_thread = Thread(Worker);
+
+		while (!s_started)
+			s_idleCondition.Wait(&s_mutex);
+
+		if (!s_running)
+		{
+			s_mutex.Unlock();
+			s_thread.Join();
+			s_mutex.Lock();
+
+			return false;
+		}
+
+		s_initialized = true;
+		return true;
+	}
+
+	bool UploadWorker::IsInitialized()
+	{
+		LockGuard lock(s_mutex);
+
+		return s_initialized;
+	}
+
+	bool UploadWorker::IsWorkerThread()
+	{
+		return t_isWorker;
+	}
+
+	void UploadWorker::ProcessCallbacks()
+	{
+		std::vector<CompletedJob> completedJobs;
+		{
+			LockGuard lock(s_mutex);
+
+			std::swap(completedJobs, s_completedJobs);
+		}
+
+		// Appelés sans verrou, les callbacks peuvent ajouter de nouveaux travaux
+		for (CompletedJob& job : completedJobs)
+		{
+			if (job.callback)
+				job.callback(job.succeeded);
+		}
+	}
+
+	void UploadWorker::Uninitialize()
+	{
+		{
+			LockGuard lock(s_mutex);
+
+			if (!s_initialized)
+				return;
+
+			// Le worker termine les travaux restants avant de s'arrêter
+			s_running = false;
+			s_jobCondition.Signal();
+		}
+
+		s_thread.Join();
+
+		LockGuard lock(s_mutex);
+
+		s_completedJobs.clear();
+		s_initialized = false;
+		s_pendingJobCount = 0;
+	}
+
+	void UploadWorker::WaitForJobs()
+	{
+		NazaraAssert(!IsWorkerThread(), "Upload worker cannot wait for itself");
+
+		LockGuard lock(s_mutex);
+
+		while (s_pendingJobCount > 0)
+			s_idleCondition.Wait(&s_mutex);
+	}
+}
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/AbstractAtlas.hpp>
+#include <Nazara/Utility/Image.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -11,4 +12,16 @@ namespace Nz
 	{
 		OnAtlasRelease(this);
 	}
+
+	bool AbstractAtlas::Insert(SparsePtr<const Image> images, Rectui* rects, bool* flipped, unsigned int* layerIndices, unsigned int count)
+	{
+		// Implémentation par défaut, les atlas capables de mieux faire (en plaçant les rectangles ensemble) la redéfinissent
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			if (!Insert(images[i], &rects[i], &flipped[i], &layerIndices[i]))
+				return false;
+		}
+
+		return true;
+	}
 }
@@ -3,10 +3,27 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/AbstractTextDrawer.hpp>
+#include <atomic>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
 	AbstractTextDrawer::~AbstractTextDrawer() = default;
+
+	UInt64 AbstractTextDrawer::GetGlyphRevision() const
+	{
+		// Drawers which do not track their changes force their users to process every glyph again
+		return InvalidRevision;
+	}
+
+	UInt64 AbstractTextDrawer::GenerateRevision()
+	{
+		// Revisions are unique among every drawer, so a revision can't be mistaken for one of another drawer
+		static std::atomic<UInt64> nextRevision(InvalidRevision + 1);
+
+		return nextRevision++;
+	}
+
+	constexpr UInt64 AbstractTextDrawer::InvalidRevision;
 }
 
@@ -26,10 +26,42 @@
  */
 
 #include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
 #include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <unordered_map>
+#include <vector>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_ALGORITHMUTILITY_X86
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_AVX2_FUNCTION
+		#define NAZARA_SSE2_FUNCTION
+	#else
+		#define NAZARA_AVX2_FUNCTION __attribute__((target("avx2,fma")))
+		#define NAZARA_SSE2_FUNCTION __attribute__((target("sse2")))
+	#endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define NAZARA_ALGORITHMUTILITY_NEON
+	#include <arm_neon.h>
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -628,6 +660,261 @@ namespace Nz
 				float m_valenceBoostScale;
 				float m_valenceBoostPower;
 		};
+
+		// Emulates a FIFO post-transform cache through timestamps, returns the number of cache misses of the triangle
+		class CacheSimulator
+		{
+			public:
+				CacheSimulator(unsigned int vertexCount, unsigned int cacheSize) :
+				m_timestamps(vertexCount, 0),
+				m_cacheSize(cacheSize),
+				m_timestamp(cacheSize + 1)
+				{
+				}
+
+				unsigned int AddTriangle(UInt32 a, UInt32 b, UInt32 c)
+				{
+					return AddVertex(a) + AddVertex(b) + AddVertex(c);
+				}
+
+				void Flush()
+				{
+					m_timestamp += m_cacheSize + 1;
+				}
+
+			private:
+				unsigned int AddVertex(UInt32 vertex)
+				{
+					if (m_timestamp - m_timestamps[vertex] <= m_cacheSize)
+						return 0;
+
+					m_timestamps[vertex] = m_timestamp++;
+					return 1;
+				}
+
+				std::vector<unsigned int> m_timestamps;
+				unsigned int m_cacheSize;
+				unsigned int m_timestamp;
+		};
+
+		struct VertexBytesHasher
+		{
+			std::size_t operator()(const UInt8* vertex) const
+			{
+				// FNV-1a
+				std::size_t hash = 14695981039346656037ULL;
+				for (std::size_t i = 0; i < stride; ++i)
+				{
+					hash ^= vertex[i];
+					hash *= 1099511628211ULL;
+				}
+
+				return hash;
+			}
+
+			std::size_t stride;
+		};
+
+		struct VertexBytesComparator
+		{
+			bool operator()(const UInt8* lhs, const UInt8* rhs) const
+			{
+				return std::memcmp(lhs, rhs, stride) == 0;
+			}
+
+			std::size_t stride;
+		};
+
+		template<typename T>
+		SparsePtr<T> GetFloatComponentPtr(VertexMapper& mapper, const VertexDeclaration* declaration, VertexComponent component, ComponentType expectedType)
+		{
+			bool enabled;
+			ComponentType type;
+			declaration->GetComponent(component, &enabled, &type, nullptr);
+
+			return (enabled && type == expectedType) ? mapper.GetComponentPtr<T>(component) : SparsePtr<T>();
+		}
+
+		float Quantize(float value, float min, float step)
+		{
+			return (step > 0.f) ? min + std::round((value - min) / step) * step : value;
+		}
+
+		// Sum of squared distances to a set of planes (Garland & Heckbert)
+		struct Quadric
+		{
+			void AddPlane(const Vector3f& normal, float distance, float weight)
+			{
+				a00 += weight * normal.x * normal.x;
+				a01 += weight * normal.x * normal.y;
+				a02 += weight * normal.x * normal.z;
+				a11 += weight * normal.y * normal.y;
+				a12 += weight * normal.y * normal.z;
+				a22 += weight * normal.z * normal.z;
+				b0 += weight * normal.x * distance;
+				b1 += weight * normal.y * distance;
+				b2 += weight * normal.z * distance;
+				c += weight * distance * distance;
+			}
+
+			float Evaluate(const Vector3f& p) const
+			{
+				float error = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+				            + 2.f * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z)
+				            + 2.f * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+
+				return std::max(error, 0.f);
+			}
+
+			Quadric& operator+=(const Quadric& quadric)
+			{
+				a00 += quadric.a00; a01 += quadric.a01; a02 += quadric.a02;
+				a11 += quadric.a11; a12 += quadric.a12; a22 += quadric.a22;
+				b0 += quadric.b0; b1 += quadric.b1; b2 += quadric.b2;
+				c += quadric.c;
+
+				return *this;
+			}
+
+			float a00 = 0.f, a01 = 0.f, a02 = 0.f, a11 = 0.f, a12 = 0.f, a22 = 0.f;
+			float b0 = 0.f, b1 = 0.f, b2 = 0.f;
+			float c = 0.f;
+		};
+
+		struct PositionHasher
+		{
+			std::size_t operator()(const Vector3f& position) const
+			{
+				std::size_t seed = 0;
+				HashCombine(seed, position.x);
+				HashCombine(seed, position.y);
+				HashCombine(seed, position.z);
+
+				return seed;
+			}
+		};
+
+		struct EdgeCollapse
+		{
+			UInt32 from;
+			UInt32 to;
+			float error;
+		};
+
+		struct PositionComparator
+		{
+			bool operator()(const Vector3f& lhs, const Vector3f& rhs) const
+			{
+				// Exact comparison, consistent with the hash
+				return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+			}
+		};
+	}
+
+	/**********************************Compact**********************************/
+
+	bool CompactVertices(VertexBuffer* vertexBuffer)
+	{
+		NazaraAssert(vertexBuffer && vertexBuffer->IsValid(), "Invalid vertex buffer");
+
+		struct ComponentCopy
+		{
+			ComponentType sourceType;
+			ComponentType targetType;
+			std::size_t sourceOffset;
+			std::size_t targetOffset;
+		};
+
+		const VertexDeclaration* declaration = vertexBuffer->GetVertexDeclaration();
+
+		// Normals and tangents only need a direction, texture coordinates may exceed [0, 1] and are stored as half-floats
+		// Positions keep their precision
+		VertexDeclarationRef compactDeclaration = VertexDeclaration::New();
+		std::vector<ComponentCopy> copies;
+		std::size_t offset = 0;
+		bool compacted = false;
+		for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+		{
+			VertexComponent component = static_cast<VertexComponent>(i);
+
+			bool enabled;
+			ComponentType type;
+			std::size_t sourceOffset;
+			declaration->GetComponent(component, &enabled, &type, &sourceOffset);
+			if (!enabled)
+				continue;
+
+			ComponentType compactType = type;
+			if ((component == VertexComponent_Normal || component == VertexComponent_Tangent) && type == ComponentType_Float3)
+				compactType = ComponentType_NormalizedInt2101010;
+			else if (component == VertexComponent_TexCoord && type == ComponentType_Float2)
+				compactType = ComponentType_Half2;
+
+			if (compactType != type)
+				compacted = true;
+
+			compactDeclaration->EnableComponent(component, compactType, offset);
+			copies.push_back({type, compactType, sourceOffset, offset});
+
+			offset += Utility::ComponentStride[compactType];
+		}
+
+		if (!compacted)
+			return false;
+
+		std::size_t sourceStride = declaration->GetStride();
+		std::size_t targetStride = compactDeclaration->GetStride();
+		unsigned int vertexCount = vertexBuffer->GetVertexCount();
+
+		std::vector<UInt8> vertices(vertexCount * targetStride);
+		{
+			BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+			const UInt8* sourceVertices = static_cast<const UInt8*>(vertexMapper.GetPointer());
+
+			for (const ComponentCopy& copy : copies)
+			{
+				const UInt8* source = sourceVertices + copy.sourceOffset;
+				UInt8* target = &vertices[copy.targetOffset];
+
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					switch (copy.targetType)
+					{
+						case ComponentType_Half2:
+						{
+							const float* uv = reinterpret_cast<const float*>(source);
+							UInt16* halfUv = reinterpret_cast<UInt16*>(target);
+							halfUv[0] = PackHalf(uv[0]);
+							halfUv[1] = PackHalf(uv[1]);
+							break;
+						}
+
+						case ComponentType_NormalizedInt2101010:
+						{
+							const float* direction = reinterpret_cast<const float*>(source);
+							*reinterpret_cast<UInt32*>(target) = PackNormalizedInt2101010(Vector4f(direction[0], direction[1], direction[2], 0.f));
+							break;
+						}
+
+						default:
+							std::memcpy(target, source, Utility::ComponentStride[copy.targetType]);
+							break;
+					}
+
+					source += sourceStride;
+					target += targetStride;
+				}
+			}
+		}
+
+		const Buffer* buffer = vertexBuffer->GetBuffer();
+		UInt32 storage = buffer->GetStorage();
+		BufferUsage usage = buffer->GetUsage();
+
+		vertexBuffer->Reset(compactDeclaration, vertexCount, storage, usage);
+		vertexBuffer->Fill(vertices.data(), 0, vertexCount, true);
+
+		return true;
 	}
 
 	/**********************************Compute**********************************/
@@ -1043,6 +1330,163 @@ namespace Nz
 		}
 	}
 
+	/*********************************Interpolate*******************************/
+
+	void InterpolateSequenceJoints(const SequenceJoint* jointsA, const SequenceJoint* jointsB, float interpolation, SequenceJoint* output, unsigned int jointCount)
+	{
+		// Rotations are interpolated linearly then normalized (nlerp), which matches a slerp for the small angles found between two frames,
+		// the joints whose rotations are further apart than that go through Quaternionf::Slerp
+		constexpr float nlerpThreshold = 0.995f;
+
+		static_assert(sizeof(SequenceJoint) == 10 * sizeof(float), "SequenceJoint must be made of ten packed floats");
+
+		unsigned int i = 0;
+
+		#if defined(NAZARA_MATH_SSE2) || defined(NAZARA_MATH_NEON)
+		#ifdef NAZARA_MATH_SSE2
+		__m128 t = _mm_set1_ps(interpolation);
+		__m128 signMask = _mm_set1_ps(-0.f);
+		__m128 threshold = _mm_set1_ps(nlerpThreshold);
+		#else
+		float32x4_t t = vdupq_n_f32(interpolation);
+		float32x4_t threshold = vdupq_n_f32(nlerpThreshold);
+		const uint32_t laneBits[4] = {1, 2, 4, 8};
+		uint32x4_t laneMask = vld1q_u32(laneBits);
+		#endif
+
+		for (; i + 4 <= jointCount; i += 4)
+		{
+			// Four rotations are transposed to have their components in different registers (w, x, y, z)
+			#ifdef NAZARA_MATH_SSE2
+			__m128 aw = _mm_loadu_ps(&jointsA[i + 0].rotation.w);
+			__m128 ax = _mm_loadu_ps(&jointsA[i + 1].rotation.w);
+			__m128 ay = _mm_loadu_ps(&jointsA[i + 2].rotation.w);
+			__m128 az = _mm_loadu_ps(&jointsA[i + 3].rotation.w);
+			_MM_TRANSPOSE4_PS(aw, ax, ay, az);
+
+			__m128 bw = _mm_loadu_ps(&jointsB[i + 0].rotation.w);
+			__m128 bx = _mm_loadu_ps(&jointsB[i + 1].rotation.w);
+			__m128 by = _mm_loadu_ps(&jointsB[i + 2].rotation.w);
+			__m128 bz = _mm_loadu_ps(&jointsB[i + 3].rotation.w);
+			_MM_TRANSPOSE4_PS(bw, bx, by, bz);
+
+			// Takes the shortest path by flipping the second rotation when the dot product is negative
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_add_ps(_mm_mul_ps(ay, by), _mm_mul_ps(az, bz)));
+			__m128 sign = _mm_and_ps(dot, signMask);
+			unsigned int slerpLanes = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(_mm_xor_ps(dot, sign), threshold)));
+
+			__m128 rw = _mm_add_ps(aw, _mm_mul_ps(t, _mm_sub_ps(_mm_xor_ps(bw, sign), aw)));
+			__m128 rx = _mm_add_ps(ax, _mm_mul_ps(t, _mm_sub_ps(_mm_xor_ps(bx, sign), ax)));
+			__m128 ry = _mm_add_ps(ay, _mm_mul_ps(t, _mm_sub_ps(_mm_xor_ps(by, sign), ay)));
+			__m128 rz = _mm_add_ps(az, _mm_mul_ps(t, _mm_sub_ps(_mm_xor_ps(bz, sign), az)));
+
+			__m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, rw), _mm_mul_ps(rx, rx)), _mm_add_ps(_mm_mul_ps(ry, ry), _mm_mul_ps(rz, rz)))));
+			rw = _mm_mul_ps(rw, invLength);
+			rx = _mm_mul_ps(rx, invLength);
+			ry = _mm_mul_ps(ry, invLength);
+			rz = _mm_mul_ps(rz, invLength);
+			_MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+
+			_mm_storeu_ps(&output[i + 0].rotation.w, rw);
+			_mm_storeu_ps(&output[i + 1].rotation.w, rx);
+			_mm_storeu_ps(&output[i + 2].rotation.w, ry);
+			_mm_storeu_ps(&output[i + 3].rotation.w, rz);
+
+			// Position and scale are six consecutive floats, interpolated as four plus two
+			for (unsigned int j = i; j < i + 4; ++j)
+			{
+				__m128 a = _mm_loadu_ps(&jointsA[j].position.x);
+				__m128 b = _mm_loadu_ps(&jointsB[j].position.x);
+				_mm_storeu_ps(&output[j].position.x, _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))));
+
+				a = _mm_loadl_pi(a, reinterpret_cast<const __m64*>(&jointsA[j].scale.y));
+				b = _mm_loadl_pi(b, reinterpret_cast<const __m64*>(&jointsB[j].scale.y));
+				_mm_storel_pi(reinterpret_cast<__m64*>(&output[j].scale.y), _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))));
+			}
+			#else
+			float32x4x2_t a01 = vtrnq_f32(vld1q_f32(&jointsA[i + 0].rotation.w), vld1q_f32(&jointsA[i + 1].rotation.w));
+			float32x4x2_t a23 = vtrnq_f32(vld1q_f32(&jointsA[i + 2].rotation.w), vld1q_f32(&jointsA[i + 3].rotation.w));
+			float32x4_t aw = vcombine_f32(vget_low_f32(a01.val[0]), vget_low_f32(a23.val[0]));
+			float32x4_t ax = vcombine_f32(vget_low_f32(a01.val[1]), vget_low_f32(a23.val[1]));
+			float32x4_t ay = vcombine_f32(vget_high_f32(a01.val[0]), vget_high_f32(a23.val[0]));
+			float32x4_t az = vcombine_f32(vget_high_f32(a01.val[1]), vget_high_f32(a23.val[1]));
+
+			float32x4x2_t b01 = vtrnq_f32(vld1q_f32(&jointsB[i + 0].rotation.w), vld1q_f32(&jointsB[i + 1].rotation.w));
+			float32x4x2_t b23 = vtrnq_f32(vld1q_f32(&jointsB[i + 2].rotation.w), vld1q_f32(&jointsB[i + 3].rotation.w));
+			float32x4_t bw = vcombine_f32(vget_low_f32(b01.val[0]), vget_low_f32(b23.val[0]));
+			float32x4_t bx = vcombine_f32(vget_low_f32(b01.val[1]), vget_low_f32(b23.val[1]));
+			float32x4_t by = vcombine_f32(vget_high_f32(b01.val[0]), vget_high_f32(b23.val[0]));
+			float32x4_t bz = vcombine_f32(vget_high_f32(b01.val[1]), vget_high_f32(b23.val[1]));
+
+			float32x4_t dot = vmlaq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(aw, bw), ax, bx), ay, by), az, bz);
+			uint32x4_t negative = vcltq_f32(dot, vdupq_n_f32(0.f));
+			bw = vbslq_f32(negative, vnegq_f32(bw), bw);
+			bx = vbslq_f32(negative, vnegq_f32(bx), bx);
+			by = vbslq_f32(negative, vnegq_f32(by), by);
+			bz = vbslq_f32(negative, vnegq_f32(bz), bz);
+
+			uint32x4_t slerpMask = vandq_u32(vcltq_f32(vabsq_f32(dot), threshold), laneMask);
+			uint32x2_t slerpPairs = vadd_u32(vget_low_u32(slerpMask), vget_high_u32(slerpMask));
+			unsigned int slerpLanes = vget_lane_u32(vpadd_u32(slerpPairs, slerpPairs), 0);
+
+			float32x4_t rw = vmlaq_f32(aw, t, vsubq_f32(bw, aw));
+			float32x4_t rx = vmlaq_f32(ax, t, vsubq_f32(bx, ax));
+			float32x4_t ry = vmlaq_f32(ay, t, vsubq_f32(by, ay));
+			float32x4_t rz = vmlaq_f32(az, t, vsubq_f32(bz, az));
+
+			// Two Newton-Raphson steps bring the reciprocal square root estimate to full precision
+			float32x4_t squaredLength = vmlaq_f32(vmlaq_f32(vmlaq_f32(vmulq_f32(rw, rw), rx, rx), ry, ry), rz, rz);
+			float32x4_t invLength = vrsqrteq_f32(squaredLength);
+			invLength = vmulq_f32(invLength, vrsqrtsq_f32(vmulq_f32(squaredLength, invLength), invLength));
+			invLength = vmulq_f32(invLength, vrsqrtsq_f32(vmulq_f32(squaredLength, invLength), invLength));
+
+			float32x4x4_t rotations = {{vmulq_f32(rw, invLength), vmulq_f32(rx, invLength), vmulq_f32(ry, invLength), vmulq_f32(rz, invLength)}};
+			vst4q_lane_f32(&output[i + 0].rotation.w, rotations, 0);
+			vst4q_lane_f32(&output[i + 1].rotation.w, rotations, 1);
+			vst4q_lane_f32(&output[i + 2].rotation.w, rotations, 2);
+			vst4q_lane_f32(&output[i + 3].rotation.w, rotations, 3);
+
+			for (unsigned int j = i; j < i + 4; ++j)
+			{
+				float32x4_t a = vld1q_f32(&jointsA[j].position.x);
+				float32x4_t b = vld1q_f32(&jointsB[j].position.x);
+				vst1q_f32(&output[j].position.x, vmlaq_f32(a, t, vsubq_f32(b, a)));
+
+				float32x2_t a2 = vld1_f32(&jointsA[j].scale.y);
+				float32x2_t b2 = vld1_f32(&jointsB[j].scale.y);
+				vst1_f32(&output[j].scale.y, vmla_f32(a2, vget_low_f32(t), vsub_f32(b2, a2)));
+			}
+			#endif
+
+			while (slerpLanes)
+			{
+				unsigned int lane = IntegralLog2Pot(slerpLanes & (~slerpLanes + 1));
+				output[i + lane].rotation = Quaternionf::Slerp(jointsA[i + lane].rotation, jointsB[i + lane].rotation, interpolation);
+
+				slerpLanes &= slerpLanes - 1;
+			}
+		}
+		#endif
+
+		for (; i < jointCount; ++i)
+		{
+			const SequenceJoint& jointA = jointsA[i];
+			const SequenceJoint& jointB = jointsB[i];
+
+			float dot = jointA.rotation.DotProduct(jointB.rotation);
+			if (std::abs(dot) >= nlerpThreshold)
+			{
+				Quaternionf rotationB = (dot < 0.f) ? Quaternionf(-jointB.rotation.w, -jointB.rotation.x, -jointB.rotation.y, -jointB.rotation.z) : jointB.rotation;
+				output[i].rotation = Quaternionf::Lerp(jointA.rotation, rotationB, interpolation).Normalize();
+			}
+			else
+				output[i].rotation = Quaternionf::Slerp(jointA.rotation, jointB.rotation, interpolation);
+
+			output[i].position = Vector3f::Lerp(jointA.position, jointB.position, interpolation);
+			output[i].scale = Vector3f::Lerp(jointA.scale, jointB.scale, interpolation);
+		}
+	}
+
 	/**********************************Optimize*********************************/
 
 	void OptimizeIndices(IndexIterator indices, unsigned int indexCount)
@@ -1052,100 +1496,868 @@ namespace Nz
 			NazaraWarning("Indices optimizer failed");
 	}
 
-	/************************************Skin***********************************/
+	void OptimizeMeshBuffers(IndexBuffer* indexBuffer, VertexBuffer* vertexBuffer, const MeshParams& params)
+	{
+		NazaraAssert(indexBuffer && indexBuffer->IsValid(), "Invalid index buffer");
+		NazaraAssert(vertexBuffer && vertexBuffer->IsValid(), "Invalid vertex buffer");
 
-	void SkinPosition(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+		const VertexDeclaration* declaration = vertexBuffer->GetVertexDeclaration();
+		unsigned int indexCount = indexBuffer->GetIndexCount();
+		unsigned int vertexCount = vertexBuffer->GetVertexCount();
+
+		if (params.quantizeVertices)
+		{
+			VertexMapper vertexMapper(vertexBuffer, BufferAccess_ReadWrite);
+
+			VertexPointers pointers;
+			pointers.normalPtr = GetFloatComponentPtr<Vector3f>(vertexMapper, declaration, VertexComponent_Normal, ComponentType_Float3);
+			pointers.positionPtr = GetFloatComponentPtr<Vector3f>(vertexMapper, declaration, VertexComponent_Position, ComponentType_Float3);
+			pointers.tangentPtr = GetFloatComponentPtr<Vector3f>(vertexMapper, declaration, VertexComponent_Tangent, ComponentType_Float3);
+			pointers.uvPtr = GetFloatComponentPtr<Vector2f>(vertexMapper, declaration, VertexComponent_TexCoord, ComponentType_Float2);
+
+			QuantizeVertices(pointers, vertexCount);
+		}
+
+		IndexMapper indexMapper(indexBuffer, BufferAccess_ReadWrite);
+
+		if (params.optimizeIndexBuffers)
+		{
+			OptimizeIndices(indexMapper.begin(), indexCount);
+
+			if (params.optimizeOverdraw)
+			{
+				VertexMapper vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+
+				SparsePtr<const Vector3f> positionPtr = GetFloatComponentPtr<const Vector3f>(vertexMapper, declaration, VertexComponent_Position, ComponentType_Float3);
+				if (positionPtr)
+					OptimizeOverdraw(indexMapper.begin(), indexCount, positionPtr, vertexCount);
+			}
+		}
+
+		if (params.optimizeVertexFetch)
+		{
+			std::size_t stride = declaration->GetStride();
+
+			unsigned int usedVertexCount;
+			{
+				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadWrite);
+				usedVertexCount = OptimizeVertexFetch(indexMapper.begin(), indexCount, vertexMapper.GetPointer(), vertexCount, stride);
+			}
+
+			// Unused and duplicated vertices are gone, the buffer is shrunk in place so its owner sees the new size
+			if (usedVertexCount < vertexCount)
+			{
+				std::vector<UInt8> vertices(usedVertexCount * stride);
+				{
+					BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+					std::memcpy(vertices.data(), vertexMapper.GetPointer(), vertices.size());
+				}
+
+				const Buffer* buffer = vertexBuffer->GetBuffer();
+				UInt32 storage = buffer->GetStorage();
+				BufferUsage usage = buffer->GetUsage();
+
+				VertexDeclarationConstRef declarationRef(declaration); // Reset releases the current declaration
+				vertexBuffer->Reset(declarationRef, usedVertexCount, storage, usage);
+				vertexBuffer->Fill(vertices.data(), 0, usedVertexCount, true);
+			}
+		}
+	}
+
+	void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount, float threshold)
 	{
-		const SkeletalMeshVertex* inputVertex = &skinningInfos.inputVertex[startVertex];
-		MeshVertex* outputVertex = &skinningInfos.outputVertex[startVertex];
+		// Triangles are grouped in clusters at cache flush points, clusters are then drawn from the most outward facing
+		// to the most inward facing one (outer triangles are more likely to occlude the inner ones)
+		// Clusters are split as long as this keeps the cache efficiency within threshold of its current value
+		constexpr unsigned int CacheSize = 16;
+
+		unsigned int triangleCount = indexCount / 3;
+		if (triangleCount < 2)
+			return;
 
-		unsigned int endVertex = startVertex + vertexCount - 1;
-		for (unsigned int i = startVertex; i <= endVertex; ++i)
+		std::vector<UInt32> sourceIndices(indexCount);
+		for (unsigned int i = 0; i < indexCount; ++i)
 		{
-			Vector3f finalPosition(Vector3f::Zero());
+			UInt32 index = indices[i];
+			if (index >= vertexCount)
+			{
+				NazaraWarning("Overdraw optimizer failed: index #" + String::Number(i) + " is out of range");
+				return;
+			}
 
-			for (int j = 0; j < inputVertex->weightCount; ++j)
+			sourceIndices[i] = index;
+		}
+
+		// Hard boundaries: triangles missing the whole cache
+		std::vector<unsigned int> hardClusters;
+		{
+			CacheSimulator cache(vertexCount, CacheSize);
+			for (unsigned int i = 0; i < triangleCount; ++i)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
-				mat *= inputVertex->weights[j];
+				if (cache.AddTriangle(sourceIndices[i*3], sourceIndices[i*3 + 1], sourceIndices[i*3 + 2]) == 3)
+					hardClusters.push_back(i);
+			}
+		}
+		hardClusters.push_back(triangleCount);
+
+		// Soft boundaries: points where restarting from an empty cache doesn't cost more than the threshold allows
+		std::vector<unsigned int> clusters;
+		{
+			CacheSimulator cache(vertexCount, CacheSize);
+			for (std::size_t c = 0; c + 1 < hardClusters.size(); ++c)
+			{
+				unsigned int start = hardClusters[c];
+				unsigned int end = hardClusters[c + 1];
+
+				unsigned int clusterMisses = 0;
+				cache.Flush();
+				for (unsigned int i = start; i < end; ++i)
+					clusterMisses += cache.AddTriangle(sourceIndices[i*3], sourceIndices[i*3 + 1], sourceIndices[i*3 + 2]);
+
+				float missThreshold = threshold * clusterMisses / (end - start);
+
+				clusters.push_back(start);
+
+				unsigned int runningMisses = 0;
+				unsigned int runningTriangles = 0;
+				cache.Flush();
+				for (unsigned int i = start; i < end; ++i)
+				{
+					runningMisses += cache.AddTriangle(sourceIndices[i*3], sourceIndices[i*3 + 1], sourceIndices[i*3 + 2]);
+					runningTriangles++;
+
+					if (i + 1 < end && runningMisses <= missThreshold * runningTriangles)
+					{
+						clusters.push_back(i + 1);
+						runningMisses = 0;
+						runningTriangles = 0;
+						cache.Flush();
+					}
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		std::size_t clusterCount = clusters.size() - 1;
+		if (clusterCount < 2)
+			return;
+
+		// Area weighted centroids and normals
+		Vector3f meshCentroid = Vector3f::Zero();
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			meshCentroid += positionPtr[i];
+
+		meshCentroid /= static_cast<float>(vertexCount);
+
+		std::vector<float> sortKeys(clusterCount);
+		for (std::size_t c = 0; c < clusterCount; ++c)
+		{
+			Vector3f centroid = Vector3f::Zero();
+			Vector3f normal = Vector3f::Zero();
+			float area = 0.f;
+
+			for (unsigned int i = clusters[c]; i < clusters[c + 1]; ++i)
+			{
+				const Vector3f& a = positionPtr[sourceIndices[i*3]];
+				const Vector3f& b = positionPtr[sourceIndices[i*3 + 1]];
+				const Vector3f& c2 = positionPtr[sourceIndices[i*3 + 2]];
+
+				Vector3f triangleNormal = Vector3f::CrossProduct(b - a, c2 - a);
+				float triangleArea = triangleNormal.GetLength();
 
-				finalPosition += mat.Transform(inputVertex->position);
+				centroid += (a + b + c2) * (triangleArea / 3.f);
+				normal += triangleNormal;
+				area += triangleArea;
 			}
 
-			outputVertex->position = finalPosition;
-			outputVertex->uv = inputVertex->uv;
+			// Multiplications, since tiny triangles are legit but would trip the division checks
+			if (area > 0.f)
+				centroid *= 1.f / area;
 
-			inputVertex++;
-			outputVertex++;
+			float normalLength = normal.GetLength();
+			if (normalLength > 0.f)
+				normal *= 1.f / normalLength;
+
+			sortKeys[c] = Vector3f::DotProduct(centroid - meshCentroid, normal);
+		}
+
+		std::vector<std::size_t> clusterOrder(clusterCount);
+		for (std::size_t c = 0; c < clusterCount; ++c)
+			clusterOrder[c] = c;
+
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](std::size_t a, std::size_t b)
+		{
+			return sortKeys[a] > sortKeys[b];
+		});
+
+		unsigned int index = 0;
+		for (std::size_t c : clusterOrder)
+		{
+			for (unsigned int i = clusters[c] * 3; i < clusters[c + 1] * 3; ++i)
+				indices[index++] = sourceIndices[i];
 		}
 	}
 
-	void SkinPositionNormal(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	unsigned int OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, unsigned int vertexCount, std::size_t vertexStride)
 	{
-		const SkeletalMeshVertex* inputVertex = &skinningInfos.inputVertex[startVertex];
-		MeshVertex* outputVertex = &skinningInfos.outputVertex[startVertex];
+		constexpr UInt32 Unused = std::numeric_limits<UInt32>::max();
+
+		UInt8* vertexBytes = static_cast<UInt8*>(vertices);
+
+		std::unordered_map<const UInt8*, UInt32, VertexBytesHasher, VertexBytesComparator> uniqueVertices(vertexCount, VertexBytesHasher{vertexStride}, VertexBytesComparator{vertexStride});
+		std::vector<UInt32> remap(vertexCount, Unused);
+		std::vector<UInt32> sources;
+		sources.reserve(vertexCount);
 
-		unsigned int endVertex = startVertex + vertexCount - 1;
-		for (unsigned int i = startVertex; i <= endVertex; ++i)
+		for (unsigned int i = 0; i < indexCount; ++i)
 		{
-			Vector3f finalPosition(Vector3f::Zero());
-			Vector3f finalNormal(Vector3f::Zero());
+			UInt32 index = indices[i];
+			if (index >= vertexCount)
+			{
+				NazaraWarning("Vertex fetch optimizer failed: index #" + String::Number(i) + " is out of range");
+				return vertexCount;
+			}
 
-			for (int j = 0; j < inputVertex->weightCount; ++j)
+			if (remap[index] == Unused)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
-				mat *= inputVertex->weights[j];
+				auto pair = uniqueVertices.emplace(&vertexBytes[index * vertexStride], static_cast<UInt32>(sources.size()));
+				if (pair.second)
+					sources.push_back(index);
 
-				finalPosition += mat.Transform(inputVertex->position);
-				finalNormal += mat.Transform(inputVertex->normal, 0.f);
+				remap[index] = pair.first->second;
 			}
+		}
+
+		for (unsigned int i = 0; i < indexCount; ++i)
+			indices[i] = remap[indices[i]];
 
-			finalNormal.Normalize();
+		std::vector<UInt8> reordered(sources.size() * vertexStride);
+		for (std::size_t i = 0; i < sources.size(); ++i)
+			std::memcpy(&reordered[i * vertexStride], &vertexBytes[sources[i] * vertexStride], vertexStride);
+
+		std::memcpy(vertexBytes, reordered.data(), reordered.size());
+
+		return static_cast<unsigned int>(sources.size());
+	}
 
-			outputVertex->normal = finalNormal;
-			outputVertex->position = finalPosition;
-			outputVertex->uv = inputVertex->uv;
+	/************************************Pack***********************************/
 
-			inputVertex++;
-			outputVertex++;
+	UInt16 PackHalf(float value)
+	{
+		UInt32 bits;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		UInt16 sign = static_cast<UInt16>((bits >> 16) & 0x8000);
+		UInt32 exponent = (bits >> 23) & 0xFF;
+		UInt32 mantissa = bits & 0x7FFFFF;
+
+		// Infinity and NaN
+		if (exponent == 0xFF)
+			return sign | 0x7C00 | ((mantissa != 0) ? 0x200 : 0);
+
+		int halfExponent = static_cast<int>(exponent) - 127 + 15;
+		if (halfExponent >= 0x1F)
+			return sign | 0x7C00; // Too large, becomes infinity
+
+		UInt32 half;
+		unsigned int shift;
+		if (halfExponent <= 0)
+		{
+			// Denormalized half-float (or zero)
+			if (halfExponent < -10)
+				return sign;
+
+			mantissa |= 0x800000;
+			shift = 14 - halfExponent;
+			half = mantissa >> shift;
 		}
+		else
+		{
+			shift = 13;
+			half = (static_cast<UInt32>(halfExponent) << 10) | (mantissa >> shift);
+		}
+
+		// Round to nearest even, a carry into the exponent is still correct
+		UInt32 remainder = mantissa & ((1U << shift) - 1);
+		UInt32 halfway = 1U << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+			half++;
+
+		return sign | static_cast<UInt16>(half);
 	}
 
-	void SkinPositionNormalTangent(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	UInt32 PackNormalizedInt2101010(const Vector4f& value)
 	{
-		const SkeletalMeshVertex* inputVertex = &skinningInfos.inputVertex[startVertex];
-		MeshVertex* outputVertex = &skinningInfos.outputVertex[startVertex];
+		auto Pack = [](float component, float maxValue, UInt32 mask) -> UInt32
+		{
+			return static_cast<UInt32>(static_cast<int>(std::round(Clamp(component, -1.f, 1.f) * maxValue))) & mask;
+		};
+
+		return Pack(value.x, 511.f, 0x3FF) | (Pack(value.y, 511.f, 0x3FF) << 10) | (Pack(value.z, 511.f, 0x3FF) << 20) | (Pack(value.w, 1.f, 0x3) << 30);
+	}
+
+	/**********************************Quantize*********************************/
+
+	void QuantizeVertices(VertexPointers vertexPointers, unsigned int vertexCount, unsigned int positionBits)
+	{
+		NazaraAssert(positionBits > 0 && positionBits <= 24, "Invalid position bit count");
+
+		if (vertexCount == 0)
+			return;
+
+		if (vertexPointers.positionPtr)
+		{
+			// Positions are snapped on a grid spanning the bounding box
+			Boxf aabb = ComputeAABB(vertexPointers.positionPtr, vertexCount);
+			float maxValue = static_cast<float>((1U << positionBits) - 1);
+			Vector3f step(aabb.width / maxValue, aabb.height / maxValue, aabb.depth / maxValue);
+
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				Vector3f& position = vertexPointers.positionPtr[i];
+				position.Set(Quantize(position.x, aabb.x, step.x), Quantize(position.y, aabb.y, step.y), Quantize(position.z, aabb.z, step.z));
+			}
+		}
+
+		// Unit vectors get a signed 8 bits precision per component
+		auto QuantizeDirections = [vertexCount](SparsePtr<Vector3f> directionPtr)
+		{
+			if (!directionPtr)
+				return;
+
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				Vector3f& direction = directionPtr[i];
+				direction.Set(std::round(direction.x * 127.f) / 127.f, std::round(direction.y * 127.f) / 127.f, std::round(direction.z * 127.f) / 127.f);
+			}
+		};
+
+		QuantizeDirections(vertexPointers.normalPtr);
+		QuantizeDirections(vertexPointers.tangentPtr);
+
+		if (vertexPointers.uvPtr)
+		{
+			// Texture coordinates get 16 bits of precision per texture repetition
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				Vector2f& uv = vertexPointers.uvPtr[i];
+				uv.Set(std::round(uv.x * 65535.f) / 65535.f, std::round(uv.y * 65535.f) / 65535.f);
+			}
+		}
+	}
+
+	/*********************************Simplify**********************************/
+
+	void SimplifyIndices(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount, unsigned int targetIndexCount, std::vector<UInt32>* simplifiedIndices)
+	{
+		NazaraAssert(indexCount % 3 == 0, "Index count must be a multiple of three");
+		NazaraAssert(simplifiedIndices, "Invalid simplified indices");
+
+		// Edge collapse driven by quadric error metrics, collapsing a vertex into one of its neighbours
+		// Vertices are never moved, so the simplified indices keep using the same vertex buffer
+		std::vector<UInt32>& result = *simplifiedIndices;
+		result.resize(indexCount);
+		for (unsigned int i = 0; i < indexCount; ++i)
+			result[i] = indices[i];
+
+		if (std::any_of(result.begin(), result.end(), [=](UInt32 index) { return index >= vertexCount; }))
+		{
+			NazaraWarning("Simplification failed: indices are out of range");
+			return;
+		}
+
+		// Vertices sharing a position (splitted by other attributes) form a single position
+		std::vector<UInt32> positionIds(vertexCount);
+		unsigned int positionCount;
+		{
+			std::unordered_map<Vector3f, UInt32, PositionHasher, PositionComparator> positions(vertexCount);
+			for (unsigned int i = 0; i < vertexCount; ++i)
+				positionIds[i] = positions.emplace(positionPtr[i], static_cast<UInt32>(positions.size())).first->second;
+
+			positionCount = static_cast<unsigned int>(positions.size());
+		}
+
+		// Seams (positions used by more than one vertex) and borders are locked to keep the mesh closed
+		std::vector<bool> locked(positionCount, false);
+		{
+			std::vector<UInt32> positionVertex(positionCount, std::numeric_limits<UInt32>::max());
+			std::unordered_map<UInt64, unsigned int> edgeUsage(indexCount);
+			for (unsigned int i = 0; i < indexCount; i += 3)
+			{
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					UInt32 vertex = result[i + j];
+					UInt32& firstVertex = positionVertex[positionIds[vertex]];
+					if (firstVertex == std::numeric_limits<UInt32>::max())
+						firstVertex = vertex;
+					else if (firstVertex != vertex)
+						locked[positionIds[vertex]] = true;
+
+					UInt32 a = positionIds[vertex];
+					UInt32 b = positionIds[result[i + (j + 1) % 3]];
+					edgeUsage[(static_cast<UInt64>(std::min(a, b)) << 32) | std::max(a, b)]++;
+				}
+			}
+
+			for (const auto& pair : edgeUsage)
+			{
+				if (pair.second != 2)
+				{
+					locked[pair.first >> 32] = true;
+					locked[pair.first & 0xFFFFFFFF] = true;
+				}
+			}
+		}
+
+		std::vector<Quadric> quadrics(positionCount);
+		for (unsigned int i = 0; i < indexCount; i += 3)
+		{
+			const Vector3f& p0 = positionPtr[result[i]];
+			const Vector3f& p1 = positionPtr[result[i + 1]];
+			const Vector3f& p2 = positionPtr[result[i + 2]];
+
+			Vector3f normal = Vector3f::CrossProduct(p1 - p0, p2 - p0);
+			float length = normal.GetLength();
+			if (length <= 0.f)
+				continue;
+
+			normal *= 1.f / length;
+			float distance = -Vector3f::DotProduct(normal, p0);
+
+			// Weighted by the triangle area
+			for (unsigned int j = 0; j < 3; ++j)
+				quadrics[positionIds[result[i + j]]].AddPlane(normal, distance, length * 0.5f);
+		}
+
+		auto IsTriangleFlipped = [&](UInt32 triangle, UInt32 from, UInt32 to)
+		{
+			Vector3f p[3];
+			Vector3f newP[3];
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				UInt32 vertex = result[triangle * 3 + j];
+				p[j] = positionPtr[vertex];
+				newP[j] = (vertex == from) ? positionPtr[to] : p[j];
+			}
+
+			Vector3f normal = Vector3f::CrossProduct(p[1] - p[0], p[2] - p[0]);
+			Vector3f newNormal = Vector3f::CrossProduct(newP[1] - newP[0], newP[2] - newP[0]);
+
+			// Strongly tilted triangles are rejected as well, they usually fold over their neighbours
+			return Vector3f::DotProduct(normal, newNormal) <= 0.25f * normal.GetLength() * newNormal.GetLength();
+		};
+
+		std::vector<EdgeCollapse> collapses;
+		std::vector<UInt32> remap(vertexCount);
+		std::vector<bool> touched(positionCount);
+		std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+		std::vector<UInt32> adjacency;
 
-		unsigned int endVertex = startVertex + vertexCount - 1;
-		for (unsigned int i = startVertex; i <= endVertex; ++i)
+		targetIndexCount -= targetIndexCount % 3;
+		while (result.size() > targetIndexCount)
 		{
-			Vector3f finalPosition(Vector3f::Zero());
-			Vector3f finalNormal(Vector3f::Zero());
-			Vector3f finalTangent(Vector3f::Zero());
+			unsigned int triangleCount = static_cast<unsigned int>(result.size() / 3);
+
+			// Vertex to triangles adjacency, to check the triangles moved by a collapse
+			std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+			for (UInt32 index : result)
+				adjacencyOffsets[index + 1]++;
+
+			for (unsigned int i = 0; i < vertexCount; ++i)
+				adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+			adjacency.resize(result.size());
+			{
+				std::vector<unsigned int> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+				for (unsigned int i = 0; i < result.size(); ++i)
+					adjacency[fillOffsets[result[i]]++] = i / 3;
+			}
 
-			for (int j = 0; j < inputVertex->weightCount; ++j)
+			collapses.clear();
+			for (unsigned int i = 0; i < result.size(); i += 3)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
-				mat *= inputVertex->weights[j];
+				for (unsigned int j = 0; j < 3; ++j)
+				{
+					UInt32 a = result[i + j];
+					UInt32 b = result[i + (j + 1) % 3];
+
+					UInt32 positionA = positionIds[a];
+					UInt32 positionB = positionIds[b];
+					if (positionA == positionB)
+						continue;
+
+					if (!locked[positionA])
+						collapses.push_back({a, b, quadrics[positionA].Evaluate(positionPtr[b]) + quadrics[positionB].Evaluate(positionPtr[b])});
+
+					if (!locked[positionB])
+						collapses.push_back({b, a, quadrics[positionA].Evaluate(positionPtr[a]) + quadrics[positionB].Evaluate(positionPtr[a])});
+				}
+			}
+
+			std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& lhs, const EdgeCollapse& rhs)
+			{
+				return lhs.error < rhs.error;
+			});
+
+			for (unsigned int i = 0; i < vertexCount; ++i)
+				remap[i] = i;
+
+			std::fill(touched.begin(), touched.end(), false);
+
+			// Positions around a collapse are not collapsed again in the same pass, since their errors are outdated
+			unsigned int removableTriangles = triangleCount - targetIndexCount / 3;
+			unsigned int removedTriangles = 0;
+			for (const EdgeCollapse& collapse : collapses)
+			{
+				if (removedTriangles >= removableTriangles)
+					break;
+
+				UInt32 fromPosition = positionIds[collapse.from];
+				UInt32 toPosition = positionIds[collapse.to];
+				if (touched[fromPosition] || touched[toPosition])
+					continue;
+
+				bool flipped = false;
+				for (unsigned int j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1]; ++j)
+				{
+					UInt32 triangle = adjacency[j];
+
+					bool removed = false;
+					for (unsigned int k = 0; k < 3; ++k)
+					{
+						if (positionIds[result[triangle * 3 + k]] == toPosition)
+							removed = true;
+					}
+
+					if (!removed && IsTriangleFlipped(triangle, collapse.from, collapse.to))
+					{
+						flipped = true;
+						break;
+					}
+				}
+
+				if (flipped)
+					continue;
 
-				finalPosition += mat.Transform(inputVertex->position);
-				finalNormal += mat.Transform(inputVertex->normal, 0.f);
-				finalTangent += mat.Transform(inputVertex->tangent, 0.f);
+				remap[collapse.from] = collapse.to;
+				quadrics[toPosition] += quadrics[fromPosition];
+
+				// The moved triangles were checked against the current positions, which must stay valid until the end of the pass
+				for (unsigned int j = adjacencyOffsets[collapse.from]; j < adjacencyOffsets[collapse.from + 1]; ++j)
+				{
+					for (unsigned int k = 0; k < 3; ++k)
+						touched[positionIds[result[adjacency[j] * 3 + k]]] = true;
+				}
+
+				removedTriangles += 2; // The two triangles sharing the edge
 			}
 
-			finalNormal.Normalize();
-			finalTangent.Normalize();
+			if (removedTriangles == 0)
+				break; // Nothing can be collapsed anymore
+
+			std::size_t writeIndex = 0;
+			for (std::size_t i = 0; i < result.size(); i += 3)
+			{
+				UInt32 a = remap[result[i]];
+				UInt32 b = remap[result[i + 1]];
+				UInt32 c = remap[result[i + 2]];
+
+				if (positionIds[a] == positionIds[b] || positionIds[b] == positionIds[c] || positionIds[a] == positionIds[c])
+					continue;
 
-			outputVertex->normal = finalNormal;
-			outputVertex->position = finalPosition;
-			outputVertex->tangent = finalTangent;
-			outputVertex->uv = inputVertex->uv;
+				result[writeIndex++] = a;
+				result[writeIndex++] = b;
+				result[writeIndex++] = c;
+			}
 
-			inputVertex++;
-			outputVertex++;
+			result.resize(writeIndex);
 		}
 	}
 
+	/************************************Skin***********************************/
+
+	namespace
+	{
+		// Skinning is done once per animated mesh and frame, the kernels are dispatched at runtime to SIMD implementations
+		// Each vertex blends the matrices of its joints before transforming its position and directions with the result,
+		// instead of transforming them once per joint
+		using SkinFunction = void(*)(const Matrix4f* matrices, const SkeletalMeshVertex* inputVertex, MeshVertex* outputVertex, unsigned int vertexCount);
+
+		// Vertices are read linearly, some of them ahead are prefetched while the current one is blended
+		constexpr unsigned int SkinPrefetchDistance = 4;
+
+		template<bool Normal, bool Tangent>
+		void SkinGeneric(const Matrix4f* matrices, const SkeletalMeshVertex* inputVertex, MeshVertex* outputVertex, unsigned int vertexCount)
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				float blended[16] = {};
+				for (int j = 0; j < inputVertex->weightCount; ++j)
+				{
+					const float* matrix = matrices[inputVertex->jointIndexes[j]];
+					float weight = inputVertex->weights[j];
+
+					for (unsigned int k = 0; k < 16; ++k)
+						blended[k] += matrix[k] * weight;
+				}
+
+				auto Transform = [&](const Vector3f& vector, float w)
+				{
+					return Vector3f(blended[0] * vector.x + blended[4] * vector.y + blended[8] * vector.z + blended[12] * w,
+					                blended[1] * vector.x + blended[5] * vector.y + blended[9] * vector.z + blended[13] * w,
+					                blended[2] * vector.x + blended[6] * vector.y + blended[10] * vector.z + blended[14] * w);
+				};
+
+				outputVertex->position = Transform(inputVertex->position, 1.f);
+				if (Normal)
+					outputVertex->normal = Transform(inputVertex->normal, 0.f).Normalize();
+
+				if (Tangent)
+					outputVertex->tangent = Transform(inputVertex->tangent, 0.f).Normalize();
+
+				outputVertex->uv = inputVertex->uv;
+
+				inputVertex++;
+				outputVertex++;
+			}
+		}
+
+		#ifdef NAZARA_ALGORITHMUTILITY_X86
+		// Vectors are loaded with their following member as fourth component (ignored), which stays in the vertex
+		// Stores only write three components, not to overwrite the next member
+		NAZARA_SSE2_FUNCTION inline void StoreVector3SSE2(Vector3f* vector, __m128 value)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64*>(&vector->x), value);
+			_mm_store_ss(&vector->z, _mm_movehl_ps(value, value));
+		}
+
+		NAZARA_SSE2_FUNCTION inline __m128 TransformSSE2(const __m128 rows[4], const Vector3f& vector, bool translate)
+		{
+			__m128 value = _mm_loadu_ps(&vector.x);
+
+			__m128 result = _mm_mul_ps(_mm_shuffle_ps(value, value, _MM_SHUFFLE(0, 0, 0, 0)), rows[0]);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 1, 1, 1)), rows[1]));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 2, 2)), rows[2]));
+			if (translate)
+				result = _mm_add_ps(result, rows[3]);
+
+			return result;
+		}
+
+		NAZARA_SSE2_FUNCTION inline __m128 NormalizeSSE2(__m128 value)
+		{
+			__m128 squares = _mm_mul_ps(value, value);
+			__m128 squaredLength = _mm_add_ss(_mm_add_ss(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(1, 1, 1, 1))), _mm_movehl_ps(squares, squares));
+
+			float length = _mm_cvtss_f32(_mm_sqrt_ss(squaredLength));
+			if (length <= 0.f)
+				return value;
+
+			return _mm_mul_ps(value, _mm_set1_ps(1.f / length));
+		}
+
+		template<bool Normal, bool Tangent>
+		NAZARA_SSE2_FUNCTION void SkinSSE2(const Matrix4f* matrices, const SkeletalMeshVertex* inputVertex, MeshVertex* outputVertex, unsigned int vertexCount)
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				_mm_prefetch(reinterpret_cast<const char*>(inputVertex + SkinPrefetchDistance), _MM_HINT_T0);
+
+				__m128 rows[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+				for (int j = 0; j < inputVertex->weightCount; ++j)
+				{
+					const float* matrix = matrices[inputVertex->jointIndexes[j]];
+					__m128 weight = _mm_set1_ps(inputVertex->weights[j]);
+
+					for (unsigned int row = 0; row < 4; ++row)
+						rows[row] = _mm_add_ps(rows[row], _mm_mul_ps(_mm_loadu_ps(&matrix[row * 4]), weight));
+				}
+
+				StoreVector3SSE2(&outputVertex->position, TransformSSE2(rows, inputVertex->position, true));
+				if (Normal)
+					StoreVector3SSE2(&outputVertex->normal, NormalizeSSE2(TransformSSE2(rows, inputVertex->normal, false)));
+
+				if (Tangent)
+					StoreVector3SSE2(&outputVertex->tangent, NormalizeSSE2(TransformSSE2(rows, inputVertex->tangent, false)));
+
+				outputVertex->uv = inputVertex->uv;
+
+				inputVertex++;
+				outputVertex++;
+			}
+		}
+
+		NAZARA_AVX2_FUNCTION inline __m128 TransformAVX2(const __m128 rows[4], const Vector3f& vector, bool translate)
+		{
+			__m128 value = _mm_loadu_ps(&vector.x);
+
+			__m128 result = (translate) ? rows[3] : _mm_setzero_ps();
+			result = _mm_fmadd_ps(_mm_permute_ps(value, _MM_SHUFFLE(0, 0, 0, 0)), rows[0], result);
+			result = _mm_fmadd_ps(_mm_permute_ps(value, _MM_SHUFFLE(1, 1, 1, 1)), rows[1], result);
+			result = _mm_fmadd_ps(_mm_permute_ps(value, _MM_SHUFFLE(2, 2, 2, 2)), rows[2], result);
+
+			return result;
+		}
+
+		template<bool Normal, bool Tangent>
+		NAZARA_AVX2_FUNCTION void SkinAVX2(const Matrix4f* matrices, const SkeletalMeshVertex* inputVertex, MeshVertex* outputVertex, unsigned int vertexCount)
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				_mm_prefetch(reinterpret_cast<const char*>(inputVertex + SkinPrefetchDistance), _MM_HINT_T0);
+
+				// Two rows per register, halving the blending work
+				__m256 rows01 = _mm256_setzero_ps();
+				__m256 rows23 = _mm256_setzero_ps();
+				for (int j = 0; j < inputVertex->weightCount; ++j)
+				{
+					const float* matrix = matrices[inputVertex->jointIndexes[j]];
+					__m256 weight = _mm256_set1_ps(inputVertex->weights[j]);
+
+					rows01 = _mm256_fmadd_ps(_mm256_loadu_ps(&matrix[0]), weight, rows01);
+					rows23 = _mm256_fmadd_ps(_mm256_loadu_ps(&matrix[8]), weight, rows23);
+				}
+
+				__m128 rows[4] = {_mm256_castps256_ps128(rows01), _mm256_extractf128_ps(rows01, 1), _mm256_castps256_ps128(rows23), _mm256_extractf128_ps(rows23, 1)};
+
+				StoreVector3SSE2(&outputVertex->position, TransformAVX2(rows, inputVertex->position, true));
+				if (Normal)
+					StoreVector3SSE2(&outputVertex->normal, NormalizeSSE2(TransformAVX2(rows, inputVertex->normal, false)));
+
+				if (Tangent)
+					StoreVector3SSE2(&outputVertex->tangent, NormalizeSSE2(TransformAVX2(rows, inputVertex->tangent, false)));
+
+				outputVertex->uv = inputVertex->uv;
+
+				inputVertex++;
+				outputVertex++;
+			}
+
+			_mm256_zeroupper();
+		}
+		#endif
+
+		#ifdef NAZARA_ALGORITHMUTILITY_NEON
+		inline void StoreVector3NEON(Vector3f* vector, float32x4_t value)
+		{
+			vst1_f32(&vector->x, vget_low_f32(value));
+			vst1q_lane_f32(&vector->z, value, 2);
+		}
+
+		inline float32x4_t TransformNEON(const float32x4_t rows[4], const Vector3f& vector, bool translate)
+		{
+			float32x4_t result = (translate) ? rows[3] : vdupq_n_f32(0.f);
+			result = vfmaq_n_f32(result, rows[0], vector.x);
+			result = vfmaq_n_f32(result, rows[1], vector.y);
+			result = vfmaq_n_f32(result, rows[2], vector.z);
+
+			return result;
+		}
+
+		inline float32x4_t NormalizeNEON(float32x4_t value)
+		{
+			float32x4_t squares = vmulq_f32(value, value);
+			float length = std::sqrt(vgetq_lane_f32(squares, 0) + vgetq_lane_f32(squares, 1) + vgetq_lane_f32(squares, 2));
+			if (length <= 0.f)
+				return value;
+
+			return vmulq_n_f32(value, 1.f / length);
+		}
+
+		template<bool Normal, bool Tangent>
+		void SkinNEON(const Matrix4f* matrices, const SkeletalMeshVertex* inputVertex, MeshVertex* outputVertex, unsigned int vertexCount)
+		{
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				__builtin_prefetch(inputVertex + SkinPrefetchDistance);
+
+				float32x4_t rows[4] = {vdupq_n_f32(0.f), vdupq_n_f32(0.f), vdupq_n_f32(0.f), vdupq_n_f32(0.f)};
+				for (int j = 0; j < inputVertex->weightCount; ++j)
+				{
+					const float* matrix = matrices[inputVertex->jointIndexes[j]];
+					float weight = inputVertex->weights[j];
+
+					for (unsigned int row = 0; row < 4; ++row)
+						rows[row] = vfmaq_n_f32(rows[row], vld1q_f32(&matrix[row * 4]), weight);
+				}
+
+				StoreVector3NEON(&outputVertex->position, TransformNEON(rows, inputVertex->position, true));
+				if (Normal)
+					StoreVector3NEON(&outputVertex->normal, NormalizeNEON(TransformNEON(rows, inputVertex->normal, false)));
+
+				if (Tangent)
+					StoreVector3NEON(&outputVertex->tangent, NormalizeNEON(TransformNEON(rows, inputVertex->tangent, false)));
+
+				outputVertex->uv = inputVertex->uv;
+
+				inputVertex++;
+				outputVertex++;
+			}
+		}
+		#endif
+
+		CpuKernel<void(const Matrix4f*, const SkeletalMeshVertex*, MeshVertex*, unsigned int)> s_skinPositionKernel("Position skinning", &SkinGeneric<false, false>, {
+			#ifdef NAZARA_ALGORITHMUTILITY_X86
+			{&SkinAVX2<false, false>, "AVX2", {ProcessorCap_AVX2, ProcessorCap_FMA3}},
+			{&SkinSSE2<false, false>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMUTILITY_NEON
+			{&SkinNEON<false, false>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const Matrix4f*, const SkeletalMeshVertex*, MeshVertex*, unsigned int)> s_skinPositionNormalKernel("Position and normal skinning", &SkinGeneric<true, false>, {
+			#ifdef NAZARA_ALGORITHMUTILITY_X86
+			{&SkinAVX2<true, false>, "AVX2", {ProcessorCap_AVX2, ProcessorCap_FMA3}},
+			{&SkinSSE2<true, false>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMUTILITY_NEON
+			{&SkinNEON<true, false>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(const Matrix4f*, const SkeletalMeshVertex*, MeshVertex*, unsigned int)> s_skinPositionNormalTangentKernel("Position, normal and tangent skinning", &SkinGeneric<true, true>, {
+			#ifdef NAZARA_ALGORITHMUTILITY_X86
+			{&SkinAVX2<true, true>, "AVX2", {ProcessorCap_AVX2, ProcessorCap_FMA3}},
+			{&SkinSSE2<true, true>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_ALGORITHMUTILITY_NEON
+			{&SkinNEON<true, true>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		void Skin(const CpuKernel<void(const Matrix4f*, const SkeletalMeshVertex*, MeshVertex*, unsigned int)>& kernel, const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+		{
+			if (vertexCount == 0)
+				return;
+
+			const SkeletalMeshVertex* inputVertex = &skinningInfos.inputVertex[startVertex];
+			MeshVertex* outputVertex = &skinningInfos.outputVertex[startVertex];
+
+			// Lazily computed by the skeleton, callers skinning from multiple threads should give it themselves
+			const Matrix4f* skinningMatrices = skinningInfos.skinningMatrices;
+			if (!skinningMatrices)
+				skinningMatrices = skinningInfos.joints->GetSkeleton()->GetSkinningMatrices();
+
+			kernel(skinningMatrices, inputVertex, outputVertex, vertexCount);
+		}
+	}
+
+	void SkinPosition(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	{
+		Skin(s_skinPositionKernel, skinningInfos, startVertex, vertexCount);
+	}
+
+	void SkinPositionNormal(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	{
+		Skin(s_skinPositionNormalKernel, skinningInfos, startVertex, vertexCount);
+	}
+
+	void SkinPositionNormalTangent(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
+	{
+		Skin(s_skinPositionNormalTangentKernel, skinningInfos, startVertex, vertexCount);
+	}
+
 	/*********************************Transform*********************************/
 
 	void TransformVertices(VertexPointers vertexPointers, unsigned int vertexCount, const Matrix4f& matrix)
@@ -1164,4 +2376,41 @@ namespace Nz
 				*vertexPointers.tangentPtr++ = matrix.Transform(*vertexPointers.tangentPtr, 0.f) / scale;
 			}
 	}
+
+	/***********************************Unpack**********************************/
+
+	float UnpackHalf(UInt16 value)
+	{
+		UInt32 sign = static_cast<UInt32>(value & 0x8000) << 16;
+		UInt32 exponent = (value >> 10) & 0x1F;
+		UInt32 mantissa = value & 0x3FF;
+
+		UInt32 bits;
+		if (exponent == 0x1F)
+			bits = sign | 0x7F800000 | (mantissa << 13); // Infinity and NaN
+		else if (exponent == 0)
+		{
+			// Zero or denormalized half-float (which are normalized floats)
+			float result = std::ldexp(static_cast<float>(mantissa), -24);
+			return (sign != 0) ? -result : result;
+		}
+		else
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(float));
+
+		return result;
+	}
+
+	Vector4f UnpackNormalizedInt2101010(UInt32 value)
+	{
+		// Shifting to the top bits then back sign-extends each component
+		int x = static_cast<int>(value << 22) >> 22;
+		int y = static_cast<int>(value << 12) >> 22;
+		int z = static_cast<int>(value << 2) >> 22;
+		int w = static_cast<int>(value) >> 30;
+
+		return Vector4f(std::max(x / 511.f, -1.f), std::max(y / 511.f, -1.f), std::max(z / 511.f, -1.f), std::max(static_cast<float>(w), -1.f));
+	}
 }
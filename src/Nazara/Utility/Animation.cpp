@@ -4,25 +4,219 @@
 
 #include <Nazara/Utility/Animation.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Scratch buffers of AnimateSkeleton, kept between the calls to avoid an allocation per frame
+		thread_local std::vector<SequenceJoint> t_decodedPoses;
+		thread_local std::vector<SequenceJoint> t_interpolatedPose;
+
+		// Components other than the largest one of a unit quaternion are in the [-1/sqrt(2), 1/sqrt(2)] range
+		constexpr float s_smallestThreeRange = 0.707106781f;
+
+		struct CompressedTrack
+		{
+			UInt32 firstKey;
+			UInt32 keyCount;
+		};
+
+		struct CompressedJoint
+		{
+			CompressedTrack position;
+			CompressedTrack rotation;
+			CompressedTrack scale;
+			Vector3f positionMin;
+			Vector3f positionRange;
+			Vector3f scaleMin;
+			Vector3f scaleRange;
+		};
+
+		Quaternionf InterpolateRotation(const Quaternionf& from, const Quaternionf& to, float interpolation)
+		{
+			// Keys are close enough for a normalized linear interpolation, along the shortest path
+			float sign = (from.DotProduct(to) < 0.f) ? -1.f : 1.f;
+
+			Quaternionf rotation(from.w + (sign * to.w - from.w) * interpolation,
+			                     from.x + (sign * to.x - from.x) * interpolation,
+			                     from.y + (sign * to.y - from.y) * interpolation,
+			                     from.z + (sign * to.z - from.z) * interpolation);
+
+			return rotation.Normalize();
+		}
+
+		// Smallest three: the largest component is dropped (and rebuilt from the unit length), the three others take 15 bits each
+		void QuantizeRotation(const Quaternionf& rotation, UInt16* output)
+		{
+			float components[4] = {rotation.w, rotation.x, rotation.y, rotation.z};
+
+			unsigned int largest = 0;
+			for (unsigned int i = 1; i < 4; ++i)
+			{
+				if (std::abs(components[i]) > std::abs(components[largest]))
+					largest = i;
+			}
+
+			// q and -q are the same rotation, the largest component is made positive
+			float sign = (components[largest] < 0.f) ? -1.f : 1.f;
+
+			unsigned int j = 0;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				if (i == largest)
+					continue;
+
+				float normalized = Clamp((sign * components[i] / s_smallestThreeRange + 1.f) * 0.5f, 0.f, 1.f);
+				output[j++] = static_cast<UInt16>(std::lround(normalized * 32767.f));
+			}
+
+			// The index of the dropped component takes the remaining high bits
+			output[0] |= static_cast<UInt16>((largest & 2) << 14);
+			output[1] |= static_cast<UInt16>((largest & 1) << 15);
+		}
+
+		Quaternionf DequantizeRotation(const UInt16* input)
+		{
+			unsigned int largest = ((input[0] >> 14) & 2) | (input[1] >> 15);
+
+			float components[4];
+			float squaredLength = 0.f;
+
+			unsigned int j = 0;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				if (i == largest)
+					continue;
+
+				float component = ((input[j++] & 0x7FFF) / 32767.f * 2.f - 1.f) * s_smallestThreeRange;
+				components[i] = component;
+				squaredLength += component * component;
+			}
+
+			components[largest] = std::sqrt(std::max(1.f - squaredLength, 0.f));
+
+			return Quaternionf(components[0], components[1], components[2], components[3]);
+		}
+
+		// Vectors take 16 bits per component, relatively to the bounds of their track
+		void QuantizeVector(const Vector3f& vector, const Vector3f& min, const Vector3f& range, UInt16* output)
+		{
+			for (unsigned int i = 0; i < 3; ++i)
+				output[i] = (range[i] > 0.f) ? static_cast<UInt16>(std::lround(Clamp((vector[i] - min[i]) / range[i], 0.f, 1.f) * 65535.f)) : 0;
+		}
+
+		Vector3f DequantizeVector(const UInt16* input, const Vector3f& min, const Vector3f& range)
+		{
+			return Vector3f(min.x + range.x * (input[0] / 65535.f),
+			                min.y + range.y * (input[1] / 65535.f),
+			                min.z + range.z * (input[2] / 65535.f));
+		}
+
+		// Keeps the fewest keys from which linear interpolation rebuilds every frame within the tolerance (checked by fits(firstFrame, lastFrame))
+		template<typename F>
+		CompressedTrack FitTrack(unsigned int frameCount, std::vector<UInt16>& keyFrames, F fits)
+		{
+			CompressedTrack track;
+			track.firstKey = static_cast<UInt32>(keyFrames.size());
+
+			keyFrames.push_back(0);
+
+			unsigned int firstFrame = 0;
+			while (firstFrame + 1 < frameCount)
+			{
+				unsigned int lastFrame = firstFrame + 1;
+				while (lastFrame + 1 < frameCount && fits(firstFrame, lastFrame + 1))
+					lastFrame++;
+
+				keyFrames.push_back(static_cast<UInt16>(lastFrame));
+				firstFrame = lastFrame;
+			}
+
+			track.keyCount = static_cast<UInt32>(keyFrames.size()) - track.firstKey;
+
+			return track;
+		}
+
+		// Finds the keys surrounding a frame, and the interpolation between them
+		void FindKeys(const CompressedTrack& track, const UInt16* keyFrames, unsigned int frame, UInt32* keyA, UInt32* keyB, float* interpolation)
+		{
+			const UInt16* firstKey = &keyFrames[track.firstKey];
+			const UInt16* lastKey = firstKey + track.keyCount;
+
+			// The first key is always the first frame, and the last key the last frame
+			const UInt16* nextKey = std::upper_bound(firstKey + 1, lastKey, frame);
+			if (nextKey == lastKey)
+			{
+				*keyA = *keyB = track.firstKey + track.keyCount - 1;
+				*interpolation = 0.f;
+				return;
+			}
+
+			*keyB = static_cast<UInt32>(nextKey - keyFrames);
+			*keyA = *keyB - 1;
+			*interpolation = static_cast<float>(frame - nextKey[-1]) / (nextKey[0] - nextKey[-1]);
+		}
+	}
+
 	struct AnimationImpl
 	{
 		std::unordered_map<String, unsigned int> sequenceMap;
 		std::vector<Sequence> sequences;
 		std::vector<SequenceJoint> sequenceJoints; // Uniquement pour les animations squelettiques
+		std::vector<CompressedJoint> compressedJoints; // Only for compressed animations, replacing sequence joints
+		std::vector<UInt16> keyFrames;
+		std::vector<UInt16> keyValues; // Three per key
 		AnimationType type;
+		bool compressed = false;
 		bool loopPointInterpolation = false;
 		unsigned int frameCount;
 		unsigned int jointCount;  // Uniquement pour les animations squelettiques
 	};
 
+	namespace
+	{
+		void DecodeJoint(const AnimationImpl* impl, unsigned int frame, unsigned int jointIndex, SequenceJoint* output)
+		{
+			const UInt16* keyFrames = impl->keyFrames.data();
+			const UInt16* keyValues = impl->keyValues.data();
+
+			const CompressedJoint& joint = impl->compressedJoints[jointIndex];
+
+			UInt32 keyA;
+			UInt32 keyB;
+			float interpolation;
+
+			FindKeys(joint.position, keyFrames, frame, &keyA, &keyB, &interpolation);
+			output->position = Vector3f::Lerp(DequantizeVector(&keyValues[keyA * 3], joint.positionMin, joint.positionRange),
+			                                  DequantizeVector(&keyValues[keyB * 3], joint.positionMin, joint.positionRange), interpolation);
+
+			FindKeys(joint.rotation, keyFrames, frame, &keyA, &keyB, &interpolation);
+			output->rotation = InterpolateRotation(DequantizeRotation(&keyValues[keyA * 3]), DequantizeRotation(&keyValues[keyB * 3]), interpolation);
+
+			FindKeys(joint.scale, keyFrames, frame, &keyA, &keyB, &interpolation);
+			output->scale = Vector3f::Lerp(DequantizeVector(&keyValues[keyA * 3], joint.scaleMin, joint.scaleRange),
+			                               DequantizeVector(&keyValues[keyB * 3], joint.scaleMin, joint.scaleRange), interpolation);
+		}
+
+		void DecodePose(const AnimationImpl* impl, unsigned int frame, SequenceJoint* output)
+		{
+			for (unsigned int i = 0; i < impl->jointCount; ++i)
+				DecodeJoint(impl, frame, i, &output[i]);
+		}
+	}
+
 	bool AnimationParams::IsValid() const
 	{
 		if (startFrame > endFrame)
@@ -62,6 +256,12 @@ namespace Nz
 			unsigned int endFrame = sequence.firstFrame + sequence.frameCount - 1;
 			if (endFrame >= m_impl->frameCount)
 			{
+				if (m_impl->compressed)
+				{
+					NazaraError("Compressed animations can't be extended");
+					return false;
+				}
+
 				m_impl->frameCount = endFrame+1;
 				m_impl->sequenceJoints.resize(m_impl->frameCount*m_impl->jointCount);
 			}
@@ -145,19 +345,257 @@ namespace Nz
 		}
 		#endif
 
+		// The whole pose is interpolated at once before being applied to the joints
+		t_interpolatedPose.resize(m_impl->jointCount);
+
+		if (m_impl->compressed)
+		{
+			// Both frames are decoded before being interpolated like uncompressed ones
+			t_decodedPoses.resize(m_impl->jointCount * 2);
+
+			SequenceJoint* poseA = &t_decodedPoses[0];
+			SequenceJoint* poseB = &t_decodedPoses[m_impl->jointCount];
+			DecodePose(m_impl, frameA, poseA);
+			DecodePose(m_impl, frameB, poseB);
+
+			InterpolateSequenceJoints(poseA, poseB, interpolation, t_interpolatedPose.data(), m_impl->jointCount);
+		}
+		else
+			InterpolateSequenceJoints(&m_impl->sequenceJoints[frameA*m_impl->jointCount], &m_impl->sequenceJoints[frameB*m_impl->jointCount], interpolation, t_interpolatedPose.data(), m_impl->jointCount);
+
+		Joint* joints = targetSkeleton->GetJoints();
 		for (unsigned int i = 0; i < m_impl->jointCount; ++i)
 		{
-			Joint* joint = targetSkeleton->GetJoint(i);
+			const SequenceJoint& sequenceJoint = t_interpolatedPose[i];
+			joints[i].SetTransform(sequenceJoint.position, sequenceJoint.rotation, sequenceJoint.scale);
+		}
+	}
+
+	/*!
+	* \brief Animates a subset of the joints of a skeleton
+	*
+	* \param targetSkeleton Skeleton to animate
+	* \param frameA First frame of the interpolation
+	* \param frameB Second frame of the interpolation
+	* \param interpolation Interpolation factor between the two frames, in range [0..1]
+	* \param indices Indices of the joints to animate
+	* \param indiceCount Number of joint indices
+	*
+	* \remark Only the listed joints are decoded and interpolated, other joints keep their current local transform
+	* \remark Produces a NazaraError with NAZARA_UTILITY_SAFE defined if the skeleton is not matching the animation or if a frame or joint index is out of range
+	*/
+
+	void Animation::AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation, const unsigned int* indices, unsigned int indiceCount) const
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Animation not created");
+			return;
+		}
+
+		if (m_impl->type != AnimationType_Skeletal)
+		{
+			NazaraError("Animation is not skeletal");
+			return;
+		}
+
+		if (!targetSkeleton || !targetSkeleton->IsValid())
+		{
+			NazaraError("Target skeleton is invalid");
+			return;
+		}
+
+		if (targetSkeleton->GetJointCount() != m_impl->jointCount)
+		{
+			NazaraError("Target skeleton joint count must match animation joint count");
+			return;
+		}
+
+		if (frameA >= m_impl->frameCount)
+		{
+			NazaraError("Frame A is out of range (" + String::Number(frameA) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
 
-			SequenceJoint& sequenceJointA = m_impl->sequenceJoints[frameA*m_impl->jointCount + i];
-			SequenceJoint& sequenceJointB = m_impl->sequenceJoints[frameB*m_impl->jointCount + i];
+		if (frameB >= m_impl->frameCount)
+		{
+			NazaraError("Frame B is out of range (" + String::Number(frameB) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
+		#endif
 
-			joint->SetPosition(Vector3f::Lerp(sequenceJointA.position, sequenceJointB.position, interpolation));
-			joint->SetRotation(Quaternionf::Slerp(sequenceJointA.rotation, sequenceJointB.rotation, interpolation));
-			joint->SetScale(Vector3f::Lerp(sequenceJointA.scale, sequenceJointB.scale, interpolation));
+		Joint* joints = targetSkeleton->GetJoints();
+		for (unsigned int i = 0; i < indiceCount; ++i)
+		{
+			unsigned int index = indices[i];
+
+			#if NAZARA_UTILITY_SAFE
+			if (index >= m_impl->jointCount)
+			{
+				NazaraError("Index #" + String::Number(i) + " out of range (" + String::Number(index) + " >= " + String::Number(m_impl->jointCount) + ')');
+				return;
+			}
+			#endif
+
+			SequenceJoint sequenceJoint;
+			if (m_impl->compressed)
+			{
+				SequenceJoint jointA;
+				SequenceJoint jointB;
+				DecodeJoint(m_impl, frameA, index, &jointA);
+				DecodeJoint(m_impl, frameB, index, &jointB);
+
+				InterpolateSequenceJoints(&jointA, &jointB, interpolation, &sequenceJoint, 1);
+			}
+			else
+				InterpolateSequenceJoints(&m_impl->sequenceJoints[frameA*m_impl->jointCount + index], &m_impl->sequenceJoints[frameB*m_impl->jointCount + index], interpolation, &sequenceJoint, 1);
+
+			joints[index].SetTransform(sequenceJoint.position, sequenceJoint.rotation, sequenceJoint.scale);
 		}
 	}
 
+	/*!
+	* \brief Compresses the joints of a skeletal animation
+	* \return true If successful
+	*
+	* \param positionTolerance Maximum error allowed on joint positions and scales
+	* \param rotationTolerance Maximum error allowed on joint rotations, in radians
+	*
+	* \remark Only the keys needed to rebuild the frames by linear interpolation are kept, rotations are quantized to 48 bits (smallest three) and vectors to 16 bits per component
+	* \remark Frames are decoded on demand by AnimateSkeleton, sequence joints can't be accessed anymore
+	* \remark Produces a NazaraError with NAZARA_UTILITY_SAFE defined if the animation is not skeletal
+	*/
+
+	bool Animation::Compress(float positionTolerance, float rotationTolerance)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Animation not created");
+			return false;
+		}
+
+		if (m_impl->type != AnimationType_Skeletal)
+		{
+			NazaraError("Animation is not skeletal");
+			return false;
+		}
+		#endif
+
+		if (m_impl->compressed)
+			return true;
+
+		if (m_impl->frameCount > std::numeric_limits<UInt16>::max() + 1U)
+		{
+			NazaraError("Too many frames to compress the animation (" + String::Number(m_impl->frameCount) + " > " + String::Number(std::numeric_limits<UInt16>::max() + 1U) + ')');
+			return false;
+		}
+
+		unsigned int frameCount = m_impl->frameCount;
+		unsigned int jointCount = m_impl->jointCount;
+
+		float squaredPositionTolerance = positionTolerance * positionTolerance;
+		float rotationCosTolerance = std::cos(rotationTolerance * 0.5f); // |q1.q2| = cos(angle/2)
+
+		std::vector<CompressedJoint> compressedJoints(jointCount);
+		std::vector<UInt16> keyFrames;
+		std::vector<UInt16> keyValues;
+
+		// Quantized values of every frame of the current track, the fitting is done against them to take the quantization error into account
+		std::vector<UInt16> quantizedValues(frameCount * 3);
+
+		auto SequenceJointAt = [&](unsigned int frame, unsigned int joint) -> const SequenceJoint&
+		{
+			return m_impl->sequenceJoints[frame * jointCount + joint];
+		};
+
+		auto AddKeyValues = [&](const CompressedTrack& track)
+		{
+			for (UInt32 i = 0; i < track.keyCount; ++i)
+			{
+				const UInt16* values = &quantizedValues[keyFrames[track.firstKey + i] * 3];
+				keyValues.insert(keyValues.end(), values, values + 3);
+			}
+		};
+
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			CompressedJoint& joint = compressedJoints[i];
+
+			// Positions and scales
+			auto CompressVectors = [&](Vector3f SequenceJoint::* member, Vector3f* min, Vector3f* range) -> CompressedTrack
+			{
+				Boxf bounds(SequenceJointAt(0, i).*member, SequenceJointAt(0, i).*member);
+				for (unsigned int frame = 1; frame < frameCount; ++frame)
+					bounds.ExtendTo(SequenceJointAt(frame, i).*member);
+
+				*min = bounds.GetPosition();
+				*range = bounds.GetLengths();
+
+				for (unsigned int frame = 0; frame < frameCount; ++frame)
+					QuantizeVector(SequenceJointAt(frame, i).*member, *min, *range, &quantizedValues[frame * 3]);
+
+				CompressedTrack track = FitTrack(frameCount, keyFrames, [&](unsigned int firstFrame, unsigned int lastFrame)
+				{
+					Vector3f first = DequantizeVector(&quantizedValues[firstFrame * 3], *min, *range);
+					Vector3f last = DequantizeVector(&quantizedValues[lastFrame * 3], *min, *range);
+
+					for (unsigned int frame = firstFrame + 1; frame < lastFrame; ++frame)
+					{
+						Vector3f value = Vector3f::Lerp(first, last, static_cast<float>(frame - firstFrame) / (lastFrame - firstFrame));
+						if (value.SquaredDistance(SequenceJointAt(frame, i).*member) > squaredPositionTolerance)
+							return false;
+					}
+
+					return true;
+				});
+
+				AddKeyValues(track);
+
+				return track;
+			};
+
+			joint.position = CompressVectors(&SequenceJoint::position, &joint.positionMin, &joint.positionRange);
+			joint.scale = CompressVectors(&SequenceJoint::scale, &joint.scaleMin, &joint.scaleRange);
+
+			// Rotations
+			for (unsigned int frame = 0; frame < frameCount; ++frame)
+				QuantizeRotation(Quaternionf::Normalize(SequenceJointAt(frame, i).rotation), &quantizedValues[frame * 3]);
+
+			joint.rotation = FitTrack(frameCount, keyFrames, [&](unsigned int firstFrame, unsigned int lastFrame)
+			{
+				Quaternionf first = DequantizeRotation(&quantizedValues[firstFrame * 3]);
+				Quaternionf last = DequantizeRotation(&quantizedValues[lastFrame * 3]);
+
+				for (unsigned int frame = firstFrame + 1; frame < lastFrame; ++frame)
+				{
+					Quaternionf value = InterpolateRotation(first, last, static_cast<float>(frame - firstFrame) / (lastFrame - firstFrame));
+					if (std::abs(value.DotProduct(Quaternionf::Normalize(SequenceJointAt(frame, i).rotation))) < rotationCosTolerance)
+						return false;
+				}
+
+				return true;
+			});
+
+			AddKeyValues(joint.rotation);
+		}
+
+		m_impl->compressedJoints = std::move(compressedJoints);
+		m_impl->keyFrames = std::move(keyFrames);
+		m_impl->keyValues = std::move(keyValues);
+		m_impl->compressed = true;
+
+		m_impl->keyFrames.shrink_to_fit();
+		m_impl->keyValues.shrink_to_fit();
+
+		// Raw frames are not needed anymore
+		m_impl->sequenceJoints.clear();
+		m_impl->sequenceJoints.shrink_to_fit();
+
+		return true;
+	}
+
 	bool Animation::CreateSkeletal(unsigned int frameCount, unsigned int jointCount)
 	{
 		Destroy();
@@ -235,6 +673,15 @@ namespace Nz
 		return m_impl->jointCount;
 	}
 
+	std::size_t Animation::GetMemoryUsage() const
+	{
+		if (!m_impl)
+			return 0;
+
+		return m_impl->sequences.size() * sizeof(Sequence) + m_impl->sequenceJoints.size() * sizeof(SequenceJoint) +
+		       m_impl->compressedJoints.size() * sizeof(CompressedJoint) + (m_impl->keyFrames.size() + m_impl->keyValues.size()) * sizeof(UInt16);
+	}
+
 	Sequence* Animation::GetSequence(const String& sequenceName)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -371,6 +818,12 @@ namespace Nz
 		}
 		#endif
 
+		if (m_impl->compressed)
+		{
+			NazaraError("Animation is compressed");
+			return nullptr;
+		}
+
 		return &m_impl->sequenceJoints[frameIndex*m_impl->jointCount];
 	}
 
@@ -390,6 +843,12 @@ namespace Nz
 		}
 		#endif
 
+		if (m_impl->compressed)
+		{
+			NazaraError("Animation is compressed");
+			return nullptr;
+		}
+
 		return &m_impl->sequenceJoints[frameIndex*m_impl->jointCount];
 	}
 
@@ -432,6 +891,19 @@ namespace Nz
 		return index >= m_impl->sequences.size();
 	}
 
+	bool Animation::IsCompressed() const
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Animation not created");
+			return false;
+		}
+		#endif
+
+		return m_impl->compressed;
+	}
+
 	bool Animation::IsLoopPointInterpolationEnabled() const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -539,6 +1011,8 @@ namespace Nz
 
 	AnimationLibrary::LibraryMap Animation::s_library;
 	AnimationLoader::LoaderList Animation::s_loaders;
+	AnimationManager::ManagerCache Animation::s_managerCache;
+	AnimationManager::ManagerLoads Animation::s_managerLoads;
 	AnimationManager::ManagerMap Animation::s_managerMap;
 	AnimationManager::ManagerParams Animation::s_managerParameters;
 }
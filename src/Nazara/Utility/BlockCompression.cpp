@@ -0,0 +1,912 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/BlockCompression.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_BLOCKCOMPRESSION_X86
+	#include <emmintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_SSE2_FUNCTION
+	#else
+		#define NAZARA_SSE2_FUNCTION __attribute__((target("sse2")))
+	#endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define NAZARA_BLOCKCOMPRESSION_NEON
+	#include <arm_neon.h>
+#endif
+
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		/********************************Indices**********************************/
+		// Picking the nearest palette color of every texel is where most of the encoding time goes, it is dispatched at runtime
+		// to SIMD implementations: texels and palette colors are RGBA8 (channels to ignore are zeroed on both sides)
+		// and the error is the sum of the squared differences
+
+		UInt32 SelectIndicesGeneric(const UInt8* texels, const UInt8* palette, unsigned int paletteSize, UInt8* indices)
+		{
+			UInt32 totalError = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				UInt32 bestError = std::numeric_limits<UInt32>::max();
+				UInt8 bestIndex = 0;
+				for (unsigned int j = 0; j < paletteSize; ++j)
+				{
+					UInt32 error = 0;
+					for (unsigned int c = 0; c < 4; ++c)
+					{
+						int diff = int(texels[i*4 + c]) - int(palette[j*4 + c]);
+						error += diff*diff;
+					}
+
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = static_cast<UInt8>(j);
+					}
+				}
+
+				indices[i] = bestIndex;
+				totalError += bestError;
+			}
+
+			return totalError;
+		}
+
+		#ifdef NAZARA_BLOCKCOMPRESSION_X86
+		NAZARA_SSE2_FUNCTION UInt32 SelectIndicesSSE2(const UInt8* texels, const UInt8* palette, unsigned int paletteSize, UInt8* indices)
+		{
+			__m128i zero = _mm_setzero_si128();
+
+			// Two texels per register, as 16 bits channels
+			__m128i wideTexels[8];
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				__m128i fourTexels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&texels[i*16]));
+				wideTexels[i*2] = _mm_unpacklo_epi8(fourTexels, zero);
+				wideTexels[i*2 + 1] = _mm_unpackhi_epi8(fourTexels, zero);
+			}
+
+			// Four texels per register
+			__m128i bestErrors[4];
+			__m128i bestIndices[4];
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				bestErrors[i] = _mm_set1_epi32(std::numeric_limits<int>::max());
+				bestIndices[i] = zero;
+			}
+
+			for (unsigned int j = 0; j < paletteSize; ++j)
+			{
+				int color;
+				std::memcpy(&color, &palette[j*4], sizeof(int));
+
+				__m128i wideColor = _mm_unpacklo_epi8(_mm_set1_epi32(color), zero);
+				__m128i index = _mm_set1_epi32(j);
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					__m128i diff0 = _mm_sub_epi16(wideTexels[i*2], wideColor);
+					__m128i diff1 = _mm_sub_epi16(wideTexels[i*2 + 1], wideColor);
+
+					// (r² + g², b² + a²) of every texel, summed by pairs
+					__m128 squares0 = _mm_castsi128_ps(_mm_madd_epi16(diff0, diff0));
+					__m128 squares1 = _mm_castsi128_ps(_mm_madd_epi16(diff1, diff1));
+					__m128i errors = _mm_add_epi32(_mm_castps_si128(_mm_shuffle_ps(squares0, squares1, _MM_SHUFFLE(2, 0, 2, 0))),
+					                               _mm_castps_si128(_mm_shuffle_ps(squares0, squares1, _MM_SHUFFLE(3, 1, 3, 1))));
+
+					__m128i better = _mm_cmplt_epi32(errors, bestErrors[i]);
+					bestErrors[i] = _mm_or_si128(_mm_and_si128(better, errors), _mm_andnot_si128(better, bestErrors[i]));
+					bestIndices[i] = _mm_or_si128(_mm_and_si128(better, index), _mm_andnot_si128(better, bestIndices[i]));
+				}
+			}
+
+			alignas(16) UInt32 errors[16];
+			alignas(16) UInt32 selectedIndices[16];
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				_mm_store_si128(reinterpret_cast<__m128i*>(&errors[i*4]), bestErrors[i]);
+				_mm_store_si128(reinterpret_cast<__m128i*>(&selectedIndices[i*4]), bestIndices[i]);
+			}
+
+			UInt32 totalError = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				indices[i] = static_cast<UInt8>(selectedIndices[i]);
+				totalError += errors[i];
+			}
+
+			return totalError;
+		}
+		#endif
+
+		#ifdef NAZARA_BLOCKCOMPRESSION_NEON
+		UInt32 SelectIndicesNEON(const UInt8* texels, const UInt8* palette, unsigned int paletteSize, UInt8* indices)
+		{
+			uint8x16_t fourTexels[4];
+			uint32x4_t bestErrors[4];
+			uint32x4_t bestIndices[4];
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				fourTexels[i] = vld1q_u8(&texels[i*16]);
+				bestErrors[i] = vdupq_n_u32(std::numeric_limits<UInt32>::max());
+				bestIndices[i] = vdupq_n_u32(0);
+			}
+
+			for (unsigned int j = 0; j < paletteSize; ++j)
+			{
+				UInt32 color;
+				std::memcpy(&color, &palette[j*4], sizeof(UInt32));
+
+				uint8x16_t colors = vreinterpretq_u8_u32(vdupq_n_u32(color));
+				uint32x4_t index = vdupq_n_u32(j);
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					uint8x16_t diff = vabdq_u8(fourTexels[i], colors);
+					uint16x8_t squares0 = vmull_u8(vget_low_u8(diff), vget_low_u8(diff));
+					uint16x8_t squares1 = vmull_u8(vget_high_u8(diff), vget_high_u8(diff));
+					uint32x4_t errors = vpaddq_u32(vpaddlq_u16(squares0), vpaddlq_u16(squares1));
+
+					uint32x4_t better = vcltq_u32(errors, bestErrors[i]);
+					bestErrors[i] = vbslq_u32(better, errors, bestErrors[i]);
+					bestIndices[i] = vbslq_u32(better, index, bestIndices[i]);
+				}
+			}
+
+			UInt32 errors[16];
+			UInt32 selectedIndices[16];
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				vst1q_u32(&errors[i*4], bestErrors[i]);
+				vst1q_u32(&selectedIndices[i*4], bestIndices[i]);
+			}
+
+			UInt32 totalError = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				indices[i] = static_cast<UInt8>(selectedIndices[i]);
+				totalError += errors[i];
+			}
+
+			return totalError;
+		}
+		#endif
+
+		CpuKernel<UInt32(const UInt8*, const UInt8*, unsigned int, UInt8*)> s_selectIndicesKernel("Block compression index selection", &SelectIndicesGeneric, {
+			#ifdef NAZARA_BLOCKCOMPRESSION_X86
+			{&SelectIndicesSSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_BLOCKCOMPRESSION_NEON
+			{&SelectIndicesNEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		/*******************************Endpoints*********************************/
+
+		inline UInt8 ClampToByte(int value)
+		{
+			return static_cast<UInt8>(std::min(std::max(value, 0), 255));
+		}
+
+		// Gets the line the texels are the closest to (from the principal axis of their covariance matrix, found by power
+		// iterations), and the extent of their projection on it
+		void ComputeEndpoints(const UInt8* texels, unsigned int channelCount, float* endpoint0, float* endpoint1)
+		{
+			float mean[4] = {0.f, 0.f, 0.f, 0.f};
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				for (unsigned int c = 0; c < channelCount; ++c)
+					mean[c] += texels[i*4 + c];
+			}
+
+			for (unsigned int c = 0; c < channelCount; ++c)
+				mean[c] /= 16.f;
+
+			float covariance[4][4] = {};
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				for (unsigned int a = 0; a < channelCount; ++a)
+				{
+					float diffA = texels[i*4 + a] - mean[a];
+					for (unsigned int b = a; b < channelCount; ++b)
+						covariance[a][b] += diffA * (texels[i*4 + b] - mean[b]);
+				}
+			}
+
+			for (unsigned int a = 0; a < channelCount; ++a)
+			{
+				for (unsigned int b = 0; b < a; ++b)
+					covariance[a][b] = covariance[b][a];
+			}
+
+			// The row of the channel varying the most is a good start
+			unsigned int maxChannel = 0;
+			for (unsigned int c = 1; c < channelCount; ++c)
+			{
+				if (covariance[c][c] > covariance[maxChannel][maxChannel])
+					maxChannel = c;
+			}
+
+			float axis[4] = {0.f, 0.f, 0.f, 0.f};
+			for (unsigned int c = 0; c < channelCount; ++c)
+				axis[c] = covariance[maxChannel][c];
+
+			for (unsigned int iteration = 0; iteration < 8; ++iteration)
+			{
+				float newAxis[4] = {0.f, 0.f, 0.f, 0.f};
+				float length = 0.f;
+				for (unsigned int a = 0; a < channelCount; ++a)
+				{
+					for (unsigned int b = 0; b < channelCount; ++b)
+						newAxis[a] += covariance[a][b] * axis[b];
+
+					length += newAxis[a] * newAxis[a];
+				}
+
+				if (length < 1e-12f)
+					break;
+
+				length = 1.f / std::sqrt(length);
+				for (unsigned int c = 0; c < channelCount; ++c)
+					axis[c] = newAxis[c] * length;
+			}
+
+			float minProjection = std::numeric_limits<float>::max();
+			float maxProjection = std::numeric_limits<float>::lowest();
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				float projection = 0.f;
+				for (unsigned int c = 0; c < channelCount; ++c)
+					projection += (texels[i*4 + c] - mean[c]) * axis[c];
+
+				minProjection = std::min(minProjection, projection);
+				maxProjection = std::max(maxProjection, projection);
+			}
+
+			for (unsigned int c = 0; c < channelCount; ++c)
+			{
+				endpoint0[c] = std::min(std::max(mean[c] + axis[c] * maxProjection, 0.f), 255.f);
+				endpoint1[c] = std::min(std::max(mean[c] + axis[c] * minProjection, 0.f), 255.f);
+			}
+		}
+
+		// Least squares fit of the endpoints, from the weights (of the second endpoint) of the selected palette colors
+		bool RefineEndpoints(const UInt8* texels, const UInt8* indices, const float* weights, unsigned int channelCount, float* endpoint0, float* endpoint1)
+		{
+			float alpha2 = 0.f;
+			float beta2 = 0.f;
+			float alphaBeta = 0.f;
+			float alphaTexel[4] = {0.f, 0.f, 0.f, 0.f};
+			float betaTexel[4] = {0.f, 0.f, 0.f, 0.f};
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				float beta = weights[indices[i]];
+				float alpha = 1.f - beta;
+
+				alpha2 += alpha * alpha;
+				beta2 += beta * beta;
+				alphaBeta += alpha * beta;
+				for (unsigned int c = 0; c < channelCount; ++c)
+				{
+					alphaTexel[c] += alpha * texels[i*4 + c];
+					betaTexel[c] += beta * texels[i*4 + c];
+				}
+			}
+
+			float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+			if (std::abs(determinant) < 1e-6f)
+				return false;
+
+			float invDeterminant = 1.f / determinant;
+			for (unsigned int c = 0; c < channelCount; ++c)
+			{
+				endpoint0[c] = std::min(std::max((alphaTexel[c] * beta2 - betaTexel[c] * alphaBeta) * invDeterminant, 0.f), 255.f);
+				endpoint1[c] = std::min(std::max((betaTexel[c] * alpha2 - alphaTexel[c] * alphaBeta) * invDeterminant, 0.f), 255.f);
+			}
+
+			return true;
+		}
+
+		/*********************************Color**********************************/
+		// The color block of DXT formats: two RGB565 endpoints and 2 bits indices, in the four colors mode
+		// (which DXT3 and DXT5 always use, and DXT1 when the first endpoint is greater than the second one)
+
+		const float s_colorWeights[4] = {0.f, 1.f, 1.f/3.f, 2.f/3.f};
+
+		UInt16 QuantizeRGB565(const float* color)
+		{
+			UInt16 r = static_cast<UInt16>(color[0] * 31.f/255.f + 0.5f);
+			UInt16 g = static_cast<UInt16>(color[1] * 63.f/255.f + 0.5f);
+			UInt16 b = static_cast<UInt16>(color[2] * 31.f/255.f + 0.5f);
+
+			return (r << 11) | (g << 5) | b;
+		}
+
+		void ExpandRGB565(UInt16 color, UInt8* expanded)
+		{
+			UInt8 r = (color >> 11) & 0x1F;
+			UInt8 g = (color >> 5) & 0x3F;
+			UInt8 b = color & 0x1F;
+
+			expanded[0] = (r << 3) | (r >> 2);
+			expanded[1] = (g << 2) | (g >> 4);
+			expanded[2] = (b << 3) | (b >> 2);
+			expanded[3] = 0;
+		}
+
+		UInt32 EncodeColorEndpoints(const UInt8* texels, UInt16 color0, UInt16 color1, UInt8* block, UInt8* indices)
+		{
+			if (color0 < color1)
+				std::swap(color0, color1);
+
+			UInt8 palette[4*4];
+			ExpandRGB565(color0, &palette[0]);
+			ExpandRGB565(color1, &palette[4]);
+			for (unsigned int c = 0; c < 4; ++c)
+			{
+				palette[8 + c] = static_cast<UInt8>((2*palette[c] + palette[4 + c]) / 3);
+				palette[12 + c] = static_cast<UInt8>((palette[c] + 2*palette[4 + c]) / 3);
+			}
+
+			// Equal endpoints would mean the three colors mode for DXT1, where the last index is black
+			UInt32 error = s_selectIndicesKernel(texels, palette, (color0 == color1) ? 1 : 4, indices);
+
+			UInt32 indexBits = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+				indexBits |= UInt32(indices[i]) << (i*2);
+
+			block[0] = static_cast<UInt8>(color0);
+			block[1] = static_cast<UInt8>(color0 >> 8);
+			block[2] = static_cast<UInt8>(color1);
+			block[3] = static_cast<UInt8>(color1 >> 8);
+			for (unsigned int i = 0; i < 4; ++i)
+				block[4 + i] = static_cast<UInt8>(indexBits >> (i*8));
+
+			return error;
+		}
+
+		void CompressColorBlock(const UInt8* texels, UInt8* block)
+		{
+			UInt8 colorTexels[16*4];
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				std::memcpy(&colorTexels[i*4], &texels[i*4], 3);
+				colorTexels[i*4 + 3] = 0;
+			}
+
+			float endpoint0[3];
+			float endpoint1[3];
+			ComputeEndpoints(colorTexels, 3, endpoint0, endpoint1);
+
+			UInt8 indices[16];
+			UInt32 error = EncodeColorEndpoints(colorTexels, QuantizeRGB565(endpoint0), QuantizeRGB565(endpoint1), block, indices);
+			if (error == 0)
+				return;
+
+			UInt16 color0 = static_cast<UInt16>(block[0] | (block[1] << 8));
+			UInt16 color1 = static_cast<UInt16>(block[2] | (block[3] << 8));
+			if (color0 != color1 && RefineEndpoints(colorTexels, indices, s_colorWeights, 3, endpoint0, endpoint1))
+			{
+				UInt8 refinedBlock[8];
+				UInt8 refinedIndices[16];
+				if (EncodeColorEndpoints(colorTexels, QuantizeRGB565(endpoint0), QuantizeRGB565(endpoint1), refinedBlock, refinedIndices) < error)
+					std::memcpy(block, refinedBlock, 8);
+			}
+		}
+
+		/********************************Channel*********************************/
+		// A block of a single channel (DXT5 alpha, and both channels of BC5): two 8 bits endpoints and 3 bits indices,
+		// either with eight interpolated values or six and the exact 0 and 255 values
+
+		UInt32 SelectChannelIndices(const UInt8* values, const UInt8* palette, UInt8* indices)
+		{
+			UInt32 totalError = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				UInt32 bestError = std::numeric_limits<UInt32>::max();
+				for (unsigned int j = 0; j < 8; ++j)
+				{
+					int diff = int(values[i]) - int(palette[j]);
+					UInt32 error = diff*diff;
+					if (error < bestError)
+					{
+						bestError = error;
+						indices[i] = static_cast<UInt8>(j);
+					}
+				}
+
+				totalError += bestError;
+			}
+
+			return totalError;
+		}
+
+		void CompressChannelBlock(const UInt8* texels, unsigned int channel, UInt8* block)
+		{
+			UInt8 values[16];
+			UInt8 minValue = 255;
+			UInt8 maxValue = 0;
+			UInt8 innerMin = 255;
+			UInt8 innerMax = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				UInt8 value = texels[i*4 + channel];
+				values[i] = value;
+
+				minValue = std::min(minValue, value);
+				maxValue = std::max(maxValue, value);
+				if (value != 0 && value != 255)
+				{
+					innerMin = std::min(innerMin, value);
+					innerMax = std::max(innerMax, value);
+				}
+			}
+
+			UInt8 endpoint0 = maxValue;
+			UInt8 endpoint1 = minValue;
+			UInt8 indices[16] = {};
+			if (minValue != maxValue)
+			{
+				UInt8 palette[8] = {maxValue, minValue};
+				for (unsigned int i = 2; i < 8; ++i)
+					palette[i] = static_cast<UInt8>(((8 - i)*maxValue + (i - 1)*minValue + 3) / 7);
+
+				UInt32 error = SelectChannelIndices(values, palette, indices);
+
+				// The six values mode is worth it when there are exact extremes
+				if (error > 0 && (minValue == 0 || maxValue == 255))
+				{
+					if (innerMin > innerMax)
+						innerMin = innerMax = 0;
+
+					UInt8 extremesPalette[8] = {innerMin, innerMax, 0, 0, 0, 0, 0, 255};
+					for (unsigned int i = 2; i < 6; ++i)
+						extremesPalette[i] = static_cast<UInt8>(((6 - i)*innerMin + (i - 1)*innerMax + 2) / 5);
+
+					UInt8 extremesIndices[16];
+					if (SelectChannelIndices(values, extremesPalette, extremesIndices) < error)
+					{
+						endpoint0 = innerMin;
+						endpoint1 = innerMax;
+						std::memcpy(indices, extremesIndices, 16);
+					}
+				}
+			}
+
+			UInt64 indexBits = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+				indexBits |= UInt64(indices[i]) << (i*3);
+
+			block[0] = endpoint0;
+			block[1] = endpoint1;
+			for (unsigned int i = 0; i < 6; ++i)
+				block[2 + i] = static_cast<UInt8>(indexBits >> (i*8));
+		}
+
+		/**********************************BC7***********************************/
+		// Only mode 6 is used: a single subset with RGBA endpoints of 7 bits and a shared lowest bit per endpoint (its p-bit),
+		// and 4 bits indices, which is the best compromise for most blocks
+
+		const UInt8 s_bc7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		const float s_bc7FloatWeights[16] = {
+			0.f/64.f,  4.f/64.f,  9.f/64.f,  13.f/64.f, 17.f/64.f, 21.f/64.f, 26.f/64.f, 30.f/64.f,
+			34.f/64.f, 38.f/64.f, 43.f/64.f, 47.f/64.f, 51.f/64.f, 55.f/64.f, 60.f/64.f, 64.f/64.f
+		};
+
+		void QuantizeBC7Endpoint(const float* endpoint, UInt8* quantized)
+		{
+			UInt32 bestError = std::numeric_limits<UInt32>::max();
+			for (UInt8 pBit = 0; pBit < 2; ++pBit)
+			{
+				UInt8 candidate[4];
+				UInt32 error = 0;
+				for (unsigned int c = 0; c < 4; ++c)
+				{
+					int value = std::min(std::max(static_cast<int>((endpoint[c] - pBit) / 2.f + 0.5f), 0), 127);
+					candidate[c] = static_cast<UInt8>((value << 1) | pBit);
+
+					int diff = static_cast<int>(endpoint[c] + 0.5f) - candidate[c];
+					error += diff*diff;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					std::memcpy(quantized, candidate, 4);
+				}
+			}
+		}
+
+		class BitWriter
+		{
+			public:
+				BitWriter(UInt8* data) :
+				m_data(data),
+				m_position(0)
+				{
+				}
+
+				void Write(UInt32 value, unsigned int bitCount)
+				{
+					for (unsigned int i = 0; i < bitCount; ++i, ++m_position)
+						m_data[m_position / 8] |= ((value >> i) & 1) << (m_position % 8);
+				}
+
+			private:
+				UInt8* m_data;
+				unsigned int m_position;
+		};
+
+		// Endpoints are full 8 bits values, whose lowest bit is the p-bit
+		UInt32 EncodeBC7Endpoints(const UInt8* texels, const UInt8* endpoint0, const UInt8* endpoint1, UInt8* block, UInt8* indices)
+		{
+			UInt8 palette[16*4];
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				for (unsigned int c = 0; c < 4; ++c)
+					palette[i*4 + c] = static_cast<UInt8>(((64 - s_bc7Weights[i])*endpoint0[c] + s_bc7Weights[i]*endpoint1[c] + 32) >> 6);
+			}
+
+			UInt32 error = s_selectIndicesKernel(texels, palette, 16, indices);
+
+			// The highest bit of the first index is implicitly zero
+			if (indices[0] & 0x8)
+			{
+				std::swap(endpoint0, endpoint1);
+				for (unsigned int i = 0; i < 16; ++i)
+					indices[i] = 15 - indices[i];
+			}
+
+			std::memset(block, 0, 16);
+
+			BitWriter writer(block);
+			writer.Write(1 << 6, 7);
+			for (unsigned int c = 0; c < 4; ++c)
+			{
+				writer.Write(endpoint0[c] >> 1, 7);
+				writer.Write(endpoint1[c] >> 1, 7);
+			}
+
+			writer.Write(endpoint0[0] & 1, 1);
+			writer.Write(endpoint1[0] & 1, 1);
+
+			writer.Write(indices[0], 3);
+			for (unsigned int i = 1; i < 16; ++i)
+				writer.Write(indices[i], 4);
+
+			return error;
+		}
+
+		/**********************************ETC2**********************************/
+		// The color part only uses the individual and differential modes (those of ETC1): two subblocks of 2x4 or 4x2 texels,
+		// each with a base color and a table of intensity modifiers. The alpha part is an EAC block: a base value,
+		// a multiplier and a table of eight modifiers
+
+		const int s_etcModifiers[8][2] = {
+			{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+		};
+
+		const int s_eacModifiers[16][8] = {
+			{-3, -6,  -9, -15, 2, 5, 8, 14},
+			{-3, -7, -10, -13, 2, 6, 9, 12},
+			{-2, -5,  -8, -13, 1, 4, 7, 12},
+			{-2, -4,  -6, -13, 1, 3, 5, 12},
+			{-3, -6,  -8, -12, 2, 5, 7, 11},
+			{-3, -7,  -9, -11, 2, 6, 8, 10},
+			{-4, -7,  -8, -11, 3, 6, 7, 10},
+			{-3, -5,  -8, -11, 2, 4, 7, 10},
+			{-2, -6,  -8, -10, 1, 5, 7,  9},
+			{-2, -5,  -8, -10, 1, 4, 7,  9},
+			{-2, -4,  -8, -10, 1, 3, 7,  9},
+			{-2, -5,  -7, -10, 1, 4, 6,  9},
+			{-3, -4,  -7, -10, 2, 3, 6,  9},
+			{-1, -2,  -3, -10, 0, 1, 2,  9},
+			{-4, -6,  -8,  -9, 3, 5, 7,  8},
+			{-3, -5,  -7,  -9, 2, 4, 6,  8}
+		};
+
+		struct EtcSubblock
+		{
+			UInt8 texelIndices[8]; // Positions (y*4 + x) of the texels
+			UInt8 modifierIndices[8];
+			UInt8 table;
+		};
+
+		// Finds the best modifier table (and modifier of every texel) around a base color, the texels are given twice
+		UInt32 FitEtcSubblock(const UInt8* subblockTexels, const UInt8* baseColor, EtcSubblock* subblock)
+		{
+			UInt32 bestError = std::numeric_limits<UInt32>::max();
+			for (unsigned int table = 0; table < 8; ++table)
+			{
+				int modifiers[4] = {s_etcModifiers[table][0], s_etcModifiers[table][1], -s_etcModifiers[table][0], -s_etcModifiers[table][1]};
+
+				UInt8 palette[4*4];
+				for (unsigned int i = 0; i < 4; ++i)
+				{
+					for (unsigned int c = 0; c < 3; ++c)
+						palette[i*4 + c] = ClampToByte(baseColor[c] + modifiers[i]);
+
+					palette[i*4 + 3] = 0;
+				}
+
+				UInt8 indices[16];
+				UInt32 error = s_selectIndicesKernel(subblockTexels, palette, 4, indices);
+				if (error < bestError)
+				{
+					bestError = error;
+					subblock->table = static_cast<UInt8>(table);
+					std::memcpy(subblock->modifierIndices, indices, 8);
+				}
+			}
+
+			return bestError / 2;
+		}
+
+		void CompressEtcColorBlock(const UInt8* texels, UInt8* block)
+		{
+			UInt64 bestBits = 0;
+			UInt32 bestError = std::numeric_limits<UInt32>::max();
+			for (unsigned int flip = 0; flip < 2; ++flip)
+			{
+				EtcSubblock subblocks[2];
+				UInt8 subblockTexels[2][16*4];
+				float averages[2][3] = {};
+				for (unsigned int s = 0; s < 2; ++s)
+				{
+					unsigned int i = 0;
+					for (unsigned int y = 0; y < 4; ++y)
+					{
+						for (unsigned int x = 0; x < 4; ++x)
+						{
+							if (((flip) ? y : x) / 2 != s)
+								continue;
+
+							const UInt8* texel = &texels[(y*4 + x)*4];
+							for (unsigned int copy = 0; copy < 2; ++copy)
+							{
+								std::memcpy(&subblockTexels[s][(i + copy*8)*4], texel, 3);
+								subblockTexels[s][(i + copy*8)*4 + 3] = 0;
+							}
+
+							for (unsigned int c = 0; c < 3; ++c)
+								averages[s][c] += texel[c] / 8.f;
+
+							subblocks[s].texelIndices[i++] = static_cast<UInt8>(y*4 + x);
+						}
+					}
+				}
+
+				for (unsigned int differential = 0; differential < 2; ++differential)
+				{
+					// Base colors, as 4 bits (individual mode) or 5 bits with the second one as a 3 bits delta (differential mode)
+					int quantized[2][3];
+					UInt8 baseColors[2][3];
+					for (unsigned int c = 0; c < 3; ++c)
+					{
+						if (differential)
+						{
+							quantized[0][c] = static_cast<int>(averages[0][c] * 31.f/255.f + 0.5f);
+							quantized[1][c] = quantized[0][c] + std::min(std::max(static_cast<int>(averages[1][c] * 31.f/255.f + 0.5f) - quantized[0][c], -4), 3);
+							quantized[1][c] = std::min(std::max(quantized[1][c], 0), 31);
+
+							for (unsigned int s = 0; s < 2; ++s)
+								baseColors[s][c] = static_cast<UInt8>((quantized[s][c] << 3) | (quantized[s][c] >> 2));
+						}
+						else
+						{
+							for (unsigned int s = 0; s < 2; ++s)
+							{
+								quantized[s][c] = static_cast<int>(averages[s][c] * 15.f/255.f + 0.5f);
+								baseColors[s][c] = static_cast<UInt8>(quantized[s][c] * 17);
+							}
+						}
+					}
+
+					UInt32 error = FitEtcSubblock(subblockTexels[0], baseColors[0], &subblocks[0]) + FitEtcSubblock(subblockTexels[1], baseColors[1], &subblocks[1]);
+					if (error >= bestError)
+						continue;
+
+					UInt64 bits = 0;
+					for (unsigned int c = 0; c < 3; ++c)
+					{
+						unsigned int shift = 56 - c*8;
+						if (differential)
+							bits |= (UInt64(quantized[0][c]) << (shift + 3)) | (UInt64((quantized[1][c] - quantized[0][c]) & 0x7) << shift);
+						else
+							bits |= (UInt64(quantized[0][c]) << (shift + 4)) | (UInt64(quantized[1][c]) << shift);
+					}
+
+					bits |= UInt64(subblocks[0].table) << 37;
+					bits |= UInt64(subblocks[1].table) << 34;
+					bits |= UInt64(differential) << 33;
+					bits |= UInt64(flip) << 32;
+
+					// Texels are ordered by column, with the most significant bits of the indices first
+					for (unsigned int s = 0; s < 2; ++s)
+					{
+						for (unsigned int i = 0; i < 8; ++i)
+						{
+							unsigned int x = subblocks[s].texelIndices[i] % 4;
+							unsigned int y = subblocks[s].texelIndices[i] / 4;
+							unsigned int position = x*4 + y;
+
+							UInt8 index = subblocks[s].modifierIndices[i];
+							bits |= (UInt64(index >> 1) << (position + 16)) | (UInt64(index & 1) << position);
+						}
+					}
+
+					bestError = error;
+					bestBits = bits;
+				}
+			}
+
+			for (unsigned int i = 0; i < 8; ++i)
+				block[i] = static_cast<UInt8>(bestBits >> (56 - i*8));
+		}
+
+		UInt32 FitEacBlock(const UInt8* values, int base, int multiplier, unsigned int table, UInt32 maxError, UInt8* indices)
+		{
+			UInt32 totalError = 0;
+			for (unsigned int i = 0; i < 16 && totalError < maxError; ++i)
+			{
+				UInt32 bestError = std::numeric_limits<UInt32>::max();
+				for (unsigned int j = 0; j < 8; ++j)
+				{
+					int diff = ClampToByte(base + s_eacModifiers[table][j]*multiplier) - int(values[i]);
+					UInt32 error = diff*diff;
+					if (error < bestError)
+					{
+						bestError = error;
+						indices[i] = static_cast<UInt8>(j);
+					}
+				}
+
+				totalError += bestError;
+			}
+
+			return totalError;
+		}
+
+		void CompressEacBlock(const UInt8* texels, UInt8* block)
+		{
+			UInt8 values[16];
+			int minValue = 255;
+			int maxValue = 0;
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				values[i] = texels[i*4 + 3];
+				minValue = std::min<int>(minValue, values[i]);
+				maxValue = std::max<int>(maxValue, values[i]);
+			}
+
+			// Uniform blocks (opaque ones for a start) use the zero modifier of table 13
+			int bestBase = minValue;
+			int bestMultiplier = 1;
+			unsigned int bestTable = 13;
+			UInt8 bestIndices[16];
+			std::fill(bestIndices, bestIndices + 16, 4);
+
+			if (minValue != maxValue)
+			{
+				UInt32 bestError = std::numeric_limits<UInt32>::max();
+				UInt8 indices[16];
+				auto TryParameters = [&](int base, int multiplier, unsigned int table)
+				{
+					if (base < 0 || base > 255 || multiplier < 1 || multiplier > 15)
+						return;
+
+					UInt32 error = FitEacBlock(values, base, multiplier, table, bestError, indices);
+					if (error < bestError)
+					{
+						bestError = error;
+						bestBase = base;
+						bestMultiplier = multiplier;
+						bestTable = table;
+						std::memcpy(bestIndices, indices, 16);
+					}
+				};
+
+				// Every table with the multiplier and base covering the range of the block, then their neighbours for the best one
+				for (unsigned int table = 0; table < 16; ++table)
+				{
+					int tableMin = s_eacModifiers[table][3];
+					int tableMax = s_eacModifiers[table][7];
+
+					int multiplier = std::min(std::max((maxValue - minValue + (tableMax - tableMin)/2) / (tableMax - tableMin), 1), 15);
+					int base = (minValue + maxValue - multiplier*(tableMin + tableMax) + 1) / 2;
+					TryParameters(std::min(std::max(base, 0), 255), multiplier, table);
+				}
+
+				int base = bestBase;
+				int multiplier = bestMultiplier;
+				unsigned int table = bestTable;
+				for (int multiplierOffset = -1; multiplierOffset <= 1; ++multiplierOffset)
+				{
+					for (int baseOffset = -2; baseOffset <= 2; ++baseOffset)
+						TryParameters(base + baseOffset, multiplier + multiplierOffset, table);
+				}
+			}
+
+			UInt64 bits = (UInt64(bestBase) << 56) | (UInt64(bestMultiplier) << 52) | (UInt64(bestTable) << 48);
+			for (unsigned int i = 0; i < 16; ++i)
+			{
+				unsigned int position = (i % 4)*4 + i / 4;
+				bits |= UInt64(bestIndices[i]) << (45 - position*3);
+			}
+
+			for (unsigned int i = 0; i < 8; ++i)
+				block[i] = static_cast<UInt8>(bits >> (56 - i*8));
+		}
+	}
+
+	void CompressBC5Block(const UInt8* texels, UInt8* block)
+	{
+		CompressChannelBlock(texels, 0, &block[0]);
+		CompressChannelBlock(texels, 1, &block[8]);
+	}
+
+	void CompressBC7Block(const UInt8* texels, UInt8* block)
+	{
+		float endpoint0[4];
+		float endpoint1[4];
+		ComputeEndpoints(texels, 4, endpoint0, endpoint1);
+
+		UInt8 quantized0[4];
+		UInt8 quantized1[4];
+		QuantizeBC7Endpoint(endpoint0, quantized0);
+		QuantizeBC7Endpoint(endpoint1, quantized1);
+
+		UInt8 indices[16];
+		UInt32 error = EncodeBC7Endpoints(texels, quantized0, quantized1, block, indices);
+		if (error > 0 && RefineEndpoints(texels, indices, s_bc7FloatWeights, 4, endpoint0, endpoint1))
+		{
+			QuantizeBC7Endpoint(endpoint0, quantized0);
+			QuantizeBC7Endpoint(endpoint1, quantized1);
+
+			UInt8 refinedBlock[16];
+			if (EncodeBC7Endpoints(texels, quantized0, quantized1, refinedBlock, indices) < error)
+				std::memcpy(block, refinedBlock, 16);
+		}
+	}
+
+	void CompressDXT1Block(const UInt8* texels, UInt8* block)
+	{
+		CompressColorBlock(texels, block);
+	}
+
+	void CompressDXT3Block(const UInt8* texels, UInt8* block)
+	{
+		for (unsigned int i = 0; i < 8; ++i)
+		{
+			UInt8 alpha0 = static_cast<UInt8>((texels[i*8 + 3] * 15 + 127) / 255);
+			UInt8 alpha1 = static_cast<UInt8>((texels[i*8 + 7] * 15 + 127) / 255);
+			block[i] = alpha0 | (alpha1 << 4);
+		}
+
+		CompressColorBlock(texels, &block[8]);
+	}
+
+	void CompressDXT5Block(const UInt8* texels, UInt8* block)
+	{
+		CompressChannelBlock(texels, 3, &block[0]);
+		CompressColorBlock(texels, &block[8]);
+	}
+
+	void CompressETC2Block(const UInt8* texels, UInt8* block)
+	{
+		CompressEacBlock(texels, &block[0]);
+		CompressEtcColorBlock(texels, &block[8]);
+	}
+}
@@ -0,0 +1,23 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_BLOCKCOMPRESSION_HPP
+#define NAZARA_BLOCKCOMPRESSION_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	// Every function encodes a block of 4x4 RGBA8 texels (stored row after row)
+	void CompressBC5Block(const UInt8* texels, UInt8* block);
+	void CompressBC7Block(const UInt8* texels, UInt8* block);
+	void CompressDXT1Block(const UInt8* texels, UInt8* block);
+	void CompressDXT3Block(const UInt8* texels, UInt8* block);
+	void CompressDXT5Block(const UInt8* texels, UInt8* block);
+	void CompressETC2Block(const UInt8* texels, UInt8* block);
+}
+
+#endif // NAZARA_BLOCKCOMPRESSION_HPP
@@ -7,6 +7,10 @@
 #include <Nazara/Utility/FontData.hpp>
 #include <Nazara/Utility/FontGlyph.hpp>
 #include <Nazara/Utility/GuillotineImageAtlas.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -24,6 +28,9 @@ namespace Nz
 	}
 
 	Font::Font() :
+	m_distanceFieldEnabled(false),
+	m_distanceFieldSize(48),
+	m_distanceFieldSpread(6),
 	m_glyphBorder(s_defaultGlyphBorder),
 	m_minimumStepSize(s_defaultMinimumStepSize)
 	{
@@ -49,6 +56,10 @@ namespace Nz
 				// Au moins une autre police utilise cet atlas, on vire nos glyphes un par un
 				for (auto mapIt = m_glyphes.begin(); mapIt != m_glyphes.end(); ++mapIt)
 				{
+					// Avec les champs de distance, seuls les glyphes de taille nulle possèdent leur rectangle, les autres le partagent
+					if (m_distanceFieldEnabled && (mapIt->first & 0xFFFFFFFF) != 0)
+						continue;
+
 					GlyphMap& glyphMap = mapIt->second;
 					for (auto glyphIt = glyphMap.begin(); glyphIt != glyphMap.end(); ++glyphIt)
 					{
@@ -92,6 +103,13 @@ namespace Nz
 		#endif
 
 		m_data.reset(data);
+
+		if (m_distanceFieldEnabled && !m_data->SupportsDistanceField())
+		{
+			NazaraWarning("Font data does not support distance fields, disabling them");
+			m_distanceFieldEnabled = false;
+		}
+
 		return true;
 	}
 
@@ -109,6 +127,23 @@ namespace Nz
 		}
 	}
 
+	void Font::EnableDistanceField(bool distanceField)
+	{
+		if (m_distanceFieldEnabled != distanceField)
+		{
+			#if NAZARA_UTILITY_SAFE
+			if (distanceField && m_data && !m_data->SupportsDistanceField())
+			{
+				NazaraError("Font data does not support distance fields");
+				return;
+			}
+			#endif
+
+			ClearGlyphCache();
+			m_distanceFieldEnabled = distanceField;
+		}
+	}
+
 	bool Font::ExtractGlyph(unsigned int characterSize, char32_t character, UInt32 style, FontGlyph* glyph) const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -146,6 +181,16 @@ namespace Nz
 		return count;
 	}
 
+	unsigned int Font::GetDistanceFieldSize() const
+	{
+		return m_distanceFieldSize;
+	}
+
+	unsigned int Font::GetDistanceFieldSpread() const
+	{
+		return m_distanceFieldSpread;
+	}
+
 	String Font::GetFamilyName() const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -251,6 +296,11 @@ namespace Nz
 		return m_data->GetStyleName();
 	}
 
+	bool Font::IsDistanceFieldEnabled() const
+	{
+		return m_distanceFieldEnabled;
+	}
+
 	bool Font::IsValid() const
 	{
 		return m_data != nullptr;
@@ -273,9 +323,7 @@ namespace Nz
 		}
 
 		UInt64 key = ComputeKey(characterSize, style);
-		auto& glyphMap = m_glyphes[key];
-		for (char32_t character : set)
-			PrecacheGlyph(glyphMap, characterSize, style, character);
+		PrecacheGlyphs(m_glyphes[key], characterSize, style, set.data(), set.size());
 
 		return true;
 	}
@@ -319,6 +367,45 @@ namespace Nz
 		}
 	}
 
+	void Font::SetDistanceFieldSize(unsigned int characterSize)
+	{
+		if (m_distanceFieldSize != characterSize)
+		{
+			#if NAZARA_UTILITY_SAFE
+			if (characterSize == 0)
+			{
+				NazaraError("Distance field size cannot be zero");
+				return;
+			}
+			#endif
+
+			// Le cache n'est affecté que si les champs de distance sont utilisés
+			if (m_distanceFieldEnabled)
+				ClearGlyphCache();
+
+			m_distanceFieldSize = characterSize;
+		}
+	}
+
+	void Font::SetDistanceFieldSpread(unsigned int spread)
+	{
+		if (m_distanceFieldSpread != spread)
+		{
+			#if NAZARA_UTILITY_SAFE
+			if (spread == 0)
+			{
+				NazaraError("Distance field spread cannot be zero");
+				return;
+			}
+			#endif
+
+			if (m_distanceFieldEnabled)
+				ClearGlyphCache();
+
+			m_distanceFieldSpread = spread;
+		}
+	}
+
 	void Font::SetGlyphBorder(unsigned int borderSize)
 	{
 		if (m_glyphBorder != borderSize)
@@ -403,8 +490,8 @@ namespace Nz
 
 	UInt64 Font::ComputeKey(unsigned int characterSize, UInt32 style) const
 	{
-		// On prend le pas en compte
-		UInt64 sizePart = static_cast<UInt32>((characterSize/m_minimumStepSize)*m_minimumStepSize);
+		// On prend le pas en compte (sauf avec les champs de distance, la taille nulle y désigne le glyphe de référence)
+		UInt64 sizePart = (m_distanceFieldEnabled) ? characterSize : static_cast<UInt32>((characterSize/m_minimumStepSize)*m_minimumStepSize);
 
 		// Ainsi que le style (uniquement le gras et l'italique, les autres sont gérés par un TextDrawer)
 		UInt64 stylePart = 0;
@@ -490,6 +577,28 @@ namespace Nz
 		}
 		#endif
 
+		if (m_distanceFieldEnabled && characterSize != 0)
+		{
+			// Un seul champ de distance par caractère et par style (rangé à la taille nulle) sert à toutes les tailles,
+			// seules les métriques sont mises à l'échelle
+			UInt64 referenceKey = ComputeKey(0, style);
+			const Glyph& referenceGlyph = PrecacheGlyph(m_glyphes[referenceKey], 0, style, character);
+
+			glyph = referenceGlyph;
+			if (glyph.valid)
+			{
+				float scale = static_cast<float>(characterSize) / m_distanceFieldSize;
+
+				glyph.aabb.x = static_cast<int>(std::round(referenceGlyph.aabb.x * scale));
+				glyph.aabb.y = static_cast<int>(std::round(referenceGlyph.aabb.y * scale));
+				glyph.aabb.width = static_cast<int>(std::round(referenceGlyph.aabb.width * scale));
+				glyph.aabb.height = static_cast<int>(std::round(referenceGlyph.aabb.height * scale));
+				glyph.advance = static_cast<int>(std::round(referenceGlyph.advance * scale));
+			}
+
+			return glyph;
+		}
+
 		// On vérifie que le style demandé est supporté par la police (dans le cas contraire il devra être simulé au rendu)
 		glyph.requireFauxBold = false;
 		glyph.requireFauxItalic = false;
@@ -512,7 +621,10 @@ namespace Nz
 		{
 			// On extrait le glyphe depuis la police
 			FontGlyph fontGlyph;
-			if (ExtractGlyph(characterSize, character, style, &fontGlyph))
+			bool extracted = (m_distanceFieldEnabled) ? m_data->ExtractDistanceField(m_distanceFieldSize, character, style, m_distanceFieldSpread, &fontGlyph)
+			                                          : ExtractGlyph(characterSize, character, style, &fontGlyph);
+
+			if (extracted)
 			{
 				glyph.atlasRect.width = fontGlyph.image.GetWidth();
 				glyph.atlasRect.height = fontGlyph.image.GetHeight();
@@ -567,6 +679,126 @@ namespace Nz
 		return glyph;
 	}
 
+	void Font::PrecacheGlyphs(GlyphMap& glyphMap, unsigned int characterSize, UInt32 style, const char32_t* characters, std::size_t characterCount) const
+	{
+		// Seuls les glyphes absents du cache sont traités (une seule fois chacun)
+		std::vector<char32_t> missingCharacters;
+		for (std::size_t i = 0; i < characterCount; ++i)
+		{
+			if (glyphMap.find(characters[i]) == glyphMap.end())
+				missingCharacters.push_back(characters[i]);
+		}
+
+		std::sort(missingCharacters.begin(), missingCharacters.end());
+		missingCharacters.erase(std::unique(missingCharacters.begin(), missingCharacters.end()), missingCharacters.end());
+
+		if (missingCharacters.empty())
+			return;
+
+		if (!m_atlas)
+		{
+			// PrecacheGlyph se charge de l'erreur
+			for (char32_t character : missingCharacters)
+				PrecacheGlyph(glyphMap, characterSize, style, character);
+
+			return;
+		}
+
+		UInt32 supportedStyle = style;
+		if (style & TextStyle_Bold && !m_data->SupportsStyle(TextStyle_Bold))
+			supportedStyle &= ~TextStyle_Bold;
+
+		if (style & TextStyle_Italic && !m_data->SupportsStyle(TextStyle_Italic))
+			supportedStyle &= ~TextStyle_Italic;
+
+		if ((m_distanceFieldEnabled && characterSize != 0) || style != supportedStyle)
+		{
+			// Ces glyphes ne sont que des copies d'autres glyphes, ce sont ces derniers qui sont préchargés ensemble
+			if (m_distanceFieldEnabled && characterSize != 0)
+				PrecacheGlyphs(m_glyphes[ComputeKey(0, style)], 0, style, missingCharacters.data(), missingCharacters.size());
+			else
+				PrecacheGlyphs(m_glyphes[ComputeKey(characterSize, supportedStyle)], characterSize, supportedStyle, missingCharacters.data(), missingCharacters.size());
+
+			for (char32_t character : missingCharacters)
+				PrecacheGlyph(glyphMap, characterSize, style, character);
+
+			return;
+		}
+
+		// Rastérisation de tous les glyphes (éventuellement en parallèle)
+		std::size_t glyphCount = missingCharacters.size();
+		std::vector<FontGlyph> fontGlyphs(glyphCount);
+		std::unique_ptr<bool[]> extracted(new bool[glyphCount]);
+		if (m_distanceFieldEnabled)
+			m_data->ExtractDistanceFields(m_distanceFieldSize, missingCharacters.data(), glyphCount, style, m_distanceFieldSpread, fontGlyphs.data(), extracted.get());
+		else
+			m_data->ExtractGlyphs(characterSize, missingCharacters.data(), glyphCount, style, fontGlyphs.data(), extracted.get());
+
+		// Puis insertion de toutes les images non-vides dans l'atlas en une fois
+		std::vector<std::size_t> atlasGlyphs;
+		std::vector<Image> images;
+		std::vector<Rectui> rects;
+		for (std::size_t i = 0; i < glyphCount; ++i)
+		{
+			const Image& image = fontGlyphs[i].image;
+			if (extracted[i] && image.IsValid() && image.GetWidth() > 0 && image.GetHeight() > 0)
+			{
+				atlasGlyphs.push_back(i);
+				images.push_back(image);
+
+				// Bordure (pour éviter le débordement lors du filtrage)
+				rects.emplace_back(0U, 0U, image.GetWidth() + m_glyphBorder*2, image.GetHeight() + m_glyphBorder*2);
+			}
+		}
+
+		std::size_t atlasGlyphCount = atlasGlyphs.size();
+		std::unique_ptr<bool[]> flipped(new bool[atlasGlyphCount]);
+		std::vector<unsigned int> layerIndices(atlasGlyphCount, std::numeric_limits<unsigned int>::max());
+		if (atlasGlyphCount > 0 && !m_atlas->Insert(images.data(), rects.data(), flipped.get(), layerIndices.data(), static_cast<unsigned int>(atlasGlyphCount)))
+			NazaraError("Failed to insert glyphes into atlas");
+
+		std::size_t atlasIndex = 0;
+		for (std::size_t i = 0; i < glyphCount; ++i)
+		{
+			char32_t character = missingCharacters[i];
+
+			Glyph& glyph = glyphMap[character];
+			glyph.requireFauxBold = false;
+			glyph.requireFauxItalic = false;
+			glyph.valid = false;
+
+			if (!extracted[i])
+			{
+				NazaraWarning("Failed to extract glyph \"" + String::Unicode(character) + "\"");
+				continue;
+			}
+
+			const FontGlyph& fontGlyph = fontGlyphs[i];
+			glyph.atlasRect.width = 0;
+			glyph.atlasRect.height = 0;
+
+			if (atlasIndex < atlasGlyphCount && atlasGlyphs[atlasIndex] == i)
+			{
+				const Rectui& rect = rects[atlasIndex];
+				unsigned int layerIndex = layerIndices[atlasIndex];
+				bool glyphFlipped = flipped[atlasIndex];
+				atlasIndex++;
+
+				if (layerIndex == std::numeric_limits<unsigned int>::max())
+					continue; // Le glyphe n'a pas pu être inséré
+
+				// Compensation de la bordure (centrage du glyphe)
+				glyph.atlasRect.Set(rect.x + m_glyphBorder, rect.y + m_glyphBorder, rect.width - m_glyphBorder*2, rect.height - m_glyphBorder*2);
+				glyph.flipped = glyphFlipped;
+				glyph.layerIndex = layerIndex;
+			}
+
+			glyph.aabb = fontGlyph.aabb;
+			glyph.advance = fontGlyph.advance;
+			glyph.valid = true;
+		}
+	}
+
 	bool Font::Initialize()
 	{
 		if (!FontLibrary::Initialize())
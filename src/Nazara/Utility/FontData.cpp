@@ -3,9 +3,52 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/FontData.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/FontGlyph.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
 	FontData::~FontData() = default;
+
+	bool FontData::ExtractDistanceField(unsigned int characterSize, char32_t character, UInt32 style, unsigned int spread, FontGlyph* dst)
+	{
+		NazaraUnused(characterSize);
+		NazaraUnused(character);
+		NazaraUnused(style);
+		NazaraUnused(spread);
+		NazaraUnused(dst);
+
+		NazaraError("Font data does not support distance fields");
+		return false;
+	}
+
+	bool FontData::ExtractDistanceFields(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, unsigned int spread, FontGlyph* glyphs, bool* extracted)
+	{
+		bool success = true;
+		for (std::size_t i = 0; i < characterCount; ++i)
+		{
+			extracted[i] = ExtractDistanceField(characterSize, characters[i], style, spread, &glyphs[i]);
+			success &= extracted[i];
+		}
+
+		return success;
+	}
+
+	bool FontData::ExtractGlyphs(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, FontGlyph* glyphs, bool* extracted)
+	{
+		bool success = true;
+		for (std::size_t i = 0; i < characterCount; ++i)
+		{
+			extracted[i] = ExtractGlyph(characterSize, characters[i], style, &glyphs[i]);
+			success &= extracted[i];
+		}
+
+		return success;
+	}
+
+	bool FontData::SupportsDistanceField() const
+	{
+		return false;
+	}
 }
@@ -5,6 +5,7 @@
 #include <Nazara/Utility/Formats/DDSLoader.hpp>
 #include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Utility/Image.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
@@ -42,54 +43,18 @@ namespace Nz
 
 			static bool Load(Image* image, Stream& stream, const ImageParams& parameters)
 			{
-				NazaraUnused(parameters);
-
-				ByteStream byteStream(&stream);
-				byteStream.SetDataEndianness(Endianness_LittleEndian);
-
-				UInt32 magic;
-				byteStream >> magic;
-				NazaraAssert(magic == DDS_Magic, "Invalid DDS file"); // The Check function should make sure this doesn't happen
-
 				DDSHeader header;
-				byteStream >> header;
-
 				DDSHeaderDX10Ext headerDX10;
-				if (header.format.flags & DDPF_FOURCC && header.format.fourCC == D3DFMT_DX10)
-					byteStream >> headerDX10;
-				else
-				{
-					headerDX10.arraySize = 1;
-					headerDX10.dxgiFormat = DXGI_FORMAT_UNKNOWN;
-					headerDX10.miscFlag = 0;
-					headerDX10.resourceDimension = D3D10_RESOURCE_DIMENSION_UNKNOWN;
-				}
-
-				if ((header.flags & DDSD_WIDTH) == 0)
-					NazaraWarning("Ill-formed DDS file, doesn't have a width flag");
-
-				unsigned int width = std::max(header.width, 1U);
-
-				unsigned int height = 1U;
-				if (header.flags & DDSD_HEIGHT)
-					height = std::max(header.height, 1U);
-
-				unsigned int depth = 1U;
-				if (header.flags & DDSD_DEPTH)
-					depth = std::max(header.depth, 1U);
-
-				unsigned int levelCount = (parameters.levelCount > 0) ? std::min(parameters.levelCount, static_cast<UInt8>(header.levelCount)) : header.levelCount;
-
-				// First, identify the type
 				ImageType type;
-				if (!IdentifyImageType(header, headerDX10, &type))
-					return false;
-
-				// Then the format
 				PixelFormatType format;
-				if (!IdentifyPixelFormat(header, headerDX10, &format))
+				if (!ReadHeader(stream, &header, &headerDX10, &type, &format))
 					return false;
 
+				unsigned int width = std::max(header.width, 1U);
+				unsigned int height = (header.flags & DDSD_HEIGHT) ? std::max(header.height, 1U) : 1U;
+				unsigned int depth = (header.flags & DDSD_DEPTH) ? std::max(header.depth, 1U) : 1U;
+				unsigned int levelCount = GetLevelCount(header, parameters);
+
 				image->Create(type, format, width, height, depth, levelCount);
 
 				// Read all mipmap levels
@@ -99,7 +64,7 @@ namespace Nz
 
 					UInt8* ptr = image->GetPixels(0, 0, 0, i);
 
-					if (byteStream.Read(ptr, byteCount) != byteCount)
+					if (stream.Read(ptr, byteCount) != byteCount)
 					{
 						NazaraError("Failed to read level #" + String::Number(i));
 						return false;
@@ -122,7 +87,103 @@ namespace Nz
 				return true;
 			}
 
+			static bool LoadMemory(Image* image, const void* data, std::size_t size, const ImageParams& parameters)
+			{
+				// Levels are copied once from the buffer (usually a file mapping) to the image pixels
+				MemoryView stream(data, size);
+				return Load(image, stream, parameters);
+			}
+
+			static bool LoadView(ImageView* view, const void* data, std::size_t size, const ImageParams& parameters)
+			{
+				MemoryView stream(data, size);
+
+				DDSHeader header;
+				DDSHeaderDX10Ext headerDX10;
+				if (!ReadHeader(stream, &header, &headerDX10, &view->type, &view->format))
+					return false;
+
+				// Cubemaps and arrays store every level of a face/layer before the next one, their levels are not contiguous
+				if (view->type != ImageType_1D && view->type != ImageType_2D && view->type != ImageType_3D)
+					return false;
+
+				view->width = std::max(header.width, 1U);
+				view->height = (header.flags & DDSD_HEIGHT) ? std::max(header.height, 1U) : 1U;
+				view->depth = (header.flags & DDSD_DEPTH) ? std::max(header.depth, 1U) : 1U;
+
+				unsigned int levelCount = GetLevelCount(header, parameters);
+				view->levels.resize(levelCount);
+
+				const UInt8* levelPtr = static_cast<const UInt8*>(data) + stream.GetCursorPos();
+				const UInt8* dataEnd = static_cast<const UInt8*>(data) + size;
+
+				unsigned int width = view->width;
+				unsigned int height = view->height;
+				unsigned int depth = view->depth;
+				for (unsigned int i = 0; i < levelCount; ++i)
+				{
+					std::size_t byteCount = PixelFormat::ComputeSize(view->format, width, height, depth);
+					if (byteCount > static_cast<std::size_t>(dataEnd - levelPtr))
+					{
+						NazaraError("Level #" + String::Number(i) + " is truncated");
+						return false;
+					}
+
+					view->levels[i] = levelPtr;
+					levelPtr += byteCount;
+
+					width = std::max(width >> 1, 1U);
+					height = std::max(height >> 1, 1U);
+					depth = std::max(depth >> 1, 1U);
+				}
+
+				return true;
+			}
+
 		private:
+			static unsigned int GetLevelCount(const DDSHeader& header, const ImageParams& parameters)
+			{
+				unsigned int levelCount = std::max(header.levelCount, 1U);
+				if (parameters.levelCount > 0)
+					levelCount = std::min<unsigned int>(parameters.levelCount, levelCount);
+
+				return levelCount;
+			}
+
+			static bool ReadHeader(Stream& stream, DDSHeader* header, DDSHeaderDX10Ext* headerDX10, ImageType* type, PixelFormatType* format)
+			{
+				ByteStream byteStream(&stream);
+				byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+				UInt32 magic;
+				byteStream >> magic;
+				NazaraAssert(magic == DDS_Magic, "Invalid DDS file"); // The Check function should make sure this doesn't happen
+
+				byteStream >> *header;
+
+				if (header->format.flags & DDPF_FOURCC && header->format.fourCC == D3DFMT_DX10)
+					byteStream >> *headerDX10;
+				else
+				{
+					headerDX10->arraySize = 1;
+					headerDX10->dxgiFormat = DXGI_FORMAT_UNKNOWN;
+					headerDX10->miscFlag = 0;
+					headerDX10->resourceDimension = D3D10_RESOURCE_DIMENSION_UNKNOWN;
+				}
+
+				if ((header->flags & DDSD_WIDTH) == 0)
+					NazaraWarning("Ill-formed DDS file, doesn't have a width flag");
+
+				// First, identify the type, then the format
+				if (!IdentifyImageType(*header, *headerDX10, type))
+					return false;
+
+				if (!IdentifyPixelFormat(*header, *headerDX10, format))
+					return false;
+
+				return true;
+			}
+
 			static bool IdentifyImageType(const DDSHeader& header, const DDSHeaderDX10Ext& headerExt, ImageType* type)
 			{
 				if (headerExt.arraySize > 1)
@@ -201,7 +262,7 @@ namespace Nz
 							break;
 
 						case D3DFMT_DXT5:
-							*format = PixelFormatType_DXT3;
+							*format = PixelFormatType_DXT5;
 							break;
 
 						case D3DFMT_DX10:
@@ -234,6 +295,28 @@ namespace Nz
 								case DXGI_FORMAT_R16G16B16A16_UNORM:
 									*format = PixelFormatType_RGBA16UI;
 									break;
+								case DXGI_FORMAT_BC1_UNORM:
+								case DXGI_FORMAT_BC1_UNORM_SRGB:
+									*format = PixelFormatType_DXT1;
+									break;
+								case DXGI_FORMAT_BC2_UNORM:
+								case DXGI_FORMAT_BC2_UNORM_SRGB:
+									*format = PixelFormatType_DXT3;
+									break;
+								case DXGI_FORMAT_BC3_UNORM:
+								case DXGI_FORMAT_BC3_UNORM_SRGB:
+									*format = PixelFormatType_DXT5;
+									break;
+								case DXGI_FORMAT_BC5_UNORM:
+									*format = PixelFormatType_BC5;
+									break;
+								case DXGI_FORMAT_BC7_UNORM:
+								case DXGI_FORMAT_BC7_UNORM_SRGB:
+									*format = PixelFormatType_BC7;
+									break;
+								default:
+									NazaraError("Unhandled DXGI format " + String::Number(headerExt.dxgiFormat));
+									return false;
 							}
 							break;
 						}
@@ -266,12 +349,14 @@ namespace Nz
 	{
 		void RegisterDDSLoader()
 		{
-			ImageLoader::RegisterLoader(DDSLoader::IsSupported, DDSLoader::Check, DDSLoader::Load);
+			ImageLoader::RegisterLoader(DDSLoader::IsSupported, DDSLoader::Check, DDSLoader::Load, nullptr, DDSLoader::LoadMemory);
+			Image::RegisterViewLoader(DDSLoader::Check, DDSLoader::LoadView);
 		}
 
 		void UnregisterDDSLoader()
 		{
-			ImageLoader::UnregisterLoader(DDSLoader::IsSupported, DDSLoader::Check, DDSLoader::Load);
+			ImageLoader::UnregisterLoader(DDSLoader::IsSupported, DDSLoader::Check, DDSLoader::Load, nullptr, DDSLoader::LoadMemory);
+			Image::UnregisterViewLoader(DDSLoader::Check, DDSLoader::LoadView);
 		}
 	}
 }
@@ -10,11 +10,18 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Utility/Font.hpp>
 #include <Nazara/Utility/FontData.hpp>
 #include <Nazara/Utility/FontGlyph.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <set>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -26,6 +33,96 @@ namespace Nz
 		FT_Library s_library;
 		std::shared_ptr<FreeTypeLibrary> s_libraryOwner;
 		float s_invScaleFactor = 1.f / (1 << 6); // 1/64
+		const std::size_t s_glyphsPerTask = 16;
+
+		// Aplatit un contour FreeType en segments (en pixels) afin d'en calculer le champ de distance
+		struct OutlineFlattener
+		{
+			std::vector<Vector2f> segments; // Paires de points
+			Vector2f current;
+		};
+
+		Vector2f FromFreeType(const FT_Vector* vec)
+		{
+			return Vector2f(vec->x * s_invScaleFactor, vec->y * s_invScaleFactor);
+		}
+
+		unsigned int ComputeSubdivisionCount(float length)
+		{
+			// Un segment tous les deux pixels environ suffit, le champ étant de toute façon interpolé
+			return Clamp(static_cast<unsigned int>(length * 0.5f) + 2U, 2U, 16U);
+		}
+
+		extern "C"
+		int FT_OutlineMoveTo(const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+			flattener.current = FromFreeType(to);
+
+			return 0;
+		}
+
+		extern "C"
+		int FT_OutlineLineTo(const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+
+			Vector2f point = FromFreeType(to);
+			flattener.segments.push_back(flattener.current);
+			flattener.segments.push_back(point);
+			flattener.current = point;
+
+			return 0;
+		}
+
+		extern "C"
+		int FT_OutlineConicTo(const FT_Vector* control, const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+
+			Vector2f start = flattener.current;
+			Vector2f controlPoint = FromFreeType(control);
+			Vector2f end = FromFreeType(to);
+
+			unsigned int stepCount = ComputeSubdivisionCount(start.Distance(controlPoint) + controlPoint.Distance(end));
+			for (unsigned int i = 1; i <= stepCount; ++i)
+			{
+				float t = static_cast<float>(i) / stepCount;
+				float invT = 1.f - t;
+
+				Vector2f point = invT*invT*start + 2.f*invT*t*controlPoint + t*t*end;
+				flattener.segments.push_back(flattener.current);
+				flattener.segments.push_back(point);
+				flattener.current = point;
+			}
+
+			return 0;
+		}
+
+		extern "C"
+		int FT_OutlineCubicTo(const FT_Vector* control1, const FT_Vector* control2, const FT_Vector* to, void* user)
+		{
+			OutlineFlattener& flattener = *static_cast<OutlineFlattener*>(user);
+
+			Vector2f start = flattener.current;
+			Vector2f firstControl = FromFreeType(control1);
+			Vector2f secondControl = FromFreeType(control2);
+			Vector2f end = FromFreeType(to);
+
+			unsigned int stepCount = ComputeSubdivisionCount(start.Distance(firstControl) + firstControl.Distance(secondControl) + secondControl.Distance(end));
+			for (unsigned int i = 1; i <= stepCount; ++i)
+			{
+				float t = static_cast<float>(i) / stepCount;
+				float invT = 1.f - t;
+
+				Vector2f point = invT*invT*invT*start + 3.f*invT*invT*t*firstControl + 3.f*invT*t*t*secondControl + t*t*t*end;
+				flattener.segments.push_back(flattener.current);
+				flattener.segments.push_back(point);
+				flattener.current = point;
+			}
+
+			return 0;
+		}
 
 		extern "C"
 		unsigned long FT_StreamRead(FT_Stream stream, unsigned long offset, unsigned char* buffer, unsigned long count)
@@ -86,6 +183,12 @@ namespace Nz
 
 				~FreeTypeStream()
 				{
+					for (WorkerFace& workerFace : m_workerFaces)
+					{
+						FT_Done_Face(workerFace.face);
+						FT_Done_FreeType(workerFace.library);
+					}
+
 					if (m_face)
 						FT_Done_Face(m_face);
 				}
@@ -96,7 +199,7 @@ namespace Nz
 					return FT_Open_Face(s_library, &m_args, -1, nullptr) == 0;
 				}
 
-				bool ExtractGlyph(unsigned int characterSize, char32_t character, UInt32 style, FontGlyph* dst) override
+				bool ExtractDistanceField(unsigned int characterSize, char32_t character, UInt32 style, unsigned int spread, FontGlyph* dst) override
 				{
 					#ifdef NAZARA_DEBUG
 					if (!dst)
@@ -108,97 +211,40 @@ namespace Nz
 
 					SetCharacterSize(characterSize);
 
-					if (FT_Load_Char(m_face, character, FT_LOAD_FORCE_AUTOHINT | FT_LOAD_TARGET_NORMAL) != 0)
-					{
-						NazaraError("Failed to load character");
-						return false;
-					}
-
-					FT_GlyphSlot& glyph = m_face->glyph;
-
-					const FT_Pos boldStrength = 2 << 6;
-
-					bool embolden = (style & TextStyle_Bold);
-
-					dst->advance = (embolden) ? boldStrength >> 6 : 0;
+					return RasterizeDistanceField(m_face, character, style, spread, dst);
+				}
 
-					if (embolden && glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+				bool ExtractDistanceFields(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, unsigned int spread, FontGlyph* glyphs, bool* extracted) override
+				{
+					return ExtractBatch(characterSize, characterCount, extracted, [=] (FT_Library library, FT_Face face, std::size_t index)
 					{
-						// http://www.freetype.org/freetype2/docs/reference/ft2-outline_processing.html#FT_Outline_Embolden
-						FT_Outline_Embolden(&glyph->outline, boldStrength);
-						embolden = false;
-					}
+						NazaraUnused(library);
 
-					// http://www.freetype.org/freetype2/docs/reference/ft2-glyph_management.html#FT_Glyph_To_Bitmap
-					// Conversion du glyphe vers le format bitmap
-					// Cette fonction ne fait rien dans le cas où le glyphe est déjà un bitmap
-					if (FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL) != 0)
-					{
-						NazaraError("Failed to convert glyph to bitmap");
-						return false;
-					}
+						return RasterizeDistanceField(face, characters[index], style, spread, &glyphs[index]);
+					});
+				}
 
-					// Dans le cas où nous voulons des caractères gras mais que nous n'avons pas pu agir plus tôt
-					// nous demandons à FreeType d'agir directement sur le bitmap généré
-					if (embolden)
+				bool ExtractGlyph(unsigned int characterSize, char32_t character, UInt32 style, FontGlyph* dst) override
+				{
+					#ifdef NAZARA_DEBUG
+					if (!dst)
 					{
-						// http://www.freetype.org/freetype2/docs/reference/ft2-bitmap_handling.html#FT_Bitmap_Embolden
-						// "If you want to embolden the bitmap owned by a FT_GlyphSlot_Rec, you should call FT_GlyphSlot_Own_Bitmap on the slot first"
-						FT_GlyphSlot_Own_Bitmap(glyph);
-						FT_Bitmap_Embolden(s_library, &glyph->bitmap, boldStrength, boldStrength);
+						NazaraError("Glyph destination cannot be null");
+						return false;
 					}
+					#endif
 
-					dst->advance += glyph->metrics.horiAdvance >> 6;
-					dst->aabb.x = glyph->metrics.horiBearingX >> 6;
-					dst->aabb.y = -(glyph->metrics.horiBearingY >> 6); // Inversion du repère
-					dst->aabb.width = glyph->metrics.width >> 6;
-					dst->aabb.height = glyph->metrics.height >> 6;
+					SetCharacterSize(characterSize);
 
-					unsigned int width = glyph->bitmap.width;
-					unsigned int height = glyph->bitmap.rows;
+					return RasterizeGlyph(s_library, m_face, character, style, dst);
+				}
 
-					if (width > 0 && height > 0)
+				bool ExtractGlyphs(unsigned int characterSize, const char32_t* characters, std::size_t characterCount, UInt32 style, FontGlyph* glyphs, bool* extracted) override
+				{
+					return ExtractBatch(characterSize, characterCount, extracted, [=] (FT_Library library, FT_Face face, std::size_t index)
 					{
-						dst->image.Create(ImageType_2D, PixelFormatType_A8, width, height);
-						UInt8* pixels = dst->image.GetPixels();
-
-						const UInt8* data = glyph->bitmap.buffer;
-
-						// Selon la documentation FreeType, le glyphe peut être encodé en format A8 (huit bits d'alpha par pixel)
-						// ou au format A1 (un bit d'alpha par pixel).
-						// Cependant dans un cas comme dans l'autre, il nous faut gérer le pitch (les données peuvent ne pas être contigues)
-						// ainsi que le padding dans le cas du format A1 (Chaque ligne prends un nombre fixe d'octets)
-						if (glyph->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-						{
-							// Format A1
-							for (unsigned int y = 0; y < height; ++y)
-							{
-								for (unsigned int x = 0; x < width; ++x)
-									*pixels++ = (data[x/8] & ((1 << (7 - x%8)) ? 255 : 0));
-
-								data += glyph->bitmap.pitch;
-							}
-						}
-						else
-						{
-							// Format A8
-							if (glyph->bitmap.pitch == static_cast<int>(width*sizeof(UInt8))) // Pouvons-nous copier directement ?
-								dst->image.Update(glyph->bitmap.buffer);
-							else
-							{
-								for (unsigned int y = 0; y < height; ++y)
-								{
-									std::memcpy(pixels, data, width*sizeof(UInt8));
-									data += glyph->bitmap.pitch;
-									pixels += width*sizeof(UInt8);
-								}
-							}
-						}
-					}
-					else
-						dst->image.Destroy(); // On s'assure que l'image ne contient alors rien
-
-					return true;
+						return RasterizeGlyph(library, face, characters[index], style, &glyphs[index]);
+					});
 				}
 
 				String GetFamilyName() const override
@@ -312,6 +358,11 @@ namespace Nz
 					m_args.stream = &m_stream;
 				}
 
+				bool SupportsDistanceField() const override
+				{
+					return FT_IS_SCALABLE(m_face) != 0;
+				}
+
 				bool SupportsStyle(UInt32 style) const override
 				{
 					///TODO
@@ -319,6 +370,293 @@ namespace Nz
 				}
 
 			private:
+				struct WorkerFace
+				{
+					FT_Library library;
+					FT_Face face;
+				};
+
+				template<typename F>
+				bool ExtractBatch(unsigned int characterSize, std::size_t characterCount, bool* extracted, F rasterize)
+				{
+					if (characterCount == 0)
+						return true;
+
+					// Une face (ainsi que la bibliothèque qui l'a créée) ne peut être utilisée que par un seul thread à la fois,
+					// chaque tâche dispose donc de la sienne, la face principale étant réservée au thread appelant
+					std::size_t taskCount = std::min<std::size_t>(TaskScheduler::GetWorkerCount() + 1, (characterCount + s_glyphsPerTask - 1) / s_glyphsPerTask);
+					if (taskCount > 1)
+						taskCount = 1 + PrepareWorkerFaces(taskCount - 1);
+
+					SetCharacterSize(characterSize);
+					for (std::size_t i = 0; i + 1 < taskCount; ++i)
+						FT_Set_Pixel_Sizes(m_workerFaces[i].face, 0, characterSize);
+
+					std::size_t grainSize = std::max<std::size_t>((characterCount + taskCount - 1) / taskCount, 1);
+					TaskScheduler::ParallelFor(0, characterCount, grainSize, [&] (std::size_t first, std::size_t last)
+					{
+						// Chaque morceau (sauf le premier) possède sa propre face
+						std::size_t task = first / grainSize;
+
+						FT_Library library = (task == 0) ? s_library : m_workerFaces[task - 1].library;
+						FT_Face face = (task == 0) ? m_face : m_workerFaces[task - 1].face;
+						for (std::size_t i = first; i < last; ++i)
+							extracted[i] = rasterize(library, face, i);
+					});
+
+					return std::all_of(extracted, extracted + characterCount, [] (bool glyphExtracted) { return glyphExtracted; });
+				}
+
+				std::size_t PrepareWorkerFaces(std::size_t faceCount)
+				{
+					if (m_workerFaces.size() >= faceCount)
+						return faceCount;
+
+					if (m_faceData.empty())
+					{
+						// Les faces supplémentaires sont ouvertes depuis une copie en mémoire, le flux ne pouvant être lu en parallèle
+						Stream& stream = *static_cast<Stream*>(m_stream.descriptor.pointer);
+
+						m_faceData.resize(m_stream.size);
+						if (!stream.SetCursorPos(0) || stream.Read(m_faceData.data(), m_faceData.size()) != m_faceData.size())
+						{
+							NazaraWarning("Failed to read font data, glyphes will not be rasterized in parallel");
+							m_faceData.clear();
+
+							return 0;
+						}
+					}
+
+					while (m_workerFaces.size() < faceCount)
+					{
+						WorkerFace workerFace;
+						if (FT_Init_FreeType(&workerFace.library) != 0)
+							break;
+
+						if (FT_New_Memory_Face(workerFace.library, m_faceData.data(), static_cast<FT_Long>(m_faceData.size()), m_face->face_index, &workerFace.face) != 0)
+						{
+							FT_Done_FreeType(workerFace.library);
+							break;
+						}
+
+						m_workerFaces.push_back(workerFace);
+					}
+
+					return m_workerFaces.size();
+				}
+
+				static bool RasterizeDistanceField(FT_Face face, char32_t character, UInt32 style, unsigned int spread, FontGlyph* dst)
+				{
+					// Le hinting n'a pas de sens ici, le champ étant destiné à être affiché à d'autres tailles
+					if (FT_Load_Char(face, character, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP) != 0)
+					{
+						NazaraError("Failed to load character");
+						return false;
+					}
+
+					FT_GlyphSlot& glyph = face->glyph;
+					if (glyph->format != FT_GLYPH_FORMAT_OUTLINE)
+					{
+						NazaraError("Glyph has no outline");
+						return false;
+					}
+
+					const FT_Pos boldStrength = 2 << 6;
+
+					dst->advance = 0;
+					if (style & TextStyle_Bold)
+					{
+						FT_Outline_Embolden(&glyph->outline, boldStrength);
+						dst->advance += boldStrength >> 6;
+					}
+
+					dst->advance += (glyph->metrics.horiAdvance + 32) >> 6;
+
+					// http://www.freetype.org/freetype2/docs/reference/ft2-outline_processing.html#FT_Outline_Get_CBox
+					FT_BBox box;
+					FT_Outline_Get_CBox(&glyph->outline, &box);
+
+					int left = static_cast<int>(box.xMin >> 6);
+					int bottom = static_cast<int>(box.yMin >> 6);
+					int right = static_cast<int>((box.xMax + 63) >> 6);
+					int top = static_cast<int>((box.yMax + 63) >> 6);
+
+					OutlineFlattener flattener;
+
+					// http://www.freetype.org/freetype2/docs/reference/ft2-outline_processing.html#FT_Outline_Decompose
+					FT_Outline_Funcs funcs;
+					funcs.move_to = FT_OutlineMoveTo;
+					funcs.line_to = FT_OutlineLineTo;
+					funcs.conic_to = FT_OutlineConicTo;
+					funcs.cubic_to = FT_OutlineCubicTo;
+					funcs.shift = 0;
+					funcs.delta = 0;
+
+					if (glyph->outline.n_contours == 0 || right <= left || top <= bottom || FT_Outline_Decompose(&glyph->outline, &funcs, &flattener) != 0 || flattener.segments.empty())
+					{
+						// Caractère sans contour (espace par exemple)
+						dst->aabb.Set(0, 0, 0, 0);
+						dst->image.Destroy();
+
+						return true;
+					}
+
+					int padding = static_cast<int>(spread);
+					unsigned int width = static_cast<unsigned int>(right - left + 2*padding);
+					unsigned int height = static_cast<unsigned int>(top - bottom + 2*padding);
+
+					dst->aabb.x = left - padding;
+					dst->aabb.y = -(top + padding); // Inversion du repère
+					dst->aabb.width = width;
+					dst->aabb.height = height;
+
+					dst->image.Create(ImageType_2D, PixelFormatType_A8, width, height);
+					UInt8* pixels = dst->image.GetPixels();
+
+					bool evenOdd = (glyph->outline.flags & FT_OUTLINE_EVEN_ODD_FILL) != 0;
+					float invRange = 1.f / (2.f * std::max(spread, 1U));
+					std::size_t segmentCount = flattener.segments.size() / 2;
+
+					for (unsigned int py = 0; py < height; ++py)
+					{
+						float y = top + padding - py - 0.5f;
+						for (unsigned int px = 0; px < width; ++px)
+						{
+							Vector2f point(left - padding + px + 0.5f, y);
+
+							float minSquaredDistance = std::numeric_limits<float>::infinity();
+							int winding = 0;
+							for (std::size_t i = 0; i < segmentCount; ++i)
+							{
+								const Vector2f& a = flattener.segments[2*i];
+								const Vector2f& b = flattener.segments[2*i + 1];
+
+								Vector2f ab = b - a;
+								Vector2f ap = point - a;
+
+								float squaredLength = ab.GetSquaredLength();
+								float t = (squaredLength > 0.f) ? Clamp(ap.DotProduct(ab) / squaredLength, 0.f, 1.f) : 0.f;
+								minSquaredDistance = std::min(minSquaredDistance, (ap - ab*t).GetSquaredLength());
+
+								// Nombre d'enroulement du contour autour du point
+								float cross = ab.x*ap.y - ab.y*ap.x;
+								if (a.y <= point.y)
+								{
+									if (b.y > point.y && cross > 0.f)
+										winding++;
+								}
+								else if (b.y <= point.y && cross < 0.f)
+									winding--;
+							}
+
+							bool inside = (evenOdd) ? (winding & 1) != 0 : winding != 0;
+							float distance = std::sqrt(minSquaredDistance);
+							if (!inside)
+								distance = -distance;
+
+							// La valeur 0.5 correspond au bord du glyphe, l'intérieur étant au-dessus
+							*pixels++ = static_cast<UInt8>(Clamp(0.5f + distance*invRange, 0.f, 1.f) * 255.f + 0.5f);
+						}
+					}
+
+					return true;
+				}
+
+				static bool RasterizeGlyph(FT_Library library, FT_Face face, char32_t character, UInt32 style, FontGlyph* dst)
+				{
+					if (FT_Load_Char(face, character, FT_LOAD_FORCE_AUTOHINT | FT_LOAD_TARGET_NORMAL) != 0)
+					{
+						NazaraError("Failed to load character");
+						return false;
+					}
+
+					FT_GlyphSlot& glyph = face->glyph;
+
+					const FT_Pos boldStrength = 2 << 6;
+
+					bool embolden = (style & TextStyle_Bold);
+
+					dst->advance = (embolden) ? boldStrength >> 6 : 0;
+
+					if (embolden && glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+					{
+						// http://www.freetype.org/freetype2/docs/reference/ft2-outline_processing.html#FT_Outline_Embolden
+						FT_Outline_Embolden(&glyph->outline, boldStrength);
+						embolden = false;
+					}
+
+					// http://www.freetype.org/freetype2/docs/reference/ft2-glyph_management.html#FT_Glyph_To_Bitmap
+					// Conversion du glyphe vers le format bitmap
+					// Cette fonction ne fait rien dans le cas où le glyphe est déjà un bitmap
+					if (FT_Render_Glyph(glyph, FT_RENDER_MODE_NORMAL) != 0)
+					{
+						NazaraError("Failed to convert glyph to bitmap");
+						return false;
+					}
+
+					// Dans le cas où nous voulons des caractères gras mais que nous n'avons pas pu agir plus tôt
+					// nous demandons à FreeType d'agir directement sur le bitmap généré
+					if (embolden)
+					{
+						// http://www.freetype.org/freetype2/docs/reference/ft2-bitmap_handling.html#FT_Bitmap_Embolden
+						// "If you want to embolden the bitmap owned by a FT_GlyphSlot_Rec, you should call FT_GlyphSlot_Own_Bitmap on the slot first"
+						FT_GlyphSlot_Own_Bitmap(glyph);
+						FT_Bitmap_Embolden(library, &glyph->bitmap, boldStrength, boldStrength);
+					}
+
+					dst->advance += glyph->metrics.horiAdvance >> 6;
+					dst->aabb.x = glyph->metrics.horiBearingX >> 6;
+					dst->aabb.y = -(glyph->metrics.horiBearingY >> 6); // Inversion du repère
+					dst->aabb.width = glyph->metrics.width >> 6;
+					dst->aabb.height = glyph->metrics.height >> 6;
+
+					unsigned int width = glyph->bitmap.width;
+					unsigned int height = glyph->bitmap.rows;
+
+					if (width > 0 && height > 0)
+					{
+						dst->image.Create(ImageType_2D, PixelFormatType_A8, width, height);
+						UInt8* pixels = dst->image.GetPixels();
+
+						const UInt8* data = glyph->bitmap.buffer;
+
+						// Selon la documentation FreeType, le glyphe peut être encodé en format A8 (huit bits d'alpha par pixel)
+						// ou au format A1 (un bit d'alpha par pixel).
+						// Cependant dans un cas comme dans l'autre, il nous faut gérer le pitch (les données peuvent ne pas être contigues)
+						// ainsi que le padding dans le cas du format A1 (Chaque ligne prends un nombre fixe d'octets)
+						if (glyph->bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+						{
+							// Format A1
+							for (unsigned int y = 0; y < height; ++y)
+							{
+								for (unsigned int x = 0; x < width; ++x)
+									*pixels++ = (data[x/8] & ((1 << (7 - x%8)) ? 255 : 0));
+
+								data += glyph->bitmap.pitch;
+							}
+						}
+						else
+						{
+							// Format A8
+							if (glyph->bitmap.pitch == static_cast<int>(width*sizeof(UInt8))) // Pouvons-nous copier directement ?
+								dst->image.Update(glyph->bitmap.buffer);
+							else
+							{
+								for (unsigned int y = 0; y < height; ++y)
+								{
+									std::memcpy(pixels, data, width*sizeof(UInt8));
+									data += glyph->bitmap.pitch;
+									pixels += width*sizeof(UInt8);
+								}
+							}
+						}
+					}
+					else
+						dst->image.Destroy(); // On s'assure que l'image ne contient alors rien
+
+					return true;
+				}
+
 				void SetCharacterSize(unsigned int characterSize) const
 				{
 					if (m_characterSize != characterSize)
@@ -333,6 +671,8 @@ namespace Nz
 				FT_StreamRec m_stream;
 				std::shared_ptr<FreeTypeLibrary> m_library;
 				std::unique_ptr<Stream> m_ownedStream;
+				std::vector<UInt8> m_faceData;
+				std::vector<WorkerFace> m_workerFaces;
 				mutable unsigned int m_characterSize;
 		};
 
@@ -0,0 +1,138 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/KTXConstants.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct VkFormatMapping
+		{
+			UInt32 vkFormat;
+			PixelFormatType format;
+		};
+
+		// The first Vulkan format of every pixel format is the one we save, the others (sRGB variants mostly) are only loaded
+		constexpr VkFormatMapping s_vkFormats[] = {
+			{9,   PixelFormatType_R8},      // VK_FORMAT_R8_UNORM
+			{16,  PixelFormatType_RG8},     // VK_FORMAT_R8G8_UNORM
+			{23,  PixelFormatType_RGB8},    // VK_FORMAT_R8G8B8_UNORM
+			{29,  PixelFormatType_RGB8},    // VK_FORMAT_R8G8B8_SRGB
+			{30,  PixelFormatType_BGR8},    // VK_FORMAT_B8G8R8_UNORM
+			{36,  PixelFormatType_BGR8},    // VK_FORMAT_B8G8R8_SRGB
+			{37,  PixelFormatType_RGBA8},   // VK_FORMAT_R8G8B8A8_UNORM
+			{43,  PixelFormatType_RGBA8},   // VK_FORMAT_R8G8B8A8_SRGB
+			{44,  PixelFormatType_BGRA8},   // VK_FORMAT_B8G8R8A8_UNORM
+			{50,  PixelFormatType_BGRA8},   // VK_FORMAT_B8G8R8A8_SRGB
+			{76,  PixelFormatType_R16F},    // VK_FORMAT_R16_SFLOAT
+			{83,  PixelFormatType_RG16F},   // VK_FORMAT_R16G16_SFLOAT
+			{90,  PixelFormatType_RGB16F},  // VK_FORMAT_R16G16B16_SFLOAT
+			{97,  PixelFormatType_RGBA16F}, // VK_FORMAT_R16G16B16A16_SFLOAT
+			{100, PixelFormatType_R32F},    // VK_FORMAT_R32_SFLOAT
+			{103, PixelFormatType_RG32F},   // VK_FORMAT_R32G32_SFLOAT
+			{106, PixelFormatType_RGB32F},  // VK_FORMAT_R32G32B32_SFLOAT
+			{109, PixelFormatType_RGBA32F}, // VK_FORMAT_R32G32B32A32_SFLOAT
+			{131, PixelFormatType_DXT1},    // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+			{132, PixelFormatType_DXT1},    // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+			{133, PixelFormatType_DXT1},    // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+			{134, PixelFormatType_DXT1},    // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+			{135, PixelFormatType_DXT3},    // VK_FORMAT_BC2_UNORM_BLOCK
+			{136, PixelFormatType_DXT3},    // VK_FORMAT_BC2_SRGB_BLOCK
+			{137, PixelFormatType_DXT5},    // VK_FORMAT_BC3_UNORM_BLOCK
+			{138, PixelFormatType_DXT5},    // VK_FORMAT_BC3_SRGB_BLOCK
+			{141, PixelFormatType_BC5},     // VK_FORMAT_BC5_UNORM_BLOCK
+			{145, PixelFormatType_BC7},     // VK_FORMAT_BC7_UNORM_BLOCK
+			{146, PixelFormatType_BC7},     // VK_FORMAT_BC7_SRGB_BLOCK
+			{151, PixelFormatType_ETC2},    // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+			{152, PixelFormatType_ETC2}     // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+		};
+	}
+
+	PixelFormatType KTX2_GetPixelFormat(UInt32 vkFormat)
+	{
+		for (const VkFormatMapping& mapping : s_vkFormats)
+		{
+			if (mapping.vkFormat == vkFormat)
+				return mapping.format;
+		}
+
+		return PixelFormatType_Undefined;
+	}
+
+	UInt32 KTX2_GetVkFormat(PixelFormatType format)
+	{
+		for (const VkFormatMapping& mapping : s_vkFormats)
+		{
+			if (mapping.format == format)
+				return mapping.vkFormat;
+		}
+
+		return 0; // VK_FORMAT_UNDEFINED
+	}
+
+	bool Serialize(SerializationContext& context, const KTX2Header& header)
+	{
+		const UInt32 fields[] = {header.vkFormat, header.typeSize, header.pixelWidth, header.pixelHeight, header.pixelDepth, header.layerCount, header.faceCount,
+		                         header.levelCount, header.supercompressionScheme, header.dfdByteOffset, header.dfdByteLength, header.kvdByteOffset, header.kvdByteLength};
+
+		for (UInt32 field : fields)
+		{
+			if (!Serialize(context, field))
+				return false;
+		}
+
+		if (!Serialize(context, header.sgdByteOffset))
+			return false;
+		if (!Serialize(context, header.sgdByteLength))
+			return false;
+
+		return true;
+	}
+
+	bool Serialize(SerializationContext& context, const KTX2LevelIndex& levelIndex)
+	{
+		if (!Serialize(context, levelIndex.byteOffset))
+			return false;
+		if (!Serialize(context, levelIndex.byteLength))
+			return false;
+		if (!Serialize(context, levelIndex.uncompressedByteLength))
+			return false;
+
+		return true;
+	}
+
+	bool Unserialize(SerializationContext& context, KTX2Header* header)
+	{
+		UInt32* fields[] = {&header->vkFormat, &header->typeSize, &header->pixelWidth, &header->pixelHeight, &header->pixelDepth, &header->layerCount, &header->faceCount,
+		                    &header->levelCount, &header->supercompressionScheme, &header->dfdByteOffset, &header->dfdByteLength, &header->kvdByteOffset, &header->kvdByteLength};
+
+		for (UInt32* field : fields)
+		{
+			if (!Unserialize(context, field))
+				return false;
+		}
+
+		if (!Unserialize(context, &header->sgdByteOffset))
+			return false;
+		if (!Unserialize(context, &header->sgdByteLength))
+			return false;
+
+		return true;
+	}
+
+	bool Unserialize(SerializationContext& context, KTX2LevelIndex* levelIndex)
+	{
+		if (!Unserialize(context, &levelIndex->byteOffset))
+			return false;
+		if (!Unserialize(context, &levelIndex->byteLength))
+			return false;
+		if (!Unserialize(context, &levelIndex->uncompressedByteLength))
+			return false;
+
+		return true;
+	}
+}
@@ -0,0 +1,76 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_LOADERS_KTX_CONSTANTS_HPP
+#define NAZARA_LOADERS_KTX_CONSTANTS_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/SerializationContext.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/Enums.hpp>
+
+namespace Nz
+{
+	constexpr UInt8 KTX2_Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+	enum KTX2ChannelType
+	{
+		KTX2Channel_Red   = 0,
+		KTX2Channel_Green = 1,
+		KTX2Channel_Blue  = 2,
+		KTX2Channel_Alpha = 15,
+
+		KTX2Channel_Float  = 0x80,
+		KTX2Channel_Signed = 0x40
+	};
+
+	enum KTX2ColorModel
+	{
+		KTX2ColorModel_RGBSDA = 1,
+		KTX2ColorModel_BC1    = 128,
+		KTX2ColorModel_BC2    = 129,
+		KTX2ColorModel_BC3    = 130,
+		KTX2ColorModel_BC5    = 132,
+		KTX2ColorModel_BC7    = 134,
+		KTX2ColorModel_ETC2   = 161
+	};
+
+	struct KTX2Header
+	{
+		UInt32 vkFormat;
+		UInt32 typeSize;
+		UInt32 pixelWidth;
+		UInt32 pixelHeight;
+		UInt32 pixelDepth;
+		UInt32 layerCount;
+		UInt32 faceCount;
+		UInt32 levelCount;
+		UInt32 supercompressionScheme;
+		UInt32 dfdByteOffset;
+		UInt32 dfdByteLength;
+		UInt32 kvdByteOffset;
+		UInt32 kvdByteLength;
+		UInt64 sgdByteOffset;
+		UInt64 sgdByteLength;
+	};
+
+	struct KTX2LevelIndex
+	{
+		UInt64 byteOffset;
+		UInt64 byteLength;
+		UInt64 uncompressedByteLength;
+	};
+
+	PixelFormatType KTX2_GetPixelFormat(UInt32 vkFormat);
+	UInt32 KTX2_GetVkFormat(PixelFormatType format);
+
+	NAZARA_UTILITY_API bool Serialize(SerializationContext& context, const KTX2Header& header);
+	NAZARA_UTILITY_API bool Serialize(SerializationContext& context, const KTX2LevelIndex& levelIndex);
+	NAZARA_UTILITY_API bool Unserialize(SerializationContext& context, KTX2Header* header);
+	NAZARA_UTILITY_API bool Unserialize(SerializationContext& context, KTX2LevelIndex* levelIndex);
+}
+
+#endif // NAZARA_LOADERS_KTX_CONSTANTS_HPP
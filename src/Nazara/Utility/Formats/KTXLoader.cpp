@@ -0,0 +1,149 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/KTXLoader.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Utility/Formats/KTXConstants.hpp>
+#include <algorithm>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "ktx2");
+		}
+
+		Ternary Check(Stream& stream, const ImageParams& parameters)
+		{
+			bool skip;
+			if (parameters.custom.GetBooleanParameter("SkipNativeKTXLoader", &skip) && skip)
+				return Ternary_False;
+
+			UInt8 identifier[sizeof(KTX2_Identifier)];
+			if (stream.Read(identifier, sizeof(identifier)) != sizeof(identifier))
+				return Ternary_False;
+
+			return (std::equal(identifier, identifier + sizeof(identifier), KTX2_Identifier)) ? Ternary_True : Ternary_False;
+		}
+
+		bool Load(Image* image, Stream& stream, const ImageParams& parameters)
+		{
+			UInt64 fileStart = stream.GetCursorPos();
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			UInt8 identifier[sizeof(KTX2_Identifier)];
+			byteStream.Read(identifier, sizeof(identifier));
+			NazaraAssert(std::equal(identifier, identifier + sizeof(identifier), KTX2_Identifier), "Invalid KTX file"); // The Check function should make sure this doesn't happen
+
+			KTX2Header header;
+			byteStream >> header;
+
+			if (header.supercompressionScheme != 0)
+			{
+				NazaraError("Supercompressed KTX files are not yet supported, sorry");
+				return false;
+			}
+
+			if (header.layerCount > 1)
+			{
+				NazaraError("Array textures are not yet supported, sorry");
+				return false;
+			}
+
+			PixelFormatType format = KTX2_GetPixelFormat(header.vkFormat);
+			if (format == PixelFormatType_Undefined)
+			{
+				NazaraError("Unhandled Vulkan format " + String::Number(header.vkFormat));
+				return false;
+			}
+
+			ImageType type;
+			if (header.faceCount == 6)
+				type = ImageType_Cubemap;
+			else if (header.faceCount != 1)
+			{
+				NazaraError("Invalid face count (" + String::Number(header.faceCount) + ')');
+				return false;
+			}
+			else if (header.pixelDepth > 0)
+				type = ImageType_3D;
+			else if (header.pixelHeight > 0)
+				type = ImageType_2D;
+			else
+				type = ImageType_1D;
+
+			unsigned int width = std::max(header.pixelWidth, 1U);
+			unsigned int height = std::max(header.pixelHeight, 1U);
+			unsigned int depth = std::max(header.pixelDepth, 1U);
+
+			// A level count of zero asks the application to generate the mipmaps, only the first level is stored then
+			unsigned int fileLevelCount = std::max(header.levelCount, 1U);
+			unsigned int levelCount = (parameters.levelCount > 0) ? std::min<unsigned int>(parameters.levelCount, fileLevelCount) : fileLevelCount;
+
+			std::vector<KTX2LevelIndex> levelIndices(fileLevelCount);
+			for (KTX2LevelIndex& levelIndex : levelIndices)
+				byteStream >> levelIndex;
+
+			if (!image->Create(type, format, width, height, depth, static_cast<UInt8>(levelCount)))
+			{
+				NazaraError("Failed to create image");
+				return false;
+			}
+
+			for (UInt8 i = 0; i < image->GetLevelCount(); ++i)
+			{
+				const KTX2LevelIndex& levelIndex = levelIndices[i];
+
+				std::size_t byteCount = image->GetMemoryUsage(i);
+				if (levelIndex.byteLength != byteCount)
+				{
+					NazaraError("Level #" + String::Number(i) + " has an invalid size (" + String::Number(levelIndex.byteLength) + " != " + String::Number(byteCount) + ')');
+					return false;
+				}
+
+				if (!stream.SetCursorPos(fileStart + levelIndex.byteOffset) || byteStream.Read(image->GetPixels(0, 0, 0, i), byteCount) != byteCount)
+				{
+					NazaraError("Failed to read level #" + String::Number(i));
+					return false;
+				}
+			}
+
+			if (parameters.loadFormat != PixelFormatType_Undefined)
+				image->Convert(parameters.loadFormat);
+
+			return true;
+		}
+
+		bool LoadMemory(Image* image, const void* data, std::size_t size, const ImageParams& parameters)
+		{
+			// Levels are copied once from the buffer (usually a file mapping) to the image pixels
+			MemoryView stream(data, size);
+			return Load(image, stream, parameters);
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterKTXLoader()
+		{
+			ImageLoader::RegisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
+		}
+
+		void UnregisterKTXLoader()
+		{
+			ImageLoader::UnregisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
+		}
+	}
+}
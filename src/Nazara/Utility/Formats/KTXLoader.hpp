@@ -0,0 +1,21 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_LOADERS_KTX_HPP
+#define NAZARA_LOADERS_KTX_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	namespace Loaders
+	{
+		void RegisterKTXLoader();
+		void UnregisterKTXLoader();
+	}
+}
+
+#endif // NAZARA_LOADERS_KTX_HPP
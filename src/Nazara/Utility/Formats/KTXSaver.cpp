@@ -0,0 +1,245 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/KTXSaver.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Utility/Formats/KTXConstants.hpp>
+#include <vector>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		struct DFDSample
+		{
+			UInt32 bitOffset;
+			UInt32 bitLength;
+			UInt32 channelType;
+		};
+
+		// Builds the basic data format descriptor (Khronos Data Format specification) of the formats we can save
+		std::vector<UInt32> BuildDataFormatDescriptor(PixelFormatType format)
+		{
+			KTX2ColorModel colorModel = KTX2ColorModel_RGBSDA;
+			std::vector<DFDSample> samples;
+
+			auto AddChannels = [&](std::initializer_list<UInt32> channels, UInt32 bitLength, UInt32 channelFlags)
+			{
+				for (UInt32 channel : channels)
+					samples.push_back({static_cast<UInt32>(samples.size()) * bitLength, bitLength, channel | channelFlags});
+			};
+
+			switch (format)
+			{
+				case PixelFormatType_BC5:
+					colorModel = KTX2ColorModel_BC5;
+					AddChannels({KTX2Channel_Red, KTX2Channel_Green}, 64, 0);
+					break;
+
+				case PixelFormatType_BC7:
+					colorModel = KTX2ColorModel_BC7;
+					AddChannels({KTX2Channel_Red}, 128, 0);
+					break;
+
+				case PixelFormatType_DXT1:
+					colorModel = KTX2ColorModel_BC1;
+					AddChannels({KTX2Channel_Red}, 64, 0);
+					break;
+
+				case PixelFormatType_DXT3:
+					colorModel = KTX2ColorModel_BC2;
+					AddChannels({KTX2Channel_Alpha, KTX2Channel_Red}, 64, 0);
+					break;
+
+				case PixelFormatType_DXT5:
+					colorModel = KTX2ColorModel_BC3;
+					AddChannels({KTX2Channel_Alpha, KTX2Channel_Red}, 64, 0);
+					break;
+
+				case PixelFormatType_ETC2:
+					colorModel = KTX2ColorModel_ETC2;
+					AddChannels({KTX2Channel_Alpha, KTX2Channel_Blue}, 64, 0); // Blue is the RGB channel of ETC2
+					break;
+
+				case PixelFormatType_BGR8:    AddChannels({KTX2Channel_Blue, KTX2Channel_Green, KTX2Channel_Red}, 8, 0);                     break;
+				case PixelFormatType_BGRA8:   AddChannels({KTX2Channel_Blue, KTX2Channel_Green, KTX2Channel_Red, KTX2Channel_Alpha}, 8, 0);  break;
+				case PixelFormatType_R8:      AddChannels({KTX2Channel_Red}, 8, 0);                                                           break;
+				case PixelFormatType_RG8:     AddChannels({KTX2Channel_Red, KTX2Channel_Green}, 8, 0);                                        break;
+				case PixelFormatType_RGB8:    AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue}, 8, 0);                     break;
+				case PixelFormatType_RGBA8:   AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue, KTX2Channel_Alpha}, 8, 0);  break;
+
+				case PixelFormatType_R16F:    AddChannels({KTX2Channel_Red}, 16, KTX2Channel_Float | KTX2Channel_Signed);                     break;
+				case PixelFormatType_RG16F:   AddChannels({KTX2Channel_Red, KTX2Channel_Green}, 16, KTX2Channel_Float | KTX2Channel_Signed);  break;
+				case PixelFormatType_RGB16F:  AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue}, 16, KTX2Channel_Float | KTX2Channel_Signed); break;
+				case PixelFormatType_RGBA16F: AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue, KTX2Channel_Alpha}, 16, KTX2Channel_Float | KTX2Channel_Signed); break;
+				case PixelFormatType_R32F:    AddChannels({KTX2Channel_Red}, 32, KTX2Channel_Float | KTX2Channel_Signed);                     break;
+				case PixelFormatType_RG32F:   AddChannels({KTX2Channel_Red, KTX2Channel_Green}, 32, KTX2Channel_Float | KTX2Channel_Signed);  break;
+				case PixelFormatType_RGB32F:  AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue}, 32, KTX2Channel_Float | KTX2Channel_Signed); break;
+				case PixelFormatType_RGBA32F: AddChannels({KTX2Channel_Red, KTX2Channel_Green, KTX2Channel_Blue, KTX2Channel_Alpha}, 32, KTX2Channel_Float | KTX2Channel_Signed); break;
+
+				default:
+					NazaraInternalError("Unhandled pixel format " + PixelFormat::GetName(format));
+					break;
+			}
+
+			bool compressed = PixelFormat::IsCompressed(format);
+			UInt32 blockSize = static_cast<UInt32>(PixelFormat::ComputeSize(format, 1, 1, 1));
+			UInt32 blockByteCount = 24 + 16 * static_cast<UInt32>(samples.size());
+
+			std::vector<UInt32> descriptor;
+			descriptor.push_back(4 + blockByteCount);            // Total size
+			descriptor.push_back(0);                             // Khronos vendor, basic descriptor type
+			descriptor.push_back(2 | (blockByteCount << 16));    // Version 1.3, block size
+			descriptor.push_back(colorModel | (1 << 8) | (1 << 16)); // BT.709 primaries, linear transfer
+			descriptor.push_back((compressed) ? 0x0303 : 0);     // Texel block dimensions, minus one
+			descriptor.push_back(blockSize);                     // Bytes of the first plane
+			descriptor.push_back(0);
+
+			for (const DFDSample& sample : samples)
+			{
+				bool floating = (sample.channelType & KTX2Channel_Float) != 0;
+
+				descriptor.push_back(sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channelType << 24));
+				descriptor.push_back(0); // Sample position
+				descriptor.push_back((floating) ? 0xBF800000 : 0); // -1.f for floats
+				descriptor.push_back((floating) ? 0x3F800000 : (compressed || sample.bitLength >= 32) ? 0xFFFFFFFF : (1U << sample.bitLength) - 1);
+			}
+
+			return descriptor;
+		}
+
+		bool FormatQuerier(const String& extension)
+		{
+			return (extension == "ktx2");
+		}
+
+		bool SaveToStream(const Image& image, const String& format, Stream& stream, const ImageParams& parameters)
+		{
+			NazaraUnused(format);
+			NazaraUnused(parameters);
+
+			if (!image.IsValid())
+			{
+				NazaraError("Invalid image");
+				return false;
+			}
+
+			ImageType type = image.GetType();
+			if (type == ImageType_1D_Array || type == ImageType_2D_Array)
+			{
+				NazaraError("Array textures are not yet supported, sorry");
+				return false;
+			}
+
+			Image tempImage(image); //< We're using COW here to prevent Image copy unless required
+
+			UInt32 vkFormat = KTX2_GetVkFormat(tempImage.GetFormat());
+			if (vkFormat == 0)
+			{
+				if (!PixelFormat::IsConversionSupported(tempImage.GetFormat(), PixelFormatType_RGBA8) || !tempImage.Convert(PixelFormatType_RGBA8))
+				{
+					NazaraError("Failed to convert image to suitable format");
+					return false;
+				}
+
+				vkFormat = KTX2_GetVkFormat(PixelFormatType_RGBA8);
+			}
+
+			PixelFormatType pixelFormat = tempImage.GetFormat();
+			std::vector<UInt32> descriptor = BuildDataFormatDescriptor(pixelFormat);
+
+			UInt32 levelCount = tempImage.GetLevelCount();
+			UInt32 dfdOffset = 80 + 24 * levelCount;
+			UInt32 dfdLength = static_cast<UInt32>(descriptor.size() * sizeof(UInt32));
+			UInt32 sampleCount = (dfdLength - 28) / 16;
+
+			// Levels are stored from the smallest to the largest, each one aligned on the texel block size and four bytes
+			UInt64 texelBlockSize = PixelFormat::ComputeSize(pixelFormat, 1, 1, 1);
+			if (texelBlockSize == 0)
+			{
+				NazaraError("Invalid pixel format " + PixelFormat::GetName(pixelFormat));
+				return false;
+			}
+
+			UInt64 alignment = texelBlockSize;
+			while (alignment % 4 != 0)
+				alignment += texelBlockSize;
+
+			std::vector<KTX2LevelIndex> levelIndices(levelCount);
+			UInt64 offset = dfdOffset + dfdLength;
+			for (UInt32 i = levelCount; i-- > 0;)
+			{
+				offset = (offset + alignment - 1) / alignment * alignment;
+
+				KTX2LevelIndex& levelIndex = levelIndices[i];
+				levelIndex.byteOffset = offset;
+				levelIndex.byteLength = tempImage.GetMemoryUsage(static_cast<UInt8>(i));
+				levelIndex.uncompressedByteLength = levelIndex.byteLength;
+
+				offset += levelIndex.byteLength;
+			}
+
+			KTX2Header header;
+			header.vkFormat = vkFormat;
+			header.typeSize = (PixelFormat::IsCompressed(pixelFormat)) ? 1 : static_cast<UInt32>(texelBlockSize / sampleCount);
+			header.pixelWidth = tempImage.GetWidth();
+			header.pixelHeight = (type == ImageType_1D) ? 0 : tempImage.GetHeight();
+			header.pixelDepth = (type == ImageType_3D) ? tempImage.GetDepth() : 0;
+			header.layerCount = 0;
+			header.faceCount = (type == ImageType_Cubemap) ? 6 : 1;
+			header.levelCount = levelCount;
+			header.supercompressionScheme = 0;
+			header.dfdByteOffset = dfdOffset;
+			header.dfdByteLength = dfdLength;
+			header.kvdByteOffset = 0;
+			header.kvdByteLength = 0;
+			header.sgdByteOffset = 0;
+			header.sgdByteLength = 0;
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			byteStream.Write(KTX2_Identifier, sizeof(KTX2_Identifier));
+			byteStream << header;
+
+			for (const KTX2LevelIndex& levelIndex : levelIndices)
+				byteStream << levelIndex;
+
+			for (UInt32 word : descriptor)
+				byteStream << word;
+
+			UInt64 position = dfdOffset + dfdLength;
+			for (UInt32 i = levelCount; i-- > 0;)
+			{
+				const KTX2LevelIndex& levelIndex = levelIndices[i];
+
+				const UInt8 padding[16] = {};
+				byteStream.Write(padding, static_cast<std::size_t>(levelIndex.byteOffset - position));
+				byteStream.Write(tempImage.GetConstPixels(0, 0, 0, static_cast<UInt8>(i)), static_cast<std::size_t>(levelIndex.byteLength));
+
+				position = levelIndex.byteOffset + levelIndex.byteLength;
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterKTXSaver()
+		{
+			ImageSaver::RegisterSaver(FormatQuerier, SaveToStream);
+		}
+
+		void UnregisterKTXSaver()
+		{
+			ImageSaver::UnregisterSaver(FormatQuerier, SaveToStream);
+		}
+	}
+}
@@ -8,6 +8,7 @@
 #include <Nazara/Core/Stream.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
 #include <Nazara/Utility/Mesh.hpp>
@@ -144,9 +145,6 @@ namespace Nz
 
 			indexMapper.Unmap();
 
-			if (parameters.optimizeIndexBuffers)
-				indexBuffer->Optimize();
-
 			/// Lecture des coordonnées de texture
 			std::vector<MD2_TexCoord> texCoords(header.num_st);
 
@@ -231,6 +229,8 @@ namespace Nz
 
 			vertexMapper.Unmap();
 
+			OptimizeMeshBuffers(indexBuffer, vertexBuffer, parameters);
+
 			subMesh->SetIndexBuffer(indexBuffer);
 			subMesh->SetMaterialIndex(0);
 
@@ -81,6 +81,12 @@ namespace Nz
 				}
 			}
 
+			if (parameters.compress && !animation->Compress())
+			{
+				NazaraError("Failed to compress animation");
+				return false;
+			}
+
 			return true;
 		}
 	}
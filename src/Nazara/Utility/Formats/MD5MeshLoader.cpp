@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Formats/MD5MeshLoader.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
@@ -111,9 +112,6 @@ namespace Nz
 
 					indexMapper.Unmap();
 
-					if (parameters.optimizeIndexBuffers)
-						indexBuffer->Optimize();
-
 					// Vertex buffer
 					struct Weight
 					{
@@ -190,6 +188,8 @@ namespace Nz
 
 					vertexMapper.Unmap();
 
+					OptimizeMeshBuffers(indexBuffer, vertexBuffer, parameters);
+
 					// Material
 					ParameterList matData;
 					matData.SetParameter(MaterialData::FilePath, baseDir + md5Mesh.shader);
@@ -279,8 +279,7 @@ namespace Nz
 					StaticMeshRef subMesh = StaticMesh::New(mesh);
 					subMesh->Create(vertexBuffer);
 
-					if (parameters.optimizeIndexBuffers)
-						indexBuffer->Optimize();
+					OptimizeMeshBuffers(indexBuffer, vertexBuffer, parameters);
 
 					subMesh->SetIndexBuffer(indexBuffer);
 					subMesh->GenerateAABB();
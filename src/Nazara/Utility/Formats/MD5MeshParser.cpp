@@ -4,6 +4,7 @@
 
 #include <Nazara/Utility/Formats/MD5MeshParser.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/StringView.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/Config.hpp>
@@ -81,12 +82,12 @@ namespace Nz
 			{
 				#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
 				case 'M': // MD5Version
-					if (m_currentLine.GetWord(0) != "MD5Version")
+					if (StringView(m_currentLine).GetWord(0) != "MD5Version")
 						UnrecognizedLine();
 					break;
 
 				case 'c': // commandline
-					if (m_currentLine.GetWord(0) != "commandline")
+					if (StringView(m_currentLine).GetWord(0) != "commandline")
 						UnrecognizedLine();
 					break;
 				#endif
@@ -192,7 +193,9 @@ namespace Nz
 				m_lineCount++;
 
 				m_currentLine = m_stream.ReadLine();
-				m_currentLine = m_currentLine.SubStringTo("//"); // On ignore les commentaires
+				std::size_t commentPos = m_currentLine.Find("//"); // On ignore les commentaires
+				if (commentPos != String::npos)
+					m_currentLine.Resize(commentPos);
 				m_currentLine.Simplify(); // Pour un traitement plus simple
 				m_currentLine.Trim();
 			}
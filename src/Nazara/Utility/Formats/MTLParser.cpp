@@ -6,6 +6,7 @@
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/StringView.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <cstdio>
 #include <memory>
@@ -37,8 +38,8 @@ namespace Nz
 
 		while (Advance(false))
 		{
-			String keyword = m_currentLine.GetWord(0).ToLower();
-			if (keyword == "ka")
+			StringView keyword = StringView(m_currentLine).GetWord(0);
+			if (keyword.Equals("ka", String::CaseInsensitive))
 			{
 				float r, g, b;
 				if (std::sscanf(&m_currentLine[3], "%f %f %f", &r, &g, &b) == 3)
@@ -53,7 +54,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "kd")
+			else if (keyword.Equals("kd", String::CaseInsensitive))
 			{
 				float r, g, b;
 				if (std::sscanf(&m_currentLine[3], "%f %f %f", &r, &g, &b) == 3)
@@ -68,7 +69,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "ks")
+			else if (keyword.Equals("ks", String::CaseInsensitive))
 			{
 				float r, g, b;
 				if (std::sscanf(&m_currentLine[3], "%f %f %f", &r, &g, &b) == 3)
@@ -83,7 +84,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "ni")
+			else if (keyword.Equals("ni", String::CaseInsensitive))
 			{
 				float density;
 				if (std::sscanf(&m_currentLine[3], "%f", &density) == 1)
@@ -98,7 +99,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "ns")
+			else if (keyword.Equals("ns", String::CaseInsensitive))
 			{
 				float coef;
 				if (std::sscanf(&m_currentLine[3], "%f", &coef) == 1)
@@ -113,10 +114,10 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == 'd')
+			else if (keyword.Equals("d", String::CaseInsensitive))
 			{
 				float alpha;
-				if (std::sscanf(&m_currentLine[(keyword[0] == 'd') ? 2 : 3], "%f", &alpha) == 1)
+				if (std::sscanf(&m_currentLine[keyword.GetSize() + 1], "%f", &alpha) == 1)
 				{
 					if (!currentMaterial)
 						currentMaterial = AddMaterial("default");
@@ -128,10 +129,10 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "tr")
+			else if (keyword.Equals("tr", String::CaseInsensitive))
 			{
 				float alpha;
-				if (std::sscanf(&m_currentLine[(keyword[0] == 'd') ? 2 : 3], "%f", &alpha) == 1)
+				if (std::sscanf(&m_currentLine[keyword.GetSize() + 1], "%f", &alpha) == 1)
 				{
 					if (!currentMaterial)
 						currentMaterial = AddMaterial("default");
@@ -143,7 +144,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "illum")
+			else if (keyword.Equals("illum", String::CaseInsensitive))
 			{
 				unsigned int model;
 				if (std::sscanf(&m_currentLine[6], "%u", &model) == 1)
@@ -158,7 +159,7 @@ namespace Nz
 					UnrecognizedLine();
 				#endif
 			}
-			else if (keyword == "map_ka")
+			else if (keyword.Equals("map_ka", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -170,7 +171,7 @@ namespace Nz
 					currentMaterial->ambientMap = map;
 				}
 			}
-			else if (keyword == "map_kd")
+			else if (keyword.Equals("map_kd", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -182,7 +183,7 @@ namespace Nz
 					currentMaterial->diffuseMap = map;
 				}
 			}
-			else if (keyword == "map_ks")
+			else if (keyword.Equals("map_ks", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -194,7 +195,7 @@ namespace Nz
 					currentMaterial->specularMap = map;
 				}
 			}
-			else if (keyword == "map_bump" || keyword == "bump")
+			else if (keyword.Equals("map_bump", String::CaseInsensitive) || keyword.Equals("bump", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -206,7 +207,7 @@ namespace Nz
 					currentMaterial->bumpMap = map;
 				}
 			}
-			else if (keyword == "map_d")
+			else if (keyword.Equals("map_d", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -218,7 +219,7 @@ namespace Nz
 					currentMaterial->alphaMap = map;
 				}
 			}
-			else if (keyword == "map_decal" || keyword == "decal")
+			else if (keyword.Equals("map_decal", String::CaseInsensitive) || keyword.Equals("decal", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -230,7 +231,7 @@ namespace Nz
 					currentMaterial->decalMap = map;
 				}
 			}
-			else if (keyword == "map_disp" || keyword == "disp")
+			else if (keyword.Equals("map_disp", String::CaseInsensitive) || keyword.Equals("disp", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -242,7 +243,7 @@ namespace Nz
 					currentMaterial->displacementMap = map;
 				}
 			}
-			else if (keyword == "map_refl" || keyword == "refl")
+			else if (keyword.Equals("map_refl", String::CaseInsensitive) || keyword.Equals("refl", String::CaseInsensitive))
 			{
 				unsigned int mapPos = m_currentLine.GetWordPosition(1);
 				if (mapPos != String::npos)
@@ -254,7 +255,7 @@ namespace Nz
 					currentMaterial->reflectionMap = map;
 				}
 			}
-			else if (keyword == "newmtl")
+			else if (keyword.Equals("newmtl", String::CaseInsensitive))
 			{
 				String materialName = m_currentLine.SubString(m_currentLine.GetWordPosition(1));
 				if (!materialName.IsEmpty())
@@ -427,7 +428,9 @@ namespace Nz
 				m_lineCount++;
 
 				m_currentLine = m_currentStream->ReadLine();
-				m_currentLine = m_currentLine.SubStringTo("#"); // On ignore les commentaires
+				std::size_t commentPos = m_currentLine.Find('#'); // On ignore les commentaires
+				if (commentPos != String::npos)
+					m_currentLine.Resize(commentPos);
 				m_currentLine.Simplify(); // Pour un traitement plus simple
 			}
 			while (m_currentLine.IsEmpty());
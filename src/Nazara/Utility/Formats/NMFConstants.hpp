@@ -0,0 +1,19 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FORMATS_NMFCONSTANTS_HPP
+#define NAZARA_FORMATS_NMFCONSTANTS_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	// Nazara Mesh Format: a little-endian dump of meshes as they are once loaded, vertex and index data being stored as their buffers hold them
+	constexpr UInt32 NMF_Magic = 0x464D5A4E; // "NZMF"
+	constexpr UInt32 NMF_Version = 1;
+}
+
+#endif // NAZARA_FORMATS_NMFCONSTANTS_HPP
@@ -0,0 +1,399 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NMFLoader.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NMFConstants.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "nmf");
+		}
+
+		Ternary Check(Stream& stream, const MeshParams& parameters)
+		{
+			bool skip;
+			if (parameters.custom.GetBooleanParameter("SkipNativeNMFLoader", &skip) && skip)
+				return Ternary_False;
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			UInt32 magic;
+			byteStream >> magic;
+
+			return (magic == NMF_Magic) ? Ternary_True : Ternary_False;
+		}
+
+		bool ReadData(Stream& stream, void* buffer, std::size_t size)
+		{
+			// Checked before reading so a corrupted count doesn't make us allocate a huge buffer for nothing
+			if (stream.GetSize() - stream.GetCursorPos() < size)
+				return false;
+
+			return stream.Read(buffer, size) == size;
+		}
+
+		bool LoadMaterial(ByteStream& byteStream, ParameterList* matData)
+		{
+			UInt32 parameterCount;
+			byteStream >> parameterCount;
+
+			for (UInt32 i = 0; i < parameterCount; ++i)
+			{
+				String name;
+				UInt8 type;
+				byteStream >> name >> type;
+
+				switch (type)
+				{
+					case ParameterType_Boolean:
+					{
+						UInt8 value;
+						byteStream >> value;
+						matData->SetParameter(name, value != 0);
+						break;
+					}
+
+					case ParameterType_Color:
+					{
+						Color value;
+						byteStream >> value;
+						matData->SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType_Float:
+					{
+						float value;
+						byteStream >> value;
+						matData->SetParameter(name, value);
+						break;
+					}
+
+					case ParameterType_Integer:
+					{
+						Int32 value;
+						byteStream >> value;
+						matData->SetParameter(name, static_cast<int>(value));
+						break;
+					}
+
+					case ParameterType_None:
+						matData->SetParameter(name);
+						break;
+
+					case ParameterType_String:
+					{
+						String value;
+						byteStream >> value;
+						matData->SetParameter(name, value);
+						break;
+					}
+
+					default:
+						NazaraError("Invalid parameter type (" + String::Number(type) + ')');
+						return false;
+				}
+			}
+
+			return true;
+		}
+
+		VertexDeclarationConstRef LoadVertexDeclaration(ByteStream& byteStream)
+		{
+			VertexDeclarationRef declaration = VertexDeclaration::New();
+
+			UInt32 stride;
+			byteStream >> stride;
+			declaration->SetStride(stride);
+
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				UInt8 enabled;
+				byteStream >> enabled;
+				if (enabled)
+				{
+					UInt8 type;
+					UInt32 offset;
+					byteStream >> type >> offset;
+
+					if (type > ComponentType_Max || offset >= stride)
+					{
+						NazaraError("Invalid vertex component");
+						return nullptr;
+					}
+
+					declaration->EnableComponent(static_cast<VertexComponent>(i), static_cast<ComponentType>(type), offset);
+				}
+			}
+
+			// Prefer the engine declarations, so meshes from different sources share the same one
+			for (unsigned int layout = 0; layout <= VertexLayout_Max; ++layout)
+			{
+				const VertexDeclaration* engineDeclaration = VertexDeclaration::Get(static_cast<VertexLayout>(layout));
+				if (engineDeclaration->GetStride() != stride)
+					continue;
+
+				bool matching = true;
+				for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+				{
+					bool enabledA, enabledB;
+					ComponentType typeA, typeB;
+					std::size_t offsetA, offsetB;
+					declaration->GetComponent(static_cast<VertexComponent>(i), &enabledA, &typeA, &offsetA);
+					engineDeclaration->GetComponent(static_cast<VertexComponent>(i), &enabledB, &typeB, &offsetB);
+
+					if (enabledA != enabledB || (enabledA && (typeA != typeB || offsetA != offsetB)))
+					{
+						matching = false;
+						break;
+					}
+				}
+
+				if (matching)
+					return engineDeclaration;
+			}
+
+			return declaration;
+		}
+
+		bool LoadSubMesh(Mesh* mesh, Stream& stream, ByteStream& byteStream, const MeshParams& parameters)
+		{
+			UInt32 materialIndex;
+			UInt8 primitiveMode;
+			Boxf aabb;
+			byteStream >> materialIndex >> primitiveMode >> aabb;
+
+			if (primitiveMode > PrimitiveMode_Max)
+			{
+				NazaraError("Invalid primitive mode (" + String::Number(primitiveMode) + ')');
+				return false;
+			}
+
+			VertexDeclarationConstRef declaration = LoadVertexDeclaration(byteStream);
+			if (!declaration)
+				return false;
+
+			UInt32 vertexCount;
+			byteStream >> vertexCount;
+
+			VertexBufferRef vertexBuffer = VertexBuffer::New(declaration, vertexCount, parameters.storage, BufferUsage_Static);
+			if (vertexCount > 0)
+			{
+				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_DiscardAndWrite);
+				if (!ReadData(stream, vertexMapper.GetPointer(), vertexCount * declaration->GetStride()))
+				{
+					NazaraError("Failed to read vertices");
+					return false;
+				}
+			}
+
+			UInt8 largeIndices;
+			UInt32 indexCount;
+			byteStream >> largeIndices >> indexCount;
+
+			IndexBufferRef indexBuffer;
+			if (indexCount > 0)
+			{
+				indexBuffer = IndexBuffer::New(largeIndices != 0, indexCount, parameters.storage, BufferUsage_Static);
+
+				BufferMapper<IndexBuffer> indexMapper(indexBuffer, BufferAccess_DiscardAndWrite);
+				if (!ReadData(stream, indexMapper.GetPointer(), indexCount * indexBuffer->GetStride()))
+				{
+					NazaraError("Failed to read indices");
+					return false;
+				}
+			}
+
+			SubMeshRef subMesh;
+			if (mesh->GetAnimationType() == AnimationType_Skeletal)
+			{
+				SkeletalMeshRef skeletalMesh = SkeletalMesh::New(mesh);
+				if (!skeletalMesh->Create(vertexBuffer))
+				{
+					NazaraError("Failed to create submesh");
+					return false;
+				}
+
+				skeletalMesh->SetAABB(aabb);
+				skeletalMesh->SetIndexBuffer(indexBuffer);
+				subMesh = skeletalMesh;
+			}
+			else
+			{
+				StaticMeshRef staticMesh = StaticMesh::New(mesh);
+				if (!staticMesh->Create(vertexBuffer))
+				{
+					NazaraError("Failed to create submesh");
+					return false;
+				}
+
+				staticMesh->SetAABB(aabb);
+				staticMesh->SetIndexBuffer(indexBuffer);
+				subMesh = staticMesh;
+			}
+
+			subMesh->SetMaterialIndex(materialIndex);
+			subMesh->SetPrimitiveMode(static_cast<PrimitiveMode>(primitiveMode));
+
+			mesh->AddSubMesh(subMesh);
+
+			return true;
+		}
+
+		bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
+		{
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			UInt32 magic;
+			UInt32 version;
+			byteStream >> magic >> version;
+			NazaraAssert(magic == NMF_Magic, "Invalid NMF file"); // The Check function should make sure this doesn't happen
+
+			if (version != NMF_Version)
+			{
+				NazaraError("Unsupported NMF version (" + String::Number(version) + ')');
+				return false;
+			}
+
+			UInt8 animationType;
+			String animationPath;
+			UInt32 materialCount;
+			byteStream >> animationType >> animationPath >> materialCount;
+
+			std::vector<ParameterList> materials(materialCount);
+			for (UInt32 i = 0; i < materialCount; ++i)
+			{
+				if (!LoadMaterial(byteStream, &materials[i]))
+				{
+					NazaraError("Failed to load material #" + String::Number(i));
+					return false;
+				}
+			}
+
+			if (animationType == AnimationType_Skeletal)
+			{
+				UInt32 jointCount;
+				byteStream >> jointCount;
+
+				if (!mesh->CreateSkeletal(jointCount))
+				{
+					NazaraError("Failed to create mesh");
+					return false;
+				}
+
+				Skeleton* skeleton = mesh->GetSkeleton();
+				for (UInt32 i = 0; i < jointCount; ++i)
+				{
+					String name;
+					Int32 parent;
+					Matrix4f inverseBindMatrix;
+					Vector3f position;
+					Quaternionf rotation;
+					Vector3f scale;
+					byteStream >> name >> parent >> inverseBindMatrix >> position >> rotation >> scale;
+
+					Joint* joint = skeleton->GetJoint(i);
+					if (parent >= 0)
+					{
+						if (static_cast<UInt32>(parent) >= jointCount)
+						{
+							NazaraError("Joint #" + String::Number(i) + " has an invalid parent");
+							return false;
+						}
+
+						joint->SetParent(skeleton->GetJoint(parent));
+					}
+
+					joint->SetName(name);
+					joint->SetInverseBindMatrix(inverseBindMatrix);
+					joint->SetPosition(position);
+					joint->SetRotation(rotation);
+					joint->SetScale(scale);
+				}
+			}
+			else if (animationType == AnimationType_Static)
+			{
+				if (!mesh->CreateStatic())
+				{
+					NazaraInternalError("Failed to create mesh");
+					return false;
+				}
+			}
+			else
+			{
+				NazaraError("Invalid animation type (" + String::Number(animationType) + ')');
+				return false;
+			}
+
+			mesh->SetAnimation(animationPath);
+
+			if (materialCount > 0)
+			{
+				mesh->SetMaterialCount(materialCount);
+				for (UInt32 i = 0; i < materialCount; ++i)
+					mesh->SetMaterialData(i, std::move(materials[i]));
+			}
+
+			UInt32 subMeshCount;
+			byteStream >> subMeshCount;
+			for (UInt32 i = 0; i < subMeshCount; ++i)
+			{
+				if (!LoadSubMesh(mesh, stream, byteStream, parameters))
+				{
+					NazaraError("Failed to load submesh #" + String::Number(i));
+					return false;
+				}
+			}
+
+			// Data is stored already processed, only a transformation asked by the application is applied
+			if (animationType == AnimationType_Static)
+			{
+				if (!parameters.matrix.IsIdentity())
+					mesh->Transform(parameters.matrix);
+
+				if (parameters.center)
+					mesh->Recenter();
+			}
+
+			return true;
+		}
+
+		bool LoadMemory(Mesh* mesh, const void* data, std::size_t size, const MeshParams& parameters)
+		{
+			// Vertices and indices are copied once from the buffer (usually a file mapping) to the mesh buffers
+			MemoryView stream(data, size);
+			return Load(mesh, stream, parameters);
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterNMFLoader()
+		{
+			MeshLoader::RegisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
+		}
+
+		void UnregisterNMFLoader()
+		{
+			MeshLoader::UnregisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
+		}
+	}
+}
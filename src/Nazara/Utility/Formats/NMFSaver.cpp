@@ -0,0 +1,223 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Formats/NMFSaver.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/Stream.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/Formats/NMFConstants.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		bool IsSupported(const String& extension)
+		{
+			return (extension == "nmf");
+		}
+
+		void SaveMaterial(ByteStream& byteStream, const ParameterList& matData)
+		{
+			// Pointers and userdata have no meaning outside of the process, they are not saved
+			std::vector<String> names;
+			matData.ForEach([&](const ParameterList& list, const String& name)
+			{
+				ParameterType type;
+				list.GetParameterType(name, &type);
+				if (type != ParameterType_Pointer && type != ParameterType_Userdata)
+					names.push_back(name);
+			});
+
+			byteStream << static_cast<UInt32>(names.size());
+			for (const String& name : names)
+			{
+				ParameterType type;
+				matData.GetParameterType(name, &type);
+
+				byteStream << name << static_cast<UInt8>(type);
+				switch (type)
+				{
+					case ParameterType_Boolean:
+					{
+						bool value;
+						matData.GetBooleanParameter(name, &value);
+						byteStream << static_cast<UInt8>(value);
+						break;
+					}
+
+					case ParameterType_Color:
+					{
+						Color value;
+						matData.GetColorParameter(name, &value);
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_Float:
+					{
+						float value;
+						matData.GetFloatParameter(name, &value);
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_Integer:
+					{
+						int value;
+						matData.GetIntegerParameter(name, &value);
+						byteStream << static_cast<Int32>(value);
+						break;
+					}
+
+					case ParameterType_String:
+					{
+						String value;
+						matData.GetStringParameter(name, &value);
+						byteStream << value;
+						break;
+					}
+
+					case ParameterType_None:
+					case ParameterType_Pointer:
+					case ParameterType_Userdata:
+						break;
+				}
+			}
+		}
+
+		bool SaveSubMesh(ByteStream& byteStream, const SubMesh* subMesh)
+		{
+			const VertexBuffer* vertexBuffer = (subMesh->GetAnimationType() == AnimationType_Static) ? static_cast<const StaticMesh*>(subMesh)->GetVertexBuffer() : static_cast<const SkeletalMesh*>(subMesh)->GetVertexBuffer();
+			const VertexDeclaration* declaration = vertexBuffer->GetVertexDeclaration();
+
+			byteStream << static_cast<UInt32>(subMesh->GetMaterialIndex());
+			byteStream << static_cast<UInt8>(subMesh->GetPrimitiveMode());
+			byteStream << subMesh->GetAABB();
+
+			// Vertex declaration
+			byteStream << static_cast<UInt32>(declaration->GetStride());
+			for (unsigned int i = 0; i <= VertexComponent_Max; ++i)
+			{
+				bool enabled;
+				ComponentType type;
+				std::size_t offset;
+				declaration->GetComponent(static_cast<VertexComponent>(i), &enabled, &type, &offset);
+
+				byteStream << static_cast<UInt8>(enabled);
+				if (enabled)
+					byteStream << static_cast<UInt8>(type) << static_cast<UInt32>(offset);
+			}
+
+			// Vertices and indices are written as the buffers hold them, the loader only has to copy them back
+			UInt32 vertexCount = vertexBuffer->GetVertexCount();
+			byteStream << vertexCount;
+			if (vertexCount > 0)
+			{
+				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_ReadOnly);
+				byteStream.Write(vertexMapper.GetPointer(), vertexCount * vertexBuffer->GetStride());
+			}
+
+			const IndexBuffer* indexBuffer = subMesh->GetIndexBuffer();
+			if (indexBuffer)
+			{
+				UInt32 indexCount = indexBuffer->GetIndexCount();
+				byteStream << static_cast<UInt8>(indexBuffer->HasLargeIndices()) << indexCount;
+				if (indexCount > 0)
+				{
+					BufferMapper<IndexBuffer> indexMapper(indexBuffer, BufferAccess_ReadOnly);
+					byteStream.Write(indexMapper.GetPointer(), indexCount * indexBuffer->GetStride());
+				}
+			}
+			else
+				byteStream << UInt8(0) << UInt32(0);
+
+			return true;
+		}
+
+		bool SaveToStream(const Mesh& mesh, const String& format, Stream& stream, const MeshParams& parameters)
+		{
+			NazaraUnused(format);
+			NazaraUnused(parameters);
+
+			if (!mesh.IsValid())
+			{
+				NazaraError("Invalid mesh");
+				return false;
+			}
+
+			ByteStream byteStream(&stream);
+			byteStream.SetDataEndianness(Endianness_LittleEndian);
+
+			byteStream << NMF_Magic << NMF_Version;
+			byteStream << static_cast<UInt8>(mesh.GetAnimationType()) << mesh.GetAnimation();
+
+			// Materials
+			UInt32 materialCount = mesh.GetMaterialCount();
+			byteStream << materialCount;
+			for (UInt32 i = 0; i < materialCount; ++i)
+				SaveMaterial(byteStream, mesh.GetMaterialData(i));
+
+			// Skeleton
+			if (mesh.GetAnimationType() == AnimationType_Skeletal)
+			{
+				const Skeleton* skeleton = mesh.GetSkeleton();
+				const Joint* joints = skeleton->GetJoints();
+
+				UInt32 jointCount = skeleton->GetJointCount();
+				byteStream << jointCount;
+				for (UInt32 i = 0; i < jointCount; ++i)
+				{
+					const Joint& joint = joints[i];
+
+					Int32 parent = -1;
+					for (UInt32 j = 0; j < jointCount; ++j)
+					{
+						if (joint.GetParent() == &joints[j])
+						{
+							parent = static_cast<Int32>(j);
+							break;
+						}
+					}
+
+					byteStream << joint.GetName() << parent << joint.GetInverseBindMatrix();
+					byteStream << joint.GetPosition(CoordSys_Local) << joint.GetRotation(CoordSys_Local) << joint.GetScale(CoordSys_Local);
+				}
+			}
+
+			// Submeshes
+			UInt32 subMeshCount = mesh.GetSubMeshCount();
+			byteStream << subMeshCount;
+			for (UInt32 i = 0; i < subMeshCount; ++i)
+			{
+				if (!SaveSubMesh(byteStream, mesh.GetSubMesh(i)))
+				{
+					NazaraError("Failed to save submesh #" + String::Number(i));
+					return false;
+				}
+			}
+
+			return true;
+		}
+	}
+
+	namespace Loaders
+	{
+		void RegisterNMFSaver()
+		{
+			MeshSaver::RegisterSaver(IsSupported, SaveToStream);
+		}
+
+		void UnregisterNMFSaver()
+		{
+			MeshSaver::UnregisterSaver(IsSupported, SaveToStream);
+		}
+	}
+}
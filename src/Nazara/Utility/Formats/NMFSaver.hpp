@@ -0,0 +1,21 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FORMATS_NMFSAVER_HPP
+#define NAZARA_FORMATS_NMFSAVER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+
+namespace Nz
+{
+	namespace Loaders
+	{
+		void RegisterNMFSaver();
+		void UnregisterNMFSaver();
+	}
+}
+
+#endif // NAZARA_FORMATS_NMFSAVER_HPP
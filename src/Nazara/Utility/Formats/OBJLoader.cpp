@@ -5,6 +5,8 @@
 #include <Nazara/Utility/Formats/OBJLoader.hpp>
 #include <Nazara/Core/Algorithm.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
@@ -13,6 +15,7 @@
 #include <Nazara/Utility/Formats/MTLParser.hpp>
 #include <Nazara/Utility/Formats/OBJParser.hpp>
 #include <cstdio>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <unordered_map>
@@ -135,19 +138,89 @@ namespace Nz
 			return true;
 		}
 
-		bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
+		struct PackedVertexHasher
 		{
-			int reservedVertexCount;
-			if (!parameters.custom.GetIntegerParameter("NativeOBJLoader_VertexCount", &reservedVertexCount))
-				reservedVertexCount = 100;
+			std::size_t operator()(UInt64 key) const
+			{
+				// Bits of the packed indices are spread over the whole hash
+				key ^= key >> 33;
+				key *= 0xFF51AFD7ED558CCDULL;
+				key ^= key >> 33;
 
-			OBJParser parser;
-			if (!parser.Parse(stream, reservedVertexCount))
+				return static_cast<std::size_t>(key);
+			}
+		};
+
+		struct FaceVertexHasher
+		{
+			std::size_t operator()(const OBJParser::FaceVertex& o) const
 			{
-				NazaraError("OBJ parser failed");
-				return false;
+				std::size_t seed = 0;
+				HashCombine(seed, o.normal);
+				HashCombine(seed, o.position);
+				HashCombine(seed, o.texCoord);
+
+				return seed;
+			}
+		};
+
+		struct FaceVertexComparator
+		{
+			bool operator()(const OBJParser::FaceVertex& lhs, const OBJParser::FaceVertex& rhs) const
+			{
+				return lhs.normal   == rhs.normal   &&
+				       lhs.position == rhs.position &&
+				       lhs.texCoord == rhs.texCoord;
+			}
+		};
+
+		unsigned int GetBitCount(std::size_t value)
+		{
+			unsigned int bitCount = 0;
+			while (value > 0)
+			{
+				bitCount++;
+				value >>= 1;
+			}
+
+			return bitCount;
+		}
+
+		// Merges identical face vertices, filling the (triangulated) indices and the unique vertices in their first use order
+		template<typename Key, typename Hasher, typename Comparator, typename KeyBuilder>
+		void BuildIndices(const OBJParser::Mesh& mesh, KeyBuilder&& buildKey, std::vector<unsigned int>* indices, std::vector<OBJParser::FaceVertex>* uniqueVertices)
+		{
+			std::unordered_map<Key, unsigned int, Hasher, Comparator> vertices;
+			vertices.reserve(mesh.vertices.size());
+
+			std::vector<unsigned int> faceIndices(3); // Comme il y aura au moins trois sommets
+			for (const OBJParser::Face& face : mesh.faces)
+			{
+				faceIndices.resize(face.vertexCount);
+
+				for (std::size_t k = 0; k < face.vertexCount; ++k)
+				{
+					const OBJParser::FaceVertex& vertex = mesh.vertices[face.firstVertex + k];
+
+					auto pair = vertices.emplace(buildKey(vertex), static_cast<unsigned int>(uniqueVertices->size()));
+					if (pair.second)
+						uniqueVertices->push_back(vertex);
+
+					faceIndices[k] = pair.first->second;
+				}
+
+				// Triangulation
+				for (std::size_t k = 1; k < face.vertexCount - 1; ++k)
+				{
+					indices->push_back(faceIndices[0]);
+					indices->push_back(faceIndices[k]);
+					indices->push_back(faceIndices[k + 1]);
+				}
 			}
+		}
 
+		bool BuildMesh(Mesh* mesh, const OBJParser& parser, const String& directory, const MeshParams& parameters)
+		{
 			mesh->CreateStatic();
 
 			const String* materials = parser.GetMaterials();
@@ -162,74 +235,40 @@ namespace Nz
 			             texCoords != nullptr && meshes != nullptr && meshCount > 0,
 			             "Invalid OBJParser output");
 
-			// Un conteneur temporaire pour contenir les indices de face avant triangulation
-			std::vector<unsigned int> faceIndices(3); // Comme il y aura au moins trois sommets
+			// Face vertices are packed in a 64 bits key when their indices fit in it, which hashes and compares much faster
+			unsigned int normalBits = GetBitCount(parser.GetNormalCount());
+			unsigned int positionBits = GetBitCount(parser.GetPositionCount());
+			unsigned int texCoordBits = GetBitCount(parser.GetTexCoordCount());
+			bool packedKeys = (normalBits + positionBits + texCoordBits <= 64);
+
 			for (unsigned int i = 0; i < meshCount; ++i)
 			{
-				unsigned int faceCount = meshes[i].faces.size();
-				if (faceCount == 0)
+				if (meshes[i].faces.empty())
 					continue;
 
 				std::vector<unsigned int> indices;
-				indices.reserve(faceCount*3); // Pire cas si les faces sont des triangles
-
-				// Afin d'utiliser OBJParser::FaceVertex comme clé dans un unordered_map,
-				// nous devons fournir un foncteur de hash ainsi qu'un foncteur de comparaison
-
-				// Hash
-				struct FaceVertexHasher
-				{
-					std::size_t operator()(const OBJParser::FaceVertex& o) const
-					{
-						std::size_t seed = 0;
-						HashCombine(seed, o.normal);
-						HashCombine(seed, o.position);
-						HashCombine(seed, o.texCoord);
-
-						return seed;
-					}
-				};
-
-				// Comparaison
-				struct FaceVertexComparator
-				{
-					bool operator()(const OBJParser::FaceVertex& lhs, const OBJParser::FaceVertex& rhs) const
-					{
-						return lhs.normal   == rhs.normal   &&
-						       lhs.position == rhs.position &&
-						       lhs.texCoord == rhs.texCoord;
-					}
-				};
+				indices.reserve(meshes[i].faces.size()*3); // Pire cas si les faces sont des triangles
 
-				std::unordered_map<OBJParser::FaceVertex, unsigned int, FaceVertexHasher, FaceVertexComparator> vertices;
+				std::vector<OBJParser::FaceVertex> vertices;
 				vertices.reserve(meshes[i].vertices.size());
 
-				unsigned int vertexCount = 0;
-				for (unsigned int j = 0; j < faceCount; ++j)
+				if (packedKeys)
 				{
-					unsigned int faceVertexCount = meshes[i].faces[j].vertexCount;
-					faceIndices.resize(faceVertexCount);
-
-					for (unsigned int k = 0; k < faceVertexCount; ++k)
+					BuildIndices<UInt64, PackedVertexHasher, std::equal_to<UInt64>>(meshes[i], [=] (const OBJParser::FaceVertex& vertex)
 					{
-						const OBJParser::FaceVertex& vertex = meshes[i].vertices[meshes[i].faces[j].firstVertex + k];
-
-						auto it = vertices.find(vertex);
-						if (it == vertices.end())
-							it = vertices.emplace(vertex, vertexCount++).first;
-
-						faceIndices[k] = it->second;
-					}
-
-					// Triangulation
-					for (unsigned int k = 1; k < faceVertexCount-1; ++k)
+						return (static_cast<UInt64>(vertex.position) << (normalBits + texCoordBits)) | (static_cast<UInt64>(vertex.texCoord) << normalBits) | vertex.normal;
+					}, &indices, &vertices);
+				}
+				else
+				{
+					BuildIndices<OBJParser::FaceVertex, FaceVertexHasher, FaceVertexComparator>(meshes[i], [] (const OBJParser::FaceVertex& vertex)
 					{
-						indices.push_back(faceIndices[0]);
-						indices.push_back(faceIndices[k]);
-						indices.push_back(faceIndices[k+1]);
-					}
+						return vertex;
+					}, &indices, &vertices);
 				}
 
+				unsigned int vertexCount = static_cast<unsigned int>(vertices.size());
+
 				// Création des buffers
 				IndexBufferRef indexBuffer = IndexBuffer::New(vertexCount > std::numeric_limits<UInt16>::max(), indices.size(), parameters.storage, BufferUsage_Static);
 				VertexBufferRef vertexBuffer = VertexBuffer::New(VertexDeclaration::Get(VertexLayout_XYZ_Normal_UV_Tangent), vertexCount, parameters.storage, BufferUsage_Static);
@@ -246,12 +285,10 @@ namespace Nz
 				bool hasTexCoords = true;
 				BufferMapper<VertexBuffer> vertexMapper(vertexBuffer, BufferAccess_WriteOnly);
 				MeshVertex* meshVertices = static_cast<MeshVertex*>(vertexMapper.GetPointer());
-				for (auto& vertexPair : vertices)
+				for (unsigned int j = 0; j < vertexCount; ++j)
 				{
-					const OBJParser::FaceVertex& vertexIndices = vertexPair.first;
-					unsigned int index = vertexPair.second;
-
-					MeshVertex& vertex = meshVertices[index];
+					const OBJParser::FaceVertex& vertexIndices = vertices[j];
+					MeshVertex& vertex = meshVertices[j];
 
 					const Vector4f& vec = positions[vertexIndices.position-1];
 					vertex.position = Vector3f(parameters.matrix * vec);
@@ -279,8 +316,7 @@ namespace Nz
 					continue;
 				}
 
-				if (parameters.optimizeIndexBuffers)
-					indexBuffer->Optimize();
+				OptimizeMeshBuffers(indexBuffer, vertexBuffer, parameters);
 
 				subMesh->GenerateAABB();
 				subMesh->SetIndexBuffer(indexBuffer);
@@ -307,23 +343,73 @@ namespace Nz
 			if (!mtlLib.IsEmpty())
 			{
 				ErrorFlags flags(ErrorFlag_ThrowExceptionDisabled);
-				ParseMTL(mesh, stream.GetDirectory() + mtlLib, materials, meshes, meshCount);
+				ParseMTL(mesh, directory + mtlLib, materials, meshes, meshCount);
 			}
 
 			return true;
 		}
+
+		int GetReservedVertexCount(const MeshParams& parameters)
+		{
+			int reservedVertexCount;
+			if (!parameters.custom.GetIntegerParameter("NativeOBJLoader_VertexCount", &reservedVertexCount))
+				reservedVertexCount = 100;
+
+			return reservedVertexCount;
+		}
+
+		bool Load(Mesh* mesh, Stream& stream, const MeshParams& parameters)
+		{
+			OBJParser parser;
+			if (!parser.Parse(stream, GetReservedVertexCount(parameters)))
+			{
+				NazaraError("OBJ parser failed");
+				return false;
+			}
+
+			return BuildMesh(mesh, parser, stream.GetDirectory(), parameters);
+		}
+
+		bool LoadFile(Mesh* mesh, const String& filePath, const MeshParams& parameters)
+		{
+			File file(filePath);
+			if (!file.Open(OpenMode_ReadOnly))
+			{
+				NazaraError("Failed to open file \"" + filePath + '"');
+				return false;
+			}
+
+			// The parser reads the mapped pages directly, the directory is still needed for the MTL file
+			const void* data;
+			{
+				ErrorFlags flags(ErrorFlag_Silent);
+				data = file.Map();
+			}
+
+			if (!data)
+				return Load(mesh, file, parameters);
+
+			OBJParser parser;
+			if (!parser.Parse(data, static_cast<std::size_t>(file.GetSize()), GetReservedVertexCount(parameters)))
+			{
+				NazaraError("OBJ parser failed");
+				return false;
+			}
+
+			return BuildMesh(mesh, parser, file.GetDirectory(), parameters);
+		}
 	}
 
 	namespace Loaders
 	{
 		void RegisterOBJLoader()
 		{
-			MeshLoader::RegisterLoader(IsSupported, Check, Load);
+			MeshLoader::RegisterLoader(IsSupported, Check, Load, LoadFile);
 		}
 
 		void UnregisterOBJLoader()
 		{
-			MeshLoader::UnregisterLoader(IsSupported, Check, Load);
+			MeshLoader::UnregisterLoader(IsSupported, Check, Load, LoadFile);
 		}
 	}
 }
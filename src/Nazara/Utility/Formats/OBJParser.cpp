@@ -5,328 +5,638 @@
 #include <Nazara/Utility/Formats/OBJParser.hpp>
 #include <Nazara/Core/CallOnExit.hpp>
 #include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstring>
 #include <memory>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
-	bool OBJParser::Parse(Nz::Stream& stream, std::size_t reservedVertexCount)
+	namespace
 	{
-		m_currentStream = &stream;
+		// Small enough to spread a file over the workers, big enough for the per-chunk overhead to vanish
+		constexpr std::size_t ChunkSize = 256 * 1024;
 
-		// Force stream in text mode, reset it at the end
-		Nz::CallOnExit resetTextMode;
-		if ((stream.GetStreamOptions() & StreamOption_Text) == 0)
+		struct ChunkFace
 		{
-			stream.EnableTextMode(true);
+			std::size_t firstVertex;
+			std::size_t vertexCount;
+			std::size_t positionCount; //< Attributes of the chunk defined before the face, for relative indices
+			std::size_t normalCount;
+			std::size_t texCoordCount;
+			unsigned int line;
+		};
 
-			resetTextMode.Reset([&stream] ()
+		struct ChunkDirective
+		{
+			enum Type
 			{
-				stream.EnableTextMode(false);
-			});
-		}
+				Type_Group,
+				Type_Material,
+				Type_MtlLib
+			};
+
+			std::size_t faceIndex; //< Applies before this face of the chunk
+			String value;
+			Type type;
+		};
 
-		String matName, meshName;
-		matName = meshName = "default";
-		m_keepLastLine = false;
-		m_lineCount = 0;
-		m_meshes.clear();
-		m_mtlLib.Clear();
+		struct ChunkMessage
+		{
+			unsigned int line;
+			String message;
+			bool error;
+		};
 
-		m_normals.clear();
-		m_positions.clear();
-		m_texCoords.clear();
+		struct Chunk
+		{
+			const char* begin;
+			const char* end;
+			std::size_t firstNormal;
+			std::size_t firstPosition;
+			std::size_t firstTexCoord;
+			std::vector<ChunkDirective> directives;
+			std::vector<ChunkFace> faces;
+			std::vector<ChunkMessage> messages;
+			std::vector<OBJParser::FaceVertex> vertices; //< Signed indices as written until they are resolved
+			std::vector<Vector3f> normals;
+			std::vector<Vector4f> positions;
+			std::vector<Vector3f> texCoords;
+			unsigned int firstLine;
+			unsigned int lineCount;
+		};
 
-		// Reserve some space for incoming vertices
-		m_normals.reserve(reservedVertexCount);
-		m_positions.reserve(reservedVertexCount);
-		m_texCoords.reserve(reservedVertexCount);
+		inline bool IsBlank(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
 
-		// Sort meshes by material and group
-		using MatPair = std::pair<Mesh, unsigned int>;
-		std::unordered_map<String, std::unordered_map<String, MatPair>> meshesByName;
+		inline bool IsDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
 
-		std::size_t faceReserve = 0;
-		std::size_t vertexReserve = 0;
-		unsigned int matCount = 0;
-		auto GetMaterial = [&] (const String& meshName, const String& matName) -> Mesh*
+		inline void SkipBlanks(const char*& ptr, const char* end)
 		{
-			auto& map = meshesByName[meshName];
-			auto it = map.find(matName);
-			if (it == map.end())
-				it = map.insert(std::make_pair(matName, MatPair(Mesh(), matCount++))).first;
+			while (ptr != end && IsBlank(*ptr))
+				++ptr;
+		}
 
-			Mesh& mesh = it->second.first;
+		bool ParseInteger(const char*& ptr, const char* end, Int64* value)
+		{
+			const char* p = ptr;
 
-			mesh.faces.reserve(faceReserve);
-			mesh.vertices.reserve(vertexReserve);
-			faceReserve = 0;
-			vertexReserve = 0;
+			bool negative = false;
+			if (p != end && (*p == '-' || *p == '+'))
+				negative = (*p++ == '-');
 
-			return &(it->second.first);
-		};
+			if (p == end || !IsDigit(*p))
+				return false;
 
-		// On prépare le mesh par défaut
-		Mesh* currentMesh = nullptr;
+			Int64 result = 0;
+			for (; p != end && IsDigit(*p); ++p)
+				result = result * 10 + (*p - '0');
+
+			*value = (negative) ? -result : result;
+			ptr = p;
+			return true;
+		}
 
-		while (Advance(false))
+		// Decimal parsing without going through the C locale, which sscanf/strtod do for each number
+		bool ParseFloat(const char*& ptr, const char* end, float* value)
 		{
-			switch (std::tolower(m_currentLine[0]))
-			{
-				case '#': //< Comment
-					// Some softwares write comments to gives the number of vertex/faces an importer can expect
-					std::size_t data;
-					if (std::sscanf(m_currentLine.GetConstBuffer(), "# position count: %zu", &data) == 1)
-						m_positions.reserve(data);
-					else if (std::sscanf(m_currentLine.GetConstBuffer(), "# normal count: %zu", &data) == 1)
-						m_normals.reserve(data);
-					else if (std::sscanf(m_currentLine.GetConstBuffer(), "# texcoords count: %zu", &data) == 1)
-						m_texCoords.reserve(data);
-					else if (std::sscanf(m_currentLine.GetConstBuffer(), "# face count: %zu", &data) == 1)
-						faceReserve = data;
-					else if (std::sscanf(m_currentLine.GetConstBuffer(), "# vertex count: %zu", &data) == 1)
-						vertexReserve = data;
+			static constexpr double powersOf10[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
 
-					break;
+			const char* p = ptr;
+
+			bool negative = false;
+			if (p != end && (*p == '-' || *p == '+'))
+				negative = (*p++ == '-');
+
+			UInt64 mantissa = 0;
+			int exponent = 0;
+			bool hasDigits = false;
+
+			// Digits past the precision of the mantissa only shift the exponent
+			for (; p != end && IsDigit(*p); ++p)
+			{
+				hasDigits = true;
+				if (mantissa < 100000000000000000ULL)
+					mantissa = mantissa * 10 + (*p - '0');
+				else
+					exponent++;
+			}
 
-				case 'f': //< Face
+			if (p != end && *p == '.')
+			{
+				for (++p; p != end && IsDigit(*p); ++p)
 				{
-					if (m_currentLine.GetSize() < 7) // Since we only treat triangles, this is the minimum length of a face line (f 1 2 3)
+					hasDigits = true;
+					if (mantissa < 100000000000000000ULL)
 					{
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						UnrecognizedLine();
-						#endif
-						break;
+						mantissa = mantissa * 10 + (*p - '0');
+						exponent--;
 					}
+				}
+			}
+
+			if (!hasDigits)
+				return false;
+
+			if (p != end && (*p == 'e' || *p == 'E'))
+			{
+				const char* exponentPtr = p + 1;
 
-					unsigned int vertexCount = m_currentLine.Count(' ');
-					if (vertexCount < 3)
+				bool negativeExponent = false;
+				if (exponentPtr != end && (*exponentPtr == '-' || *exponentPtr == '+'))
+					negativeExponent = (*exponentPtr++ == '-');
+
+				if (exponentPtr != end && IsDigit(*exponentPtr))
+				{
+					int exponentValue = 0;
+					for (; exponentPtr != end && IsDigit(*exponentPtr); ++exponentPtr)
 					{
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						UnrecognizedLine();
-						#endif
-						break;
+						if (exponentValue < 1000)
+							exponentValue = exponentValue * 10 + (*exponentPtr - '0');
 					}
 
-					if (!currentMesh)
-						currentMesh = GetMaterial(meshName, matName);
+					exponent += (negativeExponent) ? -exponentValue : exponentValue;
+					p = exponentPtr;
+				}
+			}
+
+			double result = static_cast<double>(mantissa);
+			if (exponent < 0)
+				result = (exponent >= -22) ? result / powersOf10[-exponent] : result * std::pow(10.0, exponent);
+			else if (exponent > 0)
+				result = (exponent <= 22) ? result * powersOf10[exponent] : result * std::pow(10.0, exponent);
+
+			*value = static_cast<float>((negative) ? -result : result);
+			ptr = p;
+			return true;
+		}
+
+		// Reads up to count blank-separated floats, returns how many were read
+		unsigned int ParseFloats(const char* ptr, const char* end, float* values, unsigned int count)
+		{
+			unsigned int parsed = 0;
+			while (parsed < count)
+			{
+				SkipBlanks(ptr, end);
+				if (!ParseFloat(ptr, end, &values[parsed]) || (ptr != end && !IsBlank(*ptr)))
+					break;
 
-					Face face;
-					face.firstVertex = currentMesh->vertices.size();
-					face.vertexCount = vertexCount;
+				parsed++;
+			}
 
-					currentMesh->vertices.resize(face.firstVertex + vertexCount, FaceVertex{0, 0, 0});
+			return parsed;
+		}
 
-					bool error = false;
-					unsigned int pos = 2;
-					for (unsigned int i = 0; i < vertexCount; ++i)
+		bool ParseFaceVertex(const char*& ptr, const char* end, OBJParser::FaceVertex* vertex)
+		{
+			// p, p/t, p//n or p/t/n
+			Int64 position;
+			Int64 normal = 0;
+			Int64 texCoord = 0;
+			if (!ParseInteger(ptr, end, &position))
+				return false;
+
+			if (ptr != end && *ptr == '/')
+			{
+				++ptr;
+				if (ptr != end && *ptr == '/')
+				{
+					++ptr;
+					if (!ParseInteger(ptr, end, &normal))
+						return false;
+				}
+				else
+				{
+					if (!ParseInteger(ptr, end, &texCoord))
+						return false;
+
+					if (ptr != end && *ptr == '/')
 					{
-						int offset;
-						int n = 0;
-						int p = 0;
-						int t = 0;
+						++ptr;
+						if (!ParseInteger(ptr, end, &normal))
+							return false;
+					}
+				}
+			}
 
-						if (std::sscanf(&m_currentLine[pos], "%d/%d/%d%n", &p, &t, &n, &offset) != 3)
-						{
-							if (std::sscanf(&m_currentLine[pos], "%d//%d%n", &p, &n, &offset) != 2)
-							{
-								if (std::sscanf(&m_currentLine[pos], "%d/%d%n", &p, &t, &offset) != 2)
-								{
-									if (std::sscanf(&m_currentLine[pos], "%d%n", &p, &offset) != 1)
-									{
-										#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-										UnrecognizedLine();
-										#endif
-										error = true;
-										break;
-									}
-								}
-							}
-						}
+			if (ptr != end && !IsBlank(*ptr))
+				return false;
+
+			vertex->normal = static_cast<std::size_t>(normal);
+			vertex->position = static_cast<std::size_t>(position);
+			vertex->texCoord = static_cast<std::size_t>(texCoord);
+			return true;
+		}
+
+		bool WordEquals(const char* begin, const char* end, const char* word)
+		{
+			for (; begin != end && *word; ++begin, ++word)
+			{
+				if (std::tolower(static_cast<unsigned char>(*begin)) != *word)
+					return false;
+			}
+
+			return begin == end && *word == '\0';
+		}
+
+		void ParseChunk(Chunk& chunk)
+		{
+			unsigned int line = 0;
+			const char* lineBegin = chunk.begin;
+			while (lineBegin != chunk.end)
+			{
+				const char* lineEnd = static_cast<const char*>(std::memchr(lineBegin, '\n', chunk.end - lineBegin));
+				const char* nextLine = (lineEnd) ? lineEnd + 1 : chunk.end;
+				if (!lineEnd)
+					lineEnd = chunk.end;
+
+				line++;
+
+				const char* ptr = lineBegin;
+				lineBegin = nextLine;
+
+				SkipBlanks(ptr, lineEnd);
+				if (ptr == lineEnd)
+					continue;
+
+				const char* wordEnd = ptr;
+				while (wordEnd != lineEnd && !IsBlank(*wordEnd))
+					++wordEnd;
+
+				auto UnrecognizedLine = [&]()
+				{
+					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
+					chunk.messages.push_back({line, "Unrecognized \"" + String(ptr, lineEnd - ptr).Simplify() + '"', false});
+					#endif
+				};
 
-						if (p < 0)
+				auto GetParameter = [&]() -> String
+				{
+					return String(wordEnd, lineEnd - wordEnd).Simplify();
+				};
+
+				switch (std::tolower(static_cast<unsigned char>(*ptr)))
+				{
+					case '#': //< Comment
+						break;
+
+					case 'f': //< Face
+					{
+						if (wordEnd - ptr != 1)
 						{
-							p += m_positions.size() - 1;
-							if (p < 0)
-							{
-								Error("Vertex index out of range (" + String::Number(p) + " < 0");
-								error = true;
-								break;
-							}
+							UnrecognizedLine();
+							break;
 						}
 
-						if (n < 0)
+						ChunkFace face;
+						face.firstVertex = chunk.vertices.size();
+						face.line = line;
+						face.normalCount = chunk.normals.size();
+						face.positionCount = chunk.positions.size();
+						face.texCoordCount = chunk.texCoords.size();
+
+						bool error = false;
+						const char* vertexPtr = wordEnd;
+						for (;;)
 						{
-							n += m_normals.size() - 1;
-							if (n < 0)
-							{
-								Error("Normal index out of range (" + String::Number(n) + " < 0");
-								error = true;
+							SkipBlanks(vertexPtr, lineEnd);
+							if (vertexPtr == lineEnd)
 								break;
-							}
-						}
 
-						if (t < 0)
-						{
-							t += m_texCoords.size() - 1;
-							if (t < 0)
+							OBJParser::FaceVertex vertex;
+							if (!ParseFaceVertex(vertexPtr, lineEnd, &vertex))
 							{
-								Error("Texture coordinates index out of range (" + String::Number(t) + " < 0");
 								error = true;
 								break;
 							}
-						}
 
-						if (static_cast<std::size_t>(p) > m_positions.size())
-						{
-							Error("Vertex index out of range (" + String::Number(p) + " >= " + String::Number(m_positions.size()) + ')');
-							error = true;
-							break;
+							chunk.vertices.push_back(vertex);
 						}
-						else if (n != 0 && static_cast<std::size_t>(n) > m_normals.size())
-						{
-							Error("Normal index out of range (" + String::Number(n) + " >= " + String::Number(m_normals.size()) + ')');
-							error = true;
-							break;
-						}
-						else if (t != 0 && static_cast<std::size_t>(t) > m_texCoords.size())
+
+						face.vertexCount = chunk.vertices.size() - face.firstVertex;
+						if (error || face.vertexCount < 3) // Since we only treat polygons, a face has at least three vertices
 						{
-							Error("TexCoord index out of range (" + String::Number(t) + " >= " + String::Number(m_texCoords.size()) + ')');
-							error = true;
+							chunk.vertices.resize(face.firstVertex);
+							UnrecognizedLine();
 							break;
 						}
 
-						currentMesh->vertices[face.firstVertex + i].normal = static_cast<std::size_t>(n);
-						currentMesh->vertices[face.firstVertex + i].position = static_cast<std::size_t>(p);
-						currentMesh->vertices[face.firstVertex + i].texCoord = static_cast<std::size_t>(t);
-
-						pos += offset;
+						chunk.faces.push_back(face);
+						break;
 					}
 
-					if (!error)
-						currentMesh->faces.push_back(std::move(face));
-					else
-						currentMesh->vertices.resize(face.firstVertex); //< Remove vertices
-
-					break;
-				}
-
-				case 'm': //< MTLLib
-					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-					if (m_currentLine.GetWord(0).ToLower() != "mtllib")
-						UnrecognizedLine();
-					#endif
-
-					m_mtlLib = m_currentLine.SubString(m_currentLine.GetWordPosition(1));
-					break;
-
-				case 'g': //< Group (inside a mesh)
-				case 'o': //< Object (defines a mesh)
-				{
-					if (m_currentLine.GetSize() <= 2 || m_currentLine[1] != ' ')
-					{
+					case 'm': //< MTLLib
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						UnrecognizedLine();
+						if (!WordEquals(ptr, wordEnd, "mtllib"))
+							UnrecognizedLine();
 						#endif
+
+						chunk.directives.push_back({chunk.faces.size(), GetParameter(), ChunkDirective::Type_MtlLib});
 						break;
-					}
 
-					String objectName = m_currentLine.SubString(m_currentLine.GetWordPosition(1));
-					if (objectName.IsEmpty())
+					case 'g': //< Group (inside a mesh)
+					case 'o': //< Object (defines a mesh)
 					{
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						UnrecognizedLine();
-						#endif
+						String objectName = GetParameter();
+						if (wordEnd - ptr != 1 || objectName.IsEmpty())
+						{
+							UnrecognizedLine();
+							break;
+						}
+
+						chunk.directives.push_back({chunk.faces.size(), std::move(objectName), ChunkDirective::Type_Group});
 						break;
 					}
 
-					meshName = objectName;
-					currentMesh = nullptr;
-					break;
-				}
-
-				#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-				case 's': //< Smooth
-					if (m_currentLine.GetSize() <= 2 || m_currentLine[1] == ' ')
+					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
+					case 's': //< Smooth
 					{
-						String param = m_currentLine.SubString(2);
-						if (param != "all" && param != "on" && param != "off" && !param.IsNumber())
+						String param = GetParameter();
+						if (wordEnd - ptr != 1 || (param != "all" && param != "on" && param != "off" && !param.ToInteger(nullptr)))
 							UnrecognizedLine();
+						break;
 					}
-					else
-						UnrecognizedLine();
-					break;
 					#endif
 
-				case 'u': //< Usemtl
-					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-					if (m_currentLine.GetWord(0) != "usemtl")
-						UnrecognizedLine();
-					#endif
-
-					matName = m_currentLine.SubString(m_currentLine.GetWordPosition(1));
-					currentMesh = nullptr;
-					if (matName.IsEmpty())
+					case 'u': //< Usemtl
 					{
 						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						UnrecognizedLine();
+						if (!WordEquals(ptr, wordEnd, "usemtl"))
+							UnrecognizedLine();
 						#endif
+
+						String matName = GetParameter();
+						if (matName.IsEmpty())
+						{
+							UnrecognizedLine();
+							break;
+						}
+
+						chunk.directives.push_back({chunk.faces.size(), std::move(matName), ChunkDirective::Type_Material});
 						break;
 					}
-					break;
 
-				case 'v': //< Position/Normal/Texcoords
-				{
-					String word = m_currentLine.GetWord(0).ToLower();
-					if (word == 'v')
+					case 'v': //< Position/Normal/Texcoords
 					{
-						Vector4f vertex(Vector3f::Zero(), 1.f);
-						unsigned int paramCount = std::sscanf(&m_currentLine[2], "%f %f %f %f", &vertex.x, &vertex.y, &vertex.z, &vertex.w);
-						if (paramCount >= 1)
-							m_positions.push_back(vertex);
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
+						if (WordEquals(ptr, wordEnd, "v"))
+						{
+							Vector4f vertex(Vector3f::Zero(), 1.f);
+							if (ParseFloats(wordEnd, lineEnd, &vertex.x, 4) >= 1)
+								chunk.positions.push_back(vertex);
+							else
+								UnrecognizedLine();
+						}
+						else if (WordEquals(ptr, wordEnd, "vn"))
+						{
+							Vector3f normal(Vector3f::Zero());
+							if (ParseFloats(wordEnd, lineEnd, &normal.x, 3) == 3)
+								chunk.normals.push_back(normal);
+							else
+								UnrecognizedLine();
+						}
+						else if (WordEquals(ptr, wordEnd, "vt"))
+						{
+							Vector3f uvw(Vector3f::Zero());
+							if (ParseFloats(wordEnd, lineEnd, &uvw.x, 3) >= 2)
+								chunk.texCoords.push_back(uvw);
+							else
+								UnrecognizedLine();
+						}
 						else
 							UnrecognizedLine();
-						#endif
+
+						break;
 					}
-					else if (word == "vn")
+
+					default:
+						UnrecognizedLine();
+						break;
+				}
+			}
+
+			chunk.lineCount = line;
+		}
+
+		// Turns the indices of a face vertex into one-based absolute indices, zero meaning an absent attribute
+		bool ResolveIndex(std::size_t* index, std::size_t definedCount, bool required)
+		{
+			Int64 value = static_cast<Int64>(*index);
+			if (value == 0 && !required)
+				return true;
+
+			if (value < 0)
+				value += static_cast<Int64>(definedCount) + 1; //< -1 is the last attribute defined before the face
+
+			if (value <= 0 || static_cast<UInt64>(value) > definedCount)
+				return false;
+
+			*index = static_cast<std::size_t>(value);
+			return true;
+		}
+
+		void ResolveFaces(Chunk& chunk)
+		{
+			for (ChunkFace& face : chunk.faces)
+			{
+				std::size_t normalCount = chunk.firstNormal + face.normalCount;
+				std::size_t positionCount = chunk.firstPosition + face.positionCount;
+				std::size_t texCoordCount = chunk.firstTexCoord + face.texCoordCount;
+
+				for (std::size_t i = 0; i < face.vertexCount; ++i)
+				{
+					OBJParser::FaceVertex& vertex = chunk.vertices[face.firstVertex + i];
+
+					Int64 normal = static_cast<Int64>(vertex.normal);
+					Int64 position = static_cast<Int64>(vertex.position);
+					Int64 texCoord = static_cast<Int64>(vertex.texCoord);
+
+					String error;
+					if (!ResolveIndex(&vertex.position, positionCount, true))
+						error = "Vertex index out of range (" + String::Number(position) + ')';
+					else if (!ResolveIndex(&vertex.normal, normalCount, false))
+						error = "Normal index out of range (" + String::Number(normal) + ')';
+					else if (!ResolveIndex(&vertex.texCoord, texCoordCount, false))
+						error = "Texture coordinates index out of range (" + String::Number(texCoord) + ')';
+
+					if (!error.IsEmpty())
 					{
-						Vector3f normal(Vector3f::Zero());
-						unsigned int paramCount = std::sscanf(&m_currentLine[3], "%f %f %f", &normal.x, &normal.y, &normal.z);
-						if (paramCount == 3)
-							m_normals.push_back(normal);
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						else
-							UnrecognizedLine();
-						#endif
+						chunk.messages.push_back({face.line, std::move(error), true});
+						face.vertexCount = 0; //< Drops the face
+						break;
 					}
-					else if (word == "vt")
+				}
+			}
+		}
+	}
+
+	bool OBJParser::Parse(Nz::Stream& stream, std::size_t reservedVertexCount)
+	{
+		// The parser works on the whole file at once
+		std::vector<char> content(static_cast<std::size_t>(stream.GetSize() - stream.GetCursorPos()));
+		std::size_t size = (!content.empty()) ? stream.Read(content.data(), content.size()) : 0;
+
+		return Parse(content.data(), size, reservedVertexCount);
+	}
+
+	bool OBJParser::Parse(const void* data, std::size_t size, std::size_t reservedVertexCount)
+	{
+		NazaraUnused(reservedVertexCount); // Attribute counts are known before being stored
+
+		m_meshes.clear();
+		m_mtlLib.Clear();
+		m_normals.clear();
+		m_positions.clear();
+		m_texCoords.clear();
+
+		// Cut the file on line boundaries and parse the chunks in parallel, they only depend on each other through indices
+		const char* content = static_cast<const char*>(data);
+		const char* contentEnd = content + size;
+
+		std::vector<Chunk> chunks;
+		for (const char* chunkBegin = content; chunkBegin != contentEnd;)
+		{
+			const char* chunkEnd = contentEnd;
+			if (static_cast<std::size_t>(contentEnd - chunkBegin) > ChunkSize)
+			{
+				const char* newLine = static_cast<const char*>(std::memchr(chunkBegin + ChunkSize, '\n', contentEnd - chunkBegin - ChunkSize));
+				if (newLine)
+					chunkEnd = newLine + 1;
+			}
+
+			chunks.emplace_back();
+			chunks.back().begin = chunkBegin;
+			chunks.back().end = chunkEnd;
+
+			chunkBegin = chunkEnd;
+		}
+
+		TaskScheduler::ParallelFor(0, chunks.size(), 1, [&] (std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+				ParseChunk(chunks[i]);
+		});
+
+		std::size_t normalCount = 0;
+		std::size_t positionCount = 0;
+		std::size_t texCoordCount = 0;
+		unsigned int lineCount = 0;
+		for (Chunk& chunk : chunks)
+		{
+			chunk.firstLine = lineCount;
+			chunk.firstNormal = normalCount;
+			chunk.firstPosition = positionCount;
+			chunk.firstTexCoord = texCoordCount;
+
+			lineCount += chunk.lineCount;
+			normalCount += chunk.normals.size();
+			positionCount += chunk.positions.size();
+			texCoordCount += chunk.texCoords.size();
+		}
+
+		m_normals.resize(normalCount);
+		m_positions.resize(positionCount);
+		m_texCoords.resize(texCoordCount);
+
+		TaskScheduler::ParallelFor(0, chunks.size(), 1, [&] (std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Chunk& chunk = chunks[i];
+				std::copy(chunk.normals.begin(), chunk.normals.end(), m_normals.begin() + chunk.firstNormal);
+				std::copy(chunk.positions.begin(), chunk.positions.end(), m_positions.begin() + chunk.firstPosition);
+				std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), m_texCoords.begin() + chunk.firstTexCoord);
+
+				ResolveFaces(chunk);
+			}
+		});
+
+		// Sort meshes by material and group
+		using MatPair = std::pair<Mesh, unsigned int>;
+		std::unordered_map<String, std::unordered_map<String, MatPair>> meshesByName;
+
+		unsigned int matCount = 0;
+		auto GetMaterial = [&] (const String& meshName, const String& matName) -> Mesh*
+		{
+			auto& map = meshesByName[meshName];
+			auto it = map.find(matName);
+			if (it == map.end())
+				it = map.insert(std::make_pair(matName, MatPair(Mesh(), matCount++))).first;
+
+			return &(it->second.first);
+		};
+
+		String matName, meshName;
+		matName = meshName = "default";
+
+		Mesh* currentMesh = nullptr;
+		for (Chunk& chunk : chunks)
+		{
+			auto directiveIt = chunk.directives.begin();
+			auto ApplyDirectives = [&] (std::size_t faceIndex)
+			{
+				for (; directiveIt != chunk.directives.end() && directiveIt->faceIndex <= faceIndex; ++directiveIt)
+				{
+					switch (directiveIt->type)
 					{
-						Vector3f uvw(Vector3f::Zero());
-						unsigned int paramCount = std::sscanf(&m_currentLine[3], "%f %f %f", &uvw.x, &uvw.y, &uvw.z);
-						if (paramCount >= 2)
-							m_texCoords.push_back(uvw);
-						#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-						else
-							UnrecognizedLine();
-						#endif
-					}
-					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-					else
-						UnrecognizedLine();
-					#endif
+						case ChunkDirective::Type_Group:
+							meshName = directiveIt->value;
+							currentMesh = nullptr;
+							break;
 
-					break;
+						case ChunkDirective::Type_Material:
+							matName = directiveIt->value;
+							currentMesh = nullptr;
+							break;
+
+						case ChunkDirective::Type_MtlLib:
+							m_mtlLib = directiveIt->value;
+							break;
+					}
 				}
+			};
 
-				default:
-					#if NAZARA_UTILITY_STRICT_RESOURCE_PARSING
-					UnrecognizedLine();
-					#endif
-					break;
+			for (std::size_t i = 0; i < chunk.faces.size(); ++i)
+			{
+				ApplyDirectives(i);
+
+				const ChunkFace& chunkFace = chunk.faces[i];
+				if (chunkFace.vertexCount == 0)
+					continue;
+
+				if (!currentMesh)
+					currentMesh = GetMaterial(meshName, matName);
+
+				Face face;
+				face.firstVertex = currentMesh->vertices.size();
+				face.vertexCount = chunkFace.vertexCount;
+
+				auto vertexBegin = chunk.vertices.begin() + chunkFace.firstVertex;
+				currentMesh->vertices.insert(currentMesh->vertices.end(), vertexBegin, vertexBegin + chunkFace.vertexCount);
+				currentMesh->faces.push_back(face);
+			}
+
+			ApplyDirectives(chunk.faces.size());
+
+			for (const ChunkMessage& message : chunk.messages)
+			{
+				m_lineCount = chunk.firstLine + message.line;
+				if (message.error)
+					Error(message.message);
+				else
+					Warning(message.message);
 			}
 		}
 
@@ -507,31 +817,4 @@ namespace Nz
 
 		return true;
 	}
-
-	bool OBJParser::Advance(bool required)
-	{
-		if (!m_keepLastLine)
-		{
-			do
-			{
-				if (m_currentStream->EndOfStream())
-				{
-					if (required)
-						Error("Incomplete OBJ file");
-
-					return false;
-				}
-
-				m_lineCount++;
-
-				m_currentLine = m_currentStream->ReadLine();
-				m_currentLine.Simplify(); // Simplify lines (convert multiple blanks into a single space and trims)
-			}
-			while (m_currentLine.IsEmpty());
-		}
-		else
-			m_keepLastLine = false;
-
-		return true;
-	}
 }
@@ -4,61 +4,217 @@
 
 #include <Nazara/Utility/Formats/OBJLoader.hpp>
 #include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
-#include <Nazara/Utility/BufferMapper.hpp>
-#include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/MaterialData.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/TriangleIterator.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
 #include <Nazara/Utility/Formats/MTLParser.hpp>
-#include <Nazara/Utility/Formats/OBJParser.hpp>
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
-#include <limits>
-#include <map>
+#include <cstring>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
 	namespace
 	{
-		template<typename T>
-		class VertexCache
+		// Writes the file by fixed-size chunks, the mesh is never copied in memory
+		class OBJWriter
 		{
 			public:
-				VertexCache(T* ptr) :
-				m_count(0),
-				m_buffer(ptr)
+				OBJWriter(Stream& stream) :
+				m_stream(stream),
+				m_buffer(new char[ChunkSize]),
+				m_size(0),
+				m_failed(false)
 				{
+					// Same conversion as Stream::Write(const String&) would do in text mode
+					#if defined(NAZARA_PLATFORM_WINDOWS)
+					m_newLine = (stream.GetStreamOptions() & StreamOption_Text) ? "\r\n" : "\n";
+					#elif defined(NAZARA_PLATFORM_MACOS)
+					m_newLine = (stream.GetStreamOptions() & StreamOption_Text) ? "\r" : "\n";
+					#else
+					m_newLine = "\n";
+					#endif
 				}
 
-				std::size_t GetCount() const
+				bool Flush()
 				{
-					return m_count;
+					if (m_size > 0)
+					{
+						if (m_stream.Write(m_buffer.get(), m_size) != m_size)
+							m_failed = true;
+
+						m_size = 0;
+					}
+
+					return !m_failed;
 				}
 
-				std::size_t Insert(const T& data)
+				void Write(char character)
 				{
-					auto it = m_cache.find(data);
-					if (it == m_cache.end())
+					if (m_size == ChunkSize)
+						Flush();
+
+					m_buffer[m_size++] = character;
+				}
+
+				void Write(const char* str)
+				{
+					Write(str, std::strlen(str));
+				}
+
+				void Write(const char* str, std::size_t size)
+				{
+					while (size > 0)
 					{
-						it = m_cache.insert(std::make_pair(data, m_count)).first;
-						m_buffer[m_count] = data;
-						m_count++;
+						if (m_size == ChunkSize)
+							Flush();
+
+						std::size_t count = std::min(size, ChunkSize - m_size);
+						std::memcpy(&m_buffer[m_size], str, count);
+
+						m_size += count;
+						str += count;
+						size -= count;
 					}
+				}
+
+				void Write(const String& str)
+				{
+					Write(str.GetConstBuffer(), str.GetSize());
+				}
+
+				void WriteFloat(float value)
+				{
+					char buffer[32];
+					Write(buffer, FormatFloat(value, buffer));
+				}
+
+				void WriteInteger(UInt64 value)
+				{
+					char buffer[20];
+					std::size_t pos = sizeof(buffer);
+					do
+					{
+						buffer[--pos] = static_cast<char>('0' + value % 10);
+						value /= 10;
+					}
+					while (value > 0);
 
-					return it->second + 1;
+					Write(&buffer[pos], sizeof(buffer) - pos);
+				}
+
+				void WriteLine()
+				{
+					Write(m_newLine);
+				}
+
+				template<typename T>
+				void WriteLine(const T& line)
+				{
+					Write(line);
+					WriteLine();
 				}
 
 			private:
-				std::size_t m_count;
-				std::map<T, std::size_t> m_cache;
-				T* m_buffer;
+				// Same output as String::Number (%g with NAZARA_CORE_DECIMAL_DIGITS significant digits), without going through a std::ostringstream
+				static std::size_t FormatFloat(float value, char* buffer)
+				{
+					static_assert(NAZARA_CORE_DECIMAL_DIGITS > 0 && NAZARA_CORE_DECIMAL_DIGITS < 10, "Unsupported decimal digit count");
+
+					constexpr int Digits = NAZARA_CORE_DECIMAL_DIGITS;
+					static const UInt64 powers[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL};
+
+					if (value == 0.f)
+					{
+						buffer[0] = '0';
+						return 1;
+					}
+
+					double absValue = std::abs(static_cast<double>(value));
+
+					// Values in exponent notation (or not finite) are left to the C library
+					if (!(absValue >= 1e-4 && absValue < static_cast<double>(powers[Digits])))
+						return std::snprintf(buffer, 32, "%.*g", Digits, value);
+
+					int exponent = static_cast<int>(std::floor(std::log10(absValue)));
+					int decimals = Digits - 1 - exponent;
+
+					UInt64 scaled = static_cast<UInt64>(std::nearbyint(absValue * std::pow(10.0, decimals)));
+					if (scaled < powers[Digits - 1]) // log10 overestimated the exponent
+					{
+						decimals++;
+						scaled = static_cast<UInt64>(std::nearbyint(absValue * std::pow(10.0, decimals)));
+					}
+
+					if (scaled >= powers[Digits]) // Rounding added a digit
+					{
+						if (decimals == 0)
+							return std::snprintf(buffer, 32, "%.*g", Digits, value);
+
+						decimals--;
+						scaled /= 10;
+					}
+
+					UInt64 integerPart = scaled / powers[decimals];
+					UInt64 fractionalPart = scaled % powers[decimals];
+
+					// Trailing zeros are not written
+					while (decimals > 0 && fractionalPart % 10 == 0)
+					{
+						fractionalPart /= 10;
+						decimals--;
+					}
+
+					char* ptr = buffer;
+					if (value < 0.f)
+						*ptr++ = '-';
+
+					char digits[20];
+					std::size_t pos = sizeof(digits);
+					do
+					{
+						digits[--pos] = static_cast<char>('0' + integerPart % 10);
+						integerPart /= 10;
+					}
+					while (integerPart > 0);
+
+					std::memcpy(ptr, &digits[pos], sizeof(digits) - pos);
+					ptr += sizeof(digits) - pos;
+
+					if (decimals > 0)
+					{
+						*ptr++ = '.';
+						for (int i = decimals - 1; i >= 0; --i)
+						{
+							ptr[i] = static_cast<char>('0' + fractionalPart % 10);
+							fractionalPart /= 10;
+						}
+						ptr += decimals;
+					}
+
+					return ptr - buffer;
+				}
+
+				static constexpr std::size_t ChunkSize = 64 * 1024;
+
+				Stream& m_stream;
+				std::unique_ptr<char[]> m_buffer;
+				const char* m_newLine;
+				std::size_t m_size;
+				bool m_failed;
 		};
 
+		constexpr std::size_t OBJWriter::ChunkSize;
+
 		bool IsSupported(const String& extension)
 		{
 			return (extension == "obj");
@@ -78,11 +234,9 @@ namespace Nz
 				return false;
 			}
 
-			std::size_t worstCacheVertexCount = mesh.GetVertexCount();
-			OBJParser objFormat;
-			objFormat.SetNormalCount(worstCacheVertexCount);
-			objFormat.SetPositionCount(worstCacheVertexCount);
-			objFormat.SetTexCoordCount(worstCacheVertexCount);
+			OBJWriter writer(stream);
+			writer.WriteLine("# Exported by Nazara Engine");
+			writer.WriteLine();
 
 			String mtlPath = stream.GetPath();
 			if (!mtlPath.IsEmpty())
@@ -90,19 +244,19 @@ namespace Nz
 				mtlPath.Replace(".obj", ".mtl");
 				String fileName = mtlPath.SubStringFrom(NAZARA_DIRECTORY_SEPARATOR, -1, true);
 				if (!fileName.IsEmpty())
-					objFormat.SetMtlLib(fileName);
+				{
+					writer.Write("mtllib ");
+					writer.WriteLine(fileName);
+					writer.WriteLine();
+				}
 			}
 
-			VertexCache<Vector3f> normalCache(objFormat.GetNormals());
-			VertexCache<Vector4f> positionCache(objFormat.GetPositions());
-			VertexCache<Vector3f> texCoordsCache(objFormat.GetTexCoords());
-
 			// Materials
 			MTLParser mtlFormat;
 			std::unordered_set<String> registredMaterials;
 
 			std::size_t matCount = mesh.GetMaterialCount();
-			String* materialNames = objFormat.SetMaterialCount(matCount);
+			std::vector<String> materialNames(matCount);
 			for (std::size_t i = 0; i < matCount; ++i)
 			{
 				const ParameterList& matData = mesh.GetMaterialData(i);
@@ -120,7 +274,6 @@ namespace Nz
 
 				MTLParser::Material* material = mtlFormat.AddMaterial(name);
 
-				bool bValue;
 				String strVal;
 				if (matData.HasParameter(MaterialData::CustomDefined))
 				{
@@ -152,56 +305,128 @@ namespace Nz
 					material->diffuseMap = strVal;
 			}
 
-			// Meshes
+			// Meshes, each of them is written straight from its buffers: its vertices first, then its faces referencing them
+			UInt64 firstVertex = 1; // OBJ indices start at one
 			std::size_t meshCount = mesh.GetSubMeshCount();
-			OBJParser::Mesh* meshes = objFormat.SetMeshCount(meshCount);
 			for (std::size_t i = 0; i < meshCount; ++i)
 			{
 				const StaticMesh* staticMesh = static_cast<const StaticMesh*>(mesh.GetSubMesh(i));
 
-				std::size_t triangleCount = staticMesh->GetTriangleCount();
+				std::size_t vertexCount = staticMesh->GetVertexCount();
+
+				writer.Write("g mesh_");
+				writer.WriteInteger(i);
+				writer.WriteLine();
+
+				std::size_t materialIndex = staticMesh->GetMaterialIndex();
+				if (materialIndex < matCount)
+				{
+					writer.Write("usemtl ");
+					writer.WriteLine(materialNames[materialIndex]);
+				}
+				writer.WriteLine();
+
+				VertexMapper vertexMapper(staticMesh);
+
+				SparsePtr<Vector3f> normalPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Normal);
+				SparsePtr<Vector3f> positionPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Position);
+				SparsePtr<Vector2f> texCoordsPtr = vertexMapper.GetComponentPtr<Vector2f>(VertexComponent_TexCoord);
 
-				meshes[i].faces.resize(triangleCount);
-				meshes[i].material = staticMesh->GetMaterialIndex();
-				meshes[i].name = "mesh_" + String::Number(i);
-				meshes[i].vertices.resize(triangleCount * 3);
+				if (!positionPtr)
+				{
+					NazaraError("Submesh #" + String::Number(i) + " has no usable position");
+					return false;
+				}
+
+				writer.Write("# vertex count: ");
+				writer.WriteInteger(vertexCount);
+				writer.WriteLine();
+
+				for (std::size_t j = 0; j < vertexCount; ++j)
+				{
+					const Vector3f& position = positionPtr[j];
+
+					writer.Write("v ");
+					writer.WriteFloat(position.x);
+					writer.Write(' ');
+					writer.WriteFloat(position.y);
+					writer.Write(' ');
+					writer.WriteFloat(position.z);
+					writer.WriteLine();
+				}
+
+				if (texCoordsPtr)
+				{
+					for (std::size_t j = 0; j < vertexCount; ++j)
+					{
+						const Vector2f& uv = texCoordsPtr[j];
+
+						writer.Write("vt ");
+						writer.WriteFloat(uv.x);
+						writer.Write(' ');
+						writer.WriteFloat(uv.y);
+						writer.WriteLine();
+					}
+				}
 
+				if (normalPtr)
 				{
-					VertexMapper vertexMapper(staticMesh);
+					for (std::size_t j = 0; j < vertexCount; ++j)
+					{
+						const Vector3f& normal = normalPtr[j];
+
+						writer.Write("vn ");
+						writer.WriteFloat(normal.x);
+						writer.Write(' ');
+						writer.WriteFloat(normal.y);
+						writer.Write(' ');
+						writer.WriteFloat(normal.z);
+						writer.WriteLine();
+					}
+				}
 
-					SparsePtr<Vector3f> normalPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Normal);
-					SparsePtr<Vector3f> positionPtr = vertexMapper.GetComponentPtr<Vector3f>(VertexComponent_Position);
-					SparsePtr<Vector2f> texCoordsPtr = vertexMapper.GetComponentPtr<Vector2f>(VertexComponent_TexCoord);
+				writer.Write("# face count: ");
+				writer.WriteInteger(staticMesh->GetTriangleCount());
+				writer.WriteLine();
 
-					std::size_t faceIndex = 0;
-					TriangleIterator triangle(staticMesh);
-					do 
+				TriangleIterator triangle(staticMesh);
+				do
+				{
+					writer.Write('f');
+					for (std::size_t j = 0; j < 3; ++j)
 					{
-						OBJParser::Face& face = meshes[i].faces[faceIndex];
-						face.firstVertex = faceIndex * 3;
-						face.vertexCount = 3;
+						// Every attribute of a vertex has the same index
+						UInt64 index = firstVertex + triangle[j];
 
-						for (std::size_t j = 0; j < 3; ++j)
+						writer.Write(' ');
+						writer.WriteInteger(index);
+						if (texCoordsPtr || normalPtr)
 						{
-							OBJParser::FaceVertex& vertexIndices = meshes[i].vertices[face.firstVertex + j];
-
-							std::size_t index = triangle[j];
-							vertexIndices.normal = normalCache.Insert(normalPtr[index]);
-							vertexIndices.position = positionCache.Insert(positionPtr[index]);
-							vertexIndices.texCoord = texCoordsCache.Insert(texCoordsPtr[index]);
+							writer.Write('/');
+							if (texCoordsPtr)
+								writer.WriteInteger(index);
+
+							if (normalPtr)
+							{
+								writer.Write('/');
+								writer.WriteInteger(index);
+							}
 						}
-
-						faceIndex++;
 					}
-					while (triangle.Advance());
+					writer.WriteLine();
 				}
-			}
+				while (triangle.Advance());
+
+				writer.WriteLine();
 
-			objFormat.SetNormalCount(normalCache.GetCount());
-			objFormat.SetPositionCount(positionCache.GetCount());
-			objFormat.SetTexCoordCount(texCoordsCache.GetCount());
+				firstVertex += vertexCount;
+			}
 
-			objFormat.Save(stream);
+			if (!writer.Flush())
+			{
+				NazaraError("Failed to write mesh to stream");
+				return false;
+			}
 
 			if (!mtlPath.IsEmpty())
 			{
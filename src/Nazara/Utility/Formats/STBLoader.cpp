@@ -56,13 +56,8 @@ namespace Nz
 				return Ternary_False;
 		}
 
-		bool Load(Image* image, Stream& stream, const ImageParams& parameters)
+		bool CreateImage(Image* image, UInt8* ptr, int width, int height, const ImageParams& parameters)
 		{
-			// Je charge tout en RGBA8 et je converti ensuite via la méthode Convert
-			// Ceci à cause d'un bug de STB lorsqu'il s'agit de charger certaines images (ex: JPG) en "default"
-
-			int width, height, bpp;
-			UInt8* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
 			if (!ptr)
 			{
 				NazaraError("Failed to load image: " + String(stbi_failure_reason()));
@@ -85,18 +80,38 @@ namespace Nz
 
 			return true;
 		}
+
+		bool Load(Image* image, Stream& stream, const ImageParams& parameters)
+		{
+			// Je charge tout en RGBA8 et je converti ensuite via la méthode Convert
+			// Ceci à cause d'un bug de STB lorsqu'il s'agit de charger certaines images (ex: JPG) en "default"
+
+			int width, height, bpp;
+			UInt8* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &bpp, STBI_rgb_alpha);
+
+			return CreateImage(image, ptr, width, height, parameters);
+		}
+
+		bool LoadMemory(Image* image, const void* data, std::size_t size, const ImageParams& parameters)
+		{
+			// Decoding straight from the buffer (which may be a file mapping) avoids going through the read callbacks
+			int width, height, bpp;
+			UInt8* ptr = stbi_load_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size), &width, &height, &bpp, STBI_rgb_alpha);
+
+			return CreateImage(image, ptr, width, height, parameters);
+		}
 	}
 
 	namespace Loaders
 	{
 		void RegisterSTBLoader()
 		{
-			ImageLoader::RegisterLoader(IsSupported, Check, Load);
+			ImageLoader::RegisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
 		}
 
 		void UnregisterSTBLoader()
 		{
-			ImageLoader::UnregisterLoader(IsSupported, Check, Load);
+			ImageLoader::UnregisterLoader(IsSupported, Check, Load, nullptr, LoadMemory);
 		}
 	}
 }
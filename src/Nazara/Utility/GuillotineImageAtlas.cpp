@@ -4,6 +4,8 @@
 
 #include <Nazara/Utility/GuillotineImageAtlas.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <cstring>
+#include <numeric>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -112,43 +114,82 @@ namespace Nz
 			}
 			else if (i == m_layers.size() - 1) // Dernière itération ?
 			{
-				// Dernière couche, et le glyphe ne rentre pas, peut-on agrandir la taille de l'image ?
-				Vector2ui newSize = layer.binPack.GetSize()*2;
-				if (newSize == Vector2ui::Zero())
-					newSize.Set(s_atlasStartSize);
+				// Dernière couche, et le glyphe ne rentre pas, on agrandit l'atlas et on relance la boucle sur cette couche
+				if (!GrowLayers())
+					return false;
 
-				if (ResizeLayer(layer, newSize))
-				{
-					// Oui on peut !
-					layer.binPack.Expand(newSize); // On ajuste l'atlas virtuel
+				i--;
+			}
+		}
 
-					// Et on relance la boucle sur la nouvelle dernière couche
-					i--;
-				}
-				else
-				{
-					// On ne peut plus agrandir la dernière couche, il est temps d'en créer une nouvelle
-					newSize.Set(s_atlasStartSize);
+		NazaraInternalError("Unknown error"); // Normalement on ne peut pas arriver ici
+		return false;
+	}
 
-					Layer newLayer;
-					if (!ResizeLayer(newLayer, newSize))
-					{
-						// Impossible d'allouer une nouvelle couche, nous manquons probablement de mémoire (ou le glyphe est trop grand)
-						NazaraError("Failed to allocate new layer, we are probably out of memory");
-						return false;
-					}
+	bool GuillotineImageAtlas::Insert(SparsePtr<const Image> images, Rectui* rects, bool* flipped, unsigned int* layerIndices, unsigned int count)
+	{
+		if (m_layers.empty())
+			// On créé une première couche s'il n'y en a pas
+			m_layers.resize(1);
 
-					newLayer.binPack.Reset(newSize);
+		// Indices des rectangles restant à placer
+		std::vector<unsigned int> remainingRects(count);
+		std::iota(remainingRects.begin(), remainingRects.end(), 0U);
 
-					m_layers.emplace_back(std::move(newLayer)); // Insertion du layer
+		std::vector<Rectui> layerRects;
+		layerRects.reserve(count);
 
-					// On laisse la boucle insérer toute seule le rectangle à la prochaine itération
+		std::unique_ptr<bool[]> layerFlipped(new bool[count]);
+		std::unique_ptr<bool[]> layerInserted(new bool[count]);
+
+		for (unsigned int i = 0; i < m_layers.size() && !remainingRects.empty(); ++i)
+		{
+			Layer& layer = m_layers[i];
+
+			if (layer.freedRectangles > 10)
+			{
+				while (layer.binPack.MergeFreeRectangles());
+				layer.freedRectangles = 0;
+			}
+
+			layerRects.clear();
+			for (unsigned int index : remainingRects)
+				layerRects.push_back(rects[index]);
+
+			// Les rectangles sont placés ensemble, du plus grand au plus petit, ceux qui ne rentrent pas sont tentés dans les couches suivantes
+			layer.binPack.InsertSorted(layerRects.data(), layerFlipped.get(), layerInserted.get(), static_cast<unsigned int>(layerRects.size()), false, m_rectChoiceHeuristic, m_rectSplitHeuristic);
+
+			std::size_t remainingCount = 0;
+			for (std::size_t j = 0; j < layerRects.size(); ++j)
+			{
+				unsigned int index = remainingRects[j];
+				if (layerInserted[j])
+				{
+					rects[index] = layerRects[j];
+					flipped[index] = layerFlipped[j];
+					layerIndices[index] = i;
+
+					layer.queuedGlyphs.resize(layer.queuedGlyphs.size()+1);
+					QueuedGlyph& glyph = layer.queuedGlyphs.back();
+					glyph.flipped = layerFlipped[j];
+					glyph.image = images[index];
+					glyph.rect = layerRects[j];
 				}
+				else
+					remainingRects[remainingCount++] = index;
+			}
+			remainingRects.resize(remainingCount);
+
+			if (!remainingRects.empty() && i == m_layers.size() - 1)
+			{
+				if (!GrowLayers())
+					return false;
+
+				i--;
 			}
 		}
 
-		NazaraInternalError("Unknown error"); // Normalement on ne peut pas arriver ici
-		return false;
+		return true;
 	}
 
 	void GuillotineImageAtlas::SetRectChoiceHeuristic(GuillotineBinPack::FreeRectChoiceHeuristic heuristic)
@@ -161,6 +202,39 @@ namespace Nz
 		m_rectSplitHeuristic = heuristic;
 	}
 
+	bool GuillotineImageAtlas::GrowLayers()
+	{
+		// La dernière couche est pleine, peut-on agrandir la taille de son image ?
+		Layer& layer = m_layers.back();
+
+		Vector2ui newSize = layer.binPack.GetSize()*2;
+		if (newSize == Vector2ui::Zero())
+			newSize.Set(s_atlasStartSize);
+
+		if (ResizeLayer(layer, newSize))
+		{
+			// Oui on peut, on ajuste l'atlas virtuel
+			layer.binPack.Expand(newSize);
+			return true;
+		}
+
+		// On ne peut plus agrandir la dernière couche, il est temps d'en créer une nouvelle
+		newSize.Set(s_atlasStartSize);
+
+		Layer newLayer;
+		if (!ResizeLayer(newLayer, newSize))
+		{
+			// Impossible d'allouer une nouvelle couche, nous manquons probablement de mémoire (ou le glyphe est trop grand)
+			NazaraError("Failed to allocate new layer, we are probably out of memory");
+			return false;
+		}
+
+		newLayer.binPack.Reset(newSize);
+
+		m_layers.emplace_back(std::move(newLayer)); // Insertion du layer
+		return true;
+	}
+
 	AbstractImage* GuillotineImageAtlas::ResizeImage(AbstractImage* oldImage, const Vector2ui& size) const
 	{
 		std::unique_ptr<Image> newImage(new Image(ImageType_2D, PixelFormatType_A8, size.x, size.y));
@@ -181,6 +255,18 @@ namespace Nz
 		if (!newImage)
 			return false; // Nous n'avons pas pu allouer
 
+		if (GetStorage() & DataStorage_Hardware)
+		{
+			// La copie locale suit la taille de la couche
+			Image staging(ImageType_2D, PixelFormatType_A8, size.x, size.y);
+			std::memset(staging.GetPixels(), 0, size.x*size.y*sizeof(UInt8));
+
+			if (layer.staging.IsValid())
+				staging.Copy(layer.staging, Boxui(layer.staging.GetWidth(), layer.staging.GetHeight(), 1), Vector3ui(0, 0, 0));
+
+			layer.staging = std::move(staging);
+		}
+
 		if (newImage.get() == oldLayer) // Le layer a été agrandi dans le même objet, pas de souci
 		{
 			newImage.release(); // On possède déjà un unique_ptr sur cette ressource
@@ -199,10 +285,21 @@ namespace Nz
 
 	void GuillotineImageAtlas::ProcessGlyphQueue(Layer& layer) const
 	{
+		if (layer.queuedGlyphs.empty())
+			return;
+
+		// Les couches matérielles sont composées dans leur copie locale puis envoyées en une seule fois,
+		// sur la zone englobant tous les glyphes en attente
+		bool staged = layer.staging.IsValid();
+		AbstractImage* target = (staged) ? &layer.staging : layer.image.get();
+		Rectui updatedRect = layer.queuedGlyphs.front().rect;
+
 		std::vector<UInt8> pixelBuffer;
 
 		for (QueuedGlyph& glyph : layer.queuedGlyphs)
 		{
+			updatedRect.ExtendTo(glyph.rect);
+
 			unsigned int glyphWidth = glyph.image.GetWidth();
 			unsigned int glyphHeight = glyph.image.GetHeight();
 
@@ -226,7 +323,7 @@ namespace Nz
 				pixelBuffer.resize(glyph.rect.width * glyph.rect.height);
 				std::memset(pixelBuffer.data(), 0, glyph.rect.width*glyph.rect.height*sizeof(UInt8));
 
-				layer.image->Update(pixelBuffer.data(), glyph.rect);
+				target->Update(pixelBuffer.data(), glyph.rect);
 			}
 
 			const UInt8* pixels;
@@ -258,10 +355,13 @@ namespace Nz
 			else
 				pixels = glyph.image.GetConstPixels();
 
-			layer.image->Update(pixels, Rectui(glyph.rect.x + paddingX, glyph.rect.y + paddingY, glyphWidth, glyphHeight), 0, glyphWidth, glyphHeight);
+			target->Update(pixels, Rectui(glyph.rect.x + paddingX, glyph.rect.y + paddingY, glyphWidth, glyphHeight), 0, glyphWidth, glyphHeight);
 			glyph.image.Destroy(); // On libère l'image dès que possible (pour réduire la consommation)
 		}
 
 		layer.queuedGlyphs.clear();
+
+		if (staged)
+			layer.image->Update(layer.staging.GetConstPixels(updatedRect.x, updatedRect.y), updatedRect, 0, layer.staging.GetWidth(), layer.staging.GetHeight());
 	}
 }
@@ -5,11 +5,19 @@
 #include <Nazara/Utility/Image.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 #include <Nazara/Utility/Debug.hpp>
 
 ///TODO: Rajouter des warnings (Formats compressés avec les méthodes Copy/Update, tests taille dans Copy)
@@ -32,6 +40,289 @@ namespace Nz
 		{
 			return &base[(width*(height*z + y) + x)*bpp];
 		}
+
+		/*********************************Mipmaps*********************************/
+
+		struct MipmapFormat
+		{
+			unsigned int channelCount;
+			int alphaChannel;   // -1 without alpha
+			bool floatChannels; // 32 bits floats, 8 bits unsigned normalized otherwise
+		};
+
+		bool GetMipmapFormat(PixelFormatType format, MipmapFormat* mipmapFormat)
+		{
+			switch (format)
+			{
+				case PixelFormatType_A8:      *mipmapFormat = {1, 0, false};  return true;
+				case PixelFormatType_L8:
+				case PixelFormatType_R8:      *mipmapFormat = {1, -1, false}; return true;
+				case PixelFormatType_LA8:     *mipmapFormat = {2, 1, false};  return true;
+				case PixelFormatType_RG8:     *mipmapFormat = {2, -1, false}; return true;
+				case PixelFormatType_BGR8:
+				case PixelFormatType_RGB8:    *mipmapFormat = {3, -1, false}; return true;
+				case PixelFormatType_BGRA8:
+				case PixelFormatType_RGBA8:   *mipmapFormat = {4, 3, false};  return true;
+				case PixelFormatType_R32F:    *mipmapFormat = {1, -1, true};  return true;
+				case PixelFormatType_RG32F:   *mipmapFormat = {2, -1, true};  return true;
+				case PixelFormatType_RGB32F:  *mipmapFormat = {3, -1, true};  return true;
+				case PixelFormatType_RGBA32F: *mipmapFormat = {4, 3, true};   return true;
+
+				default:
+					return false;
+			}
+		}
+
+		struct ChannelTables
+		{
+			ChannelTables()
+			{
+				auto ToLinear = [] (float c)
+				{
+					return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+				};
+
+				for (unsigned int i = 0; i < 256; ++i)
+				{
+					linear[i] = i / 255.f;
+					srgbToLinear[i] = ToLinear(i / 255.f);
+				}
+
+				// A linear value is encoded to the nearest sRGB value, the thresholds being the middles between two consecutive ones
+				for (unsigned int i = 0; i < 255; ++i)
+					linearToSrgbThresholds[i] = ToLinear((i + 0.5f) / 255.f);
+			}
+
+			float linear[256];
+			float srgbToLinear[256];
+			float linearToSrgbThresholds[255];
+		};
+
+		const ChannelTables& GetChannelTables()
+		{
+			static ChannelTables tables;
+			return tables;
+		}
+
+		// Filter weights along one axis, from a source size to a destination size
+		struct MipmapAxis
+		{
+			std::vector<unsigned int> firstSamples;
+			std::vector<unsigned int> sampleCounts;
+			std::vector<std::size_t> weightOffsets;
+			std::vector<float> weights;
+		};
+
+		float BesselI0(float x)
+		{
+			// Power series, converging quickly for the small values of the Kaiser window
+			float sum = 1.f;
+			float term = 1.f;
+			float halfX = x * 0.5f;
+			for (unsigned int k = 1; k < 32; ++k)
+			{
+				term *= (halfX / k) * (halfX / k);
+				sum += term;
+				if (term < sum * 1e-7f)
+					break;
+			}
+
+			return sum;
+		}
+
+		float EvaluateKaiserFilter(float x)
+		{
+			// Sinc windowed by a Kaiser window of width 3 (alpha = 4)
+			constexpr float alpha = 4.f;
+			constexpr float width = 3.f;
+
+			if (std::abs(x) >= width)
+				return 0.f;
+
+			float sinc = (x == 0.f) ? 1.f : std::sin(float(M_PI) * x) / (float(M_PI) * x);
+			float ratio = x / width;
+
+			return sinc * BesselI0(alpha * std::sqrt(1.f - ratio * ratio)) / BesselI0(alpha);
+		}
+
+		MipmapAxis ComputeMipmapAxis(MipmapFilter filter, unsigned int srcSize, unsigned int dstSize)
+		{
+			MipmapAxis axis;
+			axis.firstSamples.resize(dstSize);
+			axis.sampleCounts.resize(dstSize);
+			axis.weightOffsets.resize(dstSize);
+
+			if (srcSize == dstSize)
+			{
+				// Axis not reduced (cubemap faces for example)
+				for (unsigned int i = 0; i < dstSize; ++i)
+				{
+					axis.firstSamples[i] = i;
+					axis.sampleCounts[i] = 1;
+					axis.weightOffsets[i] = 0;
+				}
+
+				axis.weights.push_back(1.f);
+				return axis;
+			}
+
+			float scale = float(srcSize) / dstSize;
+			float support = ((filter == MipmapFilter_Box) ? 0.5f : 3.f) * scale;
+
+			std::vector<float> weights(srcSize);
+			for (unsigned int i = 0; i < dstSize; ++i)
+			{
+				float center = (i + 0.5f) * scale;
+				int first = int(std::floor(center - support));
+				int last = int(std::ceil(center + support)) - 1;
+
+				std::fill(weights.begin(), weights.end(), 0.f);
+
+				float totalWeight = 0.f;
+				for (int j = first; j <= last; ++j)
+				{
+					float weight;
+					if (filter == MipmapFilter_Box)
+					{
+						// Exact coverage of the source pixel by the box, odd sizes included
+						float coverage = std::min(j + 1.f, center + support) - std::max(float(j), center - support);
+						weight = std::max(coverage, 0.f);
+					}
+					else
+						weight = EvaluateKaiserFilter((j + 0.5f - center) / scale);
+
+					// Samples outside of the image are clamped to its edges
+					weights[Clamp(j, 0, int(srcSize) - 1)] += weight;
+					totalWeight += weight;
+				}
+
+				unsigned int firstSample = Clamp(first, 0, int(srcSize) - 1);
+				unsigned int lastSample = Clamp(last, 0, int(srcSize) - 1);
+
+				axis.firstSamples[i] = firstSample;
+				axis.sampleCounts[i] = lastSample - firstSample + 1;
+				axis.weightOffsets[i] = axis.weights.size();
+				for (unsigned int j = firstSample; j <= lastSample; ++j)
+					axis.weights.push_back(weights[j] / totalWeight);
+			}
+
+			return axis;
+		}
+
+		void AccumulateMipmapRow(float* dst, const float* src, float weight, std::size_t count)
+		{
+			std::size_t i = 0;
+
+			#if defined(NAZARA_MATH_SSE2)
+			__m128 factor = _mm_set1_ps(weight);
+			for (; i + 4 <= count; i += 4)
+				_mm_storeu_ps(&dst[i], _mm_add_ps(_mm_loadu_ps(&dst[i]), _mm_mul_ps(_mm_loadu_ps(&src[i]), factor)));
+			#elif defined(NAZARA_MATH_NEON)
+			float32x4_t factor = vdupq_n_f32(weight);
+			for (; i + 4 <= count; i += 4)
+				vst1q_f32(&dst[i], vmlaq_f32(vld1q_f32(&dst[i]), vld1q_f32(&src[i]), factor));
+			#endif
+
+			for (; i < count; ++i)
+				dst[i] += src[i] * weight;
+		}
+
+		struct MipmapLevel
+		{
+			Vector3ui size;
+			float* values;                         // Level as (linear) floats
+			UInt8* bytes;                          // Level as 8 bits channels, when the format uses them
+			const float* decodingTables[4];        // 8 bits to float conversion of each channel
+			const float* encodingThresholds[4];    // Float to sRGB conversion of each channel, linear if null
+		};
+
+		// Computes a level from the previous one, row by row: the source rows are weighted and summed (vertical and depth filtering)
+		// into a row which is then filtered horizontally
+		void ResampleMipmapLevel(const MipmapLevel& src, const MipmapLevel& dst, unsigned int channelCount, MipmapFilter filter)
+		{
+			MipmapAxis axisX = ComputeMipmapAxis(filter, src.size.x, dst.size.x);
+			MipmapAxis axisY = ComputeMipmapAxis(filter, src.size.y, dst.size.y);
+			MipmapAxis axisZ = ComputeMipmapAxis(filter, src.size.z, dst.size.z);
+
+			std::size_t srcRowLength = std::size_t(src.size.x) * channelCount;
+			std::size_t dstRowLength = std::size_t(dst.size.x) * channelCount;
+			std::size_t rowCount = std::size_t(dst.size.y) * dst.size.z;
+
+			TaskScheduler::ParallelFor(0, rowCount, std::max<std::size_t>(64 * 1024 / srcRowLength, 1), [&] (std::size_t firstRow, std::size_t lastRow)
+			{
+				std::vector<float> sum(srcRowLength);
+				std::vector<float> decoded((src.values) ? 0 : srcRowLength);
+
+				for (std::size_t row = firstRow; row < lastRow; ++row)
+				{
+					unsigned int y = static_cast<unsigned int>(row % dst.size.y);
+					unsigned int z = static_cast<unsigned int>(row / dst.size.y);
+
+					std::fill(sum.begin(), sum.end(), 0.f);
+
+					const float* weightsZ = &axisZ.weights[axisZ.weightOffsets[z]];
+					const float* weightsY = &axisY.weights[axisY.weightOffsets[y]];
+					for (unsigned int kz = 0; kz < axisZ.sampleCounts[z]; ++kz)
+					{
+						for (unsigned int ky = 0; ky < axisY.sampleCounts[y]; ++ky)
+						{
+							std::size_t srcRow = (std::size_t(axisZ.firstSamples[z]) + kz) * src.size.y + axisY.firstSamples[y] + ky;
+
+							const float* values;
+							if (src.values)
+								values = &src.values[srcRow * srcRowLength];
+							else
+							{
+								const UInt8* bytes = &src.bytes[srcRow * srcRowLength];
+								for (std::size_t i = 0; i < srcRowLength; i += channelCount)
+								{
+									for (unsigned int c = 0; c < channelCount; ++c)
+										decoded[i + c] = src.decodingTables[c][bytes[i + c]];
+								}
+
+								values = decoded.data();
+							}
+
+							AccumulateMipmapRow(sum.data(), values, weightsZ[kz] * weightsY[ky], srcRowLength);
+						}
+					}
+
+					float* dstRow = &dst.values[row * dstRowLength];
+					for (unsigned int x = 0; x < dst.size.x; ++x)
+					{
+						const float* weights = &axisX.weights[axisX.weightOffsets[x]];
+						const float* srcPixel = &sum[std::size_t(axisX.firstSamples[x]) * channelCount];
+						for (unsigned int c = 0; c < channelCount; ++c)
+						{
+							float value = 0.f;
+							for (unsigned int k = 0; k < axisX.sampleCounts[x]; ++k)
+								value += srcPixel[k * channelCount + c] * weights[k];
+
+							dstRow[x * channelCount + c] = value;
+						}
+					}
+
+					if (dst.bytes)
+					{
+						UInt8* dstBytes = &dst.bytes[row * dstRowLength];
+						for (std::size_t i = 0; i < dstRowLength; i += channelCount)
+						{
+							for (unsigned int c = 0; c < channelCount; ++c)
+							{
+								// Clamped as the Kaiser filter overshoots near sharp edges
+								float value = Clamp(dstRow[i + c], 0.f, 1.f);
+
+								const float* thresholds = dst.encodingThresholds[c];
+								if (thresholds)
+									dstBytes[i + c] = static_cast<UInt8>(std::upper_bound(thresholds, thresholds + 255, value) - thresholds);
+								else
+									dstBytes[i + c] = static_cast<UInt8>(value * 255.f + 0.5f);
+							}
+						}
+					}
+				}
+			});
+		}
 	}
 
 	bool ImageParams::IsValid() const
@@ -105,26 +396,58 @@ namespace Nz
 		// Les images 3D et cubemaps sont stockés de la même façon
 		unsigned int depth = (m_sharedImage->type == ImageType_Cubemap) ? 6 : m_sharedImage->depth;
 
+		bool compressing = PixelFormat::IsCompressed(newFormat);
+		std::unique_ptr<UInt8[]> rgbaPixels;
+
 		for (unsigned int i = 0; i < levels.size(); ++i)
 		{
 			unsigned int pixelsPerFace = width * height;
-			levels[i].reset(new UInt8[pixelsPerFace * depth * PixelFormat::GetBytesPerPixel(newFormat)]);
-
-			UInt8* dst = levels[i].get();
 			UInt8* src = m_sharedImage->levels[i].get();
-			unsigned int srcStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(m_sharedImage->format);
-			unsigned int dstStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(newFormat);
 
-			for (unsigned int d = 0; d < depth; ++d)
+			if (compressing)
 			{
-				if (!PixelFormat::Convert(m_sharedImage->format, newFormat, src, &src[srcStride], dst))
+				// Blocks are compressed from RGBA8 texels, the first level being the largest buffer we need
+				if (m_sharedImage->format != PixelFormatType_RGBA8)
 				{
-					NazaraError("Failed to convert image");
+					if (!rgbaPixels)
+						rgbaPixels.reset(new UInt8[pixelsPerFace * depth * 4]);
+
+					unsigned int srcSize = pixelsPerFace * depth * PixelFormat::GetBytesPerPixel(m_sharedImage->format);
+					if (!PixelFormat::Convert(m_sharedImage->format, PixelFormatType_RGBA8, src, &src[srcSize], rgbaPixels.get()))
+					{
+						NazaraError("Failed to convert image");
+						return false;
+					}
+
+					src = rgbaPixels.get();
+				}
+
+				levels[i].reset(new UInt8[PixelFormat::ComputeSize(newFormat, width, height, depth)]);
+				if (!PixelFormat::Compress(newFormat, width, height, depth, src, levels[i].get()))
+				{
+					NazaraError("Failed to compress image");
 					return false;
 				}
+			}
+			else
+			{
+				levels[i].reset(new UInt8[pixelsPerFace * depth * PixelFormat::GetBytesPerPixel(newFormat)]);
+
+				UInt8* dst = levels[i].get();
+				unsigned int srcStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(m_sharedImage->format);
+				unsigned int dstStride = pixelsPerFace * PixelFormat::GetBytesPerPixel(newFormat);
 
-				src += srcStride;
-				dst += dstStride;
+				for (unsigned int d = 0; d < depth; ++d)
+				{
+					if (!PixelFormat::Convert(m_sharedImage->format, newFormat, src, &src[srcStride], dst))
+					{
+						NazaraError("Failed to convert image");
+						return false;
+					}
+
+					src += srcStride;
+					dst += dstStride;
+				}
 			}
 
 			if (width > 1)
@@ -546,12 +869,6 @@ namespace Nz
 			NazaraError("Image must be valid");
 			return false;
 		}
-
-		if (PixelFormat::IsCompressed(m_sharedImage->format))
-		{
-			NazaraError("Cannot flip compressed image");
-			return false;
-		}
 		#endif
 
 		EnsureOwnership();
@@ -581,6 +898,90 @@ namespace Nz
 		return true;
 	}
 
+	bool Image::GenerateMipmaps(MipmapFilter filter, bool sRGB)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (m_sharedImage == &emptyImage)
+		{
+			NazaraError("Image must be valid");
+			return false;
+		}
+
+		if (filter > MipmapFilter_Max)
+		{
+			NazaraError("Mipmap filter out of enum");
+			return false;
+		}
+		#endif
+
+		MipmapFormat mipmapFormat;
+		if (!GetMipmapFormat(m_sharedImage->format, &mipmapFormat))
+		{
+			NazaraError("Mipmap generation is not supported for " + PixelFormat::GetName(m_sharedImage->format) + " images");
+			return false;
+		}
+
+		UInt8 levelCount = GetMaxLevel();
+		SetLevelCount(levelCount);
+		EnsureOwnership();
+
+		auto GetLevelDimensions = [this] (UInt8 level)
+		{
+			return Vector3ui(GetLevelSize(m_sharedImage->width, level), GetLevelSize(m_sharedImage->height, level), (m_sharedImage->type == ImageType_Cubemap) ? 6 : GetLevelSize(m_sharedImage->depth, level));
+		};
+
+		unsigned int channelCount = mipmapFormat.channelCount;
+
+		MipmapLevel previousLevel;
+		previousLevel.size = GetLevelDimensions(0);
+
+		// 8 bits levels are computed from the previous one kept as (linear) floats, to avoid accumulating rounding errors,
+		// float levels are used directly
+		std::vector<float> previousValues;
+		std::vector<float> currentValues;
+		if (mipmapFormat.floatChannels)
+		{
+			previousLevel.values = reinterpret_cast<float*>(m_sharedImage->levels[0].get());
+			previousLevel.bytes = nullptr;
+		}
+		else
+		{
+			const ChannelTables& tables = GetChannelTables();
+			for (unsigned int c = 0; c < channelCount; ++c)
+			{
+				bool srgbChannel = (sRGB && int(c) != mipmapFormat.alphaChannel);
+				previousLevel.decodingTables[c] = (srgbChannel) ? tables.srgbToLinear : tables.linear;
+				previousLevel.encodingThresholds[c] = (srgbChannel) ? tables.linearToSrgbThresholds : nullptr;
+			}
+
+			previousLevel.values = nullptr; // Decoded on the fly
+			previousLevel.bytes = m_sharedImage->levels[0].get();
+		}
+
+		for (UInt8 level = 1; level < levelCount; ++level)
+		{
+			MipmapLevel currentLevel = previousLevel;
+			currentLevel.size = GetLevelDimensions(level);
+
+			if (mipmapFormat.floatChannels)
+				currentLevel.values = reinterpret_cast<float*>(m_sharedImage->levels[level].get());
+			else
+			{
+				currentValues.resize(std::size_t(currentLevel.size.x) * currentLevel.size.y * currentLevel.size.z * channelCount);
+
+				currentLevel.values = currentValues.data();
+				currentLevel.bytes = m_sharedImage->levels[level].get();
+			}
+
+			ResampleMipmapLevel(previousLevel, currentLevel, channelCount, filter);
+
+			std::swap(previousValues, currentValues);
+			previousLevel = currentLevel;
+		}
+
+		return true;
+	}
+
 	const UInt8* Image::GetConstPixels(unsigned int x, unsigned int y, unsigned int z, UInt8 level) const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -1422,6 +1823,40 @@ namespace Nz
 
 	}
 
+	bool Image::LoadViewFromMemory(ImageView* view, const void* data, std::size_t size, const ImageParams& params)
+	{
+		NazaraAssert(view, "Invalid view");
+		NazaraAssert(data, "Invalid data pointer");
+		NazaraAssert(params.IsValid(), "Invalid parameters");
+
+		for (auto& viewLoader : s_viewLoaders)
+		{
+			MemoryView stream(data, size);
+			if (viewLoader.first(stream, params) == Ternary_False)
+				continue;
+
+			if (!viewLoader.second(view, data, size, params))
+				continue;
+
+			// A conversion would need an image
+			return params.loadFormat == PixelFormatType_Undefined || params.loadFormat == view->format;
+		}
+
+		return false;
+	}
+
+	void Image::RegisterViewLoader(ImageLoader::StreamChecker checkFunc, ViewLoader viewLoader)
+	{
+		NazaraAssert(checkFunc && viewLoader, "Invalid view loader");
+
+		s_viewLoaders.emplace_front(checkFunc, viewLoader);
+	}
+
+	void Image::UnregisterViewLoader(ImageLoader::StreamChecker checkFunc, ViewLoader viewLoader)
+	{
+		s_viewLoaders.remove(std::make_pair(checkFunc, viewLoader));
+	}
+
 	void Image::EnsureOwnership()
 	{
 		if (m_sharedImage == &emptyImage)
@@ -1479,7 +1914,10 @@ namespace Nz
 	Image::SharedImage Image::emptyImage(0, ImageType_2D, PixelFormatType_Undefined, Image::SharedImage::PixelContainer(), 0, 0, 0);
 	ImageLibrary::LibraryMap Image::s_library;
 	ImageLoader::LoaderList Image::s_loaders;
+	ImageManager::ManagerCache Image::s_managerCache;
+	ImageManager::ManagerLoads Image::s_managerLoads;
 	ImageManager::ManagerMap Image::s_managerMap;
 	ImageManager::ManagerParams Image::s_managerParameters;
 	ImageSaver::SaverList Image::s_savers;
+	std::list<std::pair<ImageLoader::StreamChecker, Image::ViewLoader>> Image::s_viewLoaders;
 }
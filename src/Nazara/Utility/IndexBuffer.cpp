@@ -141,7 +141,7 @@ namespace Nz
 		}
 		#endif
 
-		return m_buffer->Map(access, offset, size);
+		return m_buffer->Map(access, m_startOffset + offset, (size == 0) ? m_endOffset - m_startOffset - offset : size);
 	}
 
 	void* IndexBuffer::MapRaw(BufferAccess access, unsigned int offset, unsigned int size) const
@@ -154,7 +154,7 @@ namespace Nz
 		}
 		#endif
 
-		return m_buffer->Map(access, offset, size);
+		return m_buffer->Map(access, m_startOffset + offset, (size == 0) ? m_endOffset - m_startOffset - offset : size);
 	}
 
 	void IndexBuffer::Optimize()
@@ -171,7 +171,7 @@ namespace Nz
 
 	void IndexBuffer::Reset(bool largeIndices, Buffer* buffer)
 	{
-		Reset(largeIndices, buffer, 0, buffer->GetSize()-1);
+		Reset(largeIndices, buffer, 0, buffer->GetSize());
 	}
 
 	void IndexBuffer::Reset(bool largeIndices, Buffer* buffer, unsigned int startOffset, unsigned int endOffset)
@@ -196,7 +196,7 @@ namespace Nz
 			return;
 		}
 
-		if (endOffset >= bufferSize)
+		if (endOffset > bufferSize)
 		{
 			NazaraError("End offset is over buffer size");
 			return;
@@ -61,6 +61,8 @@ namespace Nz
 	{
 		m_inverseBindMatrix = matrix;
 		m_skinningMatrixUpdated = false;
+
+		m_skeleton->InvalidateSkinningMatrices();
 	}
 
 	void Joint::SetName(const String& name)
@@ -75,6 +77,16 @@ namespace Nz
 		Node::InvalidateNode();
 
 		m_skinningMatrixUpdated = false;
+
+		// Roots may be moved by a node outside of the skeleton, the palette has to notice it as well
+		m_skeleton->InvalidateSkinningMatrices();
+	}
+
+	void Joint::OnParenting(const Node* parent)
+	{
+		Node::OnParenting(parent);
+
+		m_skeleton->InvalidateJointOrder();
 	}
 
 	void Joint::UpdateSkinningMatrix() const
@@ -12,6 +12,7 @@
 #include <Nazara/Utility/Buffer.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/MeshBufferPool.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
@@ -21,6 +22,7 @@
 #include <limits>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -45,6 +47,12 @@ namespace Nz
 			return false;
 		}
 
+		if (levelOfDetailCount > 0 && (levelOfDetailReduction <= 0.f || levelOfDetailReduction >= 1.f))
+		{
+			NazaraError("Level of detail reduction must be between 0 and 1");
+			return false;
+		}
+
 		return true;
 	}
 
@@ -264,8 +272,7 @@ namespace Nz
 			return nullptr;
 		}
 
-		if (params.optimizeIndexBuffers)
-			indexBuffer->Optimize();
+		OptimizeMeshBuffers(indexBuffer, vertexBuffer, params);
 
 		subMesh->SetAABB(aabb);
 		subMesh->SetIndexBuffer(indexBuffer);
@@ -280,6 +287,24 @@ namespace Nz
 			BuildSubMesh(list.GetPrimitive(i), params);
 	}
 
+	void Mesh::CompactVertices()
+	{
+		NazaraAssert(m_impl, "Mesh should be created first");
+
+		// Skinning reads float components, only static meshes are compacted
+		if (m_impl->animationType != AnimationType_Static)
+			return;
+
+		// Vertex buffers may be shared between submeshes
+		std::unordered_set<VertexBuffer*> vertexBuffers;
+		for (SubMesh* subMesh : m_impl->subMeshes)
+		{
+			VertexBuffer* vertexBuffer = static_cast<StaticMesh*>(subMesh)->GetVertexBuffer();
+			if (vertexBuffers.insert(vertexBuffer).second)
+				Nz::CompactVertices(vertexBuffer);
+		}
+	}
+
 	bool Mesh::CreateSkeletal(unsigned int jointCount)
 	{
 		Destroy();
@@ -343,6 +368,22 @@ namespace Nz
 			subMesh->GenerateTangents();
 	}
 
+	void Mesh::GenerateLevelsOfDetail(unsigned int levelCount, float reduction, float screenSize)
+	{
+		NazaraAssert(m_impl, "Mesh should be created first");
+
+		// Skinned vertices move, only static meshes get simplified versions
+		if (m_impl->animationType != AnimationType_Static)
+			return;
+
+		for (SubMesh* subMesh : m_impl->subMeshes)
+		{
+			StaticMesh* staticMesh = static_cast<StaticMesh*>(subMesh);
+			if (staticMesh->GetIndexBuffer() && staticMesh->GetPrimitiveMode() == PrimitiveMode_TriangleList)
+				staticMesh->GenerateLevelsOfDetail(levelCount, reduction, screenSize);
+		}
+	}
+
 	const Boxf& Mesh::GetAABB() const
 	{
 		NazaraAssert(m_impl, "Mesh should be created first");
@@ -410,6 +451,31 @@ namespace Nz
 		return m_impl->materialData.size();
 	}
 
+	std::size_t Mesh::GetMemoryUsage() const
+	{
+		if (!m_impl)
+			return 0;
+
+		std::size_t memoryUsage = 0;
+		for (SubMesh* subMesh : m_impl->subMeshes)
+		{
+			const VertexBuffer* vertexBuffer;
+			if (m_impl->animationType == AnimationType_Skeletal)
+				vertexBuffer = static_cast<SkeletalMesh*>(subMesh)->GetVertexBuffer();
+			else
+				vertexBuffer = static_cast<StaticMesh*>(subMesh)->GetVertexBuffer();
+
+			if (vertexBuffer)
+				memoryUsage += vertexBuffer->GetStride() * vertexBuffer->GetVertexCount();
+
+			const IndexBuffer* indexBuffer = subMesh->GetIndexBuffer();
+			if (indexBuffer)
+				memoryUsage += indexBuffer->GetStride() * indexBuffer->GetIndexCount();
+		}
+
+		return memoryUsage;
+	}
+
 	Skeleton* Mesh::GetSkeleton()
 	{
 		NazaraAssert(m_impl, "Mesh should be created first");
@@ -536,17 +602,59 @@ namespace Nz
 
 	bool Mesh::LoadFromFile(const String& filePath, const MeshParams& params)
 	{
-		return MeshLoader::LoadFromFile(this, filePath, params);
+		if (!MeshLoader::LoadFromFile(this, filePath, params))
+			return false;
+
+		if (params.levelOfDetailCount > 0)
+			GenerateLevelsOfDetail(params.levelOfDetailCount, params.levelOfDetailReduction, params.levelOfDetailScreenSize);
+
+		// Mesh algorithms expect float components
+		if (params.compactVertices)
+			CompactVertices();
+
+		// Last step, the buffers are final
+		if (params.bufferPool && !IsAnimable())
+			params.bufferPool->Store(this);
+
+		return true;
 	}
 
 	bool Mesh::LoadFromMemory(const void* data, std::size_t size, const MeshParams& params)
 	{
-		return MeshLoader::LoadFromMemory(this, data, size, params);
+		if (!MeshLoader::LoadFromMemory(this, data, size, params))
+			return false;
+
+		if (params.levelOfDetailCount > 0)
+			GenerateLevelsOfDetail(params.levelOfDetailCount, params.levelOfDetailReduction, params.levelOfDetailScreenSize);
+
+		// Mesh algorithms expect float components
+		if (params.compactVertices)
+			CompactVertices();
+
+		// Last step, the buffers are final
+		if (params.bufferPool && !IsAnimable())
+			params.bufferPool->Store(this);
+
+		return true;
 	}
 
 	bool Mesh::LoadFromStream(Stream& stream, const MeshParams& params)
 	{
-		return MeshLoader::LoadFromStream(this, stream, params);
+		if (!MeshLoader::LoadFromStream(this, stream, params))
+			return false;
+
+		if (params.levelOfDetailCount > 0)
+			GenerateLevelsOfDetail(params.levelOfDetailCount, params.levelOfDetailReduction, params.levelOfDetailScreenSize);
+
+		// Mesh algorithms expect float components
+		if (params.compactVertices)
+			CompactVertices();
+
+		// Last step, the buffers are final
+		if (params.bufferPool && !IsAnimable())
+			params.bufferPool->Store(this);
+
+		return true;
 	}
 
 	void Mesh::Recenter()
@@ -705,6 +813,8 @@ namespace Nz
 
 	MeshLibrary::LibraryMap Mesh::s_library;
 	MeshLoader::LoaderList Mesh::s_loaders;
+	MeshManager::ManagerCache Mesh::s_managerCache;
+	MeshManager::ManagerLoads Mesh::s_managerLoads;
 	MeshManager::ManagerMap Mesh::s_managerMap;
 	MeshManager::ManagerParams Mesh::s_managerParameters;
 	MeshSaver::SaverList Mesh::s_savers;
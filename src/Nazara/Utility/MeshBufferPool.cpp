@@ -0,0 +1,410 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/MeshBufferPool.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <algorithm>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	/*!
+	* \ingroup utility
+	* \class Nz::MeshBufferPool
+	* \brief Utility class suballocating the index and vertex buffers of static meshes from large shared buffers
+	*
+	* \remark Pooled buffers give their range back when they are released, the shared buffers live as long as one of their ranges is used
+	* \remark This class is thread-safe, meshes can be stored from the threads loading them
+	*/
+
+	/*!
+	* \brief Constructs a MeshBufferPool object
+	*
+	* \param storage Storage of the shared buffers
+	* \param blockSize Size of the shared buffers, geometry bigger than this gets a shared buffer of its own
+	*/
+
+	MeshBufferPool::MeshBufferPool(UInt32 storage, unsigned int blockSize) :
+	m_storage(storage),
+	m_usedSize(0),
+	m_blockSize(blockSize)
+	{
+		NazaraAssert(blockSize > 0, "Invalid block size");
+
+		m_indexPools[0].stride = sizeof(UInt16);
+		m_indexPools[1].stride = sizeof(UInt32);
+	}
+
+	MeshBufferPool::~MeshBufferPool() = default;
+
+	/*!
+	* \brief Allocates indices from a shared buffer
+	* \return Index buffer viewing its range of the shared buffer, or a null reference if the allocation failed
+	*
+	* \param largeIndices Should indices be 32 bits wide
+	* \param indexCount Number of indices
+	*/
+
+	IndexBufferRef MeshBufferPool::AllocateIndices(bool largeIndices, unsigned int indexCount)
+	{
+		NazaraAssert(indexCount > 0, "Invalid index count");
+
+		Pool& pool = m_indexPools[(largeIndices) ? 1 : 0];
+		unsigned int size = indexCount * pool.stride;
+
+		LockGuard lock(m_mutex);
+
+		Block* block;
+		unsigned int offset;
+		if (!Allocate(pool, BufferType_Index, size, &block, &offset))
+			return nullptr;
+
+		IndexBufferRef indexBuffer = IndexBuffer::New(largeIndices, block->buffer, offset, offset + size);
+
+		Allocation& allocation = Track(indexBuffer, pool, block, offset, size);
+		allocation.onIndexBufferReleaseSlot.Connect(indexBuffer->OnIndexBufferRelease, [this] (const IndexBuffer* releasedBuffer) { Free(releasedBuffer); });
+
+		return indexBuffer;
+	}
+
+	/*!
+	* \brief Allocates vertices from a shared buffer, along with the other vertices of the same declaration
+	* \return Vertex buffer viewing its range of the shared buffer, or a null reference if the allocation failed
+	*
+	* \param vertexDeclaration Declaration of the vertices
+	* \param vertexCount Number of vertices
+	*/
+
+	VertexBufferRef MeshBufferPool::AllocateVertices(const VertexDeclaration* vertexDeclaration, unsigned int vertexCount)
+	{
+		NazaraAssert(vertexDeclaration, "Invalid vertex declaration");
+		NazaraAssert(vertexCount > 0, "Invalid vertex count");
+
+		LockGuard lock(m_mutex);
+
+		Pool& pool = m_vertexPools[vertexDeclaration];
+		if (!pool.vertexDeclaration)
+		{
+			pool.vertexDeclaration = vertexDeclaration;
+			pool.stride = vertexDeclaration->GetStride();
+		}
+
+		unsigned int size = vertexCount * pool.stride;
+
+		Block* block;
+		unsigned int offset;
+		if (!Allocate(pool, BufferType_Vertex, size, &block, &offset))
+			return nullptr;
+
+		VertexBufferRef vertexBuffer = VertexBuffer::New(vertexDeclaration, block->buffer, offset, offset + size);
+
+		Allocation& allocation = Track(vertexBuffer, pool, block, offset, size);
+		allocation.onVertexBufferReleaseSlot.Connect(vertexBuffer->OnVertexBufferRelease, [this] (const VertexBuffer* releasedBuffer) { Free(releasedBuffer); });
+
+		return vertexBuffer;
+	}
+
+	/*!
+	* \brief Gets the number of shared buffers
+	*/
+
+	unsigned int MeshBufferPool::GetBlockCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		std::size_t blockCount = m_indexPools[0].blocks.size() + m_indexPools[1].blocks.size();
+		for (const auto& pair : m_vertexPools)
+			blockCount += pair.second.blocks.size();
+
+		return static_cast<unsigned int>(blockCount);
+	}
+
+	unsigned int MeshBufferPool::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	UInt32 MeshBufferPool::GetStorage() const
+	{
+		return m_storage;
+	}
+
+	/*!
+	* \brief Gets the size of the ranges used by pooled buffers
+	*/
+
+	UInt64 MeshBufferPool::GetUsedSize() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_usedSize;
+	}
+
+	bool MeshBufferPool::IsPooled(const IndexBuffer* indexBuffer) const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_allocations.find(indexBuffer) != m_allocations.end();
+	}
+
+	bool MeshBufferPool::IsPooled(const VertexBuffer* vertexBuffer) const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_allocations.find(vertexBuffer) != m_allocations.end();
+	}
+
+	/*!
+	* \brief Moves the geometry of every submesh of a static mesh to shared buffers
+	* \return true If successful
+	*
+	* \param mesh Static mesh, whose processing (optimization, compaction, levels of detail) should be done
+	*
+	* \see Store(StaticMesh*)
+	*/
+
+	bool MeshBufferPool::Store(Mesh* mesh)
+	{
+		NazaraAssert(mesh && mesh->IsValid(), "Invalid mesh");
+
+		if (mesh->GetAnimationType() != AnimationType_Static)
+		{
+			NazaraError("Only static meshes can be pooled");
+			return false;
+		}
+
+		for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+		{
+			if (!Store(static_cast<StaticMesh*>(mesh->GetSubMesh(i))))
+			{
+				NazaraError("Failed to store submesh #" + String::Number(i));
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Moves the geometry of a static mesh to shared buffers
+	* \return true If successful
+	*
+	* \param staticMesh Static mesh, whose processing (optimization, compaction, levels of detail) should be done
+	*
+	* \remark The vertex buffer is reset in place (and may be shared with other submeshes), index buffers are replaced
+	* \remark Buffers already pooled by this pool are kept
+	*/
+
+	bool MeshBufferPool::Store(StaticMesh* staticMesh)
+	{
+		NazaraAssert(staticMesh && staticMesh->IsValid(), "Invalid static mesh");
+
+		if (!IsPooled(staticMesh->GetVertexBuffer()) && !StoreVertices(staticMesh->GetVertexBuffer()))
+			return false;
+
+		const IndexBuffer* indexBuffer = staticMesh->GetIndexBuffer();
+		if (!indexBuffer || IsPooled(indexBuffer))
+			return true;
+
+		// Changing the indices drops the levels of detail, they are stored then added back
+		std::vector<std::pair<IndexBufferRef, float>> levelsOfDetail;
+		levelsOfDetail.reserve(staticMesh->GetLevelOfDetailCount() - 1);
+
+		for (unsigned int i = 1; i < staticMesh->GetLevelOfDetailCount(); ++i)
+		{
+			IndexBufferRef pooledBuffer;
+			if (!StoreIndices(staticMesh->GetIndexBuffer(i), &pooledBuffer))
+				return false;
+
+			levelsOfDetail.emplace_back(std::move(pooledBuffer), staticMesh->GetLevelOfDetailScreenSize(i));
+		}
+
+		IndexBufferRef pooledBuffer;
+		if (!StoreIndices(indexBuffer, &pooledBuffer))
+			return false;
+
+		staticMesh->SetIndexBuffer(pooledBuffer);
+		for (auto& pair : levelsOfDetail)
+			staticMesh->AddLevelOfDetail(pair.first, pair.second);
+
+		return true;
+	}
+
+	/*!
+	* \brief Finds a free range in the blocks of a pool, creating a new block if none fits
+	* \return true If successful
+	*
+	* \remark The mutex must be locked
+	*/
+
+	bool MeshBufferPool::Allocate(Pool& pool, BufferType type, unsigned int size, Block** block, unsigned int* offset)
+	{
+		// Ranges are whole numbers of elements, so offsets between meshes are too (base vertex and first index of multi-draw calls)
+		NazaraAssert(size % pool.stride == 0, "Size must be a multiple of the stride");
+
+		for (const std::unique_ptr<Block>& poolBlock : pool.blocks)
+		{
+			auto it = std::find_if(poolBlock->freeRanges.begin(), poolBlock->freeRanges.end(), [size] (const Range& range) { return range.size >= size; });
+			if (it == poolBlock->freeRanges.end())
+				continue;
+
+			*block = poolBlock.get();
+			*offset = it->offset;
+
+			it->offset += size;
+			it->size -= size;
+			if (it->size == 0)
+				poolBlock->freeRanges.erase(it);
+
+			return true;
+		}
+
+		unsigned int blockSize = std::max(m_blockSize - m_blockSize % pool.stride, size);
+
+		std::unique_ptr<Block> newBlock(new Block);
+		newBlock->buffer = Buffer::New(type);
+		if (!newBlock->buffer->Create(blockSize, m_storage, BufferUsage_Static))
+		{
+			NazaraError("Failed to create shared buffer");
+			return false;
+		}
+
+		if (blockSize > size)
+			newBlock->freeRanges.push_back(Range{size, blockSize - size});
+
+		*block = newBlock.get();
+		*offset = 0;
+
+		pool.blocks.emplace_back(std::move(newBlock));
+		return true;
+	}
+
+	/*!
+	* \brief Gives the range of a pooled buffer back to its block, destroying the block once it is unused
+	*
+	* \param buffer Released index or vertex buffer
+	*/
+
+	void MeshBufferPool::Free(const void* buffer)
+	{
+		LockGuard lock(m_mutex);
+
+		auto it = m_allocations.find(buffer);
+		if (it == m_allocations.end())
+			return;
+
+		Allocation& allocation = it->second;
+		Block* block = allocation.block;
+		Pool* pool = allocation.pool;
+
+		auto rangeIt = std::lower_bound(block->freeRanges.begin(), block->freeRanges.end(), allocation.offset, [] (const Range& range, unsigned int offset) { return range.offset < offset; });
+		rangeIt = block->freeRanges.insert(rangeIt, Range{allocation.offset, allocation.size});
+
+		// Merge with the following range, then with the previous one
+		auto nextIt = rangeIt + 1;
+		if (nextIt != block->freeRanges.end() && rangeIt->offset + rangeIt->size == nextIt->offset)
+		{
+			rangeIt->size += nextIt->size;
+			rangeIt = block->freeRanges.erase(nextIt) - 1;
+		}
+
+		if (rangeIt != block->freeRanges.begin())
+		{
+			auto previousIt = rangeIt - 1;
+			if (previousIt->offset + previousIt->size == rangeIt->offset)
+			{
+				previousIt->size += rangeIt->size;
+				block->freeRanges.erase(rangeIt);
+			}
+		}
+
+		m_usedSize -= allocation.size;
+
+		// The slot of the released buffer is being called, the signal defers its destruction
+		m_allocations.erase(it);
+
+		if (block->freeRanges.size() == 1 && block->freeRanges.front().size == block->buffer->GetSize())
+		{
+			auto blockIt = std::find_if(pool->blocks.begin(), pool->blocks.end(), [block] (const std::unique_ptr<Block>& poolBlock) { return poolBlock.get() == block; });
+			pool->blocks.erase(blockIt);
+		}
+	}
+
+	bool MeshBufferPool::StoreIndices(const IndexBuffer* indexBuffer, IndexBufferRef* pooledBuffer)
+	{
+		*pooledBuffer = AllocateIndices(indexBuffer->HasLargeIndices(), indexBuffer->GetIndexCount());
+		if (!pooledBuffer->IsValid())
+			return false;
+
+		BufferMapper<IndexBuffer> mapper(indexBuffer, BufferAccess_ReadOnly);
+		return (*pooledBuffer)->Fill(mapper.GetPointer(), 0, indexBuffer->GetIndexCount());
+	}
+
+	bool MeshBufferPool::StoreVertices(VertexBuffer* vertexBuffer)
+	{
+		const VertexDeclaration* vertexDeclaration = vertexBuffer->GetVertexDeclaration();
+		unsigned int size = vertexBuffer->GetVertexCount() * vertexDeclaration->GetStride();
+
+		Pool* pool;
+		Block* block;
+		unsigned int offset;
+		{
+			LockGuard lock(m_mutex);
+
+			pool = &m_vertexPools[vertexDeclaration];
+			if (!pool->vertexDeclaration)
+			{
+				pool->vertexDeclaration = vertexDeclaration;
+				pool->stride = vertexDeclaration->GetStride();
+			}
+
+			if (!Allocate(*pool, BufferType_Vertex, size, &block, &offset))
+				return false;
+
+			Allocation& allocation = Track(vertexBuffer, *pool, block, offset, size);
+			allocation.onVertexBufferReleaseSlot.Connect(vertexBuffer->OnVertexBufferRelease, [this] (const VertexBuffer* releasedBuffer) { Free(releasedBuffer); });
+		}
+
+		// The buffer is reset in place, the submeshes sharing it (and their users) see the pooled vertices
+		BufferRef buffer = block->buffer;
+		{
+			BufferMapper<VertexBuffer> mapper(vertexBuffer, BufferAccess_ReadOnly);
+			if (!buffer->Fill(mapper.GetPointer(), offset, size))
+			{
+				NazaraError("Failed to fill shared buffer");
+
+				mapper.Unmap();
+				Free(vertexBuffer);
+				return false;
+			}
+		}
+
+		vertexBuffer->Reset(vertexDeclaration, buffer, offset, offset + size);
+		return true;
+	}
+
+	/*!
+	* \brief Registers a range as used by a pooled buffer
+	* \return Allocation of the buffer, whose release slot must be connected
+	*
+	* \remark The mutex must be locked
+	*/
+
+	MeshBufferPool::Allocation& MeshBufferPool::Track(const void* buffer, Pool& pool, Block* block, unsigned int offset, unsigned int size)
+	{
+		Allocation& allocation = m_allocations[buffer];
+		allocation.block = block;
+		allocation.offset = offset;
+		allocation.pool = &pool;
+		allocation.size = size;
+
+		m_usedSize += size;
+
+		return allocation;
+	}
+}
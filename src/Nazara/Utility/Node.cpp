@@ -3,10 +3,18 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Node.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/NodeHierarchy.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Moving a node is cheap, workers need many of them to be worth waking up
+		const std::size_t s_movedNodesPerTask = 4096;
+	}
+
 	Node::Node() :
 	m_initialRotation(Quaternionf::Identity()),
 	m_rotation(Quaternionf::Identity()),
@@ -19,7 +27,9 @@ namespace Nz
 	m_inheritPosition(true),
 	m_inheritRotation(true),
 	m_inheritScale(true),
-	m_transformMatrixUpdated(false)
+	m_transformMatrixUpdated(false),
+	m_hierarchy(nullptr),
+	m_hierarchyIndex(NodeHierarchy::InvalidIndex)
 	{
 	}
 
@@ -35,7 +45,9 @@ namespace Nz
 	m_inheritPosition(node.m_inheritPosition),
 	m_inheritRotation(node.m_inheritRotation),
 	m_inheritScale(node.m_inheritScale),
-	m_transformMatrixUpdated(false)
+	m_transformMatrixUpdated(false),
+	m_hierarchy(nullptr),
+	m_hierarchyIndex(NodeHierarchy::InvalidIndex)
 	{
 		SetParent(node.m_parent, false);
 	}
@@ -44,10 +56,16 @@ namespace Nz
 	{
 		OnNodeRelease(this);
 
+		if (m_hierarchy)
+			m_hierarchy->RemoveNode(this);
+
 		for (Node* child : m_childs)
 		{
 			// child->SetParent(nullptr); serait problématique car elle nous appellerait
 			child->m_parent = nullptr;
+			if (child->m_hierarchy)
+				child->m_hierarchy->InvalidateOrder();
+
 			child->InvalidateNode();
 			child->OnParenting(nullptr);
 		}
@@ -57,20 +75,25 @@ namespace Nz
 
 	void Node::EnsureDerivedUpdate() const
 	{
+		if (m_hierarchy && m_hierarchy->HasPendingInvalidations())
+			InvalidateFromHierarchy();
+
 		if (!m_derivedUpdated)
 			UpdateDerived();
 	}
 
 	void Node::EnsureTransformMatrixUpdate() const
 	{
+		if (m_hierarchy && m_hierarchy->HasPendingInvalidations())
+			InvalidateFromHierarchy();
+
 		if (!m_transformMatrixUpdated)
 			UpdateTransformMatrix();
 	}
 
 	Vector3f Node::GetBackward() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Backward();
 	}
@@ -82,16 +105,14 @@ namespace Nz
 
 	Vector3f Node::GetDown() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Down();
 	}
 
 	Vector3f Node::GetForward() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Forward();
 	}
@@ -128,8 +149,7 @@ namespace Nz
 
 	Vector3f Node::GetLeft() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Left();
 	}
@@ -139,6 +159,11 @@ namespace Nz
 		return NodeType_Default;
 	}
 
+	const NodeHierarchy* Node::GetHierarchy() const
+	{
+		return m_hierarchy;
+	}
+
 	const Node* Node::GetParent() const
 	{
 		return m_parent;
@@ -149,8 +174,7 @@ namespace Nz
 		switch (coordSys)
 		{
 			case CoordSys_Global:
-				if (!m_derivedUpdated)
-					UpdateDerived();
+				EnsureDerivedUpdate();
 
 				return m_derivedPosition;
 
@@ -164,8 +188,7 @@ namespace Nz
 
 	Vector3f Node::GetRight() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Right();
 	}
@@ -175,8 +198,7 @@ namespace Nz
 		switch (coordSys)
 		{
 			case CoordSys_Global:
-				if (!m_derivedUpdated)
-					UpdateDerived();
+				EnsureDerivedUpdate();
 
 				return m_derivedRotation;
 
@@ -193,8 +215,7 @@ namespace Nz
 		switch (coordSys)
 		{
 			case CoordSys_Global:
-				if (!m_derivedUpdated)
-					UpdateDerived();
+				EnsureDerivedUpdate();
 
 				return m_derivedScale;
 
@@ -208,16 +229,14 @@ namespace Nz
 
 	const Matrix4f& Node::GetTransformMatrix() const
 	{
-		if (!m_transformMatrixUpdated)
-			UpdateTransformMatrix();
+		EnsureTransformMatrixUpdate();
 
 		return m_transformMatrix;
 	}
 
 	Vector3f Node::GetUp() const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * Vector3f::Up();
 	}
@@ -232,11 +251,9 @@ namespace Nz
 		switch (coordSys)
 		{
 			case CoordSys_Global:
-				if (!nodeA.m_derivedUpdated)
-					nodeA.UpdateDerived();
+				nodeA.EnsureDerivedUpdate();
 
-				if (!nodeB.m_derivedUpdated)
-					nodeB.UpdateDerived();
+				nodeB.EnsureDerivedUpdate();
 
 				m_position = ToLocalPosition(Vector3f::Lerp(nodeA.m_derivedPosition, nodeB.m_derivedPosition, interpolation));
 				m_rotation = ToLocalRotation(Quaternionf::Slerp(nodeA.m_derivedRotation, nodeB.m_derivedRotation, interpolation));
@@ -262,8 +279,7 @@ namespace Nz
 			{
 				if (m_parent)
 				{
-					if (!m_parent->m_derivedUpdated)
-						m_parent->UpdateDerived();
+					m_parent->EnsureDerivedUpdate();
 
 					m_position += (m_parent->m_derivedRotation.GetConjugate()*(movement - m_parent->m_derivedPosition))/m_parent->m_derivedScale; // Compensation
 				}
@@ -297,8 +313,7 @@ namespace Nz
 		{
 			case CoordSys_Global:
 			{
-				if (!m_derivedUpdated)
-					UpdateDerived();
+				EnsureDerivedUpdate();
 
 				m_rotation *= m_derivedRotation.GetInverse() * q * m_derivedRotation; ///FIXME: Correct ?
 				break;
@@ -437,10 +452,12 @@ namespace Nz
 		if (m_parent == node)
 			return;
 
+		if (m_hierarchy)
+			m_hierarchy->InvalidateOrder();
+
 		if (keepDerived)
 		{
-			if (!m_derivedUpdated)
-				UpdateDerived();
+			EnsureDerivedUpdate();
 
 			if (m_parent)
 				m_parent->RemoveChild(this);
@@ -480,8 +497,7 @@ namespace Nz
 			case CoordSys_Global:
 				if (m_parent && m_inheritPosition)
 				{
-					if (!m_parent->m_derivedUpdated)
-						m_parent->UpdateDerived();
+					m_parent->EnsureDerivedUpdate();
 
 					m_position = (m_parent->m_derivedRotation.GetConjugate()*(position - m_parent->m_derivedPosition))/m_parent->m_derivedScale - m_initialPosition;
 				}
@@ -559,6 +575,49 @@ namespace Nz
 		SetScale(Vector3f(scaleX, scaleY, scaleZ), coordSys);
 	}
 
+	void Node::SetTransform(const Vector3f& position, const Quaternionf& rotation, const Vector3f& scale, CoordSys coordSys)
+	{
+		// Same as SetPosition, SetRotation and SetScale, but the node (and its childs) are only invalidated once
+		Quaternionf q(rotation);
+		q.Normalize();
+
+		switch (coordSys)
+		{
+			case CoordSys_Global:
+				if (m_parent && m_inheritPosition)
+				{
+					m_parent->EnsureDerivedUpdate();
+
+					m_position = (m_parent->m_derivedRotation.GetConjugate()*(position - m_parent->m_derivedPosition))/m_parent->m_derivedScale - m_initialPosition;
+				}
+				else
+					m_position = position - m_initialPosition;
+
+				if (m_parent && m_inheritRotation)
+				{
+					Quaternionf rot(m_parent->GetRotation() * m_initialRotation);
+
+					m_rotation = rot.GetConjugate() * q;
+				}
+				else
+					m_rotation = q;
+
+				if (m_parent && m_inheritScale)
+					m_scale = scale / (m_initialScale * m_parent->GetScale());
+				else
+					m_scale = scale / m_initialScale;
+				break;
+
+			case CoordSys_Local:
+				m_position = position;
+				m_rotation = q;
+				m_scale = scale;
+				break;
+		}
+
+		InvalidateNode();
+	}
+
 	void Node::SetTransformMatrix(const Matrix4f& matrix)
 	{
 		SetPosition(matrix.GetTranslation(), CoordSys_Global);
@@ -571,48 +630,42 @@ namespace Nz
 
 	Vector3f Node::ToGlobalPosition(const Vector3f& localPosition) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedPosition + (m_derivedScale * (m_derivedRotation * localPosition));
 	}
 
 	Quaternionf Node::ToGlobalRotation(const Quaternionf& localRotation) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation * localRotation;
 	}
 
 	Vector3f Node::ToGlobalScale(const Vector3f& localScale) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedScale * localScale;
 	}
 
 	Vector3f Node::ToLocalPosition(const Vector3f& globalPosition) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return (m_derivedRotation.GetConjugate()*(globalPosition - m_derivedPosition))/m_derivedScale;
 	}
 
 	Quaternionf Node::ToLocalRotation(const Quaternionf& globalRotation) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return m_derivedRotation.GetConjugate() * globalRotation;
 	}
 
 	Vector3f Node::ToLocalScale(const Vector3f& globalScale) const
 	{
-		if (!m_derivedUpdated)
-			UpdateDerived();
+		EnsureDerivedUpdate();
 
 		return globalScale / m_derivedScale;
 	}
@@ -636,6 +689,49 @@ namespace Nz
 		return *this;
 	}
 
+	// Same as calling Move(movements[i]) on each node (in local coordinates), the nodes must all be different
+	// Nodes sharing the hierarchy of the first one are only marked, their OnNodeInvalidation signal is emitted by its next update
+	// and InvalidateNode is not called for them
+	void Node::MoveNodes(Node* const* nodes, const Vector3f* movements, std::size_t count)
+	{
+		if (count == 0)
+			return;
+
+		NodeHierarchy* hierarchy = nodes[0]->m_hierarchy;
+
+		// Each node is only visited once by the workers, the others nodes are moved afterwards
+		std::size_t skippedCount = TaskScheduler::ParallelReduce(std::size_t(0), count, s_movedNodesPerTask, std::size_t(0), [=] (std::size_t first, std::size_t last, std::size_t skipped)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Node* node = nodes[i];
+				if (!hierarchy || node->m_hierarchy != hierarchy)
+				{
+					skipped++;
+					continue;
+				}
+
+				node->m_position += node->m_rotation * movements[i];
+
+				hierarchy->InvalidatePosition(node);
+			}
+
+			return skipped;
+		}, [] (std::size_t skipped1, std::size_t skipped2) { return skipped1 + skipped2; });
+
+		if (hierarchy)
+			hierarchy->m_pendingInvalidations = true;
+
+		if (skippedCount > 0)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				if (!hierarchy || nodes[i]->m_hierarchy != hierarchy)
+					nodes[i]->Move(movements[i]);
+			}
+		}
+	}
+
 	void Node::AddChild(Node* node) const
 	{
 		#ifdef NAZARA_DEBUG
@@ -649,13 +745,41 @@ namespace Nz
 		m_childs.push_back(node);
 	}
 
+	void Node::InvalidateFromHierarchy() const
+	{
+		// Our ancestors may have been moved since the last update of the hierarchy without invalidating us,
+		// everything below the topmost one has to be recomputed
+		const Node* invalidatedAncestor = nullptr;
+		for (const Node* node = this; node && node->m_hierarchy == m_hierarchy; node = node->m_parent)
+		{
+			if (m_hierarchy->IsInvalidated(node->m_hierarchyIndex))
+				invalidatedAncestor = node;
+		}
+
+		if (invalidatedAncestor)
+		{
+			for (const Node* node = this; node != invalidatedAncestor->m_parent; node = node->m_parent)
+			{
+				node->m_derivedUpdated = false;
+				node->m_transformMatrixUpdated = false;
+			}
+		}
+	}
+
 	void Node::InvalidateNode()
 	{
 		m_derivedUpdated = false;
 		m_transformMatrixUpdated = false;
 
+		// Childs from our hierarchy will be invalidated by its next update
+		if (m_hierarchy)
+			m_hierarchy->InvalidateNode(this);
+
 		for (Node* node : m_childs)
-			node->InvalidateNode();
+		{
+			if (!m_hierarchy || node->m_hierarchy != m_hierarchy)
+				node->InvalidateNode();
+		}
 
 		OnNodeInvalidation(this);
 	}
@@ -678,7 +802,10 @@ namespace Nz
 	{
 		if (m_parent)
 		{
-			if (!m_parent->m_derivedUpdated)
+			// Nodes of a same hierarchy were already refreshed by the one which started the update
+			if (m_parent->m_hierarchy != m_hierarchy)
+				m_parent->EnsureDerivedUpdate();
+			else if (!m_parent->m_derivedUpdated)
 				m_parent->UpdateDerived();
 
 			if (m_inheritPosition)
@@ -0,0 +1,381 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/NodeHierarchy.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Below this many nodes per depth level, spreading the work isn't worth the synchronization
+		const std::size_t s_nodesPerTask = 1024;
+
+		template<typename T>
+		void Permute(std::vector<T>& values, const std::vector<std::size_t>& order)
+		{
+			std::vector<T> permutedValues;
+			permutedValues.reserve(values.size());
+
+			for (std::size_t index : order)
+				permutedValues.push_back(values[index]);
+
+			values = std::move(permutedValues);
+		}
+	}
+
+	NodeHierarchy::NodeHierarchy() :
+	m_levelOffsets(1, 0),
+	m_orderInvalidated(false),
+	m_pendingInvalidations(false)
+	{
+	}
+
+	NodeHierarchy::~NodeHierarchy()
+	{
+		Clear();
+	}
+
+	void NodeHierarchy::Clear()
+	{
+		std::vector<Node*> nodes(std::move(m_nodes));
+		for (Node* node : nodes)
+			node->m_hierarchy = nullptr;
+
+		m_nodes.clear();
+		m_transformMatrices.clear();
+		m_derivedRotations.clear();
+		m_localRotations.clear();
+		m_derivedPositions.clear();
+		m_derivedScales.clear();
+		m_localPositions.clear();
+		m_localScales.clear();
+		m_levelOffsets.assign(1, 0);
+		m_parentIndices.clear();
+		m_inheritFlags.clear();
+		m_invalidationFlags.clear();
+		m_orderInvalidated = false;
+		m_pendingInvalidations = false;
+
+		// Pending invalidations were not propagated, the nodes have to do it themselves now
+		for (Node* node : nodes)
+			node->InvalidateNode();
+	}
+
+	void NodeHierarchy::Register(Node* node)
+	{
+		NazaraAssert(node, "Invalid node");
+
+		if (node->m_hierarchy == this)
+			return;
+
+		if (node->m_hierarchy)
+			node->m_hierarchy->Unregister(node);
+
+		node->m_hierarchy = this;
+		node->m_hierarchyIndex = m_nodes.size();
+
+		m_nodes.push_back(node);
+		m_transformMatrices.emplace_back(Matrix4f::Identity());
+		m_derivedRotations.emplace_back(Quaternionf::Identity());
+		m_localRotations.emplace_back(Quaternionf::Identity());
+		m_derivedPositions.emplace_back(Vector3f::Zero());
+		m_derivedScales.emplace_back(Vector3f::Unit());
+		m_localPositions.emplace_back(Vector3f::Zero());
+		m_localScales.emplace_back(Vector3f::Unit());
+		m_parentIndices.push_back(InvalidIndex);
+		m_inheritFlags.push_back(0);
+		m_invalidationFlags.push_back(0);
+
+		m_orderInvalidated = true;
+
+		InvalidateNode(node);
+	}
+
+	void NodeHierarchy::Unregister(Node* node)
+	{
+		NazaraAssert(node, "Invalid node");
+
+		if (node->m_hierarchy != this)
+		{
+			NazaraError("Node is not part of this hierarchy");
+			return;
+		}
+
+		RemoveNode(node);
+
+		// Our childs are no longer invalidated through us, and our ancestors may have been moved
+		node->InvalidateNode();
+	}
+
+	void NodeHierarchy::Update()
+	{
+		if (m_orderInvalidated)
+			SortNodes();
+
+		if (!m_pendingInvalidations)
+			return;
+
+		for (std::size_t level = 0; level + 1 < m_levelOffsets.size(); ++level)
+		{
+			std::size_t firstIndex = m_levelOffsets[level];
+			std::size_t lastIndex = m_levelOffsets[level + 1];
+
+			if (level == 0)
+			{
+				// Roots depend on nodes outside of the hierarchy, which may not be thread-safe to update
+				for (std::size_t i = firstIndex; i < lastIndex; ++i)
+					UpdateRoot(i);
+			}
+			else
+			{
+				// Each level only reads the previous one, so its nodes can be updated in any order
+				TaskScheduler::ParallelFor(firstIndex, lastIndex, s_nodesPerTask, [this] (std::size_t first, std::size_t last)
+				{
+					UpdateLevel(first, last);
+				});
+			}
+		}
+
+		m_invalidatedNodes.clear();
+		for (std::size_t i = 0; i < m_nodes.size(); ++i)
+		{
+			// Nodes only invalidated by themselves already signaled it, the others changed since
+			if (m_invalidationFlags[i] & (InvalidationFlags_Propagated | InvalidationFlags_Unsignaled))
+				m_invalidatedNodes.push_back(m_nodes[i]);
+
+			m_invalidationFlags[i] = 0;
+		}
+
+		m_pendingInvalidations = false;
+
+		for (Node* node : m_invalidatedNodes)
+		{
+			for (Node* child : node->m_childs)
+			{
+				if (child->m_hierarchy != this)
+					child->InvalidateNode();
+			}
+
+			node->OnNodeInvalidation(node);
+		}
+	}
+
+	void NodeHierarchy::InvalidateNode(const Node* node)
+	{
+		std::size_t index = node->m_hierarchyIndex;
+
+		m_localPositions[index] = node->m_initialPosition + node->m_position;
+		m_localRotations[index] = node->m_initialRotation * node->m_rotation;
+		m_localScales[index] = node->m_initialScale * node->m_scale;
+
+		UInt8 inheritFlags = 0;
+		if (node->m_inheritPosition)
+			inheritFlags |= InheritFlags_Position;
+
+		if (node->m_inheritRotation)
+			inheritFlags |= InheritFlags_Rotation;
+
+		if (node->m_inheritScale)
+			inheritFlags |= InheritFlags_Scale;
+
+		m_inheritFlags[index] = inheritFlags;
+		m_invalidationFlags[index] |= InvalidationFlags_Self;
+		m_pendingInvalidations = true;
+	}
+
+	void NodeHierarchy::RemoveNode(Node* node)
+	{
+		std::size_t index = node->m_hierarchyIndex;
+		std::size_t lastIndex = m_nodes.size() - 1;
+
+		// The order has to be rebuilt anyway, swapping with the last node is enough
+		if (index != lastIndex)
+		{
+			m_nodes[index] = m_nodes[lastIndex];
+			m_nodes[index]->m_hierarchyIndex = index;
+
+			m_transformMatrices[index] = m_transformMatrices[lastIndex];
+			m_derivedRotations[index] = m_derivedRotations[lastIndex];
+			m_localRotations[index] = m_localRotations[lastIndex];
+			m_derivedPositions[index] = m_derivedPositions[lastIndex];
+			m_derivedScales[index] = m_derivedScales[lastIndex];
+			m_localPositions[index] = m_localPositions[lastIndex];
+			m_localScales[index] = m_localScales[lastIndex];
+			m_inheritFlags[index] = m_inheritFlags[lastIndex];
+			m_invalidationFlags[index] = m_invalidationFlags[lastIndex];
+		}
+
+		m_nodes.pop_back();
+		m_transformMatrices.pop_back();
+		m_derivedRotations.pop_back();
+		m_localRotations.pop_back();
+		m_derivedPositions.pop_back();
+		m_derivedScales.pop_back();
+		m_localPositions.pop_back();
+		m_localScales.pop_back();
+		m_parentIndices.pop_back();
+		m_inheritFlags.pop_back();
+		m_invalidationFlags.pop_back();
+
+		m_orderInvalidated = true;
+
+		node->m_hierarchy = nullptr;
+		node->m_hierarchyIndex = InvalidIndex;
+	}
+
+	void NodeHierarchy::SortNodes()
+	{
+		std::size_t nodeCount = m_nodes.size();
+
+		// Depth of every node, starting from the ones whose parent is not part of the hierarchy
+		std::vector<std::size_t> depths(nodeCount, InvalidIndex);
+		std::vector<std::size_t> chain;
+		std::size_t levelCount = 0;
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			if (depths[i] != InvalidIndex)
+				continue;
+
+			std::size_t depth = 0;
+			std::size_t index = i;
+
+			chain.clear();
+			for (;;)
+			{
+				chain.push_back(index);
+
+				const Node* parent = m_nodes[index]->m_parent;
+				if (!parent || parent->m_hierarchy != this)
+					break;
+
+				index = parent->m_hierarchyIndex;
+				if (depths[index] != InvalidIndex)
+				{
+					depth = depths[index] + 1;
+					break;
+				}
+			}
+
+			for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+				depths[*it] = depth++;
+
+			levelCount = std::max(levelCount, depth);
+		}
+
+		// Counting sort, keeping the previous relative order of the nodes of a same level
+		m_levelOffsets.assign(levelCount + 1, 0);
+		for (std::size_t depth : depths)
+			m_levelOffsets[depth + 1]++;
+
+		for (std::size_t level = 1; level <= levelCount; ++level)
+			m_levelOffsets[level] += m_levelOffsets[level - 1];
+
+		std::vector<std::size_t> order(nodeCount);
+		std::vector<std::size_t> positions(m_levelOffsets.begin(), m_levelOffsets.end() - 1);
+		for (std::size_t i = 0; i < nodeCount; ++i)
+			order[positions[depths[i]]++] = i;
+
+		Permute(m_nodes, order);
+		Permute(m_transformMatrices, order);
+		Permute(m_derivedRotations, order);
+		Permute(m_localRotations, order);
+		Permute(m_derivedPositions, order);
+		Permute(m_derivedScales, order);
+		Permute(m_localPositions, order);
+		Permute(m_localScales, order);
+		Permute(m_inheritFlags, order);
+		Permute(m_invalidationFlags, order);
+
+		for (std::size_t i = 0; i < nodeCount; ++i)
+			m_nodes[i]->m_hierarchyIndex = i;
+
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			const Node* parent = m_nodes[i]->m_parent;
+			m_parentIndices[i] = (parent && parent->m_hierarchy == this) ? parent->m_hierarchyIndex : InvalidIndex;
+		}
+
+		m_orderInvalidated = false;
+	}
+
+	void NodeHierarchy::UpdateLevel(std::size_t firstIndex, std::size_t lastIndex)
+	{
+		for (std::size_t i = firstIndex; i < lastIndex; ++i)
+		{
+			std::size_t parentIndex = m_parentIndices[i];
+			if (m_invalidationFlags[parentIndex] != 0)
+				m_invalidationFlags[i] |= InvalidationFlags_Propagated;
+
+			if (m_invalidationFlags[i] != 0)
+				UpdateNode(i, m_derivedPositions[parentIndex], m_derivedRotations[parentIndex], m_derivedScales[parentIndex]);
+		}
+	}
+
+	void NodeHierarchy::UpdateNode(std::size_t index, const Vector3f& parentPosition, const Quaternionf& parentRotation, const Vector3f& parentScale)
+	{
+		// Same computations as Node::UpdateDerived
+		UInt8 inheritFlags = m_inheritFlags[index];
+
+		Vector3f& derivedPosition = m_derivedPositions[index];
+		if (inheritFlags & InheritFlags_Position)
+			derivedPosition = parentRotation * (parentScale * m_localPositions[index]) + parentPosition;
+		else
+			derivedPosition = m_localPositions[index];
+
+		Quaternionf& derivedRotation = m_derivedRotations[index];
+		if (inheritFlags & InheritFlags_Rotation)
+		{
+			derivedRotation = parentRotation * m_localRotations[index];
+			derivedRotation.Normalize();
+		}
+		else
+			derivedRotation = m_localRotations[index];
+
+		Vector3f& derivedScale = m_derivedScales[index];
+		derivedScale = m_localScales[index];
+		if (inheritFlags & InheritFlags_Scale)
+			derivedScale *= parentScale;
+
+		WriteNode(index);
+	}
+
+	void NodeHierarchy::UpdateRoot(std::size_t index)
+	{
+		// Roots moved by Node::MoveNodes may already be up to date
+		if ((m_invalidationFlags[index] & InvalidationFlags_Self) == 0)
+			return;
+
+		const Node* parent = m_nodes[index]->m_parent;
+		if (parent)
+			UpdateNode(index, parent->GetPosition(), parent->GetRotation(), parent->GetScale());
+		else
+		{
+			m_derivedPositions[index] = m_localPositions[index];
+			m_derivedRotations[index] = m_localRotations[index];
+			m_derivedScales[index] = m_localScales[index];
+
+			WriteNode(index);
+		}
+	}
+
+	void NodeHierarchy::WriteNode(std::size_t index)
+	{
+		Matrix4f& transformMatrix = m_transformMatrices[index];
+		transformMatrix.MakeTransform(m_derivedPositions[index], m_derivedRotations[index], m_derivedScales[index]);
+
+		const Node* node = m_nodes[index];
+		node->m_derivedPosition = m_derivedPositions[index];
+		node->m_derivedRotation = m_derivedRotations[index];
+		node->m_derivedScale = m_derivedScales[index];
+		node->m_derivedUpdated = true;
+		node->m_transformMatrix = transformMatrix;
+		node->m_transformMatrixUpdated = true;
+	}
+
+	constexpr std::size_t NodeHierarchy::InvalidIndex;
+}
@@ -3,8 +3,34 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
 #include <Nazara/Core/Endianness.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/BlockCompression.hpp>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if (defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_MSVC)) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define NAZARA_PIXELFORMAT_X86
+	#include <immintrin.h>
+
+	#if defined(NAZARA_COMPILER_MSVC)
+		#define NAZARA_AVX2_FUNCTION
+		#define NAZARA_SSE2_FUNCTION
+		#define NAZARA_SSSE3_FUNCTION
+	#else
+		#define NAZARA_AVX2_FUNCTION __attribute__((target("avx2")))
+		#define NAZARA_SSE2_FUNCTION __attribute__((target("sse2")))
+		#define NAZARA_SSSE3_FUNCTION __attribute__((target("ssse3")))
+	#endif
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	#define NAZARA_PIXELFORMAT_NEON
+	#include <arm_neon.h>
+#endif
+
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -41,6 +67,252 @@ namespace Nz
 			return static_cast<UInt8>(c * (31.f/255.f));
 		}
 
+		/*********************************Kernels*********************************/
+		// The most common conversions (swapping red and blue, adding an alpha channel or expanding luminance)
+		// are dispatched at runtime to SIMD implementations, the generic ones handle the remaining pixels
+
+		template<bool SwapRedBlue>
+		UInt8* Expand24To32Generic(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			while (start < end)
+			{
+				*dst++ = start[(SwapRedBlue) ? 2 : 0];
+				*dst++ = start[1];
+				*dst++ = start[(SwapRedBlue) ? 0 : 2];
+				*dst++ = 0xFF;
+
+				start += 3;
+			}
+
+			return dst;
+		}
+
+		UInt8* ExpandL8Generic(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			while (start < end)
+			{
+				*dst++ = start[0];
+				*dst++ = start[0];
+				*dst++ = start[0];
+				*dst++ = 0xFF;
+
+				start += 1;
+			}
+
+			return dst;
+		}
+
+		UInt8* SwapRedBlue32Generic(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			while (start < end)
+			{
+				*dst++ = start[2];
+				*dst++ = start[1];
+				*dst++ = start[0];
+				*dst++ = start[3];
+
+				start += 4;
+			}
+
+			return dst;
+		}
+
+		#ifdef NAZARA_PIXELFORMAT_X86
+		template<bool SwapRedBlue>
+		NAZARA_SSSE3_FUNCTION __m128i GetExpand24To32Mask()
+		{
+			if (SwapRedBlue)
+				return _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+			else
+				return _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+		}
+
+		template<bool SwapRedBlue>
+		NAZARA_AVX2_FUNCTION UInt8* Expand24To32AVX2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m256i alpha = _mm256_set1_epi32(0xFF000000);
+			__m256i mask = _mm256_broadcastsi128_si256(GetExpand24To32Mask<SwapRedBlue>());
+
+			// Eight pixels (24 bytes) per iteration, each lane of the register holding four of them
+			for (; end - start >= 28; start += 24, dst += 32)
+			{
+				__m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(start))), _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + 12)), 1);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), alpha));
+			}
+
+			return Expand24To32Generic<SwapRedBlue>(start, end, dst);
+		}
+
+		template<bool SwapRedBlue>
+		NAZARA_SSSE3_FUNCTION UInt8* Expand24To32SSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m128i alpha = _mm_set1_epi32(0xFF000000);
+			__m128i mask = GetExpand24To32Mask<SwapRedBlue>();
+
+			// Four pixels (12 bytes) per iteration, the load reading four bytes ahead
+			for (; end - start >= 16; start += 12, dst += 16)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(start)), mask), alpha));
+
+			return Expand24To32Generic<SwapRedBlue>(start, end, dst);
+		}
+
+		NAZARA_AVX2_FUNCTION UInt8* ExpandL8AVX2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m256i alpha = _mm256_set1_epi32(0xFF000000);
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				__m128i luminance = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+
+				// L -> (L, L, L, 0xFF), eight pixels at a time
+				__m256i low = _mm256_cvtepu8_epi32(luminance);
+				__m256i high = _mm256_cvtepu8_epi32(_mm_srli_si128(luminance, 8));
+				low = _mm256_or_si256(_mm256_or_si256(low, alpha), _mm256_or_si256(_mm256_slli_epi32(low, 8), _mm256_slli_epi32(low, 16)));
+				high = _mm256_or_si256(_mm256_or_si256(high, alpha), _mm256_or_si256(_mm256_slli_epi32(high, 8), _mm256_slli_epi32(high, 16)));
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), low);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), high);
+			}
+
+			return ExpandL8Generic(start, end, dst);
+		}
+
+		NAZARA_SSE2_FUNCTION UInt8* ExpandL8SSE2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m128i alpha = _mm_set1_epi8(char(0xFF));
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				__m128i luminance = _mm_loadu_si128(reinterpret_cast<const __m128i*>(start));
+
+				// (L, L) and (L, 0xFF) pairs interleaved into (L, L, L, 0xFF)
+				__m128i lowPairs = _mm_unpacklo_epi8(luminance, luminance);
+				__m128i highPairs = _mm_unpackhi_epi8(luminance, luminance);
+				__m128i lowAlphaPairs = _mm_unpacklo_epi8(luminance, alpha);
+				__m128i highAlphaPairs = _mm_unpackhi_epi8(luminance, alpha);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi16(lowPairs, lowAlphaPairs));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi16(lowPairs, lowAlphaPairs));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_unpacklo_epi16(highPairs, highAlphaPairs));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), _mm_unpackhi_epi16(highPairs, highAlphaPairs));
+			}
+
+			return ExpandL8Generic(start, end, dst);
+		}
+
+		NAZARA_AVX2_FUNCTION UInt8* SwapRedBlue32AVX2(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m256i mask = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+			                                 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			for (; end - start >= 32; start += 32, dst += 32)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(start)), mask));
+
+			return SwapRedBlue32Generic(start, end, dst);
+		}
+
+		NAZARA_SSSE3_FUNCTION UInt8* SwapRedBlue32SSSE3(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			__m128i mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			for (; end - start >= 16; start += 16, dst += 16)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(start)), mask));
+
+			return SwapRedBlue32Generic(start, end, dst);
+		}
+		#endif
+
+		#ifdef NAZARA_PIXELFORMAT_NEON
+		template<bool SwapRedBlue>
+		UInt8* Expand24To32NEON(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			// Sixteen pixels per iteration, deinterleaved by the load and interleaved again by the store
+			for (; end - start >= 48; start += 48, dst += 64)
+			{
+				uint8x16x3_t pixels = vld3q_u8(start);
+
+				uint8x16x4_t expanded;
+				expanded.val[0] = pixels.val[(SwapRedBlue) ? 2 : 0];
+				expanded.val[1] = pixels.val[1];
+				expanded.val[2] = pixels.val[(SwapRedBlue) ? 0 : 2];
+				expanded.val[3] = vdupq_n_u8(0xFF);
+
+				vst4q_u8(dst, expanded);
+			}
+
+			return Expand24To32Generic<SwapRedBlue>(start, end, dst);
+		}
+
+		UInt8* ExpandL8NEON(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			for (; end - start >= 16; start += 16, dst += 64)
+			{
+				uint8x16_t luminance = vld1q_u8(start);
+
+				uint8x16x4_t expanded;
+				expanded.val[0] = luminance;
+				expanded.val[1] = luminance;
+				expanded.val[2] = luminance;
+				expanded.val[3] = vdupq_n_u8(0xFF);
+
+				vst4q_u8(dst, expanded);
+			}
+
+			return ExpandL8Generic(start, end, dst);
+		}
+
+		UInt8* SwapRedBlue32NEON(const UInt8* start, const UInt8* end, UInt8* dst)
+		{
+			for (; end - start >= 64; start += 64, dst += 64)
+			{
+				uint8x16x4_t pixels = vld4q_u8(start);
+				std::swap(pixels.val[0], pixels.val[2]);
+
+				vst4q_u8(dst, pixels);
+			}
+
+			return SwapRedBlue32Generic(start, end, dst);
+		}
+		#endif
+
+		CpuKernel<UInt8*(const UInt8*, const UInt8*, UInt8*)> s_expand24To32Kernel("24 to 32 bits pixel expansion", &Expand24To32Generic<false>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&Expand24To32AVX2<false>, "AVX2", {ProcessorCap_AVX2}},
+			{&Expand24To32SSSE3<false>, "SSSE3", {ProcessorCap_SSSE3}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&Expand24To32NEON<false>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<UInt8*(const UInt8*, const UInt8*, UInt8*)> s_expandSwap24To32Kernel("24 to 32 bits pixel expansion with red/blue swap", &Expand24To32Generic<true>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&Expand24To32AVX2<true>, "AVX2", {ProcessorCap_AVX2}},
+			{&Expand24To32SSSE3<true>, "SSSE3", {ProcessorCap_SSSE3}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&Expand24To32NEON<true>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<UInt8*(const UInt8*, const UInt8*, UInt8*)> s_expandL8Kernel("Luminance to 32 bits pixel expansion", &ExpandL8Generic, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&ExpandL8AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&ExpandL8SSE2, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&ExpandL8NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<UInt8*(const UInt8*, const UInt8*, UInt8*)> s_swapRedBlue32Kernel("32 bits pixel red/blue swap", &SwapRedBlue32Generic, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&SwapRedBlue32AVX2, "AVX2", {ProcessorCap_AVX2}},
+			{&SwapRedBlue32SSSE3, "SSSE3", {ProcessorCap_SSSE3}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&SwapRedBlue32NEON, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
 		template<PixelFormatType from, PixelFormatType to>
 		UInt8* ConvertPixels(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
@@ -144,17 +416,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_BGR8, PixelFormatType_BGRA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[0];
-				*dst++ = start[1];
-				*dst++ = start[2];
-				*dst++ = 0xFF;
-
-				start += 3;
-			}
-
-			return dst;
+			return s_expand24To32Kernel(start, end, dst);
 		}
 
 		template<>
@@ -246,17 +508,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_BGR8, PixelFormatType_RGBA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[2];
-				*dst++ = start[1];
-				*dst++ = start[0];
-				*dst++ = 0xFF;
-
-				start += 3;
-			}
-
-			return dst;
+			return s_expandSwap24To32Kernel(start, end, dst);
 		}
 
 		/**********************************BGRA8**********************************/
@@ -377,17 +629,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_BGRA8, PixelFormatType_RGBA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[2];
-				*dst++ = start[1];
-				*dst++ = start[0];
-				*dst++ = start[3];
-
-				start += 4;
-			}
-
-			return dst;
+			return s_swapRedBlue32Kernel(start, end, dst);
 		}
 
 		/***********************************L8************************************/
@@ -409,17 +651,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_L8, PixelFormatType_BGRA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[0];
-				*dst++ = start[0];
-				*dst++ = start[0];
-				*dst++ = 0xFF;
-
-				start += 1;
-			}
-
-			return dst;
+			return s_expandL8Kernel(start, end, dst);
 		}
 
 		template<>
@@ -502,17 +734,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_L8, PixelFormatType_RGBA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[0];
-				*dst++ = start[0];
-				*dst++ = start[0];
-				*dst++ = 0xFF;
-
-				start += 1;
-			}
-
-			return dst;
+			return s_expandL8Kernel(start, end, dst);
 		}
 
 		/***********************************LA8***********************************/
@@ -1030,17 +1252,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_RGB8, PixelFormatType_BGRA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[2];
-				*dst++ = start[1];
-				*dst++ = start[0];
-				*dst++ = 0xFF;
-
-				start += 3;
-			}
-
-			return dst;
+			return s_expandSwap24To32Kernel(start, end, dst);
 		}
 
 		template<>
@@ -1117,17 +1329,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_RGB8, PixelFormatType_RGBA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[0];
-				*dst++ = start[1];
-				*dst++ = start[2];
-				*dst++ = 0xFF;
-
-				start += 3;
-			}
-
-			return dst;
+			return s_expand24To32Kernel(start, end, dst);
 		}
 
 		/**********************************RGBA8**********************************/
@@ -1162,17 +1364,7 @@ namespace Nz
 		template<>
 		UInt8* ConvertPixels<PixelFormatType_RGBA8, PixelFormatType_BGRA8>(const UInt8* start, const UInt8* end, UInt8* dst)
 		{
-			while (start < end)
-			{
-				*dst++ = start[2];
-				*dst++ = start[1];
-				*dst++ = start[0];
-				*dst++ = start[3];
-
-				start += 4;
-			}
-
-			return dst;
+			return s_swapRedBlue32Kernel(start, end, dst);
 		}
 
 		template<>
@@ -1266,6 +1458,451 @@ namespace Nz
 		{
 			PixelFormat::SetConvertFunction(format1, format2, &ConvertPixels<format1, format2>);
 		}
+
+		/**********************************Flip***********************************/
+		// Flipping is done in place: the rows (or rows of blocks) are swapped through a small buffer and the pixels of each row
+		// are reversed, with SIMD shuffles for the power of two pixel sizes
+
+		void MirrorPixels(UInt8* left, UInt8* right, unsigned int bpp)
+		{
+			while (right - left >= 2*static_cast<std::ptrdiff_t>(bpp))
+			{
+				right -= bpp;
+				std::swap_ranges(left, left + bpp, right);
+				left += bpp;
+			}
+		}
+
+		template<unsigned int Bpp>
+		void MirrorRowGeneric(UInt8* row, unsigned int width)
+		{
+			MirrorPixels(row, row + width*Bpp, Bpp);
+		}
+
+		#ifdef NAZARA_PIXELFORMAT_X86
+		template<unsigned int Bpp> __m128i ReversePixelsSSE2(__m128i pixels);
+
+		template<>
+		NAZARA_SSE2_FUNCTION __m128i ReversePixelsSSE2<8>(__m128i pixels)
+		{
+			return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		template<>
+		NAZARA_SSE2_FUNCTION __m128i ReversePixelsSSE2<4>(__m128i pixels)
+		{
+			return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+
+		template<>
+		NAZARA_SSE2_FUNCTION __m128i ReversePixelsSSE2<2>(__m128i pixels)
+		{
+			pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+			pixels = _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(0, 1, 2, 3));
+
+			return _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 0, 3, 2));
+		}
+
+		template<>
+		NAZARA_SSE2_FUNCTION __m128i ReversePixelsSSE2<1>(__m128i pixels)
+		{
+			pixels = ReversePixelsSSE2<2>(pixels);
+
+			return _mm_or_si128(_mm_slli_epi16(pixels, 8), _mm_srli_epi16(pixels, 8));
+		}
+
+		template<unsigned int Bpp>
+		NAZARA_SSE2_FUNCTION void MirrorRowSSE2(UInt8* row, unsigned int width)
+		{
+			UInt8* left = row;
+			UInt8* right = row + width*Bpp;
+			while (right - left >= 32)
+			{
+				right -= 16;
+
+				__m128i leftPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+				__m128i rightPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(left), ReversePixelsSSE2<Bpp>(rightPixels));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(right), ReversePixelsSSE2<Bpp>(leftPixels));
+
+				left += 16;
+			}
+
+			MirrorPixels(left, right, Bpp);
+		}
+		#endif
+
+		#ifdef NAZARA_PIXELFORMAT_NEON
+		template<unsigned int Bpp>
+		uint8x16_t ReversePixelsNEON(uint8x16_t pixels)
+		{
+			switch (Bpp)
+			{
+				case 1: pixels = vrev64q_u8(pixels); break;
+				case 2: pixels = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(pixels))); break;
+				case 4: pixels = vreinterpretq_u8_u32(vrev64q_u32(vreinterpretq_u32_u8(pixels))); break;
+			}
+
+			return vextq_u8(pixels, pixels, 8);
+		}
+
+		template<unsigned int Bpp>
+		void MirrorRowNEON(UInt8* row, unsigned int width)
+		{
+			UInt8* left = row;
+			UInt8* right = row + width*Bpp;
+			while (right - left >= 32)
+			{
+				right -= 16;
+
+				uint8x16_t leftPixels = vld1q_u8(left);
+				uint8x16_t rightPixels = vld1q_u8(right);
+				vst1q_u8(left, ReversePixelsNEON<Bpp>(rightPixels));
+				vst1q_u8(right, ReversePixelsNEON<Bpp>(leftPixels));
+
+				left += 16;
+			}
+
+			MirrorPixels(left, right, Bpp);
+		}
+		#endif
+
+		CpuKernel<void(UInt8*, unsigned int)> s_mirrorRow8Kernel("8 bits pixel row mirroring", &MirrorRowGeneric<1>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&MirrorRowSSE2<1>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&MirrorRowNEON<1>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(UInt8*, unsigned int)> s_mirrorRow16Kernel("16 bits pixel row mirroring", &MirrorRowGeneric<2>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&MirrorRowSSE2<2>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&MirrorRowNEON<2>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(UInt8*, unsigned int)> s_mirrorRow32Kernel("32 bits pixel row mirroring", &MirrorRowGeneric<4>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&MirrorRowSSE2<4>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&MirrorRowNEON<4>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		CpuKernel<void(UInt8*, unsigned int)> s_mirrorRow64Kernel("64 bits pixel row mirroring", &MirrorRowGeneric<8>, {
+			#ifdef NAZARA_PIXELFORMAT_X86
+			{&MirrorRowSSE2<8>, "SSE2", {ProcessorCap_SSE2}},
+			#endif
+			#ifdef NAZARA_PIXELFORMAT_NEON
+			{&MirrorRowNEON<8>, "NEON", {ProcessorCap_NEON}},
+			#endif
+		});
+
+		void FlipRows(const UInt8* src, UInt8* dst, unsigned int rowCount, std::size_t rowSize)
+		{
+			if (src == dst)
+			{
+				// memcpy is already vectorized, going through a small buffer keeps both rows in the cache
+				UInt8 buffer[1024];
+				for (unsigned int y = 0; y < rowCount/2; ++y)
+				{
+					UInt8* top = dst + y*rowSize;
+					UInt8* bottom = dst + (rowCount - y - 1)*rowSize;
+					for (std::size_t offset = 0; offset < rowSize; offset += sizeof(buffer))
+					{
+						std::size_t size = std::min(rowSize - offset, sizeof(buffer));
+						std::memcpy(buffer, &top[offset], size);
+						std::memcpy(&top[offset], &bottom[offset], size);
+						std::memcpy(&bottom[offset], buffer, size);
+					}
+				}
+			}
+			else
+			{
+				for (unsigned int y = 0; y < rowCount; ++y)
+					std::memcpy(dst + (rowCount - y - 1)*rowSize, src + y*rowSize, rowSize);
+			}
+		}
+
+		template<unsigned int Bpp>
+		bool FlipPixelsHorizontally(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)
+		{
+			std::size_t rowSize = width*Bpp;
+			unsigned int rowCount = height*depth;
+			if (src != dst)
+				std::memcpy(dst, src, rowCount*rowSize);
+
+			void (*mirrorRow)(UInt8*, unsigned int);
+			switch (Bpp)
+			{
+				case 1: mirrorRow = s_mirrorRow8Kernel.Get(); break;
+				case 2: mirrorRow = s_mirrorRow16Kernel.Get(); break;
+				case 4: mirrorRow = s_mirrorRow32Kernel.Get(); break;
+				case 8: mirrorRow = s_mirrorRow64Kernel.Get(); break;
+				default: mirrorRow = &MirrorRowGeneric<Bpp>; break;
+			}
+
+			for (unsigned int y = 0; y < rowCount; ++y)
+				mirrorRow(dst + y*rowSize, width);
+
+			return true;
+		}
+
+		template<unsigned int Bpp>
+		bool FlipPixelsVertically(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)
+		{
+			std::size_t rowSize = width*Bpp;
+			std::size_t sliceSize = height*rowSize;
+			for (unsigned int z = 0; z < depth; ++z)
+				FlipRows(src + z*sliceSize, dst + z*sliceSize, height, rowSize);
+
+			return true;
+		}
+
+		// DXT images are made of 4x4 texel blocks, beginning with a DXT3 (4 bits per texel) or DXT5 (3 bits indices) alpha block,
+		// followed by a color block (BC5 blocks being two single channel blocks) ending with a byte of 2 bits indices per row: flipping the blocks and their texel rows/columns
+		// flips the image, as long as there is no partial block
+		UInt32 MirrorBitFields(UInt32 value, unsigned int fieldBits, unsigned int fieldCount)
+		{
+			UInt32 mask = (1U << fieldBits) - 1;
+			UInt32 result = value;
+			for (unsigned int i = 0; i < fieldCount; ++i)
+			{
+				unsigned int dstShift = (fieldCount - i - 1)*fieldBits;
+				result &= ~(mask << dstShift);
+				result |= ((value >> i*fieldBits) & mask) << dstShift;
+			}
+
+			return result;
+		}
+
+		// Single channel blocks (DXT5 alpha and both halves of BC5) have two endpoints followed by rows of 3 bits indices
+		UInt64 ReadChannelIndices(const UInt8* block)
+		{
+			UInt64 indices = 0;
+			for (unsigned int i = 0; i < 6; ++i)
+				indices |= UInt64(block[2 + i]) << (i*8);
+
+			return indices;
+		}
+
+		void WriteChannelIndices(UInt8* block, UInt64 indices)
+		{
+			for (unsigned int i = 0; i < 6; ++i)
+				block[2 + i] = static_cast<UInt8>(indices >> (i*8));
+		}
+
+		void FlipChannelBlockHorizontally(UInt8* block, unsigned int columnCount)
+		{
+			UInt64 indices = ReadChannelIndices(block);
+			for (unsigned int y = 0; y < 4; ++y)
+			{
+				UInt64 row = MirrorBitFields(static_cast<UInt32>(indices >> (y*12)) & 0xFFF, 3, columnCount);
+				indices = (indices & ~(UInt64(0xFFF) << (y*12))) | (row << (y*12));
+			}
+
+			WriteChannelIndices(block, indices);
+		}
+
+		void FlipChannelBlockVertically(UInt8* block, unsigned int rowCount)
+		{
+			UInt64 indices = ReadChannelIndices(block);
+			UInt64 flippedIndices = indices;
+			for (unsigned int y = 0; y < rowCount; ++y)
+			{
+				unsigned int dstShift = (rowCount - y - 1)*12;
+				flippedIndices &= ~(UInt64(0xFFF) << dstShift);
+				flippedIndices |= ((indices >> (y*12)) & 0xFFF) << dstShift;
+			}
+
+			WriteChannelIndices(block, flippedIndices);
+		}
+
+		template<PixelFormatType Format>
+		void FlipBlockHorizontally(UInt8* block, unsigned int columnCount)
+		{
+			if (Format == PixelFormatType_BC5)
+			{
+				FlipChannelBlockHorizontally(&block[0], columnCount);
+				FlipChannelBlockHorizontally(&block[8], columnCount);
+				return;
+			}
+
+			UInt8* colorBlock = block;
+			if (Format == PixelFormatType_DXT3)
+			{
+				for (unsigned int y = 0; y < 4; ++y)
+				{
+					UInt32 row = MirrorBitFields(block[y*2] | (block[y*2 + 1] << 8), 4, columnCount);
+					block[y*2] = static_cast<UInt8>(row);
+					block[y*2 + 1] = static_cast<UInt8>(row >> 8);
+				}
+
+				colorBlock += 8;
+			}
+			else if (Format == PixelFormatType_DXT5)
+			{
+				FlipChannelBlockHorizontally(block, columnCount);
+				colorBlock += 8;
+			}
+
+			for (unsigned int y = 0; y < 4; ++y)
+				colorBlock[4 + y] = static_cast<UInt8>(MirrorBitFields(colorBlock[4 + y], 2, columnCount));
+		}
+
+		template<PixelFormatType Format>
+		void FlipBlockVertically(UInt8* block, unsigned int rowCount)
+		{
+			if (Format == PixelFormatType_BC5)
+			{
+				FlipChannelBlockVertically(&block[0], rowCount);
+				FlipChannelBlockVertically(&block[8], rowCount);
+				return;
+			}
+
+			UInt8* colorBlock = block;
+			if (Format == PixelFormatType_DXT3)
+			{
+				for (unsigned int y = 0; y < rowCount/2; ++y)
+					std::swap_ranges(&block[y*2], &block[y*2 + 2], &block[(rowCount - y - 1)*2]);
+
+				colorBlock += 8;
+			}
+			else if (Format == PixelFormatType_DXT5)
+			{
+				FlipChannelBlockVertically(block, rowCount);
+				colorBlock += 8;
+			}
+
+			std::reverse(&colorBlock[4], &colorBlock[4 + rowCount]);
+		}
+
+		template<PixelFormatType Format>
+		bool FlipBlocksHorizontally(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)
+		{
+			if (width > 4 && width % 4 != 0)
+			{
+				NazaraError("Width (" + String::Number(width) + ") must be a multiple of the block size");
+				return false;
+			}
+
+			const unsigned int blockSize = (Format == PixelFormatType_DXT1) ? 8 : 16;
+			unsigned int blockCount = (width + 3)/4;
+			unsigned int blockRowCount = (height + 3)/4 * depth;
+			std::size_t rowSize = blockCount*blockSize;
+			if (src != dst)
+				std::memcpy(dst, src, blockRowCount*rowSize);
+
+			unsigned int columnCount = std::min(width, 4U);
+			for (unsigned int y = 0; y < blockRowCount; ++y)
+			{
+				UInt8* row = dst + y*rowSize;
+				MirrorPixels(row, row + rowSize, blockSize);
+
+				for (unsigned int x = 0; x < blockCount; ++x)
+					FlipBlockHorizontally<Format>(row + x*blockSize, columnCount);
+			}
+
+			return true;
+		}
+
+		template<PixelFormatType Format>
+		bool FlipBlocksVertically(unsigned int width, unsigned int height, unsigned int depth, const UInt8* src, UInt8* dst)
+		{
+			if (height > 4 && height % 4 != 0)
+			{
+				NazaraError("Height (" + String::Number(height) + ") must be a multiple of the block size");
+				return false;
+			}
+
+			const unsigned int blockSize = (Format == PixelFormatType_DXT1) ? 8 : 16;
+			unsigned int blockCount = (width + 3)/4;
+			unsigned int blockRowCount = (height + 3)/4;
+			std::size_t rowSize = blockCount*blockSize;
+			std::size_t sliceSize = blockRowCount*rowSize;
+
+			unsigned int rowCount = std::min(height, 4U);
+			for (unsigned int z = 0; z < depth; ++z)
+			{
+				UInt8* slice = dst + z*sliceSize;
+				FlipRows(src + z*sliceSize, slice, blockRowCount, rowSize);
+
+				for (unsigned int i = 0; i < blockRowCount*blockCount; ++i)
+					FlipBlockVertically<Format>(slice + i*blockSize, rowCount);
+			}
+
+			return true;
+		}
+
+		template<PixelFormatType Format>
+		void RegisterBlockFlipper()
+		{
+			PixelFormat::SetFlipFunction(PixelFlipping_Horizontally, Format, &FlipBlocksHorizontally<Format>);
+			PixelFormat::SetFlipFunction(PixelFlipping_Vertically, Format, &FlipBlocksVertically<Format>);
+		}
+
+		template<unsigned int Bpp>
+		void RegisterPixelFlipper(PixelFormatType format)
+		{
+			PixelFormat::SetFlipFunction(PixelFlipping_Horizontally, format, &FlipPixelsHorizontally<Bpp>);
+			PixelFormat::SetFlipFunction(PixelFlipping_Vertically, format, &FlipPixelsVertically<Bpp>);
+		}
+	}
+
+	bool PixelFormat::Compress(PixelFormatType dstFormat, unsigned int width, unsigned int height, unsigned int depth, const void* src, void* dst)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!IsValid(dstFormat))
+		{
+			NazaraError("Invalid pixel format");
+			return false;
+		}
+		#endif
+
+		const CompressFunction& func = s_compressFunctions[dstFormat];
+		if (!func)
+		{
+			NazaraError("No function to compress to " + GetName(dstFormat));
+			return false;
+		}
+
+		const UInt8* srcPtr = static_cast<const UInt8*>(src);
+		UInt8* dstPtr = static_cast<UInt8*>(dst);
+
+		unsigned int blockCount = (width + 3)/4;
+		unsigned int blockRowCount = (height + 3)/4;
+		std::size_t blockSize = ComputeSize(dstFormat, 4, 4, 1);
+
+		// Every block row is independent, the last texels of the image being repeated to fill the partial blocks
+		TaskScheduler::ParallelFor(0, blockRowCount*depth, 16, [&] (std::size_t first, std::size_t last)
+		{
+			UInt8 texels[4*4*4];
+			for (std::size_t blockRow = first; blockRow < last; ++blockRow)
+			{
+				unsigned int z = static_cast<unsigned int>(blockRow / blockRowCount);
+				unsigned int blockY = static_cast<unsigned int>(blockRow % blockRowCount) * 4;
+				const UInt8* slice = srcPtr + std::size_t(z)*width*height*4;
+
+				for (unsigned int i = 0; i < blockCount; ++i)
+				{
+					for (unsigned int y = 0; y < 4; ++y)
+					{
+						const UInt8* row = slice + std::size_t(std::min(blockY + y, height - 1))*width*4;
+						for (unsigned int x = 0; x < 4; ++x)
+							std::memcpy(&texels[(y*4 + x)*4], &row[std::min(i*4 + x, width - 1)*4], 4);
+					}
+
+					func(texels, dstPtr + (blockRow*blockCount + i)*blockSize);
+				}
+			}
+		});
+
+		return true;
 	}
 
 	PixelFormatType PixelFormat::IdentifyFormat(const PixelFormatInfo& info)
@@ -1286,11 +1923,14 @@ namespace Nz
 	{
 		// Setup informations about every pixel format
 		s_pixelFormatInfos[PixelFormatType_A8]              = PixelFormatInfo("A8",              PixelFormatContent_ColorRGBA,    0,                  0,                  0,                  0xFF,               PixelFormatSubType_Unsigned);
+		s_pixelFormatInfos[PixelFormatType_BC5]             = PixelFormatInfo("BC5",             PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
+		s_pixelFormatInfos[PixelFormatType_BC7]             = PixelFormatInfo("BC7",             PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
 		s_pixelFormatInfos[PixelFormatType_BGR8]            = PixelFormatInfo("BGR8",            PixelFormatContent_ColorRGBA,    0x0000FF,           0x00FF00,           0xFF0000,           0,                  PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_BGRA8]           = PixelFormatInfo("BGRA8",           PixelFormatContent_ColorRGBA,    0x0000FF00,         0x00FF0000,         0xFF000000,         0x000000FF,         PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_DXT1]            = PixelFormatInfo("DXT1",            PixelFormatContent_ColorRGBA,    8,                                                                              PixelFormatSubType_Compressed);
 		s_pixelFormatInfos[PixelFormatType_DXT3]            = PixelFormatInfo("DXT3",            PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
 		s_pixelFormatInfos[PixelFormatType_DXT5]            = PixelFormatInfo("DXT5",            PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
+		s_pixelFormatInfos[PixelFormatType_ETC2]            = PixelFormatInfo("ETC2",            PixelFormatContent_ColorRGBA,    16,                                                                             PixelFormatSubType_Compressed);
 		s_pixelFormatInfos[PixelFormatType_L8]              = PixelFormatInfo("L8",              PixelFormatContent_ColorRGBA,    0xFF,               0xFF,               0xFF,               0,                  PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_LA8]             = PixelFormatInfo("LA8",             PixelFormatContent_ColorRGBA,    0xFF00,             0xFF00,             0xFF00,             0x00FF,             PixelFormatSubType_Unsigned);
 		s_pixelFormatInfos[PixelFormatType_R8]              = PixelFormatInfo("R8",              PixelFormatContent_ColorRGBA,    0xFF,               0,                  0,                  0,                  PixelFormatSubType_Unsigned);
@@ -1564,21 +2204,62 @@ namespace Nz
 		RegisterConverter<PixelFormatType_RGBA8, PixelFormatType_RGB8>();
 		RegisterConverter<PixelFormatType_RGBA8, PixelFormatType_RGBA4>();
 
+		// Compression functions, working on blocks of RGBA8 texels
+		SetCompressFunction(PixelFormatType_BC5, &CompressBC5Block);
+		SetCompressFunction(PixelFormatType_BC7, &CompressBC7Block);
+		SetCompressFunction(PixelFormatType_DXT1, &CompressDXT1Block);
+		SetCompressFunction(PixelFormatType_DXT3, &CompressDXT3Block);
+		SetCompressFunction(PixelFormatType_DXT5, &CompressDXT5Block);
+		SetCompressFunction(PixelFormatType_ETC2, &CompressETC2Block);
+
+		// Flipping functions, the uncompressed formats only depend on the pixel size
+		RegisterBlockFlipper<PixelFormatType_BC5>();
+		RegisterBlockFlipper<PixelFormatType_DXT1>();
+		RegisterBlockFlipper<PixelFormatType_DXT3>();
+		RegisterBlockFlipper<PixelFormatType_DXT5>();
+
+		for (unsigned int i = 0; i <= PixelFormatType_Max; ++i)
+		{
+			PixelFormatType format = static_cast<PixelFormatType>(i);
+			if (IsCompressed(format))
+				continue;
+
+			switch (GetBytesPerPixel(format))
+			{
+				case 1:  RegisterPixelFlipper<1>(format);  break;
+				case 2:  RegisterPixelFlipper<2>(format);  break;
+				case 3:  RegisterPixelFlipper<3>(format);  break;
+				case 4:  RegisterPixelFlipper<4>(format);  break;
+				case 6:  RegisterPixelFlipper<6>(format);  break;
+				case 8:  RegisterPixelFlipper<8>(format);  break;
+				case 12: RegisterPixelFlipper<12>(format); break;
+				case 16: RegisterPixelFlipper<16>(format); break;
+				default: break; // Less than a byte per pixel
+			}
+		}
+
 		return true;
 	}
 
 	void PixelFormat::Uninitialize()
 	{
 		for (unsigned int i = 0; i <= PixelFormatType_Max; ++i)
+		{
+			s_compressFunctions[i] = nullptr;
 			s_pixelFormatInfos[i].Clear();
+		}
 
 		std::memset(s_convertFunctions, 0, (PixelFormatType_Max+1)*(PixelFormatType_Max+1)*sizeof(PixelFormat::ConvertFunction));
 
 		for (unsigned int i = 0; i <= PixelFlipping_Max; ++i)
-			s_flipFunctions[i].clear();
+		{
+			for (unsigned int j = 0; j <= PixelFormatType_Max; ++j)
+				s_flipFunctions[i][j] = nullptr;
+		}
 	}
 
 	PixelFormatInfo PixelFormat::s_pixelFormatInfos[PixelFormatType_Max + 1];
+	PixelFormat::CompressFunction PixelFormat::s_compressFunctions[PixelFormatType_Max+1];
 	PixelFormat::ConvertFunction PixelFormat::s_convertFunctions[PixelFormatType_Max+1][PixelFormatType_Max+1];
-	std::map<PixelFormatType, PixelFormat::FlipFunction> PixelFormat::s_flipFunctions[PixelFlipping_Max+1];
+	PixelFormat::FlipFunction PixelFormat::s_flipFunctions[PixelFlipping_Max+1][PixelFormatType_Max+1];
 }
@@ -11,6 +11,7 @@ namespace Nz
 	SimpleTextDrawer::SimpleTextDrawer() :
 	m_color(Color::White),
 	m_style(TextStyle_Regular),
+	m_glyphRevision(GenerateRevision()),
 	m_colorUpdated(true),
 	m_glyphUpdated(true),
 	m_characterSize(24)
@@ -22,6 +23,7 @@ namespace Nz
 	m_color(drawer.m_color),
 	m_text(drawer.m_text),
 	m_style(drawer.m_style),
+	m_glyphRevision(GenerateRevision()),
 	m_colorUpdated(false),
 	m_glyphUpdated(false),
 	m_characterSize(drawer.m_characterSize)
@@ -102,6 +104,16 @@ namespace Nz
 		return m_glyphs.size();
 	}
 
+	UInt64 SimpleTextDrawer::GetGlyphRevision() const
+	{
+		if (!m_glyphUpdated)
+			UpdateGlyphs();
+		else if (!m_colorUpdated)
+			UpdateGlyphColor();
+
+		return m_glyphRevision;
+	}
+
 	UInt32 SimpleTextDrawer::GetStyle() const
 	{
 		return m_style;
@@ -150,6 +162,16 @@ namespace Nz
 
 	void SimpleTextDrawer::SetText(const String& str)
 	{
+		// Text growing from its end (like a log) only requires the layout of the new characters
+		if (m_glyphUpdated && !m_text.IsEmpty() && str.GetSize() > m_text.GetSize() && str.StartsWith(m_text))
+		{
+			String appendedText = str.SubString(m_text.GetSize());
+			m_text = str;
+
+			GenerateGlyphs(appendedText);
+			return;
+		}
+
 		m_text = str;
 
 		m_glyphUpdated = false;
@@ -177,11 +199,15 @@ namespace Nz
 		m_colorUpdated = std::move(drawer.m_colorUpdated);
 		m_characterSize = std::move(drawer.m_characterSize);
 		m_color = std::move(drawer.m_color);
+		m_drawPos = std::move(drawer.m_drawPos);
 		m_glyphs = std::move(drawer.m_glyphs);
+		m_glyphRevision = std::move(drawer.m_glyphRevision);
 		m_glyphUpdated = std::move(drawer.m_glyphUpdated);
 		m_font = std::move(drawer.m_font);
+		m_previousCharacter = std::move(drawer.m_previousCharacter);
 		m_style = std::move(drawer.m_style);
 		m_text = std::move(drawer.m_text);
+		m_workingBounds = std::move(drawer.m_workingBounds);
 
 		// Update slot pointers (TODO: Improve the way of doing this)
 		ConnectFontSlots();
@@ -217,6 +243,7 @@ namespace Nz
 		m_bounds.MakeZero();
 		m_colorUpdated = true;
 		m_drawPos.Set(0, m_characterSize); //< Our draw "cursor"
+		m_glyphRevision = GenerateRevision(); //< Previous glyphes are no longer valid
 		m_glyphs.clear();
 		m_glyphUpdated = true;
 		m_previousCharacter = 0;
@@ -361,6 +388,8 @@ namespace Nz
 			if (glyph.atlas == oldLayer)
 				glyph.atlas = newLayer;
 		}
+
+		m_glyphRevision = GenerateRevision();
 	}
 
 	void SimpleTextDrawer::OnFontInvalidated(const Font* font)
@@ -400,6 +429,7 @@ namespace Nz
 			glyph.color = m_color;
 
 		m_colorUpdated = true;
+		m_glyphRevision = GenerateRevision();
 	}
 
 	void SimpleTextDrawer::UpdateGlyphs() const
@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Skeleton.hpp>
+#include <algorithm>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -12,9 +13,17 @@ namespace Nz
 	{
 		std::unordered_map<String, unsigned int> jointMap;
 		std::vector<Joint> joints;
+		std::vector<Matrix4f> skinningMatrices;
+		std::vector<Quaternionf> derivedRotations;
+		std::vector<Vector3f> derivedPositions;
+		std::vector<Vector3f> derivedScales;
+		std::vector<int> parentIndices;         //< -1 for the joints whose parent is not part of the skeleton
+		std::vector<unsigned int> jointOrder;   //< Parents before their childs
 		Boxf aabb;
 		bool aabbUpdated = false;
 		bool jointMapUpdated = false;
+		bool jointOrderUpdated = false;
+		bool skinningMatricesUpdated = false;
 	};
 
 	Skeleton::Skeleton(const Skeleton& skeleton) :
@@ -53,8 +62,11 @@ namespace Nz
 		{
 			OnSkeletonDestroy(this);
 
-			delete m_impl;
+			// Destroying the joints unparents them, which must not reach the skeleton anymore
+			SkeletonImpl* impl = m_impl;
 			m_impl = nullptr;
+
+			delete impl;
 		}
 	}
 
@@ -248,6 +260,33 @@ namespace Nz
 		return it->second;
 	}
 
+	/*!
+	* \brief Gets the skinning matrices of the joints
+	* \return Pointer to the matrices, indexed as the joints
+	*
+	* The matrices are computed together by a linear pass over the joints, once per invalidation of the skeleton,
+	* and are laid out as expected by the skinning functions and the skinning texture.
+	*
+	* \remark The pointer is valid until the joint count changes
+	* \remark Produces a NazaraError if the skeleton is not created with NAZARA_UTILITY_SAFE defined
+	*/
+
+	const Matrix4f* Skeleton::GetSkinningMatrices() const
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Skeleton not created");
+			return nullptr;
+		}
+		#endif
+
+		if (!m_impl->skinningMatricesUpdated)
+			UpdateSkinningMatrices();
+
+		return m_impl->skinningMatrices.data();
+	}
+
 	void Skeleton::Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -351,24 +390,21 @@ namespace Nz
 			m_impl->jointMapUpdated = skeleton.m_impl->jointMapUpdated;
 			m_impl->joints = skeleton.m_impl->joints;
 
-			// Code crade mais son optimisation demanderait de stocker jointCount*sizeof(unsigned int) en plus
-			// Ce qui, pour juste une copie qui ne se fera que rarement, ne vaut pas le coup
-			// L'éternel trade-off mémoire/calculs ..
+			for (Joint& joint : m_impl->joints)
+				joint.m_skeleton = this;
+
+			// Parents are not always stored before their childs, they are found through their address
 			unsigned int jointCount = skeleton.m_impl->joints.size();
+
+			std::unordered_map<const Node*, unsigned int> jointIndices;
+			for (unsigned int i = 0; i < jointCount; ++i)
+				jointIndices[&skeleton.m_impl->joints[i]] = i;
+
 			for (unsigned int i = 0; i < jointCount; ++i)
 			{
-				const Node* parent = skeleton.m_impl->joints[i].GetParent();
-				if (parent)
-				{
-					for (unsigned int j = 0; j < i; ++j) // Le parent se trouve forcément avant nous
-					{
-						if (parent == &skeleton.m_impl->joints[j]) // A-t-on trouvé le parent ?
-						{
-							m_impl->joints[i].SetParent(m_impl->joints[j]); // Oui, tout ça pour ça
-							break;
-						}
-					}
-				}
+				auto it = jointIndices.find(skeleton.m_impl->joints[i].GetParent());
+				if (it != jointIndices.end())
+					m_impl->joints[i].SetParent(m_impl->joints[it->second]);
 			}
 		}
 
@@ -378,6 +414,7 @@ namespace Nz
 	void Skeleton::InvalidateJoints()
 	{
 		m_impl->aabbUpdated = false;
+		m_impl->skinningMatricesUpdated = false;
 
 		OnSkeletonJointsInvalidated(this);
 	}
@@ -395,6 +432,21 @@ namespace Nz
 		m_impl->jointMapUpdated = false;
 	}
 
+	void Skeleton::InvalidateJointOrder()
+	{
+		if (m_impl)
+		{
+			m_impl->jointOrderUpdated = false;
+			m_impl->skinningMatricesUpdated = false;
+		}
+	}
+
+	void Skeleton::InvalidateSkinningMatrices()
+	{
+		if (m_impl)
+			m_impl->skinningMatricesUpdated = false;
+	}
+
 	void Skeleton::UpdateJointMap() const
 	{
 		#ifdef NAZARA_DEBUG
@@ -427,6 +479,124 @@ namespace Nz
 		m_impl->jointMapUpdated = true;
 	}
 
+	void Skeleton::UpdateJointOrder() const
+	{
+		#ifdef NAZARA_DEBUG
+		if (!m_impl)
+		{
+			NazaraError("Invalid skeleton");
+			return;
+		}
+		#endif
+
+		unsigned int jointCount = m_impl->joints.size();
+
+		std::unordered_map<const Node*, int> jointIndices;
+		for (unsigned int i = 0; i < jointCount; ++i)
+			jointIndices[&m_impl->joints[i]] = i;
+
+		m_impl->parentIndices.resize(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			auto it = jointIndices.find(m_impl->joints[i].GetParent());
+			m_impl->parentIndices[i] = (it != jointIndices.end()) ? it->second : -1;
+		}
+
+		// Loaders usually store the parents first, sorting by depth keeps that order while handling the other cases
+		std::vector<unsigned int> depths(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			unsigned int depth = 0;
+			for (int parentIndex = m_impl->parentIndices[i]; parentIndex >= 0; parentIndex = m_impl->parentIndices[parentIndex])
+				depth++;
+
+			depths[i] = depth;
+		}
+
+		m_impl->jointOrder.resize(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+			m_impl->jointOrder[i] = i;
+
+		std::stable_sort(m_impl->jointOrder.begin(), m_impl->jointOrder.end(), [&depths] (unsigned int first, unsigned int second)
+		{
+			return depths[first] < depths[second];
+		});
+
+		m_impl->jointOrderUpdated = true;
+	}
+
+	void Skeleton::UpdateSkinningMatrices() const
+	{
+		#ifdef NAZARA_DEBUG
+		if (!m_impl)
+		{
+			NazaraError("Invalid skeleton");
+			return;
+		}
+		#endif
+
+		if (!m_impl->jointOrderUpdated)
+			UpdateJointOrder();
+
+		unsigned int jointCount = m_impl->joints.size();
+		m_impl->derivedPositions.resize(jointCount);
+		m_impl->derivedRotations.resize(jointCount);
+		m_impl->derivedScales.resize(jointCount);
+		m_impl->skinningMatrices.resize(jointCount);
+
+		// Same computation as Node::UpdateDerived, the parents being read from the arrays instead of walking the node chains
+		for (unsigned int jointIndex : m_impl->jointOrder)
+		{
+			const Joint& joint = m_impl->joints[jointIndex];
+			Vector3f& position = m_impl->derivedPositions[jointIndex];
+			Quaternionf& rotation = m_impl->derivedRotations[jointIndex];
+			Vector3f& scale = m_impl->derivedScales[jointIndex];
+
+			int parentIndex = m_impl->parentIndices[jointIndex];
+			if (parentIndex >= 0)
+			{
+				const Vector3f& parentPosition = m_impl->derivedPositions[parentIndex];
+				const Quaternionf& parentRotation = m_impl->derivedRotations[parentIndex];
+				const Vector3f& parentScale = m_impl->derivedScales[parentIndex];
+
+				if (joint.m_inheritPosition)
+					position = parentRotation*(parentScale * (joint.m_initialPosition + joint.m_position)) + parentPosition;
+				else
+					position = joint.m_initialPosition + joint.m_position;
+
+				if (joint.m_inheritRotation)
+				{
+					rotation = parentRotation * joint.m_initialRotation * joint.m_rotation;
+					rotation.Normalize();
+				}
+				else
+					rotation = joint.m_initialRotation * joint.m_rotation;
+
+				scale = joint.m_initialScale * joint.m_scale;
+				if (joint.m_inheritScale)
+					scale *= parentScale;
+			}
+			else
+			{
+				// The parent of a root may be any node, which has to be asked
+				joint.EnsureDerivedUpdate();
+
+				position = joint.m_derivedPosition;
+				rotation = joint.m_derivedRotation;
+				scale = joint.m_derivedScale;
+			}
+		}
+
+		// Independent from each other, the matrices are built in a tight loop over contiguous arrays (using the SIMD paths of Matrix4f)
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			Matrix4f transformMatrix = Matrix4f::Transform(m_impl->derivedPositions[i], m_impl->derivedRotations[i], m_impl->derivedScales[i]);
+			m_impl->skinningMatrices[i] = Matrix4f::ConcatenateAffine(m_impl->joints[i].m_inverseBindMatrix, transformMatrix);
+		}
+
+		m_impl->skinningMatricesUpdated = true;
+	}
+
 	bool Skeleton::Initialize()
 	{
 		if (!SkeletonLibrary::Initialize())
@@ -6,8 +6,11 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/Mesh.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -25,6 +28,22 @@ namespace Nz
 		Destroy();
 	}
 
+	/*!
+	* \brief Adds a simplified version of the mesh, sharing its vertex buffer
+	*
+	* \param indexBuffer Simplified indices
+	* \param screenSize Projected size (relative to the viewport height) under which this level is used
+	*
+	* \remark Levels must be added from the most to the least detailed one
+	*/
+	void StaticMesh::AddLevelOfDetail(const IndexBuffer* indexBuffer, float screenSize)
+	{
+		NazaraAssert(indexBuffer && indexBuffer->IsValid(), "Invalid index buffer");
+		NazaraAssert(m_levelsOfDetail.empty() || screenSize < m_levelsOfDetail.back().screenSize, "Levels of detail must be added in decreasing screen size order");
+
+		m_levelsOfDetail.push_back({indexBuffer, screenSize});
+	}
+
 	void StaticMesh::Center()
 	{
 		Vector3f offset(m_aabb.x + m_aabb.width/2.f, m_aabb.y + m_aabb.height/2.f, m_aabb.z + m_aabb.depth/2.f);
@@ -41,6 +60,11 @@ namespace Nz
 		m_aabb.z -= offset.z;
 	}
 
+	void StaticMesh::ClearLevelsOfDetail()
+	{
+		m_levelsOfDetail.clear();
+	}
+
 	bool StaticMesh::Create(VertexBuffer* vertexBuffer)
 	{
 		Destroy();
@@ -64,6 +88,7 @@ namespace Nz
 			OnStaticMeshDestroy(this);
 
 			m_indexBuffer.Reset();
+			m_levelsOfDetail.clear();
 			m_vertexBuffer.Reset();
 		}
 	}
@@ -77,6 +102,67 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Generates simplified versions of the mesh triangles
+	* \return Number of generated levels, which may be less than requested if the mesh cannot be simplified further
+	*
+	* \param levelCount Number of levels to generate (in addition to the full detail one)
+	* \param reduction Ratio of triangles kept from one level to the next
+	* \param screenSize Projected size (relative to the viewport height) under which the first simplified level is used
+	*
+	* Each level is used for projected sizes smaller by a factor of sqrt(reduction), keeping the on-screen triangle density about constant
+	*
+	* \remark The mesh must be a triangle list with an index buffer
+	*/
+	unsigned int StaticMesh::GenerateLevelsOfDetail(unsigned int levelCount, float reduction, float screenSize)
+	{
+		NazaraAssert(reduction > 0.f && reduction < 1.f, "Reduction must be between 0 and 1");
+
+		ClearLevelsOfDetail();
+
+		if (!m_indexBuffer || GetPrimitiveMode() != PrimitiveMode_TriangleList)
+		{
+			NazaraError("Levels of detail can only be generated for indexed triangle lists");
+			return 0;
+		}
+
+		VertexMapper vertexMapper(m_vertexBuffer, BufferAccess_ReadOnly);
+		SparsePtr<const Vector3f> positionPtr = vertexMapper.GetComponentPtr<const Vector3f>(VertexComponent_Position);
+		unsigned int vertexCount = m_vertexBuffer->GetVertexCount();
+
+		const Buffer* buffer = m_indexBuffer->GetBuffer();
+		UInt32 storage = buffer->GetStorage();
+		BufferUsage usage = buffer->GetUsage();
+
+		// Each level is simplified from the previous one
+		const IndexBuffer* sourceBuffer = m_indexBuffer;
+		std::vector<UInt32> indices;
+		for (unsigned int i = 0; i < levelCount; ++i)
+		{
+			unsigned int sourceIndexCount = sourceBuffer->GetIndexCount();
+			{
+				IndexMapper sourceMapper(sourceBuffer, BufferAccess_ReadOnly);
+				SimplifyIndices(sourceMapper.begin(), sourceIndexCount, positionPtr, vertexCount, static_cast<unsigned int>(sourceIndexCount * reduction), &indices);
+			}
+
+			// Stop when less than half of the requested reduction could be achieved
+			if (indices.empty() || indices.size() > sourceIndexCount * (1.f + reduction) / 2.f)
+				break;
+
+			IndexBufferRef indexBuffer = IndexBuffer::New(m_indexBuffer->HasLargeIndices(), static_cast<unsigned int>(indices.size()), storage, usage);
+			{
+				IndexMapper indexMapper(indexBuffer, BufferAccess_DiscardAndWrite);
+				for (unsigned int j = 0; j < indices.size(); ++j)
+					indexMapper.Set(j, indices[j]);
+			}
+
+			AddLevelOfDetail(indexBuffer, screenSize * std::pow(std::sqrt(reduction), static_cast<float>(i)));
+			sourceBuffer = indexBuffer;
+		}
+
+		return static_cast<unsigned int>(m_levelsOfDetail.size());
+	}
+
 	const Boxf& StaticMesh::GetAABB() const
 	{
 		return m_aabb;
@@ -92,6 +178,34 @@ namespace Nz
 		return m_indexBuffer;
 	}
 
+	/*!
+	* \brief Gets the index buffer of a level of detail
+	* \return Index buffer of the level, level zero being the full detail one
+	*
+	* \param levelOfDetail Level of detail, lower than GetLevelOfDetailCount()
+	*/
+	const IndexBuffer* StaticMesh::GetIndexBuffer(unsigned int levelOfDetail) const
+	{
+		NazaraAssert(levelOfDetail < GetLevelOfDetailCount(), "Level of detail out of range");
+
+		return (levelOfDetail == 0) ? m_indexBuffer : m_levelsOfDetail[levelOfDetail - 1].indexBuffer;
+	}
+
+	/*!
+	* \brief Gets the number of levels of detail, including the full detail one
+	*/
+	unsigned int StaticMesh::GetLevelOfDetailCount() const
+	{
+		return static_cast<unsigned int>(m_levelsOfDetail.size() + 1);
+	}
+
+	float StaticMesh::GetLevelOfDetailScreenSize(unsigned int levelOfDetail) const
+	{
+		NazaraAssert(levelOfDetail < GetLevelOfDetailCount(), "Level of detail out of range");
+
+		return (levelOfDetail == 0) ? std::numeric_limits<float>::infinity() : m_levelsOfDetail[levelOfDetail - 1].screenSize;
+	}
+
 	VertexBuffer* StaticMesh::GetVertexBuffer()
 	{
 		return m_vertexBuffer;
@@ -117,6 +231,21 @@ namespace Nz
 		return m_vertexBuffer != nullptr;
 	}
 
+	/*!
+	* \brief Selects the level of detail to use for a projected size
+	* \return Least detailed level whose screen size is still greater than the projected size
+	*
+	* \param screenSize Projected size of the mesh, relative to the viewport height
+	*/
+	unsigned int StaticMesh::SelectLevelOfDetail(float screenSize) const
+	{
+		unsigned int levelOfDetail = 0;
+		while (levelOfDetail < m_levelsOfDetail.size() && screenSize < m_levelsOfDetail[levelOfDetail].screenSize)
+			levelOfDetail++;
+
+		return levelOfDetail;
+	}
+
 	void StaticMesh::SetAABB(const Boxf& aabb)
 	{
 		m_aabb = aabb;
@@ -125,5 +254,6 @@ namespace Nz
 	void StaticMesh::SetIndexBuffer(const IndexBuffer* indexBuffer)
 	{
 		m_indexBuffer = indexBuffer;
-}
+		m_levelsOfDetail.clear(); // They were simplified from the previous indices
+	}
 }
@@ -22,9 +22,13 @@
 #include <Nazara/Utility/Window.hpp>
 #include <Nazara/Utility/Formats/DDSLoader.hpp>
 #include <Nazara/Utility/Formats/FreeTypeLoader.hpp>
+#include <Nazara/Utility/Formats/KTXLoader.hpp>
+#include <Nazara/Utility/Formats/KTXSaver.hpp>
 #include <Nazara/Utility/Formats/MD2Loader.hpp>
 #include <Nazara/Utility/Formats/MD5AnimLoader.hpp>
 #include <Nazara/Utility/Formats/MD5MeshLoader.hpp>
+#include <Nazara/Utility/Formats/NMFLoader.hpp>
+#include <Nazara/Utility/Formats/NMFSaver.hpp>
 #include <Nazara/Utility/Formats/OBJLoader.hpp>
 #include <Nazara/Utility/Formats/OBJSaver.hpp>
 #include <Nazara/Utility/Formats/PCXLoader.hpp>
@@ -117,6 +121,8 @@ namespace Nz
 
 		// Image
 		Loaders::RegisterDDSLoader(); // DDS Loader (DirectX format)
+		Loaders::RegisterKTXLoader(); // KTX2 Loader (Khronos format)
+		Loaders::RegisterKTXSaver();  // KTX2 Saver (Khronos format)
 		Loaders::RegisterSTBLoader(); // Generic loader (STB)
 		Loaders::RegisterSTBSaver();  // Generic saver (STB)
 
@@ -131,6 +137,8 @@ namespace Nz
 		// Mesh
 		Loaders::RegisterMD2(); // Loader de fichiers .md2 (v8)
 		Loaders::RegisterMD5Mesh(); // Loader de fichiers .md5mesh (v10)
+		Loaders::RegisterNMFLoader(); // Binary mesh cache (Nazara format)
+		Loaders::RegisterNMFSaver();  // Binary mesh cache (Nazara format)
 		Loaders::RegisterOBJLoader(); // Loader de fichiers .md5mesh (v10)
 
 		// Image
@@ -162,9 +170,13 @@ namespace Nz
 		s_moduleReferenceCounter = 0;
 
 		Loaders::UnregisterFreeType();
+		Loaders::UnregisterKTXLoader();
+		Loaders::UnregisterKTXSaver();
 		Loaders::UnregisterMD2();
 		Loaders::UnregisterMD5Anim();
 		Loaders::UnregisterMD5Mesh();
+		Loaders::UnregisterNMFLoader();
+		Loaders::UnregisterNMFSaver();
 		Loaders::UnregisterOBJLoader();
 		Loaders::UnregisterOBJSaver();
 		Loaders::UnregisterPCX();
@@ -202,10 +214,17 @@ namespace Nz
 		2, // ComponentType_Int2
 		3, // ComponentType_Int3
 		4, // ComponentType_Int4
-		4  // ComponentType_Quaternion
+		4, // ComponentType_Quaternion
+		2, // ComponentType_Half2
+		4, // ComponentType_Half4
+		4, // ComponentType_NormalizedByte4
+		2, // ComponentType_NormalizedShort2
+		4, // ComponentType_NormalizedShort4
+		2, // ComponentType_NormalizedUShort2
+		4  // ComponentType_NormalizedInt2101010
 	};
 
-	static_assert(ComponentType_Max+1 == 14, "Component count array is incomplete");
+	static_assert(ComponentType_Max+1 == 21, "Component count array is incomplete");
 
 	std::size_t Utility::ComponentStride[ComponentType_Max+1] =
 	{
@@ -222,10 +241,17 @@ namespace Nz
 		2*sizeof(UInt32), // ComponentType_Int2
 		3*sizeof(UInt32), // ComponentType_Int3
 		4*sizeof(UInt32), // ComponentType_Int4
-		4*sizeof(float)     // ComponentType_Quaternion
+		4*sizeof(float),    // ComponentType_Quaternion
+		2*sizeof(UInt16), // ComponentType_Half2
+		4*sizeof(UInt16), // ComponentType_Half4
+		4*sizeof(Int8),   // ComponentType_NormalizedByte4
+		2*sizeof(Int16),  // ComponentType_NormalizedShort2
+		4*sizeof(Int16),  // ComponentType_NormalizedShort4
+		2*sizeof(UInt16), // ComponentType_NormalizedUShort2
+		1*sizeof(UInt32)  // ComponentType_NormalizedInt2101010
 	};
 
-	static_assert(ComponentType_Max+1 == 14, "Component stride array is incomplete");
+	static_assert(ComponentType_Max+1 == 21, "Component stride array is incomplete");
 
 	unsigned int Utility::s_moduleReferenceCounter = 0;
 }
@@ -160,7 +160,7 @@ namespace Nz
 		}
 		#endif
 
-		return m_buffer->Map(access, offset, size);
+		return m_buffer->Map(access, m_startOffset + offset, (size == 0) ? m_endOffset - m_startOffset - offset : size);
 	}
 
 	void* VertexBuffer::MapRaw(BufferAccess access, unsigned int offset, unsigned int size) const
@@ -173,7 +173,7 @@ namespace Nz
 		}
 		#endif
 
-		return m_buffer->Map(access, offset, size);
+		return m_buffer->Map(access, m_startOffset + offset, (size == 0) ? m_endOffset - m_startOffset - offset : size);
 	}
 
 	void VertexBuffer::Reset()
@@ -184,7 +184,7 @@ namespace Nz
 
 	void VertexBuffer::Reset(const VertexDeclaration* vertexDeclaration, Buffer* buffer)
 	{
-		Reset(vertexDeclaration, buffer, 0, buffer->GetSize()-1);
+		Reset(vertexDeclaration, buffer, 0, buffer->GetSize());
 	}
 
 	void VertexBuffer::Reset(const VertexDeclaration* vertexDeclaration, Buffer* buffer, unsigned int startOffset, unsigned int endOffset)
@@ -209,7 +209,7 @@ namespace Nz
 			return;
 		}
 
-		if (endOffset >= bufferSize)
+		if (endOffset > bufferSize)
 		{
 			NazaraError("End offset is over buffer size");
 			return;
@@ -169,6 +169,13 @@ namespace Nz
 			case ComponentType_Int2:
 			case ComponentType_Int3:
 			case ComponentType_Int4:
+			case ComponentType_Half2:
+			case ComponentType_Half4:
+			case ComponentType_NormalizedByte4:
+			case ComponentType_NormalizedShort2:
+			case ComponentType_NormalizedShort4:
+			case ComponentType_NormalizedUShort2:
+			case ComponentType_NormalizedInt2101010:
 				return true;
 
 			case ComponentType_Quaternion:
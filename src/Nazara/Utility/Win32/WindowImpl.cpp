@@ -76,6 +76,7 @@ namespace Nz
 	m_parent(parent),
 	m_keyRepeat(true),
 	m_mouseInside(false),
+	m_rawMouseInput(false),
 	m_smoothScrolling(false),
 	m_scrolling(0)
 	{
@@ -220,6 +221,8 @@ namespace Nz
 
 	void WindowImpl::Destroy()
 	{
+		EnableRawMouseInput(false);
+
 		if (m_ownsWindow)
 		{
 			#if NAZARA_UTILITY_THREADED_WINDOW
@@ -244,6 +247,27 @@ namespace Nz
 		m_keyRepeat = enable;
 	}
 
+	void WindowImpl::EnableRawMouseInput(bool enable)
+	{
+		if (m_rawMouseInput == enable)
+			return;
+
+		// Souris générique (usage page 1, usage 2), les messages WM_INPUT ignorent l'accélération du curseur
+		RAWINPUTDEVICE device;
+		device.usUsagePage = 0x01;
+		device.usUsage = 0x02;
+		device.dwFlags = (enable) ? 0 : RIDEV_REMOVE;
+		device.hwndTarget = (enable) ? m_handle : nullptr;
+
+		if (!RegisterRawInputDevices(&device, 1, sizeof(RAWINPUTDEVICE)))
+		{
+			NazaraError("Failed to register raw mouse device: " + Error::GetLastSystemError());
+			return;
+		}
+
+		m_rawMouseInput = enable;
+	}
+
 	void WindowImpl::EnableSmoothScrolling(bool enable)
 	{
 		m_smoothScrolling = enable;
@@ -310,6 +334,11 @@ namespace Nz
 		return IsIconic(m_handle) == TRUE;
 	}
 
+	bool WindowImpl::IsRawMouseInputEnabled() const
+	{
+		return m_rawMouseInput;
+	}
+
 	bool WindowImpl::IsVisible() const
 	{
 		return IsWindowVisible(m_handle) == TRUE;
@@ -762,6 +791,31 @@ namespace Nz
 					break;
 				}
 
+				case WM_INPUT:
+				{
+					if (!m_rawMouseInput)
+						break;
+
+					RAWINPUT input;
+					UINT size = sizeof(RAWINPUT);
+					if (GetRawInputData(reinterpret_cast<HRAWINPUT>(lParam), RID_INPUT, &input, &size, sizeof(RAWINPUTHEADER)) == static_cast<UINT>(-1))
+						break;
+
+					// Seuls les déplacements relatifs nous intéressent (les tablettes envoient des positions absolues)
+					if (input.header.dwType != RIM_TYPEMOUSE || (input.data.mouse.usFlags & MOUSE_MOVE_ABSOLUTE))
+						break;
+
+					if (input.data.mouse.lLastX == 0 && input.data.mouse.lLastY == 0)
+						break;
+
+					WindowEvent event;
+					event.type = WindowEventType_RawMouseMoved;
+					event.rawMouseMove.deltaX = input.data.mouse.lLastX;
+					event.rawMouseMove.deltaY = input.data.mouse.lLastY;
+					m_parent->PushEvent(event);
+					break;
+				}
+
 				case WM_MOUSEWHEEL:
 				{
 					if (m_smoothScrolling)
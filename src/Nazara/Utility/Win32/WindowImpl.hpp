@@ -44,6 +44,7 @@ namespace Nz
 			void Destroy();
 
 			void EnableKeyRepeat(bool enable);
+			void EnableRawMouseInput(bool enable);
 			void EnableSmoothScrolling(bool enable);
 
 			WindowHandle GetHandle() const;
@@ -59,6 +60,7 @@ namespace Nz
 			void IgnoreNextMouseEvent(int mouseX, int mouseY);
 
 			bool IsMinimized() const;
+			bool IsRawMouseInputEnabled() const;
 			bool IsVisible() const;
 
 			void ProcessEvents(bool block);
@@ -109,6 +111,7 @@ namespace Nz
 			bool m_keyRepeat;
 			bool m_mouseInside;
 			bool m_ownsWindow;
+			bool m_rawMouseInput;
 			#if !NAZARA_UTILITY_THREADED_WINDOW
 			bool m_sizemove;
 			#endif
@@ -84,6 +84,7 @@ namespace Nz
 
 		// Paramètres par défaut
 		m_impl->EnableKeyRepeat(true);
+		m_impl->EnableRawMouseInput(false);
 		m_impl->EnableSmoothScrolling(false);
 		m_impl->SetCursor(WindowCursor_Default);
 		m_impl->SetMaximumSize(-1, -1);
@@ -153,6 +154,19 @@ namespace Nz
 		m_impl->EnableKeyRepeat(enable);
 	}
 
+	void Window::EnableRawMouseInput(bool enable)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Window not created");
+			return;
+		}
+		#endif
+
+		m_impl->EnableRawMouseInput(enable);
+	}
+
 	void Window::EnableSmoothScrolling(bool enable)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -283,6 +297,19 @@ namespace Nz
 		return m_impl->IsMinimized();
 	}
 
+	bool Window::IsRawMouseInputEnabled() const
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Window not created");
+			return false;
+		}
+		#endif
+
+		return m_impl->IsRawMouseInputEnabled();
+	}
+
 	bool Window::IsVisible() const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -307,10 +334,9 @@ namespace Nz
 		#endif
 
 		#if NAZARA_UTILITY_THREADED_WINDOW
-		LockGuard lock(m_eventMutex);
+		return PopEvent(event);
 		#else
 		m_impl->ProcessEvents(false);
-		#endif
 
 		if (!m_events.empty())
 		{
@@ -323,6 +349,7 @@ namespace Nz
 		}
 
 		return false;
+		#endif
 	}
 
 	void Window::SetCursor(WindowCursor cursor)
@@ -372,9 +399,11 @@ namespace Nz
 		if (!listener)
 		{
 			// On vide la pile des évènements
-			LockGuard lock(m_eventMutex);
-			while (!m_events.empty())
-				m_events.pop();
+			m_events->Clear();
+
+			LockGuard lock(*m_overflowMutex);
+			m_overflowEvents.clear();
+			m_hasOverflowEvents = false;
 		}
 		#else
 		if (m_ownsWindow)
@@ -574,30 +603,19 @@ namespace Nz
 		#endif
 
 		#if NAZARA_UTILITY_THREADED_WINDOW
-		LockGuard lock(m_eventMutex);
+		if (PopEvent(event))
+			return true;
 
-		if (m_events.empty())
-		{
-			m_waitForEvent = true;
-			m_eventConditionMutex.Lock();
-			m_eventMutex.Unlock();
-			m_eventCondition.Wait(&m_eventConditionMutex);
-			m_eventMutex.Lock();
-			m_eventConditionMutex.Unlock();
-			m_waitForEvent = false;
-		}
+		LockGuard lock(*m_eventConditionMutex);
 
-		if (!m_events.empty())
-		{
-			if (event)
-				*event = m_events.front();
+		// Le signal peut être manqué si l'évènement arrive juste avant l'attente, d'où le délai
+		m_waitForEvent = true;
+		while (!PopEvent(event))
+			m_eventCondition->Wait(m_eventConditionMutex.get(), 10);
 
-			m_events.pop();
+		m_waitForEvent = false;
 
-			return true;
-		}
-
-		return false;
+		return true;
 		#else
 		while (m_events.empty())
 			m_impl->ProcessEvents(true);
@@ -611,6 +629,74 @@ namespace Nz
 		#endif
 	}
 
+	#if NAZARA_UTILITY_THREADED_WINDOW
+	bool Window::PopEvent(WindowEvent* event)
+	{
+		if (m_events->Pop(event))
+			return true;
+
+		if (!m_hasOverflowEvents)
+			return false;
+
+		// Tant que la liste de débordement n'est pas vide, la fenêtre n'ajoute plus rien à la file : son contenu est donc plus ancien
+		LockGuard lock(*m_overflowMutex);
+		if (m_overflowEvents.empty())
+			return false;
+
+		if (event)
+			*event = m_overflowEvents.front();
+
+		m_overflowEvents.pop_front();
+		if (m_overflowEvents.empty())
+			m_hasOverflowEvents = false;
+
+		return true;
+	}
+
+	void Window::PushOverflowEvent(const WindowEvent& event)
+	{
+		LockGuard lock(*m_overflowMutex);
+
+		// La liste a pu être vidée depuis, la file est de nouveau utilisable
+		if (m_overflowEvents.empty() && m_events->Push(event))
+			return;
+
+		// Les déplacements de la souris consécutifs sont fusionnés, les autres évènements ne sont jamais perdus
+		if (!m_overflowEvents.empty() && m_overflowEvents.back().type == event.type)
+		{
+			WindowEvent& lastEvent = m_overflowEvents.back();
+			switch (event.type)
+			{
+				case WindowEventType_MouseMoved:
+					lastEvent.mouseMove.deltaX += event.mouseMove.deltaX;
+					lastEvent.mouseMove.deltaY += event.mouseMove.deltaY;
+					lastEvent.mouseMove.x = event.mouseMove.x;
+					lastEvent.mouseMove.y = event.mouseMove.y;
+					lastEvent.timestamp = event.timestamp;
+					return;
+
+				case WindowEventType_RawMouseMoved:
+					lastEvent.rawMouseMove.deltaX += event.rawMouseMove.deltaX;
+					lastEvent.rawMouseMove.deltaY += event.rawMouseMove.deltaY;
+					lastEvent.timestamp = event.timestamp;
+					return;
+
+				default:
+					break;
+			}
+		}
+
+		if (!m_overflowWarned)
+		{
+			NazaraWarning("Event queue is full (" + String::Number(m_events->GetCapacity()) + " events), events are now stored in a slower list until they are polled");
+			m_overflowWarned = true;
+		}
+
+		m_overflowEvents.push_back(event);
+		m_hasOverflowEvents = true;
+	}
+	#endif
+
 	bool Window::OnWindowCreated()
 	{
 		return true;
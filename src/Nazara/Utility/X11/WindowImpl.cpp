@@ -20,6 +20,10 @@
 #include <X11/Xutil.h>
 #include <xcb/xcb_cursor.h>
 #include <xcb/xcb_keysyms.h>
+#include <cmath>
+#if NAZARA_UTILITY_THREADED_WINDOW
+#include <poll.h>
+#endif
 #include <Nazara/Utility/Debug.hpp>
 
 /*
@@ -54,6 +58,10 @@ namespace Nz
 
 		xcb_connection_t* connection = nullptr;
 
+		// Opcode de l'extension XInput2, utilisée pour les mouvements bruts de la souris
+		bool xinputAvailable = false;
+		uint8_t xinputOpcode = 0;
+
 		void CreateHiddenCursor()
 		{
 			XCBPixmap cursorPixmap(connection);
@@ -95,8 +103,10 @@ namespace Nz
 	m_window(0),
 	m_style(0),
 	m_parent(parent),
+	m_rawMouseInput(false),
 	m_smoothScrolling(false),
 	m_scrolling(0),
+	m_rawMouseRemainder(0.f, 0.f),
 	m_mousePos(0, 0),
 	m_keyRepeat(true)
 	{
@@ -276,12 +286,16 @@ namespace Nz
 		if (m_ownsWindow)
 		{
 			#if NAZARA_UTILITY_THREADED_WINDOW
+			// Le thread ne traite plus d'évènements une fois joint, la fenêtre peut être détruite ici
 			if (m_thread.IsJoinable())
 			{
 				m_threadActive = false;
 				m_thread.Join();
 			}
-			#else
+			#endif
+
+			EnableRawMouseInput(false);
+
 			// Destroy the window
 			if (m_window && m_ownsWindow)
 			{
@@ -299,7 +313,6 @@ namespace Nz
 
 				xcb_flush(connection);
 			}
-			#endif
 		}
 		else
 			SetEventListener(false);
@@ -310,6 +323,48 @@ namespace Nz
 		m_keyRepeat = enable;
 	}
 
+	void WindowImpl::EnableRawMouseInput(bool enable)
+	{
+		if (m_rawMouseInput == enable)
+			return;
+
+		if (!xinputAvailable)
+		{
+			if (enable)
+				NazaraWarning("XInput2 is not available, raw mouse input cannot be enabled");
+
+			return;
+		}
+
+		// Les évènements bruts ne sont envoyés qu'à la fenêtre racine
+		struct
+		{
+			xcb_input_event_mask_t header;
+			uint32_t mask;
+		} rawMask;
+
+		rawMask.header.deviceid = XCB_INPUT_DEVICE_ALL_MASTER;
+		rawMask.header.mask_len = 1;
+		rawMask.mask = (enable) ? XCB_INPUT_XI_EVENT_MASK_RAW_MOTION : 0;
+
+		if (!X11::CheckCookie(
+			connection,
+			xcb_input_xi_select_events_checked(
+				connection,
+				m_screen->root,
+				1,
+				&rawMask.header
+			))
+		)
+		{
+			NazaraError("Failed to select raw motion events");
+			return;
+		}
+
+		m_rawMouseInput = enable;
+		m_rawMouseRemainder.MakeZero();
+	}
+
 	void WindowImpl::EnableSmoothScrolling(bool enable)
 	{
 		m_smoothScrolling = enable;
@@ -390,6 +445,11 @@ namespace Nz
 		m_mousePos.y = mouseY;
 	}
 
+	bool WindowImpl::IsRawMouseInputEnabled() const
+	{
+		return m_rawMouseInput;
+	}
+
 	bool WindowImpl::IsMinimized() const
 	{
 		ScopedXCBEWMHConnection ewmhConnection(connection);
@@ -739,6 +799,20 @@ namespace Nz
 		// Create the hidden cursor
 		CreateHiddenCursor();
 
+		// Les mouvements bruts de la souris nécessitent XInput 2.0
+		const xcb_query_extension_reply_t* xinputExtension = xcb_get_extension_data(connection, &xcb_input_id);
+		if (xinputExtension && xinputExtension->present)
+		{
+			ScopedXCB<xcb_input_xi_query_version_reply_t> versionReply(xcb_input_xi_query_version_reply(
+				connection,
+				xcb_input_xi_query_version(connection, 2, 0),
+				nullptr
+			));
+
+			xinputAvailable = (versionReply && versionReply->major_version >= 2);
+			xinputOpcode = xinputExtension->major_opcode;
+		}
+
 		return true;
 	}
 
@@ -753,6 +827,8 @@ namespace Nz
 
 		X11::CloseConnection(connection);
 
+		xinputAvailable = false;
+
 		X11::Uninitialize();
 	}
 
@@ -1292,7 +1368,51 @@ namespace Nz
 
 				break;
 			}
+
+			// XInput2 events
+			case XCB_GE_GENERIC:
+			{
+				xcb_ge_generic_event_t* genericEvent = reinterpret_cast<xcb_ge_generic_event_t*>(windowEvent);
+				if (m_rawMouseInput && genericEvent->extension == xinputOpcode && genericEvent->event_type == XCB_INPUT_RAW_MOTION)
+					ProcessRawMotion(reinterpret_cast<xcb_input_raw_motion_event_t*>(windowEvent));
+
+				break;
+			}
+		}
+	}
+
+	void WindowImpl::ProcessRawMotion(xcb_input_raw_motion_event_t* rawEvent)
+	{
+		// Seuls les axes présents dans le masque sont transmis, dans l'ordre des bits
+		const uint32_t* valuatorMask = xcb_input_raw_button_press_valuator_mask(rawEvent);
+		const xcb_input_fp3232_t* values = xcb_input_raw_button_press_axisvalues_raw(rawEvent);
+		if (xcb_input_raw_button_press_valuator_mask_length(rawEvent) < 1)
+			return;
+
+		float axisValues[2] = { 0.f, 0.f };
+		for (unsigned int axis = 0; axis < 2; ++axis)
+		{
+			if (valuatorMask[0] & (1U << axis))
+			{
+				axisValues[axis] = static_cast<float>(values->integral + values->frac / 4294967296.0);
+				values++;
+			}
 		}
+
+		Vector2f delta(axisValues[0], axisValues[1]);
+
+		// Les valeurs peuvent être fractionnaires, on garde le reste pour le prochain évènement
+		delta += m_rawMouseRemainder;
+
+		WindowEvent event;
+		event.type = Nz::WindowEventType_RawMouseMoved;
+		event.rawMouseMove.deltaX = static_cast<int>(std::trunc(delta.x));
+		event.rawMouseMove.deltaY = static_cast<int>(std::trunc(delta.y));
+
+		m_rawMouseRemainder.Set(delta.x - event.rawMouseMove.deltaX, delta.y - event.rawMouseMove.deltaY);
+
+		if (event.rawMouseMove.deltaX != 0 || event.rawMouseMove.deltaY != 0)
+			m_parent->PushEvent(event);
 	}
 
 	void WindowImpl::ResetVideoMode()
@@ -1577,10 +1697,18 @@ namespace Nz
 		if (!window->m_window)
 			return;
 
+		// On n'attend jamais indéfiniment la connexion, pour que Destroy puisse arrêter le thread
+		pollfd descriptor;
+		descriptor.fd = xcb_get_file_descriptor(connection);
+		descriptor.events = POLLIN;
+
 		while (window->m_threadActive)
-			window->ProcessEvents(true);
+		{
+			descriptor.revents = 0;
+			poll(&descriptor, 1, 10);
 
-		window->Destroy();
+			window->ProcessEvents(false);
+		}
 	}
 	#endif
 }
@@ -17,6 +17,10 @@
 #include <Nazara/Utility/X11/Display.hpp>
 #include <xcb/randr.h>
 #include <xcb/xcb_icccm.h>
+#include <xcb/xinput.h>
+#if NAZARA_UTILITY_THREADED_WINDOW
+#include <atomic>
+#endif
 
 namespace Nz
 {
@@ -43,6 +47,7 @@ namespace Nz
 			void Destroy();
 
 			void EnableKeyRepeat(bool enable);
+			void EnableRawMouseInput(bool enable);
 			void EnableSmoothScrolling(bool enable);
 
 			WindowHandle GetHandle() const;
@@ -58,6 +63,7 @@ namespace Nz
 			void IgnoreNextMouseEvent(int mouseX, int mouseY);
 
 			bool IsMinimized() const;
+			bool IsRawMouseInputEnabled() const;
 			bool IsVisible() const;
 
 			void ProcessEvents(bool block);
@@ -90,6 +96,7 @@ namespace Nz
 			void CommonInitialize();
 
 			void ProcessEvent(xcb_generic_event_t* windowEvent);
+			void ProcessRawMotion(xcb_input_raw_motion_event_t* rawEvent);
 
 			void ResetVideoMode();
 
@@ -116,11 +123,13 @@ namespace Nz
 			Window* m_parent;
 			bool m_eventListener;
 			bool m_ownsWindow;
+			bool m_rawMouseInput;
 			bool m_smoothScrolling;
 			#if NAZARA_UTILITY_THREADED_WINDOW
-			bool m_threadActive;
+			std::atomic_bool m_threadActive;
 			#endif
 			short m_scrolling;
+			Vector2f m_rawMouseRemainder;
 			Vector2i m_mousePos;
 			bool m_keyRepeat;
 
@@ -0,0 +1,259 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/CommandRecorder.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <algorithm>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	CommandRecorder::CommandRecorder(Vk::Device& device) :
+	m_device(device),
+	m_currentFrame(0),
+	m_recording(false)
+	{
+	}
+
+	CommandRecorder::~CommandRecorder()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Starts recording the next frame in flight
+	* \return true if successful
+	*
+	* \remark Blocks until the GPU is done with the commands previously recorded for this frame
+	*/
+	bool CommandRecorder::BeginFrame()
+	{
+		NazaraAssert(!m_frames.empty(), "Recorder must be created first");
+		NazaraAssert(!m_recording, "Previous frame has not been submitted");
+
+		Frame& frame = *m_frames[m_currentFrame];
+		if (!frame.fence.Wait() || !frame.fence.Reset())
+		{
+			NazaraError("Failed to wait for frame #" + String::Number(m_currentFrame) + " fence");
+			return false;
+		}
+
+		// Every command buffer of the frame is recycled at once
+		if (!frame.primaryPool.Reset(0))
+		{
+			NazaraError("Failed to reset primary command pool");
+			return false;
+		}
+
+		for (auto& threadPool : frame.threadPools)
+		{
+			if (!threadPool->pool.Reset(0))
+			{
+				NazaraError("Failed to reset worker command pool");
+				return false;
+			}
+
+			threadPool->usedBufferCount = 0;
+		}
+
+		if (!frame.primaryBuffer.front().Begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+		{
+			NazaraError("Failed to begin primary command buffer");
+			return false;
+		}
+
+		m_recording = true;
+		return true;
+	}
+
+	/*!
+	* \brief Creates the command pools of every frame in flight
+	* \return true if successful
+	*
+	* \param queueFamilyIndex Queue family the commands will be submitted to
+	* \param frameCount Number of frames the CPU may record ahead of the GPU
+	*
+	* \remark Each thread taking part in TaskScheduler::ParallelFor gets its own pools, the worker count must not change afterwards
+	*/
+	bool CommandRecorder::Create(UInt32 queueFamilyIndex, unsigned int frameCount)
+	{
+		NazaraAssert(frameCount > 0, "Frame count must be over zero");
+
+		Destroy();
+
+		// The workers and the thread calling ParallelFor
+		unsigned int threadCount = TaskScheduler::GetWorkerCount() + 1;
+
+		m_frames.reserve(frameCount);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			std::unique_ptr<Frame> frame(new Frame(m_device));
+
+			if (!frame->fence.Create(VK_FENCE_CREATE_SIGNALED_BIT))
+			{
+				NazaraError("Failed to create frame fence");
+				Destroy();
+				return false;
+			}
+
+			if (!frame->primaryPool.Create(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT))
+			{
+				NazaraError("Failed to create primary command pool");
+				Destroy();
+				return false;
+			}
+
+			frame->primaryBuffer.emplace_back(frame->primaryPool.AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY));
+			if (frame->primaryPool.GetLastErrorCode() != VK_SUCCESS)
+			{
+				NazaraError("Failed to allocate primary command buffer");
+				Destroy();
+				return false;
+			}
+
+			frame->threadPools.reserve(threadCount);
+			for (unsigned int j = 0; j < threadCount; ++j)
+			{
+				std::unique_ptr<ThreadPool> threadPool(new ThreadPool(m_device));
+				if (!threadPool->pool.Create(queueFamilyIndex, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT))
+				{
+					NazaraError("Failed to create worker command pool");
+					Destroy();
+					return false;
+				}
+
+				frame->threadPools.emplace_back(std::move(threadPool));
+			}
+
+			m_frames.emplace_back(std::move(frame));
+		}
+
+		m_currentFrame = 0;
+		m_recording = false;
+
+		return true;
+	}
+
+	void CommandRecorder::Destroy()
+	{
+		// Command buffers may not be freed while the GPU still uses them
+		for (auto& frame : m_frames)
+			frame->fence.Wait();
+
+		m_chunkBuffers.clear();
+		m_frames.clear();
+	}
+
+	Vk::CommandBuffer& CommandRecorder::GetPrimaryCommandBuffer()
+	{
+		NazaraAssert(m_recording, "BeginFrame must be called first");
+
+		return m_frames[m_currentFrame]->primaryBuffer.front();
+	}
+
+	/*!
+	* \brief Ends the frame and submits its primary command buffer
+	* \return true if successful
+	*
+	* \param queue Queue to submit to, from the family given to Create
+	* \param waitSemaphore Optional semaphore to wait on before executing the commands (swapchain image acquisition)
+	* \param waitStage Pipeline stage waiting on waitSemaphore
+	* \param signalSemaphore Optional semaphore signaled once the commands are executed (presentation)
+	*/
+	bool CommandRecorder::Submit(Vk::Queue& queue, VkSemaphore waitSemaphore, VkPipelineStageFlags waitStage, VkSemaphore signalSemaphore)
+	{
+		NazaraAssert(m_recording, "BeginFrame must be called first");
+
+		Frame& frame = *m_frames[m_currentFrame];
+		m_recording = false;
+
+		Vk::CommandBuffer& primaryBuffer = frame.primaryBuffer.front();
+		if (!primaryBuffer.End())
+		{
+			NazaraError("Failed to end primary command buffer");
+			return false;
+		}
+
+		VkCommandBuffer commandBuffer = primaryBuffer;
+
+		VkSubmitInfo submitInfo = {
+			VK_STRUCTURE_TYPE_SUBMIT_INFO,
+			nullptr,
+			(waitSemaphore != VK_NULL_HANDLE) ? 1U : 0U,
+			&waitSemaphore,
+			&waitStage,
+			1U,
+			&commandBuffer,
+			(signalSemaphore != VK_NULL_HANDLE) ? 1U : 0U,
+			&signalSemaphore
+		};
+
+		m_currentFrame = (m_currentFrame + 1) % m_frames.size();
+
+		if (!queue.Submit(submitInfo, frame.fence))
+		{
+			NazaraError("Failed to submit frame commands");
+			return false;
+		}
+
+		return true;
+	}
+
+	Vk::CommandBuffer* CommandRecorder::AcquireSecondaryBuffer(const VkRenderPassBeginInfo& renderPassInfo)
+	{
+		Frame& frame = *m_frames[m_currentFrame];
+
+		unsigned int workerIndex = TaskScheduler::GetWorkerIndex();
+		if (workerIndex >= frame.threadPools.size())
+		{
+			NazaraError("Worker #" + String::Number(workerIndex) + " has no command pool, worker count changed since creation");
+			return nullptr;
+		}
+
+		// Only this thread touches its pool, no locking needed
+		ThreadPool& threadPool = *frame.threadPools[workerIndex];
+		if (threadPool.usedBufferCount == threadPool.secondaryBuffers.size())
+		{
+			threadPool.secondaryBuffers.emplace_back(threadPool.pool.AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY));
+			if (threadPool.pool.GetLastErrorCode() != VK_SUCCESS)
+			{
+				threadPool.secondaryBuffers.pop_back();
+
+				NazaraError("Failed to allocate secondary command buffer");
+				return nullptr;
+			}
+		}
+
+		Vk::CommandBuffer& commandBuffer = threadPool.secondaryBuffers[threadPool.usedBufferCount++];
+		if (!commandBuffer.Begin(VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, renderPassInfo.renderPass, 0, renderPassInfo.framebuffer, false, 0, 0))
+		{
+			NazaraError("Failed to begin secondary command buffer");
+			return nullptr;
+		}
+
+		return &commandBuffer;
+	}
+
+	void CommandRecorder::ExecuteSecondaryBuffers()
+	{
+		// Slices merged into a previous one left their slot empty
+		m_chunkBuffers.erase(std::remove(m_chunkBuffers.begin(), m_chunkBuffers.end(), static_cast<VkCommandBuffer>(VK_NULL_HANDLE)), m_chunkBuffers.end());
+
+		if (!m_chunkBuffers.empty())
+			GetPrimaryCommandBuffer().ExecuteCommands(static_cast<UInt32>(m_chunkBuffers.size()), m_chunkBuffers.data());
+	}
+
+	CommandRecorder::ThreadPool::ThreadPool(Vk::Device& device) :
+	pool(device),
+	usedBufferCount(0)
+	{
+	}
+
+	CommandRecorder::Frame::Frame(Vk::Device& device) :
+	primaryPool(device),
+	fence(device)
+	{
+	}
+}
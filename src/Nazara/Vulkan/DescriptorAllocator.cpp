@@ -0,0 +1,126 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DescriptorAllocator.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	DescriptorAllocator::DescriptorAllocator(Vk::Device& device) :
+	m_currentPool(0),
+	m_device(device),
+	m_setsPerPool(0)
+	{
+	}
+
+	/*!
+	* \brief Allocates a descriptor set, valid until the next reset
+	* \return Descriptor set handle, or VK_NULL_HANDLE if it couldn't be allocated
+	*
+	* \param setLayout Layout of the descriptor set
+	*
+	* \remark May be called from any thread
+	*/
+	VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout setLayout)
+	{
+		NazaraAssert(m_setsPerPool > 0, "Allocator must be created first");
+
+		LockGuard lock(m_mutex);
+
+		VkDescriptorSetAllocateInfo allocateInfo =
+		{
+			VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			nullptr,
+			VK_NULL_HANDLE,
+			1U,
+			&setLayout
+		};
+
+		// A full pool makes the allocation fail, the next one (possibly new) is tried then
+		for (; m_currentPool <= m_pools.size(); ++m_currentPool)
+		{
+			bool newPool = (m_currentPool == m_pools.size());
+			if (newPool)
+			{
+				std::unique_ptr<Vk::DescriptorPool> pool(new Vk::DescriptorPool(m_device));
+				if (!pool->Create(m_setsPerPool, static_cast<UInt32>(m_poolSizes.size()), m_poolSizes.data()))
+				{
+					NazaraError("Failed to create descriptor pool");
+					return VK_NULL_HANDLE;
+				}
+
+				m_pools.emplace_back(std::move(pool));
+			}
+
+			allocateInfo.descriptorPool = *m_pools[m_currentPool];
+
+			VkDescriptorSet descriptorSet;
+			VkResult result = m_device.vkAllocateDescriptorSets(m_device, &allocateInfo, &descriptorSet);
+			if (result == VkResult::VK_SUCCESS)
+				return descriptorSet;
+
+			// Even an empty pool can't hold the set, its layout needs more descriptors than a pool has
+			if (newPool)
+				break;
+		}
+
+		NazaraError("Failed to allocate descriptor set");
+		return VK_NULL_HANDLE;
+	}
+
+	/*!
+	* \brief Sets the size of the descriptor pools
+	* \return true if successful
+	*
+	* \param poolSizes Number of descriptors of each type in a pool
+	* \param setsPerPool Maximum number of descriptor sets in a pool
+	*/
+	bool DescriptorAllocator::Create(std::vector<VkDescriptorPoolSize> poolSizes, UInt32 setsPerPool)
+	{
+		NazaraAssert(!poolSizes.empty(), "Pool sizes must not be empty");
+		NazaraAssert(setsPerPool > 0, "Sets per pool must be over zero");
+
+		Destroy();
+
+		LockGuard lock(m_mutex);
+
+		m_poolSizes = std::move(poolSizes);
+		m_setsPerPool = setsPerPool;
+
+		return true;
+	}
+
+	void DescriptorAllocator::Destroy()
+	{
+		LockGuard lock(m_mutex);
+
+		m_currentPool = 0;
+		m_pools.clear();
+		m_setsPerPool = 0;
+	}
+
+	std::size_t DescriptorAllocator::GetPoolCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_pools.size();
+	}
+
+	/*!
+	* \brief Frees every descriptor set allocated since the last reset
+	*
+	* \remark The GPU must be done with all of them
+	*/
+	void DescriptorAllocator::Reset()
+	{
+		LockGuard lock(m_mutex);
+
+		for (std::size_t i = 0; i < m_pools.size() && i <= m_currentPool; ++i)
+			m_pools[i]->Reset();
+
+		m_currentPool = 0;
+	}
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DescriptorSetCache.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <algorithm>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	DescriptorSetCache::DescriptorSetCache(Vk::Device& device) :
+	m_allocator(device),
+	m_device(device)
+	{
+	}
+
+	/*!
+	* \brief Forgets every descriptor set, to be called once the resources they refer to have been destroyed
+	*
+	* \remark The GPU must be done with all of them
+	*/
+	void DescriptorSetCache::Clear()
+	{
+		LockGuard lock(m_mutex);
+
+		m_descriptorSets.clear();
+		m_allocator.Reset();
+	}
+
+	/*!
+	* \brief Sets the size of the descriptor pools
+	* \return true if successful
+	*
+	* \param poolSizes Number of descriptors of each type in a pool
+	* \param setsPerPool Maximum number of descriptor sets in a pool
+	*/
+	bool DescriptorSetCache::Create(std::vector<VkDescriptorPoolSize> poolSizes, UInt32 setsPerPool)
+	{
+		LockGuard lock(m_mutex);
+
+		m_descriptorSets.clear();
+
+		return m_allocator.Create(std::move(poolSizes), setsPerPool);
+	}
+
+	void DescriptorSetCache::Destroy()
+	{
+		LockGuard lock(m_mutex);
+
+		m_descriptorSets.clear();
+		m_allocator.Destroy();
+	}
+
+	/*!
+	* \brief Gets a descriptor set referring to some resources, allocating and writing it the first time
+	* \return Descriptor set handle, or VK_NULL_HANDLE if it couldn't be allocated
+	*
+	* \param setLayout Layout of the descriptor set
+	* \param bindings Resources of each binding, with one descriptor per binding
+	* \param bindingCount Number of bindings
+	*
+	* \remark May be called from any thread
+	*/
+	VkDescriptorSet DescriptorSetCache::GetDescriptorSet(VkDescriptorSetLayout setLayout, const Binding* bindings, std::size_t bindingCount)
+	{
+		NazaraAssert(bindings || bindingCount == 0, "Invalid bindings");
+
+		LockGuard lock(m_mutex);
+
+		m_lookupKey.setLayout = setLayout;
+		m_lookupKey.bindings.assign(bindings, bindings + bindingCount);
+
+		auto it = m_descriptorSets.find(m_lookupKey);
+		if (it != m_descriptorSets.end())
+			return it->second;
+
+		VkDescriptorSet descriptorSet = m_allocator.Allocate(setLayout);
+		if (descriptorSet == VK_NULL_HANDLE)
+			return VK_NULL_HANDLE;
+
+		// The infos are referenced by the writes, they must not be reallocated while being filled
+		m_bufferInfos.clear();
+		m_bufferInfos.reserve(bindingCount);
+		m_imageInfos.clear();
+		m_imageInfos.reserve(bindingCount);
+		m_writes.clear();
+
+		for (std::size_t i = 0; i < bindingCount; ++i)
+		{
+			const Binding& binding = bindings[i];
+
+			VkWriteDescriptorSet write =
+			{
+				VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+				nullptr,
+				descriptorSet,
+				binding.binding,
+				0U,
+				1U,
+				binding.type,
+				nullptr,
+				nullptr,
+				nullptr
+			};
+
+			if (binding.buffer != VK_NULL_HANDLE)
+			{
+				m_bufferInfos.push_back({binding.buffer, binding.offset, binding.range});
+				write.pBufferInfo = &m_bufferInfos.back();
+			}
+			else
+			{
+				m_imageInfos.push_back({binding.sampler, binding.imageView, binding.imageLayout});
+				write.pImageInfo = &m_imageInfos.back();
+			}
+
+			m_writes.push_back(write);
+		}
+
+		m_device.vkUpdateDescriptorSets(m_device, static_cast<UInt32>(m_writes.size()), m_writes.data(), 0U, nullptr);
+
+		m_descriptorSets.emplace(m_lookupKey, descriptorSet);
+
+		return descriptorSet;
+	}
+
+	std::size_t DescriptorSetCache::GetDescriptorSetCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_descriptorSets.size();
+	}
+
+	bool DescriptorSetCache::Key::operator==(const Key& key) const
+	{
+		if (setLayout != key.setLayout)
+			return false;
+
+		return bindings.size() == key.bindings.size() && std::equal(bindings.begin(), bindings.end(), key.bindings.begin(), [] (const Binding& lhs, const Binding& rhs)
+		{
+			return lhs.buffer == rhs.buffer &&
+			       lhs.type == rhs.type &&
+			       lhs.offset == rhs.offset &&
+			       lhs.range == rhs.range &&
+			       lhs.imageLayout == rhs.imageLayout &&
+			       lhs.imageView == rhs.imageView &&
+			       lhs.sampler == rhs.sampler &&
+			       lhs.binding == rhs.binding;
+		});
+	}
+
+	std::size_t DescriptorSetCache::KeyHasher::operator()(const Key& key) const
+	{
+		std::size_t seed = 0;
+		HashCombine(seed, key.setLayout);
+
+		for (const Binding& binding : key.bindings)
+		{
+			HashCombine(seed, binding.buffer);
+			HashCombine(seed, binding.type);
+			HashCombine(seed, binding.offset);
+			HashCombine(seed, binding.range);
+			HashCombine(seed, binding.imageLayout);
+			HashCombine(seed, binding.imageView);
+			HashCombine(seed, binding.sampler);
+			HashCombine(seed, binding.binding);
+		}
+
+		return seed;
+	}
+}
@@ -0,0 +1,452 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DeviceMemoryAllocator.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Vulkan/VkInstance.hpp>
+#include <algorithm>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Smallest node handed out by the buddy allocator
+		const VkDeviceSize s_minNodeSize = 256;
+	}
+
+	DeviceMemoryAllocator::DeviceMemoryAllocator(Vk::Device& device) :
+	m_device(device),
+	m_blockSize(0),
+	m_allocationCount(0),
+	m_maxAllocationCount(0)
+	{
+	}
+
+	DeviceMemoryAllocator::~DeviceMemoryAllocator()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Allocates memory for a resource
+	* \return true if successful
+	*
+	* \param requirements Memory requirements of the resource
+	* \param requiredProperties Properties the memory type must have
+	* \param allocation Allocation to fill, to be given back to Free
+	* \param flags Combination of DeviceMemoryFlags
+	* \param preferredProperties Properties tried first, dropped if no memory type having them can hold the resource
+	* \param userData Value kept in the allocation, to identify the resource when it is moved
+	*/
+	bool DeviceMemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags requiredProperties, Allocation* allocation, UInt32 flags, VkMemoryPropertyFlags preferredProperties, void* userData)
+	{
+		NazaraAssert(m_blockSize > 0, "Allocator must be created first");
+		NazaraAssert(allocation, "Invalid allocation");
+		NazaraAssert(requirements.size > 0, "Invalid size");
+
+		LockGuard lock(m_mutex);
+
+		// Buddy nodes are aligned on their size within the block
+		VkDeviceSize nodeSize = GetNearestPowerOfTwo(std::max({requirements.size, requirements.alignment, s_minNodeSize}));
+
+		for (unsigned int pass = 0; pass < 2; ++pass)
+		{
+			VkMemoryPropertyFlags properties = requiredProperties;
+			if (pass == 0)
+				properties |= preferredProperties;
+			else if (preferredProperties == 0)
+				break;
+
+			for (UInt32 memoryType = 0; memoryType < m_memoryProperties.memoryTypeCount; ++memoryType)
+			{
+				if ((requirements.memoryTypeBits & (1U << memoryType)) == 0 || (m_memoryProperties.memoryTypes[memoryType].propertyFlags & properties) != properties)
+					continue;
+
+				// A block never holds more than one big resource
+				if ((flags & DeviceMemory_Dedicated) || nodeSize > GetPool(memoryType, flags).blockSize / 2)
+				{
+					VkDeviceMemory memory;
+					UInt8* mappedPtr;
+					if (!AllocateDeviceMemory(memoryType, requirements.size, &memory, &mappedPtr))
+						continue;
+
+					allocation->flags = (flags | DeviceMemory_Dedicated) & ~DeviceMemory_Movable;
+					allocation->mappedPtr = mappedPtr;
+					allocation->memory = memory;
+					allocation->offset = 0;
+					allocation->order = 0;
+				}
+				else if (!AllocateFromPool(memoryType, flags, nodeSize, nullptr, true, allocation))
+					continue;
+
+				allocation->memoryType = memoryType;
+				allocation->size = requirements.size;
+				allocation->userData = userData;
+
+				if ((flags & DeviceMemory_Movable) && !(allocation->flags & DeviceMemory_Dedicated))
+				{
+					for (auto& block : GetPool(memoryType, flags).blocks)
+					{
+						if (block->memory == allocation->memory)
+						{
+							block->movableAllocations[allocation->offset] = *allocation;
+							break;
+						}
+					}
+				}
+
+				return true;
+			}
+		}
+
+		NazaraError("Failed to allocate " + String::Number(requirements.size) + " bytes of device memory");
+		return false;
+	}
+
+	/*!
+	* \brief Reads the memory properties of the physical device
+	* \return true if successful
+	*
+	* \param physicalDevice Physical device the device was created from
+	* \param blockSize Size of the device memory blocks, a power of two, smaller for heaps which couldn't hold eight of them
+	*/
+	bool DeviceMemoryAllocator::Create(VkPhysicalDevice physicalDevice, VkDeviceSize blockSize)
+	{
+		#if NAZARA_VULKAN_SAFE
+		if (blockSize < s_minNodeSize || GetNearestPowerOfTwo(blockSize) != blockSize)
+		{
+			NazaraError("Block size must be a power of two of at least " + String::Number(s_minNodeSize) + " bytes");
+			return false;
+		}
+		#endif
+
+		Destroy();
+
+		Vk::Instance& instance = m_device.GetInstance();
+		instance.GetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+
+		VkPhysicalDeviceProperties properties;
+		instance.GetPhysicalDeviceProperties(physicalDevice, &properties);
+
+		m_allocationCount = 0;
+		m_maxAllocationCount = properties.limits.maxMemoryAllocationCount;
+
+		// VK_EXT_memory_budget isn't available, the allocator only counts its own allocations against a share of the heap
+		m_heapBudgets.resize(m_memoryProperties.memoryHeapCount);
+		m_heapUsages.assign(m_memoryProperties.memoryHeapCount, 0);
+		for (UInt32 i = 0; i < m_memoryProperties.memoryHeapCount; ++i)
+			m_heapBudgets[i] = m_memoryProperties.memoryHeaps[i].size / 10 * 8;
+
+		m_pools.resize(m_memoryProperties.memoryTypeCount * 2);
+		for (UInt32 memoryType = 0; memoryType < m_memoryProperties.memoryTypeCount; ++memoryType)
+		{
+			VkDeviceSize heapSize = m_memoryProperties.memoryHeaps[m_memoryProperties.memoryTypes[memoryType].heapIndex].size;
+
+			VkDeviceSize poolBlockSize = blockSize;
+			while (poolBlockSize > s_minNodeSize && poolBlockSize * 8 > heapSize)
+				poolBlockSize /= 2;
+
+			m_pools[memoryType * 2].blockSize = poolBlockSize;
+			m_pools[memoryType * 2 + 1].blockSize = poolBlockSize;
+		}
+
+		m_blockSize = blockSize;
+
+		return true;
+	}
+
+	/*!
+	* \brief Moves movable allocations out of the least used blocks
+	* \return Number of moved allocations
+	*
+	* \param maxMovedSize Maximum number of bytes to move
+	*
+	* \remark For each move, OnAllocationMove is signaled with a new allocation the listener must copy the resource to and bind it with,
+	*         then free the old one once the GPU doesn't use it anymore, which releases the block when it was the last one in it
+	*/
+	std::size_t DeviceMemoryAllocator::Defragment(VkDeviceSize maxMovedSize)
+	{
+		NazaraAssert(m_blockSize > 0, "Allocator must be created first");
+
+		LockGuard lock(m_mutex);
+
+		std::size_t moveCount = 0;
+		VkDeviceSize movedSize = 0;
+		for (Pool& pool : m_pools)
+		{
+			if (pool.blocks.size() < 2)
+				continue;
+
+			auto it = std::min_element(pool.blocks.begin(), pool.blocks.end(), [] (const std::unique_ptr<Block>& lhs, const std::unique_ptr<Block>& rhs)
+			{
+				return lhs->usedSize < rhs->usedSize;
+			});
+
+			Block* block = it->get();
+
+			// The allocation keeps its place until it is freed, the listener may free it during the signal
+			std::vector<Allocation> allocations;
+			allocations.reserve(block->movableAllocations.size());
+			for (auto& pair : block->movableAllocations)
+				allocations.push_back(pair.second);
+
+			for (const Allocation& allocation : allocations)
+			{
+				if (movedSize + allocation.size > maxMovedSize)
+					return moveCount;
+
+				Allocation newAllocation(allocation);
+				if (!AllocateFromPool(allocation.memoryType, allocation.flags, pool.blockSize >> allocation.order, block, false, &newAllocation))
+					break;
+
+				for (auto& otherBlock : pool.blocks)
+				{
+					if (otherBlock->memory == newAllocation.memory)
+					{
+						otherBlock->movableAllocations[newAllocation.offset] = newAllocation;
+						break;
+					}
+				}
+
+				block->movableAllocations.erase(allocation.offset);
+
+				OnAllocationMove(this, allocation, newAllocation);
+
+				movedSize += allocation.size;
+				moveCount++;
+
+				// Freeing the last allocation of the block releases it
+				if (std::none_of(pool.blocks.begin(), pool.blocks.end(), [block] (const std::unique_ptr<Block>& other) { return other.get() == block; }))
+					break;
+			}
+		}
+
+		return moveCount;
+	}
+
+	void DeviceMemoryAllocator::Destroy()
+	{
+		LockGuard lock(m_mutex);
+
+		for (UInt32 i = 0; i < m_pools.size(); ++i)
+		{
+			for (auto& block : m_pools[i].blocks)
+				FreeDeviceMemory(i / 2, block->memory, m_pools[i].blockSize);
+		}
+
+		m_pools.clear();
+		m_blockSize = 0;
+	}
+
+	void DeviceMemoryAllocator::Free(const Allocation& allocation)
+	{
+		LockGuard lock(m_mutex);
+
+		if (allocation.flags & DeviceMemory_Dedicated)
+		{
+			FreeDeviceMemory(allocation.memoryType, allocation.memory, allocation.size);
+			return;
+		}
+
+		Pool& pool = GetPool(allocation.memoryType, allocation.flags);
+		auto it = std::find_if(pool.blocks.begin(), pool.blocks.end(), [&allocation] (const std::unique_ptr<Block>& block)
+		{
+			return block->memory == allocation.memory;
+		});
+
+		NazaraAssert(it != pool.blocks.end(), "Allocation doesn't belong to this allocator");
+
+		Block& block = **it;
+		block.movableAllocations.erase(allocation.offset);
+		block.usedSize -= pool.blockSize >> allocation.order;
+
+		ReleaseNode(block, pool.blockSize, allocation.offset, allocation.order);
+
+		// One empty block is kept per pool to avoid reallocating it over and over
+		if (block.usedSize == 0 && pool.blocks.size() > 1)
+		{
+			FreeDeviceMemory(allocation.memoryType, block.memory, pool.blockSize);
+			pool.blocks.erase(it);
+		}
+	}
+
+	VkDeviceSize DeviceMemoryAllocator::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	UInt32 DeviceMemoryAllocator::GetDeviceAllocationCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_allocationCount;
+	}
+
+	VkDeviceSize DeviceMemoryAllocator::GetHeapBudget(UInt32 heapIndex) const
+	{
+		NazaraAssert(heapIndex < m_heapBudgets.size(), "Heap index out of range");
+
+		LockGuard lock(m_mutex);
+
+		return m_heapBudgets[heapIndex];
+	}
+
+	VkDeviceSize DeviceMemoryAllocator::GetHeapUsage(UInt32 heapIndex) const
+	{
+		NazaraAssert(heapIndex < m_heapUsages.size(), "Heap index out of range");
+
+		LockGuard lock(m_mutex);
+
+		return m_heapUsages[heapIndex];
+	}
+
+	void DeviceMemoryAllocator::SetHeapBudget(UInt32 heapIndex, VkDeviceSize budget)
+	{
+		NazaraAssert(heapIndex < m_heapBudgets.size(), "Heap index out of range");
+
+		LockGuard lock(m_mutex);
+
+		m_heapBudgets[heapIndex] = budget;
+	}
+
+	bool DeviceMemoryAllocator::AllocateDeviceMemory(UInt32 memoryType, VkDeviceSize size, VkDeviceMemory* memory, UInt8** mappedPtr)
+	{
+		UInt32 heapIndex = m_memoryProperties.memoryTypes[memoryType].heapIndex;
+		if (m_heapUsages[heapIndex] + size > m_heapBudgets[heapIndex])
+			return false;
+
+		if (m_allocationCount >= m_maxAllocationCount)
+		{
+			NazaraWarning("Device memory allocation count limit reached (" + String::Number(m_maxAllocationCount) + ')');
+			return false;
+		}
+
+		VkMemoryAllocateInfo allocateInfo =
+		{
+			VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			nullptr,
+			size,
+			memoryType
+		};
+
+		VkResult result = m_device.vkAllocateMemory(m_device, &allocateInfo, nullptr, memory);
+		if (result != VkResult::VK_SUCCESS)
+			return false;
+
+		*mappedPtr = nullptr;
+		if (m_memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+		{
+			void* ptr;
+			result = m_device.vkMapMemory(m_device, *memory, 0, VK_WHOLE_SIZE, 0, &ptr);
+			if (result != VkResult::VK_SUCCESS)
+			{
+				NazaraError("Failed to map device memory");
+				m_device.vkFreeMemory(m_device, *memory, nullptr);
+				return false;
+			}
+
+			*mappedPtr = static_cast<UInt8*>(ptr);
+		}
+
+		m_allocationCount++;
+		m_heapUsages[heapIndex] += size;
+
+		return true;
+	}
+
+	bool DeviceMemoryAllocator::AllocateFromPool(UInt32 memoryType, UInt32 flags, VkDeviceSize nodeSize, const Block* excludedBlock, bool allowNewBlock, Allocation* allocation)
+	{
+		Pool& pool = GetPool(memoryType, flags);
+		UInt8 order = static_cast<UInt8>(IntegralLog2Pot(pool.blockSize / nodeSize));
+
+		Block* block = nullptr;
+		VkDeviceSize offset;
+		for (auto& candidate : pool.blocks)
+		{
+			if (candidate.get() != excludedBlock && TakeNode(*candidate, pool.blockSize, order, &offset))
+			{
+				block = candidate.get();
+				break;
+			}
+		}
+
+		if (!block)
+		{
+			if (!allowNewBlock)
+				return false;
+
+			std::unique_ptr<Block> newBlock(new Block);
+			if (!AllocateDeviceMemory(memoryType, pool.blockSize, &newBlock->memory, &newBlock->mappedPtr))
+				return false;
+
+			newBlock->freeNodes.resize(IntegralLog2Pot(pool.blockSize / s_minNodeSize) + 1);
+			newBlock->freeNodes[0].insert(0);
+			newBlock->usedSize = 0;
+
+			TakeNode(*newBlock, pool.blockSize, order, &offset);
+
+			block = newBlock.get();
+			pool.blocks.emplace_back(std::move(newBlock));
+		}
+
+		block->usedSize += nodeSize;
+
+		allocation->flags = flags & ~DeviceMemory_Dedicated;
+		allocation->mappedPtr = (block->mappedPtr) ? block->mappedPtr + offset : nullptr;
+		allocation->memory = block->memory;
+		allocation->offset = offset;
+		allocation->order = order;
+
+		return true;
+	}
+
+	void DeviceMemoryAllocator::FreeDeviceMemory(UInt32 memoryType, VkDeviceMemory memory, VkDeviceSize size)
+	{
+		// Mapped memory is implicitly unmapped
+		m_device.vkFreeMemory(m_device, memory, nullptr);
+
+		m_allocationCount--;
+		m_heapUsages[m_memoryProperties.memoryTypes[memoryType].heapIndex] -= size;
+	}
+
+	void DeviceMemoryAllocator::ReleaseNode(Block& block, VkDeviceSize blockSize, VkDeviceSize offset, UInt8 order)
+	{
+		// Merges the node with its buddy as long as the buddy is free
+		while (order > 0)
+		{
+			VkDeviceSize buddyOffset = offset ^ (blockSize >> order);
+			if (block.freeNodes[order].erase(buddyOffset) == 0)
+				break;
+
+			offset = std::min(offset, buddyOffset);
+			order--;
+		}
+
+		block.freeNodes[order].insert(offset);
+	}
+
+	bool DeviceMemoryAllocator::TakeNode(Block& block, VkDeviceSize blockSize, UInt8 order, VkDeviceSize* offset)
+	{
+		// Smallest free node big enough, split until it has the right size
+		int freeOrder = order;
+		while (freeOrder >= 0 && block.freeNodes[freeOrder].empty())
+			freeOrder--;
+
+		if (freeOrder < 0)
+			return false;
+
+		auto it = block.freeNodes[freeOrder].begin();
+		VkDeviceSize nodeOffset = *it;
+		block.freeNodes[freeOrder].erase(it);
+
+		for (int i = freeOrder + 1; i <= order; ++i)
+			block.freeNodes[i].insert(nodeOffset + (blockSize >> i));
+
+		*offset = nodeOffset;
+		return true;
+	}
+}
@@ -0,0 +1,105 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/DynamicUniformBuffer.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <cstring>
+#include <limits>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	DynamicUniformBuffer::DynamicUniformBuffer(DeviceMemoryAllocator& allocator) :
+	m_pool(allocator),
+	m_buffer(allocator.GetDevice()),
+	m_alignment(0)
+	{
+	}
+
+	/*!
+	* \brief Creates the buffer and its host-visible memory
+	* \return true if successful
+	*
+	* \param frameSize Uniform data available for each frame
+	* \param frameCount Number of frames in flight
+	* \param alignment Alignment of the dynamic offsets, at least the device minUniformBufferOffsetAlignment
+	*/
+	bool DynamicUniformBuffer::Create(VkDeviceSize frameSize, unsigned int frameCount, VkDeviceSize alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+		NazaraAssert(frameSize % alignment == 0, "Frame size must be a multiple of the alignment");
+
+		Destroy();
+
+		if (!m_buffer.Create(0, frameSize * frameCount, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT))
+		{
+			NazaraError("Failed to create uniform buffer");
+			return false;
+		}
+
+		VkMemoryRequirements requirements = m_buffer.GetMemoryRequirements();
+		if (!m_pool.Create(requirements.memoryTypeBits, frameSize, frameCount))
+		{
+			NazaraError("Failed to create uniform memory pool");
+			m_buffer.Destroy();
+			return false;
+		}
+
+		// The buffer spans every frame region, so pool offsets are buffer offsets
+		const DeviceMemoryAllocator::Allocation& allocation = m_pool.GetAllocation();
+		if (!m_buffer.BindBufferMemory(allocation.memory, allocation.offset))
+		{
+			NazaraError("Failed to bind uniform buffer memory");
+			Destroy();
+			return false;
+		}
+
+		m_alignment = alignment;
+
+		return true;
+	}
+
+	void DynamicUniformBuffer::Destroy()
+	{
+		m_buffer.Destroy();
+		m_pool.Destroy();
+	}
+
+	/*!
+	* \brief Moves on to the next frame region
+	*
+	* \remark The GPU must be done with the frame this region was last used by
+	*/
+	void DynamicUniformBuffer::NextFrame()
+	{
+		m_pool.NextFrame();
+	}
+
+	/*!
+	* \brief Copies uniform data into the current frame region
+	* \return true if successful, false if the region is full
+	*
+	* \param data Uniform data
+	* \param size Size of the data
+	* \param dynamicOffset Offset to bind the descriptor set with
+	*
+	* \remark May be called from any thread
+	*/
+	bool DynamicUniformBuffer::Push(const void* data, VkDeviceSize size, UInt32* dynamicOffset)
+	{
+		NazaraAssert(m_alignment > 0, "Buffer must be created first");
+		NazaraAssert(dynamicOffset, "Invalid dynamic offset");
+
+		DeviceMemoryAllocator::Allocation allocation;
+		if (!m_pool.Allocate(size, m_alignment, &allocation))
+			return false;
+
+		std::memcpy(allocation.mappedPtr, data, size);
+
+		NazaraAssert(allocation.offset <= std::numeric_limits<UInt32>::max(), "Dynamic offset overflow");
+
+		*dynamicOffset = static_cast<UInt32>(allocation.offset);
+		return true;
+	}
+}
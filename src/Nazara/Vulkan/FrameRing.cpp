@@ -0,0 +1,220 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/FrameRing.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <limits>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	FrameRing::FrameRing(Vk::Device& device) :
+	m_recorder(device),
+	m_device(device),
+	m_swapchain(nullptr),
+	m_queue(VK_NULL_HANDLE),
+	m_imageIndex(0),
+	m_currentFrame(0)
+	{
+	}
+
+	FrameRing::~FrameRing()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Waits for the GPU to be done with the next frame, recycles its resources and acquires a swapchain image
+	* \return true if successful, false if the image couldn't be acquired (the swapchain may need to be recreated)
+	*
+	* \param swapchain Swapchain to render to, until Present
+	*/
+	bool FrameRing::BeginFrame(Vk::Swapchain& swapchain)
+	{
+		NazaraAssert(!m_frames.empty(), "Frame ring must be created first");
+
+		m_currentFrame = m_recorder.GetFrameIndex();
+		if (!m_recorder.BeginFrame())
+			return false;
+
+		RetireFrame(m_currentFrame);
+
+		// The semaphore is free again, the submission waiting on it is complete
+		Frame& frame = *m_frames[m_currentFrame];
+		if (!swapchain.AcquireNextImage(std::numeric_limits<UInt64>::max(), frame.imageAvailable, VK_NULL_HANDLE, &m_imageIndex))
+		{
+			// The frame fence still has to be signaled for the next time this frame comes around
+			Vk::Queue queue(m_device, m_queue);
+			m_recorder.Submit(queue);
+
+			NazaraWarning("Failed to acquire swapchain image");
+			return false;
+		}
+
+		m_swapchain = &swapchain;
+
+		return true;
+	}
+
+	/*!
+	* \brief Creates the resources of every frame in flight
+	* \return true if successful
+	*
+	* \param queue Queue the frames are submitted and presented with
+	* \param queueFamilyIndex Family of the queue
+	* \param parameters Frame count and per-frame resources
+	* \param allocator Allocator of the uniform and upload regions, only needed if parameters.uniformSize or parameters.uploadSize isn't zero
+	*/
+	bool FrameRing::Create(Vk::Queue& queue, UInt32 queueFamilyIndex, const Parameters& parameters, DeviceMemoryAllocator* allocator)
+	{
+		NazaraAssert(parameters.frameCount > 0, "Frame count must be over zero");
+		NazaraAssert((parameters.uniformSize == 0 && parameters.uploadSize == 0) || allocator, "An allocator is required for uniform and upload regions");
+
+		Destroy();
+
+		if (!m_recorder.Create(queueFamilyIndex, parameters.frameCount))
+		{
+			NazaraError("Failed to create command recorder");
+			return false;
+		}
+
+		m_frames.reserve(parameters.frameCount);
+		for (unsigned int i = 0; i < parameters.frameCount; ++i)
+		{
+			std::unique_ptr<Frame> frame(new Frame(m_device));
+			if (!frame->imageAvailable.Create() || !frame->renderFinished.Create())
+			{
+				NazaraError("Failed to create frame semaphores");
+				Destroy();
+				return false;
+			}
+
+			if (!parameters.descriptorPoolSizes.empty())
+			{
+				if (!frame->descriptorAllocator.Create(parameters.descriptorPoolSizes, parameters.descriptorSetsPerPool))
+				{
+					NazaraError("Failed to create frame descriptor allocator");
+					Destroy();
+					return false;
+				}
+			}
+
+			m_frames.emplace_back(std::move(frame));
+		}
+
+		if (parameters.uniformSize > 0)
+		{
+			m_uniformBuffer.reset(new DynamicUniformBuffer(*allocator));
+			if (!m_uniformBuffer->Create(parameters.uniformSize, parameters.frameCount, parameters.uniformAlignment))
+			{
+				NazaraError("Failed to create uniform buffer");
+				Destroy();
+				return false;
+			}
+		}
+
+		if (parameters.uploadSize > 0)
+		{
+			m_uploadPool.reset(new LinearMemoryPool(*allocator));
+			if (!m_uploadPool->Create(parameters.uploadMemoryTypeBits, parameters.uploadSize, parameters.frameCount))
+			{
+				NazaraError("Failed to create upload pool");
+				Destroy();
+				return false;
+			}
+		}
+
+		m_currentFrame = 0;
+		m_queue = queue;
+		m_swapchain = nullptr;
+
+		return true;
+	}
+
+	void FrameRing::Destroy()
+	{
+		// Waits for every frame in flight
+		m_recorder.Destroy();
+
+		for (unsigned int i = 0; i < m_frames.size(); ++i)
+			RetireFrame(i);
+
+		m_frames.clear();
+		m_uniformBuffer.reset();
+		m_uploadPool.reset();
+	}
+
+	/*!
+	* \brief Calls a function once the GPU is done with the current frame
+	*
+	* \param destructor Function destroying a resource used by the frame (a pipeline, a device memory allocation, ...)
+	*/
+	void FrameRing::DestroyLater(std::function<void()> destructor)
+	{
+		NazaraAssert(!m_frames.empty(), "Frame ring must be created first");
+
+		m_frames[m_currentFrame]->deferredDestructors.emplace_back(std::move(destructor));
+	}
+
+	/*!
+	* \brief Gets the descriptor allocator of the current frame, for descriptor sets living until the GPU is done with it
+	*/
+	DescriptorAllocator& FrameRing::GetDescriptorAllocator()
+	{
+		NazaraAssert(!m_frames.empty(), "Frame ring must be created first");
+
+		return m_frames[m_currentFrame]->descriptorAllocator;
+	}
+
+	/*!
+	* \brief Submits the frame commands and presents the swapchain image
+	* \return true if successful, false if the image couldn't be presented (the swapchain may need to be recreated)
+	*/
+	bool FrameRing::Present()
+	{
+		NazaraAssert(m_swapchain, "BeginFrame must be called first");
+
+		Frame& frame = *m_frames[m_currentFrame];
+		Vk::Swapchain& swapchain = *m_swapchain;
+		m_swapchain = nullptr;
+
+		Vk::Queue queue(m_device, m_queue);
+		if (!m_recorder.Submit(queue, frame.imageAvailable, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, frame.renderFinished))
+			return false;
+
+		if (!queue.Present(swapchain, m_imageIndex, frame.renderFinished))
+		{
+			NazaraWarning("Failed to present swapchain image");
+			return false;
+		}
+
+		return true;
+	}
+
+	void FrameRing::RetireFrame(unsigned int frameIndex)
+	{
+		Frame& frame = *m_frames[frameIndex];
+
+		for (auto& destructor : frame.deferredDestructors)
+			destructor();
+
+		frame.deferredDestructors.clear();
+		frame.deferredObjects.clear();
+
+		frame.descriptorAllocator.Reset();
+
+		if (m_uniformBuffer)
+			m_uniformBuffer->NextFrame();
+
+		if (m_uploadPool)
+			m_uploadPool->NextFrame();
+	}
+
+	FrameRing::Frame::Frame(Vk::Device& device) :
+	descriptorAllocator(device),
+	imageAvailable(device),
+	renderFinished(device)
+	{
+	}
+}
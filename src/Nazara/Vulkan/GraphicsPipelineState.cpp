@@ -0,0 +1,178 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/GraphicsPipelineState.hpp>
+#include <Nazara/Core/Algorithm.hpp>
+#include <algorithm>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Vulkan structures are compared member by member, their padding is undefined
+		bool operator==(const VkPipelineColorBlendAttachmentState& lhs, const VkPipelineColorBlendAttachmentState& rhs)
+		{
+			return lhs.blendEnable == rhs.blendEnable &&
+			       lhs.srcColorBlendFactor == rhs.srcColorBlendFactor &&
+			       lhs.dstColorBlendFactor == rhs.dstColorBlendFactor &&
+			       lhs.colorBlendOp == rhs.colorBlendOp &&
+			       lhs.srcAlphaBlendFactor == rhs.srcAlphaBlendFactor &&
+			       lhs.dstAlphaBlendFactor == rhs.dstAlphaBlendFactor &&
+			       lhs.alphaBlendOp == rhs.alphaBlendOp &&
+			       lhs.colorWriteMask == rhs.colorWriteMask;
+		}
+
+		bool operator==(const VkStencilOpState& lhs, const VkStencilOpState& rhs)
+		{
+			return lhs.failOp == rhs.failOp &&
+			       lhs.passOp == rhs.passOp &&
+			       lhs.depthFailOp == rhs.depthFailOp &&
+			       lhs.compareOp == rhs.compareOp &&
+			       lhs.compareMask == rhs.compareMask &&
+			       lhs.writeMask == rhs.writeMask &&
+			       lhs.reference == rhs.reference;
+		}
+
+		bool operator==(const VkVertexInputAttributeDescription& lhs, const VkVertexInputAttributeDescription& rhs)
+		{
+			return lhs.location == rhs.location &&
+			       lhs.binding == rhs.binding &&
+			       lhs.format == rhs.format &&
+			       lhs.offset == rhs.offset;
+		}
+
+		bool operator==(const VkVertexInputBindingDescription& lhs, const VkVertexInputBindingDescription& rhs)
+		{
+			return lhs.binding == rhs.binding &&
+			       lhs.stride == rhs.stride &&
+			       lhs.inputRate == rhs.inputRate;
+		}
+
+		bool operator==(const GraphicsPipelineState::ShaderStage& lhs, const GraphicsPipelineState::ShaderStage& rhs)
+		{
+			return lhs.module == rhs.module &&
+			       lhs.stage == rhs.stage &&
+			       lhs.entryPoint == rhs.entryPoint;
+		}
+
+		template<typename T>
+		bool CompareVectors(const std::vector<T>& lhs, const std::vector<T>& rhs)
+		{
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [] (const T& a, const T& b) { return a == b; });
+		}
+
+		void HashStencil(std::size_t& seed, const VkStencilOpState& stencil)
+		{
+			HashCombine(seed, stencil.failOp);
+			HashCombine(seed, stencil.passOp);
+			HashCombine(seed, stencil.depthFailOp);
+			HashCombine(seed, stencil.compareOp);
+			HashCombine(seed, stencil.compareMask);
+			HashCombine(seed, stencil.writeMask);
+			HashCombine(seed, stencil.reference);
+		}
+	}
+
+	std::size_t GraphicsPipelineState::ComputeHash() const
+	{
+		std::size_t seed = 0;
+
+		for (float constant : blendConstants)
+			HashCombine(seed, constant);
+
+		for (const VkPipelineColorBlendAttachmentState& attachment : blendAttachments)
+		{
+			HashCombine(seed, attachment.blendEnable);
+			HashCombine(seed, attachment.srcColorBlendFactor);
+			HashCombine(seed, attachment.dstColorBlendFactor);
+			HashCombine(seed, attachment.colorBlendOp);
+			HashCombine(seed, attachment.srcAlphaBlendFactor);
+			HashCombine(seed, attachment.dstAlphaBlendFactor);
+			HashCombine(seed, attachment.alphaBlendOp);
+			HashCombine(seed, attachment.colorWriteMask);
+		}
+
+		for (VkDynamicState dynamicState : dynamicStates)
+			HashCombine(seed, dynamicState);
+
+		for (const ShaderStage& shaderStage : shaderStages)
+		{
+			HashCombine(seed, shaderStage.entryPoint);
+			HashCombine(seed, shaderStage.module);
+			HashCombine(seed, shaderStage.stage);
+		}
+
+		for (const VkVertexInputAttributeDescription& attribute : vertexAttributes)
+		{
+			HashCombine(seed, attribute.location);
+			HashCombine(seed, attribute.binding);
+			HashCombine(seed, attribute.format);
+			HashCombine(seed, attribute.offset);
+		}
+
+		for (const VkVertexInputBindingDescription& binding : vertexBindings)
+		{
+			HashCombine(seed, binding.binding);
+			HashCombine(seed, binding.stride);
+			HashCombine(seed, binding.inputRate);
+		}
+
+		HashCombine(seed, depthCompareOp);
+		HashCombine(seed, cullMode);
+		HashCombine(seed, frontFace);
+		HashCombine(seed, layout);
+		HashCombine(seed, polygonMode);
+		HashCombine(seed, topology);
+		HashCombine(seed, renderPass);
+		HashCombine(seed, sampleCount);
+		HashStencil(seed, stencilBack);
+		HashStencil(seed, stencilFront);
+		HashCombine(seed, subpass);
+		HashCombine(seed, depthBiasConstant);
+		HashCombine(seed, depthBiasSlope);
+		HashCombine(seed, lineWidth);
+		HashCombine(seed, depthBias);
+		HashCombine(seed, depthTest);
+		HashCombine(seed, depthWrite);
+		HashCombine(seed, primitiveRestart);
+		HashCombine(seed, stencilTest);
+
+		return seed;
+	}
+
+	bool GraphicsPipelineState::operator==(const GraphicsPipelineState& state) const
+	{
+		return blendConstants == state.blendConstants &&
+		       CompareVectors(blendAttachments, state.blendAttachments) &&
+		       dynamicStates == state.dynamicStates &&
+		       CompareVectors(shaderStages, state.shaderStages) &&
+		       CompareVectors(vertexAttributes, state.vertexAttributes) &&
+		       CompareVectors(vertexBindings, state.vertexBindings) &&
+		       depthCompareOp == state.depthCompareOp &&
+		       cullMode == state.cullMode &&
+		       frontFace == state.frontFace &&
+		       layout == state.layout &&
+		       polygonMode == state.polygonMode &&
+		       topology == state.topology &&
+		       renderPass == state.renderPass &&
+		       sampleCount == state.sampleCount &&
+		       stencilBack == state.stencilBack &&
+		       stencilFront == state.stencilFront &&
+		       subpass == state.subpass &&
+		       depthBiasConstant == state.depthBiasConstant &&
+		       depthBiasSlope == state.depthBiasSlope &&
+		       lineWidth == state.lineWidth &&
+		       depthBias == state.depthBias &&
+		       depthTest == state.depthTest &&
+		       depthWrite == state.depthWrite &&
+		       primitiveRestart == state.primitiveRestart &&
+		       stencilTest == state.stencilTest;
+	}
+
+	bool GraphicsPipelineState::operator!=(const GraphicsPipelineState& state) const
+	{
+		return !operator==(state);
+	}
+}
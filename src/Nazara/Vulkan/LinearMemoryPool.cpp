@@ -0,0 +1,118 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/LinearMemoryPool.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	LinearMemoryPool::LinearMemoryPool(DeviceMemoryAllocator& allocator) :
+	m_usedSize(0),
+	m_allocator(allocator),
+	m_frameSize(0),
+	m_currentFrame(0),
+	m_frameCount(0)
+	{
+	}
+
+	LinearMemoryPool::~LinearMemoryPool()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Allocates memory from the current frame region
+	* \return true if successful, false if the region is full
+	*
+	* \param size Size of the allocation
+	* \param alignment Alignment of the allocation, a power of two
+	* \param allocation Allocation to fill, it doesn't need to be freed
+	*
+	* \remark May be called from any thread
+	*/
+	bool LinearMemoryPool::Allocate(VkDeviceSize size, VkDeviceSize alignment, DeviceMemoryAllocator::Allocation* allocation)
+	{
+		NazaraAssert(m_frameCount > 0, "Pool must be created first");
+		NazaraAssert(allocation, "Invalid allocation");
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		// The pool has its own device memory, region offsets are absolute
+		VkDeviceSize regionOffset = m_currentFrame * m_frameSize;
+
+		VkDeviceSize usedSize = m_usedSize;
+		VkDeviceSize offset;
+		do
+		{
+			offset = (regionOffset + usedSize + alignment - 1) & ~(alignment - 1);
+			if (offset + size > regionOffset + m_frameSize)
+				return false;
+		}
+		while (!m_usedSize.compare_exchange_weak(usedSize, offset + size - regionOffset));
+
+		*allocation = m_allocation;
+		allocation->mappedPtr = (m_allocation.mappedPtr) ? m_allocation.mappedPtr + offset : nullptr;
+		allocation->offset = offset;
+		allocation->size = size;
+
+		return true;
+	}
+
+	/*!
+	* \brief Allocates the device memory of the pool
+	* \return true if successful
+	*
+	* \param memoryTypeBits Memory types the transient resources can be bound to
+	* \param frameSize Size available for each frame
+	* \param frameCount Number of frames in flight
+	* \param properties Properties the memory type must have
+	*/
+	bool LinearMemoryPool::Create(UInt32 memoryTypeBits, VkDeviceSize frameSize, unsigned int frameCount, VkMemoryPropertyFlags properties)
+	{
+		NazaraAssert(frameSize > 0, "Frame size must be over zero");
+		NazaraAssert(frameCount > 0, "Frame count must be over zero");
+
+		Destroy();
+
+		VkMemoryRequirements requirements;
+		requirements.alignment = 1;
+		requirements.memoryTypeBits = memoryTypeBits;
+		requirements.size = frameSize * frameCount;
+
+		if (!m_allocator.Allocate(requirements, properties, &m_allocation, DeviceMemory_Dedicated))
+		{
+			NazaraError("Failed to allocate linear pool memory");
+			return false;
+		}
+
+		m_currentFrame = 0;
+		m_frameCount = frameCount;
+		m_frameSize = frameSize;
+		m_usedSize = 0;
+
+		return true;
+	}
+
+	void LinearMemoryPool::Destroy()
+	{
+		if (m_frameCount > 0)
+		{
+			m_allocator.Free(m_allocation);
+			m_frameCount = 0;
+		}
+	}
+
+	/*!
+	* \brief Moves on to the next frame region, discarding everything allocated in it
+	*
+	* \remark Must not be called while other threads allocate from the pool
+	*/
+	void LinearMemoryPool::NextFrame()
+	{
+		NazaraAssert(m_frameCount > 0, "Pool must be created first");
+
+		m_currentFrame = (m_currentFrame + 1) % m_frameCount;
+		m_usedSize = 0;
+	}
+}
@@ -0,0 +1,479 @@
+// Copyright (C) 2016 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Vulkan"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Vulkan/PipelineManager.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Vulkan/VkInstance.hpp>
+#include <algorithm>
+#include <Nazara/Vulkan/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		const UInt32 s_pipelineCacheMagic = 0x4E5A5643; // "NZVC"
+		const UInt32 s_pipelineCacheVersion = 1;
+	}
+
+	PipelineManager::PipelineManager(Vk::Device& device) :
+	m_device(device),
+	m_pipelineCache(device),
+	m_running(false)
+	{
+	}
+
+	PipelineManager::~PipelineManager()
+	{
+		Destroy();
+	}
+
+	/*!
+	* \brief Creates the pipeline cache and starts the worker threads
+	* \return true if successful
+	*
+	* \param physicalDevice Physical device the device was created from
+	* \param cacheDirectory Directory of the pipeline cache file, the cache isn't saved if empty
+	* \param workerCount Number of threads building the preloaded pipelines
+	*
+	* \remark The cache file is named after the pipeline cache UUID of the driver, a driver update starts a new one
+	*/
+	bool PipelineManager::Create(VkPhysicalDevice physicalDevice, const String& cacheDirectory, unsigned int workerCount)
+	{
+		Destroy();
+
+		m_device.GetInstance().GetPhysicalDeviceProperties(physicalDevice, &m_deviceProperties);
+
+		std::vector<UInt8> cacheData;
+		m_cacheFilePath.Clear();
+		if (!cacheDirectory.IsEmpty())
+		{
+			if (!Directory::Exists(cacheDirectory) && !Directory::Create(cacheDirectory, true))
+				NazaraWarning("Failed to create pipeline cache directory \"" + cacheDirectory + '"');
+			else
+			{
+				String uuid;
+				for (UInt8 byte : m_deviceProperties.pipelineCacheUUID)
+				{
+					if (byte < 0x10)
+						uuid += '0';
+
+					uuid += String::Number(byte, 16);
+				}
+
+				m_cacheFilePath = cacheDirectory + NAZARA_DIRECTORY_SEPARATOR + uuid + ".nzvc";
+
+				File file(m_cacheFilePath);
+				if (file.Open(OpenMode_ReadOnly))
+				{
+					ByteStream stream(&file);
+
+					UInt32 magic = 0;
+					UInt32 version = 0;
+					UInt32 vendorId = 0;
+					UInt32 deviceId = 0;
+					UInt32 driverVersion = 0;
+					UInt32 dataSize = 0;
+					stream >> magic >> version >> vendorId >> deviceId >> driverVersion >> dataSize;
+
+					// The driver checks the data as well, but it would simply be thrown away
+					if (magic == s_pipelineCacheMagic && version == s_pipelineCacheVersion && vendorId == m_deviceProperties.vendorID &&
+					    deviceId == m_deviceProperties.deviceID && driverVersion == m_deviceProperties.driverVersion)
+					{
+						cacheData.resize(dataSize);
+						if (file.Read(cacheData.data(), dataSize) != dataSize)
+							cacheData.clear();
+					}
+				}
+			}
+		}
+
+		if (!m_pipelineCache.Create(cacheData.size(), cacheData.data()))
+		{
+			// The cache file may be corrupted, start from an empty cache
+			if (cacheData.empty() || !m_pipelineCache.Create())
+			{
+				NazaraError("Failed to create pipeline cache");
+				return false;
+			}
+		}
+
+		m_running = true;
+
+		m_workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			m_workers.emplace_back(&PipelineManager::WorkerThread, this);
+			m_workers.back().SetName("PipelineManager worker #" + String::Number(i));
+		}
+
+		return true;
+	}
+
+	void PipelineManager::Destroy()
+	{
+		{
+			LockGuard lock(m_mutex);
+			m_running = false;
+			m_queue.clear();
+		}
+
+		m_queueCondition.SignalAll();
+
+		for (Thread& worker : m_workers)
+			worker.Join();
+
+		m_workers.clear();
+
+		if (m_pipelineCache.IsValid())
+		{
+			if (!m_cacheFilePath.IsEmpty())
+				SaveCache();
+
+			m_pipelineCache.Destroy();
+		}
+
+		for (auto& pair : m_pipelines)
+		{
+			if (pair.second.pipeline != VK_NULL_HANDLE)
+				m_device.vkDestroyPipeline(m_device, pair.second.pipeline, nullptr);
+		}
+
+		m_pipelines.clear();
+	}
+
+	/*!
+	* \brief Gets the pipeline of a state, creating it if needed
+	* \return Pipeline handle, or VK_NULL_HANDLE if the creation failed
+	*
+	* \param state Pipeline state
+	*
+	* \remark A preloaded pipeline still queued is built right away on the calling thread, one being built is waited for
+	*/
+	VkPipeline PipelineManager::GetPipeline(const GraphicsPipelineState& state)
+	{
+		NazaraAssert(m_pipelineCache.IsValid(), "Pipeline manager must be created first");
+
+		{
+			LockGuard lock(m_mutex);
+
+			auto it = m_pipelines.find(state);
+			if (it == m_pipelines.end())
+				m_pipelines.emplace(state, Entry());
+			else if (it->second.queued)
+			{
+				it->second.queued = false;
+				m_queue.erase(std::find(m_queue.begin(), m_queue.end(), state));
+			}
+			else
+			{
+				while (!it->second.ready)
+				{
+					m_pipelineCondition.Wait(&m_mutex);
+					it = m_pipelines.find(state);
+				}
+
+				return it->second.pipeline;
+			}
+		}
+
+		VkPipeline pipeline = CreatePipeline(state);
+
+		LockGuard lock(m_mutex);
+
+		Entry& entry = m_pipelines[state];
+		entry.pipeline = pipeline;
+		entry.ready = true;
+
+		m_pipelineCondition.SignalAll();
+
+		return pipeline;
+	}
+
+	std::size_t PipelineManager::GetPipelineCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_pipelines.size();
+	}
+
+	/*!
+	* \brief Queues the creation of a pipeline on the worker threads
+	*
+	* \param state Pipeline state
+	*/
+	void PipelineManager::Preload(const GraphicsPipelineState& state)
+	{
+		NazaraAssert(m_pipelineCache.IsValid(), "Pipeline manager must be created first");
+
+		LockGuard lock(m_mutex);
+
+		if (m_workers.empty() || m_pipelines.find(state) != m_pipelines.end())
+			return;
+
+		Entry entry;
+		entry.queued = true;
+
+		m_pipelines.emplace(state, entry);
+		m_queue.push_back(state);
+
+		m_queueCondition.Signal();
+	}
+
+	/*!
+	* \brief Saves the pipeline cache to its file
+	* \return true if successful
+	*
+	* \remark Also done by Destroy
+	*/
+	bool PipelineManager::SaveCache()
+	{
+		NazaraAssert(m_pipelineCache.IsValid(), "Pipeline manager must be created first");
+
+		if (m_cacheFilePath.IsEmpty())
+		{
+			NazaraError("Pipeline manager has no cache directory");
+			return false;
+		}
+
+		std::vector<UInt8> cacheData;
+		if (!m_pipelineCache.GetData(&cacheData))
+			return false;
+
+		File file(m_cacheFilePath);
+		if (!file.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+		{
+			NazaraWarning("Failed to open pipeline cache file \"" + m_cacheFilePath + '"');
+			return false;
+		}
+
+		ByteStream stream(&file);
+		stream << s_pipelineCacheMagic << s_pipelineCacheVersion << m_deviceProperties.vendorID << m_deviceProperties.deviceID << m_deviceProperties.driverVersion << static_cast<UInt32>(cacheData.size());
+
+		if (file.Write(cacheData.data(), cacheData.size()) != cacheData.size())
+		{
+			NazaraWarning("Failed to write pipeline cache file \"" + m_cacheFilePath + '"');
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	* \brief Gets the pipeline of a state without waiting for it
+	* \return Pipeline handle, or VK_NULL_HANDLE while it is being built (or if its creation failed)
+	*
+	* \param state Pipeline state
+	*
+	* \remark Preloads the pipeline if it wasn't already
+	*/
+	VkPipeline PipelineManager::TryGetPipeline(const GraphicsPipelineState& state)
+	{
+		NazaraAssert(m_pipelineCache.IsValid(), "Pipeline manager must be created first");
+
+		{
+			LockGuard lock(m_mutex);
+
+			auto it = m_pipelines.find(state);
+			if (it != m_pipelines.end())
+				return (it->second.ready) ? it->second.pipeline : VK_NULL_HANDLE;
+		}
+
+		// Without workers, the pipeline can only be built right away
+		if (m_workers.empty())
+			return GetPipeline(state);
+
+		Preload(state);
+		return VK_NULL_HANDLE;
+	}
+
+	VkPipeline PipelineManager::CreatePipeline(const GraphicsPipelineState& state)
+	{
+		std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
+		shaderStages.reserve(state.shaderStages.size());
+		for (const GraphicsPipelineState::ShaderStage& shaderStage : state.shaderStages)
+		{
+			VkPipelineShaderStageCreateInfo stageInfo =
+			{
+				VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				nullptr,
+				0,
+				shaderStage.stage,
+				shaderStage.module,
+				shaderStage.entryPoint.GetConstBuffer(),
+				nullptr
+			};
+
+			shaderStages.push_back(stageInfo);
+		}
+
+		VkPipelineVertexInputStateCreateInfo vertexInputInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<UInt32>(state.vertexBindings.size()),
+			state.vertexBindings.data(),
+			static_cast<UInt32>(state.vertexAttributes.size()),
+			state.vertexAttributes.data()
+		};
+
+		VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			state.topology,
+			static_cast<VkBool32>(state.primitiveRestart)
+		};
+
+		// Viewport and scissor are expected to be part of the dynamic states
+		VkPipelineViewportStateCreateInfo viewportInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			1U,
+			nullptr,
+			1U,
+			nullptr
+		};
+
+		VkPipelineRasterizationStateCreateInfo rasterizationInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			VK_FALSE,
+			VK_FALSE,
+			state.polygonMode,
+			state.cullMode,
+			state.frontFace,
+			static_cast<VkBool32>(state.depthBias),
+			state.depthBiasConstant,
+			0.f,
+			state.depthBiasSlope,
+			state.lineWidth
+		};
+
+		VkPipelineMultisampleStateCreateInfo multisampleInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			state.sampleCount,
+			VK_FALSE,
+			1.f,
+			nullptr,
+			VK_FALSE,
+			VK_FALSE
+		};
+
+		VkPipelineDepthStencilStateCreateInfo depthStencilInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<VkBool32>(state.depthTest),
+			static_cast<VkBool32>(state.depthWrite),
+			state.depthCompareOp,
+			VK_FALSE,
+			static_cast<VkBool32>(state.stencilTest),
+			state.stencilFront,
+			state.stencilBack,
+			0.f,
+			1.f
+		};
+
+		VkPipelineColorBlendStateCreateInfo colorBlendInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			VK_FALSE,
+			VK_LOGIC_OP_COPY,
+			static_cast<UInt32>(state.blendAttachments.size()),
+			state.blendAttachments.data(),
+			{state.blendConstants[0], state.blendConstants[1], state.blendConstants[2], state.blendConstants[3]}
+		};
+
+		VkPipelineDynamicStateCreateInfo dynamicStateInfo =
+		{
+			VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<UInt32>(state.dynamicStates.size()),
+			state.dynamicStates.data()
+		};
+
+		VkGraphicsPipelineCreateInfo createInfo =
+		{
+			VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+			nullptr,
+			0,
+			static_cast<UInt32>(shaderStages.size()),
+			shaderStages.data(),
+			&vertexInputInfo,
+			&inputAssemblyInfo,
+			nullptr,
+			&viewportInfo,
+			&rasterizationInfo,
+			&multisampleInfo,
+			&depthStencilInfo,
+			&colorBlendInfo,
+			(state.dynamicStates.empty()) ? nullptr : &dynamicStateInfo,
+			state.layout,
+			state.renderPass,
+			state.subpass,
+			VK_NULL_HANDLE,
+			-1
+		};
+
+		// The pipeline cache is internally synchronized, workers may create pipelines at the same time
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		VkResult result = m_device.vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1U, &createInfo, nullptr, &pipeline);
+		if (result != VkResult::VK_SUCCESS)
+		{
+			NazaraError("Failed to create graphics pipeline (error " + String::Number(static_cast<int>(result)) + ')');
+			return VK_NULL_HANDLE;
+		}
+
+		return pipeline;
+	}
+
+	void PipelineManager::WorkerThread()
+	{
+		for (;;)
+		{
+			GraphicsPipelineState state;
+			{
+				LockGuard lock(m_mutex);
+
+				while (m_running && m_queue.empty())
+					m_queueCondition.Wait(&m_mutex);
+
+				if (!m_running)
+					return;
+
+				state = std::move(m_queue.front());
+				m_queue.pop_front();
+
+				m_pipelines[state].queued = false;
+			}
+
+			VkPipeline pipeline = CreatePipeline(state);
+
+			LockGuard lock(m_mutex);
+
+			Entry& entry = m_pipelines[state];
+			entry.pipeline = pipeline;
+			entry.ready = true;
+
+			m_pipelineCondition.SignalAll();
+		}
+	}
+}
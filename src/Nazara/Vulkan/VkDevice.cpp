@@ -40,6 +40,7 @@ namespace Nz
 				ErrorFlags flags(ErrorFlag_ThrowException, true);
 
 				NAZARA_VULKAN_LOAD_DEVICE(vkAllocateCommandBuffers);
+				NAZARA_VULKAN_LOAD_DEVICE(vkAllocateDescriptorSets);
 				NAZARA_VULKAN_LOAD_DEVICE(vkAllocateMemory);
 				NAZARA_VULKAN_LOAD_DEVICE(vkBeginCommandBuffer);
 				NAZARA_VULKAN_LOAD_DEVICE(vkBindBufferMemory);
@@ -95,10 +96,12 @@ namespace Nz
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateDescriptorPool);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateDescriptorSetLayout);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateEvent);
+				NAZARA_VULKAN_LOAD_DEVICE(vkCreateFence);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateFramebuffer);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateGraphicsPipelines);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateImage);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateImageView);
+				NAZARA_VULKAN_LOAD_DEVICE(vkCreatePipelineCache);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreatePipelineLayout);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateRenderPass);
 				NAZARA_VULKAN_LOAD_DEVICE(vkCreateSampler);
@@ -111,10 +114,12 @@ namespace Nz
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyDescriptorSetLayout);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyDevice);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyEvent);
+				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyFence);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyFramebuffer);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyImage);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyImageView);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyPipeline);
+				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyPipelineCache);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyPipelineLayout);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroyRenderPass);
 				NAZARA_VULKAN_LOAD_DEVICE(vkDestroySampler);
@@ -134,6 +139,7 @@ namespace Nz
 				NAZARA_VULKAN_LOAD_DEVICE(vkGetImageMemoryRequirements);
 				NAZARA_VULKAN_LOAD_DEVICE(vkGetImageSparseMemoryRequirements);
 				NAZARA_VULKAN_LOAD_DEVICE(vkGetImageSubresourceLayout);
+				NAZARA_VULKAN_LOAD_DEVICE(vkGetPipelineCacheData);
 				NAZARA_VULKAN_LOAD_DEVICE(vkGetRenderAreaGranularity);
 				NAZARA_VULKAN_LOAD_DEVICE(vkInvalidateMappedMemoryRanges);
 				NAZARA_VULKAN_LOAD_DEVICE(vkMapMemory);
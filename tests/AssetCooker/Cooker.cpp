@@ -0,0 +1,344 @@
+#include "Cooker.hpp"
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/PackArchive.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <cstdio>
+
+namespace
+{
+	// Bumped when the cooked data changes for the same sources, every asset is then cooked again
+	constexpr unsigned int CookerVersion = 1;
+
+	Nz::String GetExtension(const Nz::String& fileName)
+	{
+		std::size_t dot = fileName.FindLast('.');
+		if (dot == Nz::String::npos)
+			return Nz::String();
+
+		return fileName.SubString(dot + 1).ToLower();
+	}
+
+	Nz::String ReplaceExtension(const Nz::String& path, const char* extension)
+	{
+		std::size_t dot = path.FindLast('.');
+		std::size_t slash = path.FindLast('/');
+		if (dot == Nz::String::npos || (slash != Nz::String::npos && dot < slash))
+			return path + '.' + extension;
+
+		return path.SubString(0, dot - 1) + '.' + extension;
+	}
+}
+
+Cooker::Cooker(const CookerParameters& parameters) :
+m_parameters(parameters)
+{
+}
+
+bool Cooker::Run(CookerResults* results)
+{
+	m_assets.clear();
+	if (!CollectAssets(m_parameters.sourceDirectory, Nz::String()))
+		return false;
+
+	results->assetCount = m_assets.size();
+
+	// Two sources cannot be cooked to the same file (ex: wall.png and wall.tga)
+	std::unordered_map<Nz::String, std::size_t> cookedPaths;
+	for (std::size_t i = 0; i < m_assets.size(); ++i)
+	{
+		auto pair = cookedPaths.emplace(m_assets[i].cookedPath, i);
+		if (!pair.second)
+		{
+			std::fprintf(stderr, "\"%s\" and \"%s\" are both cooked to \"%s\"\n", m_assets[pair.first->second].sourcePath.GetConstBuffer(), m_assets[i].sourcePath.GetConstBuffer(), m_assets[i].cookedPath.GetConstBuffer());
+			return false;
+		}
+	}
+
+	std::unordered_map<Nz::String, ManifestEntry> manifest;
+	if (!m_parameters.forceRebuild)
+		LoadManifest(&manifest);
+
+	// Hashing reads every source, the workers overlap the reads
+	Nz::UInt64 startTime = Nz::GetElapsedMicroseconds();
+
+	Nz::TaskScheduler::ParallelFor(0, m_assets.size(), 16, [this, &manifest](std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			Asset& asset = m_assets[i];
+			asset.hash = Nz::File::ComputeHash(Nz::HashType_XXHash64, m_parameters.sourceDirectory + '/' + asset.sourcePath);
+
+			auto it = manifest.find(asset.sourcePath);
+			if (it != manifest.end() && it->second.cookedPath == asset.cookedPath && it->second.hash == asset.hash.ToHex())
+				asset.dirty = !Nz::File::Exists(m_parameters.outputDirectory + '/' + asset.cookedPath);
+		}
+	});
+
+	Nz::UInt64 hashedTime = Nz::GetElapsedMicroseconds();
+	results->hashingTime = (hashedTime - startTime) / 1000000.0;
+
+	// Directories are created beforehand, the tasks only write files
+	std::vector<std::size_t> dirtyAssets;
+	for (std::size_t i = 0; i < m_assets.size(); ++i)
+	{
+		Asset& asset = m_assets[i];
+		if (!asset.dirty)
+		{
+			asset.succeeded = true;
+			continue;
+		}
+
+		Nz::String directory = Nz::File::GetDirectory(m_parameters.outputDirectory + '/' + asset.cookedPath);
+		if (!Nz::Directory::Exists(directory) && !Nz::Directory::Create(directory, true))
+		{
+			std::fprintf(stderr, "Failed to create directory \"%s\"\n", directory.GetConstBuffer());
+			return false;
+		}
+
+		dirtyAssets.push_back(i);
+	}
+
+	// Cooking times vary a lot between assets, they are taken one by one
+	Nz::TaskScheduler::ParallelFor(0, dirtyAssets.size(), 1, [this, &dirtyAssets](std::size_t first, std::size_t last)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			Asset& asset = m_assets[dirtyAssets[i]];
+			asset.succeeded = CookAsset(asset);
+		}
+	});
+
+	Nz::UInt64 cookedTime = Nz::GetElapsedMicroseconds();
+	results->cookingTime = (cookedTime - hashedTime) / 1000000.0;
+
+	for (std::size_t index : dirtyAssets)
+	{
+		const Asset& asset = m_assets[index];
+		if (asset.succeeded)
+			results->cookedCount++;
+		else
+		{
+			results->failedCount++;
+			std::fprintf(stderr, "Failed to cook \"%s\"\n", asset.sourcePath.GetConstBuffer());
+		}
+	}
+
+	results->upToDateCount = m_assets.size() - dirtyAssets.size();
+
+	// The cooked files of the sources which disappeared are removed, they would end up in the pack otherwise
+	for (const auto& pair : manifest)
+	{
+		if (cookedPaths.find(pair.second.cookedPath) == cookedPaths.end())
+		{
+			if (Nz::File::Delete(m_parameters.outputDirectory + '/' + pair.second.cookedPath))
+				results->removedCount++;
+		}
+	}
+
+	if (!SaveManifest())
+		return false;
+
+	if (!m_parameters.packPath.IsEmpty())
+	{
+		bool outOfDate = results->cookedCount > 0 || results->removedCount > 0 || !Nz::File::Exists(m_parameters.packPath);
+		if (outOfDate && results->failedCount == 0)
+		{
+			if (!BuildPack())
+				return false;
+
+			results->packBuilt = true;
+		}
+
+		results->packingTime = (Nz::GetElapsedMicroseconds() - cookedTime) / 1000000.0;
+	}
+
+	return results->failedCount == 0;
+}
+
+bool Cooker::BuildPack() const
+{
+	// The pack holds the cooked files only, under their path relative to the output directory
+	std::vector<Nz::PackArchive::SourceEntry> entries(m_assets.size());
+	for (std::size_t i = 0; i < m_assets.size(); ++i)
+	{
+		entries[i].path = m_assets[i].cookedPath;
+		entries[i].filePath = m_parameters.outputDirectory + '/' + m_assets[i].cookedPath;
+	}
+
+	if (!Nz::PackArchive::Build(m_parameters.packPath, entries))
+	{
+		std::fprintf(stderr, "Failed to build pack \"%s\"\n", m_parameters.packPath.GetConstBuffer());
+		return false;
+	}
+
+	return true;
+}
+
+bool Cooker::CollectAssets(const Nz::String& directoryPath, const Nz::String& relativePath)
+{
+	Nz::Directory directory(directoryPath);
+	if (!directory.Open())
+	{
+		std::fprintf(stderr, "Failed to open directory \"%s\"\n", directoryPath.GetConstBuffer());
+		return false;
+	}
+
+	while (directory.NextResult())
+	{
+		Nz::String name = directory.GetResultName();
+		Nz::String path = (relativePath.IsEmpty()) ? name : relativePath + '/' + name;
+
+		if (directory.IsResultDirectory())
+		{
+			if (!CollectAssets(directory.GetResultPath(), path))
+				return false;
+
+			continue;
+		}
+
+		Asset asset;
+		asset.sourcePath = path;
+
+		// Cooked formats are loaded as they are
+		Nz::String extension = GetExtension(name);
+		bool cooked = (extension == "ktx2" || extension == "nmf");
+		if (!cooked && Nz::MeshLoader::IsExtensionSupported(extension))
+		{
+			asset.type = AssetType_Mesh;
+			asset.cookedPath = ReplaceExtension(path, "nmf");
+		}
+		else if (!cooked && Nz::ImageLoader::IsExtensionSupported(extension))
+		{
+			asset.type = AssetType_Image;
+			asset.cookedPath = ReplaceExtension(path, "ktx2");
+		}
+		else
+		{
+			asset.type = AssetType_Copy;
+			asset.cookedPath = path;
+		}
+
+		m_assets.emplace_back(std::move(asset));
+	}
+
+	return true;
+}
+
+bool Cooker::CookAsset(const Asset& asset) const
+{
+	Nz::String sourcePath = m_parameters.sourceDirectory + '/' + asset.sourcePath;
+	Nz::String cookedPath = m_parameters.outputDirectory + '/' + asset.cookedPath;
+
+	switch (asset.type)
+	{
+		case AssetType_Copy:
+			return Nz::File::Copy(sourcePath, cookedPath);
+
+		case AssetType_Image:
+			return CookImage(sourcePath, cookedPath);
+
+		case AssetType_Mesh:
+			return CookMesh(sourcePath, cookedPath);
+	}
+
+	return false;
+}
+
+bool Cooker::CookImage(const Nz::String& sourcePath, const Nz::String& cookedPath) const
+{
+	Nz::Image image;
+	if (!image.LoadFromFile(sourcePath))
+		return false;
+
+	// The mipmaps are generated before the compression, which would make it impossible
+	if (m_parameters.generateMipmaps && image.GetLevelCount() == 1 && !image.IsCompressed())
+	{
+		if (!image.GenerateMipmaps())
+		{
+			if (!image.Convert(Nz::PixelFormatType_RGBA8) || !image.GenerateMipmaps())
+				return false;
+		}
+	}
+
+	if (m_parameters.textureFormat != Nz::PixelFormatType_Undefined && image.GetFormat() != m_parameters.textureFormat)
+	{
+		if (!image.Convert(m_parameters.textureFormat))
+			return false;
+	}
+
+	return image.SaveToFile(cookedPath);
+}
+
+bool Cooker::CookMesh(const Nz::String& sourcePath, const Nz::String& cookedPath) const
+{
+	// Buffers are only read back to be saved, they do not need to live on the GPU
+	Nz::MeshParams params;
+	params.storage = Nz::DataStorage_Software;
+
+	Nz::MeshRef mesh = Nz::Mesh::New();
+	if (!mesh->LoadFromFile(sourcePath, params))
+		return false;
+
+	return mesh->SaveToFile(cookedPath);
+}
+
+Nz::String Cooker::GetOptionsSignature() const
+{
+	Nz::String signature = "AssetCooker " + Nz::String::Number(CookerVersion);
+	signature += " format=" + ((m_parameters.textureFormat != Nz::PixelFormatType_Undefined) ? Nz::PixelFormat::GetName(m_parameters.textureFormat) : Nz::String("none"));
+	signature += " mipmaps=" + Nz::String::Boolean(m_parameters.generateMipmaps);
+
+	return signature;
+}
+
+// The manifest lists the hash of every source cooked by the last run, and is dropped if the options changed since
+bool Cooker::LoadManifest(std::unordered_map<Nz::String, ManifestEntry>* entries) const
+{
+	Nz::File file(m_parameters.outputDirectory + '/' + ManifestName);
+	if (!file.Open(Nz::OpenMode_ReadOnly | Nz::OpenMode_Text))
+		return false;
+
+	if (file.ReadLine() != GetOptionsSignature())
+		return false;
+
+	while (!file.EndOfFile())
+	{
+		// <hash>\t<source path>\t<cooked path>
+		std::vector<Nz::String> fields;
+		if (file.ReadLine().Split(fields, '\t') != 3)
+			continue;
+
+		ManifestEntry& entry = (*entries)[fields[1]];
+		entry.cookedPath = std::move(fields[2]);
+		entry.hash = std::move(fields[0]);
+	}
+
+	return true;
+}
+
+// Failed assets are left out, so they are cooked again by the next run
+bool Cooker::SaveManifest() const
+{
+	Nz::String manifestPath = m_parameters.outputDirectory + '/' + ManifestName;
+
+	Nz::File file(manifestPath);
+	if (!file.Open(Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate | Nz::OpenMode_Text))
+	{
+		std::fprintf(stderr, "Failed to open \"%s\"\n", manifestPath.GetConstBuffer());
+		return false;
+	}
+
+	file.Write(GetOptionsSignature() + '\n');
+	for (const Asset& asset : m_assets)
+	{
+		if (asset.succeeded)
+			file.Write(asset.hash.ToHex() + '\t' + asset.sourcePath + '\t' + asset.cookedPath + '\n');
+	}
+
+	return true;
+}
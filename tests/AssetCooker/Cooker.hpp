@@ -0,0 +1,84 @@
+#pragma once
+
+#ifndef NAZARA_ASSETCOOKER_COOKER_HPP
+#define NAZARA_ASSETCOOKER_COOKER_HPP
+
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Utility/Enums.hpp>
+#include <unordered_map>
+#include <vector>
+
+struct CookerParameters
+{
+	Nz::PixelFormatType textureFormat = Nz::PixelFormatType_DXT5; //< Undefined keeps the loaded format
+	Nz::String outputDirectory;
+	Nz::String packPath;                                          //< No pack is built if empty
+	Nz::String sourceDirectory;
+	bool forceRebuild = false;
+	bool generateMipmaps = true;
+};
+
+struct CookerResults
+{
+	double cookingTime = 0.0; //< In seconds
+	double hashingTime = 0.0;
+	double packingTime = 0.0;
+	std::size_t assetCount = 0;
+	std::size_t cookedCount = 0;
+	std::size_t failedCount = 0;
+	std::size_t removedCount = 0;
+	std::size_t upToDateCount = 0;
+	bool packBuilt = false;
+};
+
+// Turns a tree of source assets into the data loaded at runtime: meshes are saved as NMF, images as block compressed KTX2 with their mipmaps,
+// anything else is copied. Only the assets whose content changed since the last run are cooked again, the output can then be packed.
+class Cooker
+{
+	public:
+		Cooker(const CookerParameters& parameters);
+		~Cooker() = default;
+
+		bool Run(CookerResults* results);
+
+		static constexpr const char* ManifestName = "AssetCooker.manifest";
+
+	private:
+		enum AssetType
+		{
+			AssetType_Copy,
+			AssetType_Image,
+			AssetType_Mesh
+		};
+
+		struct Asset
+		{
+			AssetType type;
+			Nz::ByteArray hash;
+			Nz::String cookedPath; //< Relative to the output directory
+			Nz::String sourcePath; //< Relative to the source directory
+			bool dirty = true;
+			bool succeeded = false;
+		};
+
+		struct ManifestEntry
+		{
+			Nz::String cookedPath;
+			Nz::String hash;
+		};
+
+		bool BuildPack() const;
+		bool CollectAssets(const Nz::String& directoryPath, const Nz::String& relativePath);
+		bool CookAsset(const Asset& asset) const;
+		bool CookImage(const Nz::String& sourcePath, const Nz::String& cookedPath) const;
+		bool CookMesh(const Nz::String& sourcePath, const Nz::String& cookedPath) const;
+		Nz::String GetOptionsSignature() const;
+		bool LoadManifest(std::unordered_map<Nz::String, ManifestEntry>* entries) const;
+		bool SaveManifest() const;
+
+		CookerParameters m_parameters;
+		std::vector<Asset> m_assets;
+};
+
+#endif // NAZARA_ASSETCOOKER_COOKER_HPP
@@ -0,0 +1,155 @@
+#include "Cooker.hpp"
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Cooks a tree of source assets into the data loaded at runtime, and writes what was done as JSON on the standard output
+// Usage: AssetCooker <source directory> <output directory> [--pack=<file>] [--texture-format=<pixel format>|none] [--no-mipmaps]
+//                    [--workers=<count>] [--force]
+//
+// Meshes become NMF files, images KTX2 files (DXT5 by default, any format with a compression or conversion function can be given), the rest is copied.
+// The manifest left in the output directory holds the hash of every source: the next runs only cook the sources whose content changed.
+
+namespace
+{
+	bool ParseTextureFormat(const char* name, Nz::PixelFormatType* format)
+	{
+		if (std::strcmp(name, "none") == 0)
+		{
+			*format = Nz::PixelFormatType_Undefined;
+			return true;
+		}
+
+		Nz::String lowerName = Nz::String(name).ToLower();
+		for (unsigned int i = 0; i <= Nz::PixelFormatType_Max; ++i)
+		{
+			Nz::PixelFormatType candidate = static_cast<Nz::PixelFormatType>(i);
+			if (Nz::PixelFormat::GetName(candidate).ToLower() == lowerName)
+			{
+				*format = candidate;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ParseOptions(int argc, char* argv[], CookerParameters* parameters, unsigned int* workerCount)
+	{
+		std::vector<const char*> directories;
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+
+			if (std::strcmp(arg, "--force") == 0)
+				parameters->forceRebuild = true;
+			else if (std::strcmp(arg, "--no-mipmaps") == 0)
+				parameters->generateMipmaps = false;
+			else if (std::strncmp(arg, "--pack=", 7) == 0)
+				parameters->packPath = arg + 7;
+			else if (std::strncmp(arg, "--texture-format=", 17) == 0)
+			{
+				if (!ParseTextureFormat(arg + 17, &parameters->textureFormat))
+				{
+					std::fprintf(stderr, "Unknown pixel format: %s\n", arg + 17);
+					return false;
+				}
+			}
+			else if (std::strncmp(arg, "--workers=", 10) == 0)
+				*workerCount = static_cast<unsigned int>(std::strtoul(arg + 10, nullptr, 10));
+			else if (std::strncmp(arg, "--", 2) == 0)
+			{
+				std::fprintf(stderr, "Unknown argument: %s\n", arg);
+				return false;
+			}
+			else
+				directories.push_back(arg);
+		}
+
+		if (directories.size() != 2)
+		{
+			std::fprintf(stderr, "Usage: AssetCooker <source directory> <output directory> [--pack=<file>] [--texture-format=<pixel format>|none] [--no-mipmaps] [--workers=<count>] [--force]\n");
+			return false;
+		}
+
+		parameters->sourceDirectory = Nz::String(directories[0]).Trim('/', Nz::String::TrimOnlyRight);
+		parameters->outputDirectory = Nz::String(directories[1]).Trim('/', Nz::String::TrimOnlyRight);
+
+		if (!Nz::Directory::Exists(parameters->sourceDirectory))
+		{
+			std::fprintf(stderr, "Source directory \"%s\" does not exist\n", directories[0]);
+			return false;
+		}
+
+		// The sources would be cooked over themselves
+		if (parameters->sourceDirectory == parameters->outputDirectory)
+		{
+			std::fprintf(stderr, "Source and output directories must be different\n");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	CookerParameters parameters;
+	unsigned int workerCount = 0;
+	if (!ParseOptions(argc, argv, &parameters, &workerCount))
+		return EXIT_FAILURE;
+
+	// The standard output only receives the results, the log file still receives the messages once the modules are initialized
+	Nz::Log::Enable(false);
+
+	if (workerCount > 0)
+		Nz::TaskScheduler::SetWorkerCount(workerCount);
+
+	Nz::Initializer<Nz::Utility> utility;
+	if (!utility)
+	{
+		std::fprintf(stderr, "Failed to initialize the utility module\n");
+		return EXIT_FAILURE;
+	}
+
+	Nz::Log::Enable(true);
+	Nz::Log::GetLogger()->EnableStdReplication(false);
+
+	if (parameters.textureFormat != Nz::PixelFormatType_Undefined && !Nz::PixelFormat::IsConversionSupported(Nz::PixelFormatType_RGBA8, parameters.textureFormat))
+	{
+		std::fprintf(stderr, "Images cannot be converted to %s\n", Nz::PixelFormat::GetName(parameters.textureFormat).GetConstBuffer());
+		return EXIT_FAILURE;
+	}
+
+	if (!Nz::Directory::Exists(parameters.outputDirectory) && !Nz::Directory::Create(parameters.outputDirectory, true))
+	{
+		std::fprintf(stderr, "Failed to create output directory \"%s\"\n", parameters.outputDirectory.GetConstBuffer());
+		return EXIT_FAILURE;
+	}
+
+	Cooker cooker(parameters);
+
+	CookerResults results;
+	bool succeeded = cooker.Run(&results);
+
+	std::printf("{\n");
+	std::printf("\t\"succeeded\": %s,\n", (succeeded) ? "true" : "false");
+	std::printf("\t\"workers\": %u,\n", Nz::TaskScheduler::GetWorkerCount());
+	std::printf("\t\"assets\": %llu,\n\t\"cooked\": %llu,\n\t\"up_to_date\": %llu,\n\t\"failed\": %llu,\n\t\"removed\": %llu,\n",
+	            static_cast<unsigned long long>(results.assetCount), static_cast<unsigned long long>(results.cookedCount), static_cast<unsigned long long>(results.upToDateCount),
+	            static_cast<unsigned long long>(results.failedCount), static_cast<unsigned long long>(results.removedCount));
+	std::printf("\t\"pack_built\": %s,\n", (results.packBuilt) ? "true" : "false");
+	std::printf("\t\"hashing_s\": %.3f,\n\t\"cooking_s\": %.3f,\n\t\"packing_s\": %.3f\n", results.hashingTime, results.cookingTime, results.packingTime);
+	std::printf("}\n");
+
+	Nz::Log::Enable(false);
+
+	return (succeeded) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
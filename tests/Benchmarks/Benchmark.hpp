@@ -0,0 +1,147 @@
+#pragma once
+
+#ifndef NAZARA_BENCHMARKS_BENCHMARK_HPP
+#define NAZARA_BENCHMARKS_BENCHMARK_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef NAZARA_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
+namespace Benchmark
+{
+	struct Result
+	{
+		std::string name;
+		std::size_t bytesPerOperation;
+		std::size_t iterations;
+		double nsPerOperation;
+	};
+
+	// Measures an operation: the iteration count is first scaled until a run lasts long enough to be timed,
+	// then the run is repeated and the median is kept, which is not disturbed by an occasional preemption
+	class State
+	{
+		public:
+			State(std::string name, double minTime, unsigned int repetitions) :
+			m_name(std::move(name)),
+			m_minTime(minTime),
+			m_bytesPerOperation(0),
+			m_repetitions(repetitions)
+			{
+			}
+
+			template<typename F> void Measure(const char* variant, F&& operation)
+			{
+				std::size_t iterations = 1;
+				for (;;)
+				{
+					double elapsed = Time(operation, iterations);
+					if (elapsed >= m_minTime || iterations >= (std::size_t(1) << 40))
+						break;
+
+					// Aims a bit over the minimum time, without growing more than tenfold at once
+					double factor = (elapsed > 0.0) ? std::min(m_minTime * 1.2 / elapsed, 10.0) : 10.0;
+					iterations = std::max(iterations + 1, static_cast<std::size_t>(iterations * factor));
+				}
+
+				std::vector<double> timings(m_repetitions);
+				for (double& timing : timings)
+					timing = Time(operation, iterations) / iterations;
+
+				std::nth_element(timings.begin(), timings.begin() + timings.size() / 2, timings.end());
+
+				Result result;
+				result.name = (variant) ? m_name + '/' + variant : m_name;
+				result.bytesPerOperation = m_bytesPerOperation;
+				result.iterations = iterations;
+				result.nsPerOperation = timings[timings.size() / 2];
+
+				m_results.push_back(std::move(result));
+			}
+
+			template<typename F> void Measure(F&& operation)
+			{
+				Measure(nullptr, std::forward<F>(operation));
+			}
+
+			const std::vector<Result>& GetResults() const
+			{
+				return m_results;
+			}
+
+			// Used to report a throughput, 0 if the operation doesn't process a meaningful amount of data
+			void SetBytesPerOperation(std::size_t bytes)
+			{
+				m_bytesPerOperation = bytes;
+			}
+
+		private:
+			template<typename F> double Time(F& operation, std::size_t iterations)
+			{
+				auto start = std::chrono::steady_clock::now();
+				for (std::size_t i = 0; i < iterations; ++i)
+					operation();
+
+				return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			}
+
+			std::string m_name;
+			std::vector<Result> m_results;
+			double m_minTime;
+			std::size_t m_bytesPerOperation;
+			unsigned int m_repetitions;
+	};
+
+	using Function = void(*)(State& state);
+
+	struct Entry
+	{
+		const char* name;
+		Function function;
+	};
+
+	inline std::vector<Entry>& GetEntries()
+	{
+		static std::vector<Entry> entries;
+		return entries;
+	}
+
+	struct Registrar
+	{
+		Registrar(const char* name, Function function)
+		{
+			GetEntries().push_back({name, function});
+		}
+	};
+
+	// Prevents the compiler from discarding a result that is never read
+	template<typename T>
+	void DoNotOptimize(const T& value)
+	{
+		#ifdef NAZARA_COMPILER_MSVC
+		const volatile char* address = reinterpret_cast<const volatile char*>(&value);
+		static_cast<void>(*address);
+		_ReadWriteBarrier();
+		#else
+		asm volatile("" : : "r"(&value) : "memory");
+		#endif
+	}
+}
+
+#define NAZARA_BENCHMARK_CONCAT_(a, b) a ## b
+#define NAZARA_BENCHMARK_CONCAT(a, b) NAZARA_BENCHMARK_CONCAT_(a, b)
+
+// Declares a benchmark function taking a Benchmark::State& named state
+#define BENCHMARK(name) \
+	static void NAZARA_BENCHMARK_CONCAT(Benchmark_, __LINE__)(Benchmark::State& state); \
+	static Benchmark::Registrar NAZARA_BENCHMARK_CONCAT(BenchmarkRegistrar_, __LINE__)(name, &NAZARA_BENCHMARK_CONCAT(Benchmark_, __LINE__)); \
+	static void NAZARA_BENCHMARK_CONCAT(Benchmark_, __LINE__)(Benchmark::State& state)
+
+#endif // NAZARA_BENCHMARKS_BENCHMARK_HPP
@@ -0,0 +1,217 @@
+#include "Benchmark.hpp"
+#include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/MemoryPool.hpp>
+#include <Nazara/Core/Signal.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Core/StringView.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <array>
+#include <memory>
+#include <vector>
+
+BENCHMARK("Core/Bitset")
+{
+	Nz::Bitset<> a(4096, false);
+	Nz::Bitset<> b(4096, false);
+	for (std::size_t i = 0; i < 4096; i += 3)
+		a.Set(i);
+
+	for (std::size_t i = 0; i < 4096; i += 5)
+		b.Set(i);
+
+	Nz::Bitset<> result;
+	state.SetBytesPerOperation(4096 / 8);
+	state.Measure("AND4096", [&]()
+	{
+		result.PerformsAND(a, b);
+		Benchmark::DoNotOptimize(result);
+	});
+
+	state.Measure("Count4096", [&]()
+	{
+		std::size_t count = a.Count();
+		Benchmark::DoNotOptimize(count);
+	});
+
+	state.SetBytesPerOperation(0);
+	state.Measure("Iterate4096", [&]()
+	{
+		std::size_t sum = 0;
+		for (std::size_t bit = b.FindFirst(); bit != b.npos; bit = b.FindNext(bit))
+			sum += bit;
+
+		Benchmark::DoNotOptimize(sum);
+	});
+
+	state.Measure("UnboundedSet", [&]()
+	{
+		Nz::Bitset<> bitset;
+		for (std::size_t i = 0; i < 256; i += 7)
+			bitset.UnboundedSet(i);
+
+		Benchmark::DoNotOptimize(bitset);
+	});
+}
+
+BENCHMARK("Core/ByteStream")
+{
+	std::array<Nz::Vector3f, 256> vectors;
+	for (std::size_t i = 0; i < vectors.size(); ++i)
+		vectors[i].Set(float(i), float(i) * 0.5f, float(i) * 0.25f);
+
+	std::vector<Nz::UInt8> buffer(vectors.size() * 3 * sizeof(float));
+
+	state.SetBytesPerOperation(buffer.size());
+	state.Measure("WriteVector3f256", [&]()
+	{
+		Nz::ByteStream stream(buffer.data(), buffer.size());
+		for (const Nz::Vector3f& vector : vectors)
+			stream << vector;
+
+		Benchmark::DoNotOptimize(buffer);
+	});
+
+	state.Measure("ReadVector3f256", [&]()
+	{
+		Nz::ByteStream stream(static_cast<const void*>(buffer.data()), buffer.size());
+		for (Nz::Vector3f& vector : vectors)
+			stream >> vector;
+
+		Benchmark::DoNotOptimize(vectors);
+	});
+
+	state.Measure("WriteArrayFloat768", [&]()
+	{
+		Nz::ByteStream stream(buffer.data(), buffer.size());
+		stream.WriteArray(&vectors[0].x, vectors.size() * 3);
+
+		Benchmark::DoNotOptimize(buffer);
+	});
+
+	state.SetBytesPerOperation(sizeof(Nz::UInt32) * 1024);
+	state.Measure("WriteByteArrayUInt32x1024", [&]()
+	{
+		Nz::ByteArray byteArray;
+		Nz::ByteStream stream(&byteArray, Nz::OpenMode_WriteOnly);
+		for (Nz::UInt32 i = 0; i < 1024; ++i)
+			stream << i;
+
+		Benchmark::DoNotOptimize(byteArray);
+	});
+}
+
+BENCHMARK("Core/MemoryPool")
+{
+	constexpr unsigned int blockSize = 64;
+	constexpr unsigned int blockCount = 128;
+
+	Nz::MemoryPool pool(blockSize, blockCount);
+	std::array<void*, blockCount> blocks;
+
+	state.Measure("AllocateFree128", [&]()
+	{
+		for (void*& block : blocks)
+			block = pool.Allocate(blockSize);
+
+		Benchmark::DoNotOptimize(blocks);
+
+		for (void* block : blocks)
+			pool.Free(block);
+	});
+
+	// Reference point
+	state.Measure("NewDelete128", [&]()
+	{
+		for (void*& block : blocks)
+			block = ::operator new(blockSize);
+
+		Benchmark::DoNotOptimize(blocks);
+
+		for (void* block : blocks)
+			::operator delete(block);
+	});
+}
+
+BENCHMARK("Core/Signal")
+{
+	Nz::Signal<int> signal;
+	int sum = 0;
+
+	state.Measure("EmitNoSlot", [&]()
+	{
+		signal(1);
+	});
+
+	std::vector<Nz::Signal<int>::ConnectionGuard> connections;
+	for (unsigned int i = 0; i < 8; ++i)
+		connections.emplace_back(signal.Connect([&sum](int value) { sum += value; }));
+
+	state.Measure("Emit8Slots", [&]()
+	{
+		signal(1);
+	});
+
+	Benchmark::DoNotOptimize(sum);
+
+	state.Measure("ConnectDisconnect", [&]()
+	{
+		Nz::Signal<int>::Connection connection = signal.Connect([&sum](int value) { sum -= value; });
+		connection.Disconnect();
+	});
+}
+
+BENCHMARK("Core/String")
+{
+	Nz::String text;
+	for (unsigned int i = 0; i < 64; ++i)
+	{
+		text += "Lorem ipsum dolor sit amet ";
+		text += Nz::String::Number(i);
+		text += ' ';
+	}
+	text += "needle";
+
+	state.SetBytesPerOperation(text.GetSize());
+	state.Measure("Find", [&]()
+	{
+		std::size_t pos = text.Find("needle");
+		Benchmark::DoNotOptimize(pos);
+	});
+
+	state.Measure("FindCaseInsensitive", [&]()
+	{
+		std::size_t pos = text.Find("NEEDLE", 0, Nz::String::CaseInsensitive);
+		Benchmark::DoNotOptimize(pos);
+	});
+
+	state.Measure("SplitStringView", [&]()
+	{
+		std::vector<Nz::StringView> words;
+		text.Split(words, ' ');
+		Benchmark::DoNotOptimize(words);
+	});
+
+	state.Measure("ToLower", [&]()
+	{
+		Nz::String lower = text.ToLower();
+		Benchmark::DoNotOptimize(lower);
+	});
+
+	state.SetBytesPerOperation(0);
+	state.Measure("Append16", [&]()
+	{
+		Nz::String string;
+		for (unsigned int i = 0; i < 16; ++i)
+			string += "append";
+
+		Benchmark::DoNotOptimize(string);
+	});
+
+	state.Measure("Number", [&]()
+	{
+		Nz::String number = Nz::String::Number(123456789);
+		Benchmark::DoNotOptimize(number);
+	});
+}
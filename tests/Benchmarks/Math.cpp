@@ -0,0 +1,105 @@
+#include "Benchmark.hpp"
+#include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Sphere.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <random>
+#include <vector>
+
+BENCHMARK("Math/Matrix4")
+{
+	Nz::Matrix4f a = Nz::Matrix4f::Transform(Nz::Vector3f(1.f, 2.f, 3.f), Nz::EulerAnglesf(10.f, 20.f, 30.f).ToQuaternion(), Nz::Vector3f(2.f));
+	Nz::Matrix4f b = Nz::Matrix4f::Perspective(Nz::FromDegrees(70.f), 16.f / 9.f, 1.f, 1000.f);
+
+	state.Measure("Concatenate", [&]()
+	{
+		Nz::Matrix4f result = a * b;
+		Benchmark::DoNotOptimize(result);
+	});
+
+	state.Measure("ConcatenateAffine", [&]()
+	{
+		Nz::Matrix4f result(a);
+		result.ConcatenateAffine(a);
+		Benchmark::DoNotOptimize(result);
+	});
+
+	state.Measure("GetInverse", [&]()
+	{
+		Nz::Matrix4f result;
+		a.GetInverse(&result);
+		Benchmark::DoNotOptimize(result);
+	});
+
+	state.Measure("GetInverseAffine", [&]()
+	{
+		Nz::Matrix4f result;
+		a.GetInverseAffine(&result);
+		Benchmark::DoNotOptimize(result);
+	});
+
+	Nz::Vector3f vector(1.f, 2.f, 3.f);
+	state.Measure("TransformVector3", [&]()
+	{
+		Nz::Vector3f result = a.Transform(vector);
+		Benchmark::DoNotOptimize(result);
+	});
+
+	state.Measure("MakeTransform", [&]()
+	{
+		Nz::Matrix4f result;
+		result.MakeTransform(vector, Nz::Quaternionf::Identity(), Nz::Vector3f::Unit());
+		Benchmark::DoNotOptimize(result);
+	});
+}
+
+BENCHMARK("Math/Frustum")
+{
+	Nz::Frustumf frustum;
+	frustum.Build(Nz::FromDegrees(70.f), 16.f / 9.f, 1.f, 1000.f, Nz::Vector3f::Zero(), Nz::Vector3f::Forward());
+
+	// Same seed on each run, the ratio of culled volumes must not change between two versions
+	std::mt19937 randomGenerator(42);
+	std::uniform_real_distribution<float> distribution(-500.f, 500.f);
+
+	constexpr std::size_t volumeCount = 1024;
+	std::vector<Nz::Boxf> boxes(volumeCount);
+	std::vector<Nz::Spheref> spheres(volumeCount);
+	std::vector<Nz::Vector3f> points(volumeCount);
+	for (std::size_t i = 0; i < volumeCount; ++i)
+	{
+		points[i].Set(distribution(randomGenerator), distribution(randomGenerator), distribution(randomGenerator));
+		boxes[i].Set(points[i].x, points[i].y, points[i].z, 10.f, 10.f, 10.f);
+		spheres[i].Set(points[i].x, points[i].y, points[i].z, 10.f);
+	}
+
+	// One operation is one test
+	std::size_t index = 0;
+	state.Measure("ContainsBox", [&]()
+	{
+		bool contained = frustum.Contains(boxes[index++ % volumeCount]);
+		Benchmark::DoNotOptimize(contained);
+	});
+
+	state.Measure("ContainsSphere", [&]()
+	{
+		bool contained = frustum.Contains(spheres[index++ % volumeCount]);
+		Benchmark::DoNotOptimize(contained);
+	});
+
+	state.Measure("ContainsPoint", [&]()
+	{
+		bool contained = frustum.Contains(points[index++ % volumeCount]);
+		Benchmark::DoNotOptimize(contained);
+	});
+
+	state.Measure("IntersectBox", [&]()
+	{
+		Nz::IntersectionSide side = frustum.Intersect(boxes[index++ % volumeCount]);
+		Benchmark::DoNotOptimize(side);
+	});
+}
@@ -0,0 +1,93 @@
+#include "Benchmark.hpp"
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <random>
+#include <vector>
+
+BENCHMARK("Utility/PixelFormat")
+{
+	constexpr std::size_t pixelCount = 256 * 256;
+
+	std::vector<Nz::UInt8> source(pixelCount * 4);
+	for (std::size_t i = 0; i < source.size(); ++i)
+		source[i] = static_cast<Nz::UInt8>(i * 31);
+
+	std::vector<Nz::UInt8> destination(pixelCount * 4);
+
+	// Throughput is given in source bytes
+	state.SetBytesPerOperation(pixelCount * 4);
+	state.Measure("ConvertBGRA8ToRGBA8", [&]()
+	{
+		Nz::PixelFormat::Convert(Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGBA8, source.data(), source.data() + pixelCount * 4, destination.data());
+		Benchmark::DoNotOptimize(destination);
+	});
+
+	state.Measure("ConvertBGRA8ToL8", [&]()
+	{
+		Nz::PixelFormat::Convert(Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_L8, source.data(), source.data() + pixelCount * 4, destination.data());
+		Benchmark::DoNotOptimize(destination);
+	});
+
+	state.SetBytesPerOperation(pixelCount * 3);
+	state.Measure("ConvertRGB8ToBGRA8", [&]()
+	{
+		Nz::PixelFormat::Convert(Nz::PixelFormatType_RGB8, Nz::PixelFormatType_BGRA8, source.data(), source.data() + pixelCount * 3, destination.data());
+		Benchmark::DoNotOptimize(destination);
+	});
+}
+
+BENCHMARK("Utility/Skinning")
+{
+	constexpr unsigned int jointCount = 32;
+	constexpr unsigned int vertexCount = 4096;
+
+	std::mt19937 randomGenerator(42);
+	std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+	std::uniform_int_distribution<int> jointDistribution(0, jointCount - 1);
+
+	std::vector<Nz::Matrix4f> matrices(jointCount);
+	for (Nz::Matrix4f& matrix : matrices)
+		matrix.MakeTransform(Nz::Vector3f(distribution(randomGenerator), distribution(randomGenerator), distribution(randomGenerator)), Nz::Quaternionf(1.f, distribution(randomGenerator), distribution(randomGenerator), distribution(randomGenerator)).Normalize());
+
+	std::vector<Nz::SkeletalMeshVertex> inputVertices(vertexCount);
+	for (Nz::SkeletalMeshVertex& vertex : inputVertices)
+	{
+		vertex.position.Set(distribution(randomGenerator), distribution(randomGenerator), distribution(randomGenerator));
+		vertex.normal = Nz::Vector3f::Up();
+		vertex.tangent = Nz::Vector3f::Right();
+		vertex.uv.Set(0.5f, 0.5f);
+		vertex.weightCount = 4;
+		vertex.weights.Set(0.4f, 0.3f, 0.2f, 0.1f);
+		vertex.jointIndexes.Set(jointDistribution(randomGenerator), jointDistribution(randomGenerator), jointDistribution(randomGenerator), jointDistribution(randomGenerator));
+	}
+
+	std::vector<Nz::MeshVertex> outputVertices(vertexCount);
+
+	Nz::SkinningData skinningData;
+	skinningData.joints = nullptr;
+	skinningData.skinningMatrices = matrices.data();
+	skinningData.inputVertex = inputVertices.data();
+	skinningData.outputVertex = outputVertices.data();
+
+	// Throughput is given in skinned vertex bytes
+	state.SetBytesPerOperation(vertexCount * sizeof(Nz::SkeletalMeshVertex));
+	state.Measure("Position4096", [&]()
+	{
+		Nz::SkinPosition(skinningData, 0, vertexCount);
+		Benchmark::DoNotOptimize(outputVertices);
+	});
+
+	state.Measure("PositionNormal4096", [&]()
+	{
+		Nz::SkinPositionNormal(skinningData, 0, vertexCount);
+		Benchmark::DoNotOptimize(outputVertices);
+	});
+
+	state.Measure("PositionNormalTangent4096", [&]()
+	{
+		Nz::SkinPositionNormalTangent(skinningData, 0, vertexCount);
+		Benchmark::DoNotOptimize(outputVertices);
+	});
+}
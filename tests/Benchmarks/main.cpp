@@ -0,0 +1,89 @@
+#include "Benchmark.hpp"
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/Core.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Usage: Benchmarks [--filter=<substring>] [--format=csv|json] [--min-time=<ms>] [--repetitions=<count>]
+// Results are written to the standard output, one benchmark per line (CSV) or as a single JSON array
+int main(int argc, char* argv[])
+{
+	const char* filter = "";
+	bool json = false;
+	double minTime = 20.0;
+	unsigned int repetitions = 5;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		if (std::strncmp(arg, "--filter=", 9) == 0)
+			filter = arg + 9;
+		else if (std::strcmp(arg, "--format=json") == 0)
+			json = true;
+		else if (std::strcmp(arg, "--format=csv") == 0)
+			json = false;
+		else if (std::strncmp(arg, "--min-time=", 11) == 0)
+			minTime = std::atof(arg + 11);
+		else if (std::strncmp(arg, "--repetitions=", 14) == 0)
+			repetitions = std::max(std::atoi(arg + 14), 1);
+		else
+		{
+			std::fprintf(stderr, "Unknown argument: %s\n", arg);
+			return EXIT_FAILURE;
+		}
+	}
+
+	// The standard output only receives the results, the log file still receives the messages once the modules are initialized
+	Nz::Log::Enable(false);
+
+	Nz::Initializer<Nz::Core, Nz::Utility> modules;
+	if (!modules)
+	{
+		std::fprintf(stderr, "Failed to initialize modules\n");
+		return EXIT_FAILURE;
+	}
+
+	Nz::Log::Enable(true);
+	Nz::Log::GetLogger()->EnableStdReplication(false);
+
+	if (json)
+		std::printf("[");
+	else
+		std::printf("name,iterations,ns_per_op,ops_per_s,bytes_per_s\n");
+
+	bool first = true;
+	for (const Benchmark::Entry& entry : Benchmark::GetEntries())
+	{
+		if (!std::strstr(entry.name, filter))
+			continue;
+
+		Benchmark::State state(entry.name, minTime * 1000000.0, repetitions);
+		entry.function(state);
+
+		for (const Benchmark::Result& result : state.GetResults())
+		{
+			double opsPerSecond = 1000000000.0 / result.nsPerOperation;
+			double bytesPerSecond = opsPerSecond * result.bytesPerOperation;
+
+			if (json)
+			{
+				std::printf("%s\n\t{\"name\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.3f, \"ops_per_s\": %.1f, \"bytes_per_s\": %.1f}", (first) ? "" : ",", result.name.c_str(), result.iterations, result.nsPerOperation, opsPerSecond, bytesPerSecond);
+				first = false;
+			}
+			else
+				std::printf("%s,%zu,%.3f,%.1f,%.1f\n", result.name.c_str(), result.iterations, result.nsPerOperation, opsPerSecond, bytesPerSecond);
+
+			std::fflush(stdout);
+		}
+	}
+
+	if (json)
+		std::printf("\n]\n");
+
+	Nz::Log::Enable(false);
+
+	return EXIT_SUCCESS;
+}
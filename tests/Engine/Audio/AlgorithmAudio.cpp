@@ -1,7 +1,33 @@
 #include <Nazara/Audio/Algorithm.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Math/Algorithm.hpp>
 #include <Catch/catch.hpp>
 
 #include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Runs a check with the best implementation, then without each SIMD instruction set
+	bool CheckEveryImplementation(const std::function<bool()>& check)
+	{
+		bool success = check();
+		for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+		{
+			Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+			success = check() && success;
+		}
+
+		for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+			Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+
+		return success;
+	}
+}
 
 TEST_CASE("MixToMono", "[AUDIO][ALGORITHM]")
 {
@@ -16,4 +42,153 @@ TEST_CASE("MixToMono", "[AUDIO][ALGORITHM]")
 		std::array<int, 2> theoric{ 2, 4 }; // It's the mean of the two channels
 		REQUIRE(output == theoric);
 	}
+
+	SECTION("Mix Int16 and float stereo frames like the generic version, in place")
+	{
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<int> distribution(std::numeric_limits<Nz::Int16>::min(), std::numeric_limits<Nz::Int16>::max());
+
+		// An odd number of frames leaves some of them to the generic code
+		const unsigned int frameCount = 67;
+		std::vector<Nz::Int16> samples(frameCount * 2);
+		for (Nz::Int16& sample : samples)
+			sample = static_cast<Nz::Int16>(distribution(generator));
+
+		std::vector<float> floatSamples(samples.size());
+		for (std::size_t i = 0; i < samples.size(); ++i)
+			floatSamples[i] = samples[i] / 1000.f;
+
+		std::vector<Nz::Int16> expected(frameCount);
+		Nz::MixToMono<Nz::Int16>(samples.data(), expected.data(), 2, frameCount);
+
+		std::vector<float> expectedFloat(frameCount);
+		Nz::MixToMono<float>(floatSamples.data(), expectedFloat.data(), 2, frameCount);
+
+		CHECK(CheckEveryImplementation([&]()
+		{
+			std::vector<Nz::Int16> mixed = samples;
+			Nz::MixToMono(mixed.data(), mixed.data(), 2, frameCount);
+
+			std::vector<float> mixedFloat = floatSamples;
+			Nz::MixToMono(mixedFloat.data(), mixedFloat.data(), 2, frameCount);
+
+			return std::equal(expected.begin(), expected.end(), mixed.begin()) && std::equal(expectedFloat.begin(), expectedFloat.end(), mixedFloat.begin());
+		}));
+	}
+}
+
+TEST_CASE("ConvertSamples", "[AUDIO][ALGORITHM]")
+{
+	SECTION("Int16 samples are kept when converted to float and back")
+	{
+		std::vector<Nz::Int16> samples;
+		for (int i = std::numeric_limits<Nz::Int16>::min(); i <= std::numeric_limits<Nz::Int16>::max(); ++i)
+			samples.push_back(static_cast<Nz::Int16>(i));
+
+		CHECK(CheckEveryImplementation([&]()
+		{
+			std::vector<float> floatSamples(samples.size());
+			Nz::ConvertSamples(samples.data(), floatSamples.data(), samples.size());
+
+			std::vector<Nz::Int16> converted(samples.size());
+			Nz::ConvertSamples(floatSamples.data(), converted.data(), floatSamples.size());
+
+			return floatSamples.front() == -1.f && floatSamples[32768] == 0.f && converted == samples;
+		}));
+	}
+
+	SECTION("Out of range float samples are saturated")
+	{
+		std::array<float, 3> samples{ -2.f, 1.f, 1000.f };
+
+		CHECK(CheckEveryImplementation([&]()
+		{
+			std::array<Nz::Int16, 3> converted;
+			Nz::ConvertSamples(samples.data(), converted.data(), samples.size());
+
+			return converted[0] == -32768 && converted[1] == 32767 && converted[2] == 32767;
+		}));
+	}
+}
+
+TEST_CASE("InterleaveStereo", "[AUDIO][ALGORITHM]")
+{
+	SECTION("Two channels are interleaved into frames")
+	{
+		const unsigned int frameCount = 37;
+
+		std::vector<Nz::Int16> left(frameCount);
+		std::vector<Nz::Int16> right(frameCount);
+		std::vector<float> leftFloat(frameCount);
+		std::vector<float> rightFloat(frameCount);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			left[i] = static_cast<Nz::Int16>(i);
+			right[i] = static_cast<Nz::Int16>(-static_cast<int>(i));
+			leftFloat[i] = left[i];
+			rightFloat[i] = right[i];
+		}
+
+		CHECK(CheckEveryImplementation([&]()
+		{
+			std::vector<Nz::Int16> output(frameCount * 2);
+			Nz::InterleaveStereo(left.data(), right.data(), output.data(), frameCount);
+
+			std::vector<float> outputFloat(frameCount * 2);
+			Nz::InterleaveStereo(leftFloat.data(), rightFloat.data(), outputFloat.data(), frameCount);
+
+			for (unsigned int i = 0; i < frameCount; ++i)
+			{
+				if (output[2*i] != left[i] || output[2*i + 1] != right[i] || outputFloat[2*i] != leftFloat[i] || outputFloat[2*i + 1] != rightFloat[i])
+					return false;
+			}
+
+			return true;
+		}));
+	}
+}
+
+TEST_CASE("Resample", "[AUDIO][ALGORITHM]")
+{
+	// Stereo sine waves, with a different frequency on each channel
+	auto GenerateSine = [](unsigned int frameCount, Nz::UInt32 sampleRate)
+	{
+		std::vector<Nz::Int16> samples(frameCount * 2);
+		for (unsigned int i = 0; i < frameCount; ++i)
+		{
+			samples[2*i] = static_cast<Nz::Int16>(16384.0 * std::sin(2.0 * M_PI * 440.0 * i / sampleRate));
+			samples[2*i + 1] = static_cast<Nz::Int16>(16384.0 * std::sin(2.0 * M_PI * 1000.0 * i / sampleRate));
+		}
+
+		return samples;
+	};
+
+	for (Nz::UInt32 outputRate : {48000U, 22050U})
+	{
+		SECTION("Resample a 44100 Hz sound at " + std::to_string(outputRate) + " Hz")
+		{
+			const unsigned int frameCount = 4410;
+			std::vector<Nz::Int16> input = GenerateSine(frameCount, 44100);
+
+			unsigned int outputFrameCount = Nz::GetResampledFrameCount(frameCount, 44100, outputRate);
+			REQUIRE(outputFrameCount == frameCount * outputRate / 44100);
+
+			std::vector<Nz::Int16> expected = GenerateSine(outputFrameCount, outputRate);
+
+			CHECK(CheckEveryImplementation([&]()
+			{
+				std::vector<Nz::Int16> output(outputFrameCount * 2);
+				Nz::Resample(input.data(), output.data(), 2, frameCount, 44100, outputRate);
+
+				// The edges of the sound are filtered against silence, only the middle matches the sine waves
+				for (unsigned int i = 32; i < outputFrameCount - 32; ++i)
+				{
+					if (std::abs(output[2*i] - expected[2*i]) > 16 || std::abs(output[2*i + 1] - expected[2*i + 1]) > 16)
+						return false;
+				}
+
+				return true;
+			}));
+		}
+	}
 }
@@ -17,5 +17,23 @@ SCENARIO("SoundBuffer", "[AUDIO][SOUNDBUFFER]")
 				REQUIRE(soundBuffer.GetDuration() >= 8000);
 			}
 		}
+
+		WHEN("We load our sound and keep it compressed")
+		{
+			Nz::SoundBufferParams params;
+			params.keepCompressed = true;
+
+			REQUIRE(soundBuffer.LoadFromFile("resources/Engine/Audio/Cat.flac", params));
+
+			THEN("Samples are not decoded until the sound is played")
+			{
+				CHECK(soundBuffer.IsCompressed());
+				CHECK(!soundBuffer.IsDecoded());
+				CHECK(soundBuffer.GetSamples() == nullptr);
+				CHECK(soundBuffer.GetMemoryUsage() < soundBuffer.GetSampleCount() * sizeof(Nz::Int16));
+				REQUIRE(soundBuffer.GetDuration() <= 8500);
+				REQUIRE(soundBuffer.GetDuration() >= 8000);
+			}
+		}
 	}
 }
@@ -3,7 +3,23 @@
 
 #include <Nazara/Core/ByteArray.hpp>
 
+#include <algorithm>
 #include <array>
+#include <vector>
+
+namespace
+{
+	Nz::String ComputeHash(Nz::HashType type, const Nz::UInt8* data, std::size_t size, std::size_t chunkSize)
+	{
+		std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(type);
+		hash->Begin();
+
+		for (std::size_t offset = 0; offset < size; offset += chunkSize)
+			hash->Append(&data[offset], std::min(chunkSize, size - offset));
+
+		return hash->End().ToHex();
+	}
+}
 
 SCENARIO("AbstractHash", "[CORE][ABSTRACTHASH]")
 {
@@ -24,4 +40,35 @@ SCENARIO("AbstractHash", "[CORE][ABSTRACTHASH]")
 			}
 		}
 	}
+
+	GIVEN("Known test vectors")
+	{
+		const char* abc = "abc";
+		const char* digits = "123456789";
+
+		const Nz::UInt8* abcData = reinterpret_cast<const Nz::UInt8*>(abc);
+		const Nz::UInt8* digitsData = reinterpret_cast<const Nz::UInt8*>(digits);
+
+		REQUIRE(ComputeHash(Nz::HashType_SHA1, abcData, 3, 3) == "a9993e364706816aba3e25717850c26c9cd0d89d");
+		REQUIRE(ComputeHash(Nz::HashType_SHA256, abcData, 3, 3) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+		REQUIRE(ComputeHash(Nz::HashType_CRC32, digitsData, 9, 9) == "cbf43926");
+		REQUIRE(ComputeHash(Nz::HashType_XXHash64, abcData, 0, 1) == "ef46db3751d8e999");
+		REQUIRE(ComputeHash(Nz::HashType_XXHash64, abcData, 3, 3) == "44bc2cf5ad770999");
+	}
+
+	GIVEN("A large input, hashed at once and in small chunks")
+	{
+		// Long enough to go through the hardware accelerated paths when they are available
+		std::vector<Nz::UInt8> data(1000);
+		for (std::size_t i = 0; i < data.size(); ++i)
+			data[i] = static_cast<Nz::UInt8>(i * 7 + 3);
+
+		for (std::size_t chunkSize : { std::size_t(1000), std::size_t(100), std::size_t(7) })
+		{
+			REQUIRE(ComputeHash(Nz::HashType_SHA1, data.data(), data.size(), chunkSize) == "4231a8a50a10fa9758db8ec71fdef855b751048a");
+			REQUIRE(ComputeHash(Nz::HashType_SHA256, data.data(), data.size(), chunkSize) == "1e9bc38cbf860b9ec31918b065f9b52476c549a782e0e7990bed8ce3868d2371");
+			REQUIRE(ComputeHash(Nz::HashType_CRC32, data.data(), data.size(), chunkSize) == "17bc2a46");
+			REQUIRE(ComputeHash(Nz::HashType_XXHash64, data.data(), data.size(), chunkSize) == "5f235fa033f1a3fb");
+		}
+	}
 }
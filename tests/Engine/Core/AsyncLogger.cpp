@@ -0,0 +1,106 @@
+#include <Nazara/Core/AsyncLogger.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+	class CountingLogger : public Nz::AbstractLogger
+	{
+		public:
+			CountingLogger(std::atomic_uint& writeCount, std::atomic_uint& errorCount, std::atomic_bool* blocked = nullptr) :
+			m_writeCount(writeCount),
+			m_errorCount(errorCount),
+			m_blocked(blocked)
+			{
+			}
+
+			void EnableStdReplication(bool /*enable*/) override
+			{
+			}
+
+			bool IsStdReplicationEnabled() override
+			{
+				return false;
+			}
+
+			void Write(const Nz::String& /*string*/) override
+			{
+				while (m_blocked && *m_blocked)
+					Nz::Thread::Sleep(1);
+
+				m_writeCount++;
+			}
+
+			void WriteError(Nz::ErrorType /*type*/, const Nz::String& /*error*/, unsigned int /*line*/, const char* /*file*/, const char* /*function*/) override
+			{
+				m_errorCount++;
+			}
+
+		private:
+			std::atomic_uint& m_writeCount;
+			std::atomic_uint& m_errorCount;
+			std::atomic_bool* m_blocked;
+	};
+}
+
+SCENARIO("AsyncLogger", "[CORE][ASYNCLOGGER]")
+{
+	std::atomic_uint writeCount(0);
+	std::atomic_uint errorCount(0);
+
+	GIVEN("An asynchronous logger which blocks on overflow")
+	{
+		Nz::AsyncLogger logger(new CountingLogger(writeCount, errorCount), Nz::LogOverflowPolicy_Block, 16);
+
+		WHEN("Several threads write more entries than their queue can hold")
+		{
+			std::vector<Nz::Thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&logger]()
+				{
+					for (unsigned int j = 0; j < 1000; ++j)
+						logger.Write("Entry");
+
+					logger.WriteError(Nz::ErrorType_Warning, "Warning", __LINE__, __FILE__, "Test");
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			logger.Flush();
+
+			THEN("Every entry is written")
+			{
+				CHECK(writeCount == 4000);
+				CHECK(errorCount == 4);
+				CHECK(logger.GetDroppedCount() == 0);
+			}
+		}
+	}
+
+	GIVEN("An asynchronous logger which drops on overflow")
+	{
+		std::atomic_bool blocked(true);
+		Nz::AsyncLogger logger(new CountingLogger(writeCount, errorCount, &blocked), Nz::LogOverflowPolicy_Drop, 16);
+
+		WHEN("We write more entries than the queue can hold while the wrapped logger is stuck")
+		{
+			for (unsigned int i = 0; i < 100; ++i)
+				logger.Write("Entry");
+
+			blocked = false;
+			logger.Flush();
+
+			THEN("Entries are dropped instead of blocking, and reported")
+			{
+				CHECK(logger.GetDroppedCount() > 0);
+				CHECK(writeCount + logger.GetDroppedCount() == 100);
+			}
+		}
+	}
+}
@@ -2,6 +2,7 @@
 #include <Catch/catch.hpp>
 
 #include <string>
+#include <vector>
 
 SCENARIO("Bitset", "[CORE][BITSET]")
 {
@@ -114,4 +115,91 @@ SCENARIO("Bitset", "[CORE][BITSET]")
 			}
 		}
 	}
+
+	GIVEN("Two bitsets combined in place")
+	{
+		Nz::Bitset<> first("01001");
+		Nz::Bitset<> second("10111");
+
+		WHEN("We use the compound operators")
+		{
+			Nz::Bitset<> andBitset(first);
+			andBitset &= second;
+
+			Nz::Bitset<> orBitset(first);
+			orBitset |= second;
+
+			Nz::Bitset<> xorBitset(first);
+			xorBitset ^= second;
+
+			THEN("They should give the same result as the binary operators")
+			{
+				REQUIRE(andBitset == Nz::Bitset<>("00001"));
+				REQUIRE(orBitset == Nz::Bitset<>("11111"));
+				REQUIRE(xorBitset == Nz::Bitset<>("11110"));
+			}
+		}
+	}
+
+	GIVEN("Three bitsets spanning multiple blocks")
+	{
+		Nz::Bitset<Nz::UInt8> a;
+		Nz::Bitset<Nz::UInt8> b;
+		Nz::Bitset<Nz::UInt8> c;
+
+		for (std::size_t i = 0; i < 100; i += 3)
+			a.UnboundedSet(i);
+
+		for (std::size_t i = 0; i < 70; i += 2)
+			b.UnboundedSet(i);
+
+		for (std::size_t i = 0; i < 40; i += 4)
+			c.UnboundedSet(i);
+
+		WHEN("We iterate over (a & b) & ~c")
+		{
+			std::vector<std::size_t> bits;
+			for (std::size_t bit : (Nz::MakeBitsetExpression(a) & b) & ~Nz::MakeBitsetExpression(c))
+				bits.push_back(bit);
+
+			THEN("We should get the bits set in a and b but not in c, even past the end of c")
+			{
+				std::vector<std::size_t> expected;
+				for (std::size_t i = 0; i < 100; ++i)
+				{
+					if (i % 3 == 0 && i % 2 == 0 && i < 70 && !(i % 4 == 0 && i < 40))
+						expected.push_back(i);
+				}
+
+				REQUIRE(bits == expected);
+			}
+		}
+
+		WHEN("We evaluate an expression into a bitset")
+		{
+			Nz::Bitset<Nz::UInt8> result(Nz::MakeBitsetExpression(a) | b);
+			Nz::Bitset<Nz::UInt8> xorResult;
+			xorResult = Nz::MakeBitsetExpression(a) ^ b;
+
+			THEN("It should match the regular operators")
+			{
+				REQUIRE(result == (a | b));
+				REQUIRE(result.GetSize() == 100);
+				REQUIRE(xorResult == (a ^ b));
+				REQUIRE((Nz::MakeBitsetExpression(a) & b).Count() == (a & b).Count());
+				REQUIRE((Nz::MakeBitsetExpression(c) & ~Nz::MakeBitsetExpression(a) & ~Nz::MakeBitsetExpression(b)).TestNone());
+			}
+		}
+
+		WHEN("We evaluate an expression referencing the target bitset")
+		{
+			Nz::Bitset<Nz::UInt8> expected = c & a;
+			c = Nz::MakeBitsetExpression(c) & a;
+
+			THEN("It should be computed in place")
+			{
+				REQUIRE(c == expected);
+			}
+		}
+	}
 }
@@ -28,3 +28,33 @@ SCENARIO("Clock", "[CORE][CLOCK]")
 		}
 	}
 }
+
+SCENARIO("Timestamp clock", "[CORE][CLOCK]")
+{
+	GIVEN("A clock reading the timestamp counter")
+	{
+		Nz::Clock clock(0, false, Nz::ClockMode_Timestamp);
+		CHECK(clock.GetMode() == Nz::ClockMode_Timestamp);
+
+		WHEN("We wait")
+		{
+			Nz::Thread::Sleep(20);
+
+			THEN("It measures about the same time as the system clock")
+			{
+				Nz::UInt64 elapsed = clock.GetMicroseconds();
+				CHECK(elapsed >= 15000);
+				CHECK(elapsed < 1000000);
+			}
+		}
+
+		WHEN("We convert a second worth of ticks")
+		{
+			THEN("We get a second")
+			{
+				CHECK(Nz::TimestampToMicroseconds(Nz::GetTimestampFrequency()) == 1000000);
+				CHECK(Nz::TimestampToMicroseconds(Nz::GetTimestampFrequency() * 3600) == 3600000000ULL);
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#include <Nazara/Core/ConcurrentMemoryPool.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <Nazara/Math/Vector2.hpp>
+#include <atomic>
+#include <set>
+#include <vector>
+
+SCENARIO("ConcurrentMemoryPool", "[CORE][CONCURRENTMEMORYPOOL]")
+{
+	GIVEN("A ConcurrentMemoryPool to contain Nz::Vector2<int>")
+	{
+		Nz::ConcurrentMemoryPool memoryPool(sizeof(Nz::Vector2<int>), 4, 2);
+
+		WHEN("We construct a Nz::Vector2<int>")
+		{
+			Nz::Vector2<int>* vector2 = memoryPool.New<Nz::Vector2<int>>(1, 2);
+
+			THEN("Memory is available")
+			{
+				vector2->x = 3;
+				REQUIRE(*vector2 == Nz::Vector2<int>(3, 2));
+				REQUIRE(memoryPool.GetCapacity() == 8);
+			}
+
+			memoryPool.Delete(vector2);
+		}
+
+		WHEN("We allocate more blocks than a chunk holds")
+		{
+			std::set<void*> blocks;
+			for (unsigned int i = 0; i < 100; ++i)
+				blocks.insert(memoryPool.Allocate());
+
+			THEN("Every block is different and the pool has grown")
+			{
+				CHECK(blocks.size() == 100);
+				REQUIRE(memoryPool.GetCapacity() >= 100);
+			}
+
+			for (void* block : blocks)
+				memoryPool.Free(block);
+		}
+
+		WHEN("Multiple threads allocate and free blocks from each other")
+		{
+			constexpr unsigned int threadCount = 4;
+			constexpr unsigned int allocationCount = 10000;
+
+			Nz::ConcurrentMemoryPool sharedPool(sizeof(Nz::Vector2<int>));
+
+			std::vector<std::vector<Nz::Vector2<int>*>> allocations(threadCount);
+			std::atomic_uint errorCount(0);
+
+			std::vector<Nz::Thread> threads;
+			for (unsigned int i = 0; i < threadCount; ++i)
+			{
+				threads.emplace_back([&, i]()
+				{
+					for (unsigned int j = 0; j < allocationCount; ++j)
+						allocations[i].push_back(sharedPool.New<Nz::Vector2<int>>(i, j));
+
+					for (unsigned int j = 0; j < allocationCount; ++j)
+					{
+						if (*allocations[i][j] != Nz::Vector2<int>(i, j))
+							errorCount++;
+					}
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			threads.clear();
+
+			// Every thread frees the blocks allocated by another one
+			for (unsigned int i = 0; i < threadCount; ++i)
+			{
+				threads.emplace_back([&, i]()
+				{
+					for (Nz::Vector2<int>* vector : allocations[(i + 1) % threadCount])
+						sharedPool.Delete(vector);
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			THEN("No block has been shared between two allocations")
+			{
+				REQUIRE(errorCount == 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,120 @@
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <Catch/catch.hpp>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	int AddGeneric(int a, int b)
+	{
+		return a + b;
+	}
+
+	int AddSSE2(int a, int b)
+	{
+		return a + b + 1000;
+	}
+
+	int AddImpossible(int a, int b)
+	{
+		return a + b + 2000;
+	}
+
+	Nz::String ComputeCRC32(const std::vector<Nz::UInt8>& data)
+	{
+		std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(Nz::HashType_CRC32);
+		hash->Begin();
+		hash->Append(data.data(), data.size());
+
+		return hash->End().ToHex();
+	}
+}
+
+SCENARIO("CpuDispatch", "[CORE][CPUDISPATCH]")
+{
+	GIVEN("A kernel with several implementations")
+	{
+		Nz::CpuKernel<int(int, int)> kernel("Add", &AddGeneric, {
+			{&AddImpossible, "Impossible", {Nz::ProcessorCap_SSE2, Nz::ProcessorCap_Max}},
+			{&AddSSE2, "SSE2", {Nz::ProcessorCap_SSE2}}
+		});
+
+		bool hasSSE2 = Nz::CpuDispatch::IsCapabilityEnabled(Nz::ProcessorCap_SSE2);
+
+		WHEN("We call it")
+		{
+			THEN("The best supported implementation is used")
+			{
+				CHECK(kernel(1, 2) == ((hasSSE2) ? 1003 : 3));
+				CHECK(std::strcmp(kernel.GetSelectedName(), (hasSSE2) ? "SSE2" : "Generic") == 0);
+			}
+		}
+
+		WHEN("We disable the capability it requires")
+		{
+			Nz::CpuDispatch::SetCapabilityEnabled(Nz::ProcessorCap_SSE2, false);
+
+			THEN("The fallback is used")
+			{
+				CHECK_FALSE(Nz::CpuDispatch::IsCapabilityEnabled(Nz::ProcessorCap_SSE2));
+				CHECK(kernel(1, 2) == 3);
+				CHECK(std::strcmp(kernel.GetSelectedName(), "Generic") == 0);
+			}
+
+			Nz::CpuDispatch::SetCapabilityEnabled(Nz::ProcessorCap_SSE2, true);
+			CHECK(kernel(1, 2) == ((hasSSE2) ? 1003 : 3));
+		}
+
+		WHEN("We enumerate registered kernels")
+		{
+			bool found = false;
+			Nz::CpuDispatch::ForEachKernel([&] (const Nz::Detail::CpuKernelBase& registeredKernel)
+			{
+				if (&registeredKernel == &kernel)
+					found = true;
+			});
+
+			THEN("It is part of them")
+			{
+				CHECK(found);
+			}
+		}
+	}
+
+	GIVEN("The hardware capabilities")
+	{
+		THEN("Dependent capabilities are consistent")
+		{
+			if (Nz::HardwareInfo::HasCapability(Nz::ProcessorCap_AVX2))
+				CHECK(Nz::HardwareInfo::HasCapability(Nz::ProcessorCap_AVX));
+
+			if (Nz::HardwareInfo::HasCapability(Nz::ProcessorCap_AVX512F))
+				CHECK(Nz::HardwareInfo::HasCapability(Nz::ProcessorCap_AVX2));
+		}
+	}
+
+	GIVEN("The CRC32 hash, which has an accelerated implementation")
+	{
+		std::vector<Nz::UInt8> data(1000);
+		for (std::size_t i = 0; i < data.size(); ++i)
+			data[i] = static_cast<Nz::UInt8>(i * 7 + 3);
+
+		Nz::String accelerated = ComputeCRC32(data);
+
+		WHEN("We disable carry-less multiplication")
+		{
+			Nz::CpuDispatch::SetCapabilityEnabled(Nz::ProcessorCap_PCLMULQDQ, false);
+			Nz::String generic = ComputeCRC32(data);
+			Nz::CpuDispatch::SetCapabilityEnabled(Nz::ProcessorCap_PCLMULQDQ, true);
+
+			THEN("The generic implementation gives the same result")
+			{
+				CHECK(generic == accelerated);
+			}
+		}
+	}
+}
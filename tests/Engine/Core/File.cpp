@@ -77,6 +77,27 @@ SCENARIO("File", "[CORE][FILE]")
 				REQUIRE(content == "Test");
 			}
 		}
+
+		WHEN("We map the file in memory")
+		{
+			REQUIRE(fileTest.IsOpen());
+			const char* data = static_cast<const char*>(fileTest.Map());
+
+			THEN("We can read its content without any copy")
+			{
+				REQUIRE(data);
+				REQUIRE(fileTest.IsMapped());
+				REQUIRE(fileTest.GetSize() == 5U);
+				REQUIRE(Nz::String(data, 4) == "Test");
+				REQUIRE(fileTest.Map() == data);
+			}
+
+			AND_THEN("We unmap it")
+			{
+				fileTest.Unmap();
+				CHECK(!fileTest.IsMapped());
+			}
+		}
 	}
 
 	GIVEN("Nothing")
@@ -0,0 +1,151 @@
+#include <Nazara/Core/FrameArena.hpp>
+#include <Nazara/Core/FrameArenaAllocator.hpp>
+#include <Catch/catch.hpp>
+
+#include <Nazara/Math/Vector2.hpp>
+#include <cstdint>
+
+SCENARIO("FrameArena", "[CORE][FRAMEARENA]")
+{
+	GIVEN("A FrameArena with small blocks")
+	{
+		Nz::FrameArena arena(256);
+
+		WHEN("We construct a Nz::Vector2<int>")
+		{
+			Nz::Vector2<int>* vector2 = arena.New<Nz::Vector2<int>>(1, 2);
+
+			THEN("Memory is available")
+			{
+				vector2->x = 3;
+				REQUIRE(*vector2 == Nz::Vector2<int>(3, 2));
+				REQUIRE(arena.GetAllocatedSize() == sizeof(Nz::Vector2<int>));
+			}
+		}
+
+		WHEN("We allocate with a specific alignment")
+		{
+			arena.Allocate(1);
+			void* ptr = arena.Allocate(16, 64);
+
+			THEN("The memory is aligned")
+			{
+				REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0);
+			}
+		}
+
+		WHEN("We allocate more than a block")
+		{
+			for (unsigned int i = 0; i < 10; ++i)
+				arena.Allocate(100);
+
+			void* big = arena.Allocate(1000);
+
+			THEN("The arena grows")
+			{
+				REQUIRE(big != nullptr);
+				REQUIRE(arena.GetCapacity() >= 1000 + 10 * 100);
+			}
+
+			AND_WHEN("We go through two frames with the same workload")
+			{
+				std::size_t capacity = arena.GetCapacity();
+
+				for (unsigned int frame = 0; frame < 2; ++frame)
+				{
+					arena.NextFrame();
+					for (unsigned int i = 0; i < 10; ++i)
+						arena.Allocate(100);
+
+					arena.Allocate(1000);
+				}
+
+				std::size_t steadyCapacity = arena.GetCapacity();
+
+				arena.NextFrame();
+				for (unsigned int i = 0; i < 10; ++i)
+					arena.Allocate(100);
+
+				arena.Allocate(1000);
+
+				THEN("Blocks are reused instead of reallocated")
+				{
+					REQUIRE(capacity * 2 >= steadyCapacity);
+					REQUIRE(arena.GetCapacity() == steadyCapacity);
+				}
+			}
+		}
+
+		WHEN("We switch to the next frame")
+		{
+			int* previous = arena.New<int>(42);
+			arena.NextFrame();
+
+			int* current = arena.New<int>(7);
+
+			THEN("Memory from the previous frame is still valid")
+			{
+				REQUIRE(arena.GetAllocatedSize() == sizeof(int));
+				REQUIRE(*previous == 42);
+				REQUIRE(*current == 7);
+			}
+
+			AND_THEN("The first frame gets reused on the following switch")
+			{
+				arena.NextFrame();
+				int* reused = arena.New<int>(13);
+
+				REQUIRE(reused == previous);
+			}
+		}
+	}
+
+	GIVEN("A vector using a FrameArenaAllocator")
+	{
+		Nz::FrameArena arena;
+		Nz::FrameVector<int> vector{Nz::FrameArenaAllocator<int>(arena)};
+
+		WHEN("We fill it")
+		{
+			for (int i = 0; i < 1000; ++i)
+				vector.push_back(i);
+
+			THEN("Its memory comes from the arena")
+			{
+				REQUIRE(vector.get_allocator().GetArena() == &arena);
+				REQUIRE(arena.GetAllocatedSize() >= 1000 * sizeof(int));
+
+				bool ordered = true;
+				for (int i = 0; i < 1000; ++i)
+					ordered = ordered && vector[i] == i;
+
+				REQUIRE(ordered);
+			}
+
+			AND_WHEN("We reassign it after resetting the frame")
+			{
+				arena.Reset();
+				vector = Nz::FrameVector<int>(arena);
+
+				THEN("It is empty and keeps using the arena")
+				{
+					REQUIRE(vector.empty());
+					REQUIRE(vector.get_allocator().GetArena() == &arena);
+					REQUIRE(arena.GetAllocatedSize() == 0);
+				}
+			}
+		}
+	}
+
+	GIVEN("A vector using a default FrameArenaAllocator")
+	{
+		Nz::FrameVector<int> vector;
+		vector.assign(100, 5);
+
+		THEN("It uses the global allocator")
+		{
+			REQUIRE(vector.get_allocator().GetArena() == nullptr);
+			REQUIRE(vector.size() == 100);
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#include <Nazara/Core/GuillotineBinPack.hpp>
+#include <Catch/catch.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	bool CheckPacking(const std::vector<Nz::Rectui>& rects, const std::vector<bool>& inserted, unsigned int width, unsigned int height)
+	{
+		for (std::size_t i = 0; i < rects.size(); ++i)
+		{
+			if (!inserted[i])
+				continue;
+
+			const Nz::Rectui& rect = rects[i];
+			if (rect.x + rect.width > width || rect.y + rect.height > height)
+				return false;
+
+			for (std::size_t j = i + 1; j < rects.size(); ++j)
+			{
+				if (inserted[j] && rect.Intersect(rects[j]))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::vector<Nz::Rectui> MakeGlyphs(unsigned int count)
+	{
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<unsigned int> distribution(4, 24);
+
+		std::vector<Nz::Rectui> rects(count);
+		for (Nz::Rectui& rect : rects)
+			rect = Nz::Rectui(0, 0, distribution(generator), distribution(generator));
+
+		return rects;
+	}
+}
+
+SCENARIO("GuillotineBinPack", "[CORE][GUILLOTINEBINPACK]")
+{
+	GIVEN("A 512x512 bin")
+	{
+		Nz::GuillotineBinPack binPack(512, 512);
+
+		WHEN("We insert glyph-sized rectangles one at a time")
+		{
+			std::vector<Nz::Rectui> rects = MakeGlyphs(300);
+			std::vector<bool> inserted(rects.size());
+
+			for (std::size_t i = 0; i < rects.size(); ++i)
+			{
+				bool flipped;
+				bool wasInserted;
+				binPack.Insert(&rects[i], &flipped, &wasInserted, 1, true, Nz::GuillotineBinPack::RectBestAreaFit, Nz::GuillotineBinPack::SplitMinimizeArea);
+				inserted[i] = wasInserted;
+			}
+
+			THEN("Every rectangle fits, without overlap")
+			{
+				for (bool wasInserted : inserted)
+					CHECK(wasInserted);
+
+				CHECK(CheckPacking(rects, inserted, 512, 512));
+			}
+		}
+
+		WHEN("We insert a batch of rectangles")
+		{
+			std::vector<Nz::Rectui> rects = MakeGlyphs(200);
+			bool flipped[200];
+			bool inserted[200];
+
+			THEN("Insert places them without overlap")
+			{
+				CHECK(binPack.Insert(rects.data(), flipped, inserted, 200, true, Nz::GuillotineBinPack::RectBestShortSideFit, Nz::GuillotineBinPack::SplitShorterLeftoverAxis));
+				CHECK(CheckPacking(rects, std::vector<bool>(inserted, inserted + 200), 512, 512));
+			}
+
+			THEN("InsertSorted places them without overlap")
+			{
+				CHECK(binPack.InsertSorted(rects.data(), flipped, inserted, 200, true, Nz::GuillotineBinPack::RectBestShortSideFit, Nz::GuillotineBinPack::SplitShorterLeftoverAxis));
+				CHECK(CheckPacking(rects, std::vector<bool>(inserted, inserted + 200), 512, 512));
+			}
+		}
+
+		WHEN("We insert a rectangle too large for the bin")
+		{
+			Nz::Rectui rects[2] = {Nz::Rectui(0, 0, 600, 10), Nz::Rectui(0, 0, 10, 10)};
+			bool inserted[2];
+
+			THEN("InsertSorted still places the other ones")
+			{
+				CHECK_FALSE(binPack.InsertSorted(rects, nullptr, inserted, 2, true, Nz::GuillotineBinPack::RectBestAreaFit, Nz::GuillotineBinPack::SplitMinimizeArea));
+				CHECK_FALSE(inserted[0]);
+				CHECK(inserted[1]);
+			}
+		}
+
+		WHEN("We free every inserted rectangle")
+		{
+			Nz::Rectui rects[4] = {Nz::Rectui(0, 0, 256, 256), Nz::Rectui(0, 0, 256, 256), Nz::Rectui(0, 0, 256, 256), Nz::Rectui(0, 0, 256, 256)};
+			REQUIRE(binPack.Insert(rects, 4, false, Nz::GuillotineBinPack::RectBestAreaFit, Nz::GuillotineBinPack::SplitMinimizeArea));
+			CHECK(binPack.GetOccupancy() == Approx(1.f));
+
+			for (const Nz::Rectui& rect : rects)
+				binPack.FreeRectangle(rect);
+
+			binPack.MergeFreeRectangles();
+
+			THEN("The whole bin is free again")
+			{
+				CHECK(binPack.GetOccupancy() == Approx(0.f));
+
+				Nz::Rectui full(0, 0, 512, 512);
+				CHECK(binPack.Insert(&full, 1, false, Nz::GuillotineBinPack::RectBestAreaFit, Nz::GuillotineBinPack::SplitMinimizeArea));
+			}
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#include <Nazara/Core/Initializer.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	std::mutex s_eventMutex;
+	std::vector<int> s_events; // Positive for an initialization, negative for an uninitialization
+	bool s_failSecond = false;
+
+	void PushEvent(int event)
+	{
+		std::lock_guard<std::mutex> lock(s_eventMutex);
+		s_events.push_back(event);
+	}
+
+	struct FirstModule
+	{
+		static bool Initialize() { PushEvent(1); return true; }
+		static void Uninitialize() { PushEvent(-1); }
+
+		static constexpr bool ParallelInitialization = true;
+	};
+
+	struct SecondModule
+	{
+		static bool Initialize() { PushEvent(2); return !s_failSecond; }
+		static void Uninitialize() { PushEvent(-2); }
+	};
+
+	struct ThirdModule
+	{
+		static bool Initialize() { PushEvent(3); return true; }
+		static void Uninitialize() { PushEvent(-3); }
+
+		static constexpr bool ParallelInitialization = true;
+	};
+}
+
+SCENARIO("Initializer", "[CORE][INITIALIZER]")
+{
+	GIVEN("Three modules, the first and last one allowing a parallel initialization")
+	{
+		s_events.clear();
+		s_failSecond = false;
+
+		WHEN("We initialize them sequentially")
+		{
+			{
+				Nz::Initializer<FirstModule, SecondModule, ThirdModule> modules;
+				CHECK(modules.IsInitialized());
+			}
+
+			THEN("They are initialized in order and uninitialized in reverse order")
+			{
+				CHECK(s_events == std::vector<int>({1, 2, 3, -3, -2, -1}));
+			}
+		}
+
+		WHEN("We initialize them in parallel")
+		{
+			Nz::Initializer<FirstModule, SecondModule, ThirdModule> modules(true, true);
+			REQUIRE(modules.IsInitialized());
+
+			THEN("The parallel modules are initialized before the other ones")
+			{
+				REQUIRE(s_events.size() == 3);
+				CHECK(s_events[2] == 2);
+				CHECK(s_events[0] + s_events[1] == 4);
+			}
+
+			AND_THEN("The timings are reported")
+			{
+				CHECK(modules.GetModuleInitializationTime(0) <= modules.GetInitializationTime());
+				CHECK(modules.GetModuleInitializationTime(2) <= modules.GetInitializationTime());
+			}
+		}
+
+		WHEN("A module fails to initialize")
+		{
+			s_failSecond = true;
+
+			Nz::Initializer<FirstModule, SecondModule, ThirdModule> modules;
+
+			THEN("The previous modules are uninitialized")
+			{
+				CHECK_FALSE(modules.IsInitialized());
+				CHECK(s_events == std::vector<int>({1, 2, -1}));
+			}
+		}
+
+		WHEN("We uninitialize them explicitly")
+		{
+			{
+				Nz::Initializer<FirstModule, SecondModule, ThirdModule> modules;
+				modules.Uninitialize();
+				CHECK_FALSE(modules.IsInitialized());
+			}
+
+			THEN("They are only uninitialized once")
+			{
+				CHECK(s_events.size() == 6);
+			}
+		}
+	}
+}
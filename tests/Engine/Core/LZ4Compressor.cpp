@@ -0,0 +1,111 @@
+#include <Nazara/Core/LZ4Compressor.hpp>
+#include <Catch/catch.hpp>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+SCENARIO("LZ4Compressor", "[CORE][LZ4COMPRESSOR]")
+{
+	GIVEN("A compressor without dictionary")
+	{
+		Nz::LZ4Compressor compressor;
+
+		WHEN("We compress redundant data")
+		{
+			std::string data;
+			for (unsigned int i = 0; i < 100; ++i)
+				data += "position: " + std::to_string(i % 7) + ", health: 100;";
+
+			std::vector<Nz::UInt8> compressed(Nz::LZ4Compressor::ComputeMaxCompressedSize(data.size()));
+			std::size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data(), compressed.size());
+
+			THEN("It should be much smaller, and decompress to the same data")
+			{
+				REQUIRE(compressedSize > 0);
+				CHECK(compressedSize * 4 < data.size());
+
+				std::string decompressed(data.size(), '\0');
+				REQUIRE(compressor.Decompress(compressed.data(), compressedSize, &decompressed[0], decompressed.size()));
+				CHECK(decompressed == data);
+			}
+
+			THEN("Corrupted or truncated blocks should be rejected")
+			{
+				std::string decompressed(data.size(), '\0');
+				CHECK_FALSE(compressor.Decompress(compressed.data(), compressedSize - 1, &decompressed[0], decompressed.size()));
+				CHECK_FALSE(compressor.Decompress(compressed.data(), compressedSize, &decompressed[0], decompressed.size() - 1));
+
+				compressed[compressedSize - 8] ^= 0xFF;
+				compressor.Decompress(compressed.data(), compressedSize, &decompressed[0], decompressed.size()); //< Must not overflow
+			}
+
+			THEN("A too small output should make the compression fail")
+			{
+				CHECK(compressor.Compress(data.data(), data.size(), compressed.data(), compressedSize - 1) == 0);
+			}
+		}
+
+		WHEN("We compress random data")
+		{
+			std::mt19937 randomEngine(42);
+			std::vector<Nz::UInt8> data(1000);
+			for (Nz::UInt8& byte : data)
+				byte = static_cast<Nz::UInt8>(randomEngine());
+
+			std::vector<Nz::UInt8> compressed(Nz::LZ4Compressor::ComputeMaxCompressedSize(data.size()));
+			std::size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data(), compressed.size());
+
+			THEN("It should still fit in the maximum size and decompress")
+			{
+				REQUIRE(compressedSize > 0);
+
+				std::vector<Nz::UInt8> decompressed(data.size());
+				REQUIRE(compressor.Decompress(compressed.data(), compressedSize, decompressed.data(), decompressed.size()));
+				CHECK(decompressed == data);
+			}
+		}
+
+		WHEN("We decompress a block made by hand")
+		{
+			// Four literals, a match of eight bytes four bytes back, then five last literals
+			const Nz::UInt8 block[] = { 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x50, 'x', 'y', 'z', 'w', 'v' };
+
+			THEN("It should follow the LZ4 block format")
+			{
+				char decompressed[17];
+				REQUIRE(compressor.Decompress(block, sizeof(block), decompressed, sizeof(decompressed)));
+				CHECK(std::string(decompressed, sizeof(decompressed)) == "abcdabcdabcdxyzwv");
+			}
+		}
+	}
+
+	GIVEN("Two compressors sharing a dictionary")
+	{
+		std::string dictionary = "{\"name\": \"player\", \"team\": \"blue\", \"weapon\": \"railgun\", \"ammo\": 25}";
+		Nz::LZ4Compressor compressor(dictionary.data(), dictionary.size());
+		Nz::LZ4Compressor decompressor(dictionary.data(), dictionary.size());
+
+		WHEN("We compress a small packet looking like the dictionary")
+		{
+			std::string data = "{\"name\": \"player\", \"team\": \"red\", \"weapon\": \"railgun\", \"ammo\": 12}";
+
+			std::vector<Nz::UInt8> compressed(Nz::LZ4Compressor::ComputeMaxCompressedSize(data.size()));
+			std::size_t compressedSize = compressor.Compress(data.data(), data.size(), compressed.data(), compressed.size());
+
+			THEN("Matches should refer to the dictionary")
+			{
+				REQUIRE(compressedSize > 0);
+				CHECK(compressedSize * 2 < data.size());
+
+				std::string decompressed(data.size(), '\0');
+				REQUIRE(decompressor.Decompress(compressed.data(), compressedSize, &decompressed[0], decompressed.size()));
+				CHECK(decompressed == data);
+
+				Nz::LZ4Compressor withoutDictionary;
+				CHECK_FALSE(withoutDictionary.Decompress(compressed.data(), compressedSize, &decompressed[0], decompressed.size()));
+			}
+		}
+	}
+}
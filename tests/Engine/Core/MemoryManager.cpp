@@ -0,0 +1,233 @@
+#include <Nazara/Core/MemoryManager.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	const Nz::MemoryManager::AllocationSite* FindSite(const std::vector<Nz::MemoryManager::AllocationSite>& sites, const char* file, unsigned int line)
+	{
+		auto it = std::find_if(sites.begin(), sites.end(), [file, line] (const Nz::MemoryManager::AllocationSite& site)
+		{
+			return site.file && std::strcmp(site.file, file) == 0 && site.line == line;
+		});
+
+		return (it != sites.end()) ? &*it : nullptr;
+	}
+
+	Nz::MemoryManager::ModuleUsage GetModuleUsage(const char* name)
+	{
+		std::vector<Nz::MemoryManager::ModuleUsage> usages = Nz::MemoryManager::GetModuleUsages();
+		auto it = std::find_if(usages.begin(), usages.end(), [name] (const Nz::MemoryManager::ModuleUsage& usage)
+		{
+			return std::strcmp(usage.name, name) == 0;
+		});
+
+		if (it != usages.end())
+			return *it;
+
+		Nz::MemoryManager::ModuleUsage usage;
+		usage.name = name;
+		usage.allocatedSize = 0;
+		usage.allocationCount = 0;
+		usage.liveAllocationCount = 0;
+		usage.liveSize = 0;
+
+		return usage;
+	}
+}
+
+SCENARIO("MemoryManager", "[CORE][MEMORYMANAGER]")
+{
+	GIVEN("The memory manager sampling every allocation")
+	{
+		Nz::MemoryManager::SetAllocationSamplingRate(1);
+		Nz::MemoryManager::EnableAllocationSampling(true);
+		Nz::MemoryManager::ResetAllocationSites();
+
+		REQUIRE(Nz::MemoryManager::IsAllocationSamplingEnabled());
+		REQUIRE(Nz::MemoryManager::GetAllocationSamplingRate() == 1);
+
+		WHEN("We allocate blocks from a call site")
+		{
+			bool freed = false;
+			void* blocks[10];
+			for (void*& block : blocks)
+				block = Nz::MemoryManager::Allocate(128, false, "MemoryManagerTest.cpp", 42);
+
+			THEN("The site is recorded with its live memory")
+			{
+				std::vector<Nz::MemoryManager::AllocationSite> sites = Nz::MemoryManager::GetAllocationSites();
+				const Nz::MemoryManager::AllocationSite* site = FindSite(sites, "MemoryManagerTest.cpp", 42);
+
+				REQUIRE(site);
+				CHECK(site->sampleCount == 10);
+				CHECK(site->allocationCount == 10);
+				CHECK(site->allocatedSize == 10 * 128);
+				CHECK(site->liveAllocationCount == 10);
+				CHECK(site->liveSize == 10 * 128);
+			}
+
+			AND_WHEN("We free them")
+			{
+				for (void* block : blocks)
+					Nz::MemoryManager::Free(block, false);
+
+				freed = true;
+
+				THEN("Live counters go back to zero while totals are kept")
+				{
+					std::vector<Nz::MemoryManager::AllocationSite> sites = Nz::MemoryManager::GetAllocationSites();
+					const Nz::MemoryManager::AllocationSite* site = FindSite(sites, "MemoryManagerTest.cpp", 42);
+
+					REQUIRE(site);
+					CHECK(site->liveAllocationCount == 0);
+					CHECK(site->liveSize == 0);
+					CHECK(site->allocatedSize == 10 * 128);
+				}
+			}
+
+			if (!freed)
+			{
+				for (void* block : blocks)
+					Nz::MemoryManager::Free(block, false);
+			}
+		}
+
+		Nz::MemoryManager::EnableAllocationSampling(false);
+		Nz::MemoryManager::SetAllocationSamplingRate(1024);
+	}
+
+	GIVEN("The memory manager sampling one allocation in 16")
+	{
+		Nz::MemoryManager::SetAllocationSamplingRate(16);
+		Nz::MemoryManager::EnableAllocationSampling(true);
+		Nz::MemoryManager::ResetAllocationSites();
+
+		WHEN("We make a lot of allocations")
+		{
+			for (unsigned int i = 0; i < 16 * 1000; ++i)
+				Nz::MemoryManager::Free(Nz::MemoryManager::Allocate(64, false, "MemoryManagerTest.cpp", 100), false);
+
+			THEN("Only a fraction of them is sampled and the estimation is close")
+			{
+				std::vector<Nz::MemoryManager::AllocationSite> sites = Nz::MemoryManager::GetAllocationSites();
+				const Nz::MemoryManager::AllocationSite* site = FindSite(sites, "MemoryManagerTest.cpp", 100);
+
+				REQUIRE(site);
+				CHECK(site->sampleCount < 2000);
+				CHECK(site->allocationCount > 16 * 800);
+				CHECK(site->allocationCount < 16 * 1200);
+				CHECK(site->liveSize == 0);
+			}
+		}
+
+		Nz::MemoryManager::EnableAllocationSampling(false);
+		Nz::MemoryManager::SetAllocationSamplingRate(1024);
+	}
+
+	GIVEN("Allocations made from the files of a module")
+	{
+		Nz::MemoryManager::ModuleUsage before = GetModuleUsage("TestModule");
+
+		WHEN("We allocate blocks of various sizes")
+		{
+			const std::size_t sizes[] = {1, 24, 300, 5000, 100000};
+
+			std::vector<void*> blocks;
+			for (std::size_t size : sizes)
+			{
+				void* block = Nz::MemoryManager::Allocate(size, false, "src/Nazara/TestModule/File.cpp", 10);
+				std::memset(block, 0x42, size);
+
+				blocks.push_back(block);
+			}
+
+			THEN("They are counted for the module")
+			{
+				Nz::MemoryManager::ModuleUsage usage = GetModuleUsage("TestModule");
+				CHECK(usage.allocationCount - before.allocationCount == 5);
+				CHECK(usage.allocatedSize - before.allocatedSize == 1 + 24 + 300 + 5000 + 100000);
+				CHECK(usage.liveAllocationCount - before.liveAllocationCount == 5);
+				CHECK(usage.liveSize - before.liveSize == 1 + 24 + 300 + 5000 + 100000);
+			}
+
+			for (void* block : blocks)
+				Nz::MemoryManager::Free(block, false);
+
+			THEN("Freeing them only changes the live counters")
+			{
+				Nz::MemoryManager::ModuleUsage usage = GetModuleUsage("TestModule");
+				CHECK(usage.allocationCount - before.allocationCount == 5);
+				CHECK(usage.liveAllocationCount == before.liveAllocationCount);
+				CHECK(usage.liveSize == before.liveSize);
+			}
+		}
+	}
+
+	GIVEN("Multiple threads allocating blocks freed by each other")
+	{
+		constexpr unsigned int threadCount = 4;
+		constexpr unsigned int allocationCount = 10000;
+
+		Nz::MemoryManager::ModuleUsage before = GetModuleUsage("TestModule");
+
+		std::vector<std::vector<Nz::UInt32*>> allocations(threadCount);
+		std::atomic_uint errorCount(0);
+
+		std::vector<Nz::Thread> threads;
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([&, i]()
+			{
+				allocations[i].reserve(allocationCount);
+				for (unsigned int j = 0; j < allocationCount; ++j)
+				{
+					std::size_t size = sizeof(Nz::UInt32) * (1 + j % 64);
+					Nz::UInt32* block = static_cast<Nz::UInt32*>(Nz::MemoryManager::Allocate(size, false, "src/Nazara/TestModule/Thread.cpp", 20));
+					block[0] = i * allocationCount + j;
+
+					allocations[i].push_back(block);
+				}
+
+				for (unsigned int j = 0; j < allocationCount; ++j)
+				{
+					if (allocations[i][j][0] != i * allocationCount + j)
+						errorCount++;
+				}
+			});
+		}
+
+		for (Nz::Thread& thread : threads)
+			thread.Join();
+
+		threads.clear();
+
+		// Every thread frees the blocks allocated by another one
+		for (unsigned int i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back([&, i]()
+			{
+				for (Nz::UInt32* block : allocations[(i + 1) % threadCount])
+					Nz::MemoryManager::Free(block, false);
+			});
+		}
+
+		for (Nz::Thread& thread : threads)
+			thread.Join();
+
+		THEN("No block has been shared and every block has been accounted for")
+		{
+			CHECK(errorCount == 0);
+
+			Nz::MemoryManager::ModuleUsage usage = GetModuleUsage("TestModule");
+			CHECK(usage.allocationCount - before.allocationCount == threadCount * allocationCount);
+			CHECK(usage.liveAllocationCount == before.liveAllocationCount);
+			CHECK(usage.liveSize == before.liveSize);
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#include <Nazara/Core/PackArchive.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/VirtualFileSystem.hpp>
+#include <Catch/catch.hpp>
+#include <cstring>
+
+SCENARIO("PackArchive", "[CORE][PACKARCHIVE]")
+{
+	GIVEN("A pack built from two entries")
+	{
+		Nz::ByteArray compressible(4096, 'N');
+		Nz::ByteArray incompressible;
+		for (unsigned int i = 0; i < 61; ++i)
+			incompressible.PushBack(static_cast<Nz::UInt8>(i * 7919 + 13));
+
+		std::vector<Nz::PackArchive::SourceEntry> sources(2);
+		sources[0].path = "textures/wall.dat";
+		sources[0].data = compressible;
+		sources[1].path = "./sounds\\step.dat";
+		sources[1].data = incompressible;
+		sources[1].compress = false;
+
+		REQUIRE(Nz::PackArchive::Build("TestPack.pak", sources));
+
+		WHEN("We open it")
+		{
+			Nz::PackArchive archive;
+			REQUIRE(archive.Open("TestPack.pak"));
+			CHECK(archive.GetEntryCount() == 2);
+
+			THEN("Entries are found by their normalized path")
+			{
+				const Nz::PackArchive::Entry* wall = archive.FindEntry("textures/wall.dat");
+				REQUIRE(wall);
+				CHECK(wall->IsCompressed());
+				CHECK(wall->size == compressible.GetSize());
+				CHECK(archive.GetEntryPath(*wall) == "textures/wall.dat");
+
+				Nz::ByteArray extracted(static_cast<std::size_t>(wall->size), 0);
+				REQUIRE(archive.Extract(*wall, extracted.GetBuffer()));
+				CHECK(extracted == compressible);
+
+				const Nz::PackArchive::Entry* step = archive.FindEntry("sounds/step.dat");
+				REQUIRE(step);
+				CHECK_FALSE(step->IsCompressed());
+				CHECK(step->offset % Nz::PackArchive::DefaultAlignment == 0);
+				CHECK(std::memcmp(archive.GetEntryData(*step), incompressible.GetConstBuffer(), incompressible.GetSize()) == 0);
+
+				CHECK(archive.FindEntry("sounds/missing.dat") == nullptr);
+			}
+		}
+
+		WHEN("We mount it in the virtual file system")
+		{
+			REQUIRE(Nz::VirtualFileSystem::MountPack("TestPack.pak", "data"));
+
+			THEN("Its entries can be read under the mount point")
+			{
+				CHECK(Nz::VirtualFileSystem::Exists("data/sounds/step.dat"));
+				CHECK_FALSE(Nz::VirtualFileSystem::Exists("sounds/step.dat"));
+
+				Nz::ByteArray data;
+				REQUIRE(Nz::VirtualFileSystem::ReadFile("data/textures/wall.dat", &data));
+				CHECK(data == compressible);
+			}
+
+			Nz::VirtualFileSystem::UnmountAll();
+			CHECK_FALSE(Nz::VirtualFileSystem::HasMounts());
+		}
+
+		Nz::File::Delete("TestPack.pak");
+	}
+}
@@ -2,6 +2,8 @@
 #include <Catch/catch.hpp>
 
 #include <Nazara/Core/String.hpp>
+#include <algorithm>
+#include <vector>
 
 SCENARIO("ParameterList", "[CORE][PARAMETERLIST]")
 {
@@ -49,4 +51,83 @@ SCENARIO("ParameterList", "[CORE][PARAMETERLIST]")
 			}
 		}
 	}
+
+	GIVEN("A ParameterList with many parameters")
+	{
+		Nz::ParameterList parameterList;
+		for (int i = 0; i < 1000; ++i)
+			parameterList.SetParameter("param" + Nz::String::Number(i), i);
+
+		WHEN("We remove half of them and overwrite others")
+		{
+			for (int i = 0; i < 1000; i += 2)
+				parameterList.RemoveParameter("param" + Nz::String::Number(i));
+
+			for (int i = 1; i < 1000; i += 4)
+				parameterList.SetParameter("param" + Nz::String::Number(i), Nz::String("overwritten"));
+
+			THEN("Only the remaining parameters can be retrieved, with their last value")
+			{
+				REQUIRE(parameterList.GetParameterCount() == 500);
+
+				bool allFound = true;
+				for (int i = 0; i < 1000; ++i)
+				{
+					Nz::String name = "param" + Nz::String::Number(i);
+					if (i % 2 == 0)
+						allFound &= !parameterList.HasParameter(name);
+					else if (i % 4 == 1)
+					{
+						Nz::String value;
+						allFound &= parameterList.GetStringParameter(name, &value) && value == "overwritten";
+					}
+					else
+					{
+						int value;
+						allFound &= parameterList.GetIntegerParameter(name, &value) && value == i;
+					}
+				}
+
+				REQUIRE(allFound);
+			}
+		}
+
+		WHEN("We enumerate it")
+		{
+			parameterList.SetParameter("string", "value");
+
+			std::vector<Nz::String> names;
+			parameterList.ForEach([&](const Nz::ParameterList& list, const Nz::String& name)
+			{
+				REQUIRE(&list == &parameterList);
+				names.push_back(name);
+			});
+
+			THEN("Every parameter is visited once")
+			{
+				REQUIRE(names.size() == parameterList.GetParameterCount());
+				REQUIRE(std::count(names.begin(), names.end(), "param42") == 1);
+				REQUIRE(std::count(names.begin(), names.end(), "string") == 1);
+			}
+		}
+
+		WHEN("We freeze it")
+		{
+			Nz::FrozenParameterList frozen(parameterList);
+			Nz::FrozenParameterList copy = frozen;
+
+			parameterList.Clear();
+
+			THEN("The copies share the same immutable content")
+			{
+				REQUIRE(&copy.GetList() == &frozen.GetList());
+
+				int value;
+				REQUIRE(copy.GetIntegerParameter("param42", &value));
+				REQUIRE(value == 42);
+				REQUIRE(!parameterList.HasParameter("param42"));
+				REQUIRE(!Nz::FrozenParameterList().HasParameter("param42"));
+			}
+		}
+	}
 }
@@ -0,0 +1,105 @@
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+	const char* s_innerZone = "Profiler test inner";
+	const char* s_outerZone = "Profiler test outer";
+
+	const Nz::Profiler::ZoneStats* FindStats(const std::vector<Nz::Profiler::ZoneStats>& stats, const char* name)
+	{
+		auto it = std::find_if(stats.begin(), stats.end(), [name] (const Nz::Profiler::ZoneStats& zoneStats) { return std::strcmp(zoneStats.name, name) == 0; });
+		return (it != stats.end()) ? &*it : nullptr;
+	}
+
+	void RunZones(unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			Nz::Profiler::Zone outer(s_outerZone);
+			{
+				Nz::Profiler::Zone inner(s_innerZone);
+
+				// Busy wait, for the zone to last at least a millisecond (measured like the profiler does)
+				Nz::Clock clock(0, false, Nz::ClockMode_Timestamp);
+				while (clock.GetMicroseconds() < 1000);
+			}
+		}
+	}
+}
+
+SCENARIO("Profiler", "[CORE][PROFILER]")
+{
+	GIVEN("An enabled profiler")
+	{
+		Nz::Profiler::Clear();
+		Nz::Profiler::Enable();
+
+		WHEN("We run nested zones")
+		{
+			RunZones(3);
+
+			THEN("Their stats are recorded")
+			{
+				std::vector<Nz::Profiler::ZoneStats> stats = Nz::Profiler::GetStats();
+
+				const Nz::Profiler::ZoneStats* outer = FindStats(stats, s_outerZone);
+				const Nz::Profiler::ZoneStats* inner = FindStats(stats, s_innerZone);
+				REQUIRE(outer);
+				REQUIRE(inner);
+
+				CHECK(outer->callCount == 3);
+				CHECK(inner->callCount == 3);
+				CHECK(inner->totalTime >= 3000);
+				CHECK(outer->totalTime >= inner->totalTime);
+				CHECK(outer->selfTime <= outer->totalTime - inner->totalTime);
+				CHECK(outer->maxTime <= outer->totalTime);
+			}
+
+			THEN("They can be exported as a Chrome trace")
+			{
+				Nz::ByteArray buffer;
+				Nz::MemoryStream stream(&buffer, Nz::OpenMode_WriteOnly);
+				REQUIRE(Nz::Profiler::ExportChromeTrace(stream));
+
+				std::string trace(reinterpret_cast<const char*>(buffer.GetConstBuffer()), buffer.GetSize());
+				CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+				CHECK(trace.find(s_outerZone) != std::string::npos);
+				CHECK(trace.find(s_innerZone) != std::string::npos);
+			}
+
+			AND_WHEN("We clear it")
+			{
+				Nz::Profiler::Clear();
+
+				THEN("Nothing is left")
+				{
+					std::vector<Nz::Profiler::ZoneStats> stats = Nz::Profiler::GetStats();
+					CHECK_FALSE(FindStats(stats, s_outerZone));
+					CHECK_FALSE(FindStats(stats, s_innerZone));
+				}
+			}
+		}
+
+		WHEN("We disable it")
+		{
+			Nz::Profiler::Enable(false);
+			RunZones(2);
+
+			THEN("Zones are not recorded")
+			{
+				CHECK_FALSE(Nz::Profiler::IsEnabled());
+				CHECK_FALSE(FindStats(Nz::Profiler::GetStats(), s_outerZone));
+			}
+		}
+
+		Nz::Profiler::Enable(false);
+		Nz::Profiler::Clear();
+	}
+}
@@ -0,0 +1,64 @@
+#include <Nazara/Core/ReadAheadStream.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("ReadAheadStream", "[CORE][READAHEADSTREAM]")
+{
+	GIVEN("A memory stream of 1000 bytes read ahead by blocks of 64 bytes")
+	{
+		Nz::ByteArray data(1000, 0);
+		for (std::size_t i = 0; i < data.GetSize(); ++i)
+			data[i] = static_cast<Nz::UInt8>(i % 251);
+
+		Nz::MemoryStream source(&data, Nz::OpenMode_ReadOnly);
+		Nz::ReadAheadStream stream(source, 64, 3);
+
+		REQUIRE(stream.GetSize() == 1000U);
+		REQUIRE(stream.GetBlockSize() == 64U);
+		REQUIRE(stream.GetBlockCount() == 3U);
+
+		WHEN("We read it sequentially")
+		{
+			Nz::ByteArray result(1000, 0);
+			std::size_t readSize = 0;
+			while (!stream.EndOfStream())
+				readSize += stream.Read(&result[readSize], 100);
+
+			THEN("We get the whole content")
+			{
+				REQUIRE(readSize == 1000U);
+				REQUIRE(result == data);
+				REQUIRE(stream.Read(&result[0], 10) == 0U);
+			}
+		}
+
+		WHEN("We seek backward and forward")
+		{
+			Nz::UInt8 value;
+			REQUIRE(stream.Read(&value, 1) == 1U);
+			REQUIRE(value == 0);
+
+			THEN("Reads come from the right positions")
+			{
+				REQUIRE(stream.SetCursorPos(900));
+				REQUIRE(stream.Read(&value, 1) == 1U);
+				REQUIRE(value == 900 % 251);
+
+				REQUIRE(stream.SetCursorPos(3));
+				REQUIRE(stream.Read(&value, 1) == 1U);
+				REQUIRE(value == 3);
+
+				REQUIRE(stream.Read(nullptr, 500) == 500U);
+				REQUIRE(stream.GetCursorPos() == 504U);
+				REQUIRE(stream.Read(&value, 1) == 1U);
+				REQUIRE(value == 504 % 251);
+
+				Nz::UInt8 buffer[100];
+				REQUIRE(stream.SetCursorPos(950));
+				REQUIRE(stream.Read(buffer, 100) == 50U);
+				REQUIRE(buffer[49] == 999 % 251);
+			}
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include <Nazara/Core/RefCounted.hpp>
+#include <Nazara/Core/BorrowedRef.hpp>
 #include <Catch/catch.hpp>
 
 SCENARIO("RefCounted", "[CORE][REFCOUNTED]")
@@ -27,3 +28,117 @@ SCENARIO("RefCounted", "[CORE][REFCOUNTED]")
 		}
 	}
 }
+
+namespace
+{
+	class Tracked : public Nz::RefCounted
+	{
+		public:
+			Tracked(unsigned int& destroyedCount, Nz::RefCountingMode countingMode = Nz::RefCountingMode_Atomic) :
+			RefCounted(false, countingMode),
+			m_destroyedCount(destroyedCount)
+			{
+			}
+
+			~Tracked()
+			{
+				m_destroyedCount++;
+			}
+
+			Nz::ObjectRef<Tracked> child;
+
+		private:
+			unsigned int& m_destroyedCount;
+	};
+}
+
+SCENARIO("RefCounted release", "[CORE][REFCOUNTED]")
+{
+	unsigned int destroyedCount = 0;
+
+	GIVEN("A single-threaded refcounted object")
+	{
+		Nz::ObjectRef<Tracked> ref = new Tracked(destroyedCount, Nz::RefCountingMode_SingleThreaded);
+		REQUIRE(ref->GetCountingMode() == Nz::RefCountingMode_SingleThreaded);
+
+		WHEN("We copy and borrow its reference")
+		{
+			Nz::ObjectRef<Tracked> copy = ref;
+			Nz::BorrowedRef<Tracked> borrowed = ref;
+			Nz::BorrowedRef<const Tracked> borrowedCopy = borrowed;
+
+			THEN("Only owning references are counted")
+			{
+				CHECK(ref->GetReferenceCount() == 2);
+				CHECK((borrowed == ref));
+				CHECK(borrowedCopy.Get() == ref.Get());
+
+				Nz::ObjectRef<Tracked> acquired = borrowed.Acquire();
+				CHECK(ref->GetReferenceCount() == 3);
+			}
+		}
+
+		WHEN("We remove its last reference")
+		{
+			ref.Reset();
+
+			THEN("It is destroyed right away")
+			{
+				CHECK(destroyedCount == 1);
+			}
+		}
+	}
+
+	GIVEN("Deferred release enabled on this thread")
+	{
+		Nz::RefCounted::EnableDeferredRelease();
+		REQUIRE(Nz::RefCounted::IsDeferredReleaseEnabled());
+
+		Nz::ObjectRef<Tracked> ref = new Tracked(destroyedCount);
+		ref->child = new Tracked(destroyedCount);
+
+		WHEN("We remove the last reference of an object owning another one")
+		{
+			CHECK_FALSE(ref.Reset());
+
+			THEN("Nothing is destroyed until the flush, which destroys the whole cascade")
+			{
+				CHECK(destroyedCount == 0);
+				CHECK(Nz::RefCounted::FlushDeferredReleases() == 2);
+				CHECK(destroyedCount == 2);
+				CHECK(Nz::RefCounted::FlushDeferredReleases() == 0);
+			}
+		}
+
+		WHEN("A queued object is referenced again before the flush")
+		{
+			Tracked* object = ref.Get();
+			ref.Reset();
+			ref = object;
+
+			THEN("It survives the flush")
+			{
+				CHECK(Nz::RefCounted::FlushDeferredReleases() == 0);
+				CHECK(destroyedCount == 0);
+
+				ref.Reset();
+				CHECK(Nz::RefCounted::FlushDeferredReleases() == 2);
+			}
+		}
+
+		WHEN("We disable deferred release")
+		{
+			ref.Reset();
+			Nz::RefCounted::EnableDeferredRelease(false);
+
+			THEN("Queued objects are flushed")
+			{
+				CHECK(destroyedCount == 2);
+			}
+		}
+
+		ref.Reset();
+		Nz::RefCounted::EnableDeferredRelease(false);
+		CHECK(destroyedCount == 2);
+	}
+}
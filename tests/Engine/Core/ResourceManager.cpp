@@ -0,0 +1,159 @@
+#include <Nazara/Core/ResourceManager.hpp>
+#include <Nazara/Core/RefCounted.hpp>
+#include <Nazara/Core/Resource.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+	struct TestParams : Nz::ResourceParameters
+	{
+	};
+
+	class TestResource;
+
+	using TestResourceManager = Nz::ResourceManager<TestResource, TestParams>;
+	using TestResourceRef = Nz::ObjectRef<TestResource>;
+
+	std::atomic_uint s_loadCount(0);
+
+	class TestResource : public Nz::RefCounted, public Nz::Resource
+	{
+		friend TestResourceManager;
+
+		public:
+			TestResource() :
+			RefCounted(false)
+			{
+			}
+
+			std::size_t GetMemoryUsage() const
+			{
+				return 100;
+			}
+
+			bool LoadFromFile(const Nz::String& filePath, const TestParams& /*params*/)
+			{
+				// Leaves time for other requests of the same file
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				s_loadCount++;
+
+				return !filePath.EndsWith("invalid");
+			}
+
+			static TestResourceRef New()
+			{
+				return new TestResource;
+			}
+
+		private:
+			static TestResourceManager::ManagerCache s_managerCache;
+			static TestResourceManager::ManagerLoads s_managerLoads;
+			static TestResourceManager::ManagerMap s_managerMap;
+			static TestResourceManager::ManagerParams s_managerParameters;
+	};
+
+	TestResourceManager::ManagerCache TestResource::s_managerCache;
+	TestResourceManager::ManagerLoads TestResource::s_managerLoads;
+	TestResourceManager::ManagerMap TestResource::s_managerMap;
+	TestResourceManager::ManagerParams TestResource::s_managerParameters;
+}
+
+SCENARIO("ResourceManager", "[CORE][RESOURCEMANAGER]")
+{
+	GIVEN("A resource manager")
+	{
+		s_loadCount = 0;
+
+		WHEN("We request the same file asynchronously twice")
+		{
+			Nz::ResourceRequest<TestResource> first = TestResourceManager::GetAsync("resource");
+			Nz::ResourceRequest<TestResource> second = TestResourceManager::GetAsync("resource");
+			REQUIRE(first.IsValid());
+			REQUIRE(second.IsValid());
+
+			THEN("It is loaded only once")
+			{
+				TestResourceRef firstResource = first.Wait();
+				TestResourceRef secondResource = second.Wait();
+				REQUIRE(firstResource.IsValid());
+				CHECK((firstResource == secondResource));
+				CHECK(first.IsDone());
+				CHECK(s_loadCount == 1);
+
+				AND_THEN("It is registered in the manager")
+				{
+					CHECK((TestResourceManager::Get("resource") == firstResource));
+
+					Nz::ResourceRequest<TestResource> third = TestResourceManager::GetAsync("resource");
+					CHECK(third.IsDone());
+					CHECK((third.Wait() == firstResource));
+					CHECK(s_loadCount == 1);
+				}
+			}
+		}
+
+		WHEN("We request a file asynchronously then synchronously")
+		{
+			Nz::ResourceRequest<TestResource> request = TestResourceManager::GetAsync("resource");
+			TestResourceRef resource = TestResourceManager::Get("resource");
+
+			THEN("The synchronous request waits for the load in flight")
+			{
+				CHECK((resource == request.Wait()));
+				CHECK(s_loadCount == 1);
+			}
+		}
+
+		WHEN("The load fails")
+		{
+			Nz::ResourceRequest<TestResource> request = TestResourceManager::GetAsync("invalid");
+
+			THEN("The request gives no resource and nothing is registered")
+			{
+				CHECK_FALSE(request.Wait().IsValid());
+
+				TestResourceManager::Purge();
+				CHECK_FALSE(TestResourceManager::Get("invalid").IsValid());
+				CHECK(s_loadCount == 2);
+			}
+		}
+
+		WHEN("We load more than the memory budget allows")
+		{
+			TestResourceManager::SetMemoryBudget(300);
+			TestResourceManager::ResetStats();
+
+			TestResourceRef kept = TestResourceManager::Get("first");
+			TestResourceManager::Get("second");
+			TestResourceManager::Get("third");
+			TestResourceManager::Get("second");
+			TestResourceManager::Get("fourth");
+
+			THEN("The least recently used unreferenced resource is evicted")
+			{
+				const Nz::ResourceManagerStats& stats = TestResourceManager::GetStats();
+				CHECK(stats.evictionCount == 1);
+				CHECK(stats.hitCount == 1);
+				CHECK(stats.missCount == 4);
+				CHECK(stats.residentBytes == 300);
+				CHECK(stats.residentCount == 3);
+				CHECK(TestResourceManager::GetHitRate() == Approx(0.2f));
+
+				CHECK((TestResourceManager::Get("first") == kept));
+				TestResourceManager::Get("second");
+				CHECK(s_loadCount == 4);
+
+				TestResourceManager::Get("third");
+				CHECK(s_loadCount == 5);
+			}
+
+			TestResourceManager::SetMemoryBudget(0);
+		}
+
+		TestResourceManager::Clear();
+	}
+}
@@ -1,5 +1,7 @@
 #include <Nazara/Core/SerializationContext.hpp>
 
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Core/Color.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Math/BoundingVolume.hpp>
@@ -260,4 +262,43 @@ SCENARIO("Serialization", "[CORE][SERIALIZATION]")
 			}
 		}
 	}
+
+	GIVEN("An array of vectors")
+	{
+		std::vector<Nz::Vector3f> vectors(1000);
+		for (std::size_t i = 0; i < vectors.size(); ++i)
+			vectors[i].Set(float(i), float(i) * 0.5f, -float(i));
+
+		for (Nz::Endianness endianness : {Nz::Endianness_BigEndian, Nz::Endianness_LittleEndian})
+		{
+			WHEN("We serialize it in one block with endianness " + std::to_string(static_cast<int>(endianness)))
+			{
+				Nz::ByteArray bulk;
+				Nz::ByteStream bulkStream(&bulk, Nz::OpenMode_WriteOnly);
+				bulkStream.SetDataEndianness(endianness);
+				REQUIRE(bulkStream.WriteArray(vectors.data(), vectors.size()));
+
+				THEN("It produces the same bytes as serializing each vector")
+				{
+					Nz::ByteArray perElement;
+					Nz::ByteStream perElementStream(&perElement, Nz::OpenMode_WriteOnly);
+					perElementStream.SetDataEndianness(endianness);
+					for (const Nz::Vector3f& vector : vectors)
+						perElementStream << vector;
+
+					REQUIRE(bulk.GetSize() == vectors.size() * sizeof(Nz::Vector3f));
+					REQUIRE(bulk == perElement);
+				}
+
+				AND_THEN("We can read it back")
+				{
+					std::vector<Nz::Vector3f> result(vectors.size());
+					Nz::ByteStream readStream(&bulk, Nz::OpenMode_ReadOnly);
+					readStream.SetDataEndianness(endianness);
+					REQUIRE(readStream.ReadArray(result.data(), result.size()));
+					REQUIRE(result == vectors);
+				}
+			}
+		}
+	}
 }
@@ -0,0 +1,108 @@
+#include <Nazara/Core/SharedMutex.hpp>
+#include <Nazara/Core/ExclusiveLockGuard.hpp>
+#include <Nazara/Core/SharedLockGuard.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+SCENARIO("SharedMutex", "[CORE][SHAREDMUTEX]")
+{
+	GIVEN("A shared mutex")
+	{
+		Nz::SharedMutex mutex;
+
+		WHEN("A reader owns it")
+		{
+			Nz::SharedLockGuard readLock(mutex);
+
+			THEN("Other readers can own it too, but not writers")
+			{
+				bool otherReader = false;
+				bool writer = true;
+
+				Nz::Thread thread([&]()
+				{
+					otherReader = mutex.TryLockShared();
+					if (otherReader)
+						mutex.UnlockShared();
+
+					writer = mutex.TryLock();
+					if (writer)
+						mutex.Unlock();
+				});
+				thread.Join();
+
+				CHECK(otherReader);
+				CHECK_FALSE(writer);
+			}
+		}
+
+		WHEN("A writer owns it")
+		{
+			Nz::ExclusiveLockGuard writeLock(mutex);
+
+			THEN("Nobody else can own it")
+			{
+				bool reader = true;
+				bool writer = true;
+
+				Nz::Thread thread([&]()
+				{
+					reader = mutex.TryLockShared();
+					if (reader)
+						mutex.UnlockShared();
+
+					writer = mutex.TryLock();
+					if (writer)
+						mutex.Unlock();
+				});
+				thread.Join();
+
+				CHECK_FALSE(reader);
+				CHECK_FALSE(writer);
+			}
+		}
+
+		WHEN("Readers and writers run concurrently")
+		{
+			// The writers keep both values equal, readers must never see them differ
+			unsigned int first = 0;
+			unsigned int second = 0;
+			std::atomic_bool mismatch(false);
+
+			std::vector<Nz::Thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&, i]()
+				{
+					for (unsigned int j = 0; j < 10000; ++j)
+					{
+						if (i % 2 == 0)
+						{
+							Nz::ExclusiveLockGuard lock(mutex);
+							++first;
+							++second;
+						}
+						else
+						{
+							Nz::SharedLockGuard lock(mutex);
+							if (first != second)
+								mismatch = true;
+						}
+					}
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			THEN("Writes are exclusive")
+			{
+				CHECK_FALSE(mismatch);
+				CHECK(first == 20000);
+			}
+		}
+	}
+}
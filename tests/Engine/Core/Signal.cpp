@@ -1,6 +1,9 @@
 #include <Nazara/Core/Signal.hpp>
 #include <Catch/catch.hpp>
 
+#include <array>
+#include <vector>
+
 struct Incrementer
 {
 	void increment(int* inc)
@@ -45,4 +48,106 @@ SCENARIO("Signal", "[CORE][SIGNAL]")
 			}
 		}
 	}
+
+	GIVEN("A signal whose listeners disconnect while it is emitted")
+	{
+		Nz::Signal<int*> signal;
+
+		Nz::Signal<int*>::Connection selfConnection;
+		Nz::Signal<int*>::Connection otherConnection;
+
+		selfConnection = signal.Connect([&selfConnection, &otherConnection](int* inc)
+		{
+			*inc += 1;
+			selfConnection.Disconnect();
+			otherConnection.Disconnect();
+		});
+
+		otherConnection = signal.Connect([](int* inc) { *inc += 10; });
+		signal.Connect([](int* inc) { *inc += 100; });
+
+		WHEN("We emit it twice")
+		{
+			int inc = 0;
+			signal(&inc);
+			signal(&inc);
+
+			THEN("The disconnected listeners should only be called before their disconnection")
+			{
+				REQUIRE(inc == 201);
+				REQUIRE(!selfConnection.IsConnected());
+				REQUIRE(!otherConnection.IsConnected());
+			}
+		}
+	}
+
+	GIVEN("A signal with a listener connecting another one while it is emitted")
+	{
+		Nz::Signal<int*> signal;
+		std::vector<Nz::Signal<int*>::Connection> connections;
+
+		signal.Connect([&signal, &connections](int* inc)
+		{
+			*inc += 1;
+			for (int i = 0; i < 100; ++i)
+				connections.emplace_back(signal.Connect([](int* value) { *value += 1; }));
+		});
+
+		WHEN("We emit it")
+		{
+			int inc = 0;
+			signal(&inc);
+
+			THEN("The new listeners are called during the same emission")
+			{
+				REQUIRE(inc == 101);
+			}
+		}
+	}
+
+	GIVEN("Copies of a connection and a large callback")
+	{
+		std::array<int, 32> payload;
+		payload.fill(1);
+
+		Nz::Signal<int*>* signal = new Nz::Signal<int*>;
+		Nz::Signal<int*>::Connection connection = signal->Connect([payload](int* inc)
+		{
+			for (int value : payload)
+				*inc += value;
+		});
+
+		Nz::Signal<int*>::Connection copy(connection);
+		Nz::Signal<int*>::Connection moved(std::move(copy));
+
+		WHEN("We emit the signal")
+		{
+			int inc = 0;
+			(*signal)(&inc);
+
+			THEN("The callback stored outside of the slot is called")
+			{
+				REQUIRE(inc == 32);
+				REQUIRE(connection.IsConnected());
+				REQUIRE(!copy.IsConnected());
+				REQUIRE(moved.IsConnected());
+			}
+		}
+
+		WHEN("We destroy the signal")
+		{
+			delete signal;
+			signal = nullptr;
+
+			THEN("Every connection should be reset")
+			{
+				REQUIRE(!connection.IsConnected());
+				REQUIRE(!moved.IsConnected());
+
+				connection.Disconnect(); //< Must be a no-op
+			}
+		}
+
+		delete signal;
+	}
 }
@@ -0,0 +1,86 @@
+#include <Nazara/Core/SpinMutex.hpp>
+#include <Nazara/Core/SpinLockGuard.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <vector>
+
+SCENARIO("SpinMutex", "[CORE][SPINMUTEX]")
+{
+	GIVEN("A spin mutex")
+	{
+		Nz::SpinMutex mutex;
+
+		WHEN("We lock it")
+		{
+			Nz::SpinLockGuard lock(mutex);
+
+			THEN("It cannot be locked again")
+			{
+				CHECK_FALSE(mutex.TryLock());
+			}
+		}
+
+		WHEN("We unlock it")
+		{
+			mutex.Lock();
+			mutex.Unlock();
+
+			THEN("It can be locked again")
+			{
+				CHECK(mutex.TryLock());
+				mutex.Unlock();
+			}
+		}
+
+		WHEN("Several threads increment a counter under the mutex")
+		{
+			unsigned int counter = 0;
+
+			std::vector<Nz::Thread> threads;
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				threads.emplace_back([&]()
+				{
+					for (unsigned int j = 0; j < 50000; ++j)
+					{
+						Nz::SpinLockGuard lock(mutex);
+						++counter;
+					}
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			THEN("No increment is lost")
+			{
+				CHECK(counter == 200000);
+			}
+		}
+
+		WHEN("The owner holds it for long")
+		{
+			unsigned int counter = 0;
+
+			mutex.Lock();
+
+			Nz::Thread thread([&]()
+			{
+				Nz::SpinLockGuard lock(mutex);
+				++counter;
+			});
+
+			Nz::Thread::Sleep(20); // The other thread stops spinning and blocks
+			counter = 1;
+			mutex.Unlock();
+
+			thread.Join();
+
+			THEN("The blocked thread is woken up")
+			{
+				CHECK(counter == 2);
+			}
+		}
+	}
+}
@@ -0,0 +1,88 @@
+#include <Nazara/Core/SpscQueue.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("SpscQueue", "[CORE][SPSCQUEUE]")
+{
+	GIVEN("A queue of three values")
+	{
+		Nz::SpscQueue<int> queue(3);
+
+		THEN("Its capacity is rounded up to a power of two")
+		{
+			CHECK(queue.GetCapacity() == 4);
+			CHECK(queue.IsEmpty());
+		}
+
+		WHEN("We fill it")
+		{
+			for (int i = 0; i < 4; ++i)
+				CHECK(queue.Push(i));
+
+			THEN("It refuses more values")
+			{
+				CHECK_FALSE(queue.Push(4));
+				CHECK(queue.GetSize() == 4);
+			}
+
+			THEN("Values come out in order")
+			{
+				int value;
+				for (int i = 0; i < 4; ++i)
+				{
+					REQUIRE(queue.Pop(&value));
+					CHECK(value == i);
+				}
+
+				CHECK_FALSE(queue.Pop(&value));
+			}
+
+			AND_WHEN("We clear it")
+			{
+				queue.Clear();
+
+				THEN("It is empty and accepts values again")
+				{
+					CHECK(queue.IsEmpty());
+					CHECK(queue.Push(5));
+				}
+			}
+		}
+
+		WHEN("A thread produces values while another consumes them")
+		{
+			const unsigned int valueCount = 100000;
+
+			Nz::Thread producer([&]()
+			{
+				for (unsigned int i = 0; i < valueCount; ++i)
+				{
+					while (!queue.Push(i))
+						Nz::Thread::Sleep(0);
+				}
+			});
+
+			bool ordered = true;
+			unsigned int expected = 0;
+			while (expected < valueCount)
+			{
+				int value;
+				if (queue.Pop(&value))
+				{
+					if (value != static_cast<int>(expected))
+						ordered = false;
+
+					expected++;
+				}
+			}
+
+			producer.Join();
+
+			THEN("Every value is received once and in order")
+			{
+				CHECK(ordered);
+				CHECK(queue.IsEmpty());
+			}
+		}
+	}
+}
@@ -142,5 +142,56 @@ SCENARIO("String", "[CORE][STRING]")
 			}
 		}
 	}
-}
 
+	GIVEN("A short string")
+	{
+		Nz::String shortString("Diffuse");
+
+		WHEN("We append characters until it no longer fits the small buffer")
+		{
+			Nz::String copy = shortString;
+			for (unsigned int i = 0; i < 40; ++i)
+				shortString += 'x';
+
+			THEN("Content and copies are preserved")
+			{
+				REQUIRE(shortString.GetSize() == 7 + 40);
+				REQUIRE(shortString.StartsWith("Diffusexxx"));
+				REQUIRE(shortString.EndsWith("xxx"));
+				REQUIRE(shortString.GetCapacity() >= shortString.GetSize());
+				REQUIRE(copy == "Diffuse");
+			}
+		}
+
+		WHEN("We modify a copy of it")
+		{
+			Nz::String copy = shortString;
+			copy[0] = 'd';
+
+			THEN("The original string is not affected")
+			{
+				REQUIRE(shortString == "Diffuse");
+				REQUIRE(copy == "diffuse");
+			}
+		}
+	}
+
+	GIVEN("A string with extra blanks")
+	{
+		Nz::String blanks("  a   b  ");
+
+		WHEN("We simplify it")
+		{
+			Nz::String simplified = blanks.Simplified();
+			blanks.Simplify();
+
+			THEN("Both forms have the right size")
+			{
+				REQUIRE(simplified == "a b");
+				REQUIRE(simplified.GetSize() == 3);
+				REQUIRE(blanks == "a b");
+				REQUIRE(blanks.GetSize() == 3);
+			}
+		}
+	}
+}
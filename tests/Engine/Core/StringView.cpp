@@ -0,0 +1,101 @@
+#include <Nazara/Core/StringView.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("StringView", "[CORE][STRINGVIEW]")
+{
+	GIVEN("A view of a line of an OBJ file")
+	{
+		Nz::String line("vn 0.25   -1.5 3");
+		Nz::StringView view(line);
+
+		WHEN("We look for words")
+		{
+			THEN("They reference the characters of the line")
+			{
+				Nz::StringView keyword = view.GetWord(0);
+				REQUIRE(keyword == "vn");
+				REQUIRE(keyword.GetConstBuffer() == line.GetConstBuffer());
+				REQUIRE(keyword.Equals("VN", Nz::String::CaseInsensitive));
+				REQUIRE(view.GetWord(2) == "-1.5");
+				REQUIRE(view.GetWord(4).IsEmpty());
+				REQUIRE(view.GetWordPosition(3) == 15);
+			}
+		}
+
+		WHEN("We split it")
+		{
+			std::vector<Nz::StringView> tokens;
+			REQUIRE(view.Split(tokens) == 4);
+
+			THEN("Empty tokens are skipped and numbers can be converted")
+			{
+				REQUIRE(tokens[0] == "vn");
+				REQUIRE(tokens[3] == "3");
+
+				double x;
+				REQUIRE(tokens[1].ToDouble(&x));
+				REQUIRE(x == Approx(0.25));
+
+				long long z;
+				REQUIRE(tokens[3].ToInteger(&z));
+				REQUIRE(z == 3);
+
+				REQUIRE_FALSE(tokens[0].ToInteger(nullptr));
+			}
+		}
+
+		WHEN("We split it from a String")
+		{
+			std::vector<Nz::StringView> tokens;
+			line.Split(tokens, ' ', 3);
+
+			THEN("We get views over the string")
+			{
+				REQUIRE(tokens.size() == 3);
+				REQUIRE(tokens[0] == "0.25");
+				REQUIRE(Nz::String(tokens[1]) == "-1.5");
+			}
+		}
+	}
+
+	GIVEN("A view with blanks and comments")
+	{
+		Nz::StringView view("  \tmap_Kd texture.png // diffuse  ");
+
+		WHEN("We trim and cut it")
+		{
+			Nz::StringView content = view.SubStringTo("//").Trimmed();
+
+			THEN("The result is what we expect")
+			{
+				REQUIRE(content == "map_Kd texture.png");
+				REQUIRE(content.StartsWith("MAP_", Nz::String::CaseInsensitive));
+				REQUIRE(content.EndsWith(".png"));
+				REQUIRE(content.SubStringFrom(" ") == "texture.png");
+				REQUIRE(content.Find('.') == 14);
+				REQUIRE(content.FindLast('p') == 15);
+				REQUIRE(content.FindAny("xyz") == 9);
+				REQUIRE(content.SubString(-3) == "png");
+				REQUIRE(content.ToString() == "map_Kd texture.png");
+			}
+		}
+	}
+
+	GIVEN("Some boolean and integer views")
+	{
+		THEN("They are converted like their String counterparts")
+		{
+			bool value;
+			REQUIRE(Nz::StringView("TRUE").ToBool(&value, Nz::String::CaseInsensitive));
+			REQUIRE(value);
+			REQUIRE_FALSE(Nz::StringView("TRUE").ToBool(&value));
+
+			long long number;
+			REQUIRE(Nz::StringView("ff").ToInteger(&number, 16));
+			REQUIRE(number == 255);
+			REQUIRE(Nz::StringView(" -42 ").ToInteger(&number));
+			REQUIRE(number == -42);
+			REQUIRE_FALSE(Nz::StringView("12a").ToInteger(&number));
+		}
+	}
+}
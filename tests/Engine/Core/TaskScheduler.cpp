@@ -0,0 +1,171 @@
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <vector>
+
+SCENARIO("TaskScheduler", "[CORE][TASKSCHEDULER]")
+{
+	GIVEN("A task scheduler with four workers")
+	{
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(4);
+		REQUIRE(Nz::TaskScheduler::Initialize());
+
+		std::atomic_uint counter(0);
+
+		WHEN("We run a lot of tasks")
+		{
+			for (unsigned int i = 0; i < 1000; ++i)
+				Nz::TaskScheduler::AddTask([&counter]() { counter++; });
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Every task has been executed")
+			{
+				REQUIRE(counter == 1000);
+			}
+		}
+
+		WHEN("Tasks capture more than fits in their state")
+		{
+			std::array<unsigned int, 64> increments;
+			increments.fill(1);
+
+			for (unsigned int i = 0; i < 100; ++i)
+			{
+				Nz::TaskScheduler::AddTask([&counter, increments]()
+				{
+					for (unsigned int increment : increments)
+						counter += increment;
+				});
+			}
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Every task has been executed with its capture")
+			{
+				REQUIRE(counter == 6400);
+			}
+		}
+
+		WHEN("Tasks spawn other tasks")
+		{
+			for (unsigned int i = 0; i < 100; ++i)
+			{
+				Nz::TaskScheduler::AddTask([&counter]()
+				{
+					for (unsigned int j = 0; j < 10; ++j)
+						Nz::TaskScheduler::AddTask([&counter]() { counter++; });
+
+					counter++;
+				});
+			}
+
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Spawned tasks are waited for too")
+			{
+				REQUIRE(counter == 1100);
+			}
+		}
+
+		WHEN("A task depends on others")
+		{
+			std::atomic_uint firstDone(0);
+			std::atomic_bool orderRespected(false);
+
+			Nz::TaskHandle first = Nz::TaskScheduler::AddTask([&firstDone]() { Nz::Thread::Sleep(10); firstDone++; });
+			Nz::TaskHandle second = Nz::TaskScheduler::AddTask([&firstDone]() { firstDone++; });
+			Nz::TaskHandle last = Nz::TaskScheduler::AddTaskAfter({first, second}, [&]()
+			{
+				orderRespected = (firstDone == 2);
+			});
+
+			Nz::TaskScheduler::Wait(last);
+
+			THEN("It runs after its dependencies")
+			{
+				CHECK(first.IsDone());
+				CHECK(second.IsDone());
+				CHECK(last.IsDone());
+				REQUIRE(orderRespected);
+			}
+		}
+
+		WHEN("We build a chain of tasks from inside a task")
+		{
+			Nz::TaskHandle root = Nz::TaskScheduler::AddTask([&counter]()
+			{
+				Nz::TaskHandle previous;
+				for (unsigned int i = 0; i < 50; ++i)
+					previous = Nz::TaskScheduler::AddTaskAfter({previous}, [&counter, i]() { if (counter == i) counter++; });
+
+				Nz::TaskScheduler::Wait(previous);
+			});
+
+			Nz::TaskScheduler::Wait(root);
+
+			THEN("The chain is executed in order")
+			{
+				REQUIRE(counter == 50);
+			}
+		}
+
+		WHEN("We use a parallel for over a range")
+		{
+			std::vector<unsigned int> values(10000, 0);
+			Nz::TaskScheduler::ParallelFor(0, values.size(), 64, [&values](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					values[i]++;
+			});
+
+			THEN("Every index has been processed exactly once")
+			{
+				REQUIRE(std::count(values.begin(), values.end(), 1U) == 10000);
+			}
+		}
+
+		WHEN("We ask for the worker index")
+		{
+			std::vector<unsigned int> indices(100, 0);
+			Nz::TaskScheduler::ParallelFor(0, indices.size(), 1, [&indices](std::size_t first, std::size_t last)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					indices[i] = Nz::TaskScheduler::GetWorkerIndex();
+			});
+
+			THEN("Workers get their own index and other threads the worker count")
+			{
+				CHECK(Nz::TaskScheduler::GetWorkerIndex() == 4);
+				REQUIRE(std::all_of(indices.begin(), indices.end(), [](unsigned int index) { return index <= 4; }));
+			}
+		}
+
+		WHEN("We reduce a range")
+		{
+			Nz::UInt64 sum = Nz::TaskScheduler::ParallelReduce(1, 100001, 100, Nz::UInt64(0), [](std::size_t first, std::size_t last, Nz::UInt64 partialSum)
+			{
+				for (std::size_t i = first; i < last; ++i)
+					partialSum += i;
+
+				return partialSum;
+			}, [](Nz::UInt64 lhs, Nz::UInt64 rhs) { return lhs + rhs; });
+
+			THEN("The result is the same as a sequential sum")
+			{
+				REQUIRE(sum == 5000050000ULL);
+			}
+		}
+
+		Nz::TaskScheduler::Uninitialize();
+		Nz::TaskScheduler::SetWorkerCount(0);
+	}
+}
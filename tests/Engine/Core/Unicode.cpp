@@ -0,0 +1,138 @@
+#include <Nazara/Core/Unicode.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Catch/catch.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+	std::vector<std::string> GetInvalidStrings()
+	{
+		std::string padding(29, 'a'); // Puts the faulty sequence across the 16 and 32 bytes block boundaries
+
+		return {
+			"\x80",                               // Lone continuation byte
+			"abc\xC3",                            // Truncated two bytes sequence
+			"abc\xE2\x82",                        // Truncated three bytes sequence
+			"\xC0\xAF",                           // Overlong two bytes sequence
+			"\xE0\x80\xAF",                       // Overlong three bytes sequence
+			"\xF0\x80\x80\xAF",                   // Overlong four bytes sequence
+			"\xED\xA0\x80",                       // Surrogate
+			"\xF4\x90\x80\x80",                   // Above U+10FFFF
+			"\xF8\x88\x80\x80\x80",               // Five bytes sequence
+			"\xC3\xA9\xA9",                       // Too many continuation bytes
+			"\xE2\x82\x41",                       // ASCII in the middle of a sequence
+			padding + "\xE2\x82\xAC\xE2\x82",     // Truncated at the end of a block
+			padding + "\xF0\x9F\x98" + padding,   // Truncated across a block boundary
+			padding + "\xED\xBF\xBF" + padding,   // Surrogate across a block boundary
+			std::string(64, 'x') + "\xFF"         // Invalid byte after ASCII blocks
+		};
+	}
+
+	std::vector<std::string> GetValidStrings()
+	{
+		std::string padding(29, 'a');
+
+		return {
+			"",
+			"Hello world",
+			std::string(100, 'z'),
+			"\xC3\xA9t\xC3\xA9",                                      // été
+			"\xE2\x82\xAC",                                           // Euro sign
+			"\xF0\x9F\x98\x80",                                       // Emoji
+			"\xF4\x8F\xBF\xBF",                                       // U+10FFFF
+			"\xEE\x80\x80",                                           // U+E000, just after the surrogates
+			padding + "\xE2\x82\xAC" + padding,                       // Sequence across the block boundaries
+			padding + "\xF0\x9F\x98\x80" + padding + "\xC3\xA9" + std::string(40, 'b')
+		};
+	}
+
+	std::u32string DecodeReference(const std::string& str)
+	{
+		std::u32string result;
+		for (std::size_t i = 0; i < str.size();)
+		{
+			unsigned char lead = str[i];
+			std::size_t length = (lead < 0x80) ? 1 : (lead < 0xE0) ? 2 : (lead < 0xF0) ? 3 : 4;
+			char32_t codepoint = (length == 1) ? lead : lead & (0x7F >> length);
+			for (std::size_t j = 1; j < length; ++j)
+				codepoint = (codepoint << 6) | (str[i + j] & 0x3F);
+
+			result.push_back(codepoint);
+			i += length;
+		}
+
+		return result;
+	}
+
+	void CheckImplementation()
+	{
+		for (const std::string& str : GetValidStrings())
+		{
+			INFO("String: " << str);
+			CHECK(Nz::Unicode::IsValidUtf8(str.data(), str.size()));
+
+			std::u32string converted(str.size(), U'\0');
+			converted.resize(Nz::Unicode::Utf8ToUtf32(str.data(), str.size(), &converted[0]));
+			CHECK(converted == DecodeReference(str));
+		}
+
+		for (const std::string& str : GetInvalidStrings())
+		{
+			INFO("String: " << str);
+			CHECK_FALSE(Nz::Unicode::IsValidUtf8(str.data(), str.size()));
+		}
+	}
+}
+
+SCENARIO("Unicode", "[CORE][UNICODE]")
+{
+	GIVEN("Valid and invalid UTF-8 strings")
+	{
+		WHEN("We check and convert them with the best implementation")
+		{
+			THEN("The results are right")
+			{
+				CheckImplementation();
+			}
+		}
+
+		WHEN("We disable the SIMD capabilities one after another")
+		{
+			THEN("Every implementation gives the same results")
+			{
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSSE3, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+				{
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+					CheckImplementation();
+				}
+
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSSE3, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+			}
+		}
+	}
+
+	GIVEN("A String holding UTF-8")
+	{
+		Nz::String str("\xC3\xA9t\xC3\xA9 " + std::string(40, 'a') + "\xF0\x9F\x98\x80");
+
+		THEN("It is valid and can be converted to UTF-32")
+		{
+			CHECK(str.IsValidUtf8());
+
+			std::u32string utf32 = str.GetUtf32String();
+			REQUIRE(utf32.size() == 45);
+			CHECK(utf32[0] == U'é');
+			CHECK(utf32[1] == U't');
+			CHECK(utf32[44] == U'\U0001F600');
+		}
+
+		THEN("Invalid UTF-8 is detected")
+		{
+			CHECK_FALSE(Nz::String("abc\xC3").IsValidUtf8());
+		}
+	}
+}
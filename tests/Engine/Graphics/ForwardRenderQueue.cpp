@@ -0,0 +1,238 @@
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
+#include <Catch/catch.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "TestViewer.hpp"
+
+SCENARIO("ForwardRenderQueue", "[GRAPHICS][FORWARDRENDERQUEUE]")
+{
+	GIVEN("A forward render queue recording a command list")
+	{
+		Nz::ForwardRenderQueue queue;
+		queue.EnableCommandList(true);
+		REQUIRE(queue.IsCommandListEnabled());
+
+		Nz::MaterialRef opaqueMaterial = Nz::Material::New();
+		Nz::MaterialRef otherOpaqueMaterial = Nz::Material::New();
+		Nz::MaterialRef transparentMaterial = Nz::Material::New();
+		transparentMaterial->Enable(Nz::RendererParameter_Blend, true);
+
+		Nz::VertexBuffer vertexBuffer;
+		Nz::VertexBuffer otherVertexBuffer;
+
+		Nz::MeshData meshData;
+		meshData.indexBuffer = nullptr;
+		meshData.primitiveMode = Nz::PrimitiveMode_TriangleList;
+		meshData.skeleton = nullptr;
+		meshData.vertexBuffer = &vertexBuffer;
+
+		Nz::MeshData otherMeshData = meshData;
+		otherMeshData.vertexBuffer = &otherVertexBuffer;
+
+		Nz::Boxf aabb(-1.f, -1.f, -1.f, 2.f, 2.f, 2.f);
+
+		// Interleaved on purpose, the sort has to gather them
+		for (int i = 0; i < 12; ++i)
+		{
+			const Nz::Material* material = (i % 2 == 0) ? opaqueMaterial : otherOpaqueMaterial;
+			const Nz::MeshData& mesh = (i % 3 == 0) ? meshData : otherMeshData;
+			float distance = 10.f + static_cast<float>((i * 7) % 12);
+
+			queue.AddMesh(0, material, mesh, aabb, Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * distance));
+			queue.AddMesh(0, transparentMaterial, mesh, aabb, Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * distance));
+		}
+
+		queue.AddMesh(-1, opaqueMaterial, meshData, aabb, Nz::Matrix4f::Identity());
+
+		WHEN("We sort it")
+		{
+			TestViewer viewer;
+			queue.Sort(&viewer);
+
+			const auto& commands = queue.commandList.commands;
+			REQUIRE(commands.size() == 25);
+
+			THEN("Commands are ordered by layer, then by type")
+			{
+				CHECK(Nz::ForwardRenderQueue::GetCommandLayer(commands.front().sortKey) == 127);
+				CHECK(Nz::ForwardRenderQueue::GetCommandType(commands.front().sortKey) == Nz::ForwardRenderQueue::CommandType_OpaqueModel);
+
+				bool ordered = true;
+				for (std::size_t i = 1; i < commands.size(); ++i)
+				{
+					if (commands[i - 1].sortKey > commands[i].sortKey)
+						ordered = false;
+				}
+
+				CHECK(ordered);
+				CHECK(Nz::ForwardRenderQueue::GetCommandType(commands.back().sortKey) == Nz::ForwardRenderQueue::CommandType_TransparentModel);
+			}
+
+			THEN("Opaque instances of a material and a mesh are contiguous and drawn front to back")
+			{
+				std::vector<std::pair<const Nz::Material*, const Nz::VertexBuffer*>> groups;
+				bool frontToBack = true;
+				float lastDistance = 0.f;
+
+				for (std::size_t i = 1; i < commands.size(); ++i)
+				{
+					if (Nz::ForwardRenderQueue::GetCommandType(commands[i].sortKey) != Nz::ForwardRenderQueue::CommandType_OpaqueModel)
+						continue;
+
+					const auto& data = queue.commandList.models[commands[i].index];
+					float distance = data.transformMatrix.GetTranslation().GetLength();
+
+					auto group = std::make_pair(data.material, data.meshData.vertexBuffer);
+					if (groups.empty() || groups.back() != group)
+						groups.push_back(group);
+					else if (distance < lastDistance)
+						frontToBack = false;
+
+					lastDistance = distance;
+				}
+
+				CHECK(groups.size() == 4);
+				CHECK(frontToBack);
+			}
+
+			THEN("Transparent models are drawn back to front")
+			{
+				bool backToFront = true;
+				float lastDistance = std::numeric_limits<float>::infinity();
+
+				for (const auto& command : commands)
+				{
+					if (Nz::ForwardRenderQueue::GetCommandType(command.sortKey) != Nz::ForwardRenderQueue::CommandType_TransparentModel)
+						continue;
+
+					float distance = queue.commandList.models[command.index].transformMatrix.GetTranslation().GetLength();
+					if (distance > lastDistance)
+						backToFront = false;
+
+					lastDistance = distance;
+				}
+
+				CHECK(backToFront);
+			}
+		}
+
+		WHEN("We clear it")
+		{
+			queue.Clear();
+
+			THEN("The command list is empty")
+			{
+				CHECK(queue.commandList.commands.empty());
+				CHECK(queue.commandList.models.empty());
+			}
+		}
+	}
+
+	GIVEN("Two queues filled with halves of a scene")
+	{
+		Nz::ForwardRenderQueue queue;
+		queue.EnableCommandList(true);
+
+		Nz::ForwardRenderQueue firstHalf;
+		firstHalf.EnableCommandList(true);
+
+		Nz::ForwardRenderQueue secondHalf;
+		secondHalf.EnableCommandList(true);
+
+		Nz::MaterialRef material = Nz::Material::New();
+
+		Nz::VertexBuffer vertexBuffer;
+
+		Nz::MeshData meshData;
+		meshData.indexBuffer = nullptr;
+		meshData.primitiveMode = Nz::PrimitiveMode_TriangleList;
+		meshData.skeleton = nullptr;
+		meshData.vertexBuffer = &vertexBuffer;
+
+		Nz::Boxf aabb(-1.f, -1.f, -1.f, 2.f, 2.f, 2.f);
+
+		for (int i = 0; i < 8; ++i)
+		{
+			Nz::Matrix4f transformMatrix = Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * (10.f + static_cast<float>((i * 5) % 8)));
+			Nz::Vector3f billboardPosition = Nz::Vector3f::Forward() * static_cast<float>(i);
+
+			queue.AddMesh(0, material, meshData, aabb, transformMatrix);
+			queue.AddBillboard(0, material, billboardPosition, Nz::Vector2f(1.f));
+
+			Nz::ForwardRenderQueue& half = (i < 4) ? firstHalf : secondHalf;
+			half.AddMesh(0, material, meshData, aabb, transformMatrix);
+			half.AddBillboard(0, material, billboardPosition, Nz::Vector2f(1.f));
+		}
+
+		WHEN("We merge them in order")
+		{
+			Nz::ForwardRenderQueue merged;
+			merged.EnableCommandList(true);
+			merged.MergeCommandList(firstHalf);
+			merged.MergeCommandList(secondHalf);
+
+			TestViewer viewer;
+			queue.Sort(&viewer);
+			merged.Sort(&viewer);
+
+			THEN("The sorted commands reference the same data as with a single queue")
+			{
+				const auto& expected = queue.commandList.commands;
+				const auto& commands = merged.commandList.commands;
+				REQUIRE(commands.size() == expected.size());
+				REQUIRE(merged.commandList.billboards.size() == 8);
+
+				bool identical = true;
+				for (std::size_t i = 0; i < commands.size(); ++i)
+				{
+					if (commands[i].sortKey != expected[i].sortKey)
+						identical = false;
+					else if (Nz::ForwardRenderQueue::GetCommandType(commands[i].sortKey) == Nz::ForwardRenderQueue::CommandType_OpaqueModel)
+					{
+						Nz::Vector3f position = merged.commandList.models[commands[i].index].transformMatrix.GetTranslation();
+						Nz::Vector3f expectedPosition = queue.commandList.models[expected[i].index].transformMatrix.GetTranslation();
+						if (position != expectedPosition)
+							identical = false;
+					}
+					else
+					{
+						const auto& data = merged.commandList.billboardCommands[commands[i].index];
+						const auto& expectedData = queue.commandList.billboardCommands[expected[i].index];
+						if (merged.commandList.billboards[data.firstBillboard].center != queue.commandList.billboards[expectedData.firstBillboard].center)
+							identical = false;
+					}
+				}
+
+				CHECK(identical);
+			}
+		}
+	}
+
+	GIVEN("Sprites sampling different layers of a texture array through the same material")
+	{
+		Nz::ForwardRenderQueue queue;
+
+		Nz::MaterialRef material = Nz::Material::New();
+
+		Nz::VertexStruct_XYZ_Color_UV vertices[3 * 4];
+		for (unsigned int i = 0; i < 3; ++i)
+			queue.AddSprites(0, material, &vertices[i * 4], 1, nullptr, i * 2);
+
+		WHEN("We look at their batch")
+		{
+			const auto& overlayMap = queue.layers[0].basicSprites[material].overlayMap;
+
+			THEN("They are gathered in a single batch, each chain keeping its layer")
+			{
+				REQUIRE(overlayMap.size() == 1);
+
+				const auto& spriteChains = overlayMap.begin()->second.spriteChains;
+				REQUIRE(spriteChains.size() == 3);
+				CHECK(spriteChains[0].textureLayer == 0);
+				CHECK(spriteChains[1].textureLayer == 2);
+				CHECK(spriteChains[2].textureLayer == 4);
+			}
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include <Nazara/Graphics/Light.hpp>
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
 #include <Catch/catch.hpp>
 
 SCENARIO("Light", "[GRAPHICS][LIGHT]")
@@ -28,4 +29,90 @@ SCENARIO("Light", "[GRAPHICS][LIGHT]")
 			}
 		}
 	}
+
+	GIVEN("A view split between four shadow cascades")
+	{
+		float splits[4];
+
+		WHEN("We use the uniform scheme")
+		{
+			Nz::Light::ComputeShadowCascadeSplits(1.f, 1001.f, 4, 0.f, splits);
+
+			THEN("The cascades have the same depth")
+			{
+				CHECK(splits[0] == Approx(251.f));
+				CHECK(splits[1] == Approx(501.f));
+				CHECK(splits[2] == Approx(751.f));
+				CHECK(splits[3] == Approx(1001.f));
+			}
+		}
+
+		WHEN("We use the logarithmic scheme")
+		{
+			Nz::Light::ComputeShadowCascadeSplits(1.f, 10000.f, 4, 1.f, splits);
+
+			THEN("Each cascade is ten times deeper than the previous one")
+			{
+				CHECK(splits[0] == Approx(10.f));
+				CHECK(splits[1] == Approx(100.f));
+				CHECK(splits[2] == Approx(1000.f));
+				CHECK(splits[3] == Approx(10000.f));
+			}
+		}
+
+		WHEN("We blend both schemes")
+		{
+			Nz::Light::ComputeShadowCascadeSplits(0.1f, 500.f, 4, 0.75f, splits);
+
+			THEN("Splits are increasing and the last one is the far plane")
+			{
+				CHECK(splits[0] > 0.1f);
+				CHECK(splits[0] < splits[1]);
+				CHECK(splits[1] < splits[2]);
+				CHECK(splits[2] < splits[3]);
+				CHECK(splits[3] == Approx(500.f));
+			}
+		}
+	}
+
+	GIVEN("A spot light casting shadows in a region of an atlas")
+	{
+		Nz::TextureRef atlas = Nz::Texture::New();
+		REQUIRE(atlas->Create(Nz::ImageType_2D, Nz::PixelFormatType_Depth16, 1024, 1024));
+
+		Nz::Light spotLight(Nz::LightType_Spot);
+		spotLight.EnableShadowCasting(true);
+		spotLight.SetShadowMapAtlas(atlas, Nz::Rectui(256, 512, 256, 256));
+
+		WHEN("We add it to a render queue")
+		{
+			Nz::ForwardRenderQueue queue;
+			spotLight.AddToRenderQueue(&queue, Nz::Matrix4f::Identity());
+
+			THEN("Its shadow map is the atlas, sampled in its region")
+			{
+				CHECK(spotLight.IsShadowMapAtlased());
+				CHECK(spotLight.GetShadowMap().Get() == atlas.Get());
+
+				REQUIRE(queue.spotLights.size() == 1);
+				CHECK(queue.spotLights[0].shadowMap == atlas.Get());
+
+				Nz::Vector4f texCoords = queue.spotLights[0].transformMatrix.Transform(Nz::Vector4f(Nz::Vector3f::Forward() * 10.f, 1.f));
+				CHECK(texCoords.x / texCoords.w == Approx(0.375f));
+				CHECK(texCoords.y / texCoords.w == Approx(0.625f));
+			}
+		}
+
+		WHEN("We give it its own shadow map back")
+		{
+			spotLight.ClearShadowMapAtlas();
+
+			THEN("The shadow map covers its whole texture")
+			{
+				CHECK_FALSE(spotLight.IsShadowMapAtlased());
+				CHECK(spotLight.GetShadowMap().Get() != atlas.Get());
+				CHECK(spotLight.GetShadowMapRegion() == Nz::Rectui(0, 0, 512, 512));
+			}
+		}
+	}
 }
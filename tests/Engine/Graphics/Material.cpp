@@ -0,0 +1,48 @@
+#include <Nazara/Graphics/Material.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("Material", "[GRAPHICS][MATERIAL]")
+{
+	GIVEN("Two default materials")
+	{
+		Nz::MaterialRef first = Nz::Material::New();
+		Nz::MaterialRef second = Nz::Material::New();
+
+		THEN("They share the same sort key")
+		{
+			CHECK(first->GetSortKey() == second->GetSortKey());
+		}
+
+		WHEN("We only change the parameters of one of them")
+		{
+			second->SetDiffuseColor(Nz::Color::Red);
+			second->SetShininess(10.f);
+
+			THEN("Their sort keys are still the same")
+			{
+				CHECK(first->GetSortKey() == second->GetSortKey());
+			}
+		}
+
+		WHEN("We enable blending on one of them")
+		{
+			Nz::UInt32 pipelineKey = first->GetSortKey() >> 20;
+
+			second->Enable(Nz::RendererParameter_Blend, true);
+			second->SetDstBlend(Nz::BlendFunc_InvSrcAlpha);
+			second->SetSrcBlend(Nz::BlendFunc_SrcAlpha);
+
+			THEN("Only the render states part of the key is modified")
+			{
+				CHECK(first->GetSortKey() != second->GetSortKey());
+				CHECK(second->GetSortKey() >> 20 == pipelineKey);
+			}
+
+			AND_THEN("A copy of it has the same key")
+			{
+				Nz::MaterialRef copy = Nz::Material::New(*second);
+				CHECK(copy->GetSortKey() == second->GetSortKey());
+			}
+		}
+	}
+}
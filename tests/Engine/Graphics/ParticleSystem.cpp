@@ -2,7 +2,10 @@
 #include <Catch/catch.hpp>
 
 #include <Nazara/Core/SparsePtr.hpp>
+#include <Nazara/Graphics/ParticleGpuSimulator.hpp>
 #include <Nazara/Graphics/ParticleMapper.hpp>
+#include <Nazara/Utility/Image.hpp>
+#include <cmath>
 
 class TestParticleController : public Nz::ParticleController
 {
@@ -27,6 +30,15 @@ class TestParticleController : public Nz::ParticleController
 		}
 };
 
+class TestParallelParticleController : public TestParticleController
+{
+	public:
+		bool IsParallelizable() const override
+		{
+			return true;
+		}
+};
+
 class TestParticleEmitter : public Nz::ParticleEmitter
 {
 	public:
@@ -100,4 +112,137 @@ SCENARIO("ParticleSystem", "[GRAPHICS][PARTICLESYSTEM]")
 			}
 		}
 	}
+
+	GIVEN("A particle system storing each component separately, with a parallelizable controller")
+	{
+		TestParallelParticleController particleController;
+		TestParticleGenerator particleGenerator;
+		Nz::ParticleSystem particleSystem(5000, Nz::ParticleLayout_Billboard, Nz::ParticleStorage_Separate);
+
+		particleSystem.AddController(&particleController);
+		particleSystem.AddGenerator(&particleGenerator);
+
+		WHEN("We generate particles")
+		{
+			REQUIRE(particleSystem.GenerateParticles(3000) != nullptr);
+
+			Nz::ParticleMapper mapper = particleSystem.GetParticleMapper();
+			Nz::SparsePtr<Nz::Vector3f> velocityPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Velocity);
+			Nz::SparsePtr<float> lifePtr = mapper.GetComponentPtr<float>(Nz::ParticleComponent_Life);
+
+			THEN("Each component is contiguous")
+			{
+				CHECK(velocityPtr.GetStride() == static_cast<int>(sizeof(Nz::Vector3f)));
+				CHECK(lifePtr.GetStride() == static_cast<int>(sizeof(float)));
+				CHECK(lifePtr[2999] == Approx(1.3f));
+				CHECK(velocityPtr[2999] == Nz::Vector3f::UnitX());
+			}
+
+			AND_WHEN("Half of them die")
+			{
+				for (unsigned int i = 0; i < 3000; i += 2)
+					lifePtr[i] = 0.5f;
+
+				particleSystem.Update(1.f);
+
+				THEN("The survivors keep their components")
+				{
+					REQUIRE(particleSystem.GetParticleCount() == 1500);
+
+					bool intact = true;
+					for (unsigned int i = 0; i < 1500; ++i)
+					{
+						if (std::abs(lifePtr[i] - 0.3f) > 0.001f || velocityPtr[i] != Nz::Vector3f::UnitX())
+							intact = false;
+					}
+
+					CHECK(intact);
+				}
+			}
+		}
+	}
+
+	GIVEN("A particle system with simulation LOD")
+	{
+		TestParticleController particleController;
+		TestParticleGenerator particleGenerator;
+		Nz::ParticleSystem particleSystem(10, Nz::ParticleLayout_Billboard);
+
+		particleSystem.AddController(&particleController);
+		TestParticleEmitter particleEmitter;
+		particleEmitter.SetEmissionCount(10);
+		particleSystem.AddEmitter(&particleEmitter);
+
+		particleSystem.AddGenerator(&particleGenerator);
+		particleSystem.EnableSimulationLOD(true);
+
+		WHEN("We update it before it was ever rendered")
+		{
+			particleSystem.Update(0.1f);
+
+			THEN("It is simulated and bounded by its particles")
+			{
+				CHECK(particleSystem.GetParticleCount() == 10);
+				CHECK(particleSystem.GetProjectedSize() < 0.f);
+
+				particleSystem.EnsureBoundingVolumeUpdated();
+				const Nz::BoundingVolumef& boundingVolume = particleSystem.GetBoundingVolume();
+				REQUIRE(boundingVolume.IsFinite());
+				CHECK(boundingVolume.aabb == Nz::Boxf(-1.f, -1.f, -1.f, 2.f, 2.f, 2.f));
+			}
+
+			AND_WHEN("It is culled for longer than its particles live")
+			{
+				particleSystem.Update(2.f);
+
+				THEN("Its simulation is frozen")
+				{
+					CHECK(particleSystem.GetParticleCount() == 10);
+				}
+			}
+
+			AND_WHEN("The simulation LOD is disabled")
+			{
+				particleSystem.EnableSimulationLOD(false);
+				particleSystem.Update(2.f);
+
+				THEN("The particles die as usual")
+				{
+					CHECK(particleSystem.GetParticleCount() == 0);
+				}
+			}
+		}
+	}
+
+	GIVEN("A particle system simulated by the GPU")
+	{
+		TestParticleGenerator particleGenerator;
+		Nz::ParticleSystem particleSystem(100, Nz::ParticleLayout_Billboard);
+		particleSystem.AddGenerator(&particleGenerator);
+
+		particleSystem.EnableGpuSimulation(true);
+		REQUIRE(particleSystem.GetGpuSimulator() != nullptr);
+		particleSystem.GetGpuSimulator()->SetGravity(Nz::Vector3f(0.f, -1.f, 0.f));
+
+		WHEN("We generate particles and update it")
+		{
+			particleSystem.GenerateParticles(10);
+			particleSystem.Update(0.5f);
+
+			THEN("The particles were handed over to the GPU, which moved them")
+			{
+				CHECK(particleSystem.GetParticleCount() == 0);
+				CHECK(particleSystem.GetGpuSimulator()->GetUsedParticleCount() == 10);
+
+				Nz::Image states;
+				REQUIRE(particleSystem.GetGpuSimulator()->GetStateTexture(0)->Download(&states));
+
+				// The velocity is updated before the position
+				const float* state = reinterpret_cast<const float*>(states.GetConstPixels());
+				CHECK(state[0] == Approx(0.5f));
+				CHECK(state[1] == Approx(-0.25f));
+				CHECK(state[2] == Approx(0.f));
+			}
+		}
+	}
 }
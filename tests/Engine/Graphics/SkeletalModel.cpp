@@ -1,5 +1,7 @@
 #include <Nazara/Graphics/SkeletalModel.hpp>
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
 #include <Catch/catch.hpp>
+#include "TestViewer.hpp"
 
 SCENARIO("SkeletalModel", "[GRAPHICS][SKELETALMODEL]")
 {
@@ -23,4 +25,66 @@ SCENARIO("SkeletalModel", "[GRAPHICS][SKELETALMODEL]")
 			}
 		}
 	}
+
+	GIVEN("Two animated bob lamps with animation LOD, far from the viewer")
+	{
+		Nz::AnimationRef animation = Nz::Animation::New();
+		REQUIRE(animation->LoadFromFile("resources/Engine/Graphics/Bob lamp/bob_lamp_update.md5anim"));
+
+		Nz::SkeletalModel first;
+		REQUIRE(first.LoadFromFile("resources/Engine/Graphics/Bob lamp/bob_lamp_update.md5mesh"));
+		first.SetAnimation(animation);
+		first.EnableAnimationLOD(true);
+
+		Nz::SkeletalModel second(first);
+
+		Nz::Matrix4f transformMatrix = Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * 900.f);
+		Nz::InstancedRenderable::InstanceData instanceData(transformMatrix);
+		instanceData.renderOrder = 0;
+
+		TestViewer viewer;
+		Nz::ForwardRenderQueue queue;
+		queue.SetViewer(&viewer);
+
+		WHEN("They are not rendered")
+		{
+			first.AdvanceAnimation(0.5f);
+			Nz::Vector3f position = first.GetSkeleton()->GetJoint(0u)->GetPosition();
+
+			first.AdvanceAnimation(0.5f);
+
+			THEN("Their pose is kept")
+			{
+				CHECK(first.GetProjectedSize() < 0.f);
+				CHECK(first.GetSkeleton()->GetJoint(0u)->GetPosition() == position);
+			}
+		}
+
+		WHEN("They are rendered small enough")
+		{
+			first.AddToRenderQueue(&queue, instanceData);
+			second.AddToRenderQueue(&queue, instanceData);
+
+			CHECK(first.GetProjectedSize() < first.GetAnimationLOD().sharedPoseSize);
+
+			first.AdvanceAnimation(0.5f);
+			second.AdvanceAnimation(0.5f);
+
+			THEN("They share the pose of their animation frame")
+			{
+				CHECK(first.IsPoseShared());
+				CHECK(second.IsPoseShared());
+			}
+
+			AND_WHEN("Animation LOD is disabled")
+			{
+				first.EnableAnimationLOD(false);
+
+				THEN("The model uses its own skeleton again")
+				{
+					CHECK_FALSE(first.IsPoseShared());
+				}
+			}
+		}
+	}
 }
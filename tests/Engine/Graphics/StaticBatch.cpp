@@ -0,0 +1,74 @@
+#include <Nazara/Graphics/StaticBatch.hpp>
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("StaticBatch", "[GRAPHICS][STATICBATCH]")
+{
+	GIVEN("A batch of three sprites, two of them sharing a material")
+	{
+		Nz::MaterialRef sharedMaterial = Nz::Material::New();
+		Nz::MaterialRef otherMaterial = Nz::Material::New();
+
+		Nz::SpriteRef first = Nz::Sprite::New(sharedMaterial);
+		Nz::SpriteRef second = Nz::Sprite::New(sharedMaterial);
+		Nz::SpriteRef third = Nz::Sprite::New(otherMaterial);
+		second->SetColor(Nz::Color::Red);
+
+		Nz::StaticBatchRef batch = Nz::StaticBatch::New();
+		batch->AddSprite(first);
+		batch->AddSprite(second, Nz::Matrix4f::Translate(Nz::Vector3f::Right() * 100.f));
+		batch->AddSprite(third);
+
+		Nz::Matrix4f transformMatrix = Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * 10.f);
+		Nz::InstancedRenderable::InstanceData instanceData(transformMatrix);
+		instanceData.renderOrder = 0;
+
+		const Nz::InstancedRenderable& renderable = *batch;
+		renderable.UpdateData(&instanceData);
+
+		Nz::ForwardRenderQueue queue;
+		queue.EnableCommandList(true);
+
+		WHEN("We add it to a render queue")
+		{
+			renderable.AddToRenderQueue(&queue, instanceData);
+
+			THEN("The sprites sharing a material are queued together, in the batch space")
+			{
+				CHECK(batch->GetBatchCount() == 2);
+				REQUIRE(queue.commandList.sprites.size() == 2);
+
+				const auto& chain = queue.commandList.sprites.front().spriteChain;
+				REQUIRE(chain.spriteCount == 2);
+				CHECK(chain.vertices[4].color == Nz::Color::Red);
+				CHECK(chain.vertices[4].position == transformMatrix.Transform(Nz::Vector3f::Right() * 100.f));
+			}
+		}
+
+		WHEN("A member changes its material")
+		{
+			third->SetMaterial(sharedMaterial, false);
+			renderable.UpdateData(&instanceData);
+			renderable.AddToRenderQueue(&queue, instanceData);
+
+			THEN("The batch is rebuilt")
+			{
+				CHECK(batch->GetBatchCount() == 1);
+				REQUIRE(queue.commandList.sprites.size() == 1);
+				CHECK(queue.commandList.sprites.front().spriteChain.spriteCount == 3);
+			}
+		}
+
+		WHEN("A member is removed")
+		{
+			CHECK(batch->RemoveSprite(third));
+			CHECK_FALSE(batch->RemoveSprite(third));
+
+			THEN("Its batch disappears")
+			{
+				CHECK(batch->GetSpriteCount() == 2);
+				CHECK(batch->GetBatchCount() == 1);
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef NAZARA_UNITTESTS_GRAPHICS_TESTVIEWER_HPP
+#define NAZARA_UNITTESTS_GRAPHICS_TESTVIEWER_HPP
+
+#include <Nazara/Graphics/AbstractViewer.hpp>
+#include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Rect.hpp>
+#include <Nazara/Math/Vector3.hpp>
+
+// Viewer without render target, looking forward from the origin, shared by the tests of the renderables and render queues
+class TestViewer : public Nz::AbstractViewer
+{
+	public:
+		TestViewer() :
+		m_viewport(0, 0, 800, 600),
+		m_eyePosition(Nz::Vector3f::Zero())
+		{
+			m_frustum.Build(70.f, 4.f / 3.f, 1.f, 1000.f, m_eyePosition, Nz::Vector3f::Forward());
+			m_projectionMatrix.MakePerspective(70.f, 4.f / 3.f, 1.f, 1000.f);
+			m_viewMatrix.MakeLookAt(m_eyePosition, Nz::Vector3f::Forward());
+		}
+
+		void ApplyView() const override {}
+		float GetAspectRatio() const override { return 4.f / 3.f; }
+		Nz::Vector3f GetEyePosition() const override { return m_eyePosition; }
+		Nz::Vector3f GetForward() const override { return Nz::Vector3f::Forward(); }
+		const Nz::Frustumf& GetFrustum() const override { return m_frustum; }
+		const Nz::Matrix4f& GetProjectionMatrix() const override { return m_projectionMatrix; }
+		const Nz::RenderTarget* GetTarget() const override { return nullptr; }
+		const Nz::Matrix4f& GetViewMatrix() const override { return m_viewMatrix; }
+		const Nz::Recti& GetViewport() const override { return m_viewport; }
+		float GetZFar() const override { return 1000.f; }
+		float GetZNear() const override { return 1.f; }
+
+	private:
+		Nz::Frustumf m_frustum;
+		Nz::Matrix4f m_projectionMatrix;
+		Nz::Matrix4f m_viewMatrix;
+		Nz::Recti m_viewport;
+		Nz::Vector3f m_eyePosition;
+};
+
+#endif // NAZARA_UNITTESTS_GRAPHICS_TESTVIEWER_HPP
@@ -0,0 +1,80 @@
+#include <Nazara/Graphics/TileMap.hpp>
+#include <Nazara/Graphics/ForwardRenderQueue.hpp>
+#include <Catch/catch.hpp>
+#include "TestViewer.hpp"
+
+namespace
+{
+	unsigned int CountSprites(const Nz::ForwardRenderQueue& queue)
+	{
+		unsigned int spriteCount = 0;
+		for (const auto& sprites : queue.commandList.sprites)
+			spriteCount += sprites.spriteChain.spriteCount;
+
+		return spriteCount;
+	}
+}
+
+SCENARIO("TileMap", "[GRAPHICS][TILEMAP]")
+{
+	GIVEN("A 64x64 tilemap with every tile enabled, in front of a viewer")
+	{
+		Nz::TileMapRef tileMap = Nz::TileMap::New(Nz::Vector2ui(64, 64), Nz::Vector2f(1.f, 1.f));
+		tileMap->EnableTiles(Nz::Rectf(0.f, 0.f, 1.f, 1.f));
+
+		Nz::Matrix4f transformMatrix = Nz::Matrix4f::Translate(Nz::Vector3f::Forward() * 10.f);
+		Nz::InstancedRenderable::InstanceData instanceData(transformMatrix);
+		instanceData.renderOrder = 0;
+
+		const Nz::InstancedRenderable& renderable = *tileMap;
+		renderable.UpdateData(&instanceData);
+
+		Nz::ForwardRenderQueue queue;
+		queue.EnableCommandList(true);
+
+		WHEN("We add it to a render queue without viewer")
+		{
+			renderable.AddToRenderQueue(&queue, instanceData);
+
+			THEN("Every chunk is queued")
+			{
+				CHECK(queue.commandList.sprites.size() == 16);
+				CHECK(CountSprites(queue) == 64 * 64);
+			}
+		}
+
+		WHEN("We add it to a render queue seen by the viewer")
+		{
+			TestViewer viewer;
+			queue.SetViewer(&viewer);
+			renderable.AddToRenderQueue(&queue, instanceData);
+
+			THEN("Only the chunk in the frustum is queued")
+			{
+				REQUIRE(queue.commandList.sprites.size() == 1);
+				CHECK(CountSprites(queue) == 16 * 16);
+				CHECK(queue.GetStats().culledObjectCount == 15);
+			}
+		}
+
+		WHEN("We disable a tile and update the instance")
+		{
+			tileMap->DisableTile(Nz::Vector2ui(0, 0));
+			tileMap->EnableTile(Nz::Vector2ui(63, 63), Nz::Rectf(0.f, 0.f, 0.5f, 0.5f), Nz::Color::Red);
+			renderable.UpdateData(&instanceData);
+			renderable.AddToRenderQueue(&queue, instanceData);
+
+			THEN("The modified chunks are rebuilt")
+			{
+				REQUIRE(queue.commandList.sprites.size() == 16);
+				CHECK(queue.commandList.sprites.front().spriteChain.spriteCount == 16 * 16 - 1);
+				CHECK(CountSprites(queue) == 64 * 64 - 1);
+
+				const auto& lastChain = queue.commandList.sprites.back().spriteChain;
+				const Nz::VertexStruct_XYZ_Color_UV& lastVertex = lastChain.vertices[4 * lastChain.spriteCount - 1];
+				CHECK(lastVertex.color == Nz::Color::Red);
+				CHECK(lastVertex.position == transformMatrix.Transform(Nz::Vector3f(64.f, -64.f, 0.f)));
+			}
+		}
+	}
+}
@@ -1,6 +1,15 @@
 #include <Nazara/Math/BoundingVolume.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
 #include <Catch/catch.hpp>
 
+namespace
+{
+	bool ApproxEquals(const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+	{
+		return lhs.x == Approx(rhs.x) && lhs.y == Approx(rhs.y) && lhs.z == Approx(rhs.z);
+	}
+}
+
 SCENARIO("BoundingVolume", "[MATH][BOUNDINGVOLUME]")
 {
 	GIVEN("With a null bounding volume and an infinite")
@@ -100,6 +109,42 @@ SCENARIO("BoundingVolume", "[MATH][BOUNDINGVOLUME]")
 			}
 		}
 
+		WHEN("We rotate, scale and move one")
+		{
+			Nz::BoundingVolumef volume(1.f, -2.f, 0.5f, 2.f, 3.f, 4.f);
+			Nz::Matrix4f transformMatrix = Nz::Matrix4f::Transform(Nz::Vector3f(5.f, -1.f, 2.f), Nz::EulerAnglesf(30.f, 45.f, -60.f), Nz::Vector3f(1.f, 2.f, 0.5f));
+			volume.Update(transformMatrix);
+
+			THEN("The aabb bounds the corners of the obb")
+			{
+				Nz::Boxf cornerBox(volume.obb(0), volume.obb(1));
+				for (unsigned int i = 2; i <= Nz::BoxCorner_Max; ++i)
+					cornerBox.ExtendTo(volume.obb(i));
+
+				CHECK(ApproxEquals(volume.aabb.GetMinimum(), cornerBox.GetMinimum()));
+				CHECK(ApproxEquals(volume.aabb.GetMaximum(), cornerBox.GetMaximum()));
+
+				for (unsigned int i = 0; i <= Nz::BoxCorner_Max; ++i)
+					CHECK(ApproxEquals(volume.obb(i), transformMatrix.Transform(volume.obb.localBox.GetCorner(static_cast<Nz::BoxCorner>(i)))));
+			}
+
+			AND_WHEN("We transform its local box as a batch")
+			{
+				Nz::Vector3f localCenter = volume.obb.localBox.GetCenter();
+				Nz::Vector3f localExtents = volume.obb.localBox.GetLengths() / 2.f;
+
+				float center[3];
+				float extents[3];
+				Nz::BoundingVolumef::TransformBoxes(&localCenter.x, &localCenter.y, &localCenter.z, &localExtents.x, &localExtents.y, &localExtents.z, &transformMatrix, 1, &center[0], &center[1], &center[2], &extents[0], &extents[1], &extents[2]);
+
+				THEN("We get the same aabb")
+				{
+					CHECK(ApproxEquals(Nz::Vector3f(center), volume.aabb.GetCenter()));
+					CHECK(ApproxEquals(Nz::Vector3f(extents) * 2.f, volume.aabb.GetLengths()));
+				}
+			}
+		}
+
 		WHEN("We try to lerp")
 		{
 			THEN("Compilation should be fine")
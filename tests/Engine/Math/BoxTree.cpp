@@ -0,0 +1,150 @@
+#include <Nazara/Math/BoxTree.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+SCENARIO("BoxTree", "[MATH][BOXTREE]")
+{
+	GIVEN("A tree of boxes along a grid")
+	{
+		Nz::BoxTreef tree;
+
+		std::vector<Nz::Boxf> boxes;
+		std::vector<std::size_t> proxies;
+		for (unsigned int i = 0; i < 1000; ++i)
+		{
+			boxes.emplace_back(float(i % 10) * 10.f, float((i / 10) % 10) * 10.f, float(i / 100) * 10.f, 1.f, 1.f, 1.f);
+			proxies.push_back(tree.Insert(boxes.back(), i));
+		}
+
+		auto QueryAll = [&](const auto& volume)
+		{
+			std::vector<std::size_t> result;
+			tree.Query(volume, [&](std::size_t userData) { result.push_back(userData); });
+			std::sort(result.begin(), result.end());
+
+			return result;
+		};
+
+		THEN("It stays balanced")
+		{
+			CHECK(tree.GetProxyCount() == 1000);
+			CHECK(tree.GetHeight() < 20);
+			CHECK(tree.GetBounds().Contains(Nz::Boxf(0.f, 0.f, 0.f, 91.f, 91.f, 91.f)));
+		}
+
+		WHEN("We query the boxes inside of a volume")
+		{
+			THEN("We get the same boxes as by testing all of them")
+			{
+				Nz::Boxf box(15.f, 15.f, 15.f, 30.f, 30.f, 30.f);
+				Nz::Spheref sphere(50.f, 50.f, 50.f, 25.f);
+				Nz::Frustumf frustum;
+				frustum.Build(Nz::FromDegrees(60.f), 1.f, 1.f, 60.f, Nz::Vector3f(-10.f, 45.f, 45.f), Nz::Vector3f(50.f, 45.f, 45.f));
+
+				std::vector<std::size_t> expectedBox;
+				std::vector<std::size_t> expectedFrustum;
+				std::vector<std::size_t> expectedSphere;
+				for (std::size_t i = 0; i < boxes.size(); ++i)
+				{
+					if (box.Intersect(boxes[i]))
+						expectedBox.push_back(i);
+
+					if (frustum.Intersect(boxes[i]) != Nz::IntersectionSide_Outside)
+						expectedFrustum.push_back(i);
+
+					if (sphere.Intersect(boxes[i]))
+						expectedSphere.push_back(i);
+				}
+
+				// The margin may only add a few boxes near the edges
+				std::vector<std::size_t> resultBox = QueryAll(box);
+				std::vector<std::size_t> resultFrustum = QueryAll(frustum);
+				std::vector<std::size_t> resultSphere = QueryAll(sphere);
+
+				CHECK(!expectedBox.empty());
+				CHECK(!expectedFrustum.empty());
+				CHECK(!expectedSphere.empty());
+				CHECK(std::includes(resultBox.begin(), resultBox.end(), expectedBox.begin(), expectedBox.end()));
+				CHECK(std::includes(resultFrustum.begin(), resultFrustum.end(), expectedFrustum.begin(), expectedFrustum.end()));
+				CHECK(std::includes(resultSphere.begin(), resultSphere.end(), expectedSphere.begin(), expectedSphere.end()));
+				CHECK(resultFrustum.size() < boxes.size() / 2);
+			}
+		}
+
+		WHEN("We move the boxes a little")
+		{
+			THEN("They stay in their enlarged box")
+			{
+				for (std::size_t i = 0; i < proxies.size(); ++i)
+				{
+					Nz::Boxf box = boxes[i];
+					box.x += 0.05f;
+
+					CHECK(!tree.Move(proxies[i], box));
+				}
+			}
+		}
+
+		WHEN("We move and remove boxes randomly")
+		{
+			std::mt19937 randomGenerator(42);
+			std::uniform_real_distribution<float> positionDistribution(0.f, 100.f);
+
+			for (std::size_t i = 0; i < proxies.size(); ++i)
+			{
+				if (i % 3 == 0)
+				{
+					tree.Remove(proxies[i]);
+					proxies[i] = Nz::BoxTreef::InvalidProxy;
+				}
+				else
+				{
+					boxes[i].Set(positionDistribution(randomGenerator), positionDistribution(randomGenerator), positionDistribution(randomGenerator), 1.f, 1.f, 1.f);
+					CHECK(tree.Move(proxies[i], boxes[i]));
+				}
+			}
+
+			THEN("Queries only find the remaining boxes at their new position")
+			{
+				CHECK(tree.GetProxyCount() == 666);
+				CHECK(tree.GetHeight() < 20);
+
+				Nz::Boxf box(25.f, 25.f, 25.f, 50.f, 50.f, 50.f);
+				std::vector<std::size_t> result = QueryAll(box);
+
+				std::vector<std::size_t> expected;
+				for (std::size_t i = 0; i < boxes.size(); ++i)
+				{
+					if (proxies[i] != Nz::BoxTreef::InvalidProxy && box.Intersect(boxes[i]))
+						expected.push_back(i);
+				}
+
+				CHECK(std::includes(result.begin(), result.end(), expected.begin(), expected.end()));
+				for (std::size_t userData : result)
+					CHECK(proxies[userData] != Nz::BoxTreef::InvalidProxy);
+			}
+
+			AND_THEN("We can insert new boxes")
+			{
+				std::size_t proxy = tree.Insert(Nz::Boxf(0.f, 0.f, 0.f, 1.f, 1.f, 1.f), 1000);
+				CHECK(tree.GetProxyCount() == 667);
+				CHECK(tree.GetUserData(proxy) == 1000);
+			}
+		}
+
+		WHEN("We clear it")
+		{
+			tree.Clear();
+
+			THEN("It is empty")
+			{
+				CHECK(tree.IsEmpty());
+				CHECK(tree.GetProxyCount() == 0);
+				CHECK(QueryAll(Nz::Boxf(0.f, 0.f, 0.f, 100.f, 100.f, 100.f)).empty());
+			}
+		}
+	}
+}
@@ -1,6 +1,9 @@
 #include <Nazara/Math/Frustum.hpp>
 #include <Catch/catch.hpp>
 
+#include <random>
+#include <vector>
+
 SCENARIO("Frustum", "[MATH][FRUSTUM]")
 {
 	GIVEN("One frustum (90, 1, 1, 1000, (0, 0, 0), (1, 0, 0))")
@@ -79,6 +82,86 @@ SCENARIO("Frustum", "[MATH][FRUSTUM]")
 			}
 		}
 
+		WHEN("We cull a set of boxes and spheres at once")
+		{
+			const std::size_t count = 103; // Not a multiple of the SIMD width and more than one block
+			std::mt19937 randomEngine(42);
+			std::uniform_real_distribution<float> xDistribution(-200.f, 1200.f);
+			std::uniform_real_distribution<float> yzDistribution(-600.f, 600.f);
+			std::uniform_real_distribution<float> sizeDistribution(0.5f, 50.f);
+
+			std::vector<float> centerX(count), centerY(count), centerZ(count);
+			std::vector<float> extentX(count), extentY(count), extentZ(count);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				centerX[i] = xDistribution(randomEngine);
+				centerY[i] = yzDistribution(randomEngine);
+				centerZ[i] = yzDistribution(randomEngine);
+				extentX[i] = sizeDistribution(randomEngine);
+				extentY[i] = sizeDistribution(randomEngine);
+				extentZ[i] = sizeDistribution(randomEngine);
+			}
+
+			auto GetBox = [&](std::size_t i)
+			{
+				return Nz::Boxf(centerX[i] - extentX[i], centerY[i] - extentY[i], centerZ[i] - extentZ[i], extentX[i] * 2.f, extentY[i] * 2.f, extentZ[i] * 2.f);
+			};
+
+			THEN("The boxes are culled as with Contains")
+			{
+				std::vector<Nz::UInt8> planeCache(count, 0xFF);
+				Nz::Bitset<Nz::UInt64> visibility;
+
+				// The second pass uses the planes stored by the first one
+				for (unsigned int pass = 0; pass < 2; ++pass)
+				{
+					frustum.CullBoxes(centerX.data(), centerY.data(), centerZ.data(), extentX.data(), extentY.data(), extentZ.data(), count, &visibility, planeCache.data());
+					REQUIRE(visibility.GetSize() == count);
+
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						INFO("Box #" << i << " (pass #" << pass << ')');
+						CHECK(visibility.Test(i) == frustum.Contains(GetBox(i)));
+					}
+				}
+
+				CHECK(visibility.Count() > 0);
+				CHECK(visibility.Count() < count);
+			}
+
+			THEN("The spheres are culled as with Contains")
+			{
+				Nz::Bitset<Nz::UInt64> visibility;
+				frustum.CullSpheres(centerX.data(), centerY.data(), centerZ.data(), extentX.data(), count, &visibility);
+				REQUIRE(visibility.GetSize() == count);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					INFO("Sphere #" << i);
+					CHECK(visibility.Test(i) == frustum.Contains(Nz::Spheref(centerX[i], centerY[i], centerZ[i], extentX[i])));
+				}
+			}
+
+			THEN("The generic implementation gives the same results")
+			{
+				Nz::Frustumd frustumd;
+				frustumd.Build(Nz::FromDegrees(90.0), 1.0, 1.0, 1000.0, Nz::Vector3d::Zero(), Nz::Vector3d::UnitX());
+
+				std::vector<double> centerXd(centerX.begin(), centerX.end()), centerYd(centerY.begin(), centerY.end()), centerZd(centerZ.begin(), centerZ.end());
+				std::vector<double> extentXd(extentX.begin(), extentX.end()), extentYd(extentY.begin(), extentY.end()), extentZd(extentZ.begin(), extentZ.end());
+
+				Nz::Bitset<Nz::UInt64> visibility;
+				frustumd.CullBoxes(centerXd.data(), centerYd.data(), centerZd.data(), extentXd.data(), extentYd.data(), extentZd.data(), count, &visibility);
+				REQUIRE(visibility.GetSize() == count);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					INFO("Box #" << i);
+					CHECK(visibility.Test(i) == frustumd.Contains(Nz::Boxd(GetBox(i))));
+				}
+			}
+		}
+
 		WHEN("We test for edge cases")
 		{
 			THEN("Implementation defined these")
@@ -1,5 +1,6 @@
 #include <Nazara/Math/Matrix4.hpp>
 #include <Catch/catch.hpp>
+#include <random>
 
 SCENARIO("Matrix4", "[MATH][Matrix4]")
 {
@@ -16,6 +17,17 @@ SCENARIO("Matrix4", "[MATH][Matrix4]")
 			}
 		}
 
+		WHEN("We build one at compile time")
+		{
+			constexpr Nz::Matrix4f identity = Nz::Matrix4f::Identity();
+
+			THEN("It is the identity matrix")
+			{
+				static_assert(identity.m11 == 1.f && identity.m12 == 0.f && identity.m44 == 1.f, "Identity should be computed at compile time");
+				REQUIRE(identity == secondIdentity);
+			}
+		}
+
 		WHEN("We multiply the first with a Nz::Vector")
 		{
 			THEN("Nz::Vector stay the same")
@@ -141,4 +153,87 @@ SCENARIO("Matrix4", "[MATH][Matrix4]")
 			}
 		}
 	}
+
+	GIVEN("Random float matrices")
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+		auto RandomMatrix = [&](bool affine)
+		{
+			Nz::Matrix4f matrix;
+			for (unsigned int i = 0; i < 16; ++i)
+				static_cast<float*>(matrix)[i] = distribution(randomEngine);
+
+			if (affine)
+			{
+				matrix.m14 = 0.f;
+				matrix.m24 = 0.f;
+				matrix.m34 = 0.f;
+				matrix.m44 = 1.f;
+			}
+
+			return matrix;
+		};
+
+		auto CheckNear = [](const Nz::Matrix4f& matrix, const Nz::Matrix4d& reference)
+		{
+			for (unsigned int i = 0; i < 16; ++i)
+				CHECK(static_cast<const float*>(matrix)[i] == Approx(static_cast<const double*>(reference)[i]).epsilon(0.001));
+		};
+
+		WHEN("We use the SIMD specialized operations")
+		{
+			THEN("They give the same results as the double precision ones")
+			{
+				for (unsigned int i = 0; i < 20; ++i)
+				{
+					Nz::Matrix4f left = RandomMatrix(false);
+					Nz::Matrix4f right = RandomMatrix(false);
+					CheckNear(Nz::Matrix4f::Concatenate(left, right), Nz::Matrix4d::Concatenate(Nz::Matrix4d(left), Nz::Matrix4d(right)));
+
+					Nz::Matrix4f inverse;
+					Nz::Matrix4d inverseReference;
+					REQUIRE(left.GetInverse(&inverse));
+					REQUIRE(Nz::Matrix4d(left).GetInverse(&inverseReference));
+					CheckNear(inverse, inverseReference);
+
+					Nz::Matrix4f leftAffine = RandomMatrix(true);
+					Nz::Matrix4f rightAffine = RandomMatrix(true);
+					CheckNear(Nz::Matrix4f::ConcatenateAffine(leftAffine, rightAffine), Nz::Matrix4d::ConcatenateAffine(Nz::Matrix4d(leftAffine), Nz::Matrix4d(rightAffine)));
+
+					REQUIRE(leftAffine.GetInverseAffine(&inverse));
+					REQUIRE(Nz::Matrix4d(leftAffine).GetInverseAffine(&inverseReference));
+					CheckNear(inverse, inverseReference);
+
+					Nz::Vector4f vector(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+					Nz::Vector4f transformed = left.Transform(vector);
+					Nz::Vector4d transformedReference = Nz::Matrix4d(left).Transform(Nz::Vector4d(vector));
+					CHECK(transformed.x == Approx(transformedReference.x).epsilon(0.001));
+					CHECK(transformed.y == Approx(transformedReference.y).epsilon(0.001));
+					CHECK(transformed.z == Approx(transformedReference.z).epsilon(0.001));
+					CHECK(transformed.w == Approx(transformedReference.w).epsilon(0.001));
+
+					Nz::Vector3f transformed3 = left.Transform(Nz::Vector3f(vector.x, vector.y, vector.z), vector.w);
+					CHECK(transformed3.x == Approx(transformedReference.x).epsilon(0.001));
+					CHECK(transformed3.y == Approx(transformedReference.y).epsilon(0.001));
+					CHECK(transformed3.z == Approx(transformedReference.z).epsilon(0.001));
+				}
+			}
+		}
+
+		WHEN("We invert a singular matrix")
+		{
+			Nz::Matrix4f singular(1.f, 2.f, 3.f, 4.f,
+			                      2.f, 4.f, 6.f, 8.f,
+			                      0.f, 1.f, 0.f, 1.f,
+			                      5.f, 1.f, 2.f, 0.f);
+
+			THEN("It fails")
+			{
+				Nz::Matrix4f inverse;
+				CHECK_FALSE(singular.GetInverse(&inverse));
+			}
+		}
+	}
 }
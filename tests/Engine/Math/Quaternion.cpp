@@ -184,4 +184,46 @@ SCENARIO("Quaternion", "[MATH][QUATERNION]")
 			}*/
 		}
 	}
+
+	GIVEN("Two random float quaternions")
+	{
+		Nz::Quaternionf first = Nz::EulerAnglesf(10.f, 75.f, -30.f).ToQuaternion();
+		Nz::Quaternionf second = Nz::EulerAnglesf(-45.f, 5.f, 120.f).ToQuaternion();
+
+		Nz::Quaternionf firstReference = first;
+		Nz::Quaterniond firstDouble(first);
+		Nz::Quaterniond secondDouble(second);
+
+		WHEN("We multiply them")
+		{
+			Nz::Quaternionf product = first * second;
+			Nz::Quaterniond productReference = firstDouble * secondDouble;
+
+			THEN("The result matches the double precision one")
+			{
+				CHECK(product.w == Approx(productReference.w));
+				CHECK(product.x == Approx(productReference.x));
+				CHECK(product.y == Approx(productReference.y));
+				CHECK(product.z == Approx(productReference.z));
+				CHECK(first == firstReference);
+			}
+		}
+
+		WHEN("We interpolate between them")
+		{
+			// The second one is negated to go through the shortest path handling
+			Nz::Quaternionf negated(-second.w, -second.x, -second.y, -second.z);
+
+			Nz::Quaternionf interpolated = Nz::Quaternionf::Slerp(first, negated, 0.3f);
+			Nz::Quaterniond interpolatedReference = Nz::Quaterniond::Slerp(firstDouble, Nz::Quaterniond(negated), 0.3);
+
+			THEN("The result matches the double precision one")
+			{
+				CHECK(interpolated.w == Approx(interpolatedReference.w));
+				CHECK(interpolated.x == Approx(interpolatedReference.x));
+				CHECK(interpolated.y == Approx(interpolatedReference.y));
+				CHECK(interpolated.z == Approx(interpolatedReference.z));
+			}
+		}
+	}
 }
@@ -96,5 +96,18 @@ SCENARIO("Vector3", "[MATH][VECTOR3]")
 				REQUIRE(Nz::Vector3f::Lerp(zero, unit, 0.5f) == (Nz::Vector3f::Unit() * 0.5f));
 			}
 		}
+
+		WHEN("We use them in constant expressions")
+		{
+			constexpr Nz::Vector3f cross = Nz::Vector3f::UnitX().CrossProduct(Nz::Vector3f::UnitY());
+			constexpr Nz::Vector3f sum = (Nz::Vector3f::Up() + Nz::Vector3f(2.f)) / 2.f;
+
+			THEN("They are computed at compile time")
+			{
+				static_assert(cross == Nz::Vector3f::UnitZ(), "Cross product should be computed at compile time");
+				static_assert(sum.DotProduct(Nz::Vector3f::Unit()) == 3.5f, "Arithmetic should be computed at compile time");
+				CHECK(sum == Nz::Vector3f(1.f, 1.5f, 1.f));
+			}
+		}
 	}
 }
@@ -0,0 +1,70 @@
+#include <Nazara/Network/Algorithm.hpp>
+#include <Catch/catch.hpp>
+
+#include <random>
+#include <vector>
+
+SCENARIO("Delta encoding", "[NETWORK][ALGORITHM]")
+{
+	GIVEN("A snapshot and the next one, where a few values changed")
+	{
+		std::mt19937 randomEngine(42);
+
+		std::vector<Nz::UInt8> reference(2000);
+		for (Nz::UInt8& byte : reference)
+			byte = static_cast<Nz::UInt8>(randomEngine());
+
+		std::vector<Nz::UInt8> snapshot = reference;
+		for (std::size_t i = 0; i < snapshot.size(); i += 97)
+			snapshot[i] ^= 0x5A;
+
+		WHEN("We encode it against the previous one")
+		{
+			Nz::ByteArray delta;
+			Nz::EncodeDelta(reference.data(), reference.size(), snapshot.data(), snapshot.size(), &delta);
+
+			THEN("It should be small and decode to the snapshot")
+			{
+				CHECK(delta.GetSize() * 10 < snapshot.size());
+
+				Nz::ByteArray decoded;
+				REQUIRE(Nz::DecodeDelta(reference.data(), reference.size(), delta.GetConstBuffer(), delta.GetSize(), &decoded));
+				CHECK(Nz::ByteArray(snapshot.data(), snapshot.size()) == decoded);
+			}
+
+			THEN("Truncated deltas should be rejected")
+			{
+				Nz::ByteArray decoded;
+				CHECK_FALSE(Nz::DecodeDelta(reference.data(), reference.size(), delta.GetConstBuffer(), delta.GetSize() - 1, &decoded));
+			}
+		}
+
+		WHEN("The snapshot grows past the reference")
+		{
+			snapshot.resize(2100, 0);
+
+			Nz::ByteArray delta;
+			Nz::EncodeDelta(reference.data(), reference.size(), snapshot.data(), snapshot.size(), &delta);
+
+			THEN("The new bytes should be decoded too")
+			{
+				Nz::ByteArray decoded;
+				REQUIRE(Nz::DecodeDelta(reference.data(), reference.size(), delta.GetConstBuffer(), delta.GetSize(), &decoded));
+				CHECK(Nz::ByteArray(snapshot.data(), snapshot.size()) == decoded);
+			}
+		}
+
+		WHEN("We encode it without reference")
+		{
+			Nz::ByteArray delta;
+			Nz::EncodeDelta(nullptr, 0, snapshot.data(), snapshot.size(), &delta);
+
+			THEN("It should decode on its own")
+			{
+				Nz::ByteArray decoded;
+				REQUIRE(Nz::DecodeDelta(nullptr, 0, delta.GetConstBuffer(), delta.GetSize(), &decoded));
+				CHECK(Nz::ByteArray(snapshot.data(), snapshot.size()) == decoded);
+			}
+		}
+	}
+}
@@ -1,6 +1,10 @@
 #include <Nazara/Network/IpAddress.hpp>
 #include <Catch/catch.hpp>
 
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <atomic>
+
 SCENARIO("IpAddress", "[NETWORK][IPADDRESS]")
 {
 	GIVEN("Two default IpAddress")
@@ -44,4 +48,55 @@ SCENARIO("IpAddress", "[NETWORK][IPADDRESS]")
 			}
 		}
 	}
+
+	GIVEN("Asynchronous resolutions")
+	{
+		Nz::IpAddress::ClearResolveCache();
+
+		WHEN("We resolve localhost and wait for it")
+		{
+			Nz::ResolveHandle handle = Nz::IpAddress::ResolveHostnameAsync(Nz::NetProtocol_IPv4, "localhost");
+			REQUIRE(handle.IsValid());
+			handle.Wait();
+
+			THEN("It's the loop back, and the result is cached")
+			{
+				REQUIRE(handle.IsDone());
+				REQUIRE(handle.GetError() == Nz::ResolveError_NoError);
+				REQUIRE_FALSE(handle.GetResults().empty());
+				CHECK(handle.GetResults().front().address.IsLoopback());
+
+				bool isCalled = false;
+				Nz::ResolveHandle cachedHandle = Nz::IpAddress::ResolveHostnameAsync(Nz::NetProtocol_IPv4, "localhost", "http", [&](const Nz::ResolveHandle& result)
+				{
+					isCalled = result.IsDone();
+				});
+
+				CHECK(isCalled);
+				CHECK(cachedHandle.IsDone());
+			}
+		}
+
+		WHEN("We resolve the loop back while a poller waits")
+		{
+			Nz::SocketPoller poller;
+			std::atomic_bool isDone(false);
+
+			Nz::ResolveHandle handle = Nz::IpAddress::ResolveAddressAsync(Nz::IpAddress::LoopbackIpV4, [&](const Nz::ResolveHandle&)
+			{
+				isDone = true;
+				poller.Wake();
+			});
+
+			THEN("The callback should wake the poller up")
+			{
+				Nz::Clock clock;
+				CHECK(poller.Wait(10000) == 0);
+				CHECK(clock.GetMilliseconds() < 5000);
+
+				handle.Wait();
+				CHECK(isDone);
+			}
+		}
+	}
 }
@@ -0,0 +1,72 @@
+#include <Nazara/Network/NetPacket.hpp>
+#include <Catch/catch.hpp>
+
+#include <Nazara/Core/Thread.hpp>
+#include <memory>
+#include <vector>
+
+SCENARIO("NetPacket", "[NETWORK][NETPACKET]")
+{
+	GIVEN("The buffer pool statistics")
+	{
+		Nz::NetPacket::BufferPoolStats initialStats = Nz::NetPacket::GetBufferPoolStats();
+
+		WHEN("We create packets")
+		{
+			std::vector<std::unique_ptr<Nz::NetPacket>> packets;
+			for (unsigned int i = 0; i < 100; ++i)
+				packets.emplace_back(std::make_unique<Nz::NetPacket>(1, 100));
+
+			THEN("Their buffers should be outstanding")
+			{
+				Nz::NetPacket::BufferPoolStats stats = Nz::NetPacket::GetBufferPoolStats();
+				CHECK(stats.acquiredBuffers - initialStats.acquiredBuffers == 100);
+				CHECK(stats.outstandingBuffers - initialStats.outstandingBuffers == 100);
+			}
+
+			AND_WHEN("We destroy them and create them again")
+			{
+				packets.clear();
+
+				Nz::NetPacket::BufferPoolStats releasedStats = Nz::NetPacket::GetBufferPoolStats();
+				CHECK(releasedStats.outstandingBuffers == initialStats.outstandingBuffers);
+
+				for (unsigned int i = 0; i < 100; ++i)
+					packets.emplace_back(std::make_unique<Nz::NetPacket>(1, 100));
+
+				THEN("Their buffers should come from the pool")
+				{
+					Nz::NetPacket::BufferPoolStats stats = Nz::NetPacket::GetBufferPoolStats();
+					CHECK(stats.allocatedBuffers == releasedStats.allocatedBuffers);
+					CHECK(stats.reusedBuffers - releasedStats.reusedBuffers == 100);
+					CHECK(stats.hitRate > 0.f);
+				}
+			}
+		}
+
+		WHEN("Another thread releases packets")
+		{
+			std::vector<std::unique_ptr<Nz::NetPacket>> packets;
+			for (unsigned int i = 0; i < 200; ++i)
+			{
+				packets.emplace_back(std::make_unique<Nz::NetPacket>(1, 100));
+				*packets.back() << Nz::UInt32(i);
+			}
+
+			Nz::Thread thread([&packets] () { packets.clear(); });
+			thread.Join();
+
+			THEN("Its cache should be given back to the global pool")
+			{
+				Nz::NetPacket::BufferPoolStats releasedStats = Nz::NetPacket::GetBufferPoolStats();
+				CHECK(releasedStats.outstandingBuffers == initialStats.outstandingBuffers);
+
+				for (unsigned int i = 0; i < 200; ++i)
+					packets.emplace_back(std::make_unique<Nz::NetPacket>(1, 100));
+
+				Nz::NetPacket::BufferPoolStats stats = Nz::NetPacket::GetBufferPoolStats();
+				CHECK(stats.reusedBuffers - releasedStats.reusedBuffers == 200);
+			}
+		}
+	}
+}
@@ -1,7 +1,9 @@
 #include <Nazara/Network/RUdpConnection.hpp>
 #include <Catch/catch.hpp>
 
+#include <Nazara/Core/Thread.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <vector>
 
 SCENARIO("RUdpConnection", "[NETWORK][RUDPCONNECTION]")
 {
@@ -36,5 +38,394 @@ SCENARIO("RUdpConnection", "[NETWORK][RUDPCONNECTION]")
 				REQUIRE(result == vector123);
 			}
 		}
+
+		WHEN("We send many packets from client in a single update")
+		{
+			for (Nz::UInt32 i = 0; i < 100; ++i)
+			{
+				Nz::NetPacket packet(1);
+				packet << i;
+				REQUIRE(client.Send(serverIP, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet));
+			}
+			client.Update();
+
+			THEN("We should get each of them once on the server")
+			{
+				server.Update();
+
+				Nz::UInt32 expected = 0;
+				Nz::RUdpMessage rudpMessage;
+				while (server.PollMessage(&rudpMessage))
+				{
+					Nz::UInt32 result;
+					rudpMessage.data >> result;
+					CHECK(result == expected);
+					expected++;
+				}
+
+				REQUIRE(expected == 100);
+			}
+		}
+
+		WHEN("Both connections are updated by their own thread")
+		{
+			client.Update(); //< Sends the connection request
+
+			server.EnableThreading(true);
+			client.EnableThreading(true);
+			CHECK(server.IsThreadingEnabled());
+
+			Nz::NetPacket packet(1);
+			Nz::Vector3f vector123(1.f, 2.f, 3.f);
+			packet << vector123;
+			REQUIRE(client.Send(serverIP, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet));
+
+			THEN("We should get it on the server without updating")
+			{
+				Nz::RUdpMessage rudpMessage;
+				bool received = false;
+				for (unsigned int i = 0; i < 1000 && !received; ++i)
+				{
+					received = server.PollMessage(&rudpMessage);
+					if (!received)
+						Nz::Thread::Sleep(1);
+				}
+
+				REQUIRE(received);
+				Nz::Vector3f result;
+				rudpMessage.data >> result;
+				REQUIRE(result == vector123);
+
+				server.EnableThreading(false);
+				CHECK_FALSE(server.IsThreadingEnabled());
+			}
+		}
+	}
+
+	GIVEN("Two RUdpConnection compressing their payloads")
+	{
+		Nz::UInt16 port = 64266;
+		Nz::RUdpConnection server;
+		server.EnableCompression(true);
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port));
+
+		// Replies come from the loopback address, the client has to know the server by it
+		Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+		serverAddress.SetPort(port);
+
+		Nz::RUdpConnection client;
+		client.EnableCompression(true);
+		REQUIRE(client.Listen(Nz::NetProtocol_IPv4, port + 1));
+		REQUIRE(client.Connect(serverAddress));
+
+		WHEN("We send a redundant message and track it")
+		{
+			Nz::UInt32 acknowledgedMessage = 0;
+			client.OnMessageAcknowledged.Connect([&](Nz::RUdpConnection*, const Nz::IpAddress&, Nz::UInt32 messageId)
+			{
+				acknowledgedMessage = messageId;
+			});
+
+			Nz::NetPacket packet(1);
+			for (Nz::UInt32 i = 0; i < 256; ++i)
+				packet << i % 4;
+
+			REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet, 42));
+			client.Update();
+
+			THEN("The server should get it decompressed, and the client should know once it is acknowledged")
+			{
+				Nz::RUdpMessage rudpMessage;
+				server.Update();
+				REQUIRE(server.PollMessage(&rudpMessage));
+
+				bool isIntact = true;
+				for (Nz::UInt32 i = 0; i < 256; ++i)
+				{
+					Nz::UInt32 result;
+					rudpMessage.data >> result;
+					isIntact = isIntact && (result == i % 4);
+				}
+				CHECK(isIntact);
+
+				Nz::NetPacket reply(2);
+				reply << Nz::UInt8(1);
+				REQUIRE(server.Send(rudpMessage.from, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, reply));
+				server.Update();
+
+				CHECK(acknowledgedMessage == 0);
+				client.Update();
+				CHECK(acknowledgedMessage == 42);
+			}
+		}
+	}
+
+	GIVEN("Two connected RUdpConnection aggregating small messages")
+	{
+		Nz::UInt16 port = 64268;
+		Nz::RUdpConnection server;
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port));
+
+		Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+		serverAddress.SetPort(port);
+
+		Nz::RUdpConnection client;
+		client.EnableCompression(true);
+		REQUIRE(client.Listen(Nz::NetProtocol_IPv4, port + 1));
+		CHECK(client.IsAggregationEnabled());
+
+		bool isConnected = false;
+		client.OnConnectedToPeer.Connect([&](Nz::RUdpConnection*)
+		{
+			isConnected = true;
+		});
+
+		// Messages are only aggregated once the handshake is over
+		REQUIRE(client.Connect(serverAddress));
+		client.Update();
+		server.Update();
+		client.Update();
+		REQUIRE(isConnected);
+
+		WHEN("We send small, compressed and oversized messages during the same update")
+		{
+			for (Nz::UInt32 i = 0; i < 10; ++i)
+			{
+				Nz::NetPacket packet(100 + i);
+				packet << i;
+				REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet));
+			}
+
+			Nz::NetPacket compressiblePacket(200);
+			for (Nz::UInt32 i = 0; i < 256; ++i)
+				compressiblePacket << i % 4;
+
+			REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, compressiblePacket));
+
+			Nz::NetPacket oversizedPacket(201);
+			for (Nz::UInt32 i = 0; i < 2048; ++i)
+				oversizedPacket << i;
+
+			REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, oversizedPacket));
+			client.Update();
+
+			THEN("The server should get each one of them, in order")
+			{
+				server.Update();
+
+				Nz::RUdpMessage rudpMessage;
+				for (Nz::UInt32 i = 0; i < 10; ++i)
+				{
+					REQUIRE(server.PollMessage(&rudpMessage));
+					CHECK(rudpMessage.data.GetNetCode() == 100 + i);
+
+					Nz::UInt32 result;
+					rudpMessage.data >> result;
+					CHECK(result == i);
+				}
+
+				REQUIRE(server.PollMessage(&rudpMessage));
+				CHECK(rudpMessage.data.GetNetCode() == 200);
+				CHECK(rudpMessage.data.GetDataSize() == Nz::RUdpConnection::MessageHeader + compressiblePacket.GetDataSize() + Nz::RUdpConnection::MessageFooter);
+
+				REQUIRE(server.PollMessage(&rudpMessage));
+				CHECK(rudpMessage.data.GetNetCode() == 201);
+				CHECK(rudpMessage.data.GetDataSize() == Nz::RUdpConnection::MessageHeader + oversizedPacket.GetDataSize() + Nz::RUdpConnection::MessageFooter);
+
+				CHECK_FALSE(server.PollMessage(&rudpMessage));
+			}
+		}
+	}
+
+	GIVEN("Two connected RUdpConnection with statistics")
+	{
+		Nz::UInt16 port = 64270;
+		Nz::RUdpConnection server;
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port));
+
+		Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+		serverAddress.SetPort(port);
+
+		Nz::RUdpConnection client;
+		REQUIRE(client.Listen(Nz::NetProtocol_IPv4, port + 1));
+		REQUIRE(client.Connect(serverAddress));
+		client.Update();
+		server.Update();
+		client.Update();
+
+		WHEN("The connection has been established")
+		{
+			Nz::RUdpConnection::PeerStatistics statistics;
+			REQUIRE(client.GetPeerStatistics(serverAddress, &statistics));
+			CHECK_FALSE(client.GetPeerStatistics(Nz::IpAddress::LoopbackIpV4, &statistics));
+
+			THEN("The acknowledged request should have measured the round-trip time")
+			{
+				CHECK(statistics.packetsSent == 1);
+				CHECK(statistics.packetsReceived == 1);
+				CHECK(statistics.packetsLost == 0);
+				CHECK(statistics.bytesSent > 0);
+				CHECK(statistics.bytesReceived > 0);
+				CHECK(statistics.inFlightPacketCount == 0);
+				CHECK(statistics.roundTripTime < 1'000'000);
+				CHECK(statistics.congestionWindow > 16.f);
+			}
+		}
+
+		WHEN("We send more than the bandwidth limit allows")
+		{
+			client.SetBandwidthLimit(1000);
+
+			std::vector<Nz::UInt8> payload(400, 0x42);
+			for (unsigned int i = 0; i < 10; ++i)
+			{
+				Nz::NetPacket packet(1);
+				packet.Write(payload.data(), payload.size());
+				REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Medium, Nz::PacketReliability_Reliable, packet));
+			}
+
+			Nz::NetPacket urgentPacket(2);
+			urgentPacket << Nz::UInt32(42);
+			REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, urgentPacket));
+
+			client.Update();
+			server.Update();
+
+			THEN("Immediate packets should be sent at once, while the others wait for the next updates")
+			{
+				Nz::RUdpMessage rudpMessage;
+				REQUIRE(server.PollMessage(&rudpMessage));
+				CHECK(rudpMessage.data.GetNetCode() == 2);
+
+				unsigned int receivedCount = 0;
+				while (server.PollMessage(&rudpMessage))
+					receivedCount++;
+
+				CHECK(receivedCount < 10);
+
+				Nz::RUdpConnection::PeerStatistics statistics;
+				REQUIRE(client.GetPeerStatistics(serverAddress, &statistics));
+				CHECK(statistics.pendingPacketCount == 10 - receivedCount);
+			}
+		}
+	}
+
+	GIVEN("Two connected RUdpConnection, the server simulating a slow network")
+	{
+		Nz::UInt16 port = 64272;
+		Nz::RUdpConnection server;
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port));
+
+		Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+		serverAddress.SetPort(port);
+
+		Nz::RUdpConnection client;
+		REQUIRE(client.Listen(Nz::NetProtocol_IPv4, port + 1));
+		REQUIRE(client.Connect(serverAddress));
+		client.Update();
+		server.Update();
+		client.Update();
+
+		Nz::RUdpConnection::SimulationParameters simulation;
+		simulation.latency = 50'000;
+		server.SimulateNetwork(simulation);
+
+		WHEN("We send many packets from client")
+		{
+			for (Nz::UInt32 i = 0; i < 10; ++i)
+			{
+				Nz::NetPacket packet(1);
+				packet << i;
+				REQUIRE(client.Send(serverAddress, Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet));
+			}
+			client.Update();
+
+			THEN("The server should only get them once the latency has elapsed, in order")
+			{
+				Nz::Thread::Sleep(5);
+				server.Update();
+
+				Nz::RUdpMessage rudpMessage;
+				CHECK_FALSE(server.PollMessage(&rudpMessage));
+
+				Nz::Thread::Sleep(60);
+				server.Update();
+
+				Nz::UInt32 expected = 0;
+				while (server.PollMessage(&rudpMessage))
+				{
+					Nz::UInt32 result;
+					rudpMessage.data >> result;
+					CHECK(result == expected);
+					expected++;
+				}
+
+				REQUIRE(expected == 10);
+			}
+		}
+	}
+
+	GIVEN("A server connected to two clients")
+	{
+		Nz::UInt16 port = 64274;
+		Nz::RUdpConnection server;
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port));
+
+		Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+		serverAddress.SetPort(port);
+
+		std::vector<Nz::IpAddress> clientAddresses;
+		Nz::RUdpConnection clients[2];
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			Nz::UInt16 clientPort = static_cast<Nz::UInt16>(port + 1 + i);
+			REQUIRE(clients[i].Listen(Nz::NetProtocol_IPv4, clientPort));
+			REQUIRE(clients[i].Connect(serverAddress));
+
+			Nz::IpAddress clientAddress = Nz::IpAddress::LoopbackIpV4;
+			clientAddress.SetPort(clientPort);
+			clientAddresses.push_back(clientAddress);
+		}
+
+		for (Nz::RUdpConnection& client : clients)
+			client.Update();
+
+		server.Update();
+
+		for (Nz::RUdpConnection& client : clients)
+			client.Update();
+
+		WHEN("The server broadcasts a packet to them and to an unknown peer")
+		{
+			Nz::IpAddress unknownAddress = Nz::IpAddress::LoopbackIpV4;
+			unknownAddress.SetPort(port + 3);
+
+			std::vector<Nz::IpAddress> peers = clientAddresses;
+			peers.push_back(unknownAddress);
+
+			Nz::NetPacket packet(1);
+			Nz::Vector3f vector123(1.f, 2.f, 3.f);
+			packet << vector123;
+			CHECK_FALSE(server.Broadcast(peers.data(), peers.size(), Nz::PacketPriority_Immediate, Nz::PacketReliability_Reliable, packet));
+			server.Update();
+
+			THEN("Each client gets it once")
+			{
+				for (Nz::RUdpConnection& client : clients)
+				{
+					client.Update();
+
+					Nz::RUdpMessage rudpMessage;
+					REQUIRE(client.PollMessage(&rudpMessage));
+					CHECK(rudpMessage.data.GetNetCode() == 1);
+
+					Nz::Vector3f result;
+					rudpMessage.data >> result;
+					CHECK(result == vector123);
+
+					CHECK_FALSE(client.PollMessage(&rudpMessage));
+				}
+			}
+		}
 	}
 }
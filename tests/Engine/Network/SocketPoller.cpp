@@ -0,0 +1,160 @@
+#include <Nazara/Network/SocketPoller.hpp>
+#include <Catch/catch.hpp>
+
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Network/TcpClient.hpp>
+#include <Nazara/Network/TcpServer.hpp>
+
+#include <random>
+
+SCENARIO("SocketPoller", "[NETWORK][SOCKETPOLLER]")
+{
+	GIVEN("A TCP server and two connected clients")
+	{
+		// Avoid reusing the same socket
+		std::random_device rd;
+		std::mt19937 gen(rd());
+		std::uniform_int_distribution<> dis(1025, 64245);
+
+		Nz::UInt16 port = dis(gen);
+		Nz::TcpServer server;
+		REQUIRE(server.Listen(Nz::NetProtocol_IPv4, port) == Nz::SocketState_Bound);
+		Nz::IpAddress serverIP = server.GetBoundAddress();
+		REQUIRE(serverIP.IsValid());
+
+		Nz::SocketPoller poller;
+		REQUIRE(poller.RegisterSocket(server, Nz::SocketPollEvent_Read));
+
+		Nz::TcpClient firstClient;
+		REQUIRE(firstClient.Connect(serverIP) == Nz::SocketState_Connecting);
+		Nz::TcpClient secondClient;
+		REQUIRE(secondClient.Connect(serverIP) == Nz::SocketState_Connecting);
+
+		REQUIRE(poller.Wait(1000) == 1);
+		CHECK(poller.IsReadyToRead(server));
+
+		Nz::TcpClient firstServerSide;
+		REQUIRE(server.AcceptClient(&firstServerSide));
+		Nz::TcpClient secondServerSide;
+		REQUIRE(server.AcceptClient(&secondServerSide));
+
+		int firstData = 1;
+		int secondData = 2;
+		REQUIRE(poller.RegisterSocket(firstServerSide, Nz::SocketPollEvent_Read, Nz::SocketPollMode_LevelTriggered, &firstData));
+		REQUIRE(poller.RegisterSocket(secondServerSide, Nz::SocketPollEvent_Read, Nz::SocketPollMode_LevelTriggered, &secondData));
+		CHECK(poller.GetSocketCount() == 3);
+
+		WHEN("Nothing is sent")
+		{
+			THEN("The wait should time out")
+			{
+				CHECK(poller.Wait(50) == 0);
+				CHECK(poller.GetReadySockets().empty());
+				CHECK_FALSE(poller.IsReadyToRead(firstServerSide));
+			}
+		}
+
+		WHEN("The second client sends data")
+		{
+			char data[] = "Nazara";
+			std::size_t sent;
+			REQUIRE(secondClient.Send(data, sizeof(data), &sent));
+			REQUIRE(sent == sizeof(data));
+
+			THEN("Only its server side socket should be ready, as long as it is not read")
+			{
+				for (unsigned int i = 0; i < 2; ++i)
+				{
+					REQUIRE(poller.Wait(1000) == 1);
+					CHECK_FALSE(poller.IsReadyToRead(firstServerSide));
+					CHECK(poller.IsReadyToRead(secondServerSide));
+					CHECK_FALSE(poller.IsReadyToWrite(secondServerSide));
+
+					const Nz::SocketPoller::ReadySocket& readySocket = poller.GetReadySockets().front();
+					CHECK(readySocket.eventFlags == Nz::SocketPollEvent_Read);
+					CHECK(readySocket.userdata == &secondData);
+				}
+
+				char received[sizeof(data)];
+				std::size_t receivedSize;
+				REQUIRE(secondServerSide.Receive(received, sizeof(received), &receivedSize));
+				CHECK(receivedSize == sizeof(data));
+
+				CHECK(poller.Wait(50) == 0);
+			}
+		}
+
+		WHEN("We wait for write readiness")
+		{
+			REQUIRE(poller.UpdateSocket(firstServerSide, Nz::SocketPollEvent_Read | Nz::SocketPollEvent_Write));
+
+			THEN("The socket should be writable without any data to read")
+			{
+				REQUIRE(poller.Wait(1000) == 1);
+				CHECK(poller.IsReadyToWrite(firstServerSide));
+				CHECK_FALSE(poller.IsReadyToRead(firstServerSide));
+				CHECK(poller.GetReadySockets().front().userdata == nullptr);
+			}
+		}
+
+		WHEN("Another thread wakes the poller up")
+		{
+			Nz::Thread thread([&poller]
+			{
+				poller.Wake();
+			});
+
+			THEN("The wait should be interrupted without any ready socket")
+			{
+				Nz::Clock clock;
+				CHECK(poller.Wait(5000) == 0);
+				CHECK(clock.GetMilliseconds() < 4000);
+				CHECK(poller.GetReadySockets().empty());
+				CHECK(poller.GetSocketCount() == 3);
+
+				thread.Join();
+			}
+		}
+
+		WHEN("A ready socket is unregistered")
+		{
+			char data[] = "Nazara";
+			std::size_t sent;
+			REQUIRE(firstClient.Send(data, sizeof(data), &sent));
+			REQUIRE(poller.Wait(1000) == 1);
+
+			poller.UnregisterSocket(firstServerSide);
+
+			THEN("It should not be reported anymore")
+			{
+				CHECK_FALSE(poller.IsRegistered(firstServerSide));
+				CHECK_FALSE(poller.IsReadyToRead(firstServerSide));
+				CHECK(poller.GetReadySockets().empty());
+				CHECK(poller.GetSocketCount() == 2);
+			}
+		}
+
+		#ifndef NAZARA_PLATFORM_WINDOWS
+		WHEN("A socket is edge-triggered")
+		{
+			REQUIRE(poller.UpdateSocket(firstServerSide, Nz::SocketPollEvent_Read, Nz::SocketPollMode_EdgeTriggered, &firstData));
+
+			char data[] = "Nazara";
+			std::size_t sent;
+			REQUIRE(firstClient.Send(data, sizeof(data), &sent));
+
+			THEN("It should only be reported once until more data arrives")
+			{
+				REQUIRE(poller.Wait(1000) == 1);
+				CHECK(poller.IsReadyToRead(firstServerSide));
+				CHECK(poller.Wait(50) == 0);
+
+				REQUIRE(firstClient.Send(data, sizeof(data), &sent));
+				REQUIRE(poller.Wait(1000) == 1);
+				CHECK(poller.GetReadySockets().front().userdata == &firstData);
+			}
+		}
+		#endif
+	}
+}
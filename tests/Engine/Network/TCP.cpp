@@ -2,10 +2,12 @@
 #include <Nazara/Network/TcpServer.hpp>
 #include <Catch/catch.hpp>
 
+#include <Nazara/Core/Thread.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Network/NetPacket.hpp>
 
 #include <random>
+#include <string>
 
 SCENARIO("TCP", "[NETWORK][TCP]")
 {
@@ -45,5 +47,83 @@ SCENARIO("TCP", "[NETWORK][TCP]")
 				REQUIRE(result == vector123);
 			}
 		}
+
+		WHEN("We send multiple buffers at once")
+		{
+			char first[] = "Naz";
+			char second[] = "ara";
+
+			Nz::NetBuffer buffers[2];
+			buffers[0].data = first;
+			buffers[0].dataLength = 3;
+			buffers[1].data = second;
+			buffers[1].dataLength = 3;
+
+			std::size_t sent;
+			REQUIRE(client.SendMultiple(buffers, 2, &sent));
+			CHECK(sent == 6);
+
+			THEN("They should be received one after the other")
+			{
+				char received[6];
+				std::size_t receivedSize = 0;
+				while (receivedSize < sizeof(received))
+				{
+					std::size_t read;
+					REQUIRE(serverToClient.Receive(received + receivedSize, sizeof(received) - receivedSize, &read));
+					receivedSize += read;
+				}
+
+				CHECK(std::string(received, sizeof(received)) == "Nazara");
+			}
+		}
+
+		WHEN("The client gathers its packets")
+		{
+			client.EnableLowDelay(true);
+			client.EnableWriteCoalescing(true, 1400, 60'000);
+			CHECK(client.IsWriteCoalescingEnabled());
+
+			for (Nz::UInt32 i = 0; i < 3; ++i)
+			{
+				Nz::NetPacket packet(1);
+				packet << i;
+				REQUIRE(client.SendPacket(packet));
+			}
+
+			THEN("They should only be sent once flushed")
+			{
+				Nz::Thread::Sleep(10);
+				CHECK(serverToClient.QueryAvailableBytes() == 0);
+
+				client.Flush();
+
+				for (Nz::UInt32 i = 0; i < 3; ++i)
+				{
+					Nz::NetPacket resultPacket;
+					REQUIRE(serverToClient.ReceivePacket(&resultPacket));
+
+					Nz::UInt32 result;
+					resultPacket >> result;
+					CHECK(result == i);
+				}
+			}
+
+			THEN("A packet reaching the flush size should send them all")
+			{
+				Nz::NetPacket bigPacket(2);
+				for (Nz::UInt32 i = 0; i < 500; ++i)
+					bigPacket << i;
+
+				REQUIRE(client.SendPacket(bigPacket));
+
+				for (Nz::UInt32 i = 0; i < 4; ++i)
+				{
+					Nz::NetPacket resultPacket;
+					REQUIRE(serverToClient.ReceivePacket(&resultPacket));
+					CHECK(resultPacket.GetNetCode() == ((i < 3) ? 1 : 2));
+				}
+			}
+		}
 	}
 }
@@ -3,6 +3,7 @@
 
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Network/NetPacket.hpp>
+#include <array>
 
 SCENARIO("UdpSocket", "[NETWORK][UDPSOCKET]")
 {
@@ -35,5 +36,50 @@ SCENARIO("UdpSocket", "[NETWORK][UDPSOCKET]")
 				REQUIRE(result == vector123);
 			}
 		}
+
+		WHEN("We send many packets at once from client")
+		{
+			std::array<Nz::NetPacket, 5> packets;
+			std::array<const Nz::NetPacket*, 5> packetPointers;
+			std::array<Nz::IpAddress, 5> addresses;
+			for (unsigned int i = 0; i < packets.size(); ++i)
+			{
+				packets[i].Reset(1);
+				packets[i] << Nz::UInt32(i);
+
+				packetPointers[i] = &packets[i];
+				addresses[i] = serverIP;
+			}
+
+			std::size_t sent;
+			REQUIRE(client.SendMultiple(addresses.data(), packetPointers.data(), packets.size(), &sent));
+			REQUIRE(sent == packets.size());
+
+			THEN("We should get them in order on the server")
+			{
+				std::array<Nz::NetPacket, 8> resultPackets;
+				std::array<Nz::IpAddress, 8> fromIps;
+
+				std::size_t receivedCount = 0;
+				while (receivedCount < packets.size())
+				{
+					std::size_t received;
+					REQUIRE(server.ReceiveMultiple(&resultPackets[receivedCount], &fromIps[receivedCount], resultPackets.size() - receivedCount, &received));
+					REQUIRE(received > 0);
+
+					receivedCount += received;
+				}
+				REQUIRE(receivedCount == packets.size());
+
+				for (unsigned int i = 0; i < receivedCount; ++i)
+				{
+					Nz::UInt32 result;
+					resultPackets[i] >> result;
+					CHECK(result == i);
+					CHECK(resultPackets[i].GetNetCode() == 1);
+					CHECK(fromIps[i].GetPort() == clientIP.GetPort());
+				}
+			}
+		}
 	}
 }
@@ -0,0 +1,427 @@
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexStruct.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+SCENARIO("InterpolateSequenceJoints", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("Two poses, with close and distant rotations")
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+		auto Random = [&]() { return distribution(randomEngine); };
+
+		// Not a multiple of four, to go through the remaining joints too
+		const unsigned int jointCount = 23;
+
+		std::vector<Nz::SequenceJoint> poseA(jointCount);
+		std::vector<Nz::SequenceJoint> poseB(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			poseA[i].rotation = Nz::Quaternionf(Random(), Random(), Random(), Random()).Normalize();
+			if (i % 3 == 0)
+				poseB[i].rotation = Nz::Quaternionf(Random(), Random(), Random(), Random()).Normalize();
+			else
+			{
+				poseB[i].rotation = poseA[i].rotation * Nz::Quaternionf(1.f, 0.05f * Random(), 0.05f * Random(), 0.05f * Random()).Normalize();
+
+				// Same rotation, on the other side of the hypersphere
+				if (i % 2 == 0)
+					poseB[i].rotation = Nz::Quaternionf(-poseB[i].rotation.w, -poseB[i].rotation.x, -poseB[i].rotation.y, -poseB[i].rotation.z);
+			}
+
+			poseA[i].position = Nz::Vector3f(Random(), Random(), Random());
+			poseB[i].position = Nz::Vector3f(Random(), Random(), Random());
+			poseA[i].scale = Nz::Vector3f(Random(), Random(), Random());
+			poseB[i].scale = Nz::Vector3f(Random(), Random(), Random());
+		}
+
+		WHEN("We interpolate them")
+		{
+			std::vector<Nz::SequenceJoint> output(jointCount);
+
+			THEN("The joints match the ones interpolated one by one")
+			{
+				for (float interpolation : {0.f, 0.3f, 0.5f, 1.f})
+				{
+					Nz::InterpolateSequenceJoints(poseA.data(), poseB.data(), interpolation, output.data(), jointCount);
+
+					for (unsigned int i = 0; i < jointCount; ++i)
+					{
+						INFO("Joint #" << i << " at " << interpolation);
+
+						Nz::Quaternionf expectedRotation = Nz::Quaternionf::Slerp(poseA[i].rotation, poseB[i].rotation, interpolation).Normalize();
+						CHECK(std::abs(expectedRotation.DotProduct(output[i].rotation)) == Approx(1.f).epsilon(0.0001f));
+						CHECK(output[i].position == Nz::Vector3f::Lerp(poseA[i].position, poseB[i].position, interpolation));
+						CHECK(output[i].scale == Nz::Vector3f::Lerp(poseA[i].scale, poseB[i].scale, interpolation));
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Skinning", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("Random joints and vertices influenced by up to four of them")
+	{
+		std::mt19937 randomEngine(42);
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+		auto Random = [&]() { return distribution(randomEngine); };
+
+		const unsigned int jointCount = 16;
+		const unsigned int vertexCount = 101;
+
+		std::vector<Nz::Matrix4f> matrices(jointCount);
+		for (Nz::Matrix4f& matrix : matrices)
+			matrix.MakeTransform(Nz::Vector3f(Random(), Random(), Random()), Nz::Quaternionf(Random(), Random(), Random(), Random()).Normalize(), Nz::Vector3f(1.5f + Random()));
+
+		std::vector<Nz::SkeletalMeshVertex> inputVertices(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; ++i)
+		{
+			Nz::SkeletalMeshVertex& vertex = inputVertices[i];
+			vertex.position = Nz::Vector3f(Random(), Random(), Random());
+			vertex.normal = Nz::Vector3f(Random(), Random(), Random() + 2.f).Normalize();
+			vertex.tangent = Nz::Vector3f(Random() + 2.f, Random(), Random()).Normalize();
+			vertex.uv = Nz::Vector2f(Random(), Random());
+			vertex.weightCount = i % 5;
+
+			float weightSum = 0.f;
+			for (int j = 0; j < vertex.weightCount; ++j)
+			{
+				vertex.jointIndexes[j] = static_cast<Nz::Int32>((i * 7 + j * 3) % jointCount);
+				vertex.weights[j] = Random() + 1.5f;
+				weightSum += vertex.weights[j];
+			}
+
+			for (int j = 0; j < vertex.weightCount; ++j)
+				vertex.weights[j] /= weightSum;
+		}
+
+		auto CheckSkinning = [&]()
+		{
+			std::vector<Nz::MeshVertex> outputVertices(vertexCount);
+
+			Nz::SkinningData skinningData;
+			skinningData.joints = nullptr;
+			skinningData.skinningMatrices = matrices.data();
+			skinningData.inputVertex = inputVertices.data();
+			skinningData.outputVertex = outputVertices.data();
+
+			// In two parts, as the skinning manager does with several threads
+			Nz::SkinPositionNormalTangent(skinningData, 0, 50);
+			Nz::SkinPositionNormalTangent(skinningData, 50, vertexCount - 50);
+
+			bool matching = true;
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				const Nz::SkeletalMeshVertex& vertex = inputVertices[i];
+
+				// Transformed by every joint, one after another
+				Nz::Vector3f position = Nz::Vector3f::Zero();
+				Nz::Vector3f normal = Nz::Vector3f::Zero();
+				Nz::Vector3f tangent = Nz::Vector3f::Zero();
+				for (int j = 0; j < vertex.weightCount; ++j)
+				{
+					const Nz::Matrix4f& matrix = matrices[vertex.jointIndexes[j]];
+					position += matrix.Transform(vertex.position) * vertex.weights[j];
+					normal += matrix.Transform(vertex.normal, 0.f) * vertex.weights[j];
+					tangent += matrix.Transform(vertex.tangent, 0.f) * vertex.weights[j];
+				}
+
+				normal.Normalize();
+				tangent.Normalize();
+
+				const Nz::MeshVertex& output = outputVertices[i];
+				if (output.position.Distance(position) > 0.0001f || output.normal.Distance(normal) > 0.0001f ||
+				    output.tangent.Distance(tangent) > 0.0001f || output.uv != vertex.uv)
+				{
+					matching = false;
+				}
+			}
+
+			return matching;
+		};
+
+		WHEN("We skin them with every implementation")
+		{
+			THEN("Vertices are transformed by the weighted joints")
+			{
+				CHECK(CheckSkinning());
+
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+				{
+					INFO("Without " << cap);
+
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+					CHECK(CheckSkinning());
+				}
+
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+			}
+		}
+	}
+}
+
+SCENARIO("Mesh optimization", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("Vertices referenced out of order, with an unused and a duplicated one")
+	{
+		struct Vertex
+		{
+			float position;
+			float id;
+		};
+
+		std::vector<Vertex> vertices = {{0.f, 0.f}, {1.f, 1.f}, {2.f, 2.f}, {3.f, 3.f}, {1.f, 1.f}};
+
+		Nz::IndexBuffer indexBuffer(false, 6);
+		{
+			Nz::IndexMapper mapper(&indexBuffer, Nz::BufferAccess_WriteOnly);
+			const Nz::UInt32 indices[] = {3, 1, 0, 0, 4, 3};
+			for (unsigned int i = 0; i < 6; ++i)
+				mapper.Set(i, indices[i]);
+		}
+
+		WHEN("We optimize the vertex fetch")
+		{
+			Nz::IndexMapper mapper(&indexBuffer);
+			unsigned int vertexCount = Nz::OptimizeVertexFetch(mapper.begin(), 6, vertices.data(), static_cast<unsigned int>(vertices.size()), sizeof(Vertex));
+
+			THEN("Vertices are stored in their first use order without the unused and duplicated ones")
+			{
+				REQUIRE(vertexCount == 3);
+				CHECK(vertices[0].id == 3.f);
+				CHECK(vertices[1].id == 1.f);
+				CHECK(vertices[2].id == 0.f);
+
+				const Nz::UInt32 expectedIndices[] = {0, 1, 2, 2, 1, 0};
+				for (unsigned int i = 0; i < 6; ++i)
+					CHECK(mapper.Get(i) == expectedIndices[i]);
+			}
+		}
+	}
+
+	GIVEN("A sphere")
+	{
+		unsigned int indexCount;
+		unsigned int vertexCount;
+		Nz::ComputeUvSphereIndexVertexCount(16, 16, &indexCount, &vertexCount);
+
+		std::vector<Nz::Vector3f> positions(vertexCount);
+		std::vector<Nz::Vector3f> normals(vertexCount);
+		std::vector<Nz::Vector2f> uvs(vertexCount);
+
+		Nz::VertexPointers pointers;
+		pointers.normalPtr = normals.data();
+		pointers.positionPtr = positions.data();
+		pointers.uvPtr = uvs.data();
+
+		Nz::IndexBuffer indexBuffer(false, indexCount);
+		Nz::IndexMapper mapper(&indexBuffer);
+		Nz::GenerateUvSphere(1.f, 16, 16, Nz::Matrix4f::Identity(), Nz::Rectf(0.f, 0.f, 1.f, 1.f), pointers, mapper.begin());
+
+		auto GetTriangles = [&]()
+		{
+			std::vector<std::array<Nz::UInt32, 3>> triangles(indexCount / 3);
+			for (unsigned int i = 0; i < indexCount / 3; ++i)
+			{
+				// Rotated to begin with the smallest index, keeping the winding
+				std::array<Nz::UInt32, 3> triangle = {{mapper.Get(i*3), mapper.Get(i*3 + 1), mapper.Get(i*3 + 2)}};
+				std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+				triangles[i] = triangle;
+			}
+
+			std::sort(triangles.begin(), triangles.end());
+			return triangles;
+		};
+
+		WHEN("We reorder its triangles for cache efficiency and overdraw")
+		{
+			auto triangles = GetTriangles();
+
+			Nz::OptimizeIndices(mapper.begin(), indexCount);
+			unsigned int cacheMissCount = Nz::ComputeCacheMissCount(mapper.begin(), indexCount);
+
+			Nz::OptimizeOverdraw(mapper.begin(), indexCount, positions.data(), vertexCount);
+
+			THEN("The same triangles are drawn, with about the same cache efficiency")
+			{
+				CHECK(GetTriangles() == triangles);
+				CHECK(Nz::ComputeCacheMissCount(mapper.begin(), indexCount) <= cacheMissCount * 1.25f);
+			}
+		}
+
+		WHEN("We quantize its vertices")
+		{
+			Nz::Boxf aabb = Nz::ComputeAABB(positions.data(), vertexCount);
+			Nz::QuantizeVertices(pointers, vertexCount, 8);
+
+			THEN("Attributes are snapped on their grid")
+			{
+				bool snapped = true;
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					float x = (positions[i].x - aabb.x) / (aabb.width / 255.f);
+					float nx = normals[i].x * 127.f;
+					if (std::abs(x - std::round(x)) > 0.01f || std::abs(nx - std::round(nx)) > 0.001f)
+						snapped = false;
+				}
+				CHECK(snapped);
+			}
+		}
+	}
+
+	GIVEN("An icosphere")
+	{
+		unsigned int indexCount;
+		unsigned int vertexCount;
+		Nz::ComputeIcoSphereIndexVertexCount(3, &indexCount, &vertexCount);
+
+		std::vector<Nz::Vector3f> positions(vertexCount);
+		std::vector<Nz::Vector3f> normals(vertexCount);
+		std::vector<Nz::Vector2f> uvs(vertexCount);
+
+		Nz::VertexPointers pointers;
+		pointers.normalPtr = normals.data();
+		pointers.positionPtr = positions.data();
+		pointers.uvPtr = uvs.data();
+
+		Nz::IndexBuffer indexBuffer(false, indexCount);
+		Nz::IndexMapper mapper(&indexBuffer);
+		Nz::GenerateIcoSphere(1.f, 3, Nz::Matrix4f::Identity(), Nz::Rectf(0.f, 0.f, 1.f, 1.f), pointers, mapper.begin());
+
+		WHEN("We simplify it")
+		{
+			std::vector<Nz::UInt32> simplifiedIndices;
+			Nz::SimplifyIndices(mapper.begin(), indexCount, positions.data(), vertexCount, indexCount / 2, &simplifiedIndices);
+
+			THEN("We get about half of the triangles, none of them being degenerated")
+			{
+				CHECK(simplifiedIndices.size() % 3 == 0);
+				CHECK(simplifiedIndices.size() <= indexCount * 3 / 4);
+				CHECK(simplifiedIndices.size() >= indexCount / 4);
+
+				bool valid = true;
+				for (std::size_t i = 0; i < simplifiedIndices.size(); i += 3)
+				{
+					const Nz::Vector3f& a = positions[simplifiedIndices[i]];
+					const Nz::Vector3f& b = positions[simplifiedIndices[i + 1]];
+					const Nz::Vector3f& c = positions[simplifiedIndices[i + 2]];
+
+					// Triangles of a sphere centered on the origin face outward
+					Nz::Vector3f normal = Nz::Vector3f::CrossProduct(b - a, c - a);
+					if (a == b || b == c || a == c || Nz::Vector3f::DotProduct(normal, a + b + c) <= 0.f)
+						valid = false;
+				}
+				CHECK(valid);
+			}
+		}
+	}
+}
+
+SCENARIO("Vertex compaction", "[UTILITY][ALGORITHM]")
+{
+	GIVEN("Some floats")
+	{
+		THEN("They are converted to half-floats and back with a half-float precision")
+		{
+			CHECK(Nz::PackHalf(1.f) == 0x3C00);
+			CHECK(Nz::PackHalf(-2.f) == 0xC000);
+			CHECK(Nz::PackHalf(65504.f) == 0x7BFF);
+			CHECK(Nz::PackHalf(1.e6f) == 0x7C00);
+
+			const float values[] = {0.f, 1.f, -2.5f, 0.333f, 1000.125f, 0.00001f};
+			for (float value : values)
+				CHECK(std::abs(Nz::UnpackHalf(Nz::PackHalf(value)) - value) <= std::abs(value) / 1024.f + 0.0000001f);
+		}
+
+		THEN("Directions are packed on 10 bits per component")
+		{
+			Nz::Vector4f direction = Nz::Vector4f(0.6f, -0.8f, 0.f, -1.f);
+			Nz::Vector4f unpacked = Nz::UnpackNormalizedInt2101010(Nz::PackNormalizedInt2101010(direction));
+
+			CHECK(std::abs(unpacked.x - direction.x) < 0.002f);
+			CHECK(std::abs(unpacked.y - direction.y) < 0.002f);
+			CHECK(std::abs(unpacked.z - direction.z) < 0.002f);
+			CHECK(unpacked.w == -1.f);
+		}
+	}
+
+	GIVEN("A vertex buffer with float normals and texture coordinates")
+	{
+		const unsigned int vertexCount = 3;
+		Nz::VertexBuffer vertexBuffer(Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ_Normal_UV), vertexCount, Nz::DataStorage_Software);
+		{
+			Nz::BufferMapper<Nz::VertexBuffer> mapper(vertexBuffer, Nz::BufferAccess_WriteOnly);
+			Nz::VertexStruct_XYZ_Normal_UV* vertices = static_cast<Nz::VertexStruct_XYZ_Normal_UV*>(mapper.GetPointer());
+			for (unsigned int i = 0; i < vertexCount; ++i)
+			{
+				vertices[i].position.Set(i * 1.5f, -1.f, 1000.f);
+				vertices[i].normal = Nz::Vector3f(1.f, i * 1.f, -2.f).Normalize();
+				vertices[i].uv.Set(i * 0.25f, 2.5f);
+			}
+		}
+
+		WHEN("We compact it")
+		{
+			REQUIRE(Nz::CompactVertices(&vertexBuffer));
+
+			THEN("Positions are untouched while normals and texture coordinates are packed")
+			{
+				const Nz::VertexDeclaration* declaration = vertexBuffer.GetVertexDeclaration();
+				CHECK(declaration->GetStride() == 20);
+
+				bool enabled;
+				Nz::ComponentType type;
+				std::size_t normalOffset, positionOffset, uvOffset;
+				declaration->GetComponent(Nz::VertexComponent_Normal, &enabled, &type, &normalOffset);
+				CHECK(type == Nz::ComponentType_NormalizedInt2101010);
+				declaration->GetComponent(Nz::VertexComponent_Position, &enabled, &type, &positionOffset);
+				CHECK(type == Nz::ComponentType_Float3);
+				declaration->GetComponent(Nz::VertexComponent_TexCoord, &enabled, &type, &uvOffset);
+				CHECK(type == Nz::ComponentType_Half2);
+
+				REQUIRE(vertexBuffer.GetVertexCount() == vertexCount);
+
+				Nz::BufferMapper<Nz::VertexBuffer> mapper(vertexBuffer, Nz::BufferAccess_ReadOnly);
+				const Nz::UInt8* vertex = static_cast<const Nz::UInt8*>(mapper.GetPointer());
+				bool matching = true;
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					Nz::Vector3f position = *reinterpret_cast<const Nz::Vector3f*>(vertex + positionOffset);
+					Nz::Vector4f normal = Nz::UnpackNormalizedInt2101010(*reinterpret_cast<const Nz::UInt32*>(vertex + normalOffset));
+					const Nz::UInt16* uv = reinterpret_cast<const Nz::UInt16*>(vertex + uvOffset);
+
+					if (position != Nz::Vector3f(i * 1.5f, -1.f, 1000.f))
+						matching = false;
+
+					if (Nz::Vector3f(normal.x, normal.y, normal.z).SquaredDistance(Nz::Vector3f(1.f, i * 1.f, -2.f).Normalize()) > 0.0001f)
+						matching = false;
+
+					if (Nz::UnpackHalf(uv[0]) != i * 0.25f || Nz::UnpackHalf(uv[1]) != 2.5f)
+						matching = false;
+
+					vertex += declaration->GetStride();
+				}
+
+				CHECK(matching);
+			}
+
+			THEN("Compacting it again does nothing")
+			{
+				CHECK_FALSE(Nz::CompactVertices(&vertexBuffer));
+			}
+		}
+	}
+}
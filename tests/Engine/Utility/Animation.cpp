@@ -0,0 +1,90 @@
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Catch/catch.hpp>
+#include <cmath>
+
+SCENARIO("Animation", "[UTILITY][ANIMATION]")
+{
+	GIVEN("A smooth skeletal animation")
+	{
+		const unsigned int frameCount = 200;
+		const unsigned int jointCount = 8;
+
+		Nz::AnimationRef animation = Nz::Animation::New();
+		REQUIRE(animation->CreateSkeletal(frameCount, jointCount));
+
+		Nz::Sequence sequence;
+		sequence.firstFrame = 0;
+		sequence.frameCount = frameCount;
+		sequence.frameRate = 24;
+		REQUIRE(animation->AddSequence(sequence));
+
+		Nz::SequenceJoint* sequenceJoints = animation->GetSequenceJoints();
+		for (unsigned int frame = 0; frame < frameCount; ++frame)
+		{
+			float time = frame / static_cast<float>(frameCount);
+
+			for (unsigned int i = 0; i < jointCount; ++i)
+			{
+				Nz::SequenceJoint& sequenceJoint = sequenceJoints[frame * jointCount + i];
+				sequenceJoint.position = Nz::Vector3f(static_cast<float>(i), std::sin(time * 3.f) * 0.1f, time * 2.f);
+				sequenceJoint.rotation = Nz::Quaternionf(time * 1.5f + i, Nz::Vector3f::Normalize(Nz::Vector3f(1.f, 1.f, static_cast<float>(i))));
+				sequenceJoint.scale = Nz::Vector3f::Unit();
+			}
+		}
+
+		Nz::AnimationRef reference = Nz::Animation::New();
+		REQUIRE(reference->CreateSkeletal(frameCount, jointCount));
+		REQUIRE(reference->AddSequence(sequence));
+		std::copy(sequenceJoints, sequenceJoints + frameCount * jointCount, reference->GetSequenceJoints());
+
+		WHEN("We compress it")
+		{
+			std::size_t memoryUsage = animation->GetMemoryUsage();
+
+			const float positionTolerance = 0.001f;
+			const float rotationTolerance = 0.001f;
+			REQUIRE(animation->Compress(positionTolerance, rotationTolerance));
+			CHECK(animation->IsCompressed());
+
+			THEN("It takes much less memory")
+			{
+				CHECK(animation->GetMemoryUsage() * 5 < memoryUsage);
+			}
+
+			THEN("Frames are decoded within the tolerance")
+			{
+				Nz::Skeleton skeleton;
+				Nz::Skeleton referenceSkeleton;
+				REQUIRE(skeleton.Create(jointCount));
+				REQUIRE(referenceSkeleton.Create(jointCount));
+
+				bool matching = true;
+				for (unsigned int frame = 0; frame + 1 < frameCount; frame += 7)
+				{
+					animation->AnimateSkeleton(&skeleton, frame, frame + 1, 0.25f);
+					reference->AnimateSkeleton(&referenceSkeleton, frame, frame + 1, 0.25f);
+
+					for (unsigned int i = 0; i < jointCount; ++i)
+					{
+						const Nz::Joint* joint = skeleton.GetJoint(i);
+						const Nz::Joint* referenceJoint = referenceSkeleton.GetJoint(i);
+
+						// Quantization adds a bit of error on top of the tolerance
+						if (joint->GetPosition(Nz::CoordSys_Local).Distance(referenceJoint->GetPosition(Nz::CoordSys_Local)) > positionTolerance * 1.5f)
+							matching = false;
+
+						if (std::abs(joint->GetRotation(Nz::CoordSys_Local).DotProduct(referenceJoint->GetRotation(Nz::CoordSys_Local))) < std::cos(rotationTolerance))
+							matching = false;
+
+						if (joint->GetScale(Nz::CoordSys_Local).Distance(Nz::Vector3f::Unit()) > positionTolerance)
+							matching = false;
+					}
+				}
+
+				CHECK(matching);
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include <Nazara/Utility/Font.hpp>
+#include <Nazara/Utility/FontGlyph.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("Font", "[UTILITY][FONT]")
+{
+	GIVEN("The default font")
+	{
+		const Nz::FontRef& font = Nz::Font::GetDefault();
+		REQUIRE(font.IsValid());
+
+		WHEN("We precache a character set")
+		{
+			const unsigned int characterSize = 27;
+			REQUIRE(font->Precache(characterSize, Nz::TextStyle_Regular, "The quick brown fox jumps over the lazy dog!"));
+
+			THEN("Every character is cached once, matching the glyph extracted alone")
+			{
+				CHECK(font->GetCachedGlyphCount(characterSize, Nz::TextStyle_Regular) == 29);
+
+				bool matching = true;
+				for (char character : Nz::String("Tqfz!"))
+				{
+					const Nz::Font::Glyph& glyph = font->GetGlyph(characterSize, Nz::TextStyle_Regular, character);
+
+					Nz::FontGlyph fontGlyph;
+					REQUIRE(font->ExtractGlyph(characterSize, character, Nz::TextStyle_Regular, &fontGlyph));
+
+					if (!glyph.valid || glyph.aabb != fontGlyph.aabb || glyph.advance != fontGlyph.advance)
+						matching = false;
+
+					unsigned int width = (glyph.flipped) ? glyph.atlasRect.height : glyph.atlasRect.width;
+					if (width != fontGlyph.image.GetWidth())
+						matching = false;
+				}
+
+				CHECK(matching);
+			}
+		}
+	}
+
+	GIVEN("The default font rendering distance fields")
+	{
+		const Nz::FontRef& font = Nz::Font::GetDefault();
+		REQUIRE(font.IsValid());
+
+		font->EnableDistanceField(true);
+		REQUIRE(font->IsDistanceFieldEnabled());
+
+		WHEN("We request the same glyph at two sizes")
+		{
+			Nz::Font::Glyph smallGlyph = font->GetGlyph(16, Nz::TextStyle_Regular, 'A');
+			Nz::Font::Glyph largeGlyph = font->GetGlyph(64, Nz::TextStyle_Regular, 'A');
+
+			THEN("Both sizes share a single distance field scaled to their size")
+			{
+				REQUIRE(smallGlyph.valid);
+				REQUIRE(largeGlyph.valid);
+
+				CHECK(smallGlyph.atlasRect == largeGlyph.atlasRect);
+				CHECK(smallGlyph.layerIndex == largeGlyph.layerIndex);
+				CHECK(largeGlyph.aabb.width > 3 * smallGlyph.aabb.width);
+				CHECK(largeGlyph.aabb.width < 5 * smallGlyph.aabb.width);
+				CHECK(largeGlyph.advance > smallGlyph.advance);
+			}
+		}
+
+		WHEN("We disable distance fields")
+		{
+			font->GetGlyph(32, Nz::TextStyle_Regular, 'A');
+			font->EnableDistanceField(false);
+
+			THEN("The glyph cache is cleared")
+			{
+				CHECK(font->GetCachedGlyphCount() == 0);
+			}
+		}
+
+		font->EnableDistanceField(false);
+	}
+}
@@ -0,0 +1,297 @@
+#include <Nazara/Utility/Image.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Catch/catch.hpp>
+#include <array>
+#include <vector>
+
+SCENARIO("Image", "[UTILITY][IMAGE]")
+{
+	GIVEN("A 8x8 RGBA8 image with black and white columns and a half transparent alpha")
+	{
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, 8, 8);
+
+		Nz::UInt8* pixels = image.GetPixels();
+		for (unsigned int i = 0; i < 8 * 8; ++i)
+		{
+			Nz::UInt8 value = (i % 2 == 0) ? 0 : 255;
+			pixels[i * 4 + 0] = value;
+			pixels[i * 4 + 1] = value;
+			pixels[i * 4 + 2] = value;
+			pixels[i * 4 + 3] = 128;
+		}
+
+		WHEN("We generate its mipmaps with a box filter")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::MipmapFilter_Box));
+
+			THEN("Every level is the average of the previous one")
+			{
+				REQUIRE(image.GetLevelCount() == Nz::Image::GetMaxLevel(8, 8));
+
+				for (Nz::UInt8 level = 1; level < image.GetLevelCount(); ++level)
+				{
+					const Nz::UInt8* levelPixels = image.GetConstPixels(0, 0, 0, level);
+					CHECK(image.GetWidth(level) == 8U >> level);
+					CHECK(int(levelPixels[0]) == 128);
+					CHECK(int(levelPixels[3]) == 128);
+				}
+			}
+		}
+
+		WHEN("We generate its mipmaps as sRGB")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::MipmapFilter_Box, true));
+
+			THEN("The colors are averaged in linear space, but not the alpha")
+			{
+				const Nz::UInt8* levelPixels = image.GetConstPixels(0, 0, 0, 1);
+				CHECK(int(levelPixels[0]) == 188);
+				CHECK(int(levelPixels[3]) == 128);
+			}
+		}
+
+		WHEN("We generate its mipmaps with a Kaiser filter")
+		{
+			REQUIRE(image.GenerateMipmaps(Nz::MipmapFilter_Kaiser));
+
+			THEN("An uniform alpha stays uniform")
+			{
+				const Nz::UInt8* levelPixels = image.GetConstPixels(0, 0, 0, 1);
+				for (unsigned int i = 0; i < 4 * 4; ++i)
+					CHECK(int(levelPixels[i * 4 + 3]) == 128);
+			}
+		}
+
+		WHEN("We compress it with its mipmaps")
+		{
+			REQUIRE(image.GenerateMipmaps());
+			REQUIRE(image.Convert(Nz::PixelFormatType_DXT5));
+
+			THEN("Every level is made of blocks")
+			{
+				CHECK(image.GetFormat() == Nz::PixelFormatType_DXT5);
+				CHECK(image.GetLevelCount() == Nz::Image::GetMaxLevel(8, 8));
+				CHECK(image.GetMemoryUsage(0) == 4 * 16);
+				CHECK(image.GetMemoryUsage(3) == 16);
+
+				// The half transparent alpha is an endpoint of the alpha block
+				CHECK(int(image.GetConstPixels()[0]) == 128);
+			}
+		}
+
+		WHEN("We save it as a KTX2 file and load it back")
+		{
+			REQUIRE(image.GenerateMipmaps());
+
+			Nz::ByteArray data;
+			Nz::MemoryStream stream(&data);
+			REQUIRE(image.SaveToStream(stream, "ktx2"));
+
+			stream.SetCursorPos(0);
+			Nz::Image loaded;
+			REQUIRE(loaded.LoadFromStream(stream));
+
+			THEN("The image and its levels are the same")
+			{
+				CHECK(loaded.GetType() == Nz::ImageType_2D);
+				CHECK(loaded.GetFormat() == Nz::PixelFormatType_RGBA8);
+				CHECK(loaded.GetLevelCount() == image.GetLevelCount());
+
+				for (Nz::UInt8 level = 0; level < loaded.GetLevelCount(); ++level)
+				{
+					const Nz::UInt8* pixels = image.GetConstPixels(0, 0, 0, level);
+					CHECK(std::equal(pixels, pixels + image.GetMemoryUsage(level), loaded.GetConstPixels(0, 0, 0, level)));
+				}
+			}
+		}
+	}
+
+	GIVEN("A cubemap with a different color per face")
+	{
+		Nz::Image cubemap(Nz::ImageType_Cubemap, Nz::PixelFormatType_L8, 4, 4);
+		for (unsigned int face = 0; face < 6; ++face)
+			std::fill(cubemap.GetPixels(0, 0, face), cubemap.GetPixels(0, 0, face) + 4 * 4, Nz::UInt8(face * 40));
+
+		WHEN("We generate its mipmaps")
+		{
+			REQUIRE(cubemap.GenerateMipmaps());
+
+			THEN("The faces are not mixed")
+			{
+				for (unsigned int face = 0; face < 6; ++face)
+					CHECK(int(*cubemap.GetConstPixels(0, 0, face, 1)) == int(face * 40));
+			}
+		}
+	}
+
+	GIVEN("A compressed image")
+	{
+		Nz::Image image(Nz::ImageType_2D, Nz::PixelFormatType_DXT1, 8, 8);
+
+		THEN("Mipmaps cannot be generated")
+		{
+			CHECK_FALSE(image.GenerateMipmaps());
+		}
+
+		THEN("It can be flipped")
+		{
+			CHECK(image.FlipHorizontally());
+			CHECK(image.FlipVertically());
+		}
+
+		THEN("It can be saved as a KTX2 file and loaded back")
+		{
+			Nz::ByteArray data;
+			Nz::MemoryStream stream(&data);
+			REQUIRE(image.SaveToStream(stream, "ktx2"));
+
+			stream.SetCursorPos(0);
+			Nz::Image loaded;
+			REQUIRE(loaded.LoadFromStream(stream));
+			CHECK(loaded.GetFormat() == Nz::PixelFormatType_DXT1);
+			CHECK(std::equal(image.GetConstPixels(), image.GetConstPixels() + image.GetMemoryUsage(0), loaded.GetConstPixels()));
+		}
+	}
+
+	GIVEN("A DDS file in memory")
+	{
+		// 8x8 with three levels, followed by the level data
+		auto BuildDDS = [](const char* fourCC, Nz::UInt32 dxgiFormat, std::size_t dataSize)
+		{
+			std::vector<Nz::UInt32> words(1 + 31, 0);
+			words[0] = 0x20534444;                     // "DDS "
+			words[1] = 124;                            // Header size
+			words[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000; // Caps, height, width, pixel format and mipmap count
+			words[3] = 8;                              // Height
+			words[4] = 8;                              // Width
+			words[7] = 3;                              // Level count
+			words[19] = 32;                            // Pixel format size
+			words[20] = 0x4;                           // Four CC
+			words[21] = Nz::UInt32(fourCC[0]) | Nz::UInt32(fourCC[1]) << 8 | Nz::UInt32(fourCC[2]) << 16 | Nz::UInt32(fourCC[3]) << 24;
+
+			if (dxgiFormat != 0)
+			{
+				words.push_back(dxgiFormat);
+				words.push_back(3);                    // 2D texture
+				words.push_back(0);
+				words.push_back(1);                    // Array size
+				words.push_back(0);
+			}
+
+			std::vector<Nz::UInt8> file;
+			for (Nz::UInt32 word : words)
+			{
+				for (unsigned int i = 0; i < 4; ++i)
+					file.push_back(static_cast<Nz::UInt8>(word >> (i * 8)));
+			}
+
+			for (std::size_t i = 0; i < dataSize; ++i)
+				file.push_back(static_cast<Nz::UInt8>(i));
+
+			return file;
+		};
+
+		WHEN("It holds DXT1 levels")
+		{
+			std::size_t dataSize = Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_DXT1, 8, 8, 1) + Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_DXT1, 4, 4, 1) + Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_DXT1, 2, 2, 1);
+			std::vector<Nz::UInt8> file = BuildDDS("DXT1", 0, dataSize);
+
+			THEN("A view points into the file without copying")
+			{
+				Nz::ImageView view;
+				REQUIRE(Nz::Image::LoadViewFromMemory(&view, file.data(), file.size()));
+				CHECK(view.type == Nz::ImageType_2D);
+				CHECK(view.format == Nz::PixelFormatType_DXT1);
+				CHECK(view.width == 8);
+				CHECK(view.height == 8);
+				REQUIRE(view.levels.size() == 3);
+				CHECK(view.levels[0] == file.data() + 128);
+				CHECK(view.levels[1] == file.data() + 128 + 32);
+				CHECK(view.levels[2] == file.data() + 128 + 32 + 8);
+			}
+
+			THEN("A view with a different load format is refused")
+			{
+				Nz::ImageParams params;
+				params.loadFormat = Nz::PixelFormatType_RGBA8;
+
+				Nz::ImageView view;
+				CHECK_FALSE(Nz::Image::LoadViewFromMemory(&view, file.data(), file.size(), params));
+			}
+
+			THEN("A truncated file is refused")
+			{
+				Nz::ImageView view;
+				CHECK_FALSE(Nz::Image::LoadViewFromMemory(&view, file.data(), file.size() - 1));
+			}
+
+			THEN("The image loader reads the same levels")
+			{
+				Nz::Image image;
+				REQUIRE(image.LoadFromMemory(file.data(), file.size()));
+				CHECK(image.GetLevelCount() == 3);
+				CHECK(std::equal(image.GetConstPixels(0, 0, 0, 1), image.GetConstPixels(0, 0, 0, 1) + 8, file.data() + 128 + 32));
+			}
+		}
+
+		WHEN("It holds DXT5 levels")
+		{
+			std::vector<Nz::UInt8> file = BuildDDS("DXT5", 0, 64 + 16 + 16);
+
+			THEN("They are identified as DXT5")
+			{
+				Nz::ImageView view;
+				REQUIRE(Nz::Image::LoadViewFromMemory(&view, file.data(), file.size()));
+				CHECK(view.format == Nz::PixelFormatType_DXT5);
+			}
+		}
+
+		WHEN("It holds BC7 levels behind a DX10 header")
+		{
+			std::vector<Nz::UInt8> file = BuildDDS("DX10", 98, 64 + 16 + 16); // DXGI_FORMAT_BC7_UNORM
+
+			THEN("They are identified as BC7")
+			{
+				Nz::ImageView view;
+				REQUIRE(Nz::Image::LoadViewFromMemory(&view, file.data(), file.size()));
+				CHECK(view.format == Nz::PixelFormatType_BC7);
+				REQUIRE(view.levels.size() == 3);
+				CHECK(view.levels[0] == file.data() + 148);
+			}
+		}
+	}
+	GIVEN("Image files decoded on the task scheduler workers")
+	{
+		std::array<Nz::String, 4> filePaths = {
+			"resources/Engine/Graphics/Bob lamp/bob_body.tga",
+			"resources/Engine/Graphics/Bob lamp/bob_head.tga",
+			"resources/Engine/Graphics/Bob lamp/lantern.tga",
+			"resources/Engine/Graphics/Nazara.png"
+		};
+
+		std::vector<Nz::ResourceRequest<Nz::Image>> requests;
+		for (const Nz::String& filePath : filePaths)
+			requests.push_back(Nz::ImageManager::GetAsync(filePath));
+
+		WHEN("We wait for them")
+		{
+			THEN("They match the images decoded synchronously")
+			{
+				for (std::size_t i = 0; i < filePaths.size(); ++i)
+				{
+					Nz::ImageRef image = requests[i].Wait();
+					REQUIRE(image.IsValid());
+
+					Nz::Image reference;
+					REQUIRE(reference.LoadFromFile(filePaths[i]));
+					REQUIRE(image->GetSize() == reference.GetSize());
+					CHECK(std::equal(reference.GetConstPixels(), reference.GetConstPixels() + reference.GetMemoryUsage(), image->GetConstPixels()));
+				}
+			}
+		}
+
+		Nz::ImageManager::Clear();
+	}
+}
@@ -0,0 +1,303 @@
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/MaterialData.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Nazara/Utility/VertexMapper.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+
+namespace
+{
+	template<typename T>
+	bool HaveSameContent(const T* bufferA, const T* bufferB, std::size_t size)
+	{
+		Nz::BufferMapper<T> mapperA(bufferA, Nz::BufferAccess_ReadOnly);
+		Nz::BufferMapper<T> mapperB(bufferB, Nz::BufferAccess_ReadOnly);
+
+		const Nz::UInt8* a = static_cast<const Nz::UInt8*>(mapperA.GetPointer());
+		const Nz::UInt8* b = static_cast<const Nz::UInt8*>(mapperB.GetPointer());
+		return std::equal(a, a + size, b);
+	}
+}
+
+SCENARIO("Mesh", "[UTILITY][MESH]")
+{
+	Nz::MeshParams params;
+	params.storage = Nz::DataStorage_Software;
+
+	GIVEN("A static mesh made of two boxes")
+	{
+		Nz::Mesh mesh;
+		REQUIRE(mesh.CreateStatic());
+		mesh.BuildSubMesh(Nz::Primitive::Box(Nz::Vector3f(1.f, 2.f, 3.f)), params);
+		mesh.BuildSubMesh(Nz::Primitive::Box(Nz::Vector3f(4.f), Nz::Vector3ui(2U), Nz::Vector3f(10.f, 0.f, 0.f)), params);
+		mesh.GetSubMesh(1)->SetMaterialIndex(1);
+
+		mesh.SetMaterialCount(2);
+		Nz::ParameterList matData;
+		matData.SetParameter(Nz::MaterialData::DiffuseTexturePath, "box.png");
+		matData.SetParameter(Nz::MaterialData::DiffuseColor, Nz::Color::Red);
+		matData.SetParameter(Nz::MaterialData::Shininess, 12.f);
+		matData.SetParameter(Nz::MaterialData::Lighting, false);
+		matData.SetParameter(Nz::MaterialData::CustomDefined);
+		mesh.SetMaterialData(1, matData);
+
+		WHEN("It is saved as a NMF file and loaded back")
+		{
+			Nz::ByteArray data;
+			Nz::MemoryStream stream(&data);
+			REQUIRE(mesh.SaveToStream(stream, "nmf", params));
+
+			Nz::Mesh loaded;
+			REQUIRE(loaded.LoadFromMemory(data.GetConstBuffer(), data.GetSize(), params));
+
+			THEN("Submeshes and their buffers are identical")
+			{
+				REQUIRE(loaded.GetAnimationType() == Nz::AnimationType_Static);
+				REQUIRE(loaded.GetSubMeshCount() == 2);
+
+				for (unsigned int i = 0; i < 2; ++i)
+				{
+					const Nz::StaticMesh* original = static_cast<const Nz::StaticMesh*>(mesh.GetSubMesh(i));
+					const Nz::StaticMesh* copy = static_cast<const Nz::StaticMesh*>(loaded.GetSubMesh(i));
+
+					CHECK(copy->GetMaterialIndex() == original->GetMaterialIndex());
+					CHECK(copy->GetPrimitiveMode() == original->GetPrimitiveMode());
+					CHECK(copy->GetAABB() == original->GetAABB());
+					REQUIRE(copy->GetVertexCount() == original->GetVertexCount());
+					CHECK(copy->GetVertexBuffer()->GetVertexDeclaration() == original->GetVertexBuffer()->GetVertexDeclaration());
+					CHECK(HaveSameContent(copy->GetVertexBuffer(), original->GetVertexBuffer(), original->GetVertexCount() * original->GetVertexBuffer()->GetStride()));
+
+					const Nz::IndexBuffer* indexBuffer = original->GetIndexBuffer();
+					REQUIRE(copy->GetIndexBuffer()->GetIndexCount() == indexBuffer->GetIndexCount());
+					CHECK(HaveSameContent(copy->GetIndexBuffer(), indexBuffer, indexBuffer->GetIndexCount() * indexBuffer->GetStride()));
+				}
+			}
+
+			THEN("Materials are restored")
+			{
+				REQUIRE(loaded.GetMaterialCount() == 2);
+
+				const Nz::ParameterList& loadedData = loaded.GetMaterialData(1);
+				CHECK(loadedData.GetParameterCount() == matData.GetParameterCount());
+
+				Nz::String path;
+				Nz::Color color;
+				float shininess;
+				bool lighting;
+				CHECK(loadedData.GetStringParameter(Nz::MaterialData::DiffuseTexturePath, &path));
+				CHECK(path == "box.png");
+				CHECK(loadedData.GetColorParameter(Nz::MaterialData::DiffuseColor, &color));
+				CHECK(color == Nz::Color::Red);
+				CHECK(loadedData.GetFloatParameter(Nz::MaterialData::Shininess, &shininess));
+				CHECK(shininess == 12.f);
+				CHECK(loadedData.GetBooleanParameter(Nz::MaterialData::Lighting, &lighting));
+				CHECK(!lighting);
+				CHECK(loadedData.HasParameter(Nz::MaterialData::CustomDefined));
+			}
+		}
+
+		WHEN("It is saved as an OBJ file and loaded back")
+		{
+			REQUIRE(mesh.SaveToFile("Test Export.obj", params));
+
+			Nz::Mesh loaded;
+			bool loadedFromFile = loaded.LoadFromFile("Test Export.obj", params);
+			Nz::File::Delete("Test Export.obj");
+			Nz::File::Delete("Test Export.mtl");
+			REQUIRE(loadedFromFile);
+
+			THEN("Submeshes have the same triangles")
+			{
+				REQUIRE(loaded.GetSubMeshCount() == 2);
+
+				// The loader orders submeshes by material, which here is also their original index
+				for (unsigned int i = 0; i < 2; ++i)
+				{
+					const Nz::StaticMesh* copy = static_cast<const Nz::StaticMesh*>(loaded.GetSubMesh(i));
+					REQUIRE(copy->GetMaterialIndex() < 2);
+
+					const Nz::StaticMesh* original = static_cast<const Nz::StaticMesh*>(mesh.GetSubMesh(copy->GetMaterialIndex()));
+					CHECK(copy->GetTriangleCount() == original->GetTriangleCount());
+					CHECK(copy->GetVertexCount() == original->GetVertexCount());
+
+					// Positions are written with six significant digits
+					Nz::VertexMapper vertexMapper(original);
+					Nz::Boxf aabb = Nz::ComputeAABB(vertexMapper.GetComponentPtr<const Nz::Vector3f>(Nz::VertexComponent_Position), original->GetVertexCount());
+					CHECK(copy->GetAABB().GetMinimum().SquaredDistance(aabb.GetMinimum()) < 0.0001f);
+					CHECK(copy->GetAABB().GetMaximum().SquaredDistance(aabb.GetMaximum()) < 0.0001f);
+				}
+			}
+		}
+	}
+
+	GIVEN("A skeletal mesh")
+	{
+		Nz::Mesh mesh;
+		REQUIRE(mesh.CreateSkeletal(2));
+
+		Nz::Skeleton* skeleton = mesh.GetSkeleton();
+		skeleton->GetJoint(0U)->SetName("root");
+		skeleton->GetJoint(1U)->SetName("child");
+		skeleton->GetJoint(1U)->SetParent(skeleton->GetJoint(0U));
+		skeleton->GetJoint(1U)->SetPosition(Nz::Vector3f(0.f, 1.f, 0.f));
+		skeleton->GetJoint(1U)->SetInverseBindMatrix(Nz::Matrix4f::Translate(Nz::Vector3f(0.f, -1.f, 0.f)));
+
+		Nz::VertexBufferRef vertexBuffer = Nz::VertexBuffer::New(Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ_Normal_UV_Tangent_Skinning), 3, params.storage, Nz::BufferUsage_Static);
+		{
+			Nz::BufferMapper<Nz::VertexBuffer> mapper(vertexBuffer, Nz::BufferAccess_DiscardAndWrite);
+			Nz::SkeletalMeshVertex* vertices = static_cast<Nz::SkeletalMeshVertex*>(mapper.GetPointer());
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				vertices[i] = Nz::SkeletalMeshVertex();
+				vertices[i].position = Nz::Vector3f(float(i), 0.f, 0.f);
+				vertices[i].weightCount = 1;
+				vertices[i].jointIndexes[0] = i % 2;
+				vertices[i].weights[0] = 1.f;
+			}
+		}
+
+		Nz::SkeletalMeshRef subMesh = Nz::SkeletalMesh::New(&mesh);
+		REQUIRE(subMesh->Create(vertexBuffer));
+		subMesh->SetAABB(Nz::Boxf(0.f, 0.f, 0.f, 2.f, 0.f, 0.f));
+		mesh.AddSubMesh(subMesh);
+
+		WHEN("It is saved as a NMF file and loaded back")
+		{
+			Nz::ByteArray data;
+			Nz::MemoryStream stream(&data);
+			REQUIRE(mesh.SaveToStream(stream, "nmf", params));
+
+			Nz::Mesh loaded;
+			REQUIRE(loaded.LoadFromMemory(data.GetConstBuffer(), data.GetSize(), params));
+
+			THEN("The skeleton and the vertices are restored")
+			{
+				REQUIRE(loaded.GetAnimationType() == Nz::AnimationType_Skeletal);
+				REQUIRE(loaded.GetJointCount() == 2);
+
+				const Nz::Joint* child = loaded.GetSkeleton()->GetJoint(1U);
+				CHECK(child->GetName() == "child");
+				CHECK(child->GetParent() == loaded.GetSkeleton()->GetJoint(0U));
+				CHECK(child->GetPosition(Nz::CoordSys_Local) == Nz::Vector3f(0.f, 1.f, 0.f));
+				CHECK(child->GetInverseBindMatrix() == Nz::Matrix4f::Translate(Nz::Vector3f(0.f, -1.f, 0.f)));
+
+				REQUIRE(loaded.GetSubMeshCount() == 1);
+				const Nz::SkeletalMesh* copy = static_cast<const Nz::SkeletalMesh*>(loaded.GetSubMesh(0));
+				CHECK(copy->GetAABB() == subMesh->GetAABB());
+				CHECK(copy->GetIndexBuffer() == nullptr);
+				CHECK(HaveSameContent(copy->GetVertexBuffer(), vertexBuffer.Get(), 3 * vertexBuffer->GetStride()));
+			}
+		}
+	}
+
+	GIVEN("A truncated NMF file")
+	{
+		Nz::Mesh mesh;
+		REQUIRE(mesh.CreateStatic());
+		mesh.BuildSubMesh(Nz::Primitive::Box(Nz::Vector3f(1.f)), params);
+
+		Nz::ByteArray data;
+		Nz::MemoryStream stream(&data);
+		REQUIRE(mesh.SaveToStream(stream, "nmf", params));
+
+		THEN("It is refused")
+		{
+			Nz::Mesh loaded;
+			CHECK_FALSE(loaded.LoadFromMemory(data.GetConstBuffer(), data.GetSize() / 2, params));
+		}
+	}
+
+	GIVEN("An OBJ file")
+	{
+		{
+			Nz::File file("Test Mesh.obj", Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+			REQUIRE(file.IsOpen());
+			file.Write("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvn 0 0 1\nf 1//1 2//1 3//1 4//1\nf 3//1 4//1 1//1\n");
+		}
+
+		WHEN("It is loaded from its path")
+		{
+			Nz::Mesh mesh;
+			bool loaded = mesh.LoadFromFile("Test Mesh.obj", params);
+			Nz::File::Delete("Test Mesh.obj");
+			REQUIRE(loaded);
+
+			THEN("Shared face vertices are merged")
+			{
+				REQUIRE(mesh.GetSubMeshCount() == 1);
+
+				const Nz::StaticMesh* subMesh = static_cast<const Nz::StaticMesh*>(mesh.GetSubMesh(0));
+				CHECK(subMesh->GetVertexCount() == 4);
+				CHECK(subMesh->GetIndexBuffer()->GetIndexCount() == 9);
+			}
+		}
+	}
+
+	GIVEN("A subdivided plane")
+	{
+		Nz::Mesh mesh;
+		REQUIRE(mesh.CreateStatic());
+
+		Nz::StaticMesh* subMesh = static_cast<Nz::StaticMesh*>(mesh.BuildSubMesh(Nz::Primitive::Plane(Nz::Vector2f(10.f), Nz::Vector2ui(5U)), params));
+		REQUIRE(subMesh);
+
+		WHEN("We generate levels of detail")
+		{
+			mesh.GenerateLevelsOfDetail(3, 0.5f, 0.25f);
+
+			THEN("Each level has fewer triangles than the previous one, none of them being flipped")
+			{
+				REQUIRE(subMesh->GetLevelOfDetailCount() == 4);
+
+				Nz::VertexMapper vertexMapper(subMesh, Nz::BufferAccess_ReadOnly);
+				Nz::SparsePtr<Nz::Vector3f> positionPtr = vertexMapper.GetComponentPtr<Nz::Vector3f>(Nz::VertexComponent_Position);
+
+				auto GetFacing = [&](const Nz::IndexMapper& indexMapper, unsigned int firstIndex)
+				{
+					Nz::Vector3f a = positionPtr[indexMapper.Get(firstIndex)];
+					Nz::Vector3f b = positionPtr[indexMapper.Get(firstIndex + 1)];
+					Nz::Vector3f c = positionPtr[indexMapper.Get(firstIndex + 2)];
+
+					return Nz::Vector3f::CrossProduct(b - a, c - a).y;
+				};
+
+				// All triangles of the plane share the orientation of the first one
+				float facing = GetFacing(Nz::IndexMapper(subMesh->GetIndexBuffer(0), Nz::BufferAccess_ReadOnly), 0);
+				REQUIRE(facing != 0.f);
+
+				for (unsigned int i = 1; i < subMesh->GetLevelOfDetailCount(); ++i)
+				{
+					const Nz::IndexBuffer* indexBuffer = subMesh->GetIndexBuffer(i);
+					CHECK(indexBuffer->GetIndexCount() < subMesh->GetIndexBuffer(i - 1)->GetIndexCount());
+					CHECK(subMesh->GetLevelOfDetailScreenSize(i) < subMesh->GetLevelOfDetailScreenSize(i - 1));
+
+					Nz::IndexMapper indexMapper(indexBuffer, Nz::BufferAccess_ReadOnly);
+
+					bool sameFacing = true;
+					for (unsigned int j = 0; j < indexBuffer->GetIndexCount(); j += 3)
+					{
+						if (GetFacing(indexMapper, j) * facing <= 0.f)
+							sameFacing = false;
+					}
+					CHECK(sameFacing);
+				}
+			}
+
+			THEN("The level is selected from the screen size")
+			{
+				CHECK(subMesh->SelectLevelOfDetail(1.f) == 0);
+				CHECK(subMesh->SelectLevelOfDetail(0.2f) == 1);
+				CHECK(subMesh->SelectLevelOfDetail(0.01f) == 3);
+			}
+		}
+	}
+}
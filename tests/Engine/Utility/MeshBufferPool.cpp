@@ -0,0 +1,113 @@
+#include <Nazara/Utility/MeshBufferPool.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	std::vector<Nz::UInt8> GetContent(const Nz::VertexBuffer* vertexBuffer)
+	{
+		Nz::BufferMapper<Nz::VertexBuffer> mapper(vertexBuffer, Nz::BufferAccess_ReadOnly);
+		const Nz::UInt8* data = static_cast<const Nz::UInt8*>(mapper.GetPointer());
+
+		return std::vector<Nz::UInt8>(data, data + vertexBuffer->GetVertexCount() * vertexBuffer->GetStride());
+	}
+}
+
+SCENARIO("MeshBufferPool", "[UTILITY][MESHBUFFERPOOL]")
+{
+	GIVEN("A pool of software buffers")
+	{
+		Nz::MeshBufferPool pool(Nz::DataStorage_Software, 64 * 1024);
+
+		Nz::MeshParams params;
+		params.storage = Nz::DataStorage_Software;
+
+		WHEN("Two meshes are stored")
+		{
+			Nz::Mesh mesh;
+			REQUIRE(mesh.CreateStatic());
+			mesh.BuildSubMesh(Nz::Primitive::Box(Nz::Vector3f(1.f)), params);
+			mesh.BuildSubMesh(Nz::Primitive::IcoSphere(1.f, 2), params);
+
+			Nz::StaticMesh* box = static_cast<Nz::StaticMesh*>(mesh.GetSubMesh(0));
+			Nz::StaticMesh* sphere = static_cast<Nz::StaticMesh*>(mesh.GetSubMesh(1));
+
+			std::vector<Nz::UInt8> boxVertices = GetContent(box->GetVertexBuffer());
+			std::vector<Nz::UInt8> sphereVertices = GetContent(sphere->GetVertexBuffer());
+			unsigned int boxIndexCount = box->GetIndexBuffer()->GetIndexCount();
+
+			REQUIRE(pool.Store(&mesh));
+
+			THEN("They share their buffers, with their content and whole vertices between them")
+			{
+				CHECK(pool.IsPooled(box->GetVertexBuffer()));
+				CHECK(pool.IsPooled(box->GetIndexBuffer()));
+				CHECK(box->GetVertexBuffer()->GetBuffer() == sphere->GetVertexBuffer()->GetBuffer());
+				CHECK(box->GetIndexBuffer()->GetBuffer() == sphere->GetIndexBuffer()->GetBuffer());
+				CHECK(pool.GetBlockCount() == 2);
+
+				CHECK(GetContent(box->GetVertexBuffer()) == boxVertices);
+				CHECK(GetContent(sphere->GetVertexBuffer()) == sphereVertices);
+				CHECK(box->GetIndexBuffer()->GetIndexCount() == boxIndexCount);
+
+				unsigned int stride = box->GetVertexBuffer()->GetStride();
+				CHECK(box->GetVertexBuffer()->GetStartOffset() % stride == 0);
+				CHECK(sphere->GetVertexBuffer()->GetStartOffset() % stride == 0);
+			}
+
+			AND_THEN("Storing them again changes nothing")
+			{
+				Nz::UInt64 usedSize = pool.GetUsedSize();
+				const Nz::IndexBuffer* indexBuffer = box->GetIndexBuffer();
+
+				REQUIRE(pool.Store(&mesh));
+				CHECK(pool.GetUsedSize() == usedSize);
+				CHECK(box->GetIndexBuffer() == indexBuffer);
+			}
+
+			AND_THEN("Destroying the mesh gives the ranges back")
+			{
+				mesh.Destroy();
+
+				CHECK(pool.GetUsedSize() == 0);
+				CHECK(pool.GetBlockCount() == 0);
+			}
+		}
+
+		WHEN("Ranges are freed and allocated again")
+		{
+			const Nz::VertexDeclaration* declaration = Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ);
+
+			Nz::VertexBufferRef first = pool.AllocateVertices(declaration, 100);
+			Nz::VertexBufferRef second = pool.AllocateVertices(declaration, 100);
+			Nz::VertexBufferRef third = pool.AllocateVertices(declaration, 100);
+			REQUIRE(first.IsValid());
+
+			unsigned int firstOffset = first->GetStartOffset();
+			first.Reset();
+			second.Reset();
+
+			THEN("Neighbour free ranges are merged")
+			{
+				Nz::VertexBufferRef merged = pool.AllocateVertices(declaration, 200);
+				CHECK(merged->GetStartOffset() == firstOffset);
+				CHECK(pool.GetBlockCount() == 1);
+			}
+
+			AND_THEN("Geometry bigger than a block gets its own")
+			{
+				Nz::VertexBufferRef big = pool.AllocateVertices(declaration, 10000);
+				REQUIRE(big.IsValid());
+				CHECK(big->GetVertexCount() == 10000);
+				CHECK(pool.GetBlockCount() == 2);
+
+				big.Reset();
+				CHECK(pool.GetBlockCount() == 1);
+			}
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/NodeHierarchy.hpp>
+#include <Catch/catch.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	bool IsMatching(const Nz::Node& node, const Nz::Node& referenceNode)
+	{
+		return node.GetPosition().SquaredDistance(referenceNode.GetPosition()) < 0.0001f &&
+		       std::abs(node.GetRotation().DotProduct(referenceNode.GetRotation())) > 0.9999f &&
+		       node.GetScale().SquaredDistance(referenceNode.GetScale()) < 0.0001f;
+	}
+}
+
+SCENARIO("Node", "[UTILITY][NODE]")
+{
+	GIVEN("A tree of nodes registered to a hierarchy and the same tree of plain nodes")
+	{
+		const unsigned int nodeCount = 200;
+
+		// Parents are created after their childs, so the hierarchy has to sort them
+		std::vector<std::unique_ptr<Nz::Node>> nodes;
+		std::vector<std::unique_ptr<Nz::Node>> referenceNodes;
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			nodes.emplace_back(new Nz::Node);
+			referenceNodes.emplace_back(new Nz::Node);
+		}
+
+		Nz::NodeHierarchy hierarchy;
+		for (unsigned int i = 0; i < nodeCount; ++i)
+		{
+			Nz::Node& node = *nodes[i];
+			Nz::Node& referenceNode = *referenceNodes[i];
+
+			unsigned int parent = nodeCount - 1 - (nodeCount - 1 - i) / 3;
+			if (parent != i)
+			{
+				node.SetParent(nodes[parent].get());
+				referenceNode.SetParent(referenceNodes[parent].get());
+			}
+
+			node.SetPosition(static_cast<float>(i % 7), 1.f, -0.5f);
+			node.SetRotation(Nz::EulerAnglesf(static_cast<float>(i % 11), 10.f, 0.f));
+			node.SetScale(1.f + (i % 3) * 0.1f);
+			referenceNode.SetPosition(node.GetPosition(Nz::CoordSys_Local));
+			referenceNode.SetRotation(node.GetRotation(Nz::CoordSys_Local));
+			referenceNode.SetScale(node.GetScale(Nz::CoordSys_Local));
+
+			hierarchy.Register(&node);
+		}
+
+		CHECK(hierarchy.GetNodeCount() == nodeCount);
+
+		Nz::Node& root = *nodes.back();
+		Nz::Node& referenceRoot = *referenceNodes.back();
+		Nz::Node& leaf = *nodes.front();
+		Nz::Node& referenceLeaf = *referenceNodes.front();
+
+		REQUIRE(leaf.GetParent() != nullptr);
+
+		WHEN("We update it")
+		{
+			hierarchy.Update();
+
+			THEN("Every node has the same transform as its reference")
+			{
+				bool matching = true;
+				for (unsigned int i = 0; i < nodeCount; ++i)
+				{
+					const Nz::Node& node = *nodes[i];
+					if (!IsMatching(node, *referenceNodes[i]) || node.GetTransformMatrix() != Nz::Matrix4f::Transform(node.GetPosition(), node.GetRotation(), node.GetScale()))
+						matching = false;
+				}
+
+				CHECK(matching);
+			}
+		}
+
+		WHEN("We move the root")
+		{
+			hierarchy.Update();
+
+			unsigned int invalidationCount = 0;
+			NazaraSlot(Nz::Node, OnNodeInvalidation, invalidationSlot);
+			invalidationSlot.Connect(leaf.OnNodeInvalidation, [&] (const Nz::Node*) { invalidationCount++; });
+
+			root.Move(Nz::Vector3f::UnitX() * 5.f);
+			root.Rotate(Nz::EulerAnglesf(0.f, 45.f, 0.f));
+			referenceRoot.Move(Nz::Vector3f::UnitX() * 5.f);
+			referenceRoot.Rotate(Nz::EulerAnglesf(0.f, 45.f, 0.f));
+
+			THEN("Descendants are only invalidated by the update")
+			{
+				CHECK(invalidationCount == 0);
+				CHECK(hierarchy.HasPendingInvalidations());
+
+				hierarchy.Update();
+				CHECK(invalidationCount == 1);
+				CHECK_FALSE(hierarchy.HasPendingInvalidations());
+				CHECK(IsMatching(leaf, referenceLeaf));
+			}
+
+			THEN("Descendants are up to date even before the update")
+			{
+				CHECK(IsMatching(leaf, referenceLeaf));
+				CHECK(leaf.GetTransformMatrix() == Nz::Matrix4f::Transform(leaf.GetPosition(), leaf.GetRotation(), leaf.GetScale()));
+			}
+		}
+
+		WHEN("We move every node at once")
+		{
+			hierarchy.Update();
+
+			unsigned int invalidationCount = 0;
+			NazaraSlot(Nz::Node, OnNodeInvalidation, invalidationSlot);
+			invalidationSlot.Connect(leaf.OnNodeInvalidation, [&] (const Nz::Node*) { invalidationCount++; });
+
+			std::vector<Nz::Node*> movedNodes;
+			std::vector<Nz::Vector3f> movements;
+			for (unsigned int i = 0; i < nodeCount; ++i)
+			{
+				movedNodes.push_back(nodes[i].get());
+				movements.emplace_back(static_cast<float>(i % 5), -1.f, 0.5f);
+
+				referenceNodes[i]->Move(movements.back());
+			}
+
+			// A node outside of the hierarchy is simply moved
+			Nz::Node freeNode;
+			movedNodes.push_back(&freeNode);
+			movements.push_back(Nz::Vector3f::UnitY());
+
+			Nz::Node::MoveNodes(movedNodes.data(), movements.data(), movedNodes.size());
+
+			THEN("Nodes have the same transform as their reference, and are signaled once by the update")
+			{
+				CHECK(freeNode.GetPosition() == Nz::Vector3f::UnitY());
+				CHECK(invalidationCount == 0);
+				CHECK(hierarchy.HasPendingInvalidations());
+				CHECK(IsMatching(leaf, referenceLeaf));
+
+				hierarchy.Update();
+				CHECK(invalidationCount == 1);
+				CHECK(root.GetTransformMatrix() == Nz::Matrix4f::Transform(root.GetPosition(), root.GetRotation(), root.GetScale()));
+
+				bool matching = true;
+				for (unsigned int i = 0; i < nodeCount; ++i)
+				{
+					if (!IsMatching(*nodes[i], *referenceNodes[i]))
+						matching = false;
+				}
+
+				CHECK(matching);
+			}
+		}
+
+		WHEN("We reparent and unregister nodes")
+		{
+			hierarchy.Update();
+
+			nodes[nodeCount / 2]->SetParent(nodes[1].get());
+			referenceNodes[nodeCount / 2]->SetParent(referenceNodes[1].get());
+
+			hierarchy.Unregister(nodes[nodeCount - 2].get());
+			nodes.erase(nodes.begin() + nodeCount - 3);
+			referenceNodes.erase(referenceNodes.begin() + nodeCount - 3);
+
+			root.Scale(2.f);
+			referenceRoot.Scale(2.f);
+
+			hierarchy.Update();
+
+			THEN("Every node still has the same transform as its reference")
+			{
+				CHECK(hierarchy.GetNodeCount() == nodeCount - 2);
+
+				bool matching = true;
+				for (std::size_t i = 0; i < nodes.size(); ++i)
+				{
+					if (!IsMatching(*nodes[i], *referenceNodes[i]))
+						matching = false;
+				}
+
+				CHECK(matching);
+			}
+		}
+	}
+}
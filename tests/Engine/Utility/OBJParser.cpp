@@ -0,0 +1,139 @@
+#include <Nazara/Utility/Formats/OBJParser.hpp>
+#include <Nazara/Core/MemoryView.hpp>
+#include <Catch/catch.hpp>
+#include <string>
+
+SCENARIO("OBJParser", "[UTILITY][OBJPARSER]")
+{
+	GIVEN("A small OBJ file")
+	{
+		const char source[] =
+			"# Comment\n"
+			"mtllib scene.mtl\n"
+			"v 1.0 2.5 -3\n"
+			"v 4 5 6 0.5\n"
+			"v -1e2 0.25e1 7\r\n"
+			"vt 0.5 0.75\n"
+			"vn 0 0 1\n"
+			"o Quad\n"
+			"usemtl Red\n"
+			"f 1/1/1 2/1/1 3/1/1 -1//-1\n"
+			"usemtl Blue\n"
+			"f -3 -2 -1\n";
+
+		WHEN("We parse it from memory")
+		{
+			Nz::OBJParser parser;
+			REQUIRE(parser.Parse(source, sizeof(source) - 1));
+
+			THEN("Vertex attributes are read")
+			{
+				REQUIRE(parser.GetPositionCount() == 3);
+				CHECK(parser.GetPositions()[0] == Nz::Vector4f(1.f, 2.5f, -3.f, 1.f));
+				CHECK(parser.GetPositions()[1] == Nz::Vector4f(4.f, 5.f, 6.f, 0.5f));
+				CHECK(parser.GetPositions()[2] == Nz::Vector4f(-100.f, 2.5f, 7.f, 1.f));
+
+				REQUIRE(parser.GetTexCoordCount() == 1);
+				CHECK(parser.GetTexCoords()[0].x == Approx(0.5f));
+				CHECK(parser.GetTexCoords()[0].y == Approx(0.75f));
+
+				REQUIRE(parser.GetNormalCount() == 1);
+				CHECK(parser.GetNormals()[0] == Nz::Vector3f::UnitZ());
+
+				CHECK(parser.GetMtlLib() == "scene.mtl");
+			}
+
+			THEN("Faces are split by material and their indices resolved")
+			{
+				REQUIRE(parser.GetMaterialCount() == 2);
+				REQUIRE(parser.GetMeshCount() == 2);
+
+				const Nz::OBJParser::Mesh* meshes = parser.GetMeshes();
+				for (unsigned int i = 0; i < 2; ++i)
+				{
+					REQUIRE(meshes[i].faces.size() == 1);
+					CHECK(meshes[i].name == "Quad");
+				}
+
+				const Nz::OBJParser::Mesh& quadMesh = (parser.GetMaterials()[meshes[0].material] == "Red") ? meshes[0] : meshes[1];
+				const Nz::OBJParser::Mesh& triangleMesh = (&quadMesh == &meshes[0]) ? meshes[1] : meshes[0];
+
+				REQUIRE(quadMesh.faces[0].vertexCount == 4);
+				const Nz::OBJParser::FaceVertex& last = quadMesh.vertices[quadMesh.faces[0].firstVertex + 3];
+				CHECK(last.position == 3);
+				CHECK(last.texCoord == 0);
+				CHECK(last.normal == 1);
+
+				REQUIRE(triangleMesh.faces[0].vertexCount == 3);
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					const Nz::OBJParser::FaceVertex& vertex = triangleMesh.vertices[triangleMesh.faces[0].firstVertex + i];
+					CHECK(vertex.position == i + 1);
+					CHECK(vertex.normal == 0);
+				}
+			}
+		}
+
+		WHEN("We parse it from a stream")
+		{
+			Nz::MemoryView stream(source, sizeof(source) - 1);
+
+			Nz::OBJParser parser;
+			REQUIRE(parser.Parse(stream));
+
+			THEN("We get the same result")
+			{
+				CHECK(parser.GetPositionCount() == 3);
+				CHECK(parser.GetMeshCount() == 2);
+			}
+		}
+	}
+
+	GIVEN("A big OBJ file")
+	{
+		// Large enough to be split into several chunks
+		const unsigned int vertexCount = 60000;
+
+		std::string source;
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			source += "v " + std::to_string(i) + " " + std::to_string(i) + ".5 -" + std::to_string(i) + "\n";
+
+		for (unsigned int i = 1; i + 2 <= vertexCount; i += 3)
+			source += "f " + std::to_string(i) + " " + std::to_string(i + 1) + " " + std::to_string(i + 2) + "\n";
+
+		WHEN("We parse it")
+		{
+			Nz::OBJParser parser;
+			REQUIRE(parser.Parse(source.data(), source.size()));
+
+			THEN("Every line is read in order")
+			{
+				REQUIRE(parser.GetPositionCount() == vertexCount);
+
+				bool positionsMatching = true;
+				const Nz::Vector4f* positions = parser.GetPositions();
+				for (unsigned int i = 0; i < vertexCount; ++i)
+				{
+					float value = static_cast<float>(i);
+					if (positions[i] != Nz::Vector4f(value, value + 0.5f, -value, 1.f))
+						positionsMatching = false;
+				}
+				CHECK(positionsMatching);
+
+				REQUIRE(parser.GetMeshCount() == 1);
+
+				const Nz::OBJParser::Mesh& mesh = parser.GetMeshes()[0];
+				REQUIRE(mesh.faces.size() == vertexCount / 3);
+
+				bool facesMatching = true;
+				for (std::size_t i = 0; i < mesh.faces.size(); ++i)
+				{
+					const Nz::OBJParser::Face& face = mesh.faces[i];
+					if (face.vertexCount != 3 || mesh.vertices[face.firstVertex].position != i * 3 + 1)
+						facesMatching = false;
+				}
+				CHECK(facesMatching);
+			}
+		}
+	}
+}
@@ -0,0 +1,618 @@
+#include <Nazara/Utility/PixelFormat.hpp>
+#include <Nazara/Core/CpuDispatch.hpp>
+#include <Catch/catch.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Gets the (r, g, b, a) components of a pixel, the naive way
+	void DecodePixel(Nz::PixelFormatType format, const Nz::UInt8* pixel, Nz::UInt8* rgba)
+	{
+		switch (format)
+		{
+			case Nz::PixelFormatType_BGR8:  rgba[0] = pixel[2]; rgba[1] = pixel[1]; rgba[2] = pixel[0]; rgba[3] = 0xFF;     break;
+			case Nz::PixelFormatType_BGRA8: rgba[0] = pixel[2]; rgba[1] = pixel[1]; rgba[2] = pixel[0]; rgba[3] = pixel[3]; break;
+			case Nz::PixelFormatType_RGB8:  rgba[0] = pixel[0]; rgba[1] = pixel[1]; rgba[2] = pixel[2]; rgba[3] = 0xFF;     break;
+			case Nz::PixelFormatType_RGBA8: rgba[0] = pixel[0]; rgba[1] = pixel[1]; rgba[2] = pixel[2]; rgba[3] = pixel[3]; break;
+			default:                        rgba[0] = pixel[0]; rgba[1] = pixel[0]; rgba[2] = pixel[0]; rgba[3] = 0xFF;     break;
+		}
+	}
+
+	void CheckConversions()
+	{
+		std::mt19937 randomEngine(42);
+
+		// Odd sizes to go through the remaining pixels of the SIMD implementations, the last one being split in bands
+		for (std::size_t pixelCount : {1U, 7U, 33U, 1000U, 200000U})
+		{
+			for (Nz::PixelFormatType srcFormat : {Nz::PixelFormatType_BGR8, Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_L8, Nz::PixelFormatType_RGB8, Nz::PixelFormatType_RGBA8})
+			{
+				std::size_t srcBpp = Nz::PixelFormat::GetBytesPerPixel(srcFormat);
+
+				std::vector<Nz::UInt8> source(pixelCount * srcBpp);
+				for (Nz::UInt8& byte : source)
+					byte = static_cast<Nz::UInt8>(randomEngine());
+
+				for (Nz::PixelFormatType dstFormat : {Nz::PixelFormatType_BGRA8, Nz::PixelFormatType_RGBA8})
+				{
+					if (srcFormat == dstFormat)
+						continue;
+
+					INFO(Nz::PixelFormat::GetName(srcFormat) << " to " << Nz::PixelFormat::GetName(dstFormat) << " (" << pixelCount << " pixels)");
+
+					std::vector<Nz::UInt8> converted(pixelCount * 4);
+					REQUIRE(Nz::PixelFormat::Convert(srcFormat, dstFormat, source.data(), source.data() + source.size(), converted.data()));
+
+					bool matching = true;
+					for (std::size_t i = 0; i < pixelCount; ++i)
+					{
+						Nz::UInt8 expected[4];
+						DecodePixel(srcFormat, &source[i * srcBpp], expected);
+
+						Nz::UInt8 obtained[4];
+						DecodePixel(dstFormat, &converted[i * 4], obtained);
+
+						if (!std::equal(expected, expected + 4, obtained))
+						{
+							matching = false;
+							break;
+						}
+					}
+
+					CHECK(matching);
+				}
+			}
+		}
+	}
+
+	const char* GetFlippingName(Nz::PixelFlipping flipping)
+	{
+		return (flipping == Nz::PixelFlipping_Horizontally) ? "horizontally" : "vertically";
+	}
+
+	void CheckFlipping()
+	{
+		std::mt19937 randomEngine(42);
+
+		// Odd width to go through the middle pixels of the SIMD implementations
+		const unsigned int width = 37;
+		const unsigned int height = 5;
+		const unsigned int depth = 2;
+
+		for (Nz::PixelFormatType format : {Nz::PixelFormatType_L8, Nz::PixelFormatType_RGB5A1, Nz::PixelFormatType_RGB8, Nz::PixelFormatType_RGBA8, Nz::PixelFormatType_RGB16F, Nz::PixelFormatType_RGBA16F})
+		{
+			std::size_t bpp = Nz::PixelFormat::GetBytesPerPixel(format);
+
+			std::vector<Nz::UInt8> source(width * height * depth * bpp);
+			for (Nz::UInt8& byte : source)
+				byte = static_cast<Nz::UInt8>(randomEngine());
+
+			for (Nz::PixelFlipping flipping : {Nz::PixelFlipping_Horizontally, Nz::PixelFlipping_Vertically})
+			{
+				INFO(Nz::PixelFormat::GetName(format) << " flipped " << GetFlippingName(flipping));
+
+				std::vector<Nz::UInt8> flipped(source.size());
+				REQUIRE(Nz::PixelFormat::Flip(flipping, format, width, height, depth, source.data(), flipped.data()));
+
+				std::vector<Nz::UInt8> flippedInPlace(source);
+				REQUIRE(Nz::PixelFormat::Flip(flipping, format, width, height, depth, flippedInPlace.data(), flippedInPlace.data()));
+				CHECK(flipped == flippedInPlace);
+
+				bool matching = true;
+				for (unsigned int z = 0; z < depth; ++z)
+				{
+					for (unsigned int y = 0; y < height; ++y)
+					{
+						for (unsigned int x = 0; x < width; ++x)
+						{
+							unsigned int srcX = (flipping == Nz::PixelFlipping_Horizontally) ? width - x - 1 : x;
+							unsigned int srcY = (flipping == Nz::PixelFlipping_Vertically) ? height - y - 1 : y;
+
+							const Nz::UInt8* expected = &source[((z * height + srcY) * width + srcX) * bpp];
+							if (!std::equal(expected, expected + bpp, &flipped[((z * height + y) * width + x) * bpp]))
+								matching = false;
+						}
+					}
+				}
+
+				CHECK(matching);
+			}
+		}
+	}
+
+	// Gets what describes a DXT texel: the endpoints of its blocks and its indices
+	Nz::UInt64 GetDXTTexel(Nz::PixelFormatType format, const Nz::UInt8* pixels, unsigned int width, unsigned int x, unsigned int y)
+	{
+		unsigned int blockSize = (format == Nz::PixelFormatType_DXT1) ? 8 : 16;
+		const Nz::UInt8* block = pixels + ((y / 4) * ((width + 3) / 4) + x / 4) * blockSize;
+		unsigned int texel = (y % 4) * 4 + x % 4;
+
+		Nz::UInt64 alpha = 0;
+		if (format == Nz::PixelFormatType_DXT3)
+		{
+			alpha = (block[texel / 2] >> (texel % 2) * 4) & 0xF;
+			block += 8;
+		}
+		else if (format == Nz::PixelFormatType_DXT5)
+		{
+			Nz::UInt64 alphaIndices = 0;
+			for (unsigned int i = 0; i < 6; ++i)
+				alphaIndices |= Nz::UInt64(block[2 + i]) << (i * 8);
+
+			alpha = block[0] | (block[1] << 8) | (((alphaIndices >> texel * 3) & 0x7) << 16);
+			block += 8;
+		}
+
+		Nz::UInt64 colors = block[0] | (block[1] << 8) | (block[2] << 16) | (Nz::UInt64(block[3]) << 24);
+		return (alpha << 34) | (colors << 2) | ((block[4 + y % 4] >> (x % 4) * 2) & 0x3);
+	}
+
+	void CheckDXTFlipping()
+	{
+		std::mt19937 randomEngine(42);
+
+		for (Nz::PixelFormatType format : {Nz::PixelFormatType_DXT1, Nz::PixelFormatType_DXT3, Nz::PixelFormatType_DXT5})
+		{
+			// The smallest mipmaps only use a part of their block
+			for (unsigned int size : {12U, 2U, 1U})
+			{
+				std::vector<Nz::UInt8> source(Nz::PixelFormat::ComputeSize(format, size, size, 1));
+				for (Nz::UInt8& byte : source)
+					byte = static_cast<Nz::UInt8>(randomEngine());
+
+				for (Nz::PixelFlipping flipping : {Nz::PixelFlipping_Horizontally, Nz::PixelFlipping_Vertically})
+				{
+					INFO(Nz::PixelFormat::GetName(format) << " of size " << size << " flipped " << GetFlippingName(flipping));
+
+					std::vector<Nz::UInt8> flipped(source);
+					REQUIRE(Nz::PixelFormat::Flip(flipping, format, size, size, 1, flipped.data(), flipped.data()));
+
+					bool matching = true;
+					for (unsigned int y = 0; y < size; ++y)
+					{
+						for (unsigned int x = 0; x < size; ++x)
+						{
+							unsigned int srcX = (flipping == Nz::PixelFlipping_Horizontally) ? size - x - 1 : x;
+							unsigned int srcY = (flipping == Nz::PixelFlipping_Vertically) ? size - y - 1 : y;
+							if (GetDXTTexel(format, flipped.data(), size, x, y) != GetDXTTexel(format, source.data(), size, srcX, srcY))
+								matching = false;
+						}
+					}
+
+					CHECK(matching);
+				}
+			}
+		}
+	}
+
+	// Reference decoders of the blocks we compress, written from the specifications
+	void DecodeColorBlock(const Nz::UInt8* block, Nz::UInt8* texels)
+	{
+		Nz::UInt16 colors[2] = {static_cast<Nz::UInt16>(block[0] | (block[1] << 8)), static_cast<Nz::UInt16>(block[2] | (block[3] << 8))};
+
+		int palette[4][3];
+		for (unsigned int i = 0; i < 2; ++i)
+		{
+			palette[i][0] = ((colors[i] >> 11) & 0x1F) * 255 / 31;
+			palette[i][1] = ((colors[i] >> 5) & 0x3F) * 255 / 63;
+			palette[i][2] = (colors[i] & 0x1F) * 255 / 31;
+		}
+
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			if (colors[0] > colors[1])
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+			else
+			{
+				palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+				palette[3][c] = 0;
+			}
+		}
+
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			unsigned int index = (block[4 + i / 4] >> (i % 4) * 2) & 0x3;
+			for (unsigned int c = 0; c < 3; ++c)
+				texels[i * 4 + c] = static_cast<Nz::UInt8>(palette[index][c]);
+		}
+	}
+
+	void DecodeChannelBlock(const Nz::UInt8* block, Nz::UInt8* texels, unsigned int channel)
+	{
+		int palette[8] = {block[0], block[1]};
+		for (unsigned int i = 1; i < 7; ++i)
+		{
+			if (block[0] > block[1])
+				palette[i + 1] = ((7 - i) * block[0] + i * block[1]) / 7;
+			else if (i < 5)
+				palette[i + 1] = ((5 - i) * block[0] + i * block[1]) / 5;
+			else
+				palette[i + 1] = (i == 5) ? 0 : 255;
+		}
+
+		Nz::UInt64 indices = 0;
+		for (unsigned int i = 0; i < 6; ++i)
+			indices |= Nz::UInt64(block[2 + i]) << (i * 8);
+
+		for (unsigned int i = 0; i < 16; ++i)
+			texels[i * 4 + channel] = static_cast<Nz::UInt8>(palette[(indices >> (i * 3)) & 0x7]);
+	}
+
+	Nz::UInt32 ReadBits(const Nz::UInt8* data, unsigned int& position, unsigned int bitCount)
+	{
+		Nz::UInt32 value = 0;
+		for (unsigned int i = 0; i < bitCount; ++i, ++position)
+			value |= ((data[position / 8] >> (position % 8)) & 1) << i;
+
+		return value;
+	}
+
+	bool DecodeBC7Block(const Nz::UInt8* block, Nz::UInt8* texels)
+	{
+		// Only the mode 6 is produced by our encoder
+		unsigned int position = 0;
+		if (ReadBits(block, position, 7) != (1 << 6))
+			return false;
+
+		int endpoints[2][4];
+		for (unsigned int c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] = ReadBits(block, position, 7) << 1;
+			endpoints[1][c] = ReadBits(block, position, 7) << 1;
+		}
+
+		for (unsigned int e = 0; e < 2; ++e)
+		{
+			int pBit = ReadBits(block, position, 1);
+			for (unsigned int c = 0; c < 4; ++c)
+				endpoints[e][c] |= pBit;
+		}
+
+		const int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			int weight = weights[ReadBits(block, position, (i == 0) ? 3 : 4)];
+			for (unsigned int c = 0; c < 4; ++c)
+				texels[i * 4 + c] = static_cast<Nz::UInt8>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+		}
+
+		return true;
+	}
+
+	Nz::UInt64 ReadBigEndian(const Nz::UInt8* block)
+	{
+		Nz::UInt64 bits = 0;
+		for (unsigned int i = 0; i < 8; ++i)
+			bits = (bits << 8) | block[i];
+
+		return bits;
+	}
+
+	Nz::UInt8 ClampToByte(int value)
+	{
+		return static_cast<Nz::UInt8>(std::min(std::max(value, 0), 255));
+	}
+
+	bool DecodeETC2Block(const Nz::UInt8* block, Nz::UInt8* texels)
+	{
+		// Alpha (EAC)
+		const int eacModifiers[16][8] = {
+			{-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12}, {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+			{-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},  {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+			{-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},   {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+			{-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},   {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}
+		};
+
+		Nz::UInt64 alphaBits = ReadBigEndian(block);
+		int base = static_cast<int>(alphaBits >> 56);
+		int multiplier = static_cast<int>((alphaBits >> 52) & 0xF);
+		unsigned int table = static_cast<unsigned int>((alphaBits >> 48) & 0xF);
+
+		// Color (individual and differential modes, those of ETC1)
+		const int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+		Nz::UInt64 colorBits = ReadBigEndian(block + 8);
+		bool differential = ((colorBits >> 33) & 1) != 0;
+		bool flip = ((colorBits >> 32) & 1) != 0;
+
+		int baseColors[2][3];
+		for (unsigned int c = 0; c < 3; ++c)
+		{
+			unsigned int shift = 56 - c * 8;
+			if (differential)
+			{
+				int color0 = static_cast<int>((colorBits >> (shift + 3)) & 0x1F);
+				int delta = static_cast<int>((colorBits >> shift) & 0x7);
+				int color1 = color0 + ((delta >= 4) ? delta - 8 : delta);
+				if (color1 < 0 || color1 > 31)
+					return false; // T, H or planar modes
+
+				baseColors[0][c] = (color0 << 3) | (color0 >> 2);
+				baseColors[1][c] = (color1 << 3) | (color1 >> 2);
+			}
+			else
+			{
+				baseColors[0][c] = static_cast<int>((colorBits >> (shift + 4)) & 0xF) * 17;
+				baseColors[1][c] = static_cast<int>((colorBits >> shift) & 0xF) * 17;
+			}
+		}
+
+		for (unsigned int y = 0; y < 4; ++y)
+		{
+			for (unsigned int x = 0; x < 4; ++x)
+			{
+				unsigned int position = x * 4 + y;
+				unsigned int subblock = ((flip) ? y : x) / 2;
+				unsigned int colorTable = static_cast<unsigned int>((colorBits >> ((subblock == 0) ? 37 : 34)) & 0x7);
+				unsigned int index = static_cast<unsigned int>((((colorBits >> (position + 16)) & 1) << 1) | ((colorBits >> position) & 1));
+				int modifier = etcModifiers[colorTable][index & 1];
+				if (index & 2)
+					modifier = -modifier;
+
+				Nz::UInt8* texel = &texels[(y * 4 + x) * 4];
+				for (unsigned int c = 0; c < 3; ++c)
+					texel[c] = ClampToByte(baseColors[subblock][c] + modifier);
+
+				unsigned int alphaIndex = static_cast<unsigned int>((alphaBits >> (45 - position * 3)) & 0x7);
+				texel[3] = ClampToByte(base + eacModifiers[table][alphaIndex] * multiplier);
+			}
+		}
+
+		return true;
+	}
+
+	bool DecodeBlock(Nz::PixelFormatType format, const Nz::UInt8* block, Nz::UInt8* texels)
+	{
+		switch (format)
+		{
+			case Nz::PixelFormatType_BC5:
+				DecodeChannelBlock(block, texels, 0);
+				DecodeChannelBlock(block + 8, texels, 1);
+				return true;
+
+			case Nz::PixelFormatType_BC7:
+				return DecodeBC7Block(block, texels);
+
+			case Nz::PixelFormatType_DXT1:
+				DecodeColorBlock(block, texels);
+				return true;
+
+			case Nz::PixelFormatType_DXT3:
+				for (unsigned int i = 0; i < 16; ++i)
+					texels[i * 4 + 3] = static_cast<Nz::UInt8>(((block[i / 2] >> (i % 2) * 4) & 0xF) * 17);
+
+				DecodeColorBlock(block + 8, texels);
+				return true;
+
+			case Nz::PixelFormatType_DXT5:
+				DecodeChannelBlock(block, texels, 3);
+				DecodeColorBlock(block + 8, texels);
+				return true;
+
+			case Nz::PixelFormatType_ETC2:
+				return DecodeETC2Block(block, texels);
+
+			default:
+				return false;
+		}
+	}
+
+	// Root mean square error of the compressed image, on the channels the format stores
+	double ComputeCompressionError(Nz::PixelFormatType format, const std::vector<Nz::UInt8>& pixels, unsigned int width, unsigned int height, const std::vector<Nz::UInt8>& compressed)
+	{
+		unsigned int channelCount = (format == Nz::PixelFormatType_BC5) ? 2 : (format == Nz::PixelFormatType_DXT1) ? 3 : 4;
+		std::size_t blockSize = Nz::PixelFormat::ComputeSize(format, 4, 4, 1);
+		unsigned int blockCount = (width + 3) / 4;
+
+		double totalError = 0.0;
+		for (unsigned int blockY = 0; blockY < (height + 3) / 4; ++blockY)
+		{
+			for (unsigned int blockX = 0; blockX < blockCount; ++blockX)
+			{
+				Nz::UInt8 texels[16 * 4] = {};
+				if (!DecodeBlock(format, &compressed[(blockY * blockCount + blockX) * blockSize], texels))
+					return 255.0;
+
+				for (unsigned int y = 0; y < 4 && blockY * 4 + y < height; ++y)
+				{
+					for (unsigned int x = 0; x < 4 && blockX * 4 + x < width; ++x)
+					{
+						const Nz::UInt8* pixel = &pixels[((blockY * 4 + y) * width + blockX * 4 + x) * 4];
+						for (unsigned int c = 0; c < channelCount; ++c)
+						{
+							double diff = double(texels[(y * 4 + x) * 4 + c]) - pixel[c];
+							totalError += diff * diff;
+						}
+					}
+				}
+			}
+		}
+
+		return std::sqrt(totalError / (width * height * channelCount));
+	}
+
+	void CheckCompression()
+	{
+		// Not a multiple of the block size, the partial blocks repeat the last texels
+		const unsigned int width = 37;
+		const unsigned int height = 21;
+
+		// Smooth gradients with a bit of noise, like most textures
+		std::mt19937 randomEngine(42);
+		std::uniform_int_distribution<int> noise(-4, 4);
+
+		std::vector<Nz::UInt8> pixels(width * height * 4);
+		for (unsigned int y = 0; y < height; ++y)
+		{
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				Nz::UInt8* pixel = &pixels[(y * width + x) * 4];
+				pixel[0] = ClampToByte(x * 255 / width + noise(randomEngine));
+				pixel[1] = ClampToByte(y * 255 / height + noise(randomEngine));
+				pixel[2] = ClampToByte(128 + (x + y) * 2 + noise(randomEngine));
+				pixel[3] = ClampToByte(255 - x * 4 + noise(randomEngine));
+			}
+		}
+
+		struct CompressionBound
+		{
+			Nz::PixelFormatType format;
+			double maxError;
+		};
+
+		// Colors vary along both axes, which the single line of BC7 mode 6 and DXT color blocks can only approximate
+		for (const CompressionBound& bound : {CompressionBound{Nz::PixelFormatType_BC5, 3.0}, CompressionBound{Nz::PixelFormatType_BC7, 6.0}, CompressionBound{Nz::PixelFormatType_DXT1, 7.0},
+		                                      CompressionBound{Nz::PixelFormatType_DXT3, 7.0}, CompressionBound{Nz::PixelFormatType_DXT5, 7.0}, CompressionBound{Nz::PixelFormatType_ETC2, 8.0}})
+		{
+			INFO(Nz::PixelFormat::GetName(bound.format));
+
+			REQUIRE(Nz::PixelFormat::IsCompressionSupported(bound.format));
+			REQUIRE(Nz::PixelFormat::IsConversionSupported(Nz::PixelFormatType_RGBA8, bound.format));
+
+			std::vector<Nz::UInt8> compressed(Nz::PixelFormat::ComputeSize(bound.format, width, height, 1));
+			REQUIRE(Nz::PixelFormat::Compress(bound.format, width, height, 1, pixels.data(), compressed.data()));
+
+			double error = ComputeCompressionError(bound.format, pixels, width, height, compressed);
+			INFO("Error: " << error);
+			CHECK(error < bound.maxError);
+
+			// Disabling the SIMD implementations doesn't change a bit
+			for (Nz::ProcessorCap cap : {Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+				Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+
+			std::vector<Nz::UInt8> genericCompressed(compressed.size());
+			REQUIRE(Nz::PixelFormat::Compress(bound.format, width, height, 1, pixels.data(), genericCompressed.data()));
+			CHECK(genericCompressed == compressed);
+
+			for (Nz::ProcessorCap cap : {Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+				Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+		}
+	}
+}
+
+SCENARIO("PixelFormat", "[UTILITY][PIXELFORMAT]")
+{
+	GIVEN("Buffers of random 8 bits pixels")
+	{
+		WHEN("We convert them to RGBA8 and BGRA8 with the best implementation")
+		{
+			THEN("The components are kept")
+			{
+				CheckConversions();
+			}
+		}
+
+		WHEN("We disable the SIMD capabilities one after another")
+		{
+			THEN("Every implementation gives the same results")
+			{
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSSE3, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+				{
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+					CheckConversions();
+				}
+
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_AVX2, Nz::ProcessorCap_SSSE3, Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+			}
+		}
+	}
+
+	GIVEN("Images of random pixels")
+	{
+		WHEN("We flip them, in place or not")
+		{
+			THEN("The pixels are mirrored")
+			{
+				CheckFlipping();
+			}
+		}
+
+		WHEN("We disable the SIMD capabilities")
+		{
+			THEN("The pixels are still mirrored")
+			{
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, false);
+
+				CheckFlipping();
+
+				for (Nz::ProcessorCap cap : {Nz::ProcessorCap_SSE2, Nz::ProcessorCap_NEON})
+					Nz::CpuDispatch::SetCapabilityEnabled(cap, true);
+			}
+		}
+	}
+
+	GIVEN("Random DXT images")
+	{
+		WHEN("We flip them")
+		{
+			THEN("The blocks and their texels are mirrored")
+			{
+				CheckDXTFlipping();
+			}
+		}
+
+		WHEN("They are BC5 images")
+		{
+			std::vector<Nz::UInt8> source(Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_BC5, 8, 8, 1));
+			for (std::size_t i = 0; i < source.size(); ++i)
+				source[i] = static_cast<Nz::UInt8>(i * 37);
+
+			THEN("Both channels are flipped")
+			{
+				std::vector<Nz::UInt8> flipped(source);
+				REQUIRE(Nz::PixelFormat::Flip(Nz::PixelFlipping_Vertically, Nz::PixelFormatType_BC5, 8, 8, 1, flipped.data(), flipped.data()));
+
+				// The first block ends up on the second block row
+				Nz::UInt8 expected[16 * 4] = {};
+				Nz::UInt8 obtained[16 * 4] = {};
+				DecodeBlock(Nz::PixelFormatType_BC5, &source[0], expected);
+				DecodeBlock(Nz::PixelFormatType_BC5, &flipped[2 * 16], obtained);
+
+				bool matching = true;
+				for (unsigned int y = 0; y < 4; ++y)
+				{
+					for (unsigned int x = 0; x < 4; ++x)
+					{
+						for (unsigned int c = 0; c < 2; ++c)
+						{
+							if (expected[(y * 4 + x) * 4 + c] != obtained[((3 - y) * 4 + x) * 4 + c])
+								matching = false;
+						}
+					}
+				}
+
+				CHECK(matching);
+			}
+		}
+
+		WHEN("Their size is not a multiple of the block size")
+		{
+			std::vector<Nz::UInt8> pixels(Nz::PixelFormat::ComputeSize(Nz::PixelFormatType_DXT1, 6, 6, 1));
+
+			THEN("They cannot be flipped")
+			{
+				CHECK_FALSE(Nz::PixelFormat::Flip(Nz::PixelFlipping_Horizontally, Nz::PixelFormatType_DXT1, 6, 6, 1, pixels.data(), pixels.data()));
+				CHECK_FALSE(Nz::PixelFormat::Flip(Nz::PixelFlipping_Vertically, Nz::PixelFormatType_DXT1, 6, 6, 1, pixels.data(), pixels.data()));
+			}
+		}
+	}
+
+	GIVEN("A RGBA8 image of gradients")
+	{
+		WHEN("We compress it to every block format")
+		{
+			THEN("The decoded blocks stay close to the pixels")
+			{
+				CheckCompression();
+			}
+		}
+	}
+}
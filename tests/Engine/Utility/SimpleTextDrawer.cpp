@@ -0,0 +1,65 @@
+#include <Nazara/Utility/SimpleTextDrawer.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("SimpleTextDrawer", "[UTILITY][SIMPLETEXTDRAWER]")
+{
+	GIVEN("A drawer with some text")
+	{
+		Nz::SimpleTextDrawer drawer = Nz::SimpleTextDrawer::Draw("Hello", 24);
+		REQUIRE(drawer.GetGlyphCount() == 5);
+
+		Nz::UInt64 revision = drawer.GetGlyphRevision();
+		CHECK(revision != Nz::AbstractTextDrawer::InvalidRevision);
+
+		Nz::Vector2f firstCorner = drawer.GetGlyph(0).corners[0];
+
+		WHEN("We append text to it")
+		{
+			drawer.AppendText(" world\n!");
+			drawer.SetText("Hello world\n!!");
+
+			THEN("The previous glyphes are kept and the new ones match a full layout")
+			{
+				CHECK(drawer.GetGlyphRevision() == revision);
+				CHECK(drawer.GetGlyph(0).corners[0] == firstCorner);
+
+				Nz::SimpleTextDrawer referenceDrawer = Nz::SimpleTextDrawer::Draw("Hello world\n!!", 24);
+				REQUIRE(drawer.GetGlyphCount() == referenceDrawer.GetGlyphCount());
+				CHECK(drawer.GetBounds() == referenceDrawer.GetBounds());
+
+				bool matching = true;
+				for (std::size_t i = 0; i < drawer.GetGlyphCount(); ++i)
+				{
+					const Nz::AbstractTextDrawer::Glyph& glyph = drawer.GetGlyph(i);
+					const Nz::AbstractTextDrawer::Glyph& referenceGlyph = referenceDrawer.GetGlyph(i);
+					for (unsigned int j = 0; j < 4; ++j)
+					{
+						if (glyph.corners[j] != referenceGlyph.corners[j])
+							matching = false;
+					}
+
+					if (glyph.atlasRect != referenceGlyph.atlasRect)
+						matching = false;
+				}
+
+				CHECK(matching);
+			}
+		}
+
+		WHEN("We replace its text or change its color")
+		{
+			drawer.SetText("Help");
+			Nz::UInt64 textRevision = drawer.GetGlyphRevision();
+
+			drawer.SetColor(Nz::Color::Red);
+			Nz::UInt64 colorRevision = drawer.GetGlyphRevision();
+
+			THEN("A new revision is given each time")
+			{
+				CHECK(textRevision != revision);
+				CHECK(colorRevision != textRevision);
+				CHECK(drawer.GetGlyph(0).color == Nz::Color::Red);
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Catch/catch.hpp>
+#include <cmath>
+
+namespace
+{
+	bool MatchesJoints(const Nz::Skeleton& skeleton)
+	{
+		const Nz::Matrix4f* skinningMatrices = skeleton.GetSkinningMatrices();
+		for (unsigned int i = 0; i < skeleton.GetJointCount(); ++i)
+		{
+			const Nz::Matrix4f& expected = skeleton.GetJoint(i)->GetSkinningMatrix();
+			for (unsigned int j = 0; j < 16; ++j)
+			{
+				if (std::abs(skinningMatrices[i][j] - expected[j]) > 0.0001f)
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+SCENARIO("Skeleton", "[UTILITY][SKELETON]")
+{
+	GIVEN("A skeleton whose childs are stored before their parents")
+	{
+		Nz::Skeleton skeleton;
+		REQUIRE(skeleton.Create(4));
+
+		// 3 -> 1 -> 0, 3 -> 2
+		Nz::Joint* root = skeleton.GetJoint(3);
+		skeleton.GetJoint(1)->SetParent(root);
+		skeleton.GetJoint(0)->SetParent(skeleton.GetJoint(1));
+		skeleton.GetJoint(2)->SetParent(root);
+
+		root->SetPosition(Nz::Vector3f(1.f, 2.f, 3.f));
+		root->SetRotation(Nz::EulerAnglesf(0.f, 90.f, 0.f));
+		root->SetScale(Nz::Vector3f(1.f, 2.f, 0.5f));
+
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			Nz::Joint* joint = skeleton.GetJoint(i);
+			joint->SetPosition(Nz::Vector3f(0.f, 1.f + i, 0.5f));
+			joint->SetRotation(Nz::EulerAnglesf(10.f * i, 0.f, 30.f));
+			joint->SetInverseBindMatrix(Nz::Matrix4f::Translate(Nz::Vector3f(-1.f, -2.f * i, 0.f)));
+		}
+
+		WHEN("We get its skinning matrices")
+		{
+			THEN("They match the ones of the joints")
+			{
+				CHECK(MatchesJoints(skeleton));
+			}
+		}
+
+		WHEN("We move a joint after getting them")
+		{
+			skeleton.GetSkinningMatrices();
+			skeleton.GetJoint(1)->Move(Nz::Vector3f(0.f, 0.f, 5.f));
+
+			THEN("They are updated")
+			{
+				CHECK(MatchesJoints(skeleton));
+			}
+		}
+
+		WHEN("We copy it and move the copy")
+		{
+			Nz::Skeleton copy(skeleton);
+			copy.GetJoint(3)->Move(Nz::Vector3f(5.f, 0.f, 0.f));
+
+			THEN("Only the copy is changed")
+			{
+				CHECK(MatchesJoints(copy));
+				CHECK(MatchesJoints(skeleton));
+				CHECK(copy.GetSkinningMatrices()[0].GetTranslation() != skeleton.GetSkinningMatrices()[0].GetTranslation());
+			}
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#include "LoadTest.hpp"
+#include <algorithm>
+#include <fstream>
+
+#ifdef NAZARA_PLATFORM_LINUX
+#include <unistd.h>
+#endif
+
+void Series::Print(std::FILE* file)
+{
+	if (m_samples.empty())
+	{
+		std::fprintf(file, "null");
+		return;
+	}
+
+	double mean = 0.0;
+	for (double sample : m_samples)
+		mean += sample;
+
+	mean /= m_samples.size();
+
+	std::sort(m_samples.begin(), m_samples.end());
+
+	std::size_t count = m_samples.size();
+	std::fprintf(file, "{\"samples\": %zu, \"mean\": %.3f, \"median\": %.3f, \"p99\": %.3f, \"max\": %.3f}", count, mean, m_samples[count / 2], m_samples[count * 99 / 100], m_samples.back());
+}
+
+Nz::UInt64 GetResidentMemory()
+{
+	#ifdef NAZARA_PLATFORM_LINUX
+	// Second field of statm is the resident set size, in pages
+	std::ifstream statm("/proc/self/statm");
+
+	Nz::UInt64 totalPages;
+	Nz::UInt64 residentPages;
+	if (statm >> totalPages >> residentPages)
+		return residentPages * static_cast<Nz::UInt64>(sysconf(_SC_PAGESIZE));
+	#endif
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef NAZARA_NETWORKLOAD_LOADTEST_HPP
+#define NAZARA_NETWORKLOAD_LOADTEST_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Network/RUdpConnection.hpp>
+#include <cstdio>
+#include <vector>
+
+struct LoadParameters
+{
+	Nz::RUdpConnection::SimulationParameters simulation; //< Applied to both ends, except the bandwidth which limits each peer
+	unsigned int duration = 10; //< Measured seconds
+	unsigned int messageSize = 64; //< Bytes, each message is echoed by the server
+	unsigned int peerCount = 1000;
+	unsigned int port = 64266;
+	unsigned int sendRate = 20; //< Messages sent by each peer per second
+	unsigned int tickRate = 60; //< Server updates per second
+	unsigned int warmup = 2; //< Seconds spent before measuring, once every peer is connected
+};
+
+class Series
+{
+	public:
+		Series() = default;
+
+		inline void Add(double sample);
+
+		inline bool IsEmpty() const;
+
+		void Print(std::FILE* file);
+
+	private:
+		std::vector<double> m_samples;
+};
+
+struct LoadResults
+{
+	Series ackLatency; //< Microseconds between the sending of a message and its acknowledgment (its echo with TCP)
+	Series roundTripTime; //< Microseconds, as estimated by the server for each peer (RUdp only)
+	Series tickTime; //< Microseconds spent by the server on a tick, handling messages included
+	Series updateTime; //< Microseconds spent by the server in Update (RUdp only)
+	Nz::UInt64 bytesReceived = 0; //< By the server
+	Nz::UInt64 bytesSent = 0; //< By the server
+	Nz::UInt64 connectedPeerCount = 0;
+	Nz::UInt64 echoesReceived = 0; //< By the peers
+	Nz::UInt64 messagesReceived = 0; //< By the server
+	Nz::UInt64 messagesSent = 0; //< By the peers
+	Nz::UInt64 packetsLost = 0; //< As detected by the server
+	Nz::UInt64 residentMemoryPerPeer = 0; //< Growth of the resident memory while the peers were connecting, zero if unknown
+	Nz::UInt64 tickCount = 0;
+	double connectionTime = 0.0; //< Seconds
+	double measuredTime = 0.0; //< Seconds
+};
+
+Nz::UInt64 GetResidentMemory();
+bool RunRUdpLoad(const LoadParameters& parameters, LoadResults* results);
+bool RunTcpLoad(const LoadParameters& parameters, LoadResults* results);
+
+inline void Series::Add(double sample)
+{
+	m_samples.push_back(sample);
+}
+
+inline bool Series::IsEmpty() const
+{
+	return m_samples.empty();
+}
+
+#endif // NAZARA_NETWORKLOAD_LOADTEST_HPP
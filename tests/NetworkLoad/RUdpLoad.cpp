@@ -0,0 +1,243 @@
+#include "LoadTest.hpp"
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Network/NetPacket.hpp>
+#include <Nazara/Network/RUdpConnection.hpp>
+#include <memory>
+
+namespace
+{
+	constexpr std::size_t SendTimeWindow = 1024; //< Messages a peer can wait an ack for, older ones are not measured
+	constexpr Nz::UInt64 MaxConnectionTime = 30'000'000; //< 30s
+
+	struct Peer
+	{
+		std::unique_ptr<Nz::RUdpConnection> connection;
+		std::vector<Nz::UInt64> sendTimes; //< Indexed by message id modulo the window, zero once acknowledged
+		Nz::IpAddress serverSideAddress;
+		Nz::UInt32 nextMessageId = 1;
+		double sendCredit = 0.0;
+		bool isConnected = false;
+	};
+
+	struct ServerTotals
+	{
+		Nz::UInt64 bytesReceived = 0;
+		Nz::UInt64 bytesSent = 0;
+		Nz::UInt64 packetsLost = 0;
+	};
+
+	ServerTotals GetServerTotals(const Nz::RUdpConnection& server, const std::vector<Peer>& peers, Series* roundTripTime)
+	{
+		ServerTotals totals;
+		for (const Peer& peer : peers)
+		{
+			Nz::RUdpConnection::PeerStatistics statistics;
+			if (!server.GetPeerStatistics(peer.serverSideAddress, &statistics))
+				continue;
+
+			totals.bytesReceived += statistics.bytesReceived;
+			totals.bytesSent += statistics.bytesSent;
+			totals.packetsLost += statistics.packetsLost;
+
+			if (roundTripTime)
+				roundTripTime->Add(statistics.roundTripTime);
+		}
+
+		return totals;
+	}
+}
+
+bool RunRUdpLoad(const LoadParameters& parameters, LoadResults* results)
+{
+	Nz::UInt16 port = static_cast<Nz::UInt16>(parameters.port);
+
+	Nz::RUdpConnection server;
+	if (!server.Listen(Nz::NetProtocol_IPv4, port))
+	{
+		std::fprintf(stderr, "Failed to listen on port %u\n", parameters.port);
+		return false;
+	}
+
+	Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+	serverAddress.SetPort(port);
+
+	Nz::Clock clock;
+	bool isMeasuring = false;
+
+	std::vector<Peer> peers(parameters.peerCount);
+	for (unsigned int i = 0; i < parameters.peerCount; ++i)
+	{
+		Peer* peer = &peers[i];
+		peer->connection = std::make_unique<Nz::RUdpConnection>();
+		if (!peer->connection->Listen(Nz::NetProtocol_IPv4, 0))
+		{
+			std::fprintf(stderr, "Failed to bind peer #%u, the file descriptor limit may be too low (see ulimit -n)\n", i);
+			return false;
+		}
+
+		peer->sendTimes.resize(SendTimeWindow, 0);
+
+		// The server receives datagrams from the loopback address
+		peer->serverSideAddress = Nz::IpAddress::LoopbackIpV4;
+		peer->serverSideAddress.SetPort(peer->connection->GetBoundPort());
+
+		peer->connection->OnConnectedToPeer.Connect([peer, results](Nz::RUdpConnection*)
+		{
+			peer->isConnected = true;
+			results->connectedPeerCount++;
+		});
+
+		peer->connection->OnMessageAcknowledged.Connect([peer, results, &clock, &isMeasuring](Nz::RUdpConnection*, const Nz::IpAddress&, Nz::UInt32 messageId)
+		{
+			Nz::UInt64& sendTime = peer->sendTimes[messageId % SendTimeWindow];
+			if (isMeasuring && sendTime != 0)
+				results->ackLatency.Add(static_cast<double>(clock.GetMicroseconds() - sendTime));
+
+			sendTime = 0;
+		});
+
+		peer->connection->Connect(serverAddress);
+	}
+
+	// Every peer sends the same message, the server echoes one of the same size
+	Nz::NetPacket message(1);
+	Nz::NetPacket echo(2);
+	for (unsigned int i = 0; i < parameters.messageSize; ++i)
+	{
+		message << static_cast<Nz::UInt8>(i);
+		echo << static_cast<Nz::UInt8>(i);
+	}
+
+	const double messagesPerTick = static_cast<double>(parameters.sendRate) / parameters.tickRate;
+	const Nz::UInt64 tickInterval = 1'000'000 / parameters.tickRate;
+
+	Nz::RUdpMessage receivedMessage;
+	auto Tick = [&](bool sendMessages)
+	{
+		for (Peer& peer : peers)
+		{
+			if (sendMessages && peer.isConnected)
+			{
+				peer.sendCredit += messagesPerTick;
+				for (; peer.sendCredit >= 1.0; peer.sendCredit -= 1.0)
+				{
+					Nz::UInt32 messageId = peer.nextMessageId++;
+					if (peer.nextMessageId == 0)
+						peer.nextMessageId = 1; //< Zero means the message is not tracked
+
+					peer.sendTimes[messageId % SendTimeWindow] = clock.GetMicroseconds();
+					peer.connection->Send(serverAddress, Nz::PacketPriority_Medium, Nz::PacketReliability_Reliable, message, messageId);
+
+					if (isMeasuring)
+						results->messagesSent++;
+				}
+			}
+
+			peer.connection->Update();
+
+			while (peer.connection->PollMessage(&receivedMessage))
+			{
+				if (isMeasuring)
+					results->echoesReceived++;
+			}
+		}
+
+		Nz::UInt64 tickStart = clock.GetMicroseconds();
+
+		server.Update();
+
+		Nz::UInt64 updateEnd = clock.GetMicroseconds();
+
+		while (server.PollMessage(&receivedMessage))
+		{
+			server.Send(receivedMessage.from, Nz::PacketPriority_Medium, Nz::PacketReliability_Unreliable, echo);
+
+			if (isMeasuring)
+				results->messagesReceived++;
+		}
+
+		Nz::UInt64 tickEnd = clock.GetMicroseconds();
+
+		if (isMeasuring)
+		{
+			results->tickTime.Add(static_cast<double>(tickEnd - tickStart));
+			results->updateTime.Add(static_cast<double>(updateEnd - tickStart));
+			results->tickCount++;
+		}
+	};
+
+	Nz::UInt64 nextTick = clock.GetMicroseconds();
+	auto WaitForNextTick = [&]()
+	{
+		// Late ticks are not caught up on, the tick count tells whether the rate could be sustained
+		nextTick += tickInterval;
+
+		Nz::UInt64 now = clock.GetMicroseconds();
+		if (now < nextTick)
+			Nz::Thread::Sleep(static_cast<Nz::UInt32>((nextTick - now) / 1000));
+		else
+			nextTick = now;
+	};
+
+	// Peers allocate their buffers on their first update, only the growth caused by the connections is measured
+	for (Peer& peer : peers)
+		peer.connection->Update();
+
+	Nz::UInt64 residentMemory = GetResidentMemory();
+
+	Nz::UInt64 connectionStart = clock.GetMicroseconds();
+	while (results->connectedPeerCount < parameters.peerCount && clock.GetMicroseconds() - connectionStart < MaxConnectionTime)
+	{
+		Tick(false);
+		WaitForNextTick();
+	}
+
+	results->connectionTime = (clock.GetMicroseconds() - connectionStart) / 1'000'000.0;
+
+	if (results->connectedPeerCount < parameters.peerCount)
+		std::fprintf(stderr, "Only %llu of %u peers connected\n", static_cast<unsigned long long>(results->connectedPeerCount), parameters.peerCount);
+
+	Nz::UInt64 connectedResidentMemory = GetResidentMemory();
+	if (residentMemory > 0 && results->connectedPeerCount > 0 && connectedResidentMemory > residentMemory)
+		results->residentMemoryPerPeer = (connectedResidentMemory - residentMemory) / results->connectedPeerCount;
+
+	// The handshake does not resend lost acks, the network is only degraded once the peers are connected
+	// Every peer has its own link to the server, the bandwidth of the server is not limited
+	for (Peer& peer : peers)
+		peer.connection->SimulateNetwork(parameters.simulation);
+
+	Nz::RUdpConnection::SimulationParameters serverSimulation = parameters.simulation;
+	serverSimulation.bandwidth = 0;
+	server.SimulateNetwork(serverSimulation);
+
+	Nz::UInt64 warmupEnd = clock.GetMicroseconds() + parameters.warmup * 1'000'000ULL;
+	while (clock.GetMicroseconds() < warmupEnd)
+	{
+		Tick(true);
+		WaitForNextTick();
+	}
+
+	ServerTotals totalsBefore = GetServerTotals(server, peers, nullptr);
+
+	isMeasuring = true;
+
+	Nz::UInt64 measureStart = clock.GetMicroseconds();
+	Nz::UInt64 measureEnd = measureStart + parameters.duration * 1'000'000ULL;
+	while (clock.GetMicroseconds() < measureEnd)
+	{
+		Tick(true);
+		WaitForNextTick();
+	}
+
+	results->measuredTime = (clock.GetMicroseconds() - measureStart) / 1'000'000.0;
+
+	isMeasuring = false;
+
+	ServerTotals totalsAfter = GetServerTotals(server, peers, &results->roundTripTime);
+	results->bytesReceived = totalsAfter.bytesReceived - totalsBefore.bytesReceived;
+	results->bytesSent = totalsAfter.bytesSent - totalsBefore.bytesSent;
+	results->packetsLost = totalsAfter.packetsLost - totalsBefore.packetsLost;
+
+	return true;
+}
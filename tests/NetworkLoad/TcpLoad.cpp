@@ -0,0 +1,227 @@
+#include "LoadTest.hpp"
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Nazara/Network/NetPacket.hpp>
+#include <Nazara/Network/SocketPoller.hpp>
+#include <Nazara/Network/TcpClient.hpp>
+#include <Nazara/Network/TcpServer.hpp>
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+	constexpr unsigned int ConnectionBatchSize = 64; //< Peers connecting before the server accepts them, so the listen queue does not overflow
+	constexpr Nz::UInt64 ConnectionTimeout = 3000; //< ms
+
+	struct Peer
+	{
+		std::unique_ptr<Nz::TcpClient> client;
+		double sendCredit = 0.0;
+		bool isConnected = false;
+	};
+}
+
+bool RunTcpLoad(const LoadParameters& parameters, LoadResults* results)
+{
+	Nz::UInt16 port = static_cast<Nz::UInt16>(parameters.port);
+
+	// Accepting stops once no connection is pending, and clients are read until they would block
+	Nz::TcpServer server;
+	server.EnableBlocking(false);
+	if (server.Listen(Nz::NetProtocol_IPv4, port, ConnectionBatchSize) != Nz::SocketState_Bound)
+	{
+		std::fprintf(stderr, "Failed to listen on port %u\n", parameters.port);
+		return false;
+	}
+
+	Nz::SocketPoller poller;
+	poller.RegisterSocket(server, Nz::SocketPollEvent_Read);
+
+	Nz::IpAddress serverAddress = Nz::IpAddress::LoopbackIpV4;
+	serverAddress.SetPort(port);
+
+	Nz::Clock clock;
+	bool isMeasuring = false;
+
+	// Messages start with their sending time, which the echo brings back
+	Nz::UInt32 messageSize = std::max<Nz::UInt32>(parameters.messageSize, sizeof(Nz::UInt64));
+
+	Nz::NetPacket echo;
+	Nz::NetPacket message;
+	Nz::NetPacket receivedPacket;
+	std::vector<std::unique_ptr<Nz::TcpClient>> serverClients;
+	serverClients.reserve(parameters.peerCount);
+
+	auto ServerTick = [&]()
+	{
+		Nz::UInt64 tickStart = clock.GetMicroseconds();
+
+		poller.Wait(0);
+		for (const Nz::SocketPoller::ReadySocket& readySocket : poller.GetReadySockets())
+		{
+			if (!readySocket.userdata)
+			{
+				// Readiness of the server, by pending connections
+				for (;;)
+				{
+					std::unique_ptr<Nz::TcpClient> serverClient = std::make_unique<Nz::TcpClient>();
+					serverClient->EnableBlocking(false);
+					serverClient->EnableLowDelay(true);
+					if (!server.AcceptClient(serverClient.get()))
+						break;
+
+					poller.RegisterSocket(*serverClient, Nz::SocketPollEvent_Read, Nz::SocketPollMode_LevelTriggered, serverClient.get());
+					serverClients.push_back(std::move(serverClient));
+				}
+
+				continue;
+			}
+
+			Nz::TcpClient* serverClient = static_cast<Nz::TcpClient*>(readySocket.userdata);
+			while (serverClient->ReceivePacket(&receivedPacket))
+			{
+				echo.Reset(2, receivedPacket.GetConstData() + Nz::NetPacket::HeaderSize, receivedPacket.GetDataSize());
+				serverClient->SendPacket(echo);
+
+				if (isMeasuring)
+				{
+					results->bytesReceived += receivedPacket.GetDataSize() + Nz::NetPacket::HeaderSize;
+					results->bytesSent += echo.GetDataSize() + Nz::NetPacket::HeaderSize;
+					results->messagesReceived++;
+				}
+			}
+
+			if (serverClient->GetState() == Nz::SocketState_NotConnected)
+				poller.UnregisterSocket(*serverClient);
+		}
+
+		if (isMeasuring)
+		{
+			results->tickTime.Add(static_cast<double>(clock.GetMicroseconds() - tickStart));
+			results->tickCount++;
+		}
+	};
+
+	Nz::UInt64 residentMemory = GetResidentMemory();
+
+	Nz::UInt64 connectionStart = clock.GetMicroseconds();
+
+	std::vector<Peer> peers(parameters.peerCount);
+	for (unsigned int i = 0; i < parameters.peerCount; ++i)
+	{
+		Peer& peer = peers[i];
+		peer.client = std::make_unique<Nz::TcpClient>();
+		peer.client->EnableLowDelay(true);
+
+		if (peer.client->Connect(serverAddress) == Nz::SocketState_NotConnected)
+		{
+			std::fprintf(stderr, "Failed to connect peer #%u, the file descriptor limit may be too low (see ulimit -n)\n", i);
+			return false;
+		}
+
+		if ((i + 1) % ConnectionBatchSize != 0 && i + 1 != parameters.peerCount)
+			continue;
+
+		// The connection of a whole batch is established by the system, accepting it is up to the server
+		for (unsigned int j = i - i % ConnectionBatchSize; j <= i; ++j)
+		{
+			Peer& batchPeer = peers[j];
+			if (batchPeer.client->WaitForConnected(ConnectionTimeout))
+			{
+				batchPeer.client->EnableBlocking(false);
+				batchPeer.isConnected = true;
+				results->connectedPeerCount++;
+			}
+		}
+
+		ServerTick();
+	}
+
+	while (serverClients.size() < results->connectedPeerCount && clock.GetMicroseconds() - connectionStart < ConnectionTimeout * 1000)
+		ServerTick();
+
+	results->connectionTime = (clock.GetMicroseconds() - connectionStart) / 1'000'000.0;
+
+	if (results->connectedPeerCount < parameters.peerCount)
+		std::fprintf(stderr, "Only %llu of %u peers connected\n", static_cast<unsigned long long>(results->connectedPeerCount), parameters.peerCount);
+
+	Nz::UInt64 connectedResidentMemory = GetResidentMemory();
+	if (residentMemory > 0 && results->connectedPeerCount > 0 && connectedResidentMemory > residentMemory)
+		results->residentMemoryPerPeer = (connectedResidentMemory - residentMemory) / results->connectedPeerCount;
+
+	const double messagesPerTick = static_cast<double>(parameters.sendRate) / parameters.tickRate;
+	const Nz::UInt64 tickInterval = 1'000'000 / parameters.tickRate;
+
+	auto Tick = [&]()
+	{
+		for (Peer& peer : peers)
+		{
+			if (!peer.isConnected)
+				continue;
+
+			peer.sendCredit += messagesPerTick;
+			for (; peer.sendCredit >= 1.0; peer.sendCredit -= 1.0)
+			{
+				message.Reset(1, messageSize);
+				message << clock.GetMicroseconds();
+				message.Resize(Nz::NetPacket::HeaderSize + messageSize);
+
+				peer.client->SendPacket(message);
+
+				if (isMeasuring)
+					results->messagesSent++;
+			}
+
+			while (peer.client->ReceivePacket(&receivedPacket))
+			{
+				Nz::UInt64 sendTime;
+				receivedPacket >> sendTime;
+
+				if (isMeasuring)
+				{
+					results->ackLatency.Add(static_cast<double>(clock.GetMicroseconds() - sendTime));
+					results->echoesReceived++;
+				}
+			}
+
+			if (peer.client->GetState() == Nz::SocketState_NotConnected)
+				peer.isConnected = false;
+		}
+
+		ServerTick();
+	};
+
+	Nz::UInt64 nextTick = clock.GetMicroseconds();
+	auto WaitForNextTick = [&]()
+	{
+		// Late ticks are not caught up on, the tick count tells whether the rate could be sustained
+		nextTick += tickInterval;
+
+		Nz::UInt64 now = clock.GetMicroseconds();
+		if (now < nextTick)
+			Nz::Thread::Sleep(static_cast<Nz::UInt32>((nextTick - now) / 1000));
+		else
+			nextTick = now;
+	};
+
+	Nz::UInt64 warmupEnd = clock.GetMicroseconds() + parameters.warmup * 1'000'000ULL;
+	while (clock.GetMicroseconds() < warmupEnd)
+	{
+		Tick();
+		WaitForNextTick();
+	}
+
+	isMeasuring = true;
+
+	Nz::UInt64 measureStart = clock.GetMicroseconds();
+	Nz::UInt64 measureEnd = measureStart + parameters.duration * 1'000'000ULL;
+	while (clock.GetMicroseconds() < measureEnd)
+	{
+		Tick();
+		WaitForNextTick();
+	}
+
+	results->measuredTime = (clock.GetMicroseconds() - measureStart) / 1'000'000.0;
+
+	return true;
+}
@@ -0,0 +1,202 @@
+#include "LoadTest.hpp"
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Network/Network.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Connects many peers to a server over the loopback, each one sending messages the server echoes, and writes the measures as JSON on the standard output
+// Usage: NetworkLoad [--protocol=rudp|tcp] [--peers=<count>] [--duration=<s>] [--warmup=<s>] [--port=<port>]
+//                    [--message-size=<bytes>] [--send-rate=<messages per s>] [--tick-rate=<ticks per s>]
+//                    [--latency=<ms>] [--jitter=<ms>] [--loss=<ratio>] [--reorder=<ratio>] [--bandwidth=<bytes per s>]
+//
+// Peers and server share the process (and its thread), every peer has its own socket: the file descriptor limit has to be raised for thousands of them.
+// The network simulation only applies to RUdp: latency, jitter, loss and reordering apply to both ends, the bandwidth limits what each peer receives.
+// With TCP, the ack latency is the time before the echo comes back.
+
+namespace
+{
+	struct Options
+	{
+		LoadParameters load;
+		std::string protocol = "rudp";
+	};
+
+	bool ParseOptions(int argc, char* argv[], Options* options)
+	{
+		struct UIntOption
+		{
+			const char* prefix;
+			unsigned int* value;
+		};
+
+		struct MsOption
+		{
+			const char* prefix;
+			Nz::UInt32* value; //< In microseconds
+		};
+
+		struct RatioOption
+		{
+			const char* prefix;
+			double* value;
+		};
+
+		LoadParameters& load = options->load;
+
+		UIntOption uintOptions[] = {
+			{"--duration=",     &load.duration},
+			{"--message-size=", &load.messageSize},
+			{"--peers=",        &load.peerCount},
+			{"--port=",         &load.port},
+			{"--send-rate=",    &load.sendRate},
+			{"--tick-rate=",    &load.tickRate},
+			{"--warmup=",       &load.warmup}
+		};
+
+		MsOption msOptions[] = {
+			{"--jitter=",  &load.simulation.jitter},
+			{"--latency=", &load.simulation.latency}
+		};
+
+		RatioOption ratioOptions[] = {
+			{"--loss=",    &load.simulation.packetLoss},
+			{"--reorder=", &load.simulation.reorderProbability}
+		};
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+
+			bool found = false;
+			for (const UIntOption& option : uintOptions)
+			{
+				std::size_t length = std::strlen(option.prefix);
+				if (std::strncmp(arg, option.prefix, length) == 0)
+				{
+					*option.value = static_cast<unsigned int>(std::strtoul(arg + length, nullptr, 10));
+					found = true;
+					break;
+				}
+			}
+
+			for (const MsOption& option : msOptions)
+			{
+				std::size_t length = std::strlen(option.prefix);
+				if (!found && std::strncmp(arg, option.prefix, length) == 0)
+				{
+					*option.value = static_cast<Nz::UInt32>(std::strtod(arg + length, nullptr) * 1000.0);
+					found = true;
+				}
+			}
+
+			for (const RatioOption& option : ratioOptions)
+			{
+				std::size_t length = std::strlen(option.prefix);
+				if (!found && std::strncmp(arg, option.prefix, length) == 0)
+				{
+					*option.value = std::strtod(arg + length, nullptr);
+					found = true;
+				}
+			}
+
+			if (found)
+				continue;
+
+			if (std::strncmp(arg, "--bandwidth=", 12) == 0)
+				load.simulation.bandwidth = static_cast<Nz::UInt32>(std::strtoul(arg + 12, nullptr, 10));
+			else if (std::strncmp(arg, "--protocol=", 11) == 0)
+				options->protocol = arg + 11;
+			else
+			{
+				std::fprintf(stderr, "Unknown argument: %s\n", arg);
+				return false;
+			}
+		}
+
+		if (options->protocol != "rudp" && options->protocol != "tcp")
+		{
+			std::fprintf(stderr, "Unknown protocol: %s\n", options->protocol.c_str());
+			return false;
+		}
+
+		if (load.peerCount == 0 || load.duration == 0 || load.tickRate == 0 || load.port == 0 || load.port > 0xFFFF)
+		{
+			std::fprintf(stderr, "Peer count, duration and tick rate must be over zero, and port must be valid\n");
+			return false;
+		}
+
+		if (load.simulation.packetLoss < 0.0 || load.simulation.packetLoss > 1.0 || load.simulation.reorderProbability < 0.0 || load.simulation.reorderProbability > 1.0)
+		{
+			std::fprintf(stderr, "Loss and reorder ratios must be in range [0..1]\n");
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseOptions(argc, argv, &options))
+		return EXIT_FAILURE;
+
+	// The standard output only receives the results, the log file still receives the messages once the modules are initialized
+	Nz::Log::Enable(false);
+
+	Nz::Initializer<Nz::Network> network;
+	if (!network)
+	{
+		std::fprintf(stderr, "Failed to initialize the network module\n");
+		return EXIT_FAILURE;
+	}
+
+	Nz::Log::Enable(true);
+	Nz::Log::GetLogger()->EnableStdReplication(false);
+
+	const LoadParameters& load = options.load;
+
+	LoadResults results;
+	bool succeeded = (options.protocol == "rudp") ? RunRUdpLoad(load, &results) : RunTcpLoad(load, &results);
+	if (!succeeded)
+		return EXIT_FAILURE;
+
+	double measuredTime = results.measuredTime;
+
+	std::printf("{\n");
+	std::printf("\t\"protocol\": \"%s\",\n", options.protocol.c_str());
+	std::printf("\t\"peers\": %u,\n\t\"connected_peers\": %llu,\n\t\"connection_s\": %.3f,\n", load.peerCount, static_cast<unsigned long long>(results.connectedPeerCount), results.connectionTime);
+	std::printf("\t\"message_size\": %u,\n\t\"send_rate\": %u,\n", load.messageSize, load.sendRate);
+	std::printf("\t\"simulation\": {\"latency_us\": %u, \"jitter_us\": %u, \"loss\": %.4f, \"reorder\": %.4f, \"bandwidth\": %u},\n",
+	            load.simulation.latency, load.simulation.jitter, load.simulation.packetLoss, load.simulation.reorderProbability, load.simulation.bandwidth);
+	std::printf("\t\"measured_s\": %.3f,\n\t\"tick_rate\": {\"target\": %u, \"achieved\": %.3f},\n", measuredTime, load.tickRate, results.tickCount / measuredTime);
+
+	std::printf("\t\"server_update_us\": ");
+	results.updateTime.Print(stdout);
+	std::printf(",\n\t\"server_tick_us\": ");
+	results.tickTime.Print(stdout);
+
+	std::printf(",\n\t\"throughput\": {\"messages_sent_per_s\": %.1f, \"messages_received_per_s\": %.1f, \"echoes_received_per_s\": %.1f, \"server_bytes_in_per_s\": %.1f, \"server_bytes_out_per_s\": %.1f},\n",
+	            results.messagesSent / measuredTime, results.messagesReceived / measuredTime, results.echoesReceived / measuredTime,
+	            results.bytesReceived / measuredTime, results.bytesSent / measuredTime);
+
+	std::printf("\t\"ack_latency_us\": ");
+	results.ackLatency.Print(stdout);
+	std::printf(",\n\t\"round_trip_us\": ");
+	results.roundTripTime.Print(stdout);
+	std::printf(",\n\t\"packets_lost\": %llu,\n", static_cast<unsigned long long>(results.packetsLost));
+
+	if (results.residentMemoryPerPeer > 0)
+		std::printf("\t\"resident_memory_per_peer\": %llu\n", static_cast<unsigned long long>(results.residentMemoryPerPeer));
+	else
+		std::printf("\t\"resident_memory_per_peer\": null\n");
+
+	std::printf("}\n");
+
+	Nz::Log::Enable(false);
+
+	return EXIT_SUCCESS;
+}
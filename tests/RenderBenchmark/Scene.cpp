@@ -0,0 +1,486 @@
+#include "Scene.hpp"
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Graphics/AbstractRenderQueue.hpp>
+#include <Nazara/Graphics/Model.hpp>
+#include <Nazara/Graphics/ParticleMapper.hpp>
+#include <Nazara/Graphics/Sprite.hpp>
+#include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Utility/BufferMapper.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/SimpleTextDrawer.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/VertexDeclaration.hpp>
+#include <NDK/Components/CameraComponent.hpp>
+#include <NDK/Components/GraphicsComponent.hpp>
+#include <NDK/Components/LightComponent.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Every object lies in this box, in front of the camera
+	constexpr float s_sceneHalfSize = 100.f;
+	constexpr float s_sceneHeight = 20.f;
+
+	Nz::Vector3f RandomPosition(std::mt19937& randomGenerator)
+	{
+		std::uniform_real_distribution<float> horizontal(-s_sceneHalfSize, s_sceneHalfSize);
+		std::uniform_real_distribution<float> vertical(0.f, s_sceneHeight);
+
+		// Evaluation order of the arguments is unspecified, keep the draws in sequence
+		float x = horizontal(randomGenerator);
+		float y = vertical(randomGenerator);
+		float z = horizontal(randomGenerator);
+
+		return Nz::Vector3f(x, y, z);
+	}
+
+	Nz::Color RandomColor(std::mt19937& randomGenerator)
+	{
+		std::uniform_int_distribution<int> component(64, 255);
+
+		Nz::UInt8 r = static_cast<Nz::UInt8>(component(randomGenerator));
+		Nz::UInt8 g = static_cast<Nz::UInt8>(component(randomGenerator));
+		Nz::UInt8 b = static_cast<Nz::UInt8>(component(randomGenerator));
+
+		return Nz::Color(r, g, b);
+	}
+}
+
+Scene::Scene(const SceneParameters& parameters, const Nz::RenderTarget* target) :
+m_parameters(parameters),
+m_frameIndex(0)
+{
+	std::mt19937 randomGenerator(parameters.seed);
+
+	BuildStaticModels(randomGenerator);
+	BuildSkinnedModels(randomGenerator);
+	BuildLights(randomGenerator);
+	BuildParticleSystems(randomGenerator);
+	BuildSprites(randomGenerator);
+	BuildTexts(randomGenerator);
+
+	Ndk::EntityHandle camera = m_world.CreateEntity();
+
+	Ndk::NodeComponent& cameraNode = camera->AddComponent<Ndk::NodeComponent>();
+	cameraNode.SetPosition(0.f, 40.f, 1.5f * s_sceneHalfSize);
+	cameraNode.SetRotation(Nz::EulerAnglesf(-20.f, 0.f, 0.f));
+
+	Ndk::CameraComponent& cameraComponent = camera->AddComponent<Ndk::CameraComponent>();
+	cameraComponent.SetTarget(target);
+	cameraComponent.SetZFar(1000.f);
+	cameraComponent.SetZNear(0.1f);
+}
+
+void Scene::Animate(float elapsedTime)
+{
+	NazaraProfileZone("Scene::Animate");
+
+	for (const std::unique_ptr<Nz::SkeletalModel>& model : m_skinnedModels)
+		model->AdvanceAnimation(elapsedTime);
+
+	for (const std::unique_ptr<ParticleSystemRenderable>& renderable : m_particleSystems)
+		renderable->GetSystem().Update(elapsedTime);
+
+	// Texts are laid out again on every frame, as a HUD counter would be
+	for (std::size_t i = 0; i < m_texts.size(); ++i)
+		m_texts[i]->Update(Nz::SimpleTextDrawer::Draw("Text #" + Nz::String::Number(i) + " - frame " + Nz::String::Number(m_frameIndex), 24));
+
+	m_frameIndex++;
+}
+
+void Scene::BuildLights(std::mt19937& randomGenerator)
+{
+	std::uniform_real_distribution<float> radius(10.f, 30.f);
+
+	for (unsigned int i = 0; i < m_parameters.lightCount; ++i)
+	{
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+
+		Ndk::NodeComponent& node = entity->AddComponent<Ndk::NodeComponent>();
+		node.SetPosition(RandomPosition(randomGenerator));
+
+		Ndk::LightComponent& light = entity->AddComponent<Ndk::LightComponent>(Nz::LightType_Point);
+		light.SetColor(RandomColor(randomGenerator));
+		light.SetRadius(radius(randomGenerator));
+	}
+}
+
+void Scene::BuildParticleSystems(std::mt19937& randomGenerator)
+{
+	if (m_parameters.particleSystemCount == 0)
+		return;
+
+	Nz::MaterialRef material = Nz::Material::New();
+	material->EnableLighting(false);
+	material->Enable(Nz::RendererParameter_Blend, true);
+	material->Enable(Nz::RendererParameter_DepthWrite, false);
+	material->SetDstBlend(Nz::BlendFunc_One);
+	material->SetSrcBlend(Nz::BlendFunc_SrcAlpha);
+
+	m_particleRenderer = std::make_unique<ParticleRenderer>(std::move(material));
+
+	for (unsigned int i = 0; i < m_parameters.particleSystemCount; ++i)
+	{
+		std::unique_ptr<ParticleEmitter> emitter = std::make_unique<ParticleEmitter>(RandomPosition(randomGenerator), randomGenerator());
+
+		// Particles live two seconds on average, the systems stay close to full once started
+		emitter->SetEmissionCount(std::max(m_parameters.particleCount / 120U, 1U));
+		emitter->SetEmissionRate(60.f);
+
+		std::unique_ptr<ParticleSystemRenderable> renderable = std::make_unique<ParticleSystemRenderable>(m_parameters.particleCount);
+
+		Nz::ParticleSystem& system = renderable->GetSystem();
+		system.AddController(&m_particleController);
+		system.AddEmitter(emitter.get());
+		system.SetRenderer(m_particleRenderer.get());
+
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+		entity->AddComponent<Ndk::NodeComponent>();
+		entity->AddComponent<Ndk::GraphicsComponent>().Attach(renderable.get());
+
+		m_particleEmitters.emplace_back(std::move(emitter));
+		m_particleSystems.emplace_back(std::move(renderable));
+	}
+}
+
+void Scene::BuildSkinnedModels(std::mt19937& randomGenerator)
+{
+	if (m_parameters.skinnedModelCount == 0)
+		return;
+
+	constexpr unsigned int jointCount = 8;
+
+	Nz::MaterialRef material = Nz::Material::New();
+	material->SetDiffuseColor(RandomColor(randomGenerator));
+
+	Nz::SkeletalModel prototype;
+	prototype.SetMesh(BuildSkinnedMesh(jointCount));
+	prototype.SetMaterial(0, material);
+	prototype.SetAnimation(BuildAnimation(jointCount));
+
+	std::uniform_real_distribution<float> animationOffset(0.f, 2.f);
+	std::uniform_real_distribution<float> yaw(-180.f, 180.f);
+
+	for (unsigned int i = 0; i < m_parameters.skinnedModelCount; ++i)
+	{
+		// Each model gets its own pose, they don't all play the same frame
+		std::unique_ptr<Nz::SkeletalModel> model = std::make_unique<Nz::SkeletalModel>(prototype);
+		model->AdvanceAnimation(animationOffset(randomGenerator));
+
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+
+		Ndk::NodeComponent& node = entity->AddComponent<Ndk::NodeComponent>();
+		node.SetPosition(RandomPosition(randomGenerator));
+		node.SetRotation(Nz::EulerAnglesf(0.f, yaw(randomGenerator), 0.f));
+
+		entity->AddComponent<Ndk::GraphicsComponent>().Attach(model.get());
+
+		m_skinnedModels.emplace_back(std::move(model));
+	}
+}
+
+void Scene::BuildSprites(std::mt19937& randomGenerator)
+{
+	std::uniform_real_distribution<float> size(0.5f, 3.f);
+
+	for (unsigned int i = 0; i < m_parameters.spriteCount; ++i)
+	{
+		float spriteSize = size(randomGenerator);
+
+		Nz::SpriteRef sprite = Nz::Sprite::New();
+		sprite->SetColor(RandomColor(randomGenerator));
+		sprite->SetSize(spriteSize, spriteSize);
+
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+
+		Ndk::NodeComponent& node = entity->AddComponent<Ndk::NodeComponent>();
+		node.SetPosition(RandomPosition(randomGenerator));
+
+		entity->AddComponent<Ndk::GraphicsComponent>().Attach(sprite);
+	}
+}
+
+void Scene::BuildStaticModels(std::mt19937& randomGenerator)
+{
+	if (m_parameters.staticModelCount == 0)
+		return;
+
+	// A few meshes and materials, so that the render queue has several batches to sort
+	Nz::Primitive primitives[] = {
+		Nz::Primitive::Box(Nz::Vector3f(2.f)),
+		Nz::Primitive::Cone(2.f, 1.f, 16),
+		Nz::Primitive::IcoSphere(1.f, 2)
+	};
+
+	std::vector<Nz::ModelRef> models;
+	for (const Nz::Primitive& primitive : primitives)
+	{
+		Nz::MeshRef mesh = Nz::Mesh::New();
+		mesh->CreateStatic();
+		mesh->BuildSubMesh(primitive);
+		mesh->SetMaterialCount(1);
+
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			Nz::MaterialRef material = Nz::Material::New();
+			material->SetDiffuseColor(RandomColor(randomGenerator));
+
+			Nz::ModelRef model = Nz::Model::New();
+			model->SetMesh(mesh);
+			model->SetMaterial(0, material);
+
+			models.emplace_back(std::move(model));
+		}
+	}
+
+	std::uniform_int_distribution<std::size_t> modelIndex(0, models.size() - 1);
+	std::uniform_real_distribution<float> yaw(-180.f, 180.f);
+
+	for (unsigned int i = 0; i < m_parameters.staticModelCount; ++i)
+	{
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+
+		Ndk::NodeComponent& node = entity->AddComponent<Ndk::NodeComponent>();
+		node.SetPosition(RandomPosition(randomGenerator));
+		node.SetRotation(Nz::EulerAnglesf(0.f, yaw(randomGenerator), 0.f));
+
+		entity->AddComponent<Ndk::GraphicsComponent>().Attach(models[modelIndex(randomGenerator)]);
+	}
+}
+
+void Scene::BuildTexts(std::mt19937& randomGenerator)
+{
+	for (unsigned int i = 0; i < m_parameters.textCount; ++i)
+	{
+		Nz::TextSpriteRef text = Nz::TextSprite::New();
+		text->SetColor(RandomColor(randomGenerator));
+		text->Update(Nz::SimpleTextDrawer::Draw("Text #" + Nz::String::Number(i), 24));
+
+		Ndk::EntityHandle entity = m_world.CreateEntity();
+
+		Ndk::NodeComponent& node = entity->AddComponent<Ndk::NodeComponent>();
+		node.SetPosition(RandomPosition(randomGenerator));
+		node.SetScale(0.05f);
+
+		entity->AddComponent<Ndk::GraphicsComponent>().Attach(text);
+
+		m_texts.emplace_back(std::move(text));
+	}
+}
+
+Nz::AnimationRef Scene::BuildAnimation(unsigned int jointCount)
+{
+	constexpr unsigned int frameCount = 32;
+
+	Nz::AnimationRef animation = Nz::Animation::New();
+	animation->CreateSkeletal(frameCount, jointCount);
+	animation->EnableLoopPointInterpolation(true);
+
+	// The column sways, each joint a bit later than its parent
+	for (unsigned int frame = 0; frame < frameCount; ++frame)
+	{
+		float phase = 2.f * static_cast<float>(M_PI) * frame / frameCount;
+
+		Nz::SequenceJoint* joints = animation->GetSequenceJoints(frame);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			joints[i].position = (i > 0) ? Nz::Vector3f::Up() : Nz::Vector3f::Zero();
+			joints[i].rotation = Nz::EulerAnglesf(0.f, 0.f, 15.f * std::sin(phase + i * 0.5f)).ToQuaternion();
+			joints[i].scale = Nz::Vector3f::Unit();
+		}
+	}
+
+	Nz::Sequence sequence;
+	sequence.name = "Sway";
+	sequence.firstFrame = 0;
+	sequence.frameCount = frameCount;
+	sequence.frameRate = 24;
+
+	animation->AddSequence(sequence);
+
+	return animation;
+}
+
+Nz::MeshRef Scene::BuildSkinnedMesh(unsigned int jointCount)
+{
+	// A column of rings along the Y axis, one joint per unit of height
+	constexpr unsigned int sideCount = 12;
+	constexpr float radius = 0.3f;
+
+	unsigned int ringCount = jointCount * 2 + 1;
+	unsigned int vertexCount = ringCount * (sideCount + 1);
+	unsigned int indexCount = (ringCount - 1) * sideCount * 6;
+
+	Nz::MeshRef mesh = Nz::Mesh::New();
+	mesh->CreateSkeletal(jointCount);
+
+	Nz::Skeleton* skeleton = mesh->GetSkeleton();
+	for (unsigned int i = 0; i < jointCount; ++i)
+	{
+		Nz::Joint* joint = skeleton->GetJoint(i);
+		if (i > 0)
+		{
+			joint->SetParent(skeleton->GetJoint(i - 1));
+			joint->SetPosition(Nz::Vector3f::Up());
+		}
+
+		joint->SetInverseBindMatrix(Nz::Matrix4f::Translate(Nz::Vector3f(0.f, -static_cast<float>(i), 0.f)));
+	}
+
+	Nz::VertexBufferRef vertexBuffer = Nz::VertexBuffer::New(Nz::VertexDeclaration::Get(Nz::VertexLayout_XYZ_Normal_UV_Tangent_Skinning), vertexCount, Nz::DataStorage_Hardware, Nz::BufferUsage_Static);
+
+	Nz::BufferMapper<Nz::VertexBuffer> vertexMapper(vertexBuffer, Nz::BufferAccess_WriteOnly);
+	Nz::SkeletalMeshVertex* vertices = static_cast<Nz::SkeletalMeshVertex*>(vertexMapper.GetPointer());
+	for (unsigned int ring = 0; ring < ringCount; ++ring)
+	{
+		// Rings between two joints are evenly shared by them
+		unsigned int joint = std::min(ring / 2, jointCount - 1);
+		bool shared = (ring % 2 == 1 && joint + 1 < jointCount);
+		float height = ring * 0.5f;
+
+		for (unsigned int side = 0; side <= sideCount; ++side)
+		{
+			float angle = 2.f * static_cast<float>(M_PI) * side / sideCount;
+			Nz::Vector3f normal(std::cos(angle), 0.f, std::sin(angle));
+
+			vertices->position = Nz::Vector3f(normal.x * radius, height, normal.z * radius);
+			vertices->normal = normal;
+			vertices->tangent = Nz::Vector3f::Up();
+			vertices->uv.Set(static_cast<float>(side) / sideCount, height / jointCount);
+
+			vertices->weightCount = (shared) ? 2 : 1;
+			vertices->weights.Set((shared) ? 0.5f : 1.f, (shared) ? 0.5f : 0.f, 0.f, 0.f);
+			vertices->jointIndexes.Set(joint, (shared) ? joint + 1 : 0, 0, 0);
+			vertices++;
+		}
+	}
+
+	vertexMapper.Unmap();
+
+	Nz::IndexBufferRef indexBuffer = Nz::IndexBuffer::New(false, indexCount, Nz::DataStorage_Hardware, Nz::BufferUsage_Static);
+
+	Nz::IndexMapper indexMapper(indexBuffer, Nz::BufferAccess_DiscardAndWrite);
+	unsigned int index = 0;
+	for (unsigned int ring = 0; ring + 1 < ringCount; ++ring)
+	{
+		for (unsigned int side = 0; side < sideCount; ++side)
+		{
+			unsigned int bottom = ring * (sideCount + 1) + side;
+			unsigned int top = bottom + sideCount + 1;
+
+			indexMapper.Set(index++, bottom);
+			indexMapper.Set(index++, top);
+			indexMapper.Set(index++, top + 1);
+
+			indexMapper.Set(index++, bottom);
+			indexMapper.Set(index++, top + 1);
+			indexMapper.Set(index++, bottom + 1);
+		}
+	}
+
+	indexMapper.Unmap();
+
+	Nz::SkeletalMeshRef subMesh = Nz::SkeletalMesh::New(mesh);
+	subMesh->Create(vertexBuffer);
+	subMesh->SetAABB(Nz::Boxf(-static_cast<float>(jointCount), 0.f, -static_cast<float>(jointCount), 2.f * jointCount, static_cast<float>(jointCount), 2.f * jointCount));
+	subMesh->SetIndexBuffer(indexBuffer);
+	subMesh->SetMaterialIndex(0);
+	subMesh->SetPrimitiveMode(Nz::PrimitiveMode_TriangleList);
+
+	mesh->SetMaterialCount(1);
+	mesh->AddSubMesh(subMesh);
+
+	return mesh;
+}
+
+Scene::ParticleEmitter::ParticleEmitter(const Nz::Vector3f& origin, unsigned int seed) :
+m_origin(origin),
+m_randomGenerator(seed)
+{
+}
+
+void Scene::ParticleEmitter::SetupParticles(Nz::ParticleMapper& mapper, unsigned int count) const
+{
+	std::uniform_int_distribution<Nz::UInt32> life(1500, 2500); // In milliseconds
+	std::uniform_real_distribution<float> horizontalSpeed(-2.f, 2.f);
+	std::uniform_real_distribution<float> verticalSpeed(5.f, 10.f);
+	std::uniform_real_distribution<float> rotation(0.f, 360.f);
+
+	Nz::SparsePtr<Nz::Color> colorPtr = mapper.GetComponentPtr<Nz::Color>(Nz::ParticleComponent_Color);
+	Nz::SparsePtr<Nz::UInt32> lifePtr = mapper.GetComponentPtr<Nz::UInt32>(Nz::ParticleComponent_Life);
+	Nz::SparsePtr<Nz::Vector3f> positionPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Position);
+	Nz::SparsePtr<float> rotationPtr = mapper.GetComponentPtr<float>(Nz::ParticleComponent_Rotation);
+	Nz::SparsePtr<Nz::Vector3f> velocityPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Velocity);
+
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		colorPtr[i] = Nz::Color(255, 160, 64, 200);
+		lifePtr[i] = life(m_randomGenerator);
+		positionPtr[i] = m_origin;
+		rotationPtr[i] = rotation(m_randomGenerator);
+
+		float x = horizontalSpeed(m_randomGenerator);
+		float y = verticalSpeed(m_randomGenerator);
+		float z = horizontalSpeed(m_randomGenerator);
+		velocityPtr[i].Set(x, y, z);
+	}
+}
+
+void Scene::ParticleController::Apply(Nz::ParticleSystem& system, Nz::ParticleMapper& mapper, unsigned int startId, unsigned int endId, float elapsedTime)
+{
+	Nz::UInt32 elapsedMilliseconds = static_cast<Nz::UInt32>(elapsedTime * 1000.f);
+
+	Nz::SparsePtr<Nz::UInt32> lifePtr = mapper.GetComponentPtr<Nz::UInt32>(Nz::ParticleComponent_Life);
+	Nz::SparsePtr<Nz::Vector3f> positionPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Position);
+	Nz::SparsePtr<Nz::Vector3f> velocityPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Velocity);
+
+	for (unsigned int i = startId; i <= endId; ++i)
+	{
+		if (lifePtr[i] <= elapsedMilliseconds)
+		{
+			system.KillParticle(i);
+			continue;
+		}
+
+		lifePtr[i] -= elapsedMilliseconds;
+		velocityPtr[i].y -= 9.81f * elapsedTime;
+		positionPtr[i] += velocityPtr[i] * elapsedTime;
+	}
+}
+
+Scene::ParticleRenderer::ParticleRenderer(Nz::MaterialRef material) :
+m_material(std::move(material))
+{
+}
+
+void Scene::ParticleRenderer::Render(const Nz::ParticleSystem& system, const Nz::ParticleMapper& mapper, unsigned int startId, unsigned int endId, Nz::AbstractRenderQueue* renderQueue)
+{
+	NazaraUnused(system);
+
+	static const float size = 0.5f;
+
+	Nz::SparsePtr<const Nz::Color> colorPtr = mapper.GetComponentPtr<Nz::Color>(Nz::ParticleComponent_Color);
+	Nz::SparsePtr<const Nz::Vector3f> positionPtr = mapper.GetComponentPtr<Nz::Vector3f>(Nz::ParticleComponent_Position);
+	Nz::SparsePtr<const float> rotationPtr = mapper.GetComponentPtr<float>(Nz::ParticleComponent_Rotation);
+	Nz::SparsePtr<const float> sizePtr(&size, 0);
+
+	renderQueue->AddBillboards(0, m_material, endId - startId + 1, positionPtr + startId, sizePtr, rotationPtr + startId, colorPtr + startId);
+}
+
+Scene::ParticleSystemRenderable::ParticleSystemRenderable(unsigned int maxParticleCount) :
+m_system(maxParticleCount, Nz::ParticleLayout_Billboard)
+{
+}
+
+void Scene::ParticleSystemRenderable::AddToRenderQueue(Nz::AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
+{
+	m_system.AddToRenderQueue(renderQueue, *instanceData.transformMatrix);
+}
+
+void Scene::ParticleSystemRenderable::MakeBoundingVolume() const
+{
+	// Particles are simulated in world space, away from the entity
+	m_boundingVolume.MakeInfinite();
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#ifndef NAZARA_RENDERBENCHMARK_SCENE_HPP
+#define NAZARA_RENDERBENCHMARK_SCENE_HPP
+
+#include <Nazara/Graphics/InstancedRenderable.hpp>
+#include <Nazara/Graphics/Material.hpp>
+#include <Nazara/Graphics/ParticleController.hpp>
+#include <Nazara/Graphics/ParticleEmitter.hpp>
+#include <Nazara/Graphics/ParticleRenderer.hpp>
+#include <Nazara/Graphics/ParticleSystem.hpp>
+#include <Nazara/Graphics/SkeletalModel.hpp>
+#include <Nazara/Graphics/TextSprite.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <NDK/World.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Nz
+{
+	class RenderTarget;
+}
+
+struct SceneParameters
+{
+	unsigned int lightCount = 32;
+	unsigned int particleCount = 2000; //< Per system
+	unsigned int particleSystemCount = 4;
+	unsigned int seed = 42;
+	unsigned int skinnedModelCount = 50;
+	unsigned int spriteCount = 500;
+	unsigned int staticModelCount = 1000;
+	unsigned int textCount = 50;
+};
+
+// Synthetic scene, built from the seed only: two scenes with the same parameters are the same down to the last particle
+class Scene
+{
+	public:
+		Scene(const SceneParameters& parameters, const Nz::RenderTarget* target);
+		Scene(const Scene&) = delete;
+		~Scene() = default;
+
+		void Animate(float elapsedTime);
+
+		inline Ndk::World& GetWorld();
+
+		Scene& operator=(const Scene&) = delete;
+
+	private:
+		class ParticleEmitter : public Nz::ParticleEmitter
+		{
+			public:
+				ParticleEmitter(const Nz::Vector3f& origin, unsigned int seed);
+
+			private:
+				void SetupParticles(Nz::ParticleMapper& mapper, unsigned int count) const override;
+
+				Nz::Vector3f m_origin;
+				mutable std::mt19937 m_randomGenerator;
+		};
+
+		class ParticleController : public Nz::ParticleController
+		{
+			public:
+				void Apply(Nz::ParticleSystem& system, Nz::ParticleMapper& mapper, unsigned int startId, unsigned int endId, float elapsedTime) override;
+		};
+
+		class ParticleRenderer : public Nz::ParticleRenderer
+		{
+			public:
+				ParticleRenderer(Nz::MaterialRef material);
+
+				void Render(const Nz::ParticleSystem& system, const Nz::ParticleMapper& mapper, unsigned int startId, unsigned int endId, Nz::AbstractRenderQueue* renderQueue) override;
+
+			private:
+				Nz::MaterialRef m_material;
+		};
+
+		// Particle systems are not instanced renderables, this lets a GraphicsComponent draw them
+		class ParticleSystemRenderable : public Nz::InstancedRenderable
+		{
+			public:
+				ParticleSystemRenderable(unsigned int maxParticleCount);
+
+				void AddToRenderQueue(Nz::AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const override;
+
+				inline Nz::ParticleSystem& GetSystem();
+
+			private:
+				void MakeBoundingVolume() const override;
+
+				Nz::ParticleSystem m_system;
+		};
+
+		void BuildLights(std::mt19937& randomGenerator);
+		void BuildParticleSystems(std::mt19937& randomGenerator);
+		void BuildSkinnedModels(std::mt19937& randomGenerator);
+		void BuildSprites(std::mt19937& randomGenerator);
+		void BuildStaticModels(std::mt19937& randomGenerator);
+		void BuildTexts(std::mt19937& randomGenerator);
+
+		static Nz::AnimationRef BuildAnimation(unsigned int jointCount);
+		static Nz::MeshRef BuildSkinnedMesh(unsigned int jointCount);
+
+		SceneParameters m_parameters;
+		ParticleController m_particleController;
+		std::unique_ptr<ParticleRenderer> m_particleRenderer;
+		std::vector<std::unique_ptr<ParticleEmitter>> m_particleEmitters;
+		std::vector<std::unique_ptr<ParticleSystemRenderable>> m_particleSystems;
+		std::vector<std::unique_ptr<Nz::SkeletalModel>> m_skinnedModels;
+		std::vector<Nz::TextSpriteRef> m_texts;
+		unsigned int m_frameIndex;
+		Ndk::World m_world; //< Last, its entities reference the renderables above
+};
+
+inline Ndk::World& Scene::GetWorld()
+{
+	return m_world;
+}
+
+inline Nz::ParticleSystem& Scene::ParticleSystemRenderable::GetSystem()
+{
+	return m_system;
+}
+
+#endif // NAZARA_RENDERBENCHMARK_SCENE_HPP
@@ -0,0 +1,305 @@
+#include "Scene.hpp"
+#include <Nazara/Core/AbstractLogger.hpp>
+#include <Nazara/Core/Log.hpp>
+#include <Nazara/Core/Profiler.hpp>
+#include <Nazara/Graphics/DeferredRenderTechnique.hpp>
+#include <Nazara/Graphics/ForwardRenderTechnique.hpp>
+#include <Nazara/Renderer/GpuTimer.hpp>
+#include <Nazara/Renderer/RenderTexture.hpp>
+#include <Nazara/Renderer/Renderer.hpp>
+#include <Nazara/Renderer/Texture.hpp>
+#include <NDK/Sdk.hpp>
+#include <NDK/Systems/RenderSystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+// Renders synthetic scenes to an offscreen target through each render technique, and writes the measures as JSON on the standard output
+// Usage: RenderBenchmark [--technique=forward|deferred|all] [--frames=<count>] [--warmup=<count>] [--width=<pixels>] [--height=<pixels>]
+//                        [--seed=<seed>] [--static-models=<count>] [--skinned-models=<count>] [--lights=<count>]
+//                        [--particle-systems=<count>] [--particles=<count>] [--sprites=<count>] [--texts=<count>]
+//
+// CPU times cover the submission of the frames, GPU times come from the timer queries (read a few frames late, the last frames are never waited for)
+
+namespace
+{
+	struct Options
+	{
+		SceneParameters scene;
+		std::string technique = "all";
+		unsigned int frameCount = 300;
+		unsigned int height = 720;
+		unsigned int warmupFrameCount = 30;
+		unsigned int width = 1280;
+	};
+
+	bool ParseOptions(int argc, char* argv[], Options* options)
+	{
+		struct UIntOption
+		{
+			const char* prefix;
+			unsigned int* value;
+		};
+
+		UIntOption uintOptions[] = {
+			{"--frames=",           &options->frameCount},
+			{"--height=",           &options->height},
+			{"--lights=",           &options->scene.lightCount},
+			{"--particles=",        &options->scene.particleCount},
+			{"--particle-systems=", &options->scene.particleSystemCount},
+			{"--seed=",             &options->scene.seed},
+			{"--skinned-models=",   &options->scene.skinnedModelCount},
+			{"--sprites=",          &options->scene.spriteCount},
+			{"--static-models=",    &options->scene.staticModelCount},
+			{"--texts=",            &options->scene.textCount},
+			{"--warmup=",           &options->warmupFrameCount},
+			{"--width=",            &options->width}
+		};
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+
+			bool found = false;
+			for (const UIntOption& option : uintOptions)
+			{
+				std::size_t length = std::strlen(option.prefix);
+				if (std::strncmp(arg, option.prefix, length) == 0)
+				{
+					*option.value = static_cast<unsigned int>(std::strtoul(arg + length, nullptr, 10));
+					found = true;
+					break;
+				}
+			}
+
+			if (found)
+				continue;
+
+			if (std::strncmp(arg, "--technique=", 12) == 0)
+				options->technique = arg + 12;
+			else
+			{
+				std::fprintf(stderr, "Unknown argument: %s\n", arg);
+				return false;
+			}
+		}
+
+		if (options->technique != "all" && options->technique != "forward" && options->technique != "deferred")
+		{
+			std::fprintf(stderr, "Unknown technique: %s\n", options->technique.c_str());
+			return false;
+		}
+
+		if (options->frameCount == 0 || options->width == 0 || options->height == 0)
+		{
+			std::fprintf(stderr, "Frame count and resolution must be over zero\n");
+			return false;
+		}
+
+		return true;
+	}
+
+	std::string EscapeJson(const char* str)
+	{
+		std::string escaped;
+		for (; *str; ++str)
+		{
+			if (*str == '"' || *str == '\\')
+				escaped += '\\';
+
+			escaped += *str;
+		}
+
+		return escaped;
+	}
+
+	bool CreateTarget(Nz::RenderTexture& target, unsigned int width, unsigned int height)
+	{
+		Nz::TextureRef colorTexture = Nz::Texture::New();
+		if (!colorTexture->Create(Nz::ImageType_2D, Nz::PixelFormatType_RGBA8, width, height))
+			return false;
+
+		if (!target.Create(true))
+			return false;
+
+		target.AttachTexture(Nz::AttachmentPoint_Color, 0, colorTexture);
+		target.AttachBuffer(Nz::AttachmentPoint_DepthStencil, 0, Nz::PixelFormatType_Depth24Stencil8, width, height);
+		target.Unlock();
+
+		return target.IsComplete();
+	}
+
+	void RunTechnique(const char* name, std::unique_ptr<Nz::AbstractRenderTechnique> technique, const Options& options, bool first)
+	{
+		std::printf("%s\n\t\t{\n\t\t\t\"name\": \"%s\",\n", (first) ? "" : ",", name);
+
+		Nz::RenderTexture target;
+		if (!technique || !CreateTarget(target, options.width, options.height))
+		{
+			std::printf("\t\t\t\"supported\": false\n\t\t}");
+			return;
+		}
+
+		Scene scene(options.scene, &target);
+
+		Ndk::World& world = scene.GetWorld();
+		world.GetSystem<Ndk::RenderSystem>().ChangeRenderTechnique(std::move(technique));
+
+		// Fixed step, so that every run animates the same frames
+		const float elapsedTime = 1.f / 60.f;
+
+		struct GpuZone
+		{
+			Nz::UInt64 totalTime = 0;
+		};
+
+		std::map<std::string, GpuZone> gpuZones;
+		std::vector<double> frameTimes;
+		Nz::UInt64 gpuFrameTime = 0;
+		Nz::UInt64 bufferUploadSize = 0;
+		Nz::UInt64 drawCallCount = 0;
+		Nz::UInt64 instanceCount = 0;
+		Nz::UInt64 primitiveCount = 0;
+		Nz::UInt64 redundantCallCount = 0;
+		Nz::UInt64 shaderChangeCount = 0;
+		Nz::UInt64 stateUpdateCount = 0;
+		Nz::UInt64 textureChangeCount = 0;
+
+		Nz::GpuTimer::Enable(true);
+		Nz::Profiler::Enable(true);
+
+		for (unsigned int frame = 0; frame < options.warmupFrameCount + options.frameCount; ++frame)
+		{
+			bool measured = (frame >= options.warmupFrameCount);
+			if (frame == options.warmupFrameCount)
+				Nz::Profiler::Clear();
+
+			auto start = std::chrono::steady_clock::now();
+
+			scene.Animate(elapsedTime);
+			world.Update(elapsedTime);
+			Nz::Renderer::EndFrame();
+
+			auto end = std::chrono::steady_clock::now();
+
+			if (!measured)
+				continue;
+
+			frameTimes.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+
+			const Nz::Renderer::FrameStats& stats = Nz::Renderer::GetFrameStats();
+			bufferUploadSize += stats.bufferUploadSize;
+			drawCallCount += stats.drawCallCount;
+			instanceCount += stats.instanceCount;
+			primitiveCount += stats.primitiveCount;
+			redundantCallCount += stats.redundantCallCount;
+			shaderChangeCount += stats.shaderChangeCount;
+			stateUpdateCount += stats.stateUpdateCount;
+			textureChangeCount += stats.textureChangeCount;
+
+			// The latest frame the GPU is done with, it lags behind by a few frames
+			for (const Nz::GpuTimer::Timing& timing : Nz::GpuTimer::GetTimings())
+				gpuZones[timing.name].totalTime += timing.duration;
+
+			gpuFrameTime += Nz::GpuTimer::GetFrameDuration();
+		}
+
+		Nz::Profiler::Enable(false);
+		Nz::GpuTimer::Enable(false);
+
+		double frameCount = static_cast<double>(options.frameCount);
+
+		double meanFrameTime = 0.0;
+		for (double frameTime : frameTimes)
+			meanFrameTime += frameTime;
+
+		meanFrameTime /= frameCount;
+
+		std::sort(frameTimes.begin(), frameTimes.end());
+
+		std::printf("\t\t\t\"supported\": true,\n");
+		std::printf("\t\t\t\"cpu_frame_us\": {\"mean\": %.3f, \"median\": %.3f, \"p95\": %.3f, \"max\": %.3f},\n", meanFrameTime, frameTimes[frameTimes.size() / 2], frameTimes[frameTimes.size() * 95 / 100], frameTimes.back());
+		std::printf("\t\t\t\"gpu_frame_us\": %.3f,\n", gpuFrameTime / frameCount / 1000.0);
+
+		std::printf("\t\t\t\"cpu_zones\": [");
+		bool firstZone = true;
+		for (const Nz::Profiler::ZoneStats& zone : Nz::Profiler::GetStats())
+		{
+			std::printf("%s\n\t\t\t\t{\"name\": \"%s\", \"calls_per_frame\": %.3f, \"total_us_per_frame\": %.3f, \"self_us_per_frame\": %.3f, \"max_us\": %llu}", (firstZone) ? "" : ",", EscapeJson(zone.name).c_str(), zone.callCount / frameCount, zone.totalTime / frameCount, zone.selfTime / frameCount, static_cast<unsigned long long>(zone.maxTime));
+			firstZone = false;
+		}
+		std::printf("\n\t\t\t],\n");
+
+		std::printf("\t\t\t\"gpu_zones\": [");
+		firstZone = true;
+		for (const auto& pair : gpuZones)
+		{
+			std::printf("%s\n\t\t\t\t{\"name\": \"%s\", \"us_per_frame\": %.3f}", (firstZone) ? "" : ",", EscapeJson(pair.first.c_str()).c_str(), pair.second.totalTime / frameCount / 1000.0);
+			firstZone = false;
+		}
+		std::printf("\n\t\t\t],\n");
+
+		std::printf("\t\t\t\"render_stats_per_frame\": {\"buffer_upload_bytes\": %.1f, \"draw_calls\": %.1f, \"instances\": %.1f, \"primitives\": %.1f, \"redundant_calls\": %.1f, \"shader_changes\": %.1f, \"state_updates\": %.1f, \"texture_changes\": %.1f}\n",
+		            bufferUploadSize / frameCount, drawCallCount / frameCount, instanceCount / frameCount, primitiveCount / frameCount,
+		            redundantCallCount / frameCount, shaderChangeCount / frameCount, stateUpdateCount / frameCount, textureChangeCount / frameCount);
+
+		std::printf("\t\t}");
+		std::fflush(stdout);
+
+		Nz::Profiler::Clear();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseOptions(argc, argv, &options))
+		return EXIT_FAILURE;
+
+	// The standard output only receives the results, the log file still receives the messages once the modules are initialized
+	Nz::Log::Enable(false);
+
+	Nz::Initializer<Ndk::Sdk> sdk;
+	if (!sdk)
+	{
+		std::fprintf(stderr, "Failed to initialize the SDK\n");
+		return EXIT_FAILURE;
+	}
+
+	Nz::Log::Enable(true);
+	Nz::Log::GetLogger()->EnableStdReplication(false);
+
+	const SceneParameters& scene = options.scene;
+
+	std::printf("{\n");
+	std::printf("\t\"frames\": %u,\n\t\"warmup_frames\": %u,\n\t\"width\": %u,\n\t\"height\": %u,\n", options.frameCount, options.warmupFrameCount, options.width, options.height);
+	std::printf("\t\"scene\": {\"seed\": %u, \"static_models\": %u, \"skinned_models\": %u, \"lights\": %u, \"particle_systems\": %u, \"particles\": %u, \"sprites\": %u, \"texts\": %u},\n",
+	            scene.seed, scene.staticModelCount, scene.skinnedModelCount, scene.lightCount, scene.particleSystemCount, scene.particleCount, scene.spriteCount, scene.textCount);
+	std::printf("\t\"techniques\": [");
+
+	bool first = true;
+	if (options.technique == "all" || options.technique == "forward")
+	{
+		RunTechnique("forward", std::make_unique<Nz::ForwardRenderTechnique>(), options, first);
+		first = false;
+	}
+
+	if (options.technique == "all" || options.technique == "deferred")
+	{
+		std::unique_ptr<Nz::AbstractRenderTechnique> technique;
+		if (Nz::DeferredRenderTechnique::IsSupported())
+			technique = std::make_unique<Nz::DeferredRenderTechnique>();
+
+		RunTechnique("deferred", std::move(technique), options, first);
+	}
+
+	std::printf("\n\t]\n}\n");
+
+	Nz::Log::Enable(false);
+
+	return EXIT_SUCCESS;
+}